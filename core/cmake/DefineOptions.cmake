@@ -91,6 +91,15 @@ define_option(MILVUS_WITH_AWS "Build with aws" OFF)
 
 define_option(MILVUS_WITH_OATPP "Build with oatpp" ON)
 
+define_option(MILVUS_WITH_LOCK_STATS "Build with wait and hold time statistics of the instrumented locks" OFF)
+
+define_option_string(MILVUS_MALLOC
+        "Allocator linked in place of the glibc malloc, for the memory not drawn from the arena of a request"
+        "SYSTEM"
+        "SYSTEM"
+        "JEMALLOC"
+        "TCMALLOC")
+
 #----------------------------------------------------------------------
 set_option_category("Test and benchmark")
 
@@ -101,6 +110,8 @@ else ()
     define_option(MILVUS_BUILD_TESTS "Build the MILVUS googletest unit tests" OFF)
 endif (BUILD_UNIT_TEST)
 
+define_option(MILVUS_BUILD_BENCHMARKS "Build the MILVUS benchmarks, apart from the unit tests" OFF)
+
 #----------------------------------------------------------------------
 macro(config_summary)
     message(STATUS "---------------------------------------------------------------------")
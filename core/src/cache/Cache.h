@@ -11,22 +11,48 @@
 
 #pragma once
 
+#include "CacheReclaimer.h"
+#include "GreedyDual.h"
 #include "LRU.h"
+#include "TinyLFU.h"
+#include "utils/ContentionStats.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+// accounting of the items sharing one group, e.g. the segments of one collection
+struct CacheGroupStat {
+    std::string name_;
+    int64_t usage_ = 0;
+    int64_t item_count_ = 0;
+    int64_t quota_ = 0;  // 0 means the group is only limited by the cache capacity
+    bool pinned_ = false;
+    int64_t hit_count_ = 0;
+    int64_t miss_count_ = 0;
+};
+
 template <typename ItemObj>
 class Cache {
  public:
+    using GroupFunc = std::function<std::string(const std::string& key)>;
+    using GuardFunc = std::function<bool(const std::string& key)>;
+
     // mem_capacity, units:GB
-    Cache(int64_t capacity_gb, int64_t cache_max_count, const std::string& header = "");
+    // shard_num: keys are hashed into shard_num independently locked shards which share one capacity budget
+    // policy: eviction policy of each shard
+    Cache(int64_t capacity_gb, int64_t cache_max_count, const std::string& header = "", int64_t shard_num = 1,
+          CachePolicyType policy = CachePolicyType::LRU);
     ~Cache() = default;
 
     int64_t
@@ -54,6 +80,16 @@ class Cache {
         freemem_percent_ = percent;
     }
 
+    int64_t
+    shard_num() const {
+        return shards_.size();
+    }
+
+    CachePolicyType
+    policy() const {
+        return policy_type_;
+    }
+
     size_t
     size() const;
 
@@ -69,9 +105,47 @@ class Cache {
     void
     erase(const std::string& key);
 
+    // insert item under key and erase old_key in one step, a reader finds one of them at any time. The item is only
+    // inserted if it fits in the capacity once old_key is erased, old_key is erased either way
+    bool
+    replace(const std::string& old_key, const std::string& key, const ItemObj& item);
+
+    // map a key to its group, keys mapped to an empty name are not grouped, must be set before any insertion
+    void
+    set_group_func(const GroupFunc& func) {
+        group_func_ = func;
+    }
+
+    // keys for which func returns true are skipped when releasing memory for capacity, must be set before any
+    // insertion, func is called with a shard lock held so it must not access the cache
+    void
+    set_evict_guard(const GuardFunc& func) {
+        evict_guard_ = func;
+    }
+
+    // quota: max bytes the group can occupy, 0 means no quota
+    // pinned: items of a pinned group are only evicted to keep the group under its own quota
+    // aliases: other group names accounted to this group, e.g. partitions of a collection
+    void
+    set_group_quota(const std::string& group, int64_t quota, bool pinned,
+                    const std::vector<std::string>& aliases = std::vector<std::string>());
+
+    void
+    remove_group_quota(const std::string& group);
+
+    bool
+    group_stat(const std::string& group, CacheGroupStat& stat) const;
+
+    std::vector<CacheGroupStat>
+    group_stats() const;
+
     bool
     reserve(const int64_t size);
 
+    // release at least size bytes, pinned and guarded items are kept
+    void
+    release(const int64_t size);
+
     void
     print();
 
@@ -79,23 +153,86 @@ class Cache {
     clear();
 
  private:
+    struct Shard {
+        Shard(int64_t max_count, CachePolicyType policy) {
+            if (policy == CachePolicyType::TINY_LFU) {
+                policy_ = std::make_unique<TinyLFU<std::string, ItemObj>>(max_count);
+            } else if (policy == CachePolicyType::GREEDY_DUAL) {
+                policy_ = std::make_unique<GreedyDual<std::string, ItemObj>>(max_count);
+            } else {
+                policy_ = std::make_unique<LRU<std::string, ItemObj>>(max_count);
+            }
+        }
+
+        CachePolicyPtr<std::string, ItemObj> policy_;
+        mutable InstrumentedMutex mutex_{"cache.shard"};
+    };
+    using ShardPtr = std::unique_ptr<Shard>;
+
+    Shard&
+    shard_of(const std::string& key);
+
+    // return the replaced item, it must be released after the shard lock is unlocked
+    ItemObj
+    insert_internal(Shard& shard, const std::string& key, const ItemObj& item);
+
+    // return the erased item, it must be released after the shard lock is unlocked
+    ItemObj
+    erase_internal(Shard& shard, const std::string& key);
+
+    // hand items over to CacheReclaimer, so that they are destroyed out of the caller thread
     void
-    insert_internal(const std::string& key, const ItemObj& item);
+    reclaim(std::vector<ItemObj>& items);
+
+    // frequency of the first item free_memory would release, false if nothing can be released,
+    // takes evict_mutex_ and shard locks one at a time, so the caller must not hold any of them
+    bool
+    next_victim_frequency(const std::string& skip_key, size_t& frequency);
 
+    // release memory round-robin across shards until usage drops under target_size, item skip_key is kept,
+    // shard locks are taken one at a time, so the caller must not hold any of them
     void
-    erase_internal(const std::string& key);
+    free_memory(const int64_t target_size, const std::string& skip_key = "");
 
+    // release items of group until the group fits in its quota, item skip_key is kept
     void
-    free_memory_internal(const int64_t target_size);
+    free_group_memory(const std::string& group, const std::string& skip_key = "");
+
+    // group name of key after alias resolution, group_mutex_ must be held
+    std::string
+    group_name_of(const std::string& key) const;
+
+    std::string
+    group_of(const std::string& key) const;
+
+    // update the group accounting of key, group_mutex_ must not be held
+    void
+    account_group(const std::string& key, int64_t size_delta, int64_t count_delta);
+
+    bool
+    is_pinned(const std::string& key) const;
 
  private:
     std::string header_;
-    int64_t usage_;
-    int64_t capacity_;
+    std::atomic<int64_t> usage_;
+    std::atomic<int64_t> capacity_;
     double freemem_percent_;
 
-    LRU<std::string, ItemObj> lru_;
-    mutable std::mutex mutex_;
+    CachePolicyType policy_type_;
+    std::vector<ShardPtr> shards_;
+
+    // eviction passes are serialized so that concurrent inserts don't release memory twice,
+    // evict_cursor_ rotates the first shard to release from and is protected by evict_mutex_
+    std::mutex evict_mutex_;
+    uint64_t evict_cursor_ = 0;
+
+    // group accounting, group_mutex_ is always taken after a shard lock and never the other way round
+    GroupFunc group_func_;
+    GuardFunc evict_guard_;
+    std::unordered_map<std::string, CacheGroupStat> groups_;
+    std::unordered_map<std::string, std::string> group_alias_;
+    std::atomic<int64_t> pinned_group_count_{0};
+    mutable std::mutex group_mutex_;
 };
 
 }  // namespace cache
@@ -15,176 +15,545 @@ namespace cache {
 constexpr double DEFAULT_THRESHOLD_PERCENT = 0.7;
 
 template <typename ItemObj>
-Cache<ItemObj>::Cache(int64_t capacity, int64_t cache_max_count, const std::string& header)
+Cache<ItemObj>::Cache(int64_t capacity, int64_t cache_max_count, const std::string& header, int64_t shard_num,
+                      CachePolicyType policy)
     : header_(header),
       usage_(0),
       capacity_(capacity),
       freemem_percent_(DEFAULT_THRESHOLD_PERCENT),
-      lru_(cache_max_count) {
+      policy_type_(policy) {
+    if (shard_num <= 0) {
+        shard_num = 1;
+    }
+    int64_t shard_max_count = std::max(cache_max_count / shard_num, (int64_t)1);
+    for (int64_t i = 0; i < shard_num; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>(shard_max_count, policy));
+    }
+}
+
+template <typename ItemObj>
+typename Cache<ItemObj>::Shard&
+Cache<ItemObj>::shard_of(const std::string& key) {
+    if (shards_.size() == 1) {
+        return *shards_[0];
+    }
+    return *shards_[std::hash<std::string>()(key) % shards_.size()];
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::set_capacity(int64_t capacity) {
-    std::lock_guard<std::mutex> lock(mutex_);
     if (capacity > 0) {
         capacity_ = capacity;
-        free_memory_internal(capacity);
+        free_memory(capacity);
     }
 }
 
 template <typename ItemObj>
 size_t
 Cache<ItemObj>::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.size();
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex_);
+        count += shard->policy_->size();
+    }
+    return count;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::exists(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.exists(key);
+    auto& shard = shard_of(key);
+    std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+    return shard.policy_->exists(key);
 }
 
 template <typename ItemObj>
 ItemObj
 Cache<ItemObj>::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
-        return nullptr;
+    auto& shard = shard_of(key);
+    ItemObj item = nullptr;
+    {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+        shard.policy_->access(key);
+        if (shard.policy_->exists(key)) {
+            item = shard.policy_->get(key);
+        }
+    }
+
+    if (group_func_) {
+        std::lock_guard<std::mutex> lock(group_mutex_);
+        std::string group = group_name_of(key);
+        if (!group.empty()) {
+            auto& stat = groups_[group];
+            stat.name_ = group;
+            if (item == nullptr) {
+                ++stat.miss_count_;
+            } else {
+                ++stat.hit_count_;
+            }
+        }
     }
-    return lru_.get(key);
+    return item;
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    insert_internal(key, item);
+    if (item == nullptr) {
+        return;
+    }
+
+    // the policy may refuse an item whose insertion would evict more valuable ones, the item compared
+    // with is the one the round-robin eviction releases next, whichever shard it lives in
+    size_t victim_frequency = 0;
+    bool need_evict = usage_ + item->Size() > capacity_ && next_victim_frequency(key, victim_frequency);
+
+    auto& shard = shard_of(key);
+    std::vector<ItemObj> replaced;
+    {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+        if (need_evict && !shard.policy_->exists(key) && !shard.policy_->admit(key, victim_frequency)) {
+            LOG_SERVER_DEBUG_ << header_ << " Reject " << key << " size: " << (item->Size() >> 20)
+                              << "MB, not admitted by cache policy";
+            return;
+        }
+        replaced.emplace_back(insert_internal(shard, key, item));
+    }
+    reclaim(replaced);
+
+    if (group_func_) {
+        free_group_memory(group_of(key), key);
+    }
+
+    // if usage exceed capacity, free some items
+    if (usage_ > capacity_) {
+        LOG_SERVER_DEBUG_ << header_ << " Current usage " << (usage_ >> 20) << "MB is too high for capacity "
+                          << (capacity_ >> 20) << "MB, start free memory";
+        free_memory(capacity_, key);
+    }
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    erase_internal(key);
+    auto& shard = shard_of(key);
+    std::vector<ItemObj> erased;
+    {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+        erased.emplace_back(erase_internal(shard, key));
+    }
+    reclaim(erased);
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::replace(const std::string& old_key, const std::string& key, const ItemObj& item) {
+    auto& old_shard = shard_of(old_key);
+    auto& shard = shard_of(key);
+    std::vector<ItemObj> released;
+    bool inserted = false;
+    {
+        std::unique_lock<InstrumentedMutex> old_lock(old_shard.mutex_, std::defer_lock);
+        std::unique_lock<InstrumentedMutex> lock(shard.mutex_, std::defer_lock);
+        if (&old_shard == &shard) {
+            lock.lock();
+        } else {
+            std::lock(old_lock, lock);
+        }
+
+        released.emplace_back(erase_internal(old_shard, old_key));
+        // nothing else is evicted for the item
+        if (item != nullptr && (shard.policy_->exists(key) || usage_ + item->Size() <= capacity_)) {
+            released.emplace_back(insert_internal(shard, key, item));
+            inserted = true;
+        }
+    }
+    reclaim(released);
+
+    if (inserted && group_func_) {
+        free_group_memory(group_of(key), key);
+    }
+    return inserted;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::reserve(const int64_t item_size) {
-    std::lock_guard<std::mutex> lock(mutex_);
     if (item_size > capacity_) {
         LOG_SERVER_ERROR_ << header_ << " item size " << (item_size >> 20) << "MB too big to insert into cache capacity"
-                         << (capacity_ >> 20) << "MB";
+                          << (capacity_ >> 20) << "MB";
         return false;
     }
     if (item_size > capacity_ - usage_) {
-        free_memory_internal(capacity_ - item_size);
+        free_memory(capacity_ - item_size);
     }
     return true;
 }
 
+template <typename ItemObj>
+void
+Cache<ItemObj>::release(const int64_t size) {
+    if (size > 0) {
+        free_memory(usage_ - size);
+    }
+}
+
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lru_.clear();
-    usage_ = 0;
+    for (auto& shard : shards_) {
+        std::vector<ItemObj> erased;
+        {
+            std::lock_guard<InstrumentedMutex> lock(shard->mutex_);
+            int64_t shard_usage = 0;
+            std::vector<std::string> keys;
+            shard->policy_->visit_victims([&](const std::pair<std::string, ItemObj>& pair) {
+                shard_usage += pair.second->Size();
+                erased.emplace_back(pair.second);
+                keys.emplace_back(pair.first);
+                return true;
+            });
+            shard->policy_->clear();
+            usage_ -= shard_usage;
+
+            for (size_t i = 0; i < keys.size(); ++i) {
+                account_group(keys[i], -erased[i]->Size(), -1);
+            }
+        }
+        reclaim(erased);
+    }
     LOG_SERVER_DEBUG_ << header_ << " Clear cache !";
 }
 
-
 template <typename ItemObj>
 void
 Cache<ItemObj>::print() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    size_t cache_count = lru_.size();
-    // for (auto it = lru_.begin(); it != lru_.end(); ++it) {
-    //     LOG_SERVER_DEBUG_ << it->first;
-    // }
-    LOG_SERVER_DEBUG_ << header_ << " [item count]: " << cache_count << ", [usage] " << (usage_ >> 20)
-                     << "MB, [capacity] " << (capacity_ >> 20) << "MB";
+    size_t cache_count = size();
+    LOG_SERVER_DEBUG_ << header_ << " [item count]: " << cache_count << ", [shard count]: " << shards_.size()
+                      << ", [usage] " << (usage_ >> 20) << "MB, [capacity] " << (capacity_ >> 20) << "MB";
 }
 
 template <typename ItemObj>
-void
-Cache<ItemObj>::insert_internal(const std::string& key, const ItemObj& item) {
-    if (item == nullptr) {
-        return;
-    }
-
+ItemObj
+Cache<ItemObj>::insert_internal(Shard& shard, const std::string& key, const ItemObj& item) {
     size_t item_size = item->Size();
 
     // if key already exist, subtract old item size
-    if (lru_.exists(key)) {
-        const ItemObj& old_item = lru_.get(key);
+    ItemObj old_item = nullptr;
+    if (shard.policy_->exists(key)) {
+        old_item = shard.policy_->peek(key);
         usage_ -= old_item->Size();
     }
 
     // plus new item size
     usage_ += item_size;
-
-    // if usage exceed capacity, free some items
-    if (usage_ > capacity_) {
-        LOG_SERVER_DEBUG_ << header_ << " Current usage " << (usage_ >> 20) << "MB is too high for capacity "
-                         << (capacity_ >> 20) << "MB, start free memory";
-        free_memory_internal(capacity_);
-    }
+    account_group(key, item_size - (old_item ? old_item->Size() : 0), old_item ? 0 : 1);
 
     // insert new item
-    lru_.put(key, item);
+    shard.policy_->put(key, item);
     LOG_SERVER_DEBUG_ << header_ << " Insert " << key << " size: " << (item_size >> 20) << "MB into cache";
-    LOG_SERVER_DEBUG_ << header_ << " Count: " << lru_.size() << ", Usage: " << (usage_ >> 20) << "MB, Capacity: "
-                     << (capacity_ >> 20) << "MB";
+    LOG_SERVER_DEBUG_ << header_ << " Shard count: " << shard.policy_->size() << ", Usage: " << (usage_ >> 20)
+                      << "MB, Capacity: " << (capacity_ >> 20) << "MB";
+    return old_item;
 }
 
 template <typename ItemObj>
-void
-Cache<ItemObj>::erase_internal(const std::string& key) {
-    if (!lru_.exists(key)) {
-        return;
+ItemObj
+Cache<ItemObj>::erase_internal(Shard& shard, const std::string& key) {
+    if (!shard.policy_->exists(key)) {
+        return nullptr;
     }
 
-    const ItemObj& item = lru_.get(key);
+    ItemObj item = shard.policy_->peek(key);
     size_t item_size = item->Size();
 
-    lru_.erase(key);
+    shard.policy_->erase(key);
 
     usage_ -= item_size;
+    account_group(key, -(int64_t)item_size, -1);
     LOG_SERVER_DEBUG_ << header_ << " Erase " << key << " size: " << (item_size >> 20) << "MB from cache";
-    LOG_SERVER_DEBUG_ << header_ << " Count: " << lru_.size() << ", Usage: " << (usage_ >> 20) << "MB, Capacity: "
-                     << (capacity_ >> 20) << "MB";
+    LOG_SERVER_DEBUG_ << header_ << " Shard count: " << shard.policy_->size() << ", Usage: " << (usage_ >> 20)
+                      << "MB, Capacity: " << (capacity_ >> 20) << "MB";
+    return item;
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::free_memory_internal(const int64_t target_size) {
+Cache<ItemObj>::reclaim(std::vector<ItemObj>& items) {
+    auto& reclaimer = CacheReclaimer::GetInstance();
+    for (auto& item : items) {
+        reclaimer.Reclaim(std::move(item));
+    }
+    items.clear();
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::next_victim_frequency(const std::string& skip_key, size_t& frequency) {
+    std::lock_guard<std::mutex> evict_lock(evict_mutex_);
+
+    // same visiting order as free_memory, without moving the cursor
+    int64_t shard_num = shards_.size();
+    for (int64_t i = 0; i < shard_num; ++i) {
+        auto& shard = *shards_[(evict_cursor_ + i) % shard_num];
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+
+        bool found = false;
+        shard.policy_->visit_victims([&](const std::pair<std::string, ItemObj>& pair) {
+            if (pair.first != skip_key && !is_pinned(pair.first) && !(evict_guard_ && evict_guard_(pair.first))) {
+                frequency = shard.policy_->frequency(pair.first);
+                found = true;
+            }
+            return !found;
+        });
+        if (found) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::free_memory(const int64_t target_size, const std::string& skip_key) {
+    std::lock_guard<std::mutex> evict_lock(evict_mutex_);
+
     int64_t threshold = std::min((int64_t)(capacity_ * freemem_percent_), target_size);
     int64_t delta_size = usage_ - threshold;
     if (delta_size <= 0) {
-        delta_size = 1;  // ensure at least one item erased
+        return;  // memory has been released by a previous eviction pass
     }
 
-    std::set<std::string> key_array;
+    // each shard releases its share from the tail of its own LRU list, so that hot items of
+    // one shard are not evicted to make room for another one
+    int64_t shard_num = shards_.size();
+    int64_t shard_quota = std::max(delta_size / shard_num, (int64_t)1);
     int64_t released_size = 0;
 
-    auto it = lru_.rbegin();
-    while (it != lru_.rend() && released_size < delta_size) {
-        auto& key = it->first;
-        auto& obj_ptr = it->second;
+    while (released_size < delta_size) {
+        int64_t round_released = 0;
+        for (int64_t i = 0; i < shard_num && released_size < delta_size; ++i) {
+            auto& shard = *shards_[evict_cursor_++ % shard_num];
+            std::vector<ItemObj> evicted;
+            int64_t shard_released = 0;
+            {
+                std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+
+                std::set<std::string> key_array;
+                shard.policy_->visit_victims([&](const std::pair<std::string, ItemObj>& pair) {
+                    if (shard_released >= shard_quota || released_size + shard_released >= delta_size) {
+                        return false;
+                    }
+                    if (pair.first != skip_key && !is_pinned(pair.first) &&
+                        !(evict_guard_ && evict_guard_(pair.first))) {
+                        key_array.emplace(pair.first);
+                        shard_released += pair.second->Size();
+                    }
+                    return true;
+                });
 
-        key_array.emplace(key);
-        released_size += obj_ptr->Size();
-        ++it;
+                for (auto& key : key_array) {
+                    evicted.emplace_back(erase_internal(shard, key));
+                }
+            }
+            reclaim(evicted);
+            round_released += shard_released;
+            released_size += shard_released;
+        }
+
+        if (round_released == 0) {
+            break;  // nothing left to release
+        }
+    }
+
+    if (released_size < delta_size && (pinned_group_count_ > 0 || evict_guard_)) {
+        LOG_SERVER_WARNING_ << header_ << " Only " << (released_size >> 20) << "MB of " << (delta_size >> 20)
+                            << "MB released, the rest is pinned";
+    }
+    LOG_SERVER_DEBUG_ << header_ << " Released memory size: " << (released_size >> 20) << "MB";
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::free_group_memory(const std::string& group, const std::string& skip_key) {
+    if (group.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> evict_lock(evict_mutex_);
+
+    int64_t delta_size = 0;
+    {
+        std::lock_guard<std::mutex> lock(group_mutex_);
+        auto it = groups_.find(group);
+        if (it == groups_.end() || it->second.quota_ <= 0) {
+            return;
+        }
+        delta_size = it->second.usage_ - it->second.quota_;
+    }
+    if (delta_size <= 0) {
+        return;
+    }
+
+    int64_t shard_num = shards_.size();
+    int64_t released_size = 0;
+    for (int64_t i = 0; i < shard_num && released_size < delta_size; ++i) {
+        auto& shard = *shards_[evict_cursor_++ % shard_num];
+        std::vector<ItemObj> evicted;
+        {
+            std::lock_guard<InstrumentedMutex> lock(shard.mutex_);
+
+            std::vector<std::string> key_array;
+            shard.policy_->visit_victims([&](const std::pair<std::string, ItemObj>& pair) {
+                if (released_size >= delta_size) {
+                    return false;
+                }
+                if (pair.first != skip_key) {
+                    std::lock_guard<std::mutex> group_lock(group_mutex_);
+                    if (group_name_of(pair.first) == group) {
+                        key_array.emplace_back(pair.first);
+                        released_size += pair.second->Size();
+                    }
+                }
+                return true;
+            });
+
+            for (auto& key : key_array) {
+                evicted.emplace_back(erase_internal(shard, key));
+            }
+        }
+        reclaim(evicted);
+    }
+
+    LOG_SERVER_DEBUG_ << header_ << " Released memory size: " << (released_size >> 20) << "MB of group " << group;
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::set_group_quota(const std::string& group, int64_t quota, bool pinned,
+                                const std::vector<std::string>& aliases) {
+    if (group.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(group_mutex_);
+        auto& stat = groups_[group];
+        stat.name_ = group;
+        if (stat.pinned_ != pinned) {
+            pinned_group_count_ += pinned ? 1 : -1;
+        }
+        stat.quota_ = std::max(quota, (int64_t)0);
+        stat.pinned_ = pinned;
+
+        for (auto& alias : aliases) {
+            if (alias.empty() || alias == group) {
+                continue;
+            }
+            group_alias_[alias] = group;
+
+            // items cached before the alias was known move to the owner group
+            auto it = groups_.find(alias);
+            if (it != groups_.end()) {
+                stat.usage_ += it->second.usage_;
+                stat.item_count_ += it->second.item_count_;
+                stat.hit_count_ += it->second.hit_count_;
+                stat.miss_count_ += it->second.miss_count_;
+                if (it->second.pinned_) {
+                    --pinned_group_count_;
+                }
+                groups_.erase(it);
+            }
+        }
+    }
+
+    free_group_memory(group);
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::remove_group_quota(const std::string& group) {
+    std::lock_guard<std::mutex> lock(group_mutex_);
+    auto it = groups_.find(group);
+    if (it == groups_.end()) {
+        return;
+    }
+    if (it->second.pinned_) {
+        --pinned_group_count_;
+    }
+    it->second.quota_ = 0;
+    it->second.pinned_ = false;
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::group_stat(const std::string& group, CacheGroupStat& stat) const {
+    std::lock_guard<std::mutex> lock(group_mutex_);
+    auto it = groups_.find(group);
+    if (it == groups_.end()) {
+        return false;
+    }
+    stat = it->second;
+    return true;
+}
+
+template <typename ItemObj>
+std::vector<CacheGroupStat>
+Cache<ItemObj>::group_stats() const {
+    std::lock_guard<std::mutex> lock(group_mutex_);
+    std::vector<CacheGroupStat> stats;
+    stats.reserve(groups_.size());
+    for (auto& pair : groups_) {
+        stats.emplace_back(pair.second);
+    }
+    return stats;
+}
+
+template <typename ItemObj>
+std::string
+Cache<ItemObj>::group_name_of(const std::string& key) const {
+    if (!group_func_) {
+        return "";
     }
+    std::string group = group_func_(key);
+    auto it = group_alias_.find(group);
+    return (it == group_alias_.end()) ? group : it->second;
+}
 
-    LOG_SERVER_DEBUG_ << header_ << " To be released memory size: " << (released_size >> 20) << "MB";
+template <typename ItemObj>
+std::string
+Cache<ItemObj>::group_of(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(group_mutex_);
+    return group_name_of(key);
+}
 
-    for (auto& key : key_array) {
-        erase_internal(key);
+template <typename ItemObj>
+void
+Cache<ItemObj>::account_group(const std::string& key, int64_t size_delta, int64_t count_delta) {
+    if (!group_func_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(group_mutex_);
+    std::string group = group_name_of(key);
+    if (group.empty()) {
+        return;
+    }
+    auto& stat = groups_[group];
+    stat.name_ = group;
+    stat.usage_ += size_delta;
+    stat.item_count_ += count_delta;
+}
+
+template <typename ItemObj>
+bool
+Cache<ItemObj>::is_pinned(const std::string& key) const {
+    if (pinned_group_count_ == 0) {
+        return false;
     }
+    std::lock_guard<std::mutex> lock(group_mutex_);
+    auto it = groups_.find(group_name_of(key));
+    return it != groups_.end() && it->second.pinned_;
 }
 
 }  // namespace cache
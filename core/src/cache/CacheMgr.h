@@ -39,6 +39,10 @@ class CacheMgr {
     virtual void
     EraseItem(const std::string& key);
 
+    // insert data under key in place of old_key, false if data doesn't fit in the free capacity
+    virtual bool
+    ReplaceItem(const std::string& old_key, const std::string& key, const ItemObj& data);
+
     virtual bool
     Reserve(const int64_t size);
 
@@ -73,6 +73,17 @@ CacheMgr<ItemObj>::EraseItem(const std::string& key) {
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
 }
 
+template <typename ItemObj>
+bool
+CacheMgr<ItemObj>::ReplaceItem(const std::string& old_key, const std::string& key, const ItemObj& data) {
+    if (cache_ == nullptr) {
+        LOG_SERVER_ERROR_ << "Cache doesn't exist";
+        return false;
+    }
+    server::Metrics::GetInstance().CacheAccessTotalIncrement();
+    return cache_->replace(old_key, key, data);
+}
+
 template <typename ItemObj>
 bool
 CacheMgr<ItemObj>::Reserve(const int64_t size) {
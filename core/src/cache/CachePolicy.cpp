@@ -0,0 +1,32 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/CachePolicy.h"
+
+namespace milvus {
+namespace cache {
+
+const char* CACHE_POLICY_LRU = "lru";
+const char* CACHE_POLICY_TINY_LFU = "tinylfu";
+const char* CACHE_POLICY_GREEDY_DUAL = "cost";
+
+CachePolicyType
+ParseCachePolicyType(const std::string& name) {
+    if (name == CACHE_POLICY_TINY_LFU) {
+        return CachePolicyType::TINY_LFU;
+    } else if (name == CACHE_POLICY_GREEDY_DUAL) {
+        return CachePolicyType::GREEDY_DUAL;
+    }
+    return CachePolicyType::LRU;
+}
+
+}  // namespace cache
+}  // namespace milvus
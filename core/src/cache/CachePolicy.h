@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace milvus {
+namespace cache {
+
+enum class CachePolicyType {
+    LRU = 0,
+    TINY_LFU,
+    GREEDY_DUAL,
+};
+
+extern const char* CACHE_POLICY_LRU;
+extern const char* CACHE_POLICY_TINY_LFU;
+extern const char* CACHE_POLICY_GREEDY_DUAL;
+
+// unknown names fall back to LRU, names are validated by Config
+CachePolicyType
+ParseCachePolicyType(const std::string& name);
+
+/*
+ * Eviction policy of one cache shard. A policy only decides the eviction order and whether
+ * a new item is worth caching, memory accounting is done by Cache.
+ */
+template <typename key_t, typename value_t>
+class CachePolicy {
+ public:
+    typedef typename std::pair<key_t, value_t> key_value_pair_t;
+    using VisitFunc = std::function<bool(const key_value_pair_t&)>;
+
+    virtual ~CachePolicy() = default;
+
+    virtual void
+    put(const key_t& key, const value_t& value) = 0;
+
+    // throw std::range_error if key doesn't exist
+    virtual const value_t&
+    get(const key_t& key) = 0;
+
+    // same as get, but the lookup is not counted as an access, used for bookkeeping
+    virtual const value_t&
+    peek(const key_t& key) const = 0;
+
+    virtual void
+    erase(const key_t& key) = 0;
+
+    virtual bool
+    exists(const key_t& key) const = 0;
+
+    virtual size_t
+    size() const = 0;
+
+    virtual void
+    clear() = 0;
+
+    // record a lookup of key, called for both hits and misses
+    virtual void
+    access(const key_t& key) {
+    }
+
+    // popularity of key as seen by admit, comparable across shards of the same policy type
+    virtual size_t
+    frequency(const key_t& key) const {
+        return 0;
+    }
+
+    // whether key should be cached if its insertion requires evicting an item of victim_frequency,
+    // the victim may live in another shard
+    virtual bool
+    admit(const key_t& key, size_t victim_frequency) {
+        return true;
+    }
+
+    // visit items from the first to be evicted to the last one, stop when func returns false
+    virtual void
+    visit_victims(const VisitFunc& func) = 0;
+};
+
+template <typename key_t, typename value_t>
+using CachePolicyPtr = std::unique_ptr<CachePolicy<key_t, value_t>>;
+
+}  // namespace cache
+}  // namespace milvus
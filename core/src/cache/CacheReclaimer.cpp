@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/CacheReclaimer.h"
+#include "utils/Log.h"
+
+#include <utility>
+
+namespace milvus {
+namespace cache {
+
+CacheReclaimer&
+CacheReclaimer::GetInstance() {
+    static CacheReclaimer s_reclaimer;
+    return s_reclaimer;
+}
+
+void
+CacheReclaimer::Start(int64_t queue_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || queue_size <= 0) {
+        return;
+    }
+
+    queue_.SetCapacity(queue_size);
+    queue_.SetName("cache_reclaim_queue");
+    {
+        std::unique_lock<std::shared_mutex> reclaim_lock(reclaim_mutex_);
+        running_ = true;
+    }
+    worker_thread_ = std::thread(&CacheReclaimer::WorkerFunction, this);
+    LOG_SERVER_INFO_ << "Cache reclaimer started, queue size: " << queue_size;
+}
+
+void
+CacheReclaimer::Stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return;
+    }
+
+    {
+        // waits for the objects being enqueued, the later ones are released inline
+        std::unique_lock<std::shared_mutex> reclaim_lock(reclaim_mutex_);
+        running_ = false;
+    }
+    queue_.Put(nullptr);
+    if (worker_thread_.joinable()) {
+        worker_thread_.join();
+    }
+    LOG_SERVER_INFO_ << "Cache reclaimer stopped";
+}
+
+void
+CacheReclaimer::Reclaim(std::shared_ptr<void> obj) {
+    if (obj == nullptr) {
+        return;
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> reclaim_lock(reclaim_mutex_);
+        if (running_) {
+            queue_.Put(std::move(obj));
+            return;
+        }
+    }
+    // released by the caller, outside of the lock
+    obj.reset();
+}
+
+void
+CacheReclaimer::WorkerFunction() {
+    SetThreadName("cache_reclaim");
+    while (true) {
+        auto obj = queue_.Take();
+        if (obj == nullptr) {
+            break;
+        }
+        obj.reset();
+    }
+
+    // release objects queued before the stop signal
+    while (!queue_.Empty()) {
+        queue_.Take();
+    }
+}
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "utils/BlockingQueue.h"
+
+namespace milvus {
+namespace cache {
+
+/*
+ * Background thread releasing objects evicted from caches, so that destroying multi-GB
+ * indexes is not paid by the search which triggered the eviction.
+ * The queue is bounded: Reclaim() blocks when the reclaim thread falls behind, which limits
+ * the memory held by evicted but not yet released objects.
+ */
+class CacheReclaimer {
+ public:
+    static CacheReclaimer&
+    GetInstance();
+
+    // queue_size: max number of objects waiting to be released, 0 means release inline
+    void
+    Start(int64_t queue_size);
+
+    void
+    Stop();
+
+    bool
+    Running() const {
+        return running_;
+    }
+
+    int64_t
+    PendingCount() const {
+        return queue_.Size();
+    }
+
+    // drop the last reference of obj in the reclaim thread, obj is released inline if not running, also once Stop()
+    // has begun, so that nothing is left in the queue after the reclaim thread is gone
+    void
+    Reclaim(std::shared_ptr<void> obj);
+
+ private:
+    CacheReclaimer() = default;
+
+    void
+    WorkerFunction();
+
+ private:
+    std::atomic<bool> running_{false};
+    std::mutex mutex_;
+    // held shared by Reclaim() from the check of running_ to the end of the enqueue, exclusively to change running_
+    std::shared_mutex reclaim_mutex_;
+    std::thread worker_thread_;
+    BlockingQueue<std::shared_ptr<void>> queue_;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -11,8 +11,11 @@
 
 #include "cache/CpuCacheMgr.h"
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
+#include <faiss/utils/HugePage.h>
 #include <fiu-local.h>
 
 #include "config/Config.h"
@@ -24,6 +27,9 @@ namespace cache {
 namespace {
 // constexpr int64_t unit = 1024 * 1024 * 1024;
 constexpr int64_t unit = 1;
+
+// keep consistent with the collection folder of db/Utils.cpp
+const char* TABLES_FOLDER = "/tables/";
 }  // namespace
 
 CpuCacheMgr::CpuCacheMgr() {
@@ -35,14 +41,26 @@ CpuCacheMgr::CpuCacheMgr() {
     int64_t cap = cpu_cache_cap * unit;
     LOG_SERVER_DEBUG_ << "cpu cache.size: " << cap;
     LOG_SERVER_INFO_ << "cpu cache.size: " << cap;
-    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32, "[CACHE CPU]");
+
+    int64_t cpu_cache_shard_num;
+    config.GetCacheConfigCpuCacheShardNum(cpu_cache_shard_num);
+    LOG_SERVER_INFO_ << "cpu cache.shard_num: " << cpu_cache_shard_num;
+
+    std::string cpu_cache_policy;
+    config.GetCacheConfigCpuCachePolicy(cpu_cache_policy);
+    LOG_SERVER_INFO_ << "cpu cache.policy: " << cpu_cache_policy;
+    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32, "[CACHE CPU]", cpu_cache_shard_num,
+                                                 ParseCachePolicyType(cpu_cache_policy));
 
     float cpu_cache_threshold;
     config.GetCacheConfigCpuCacheThreshold(cpu_cache_threshold);
     cache_->set_freemem_percent(cpu_cache_threshold);
+    cache_->set_group_func(&CpuCacheMgr::CollectionOf);
 
     SetIdentity("CpuCacheMgr");
     AddCpuCacheCapacityListener();
+
+    memory_probe_.Set(MemorySubsystem::CPU_CACHE, [this] { return CacheUsage(); });
 }
 
 CpuCacheMgr*
@@ -57,6 +75,66 @@ CpuCacheMgr::GetIndex(const std::string& key) {
     return obj;
 }
 
+void
+CpuCacheMgr::SetCollectionQuota(const std::string& collection_id, int64_t quota, bool pinned,
+                                const std::vector<std::string>& partition_ids) {
+    LOG_SERVER_INFO_ << "Set cpu cache quota of collection " << collection_id << ": " << quota
+                     << ", pinned: " << pinned;
+    cache_->set_group_quota(collection_id, quota, pinned, partition_ids);
+}
+
+void
+CpuCacheMgr::RemoveCollectionQuota(const std::string& collection_id) {
+    cache_->remove_group_quota(collection_id);
+}
+
+bool
+CpuCacheMgr::GetCollectionStat(const std::string& collection_id, CacheGroupStat& stat) const {
+    return cache_->group_stat(collection_id, stat);
+}
+
+std::vector<CacheGroupStat>
+CpuCacheMgr::GetCollectionStats() const {
+    return cache_->group_stats();
+}
+
+std::string
+CpuCacheMgr::CollectionOf(const std::string& key) {
+    auto pos = key.rfind(TABLES_FOLDER);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += strlen(TABLES_FOLDER);
+    auto end = key.find('/', pos);
+    if (end == std::string::npos) {
+        return "";
+    }
+    return key.substr(pos, end - pos);
+}
+
+int64_t
+CpuCacheMgr::HugePageUsage() {
+    return faiss::huge_page_usage();
+}
+
+void
+CpuCacheMgr::EnforceMemoryLimit() {
+    int64_t limit = 0;
+    server::Config::GetInstance().GetCacheConfigMemoryLimit(limit);
+    if (limit <= 0 || cache_ == nullptr) {
+        return;
+    }
+
+    int64_t excess = MemoryAccounting::GetInstance().Total() - limit;
+    if (excess <= 0) {
+        return;
+    }
+    int64_t size = std::min(excess, CacheUsage());
+    LOG_SERVER_WARNING_ << "Memory usage exceeds the limit " << limit << " by " << excess << " bytes, release "
+                        << size << " bytes of cpu cache";
+    cache_->release(size);
+}
+
 void
 CpuCacheMgr::OnCpuCacheCapacityChanged(int64_t value) {
     SetCapacity(value * unit);
@@ -13,10 +13,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cache/CacheMgr.h"
 #include "cache/DataObj.h"
 #include "config/handler/CacheConfigHandler.h"
+#include "utils/MemoryAccounting.h"
 
 namespace milvus {
 namespace cache {
@@ -33,9 +35,41 @@ class CpuCacheMgr : public CacheMgr<DataObjPtr>, public server::CacheConfigHandl
     DataObjPtr
     GetIndex(const std::string& key);
 
+    // quota: max bytes the collection can occupy in cache, 0 means no quota
+    // pinned: segments of a pinned collection are only evicted to respect its own quota
+    // partitions are accounted to their owner collection
+    void
+    SetCollectionQuota(const std::string& collection_id, int64_t quota, bool pinned,
+                       const std::vector<std::string>& partition_ids);
+
+    void
+    RemoveCollectionQuota(const std::string& collection_id);
+
+    bool
+    GetCollectionStat(const std::string& collection_id, CacheGroupStat& stat) const;
+
+    std::vector<CacheGroupStat>
+    GetCollectionStats() const;
+
+    // collection id of a cache key, keys are segment file locations such as <path>/tables/<collection>/<segment>/<file>
+    static std::string
+    CollectionOf(const std::string& key);
+
+    // bytes of the process on transparent huge pages, which the cached indexes and raw vectors are allocated on
+    // when engine_config.huge_page is set
+    static int64_t
+    HugePageUsage();
+
+    // shrink the cache when the memory accounted by all subsystems exceeds cache.memory_limit
+    void
+    EnforceMemoryLimit();
+
  protected:
     void
     OnCpuCacheCapacityChanged(int64_t value) override;
+
+ private:
+    MemoryProbe memory_probe_;
 };
 
 }  // namespace cache
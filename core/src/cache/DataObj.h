@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace milvus {
@@ -20,6 +21,20 @@ class DataObj {
  public:
     virtual int64_t
     Size() = 0;
+
+    // milliseconds it took to load the object, used by the cost aware cache policy
+    int64_t
+    ReloadCost() const {
+        return reload_cost_;
+    }
+
+    void
+    SetReloadCost(int64_t cost) {
+        reload_cost_ = cost;
+    }
+
+ private:
+    int64_t reload_cost_ = 0;
 };
 
 using DataObjPtr = std::shared_ptr<DataObj>;
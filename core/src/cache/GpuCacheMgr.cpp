@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "cache/GpuCacheMgr.h"
+#include "cache/GpuResidencyMgr.h"
 #include "config/Config.h"
 #include "utils/Log.h"
 
@@ -36,11 +37,16 @@ GpuCacheMgr::GpuCacheMgr(int64_t gpu_id) : gpu_id_(gpu_id) {
     config.GetGpuResourceConfigCacheCapacity(gpu_cache_cap);
     int64_t cap = gpu_cache_cap * G_BYTE;
     std::string header = "[CACHE GPU" + std::to_string(gpu_id) + "]";
-    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32, header);
+
+    std::string gpu_cache_policy;
+    config.GetGpuResourceConfigCachePolicy(gpu_cache_policy);
+    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32, header, 1, ParseCachePolicyType(gpu_cache_policy));
 
     float gpu_mem_threshold;
     config.GetGpuResourceConfigCacheThreshold(gpu_mem_threshold);
     cache_->set_freemem_percent(gpu_mem_threshold);
+    cache_->set_evict_guard(
+        [gpu_id](const std::string& key) { return GpuResidencyMgr::GetInstance().Needed(gpu_id, key); });
 
     SetIdentity("GpuCacheMgr");
     AddGpuEnableListener();
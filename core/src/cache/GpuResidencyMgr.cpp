@@ -0,0 +1,231 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/GpuResidencyMgr.h"
+#include "cache/GpuCacheMgr.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+#ifdef MILVUS_GPU_VERSION
+GpuResidencyMgr&
+GpuResidencyMgr::GetInstance() {
+    static GpuResidencyMgr s_mgr;
+    return s_mgr;
+}
+
+void
+GpuResidencyMgr::Start(int64_t prefetch_depth) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || prefetch_depth <= 0) {
+        return;
+    }
+
+    prefetch_depth_ = prefetch_depth;
+    running_ = true;
+    LOG_SERVER_INFO_ << "Gpu residency manager started, prefetch depth: " << prefetch_depth;
+}
+
+void
+GpuResidencyMgr::Stop() {
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        fresh_devices_.clear();
+        for (auto& pair : devices_) {
+            if (pair.second->worker_.joinable()) {
+                workers.emplace_back(std::move(pair.second->worker_));
+            }
+        }
+    }
+
+    queue_cv_.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    LOG_SERVER_INFO_ << "Gpu residency manager stopped";
+}
+
+void
+GpuResidencyMgr::KeepFreshSegments(const std::vector<int64_t>& devices) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (devices.empty()) {
+        return;
+    }
+
+    fresh_devices_ = devices;
+    running_ = true;
+    LOG_SERVER_INFO_ << "Gpu residency manager keeps the fresh segments on " << devices.size() << " gpus";
+}
+
+int64_t
+GpuResidencyMgr::FreshSegmentDevice(const std::string& segment_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_ || fresh_devices_.empty()) {
+        return -1;
+    }
+    return fresh_devices_[std::hash<std::string>()(segment_id) % fresh_devices_.size()];
+}
+
+bool
+GpuResidencyMgr::Prefetch(int64_t device_id, const std::string& key, int64_t size, const CopyFunc& copy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return false;
+    }
+
+    auto device = DeviceOf(device_id);
+    if (device->in_flight_.find(key) != device->in_flight_.end()) {
+        return false;
+    }
+
+    if (!device->worker_.joinable()) {
+        device->worker_ = std::thread(&GpuResidencyMgr::WorkerFunction, this, device_id, device);
+    }
+    device->in_flight_.insert(key);
+    device->queue_.emplace_back(PrefetchJob{key, size, copy});
+    queue_cv_.notify_all();
+    return true;
+}
+
+void
+GpuResidencyMgr::Wait(int64_t device_id, const std::string& key) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = devices_.find(device_id);
+    if (iter == devices_.end()) {
+        return;
+    }
+    auto device = iter->second;
+
+    // not started yet, the caller copies by itself rather than waiting for the jobs queued before
+    auto& queue = device->queue_;
+    auto job = std::find_if(queue.begin(), queue.end(), [&](const PrefetchJob& job) { return job.key_ == key; });
+    if (job != queue.end()) {
+        queue.erase(job);
+        device->in_flight_.erase(key);
+        return;
+    }
+
+    done_cv_.wait(lock, [&] { return device->in_flight_.find(key) == device->in_flight_.end(); });
+}
+
+void
+GpuResidencyMgr::Acquire(int64_t device_id, const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++DeviceOf(device_id)->needed_[key];
+}
+
+void
+GpuResidencyMgr::Release(int64_t device_id, const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(device_id);
+    if (iter == devices_.end()) {
+        return;
+    }
+    auto& needed = iter->second->needed_;
+    auto count = needed.find(key);
+    if (count != needed.end() && --count->second <= 0) {
+        needed.erase(count);
+    }
+}
+
+bool
+GpuResidencyMgr::Needed(int64_t device_id, const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = devices_.find(device_id);
+    if (iter == devices_.end()) {
+        return false;
+    }
+    return iter->second->needed_.find(key) != iter->second->needed_.end();
+}
+
+GpuResidencyMgr::DevicePtr
+GpuResidencyMgr::DeviceOf(int64_t device_id) {
+    auto& device = devices_[device_id];
+    if (device == nullptr) {
+        device = std::make_shared<Device>();
+    }
+    return device;
+}
+
+void
+GpuResidencyMgr::WorkerFunction(int64_t device_id, DevicePtr device) {
+    SetThreadName("gpu_prefetch");
+    while (true) {
+        PrefetchJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queue_cv_.wait(lock, [&] { return !running_ || !device->queue_.empty(); });
+            if (!running_) {
+                for (auto& queued : device->queue_) {
+                    device->in_flight_.erase(queued.key_);
+                }
+                device->queue_.clear();
+                done_cv_.notify_all();
+                return;
+            }
+
+            job = std::move(device->queue_.front());
+            device->queue_.pop_front();
+        }
+
+        // the task may have finished while the job was queued
+        if (Needed(device_id, job.key_)) {
+            LoadToGpu(device_id, job);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            device->in_flight_.erase(job.key_);
+        }
+        done_cv_.notify_all();
+    }
+}
+
+void
+GpuResidencyMgr::LoadToGpu(int64_t device_id, const PrefetchJob& job) {
+    auto gpu_cache_mgr = GpuCacheMgr::GetInstance(device_id);
+    if (gpu_cache_mgr->ItemExists(job.key_)) {
+        return;
+    }
+
+    // only items no pending task needs can be evicted, give up if they don't make enough room
+    if (job.size_ > gpu_cache_mgr->CacheCapacity() - gpu_cache_mgr->CacheUsage()) {
+        gpu_cache_mgr->Reserve(job.size_);
+        if (job.size_ > gpu_cache_mgr->CacheCapacity() - gpu_cache_mgr->CacheUsage()) {
+            LOG_SERVER_DEBUG_ << "Skip prefetch " << job.key_ << " to gpu" << device_id << ", gpu cache is full";
+            return;
+        }
+    }
+
+    try {
+        auto obj = job.copy_();
+        if (obj != nullptr) {
+            gpu_cache_mgr->InsertItem(job.key_, obj);
+            LOG_SERVER_DEBUG_ << "Prefetched " << job.key_ << " to gpu" << device_id;
+        }
+    } catch (std::exception& ex) {
+        LOG_SERVER_ERROR_ << "Failed to prefetch " << job.key_ << " to gpu" << device_id << ": " << ex.what();
+    }
+}
+#endif
+
+}  // namespace cache
+}  // namespace milvus
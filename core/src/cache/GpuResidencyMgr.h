@@ -0,0 +1,126 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cache/DataObj.h"
+
+namespace milvus {
+namespace cache {
+
+#ifdef MILVUS_GPU_VERSION
+/*
+ * Keeps the index files of queued search tasks resident in GPU cache.
+ * Each device has a prefetch thread which copies the files of tasks waiting in the GPU task table while
+ * earlier tasks are searching. The copy takes its own faiss gpu resource, so it runs on a different cuda
+ * stream than the search. Files needed by pending tasks are protected from GpuCacheMgr eviction until
+ * the task releases them.
+ * The newly flushed segments can be kept resident too, each one is copied onto the search device picked
+ * by its segment id, so that it is searched there by brute force until its index is built.
+ */
+class GpuResidencyMgr {
+ public:
+    // performs the host to device copy, returns the gpu index
+    using CopyFunc = std::function<DataObjPtr()>;
+
+    static GpuResidencyMgr&
+    GetInstance();
+
+    // prefetch_depth: max number of queued tasks per device to prefetch for, 0 disables prefetch
+    void
+    Start(int64_t prefetch_depth);
+
+    void
+    Stop();
+
+    int64_t
+    PrefetchDepth() const {
+        return prefetch_depth_;
+    }
+
+    // keep the newly flushed segments resident on devices, runs the prefetch threads even without prefetch depth
+    void
+    KeepFreshSegments(const std::vector<int64_t>& devices);
+
+    // device a newly flushed segment is kept on, -1 if the fresh segments are not kept
+    int64_t
+    FreshSegmentDevice(const std::string& segment_id) const;
+
+    // queue an asynchronous copy of key onto device_id, the copied item is inserted into GpuCacheMgr
+    // return false if prefetch is not running or key is already queued
+    bool
+    Prefetch(int64_t device_id, const std::string& key, int64_t size, const CopyFunc& copy);
+
+    // block until the queued or running prefetch of key on device_id finishes
+    void
+    Wait(int64_t device_id, const std::string& key);
+
+    // a pending task needs key on device_id, it won't be evicted from GpuCacheMgr until released
+    void
+    Acquire(int64_t device_id, const std::string& key);
+
+    void
+    Release(int64_t device_id, const std::string& key);
+
+    bool
+    Needed(int64_t device_id, const std::string& key) const;
+
+ private:
+    GpuResidencyMgr() = default;
+
+    struct PrefetchJob {
+        std::string key_;
+        int64_t size_;
+        CopyFunc copy_;
+    };
+
+    struct Device {
+        std::deque<PrefetchJob> queue_;
+        std::unordered_set<std::string> in_flight_;
+        std::unordered_map<std::string, int64_t> needed_;
+        std::thread worker_;
+    };
+    using DevicePtr = std::shared_ptr<Device>;
+
+    DevicePtr
+    DeviceOf(int64_t device_id);
+
+    void
+    WorkerFunction(int64_t device_id, DevicePtr device);
+
+    void
+    LoadToGpu(int64_t device_id, const PrefetchJob& job);
+
+ private:
+    std::unordered_map<int64_t, DevicePtr> devices_;
+    bool running_ = false;
+    int64_t prefetch_depth_ = 0;
+    std::vector<int64_t> fresh_devices_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queue_cv_;
+    std::condition_variable done_cv_;
+};
+#endif
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,152 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/CachePolicy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace milvus {
+namespace cache {
+
+/*
+ * Cost aware policy (GreedyDual-Size). Every item gets the priority L + reload_cost / size,
+ * the item with the lowest priority is evicted first and L is raised to the priority of the
+ * evicted item, so items that are not hit again age out no matter how expensive they are.
+ * Cheap to reload or large items go first, which minimizes the reload time per byte freed.
+ * value_t must be a pointer-like type to an object providing Size() and ReloadCost().
+ */
+template <typename key_t, typename value_t>
+class GreedyDual : public CachePolicy<key_t, value_t> {
+ public:
+    typedef typename std::pair<key_t, value_t> key_value_pair_t;
+    typedef typename std::multimap<double, key_value_pair_t>::iterator queue_iterator_t;
+    using VisitFunc = typename CachePolicy<key_t, value_t>::VisitFunc;
+
+    explicit GreedyDual(size_t max_size) : max_size_(max_size) {
+    }
+
+    void
+    put(const key_t& key, const value_t& value) override {
+        auto it = items_map_.find(key);
+        if (it != items_map_.end()) {
+            queue_.erase(it->second);
+            items_map_.erase(it);
+        }
+
+        items_map_[key] = queue_.emplace(inflation_ + weight(value), key_value_pair_t(key, value));
+
+        if (items_map_.size() > max_size_) {
+            auto victim = queue_.begin();
+            items_map_.erase(victim->second.first);
+            remove(victim);
+        }
+    }
+
+    const value_t&
+    get(const key_t& key) override {
+        auto it = items_map_.find(key);
+        if (it == items_map_.end()) {
+            throw std::range_error("There is no such key in cache");
+        }
+
+        // a hit restores the full priority on top of the current inflation
+        auto node = queue_.extract(it->second);
+        node.key() = inflation_ + weight(node.mapped().second);
+        it->second = queue_.insert(std::move(node));
+        return it->second->second.second;
+    }
+
+    const value_t&
+    peek(const key_t& key) const override {
+        auto it = items_map_.find(key);
+        if (it == items_map_.end()) {
+            throw std::range_error("There is no such key in cache");
+        }
+        return it->second->second.second;
+    }
+
+    void
+    erase(const key_t& key) override {
+        auto it = items_map_.find(key);
+        if (it != items_map_.end()) {
+            remove(it->second);
+            items_map_.erase(it);
+        }
+    }
+
+    bool
+    exists(const key_t& key) const override {
+        return items_map_.find(key) != items_map_.end();
+    }
+
+    size_t
+    size() const override {
+        return items_map_.size();
+    }
+
+    void
+    clear() override {
+        queue_.clear();
+        items_map_.clear();
+        inflation_ = 0.0;
+    }
+
+    void
+    visit_victims(const VisitFunc& func) override {
+        for (auto& pair : queue_) {
+            if (!func(pair.second)) {
+                return;
+            }
+        }
+    }
+
+    double
+    inflation() const {
+        return inflation_;
+    }
+
+ private:
+    // reload cost in milliseconds per MB, unknown cost counts as 1ms so such items are ordered by size
+    static double
+    weight(const value_t& value) {
+        if (value == nullptr) {
+            return 0.0;
+        }
+        double cost = std::max(value->ReloadCost(), (int64_t)1);
+        double size = std::max(value->Size(), (int64_t)1);
+        return cost * 1048576.0 / size;
+    }
+
+    void
+    remove(queue_iterator_t it) {
+        if (it == queue_.begin()) {
+            inflation_ = std::max(inflation_, it->first);
+        }
+        queue_.erase(it);
+    }
+
+ private:
+    std::multimap<double, key_value_pair_t> queue_;
+    std::unordered_map<key_t, queue_iterator_t> items_map_;
+    size_t max_size_;
+    double inflation_ = 0.0;
+};
+
+}  // namespace cache
+}  // namespace milvus
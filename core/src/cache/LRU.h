@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "cache/CachePolicy.h"
+
 #include <cstddef>
 #include <list>
 #include <stdexcept>
@@ -21,9 +23,10 @@ namespace milvus {
 namespace cache {
 
 template <typename key_t, typename value_t>
-class LRU {
+class LRU : public CachePolicy<key_t, value_t> {
  public:
     typedef typename std::pair<key_t, value_t> key_value_pair_t;
+    using VisitFunc = typename CachePolicy<key_t, value_t>::VisitFunc;
     typedef typename std::list<key_value_pair_t>::iterator list_iterator_t;
     typedef typename std::list<key_value_pair_t>::reverse_iterator reverse_list_iterator_t;
 
@@ -31,7 +34,7 @@ class LRU {
     }
 
     void
-    put(const key_t& key, const value_t& value) {
+    put(const key_t& key, const value_t& value) override {
         auto it = cache_items_map_.find(key);
         cache_items_list_.push_front(key_value_pair_t(key, value));
         if (it != cache_items_map_.end()) {
@@ -49,7 +52,7 @@ class LRU {
     }
 
     const value_t&
-    get(const key_t& key) {
+    get(const key_t& key) override {
         auto it = cache_items_map_.find(key);
         if (it == cache_items_map_.end()) {
             throw std::range_error("There is no such key in cache");
@@ -59,8 +62,17 @@ class LRU {
         }
     }
 
+    const value_t&
+    peek(const key_t& key) const override {
+        auto it = cache_items_map_.find(key);
+        if (it == cache_items_map_.end()) {
+            throw std::range_error("There is no such key in cache");
+        }
+        return it->second->second;
+    }
+
     void
-    erase(const key_t& key) {
+    erase(const key_t& key) override {
         auto it = cache_items_map_.find(key);
         if (it != cache_items_map_.end()) {
             cache_items_list_.erase(it->second);
@@ -69,12 +81,12 @@ class LRU {
     }
 
     bool
-    exists(const key_t& key) const {
+    exists(const key_t& key) const override {
         return cache_items_map_.find(key) != cache_items_map_.end();
     }
 
     size_t
-    size() const {
+    size() const override {
         return cache_items_map_.size();
     }
 
@@ -100,11 +112,20 @@ class LRU {
     }
 
     void
-    clear() {
+    clear() override {
         cache_items_list_.clear();
         cache_items_map_.clear();
     }
 
+    void
+    visit_victims(const VisitFunc& func) override {
+        for (auto it = cache_items_list_.rbegin(); it != cache_items_list_.rend(); ++it) {
+            if (!func(*it)) {
+                break;
+            }
+        }
+    }
+
  private:
     std::list<key_value_pair_t> cache_items_list_;
     std::unordered_map<key_t, list_iterator_t> cache_items_map_;
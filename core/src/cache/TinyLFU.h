@@ -0,0 +1,256 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/CachePolicy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+/*
+ * Count-min sketch with 4 rows of saturating 8-bit counters. All counters are halved once
+ * every sample_size increments so that the popularity of old items fades out.
+ */
+template <typename key_t>
+class FrequencySketch {
+ public:
+    explicit FrequencySketch(size_t width) {
+        width_ = 16;
+        while (width_ < width) {
+            width_ <<= 1;
+        }
+        table_.assign(DEPTH * width_, 0);
+        sample_size_ = width_ * 10;
+    }
+
+    void
+    increment(const key_t& key) {
+        uint64_t hash = std::hash<key_t>()(key);
+        for (size_t i = 0; i < DEPTH; ++i) {
+            uint8_t& counter = table_[i * width_ + index_of(hash, i)];
+            if (counter < MAX_COUNT) {
+                ++counter;
+            }
+        }
+        if (++additions_ >= sample_size_) {
+            reset();
+        }
+    }
+
+    uint8_t
+    frequency(const key_t& key) const {
+        uint64_t hash = std::hash<key_t>()(key);
+        uint8_t freq = MAX_COUNT;
+        for (size_t i = 0; i < DEPTH; ++i) {
+            freq = std::min(freq, table_[i * width_ + index_of(hash, i)]);
+        }
+        return freq;
+    }
+
+    void
+    clear() {
+        std::fill(table_.begin(), table_.end(), 0);
+        additions_ = 0;
+    }
+
+ private:
+    size_t
+    index_of(uint64_t hash, size_t row) const {
+        static const uint64_t SEEDS[DEPTH] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+                                              0xcbf29ce484222325ULL};
+        uint64_t h = (hash + SEEDS[row]) * SEEDS[row];
+        h ^= h >> 32;
+        return h & (width_ - 1);
+    }
+
+    void
+    reset() {
+        for (auto& counter : table_) {
+            counter >>= 1;
+        }
+        additions_ /= 2;
+    }
+
+ private:
+    static constexpr size_t DEPTH = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+
+    std::vector<uint8_t> table_;
+    size_t width_;
+    size_t sample_size_;
+    size_t additions_ = 0;
+};
+
+/*
+ * Frequency aware policy: TinyLFU admission in front of a segmented LRU.
+ * New items enter the probation segment and are promoted to the protected segment on hit,
+ * so items touched only once (full scans, preload of cold collections) are evicted first.
+ * When an insertion needs to evict, the new key is only admitted if it has been requested
+ * more often than the item that would be evicted for it.
+ */
+template <typename key_t, typename value_t>
+class TinyLFU : public CachePolicy<key_t, value_t> {
+ public:
+    typedef typename std::pair<key_t, value_t> key_value_pair_t;
+    typedef typename std::list<key_value_pair_t>::iterator list_iterator_t;
+    using VisitFunc = typename CachePolicy<key_t, value_t>::VisitFunc;
+
+    // protected_percent: max percent of items kept in the protected segment
+    explicit TinyLFU(size_t max_size, size_t sketch_width = 4096, double protected_percent = 0.8)
+        : max_size_(max_size), sketch_(sketch_width), protected_percent_(protected_percent) {
+    }
+
+    void
+    put(const key_t& key, const value_t& value) override {
+        auto it = items_map_.find(key);
+        if (it != items_map_.end()) {
+            it->second.iter_->second = value;
+            touch(it->second);
+            return;
+        }
+
+        probation_list_.push_front(key_value_pair_t(key, value));
+        items_map_[key] = Entry{probation_list_.begin(), false};
+
+        if (items_map_.size() > max_size_) {
+            auto& victim_list = probation_list_.empty() ? protected_list_ : probation_list_;
+            items_map_.erase(victim_list.back().first);
+            victim_list.pop_back();
+        }
+    }
+
+    const value_t&
+    get(const key_t& key) override {
+        auto it = items_map_.find(key);
+        if (it == items_map_.end()) {
+            throw std::range_error("There is no such key in cache");
+        }
+        touch(it->second);
+        return it->second.iter_->second;
+    }
+
+    const value_t&
+    peek(const key_t& key) const override {
+        auto it = items_map_.find(key);
+        if (it == items_map_.end()) {
+            throw std::range_error("There is no such key in cache");
+        }
+        return it->second.iter_->second;
+    }
+
+    void
+    erase(const key_t& key) override {
+        auto it = items_map_.find(key);
+        if (it != items_map_.end()) {
+            list_of(it->second).erase(it->second.iter_);
+            items_map_.erase(it);
+        }
+    }
+
+    bool
+    exists(const key_t& key) const override {
+        return items_map_.find(key) != items_map_.end();
+    }
+
+    size_t
+    size() const override {
+        return items_map_.size();
+    }
+
+    void
+    clear() override {
+        probation_list_.clear();
+        protected_list_.clear();
+        items_map_.clear();
+        sketch_.clear();
+    }
+
+    void
+    access(const key_t& key) override {
+        sketch_.increment(key);
+    }
+
+    size_t
+    frequency(const key_t& key) const override {
+        return sketch_.frequency(key);
+    }
+
+    bool
+    admit(const key_t& key, size_t victim_frequency) override {
+        return sketch_.frequency(key) > victim_frequency;
+    }
+
+    void
+    visit_victims(const VisitFunc& func) override {
+        for (auto it = probation_list_.rbegin(); it != probation_list_.rend(); ++it) {
+            if (!func(*it)) {
+                return;
+            }
+        }
+        for (auto it = protected_list_.rbegin(); it != protected_list_.rend(); ++it) {
+            if (!func(*it)) {
+                return;
+            }
+        }
+    }
+
+ private:
+    struct Entry {
+        list_iterator_t iter_;
+        bool protected_;
+    };
+
+    std::list<key_value_pair_t>&
+    list_of(const Entry& entry) {
+        return entry.protected_ ? protected_list_ : probation_list_;
+    }
+
+    void
+    touch(Entry& entry) {
+        if (entry.protected_) {
+            protected_list_.splice(protected_list_.begin(), protected_list_, entry.iter_);
+            return;
+        }
+
+        // promote to protected segment, demote the coldest protected item if the segment is full
+        protected_list_.splice(protected_list_.begin(), probation_list_, entry.iter_);
+        entry.protected_ = true;
+
+        size_t protected_max = std::max((size_t)(items_map_.size() * protected_percent_), (size_t)1);
+        if (protected_list_.size() > protected_max) {
+            auto last = std::prev(protected_list_.end());
+            items_map_[last->first].protected_ = false;
+            probation_list_.splice(probation_list_.begin(), protected_list_, last);
+        }
+    }
+
+ private:
+    std::list<key_value_pair_t> probation_list_;
+    std::list<key_value_pair_t> protected_list_;
+    std::unordered_map<key_t, Entry> items_map_;
+    size_t max_size_;
+    FrequencySketch<key_t> sketch_;
+    double protected_percent_;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -41,6 +41,15 @@ class AttrsFormat {
     virtual void
     read_attrs(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name, off_t offset, size_t num_bytes,
                std::vector<uint8_t>& raw_attrs) = 0;
+
+    // the values at the row offsets, width bytes each, read with one open of the file
+    virtual void
+    read_attrs(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name, const std::vector<int64_t>& offsets,
+               size_t width, std::vector<uint8_t>& raw_attrs) = 0;
+
+    // the segment in fs_ptr directory has raw attribute files
+    virtual bool
+    has_attrs(const storage::FSHandlerPtr& fs_ptr) = 0;
 };
 
 using AttrsFormatPtr = std::shared_ptr<AttrsFormat>;
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 
+#include "segment/AttrZoneMap.h"
 #include "segment/AttrsIndex.h"
 #include "storage/FSHandler.h"
 
@@ -33,6 +34,10 @@ class AttrsIndexFormat {
 
     virtual void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::AttrsIndexPtr& attr_index) = 0;
+
+    // zone maps are written along with the attribute indexes, they are small enough to be read on every search
+    virtual void
+    read_zone_maps(const storage::FSHandlerPtr& fs_ptr, segment::AttrZoneMaps& zone_maps) = 0;
 };
 
 using AttrsIndexFormatPtr = std::shared_ptr<AttrsIndexFormat>;
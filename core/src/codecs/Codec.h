@@ -24,6 +24,7 @@
 #include "IdIndexFormat.h"
 #include "VectorCompressFormat.h"
 #include "VectorIndexFormat.h"
+#include "VectorSummaryFormat.h"
 #include "VectorsFormat.h"
 #include "utils/Exception.h"
 
@@ -62,6 +63,16 @@ class Codec {
         throw Exception(SERVER_UNSUPPORTED_ERROR, "id bloom filter not supported");
     }
 
+    virtual IdIndexFormatPtr
+    GetIdIndexFormat() {
+        throw Exception(SERVER_UNSUPPORTED_ERROR, "id index not supported");
+    }
+
+    virtual VectorSummaryFormatPtr
+    GetVectorSummaryFormat() {
+        throw Exception(SERVER_UNSUPPORTED_ERROR, "vector summary not supported");
+    }
+
     virtual VectorCompressFormatPtr
     GetVectorCompressFormat() {
         throw Exception(SERVER_UNSUPPORTED_ERROR, "vector compress not supported");
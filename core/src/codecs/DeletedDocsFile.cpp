@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/DeletedDocsFile.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+#include "segment/DeletedDocs.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+void
+ReadBytes(int fd, void* data, size_t bytes, const std::string& file_path) {
+    auto ptr = static_cast<uint8_t*>(data);
+    while (bytes > 0) {
+        auto n = ::read(fd, ptr, bytes);
+        if (n <= 0) {
+            std::string err_msg = "Failed to read from file: " + file_path + ", error: " +
+                                  (n == 0 ? std::string("unexpected end of file") : std::strerror(errno));
+            LOG_ENGINE_ERROR_ << err_msg;
+            ::close(fd);
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+        ptr += n;
+        bytes -= n;
+    }
+}
+
+int
+OpenForRead(const std::string& file_path) {
+    int fd = open(file_path.c_str(), O_RDONLY, 00664);
+    if (fd == -1) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+    return fd;
+}
+
+void
+Close(int fd, const std::string& file_path) {
+    if (::close(fd) == -1) {
+        std::string err_msg = "Failed to close file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+}
+
+}  // namespace
+
+void
+ReadDeletedDocsFile(const std::string& file_path, segment::RoaringBitmap& deleted_docs) {
+    int fd = OpenForRead(file_path);
+
+    deleted_docs.Clear();
+    size_t header;
+    ReadBytes(fd, &header, sizeof(size_t), file_path);
+    if (header != DELETED_DOCS_ROARING_MAGIC) {
+        // legacy layout, header is the byte count of the offsets
+        std::vector<segment::offset_t> offsets(header / sizeof(segment::offset_t));
+        ReadBytes(fd, offsets.data(), offsets.size() * sizeof(segment::offset_t), file_path);
+        for (auto offset : offsets) {
+            deleted_docs.Add(offset);
+        }
+        Close(fd, file_path);
+        return;
+    }
+
+    size_t sizes[2];
+    ReadBytes(fd, sizes, sizeof(sizes), file_path);
+    std::vector<uint8_t> buffer(sizes[1]);
+    ReadBytes(fd, buffer.data(), buffer.size(), file_path);
+    Close(fd, file_path);
+
+    if (!deleted_docs.Deserialize(buffer.data(), buffer.size()) || deleted_docs.Cardinality() != sizes[0]) {
+        std::string err_msg = "Corrupted deleted docs file: " + file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+}
+
+void
+ReadDeletedDocsFileSize(const std::string& file_path, size_t& size) {
+    int fd = OpenForRead(file_path);
+
+    size_t header;
+    ReadBytes(fd, &header, sizeof(size_t), file_path);
+    if (header != DELETED_DOCS_ROARING_MAGIC) {
+        size = header / sizeof(segment::offset_t);
+    } else {
+        ReadBytes(fd, &size, sizeof(size_t), file_path);
+    }
+    Close(fd, file_path);
+}
+
+void
+WriteDeletedDocsFile(const std::string& file_path, const segment::RoaringBitmap& deleted_docs) {
+    std::vector<uint8_t> buffer(3 * sizeof(size_t));
+    deleted_docs.Serialize(buffer);
+    size_t header[3] = {DELETED_DOCS_ROARING_MAGIC, deleted_docs.Cardinality(), buffer.size() - sizeof(header)};
+    std::memcpy(buffer.data(), header, sizeof(header));
+
+    int fd = open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 00664);
+    if (fd == -1) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+    if (::write(fd, buffer.data(), buffer.size()) != static_cast<ssize_t>(buffer.size())) {
+        std::string err_msg = "Failed to write to file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        ::close(fd);
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+    Close(fd, file_path);
+}
+
+}  // namespace codec
+}  // namespace milvus
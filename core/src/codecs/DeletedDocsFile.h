@@ -0,0 +1,46 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "segment/RoaringBitmap.h"
+
+namespace milvus {
+namespace codec {
+
+/*
+ * A deleted docs file of the legacy layout is a size_t byte count followed by the int32 offsets.
+ * Files are now written as:
+ *   size_t DELETED_DOCS_ROARING_MAGIC, size_t number of deleted docs, size_t bytes of the bitmap, the bitmap
+ * Both layouts are readable, a legacy file is converted by the next write.
+ * The functions throw Exception on io errors.
+ */
+constexpr size_t DELETED_DOCS_ROARING_MAGIC = 0x3130524f4c454452;  // "RDELOR01"
+
+void
+ReadDeletedDocsFile(const std::string& file_path, segment::RoaringBitmap& deleted_docs);
+
+void
+ReadDeletedDocsFileSize(const std::string& file_path, size_t& size);
+
+void
+WriteDeletedDocsFile(const std::string& file_path, const segment::RoaringBitmap& deleted_docs);
+
+}  // namespace codec
+}  // namespace milvus
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "index/knowhere/knowhere/common/BinarySet.h"
@@ -38,12 +39,29 @@ class VectorsFormat {
     virtual void
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) = 0;
 
+    // advice: expected access pattern, only used when the raw vectors are memory mapped
     virtual void
-    read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere::BinaryPtr& raw_vectors) = 0;
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere::BinaryPtr& raw_vectors,
+                 storage::MmapAdvice advice) = 0;
 
     virtual void
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) = 0;
+
+    // the vectors at the row offsets, width bytes each, read with one open of the file
+    virtual void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<int64_t>& offsets, size_t width,
+                 std::vector<uint8_t>& raw_vectors) = 0;
+
+    // the raw vector and uid files of the segment in fs_ptr directory, false unless both are in the plain layout
+    // whose rows can be copied by byte ranges
+    virtual bool
+    plain_files(const storage::FSHandlerPtr& fs_ptr, std::string& rv_path, std::string& uid_path) = 0;
+
+    // the raw vector and uid files written for the vectors named name
+    virtual void
+    file_paths(const storage::FSHandlerPtr& fs_ptr, const std::string& name, std::string& rv_path,
+               std::string& uid_path) = 0;
 };
 
 using VectorsFormatPtr = std::shared_ptr<VectorsFormat>;
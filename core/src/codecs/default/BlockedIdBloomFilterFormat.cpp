@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/BlockedIdBloomFilterFormat.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+constexpr size_t blocked_bloom_filter_capacity = 500000;
+constexpr double blocked_bloom_filter_error_rate = 0.01;
+constexpr uint64_t blocked_bloom_filter_magic = 0x31304642424c4252;  // "RBLBBF01"
+
+bool
+BlockedIdBloomFilterFormat::exists(const storage::FSHandlerPtr& fs_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    return boost::filesystem::exists(dir_path + "/" + bloom_filter_filename_);
+}
+
+void
+BlockedIdBloomFilterFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
+
+    std::vector<uint8_t> buffer;
+    int fd = open(bloom_filter_file_path.c_str(), O_RDONLY);
+    if (fd != -1) {
+        auto file_size = lseek(fd, 0, SEEK_END);
+        if (file_size > 0) {
+            buffer.resize(file_size);
+            if (pread(fd, buffer.data(), buffer.size(), 0) != file_size) {
+                buffer.clear();
+            }
+        }
+        ::close(fd);
+    }
+
+    uint64_t magic = 0;
+    if (buffer.size() >= sizeof(magic)) {
+        memcpy(&magic, buffer.data(), sizeof(magic));
+    }
+    auto blocked_filter = std::make_shared<segment::BlockedBloomFilter>();
+    if (magic != blocked_bloom_filter_magic ||
+        !blocked_filter->Deserialize(buffer.data() + sizeof(magic), buffer.size() - sizeof(magic))) {
+        std::string err_msg = "Failed to read bloom filter from file: " + bloom_filter_file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(blocked_filter);
+}
+
+void
+BlockedIdBloomFilterFormat::write(const storage::FSHandlerPtr& fs_ptr,
+                                  const segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
+
+    auto blocked_filter = id_bloom_filter_ptr->GetBlockedBloomFilter();
+    if (blocked_filter == nullptr) {
+        std::string err_msg = "Failed to write bloom filter to file: " + bloom_filter_file_path + ". Not blocked";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    std::vector<uint8_t> buffer(sizeof(blocked_bloom_filter_magic));
+    memcpy(buffer.data(), &blocked_bloom_filter_magic, sizeof(blocked_bloom_filter_magic));
+    blocked_filter->Serialize(buffer);
+
+    // Write to the temp file, in order to avoid possible race condition with search (concurrent read and write)
+    const std::string temp_path = bloom_filter_file_path + ".temp";
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 00664);
+    if (fd == -1) {
+        std::string err_msg = "Failed to open file: " + temp_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+    if (::write(fd, buffer.data(), buffer.size()) != static_cast<ssize_t>(buffer.size())) {
+        std::string err_msg = "Failed to write to file: " + temp_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        ::close(fd);
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+    if (::close(fd) == -1) {
+        std::string err_msg = "Failed to close file: " + temp_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    boost::filesystem::rename(temp_path, bloom_filter_file_path);
+}
+
+void
+BlockedIdBloomFilterFormat::create(const storage::FSHandlerPtr& fs_ptr,
+                                   segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    auto blocked_filter =
+        std::make_shared<segment::BlockedBloomFilter>(blocked_bloom_filter_capacity, blocked_bloom_filter_error_rate);
+    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(blocked_filter);
+}
+
+}  // namespace codec
+}  // namespace milvus
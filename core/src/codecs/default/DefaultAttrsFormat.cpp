@@ -16,6 +16,7 @@
 // under the License.
 
 #include "codecs/default/DefaultAttrsFormat.h"
+#include "codecs/default/RawDataCodec.h"
 
 #include <fcntl.h>
 #include <fiu-local.h>
@@ -56,6 +57,35 @@ DefaultAttrsFormat::read_attrs_internal(const storage::FSHandlerPtr& fs_ptr, con
     fs_ptr->reader_ptr_->close();
 }
 
+void
+DefaultAttrsFormat::read_attrs_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                        const std::vector<int64_t>& offsets, size_t width,
+                                        std::vector<uint8_t>& raw_attrs) {
+    if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    size_t nbytes;
+    fs_ptr->reader_ptr_->read(&nbytes, sizeof(size_t));
+
+    raw_attrs.resize(offsets.size() * width);
+    storage::ReadRequests requests;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (offsets[i] < 0 || (offsets[i] + 1) * width > nbytes) {
+            fs_ptr->reader_ptr_->close();
+            std::string err_msg = "Invalid offset " + std::to_string(offsets[i]) + " to read: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+        }
+        requests.emplace_back(raw_attrs.data() + i * width, sizeof(size_t) + offsets[i] * width, width);
+    }
+    fs_ptr->reader_ptr_->preadv(requests);
+
+    fs_ptr->reader_ptr_->close();
+}
+
 void
 DefaultAttrsFormat::read_uids_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                                        std::vector<int64_t>& uids) {
@@ -67,13 +97,15 @@ DefaultAttrsFormat::read_uids_internal(const storage::FSHandlerPtr& fs_ptr, cons
         throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
     }
 
-    size_t num_bytes;
-    fs_ptr->reader_ptr_->read(&num_bytes, sizeof(size_t));
+    // the uid file is written by the vectors format, it may be encoded
+    RawDataHeader header;
+    size_t num_bytes = ReadRawDataHeader(fs_ptr->reader_ptr_, file_path, header);
 
     uids.resize(num_bytes / sizeof(int64_t));
-    fs_ptr->reader_ptr_->read(uids.data(), num_bytes);
+    ReadRawData(fs_ptr->reader_ptr_, file_path, header, 0, uids.size() * sizeof(int64_t),
+                reinterpret_cast<uint8_t*>(uids.data()));
 
-    fs_ptr->reader_ptr_->read(uids.data(), num_bytes);
+    fs_ptr->reader_ptr_->close();
 }
 
 void
@@ -214,6 +246,32 @@ DefaultAttrsFormat::read_attrs(const milvus::storage::FSHandlerPtr& fs_ptr, cons
     }
 }
 
+void
+DefaultAttrsFormat::read_attrs(const milvus::storage::FSHandlerPtr& fs_ptr, const std::string& field_name,
+                               const std::vector<int64_t>& offsets, size_t width, std::vector<uint8_t>& raw_attrs) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        std::string file_name = path.filename().string();
+        if (path.extension().string() == raw_attr_extension_ &&
+            file_name.substr(0, file_name.size() - 3) == field_name) {
+            read_attrs_internal(fs_ptr, path.string(), offsets, width, raw_attrs);
+            break;
+        }
+    }
+}
+
 void
 DefaultAttrsFormat::read_uids(const milvus::storage::FSHandlerPtr& fs_ptr, std::vector<int64_t>& uids) {
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
@@ -238,5 +296,24 @@ DefaultAttrsFormat::read_uids(const milvus::storage::FSHandlerPtr& fs_ptr, std::
     }
 }
 
+bool
+DefaultAttrsFormat::has_attrs(const storage::FSHandlerPtr& fs_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        return false;
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        if (it->path().extension().string() == raw_attr_extension_) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -40,9 +40,16 @@ class DefaultAttrsFormat : public AttrsFormat {
     read_attrs(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name, off_t offset, size_t num_bytes,
                std::vector<uint8_t>& raw_attrs) override;
 
+    void
+    read_attrs(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name, const std::vector<int64_t>& offsets,
+               size_t width, std::vector<uint8_t>& raw_attrs) override;
+
     void
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<int64_t>& uids) override;
 
+    bool
+    has_attrs(const storage::FSHandlerPtr& fs_ptr) override;
+
     // No copy and move
     DefaultAttrsFormat(const DefaultAttrsFormat&) = delete;
     DefaultAttrsFormat(DefaultAttrsFormat&&) = delete;
@@ -57,6 +64,10 @@ class DefaultAttrsFormat : public AttrsFormat {
     read_attrs_internal(const storage::FSHandlerPtr& fs_ptr, const std::string&, off_t, size_t, std::vector<uint8_t>&,
                         size_t&);
 
+    void
+    read_attrs_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                        const std::vector<int64_t>& offsets, size_t width, std::vector<uint8_t>& raw_attrs);
+
     void
     read_uids_internal(const storage::FSHandlerPtr& fs_ptr, const std::string&, std::vector<int64_t>&);
 
@@ -23,9 +23,10 @@
 #include <boost/filesystem.hpp>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "db/meta/MetaTypes.h"
-#include "knowhere/index/structured_index/StructuredIndexSort.h"
+#include "knowhere/index/structured_index/StructuredIndexFactory.h"
 
 #include "utils/Exception.h"
 #include "utils/Log.h"
@@ -35,31 +36,32 @@ namespace milvus {
 namespace codec {
 
 knowhere::IndexPtr
-DefaultAttrsIndexFormat::create_structured_index(const milvus::engine::meta::hybrid::DataType data_type) {
+DefaultAttrsIndexFormat::create_structured_index(const milvus::engine::meta::hybrid::DataType data_type,
+                                                 const knowhere::BinarySet& index_binary) {
     knowhere::IndexPtr index = nullptr;
     switch (data_type) {
         case engine::meta::hybrid::DataType::INT8: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int8_t>>();
+            index = knowhere::CreateStructuredIndex<int8_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::INT16: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int16_t>>();
+            index = knowhere::CreateStructuredIndex<int16_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::INT32: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int32_t>>();
+            index = knowhere::CreateStructuredIndex<int32_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::INT64: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int64_t>>();
+            index = knowhere::CreateStructuredIndex<int64_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::FLOAT: {
-            index = std::make_shared<knowhere::StructuredIndexSort<float>>();
+            index = knowhere::CreateStructuredIndex<float>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::DOUBLE: {
-            index = std::make_shared<knowhere::StructuredIndexSort<double>>();
+            index = knowhere::CreateStructuredIndex<double>(index_binary);
             break;
         }
         default: {
@@ -129,7 +131,7 @@ DefaultAttrsIndexFormat::read_internal(const milvus::storage::FSHandlerPtr& fs_p
     double rate = length * 1000000.0 / span / 1024 / 1024;
     LOG_ENGINE_DEBUG_ << "read_index(" << path << ") rate " << rate << "MB/s";
 
-    index = create_structured_index((engine::meta::hybrid::DataType)data_type);
+    index = create_structured_index((engine::meta::hybrid::DataType)data_type, load_data_list);
 
     index->Load(load_data_list);
 
@@ -165,6 +167,61 @@ DefaultAttrsIndexFormat::read(const milvus::storage::FSHandlerPtr& fs_ptr,
     }
 }
 
+void
+DefaultAttrsIndexFormat::write_zone_map(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                        const segment::AttrIndexPtr& attr_index) {
+    auto zone_map = segment::AttrZoneMap::Build(attr_index->GetAttrIndex(), attr_index->GetDataType());
+    if (zone_map == nullptr) {
+        return;
+    }
+
+    std::vector<uint8_t> data;
+    zone_map->Serialize(data);
+    if (!fs_ptr->writer_ptr_->open(file_path)) {
+        LOG_ENGINE_ERROR_ << "Fail to open attribute zone map: " << file_path;
+        return;
+    }
+    fs_ptr->writer_ptr_->write(data.data(), data.size());
+    fs_ptr->writer_ptr_->close();
+}
+
+void
+DefaultAttrsIndexFormat::read_zone_maps(const storage::FSHandlerPtr& fs_ptr, segment::AttrZoneMaps& zone_maps) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() != zone_map_extension_) {
+            continue;
+        }
+        if (!fs_ptr->reader_ptr_->open(path.string())) {
+            LOG_ENGINE_WARNING_ << "Fail to open attribute zone map: " << path.string();
+            continue;
+        }
+        std::vector<uint8_t> data(fs_ptr->reader_ptr_->length());
+        fs_ptr->reader_ptr_->read(data.data(), data.size());
+        fs_ptr->reader_ptr_->close();
+
+        // a broken zone map only costs the pruning, the attribute index is still there
+        auto zone_map = segment::AttrZoneMap::Deserialize(data.data(), data.size());
+        if (zone_map == nullptr) {
+            LOG_ENGINE_WARNING_ << "Invalid attribute zone map: " << path.string();
+            continue;
+        }
+        zone_maps.insert(std::make_pair(path.stem().string(), zone_map));
+    }
+}
+
 void
 DefaultAttrsIndexFormat::write(const milvus::storage::FSHandlerPtr& fs_ptr,
                                const milvus::segment::AttrsIndexPtr& attrs_index) {
@@ -200,9 +257,10 @@ DefaultAttrsIndexFormat::write(const milvus::storage::FSHandlerPtr& fs_ptr,
             fs_ptr->writer_ptr_->write(&binary_length, sizeof(binary_length));
             fs_ptr->writer_ptr_->write((void*)binary->data.get(), binary_length);
         }
-    }
+        fs_ptr->writer_ptr_->close();
 
-    fs_ptr->writer_ptr_->close();
+        write_zone_map(fs_ptr, dir_path + "/" + field_name + zone_map_extension_, attr_it->second);
+    }
 
     double span = recorder.RecordSection("End");
     double rate = fs_ptr->writer_ptr_->length() * 1000000.0 / span / 1024 / 1024;
@@ -37,6 +37,9 @@ class DefaultAttrsIndexFormat : public AttrsIndexFormat {
     void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::AttrsIndexPtr& attr_index) override;
 
+    void
+    read_zone_maps(const storage::FSHandlerPtr& fs_ptr, segment::AttrZoneMaps& zone_maps) override;
+
     // No copy and move
     DefaultAttrsIndexFormat(const DefaultAttrsIndexFormat&) = delete;
     DefaultAttrsIndexFormat(DefaultAttrsIndexFormat&&) = delete;
@@ -52,10 +55,15 @@ class DefaultAttrsIndexFormat : public AttrsIndexFormat {
                   engine::meta::hybrid::DataType& attr_type);
 
     knowhere::IndexPtr
-    create_structured_index(const engine::meta::hybrid::DataType data_type);
+    create_structured_index(const engine::meta::hybrid::DataType data_type, const knowhere::BinarySet& index_binary);
+
+    void
+    write_zone_map(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                   const segment::AttrIndexPtr& attr_index);
 
  private:
     const std::string attr_index_extension_ = ".idx";
+    const std::string zone_map_extension_ = ".zm";
 };
 
 }  // namespace codec
@@ -23,8 +23,10 @@
 #include "DefaultAttrsIndexFormat.h"
 #include "DefaultDeletedDocsFormat.h"
 #include "DefaultIdBloomFilterFormat.h"
+#include "DefaultIdIndexFormat.h"
 #include "DefaultVectorCompressFormat.h"
 #include "DefaultVectorIndexFormat.h"
+#include "DefaultVectorSummaryFormat.h"
 #include "DefaultVectorsFormat.h"
 
 namespace milvus {
@@ -43,6 +45,8 @@ DefaultCodec::DefaultCodec() {
     attrs_index_format_ptr_ = std::make_shared<DefaultAttrsIndexFormat>();
     deleted_docs_format_ptr_ = std::make_shared<DefaultDeletedDocsFormat>();
     id_bloom_filter_format_ptr_ = std::make_shared<DefaultIdBloomFilterFormat>();
+    id_index_format_ptr_ = std::make_shared<DefaultIdIndexFormat>();
+    vector_summary_format_ptr_ = std::make_shared<DefaultVectorSummaryFormat>();
     vector_compress_format_ptr_ = std::make_shared<DefaultVectorCompressFormat>();
 }
 
@@ -76,6 +80,16 @@ DefaultCodec::GetIdBloomFilterFormat() {
     return id_bloom_filter_format_ptr_;
 }
 
+IdIndexFormatPtr
+DefaultCodec::GetIdIndexFormat() {
+    return id_index_format_ptr_;
+}
+
+VectorSummaryFormatPtr
+DefaultCodec::GetVectorSummaryFormat() {
+    return vector_summary_format_ptr_;
+}
+
 VectorCompressFormatPtr
 DefaultCodec::GetVectorCompressFormat() {
     return vector_compress_format_ptr_;
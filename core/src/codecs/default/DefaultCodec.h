@@ -45,6 +45,12 @@ class DefaultCodec : public Codec {
     IdBloomFilterFormatPtr
     GetIdBloomFilterFormat() override;
 
+    IdIndexFormatPtr
+    GetIdIndexFormat() override;
+
+    VectorSummaryFormatPtr
+    GetVectorSummaryFormat() override;
+
     VectorCompressFormatPtr
     GetVectorCompressFormat() override;
 
@@ -58,6 +64,8 @@ class DefaultCodec : public Codec {
     AttrsIndexFormatPtr attrs_index_format_ptr_;
     DeletedDocsFormatPtr deleted_docs_format_ptr_;
     IdBloomFilterFormatPtr id_bloom_filter_format_ptr_;
+    IdIndexFormatPtr id_index_format_ptr_;
+    VectorSummaryFormatPtr vector_summary_format_ptr_;
     VectorCompressFormatPtr vector_compress_format_ptr_;
 };
 
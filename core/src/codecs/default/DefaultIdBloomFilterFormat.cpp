@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 
+#include "config/Config.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 
@@ -32,6 +33,10 @@ constexpr double bloom_filter_error_rate = 0.01;
 
 void
 DefaultIdBloomFilterFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    if (blocked_format_.exists(fs_ptr)) {
+        return blocked_format_.read(fs_ptr, id_bloom_filter_ptr);
+    }
+
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
     scaling_bloom_t* bloom_filter =
@@ -49,6 +54,10 @@ DefaultIdBloomFilterFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::I
 void
 DefaultIdBloomFilterFormat::write(const storage::FSHandlerPtr& fs_ptr,
                                   const segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    if (id_bloom_filter_ptr->GetBlockedBloomFilter() != nullptr) {
+        return blocked_format_.write(fs_ptr, id_bloom_filter_ptr);
+    }
+
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
     if (scaling_bloom_flush(id_bloom_filter_ptr->GetBloomFilter()) == -1) {
@@ -62,6 +71,12 @@ DefaultIdBloomFilterFormat::write(const storage::FSHandlerPtr& fs_ptr,
 void
 DefaultIdBloomFilterFormat::create(const storage::FSHandlerPtr& fs_ptr,
                                    segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    bool blocked = false;
+    server::Config::GetInstance().GetStorageConfigBlockedBloomFilter(blocked);
+    if (blocked) {
+        return blocked_format_.create(fs_ptr, id_bloom_filter_ptr);
+    }
+
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
     scaling_bloom_t* bloom_filter =
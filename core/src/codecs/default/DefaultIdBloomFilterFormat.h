@@ -20,12 +20,14 @@
 #include <string>
 
 #include "codecs/IdBloomFilterFormat.h"
+#include "codecs/default/BlockedIdBloomFilterFormat.h"
 #include "segment/IdBloomFilter.h"
 #include "storage/disk/DiskOperation.h"
 
 namespace milvus {
 namespace codec {
 
+// Creates the filters of new segments in the layout chosen by storage.blocked_bloom_filter and reads either layout
 class DefaultIdBloomFilterFormat : public IdBloomFilterFormat {
  public:
     DefaultIdBloomFilterFormat() = default;
@@ -50,6 +52,7 @@ class DefaultIdBloomFilterFormat : public IdBloomFilterFormat {
 
  private:
     const std::string bloom_filter_filename_ = "bloom_filter";
+    BlockedIdBloomFilterFormat blocked_format_;
 };
 
 }  // namespace codec
@@ -16,6 +16,7 @@
 // under the License.
 
 #include <boost/filesystem.hpp>
+#include <cstring>
 #include <memory>
 
 #include "codecs/default/DefaultCodec.h"
@@ -50,12 +51,21 @@ DefaultVectorIndexFormat::read_internal(const storage::FSHandlerPtr& fs_ptr, con
     }
 
     int64_t rp = 0;
-    fs_ptr->reader_ptr_->seekg(0);
-
     int32_t current_type = 0;
-    fs_ptr->reader_ptr_->read(&current_type, sizeof(current_type));
-    rp += sizeof(current_type);
-    fs_ptr->reader_ptr_->seekg(rp);
+
+    // deserialize from the page cache directly instead of copying the whole file onto the heap first,
+    // the mapping is released once the index is built unless the index keeps the binaries
+    auto mapping = fs_ptr->reader_ptr_->mmap(0, length, storage::MmapAdvice::SEQUENTIAL);
+    if (mapping != nullptr && parse_mapped_internal(mapping, length, current_type, load_data_list)) {
+        LOG_ENGINE_DEBUG_ << "Mapped index file " << path << " length: " << length << " bytes";
+        rp = length;
+    } else {
+        load_data_list.clear();
+        fs_ptr->reader_ptr_->seekg(0);
+        fs_ptr->reader_ptr_->read(&current_type, sizeof(current_type));
+        rp += sizeof(current_type);
+        fs_ptr->reader_ptr_->seekg(rp);
+    }
 
     LOG_ENGINE_DEBUG_ << "Start to read_index(" << path << ") length: " << length << " bytes";
     while (rp < length) {
@@ -90,8 +100,8 @@ DefaultVectorIndexFormat::read_internal(const storage::FSHandlerPtr& fs_ptr, con
     LOG_ENGINE_DEBUG_ << "read_index(" << path << ") rate " << rate << "MB/s";
 
     knowhere::VecIndexFactory& vec_index_factory = knowhere::VecIndexFactory::GetInstance();
-    auto index =
-        vec_index_factory.CreateVecIndex(knowhere::OldIndexTypeToStr(current_type), knowhere::IndexMode::MODE_CPU);
+    auto index = vec_index_factory.CreateVecIndex(knowhere::OldIndexTypeToStr(current_type), load_data_list,
+                                                  knowhere::IndexMode::MODE_CPU);
     if (index != nullptr) {
         if (extern_data != nullptr) {
             LOG_ENGINE_DEBUG_ << "load index with " << extern_key << " " << extern_data->size;
@@ -108,6 +118,46 @@ DefaultVectorIndexFormat::read_internal(const storage::FSHandlerPtr& fs_ptr, con
     return index;
 }
 
+bool
+DefaultVectorIndexFormat::parse_mapped_internal(const std::shared_ptr<uint8_t[]>& mapping, int64_t length,
+                                                int32_t& index_type, knowhere::BinarySet& binary_set) {
+    uint8_t* data = mapping.get();
+    int64_t rp = 0;
+    auto read_value = [&](void* value, int64_t size) {
+        if (size > length - rp) {
+            return false;
+        }
+        memcpy(value, data + rp, size);
+        rp += size;
+        return true;
+    };
+
+    if (!read_value(&index_type, sizeof(index_type))) {
+        return false;
+    }
+
+    while (rp < length) {
+        size_t meta_length;
+        if (!read_value(&meta_length, sizeof(meta_length)) || meta_length > (size_t)(length - rp)) {
+            return false;
+        }
+        std::string meta(reinterpret_cast<char*>(data + rp), meta_length);
+        rp += meta_length;
+
+        size_t bin_length;
+        if (!read_value(&bin_length, sizeof(bin_length)) || bin_length > (size_t)(length - rp)) {
+            return false;
+        }
+
+        // shares the ownership of the whole mapping
+        std::shared_ptr<uint8_t[]> binptr(mapping, data + rp);
+        binary_set.Append(meta, binptr, bin_length);
+        binary_set.GetByName(meta)->mapped = true;
+        rp += bin_length;
+    }
+    return true;
+}
+
 void
 DefaultVectorIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, const std::string& location,
                                ExternalData externalData, segment::VectorIndexPtr& vector_index) {
@@ -127,7 +177,8 @@ DefaultVectorIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, const std::s
         case ExternalData_RawData: {
             auto& default_codec = codec::DefaultCodec::instance();
             knowhere::BinaryPtr raw_data = nullptr;
-            default_codec.GetVectorsFormat()->read_vectors(fs_ptr, raw_data);
+            // the index keeps the raw data and accesses it in the order of graph or inverted lists
+            default_codec.GetVectorsFormat()->read_vectors(fs_ptr, raw_data, storage::MmapAdvice::RANDOM);
 
             index = read_internal(fs_ptr, location, RAW_DATA, raw_data);
             break;
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "codecs/VectorIndexFormat.h"
@@ -49,6 +50,11 @@ class DefaultVectorIndexFormat : public VectorIndexFormat {
     knowhere::VecIndexPtr
     read_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& path, const std::string& extern_key = "",
                   const knowhere::BinaryPtr& extern_data = nullptr);
+
+    // split a mapped index file into binaries pointing into the mapping, return false if the file is broken
+    bool
+    parse_mapped_internal(const std::shared_ptr<uint8_t[]>& mapping, int64_t length, int32_t& index_type,
+                          knowhere::BinarySet& binary_set);
 };
 
 }  // namespace codec
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "codecs/default/DefaultVectorSummaryFormat.h"
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+constexpr uint64_t vector_summary_magic = 0x31304d4d55535648;  // "HVSUMM01"
+
+void
+DefaultVectorSummaryFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::VectorSummaryPtr& vector_summary) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string vector_summary_file_path = dir_path + "/" + vector_summary_filename_;
+
+    vector_summary = nullptr;
+    if (!boost::filesystem::exists(vector_summary_file_path)) {
+        return;
+    }
+
+    if (!fs_ptr->reader_ptr_->open(vector_summary_file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + vector_summary_file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    std::vector<uint8_t> buffer(fs_ptr->reader_ptr_->length());
+    fs_ptr->reader_ptr_->read(buffer.data(), buffer.size());
+    fs_ptr->reader_ptr_->close();
+
+    uint64_t magic = 0;
+    if (buffer.size() >= sizeof(magic)) {
+        memcpy(&magic, buffer.data(), sizeof(magic));
+    }
+    auto summary = std::make_shared<segment::VectorSummary>();
+    if (magic != vector_summary_magic ||
+        !summary->Deserialize(buffer.data() + sizeof(magic), buffer.size() - sizeof(magic))) {
+        std::string err_msg = "Failed to read vector summary from file: " + vector_summary_file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    vector_summary = summary;
+}
+
+void
+DefaultVectorSummaryFormat::write(const storage::FSHandlerPtr& fs_ptr,
+                                  const segment::VectorSummaryPtr& vector_summary) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string vector_summary_file_path = dir_path + "/" + vector_summary_filename_;
+
+    std::vector<uint8_t> buffer(sizeof(vector_summary_magic));
+    memcpy(buffer.data(), &vector_summary_magic, sizeof(vector_summary_magic));
+    vector_summary->Serialize(buffer);
+
+    if (!fs_ptr->writer_ptr_->open(vector_summary_file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + vector_summary_file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+    fs_ptr->writer_ptr_->write(buffer.data(), buffer.size());
+    fs_ptr->writer_ptr_->close();
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -0,0 +1,52 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <string>
+
+#include "codecs/VectorSummaryFormat.h"
+
+namespace milvus {
+namespace codec {
+
+class DefaultVectorSummaryFormat : public VectorSummaryFormat {
+ public:
+    DefaultVectorSummaryFormat() = default;
+
+    void
+    read(const storage::FSHandlerPtr& fs_ptr, segment::VectorSummaryPtr& vector_summary) override;
+
+    void
+    write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorSummaryPtr& vector_summary) override;
+
+    // No copy and move
+    DefaultVectorSummaryFormat(const DefaultVectorSummaryFormat&) = delete;
+    DefaultVectorSummaryFormat(DefaultVectorSummaryFormat&&) = delete;
+
+    DefaultVectorSummaryFormat&
+    operator=(const DefaultVectorSummaryFormat&) = delete;
+    DefaultVectorSummaryFormat&
+    operator=(DefaultVectorSummaryFormat&&) = delete;
+
+ private:
+    const std::string vector_summary_filename_ = "vector_summary";
+};
+
+}  // namespace codec
+}  // namespace milvus
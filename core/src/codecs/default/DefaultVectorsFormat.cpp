@@ -23,7 +23,10 @@
 #include <memory>
 
 #include <boost/filesystem.hpp>
+#include <faiss/utils/HugePage.h>
 
+#include "codecs/default/RawDataCodec.h"
+#include "config/Config.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -40,40 +43,81 @@ DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr,
         throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
     }
 
-    size_t num_bytes;
-    fs_ptr->reader_ptr_->read(&num_bytes, sizeof(size_t));
+    RawDataHeader header;
+    size_t num_bytes = ReadRawDataHeader(fs_ptr->reader_ptr_, file_path, header);
 
-    num = std::min(num, num_bytes - offset);
-
-    offset += sizeof(size_t);  // Beginning of file is num_bytes
-    fs_ptr->reader_ptr_->seekg(offset);
+    num = (size_t)offset < num_bytes ? std::min(num, num_bytes - offset) : 0;
 
     raw_vectors.resize(num / sizeof(uint8_t));
-    fs_ptr->reader_ptr_->read(raw_vectors.data(), num);
+    ReadRawData(fs_ptr->reader_ptr_, file_path, header, offset, num, raw_vectors.data());
 
     fs_ptr->reader_ptr_->close();
 }
 
 void
 DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
-                                            knowhere::BinaryPtr& raw_vectors) {
+                                            knowhere::BinaryPtr& raw_vectors, storage::MmapAdvice advice) {
     if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
         std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
         LOG_ENGINE_ERROR_ << err_msg;
         throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
     }
 
-    size_t num_bytes;
-    fs_ptr->reader_ptr_->read(&num_bytes, sizeof(size_t));
+    RawDataHeader header;
+    size_t num_bytes = ReadRawDataHeader(fs_ptr->reader_ptr_, file_path, header);
 
     raw_vectors = std::make_shared<knowhere::Binary>();
     raw_vectors->size = num_bytes;
-    raw_vectors->data = std::shared_ptr<uint8_t[]>(new uint8_t[num_bytes]);
 
-    // Beginning of file is num_bytes
-    fs_ptr->reader_ptr_->seekg(sizeof(size_t));
+    // share the pages with the os page cache instead of copying them onto the heap, encoded files must be decoded
+    bool mmap_enable = false;
+    server::Config::GetInstance().GetStorageConfigRawVectorMmap(mmap_enable);
+    if (mmap_enable && header.magic_ != RAW_DATA_MAGIC) {
+        raw_vectors->data = fs_ptr->reader_ptr_->mmap(sizeof(size_t), num_bytes, advice);
+        if (raw_vectors->data != nullptr) {
+            fs_ptr->reader_ptr_->close();
+            return;
+        }
+        LOG_ENGINE_WARNING_ << "Failed to mmap " << file_path << ", read it instead";
+    }
+
+    // the cached raw vectors are searched at random, they are given huge pages when engine_config.huge_page is set
+    auto data = static_cast<uint8_t*>(faiss::alloc_huge_page(num_bytes));
+    if (data == nullptr) {
+        fs_ptr->reader_ptr_->close();
+        std::string err_msg = "Failed to allocate " + std::to_string(num_bytes) + " bytes to read " + file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    raw_vectors->data = std::shared_ptr<uint8_t[]>(data, free);
+    ReadRawData(fs_ptr->reader_ptr_, file_path, header, 0, num_bytes, raw_vectors->data.get());
+
+    fs_ptr->reader_ptr_->close();
+}
+
+void
+DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                            const std::vector<int64_t>& offsets, size_t width,
+                                            std::vector<uint8_t>& raw_vectors) {
+    if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    RawDataHeader header;
+    size_t num_bytes = ReadRawDataHeader(fs_ptr->reader_ptr_, file_path, header);
 
-    fs_ptr->reader_ptr_->read(raw_vectors->data.get(), num_bytes);
+    raw_vectors.resize(offsets.size() * width);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (offsets[i] < 0 || (offsets[i] + 1) * width > num_bytes) {
+            fs_ptr->reader_ptr_->close();
+            std::string err_msg = "Invalid offset " + std::to_string(offsets[i]) + " to read: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+        }
+        ReadRawData(fs_ptr->reader_ptr_, file_path, header, offsets[i] * width, width, raw_vectors.data() + i * width);
+    }
 
     fs_ptr->reader_ptr_->close();
 }
@@ -87,11 +131,12 @@ DefaultVectorsFormat::read_uids_internal(const storage::FSHandlerPtr& fs_ptr, co
         throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
     }
 
-    size_t num_bytes;
-    fs_ptr->reader_ptr_->read(&num_bytes, sizeof(size_t));
+    RawDataHeader header;
+    size_t num_bytes = ReadRawDataHeader(fs_ptr->reader_ptr_, file_path, header);
 
     uids.resize(num_bytes / sizeof(segment::doc_id_t));
-    fs_ptr->reader_ptr_->read(uids.data(), num_bytes);
+    ReadRawData(fs_ptr->reader_ptr_, file_path, header, 0, uids.size() * sizeof(segment::doc_id_t),
+                reinterpret_cast<uint8_t*>(uids.data()));
 
     fs_ptr->reader_ptr_->close();
 }
@@ -132,6 +177,9 @@ DefaultVectorsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::
 
     TimeRecorder rc("write vectors");
 
+    bool compress = false;
+    server::Config::GetInstance().GetStorageConfigRawDataCompress(compress);
+
     if (!fs_ptr->writer_ptr_->open(rv_file_path.c_str())) {
         std::string err_msg = "Failed to open file: " + rv_file_path + ", error: " + std::strerror(errno);
         LOG_ENGINE_ERROR_ << err_msg;
@@ -139,8 +187,7 @@ DefaultVectorsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::
     }
 
     size_t rv_num_bytes = vectors->GetData().size() * sizeof(uint8_t);
-    fs_ptr->writer_ptr_->write(&rv_num_bytes, sizeof(size_t));
-    fs_ptr->writer_ptr_->write((void*)vectors->GetData().data(), rv_num_bytes);
+    WriteRawData(fs_ptr->writer_ptr_, RawDataCodecType::BYTE_PLANE, vectors->GetData().data(), rv_num_bytes, compress);
     fs_ptr->writer_ptr_->close();
 
     rc.RecordSection("write rv done");
@@ -151,8 +198,8 @@ DefaultVectorsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::
         throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
     }
     size_t uid_num_bytes = vectors->GetUids().size() * sizeof(segment::doc_id_t);
-    fs_ptr->writer_ptr_->write(&uid_num_bytes, sizeof(size_t));
-    fs_ptr->writer_ptr_->write((void*)vectors->GetUids().data(), uid_num_bytes);
+    WriteRawData(fs_ptr->writer_ptr_, RawDataCodecType::DELTA_INT64, vectors->GetUids().data(), uid_num_bytes,
+                 compress);
     fs_ptr->writer_ptr_->close();
 
     rc.RecordSection("write uids done");
@@ -182,7 +229,8 @@ DefaultVectorsFormat::read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector
 }
 
 void
-DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere::BinaryPtr& raw_vectors) {
+DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere::BinaryPtr& raw_vectors,
+                                   storage::MmapAdvice advice) {
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     if (!boost::filesystem::is_directory(dir_path)) {
         std::string err_msg = "Directory: " + dir_path + "does not exist";
@@ -198,7 +246,7 @@ DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere
     for (; it != it_end; ++it) {
         const auto& path = it->path();
         if (path.extension().string() == raw_vector_extension_) {
-            read_vectors_internal(fs_ptr, path.string(), raw_vectors);
+            read_vectors_internal(fs_ptr, path.string(), raw_vectors, advice);
             break;
         }
     }
@@ -228,5 +276,59 @@ DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t of
     }
 }
 
+void
+DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<int64_t>& offsets,
+                                   size_t width, std::vector<uint8_t>& raw_vectors) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == raw_vector_extension_) {
+            read_vectors_internal(fs_ptr, path.string(), offsets, width, raw_vectors);
+            break;
+        }
+    }
+}
+
+bool
+DefaultVectorsFormat::plain_files(const storage::FSHandlerPtr& fs_ptr, std::string& rv_path, std::string& uid_path) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        return false;
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == raw_vector_extension_) {
+            // the attributes keep their own uid file, the one of the vectors is named after them
+            file_paths(fs_ptr, path.stem().string(), rv_path, uid_path);
+            size_t rv_size = 0, uid_size = 0;
+            return ReadPlainRawDataSize(rv_path, rv_size) && ReadPlainRawDataSize(uid_path, uid_size);
+        }
+    }
+    return false;
+}
+
+void
+DefaultVectorsFormat::file_paths(const storage::FSHandlerPtr& fs_ptr, const std::string& name, std::string& rv_path,
+                                 std::string& uid_path) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    rv_path = dir_path + "/" + name + raw_vector_extension_;
+    uid_path = dir_path + "/" + name + user_id_extension_;
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -40,12 +40,24 @@ class DefaultVectorsFormat : public VectorsFormat {
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) override;
 
     void
-    read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere::BinaryPtr& raw_vectors) override;
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, knowhere::BinaryPtr& raw_vectors,
+                 storage::MmapAdvice advice) override;
 
     void
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) override;
 
+    void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<int64_t>& offsets, size_t width,
+                 std::vector<uint8_t>& raw_vectors) override;
+
+    bool
+    plain_files(const storage::FSHandlerPtr& fs_ptr, std::string& rv_path, std::string& uid_path) override;
+
+    void
+    file_paths(const storage::FSHandlerPtr& fs_ptr, const std::string& name, std::string& rv_path,
+               std::string& uid_path) override;
+
     // No copy and move
     DefaultVectorsFormat(const DefaultVectorsFormat&) = delete;
     DefaultVectorsFormat(DefaultVectorsFormat&&) = delete;
@@ -62,7 +74,11 @@ class DefaultVectorsFormat : public VectorsFormat {
 
     void
     read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
-                          knowhere::BinaryPtr& raw_vectors);
+                          knowhere::BinaryPtr& raw_vectors, storage::MmapAdvice advice);
+
+    void
+    read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                          const std::vector<int64_t>& offsets, size_t width, std::vector<uint8_t>& raw_vectors);
 
     void
     read_uids_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
@@ -0,0 +1,525 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/RawDataCodec.h"
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "storage/IOScheduler.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+static_assert(sizeof(RawDataHeader) == 32, "RawDataHeader is written to files as is");
+
+namespace {
+
+uint32_t
+BitWidth(uint64_t max_value) {
+    uint32_t width = 0;
+    while (width < 64 && (max_value >> width) != 0) {
+        ++width;
+    }
+    return width;
+}
+
+// append n values of width bits each, lowest bit first
+void
+PackBits(const uint64_t* values, size_t n, uint32_t width, std::vector<uint8_t>& out) {
+    if (width == 0) {
+        return;
+    }
+
+    size_t begin = out.size();
+    out.resize(begin + (n * width + 7) / 8, 0);
+    uint8_t* dst = out.data() + begin;
+    size_t bit = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t value = values[i];
+        for (uint32_t left = width; left > 0;) {
+            uint32_t shift = bit & 7;
+            uint32_t count = std::min(8 - shift, left);
+            dst[bit >> 3] |= (uint8_t)((value & ((1u << count) - 1)) << shift);
+            value >>= count;
+            left -= count;
+            bit += count;
+        }
+    }
+}
+
+// decoding is the hot path when loading segments: values up to 56 bits wide are extracted from one
+// unaligned 64 bit little endian load each, the loop has no per bit work and no branches
+bool
+UnpackBits(const uint8_t* src, size_t src_size, size_t n, uint32_t width, uint64_t* values) {
+    if (width == 0) {
+        std::fill(values, values + n, 0);
+        return true;
+    }
+    if (width > 64 || (n * width + 7) / 8 > src_size) {
+        return false;
+    }
+
+    size_t bit = 0;
+    size_t i = 0;
+    if (width <= 56) {
+        uint64_t mask = (1ULL << width) - 1;
+        for (; i < n && (bit >> 3) + sizeof(uint64_t) <= src_size; ++i, bit += width) {
+            uint64_t word;
+            memcpy(&word, src + (bit >> 3), sizeof(word));
+            values[i] = (word >> (bit & 7)) & mask;
+        }
+    }
+
+    // values near the end of the buffer, or wider than 56 bits
+    for (; i < n; ++i) {
+        uint64_t value = 0;
+        for (uint32_t done = 0; done < width;) {
+            uint32_t shift = bit & 7;
+            uint32_t count = std::min(8 - shift, width - done);
+            value |= (uint64_t)((src[bit >> 3] >> shift) & ((1u << count) - 1)) << done;
+            done += count;
+            bit += count;
+        }
+        values[i] = value;
+    }
+    return true;
+}
+
+void
+EncodeBytePlane(const uint8_t* data, size_t size, std::vector<uint8_t>& encoded) {
+    const size_t words = size / sizeof(uint32_t);
+    std::vector<uint64_t> indexes(words);
+    for (size_t p = 0; p < sizeof(uint32_t); ++p) {
+        bool seen[256] = {false};
+        for (size_t i = 0; i < words; ++i) {
+            seen[data[i * sizeof(uint32_t) + p]] = true;
+        }
+        std::vector<uint8_t> dict;
+        uint8_t index_of[256] = {0};
+        for (size_t b = 0; b < 256; ++b) {
+            if (seen[b]) {
+                index_of[b] = dict.size();
+                dict.push_back(b);
+            }
+        }
+
+        uint32_t width = dict.empty() ? 0 : BitWidth(dict.size() - 1);
+        encoded.push_back(width);
+        if (width >= 8) {
+            for (size_t i = 0; i < words; ++i) {
+                encoded.push_back(data[i * sizeof(uint32_t) + p]);
+            }
+            continue;
+        }
+
+        encoded.push_back(dict.size());
+        encoded.insert(encoded.end(), dict.begin(), dict.end());
+        for (size_t i = 0; i < words; ++i) {
+            indexes[i] = index_of[data[i * sizeof(uint32_t) + p]];
+        }
+        PackBits(indexes.data(), words, width, encoded);
+    }
+    encoded.insert(encoded.end(), data + words * sizeof(uint32_t), data + size);
+}
+
+bool
+DecodeBytePlane(const uint8_t* encoded, size_t encoded_size, uint8_t* data, size_t size) {
+    const size_t words = size / sizeof(uint32_t);
+    const size_t tail = size - words * sizeof(uint32_t);
+    const uint8_t* end = encoded + encoded_size;
+    std::vector<uint64_t> indexes(words);
+    for (size_t p = 0; p < sizeof(uint32_t); ++p) {
+        if (end - encoded < 1) {
+            return false;
+        }
+        uint32_t width = *encoded++;
+        if (width >= 8) {
+            if ((size_t)(end - encoded) < words) {
+                return false;
+            }
+            for (size_t i = 0; i < words; ++i) {
+                data[i * sizeof(uint32_t) + p] = encoded[i];
+            }
+            encoded += words;
+            continue;
+        }
+
+        if (end - encoded < 1) {
+            return false;
+        }
+        size_t dict_size = *encoded++;
+        const uint8_t* dict = encoded;
+        encoded += dict_size;
+        size_t packed_size = (words * width + 7) / 8;
+        if (encoded > end || (size_t)(end - encoded) < packed_size || (words > 0 && dict_size == 0) ||
+            !UnpackBits(encoded, packed_size, words, width, indexes.data())) {
+            return false;
+        }
+        for (size_t i = 0; i < words; ++i) {
+            if (indexes[i] >= dict_size) {
+                return false;
+            }
+            data[i * sizeof(uint32_t) + p] = dict[indexes[i]];
+        }
+        encoded += packed_size;
+    }
+
+    if ((size_t)(end - encoded) != tail) {
+        return false;
+    }
+    memcpy(data + words * sizeof(uint32_t), encoded, tail);
+    return true;
+}
+
+void
+EncodeDeltaInt64(const uint8_t* data, size_t size, std::vector<uint8_t>& encoded) {
+    const size_t n = size / sizeof(int64_t);
+    if (n > 0) {
+        std::vector<uint64_t> values(n);
+        memcpy(values.data(), data, n * sizeof(uint64_t));
+
+        // deltas wrap around, (value - previous - min_delta) is exact in unsigned arithmetic
+        int64_t min_delta = 0;
+        for (size_t i = 1; i < n; ++i) {
+            int64_t delta = (int64_t)(values[i] - values[i - 1]);
+            min_delta = (i == 1) ? delta : std::min(min_delta, delta);
+        }
+        std::vector<uint64_t> deltas(n - 1);
+        uint64_t max_delta = 0;
+        for (size_t i = 1; i < n; ++i) {
+            deltas[i - 1] = values[i] - values[i - 1] - (uint64_t)min_delta;
+            max_delta = std::max(max_delta, deltas[i - 1]);
+        }
+
+        uint32_t width = BitWidth(max_delta);
+        const uint8_t* first = reinterpret_cast<const uint8_t*>(&values[0]);
+        const uint8_t* min = reinterpret_cast<const uint8_t*>(&min_delta);
+        encoded.insert(encoded.end(), first, first + sizeof(uint64_t));
+        encoded.insert(encoded.end(), min, min + sizeof(int64_t));
+        encoded.push_back(width);
+        PackBits(deltas.data(), deltas.size(), width, encoded);
+    }
+    encoded.insert(encoded.end(), data + n * sizeof(int64_t), data + size);
+}
+
+bool
+DecodeDeltaInt64(const uint8_t* encoded, size_t encoded_size, uint8_t* data, size_t size) {
+    const size_t n = size / sizeof(int64_t);
+    const size_t tail = size - n * sizeof(int64_t);
+    const uint8_t* end = encoded + encoded_size;
+    if (n > 0) {
+        const size_t head_size = sizeof(uint64_t) + sizeof(int64_t) + 1;
+        if ((size_t)(end - encoded) < head_size) {
+            return false;
+        }
+        uint64_t value, min_delta;
+        memcpy(&value, encoded, sizeof(value));
+        memcpy(&min_delta, encoded + sizeof(value), sizeof(min_delta));
+        uint32_t width = encoded[head_size - 1];
+        encoded += head_size;
+
+        std::vector<uint64_t> deltas(n - 1);
+        size_t packed_size = ((n - 1) * width + 7) / 8;
+        if ((size_t)(end - encoded) < packed_size || !UnpackBits(encoded, packed_size, n - 1, width, deltas.data())) {
+            return false;
+        }
+        encoded += packed_size;
+
+        std::vector<uint64_t> values(n);
+        values[0] = value;
+        for (size_t i = 1; i < n; ++i) {
+            value += min_delta + deltas[i - 1];
+            values[i] = value;
+        }
+        memcpy(data, values.data(), n * sizeof(uint64_t));
+    }
+
+    if ((size_t)(end - encoded) != tail) {
+        return false;
+    }
+    memcpy(data + n * sizeof(int64_t), encoded, tail);
+    return true;
+}
+
+}  // namespace
+
+void
+EncodeRawDataBlock(RawDataCodecType type, const uint8_t* data, size_t size, std::vector<uint8_t>& encoded) {
+    switch (type) {
+        case RawDataCodecType::BYTE_PLANE:
+            EncodeBytePlane(data, size, encoded);
+            break;
+        case RawDataCodecType::DELTA_INT64:
+            EncodeDeltaInt64(data, size, encoded);
+            break;
+    }
+}
+
+bool
+DecodeRawDataBlock(RawDataCodecType type, const uint8_t* encoded, size_t encoded_size, uint8_t* data, size_t size) {
+    switch (type) {
+        case RawDataCodecType::BYTE_PLANE:
+            return DecodeBytePlane(encoded, encoded_size, data, size);
+        case RawDataCodecType::DELTA_INT64:
+            return DecodeDeltaInt64(encoded, encoded_size, data, size);
+        default:
+            return false;
+    }
+}
+
+void
+WriteRawData(const storage::IOWriterPtr& writer, RawDataCodecType type, const void* data, size_t size,
+             bool compress) {
+    auto raw = reinterpret_cast<const uint8_t*>(data);
+    if (compress && size > 0) {
+        RawDataHeader header;
+        header.magic_ = RAW_DATA_MAGIC;
+        header.raw_size_ = size;
+        header.type_ = (uint32_t)type;
+        header.block_size_ = RAW_DATA_BLOCK_SIZE;
+        header.block_num_ = (size + RAW_DATA_BLOCK_SIZE - 1) / RAW_DATA_BLOCK_SIZE;
+
+        std::vector<uint64_t> offsets(header.block_num_ + 1);
+        std::vector<uint8_t> encoded;
+        for (size_t block = 0; block < header.block_num_; ++block) {
+            size_t begin = block * RAW_DATA_BLOCK_SIZE;
+            offsets[block] = encoded.size();
+            EncodeRawDataBlock(type, raw + begin, std::min<size_t>(RAW_DATA_BLOCK_SIZE, size - begin), encoded);
+        }
+        offsets[header.block_num_] = encoded.size();
+
+        size_t encoded_size = sizeof(header) + offsets.size() * sizeof(uint64_t) + encoded.size();
+        if (encoded_size < sizeof(size_t) + size) {
+            writer->write(&header, sizeof(header));
+            writer->write(offsets.data(), offsets.size() * sizeof(uint64_t));
+            writer->write(encoded.data(), encoded.size());
+            return;
+        }
+    }
+
+    size_t num_bytes = size;
+    writer->write(&num_bytes, sizeof(size_t));
+    writer->write(const_cast<uint8_t*>(raw), size);
+}
+
+size_t
+ReadRawDataHeader(const storage::IOReaderPtr& reader, const std::string& file_path, RawDataHeader& header) {
+    header = RawDataHeader();
+    uint64_t first_word = 0;
+    reader->read(&first_word, sizeof(first_word));
+    if (first_word != RAW_DATA_MAGIC) {
+        header.raw_size_ = first_word;
+        return header.raw_size_;
+    }
+
+    header.magic_ = first_word;
+    reader->read(reinterpret_cast<uint8_t*>(&header) + sizeof(first_word), sizeof(header) - sizeof(first_word));
+    if ((header.type_ != (uint32_t)RawDataCodecType::BYTE_PLANE &&
+         header.type_ != (uint32_t)RawDataCodecType::DELTA_INT64) ||
+        header.block_size_ == 0 ||
+        header.block_num_ != (header.raw_size_ + header.block_size_ - 1) / header.block_size_) {
+        std::string err_msg = "Invalid encoded raw data header: " + file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    return header.raw_size_;
+}
+
+void
+ReadRawData(const storage::IOReaderPtr& reader, const std::string& file_path, const RawDataHeader& header,
+            size_t offset, size_t size, uint8_t* data) {
+    if (size == 0) {
+        return;
+    }
+    if (header.magic_ != RAW_DATA_MAGIC) {
+        reader->pread(data, size, sizeof(size_t) + offset);
+        return;
+    }
+
+    // only the blocks covering the range are read and decoded
+    const size_t block_size = header.block_size_;
+    const size_t first_block = offset / block_size;
+    const size_t last_block = (offset + size - 1) / block_size;
+    const size_t table_pos = sizeof(RawDataHeader);
+    const size_t data_pos = table_pos + (header.block_num_ + 1) * sizeof(uint64_t);
+
+    std::vector<uint64_t> offsets(last_block - first_block + 2);
+    reader->pread(offsets.data(), offsets.size() * sizeof(uint64_t), table_pos + first_block * sizeof(uint64_t));
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1]) {
+            std::string err_msg = "Invalid encoded raw data block offsets: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        }
+    }
+
+    std::vector<uint8_t> encoded(offsets.back() - offsets.front());
+    reader->pread(encoded.data(), encoded.size(), data_pos + offsets.front());
+
+    std::vector<uint8_t> block_data;
+    for (size_t block = first_block; block <= last_block; ++block) {
+        size_t block_begin = block * block_size;
+        size_t block_length = std::min<size_t>(block_size, header.raw_size_ - block_begin);
+        size_t copy_begin = std::max(offset, block_begin);
+        size_t copy_end = std::min(offset + size, block_begin + block_length);
+
+        // blocks entirely inside the range are decoded in place
+        bool in_place = (copy_begin == block_begin && copy_end == block_begin + block_length);
+        uint8_t* dst = nullptr;
+        if (in_place) {
+            dst = data + (block_begin - offset);
+        } else {
+            block_data.resize(block_length);
+            dst = block_data.data();
+        }
+
+        auto index = block - first_block;
+        if (!DecodeRawDataBlock((RawDataCodecType)header.type_, encoded.data() + offsets[index] - offsets.front(),
+                                offsets[index + 1] - offsets[index], dst, block_length)) {
+            std::string err_msg = "Failed to decode raw data block " + std::to_string(block) + ": " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        }
+        if (!in_place) {
+            memcpy(data + (copy_begin - offset), block_data.data() + (copy_begin - block_begin), copy_end - copy_begin);
+        }
+    }
+}
+
+bool
+ReadPlainRawDataSize(const std::string& file_path, size_t& size) {
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    uint64_t first_word = 0;
+    bool plain = ::pread(fd, &first_word, sizeof(first_word), 0) == sizeof(first_word) && first_word != RAW_DATA_MAGIC;
+    ::close(fd);
+    size = first_word;
+    return plain;
+}
+
+RawDataAppender::~RawDataAppender() {
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+}
+
+void
+RawDataAppender::Open(const std::string& file_path) {
+    file_path_ = file_path;
+    size_ = 0;
+    fd_ = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    uint64_t num_bytes = 0;
+    if (fd_ == -1 || ::write(fd_, &num_bytes, sizeof(num_bytes)) != sizeof(num_bytes)) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+}
+
+void
+RawDataAppender::Append(const std::string& src_path, const std::vector<Range>& ranges) {
+    int src_fd = ::open(src_path.c_str(), O_RDONLY);
+    if (src_fd == -1) {
+        std::string err_msg = "Failed to open file: " + src_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    try {
+        for (auto& range : ranges) {
+            Copy(src_fd, src_path, sizeof(size_t) + range.first, range.second);
+        }
+    } catch (...) {
+        ::close(src_fd);
+        throw;
+    }
+    ::close(src_fd);
+}
+
+void
+RawDataAppender::Copy(int src_fd, const std::string& src_path, size_t pos, size_t size) {
+    // paced in chunks like the writes of DiskIOWriter
+    auto& io_scheduler = storage::IOScheduler::GetInstance();
+    const size_t chunk_size = storage::DiskIOWriter::WRITE_CHUNK_SIZE;
+    while (size > 0) {
+        size_t chunk = std::min(chunk_size, size);
+        io_scheduler.Acquire(chunk);
+
+        ssize_t copied = -1;
+#ifdef SYS_copy_file_range
+        if (kernel_copy_) {
+            loff_t src_pos = pos;
+            copied = ::syscall(SYS_copy_file_range, src_fd, &src_pos, fd_, nullptr, chunk, 0);
+            if (copied == -1 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+                LOG_ENGINE_DEBUG_ << "copy_file_range is not supported to " << file_path_ << ", copy through memory";
+                kernel_copy_ = false;
+            }
+        }
+#else
+        kernel_copy_ = false;
+#endif
+        if (!kernel_copy_) {
+            buffer_.resize(chunk);
+            copied = ::pread(src_fd, buffer_.data(), chunk, pos);
+            if (copied > 0 && ::write(fd_, buffer_.data(), copied) != copied) {
+                copied = -1;
+            }
+        }
+
+        if (copied <= 0) {
+            std::string err_msg = "Failed to copy " + src_path + " to " + file_path_ + ", error: " +
+                                  (copied == 0 ? std::string("unexpected end of file") : std::strerror(errno));
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+        pos += copied;
+        size -= copied;
+        size_ += copied;
+    }
+}
+
+void
+RawDataAppender::Close() {
+    if (fd_ == -1) {
+        return;
+    }
+    uint64_t num_bytes = size_;
+    bool written = ::pwrite(fd_, &num_bytes, sizeof(num_bytes), 0) == sizeof(num_bytes);
+    bool closed = ::close(fd_) == 0;
+    fd_ = -1;
+    std::vector<uint8_t>().swap(buffer_);
+    if (!written || !closed) {
+        std::string err_msg = "Failed to write file: " + file_path_ + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/IOReader.h"
+#include "storage/IOWriter.h"
+
+namespace milvus {
+namespace codec {
+
+/*
+ * Lossless encoding of raw vector (.rv) and uid (.uid) files.
+ *
+ * A plain file starts with the raw data size followed by the raw data. An encoded file starts with
+ * RAW_DATA_MAGIC instead, which is never a valid size, so both layouts are readable by the same code.
+ * The data is encoded in independent blocks of RAW_DATA_BLOCK_SIZE raw bytes, each range read only
+ * decodes the blocks it covers:
+ *
+ *   RawDataHeader | uint64 block offsets * (block_num_ + 1) | encoded blocks
+ *
+ * BYTE_PLANE splits 4 byte words into 4 byte planes and bit-packs every plane against a dictionary of
+ * its distinct bytes, the sign/exponent plane of float vectors mostly takes a few bits per value.
+ * DELTA_INT64 bit-packs the deltas between consecutive int64 values, uids assigned in order take a few
+ * bits per value or nothing at all.
+ */
+enum class RawDataCodecType : uint32_t {
+    BYTE_PLANE = 1,
+    DELTA_INT64 = 2,
+};
+
+constexpr uint64_t RAW_DATA_MAGIC = 0xC0DEC0DE7A5DA7A0;
+constexpr uint32_t RAW_DATA_BLOCK_SIZE = 64 * 1024;
+
+struct RawDataHeader {
+    uint64_t magic_ = 0;
+    uint64_t raw_size_ = 0;
+    uint32_t type_ = 0;
+    uint32_t block_size_ = 0;
+    uint64_t block_num_ = 0;
+};
+
+// write data in the encoded layout if compress is true and it makes the file smaller, otherwise plain
+void
+WriteRawData(const storage::IOWriterPtr& writer, RawDataCodecType type, const void* data, size_t size,
+             bool compress);
+
+// read the header of the opened file in either layout, return the raw data size
+// file_path is only used in error messages
+size_t
+ReadRawDataHeader(const storage::IOReaderPtr& reader, const std::string& file_path, RawDataHeader& header);
+
+// read raw bytes [offset, offset + size) of the opened file, the range must be within the raw data size
+void
+ReadRawData(const storage::IOReaderPtr& reader, const std::string& file_path, const RawDataHeader& header,
+            size_t offset, size_t size, uint8_t* data);
+
+// append one encoded block to encoded, and decode it back, exposed for testing
+void
+EncodeRawDataBlock(RawDataCodecType type, const uint8_t* data, size_t size, std::vector<uint8_t>& encoded);
+
+bool
+DecodeRawDataBlock(RawDataCodecType type, const uint8_t* encoded, size_t encoded_size, uint8_t* data, size_t size);
+
+// false if the file is encoded or can't be read, otherwise size is the raw data size of the plain file
+bool
+ReadPlainRawDataSize(const std::string& file_path, size_t& size);
+
+/*
+ * Writes a plain file by concatenating byte ranges of the raw data of other plain files. The bytes are copied
+ * within the kernel by copy_file_range where the file systems allow it, through a buffer of a chunk otherwise,
+ * they never go through memory as a whole. The raw data size in front of the file is written by Close().
+ */
+class RawDataAppender {
+ public:
+    // the offset and the size of a range of the raw data
+    using Range = std::pair<size_t, size_t>;
+
+    RawDataAppender() = default;
+    ~RawDataAppender();
+
+    // No copy and move
+    RawDataAppender(const RawDataAppender&) = delete;
+    RawDataAppender(RawDataAppender&&) = delete;
+
+    RawDataAppender&
+    operator=(const RawDataAppender&) = delete;
+    RawDataAppender&
+    operator=(RawDataAppender&&) = delete;
+
+    void
+    Open(const std::string& file_path);
+
+    // the ranges must be within the raw data of the plain file src_path
+    void
+    Append(const std::string& src_path, const std::vector<Range>& ranges);
+
+    void
+    Close();
+
+    // raw data bytes appended so far
+    size_t
+    Size() const {
+        return size_;
+    }
+
+ private:
+    void
+    Copy(int src_fd, const std::string& src_path, size_t pos, size_t size);
+
+ private:
+    std::string file_path_;
+    int fd_ = -1;
+    size_t size_ = 0;
+    // cleared by the first copy_file_range the file systems don't support
+    bool kernel_copy_ = true;
+    std::vector<uint8_t> buffer_;
+};
+
+}  // namespace codec
+}  // namespace milvus
@@ -66,16 +66,15 @@ SSBlockFormat::read(const storage::FSHandlerPtr& fs_ptr, const std::string& file
     size_t total_num_bytes;
     fs_ptr->reader_ptr_->read(&total_num_bytes, sizeof(size_t));
 
-    offset += sizeof(size_t);  // Beginning of file is num_bytes
-    if (offset + num_bytes > total_num_bytes) {
+    if (offset + num_bytes > (int64_t)total_num_bytes) {
         std::string err_msg = "Invalid input to read: " + file_path;
         LOG_ENGINE_ERROR_ << err_msg;
         throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
     }
 
+    offset += sizeof(size_t);  // Beginning of file is num_bytes
     raw.resize(num_bytes);
-    fs_ptr->reader_ptr_->seekg(offset);
-    fs_ptr->reader_ptr_->read(raw.data(), num_bytes);
+    fs_ptr->reader_ptr_->pread(raw.data(), num_bytes, offset);
     fs_ptr->reader_ptr_->close();
 }
 
@@ -97,8 +96,7 @@ SSBlockFormat::read(const storage::FSHandlerPtr& fs_ptr, const std::string& file
 
     int64_t total_bytes = 0;
     for (auto& range : read_ranges) {
-        int64_t offset = range.offset_ + sizeof(size_t);
-        if (offset + range.num_bytes_ > total_num_bytes) {
+        if (range.offset_ + range.num_bytes_ > (int64_t)total_num_bytes) {
             std::string err_msg = "Invalid input to read: " + file_path;
             LOG_ENGINE_ERROR_ << err_msg;
             throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
@@ -109,29 +107,147 @@ SSBlockFormat::read(const storage::FSHandlerPtr& fs_ptr, const std::string& file
 
     raw.clear();
     raw.resize(total_bytes);
+    storage::ReadRequests requests;
     int64_t poz = 0;
     for (auto& range : read_ranges) {
         int64_t offset = range.offset_ + sizeof(size_t);
-        fs_ptr->reader_ptr_->seekg(offset);
-        fs_ptr->reader_ptr_->read(raw.data() + poz, range.num_bytes_);
+        requests.emplace_back(raw.data() + poz, offset, range.num_bytes_);
         poz += range.num_bytes_;
     }
+    // submit all ranges at once, the reader merges adjacent ones and overlaps the io of the others
+    fs_ptr->reader_ptr_->preadv(requests);
+
+    fs_ptr->reader_ptr_->close();
+}
+
+void
+SSBlockFormat::read_coalesced(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                              const ReadRanges& read_ranges, int64_t coalesce_gap,
+                              std::vector<std::vector<uint8_t>>& data) {
+    data.clear();
+    data.resize(read_ranges.size());
+    if (read_ranges.empty()) {
+        return;
+    }
+
+    if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    size_t total_num_bytes;
+    fs_ptr->reader_ptr_->read(&total_num_bytes, sizeof(size_t));
+
+    std::vector<size_t> order(read_ranges.size());
+    for (size_t i = 0; i < read_ranges.size(); ++i) {
+        auto& range = read_ranges[i];
+        if (range.offset_ < 0 || range.num_bytes_ <= 0 || range.offset_ >= (int64_t)total_num_bytes) {
+            fs_ptr->reader_ptr_->close();
+            std::string err_msg = "Invalid input to read: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+        }
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return read_ranges[a].offset_ < read_ranges[b].offset_; });
+
+    // the spans to read, each covers the sorted ranges [first, last)
+    struct Span {
+        int64_t offset_;
+        int64_t end_;
+        size_t first_;
+        size_t last_;
+    };
+    std::vector<Span> spans;
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto& range = read_ranges[order[i]];
+        int64_t end = std::min(range.offset_ + range.num_bytes_, (int64_t)total_num_bytes);
+        if (!spans.empty() && range.offset_ <= spans.back().end_ + coalesce_gap) {
+            spans.back().end_ = std::max(spans.back().end_, end);
+            spans.back().last_ = i + 1;
+        } else {
+            spans.push_back(Span{range.offset_, end, i, i + 1});
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> buffers(spans.size());
+    storage::ReadRequests requests;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        buffers[i].resize(spans[i].end_ - spans[i].offset_);
+        requests.emplace_back(buffers[i].data(), spans[i].offset_ + sizeof(size_t), buffers[i].size());
+    }
+    fs_ptr->reader_ptr_->preadv(requests);
+    fs_ptr->reader_ptr_->close();
+
+    for (size_t i = 0; i < spans.size(); ++i) {
+        for (size_t k = spans[i].first_; k < spans[i].last_; ++k) {
+            auto& range = read_ranges[order[k]];
+            int64_t end = std::min(range.offset_ + range.num_bytes_, (int64_t)total_num_bytes);
+            auto begin = buffers[i].begin() + (range.offset_ - spans[i].offset_);
+            data[order[k]].assign(begin, begin + (end - range.offset_));
+        }
+    }
+}
+
+void
+SSBlockFormat::read_tail(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, int64_t num_bytes,
+                         std::vector<uint8_t>& raw, int64_t& total_num_bytes) {
+    if (num_bytes <= 0) {
+        std::string err_msg = "Invalid input to read: " + file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    // the size header is skipped, the block size follows from the file length
+    total_num_bytes = fs_ptr->reader_ptr_->length() - (int64_t)sizeof(size_t);
+    if (total_num_bytes < 0) {
+        fs_ptr->reader_ptr_->close();
+        std::string err_msg = "Invalid block file: " + file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
 
+    num_bytes = std::min(num_bytes, total_num_bytes);
+    raw.resize(num_bytes);
+    if (num_bytes > 0) {
+        fs_ptr->reader_ptr_->pread(raw.data(), num_bytes, sizeof(size_t) + total_num_bytes - num_bytes);
+    }
     fs_ptr->reader_ptr_->close();
 }
 
 void
 SSBlockFormat::write(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                      const std::vector<uint8_t>& raw) {
+    write(fs_ptr, file_path, WriteBuffers{WriteBuffer(raw.data(), raw.size())});
+}
+
+void
+SSBlockFormat::write(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                     const WriteBuffers& buffers) {
     if (!fs_ptr->writer_ptr_->open(file_path.c_str())) {
         std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
         LOG_ENGINE_ERROR_ << err_msg;
         throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
     }
 
-    size_t num_bytes = raw.size();
+    size_t num_bytes = 0;
+    for (auto& buffer : buffers) {
+        num_bytes += buffer.num_bytes_;
+    }
     fs_ptr->writer_ptr_->write(&num_bytes, sizeof(size_t));
-    fs_ptr->writer_ptr_->write((void*)raw.data(), num_bytes);
+    for (auto& buffer : buffers) {
+        if (buffer.num_bytes_ > 0) {
+            fs_ptr->writer_ptr_->write((void*)buffer.data_, buffer.num_bytes_);
+        }
+    }
     fs_ptr->writer_ptr_->close();
 }
 
@@ -36,6 +36,15 @@ struct ReadRange {
 
 using ReadRanges = std::vector<ReadRange>;
 
+struct WriteBuffer {
+    WriteBuffer(const void* data, int64_t num_bytes) : data_(data), num_bytes_(num_bytes) {
+    }
+    const void* data_;
+    int64_t num_bytes_;
+};
+
+using WriteBuffers = std::vector<WriteBuffer>;
+
 class SSBlockFormat {
  public:
     SSBlockFormat() = default;
@@ -51,9 +60,24 @@ class SSBlockFormat {
     read(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const ReadRanges& read_ranges,
          std::vector<uint8_t>& raw);
 
+    // read the ranges with as few requests as possible: ranges closer than coalesce_gap bytes are read as one span and
+    // the bytes between them are dropped. data[i] holds the bytes of read_ranges[i], cut short at the end of the block
+    void
+    read_coalesced(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const ReadRanges& read_ranges,
+                   int64_t coalesce_gap, std::vector<std::vector<uint8_t>>& data);
+
+    // read the last num_bytes of the block (less if the block is smaller) with a single request
+    void
+    read_tail(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, int64_t num_bytes,
+              std::vector<uint8_t>& raw, int64_t& total_num_bytes);
+
     void
     write(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const std::vector<uint8_t>& raw);
 
+    // write the buffers back to back as one block
+    void
+    write(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const WriteBuffers& buffers);
+
     // No copy and move
     SSBlockFormat(const SSBlockFormat&) = delete;
     SSBlockFormat(SSBlockFormat&&) = delete;
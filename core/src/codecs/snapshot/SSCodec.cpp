@@ -40,6 +40,7 @@ SSCodec::SSCodec() {
     deleted_docs_format_ptr_ = std::make_shared<SSDeletedDocsFormat>();
     id_bloom_filter_format_ptr_ = std::make_shared<SSIdBloomFilterFormat>();
     vector_compress_format_ptr_ = std::make_shared<SSVectorCompressFormat>();
+    segment_container_format_ptr_ = std::make_shared<SSSegmentContainerFormat>();
 }
 
 SSBlockFormatPtr
@@ -71,5 +72,10 @@ SSVectorCompressFormatPtr
 SSCodec::GetVectorCompressFormat() {
     return vector_compress_format_ptr_;
 }
+
+SSSegmentContainerFormatPtr
+SSCodec::GetSegmentContainerFormat() {
+    return segment_container_format_ptr_;
+}
 }  // namespace codec
 }  // namespace milvus
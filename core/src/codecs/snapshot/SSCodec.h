@@ -20,6 +20,7 @@
 #include "codecs/snapshot/SSBlockFormat.h"
 #include "codecs/snapshot/SSDeletedDocsFormat.h"
 #include "codecs/snapshot/SSIdBloomFilterFormat.h"
+#include "codecs/snapshot/SSSegmentContainerFormat.h"
 #include "codecs/snapshot/SSStructuredIndexFormat.h"
 #include "codecs/snapshot/SSVectorCompressFormat.h"
 #include "codecs/snapshot/SSVectorIndexFormat.h"
@@ -50,6 +51,9 @@ class SSCodec {
     SSVectorCompressFormatPtr
     GetVectorCompressFormat();
 
+    SSSegmentContainerFormatPtr
+    GetSegmentContainerFormat();
+
  private:
     SSCodec();
 
@@ -60,6 +64,7 @@ class SSCodec {
     SSDeletedDocsFormatPtr deleted_docs_format_ptr_;
     SSIdBloomFilterFormatPtr id_bloom_filter_format_ptr_;
     SSVectorCompressFormatPtr vector_compress_format_ptr_;
+    SSSegmentContainerFormatPtr segment_container_format_ptr_;
 };
 
 }  // namespace codec
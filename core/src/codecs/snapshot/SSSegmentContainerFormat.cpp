@@ -0,0 +1,219 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/snapshot/SSSegmentContainerFormat.h"
+
+#include <boost/crc.hpp>
+#include <cstring>
+#include <utility>
+
+#include "codecs/snapshot/SSCodec.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+#pragma pack(push, 1)
+struct ContainerTrailer {
+    int64_t footer_size_;
+    uint32_t footer_crc_;
+    uint32_t section_count_;
+    uint32_t version_;
+    uint32_t magic_;
+};
+#pragma pack(pop)
+
+template <typename T>
+void
+Append(std::vector<uint8_t>& buf, const T& value) {
+    auto ptr = reinterpret_cast<const uint8_t*>(&value);
+    buf.insert(buf.end(), ptr, ptr + sizeof(T));
+}
+
+template <typename T>
+bool
+Extract(const uint8_t*& ptr, const uint8_t* end, T& value) {
+    if (end - ptr < (int64_t)sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return true;
+}
+
+void
+ThrowCorrupted(const std::string& file_path, const std::string& reason) {
+    std::string err_msg = "Corrupted segment container: " + file_path + ", " + reason;
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+}
+
+}  // namespace
+
+uint32_t
+SSSegmentContainerFormat::Checksum(const void* data, int64_t num_bytes) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, num_bytes);
+    return crc.checksum();
+}
+
+void
+SSSegmentContainerFormat::write(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                const ContainerSections& sections) {
+    WriteBuffers buffers;
+    std::vector<uint8_t> footer;
+    int64_t offset = 0;
+    for (auto& pair : sections) {
+        auto& name = pair.first;
+        auto& data = pair.second;
+        buffers.emplace_back(data.data(), data.size());
+
+        Append(footer, (uint32_t)name.size());
+        footer.insert(footer.end(), name.begin(), name.end());
+        Append(footer, offset);
+        Append(footer, (int64_t)data.size());
+        Append(footer, Checksum(data.data(), data.size()));
+        offset += data.size();
+    }
+
+    ContainerTrailer trailer;
+    trailer.footer_size_ = footer.size();
+    trailer.footer_crc_ = Checksum(footer.data(), footer.size());
+    trailer.section_count_ = sections.size();
+    trailer.version_ = CONTAINER_VERSION;
+    trailer.magic_ = CONTAINER_MAGIC;
+
+    buffers.emplace_back(footer.data(), footer.size());
+    buffers.emplace_back(&trailer, sizeof(trailer));
+
+    auto& ss_codec = SSCodec::instance();
+    ss_codec.GetBlockFormat()->write(fs_ptr, file_path, buffers);
+}
+
+void
+SSSegmentContainerFormat::read_index(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                     ContainerIndexPtr& index) {
+    auto& ss_codec = SSCodec::instance();
+    auto block_format = ss_codec.GetBlockFormat();
+
+    std::vector<uint8_t> tail;
+    int64_t total_num_bytes = 0;
+    block_format->read_tail(fs_ptr, file_path, FOOTER_READ_SIZE, tail, total_num_bytes);
+    if (tail.size() < sizeof(ContainerTrailer)) {
+        ThrowCorrupted(file_path, "file too small");
+    }
+
+    ContainerTrailer trailer;
+    memcpy(&trailer, tail.data() + tail.size() - sizeof(trailer), sizeof(trailer));
+    if (trailer.magic_ != CONTAINER_MAGIC) {
+        ThrowCorrupted(file_path, "bad magic");
+    }
+    if (trailer.version_ > CONTAINER_VERSION) {
+        ThrowCorrupted(file_path, "unsupported version " + std::to_string(trailer.version_));
+    }
+    int64_t footer_end = total_num_bytes - sizeof(trailer);
+    if (trailer.footer_size_ < 0 || trailer.footer_size_ > footer_end) {
+        ThrowCorrupted(file_path, "bad footer size");
+    }
+
+    // a footer larger than the first read costs a second one
+    if ((int64_t)tail.size() < trailer.footer_size_ + (int64_t)sizeof(trailer)) {
+        block_format->read_tail(fs_ptr, file_path, trailer.footer_size_ + sizeof(trailer), tail, total_num_bytes);
+    }
+
+    const uint8_t* ptr = tail.data() + tail.size() - sizeof(trailer) - trailer.footer_size_;
+    const uint8_t* end = ptr + trailer.footer_size_;
+    if (Checksum(ptr, trailer.footer_size_) != trailer.footer_crc_) {
+        ThrowCorrupted(file_path, "footer checksum mismatch");
+    }
+
+    int64_t data_end = footer_end - trailer.footer_size_;
+    index = std::make_shared<ContainerIndex>();
+    for (uint32_t i = 0; i < trailer.section_count_; ++i) {
+        uint32_t name_size = 0;
+        if (!Extract(ptr, end, name_size) || end - ptr < (int64_t)name_size) {
+            ThrowCorrupted(file_path, "truncated footer");
+        }
+        std::string name(reinterpret_cast<const char*>(ptr), name_size);
+        ptr += name_size;
+
+        ContainerSection section;
+        if (!Extract(ptr, end, section.offset_) || !Extract(ptr, end, section.size_) ||
+            !Extract(ptr, end, section.crc_)) {
+            ThrowCorrupted(file_path, "truncated footer");
+        }
+        if (section.offset_ < 0 || section.size_ < 0 || section.offset_ + section.size_ > data_end) {
+            ThrowCorrupted(file_path, "section " + name + " out of range");
+        }
+        index->insert(std::make_pair(name, section));
+    }
+}
+
+void
+SSSegmentContainerFormat::read_section(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                       const ContainerIndexPtr& index, const std::string& name,
+                                       std::vector<uint8_t>& raw) {
+    ContainerSections sections;
+    read_sections(fs_ptr, file_path, index, {name}, sections);
+    raw.swap(sections[name]);
+}
+
+void
+SSSegmentContainerFormat::read_sections(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                        const ContainerIndexPtr& index, const std::vector<std::string>& names,
+                                        ContainerSections& sections) {
+    if (index == nullptr) {
+        std::string err_msg = "Segment container index is null: " + file_path;
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_NULL_POINTER, err_msg);
+    }
+
+    ReadRanges ranges;
+    std::vector<std::pair<std::string, ContainerSection>> targets;
+    for (auto& name : names) {
+        auto iter = index->find(name);
+        if (iter == index->end()) {
+            std::string err_msg = "No section " + name + " in segment container: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_FILE_NOT_FOUND, err_msg);
+        }
+        targets.emplace_back(*iter);
+        if (iter->second.size_ > 0) {
+            ranges.emplace_back(iter->second.offset_, iter->second.size_);
+        }
+    }
+
+    std::vector<uint8_t> raw;
+    auto& ss_codec = SSCodec::instance();
+    ss_codec.GetBlockFormat()->read(fs_ptr, file_path, ranges, raw);
+
+    int64_t poz = 0;
+    for (auto& target : targets) {
+        auto& section = target.second;
+        if (Checksum(raw.data() + poz, section.size_) != section.crc_) {
+            ThrowCorrupted(file_path, "section " + target.first + " checksum mismatch");
+        }
+        sections[target.first].assign(raw.data() + poz, raw.data() + poz + section.size_);
+        poz += section.size_;
+    }
+}
+
+}  // namespace codec
+}  // namespace milvus
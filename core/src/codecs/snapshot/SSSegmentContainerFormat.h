@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/FSHandler.h"
+
+namespace milvus {
+namespace codec {
+
+/*
+ * Single file segment container, laid out as a block of SSBlockFormat:
+ *   section data back to back
+ *   footer: for each section, name length (uint32), name, offset (int64), size (int64), crc32 (uint32)
+ *   trailer: footer size (int64), footer crc32 (uint32), section count (uint32), version (uint32), magic (uint32)
+ * Opening the container costs one tail read which normally covers the footer, sections are then fetched with
+ * range reads and checked against their crc.
+ */
+struct ContainerSection {
+    int64_t offset_ = 0;
+    int64_t size_ = 0;
+    uint32_t crc_ = 0;
+};
+
+// section name -> position in the container
+using ContainerIndex = std::map<std::string, ContainerSection>;
+using ContainerIndexPtr = std::shared_ptr<ContainerIndex>;
+
+// section name -> section data
+using ContainerSections = std::map<std::string, std::vector<uint8_t>>;
+
+class SSSegmentContainerFormat {
+ public:
+    static constexpr uint32_t CONTAINER_MAGIC = 0x5345474Du;  // "SEGM"
+    static constexpr uint32_t CONTAINER_VERSION = 1;
+    // bytes fetched from the end of the file when opening, enough for the footer of a few hundred sections
+    static constexpr int64_t FOOTER_READ_SIZE = 16 * 1024;
+
+    SSSegmentContainerFormat() = default;
+
+    void
+    write(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const ContainerSections& sections);
+
+    void
+    read_index(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, ContainerIndexPtr& index);
+
+    void
+    read_section(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const ContainerIndexPtr& index,
+                 const std::string& name, std::vector<uint8_t>& raw);
+
+    // fetch several sections with one batch of range reads
+    void
+    read_sections(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, const ContainerIndexPtr& index,
+                  const std::vector<std::string>& names, ContainerSections& sections);
+
+    static uint32_t
+    Checksum(const void* data, int64_t num_bytes);
+
+    // No copy and move
+    SSSegmentContainerFormat(const SSSegmentContainerFormat&) = delete;
+    SSSegmentContainerFormat(SSSegmentContainerFormat&&) = delete;
+
+    SSSegmentContainerFormat&
+    operator=(const SSSegmentContainerFormat&) = delete;
+    SSSegmentContainerFormat&
+    operator=(SSSegmentContainerFormat&&) = delete;
+};
+
+using SSSegmentContainerFormatPtr = std::shared_ptr<SSSegmentContainerFormat>;
+
+}  // namespace codec
+}  // namespace milvus
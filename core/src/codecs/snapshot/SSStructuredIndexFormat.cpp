@@ -25,7 +25,7 @@
 #include <utility>
 
 #include "db/meta/MetaTypes.h"
-#include "knowhere/index/structured_index/StructuredIndexSort.h"
+#include "knowhere/index/structured_index/StructuredIndexFactory.h"
 
 #include "utils/Exception.h"
 #include "utils/Log.h"
@@ -35,31 +35,32 @@ namespace milvus {
 namespace codec {
 
 knowhere::IndexPtr
-SSStructuredIndexFormat::create_structured_index(const milvus::engine::meta::hybrid::DataType data_type) {
+SSStructuredIndexFormat::create_structured_index(const milvus::engine::meta::hybrid::DataType data_type,
+                                                 const knowhere::BinarySet& index_binary) {
     knowhere::IndexPtr index = nullptr;
     switch (data_type) {
         case engine::meta::hybrid::DataType::INT8: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int8_t>>();
+            index = knowhere::CreateStructuredIndex<int8_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::INT16: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int16_t>>();
+            index = knowhere::CreateStructuredIndex<int16_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::INT32: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int32_t>>();
+            index = knowhere::CreateStructuredIndex<int32_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::INT64: {
-            index = std::make_shared<knowhere::StructuredIndexSort<int64_t>>();
+            index = knowhere::CreateStructuredIndex<int64_t>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::FLOAT: {
-            index = std::make_shared<knowhere::StructuredIndexSort<float>>();
+            index = knowhere::CreateStructuredIndex<float>(index_binary);
             break;
         }
         case engine::meta::hybrid::DataType::DOUBLE: {
-            index = std::make_shared<knowhere::StructuredIndexSort<double>>();
+            index = knowhere::CreateStructuredIndex<double>(index_binary);
             break;
         }
         default: {
@@ -129,7 +130,7 @@ SSStructuredIndexFormat::read_internal(const milvus::storage::FSHandlerPtr& fs_p
     double rate = length * 1000000.0 / span / 1024 / 1024;
     LOG_ENGINE_DEBUG_ << "read_index(" << path << ") rate " << rate << "MB/s";
 
-    index = create_structured_index((engine::meta::hybrid::DataType)data_type);
+    index = create_structured_index((engine::meta::hybrid::DataType)data_type, load_data_list);
 
     index->Load(load_data_list);
 
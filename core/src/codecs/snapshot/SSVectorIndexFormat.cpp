@@ -130,7 +130,7 @@ SSVectorIndexFormat::construct_index(const std::string& index_name, knowhere::Bi
                                      knowhere::BinaryPtr& raw_data, knowhere::BinaryPtr& compress_data,
                                      knowhere::VecIndexPtr& index) {
     knowhere::VecIndexFactory& vec_index_factory = knowhere::VecIndexFactory::GetInstance();
-    index = vec_index_factory.CreateVecIndex(index_name, knowhere::IndexMode::MODE_CPU);
+    index = vec_index_factory.CreateVecIndex(index_name, index_data, knowhere::IndexMode::MODE_CPU);
     if (index != nullptr) {
         int64_t length = 0;
         for (auto& pair : index_data.binary_map_) {
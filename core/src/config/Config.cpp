@@ -46,6 +46,12 @@ const char* CONFIG_CLUSTER_ENABLE = "enable";
 const char* CONFIG_CLUSTER_ENABLE_DEFAULT = "true";
 const char* CONFIG_CLUSTER_ROLE = "role";
 const char* CONFIG_CLUSTER_ROLE_DEFAULT = "rw";
+const char* CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL = "replica_refresh_interval";
+const char* CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL_DEFAULT = "0";
+const char* CONFIG_CLUSTER_SHARDS = "shards";
+const char* CONFIG_CLUSTER_SHARDS_DEFAULT = "";
+const char* CONFIG_CLUSTER_HEDGE_DELAY = "hedge_delay";
+const char* CONFIG_CLUSTER_HEDGE_DELAY_DEFAULT = "0";
 
 /* general config */
 const char* CONFIG_GENERAL = "general";
@@ -53,6 +59,8 @@ const char* CONFIG_GENERAL_TIMEZONE = "timezone";
 const char* CONFIG_GENERAL_TIMEZONE_DEFAULT = "UTC+8";
 const char* CONFIG_GENERAL_METAURI = "meta_uri";
 const char* CONFIG_GENERAL_METAURI_DEFAULT = "sqlite://:@:/";
+const char* CONFIG_GENERAL_META_CACHE_TTL = "meta_cache_ttl";
+const char* CONFIG_GENERAL_META_CACHE_TTL_DEFAULT = "1000";
 
 /* network config */
 const char* CONFIG_NETWORK = "network";
@@ -64,6 +72,18 @@ const char* CONFIG_NETWORK_HTTP_ENABLE = "http.enable";
 const char* CONFIG_NETWORK_HTTP_ENABLE_DEFAULT = "true";
 const char* CONFIG_NETWORK_HTTP_PORT = "http.port";
 const char* CONFIG_NETWORK_HTTP_PORT_DEFAULT = "19121";
+const char* CONFIG_NETWORK_HTTP_ASYNC = "http.async";
+const char* CONFIG_NETWORK_HTTP_ASYNC_DEFAULT = "false";
+const char* CONFIG_NETWORK_HTTP_IO_THREADS = "http.io_threads";
+const char* CONFIG_NETWORK_HTTP_IO_THREADS_DEFAULT = "2";
+const char* CONFIG_NETWORK_HTTP_WORKER_THREADS = "http.worker_threads";
+const char* CONFIG_NETWORK_HTTP_WORKER_THREADS_DEFAULT = "16";
+const char* CONFIG_NETWORK_GRPC_ASYNC = "grpc.async";
+const char* CONFIG_NETWORK_GRPC_ASYNC_DEFAULT = "false";
+const char* CONFIG_NETWORK_GRPC_CAPTURE_PATH = "grpc.capture_path";
+const char* CONFIG_NETWORK_GRPC_CAPTURE_PATH_DEFAULT = "";
+const char* CONFIG_NETWORK_GRPC_CAPTURE_SIZE = "grpc.capture_size";
+const char* CONFIG_NETWORK_GRPC_CAPTURE_SIZE_DEFAULT = "1GB";
 
 /* db config */
 const char* CONFIG_DB = "db_config";
@@ -82,6 +102,36 @@ const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT = "file_cleanup_timeout";
 const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_DEFAULT = "10";
 const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN = 0;
 const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX = 3600;
+const char* CONFIG_STORAGE_RAW_VECTOR_MMAP = "raw_vector_mmap";
+const char* CONFIG_STORAGE_RAW_VECTOR_MMAP_DEFAULT = "false";
+const char* CONFIG_STORAGE_RAW_DATA_COMPRESS = "raw_data_compress";
+const char* CONFIG_STORAGE_RAW_DATA_COMPRESS_DEFAULT = "false";
+const char* CONFIG_STORAGE_BLOCKED_BLOOM_FILTER = "blocked_bloom_filter";
+const char* CONFIG_STORAGE_BLOCKED_BLOOM_FILTER_DEFAULT = "false";
+const char* CONFIG_STORAGE_MERGE_STRATEGY = "merge_strategy";
+const char* CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT = "layered";
+const char* CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION = "merge_amplification";
+const char* CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION_DEFAULT = "3";
+const char* CONFIG_STORAGE_MERGE_BYTES_LIMIT = "merge_bytes_limit";
+const char* CONFIG_STORAGE_MERGE_BYTES_LIMIT_DEFAULT = "0";
+const char* CONFIG_STORAGE_COMPACT_THRESHOLD = "compact_threshold";
+const char* CONFIG_STORAGE_COMPACT_THRESHOLD_DEFAULT = "0.0";
+const char* CONFIG_STORAGE_COMPACT_BYTES_LIMIT = "compact_bytes_limit";
+const char* CONFIG_STORAGE_COMPACT_BYTES_LIMIT_DEFAULT = "1GB";
+const char* CONFIG_STORAGE_READ_COALESCE_GAP = "read_coalesce_gap";
+const char* CONFIG_STORAGE_READ_COALESCE_GAP_DEFAULT = "64KB";
+const char* CONFIG_STORAGE_COLD_PATH = "cold_path";
+const char* CONFIG_STORAGE_COLD_PATH_DEFAULT = "";
+const char* CONFIG_STORAGE_HOT_CAPACITY = "hot_capacity";
+const char* CONFIG_STORAGE_HOT_CAPACITY_DEFAULT = "0";
+const char* CONFIG_STORAGE_GC_THREAD_NUM = "gc_thread_num";
+const char* CONFIG_STORAGE_GC_THREAD_NUM_DEFAULT = "4";
+const char* CONFIG_STORAGE_GC_UNLINK_RATE = "gc_unlink_rate";
+const char* CONFIG_STORAGE_GC_UNLINK_RATE_DEFAULT = "0";
+const char* CONFIG_STORAGE_BACKGROUND_IO_RATE = "background_io_rate";
+const char* CONFIG_STORAGE_BACKGROUND_IO_RATE_DEFAULT = "0";
+const char* CONFIG_STORAGE_IO_LATENCY_TARGET = "io_latency_target";
+const char* CONFIG_STORAGE_IO_LATENCY_TARGET_DEFAULT = "10.0";
 
 /* cache config */
 const char* CONFIG_CACHE = "cache";
@@ -89,12 +139,32 @@ const char* CONFIG_CACHE_CPU_CACHE_CAPACITY = "cache_size";
 const char* CONFIG_CACHE_CPU_CACHE_CAPACITY_DEFAULT = "4294967296"; /* 4 GB */
 const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD = "cpu_cache_threshold";
 const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT = "0.7";
+const char* CONFIG_CACHE_CPU_CACHE_SHARD_NUM = "cpu_cache_shard_num";
+const char* CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT = "1";
+const char* CONFIG_CACHE_CPU_CACHE_POLICY = "cpu_cache_policy";
+const char* CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT = "lru";
+const char* CONFIG_CACHE_RECLAIM_QUEUE_SIZE = "reclaim_queue_size";
+const char* CONFIG_CACHE_RECLAIM_QUEUE_SIZE_DEFAULT = "64";
+const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY = "result_cache_capacity";
+const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT = "0";
 const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1073741824"; /* 1 GB */
+const char* CONFIG_CACHE_INSERT_BUFFER_TARGET = "insert_buffer_target";
+const char* CONFIG_CACHE_INSERT_BUFFER_TARGET_DEFAULT = "0.5";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
 const char* CONFIG_CACHE_PRELOAD_COLLECTION = "preload_collection";
 const char* CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT = "";
+const char* CONFIG_CACHE_MEMORY_LIMIT = "memory_limit";
+const char* CONFIG_CACHE_MEMORY_LIMIT_DEFAULT = "0";
+const char* CONFIG_CACHE_PRELOAD_THREAD_NUM = "preload_thread_num";
+const char* CONFIG_CACHE_PRELOAD_THREAD_NUM_DEFAULT = "4";
+const char* CONFIG_CACHE_PRELOAD_BANDWIDTH = "preload_bandwidth";
+const char* CONFIG_CACHE_PRELOAD_BANDWIDTH_DEFAULT = "0";
+const char* CONFIG_CACHE_WARM_UP_SIZE = "warm_up_size";
+const char* CONFIG_CACHE_WARM_UP_SIZE_DEFAULT = "0";
+const char* CONFIG_CACHE_WRITE_THROUGH_INDEX = "write_through_index";
+const char* CONFIG_CACHE_WRITE_THROUGH_INDEX_DEFAULT = "false";
 
 /* metric config */
 const char* CONFIG_METRIC = "metric";
@@ -104,6 +174,12 @@ const char* CONFIG_METRIC_ADDRESS = "address";
 const char* CONFIG_METRIC_ADDRESS_DEFAULT = "127.0.0.1";
 const char* CONFIG_METRIC_PORT = "port";
 const char* CONFIG_METRIC_PORT_DEFAULT = "9091";
+const char* CONFIG_METRIC_PROFILING_INTERVAL = "profiling_interval";
+const char* CONFIG_METRIC_PROFILING_INTERVAL_DEFAULT = "0";
+const char* CONFIG_METRIC_PROFILING_DURATION = "profiling_duration";
+const char* CONFIG_METRIC_PROFILING_DURATION_DEFAULT = "10";
+const char* CONFIG_METRIC_RECALL_SAMPLE_RATE = "recall_sample_rate";
+const char* CONFIG_METRIC_RECALL_SAMPLE_RATE_DEFAULT = "0.0";
 
 /* engine config */
 const char* CONFIG_ENGINE = "engine_config";
@@ -115,6 +191,38 @@ const char* CONFIG_ENGINE_SIMD_TYPE = "simd_type";
 const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT = "auto";
 const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ = "search_combine_nq";
 const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT = "64";
+const char* CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US = "search_combine_wait_us";
+const char* CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US_DEFAULT = "0";
+const char* CONFIG_ENGINE_PARALLEL_REDUCE = "parallel_reduce";
+const char* CONFIG_ENGINE_PARALLEL_REDUCE_DEFAULT = "true";
+const char* CONFIG_ENGINE_EXECUTOR_THREADS = "executor_threads";
+const char* CONFIG_ENGINE_EXECUTOR_THREADS_DEFAULT = "0";
+const char* CONFIG_ENGINE_PREFETCH_DEPTH = "prefetch_depth";
+const char* CONFIG_ENGINE_PREFETCH_DEPTH_DEFAULT = "3";
+const char* CONFIG_ENGINE_SEARCH_WORKERS = "search_workers";
+const char* CONFIG_ENGINE_SEARCH_WORKERS_DEFAULT = "1";
+const char* CONFIG_ENGINE_INSERT_WORKERS = "insert_workers";
+const char* CONFIG_ENGINE_INSERT_WORKERS_DEFAULT = "1";
+const char* CONFIG_ENGINE_DDL_WORKERS = "ddl_workers";
+const char* CONFIG_ENGINE_DDL_WORKERS_DEFAULT = "1";
+const char* CONFIG_ENGINE_MAINTENANCE_WORKERS = "maintenance_workers";
+const char* CONFIG_ENGINE_MAINTENANCE_WORKERS_DEFAULT = "1";
+const char* CONFIG_ENGINE_REQUEST_QUEUE_DEPTH = "request_queue_depth";
+const char* CONFIG_ENGINE_REQUEST_QUEUE_DEPTH_DEFAULT = "0";
+const char* CONFIG_ENGINE_BUILD_CPU_SHARE = "build_cpu_share";
+const char* CONFIG_ENGINE_BUILD_CPU_SHARE_DEFAULT = "0.25";
+const char* CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS = "search_latency_slo_ms";
+const char* CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS_DEFAULT = "0";
+const char* CONFIG_ENGINE_SEARCH_INSERT_BUFFER = "search_insert_buffer";
+const char* CONFIG_ENGINE_SEARCH_INSERT_BUFFER_DEFAULT = "false";
+const char* CONFIG_ENGINE_NUMA_AWARE = "numa_aware";
+const char* CONFIG_ENGINE_NUMA_AWARE_DEFAULT = "false";
+const char* CONFIG_ENGINE_HUGE_PAGE = "huge_page";
+const char* CONFIG_ENGINE_HUGE_PAGE_DEFAULT = "false";
+const char* CONFIG_ENGINE_RAW_VECTOR_COMPRESSION = "raw_vector_compression";
+const char* CONFIG_ENGINE_RAW_VECTOR_COMPRESSION_DEFAULT = "none";
+const char* CONFIG_ENGINE_SEARCH_MEMORY_LIMIT = "search_memory_limit";
+const char* CONFIG_ENGINE_SEARCH_MEMORY_LIMIT_DEFAULT = "0"; /* no limit, opt in */
 
 /* gpu resource config */
 const char* CONFIG_GPU_RESOURCE = "gpu";
@@ -128,6 +236,18 @@ const char* CONFIG_GPU_RESOURCE_CACHE_CAPACITY = "cache_size";
 const char* CONFIG_GPU_RESOURCE_CACHE_CAPACITY_DEFAULT = "1073741824"; /* 1 GB */
 const char* CONFIG_GPU_RESOURCE_CACHE_THRESHOLD = "cache_threshold";
 const char* CONFIG_GPU_RESOURCE_CACHE_THRESHOLD_DEFAULT = "0.7";
+const char* CONFIG_GPU_RESOURCE_CACHE_POLICY = "cache_policy";
+const char* CONFIG_GPU_RESOURCE_CACHE_POLICY_DEFAULT = "lru";
+const char* CONFIG_GPU_RESOURCE_PREFETCH_DEPTH = "prefetch_depth";
+const char* CONFIG_GPU_RESOURCE_PREFETCH_DEPTH_DEFAULT = "2";
+const char* CONFIG_GPU_RESOURCE_COST_PLACEMENT = "cost_placement";
+const char* CONFIG_GPU_RESOURCE_COST_PLACEMENT_DEFAULT = "false";
+const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED = "build_index_sharded";
+const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED_DEFAULT = "false";
+const char* CONFIG_GPU_RESOURCE_SEARCH_SHARDED = "search_sharded";
+const char* CONFIG_GPU_RESOURCE_SEARCH_SHARDED_DEFAULT = "false";
+const char* CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS = "keep_fresh_segments";
+const char* CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS_DEFAULT = "false";
 const char* CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD = "gpu_search_threshold";
 const char* CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD_DEFAULT = "1000";
 const char* CONFIG_GPU_RESOURCE_DELIMITER = ",";
@@ -139,6 +259,16 @@ const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES_DEFAULT = "gpu0";
 /* tracing config */
 const char* CONFIG_TRACING = "tracing_config";
 const char* CONFIG_TRACING_JSON_CONFIG_PATH = "json_config_path";
+const char* CONFIG_TRACING_SEARCH_SAMPLE_RATE = "search_sample_rate";
+const char* CONFIG_TRACING_SEARCH_SAMPLE_RATE_DEFAULT = "1.0";
+const char* CONFIG_TRACING_INSERT_SAMPLE_RATE = "insert_sample_rate";
+const char* CONFIG_TRACING_INSERT_SAMPLE_RATE_DEFAULT = "1.0";
+const char* CONFIG_TRACING_DDL_SAMPLE_RATE = "ddl_sample_rate";
+const char* CONFIG_TRACING_DDL_SAMPLE_RATE_DEFAULT = "1.0";
+const char* CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE = "maintenance_sample_rate";
+const char* CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE_DEFAULT = "1.0";
+const char* CONFIG_TRACING_INFO_SAMPLE_RATE = "info_sample_rate";
+const char* CONFIG_TRACING_INFO_SAMPLE_RATE_DEFAULT = "1.0";
 
 /* wal config */
 const char* CONFIG_WAL = "wal";
@@ -152,6 +282,14 @@ const int64_t CONFIG_WAL_BUFFER_SIZE_MIN = 67108864;      /* 64 MB */
 const int64_t CONFIG_WAL_BUFFER_SIZE_MAX = 4294967296;    /* 4 GB */
 const char* CONFIG_WAL_WAL_PATH = "path";
 const char* CONFIG_WAL_WAL_PATH_DEFAULT = "/tmp/milvus/wal";
+const char* CONFIG_WAL_SYNC_MODE = "sync_mode";
+const char* CONFIG_WAL_SYNC_MODE_DEFAULT = "none";
+const char* CONFIG_WAL_SYNC_INTERVAL = "sync_interval";
+const char* CONFIG_WAL_SYNC_INTERVAL_DEFAULT = "10";
+const char* CONFIG_WAL_RECOVERY_THREAD_NUM = "recovery_thread_num";
+const char* CONFIG_WAL_RECOVERY_THREAD_NUM_DEFAULT = "1";
+const char* CONFIG_WAL_COMPRESS = "compress";
+const char* CONFIG_WAL_COMPRESS_DEFAULT = "false";
 
 /* logs config */
 const char* CONFIG_LOGS = "logs";
@@ -169,6 +307,16 @@ const char* CONFIG_LOGS_LOG_ROTATE_NUM = "log_rotate_num";
 const char* CONFIG_LOGS_LOG_ROTATE_NUM_DEFAULT = "0";
 const int64_t CONFIG_LOGS_LOG_ROTATE_NUM_MIN = 0;
 const int64_t CONFIG_LOGS_LOG_ROTATE_NUM_MAX = 1024;
+const char* CONFIG_LOGS_ASYNC_ENABLE = "async.enable";
+const char* CONFIG_LOGS_ASYNC_ENABLE_DEFAULT = "false";
+const char* CONFIG_LOGS_ASYNC_BUFFER_SIZE = "async.buffer_size";
+const char* CONFIG_LOGS_ASYNC_BUFFER_SIZE_DEFAULT = "4096";
+const int64_t CONFIG_LOGS_ASYNC_BUFFER_SIZE_MIN = 64;
+const int64_t CONFIG_LOGS_ASYNC_BUFFER_SIZE_MAX = 1048576;
+const char* CONFIG_LOGS_ASYNC_RATE_LIMIT = "async.rate_limit";
+const char* CONFIG_LOGS_ASYNC_RATE_LIMIT_DEFAULT = "1000";
+const int64_t CONFIG_LOGS_ASYNC_RATE_LIMIT_MIN = 0;
+const int64_t CONFIG_LOGS_ASYNC_RATE_LIMIT_MAX = 1000000;
 
 constexpr int64_t GB = 1UL << 30;
 constexpr int32_t PORT_NUMBER_MIN = 1024;
@@ -203,6 +351,34 @@ Config::Config() {
     std::string node_search_combine = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ;
     config_callback_[node_search_combine] = empty_map;
 
+    std::string node_search_combine_wait = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US;
+    config_callback_[node_search_combine_wait] = empty_map;
+
+    std::string node_omp_thread_num = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_OMP_THREAD_NUM;
+    config_callback_[node_omp_thread_num] = empty_map;
+
+    std::string node_build_cpu_share = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_BUILD_CPU_SHARE;
+    config_callback_[node_build_cpu_share] = empty_map;
+
+    std::string node_search_workers = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_SEARCH_WORKERS;
+    config_callback_[node_search_workers] = empty_map;
+
+    std::string node_insert_workers = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_INSERT_WORKERS;
+    config_callback_[node_insert_workers] = empty_map;
+
+    std::string node_ddl_workers = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_DDL_WORKERS;
+    config_callback_[node_ddl_workers] = empty_map;
+
+    std::string node_maintenance_workers = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_MAINTENANCE_WORKERS;
+    config_callback_[node_maintenance_workers] = empty_map;
+
+    std::string node_request_queue_depth = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_REQUEST_QUEUE_DEPTH;
+    config_callback_[node_request_queue_depth] = empty_map;
+
+    // wal config
+    std::string node_wal_buffer_size = std::string(CONFIG_WAL) + "." + CONFIG_WAL_BUFFER_SIZE;
+    config_callback_[node_wal_buffer_size] = empty_map;
+
     // gpu resources config
     std::string node_gpu_enable = std::string(CONFIG_GPU_RESOURCE) + "." + CONFIG_GPU_RESOURCE_ENABLE;
     config_callback_[node_gpu_enable] = empty_map;
@@ -260,6 +436,15 @@ Config::ValidateConfig() {
     std::string cluster_role;
     STATUS_CHECK(GetClusterConfigRole(cluster_role));
 
+    int64_t cluster_replica_refresh_interval;
+    STATUS_CHECK(GetClusterConfigReplicaRefreshInterval(cluster_replica_refresh_interval));
+
+    std::vector<std::vector<std::string>> cluster_shards;
+    STATUS_CHECK(GetClusterConfigShards(cluster_shards));
+
+    int64_t cluster_hedge_delay;
+    STATUS_CHECK(GetClusterConfigHedgeDelay(cluster_hedge_delay));
+
     /* general config */
     std::string general_timezone;
     STATUS_CHECK(GetGeneralConfigTimezone(general_timezone));
@@ -267,6 +452,9 @@ Config::ValidateConfig() {
     std::string general_metauri;
     STATUS_CHECK(GetGeneralConfigMetaURI(general_metauri));
 
+    int64_t meta_cache_ttl;
+    STATUS_CHECK(GetGeneralConfigMetaCacheTTL(meta_cache_ttl));
+
     /* network config */
     std::string bind_address;
     STATUS_CHECK(GetNetworkConfigBindAddress(bind_address));
@@ -280,6 +468,24 @@ Config::ValidateConfig() {
     std::string http_port;
     STATUS_CHECK(GetNetworkConfigHTTPPort(http_port));
 
+    bool http_async = false;
+    STATUS_CHECK(GetNetworkConfigHTTPAsync(http_async));
+
+    int64_t http_io_threads;
+    STATUS_CHECK(GetNetworkConfigHTTPIOThreads(http_io_threads));
+
+    int64_t http_worker_threads;
+    STATUS_CHECK(GetNetworkConfigHTTPWorkerThreads(http_worker_threads));
+
+    bool grpc_async = false;
+    STATUS_CHECK(GetNetworkConfigGrpcAsync(grpc_async));
+
+    std::string grpc_capture_path;
+    STATUS_CHECK(GetNetworkConfigGrpcCapturePath(grpc_capture_path));
+
+    int64_t grpc_capture_size;
+    STATUS_CHECK(GetNetworkConfigGrpcCaptureSize(grpc_capture_size));
+
     /* db config */
     int64_t db_archive_disk_threshold;
     STATUS_CHECK(GetDBConfigArchiveDiskThreshold(db_archive_disk_threshold));
@@ -294,6 +500,51 @@ Config::ValidateConfig() {
     int64_t auto_flush_interval;
     STATUS_CHECK(GetStorageConfigAutoFlushInterval(auto_flush_interval));
 
+    bool raw_vector_mmap;
+    STATUS_CHECK(GetStorageConfigRawVectorMmap(raw_vector_mmap));
+
+    bool raw_data_compress;
+    STATUS_CHECK(GetStorageConfigRawDataCompress(raw_data_compress));
+
+    bool blocked_bloom_filter;
+    STATUS_CHECK(GetStorageConfigBlockedBloomFilter(blocked_bloom_filter));
+
+    std::string merge_strategy;
+    STATUS_CHECK(GetStorageConfigMergeStrategy(merge_strategy));
+
+    int64_t merge_write_amplification;
+    STATUS_CHECK(GetStorageConfigMergeWriteAmplification(merge_write_amplification));
+
+    int64_t merge_bytes_limit;
+    STATUS_CHECK(GetStorageConfigMergeBytesLimit(merge_bytes_limit));
+
+    float compact_threshold;
+    STATUS_CHECK(GetStorageConfigCompactThreshold(compact_threshold));
+
+    int64_t compact_bytes_limit;
+    STATUS_CHECK(GetStorageConfigCompactBytesLimit(compact_bytes_limit));
+
+    int64_t read_coalesce_gap;
+    STATUS_CHECK(GetStorageConfigReadCoalesceGap(read_coalesce_gap));
+
+    std::string cold_path;
+    STATUS_CHECK(GetStorageConfigColdPath(cold_path));
+
+    int64_t hot_capacity;
+    STATUS_CHECK(GetStorageConfigHotCapacity(hot_capacity));
+
+    int64_t gc_thread_num;
+    STATUS_CHECK(GetStorageConfigGCThreadNum(gc_thread_num));
+
+    int64_t gc_unlink_rate;
+    STATUS_CHECK(GetStorageConfigGCUnlinkRate(gc_unlink_rate));
+
+    int64_t background_io_rate;
+    STATUS_CHECK(GetStorageConfigBackgroundIORate(background_io_rate));
+
+    float io_latency_target;
+    STATUS_CHECK(GetStorageConfigIOLatencyTarget(io_latency_target));
+
     // bool storage_s3_enable;
     // STATUS_CHECK(GetStorageConfigS3Enable(storage_s3_enable));
     // // std::cout << "S3 " << (storage_s3_enable ? "ENABLED !" : "DISABLED !") << std::endl;
@@ -323,6 +574,15 @@ Config::ValidateConfig() {
     std::string metric_port;
     STATUS_CHECK(GetMetricConfigPort(metric_port));
 
+    int64_t metric_profiling_interval;
+    STATUS_CHECK(GetMetricConfigProfilingInterval(metric_profiling_interval));
+
+    int64_t metric_profiling_duration;
+    STATUS_CHECK(GetMetricConfigProfilingDuration(metric_profiling_duration));
+
+    float metric_recall_sample_rate;
+    STATUS_CHECK(GetMetricConfigRecallSampleRate(metric_recall_sample_rate));
+
     /* cache config */
     int64_t cache_cpu_cache_capacity;
     STATUS_CHECK(GetCacheConfigCpuCacheCapacity(cache_cpu_cache_capacity));
@@ -330,15 +590,45 @@ Config::ValidateConfig() {
     float cache_cpu_cache_threshold;
     STATUS_CHECK(GetCacheConfigCpuCacheThreshold(cache_cpu_cache_threshold));
 
+    int64_t cpu_cache_shard_num;
+    STATUS_CHECK(GetCacheConfigCpuCacheShardNum(cpu_cache_shard_num));
+
+    std::string cpu_cache_policy;
+    STATUS_CHECK(GetCacheConfigCpuCachePolicy(cpu_cache_policy));
+
+    int64_t reclaim_queue_size;
+    STATUS_CHECK(GetCacheConfigReclaimQueueSize(reclaim_queue_size));
+
+    int64_t result_cache_capacity;
+    STATUS_CHECK(GetCacheConfigResultCacheCapacity(result_cache_capacity));
+
     int64_t cache_insert_buffer_size;
     STATUS_CHECK(GetCacheConfigInsertBufferSize(cache_insert_buffer_size));
 
+    float cache_insert_buffer_target;
+    STATUS_CHECK(GetCacheConfigInsertBufferTarget(cache_insert_buffer_target));
+
     bool cache_insert_data;
     STATUS_CHECK(GetCacheConfigCacheInsertData(cache_insert_data));
 
     std::string cache_preload_collection;
     STATUS_CHECK(GetCacheConfigPreloadCollection(cache_preload_collection));
 
+    int64_t cache_memory_limit;
+    STATUS_CHECK(GetCacheConfigMemoryLimit(cache_memory_limit));
+
+    int64_t cache_preload_thread_num;
+    STATUS_CHECK(GetCacheConfigPreloadThreadNum(cache_preload_thread_num));
+
+    int64_t cache_preload_bandwidth;
+    STATUS_CHECK(GetCacheConfigPreloadBandwidth(cache_preload_bandwidth));
+
+    int64_t cache_warm_up_size;
+    STATUS_CHECK(GetCacheConfigWarmUpSize(cache_warm_up_size));
+
+    bool cache_write_through_index;
+    STATUS_CHECK(GetCacheConfigWriteThroughIndex(cache_write_through_index));
+
     /* engine config */
     int64_t engine_use_blas_threshold;
     STATUS_CHECK(GetEngineConfigUseBlasThreshold(engine_use_blas_threshold));
@@ -349,6 +639,54 @@ Config::ValidateConfig() {
     std::string engine_simd_type;
     STATUS_CHECK(GetEngineConfigSimdType(engine_simd_type));
 
+    int64_t engine_search_combine_wait_us;
+    STATUS_CHECK(GetEngineSearchCombineWaitUs(engine_search_combine_wait_us));
+
+    bool engine_parallel_reduce;
+    STATUS_CHECK(GetEngineConfigParallelReduce(engine_parallel_reduce));
+
+    int64_t engine_executor_threads;
+    STATUS_CHECK(GetEngineConfigExecutorThreads(engine_executor_threads));
+
+    int64_t engine_prefetch_depth;
+    STATUS_CHECK(GetEngineConfigPrefetchDepth(engine_prefetch_depth));
+
+    int64_t engine_search_workers;
+    STATUS_CHECK(GetEngineConfigSearchWorkers(engine_search_workers));
+
+    int64_t engine_insert_workers;
+    STATUS_CHECK(GetEngineConfigInsertWorkers(engine_insert_workers));
+
+    int64_t engine_ddl_workers;
+    STATUS_CHECK(GetEngineConfigDdlWorkers(engine_ddl_workers));
+
+    int64_t engine_maintenance_workers;
+    STATUS_CHECK(GetEngineConfigMaintenanceWorkers(engine_maintenance_workers));
+
+    int64_t engine_request_queue_depth;
+    STATUS_CHECK(GetEngineConfigRequestQueueDepth(engine_request_queue_depth));
+
+    float engine_build_cpu_share;
+    STATUS_CHECK(GetEngineConfigBuildCpuShare(engine_build_cpu_share));
+
+    int64_t engine_search_latency_slo_ms;
+    STATUS_CHECK(GetEngineConfigSearchLatencySloMs(engine_search_latency_slo_ms));
+
+    bool engine_search_insert_buffer;
+    STATUS_CHECK(GetEngineConfigSearchInsertBuffer(engine_search_insert_buffer));
+
+    bool engine_numa_aware;
+    STATUS_CHECK(GetEngineConfigNumaAware(engine_numa_aware));
+
+    bool engine_huge_page;
+    STATUS_CHECK(GetEngineConfigHugePage(engine_huge_page));
+
+    std::string engine_raw_vector_compression;
+    STATUS_CHECK(GetEngineConfigRawVectorCompression(engine_raw_vector_compression));
+
+    int64_t engine_search_memory_limit;
+    STATUS_CHECK(GetEngineConfigSearchMemoryLimit(engine_search_memory_limit));
+
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
     bool gpu_resource_enable;
@@ -362,6 +700,24 @@ Config::ValidateConfig() {
         float resource_cache_threshold;
         STATUS_CHECK(GetGpuResourceConfigCacheThreshold(resource_cache_threshold));
 
+        std::string resource_cache_policy;
+        STATUS_CHECK(GetGpuResourceConfigCachePolicy(resource_cache_policy));
+
+        int64_t resource_prefetch_depth;
+        STATUS_CHECK(GetGpuResourceConfigPrefetchDepth(resource_prefetch_depth));
+
+        bool resource_cost_placement;
+        STATUS_CHECK(GetGpuResourceConfigCostPlacement(resource_cost_placement));
+
+        bool resource_build_index_sharded;
+        STATUS_CHECK(GetGpuResourceConfigBuildIndexSharded(resource_build_index_sharded));
+
+        bool resource_search_sharded;
+        STATUS_CHECK(GetGpuResourceConfigSearchSharded(resource_search_sharded));
+
+        bool resource_keep_fresh_segments;
+        STATUS_CHECK(GetGpuResourceConfigKeepFreshSegments(resource_keep_fresh_segments));
+
         int64_t engine_gpu_search_threshold;
         STATUS_CHECK(GetGpuResourceConfigGpuSearchThreshold(engine_gpu_search_threshold));
 
@@ -377,6 +733,21 @@ Config::ValidateConfig() {
     std::string tracing_config_path;
     STATUS_CHECK(GetTracingConfigJsonConfigPath(tracing_config_path));
 
+    float tracing_search_sample_rate;
+    STATUS_CHECK(GetTracingConfigSearchSampleRate(tracing_search_sample_rate));
+
+    float tracing_insert_sample_rate;
+    STATUS_CHECK(GetTracingConfigInsertSampleRate(tracing_insert_sample_rate));
+
+    float tracing_ddl_sample_rate;
+    STATUS_CHECK(GetTracingConfigDdlSampleRate(tracing_ddl_sample_rate));
+
+    float tracing_maintenance_sample_rate;
+    STATUS_CHECK(GetTracingConfigMaintenanceSampleRate(tracing_maintenance_sample_rate));
+
+    float tracing_info_sample_rate;
+    STATUS_CHECK(GetTracingConfigInfoSampleRate(tracing_info_sample_rate));
+
     /* wal config */
     bool enable;
     STATUS_CHECK(GetWalConfigEnable(enable));
@@ -390,6 +761,18 @@ Config::ValidateConfig() {
     std::string wal_path;
     STATUS_CHECK(GetWalConfigWalPath(wal_path));
 
+    std::string sync_mode;
+    STATUS_CHECK(GetWalConfigSyncMode(sync_mode));
+
+    int64_t sync_interval;
+    STATUS_CHECK(GetWalConfigSyncInterval(sync_interval));
+
+    int64_t recovery_thread_num;
+    STATUS_CHECK(GetWalConfigRecoveryThreadNum(recovery_thread_num));
+
+    bool compress;
+    STATUS_CHECK(GetWalConfigCompress(compress));
+
     /* logs config */
     std::string logs_level;
     STATUS_CHECK(GetLogsLevel(logs_level));
@@ -406,6 +789,15 @@ Config::ValidateConfig() {
     int64_t logs_log_rotate_num;
     STATUS_CHECK(GetLogsLogRotateNum(logs_log_rotate_num));
 
+    bool logs_async_enable;
+    STATUS_CHECK(GetLogsAsyncEnable(logs_async_enable));
+
+    int64_t logs_async_buffer_size;
+    STATUS_CHECK(GetLogsAsyncBufferSize(logs_async_buffer_size));
+
+    int64_t logs_async_rate_limit;
+    STATUS_CHECK(GetLogsAsyncRateLimit(logs_async_rate_limit));
+
     return Status::OK();
 }
 
@@ -414,16 +806,26 @@ Config::ResetDefaultConfig() {
     /* cluster config */
     STATUS_CHECK(SetClusterConfigEnable(CONFIG_CLUSTER_ENABLE_DEFAULT));
     STATUS_CHECK(SetClusterConfigRole(CONFIG_CLUSTER_ROLE_DEFAULT));
+    STATUS_CHECK(SetClusterConfigReplicaRefreshInterval(CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL_DEFAULT));
+    STATUS_CHECK(SetClusterConfigShards(CONFIG_CLUSTER_SHARDS_DEFAULT));
+    STATUS_CHECK(SetClusterConfigHedgeDelay(CONFIG_CLUSTER_HEDGE_DELAY_DEFAULT));
 
     /* general config */
     STATUS_CHECK(SetGeneralConfigTimezone(CONFIG_GENERAL_TIMEZONE_DEFAULT));
     STATUS_CHECK(SetGeneralConfigMetaURI(CONFIG_GENERAL_METAURI_DEFAULT));
+    STATUS_CHECK(SetGeneralConfigMetaCacheTTL(CONFIG_GENERAL_META_CACHE_TTL_DEFAULT));
 
     /* network config */
     STATUS_CHECK(SetNetworkConfigBindAddress(CONFIG_NETWORK_BIND_ADDRESS_DEFAULT));
     STATUS_CHECK(SetNetworkConfigBindPort(CONFIG_NETWORK_BIND_PORT_DEFAULT));
     STATUS_CHECK(SetNetworkConfigHTTPEnable(CONFIG_NETWORK_HTTP_ENABLE_DEFAULT));
     STATUS_CHECK(SetNetworkConfigHTTPPort(CONFIG_NETWORK_HTTP_PORT_DEFAULT));
+    STATUS_CHECK(SetNetworkConfigHTTPAsync(CONFIG_NETWORK_HTTP_ASYNC_DEFAULT));
+    STATUS_CHECK(SetNetworkConfigHTTPIOThreads(CONFIG_NETWORK_HTTP_IO_THREADS_DEFAULT));
+    STATUS_CHECK(SetNetworkConfigHTTPWorkerThreads(CONFIG_NETWORK_HTTP_WORKER_THREADS_DEFAULT));
+    STATUS_CHECK(SetNetworkConfigGrpcAsync(CONFIG_NETWORK_GRPC_ASYNC_DEFAULT));
+    STATUS_CHECK(SetNetworkConfigGrpcCapturePath(CONFIG_NETWORK_GRPC_CAPTURE_PATH_DEFAULT));
+    STATUS_CHECK(SetNetworkConfigGrpcCaptureSize(CONFIG_NETWORK_GRPC_CAPTURE_SIZE_DEFAULT));
 
     /* db config */
     STATUS_CHECK(SetDBConfigArchiveDiskThreshold(CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT));
@@ -432,6 +834,21 @@ Config::ResetDefaultConfig() {
     /* storage config */
     STATUS_CHECK(SetStorageConfigPath(CONFIG_STORAGE_PATH_DEFAULT));
     STATUS_CHECK(SetStorageConfigAutoFlushInterval(CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT));
+    STATUS_CHECK(SetStorageConfigRawVectorMmap(CONFIG_STORAGE_RAW_VECTOR_MMAP_DEFAULT));
+    STATUS_CHECK(SetStorageConfigRawDataCompress(CONFIG_STORAGE_RAW_DATA_COMPRESS_DEFAULT));
+    STATUS_CHECK(SetStorageConfigBlockedBloomFilter(CONFIG_STORAGE_BLOCKED_BLOOM_FILTER_DEFAULT));
+    STATUS_CHECK(SetStorageConfigMergeStrategy(CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT));
+    STATUS_CHECK(SetStorageConfigMergeWriteAmplification(CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION_DEFAULT));
+    STATUS_CHECK(SetStorageConfigMergeBytesLimit(CONFIG_STORAGE_MERGE_BYTES_LIMIT_DEFAULT));
+    STATUS_CHECK(SetStorageConfigCompactThreshold(CONFIG_STORAGE_COMPACT_THRESHOLD_DEFAULT));
+    STATUS_CHECK(SetStorageConfigCompactBytesLimit(CONFIG_STORAGE_COMPACT_BYTES_LIMIT_DEFAULT));
+    STATUS_CHECK(SetStorageConfigReadCoalesceGap(CONFIG_STORAGE_READ_COALESCE_GAP_DEFAULT));
+    STATUS_CHECK(SetStorageConfigColdPath(CONFIG_STORAGE_COLD_PATH_DEFAULT));
+    STATUS_CHECK(SetStorageConfigHotCapacity(CONFIG_STORAGE_HOT_CAPACITY_DEFAULT));
+    STATUS_CHECK(SetStorageConfigGCThreadNum(CONFIG_STORAGE_GC_THREAD_NUM_DEFAULT));
+    STATUS_CHECK(SetStorageConfigGCUnlinkRate(CONFIG_STORAGE_GC_UNLINK_RATE_DEFAULT));
+    STATUS_CHECK(SetStorageConfigBackgroundIORate(CONFIG_STORAGE_BACKGROUND_IO_RATE_DEFAULT));
+    STATUS_CHECK(SetStorageConfigIOLatencyTarget(CONFIG_STORAGE_IO_LATENCY_TARGET_DEFAULT));
     STATUS_CHECK(SetStorageConfigFileCleanupTimeout(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Enable(CONFIG_STORAGE_S3_ENABLE_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Address(CONFIG_STORAGE_S3_ADDRESS_DEFAULT));
@@ -444,35 +861,81 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetMetricConfigEnableMonitor(CONFIG_METRIC_ENABLE_MONITOR_DEFAULT));
     STATUS_CHECK(SetMetricConfigAddress(CONFIG_METRIC_ADDRESS_DEFAULT));
     STATUS_CHECK(SetMetricConfigPort(CONFIG_METRIC_PORT_DEFAULT));
+    STATUS_CHECK(SetMetricConfigProfilingInterval(CONFIG_METRIC_PROFILING_INTERVAL_DEFAULT));
+    STATUS_CHECK(SetMetricConfigProfilingDuration(CONFIG_METRIC_PROFILING_DURATION_DEFAULT));
+    STATUS_CHECK(SetMetricConfigRecallSampleRate(CONFIG_METRIC_RECALL_SAMPLE_RATE_DEFAULT));
 
     /* cache config */
     STATUS_CHECK(SetCacheConfigCpuCacheCapacity(CONFIG_CACHE_CPU_CACHE_CAPACITY_DEFAULT));
     STATUS_CHECK(SetCacheConfigCpuCacheThreshold(CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT));
+    STATUS_CHECK(SetCacheConfigCpuCacheShardNum(CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT));
+    STATUS_CHECK(SetCacheConfigCpuCachePolicy(CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT));
+    STATUS_CHECK(SetCacheConfigReclaimQueueSize(CONFIG_CACHE_RECLAIM_QUEUE_SIZE_DEFAULT));
+    STATUS_CHECK(SetCacheConfigResultCacheCapacity(CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT));
     STATUS_CHECK(SetCacheConfigInsertBufferSize(CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT));
+    STATUS_CHECK(SetCacheConfigInsertBufferTarget(CONFIG_CACHE_INSERT_BUFFER_TARGET_DEFAULT));
     STATUS_CHECK(SetCacheConfigCacheInsertData(CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT));
     STATUS_CHECK(SetCacheConfigPreloadCollection(CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT));
+    STATUS_CHECK(SetCacheConfigMemoryLimit(CONFIG_CACHE_MEMORY_LIMIT_DEFAULT));
+    STATUS_CHECK(SetCacheConfigPreloadThreadNum(CONFIG_CACHE_PRELOAD_THREAD_NUM_DEFAULT));
+    STATUS_CHECK(SetCacheConfigPreloadBandwidth(CONFIG_CACHE_PRELOAD_BANDWIDTH_DEFAULT));
+    STATUS_CHECK(SetCacheConfigWarmUpSize(CONFIG_CACHE_WARM_UP_SIZE_DEFAULT));
+    STATUS_CHECK(SetCacheConfigWriteThroughIndex(CONFIG_CACHE_WRITE_THROUGH_INDEX_DEFAULT));
 
     /* engine config */
     STATUS_CHECK(SetEngineConfigUseBlasThreshold(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetEngineConfigOmpThreadNum(CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT));
     STATUS_CHECK(SetEngineConfigSimdType(CONFIG_ENGINE_SIMD_TYPE_DEFAULT));
     STATUS_CHECK(SetEngineSearchCombineMaxNq(CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT));
+    STATUS_CHECK(SetEngineSearchCombineWaitUs(CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US_DEFAULT));
+    STATUS_CHECK(SetEngineConfigParallelReduce(CONFIG_ENGINE_PARALLEL_REDUCE_DEFAULT));
+    STATUS_CHECK(SetEngineConfigExecutorThreads(CONFIG_ENGINE_EXECUTOR_THREADS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigPrefetchDepth(CONFIG_ENGINE_PREFETCH_DEPTH_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchWorkers(CONFIG_ENGINE_SEARCH_WORKERS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigInsertWorkers(CONFIG_ENGINE_INSERT_WORKERS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigDdlWorkers(CONFIG_ENGINE_DDL_WORKERS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigMaintenanceWorkers(CONFIG_ENGINE_MAINTENANCE_WORKERS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigRequestQueueDepth(CONFIG_ENGINE_REQUEST_QUEUE_DEPTH_DEFAULT));
+    STATUS_CHECK(SetEngineConfigBuildCpuShare(CONFIG_ENGINE_BUILD_CPU_SHARE_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchLatencySloMs(CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchInsertBuffer(CONFIG_ENGINE_SEARCH_INSERT_BUFFER_DEFAULT));
+    STATUS_CHECK(SetEngineConfigNumaAware(CONFIG_ENGINE_NUMA_AWARE_DEFAULT));
+    STATUS_CHECK(SetEngineConfigHugePage(CONFIG_ENGINE_HUGE_PAGE_DEFAULT));
+    STATUS_CHECK(SetEngineConfigRawVectorCompression(CONFIG_ENGINE_RAW_VECTOR_COMPRESSION_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchMemoryLimit(CONFIG_ENGINE_SEARCH_MEMORY_LIMIT_DEFAULT));
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
     STATUS_CHECK(SetGpuResourceConfigEnable(CONFIG_GPU_RESOURCE_ENABLE_DEFAULT));
     STATUS_CHECK(SetGpuResourceConfigCacheCapacity(CONFIG_GPU_RESOURCE_CACHE_CAPACITY_DEFAULT));
     STATUS_CHECK(SetGpuResourceConfigCacheThreshold(CONFIG_GPU_RESOURCE_CACHE_THRESHOLD_DEFAULT));
+    STATUS_CHECK(SetGpuResourceConfigCachePolicy(CONFIG_GPU_RESOURCE_CACHE_POLICY_DEFAULT));
+    STATUS_CHECK(SetGpuResourceConfigPrefetchDepth(CONFIG_GPU_RESOURCE_PREFETCH_DEPTH_DEFAULT));
+    STATUS_CHECK(SetGpuResourceConfigCostPlacement(CONFIG_GPU_RESOURCE_COST_PLACEMENT_DEFAULT));
+    STATUS_CHECK(SetGpuResourceConfigBuildIndexSharded(CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED_DEFAULT));
+    STATUS_CHECK(SetGpuResourceConfigSearchSharded(CONFIG_GPU_RESOURCE_SEARCH_SHARDED_DEFAULT));
+    STATUS_CHECK(SetGpuResourceConfigKeepFreshSegments(CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS_DEFAULT));
     STATUS_CHECK(SetGpuResourceConfigGpuSearchThreshold(CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetGpuResourceConfigSearchResources(CONFIG_GPU_RESOURCE_SEARCH_RESOURCES_DEFAULT));
     STATUS_CHECK(SetGpuResourceConfigBuildIndexResources(CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES_DEFAULT));
 #endif
 
+    /* tracing config */
+    STATUS_CHECK(SetTracingConfigSearchSampleRate(CONFIG_TRACING_SEARCH_SAMPLE_RATE_DEFAULT));
+    STATUS_CHECK(SetTracingConfigInsertSampleRate(CONFIG_TRACING_INSERT_SAMPLE_RATE_DEFAULT));
+    STATUS_CHECK(SetTracingConfigDdlSampleRate(CONFIG_TRACING_DDL_SAMPLE_RATE_DEFAULT));
+    STATUS_CHECK(SetTracingConfigMaintenanceSampleRate(CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE_DEFAULT));
+    STATUS_CHECK(SetTracingConfigInfoSampleRate(CONFIG_TRACING_INFO_SAMPLE_RATE_DEFAULT));
+
     /* wal config */
     STATUS_CHECK(SetWalConfigEnable(CONFIG_WAL_ENABLE_DEFAULT));
     STATUS_CHECK(SetWalConfigRecoveryErrorIgnore(CONFIG_WAL_RECOVERY_ERROR_IGNORE_DEFAULT));
     STATUS_CHECK(SetWalConfigBufferSize(CONFIG_WAL_BUFFER_SIZE_DEFAULT));
     STATUS_CHECK(SetWalConfigWalPath(CONFIG_WAL_WAL_PATH_DEFAULT));
+    STATUS_CHECK(SetWalConfigSyncMode(CONFIG_WAL_SYNC_MODE_DEFAULT));
+    STATUS_CHECK(SetWalConfigSyncInterval(CONFIG_WAL_SYNC_INTERVAL_DEFAULT));
+    STATUS_CHECK(SetWalConfigRecoveryThreadNum(CONFIG_WAL_RECOVERY_THREAD_NUM_DEFAULT));
+    STATUS_CHECK(SetWalConfigCompress(CONFIG_WAL_COMPRESS_DEFAULT));
 
     /* logs config */
     STATUS_CHECK(SetLogsLevel(CONFIG_LOGS_LEVEL_DEFAULT));
@@ -480,6 +943,9 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetLogsPath(CONFIG_LOGS_PATH_DEFAULT));
     STATUS_CHECK(SetLogsMaxLogFileSize(CONFIG_LOGS_MAX_LOG_FILE_SIZE_DEFAULT));
     STATUS_CHECK(SetLogsLogRotateNum(CONFIG_LOGS_LOG_ROTATE_NUM_DEFAULT));
+    STATUS_CHECK(SetLogsAsyncEnable(CONFIG_LOGS_ASYNC_ENABLE_DEFAULT));
+    STATUS_CHECK(SetLogsAsyncBufferSize(CONFIG_LOGS_ASYNC_BUFFER_SIZE_DEFAULT));
+    STATUS_CHECK(SetLogsAsyncRateLimit(CONFIG_LOGS_ASYNC_RATE_LIMIT_DEFAULT));
 
     return Status::OK();
 }
@@ -512,6 +978,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetClusterConfigEnable(value);
         } else if (child_key == CONFIG_CLUSTER_ROLE) {
             status = SetClusterConfigRole(value);
+        } else if (child_key == CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL) {
+            status = SetClusterConfigReplicaRefreshInterval(value);
+        } else if (child_key == CONFIG_CLUSTER_SHARDS) {
+            status = SetClusterConfigShards(value);
+        } else if (child_key == CONFIG_CLUSTER_HEDGE_DELAY) {
+            status = SetClusterConfigHedgeDelay(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -520,6 +992,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetGeneralConfigTimezone(value);
         } else if (child_key == CONFIG_GENERAL_METAURI) {
             status = SetGeneralConfigMetaURI(value);
+        } else if (child_key == CONFIG_GENERAL_META_CACHE_TTL) {
+            status = SetGeneralConfigMetaCacheTTL(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -538,6 +1012,36 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetStorageConfigPath(value);
         } else if (child_key == CONFIG_STORAGE_AUTO_FLUSH_INTERVAL) {
             status = SetStorageConfigAutoFlushInterval(value);
+        } else if (child_key == CONFIG_STORAGE_RAW_VECTOR_MMAP) {
+            status = SetStorageConfigRawVectorMmap(value);
+        } else if (child_key == CONFIG_STORAGE_RAW_DATA_COMPRESS) {
+            status = SetStorageConfigRawDataCompress(value);
+        } else if (child_key == CONFIG_STORAGE_BLOCKED_BLOOM_FILTER) {
+            status = SetStorageConfigBlockedBloomFilter(value);
+        } else if (child_key == CONFIG_STORAGE_MERGE_STRATEGY) {
+            status = SetStorageConfigMergeStrategy(value);
+        } else if (child_key == CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION) {
+            status = SetStorageConfigMergeWriteAmplification(value);
+        } else if (child_key == CONFIG_STORAGE_MERGE_BYTES_LIMIT) {
+            status = SetStorageConfigMergeBytesLimit(value);
+        } else if (child_key == CONFIG_STORAGE_COMPACT_THRESHOLD) {
+            status = SetStorageConfigCompactThreshold(value);
+        } else if (child_key == CONFIG_STORAGE_COMPACT_BYTES_LIMIT) {
+            status = SetStorageConfigCompactBytesLimit(value);
+        } else if (child_key == CONFIG_STORAGE_READ_COALESCE_GAP) {
+            status = SetStorageConfigReadCoalesceGap(value);
+        } else if (child_key == CONFIG_STORAGE_COLD_PATH) {
+            status = SetStorageConfigColdPath(value);
+        } else if (child_key == CONFIG_STORAGE_HOT_CAPACITY) {
+            status = SetStorageConfigHotCapacity(value);
+        } else if (child_key == CONFIG_STORAGE_GC_THREAD_NUM) {
+            status = SetStorageConfigGCThreadNum(value);
+        } else if (child_key == CONFIG_STORAGE_GC_UNLINK_RATE) {
+            status = SetStorageConfigGCUnlinkRate(value);
+        } else if (child_key == CONFIG_STORAGE_BACKGROUND_IO_RATE) {
+            status = SetStorageConfigBackgroundIORate(value);
+        } else if (child_key == CONFIG_STORAGE_IO_LATENCY_TARGET) {
+            status = SetStorageConfigIOLatencyTarget(value);
             // } else if (child_key == CONFIG_STORAGE_S3_ENABLE) {
             //     status = SetStorageConfigS3Enable(value);
             // } else if (child_key == CONFIG_STORAGE_S3_ADDRESS) {
@@ -560,6 +1064,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetMetricConfigAddress(value);
         } else if (child_key == CONFIG_METRIC_PORT) {
             status = SetMetricConfigPort(value);
+        } else if (child_key == CONFIG_METRIC_PROFILING_INTERVAL) {
+            status = SetMetricConfigProfilingInterval(value);
+        } else if (child_key == CONFIG_METRIC_PROFILING_DURATION) {
+            status = SetMetricConfigProfilingDuration(value);
+        } else if (child_key == CONFIG_METRIC_RECALL_SAMPLE_RATE) {
+            status = SetMetricConfigRecallSampleRate(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -568,12 +1078,32 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetCacheConfigCpuCacheCapacity(value);
         } else if (child_key == CONFIG_CACHE_CPU_CACHE_THRESHOLD) {
             status = SetCacheConfigCpuCacheThreshold(value);
+        } else if (child_key == CONFIG_CACHE_CPU_CACHE_SHARD_NUM) {
+            status = SetCacheConfigCpuCacheShardNum(value);
+        } else if (child_key == CONFIG_CACHE_CPU_CACHE_POLICY) {
+            status = SetCacheConfigCpuCachePolicy(value);
+        } else if (child_key == CONFIG_CACHE_RECLAIM_QUEUE_SIZE) {
+            status = SetCacheConfigReclaimQueueSize(value);
+        } else if (child_key == CONFIG_CACHE_RESULT_CACHE_CAPACITY) {
+            status = SetCacheConfigResultCacheCapacity(value);
         } else if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA) {
             status = SetCacheConfigCacheInsertData(value);
         } else if (child_key == CONFIG_CACHE_INSERT_BUFFER_SIZE) {
             status = SetCacheConfigInsertBufferSize(value);
+        } else if (child_key == CONFIG_CACHE_INSERT_BUFFER_TARGET) {
+            status = SetCacheConfigInsertBufferTarget(value);
         } else if (child_key == CONFIG_CACHE_PRELOAD_COLLECTION) {
             status = SetCacheConfigPreloadCollection(value);
+        } else if (child_key == CONFIG_CACHE_MEMORY_LIMIT) {
+            status = SetCacheConfigMemoryLimit(value);
+        } else if (child_key == CONFIG_CACHE_PRELOAD_THREAD_NUM) {
+            status = SetCacheConfigPreloadThreadNum(value);
+        } else if (child_key == CONFIG_CACHE_PRELOAD_BANDWIDTH) {
+            status = SetCacheConfigPreloadBandwidth(value);
+        } else if (child_key == CONFIG_CACHE_WARM_UP_SIZE) {
+            status = SetCacheConfigWarmUpSize(value);
+        } else if (child_key == CONFIG_CACHE_WRITE_THROUGH_INDEX) {
+            status = SetCacheConfigWriteThroughIndex(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -586,6 +1116,38 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetEngineConfigSimdType(value);
         } else if (child_key == CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ) {
             status = SetEngineSearchCombineMaxNq(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US) {
+            status = SetEngineSearchCombineWaitUs(value);
+        } else if (child_key == CONFIG_ENGINE_PARALLEL_REDUCE) {
+            status = SetEngineConfigParallelReduce(value);
+        } else if (child_key == CONFIG_ENGINE_EXECUTOR_THREADS) {
+            status = SetEngineConfigExecutorThreads(value);
+        } else if (child_key == CONFIG_ENGINE_PREFETCH_DEPTH) {
+            status = SetEngineConfigPrefetchDepth(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_WORKERS) {
+            status = SetEngineConfigSearchWorkers(value);
+        } else if (child_key == CONFIG_ENGINE_INSERT_WORKERS) {
+            status = SetEngineConfigInsertWorkers(value);
+        } else if (child_key == CONFIG_ENGINE_DDL_WORKERS) {
+            status = SetEngineConfigDdlWorkers(value);
+        } else if (child_key == CONFIG_ENGINE_MAINTENANCE_WORKERS) {
+            status = SetEngineConfigMaintenanceWorkers(value);
+        } else if (child_key == CONFIG_ENGINE_REQUEST_QUEUE_DEPTH) {
+            status = SetEngineConfigRequestQueueDepth(value);
+        } else if (child_key == CONFIG_ENGINE_BUILD_CPU_SHARE) {
+            status = SetEngineConfigBuildCpuShare(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS) {
+            status = SetEngineConfigSearchLatencySloMs(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_INSERT_BUFFER) {
+            status = SetEngineConfigSearchInsertBuffer(value);
+        } else if (child_key == CONFIG_ENGINE_NUMA_AWARE) {
+            status = SetEngineConfigNumaAware(value);
+        } else if (child_key == CONFIG_ENGINE_HUGE_PAGE) {
+            status = SetEngineConfigHugePage(value);
+        } else if (child_key == CONFIG_ENGINE_RAW_VECTOR_COMPRESSION) {
+            status = SetEngineConfigRawVectorCompression(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_MEMORY_LIMIT) {
+            status = SetEngineConfigSearchMemoryLimit(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -597,6 +1159,18 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetGpuResourceConfigCacheCapacity(value);
         } else if (child_key == CONFIG_GPU_RESOURCE_CACHE_THRESHOLD) {
             status = SetGpuResourceConfigCacheThreshold(value);
+        } else if (child_key == CONFIG_GPU_RESOURCE_CACHE_POLICY) {
+            status = SetGpuResourceConfigCachePolicy(value);
+        } else if (child_key == CONFIG_GPU_RESOURCE_PREFETCH_DEPTH) {
+            status = SetGpuResourceConfigPrefetchDepth(value);
+        } else if (child_key == CONFIG_GPU_RESOURCE_COST_PLACEMENT) {
+            status = SetGpuResourceConfigCostPlacement(value);
+        } else if (child_key == CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED) {
+            status = SetGpuResourceConfigBuildIndexSharded(value);
+        } else if (child_key == CONFIG_GPU_RESOURCE_SEARCH_SHARDED) {
+            status = SetGpuResourceConfigSearchSharded(value);
+        } else if (child_key == CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS) {
+            status = SetGpuResourceConfigKeepFreshSegments(value);
         } else if (child_key == CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD) {
             status = SetGpuResourceConfigGpuSearchThreshold(value);
         } else if (child_key == CONFIG_GPU_RESOURCE_SEARCH_RESOURCES) {
@@ -610,6 +1184,16 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
     } else if (parent_key == CONFIG_TRACING) {
         if (child_key == CONFIG_TRACING_JSON_CONFIG_PATH) {
             status = SetTracingConfigJsonConfigPath(value);
+        } else if (child_key == CONFIG_TRACING_SEARCH_SAMPLE_RATE) {
+            status = SetTracingConfigSearchSampleRate(value);
+        } else if (child_key == CONFIG_TRACING_INSERT_SAMPLE_RATE) {
+            status = SetTracingConfigInsertSampleRate(value);
+        } else if (child_key == CONFIG_TRACING_DDL_SAMPLE_RATE) {
+            status = SetTracingConfigDdlSampleRate(value);
+        } else if (child_key == CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE) {
+            status = SetTracingConfigMaintenanceSampleRate(value);
+        } else if (child_key == CONFIG_TRACING_INFO_SAMPLE_RATE) {
+            status = SetTracingConfigInfoSampleRate(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -622,6 +1206,14 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetWalConfigBufferSize(value);
         } else if (child_key == CONFIG_WAL_WAL_PATH) {
             status = SetWalConfigWalPath(value);
+        } else if (child_key == CONFIG_WAL_SYNC_MODE) {
+            status = SetWalConfigSyncMode(value);
+        } else if (child_key == CONFIG_WAL_SYNC_INTERVAL) {
+            status = SetWalConfigSyncInterval(value);
+        } else if (child_key == CONFIG_WAL_RECOVERY_THREAD_NUM) {
+            status = SetWalConfigRecoveryThreadNum(value);
+        } else if (child_key == CONFIG_WAL_COMPRESS) {
+            status = SetWalConfigCompress(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -636,6 +1228,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetLogsMaxLogFileSize(value);
         } else if (child_key == CONFIG_LOGS_LOG_ROTATE_NUM) {
             status = SetLogsLogRotateNum(value);
+        } else if (child_key == CONFIG_LOGS_ASYNC_ENABLE) {
+            status = SetLogsAsyncEnable(value);
+        } else if (child_key == CONFIG_LOGS_ASYNC_BUFFER_SIZE) {
+            status = SetLogsAsyncBufferSize(value);
+        } else if (child_key == CONFIG_LOGS_ASYNC_RATE_LIMIT) {
+            status = SetLogsAsyncRateLimit(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -643,8 +1241,9 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
 
     if (status.ok()) {
         status = UpdateFileConfigFromMem(parent_key, child_key);
-        if (status.ok() &&
-            !(parent_key == CONFIG_CACHE || parent_key == CONFIG_ENGINE || parent_key == CONFIG_GPU_RESOURCE)) {
+        // the configs with a callback are applied by their handlers, the others take effect on restart
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        if (status.ok() && config_callback_.find(parent_key + "." + child_key) == config_callback_.end()) {
             restart_required_ = true;
         }
     }
@@ -754,7 +1353,7 @@ Config::UpdateFileConfigFromMem(const std::string& parent_key, const std::string
 
     // convert value string to standard string stored in yaml file
     std::string value_str;
-    if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA ||
+    if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA || child_key == CONFIG_CACHE_WRITE_THROUGH_INDEX ||
         // child_key == CONFIG_STORAGE_S3_ENABLE ||
         child_key == CONFIG_METRIC_ENABLE_MONITOR || child_key == CONFIG_GPU_RESOURCE_ENABLE ||
         child_key == CONFIG_WAL_ENABLE || child_key == CONFIG_WAL_RECOVERY_ERROR_IGNORE) {
@@ -898,6 +1497,88 @@ Config::CheckClusterConfigRole(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckClusterConfigReplicaRefreshInterval(const std::string& value) {
+    fiu_return_on("check_config_cluster_replica_refresh_interval_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid replica refresh interval: " + value +
+                          ". Possible reason: cluster.replica_refresh_interval is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 0 || v > 3600000) {
+            std::string msg = "Invalid replica refresh interval: " + value +
+                              ". Possible reason: cluster.replica_refresh_interval is not in range [0, 3600000].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+namespace {
+
+// "host:port,host:port;host:port" -- the shards are separated by ';', the replicas of a shard by ','
+Status
+ParseClusterShards(const std::string& value, std::vector<std::vector<std::string>>& shards) {
+    shards.clear();
+    if (value.empty()) {
+        return Status::OK();
+    }
+
+    std::vector<std::string> shard_strs;
+    StringHelpFunctions::SplitStringByDelimeter(value, ";", shard_strs);
+    for (auto& shard_str : shard_strs) {
+        std::vector<std::string> addresses;
+        StringHelpFunctions::SplitStringByDelimeter(shard_str, ",", addresses);
+        std::vector<std::string> replicas;
+        for (auto& address : addresses) {
+            StringHelpFunctions::TrimStringBlank(address);
+            auto pos = address.rfind(':');
+            if (pos == std::string::npos || pos == 0 || !ValidateStringIsNumber(address.substr(pos + 1)).ok()) {
+                std::string msg = "Invalid shard address: " + address +
+                                  ". Possible reason: cluster.shards is not a list of host:port.";
+                return Status(SERVER_INVALID_ARGUMENT, msg);
+            }
+            replicas.emplace_back(address);
+        }
+        if (replicas.empty()) {
+            return Status(SERVER_INVALID_ARGUMENT, "Invalid shards: " + value + ". A shard has no address.");
+        }
+        shards.emplace_back(replicas);
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+Status
+Config::CheckClusterConfigShards(const std::string& value) {
+    fiu_return_on("check_config_cluster_shards_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::vector<std::vector<std::string>> shards;
+    return ParseClusterShards(value, shards);
+}
+
+Status
+Config::CheckClusterConfigHedgeDelay(const std::string& value) {
+    fiu_return_on("check_config_cluster_hedge_delay_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid hedge delay: " + value +
+                          ". Possible reason: cluster.hedge_delay is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 0 || v > 60000) {
+            std::string msg = "Invalid hedge delay: " + value +
+                              ". Possible reason: cluster.hedge_delay is not in range [0, 60000].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 /* general config */
 Status
 Config::CheckGeneralConfigTimezone(const std::string& value) {
@@ -931,6 +1612,25 @@ Config::CheckGeneralConfigMetaURI(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckGeneralConfigMetaCacheTTL(const std::string& value) {
+    fiu_return_on("check_config_meta_cache_ttl_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid meta cache ttl: " + value +
+                          ". Possible reason: general.meta_cache_ttl is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 0 || v > 3600000) {
+            std::string msg = "Invalid meta cache ttl: " + value +
+                              ". Possible reason: general.meta_cache_ttl is not in range [0, 3600000].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 /* network config */
 Status
 Config::CheckNetworkConfigBindAddress(const std::string& value) {
@@ -992,6 +1692,63 @@ Config::CheckNetworkConfigHTTPPort(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckNetworkConfigHTTPAsync(const std::string& value) {
+    return ValidateStringIsBool(value);
+}
+
+Status
+Config::CheckNetworkConfigHTTPIOThreads(const std::string& value) {
+    if (!ValidateStringIsNumber(value).ok() || std::stoll(value) <= 0) {
+        std::string msg = "Invalid http io thread num: " + value +
+                          ". Possible reason: network.http.io_threads is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckNetworkConfigHTTPWorkerThreads(const std::string& value) {
+    if (!ValidateStringIsNumber(value).ok() || std::stoll(value) <= 0) {
+        std::string msg = "Invalid http worker thread num: " + value +
+                          ". Possible reason: network.http.worker_threads is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckNetworkConfigGrpcAsync(const std::string& value) {
+    return ValidateStringIsBool(value);
+}
+
+Status
+Config::CheckNetworkConfigGrpcCapturePath(const std::string& value) {
+    fiu_return_on("check_config_grpc_capture_path_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+    if (!value.empty() && value[0] != '/') {
+        std::string msg =
+            "Invalid capture path: " + value + ". Possible reason: network.grpc.capture_path is not an absolute path.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckNetworkConfigGrpcCaptureSize(const std::string& value) {
+    fiu_return_on("check_config_grpc_capture_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size <= 0) {
+        std::string msg =
+            "Invalid capture size: " + value + ". Possible reason: network.grpc.capture_size is not positive.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* DB config */
 Status
 Config::CheckDBConfigArchiveDiskThreshold(const std::string& value) {
@@ -1045,58 +1802,277 @@ Config::CheckStorageConfigAutoFlushInterval(const std::string& value) {
 }
 
 Status
-Config::CheckStorageConfigFileCleanupTimeout(const std::string& value) {
+Config::CheckStorageConfigRawVectorMmap(const std::string& value) {
+    fiu_return_on("check_config_raw_vector_mmap_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid raw vector mmap: " + value +
+                          ". Possible reason: storage.raw_vector_mmap is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigRawDataCompress(const std::string& value) {
+    fiu_return_on("check_config_raw_data_compress_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid raw data compress: " + value +
+                          ". Possible reason: storage.raw_data_compress is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigBlockedBloomFilter(const std::string& value) {
+    fiu_return_on("check_config_blocked_bloom_filter_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid blocked bloom filter: " + value +
+                          ". Possible reason: storage.blocked_bloom_filter is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigMergeStrategy(const std::string& value) {
+    fiu_return_on("check_config_merge_strategy_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != "simple" && value != "layered" && value != "adaptive" && value != "tiered") {
+        std::string msg = "Invalid merge strategy: " + value +
+                          ". Possible reason: storage.merge_strategy is not one of simple, layered, adaptive "
+                          "and tiered.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigMergeWriteAmplification(const std::string& value) {
+    fiu_return_on("check_config_merge_amplification_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
     if (!ValidateStringIsNumber(value).ok()) {
-        std::string msg = "Invalid file_cleanup_timeout: " + value +
-                          ". Possible reason: storage.file_cleanup_timeout is not a positive integer.";
+        std::string msg = "Invalid merge write amplification: " + value +
+                          ". Possible reason: storage.merge_amplification is not a positive integer.";
         return Status(SERVER_INVALID_ARGUMENT, msg);
     } else {
-        int64_t file_cleanup_timeout = std::stoll(value);
-        if (file_cleanup_timeout < CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN ||
-            file_cleanup_timeout > CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX) {
-            std::string msg = "Invalid file_cleanup_timeout: " + value +
-                              ". Possible reason: storage.file_cleanup_timeout is not in range [" +
-                              std::to_string(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN) + ", " +
-                              std::to_string(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN) + "].";
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 16) {
+            std::string msg = "Invalid merge write amplification: " + value +
+                              ". Possible reason: storage.merge_amplification is not in range [1, 16].";
             return Status(SERVER_INVALID_ARGUMENT, msg);
         }
     }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigMergeBytesLimit(const std::string& value) {
+    fiu_return_on("check_config_merge_bytes_limit_fail", Status(SERVER_INVALID_ARGUMENT, ""));
 
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size < 0) {
+        std::string msg = "Invalid merge bytes limit: " + value +
+                          ". Possible reason: storage.merge_bytes_limit is negative.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
     return Status::OK();
 }
 
-// Status
-// Config::CheckStorageConfigS3Enable(const std::string& value) {
-//    if (!ValidateStringIsBool(value).ok()) {
-//        std::string msg =
-//            "Invalid storage config: " + value + ". Possible reason: storage_config.s3_enable is not a boolean.";
-//        return Status(SERVER_INVALID_ARGUMENT, msg);
-//    }
-//    return Status::OK();
-// }
-//
-// Status
-// Config::CheckStorageConfigS3Address(const std::string& value) {
-//    if (!ValidateIpAddress(value).ok()) {
-//        std::string msg = "Invalid s3 address: " + value + ". Possible reason: storage_config.s3_address is invalid.";
-//        return Status(SERVER_INVALID_ARGUMENT, msg);
-//    }
-//    return Status::OK();
-// }
-//
-// Status
-// Config::CheckStorageConfigS3Port(const std::string& value) {
-//    if (!ValidateStringIsNumber(value).ok()) {
-//        std::string msg = "Invalid s3 port: " + value + ". Possible reason: storage_config.s3_port is not a number.";
-//        return Status(SERVER_INVALID_ARGUMENT, msg);
-//    } else {
-//        try {
-//            int32_t port = std::stoi(value);
-//            if (!(port > PORT_NUMBER_MIN && port < PORT_NUMBER_MAX)) {
-//                std::string msg = "Invalid s3 port: " + value +
-//                                  ". Possible reason: storage_config.s3_port is not in range (1024, 65535).";
-//                return Status(SERVER_INVALID_ARGUMENT, msg);
-//            }
+Status
+Config::CheckStorageConfigCompactThreshold(const std::string& value) {
+    fiu_return_on("check_config_compact_threshold_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid compact threshold: " + value +
+                          ". Possible reason: storage.compact_threshold is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float v = std::stof(value);
+        if (v < 0.0 || v > 1.0) {
+            std::string msg = "Invalid compact threshold: " + value +
+                              ". Possible reason: storage.compact_threshold is not in range [0.0, 1.0].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigCompactBytesLimit(const std::string& value) {
+    fiu_return_on("check_config_compact_bytes_limit_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size < 0) {
+        std::string msg = "Invalid compact bytes limit: " + value +
+                          ". Possible reason: storage.compact_bytes_limit is negative.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigReadCoalesceGap(const std::string& value) {
+    fiu_return_on("check_config_read_coalesce_gap_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size < 0) {
+        std::string msg = "Invalid read coalesce gap: " + value +
+                          ". Possible reason: storage.read_coalesce_gap is negative.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigColdPath(const std::string& value) {
+    fiu_return_on("check_config_cold_path_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+    if (value.empty()) {
+        return Status::OK();
+    }
+
+    return ValidateStoragePath(value);
+}
+
+Status
+Config::CheckStorageConfigHotCapacity(const std::string& value) {
+    fiu_return_on("check_config_hot_capacity_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size < 0) {
+        std::string msg = "Invalid hot capacity: " + value + ". Possible reason: storage.hot_capacity is negative.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigGCThreadNum(const std::string& value) {
+    fiu_return_on("check_config_gc_thread_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid gc thread num: " + value +
+                          ". Possible reason: storage.gc_thread_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 64) {
+            std::string msg = "Invalid gc thread num: " + value +
+                              ". Possible reason: storage.gc_thread_num is not in range [1, 64].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigGCUnlinkRate(const std::string& value) {
+    fiu_return_on("check_config_gc_unlink_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid gc unlink rate: " + value +
+                          ". Possible reason: storage.gc_unlink_rate is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigBackgroundIORate(const std::string& value) {
+    fiu_return_on("check_config_background_io_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size < 0) {
+        std::string msg = "Invalid background io rate: " + value +
+                          ". Possible reason: storage.background_io_rate is negative.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigIOLatencyTarget(const std::string& value) {
+    fiu_return_on("check_config_io_latency_target_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok() || std::stof(value) < 0.0) {
+        std::string msg = "Invalid io latency target: " + value +
+                          ". Possible reason: storage.io_latency_target is not a non-negative number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigFileCleanupTimeout(const std::string& value) {
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid file_cleanup_timeout: " + value +
+                          ". Possible reason: storage.file_cleanup_timeout is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t file_cleanup_timeout = std::stoll(value);
+        if (file_cleanup_timeout < CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN ||
+            file_cleanup_timeout > CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX) {
+            std::string msg = "Invalid file_cleanup_timeout: " + value +
+                              ". Possible reason: storage.file_cleanup_timeout is not in range [" +
+                              std::to_string(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN) + ", " +
+                              std::to_string(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN) + "].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+
+    return Status::OK();
+}
+
+// Status
+// Config::CheckStorageConfigS3Enable(const std::string& value) {
+//    if (!ValidateStringIsBool(value).ok()) {
+//        std::string msg =
+//            "Invalid storage config: " + value + ". Possible reason: storage_config.s3_enable is not a boolean.";
+//        return Status(SERVER_INVALID_ARGUMENT, msg);
+//    }
+//    return Status::OK();
+// }
+//
+// Status
+// Config::CheckStorageConfigS3Address(const std::string& value) {
+//    if (!ValidateIpAddress(value).ok()) {
+//        std::string msg = "Invalid s3 address: " + value + ". Possible reason: storage_config.s3_address is invalid.";
+//        return Status(SERVER_INVALID_ARGUMENT, msg);
+//    }
+//    return Status::OK();
+// }
+//
+// Status
+// Config::CheckStorageConfigS3Port(const std::string& value) {
+//    if (!ValidateStringIsNumber(value).ok()) {
+//        std::string msg = "Invalid s3 port: " + value + ". Possible reason: storage_config.s3_port is not a number.";
+//        return Status(SERVER_INVALID_ARGUMENT, msg);
+//    } else {
+//        try {
+//            int32_t port = std::stoi(value);
+//            if (!(port > PORT_NUMBER_MIN && port < PORT_NUMBER_MAX)) {
+//                std::string msg = "Invalid s3 port: " + value +
+//                                  ". Possible reason: storage_config.s3_port is not in range (1024, 65535).";
+//                return Status(SERVER_INVALID_ARGUMENT, msg);
+//            }
 //        } catch (...) {
 //            return Status(SERVER_INVALID_ARGUMENT, "Invalid storage_config.s3_port: " + value);
 //        }
@@ -1170,6 +2146,57 @@ Config::CheckMetricConfigPort(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckMetricConfigProfilingInterval(const std::string& value) {
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid metric profiling interval: " + value +
+                          ". Possible reason: metric.profiling_interval is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v > 86400) {
+            std::string msg = "Invalid metric profiling interval: " + value +
+                              ". Possible reason: metric.profiling_interval is not in range [0, 86400].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckMetricConfigProfilingDuration(const std::string& value) {
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid metric profiling duration: " + value +
+                          ". Possible reason: metric.profiling_duration is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 600) {
+            std::string msg = "Invalid metric profiling duration: " + value +
+                              ". Possible reason: metric.profiling_duration is not in range [1, 600].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckMetricConfigRecallSampleRate(const std::string& value) {
+    if (!ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid metric recall sample rate: " + value +
+                          ". Possible reason: metric.recall_sample_rate is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float v = std::stof(value);
+        if (v < 0.0 || v > 1.0) {
+            std::string msg = "Invalid metric recall sample rate: " + value +
+                              ". Possible reason: metric.recall_sample_rate is not in range [0.0, 1.0].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 /* cache config */
 Status
 Config::CheckCacheConfigCpuCacheCapacity(const std::string& value) {
@@ -1212,6 +2239,25 @@ Config::CheckCacheConfigCpuCacheCapacity(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigInsertBufferTarget(const std::string& value) {
+    fiu_return_on("check_config_insert_buffer_target_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid insert buffer target: " + value +
+                          ". Possible reason: cache.insert_buffer_target is not in range (0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float v = std::stof(value);
+        if (v <= 0.0 || v > 1.0) {
+            std::string msg = "Invalid insert buffer target: " + value +
+                              ". Possible reason: cache.insert_buffer_target is not in range (0.0, 1.0].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 Status
 Config::CheckCacheConfigCpuCacheThreshold(const std::string& value) {
     fiu_return_on("check_config_cpu_cache_threshold_fail", Status(SERVER_INVALID_ARGUMENT, ""));
@@ -1231,6 +2277,75 @@ Config::CheckCacheConfigCpuCacheThreshold(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigCpuCacheShardNum(const std::string& value) {
+    fiu_return_on("check_config_cpu_cache_shard_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid cpu cache shard num: " + value +
+                          ". Possible reason: cache.cpu_cache_shard_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 1024) {
+            std::string msg = "Invalid cpu cache shard num: " + value +
+                              ". Possible reason: cache.cpu_cache_shard_num is not in range [1, 1024].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigCpuCachePolicy(const std::string& value) {
+    fiu_return_on("check_config_cpu_cache_policy_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != "lru" && value != "tinylfu" && value != "cost") {
+        std::string msg = "Invalid cpu cache policy: " + value +
+                          ". Possible reason: cache.cpu_cache_policy is not one of lru, tinylfu and cost.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigReclaimQueueSize(const std::string& value) {
+    fiu_return_on("check_config_reclaim_queue_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid cpu cache reclaim queue size: " + value +
+                          ". Possible reason: cache.reclaim_queue_size is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 0 || v > 4096) {
+            std::string msg = "Invalid cpu cache reclaim queue size: " + value +
+                              ". Possible reason: cache.reclaim_queue_size is not in range [0, 4096].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigResultCacheCapacity(const std::string& value) {
+    fiu_return_on("check_config_result_cache_capacity_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid result cache capacity: " + value +
+                          ". Possible reason: cache.result_cache_capacity is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v > 1048576) {
+            std::string msg = "Invalid result cache capacity: " + value +
+                              ". Possible reason: cache.result_cache_capacity is not in range [0, 1048576].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 Status
 Config::CheckCacheConfigInsertBufferSize(const std::string& value) {
     fiu_return_on("check_config_insert_buffer_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
@@ -1307,6 +2422,96 @@ Config::CheckCacheConfigPreloadCollection(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigMemoryLimit(const std::string& value) {
+    fiu_return_on("check_config_memory_limit_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t memory_limit = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else {
+        if (memory_limit < 0) {
+            std::string msg = "Invalid memory limit: " + value +
+                              ". Possible reason: cache.memory_limit is not a non-negative integer.";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+
+        int64_t total_mem = 0, free_mem = 0;
+        GetSystemMemInfo(total_mem, free_mem);
+        if (memory_limit >= total_mem) {
+            std::stringstream ss;
+            ss << "Invalid memory limit: " << value << ". ";
+            ss << "Possible reason: cache.memory_limit exceeds system memory (" << (total_mem >> 30) << "GB).";
+            return Status(SERVER_INVALID_ARGUMENT, ss.str());
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigPreloadThreadNum(const std::string& value) {
+    fiu_return_on("check_config_preload_thread_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid preload thread num: " + value +
+                          ". Possible reason: cache.preload_thread_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 64) {
+            std::string msg = "Invalid preload thread num: " + value +
+                              ". Possible reason: cache.preload_thread_num is not in range [1, 64].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigPreloadBandwidth(const std::string& value) {
+    fiu_return_on("check_config_preload_bandwidth_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t bandwidth = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (bandwidth < 0) {
+        std::string msg = "Invalid preload bandwidth: " + value +
+                          ". Possible reason: cache.preload_bandwidth is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigWarmUpSize(const std::string& value) {
+    fiu_return_on("check_config_warm_up_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t warm_up_size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (warm_up_size < 0) {
+        std::string msg = "Invalid warm up size: " + value +
+                          ". Possible reason: cache.warm_up_size is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigWriteThroughIndex(const std::string& value) {
+    fiu_return_on("check_config_write_through_index_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid write through index option: " + value +
+                          ". Possible reason: cache.write_through_index is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::CheckEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1364,6 +2569,232 @@ Config::CheckEngineSearchCombineMaxNq(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckEngineSearchCombineWaitUs(const std::string& value) {
+    fiu_return_on("check_config_search_combine_wait_us_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search combine wait: " + value +
+                          ". Possible reason: engine_config.search_combine_wait_us is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 0 || v > 100000) {
+            std::string msg = "Invalid search combine wait: " + value +
+                              ". Possible reason: engine_config.search_combine_wait_us is not in range [0, 100000].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigParallelReduce(const std::string& value) {
+    fiu_return_on("check_config_parallel_reduce_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid parallel reduce: " + value +
+                          ". Possible reason: engine_config.parallel_reduce is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigExecutorThreads(const std::string& value) {
+    fiu_return_on("check_config_executor_threads_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid executor threads: " + value +
+                          ". Possible reason: engine_config.executor_threads is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t executor_threads = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    GetSystemAvailableThreads(sys_thread_cnt);
+    if (executor_threads > sys_thread_cnt) {
+        std::string msg = "Invalid executor threads: " + value +
+                          ". Possible reason: engine_config.executor_threads exceeds system cpu cores.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigPrefetchDepth(const std::string& value) {
+    fiu_return_on("check_config_engine_prefetch_depth_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid engine prefetch depth: " + value +
+                          ". Possible reason: engine_config.prefetch_depth is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 64) {
+            std::string msg = "Invalid engine prefetch depth: " + value +
+                              ". Possible reason: engine_config.prefetch_depth is not in range [1, 64].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchWorkers(const std::string& value) {
+    fiu_return_on("check_config_engine_search_workers_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok() || std::stoll(value) < 1) {
+        std::string msg = "Invalid engine search workers: " + value +
+                          ". Possible reason: engine_config.search_workers is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigInsertWorkers(const std::string& value) {
+    fiu_return_on("check_config_engine_insert_workers_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok() || std::stoll(value) < 1) {
+        std::string msg = "Invalid engine insert workers: " + value +
+                          ". Possible reason: engine_config.insert_workers is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigDdlWorkers(const std::string& value) {
+    fiu_return_on("check_config_engine_ddl_workers_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok() || std::stoll(value) < 1) {
+        std::string msg = "Invalid engine ddl workers: " + value +
+                          ". Possible reason: engine_config.ddl_workers is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigMaintenanceWorkers(const std::string& value) {
+    fiu_return_on("check_config_engine_maintenance_workers_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok() || std::stoll(value) < 1) {
+        std::string msg = "Invalid engine maintenance workers: " + value +
+                          ". Possible reason: engine_config.maintenance_workers is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigRequestQueueDepth(const std::string& value) {
+    fiu_return_on("check_config_engine_request_queue_depth_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid engine request queue depth: " + value +
+                          ". Possible reason: engine_config.request_queue_depth is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigBuildCpuShare(const std::string& value) {
+    fiu_return_on("check_config_engine_build_cpu_share_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid engine build cpu share: " + value +
+                          ". Possible reason: engine_config.build_cpu_share is not in range (0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float v = std::stof(value);
+        if (v <= 0.0 || v > 1.0) {
+            std::string msg = "Invalid engine build cpu share: " + value +
+                              ". Possible reason: engine_config.build_cpu_share is not in range (0.0, 1.0].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchLatencySloMs(const std::string& value) {
+    fiu_return_on("check_config_engine_search_latency_slo_ms_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid engine search latency slo: " + value +
+                          ". Possible reason: engine_config.search_latency_slo_ms is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchInsertBuffer(const std::string& value) {
+    fiu_return_on("check_config_engine_search_insert_buffer_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid engine search insert buffer: " + value +
+                          ". Possible reason: engine_config.search_insert_buffer is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigNumaAware(const std::string& value) {
+    fiu_return_on("check_config_engine_numa_aware_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid engine numa aware: " + value +
+                          ". Possible reason: engine_config.numa_aware is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigHugePage(const std::string& value) {
+    fiu_return_on("check_config_engine_huge_page_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid engine huge page: " + value +
+                          ". Possible reason: engine_config.huge_page is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigRawVectorCompression(const std::string& value) {
+    fiu_return_on("check_config_engine_raw_vector_compression_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != "none" && value != "sq8" && value != "fp16") {
+        std::string msg = "Invalid engine raw vector compression: " + value +
+                          ". Possible reason: engine_config.raw_vector_compression is not one of none, sq8 and fp16.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchMemoryLimit(const std::string& value) {
+    fiu_return_on("check_config_engine_search_memory_limit_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    } else if (size < 0) {
+        std::string msg = "Invalid engine search memory limit: " + value +
+                          ". Possible reason: engine_config.search_memory_limit is negative.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -1411,20 +2842,99 @@ Config::CheckGpuResourceConfigCacheCapacity(const std::string& value) {
 }
 
 Status
-Config::CheckGpuResourceConfigCacheThreshold(const std::string& value) {
-    fiu_return_on("check_config_gpu_resource_cache_threshold_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+Config::CheckGpuResourceConfigCacheThreshold(const std::string& value) {
+    fiu_return_on("check_config_gpu_resource_cache_threshold_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid gpu cache threshold: " + value +
+                          ". Possible reason: gpu.cache_threshold is not in range (0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float gpu_cache_threshold = std::stof(value);
+        if (gpu_cache_threshold <= 0.0 || gpu_cache_threshold >= 1.0) {
+            std::string msg = "Invalid gpu cache threshold: " + value +
+                              ". Possible reason: gpu.cache_threshold is not in range (0.0, 1.0].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckGpuResourceConfigCachePolicy(const std::string& value) {
+    fiu_return_on("check_config_cache_policy_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != "lru" && value != "tinylfu" && value != "cost") {
+        std::string msg = "Invalid gpu cache policy: " + value +
+                          ". Possible reason: gpu.cache_policy is not one of lru, tinylfu and cost.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckGpuResourceConfigPrefetchDepth(const std::string& value) {
+    fiu_return_on("check_config_prefetch_depth_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid gpu prefetch depth: " + value +
+                          ". Possible reason: gpu.prefetch_depth is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 0 || v > 64) {
+            std::string msg = "Invalid gpu prefetch depth: " + value +
+                              ". Possible reason: gpu.prefetch_depth is not in range [0, 64].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckGpuResourceConfigCostPlacement(const std::string& value) {
+    fiu_return_on("check_config_cost_placement_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg =
+            "Invalid gpu cost placement: " + value + ". Possible reason: gpu.cost_placement is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckGpuResourceConfigBuildIndexSharded(const std::string& value) {
+    fiu_return_on("check_config_build_index_sharded_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid gpu build index sharded: " + value +
+                          ". Possible reason: gpu.build_index_sharded is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckGpuResourceConfigSearchSharded(const std::string& value) {
+    fiu_return_on("check_config_search_sharded_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg =
+            "Invalid gpu search sharded: " + value + ". Possible reason: gpu.search_sharded is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckGpuResourceConfigKeepFreshSegments(const std::string& value) {
+    fiu_return_on("check_config_keep_fresh_segments_fail", Status(SERVER_INVALID_ARGUMENT, ""));
 
-    if (!ValidateStringIsFloat(value).ok()) {
-        std::string msg = "Invalid gpu cache threshold: " + value +
-                          ". Possible reason: gpu.cache_threshold is not in range (0.0, 1.0].";
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid gpu keep fresh segments: " + value +
+                          ". Possible reason: gpu.keep_fresh_segments is not a boolean.";
         return Status(SERVER_INVALID_ARGUMENT, msg);
-    } else {
-        float gpu_cache_threshold = std::stof(value);
-        if (gpu_cache_threshold <= 0.0 || gpu_cache_threshold >= 1.0) {
-            std::string msg = "Invalid gpu cache threshold: " + value +
-                              ". Possible reason: gpu.cache_threshold is not in range (0.0, 1.0].";
-            return Status(SERVER_INVALID_ARGUMENT, msg);
-        }
     }
     return Status::OK();
 }
@@ -1533,6 +3043,66 @@ Config::CheckTracingConfigJsonConfigPath(const std::string& value) {
     return Status(SERVER_INVALID_ARGUMENT, msg);
 }
 
+Status
+Config::CheckTracingConfigSearchSampleRate(const std::string& value) {
+    fiu_return_on("check_config_tracing_search_sample_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok() || std::stof(value) < 0.0 || std::stof(value) > 1.0) {
+        std::string msg = "Invalid tracing search sample rate: " + value +
+                          ". Possible reason: tracing_config.search_sample_rate is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckTracingConfigInsertSampleRate(const std::string& value) {
+    fiu_return_on("check_config_tracing_insert_sample_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok() || std::stof(value) < 0.0 || std::stof(value) > 1.0) {
+        std::string msg = "Invalid tracing insert sample rate: " + value +
+                          ". Possible reason: tracing_config.insert_sample_rate is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckTracingConfigDdlSampleRate(const std::string& value) {
+    fiu_return_on("check_config_tracing_ddl_sample_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok() || std::stof(value) < 0.0 || std::stof(value) > 1.0) {
+        std::string msg = "Invalid tracing ddl sample rate: " + value +
+                          ". Possible reason: tracing_config.ddl_sample_rate is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckTracingConfigMaintenanceSampleRate(const std::string& value) {
+    fiu_return_on("check_config_tracing_maintenance_sample_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok() || std::stof(value) < 0.0 || std::stof(value) > 1.0) {
+        std::string msg = "Invalid tracing maintenance sample rate: " + value +
+                          ". Possible reason: tracing_config.maintenance_sample_rate is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckTracingConfigInfoSampleRate(const std::string& value) {
+    fiu_return_on("check_config_tracing_info_sample_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsFloat(value).ok() || std::stof(value) < 0.0 || std::stof(value) > 1.0) {
+        std::string msg = "Invalid tracing info sample rate: " + value +
+                          ". Possible reason: tracing_config.info_sample_rate is not in range [0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* wal config */
 Status
 Config::CheckWalConfigEnable(const std::string& value) {
@@ -1584,6 +3154,67 @@ Config::CheckWalConfigWalPath(const std::string& value) {
     return ValidateStoragePath(value);
 }
 
+Status
+Config::CheckWalConfigSyncMode(const std::string& value) {
+    fiu_return_on("check_wal_sync_mode_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != "none" && value != "interval" && value != "batch") {
+        std::string msg = "Invalid wal sync mode: " + value +
+                          ". Possible reason: wal.sync_mode is not one of none, interval and batch.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckWalConfigSyncInterval(const std::string& value) {
+    fiu_return_on("check_wal_sync_interval_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid wal sync interval: " + value +
+                          ". Possible reason: wal.sync_interval is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 10000) {
+            std::string msg = "Invalid wal sync interval: " + value +
+                              ". Possible reason: wal.sync_interval is not in range [1, 10000].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckWalConfigRecoveryThreadNum(const std::string& value) {
+    fiu_return_on("check_wal_recovery_thread_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid wal recovery thread num: " + value +
+                          ". Possible reason: wal.recovery_thread_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t v = std::stoll(value);
+        if (v < 1 || v > 64) {
+            std::string msg = "Invalid wal recovery thread num: " + value +
+                              ". Possible reason: wal.recovery_thread_num is not in range [1, 64].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckWalConfigCompress(const std::string& value) {
+    fiu_return_on("check_wal_compress_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid wal compress: " + value + ". Possible reason: wal.compress is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* logs config */
 Status
 Config::CheckLogsLevel(const std::string& value) {
@@ -1662,6 +3293,62 @@ Config::CheckLogsLogRotateNum(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckLogsAsyncEnable(const std::string& value) {
+    auto exist_error = !ValidateStringIsBool(value).ok();
+    fiu_do_on("check_logs_async_enable_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid logs config: " + value + ". Possible reason: logs.async.enable is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckLogsAsyncBufferSize(const std::string& value) {
+    auto exist_error = !ValidateStringIsNumber(value).ok();
+    fiu_do_on("check_logs_async_buffer_size_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid async buffer_size: " + value +
+                          ". Possible reason: logs.async.buffer_size is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t buffer_size = std::stoll(value);
+        if (buffer_size < CONFIG_LOGS_ASYNC_BUFFER_SIZE_MIN || buffer_size > CONFIG_LOGS_ASYNC_BUFFER_SIZE_MAX) {
+            std::string msg = "Invalid async buffer_size: " + value +
+                              ". Possible reason: logs.async.buffer_size is not in range [" +
+                              std::to_string(CONFIG_LOGS_ASYNC_BUFFER_SIZE_MIN) + ", " +
+                              std::to_string(CONFIG_LOGS_ASYNC_BUFFER_SIZE_MAX) + "].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckLogsAsyncRateLimit(const std::string& value) {
+    auto exist_error = !ValidateStringIsNumber(value).ok();
+    fiu_do_on("check_logs_async_rate_limit_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid async rate_limit: " + value +
+                          ". Possible reason: logs.async.rate_limit is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t rate_limit = std::stoll(value);
+        if (rate_limit < CONFIG_LOGS_ASYNC_RATE_LIMIT_MIN || rate_limit > CONFIG_LOGS_ASYNC_RATE_LIMIT_MAX) {
+            std::string msg = "Invalid async rate_limit: " + value +
+                              ". Possible reason: logs.async.rate_limit is not in range [" +
+                              std::to_string(CONFIG_LOGS_ASYNC_RATE_LIMIT_MIN) + ", " +
+                              std::to_string(CONFIG_LOGS_ASYNC_RATE_LIMIT_MAX) + "].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ConfigNode&
 Config::GetConfigRoot() {
@@ -1773,6 +3460,30 @@ Config::GetClusterConfigRole(std::string& value) {
     return CheckClusterConfigRole(value);
 }
 
+Status
+Config::GetClusterConfigReplicaRefreshInterval(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_CLUSTER, CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL,
+                                   CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL_DEFAULT);
+    STATUS_CHECK(CheckClusterConfigReplicaRefreshInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetClusterConfigShards(std::vector<std::vector<std::string>>& value) {
+    std::string str = GetConfigStr(CONFIG_CLUSTER, CONFIG_CLUSTER_SHARDS, CONFIG_CLUSTER_SHARDS_DEFAULT);
+    STATUS_CHECK(CheckClusterConfigShards(str));
+    return ParseClusterShards(str, value);
+}
+
+Status
+Config::GetClusterConfigHedgeDelay(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_CLUSTER, CONFIG_CLUSTER_HEDGE_DELAY, CONFIG_CLUSTER_HEDGE_DELAY_DEFAULT);
+    STATUS_CHECK(CheckClusterConfigHedgeDelay(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* general config */
 Status
 Config::GetGeneralConfigTimezone(std::string& value) {
@@ -1786,6 +3497,15 @@ Config::GetGeneralConfigMetaURI(std::string& value) {
     return CheckGeneralConfigMetaURI(value);
 }
 
+Status
+Config::GetGeneralConfigMetaCacheTTL(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_GENERAL, CONFIG_GENERAL_META_CACHE_TTL,
+                                   CONFIG_GENERAL_META_CACHE_TTL_DEFAULT);
+    STATUS_CHECK(CheckGeneralConfigMetaCacheTTL(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* network config */
 Status
 Config::GetNetworkConfigBindAddress(std::string& value) {
@@ -1794,56 +3514,236 @@ Config::GetNetworkConfigBindAddress(std::string& value) {
 }
 
 Status
-Config::GetNetworkConfigBindPort(std::string& value) {
-    value = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_BIND_PORT, CONFIG_NETWORK_BIND_PORT_DEFAULT);
-    return CheckNetworkConfigBindPort(value);
+Config::GetNetworkConfigBindPort(std::string& value) {
+    value = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_BIND_PORT, CONFIG_NETWORK_BIND_PORT_DEFAULT);
+    return CheckNetworkConfigBindPort(value);
+}
+
+Status
+Config::GetNetworkConfigHTTPEnable(bool& value) {
+    std::string str = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_ENABLE, CONFIG_NETWORK_HTTP_ENABLE_DEFAULT);
+    STATUS_CHECK(CheckNetworkConfigHTTPEnable(str));
+    return StringHelpFunctions::ConvertToBoolean(str, value);
+}
+
+Status
+Config::GetNetworkConfigHTTPPort(std::string& value) {
+    value = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_PORT, CONFIG_NETWORK_HTTP_PORT_DEFAULT);
+    return CheckNetworkConfigHTTPPort(value);
+}
+
+Status
+Config::GetNetworkConfigHTTPAsync(bool& value) {
+    std::string str = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_ASYNC, CONFIG_NETWORK_HTTP_ASYNC_DEFAULT);
+    STATUS_CHECK(CheckNetworkConfigHTTPAsync(str));
+    return StringHelpFunctions::ConvertToBoolean(str, value);
+}
+
+Status
+Config::GetNetworkConfigHTTPIOThreads(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_IO_THREADS, CONFIG_NETWORK_HTTP_IO_THREADS_DEFAULT);
+    STATUS_CHECK(CheckNetworkConfigHTTPIOThreads(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetNetworkConfigHTTPWorkerThreads(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_WORKER_THREADS, CONFIG_NETWORK_HTTP_WORKER_THREADS_DEFAULT);
+    STATUS_CHECK(CheckNetworkConfigHTTPWorkerThreads(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetNetworkConfigGrpcAsync(bool& value) {
+    std::string str = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_GRPC_ASYNC, CONFIG_NETWORK_GRPC_ASYNC_DEFAULT);
+    STATUS_CHECK(CheckNetworkConfigGrpcAsync(str));
+    return StringHelpFunctions::ConvertToBoolean(str, value);
+}
+
+Status
+Config::GetNetworkConfigGrpcCapturePath(std::string& value) {
+    value = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_GRPC_CAPTURE_PATH, CONFIG_NETWORK_GRPC_CAPTURE_PATH_DEFAULT);
+    return CheckNetworkConfigGrpcCapturePath(value);
+}
+
+Status
+Config::GetNetworkConfigGrpcCaptureSize(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_GRPC_CAPTURE_SIZE, CONFIG_NETWORK_GRPC_CAPTURE_SIZE_DEFAULT);
+    STATUS_CHECK(CheckNetworkConfigGrpcCaptureSize(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+/* DB config */
+Status
+Config::GetDBConfigArchiveDiskThreshold(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_DB, CONFIG_DB_ARCHIVE_DISK_THRESHOLD, CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT);
+    STATUS_CHECK(CheckDBConfigArchiveDiskThreshold(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetDBConfigArchiveDaysThreshold(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_DB, CONFIG_DB_ARCHIVE_DAYS_THRESHOLD, CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT);
+    STATUS_CHECK(CheckDBConfigArchiveDaysThreshold(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+/* storage config */
+Status
+Config::GetStorageConfigPath(std::string& value) {
+    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_PATH, CONFIG_STORAGE_PATH_DEFAULT);
+    return CheckStorageConfigPath(value);
+}
+
+Status
+Config::GetStorageConfigAutoFlushInterval(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_FLUSH_INTERVAL, CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigAutoFlushInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigRawVectorMmap(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_RAW_VECTOR_MMAP, CONFIG_STORAGE_RAW_VECTOR_MMAP_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigRawVectorMmap(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigRawDataCompress(bool& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_RAW_DATA_COMPRESS,
+                                   CONFIG_STORAGE_RAW_DATA_COMPRESS_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigRawDataCompress(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigBlockedBloomFilter(bool& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_BLOCKED_BLOOM_FILTER,
+                                   CONFIG_STORAGE_BLOCKED_BLOOM_FILTER_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigBlockedBloomFilter(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigMergeStrategy(std::string& value) {
+    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_STRATEGY, CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT);
+    return CheckStorageConfigMergeStrategy(value);
+}
+
+Status
+Config::GetStorageConfigMergeWriteAmplification(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION,
+                                   CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigMergeWriteAmplification(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigMergeBytesLimit(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_BYTES_LIMIT,
+                                   CONFIG_STORAGE_MERGE_BYTES_LIMIT_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigMergeBytesLimit(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigCompactThreshold(float& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_COMPACT_THRESHOLD,
+                                   CONFIG_STORAGE_COMPACT_THRESHOLD_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigCompactThreshold(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigCompactBytesLimit(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_COMPACT_BYTES_LIMIT,
+                                   CONFIG_STORAGE_COMPACT_BYTES_LIMIT_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigCompactBytesLimit(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigReadCoalesceGap(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_READ_COALESCE_GAP,
+                                   CONFIG_STORAGE_READ_COALESCE_GAP_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigReadCoalesceGap(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
 }
 
 Status
-Config::GetNetworkConfigHTTPEnable(bool& value) {
-    std::string str = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_ENABLE, CONFIG_NETWORK_HTTP_ENABLE_DEFAULT);
-    STATUS_CHECK(CheckNetworkConfigHTTPEnable(str));
-    return StringHelpFunctions::ConvertToBoolean(str, value);
+Config::GetStorageConfigColdPath(std::string& value) {
+    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_COLD_PATH, CONFIG_STORAGE_COLD_PATH_DEFAULT);
+    return CheckStorageConfigColdPath(value);
 }
 
 Status
-Config::GetNetworkConfigHTTPPort(std::string& value) {
-    value = GetConfigStr(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_PORT, CONFIG_NETWORK_HTTP_PORT_DEFAULT);
-    return CheckNetworkConfigHTTPPort(value);
+Config::GetStorageConfigHotCapacity(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_HOT_CAPACITY, CONFIG_STORAGE_HOT_CAPACITY_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigHotCapacity(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
 }
 
-/* DB config */
 Status
-Config::GetDBConfigArchiveDiskThreshold(int64_t& value) {
-    std::string str =
-        GetConfigStr(CONFIG_DB, CONFIG_DB_ARCHIVE_DISK_THRESHOLD, CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT);
-    STATUS_CHECK(CheckDBConfigArchiveDiskThreshold(str));
+Config::GetStorageConfigGCThreadNum(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_GC_THREAD_NUM, CONFIG_STORAGE_GC_THREAD_NUM_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigGCThreadNum(str));
     value = std::stoll(str);
     return Status::OK();
 }
 
 Status
-Config::GetDBConfigArchiveDaysThreshold(int64_t& value) {
+Config::GetStorageConfigGCUnlinkRate(int64_t& value) {
     std::string str =
-        GetConfigStr(CONFIG_DB, CONFIG_DB_ARCHIVE_DAYS_THRESHOLD, CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT);
-    STATUS_CHECK(CheckDBConfigArchiveDaysThreshold(str));
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_GC_UNLINK_RATE, CONFIG_STORAGE_GC_UNLINK_RATE_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigGCUnlinkRate(str));
     value = std::stoll(str);
     return Status::OK();
 }
 
-/* storage config */
 Status
-Config::GetStorageConfigPath(std::string& value) {
-    value = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_PATH, CONFIG_STORAGE_PATH_DEFAULT);
-    return CheckStorageConfigPath(value);
+Config::GetStorageConfigBackgroundIORate(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_BACKGROUND_IO_RATE,
+                                   CONFIG_STORAGE_BACKGROUND_IO_RATE_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigBackgroundIORate(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
 }
 
 Status
-Config::GetStorageConfigAutoFlushInterval(int64_t& value) {
+Config::GetStorageConfigIOLatencyTarget(float& value) {
     std::string str =
-        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_FLUSH_INTERVAL, CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT);
-    STATUS_CHECK(CheckStorageConfigAutoFlushInterval(str));
-    value = std::stoll(str);
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_IO_LATENCY_TARGET, CONFIG_STORAGE_IO_LATENCY_TARGET_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigIOLatencyTarget(str));
+    value = std::stof(str);
     return Status::OK();
 }
 
@@ -1915,6 +3815,33 @@ Config::GetMetricConfigPort(std::string& value) {
     return CheckMetricConfigPort(value);
 }
 
+Status
+Config::GetMetricConfigProfilingInterval(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_METRIC, CONFIG_METRIC_PROFILING_INTERVAL, CONFIG_METRIC_PROFILING_INTERVAL_DEFAULT);
+    STATUS_CHECK(CheckMetricConfigProfilingInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetMetricConfigProfilingDuration(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_METRIC, CONFIG_METRIC_PROFILING_DURATION, CONFIG_METRIC_PROFILING_DURATION_DEFAULT);
+    STATUS_CHECK(CheckMetricConfigProfilingDuration(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetMetricConfigRecallSampleRate(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_METRIC, CONFIG_METRIC_RECALL_SAMPLE_RATE, CONFIG_METRIC_RECALL_SAMPLE_RATE_DEFAULT);
+    STATUS_CHECK(CheckMetricConfigRecallSampleRate(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
 /* cache config */
 Status
 Config::GetCacheConfigCpuCacheCapacity(int64_t& value) {
@@ -1927,6 +3854,15 @@ Config::GetCacheConfigCpuCacheCapacity(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigInsertBufferTarget(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_INSERT_BUFFER_TARGET, CONFIG_CACHE_INSERT_BUFFER_TARGET_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigInsertBufferTarget(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
 Status
 Config::GetCacheConfigCpuCacheThreshold(float& value) {
     std::string str =
@@ -1936,6 +3872,39 @@ Config::GetCacheConfigCpuCacheThreshold(float& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigCpuCacheShardNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_SHARD_NUM, CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigCpuCacheShardNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigCpuCachePolicy(std::string& value) {
+    value = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_POLICY, CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT);
+    return CheckCacheConfigCpuCachePolicy(value);
+}
+
+Status
+Config::GetCacheConfigReclaimQueueSize(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_RECLAIM_QUEUE_SIZE, CONFIG_CACHE_RECLAIM_QUEUE_SIZE_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigReclaimQueueSize(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigResultCacheCapacity(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_RESULT_CACHE_CAPACITY, CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigResultCacheCapacity(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 Status
 Config::GetCacheConfigInsertBufferSize(int64_t& value) {
     std::string str =
@@ -1963,6 +3932,53 @@ Config::GetCacheConfigPreloadCollection(std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigMemoryLimit(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_MEMORY_LIMIT, CONFIG_CACHE_MEMORY_LIMIT_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigMemoryLimit(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigPreloadThreadNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_THREAD_NUM, CONFIG_CACHE_PRELOAD_THREAD_NUM_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigPreloadThreadNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigPreloadBandwidth(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_BANDWIDTH, CONFIG_CACHE_PRELOAD_BANDWIDTH_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigPreloadBandwidth(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigWarmUpSize(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_WARM_UP_SIZE, CONFIG_CACHE_WARM_UP_SIZE_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigWarmUpSize(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigWriteThroughIndex(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_WRITE_THROUGH_INDEX, CONFIG_CACHE_WRITE_THROUGH_INDEX_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigWriteThroughIndex(str));
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    value = (str == "true" || str == "on" || str == "yes" || str == "1");
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::GetEngineConfigUseBlasThreshold(int64_t& value) {
@@ -1996,6 +4012,142 @@ Config::GetEngineSearchCombineMaxNq(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetEngineSearchCombineWaitUs(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US, CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US_DEFAULT);
+    STATUS_CHECK(CheckEngineSearchCombineWaitUs(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigParallelReduce(bool& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_PARALLEL_REDUCE, CONFIG_ENGINE_PARALLEL_REDUCE_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigParallelReduce(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigExecutorThreads(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_EXECUTOR_THREADS, CONFIG_ENGINE_EXECUTOR_THREADS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigExecutorThreads(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigPrefetchDepth(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_PREFETCH_DEPTH, CONFIG_ENGINE_PREFETCH_DEPTH_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigPrefetchDepth(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchWorkers(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_WORKERS, CONFIG_ENGINE_SEARCH_WORKERS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchWorkers(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigInsertWorkers(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_INSERT_WORKERS, CONFIG_ENGINE_INSERT_WORKERS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigInsertWorkers(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigDdlWorkers(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_DDL_WORKERS, CONFIG_ENGINE_DDL_WORKERS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigDdlWorkers(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigMaintenanceWorkers(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_MAINTENANCE_WORKERS, CONFIG_ENGINE_MAINTENANCE_WORKERS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigMaintenanceWorkers(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigRequestQueueDepth(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_REQUEST_QUEUE_DEPTH, CONFIG_ENGINE_REQUEST_QUEUE_DEPTH_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigRequestQueueDepth(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigBuildCpuShare(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_CPU_SHARE, CONFIG_ENGINE_BUILD_CPU_SHARE_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigBuildCpuShare(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchLatencySloMs(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS, CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchLatencySloMs(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchInsertBuffer(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_INSERT_BUFFER, CONFIG_ENGINE_SEARCH_INSERT_BUFFER_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchInsertBuffer(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigNumaAware(bool& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_NUMA_AWARE, CONFIG_ENGINE_NUMA_AWARE_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigNumaAware(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigHugePage(bool& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_HUGE_PAGE, CONFIG_ENGINE_HUGE_PAGE_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigHugePage(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigRawVectorCompression(std::string& value) {
+    value = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_RAW_VECTOR_COMPRESSION,
+                         CONFIG_ENGINE_RAW_VECTOR_COMPRESSION_DEFAULT);
+    return CheckEngineConfigRawVectorCompression(value);
+}
+
+Status
+Config::GetEngineConfigSearchMemoryLimit(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_MEMORY_LIMIT, CONFIG_ENGINE_SEARCH_MEMORY_LIMIT_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchMemoryLimit(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -2040,6 +4192,58 @@ Config::GetGpuResourceConfigCacheThreshold(float& value) {
     return Status::OK();
 }
 
+Status
+Config::GetGpuResourceConfigCachePolicy(std::string& value) {
+    value =
+        GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_CACHE_POLICY, CONFIG_GPU_RESOURCE_CACHE_POLICY_DEFAULT);
+    return CheckGpuResourceConfigCachePolicy(value);
+}
+
+Status
+Config::GetGpuResourceConfigPrefetchDepth(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_PREFETCH_DEPTH,
+                                   CONFIG_GPU_RESOURCE_PREFETCH_DEPTH_DEFAULT);
+    STATUS_CHECK(CheckGpuResourceConfigPrefetchDepth(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetGpuResourceConfigCostPlacement(bool& value) {
+    std::string str = GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_COST_PLACEMENT,
+                                   CONFIG_GPU_RESOURCE_COST_PLACEMENT_DEFAULT);
+    STATUS_CHECK(CheckGpuResourceConfigCostPlacement(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetGpuResourceConfigBuildIndexSharded(bool& value) {
+    std::string str = GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED,
+                                   CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED_DEFAULT);
+    STATUS_CHECK(CheckGpuResourceConfigBuildIndexSharded(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetGpuResourceConfigSearchSharded(bool& value) {
+    std::string str = GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_SEARCH_SHARDED,
+                                   CONFIG_GPU_RESOURCE_SEARCH_SHARDED_DEFAULT);
+    STATUS_CHECK(CheckGpuResourceConfigSearchSharded(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetGpuResourceConfigKeepFreshSegments(bool& value) {
+    std::string str = GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS,
+                                   CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS_DEFAULT);
+    STATUS_CHECK(CheckGpuResourceConfigKeepFreshSegments(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
 Status
 Config::GetGpuResourceConfigGpuSearchThreshold(int64_t& value) {
     std::string str = GetConfigStr(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD,
@@ -2109,6 +4313,51 @@ Config::GetTracingConfigJsonConfigPath(std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::GetTracingConfigSearchSampleRate(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_TRACING, CONFIG_TRACING_SEARCH_SAMPLE_RATE, CONFIG_TRACING_SEARCH_SAMPLE_RATE_DEFAULT);
+    STATUS_CHECK(CheckTracingConfigSearchSampleRate(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetTracingConfigInsertSampleRate(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_TRACING, CONFIG_TRACING_INSERT_SAMPLE_RATE, CONFIG_TRACING_INSERT_SAMPLE_RATE_DEFAULT);
+    STATUS_CHECK(CheckTracingConfigInsertSampleRate(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetTracingConfigDdlSampleRate(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_TRACING, CONFIG_TRACING_DDL_SAMPLE_RATE, CONFIG_TRACING_DDL_SAMPLE_RATE_DEFAULT);
+    STATUS_CHECK(CheckTracingConfigDdlSampleRate(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetTracingConfigMaintenanceSampleRate(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_TRACING, CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE, CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE_DEFAULT);
+    STATUS_CHECK(CheckTracingConfigMaintenanceSampleRate(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetTracingConfigInfoSampleRate(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_TRACING, CONFIG_TRACING_INFO_SAMPLE_RATE, CONFIG_TRACING_INFO_SAMPLE_RATE_DEFAULT);
+    STATUS_CHECK(CheckTracingConfigInfoSampleRate(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
 /* wal config */
 Status
 Config::GetWalConfigEnable(bool& wal_enable) {
@@ -2149,6 +4398,36 @@ Config::GetWalConfigWalPath(std::string& wal_path) {
     return Status::OK();
 }
 
+Status
+Config::GetWalConfigSyncMode(std::string& value) {
+    value = GetConfigStr(CONFIG_WAL, CONFIG_WAL_SYNC_MODE, CONFIG_WAL_SYNC_MODE_DEFAULT);
+    return CheckWalConfigSyncMode(value);
+}
+
+Status
+Config::GetWalConfigSyncInterval(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_WAL, CONFIG_WAL_SYNC_INTERVAL, CONFIG_WAL_SYNC_INTERVAL_DEFAULT);
+    STATUS_CHECK(CheckWalConfigSyncInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetWalConfigRecoveryThreadNum(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_WAL, CONFIG_WAL_RECOVERY_THREAD_NUM, CONFIG_WAL_RECOVERY_THREAD_NUM_DEFAULT);
+    STATUS_CHECK(CheckWalConfigRecoveryThreadNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetWalConfigCompress(bool& value) {
+    std::string str = GetConfigStr(CONFIG_WAL, CONFIG_WAL_COMPRESS, CONFIG_WAL_COMPRESS_DEFAULT);
+    STATUS_CHECK(CheckWalConfigCompress(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
 /* logs config */
 Status
 Config::GetLogsLevel(std::string& value) {
@@ -2190,6 +4469,30 @@ Config::GetLogsLogRotateNum(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetLogsAsyncEnable(bool& value) {
+    std::string str = GetConfigStr(CONFIG_LOGS, CONFIG_LOGS_ASYNC_ENABLE, CONFIG_LOGS_ASYNC_ENABLE_DEFAULT);
+    STATUS_CHECK(CheckLogsAsyncEnable(str));
+    STATUS_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetLogsAsyncBufferSize(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_LOGS, CONFIG_LOGS_ASYNC_BUFFER_SIZE, CONFIG_LOGS_ASYNC_BUFFER_SIZE_DEFAULT);
+    STATUS_CHECK(CheckLogsAsyncBufferSize(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetLogsAsyncRateLimit(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_LOGS, CONFIG_LOGS_ASYNC_RATE_LIMIT, CONFIG_LOGS_ASYNC_RATE_LIMIT_DEFAULT);
+    STATUS_CHECK(CheckLogsAsyncRateLimit(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 Status
 Config::GetServerRestartRequired(bool& required) {
     required = restart_required_;
@@ -2210,6 +4513,24 @@ Config::SetClusterConfigRole(const std::string& value) {
     return SetConfigValueInMem(CONFIG_CLUSTER, CONFIG_CLUSTER_ROLE, value);
 }
 
+Status
+Config::SetClusterConfigReplicaRefreshInterval(const std::string& value) {
+    STATUS_CHECK(CheckClusterConfigReplicaRefreshInterval(value));
+    return SetConfigValueInMem(CONFIG_CLUSTER, CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL, value);
+}
+
+Status
+Config::SetClusterConfigShards(const std::string& value) {
+    STATUS_CHECK(CheckClusterConfigShards(value));
+    return SetConfigValueInMem(CONFIG_CLUSTER, CONFIG_CLUSTER_SHARDS, value);
+}
+
+Status
+Config::SetClusterConfigHedgeDelay(const std::string& value) {
+    STATUS_CHECK(CheckClusterConfigHedgeDelay(value));
+    return SetConfigValueInMem(CONFIG_CLUSTER, CONFIG_CLUSTER_HEDGE_DELAY, value);
+}
+
 /* general config */
 Status
 Config::SetGeneralConfigTimezone(const std::string& value) {
@@ -2223,6 +4544,12 @@ Config::SetGeneralConfigMetaURI(const std::string& value) {
     return SetConfigValueInMem(CONFIG_GENERAL, CONFIG_GENERAL_METAURI, value);
 }
 
+Status
+Config::SetGeneralConfigMetaCacheTTL(const std::string& value) {
+    STATUS_CHECK(CheckGeneralConfigMetaCacheTTL(value));
+    return SetConfigValueInMem(CONFIG_GENERAL, CONFIG_GENERAL_META_CACHE_TTL, value);
+}
+
 /* network config */
 Status
 Config::SetNetworkConfigBindAddress(const std::string& value) {
@@ -2248,6 +4575,42 @@ Config::SetNetworkConfigHTTPPort(const std::string& value) {
     return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_PORT, value);
 }
 
+Status
+Config::SetNetworkConfigHTTPAsync(const std::string& value) {
+    STATUS_CHECK(CheckNetworkConfigHTTPAsync(value));
+    return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_ASYNC, value);
+}
+
+Status
+Config::SetNetworkConfigHTTPIOThreads(const std::string& value) {
+    STATUS_CHECK(CheckNetworkConfigHTTPIOThreads(value));
+    return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_IO_THREADS, value);
+}
+
+Status
+Config::SetNetworkConfigHTTPWorkerThreads(const std::string& value) {
+    STATUS_CHECK(CheckNetworkConfigHTTPWorkerThreads(value));
+    return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_HTTP_WORKER_THREADS, value);
+}
+
+Status
+Config::SetNetworkConfigGrpcAsync(const std::string& value) {
+    STATUS_CHECK(CheckNetworkConfigGrpcAsync(value));
+    return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_GRPC_ASYNC, value);
+}
+
+Status
+Config::SetNetworkConfigGrpcCapturePath(const std::string& value) {
+    STATUS_CHECK(CheckNetworkConfigGrpcCapturePath(value));
+    return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_GRPC_CAPTURE_PATH, value);
+}
+
+Status
+Config::SetNetworkConfigGrpcCaptureSize(const std::string& value) {
+    STATUS_CHECK(CheckNetworkConfigGrpcCaptureSize(value));
+    return SetConfigValueInMem(CONFIG_NETWORK, CONFIG_NETWORK_GRPC_CAPTURE_SIZE, value);
+}
+
 /* db config */
 Status
 Config::SetDBConfigArchiveDiskThreshold(const std::string& value) {
@@ -2274,6 +4637,96 @@ Config::SetStorageConfigAutoFlushInterval(const std::string& value) {
     return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_FLUSH_INTERVAL, value);
 }
 
+Status
+Config::SetStorageConfigRawVectorMmap(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigRawVectorMmap(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_RAW_VECTOR_MMAP, value);
+}
+
+Status
+Config::SetStorageConfigRawDataCompress(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigRawDataCompress(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_RAW_DATA_COMPRESS, value);
+}
+
+Status
+Config::SetStorageConfigBlockedBloomFilter(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigBlockedBloomFilter(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_BLOCKED_BLOOM_FILTER, value);
+}
+
+Status
+Config::SetStorageConfigMergeStrategy(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigMergeStrategy(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_STRATEGY, value);
+}
+
+Status
+Config::SetStorageConfigMergeWriteAmplification(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigMergeWriteAmplification(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION, value);
+}
+
+Status
+Config::SetStorageConfigMergeBytesLimit(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigMergeBytesLimit(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_MERGE_BYTES_LIMIT, value);
+}
+
+Status
+Config::SetStorageConfigCompactThreshold(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigCompactThreshold(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_COMPACT_THRESHOLD, value);
+}
+
+Status
+Config::SetStorageConfigCompactBytesLimit(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigCompactBytesLimit(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_COMPACT_BYTES_LIMIT, value);
+}
+
+Status
+Config::SetStorageConfigReadCoalesceGap(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigReadCoalesceGap(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_READ_COALESCE_GAP, value);
+}
+
+Status
+Config::SetStorageConfigColdPath(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigColdPath(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_COLD_PATH, value);
+}
+
+Status
+Config::SetStorageConfigHotCapacity(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigHotCapacity(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_HOT_CAPACITY, value);
+}
+
+Status
+Config::SetStorageConfigGCThreadNum(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigGCThreadNum(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_GC_THREAD_NUM, value);
+}
+
+Status
+Config::SetStorageConfigGCUnlinkRate(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigGCUnlinkRate(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_GC_UNLINK_RATE, value);
+}
+
+Status
+Config::SetStorageConfigBackgroundIORate(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigBackgroundIORate(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_BACKGROUND_IO_RATE, value);
+}
+
+Status
+Config::SetStorageConfigIOLatencyTarget(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigIOLatencyTarget(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_IO_LATENCY_TARGET, value);
+}
+
 Status
 Config::SetStorageConfigFileCleanupTimeout(const std::string& value) {
     STATUS_CHECK(CheckStorageConfigFileCleanupTimeout(value));
@@ -2335,6 +4788,24 @@ Config::SetMetricConfigPort(const std::string& value) {
     return SetConfigValueInMem(CONFIG_METRIC, CONFIG_METRIC_PORT, value);
 }
 
+Status
+Config::SetMetricConfigProfilingInterval(const std::string& value) {
+    STATUS_CHECK(CheckMetricConfigProfilingInterval(value));
+    return SetConfigValueInMem(CONFIG_METRIC, CONFIG_METRIC_PROFILING_INTERVAL, value);
+}
+
+Status
+Config::SetMetricConfigProfilingDuration(const std::string& value) {
+    STATUS_CHECK(CheckMetricConfigProfilingDuration(value));
+    return SetConfigValueInMem(CONFIG_METRIC, CONFIG_METRIC_PROFILING_DURATION, value);
+}
+
+Status
+Config::SetMetricConfigRecallSampleRate(const std::string& value) {
+    STATUS_CHECK(CheckMetricConfigRecallSampleRate(value));
+    return SetConfigValueInMem(CONFIG_METRIC, CONFIG_METRIC_RECALL_SAMPLE_RATE, value);
+}
+
 /* cache config */
 Status
 Config::SetCacheConfigCpuCacheCapacity(const std::string& value) {
@@ -2349,6 +4820,30 @@ Config::SetCacheConfigCpuCacheThreshold(const std::string& value) {
     return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_THRESHOLD, value);
 }
 
+Status
+Config::SetCacheConfigCpuCacheShardNum(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigCpuCacheShardNum(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_SHARD_NUM, value);
+}
+
+Status
+Config::SetCacheConfigCpuCachePolicy(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigCpuCachePolicy(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_POLICY, value);
+}
+
+Status
+Config::SetCacheConfigReclaimQueueSize(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigReclaimQueueSize(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_RECLAIM_QUEUE_SIZE, value);
+}
+
+Status
+Config::SetCacheConfigResultCacheCapacity(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigResultCacheCapacity(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_RESULT_CACHE_CAPACITY, value);
+}
+
 Status
 Config::SetCacheConfigInsertBufferSize(const std::string& value) {
     STATUS_CHECK(CheckCacheConfigInsertBufferSize(value));
@@ -2356,6 +4851,12 @@ Config::SetCacheConfigInsertBufferSize(const std::string& value) {
     return ExecCallBacks(CONFIG_CACHE, CONFIG_CACHE_INSERT_BUFFER_SIZE, value);
 }
 
+Status
+Config::SetCacheConfigInsertBufferTarget(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigInsertBufferTarget(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_INSERT_BUFFER_TARGET, value);
+}
+
 Status
 Config::SetCacheConfigCacheInsertData(const std::string& value) {
     STATUS_CHECK(CheckCacheConfigCacheInsertData(value));
@@ -2370,6 +4871,36 @@ Config::SetCacheConfigPreloadCollection(const std::string& value) {
     return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_COLLECTION, cor_value);
 }
 
+Status
+Config::SetCacheConfigMemoryLimit(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigMemoryLimit(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_MEMORY_LIMIT, value);
+}
+
+Status
+Config::SetCacheConfigPreloadThreadNum(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigPreloadThreadNum(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_THREAD_NUM, value);
+}
+
+Status
+Config::SetCacheConfigPreloadBandwidth(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigPreloadBandwidth(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_PRELOAD_BANDWIDTH, value);
+}
+
+Status
+Config::SetCacheConfigWarmUpSize(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigWarmUpSize(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_WARM_UP_SIZE, value);
+}
+
+Status
+Config::SetCacheConfigWriteThroughIndex(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigWriteThroughIndex(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_WRITE_THROUGH_INDEX, value);
+}
+
 /* engine config */
 Status
 Config::SetEngineConfigUseBlasThreshold(const std::string& value) {
@@ -2381,7 +4912,8 @@ Config::SetEngineConfigUseBlasThreshold(const std::string& value) {
 Status
 Config::SetEngineConfigOmpThreadNum(const std::string& value) {
     STATUS_CHECK(CheckEngineConfigOmpThreadNum(value));
-    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_OMP_THREAD_NUM, value);
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_OMP_THREAD_NUM, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_OMP_THREAD_NUM, value);
 }
 
 Status
@@ -2397,6 +4929,109 @@ Config::SetEngineSearchCombineMaxNq(const std::string& value) {
     return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ, value);
 }
 
+Status
+Config::SetEngineSearchCombineWaitUs(const std::string& value) {
+    STATUS_CHECK(CheckEngineSearchCombineWaitUs(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US, value);
+}
+
+Status
+Config::SetEngineConfigParallelReduce(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigParallelReduce(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_PARALLEL_REDUCE, value);
+}
+
+Status
+Config::SetEngineConfigExecutorThreads(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigExecutorThreads(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_EXECUTOR_THREADS, value);
+}
+
+Status
+Config::SetEngineConfigPrefetchDepth(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigPrefetchDepth(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_PREFETCH_DEPTH, value);
+}
+
+Status
+Config::SetEngineConfigSearchWorkers(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchWorkers(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_WORKERS, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_WORKERS, value);
+}
+
+Status
+Config::SetEngineConfigInsertWorkers(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigInsertWorkers(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_INSERT_WORKERS, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_INSERT_WORKERS, value);
+}
+
+Status
+Config::SetEngineConfigDdlWorkers(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigDdlWorkers(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_DDL_WORKERS, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_DDL_WORKERS, value);
+}
+
+Status
+Config::SetEngineConfigMaintenanceWorkers(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigMaintenanceWorkers(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_MAINTENANCE_WORKERS, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_MAINTENANCE_WORKERS, value);
+}
+
+Status
+Config::SetEngineConfigRequestQueueDepth(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigRequestQueueDepth(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_REQUEST_QUEUE_DEPTH, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_REQUEST_QUEUE_DEPTH, value);
+}
+
+Status
+Config::SetEngineConfigBuildCpuShare(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigBuildCpuShare(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_CPU_SHARE, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_CPU_SHARE, value);
+}
+
+Status
+Config::SetEngineConfigSearchLatencySloMs(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchLatencySloMs(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS, value);
+}
+
+Status
+Config::SetEngineConfigSearchInsertBuffer(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchInsertBuffer(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_INSERT_BUFFER, value);
+}
+
+Status
+Config::SetEngineConfigNumaAware(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigNumaAware(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_NUMA_AWARE, value);
+}
+
+Status
+Config::SetEngineConfigHugePage(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigHugePage(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_HUGE_PAGE, value);
+}
+
+Status
+Config::SetEngineConfigRawVectorCompression(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigRawVectorCompression(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_RAW_VECTOR_COMPRESSION, value);
+}
+
+Status
+Config::SetEngineConfigSearchMemoryLimit(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchMemoryLimit(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_MEMORY_LIMIT, value);
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 
@@ -2420,6 +5055,42 @@ Config::SetGpuResourceConfigCacheThreshold(const std::string& value) {
     return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_CACHE_THRESHOLD, value);
 }
 
+Status
+Config::SetGpuResourceConfigCachePolicy(const std::string& value) {
+    STATUS_CHECK(CheckGpuResourceConfigCachePolicy(value));
+    return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_CACHE_POLICY, value);
+}
+
+Status
+Config::SetGpuResourceConfigPrefetchDepth(const std::string& value) {
+    STATUS_CHECK(CheckGpuResourceConfigPrefetchDepth(value));
+    return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_PREFETCH_DEPTH, value);
+}
+
+Status
+Config::SetGpuResourceConfigCostPlacement(const std::string& value) {
+    STATUS_CHECK(CheckGpuResourceConfigCostPlacement(value));
+    return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_COST_PLACEMENT, value);
+}
+
+Status
+Config::SetGpuResourceConfigBuildIndexSharded(const std::string& value) {
+    STATUS_CHECK(CheckGpuResourceConfigBuildIndexSharded(value));
+    return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED, value);
+}
+
+Status
+Config::SetGpuResourceConfigSearchSharded(const std::string& value) {
+    STATUS_CHECK(CheckGpuResourceConfigSearchSharded(value));
+    return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_SEARCH_SHARDED, value);
+}
+
+Status
+Config::SetGpuResourceConfigKeepFreshSegments(const std::string& value) {
+    STATUS_CHECK(CheckGpuResourceConfigKeepFreshSegments(value));
+    return SetConfigValueInMem(CONFIG_GPU_RESOURCE, CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS, value);
+}
+
 Status
 Config::SetGpuResourceConfigGpuSearchThreshold(const std::string& value) {
     STATUS_CHECK(CheckGpuResourceConfigGpuSearchThreshold(value));
@@ -2454,6 +5125,36 @@ Config::SetTracingConfigJsonConfigPath(const std::string& value) {
     return SetConfigValueInMem(CONFIG_TRACING, CONFIG_TRACING_JSON_CONFIG_PATH, value);
 }
 
+Status
+Config::SetTracingConfigSearchSampleRate(const std::string& value) {
+    STATUS_CHECK(CheckTracingConfigSearchSampleRate(value));
+    return SetConfigValueInMem(CONFIG_TRACING, CONFIG_TRACING_SEARCH_SAMPLE_RATE, value);
+}
+
+Status
+Config::SetTracingConfigInsertSampleRate(const std::string& value) {
+    STATUS_CHECK(CheckTracingConfigInsertSampleRate(value));
+    return SetConfigValueInMem(CONFIG_TRACING, CONFIG_TRACING_INSERT_SAMPLE_RATE, value);
+}
+
+Status
+Config::SetTracingConfigDdlSampleRate(const std::string& value) {
+    STATUS_CHECK(CheckTracingConfigDdlSampleRate(value));
+    return SetConfigValueInMem(CONFIG_TRACING, CONFIG_TRACING_DDL_SAMPLE_RATE, value);
+}
+
+Status
+Config::SetTracingConfigMaintenanceSampleRate(const std::string& value) {
+    STATUS_CHECK(CheckTracingConfigMaintenanceSampleRate(value));
+    return SetConfigValueInMem(CONFIG_TRACING, CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE, value);
+}
+
+Status
+Config::SetTracingConfigInfoSampleRate(const std::string& value) {
+    STATUS_CHECK(CheckTracingConfigInfoSampleRate(value));
+    return SetConfigValueInMem(CONFIG_TRACING, CONFIG_TRACING_INFO_SAMPLE_RATE, value);
+}
+
 /* wal config */
 Status
 Config::SetWalConfigEnable(const std::string& value) {
@@ -2470,7 +5171,8 @@ Config::SetWalConfigRecoveryErrorIgnore(const std::string& value) {
 Status
 Config::SetWalConfigBufferSize(const std::string& value) {
     STATUS_CHECK(CheckWalConfigBufferSize(value));
-    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_BUFFER_SIZE, value);
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_BUFFER_SIZE, value));
+    return ExecCallBacks(CONFIG_WAL, CONFIG_WAL_BUFFER_SIZE, value);
 }
 
 Status
@@ -2479,6 +5181,30 @@ Config::SetWalConfigWalPath(const std::string& value) {
     return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_WAL_PATH, value);
 }
 
+Status
+Config::SetWalConfigSyncMode(const std::string& value) {
+    STATUS_CHECK(CheckWalConfigSyncMode(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_SYNC_MODE, value);
+}
+
+Status
+Config::SetWalConfigSyncInterval(const std::string& value) {
+    STATUS_CHECK(CheckWalConfigSyncInterval(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_SYNC_INTERVAL, value);
+}
+
+Status
+Config::SetWalConfigRecoveryThreadNum(const std::string& value) {
+    STATUS_CHECK(CheckWalConfigRecoveryThreadNum(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_RECOVERY_THREAD_NUM, value);
+}
+
+Status
+Config::SetWalConfigCompress(const std::string& value) {
+    STATUS_CHECK(CheckWalConfigCompress(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_COMPRESS, value);
+}
+
 /* logs config */
 Status
 Config::SetLogsLevel(const std::string& value) {
@@ -2510,5 +5236,23 @@ Config::SetLogsLogRotateNum(const std::string& value) {
     return SetConfigValueInMem(CONFIG_LOGS, CONFIG_LOGS_LOG_ROTATE_NUM, value);
 }
 
+Status
+Config::SetLogsAsyncEnable(const std::string& value) {
+    STATUS_CHECK(CheckLogsAsyncEnable(value));
+    return SetConfigValueInMem(CONFIG_LOGS, CONFIG_LOGS_ASYNC_ENABLE, value);
+}
+
+Status
+Config::SetLogsAsyncBufferSize(const std::string& value) {
+    STATUS_CHECK(CheckLogsAsyncBufferSize(value));
+    return SetConfigValueInMem(CONFIG_LOGS, CONFIG_LOGS_ASYNC_BUFFER_SIZE, value);
+}
+
+Status
+Config::SetLogsAsyncRateLimit(const std::string& value) {
+    STATUS_CHECK(CheckLogsAsyncRateLimit(value));
+    return SetConfigValueInMem(CONFIG_LOGS, CONFIG_LOGS_ASYNC_RATE_LIMIT, value);
+}
+
 }  // namespace server
 }  // namespace milvus
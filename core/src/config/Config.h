@@ -34,6 +34,12 @@ extern const char* CONFIG_CLUSTER_ENABLE;
 extern const char* CONFIG_CLUSTER_ENABLE_DEFAULT;
 extern const char* CONFIG_CLUSTER_ROLE;
 extern const char* CONFIG_CLUSTER_ROLE_DEFAULT;
+extern const char* CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL;
+extern const char* CONFIG_CLUSTER_REPLICA_REFRESH_INTERVAL_DEFAULT;
+extern const char* CONFIG_CLUSTER_SHARDS;
+extern const char* CONFIG_CLUSTER_SHARDS_DEFAULT;
+extern const char* CONFIG_CLUSTER_HEDGE_DELAY;
+extern const char* CONFIG_CLUSTER_HEDGE_DELAY_DEFAULT;
 
 /* general config */
 extern const char* CONFIG_GENERAL;
@@ -41,6 +47,8 @@ extern const char* CONFIG_GENERAL_TIMEZONE;
 extern const char* CONFIG_GENERAL_TIMEZONE_DEFAULT;
 extern const char* CONFIG_GENERAL_METAURI;
 extern const char* CONFIG_GENERAL_METAURI_DEFAULT;
+extern const char* CONFIG_GENERAL_META_CACHE_TTL;
+extern const char* CONFIG_GENERAL_META_CACHE_TTL_DEFAULT;
 
 /* network config */
 extern const char* CONFIG_NETWORK;
@@ -52,6 +60,18 @@ extern const char* CONFIG_NETWORK_HTTP_ENABLE;
 extern const char* CONFIG_NETWORK_HTTP_ENABLE_DEFAULT;
 extern const char* CONFIG_NETWORK_HTTP_PORT;
 extern const char* CONFIG_NETWORK_HTTP_PORT_DEFAULT;
+extern const char* CONFIG_NETWORK_HTTP_ASYNC;
+extern const char* CONFIG_NETWORK_HTTP_ASYNC_DEFAULT;
+extern const char* CONFIG_NETWORK_HTTP_IO_THREADS;
+extern const char* CONFIG_NETWORK_HTTP_IO_THREADS_DEFAULT;
+extern const char* CONFIG_NETWORK_HTTP_WORKER_THREADS;
+extern const char* CONFIG_NETWORK_HTTP_WORKER_THREADS_DEFAULT;
+extern const char* CONFIG_NETWORK_GRPC_ASYNC;
+extern const char* CONFIG_NETWORK_GRPC_ASYNC_DEFAULT;
+extern const char* CONFIG_NETWORK_GRPC_CAPTURE_PATH;
+extern const char* CONFIG_NETWORK_GRPC_CAPTURE_PATH_DEFAULT;
+extern const char* CONFIG_NETWORK_GRPC_CAPTURE_SIZE;
+extern const char* CONFIG_NETWORK_GRPC_CAPTURE_SIZE_DEFAULT;
 
 /* db config */
 extern const char* CONFIG_DB;
@@ -69,6 +89,36 @@ extern const char* CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT;
 extern const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT;
 extern const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN;
 extern const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX;
+extern const char* CONFIG_STORAGE_RAW_VECTOR_MMAP;
+extern const char* CONFIG_STORAGE_RAW_VECTOR_MMAP_DEFAULT;
+extern const char* CONFIG_STORAGE_RAW_DATA_COMPRESS;
+extern const char* CONFIG_STORAGE_RAW_DATA_COMPRESS_DEFAULT;
+extern const char* CONFIG_STORAGE_BLOCKED_BLOOM_FILTER;
+extern const char* CONFIG_STORAGE_BLOCKED_BLOOM_FILTER_DEFAULT;
+extern const char* CONFIG_STORAGE_MERGE_STRATEGY;
+extern const char* CONFIG_STORAGE_MERGE_STRATEGY_DEFAULT;
+extern const char* CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION;
+extern const char* CONFIG_STORAGE_MERGE_WRITE_AMPLIFICATION_DEFAULT;
+extern const char* CONFIG_STORAGE_MERGE_BYTES_LIMIT;
+extern const char* CONFIG_STORAGE_MERGE_BYTES_LIMIT_DEFAULT;
+extern const char* CONFIG_STORAGE_COMPACT_THRESHOLD;
+extern const char* CONFIG_STORAGE_COMPACT_THRESHOLD_DEFAULT;
+extern const char* CONFIG_STORAGE_COMPACT_BYTES_LIMIT;
+extern const char* CONFIG_STORAGE_COMPACT_BYTES_LIMIT_DEFAULT;
+extern const char* CONFIG_STORAGE_READ_COALESCE_GAP;
+extern const char* CONFIG_STORAGE_READ_COALESCE_GAP_DEFAULT;
+extern const char* CONFIG_STORAGE_COLD_PATH;
+extern const char* CONFIG_STORAGE_COLD_PATH_DEFAULT;
+extern const char* CONFIG_STORAGE_HOT_CAPACITY;
+extern const char* CONFIG_STORAGE_HOT_CAPACITY_DEFAULT;
+extern const char* CONFIG_STORAGE_GC_THREAD_NUM;
+extern const char* CONFIG_STORAGE_GC_THREAD_NUM_DEFAULT;
+extern const char* CONFIG_STORAGE_GC_UNLINK_RATE;
+extern const char* CONFIG_STORAGE_GC_UNLINK_RATE_DEFAULT;
+extern const char* CONFIG_STORAGE_BACKGROUND_IO_RATE;
+extern const char* CONFIG_STORAGE_BACKGROUND_IO_RATE_DEFAULT;
+extern const char* CONFIG_STORAGE_IO_LATENCY_TARGET;
+extern const char* CONFIG_STORAGE_IO_LATENCY_TARGET_DEFAULT;
 
 /* cache config */
 extern const char* CONFIG_CACHE;
@@ -76,12 +126,32 @@ extern const char* CONFIG_CACHE_CPU_CACHE_CAPACITY;
 extern const char* CONFIG_CACHE_CPU_CACHE_CAPACITY_DEFAULT;
 extern const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD;
 extern const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT;
+extern const char* CONFIG_CACHE_CPU_CACHE_SHARD_NUM;
+extern const char* CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT;
+extern const char* CONFIG_CACHE_CPU_CACHE_POLICY;
+extern const char* CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT;
+extern const char* CONFIG_CACHE_RECLAIM_QUEUE_SIZE;
+extern const char* CONFIG_CACHE_RECLAIM_QUEUE_SIZE_DEFAULT;
+extern const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY;
+extern const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT;
 extern const char* CONFIG_CACHE_INSERT_BUFFER_SIZE;
 extern const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT;
+extern const char* CONFIG_CACHE_INSERT_BUFFER_TARGET;
+extern const char* CONFIG_CACHE_INSERT_BUFFER_TARGET_DEFAULT;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT;
 extern const char* CONFIG_CACHE_PRELOAD_COLLECTION;
 extern const char* CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT;
+extern const char* CONFIG_CACHE_MEMORY_LIMIT;
+extern const char* CONFIG_CACHE_MEMORY_LIMIT_DEFAULT;
+extern const char* CONFIG_CACHE_PRELOAD_THREAD_NUM;
+extern const char* CONFIG_CACHE_PRELOAD_THREAD_NUM_DEFAULT;
+extern const char* CONFIG_CACHE_PRELOAD_BANDWIDTH;
+extern const char* CONFIG_CACHE_PRELOAD_BANDWIDTH_DEFAULT;
+extern const char* CONFIG_CACHE_WARM_UP_SIZE;
+extern const char* CONFIG_CACHE_WARM_UP_SIZE_DEFAULT;
+extern const char* CONFIG_CACHE_WRITE_THROUGH_INDEX;
+extern const char* CONFIG_CACHE_WRITE_THROUGH_INDEX_DEFAULT;
 
 /* metric config */
 extern const char* CONFIG_METRIC;
@@ -91,6 +161,12 @@ extern const char* CONFIG_METRIC_ADDRESS;
 extern const char* CONFIG_METRIC_ADDRESS_DEFAULT;
 extern const char* CONFIG_METRIC_PORT;
 extern const char* CONFIG_METRIC_PORT_DEFAULT;
+extern const char* CONFIG_METRIC_PROFILING_INTERVAL;
+extern const char* CONFIG_METRIC_PROFILING_INTERVAL_DEFAULT;
+extern const char* CONFIG_METRIC_PROFILING_DURATION;
+extern const char* CONFIG_METRIC_PROFILING_DURATION_DEFAULT;
+extern const char* CONFIG_METRIC_RECALL_SAMPLE_RATE;
+extern const char* CONFIG_METRIC_RECALL_SAMPLE_RATE_DEFAULT;
 
 /* engine config */
 extern const char* CONFIG_ENGINE;
@@ -102,6 +178,38 @@ extern const char* CONFIG_ENGINE_SIMD_TYPE;
 extern const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT;
 extern const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ;
 extern const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US;
+extern const char* CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US_DEFAULT;
+extern const char* CONFIG_ENGINE_PARALLEL_REDUCE;
+extern const char* CONFIG_ENGINE_PARALLEL_REDUCE_DEFAULT;
+extern const char* CONFIG_ENGINE_EXECUTOR_THREADS;
+extern const char* CONFIG_ENGINE_EXECUTOR_THREADS_DEFAULT;
+extern const char* CONFIG_ENGINE_PREFETCH_DEPTH;
+extern const char* CONFIG_ENGINE_PREFETCH_DEPTH_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_WORKERS;
+extern const char* CONFIG_ENGINE_SEARCH_WORKERS_DEFAULT;
+extern const char* CONFIG_ENGINE_INSERT_WORKERS;
+extern const char* CONFIG_ENGINE_INSERT_WORKERS_DEFAULT;
+extern const char* CONFIG_ENGINE_DDL_WORKERS;
+extern const char* CONFIG_ENGINE_DDL_WORKERS_DEFAULT;
+extern const char* CONFIG_ENGINE_MAINTENANCE_WORKERS;
+extern const char* CONFIG_ENGINE_MAINTENANCE_WORKERS_DEFAULT;
+extern const char* CONFIG_ENGINE_REQUEST_QUEUE_DEPTH;
+extern const char* CONFIG_ENGINE_REQUEST_QUEUE_DEPTH_DEFAULT;
+extern const char* CONFIG_ENGINE_BUILD_CPU_SHARE;
+extern const char* CONFIG_ENGINE_BUILD_CPU_SHARE_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS;
+extern const char* CONFIG_ENGINE_SEARCH_LATENCY_SLO_MS_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_INSERT_BUFFER;
+extern const char* CONFIG_ENGINE_SEARCH_INSERT_BUFFER_DEFAULT;
+extern const char* CONFIG_ENGINE_NUMA_AWARE;
+extern const char* CONFIG_ENGINE_NUMA_AWARE_DEFAULT;
+extern const char* CONFIG_ENGINE_HUGE_PAGE;
+extern const char* CONFIG_ENGINE_HUGE_PAGE_DEFAULT;
+extern const char* CONFIG_ENGINE_RAW_VECTOR_COMPRESSION;
+extern const char* CONFIG_ENGINE_RAW_VECTOR_COMPRESSION_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_MEMORY_LIMIT;
+extern const char* CONFIG_ENGINE_SEARCH_MEMORY_LIMIT_DEFAULT;
 
 /* gpu resource config */
 extern const char* CONFIG_GPU_RESOURCE;
@@ -111,6 +219,18 @@ extern const char* CONFIG_GPU_RESOURCE_CACHE_CAPACITY;
 extern const char* CONFIG_GPU_RESOURCE_CACHE_CAPACITY_DEFAULT;
 extern const char* CONFIG_GPU_RESOURCE_CACHE_THRESHOLD;
 extern const char* CONFIG_GPU_RESOURCE_CACHE_THRESHOLD_DEFAULT;
+extern const char* CONFIG_GPU_RESOURCE_CACHE_POLICY;
+extern const char* CONFIG_GPU_RESOURCE_CACHE_POLICY_DEFAULT;
+extern const char* CONFIG_GPU_RESOURCE_PREFETCH_DEPTH;
+extern const char* CONFIG_GPU_RESOURCE_PREFETCH_DEPTH_DEFAULT;
+extern const char* CONFIG_GPU_RESOURCE_COST_PLACEMENT;
+extern const char* CONFIG_GPU_RESOURCE_COST_PLACEMENT_DEFAULT;
+extern const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED;
+extern const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_SHARDED_DEFAULT;
+extern const char* CONFIG_GPU_RESOURCE_SEARCH_SHARDED;
+extern const char* CONFIG_GPU_RESOURCE_SEARCH_SHARDED_DEFAULT;
+extern const char* CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS;
+extern const char* CONFIG_GPU_RESOURCE_KEEP_FRESH_SEGMENTS_DEFAULT;
 extern const char* CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD;
 extern const char* CONFIG_GPU_RESOURCE_GPU_SEARCH_THRESHOLD_DEFAULT;
 extern const char* CONFIG_GPU_RESOURCE_DELIMITER;
@@ -122,6 +242,16 @@ extern const char* CONFIG_GPU_RESOURCE_BUILD_INDEX_RESOURCES_DEFAULT;
 /* tracing config */
 extern const char* CONFIG_TRACING;
 extern const char* CONFIG_TRACING_JSON_CONFIG_PATH;
+extern const char* CONFIG_TRACING_SEARCH_SAMPLE_RATE;
+extern const char* CONFIG_TRACING_SEARCH_SAMPLE_RATE_DEFAULT;
+extern const char* CONFIG_TRACING_INSERT_SAMPLE_RATE;
+extern const char* CONFIG_TRACING_INSERT_SAMPLE_RATE_DEFAULT;
+extern const char* CONFIG_TRACING_DDL_SAMPLE_RATE;
+extern const char* CONFIG_TRACING_DDL_SAMPLE_RATE_DEFAULT;
+extern const char* CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE;
+extern const char* CONFIG_TRACING_MAINTENANCE_SAMPLE_RATE_DEFAULT;
+extern const char* CONFIG_TRACING_INFO_SAMPLE_RATE;
+extern const char* CONFIG_TRACING_INFO_SAMPLE_RATE_DEFAULT;
 
 /* wal config */
 extern const char* CONFIG_WAL;
@@ -135,6 +265,14 @@ extern const int64_t CONFIG_WAL_BUFFER_SIZE_MIN;
 extern const int64_t CONFIG_WAL_BUFFER_SIZE_MAX;
 extern const char* CONFIG_WAL_WAL_PATH;
 extern const char* CONFIG_WAL_WAL_PATH_DEFAULT;
+extern const char* CONFIG_WAL_SYNC_MODE;
+extern const char* CONFIG_WAL_SYNC_MODE_DEFAULT;
+extern const char* CONFIG_WAL_SYNC_INTERVAL;
+extern const char* CONFIG_WAL_SYNC_INTERVAL_DEFAULT;
+extern const char* CONFIG_WAL_RECOVERY_THREAD_NUM;
+extern const char* CONFIG_WAL_RECOVERY_THREAD_NUM_DEFAULT;
+extern const char* CONFIG_WAL_COMPRESS;
+extern const char* CONFIG_WAL_COMPRESS_DEFAULT;
 
 /* logs config */
 extern const char* CONFIG_LOGS;
@@ -151,6 +289,16 @@ extern const char* CONFIG_LOGS_LOG_ROTATE_NUM;
 extern const char* CONFIG_LOGS_LOG_ROTATE_NUM_DEFAULT;
 extern const int64_t CONFIG_LOGS_LOG_ROTATE_NUM_MIN;
 extern const int64_t CONFIG_LOGS_LOG_ROTATE_NUM_MAX;
+extern const char* CONFIG_LOGS_ASYNC_ENABLE;
+extern const char* CONFIG_LOGS_ASYNC_ENABLE_DEFAULT;
+extern const char* CONFIG_LOGS_ASYNC_BUFFER_SIZE;
+extern const char* CONFIG_LOGS_ASYNC_BUFFER_SIZE_DEFAULT;
+extern const int64_t CONFIG_LOGS_ASYNC_BUFFER_SIZE_MIN;
+extern const int64_t CONFIG_LOGS_ASYNC_BUFFER_SIZE_MAX;
+extern const char* CONFIG_LOGS_ASYNC_RATE_LIMIT;
+extern const char* CONFIG_LOGS_ASYNC_RATE_LIMIT_DEFAULT;
+extern const int64_t CONFIG_LOGS_ASYNC_RATE_LIMIT_MIN;
+extern const int64_t CONFIG_LOGS_ASYNC_RATE_LIMIT_MAX;
 
 class Config {
  private:
@@ -208,12 +356,20 @@ class Config {
     CheckClusterConfigEnable(const std::string& value);
     Status
     CheckClusterConfigRole(const std::string& value);
+    Status
+    CheckClusterConfigReplicaRefreshInterval(const std::string& value);
+    Status
+    CheckClusterConfigShards(const std::string& value);
+    Status
+    CheckClusterConfigHedgeDelay(const std::string& value);
 
     /* general config */
     Status
     CheckGeneralConfigTimezone(const std::string& value);
     Status
     CheckGeneralConfigMetaURI(const std::string& value);
+    Status
+    CheckGeneralConfigMetaCacheTTL(const std::string& value);
 
     /* network config */
     Status
@@ -224,6 +380,18 @@ class Config {
     CheckNetworkConfigHTTPEnable(const std::string& value);
     Status
     CheckNetworkConfigHTTPPort(const std::string& value);
+    Status
+    CheckNetworkConfigHTTPAsync(const std::string& value);
+    Status
+    CheckNetworkConfigHTTPIOThreads(const std::string& value);
+    Status
+    CheckNetworkConfigHTTPWorkerThreads(const std::string& value);
+    Status
+    CheckNetworkConfigGrpcAsync(const std::string& value);
+    Status
+    CheckNetworkConfigGrpcCapturePath(const std::string& value);
+    Status
+    CheckNetworkConfigGrpcCaptureSize(const std::string& value);
 
     /* db config */
     Status
@@ -237,6 +405,36 @@ class Config {
     Status
     CheckStorageConfigAutoFlushInterval(const std::string& value);
     Status
+    CheckStorageConfigRawVectorMmap(const std::string& value);
+    Status
+    CheckStorageConfigRawDataCompress(const std::string& value);
+    Status
+    CheckStorageConfigBlockedBloomFilter(const std::string& value);
+    Status
+    CheckStorageConfigMergeStrategy(const std::string& value);
+    Status
+    CheckStorageConfigMergeWriteAmplification(const std::string& value);
+    Status
+    CheckStorageConfigMergeBytesLimit(const std::string& value);
+    Status
+    CheckStorageConfigCompactThreshold(const std::string& value);
+    Status
+    CheckStorageConfigCompactBytesLimit(const std::string& value);
+    Status
+    CheckStorageConfigReadCoalesceGap(const std::string& value);
+    Status
+    CheckStorageConfigColdPath(const std::string& value);
+    Status
+    CheckStorageConfigHotCapacity(const std::string& value);
+    Status
+    CheckStorageConfigGCThreadNum(const std::string& value);
+    Status
+    CheckStorageConfigGCUnlinkRate(const std::string& value);
+    Status
+    CheckStorageConfigBackgroundIORate(const std::string& value);
+    Status
+    CheckStorageConfigIOLatencyTarget(const std::string& value);
+    Status
     CheckStorageConfigFileCleanupTimeout(const std::string& value);
 
     /* metric config */
@@ -246,6 +444,12 @@ class Config {
     CheckMetricConfigAddress(const std::string& value);
     Status
     CheckMetricConfigPort(const std::string& value);
+    Status
+    CheckMetricConfigProfilingInterval(const std::string& value);
+    Status
+    CheckMetricConfigProfilingDuration(const std::string& value);
+    Status
+    CheckMetricConfigRecallSampleRate(const std::string& value);
 
     /* cache config */
     Status
@@ -253,11 +457,31 @@ class Config {
     Status
     CheckCacheConfigCpuCacheThreshold(const std::string& value);
     Status
+    CheckCacheConfigCpuCacheShardNum(const std::string& value);
+    Status
+    CheckCacheConfigCpuCachePolicy(const std::string& value);
+    Status
+    CheckCacheConfigReclaimQueueSize(const std::string& value);
+    Status
+    CheckCacheConfigResultCacheCapacity(const std::string& value);
+    Status
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
+    CheckCacheConfigInsertBufferTarget(const std::string& value);
+    Status
     CheckCacheConfigCacheInsertData(const std::string& value);
     Status
     CheckCacheConfigPreloadCollection(const std::string& value);
+    Status
+    CheckCacheConfigMemoryLimit(const std::string& value);
+    Status
+    CheckCacheConfigPreloadThreadNum(const std::string& value);
+    Status
+    CheckCacheConfigPreloadBandwidth(const std::string& value);
+    Status
+    CheckCacheConfigWarmUpSize(const std::string& value);
+    Status
+    CheckCacheConfigWriteThroughIndex(const std::string& value);
 
     /* engine config */
     Status
@@ -268,6 +492,38 @@ class Config {
     CheckEngineConfigSimdType(const std::string& value);
     Status
     CheckEngineSearchCombineMaxNq(const std::string& value);
+    Status
+    CheckEngineSearchCombineWaitUs(const std::string& value);
+    Status
+    CheckEngineConfigParallelReduce(const std::string& value);
+    Status
+    CheckEngineConfigExecutorThreads(const std::string& value);
+    Status
+    CheckEngineConfigPrefetchDepth(const std::string& value);
+    Status
+    CheckEngineConfigSearchWorkers(const std::string& value);
+    Status
+    CheckEngineConfigInsertWorkers(const std::string& value);
+    Status
+    CheckEngineConfigDdlWorkers(const std::string& value);
+    Status
+    CheckEngineConfigMaintenanceWorkers(const std::string& value);
+    Status
+    CheckEngineConfigRequestQueueDepth(const std::string& value);
+    Status
+    CheckEngineConfigBuildCpuShare(const std::string& value);
+    Status
+    CheckEngineConfigSearchLatencySloMs(const std::string& value);
+    Status
+    CheckEngineConfigSearchInsertBuffer(const std::string& value);
+    Status
+    CheckEngineConfigNumaAware(const std::string& value);
+    Status
+    CheckEngineConfigHugePage(const std::string& value);
+    Status
+    CheckEngineConfigRawVectorCompression(const std::string& value);
+    Status
+    CheckEngineConfigSearchMemoryLimit(const std::string& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -278,6 +534,18 @@ class Config {
     Status
     CheckGpuResourceConfigCacheThreshold(const std::string& value);
     Status
+    CheckGpuResourceConfigCachePolicy(const std::string& value);
+    Status
+    CheckGpuResourceConfigPrefetchDepth(const std::string& value);
+    Status
+    CheckGpuResourceConfigCostPlacement(const std::string& value);
+    Status
+    CheckGpuResourceConfigBuildIndexSharded(const std::string& value);
+    Status
+    CheckGpuResourceConfigSearchSharded(const std::string& value);
+    Status
+    CheckGpuResourceConfigKeepFreshSegments(const std::string& value);
+    Status
     CheckGpuResourceConfigGpuSearchThreshold(const std::string& value);
     Status
     CheckGpuResourceConfigSearchResources(const std::vector<std::string>& value);
@@ -288,6 +556,16 @@ class Config {
     /* tracing config */
     Status
     CheckTracingConfigJsonConfigPath(const std::string& value);
+    Status
+    CheckTracingConfigSearchSampleRate(const std::string& value);
+    Status
+    CheckTracingConfigInsertSampleRate(const std::string& value);
+    Status
+    CheckTracingConfigDdlSampleRate(const std::string& value);
+    Status
+    CheckTracingConfigMaintenanceSampleRate(const std::string& value);
+    Status
+    CheckTracingConfigInfoSampleRate(const std::string& value);
 
     /* wal config */
     Status
@@ -298,6 +576,14 @@ class Config {
     CheckWalConfigBufferSize(const std::string& value);
     Status
     CheckWalConfigWalPath(const std::string& value);
+    Status
+    CheckWalConfigSyncMode(const std::string& value);
+    Status
+    CheckWalConfigSyncInterval(const std::string& value);
+    Status
+    CheckWalConfigRecoveryThreadNum(const std::string& value);
+    Status
+    CheckWalConfigCompress(const std::string& value);
 
     /* logs config */
     Status
@@ -310,6 +596,12 @@ class Config {
     CheckLogsMaxLogFileSize(const std::string& value);
     Status
     CheckLogsLogRotateNum(const std::string& value);
+    Status
+    CheckLogsAsyncEnable(const std::string& value);
+    Status
+    CheckLogsAsyncBufferSize(const std::string& value);
+    Status
+    CheckLogsAsyncRateLimit(const std::string& value);
 
     std::string
     GetConfigStr(const std::string& parent_key, const std::string& child_key, const std::string& default_value = "");
@@ -328,12 +620,21 @@ class Config {
     GetClusterConfigEnable(bool& value);
     Status
     GetClusterConfigRole(std::string& value);
+    Status
+    GetClusterConfigReplicaRefreshInterval(int64_t& value);
+    // the peer addresses of each shard, empty unless the node coordinates the searches of the shards
+    Status
+    GetClusterConfigShards(std::vector<std::vector<std::string>>& value);
+    Status
+    GetClusterConfigHedgeDelay(int64_t& value);
 
     /* general config */
     Status
     GetGeneralConfigTimezone(std::string& value);
     Status
     GetGeneralConfigMetaURI(std::string& value);
+    Status
+    GetGeneralConfigMetaCacheTTL(int64_t& value);
 
     /* network config */
     Status
@@ -344,6 +645,18 @@ class Config {
     GetNetworkConfigHTTPEnable(bool& value);
     Status
     GetNetworkConfigHTTPPort(std::string& value);
+    Status
+    GetNetworkConfigHTTPAsync(bool& value);
+    Status
+    GetNetworkConfigHTTPIOThreads(int64_t& value);
+    Status
+    GetNetworkConfigHTTPWorkerThreads(int64_t& value);
+    Status
+    GetNetworkConfigGrpcAsync(bool& value);
+    Status
+    GetNetworkConfigGrpcCapturePath(std::string& value);
+    Status
+    GetNetworkConfigGrpcCaptureSize(int64_t& value);
 
     /* db config */
     Status
@@ -357,6 +670,36 @@ class Config {
     Status
     GetStorageConfigAutoFlushInterval(int64_t& value);
     Status
+    GetStorageConfigRawVectorMmap(bool& value);
+    Status
+    GetStorageConfigRawDataCompress(bool& value);
+    Status
+    GetStorageConfigBlockedBloomFilter(bool& value);
+    Status
+    GetStorageConfigMergeStrategy(std::string& value);
+    Status
+    GetStorageConfigMergeWriteAmplification(int64_t& value);
+    Status
+    GetStorageConfigMergeBytesLimit(int64_t& value);
+    Status
+    GetStorageConfigCompactThreshold(float& value);
+    Status
+    GetStorageConfigCompactBytesLimit(int64_t& value);
+    Status
+    GetStorageConfigReadCoalesceGap(int64_t& value);
+    Status
+    GetStorageConfigColdPath(std::string& value);
+    Status
+    GetStorageConfigHotCapacity(int64_t& value);
+    Status
+    GetStorageConfigGCThreadNum(int64_t& value);
+    Status
+    GetStorageConfigGCUnlinkRate(int64_t& value);
+    Status
+    GetStorageConfigBackgroundIORate(int64_t& value);
+    Status
+    GetStorageConfigIOLatencyTarget(float& value);
+    Status
     GetStorageConfigFileCleanupTimeup(int64_t& value);
 
     /* metric config */
@@ -366,6 +709,12 @@ class Config {
     GetMetricConfigAddress(std::string& value);
     Status
     GetMetricConfigPort(std::string& value);
+    Status
+    GetMetricConfigProfilingInterval(int64_t& value);
+    Status
+    GetMetricConfigProfilingDuration(int64_t& value);
+    Status
+    GetMetricConfigRecallSampleRate(float& value);
 
     /* cache config */
     Status
@@ -373,11 +722,31 @@ class Config {
     Status
     GetCacheConfigCpuCacheThreshold(float& value);
     Status
+    GetCacheConfigCpuCacheShardNum(int64_t& value);
+    Status
+    GetCacheConfigCpuCachePolicy(std::string& value);
+    Status
+    GetCacheConfigReclaimQueueSize(int64_t& value);
+    Status
+    GetCacheConfigResultCacheCapacity(int64_t& value);
+    Status
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
+    GetCacheConfigInsertBufferTarget(float& value);
+    Status
     GetCacheConfigCacheInsertData(bool& value);
     Status
     GetCacheConfigPreloadCollection(std::string& value);
+    Status
+    GetCacheConfigMemoryLimit(int64_t& value);
+    Status
+    GetCacheConfigPreloadThreadNum(int64_t& value);
+    Status
+    GetCacheConfigPreloadBandwidth(int64_t& value);
+    Status
+    GetCacheConfigWarmUpSize(int64_t& value);
+    Status
+    GetCacheConfigWriteThroughIndex(bool& value);
 
     /* engine config */
     Status
@@ -388,6 +757,38 @@ class Config {
     GetEngineConfigSimdType(std::string& value);
     Status
     GetEngineSearchCombineMaxNq(int64_t& value);
+    Status
+    GetEngineSearchCombineWaitUs(int64_t& value);
+    Status
+    GetEngineConfigParallelReduce(bool& value);
+    Status
+    GetEngineConfigExecutorThreads(int64_t& value);
+    Status
+    GetEngineConfigPrefetchDepth(int64_t& value);
+    Status
+    GetEngineConfigSearchWorkers(int64_t& value);
+    Status
+    GetEngineConfigInsertWorkers(int64_t& value);
+    Status
+    GetEngineConfigDdlWorkers(int64_t& value);
+    Status
+    GetEngineConfigMaintenanceWorkers(int64_t& value);
+    Status
+    GetEngineConfigRequestQueueDepth(int64_t& value);
+    Status
+    GetEngineConfigBuildCpuShare(float& value);
+    Status
+    GetEngineConfigSearchLatencySloMs(int64_t& value);
+    Status
+    GetEngineConfigSearchInsertBuffer(bool& value);
+    Status
+    GetEngineConfigNumaAware(bool& value);
+    Status
+    GetEngineConfigHugePage(bool& value);
+    Status
+    GetEngineConfigRawVectorCompression(std::string& value);
+    Status
+    GetEngineConfigSearchMemoryLimit(int64_t& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -398,6 +799,18 @@ class Config {
     Status
     GetGpuResourceConfigCacheThreshold(float& value);
     Status
+    GetGpuResourceConfigCachePolicy(std::string& value);
+    Status
+    GetGpuResourceConfigPrefetchDepth(int64_t& value);
+    Status
+    GetGpuResourceConfigCostPlacement(bool& value);
+    Status
+    GetGpuResourceConfigBuildIndexSharded(bool& value);
+    Status
+    GetGpuResourceConfigSearchSharded(bool& value);
+    Status
+    GetGpuResourceConfigKeepFreshSegments(bool& value);
+    Status
     GetGpuResourceConfigGpuSearchThreshold(int64_t& value);
     Status
     GetGpuResourceConfigSearchResources(std::vector<int64_t>& value);
@@ -408,6 +821,16 @@ class Config {
     /* tracing config */
     Status
     GetTracingConfigJsonConfigPath(std::string& value);
+    Status
+    GetTracingConfigSearchSampleRate(float& value);
+    Status
+    GetTracingConfigInsertSampleRate(float& value);
+    Status
+    GetTracingConfigDdlSampleRate(float& value);
+    Status
+    GetTracingConfigMaintenanceSampleRate(float& value);
+    Status
+    GetTracingConfigInfoSampleRate(float& value);
 
     /* wal config */
     Status
@@ -418,6 +841,14 @@ class Config {
     GetWalConfigBufferSize(int64_t& value);
     Status
     GetWalConfigWalPath(std::string& value);
+    Status
+    GetWalConfigSyncMode(std::string& value);
+    Status
+    GetWalConfigSyncInterval(int64_t& value);
+    Status
+    GetWalConfigRecoveryThreadNum(int64_t& value);
+    Status
+    GetWalConfigCompress(bool& value);
 
     /* logs config */
     Status
@@ -430,6 +861,12 @@ class Config {
     GetLogsMaxLogFileSize(int64_t& value);
     Status
     GetLogsLogRotateNum(int64_t& value);
+    Status
+    GetLogsAsyncEnable(bool& value);
+    Status
+    GetLogsAsyncBufferSize(int64_t& value);
+    Status
+    GetLogsAsyncRateLimit(int64_t& value);
 
     Status
     GetServerRestartRequired(bool& required);
@@ -440,12 +877,20 @@ class Config {
     SetClusterConfigEnable(const std::string& value);
     Status
     SetClusterConfigRole(const std::string& value);
+    Status
+    SetClusterConfigReplicaRefreshInterval(const std::string& value);
+    Status
+    SetClusterConfigShards(const std::string& value);
+    Status
+    SetClusterConfigHedgeDelay(const std::string& value);
 
     /* general config */
     Status
     SetGeneralConfigTimezone(const std::string& value);
     Status
     SetGeneralConfigMetaURI(const std::string& value);
+    Status
+    SetGeneralConfigMetaCacheTTL(const std::string& value);
 
     /* network config */
     Status
@@ -456,6 +901,18 @@ class Config {
     SetNetworkConfigHTTPEnable(const std::string& value);
     Status
     SetNetworkConfigHTTPPort(const std::string& value);
+    Status
+    SetNetworkConfigHTTPAsync(const std::string& value);
+    Status
+    SetNetworkConfigHTTPIOThreads(const std::string& value);
+    Status
+    SetNetworkConfigHTTPWorkerThreads(const std::string& value);
+    Status
+    SetNetworkConfigGrpcAsync(const std::string& value);
+    Status
+    SetNetworkConfigGrpcCapturePath(const std::string& value);
+    Status
+    SetNetworkConfigGrpcCaptureSize(const std::string& value);
 
     /* db config */
     Status
@@ -469,6 +926,36 @@ class Config {
     Status
     SetStorageConfigAutoFlushInterval(const std::string& value);
     Status
+    SetStorageConfigRawVectorMmap(const std::string& value);
+    Status
+    SetStorageConfigRawDataCompress(const std::string& value);
+    Status
+    SetStorageConfigBlockedBloomFilter(const std::string& value);
+    Status
+    SetStorageConfigMergeStrategy(const std::string& value);
+    Status
+    SetStorageConfigMergeWriteAmplification(const std::string& value);
+    Status
+    SetStorageConfigMergeBytesLimit(const std::string& value);
+    Status
+    SetStorageConfigCompactThreshold(const std::string& value);
+    Status
+    SetStorageConfigCompactBytesLimit(const std::string& value);
+    Status
+    SetStorageConfigReadCoalesceGap(const std::string& value);
+    Status
+    SetStorageConfigColdPath(const std::string& value);
+    Status
+    SetStorageConfigHotCapacity(const std::string& value);
+    Status
+    SetStorageConfigGCThreadNum(const std::string& value);
+    Status
+    SetStorageConfigGCUnlinkRate(const std::string& value);
+    Status
+    SetStorageConfigBackgroundIORate(const std::string& value);
+    Status
+    SetStorageConfigIOLatencyTarget(const std::string& value);
+    Status
     SetStorageConfigFileCleanupTimeout(const std::string& value);
 
     /* metric config */
@@ -478,6 +965,12 @@ class Config {
     SetMetricConfigAddress(const std::string& value);
     Status
     SetMetricConfigPort(const std::string& value);
+    Status
+    SetMetricConfigProfilingInterval(const std::string& value);
+    Status
+    SetMetricConfigProfilingDuration(const std::string& value);
+    Status
+    SetMetricConfigRecallSampleRate(const std::string& value);
 
     /* cache config */
     Status
@@ -485,11 +978,31 @@ class Config {
     Status
     SetCacheConfigCpuCacheThreshold(const std::string& value);
     Status
+    SetCacheConfigCpuCacheShardNum(const std::string& value);
+    Status
+    SetCacheConfigCpuCachePolicy(const std::string& value);
+    Status
+    SetCacheConfigReclaimQueueSize(const std::string& value);
+    Status
+    SetCacheConfigResultCacheCapacity(const std::string& value);
+    Status
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
+    SetCacheConfigInsertBufferTarget(const std::string& value);
+    Status
     SetCacheConfigCacheInsertData(const std::string& value);
     Status
     SetCacheConfigPreloadCollection(const std::string& value);
+    Status
+    SetCacheConfigMemoryLimit(const std::string& value);
+    Status
+    SetCacheConfigPreloadThreadNum(const std::string& value);
+    Status
+    SetCacheConfigPreloadBandwidth(const std::string& value);
+    Status
+    SetCacheConfigWarmUpSize(const std::string& value);
+    Status
+    SetCacheConfigWriteThroughIndex(const std::string& value);
 
     /* engine config */
     Status
@@ -500,6 +1013,38 @@ class Config {
     SetEngineConfigSimdType(const std::string& value);
     Status
     SetEngineSearchCombineMaxNq(const std::string& value);
+    Status
+    SetEngineSearchCombineWaitUs(const std::string& value);
+    Status
+    SetEngineConfigParallelReduce(const std::string& value);
+    Status
+    SetEngineConfigExecutorThreads(const std::string& value);
+    Status
+    SetEngineConfigPrefetchDepth(const std::string& value);
+    Status
+    SetEngineConfigSearchWorkers(const std::string& value);
+    Status
+    SetEngineConfigInsertWorkers(const std::string& value);
+    Status
+    SetEngineConfigDdlWorkers(const std::string& value);
+    Status
+    SetEngineConfigMaintenanceWorkers(const std::string& value);
+    Status
+    SetEngineConfigRequestQueueDepth(const std::string& value);
+    Status
+    SetEngineConfigBuildCpuShare(const std::string& value);
+    Status
+    SetEngineConfigSearchLatencySloMs(const std::string& value);
+    Status
+    SetEngineConfigSearchInsertBuffer(const std::string& value);
+    Status
+    SetEngineConfigNumaAware(const std::string& value);
+    Status
+    SetEngineConfigHugePage(const std::string& value);
+    Status
+    SetEngineConfigRawVectorCompression(const std::string& value);
+    Status
+    SetEngineConfigSearchMemoryLimit(const std::string& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -510,6 +1055,18 @@ class Config {
     Status
     SetGpuResourceConfigCacheThreshold(const std::string& value);
     Status
+    SetGpuResourceConfigCachePolicy(const std::string& value);
+    Status
+    SetGpuResourceConfigPrefetchDepth(const std::string& value);
+    Status
+    SetGpuResourceConfigCostPlacement(const std::string& value);
+    Status
+    SetGpuResourceConfigBuildIndexSharded(const std::string& value);
+    Status
+    SetGpuResourceConfigSearchSharded(const std::string& value);
+    Status
+    SetGpuResourceConfigKeepFreshSegments(const std::string& value);
+    Status
     SetGpuResourceConfigGpuSearchThreshold(const std::string& value);
     Status
     SetGpuResourceConfigSearchResources(const std::string& value);
@@ -520,6 +1077,16 @@ class Config {
     /* tracing config */
     Status
     SetTracingConfigJsonConfigPath(const std::string& value);
+    Status
+    SetTracingConfigSearchSampleRate(const std::string& value);
+    Status
+    SetTracingConfigInsertSampleRate(const std::string& value);
+    Status
+    SetTracingConfigDdlSampleRate(const std::string& value);
+    Status
+    SetTracingConfigMaintenanceSampleRate(const std::string& value);
+    Status
+    SetTracingConfigInfoSampleRate(const std::string& value);
 
     /* wal config */
     Status
@@ -530,6 +1097,14 @@ class Config {
     SetWalConfigBufferSize(const std::string& value);
     Status
     SetWalConfigWalPath(const std::string& value);
+    Status
+    SetWalConfigSyncMode(const std::string& value);
+    Status
+    SetWalConfigSyncInterval(const std::string& value);
+    Status
+    SetWalConfigRecoveryThreadNum(const std::string& value);
+    Status
+    SetWalConfigCompress(const std::string& value);
 
     /* logs config */
     Status
@@ -542,6 +1117,12 @@ class Config {
     SetLogsMaxLogFileSize(const std::string& value);
     Status
     SetLogsLogRotateNum(const std::string& value);
+    Status
+    SetLogsAsyncEnable(const std::string& value);
+    Status
+    SetLogsAsyncBufferSize(const std::string& value);
+    Status
+    SetLogsAsyncRateLimit(const std::string& value);
 
  private:
     bool restart_required_ = false;
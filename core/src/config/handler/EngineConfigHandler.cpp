@@ -12,19 +12,50 @@
 #include "config/handler/EngineConfigHandler.h"
 
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace server {
 
+namespace {
+
+const std::vector<std::string>&
+RequestWorkersKeys() {
+    static const std::vector<std::string> keys = {CONFIG_ENGINE_SEARCH_WORKERS, CONFIG_ENGINE_INSERT_WORKERS,
+                                                  CONFIG_ENGINE_DDL_WORKERS, CONFIG_ENGINE_MAINTENANCE_WORKERS};
+    return keys;
+}
+
+Status
+GetRequestWorkers(const std::string& key, int64_t& workers) {
+    auto& config = Config::GetInstance();
+    if (key == CONFIG_ENGINE_SEARCH_WORKERS) {
+        return config.GetEngineConfigSearchWorkers(workers);
+    } else if (key == CONFIG_ENGINE_INSERT_WORKERS) {
+        return config.GetEngineConfigInsertWorkers(workers);
+    } else if (key == CONFIG_ENGINE_DDL_WORKERS) {
+        return config.GetEngineConfigDdlWorkers(workers);
+    }
+    return config.GetEngineConfigMaintenanceWorkers(workers);
+}
+
+}  // namespace
+
 EngineConfigHandler::EngineConfigHandler() {
     auto& config = Config::GetInstance();
     config.GetEngineConfigUseBlasThreshold(use_blas_threshold_);
     config.GetEngineSearchCombineMaxNq(search_combine_nq_);
+    config.GetEngineSearchCombineWaitUs(search_combine_wait_us_);
 }
 
 EngineConfigHandler::~EngineConfigHandler() {
     RemoveUseBlasThresholdListener();
     RemoveSearchCombineMaxNqListener();
+    RemoveSearchCombineWaitUsListener();
+    RemoveOmpThreadNumListener();
+    RemoveBuildCpuShareListener();
+    RemoveRequestWorkersListener();
+    RemoveRequestQueueDepthListener();
 }
 
 //////////////////////////// Listener methods //////////////////////////////////
@@ -72,5 +103,121 @@ EngineConfigHandler::RemoveSearchCombineMaxNqListener() {
     config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ, identity_);
 }
 
+void
+EngineConfigHandler::AddSearchCombineWaitUsListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        auto status = config.GetEngineSearchCombineWaitUs(search_combine_wait_us_);
+        if (status.ok()) {
+            OnSearchCombineWaitUsChanged(search_combine_wait_us_);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US, identity_, lambda);
+}
+
+void
+EngineConfigHandler::RemoveSearchCombineWaitUsListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US, identity_);
+}
+
+void
+EngineConfigHandler::AddOmpThreadNumListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        int64_t thread_num = 0;
+        auto status = config.GetEngineConfigOmpThreadNum(thread_num);
+        if (status.ok()) {
+            OnOmpThreadNumChanged(thread_num);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_OMP_THREAD_NUM, identity_, lambda);
+}
+
+void
+EngineConfigHandler::RemoveOmpThreadNumListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_OMP_THREAD_NUM, identity_);
+}
+
+void
+EngineConfigHandler::AddBuildCpuShareListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        float share = 0.0;
+        auto status = config.GetEngineConfigBuildCpuShare(share);
+        if (status.ok()) {
+            OnBuildCpuShareChanged(share);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_CPU_SHARE, identity_, lambda);
+}
+
+void
+EngineConfigHandler::RemoveBuildCpuShareListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_BUILD_CPU_SHARE, identity_);
+}
+
+void
+EngineConfigHandler::AddRequestWorkersListener() {
+    auto& config = Config::GetInstance();
+    for (auto& key : RequestWorkersKeys()) {
+        ConfigCallBackF lambda = [this, key](const std::string& value) -> Status {
+            int64_t workers = 0;
+            auto status = GetRequestWorkers(key, workers);
+            if (status.ok()) {
+                OnRequestWorkersChanged(key, workers);
+            }
+
+            return status;
+        };
+        config.RegisterCallBack(CONFIG_ENGINE, key, identity_, lambda);
+    }
+}
+
+void
+EngineConfigHandler::RemoveRequestWorkersListener() {
+    auto& config = Config::GetInstance();
+    for (auto& key : RequestWorkersKeys()) {
+        config.CancelCallBack(CONFIG_ENGINE, key, identity_);
+    }
+}
+
+void
+EngineConfigHandler::AddRequestQueueDepthListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        int64_t depth = 0;
+        auto status = config.GetEngineConfigRequestQueueDepth(depth);
+        if (status.ok()) {
+            OnRequestQueueDepthChanged(depth);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_REQUEST_QUEUE_DEPTH, identity_, lambda);
+}
+
+void
+EngineConfigHandler::RemoveRequestQueueDepthListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_REQUEST_QUEUE_DEPTH, identity_);
+}
+
 }  // namespace server
 }  // namespace milvus
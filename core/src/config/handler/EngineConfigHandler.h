@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "config/Config.h"
 #include "config/handler/ConfigHandler.h"
 
@@ -33,6 +35,28 @@ class EngineConfigHandler : virtual public ConfigHandler {
         search_combine_nq_ = nq;
     }
 
+    virtual void
+    OnSearchCombineWaitUsChanged(int64_t wait_us) {
+        search_combine_wait_us_ = wait_us;
+    }
+
+    virtual void
+    OnOmpThreadNumChanged(int64_t thread_num) {
+    }
+
+    virtual void
+    OnBuildCpuShareChanged(float share) {
+    }
+
+    // key is the engine config key of the workers of one request group
+    virtual void
+    OnRequestWorkersChanged(const std::string& key, int64_t workers) {
+    }
+
+    virtual void
+    OnRequestQueueDepthChanged(int64_t depth) {
+    }
+
  protected:
     void
     AddUseBlasThresholdListener();
@@ -46,9 +70,41 @@ class EngineConfigHandler : virtual public ConfigHandler {
     void
     RemoveSearchCombineMaxNqListener();
 
+    void
+    AddSearchCombineWaitUsListener();
+
+    void
+    RemoveSearchCombineWaitUsListener();
+
+    void
+    AddOmpThreadNumListener();
+
+    void
+    RemoveOmpThreadNumListener();
+
+    void
+    AddBuildCpuShareListener();
+
+    void
+    RemoveBuildCpuShareListener();
+
+    // the search, insert, ddl and maintenance workers
+    void
+    AddRequestWorkersListener();
+
+    void
+    RemoveRequestWorkersListener();
+
+    void
+    AddRequestQueueDepthListener();
+
+    void
+    RemoveRequestQueueDepthListener();
+
  protected:
     int64_t use_blas_threshold_ = std::stoll(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT);
     int64_t search_combine_nq_ = std::stoll(CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT);
+    int64_t search_combine_wait_us_ = std::stoll(CONFIG_ENGINE_SEARCH_COMBINE_WAIT_US_DEFAULT);
 };
 
 }  // namespace server
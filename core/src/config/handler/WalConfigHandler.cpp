@@ -0,0 +1,50 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "config/handler/WalConfigHandler.h"
+#include "config/Config.h"
+
+namespace milvus {
+namespace server {
+
+WalConfigHandler::WalConfigHandler() {
+    auto& config = Config::GetInstance();
+    config.GetWalConfigBufferSize(wal_buffer_size_);
+}
+
+WalConfigHandler::~WalConfigHandler() {
+    RemoveWalBufferSizeListener();
+}
+
+//////////////////////////// Listener methods //////////////////////////////////
+void
+WalConfigHandler::AddWalBufferSizeListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = Config::GetInstance();
+        auto status = config.GetWalConfigBufferSize(wal_buffer_size_);
+        if (status.ok()) {
+            OnWalBufferSizeChanged(wal_buffer_size_);
+        }
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_WAL, CONFIG_WAL_BUFFER_SIZE, identity_, lambda);
+}
+
+void
+WalConfigHandler::RemoveWalBufferSizeListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_WAL, CONFIG_WAL_BUFFER_SIZE, identity_);
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,43 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "config/handler/ConfigHandler.h"
+
+namespace milvus {
+namespace server {
+
+class WalConfigHandler : virtual public ConfigHandler {
+ public:
+    WalConfigHandler();
+    virtual ~WalConfigHandler();
+
+ protected:
+    virtual void
+    OnWalBufferSizeChanged(int64_t value) {
+    }
+
+ protected:
+    void
+    AddWalBufferSizeListener();
+
+    void
+    RemoveWalBufferSizeListener();
+
+ private:
+    int64_t wal_buffer_size_ = std::stoll(CONFIG_WAL_BUFFER_SIZE_DEFAULT) /*bytes*/;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/BuildThrottle.h"
+#include "index/knowhere/knowhere/index/vector_index/helpers/BuilderSuspend.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+constexpr size_t COST_SAMPLES = 256;
+constexpr size_t P99_REFRESH = 32;
+
+// the share grows back by this part of build_share each refresh the target is met with room to spare
+constexpr double SHARE_STEP = 0.125;
+constexpr double SLO_HEADROOM = 0.8;
+}  // namespace
+
+BuildThrottle::BuildThrottle(double build_share, int64_t search_slo_ms)
+    : build_share_(std::max(build_share, MIN_BUILD_SHARE)),
+      search_slo_us_(search_slo_ms * 1000),
+      searching_share_(build_share_) {
+    costs_.reserve(COST_SAMPLES);
+}
+
+void
+BuildThrottle::SearchBegin() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (++live_search_num_ == 1) {
+        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_;
+        ApplyShare();
+    }
+}
+
+void
+BuildThrottle::SearchEnd(int64_t cost_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (search_slo_us_ > 0) {
+        if (costs_.size() < COST_SAMPLES) {
+            costs_.push_back(cost_us);
+        } else {
+            costs_[cost_index_] = cost_us;
+        }
+        cost_index_ = (cost_index_ + 1) % COST_SAMPLES;
+
+        if (cost_index_ % P99_REFRESH == 0) {
+            std::vector<int64_t> costs = costs_;
+            auto p99 = costs.begin() + (costs.size() * 99) / 100;
+            std::nth_element(costs.begin(), p99, costs.end());
+
+            double share = searching_share_;
+            if (*p99 > search_slo_us_) {
+                share = std::max(share / 2, MIN_BUILD_SHARE);
+            } else if (*p99 < search_slo_us_ * SLO_HEADROOM) {
+                share = std::min(share + build_share_ * SHARE_STEP, build_share_);
+            }
+            if (share != searching_share_) {
+                LOG_ENGINE_DEBUG_ << "Search p99 " << *p99 << "us against target " << search_slo_us_
+                                  << "us, index build cpu share " << searching_share_ << " -> " << share;
+                searching_share_ = share;
+            }
+        }
+    }
+
+    if (--live_search_num_ == 0) {
+        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_;
+    }
+    ApplyShare();
+}
+
+void
+BuildThrottle::SetBuildShare(double build_share) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    build_share_ = std::max(build_share, MIN_BUILD_SHARE);
+    searching_share_ = std::min(searching_share_, build_share_);
+    if (search_slo_us_ <= 0) {
+        searching_share_ = build_share_;
+    }
+    ApplyShare();
+}
+
+double
+BuildThrottle::SearchingShare() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return searching_share_;
+}
+
+void
+BuildThrottle::ApplyShare() {
+    knowhere::BuilderSetShare(live_search_num_ > 0 ? searching_share_ : 1.0);
+}
+
+}  // namespace engine
+}  // namespace milvus
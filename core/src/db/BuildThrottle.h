@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * The share of the cpu time the index builds keep while searches are running. The builds run unthrottled
+ * when no search is live, and at build_share otherwise. With a search latency target, the share is halved
+ * whenever the p99 of the searches misses it and grows back while it is met, but never drops under
+ * MIN_BUILD_SHARE, so the builds always progress and the unindexed segments don't pile up under steady search.
+ */
+class BuildThrottle {
+ public:
+    static constexpr double MIN_BUILD_SHARE = 0.05;
+
+    // search_slo_ms of 0 keeps the share at build_share
+    BuildThrottle(double build_share, int64_t search_slo_ms);
+
+    void
+    SearchBegin();
+
+    void
+    SearchEnd(int64_t cost_us);
+
+    // the share the builds get back once searches meet the latency target
+    void
+    SetBuildShare(double build_share);
+
+    // share the builds get while searches are running
+    double
+    SearchingShare();
+
+ private:
+    void
+    ApplyShare();
+
+ private:
+    double build_share_;
+    int64_t search_slo_us_;
+
+    std::mutex mutex_;
+    int64_t live_search_num_ = 0;
+    double searching_share_;
+
+    std::vector<int64_t> costs_;
+    size_t cost_index_ = 0;
+};
+
+using BuildThrottlePtr = std::shared_ptr<BuildThrottle>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,397 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/CollectionBackup.h"
+
+#include <algorithm>
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <cctype>
+#include <future>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include "db/Utils.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskOperation.h"
+#include "utils/Exception.h"
+#include "utils/Json.h"
+#include "utils/Log.h"
+#include "utils/ThreadPool.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr int64_t MANIFEST_VERSION = 1;
+constexpr char SQ8_EXTENSION[] = ".sq8";
+
+storage::FSHandlerPtr
+DiskFSHandler(const std::string& directory) {
+    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
+    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(directory);
+    return std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+}
+
+// index files are named by the file id, the compressed vectors of SQ8H by the file id with .sq8
+std::string
+IndexFileId(const std::string& name) {
+    auto pos = name.find('.');
+    auto stem = name.substr(0, pos);
+    if (pos != std::string::npos && name.substr(pos) != SQ8_EXTENSION) {
+        return "";
+    }
+    if (stem.empty() || !std::all_of(stem.begin(), stem.end(), [](char c) { return std::isdigit(c); })) {
+        return "";
+    }
+    return stem;
+}
+
+// the thread count of the copies, files being copied by a thread each
+size_t
+CopyThreads(size_t tasks) {
+    return std::min<size_t>({tasks, std::max(1u, std::thread::hardware_concurrency()), (size_t)MAX_THREADS_NUM});
+}
+
+}  // namespace
+
+CollectionBackup::CollectionBackup(const meta::MetaPtr& meta_ptr, const DBOptions& options)
+    : meta_ptr_(meta_ptr), options_(options) {
+}
+
+Status
+CollectionBackup::CopyFile(const storage::FSHandlerPtr& from, const std::string& from_path,
+                           const storage::FSHandlerPtr& to, const std::string& to_path, int64_t& size,
+                           uint32_t& crc) {
+    if (!from->reader_ptr_->open(from_path)) {
+        return Status(DB_ERROR, "Cannot open file: " + from_path);
+    }
+    if (!to->writer_ptr_->open(to_path)) {
+        from->reader_ptr_->close();
+        return Status(DB_ERROR, "Cannot create file: " + to_path);
+    }
+
+    size = from->reader_ptr_->length();
+    std::vector<uint8_t> buffer(std::max<int64_t>(1, std::min(size, COPY_BUFFER_SIZE)));
+    boost::crc_32_type checksum;
+    for (int64_t pos = 0; pos < size; pos += buffer.size()) {
+        auto chunk = std::min<int64_t>(buffer.size(), size - pos);
+        from->reader_ptr_->read(buffer.data(), chunk);
+        checksum.process_bytes(buffer.data(), chunk);
+        to->writer_ptr_->write(buffer.data(), chunk);
+    }
+    from->reader_ptr_->close();
+    to->writer_ptr_->close();
+
+    crc = checksum.checksum();
+    return Status::OK();
+}
+
+Status
+CollectionBackup::Export(const std::string& collection_id, const std::string& target_dir) {
+    TimeRecorderAuto rc("CollectionBackup::Export " + collection_id);
+
+    Manifest manifest;
+    manifest.collection_.collection_id_ = collection_id;
+    auto status = meta_ptr_->DescribeCollection(manifest.collection_);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::CollectionSchema> partitions;
+    status = meta_ptr_->ShowPartitions(collection_id, partitions);
+    if (!status.ok()) {
+        return status;
+    }
+    std::map<std::string, std::string> tags = {{collection_id, ""}};
+    for (auto& partition : partitions) {
+        tags[partition.collection_id_] = partition.partition_tag_;
+        manifest.partition_tags_.push_back(partition.partition_tag_);
+    }
+
+    // held until the copies are done, the files can't be merged away or cleaned up meanwhile
+    std::vector<int> file_types = {
+        meta::SegmentSchema::RAW,
+        meta::SegmentSchema::TO_INDEX,
+        meta::SegmentSchema::INDEX,
+    };
+    meta::FilesHolder files_holder;
+    for (auto& tag : tags) {
+        status = meta_ptr_->FilesByType(tag.first, file_types, files_holder);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    for (auto& desc : files_holder.HoldDescs()) {
+        Segment segment;
+        segment.partition_tag_ = tags[desc->collection_id_];
+        segment.file_ = *desc;
+        manifest.segments_.emplace_back(segment);
+    }
+
+    try {
+        storage::DiskOperation(target_dir).CreateDirectory();
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, ex.what());
+    }
+
+    std::vector<std::future<Status>> futures;
+    {
+        ThreadPool pool(CopyThreads(manifest.segments_.size()), manifest.segments_.size() + 1);
+        for (auto& segment : manifest.segments_) {
+            futures.push_back(
+                pool.enqueue(&CollectionBackup::ExportSegment, this, std::cref(target_dir), std::ref(segment)));
+        }
+        for (auto& future : futures) {
+            auto segment_status = future.get();
+            if (status.ok() && !segment_status.ok()) {
+                status = segment_status;
+            }
+        }
+    }
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Export of " << collection_id << " failed: " << status.message();
+        return status;
+    }
+
+    milvus::json json;
+    json["version"] = MANIFEST_VERSION;
+    json["collection"] = {
+        {"dimension", manifest.collection_.dimension_},
+        {"index_file_size", manifest.collection_.index_file_size_},
+        {"engine_type", manifest.collection_.engine_type_},
+        {"index_params", manifest.collection_.index_params_},
+        {"metric_type", manifest.collection_.metric_type_},
+    };
+    json["partitions"] = manifest.partition_tags_;
+    json["segments"] = milvus::json::array();
+    for (auto& segment : manifest.segments_) {
+        milvus::json segment_json;
+        segment_json["partition_tag"] = segment.partition_tag_;
+        segment_json["file_id"] = segment.file_.file_id_;
+        segment_json["file_type"] = segment.file_.file_type_;
+        segment_json["row_count"] = segment.file_.row_count_;
+        segment_json["file_size"] = segment.file_.file_size_;
+        segment_json["engine_type"] = segment.file_.engine_type_;
+        segment_json["index_params"] = segment.file_.index_params_;
+        segment_json["date"] = segment.file_.date_;
+        segment_json["files"] = milvus::json::array();
+        for (auto& entry : segment.entries_) {
+            segment_json["files"].push_back(
+                {{"name", entry.name_}, {"path", entry.path_}, {"size", entry.size_}, {"crc", entry.crc_}});
+        }
+        json["segments"].push_back(segment_json);
+    }
+
+    auto manifest_str = json.dump(4);
+    auto fs_ptr = DiskFSHandler(target_dir);
+    if (!fs_ptr->writer_ptr_->open(target_dir + "/" + MANIFEST_NAME)) {
+        return Status(DB_ERROR, "Cannot create the manifest in " + target_dir);
+    }
+    fs_ptr->writer_ptr_->write(manifest_str.data(), manifest_str.size());
+    fs_ptr->writer_ptr_->close();
+
+    LOG_ENGINE_DEBUG_ << "Exported " << manifest.segments_.size() << " segments of " << collection_id << " to "
+                      << target_dir;
+    return Status::OK();
+}
+
+Status
+CollectionBackup::ExportSegment(const std::string& target_dir, Segment& segment) {
+    std::string segment_dir;
+    utils::GetParentPath(segment.file_.location_, segment_dir);
+    auto from = DiskFSHandler(segment_dir);
+    auto to = DiskFSHandler(target_dir);
+
+    std::vector<std::string> file_paths;
+    from->operation_ptr_->ListDirectory(file_paths);
+    for (auto& file_path : file_paths) {
+        FileEntry entry;
+        entry.name_ = boost::filesystem::path(file_path).filename().string();
+
+        // the index files of the other collection files of the segment, left over by an index build, are skipped
+        auto index_file_id = IndexFileId(entry.name_);
+        if (!index_file_id.empty() && index_file_id != segment.file_.file_id_) {
+            continue;
+        }
+
+        entry.path_ = segment.file_.file_id_ + "_" + entry.name_;
+        auto status = CopyFile(from, file_path, to, target_dir + "/" + entry.path_, entry.size_, entry.crc_);
+        if (!status.ok()) {
+            return status;
+        }
+        segment.entries_.emplace_back(entry);
+    }
+
+    return Status::OK();
+}
+
+Status
+CollectionBackup::ReadManifest(const std::string& source_dir, Manifest& manifest) {
+    auto fs_ptr = DiskFSHandler(source_dir);
+    auto manifest_path = source_dir + "/" + MANIFEST_NAME;
+    if (!fs_ptr->reader_ptr_->open(manifest_path)) {
+        return Status(DB_ERROR, "No manifest in " + source_dir + ", not an export or an unfinished one");
+    }
+    std::string manifest_str(fs_ptr->reader_ptr_->length(), '\0');
+    fs_ptr->reader_ptr_->read(&manifest_str[0], manifest_str.size());
+    fs_ptr->reader_ptr_->close();
+
+    try {
+        auto json = milvus::json::parse(manifest_str);
+        if (json.at("version").get<int64_t>() != MANIFEST_VERSION) {
+            return Status(DB_ERROR, "Unsupported manifest version in " + source_dir);
+        }
+
+        auto& collection = json.at("collection");
+        manifest.collection_.dimension_ = collection.at("dimension").get<uint16_t>();
+        manifest.collection_.index_file_size_ = collection.at("index_file_size").get<int64_t>();
+        manifest.collection_.engine_type_ = collection.at("engine_type").get<int32_t>();
+        manifest.collection_.index_params_ = collection.at("index_params").get<std::string>();
+        manifest.collection_.metric_type_ = collection.at("metric_type").get<int32_t>();
+        manifest.partition_tags_ = json.at("partitions").get<std::vector<std::string>>();
+
+        manifest.segments_.clear();
+        for (auto& segment_json : json.at("segments")) {
+            Segment segment;
+            segment.partition_tag_ = segment_json.at("partition_tag").get<std::string>();
+            segment.file_.file_id_ = segment_json.at("file_id").get<std::string>();
+            segment.file_.file_type_ = segment_json.at("file_type").get<int32_t>();
+            segment.file_.row_count_ = segment_json.at("row_count").get<uint64_t>();
+            segment.file_.file_size_ = segment_json.at("file_size").get<uint64_t>();
+            segment.file_.engine_type_ = segment_json.at("engine_type").get<int32_t>();
+            segment.file_.index_params_ = segment_json.at("index_params").get<std::string>();
+            segment.file_.date_ = segment_json.at("date").get<meta::DateT>();
+            for (auto& file_json : segment_json.at("files")) {
+                FileEntry entry;
+                entry.name_ = file_json.at("name").get<std::string>();
+                entry.path_ = file_json.at("path").get<std::string>();
+                entry.size_ = file_json.at("size").get<int64_t>();
+                entry.crc_ = file_json.at("crc").get<uint32_t>();
+                segment.entries_.emplace_back(entry);
+            }
+            manifest.segments_.emplace_back(segment);
+        }
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, "Invalid manifest in " + source_dir + ": " + ex.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+CollectionBackup::Import(const std::string& source_dir, const Manifest& manifest, const std::string& collection_id) {
+    TimeRecorderAuto rc("CollectionBackup::Import " + collection_id);
+
+    std::map<std::string, std::string> partition_names = {{"", collection_id}};
+    for (auto& tag : manifest.partition_tags_) {
+        auto status = meta_ptr_->GetPartitionName(collection_id, tag, partition_names[tag]);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    std::vector<meta::SegmentSchema> files(manifest.segments_.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto iter = partition_names.find(manifest.segments_[i].partition_tag_);
+        if (iter == partition_names.end()) {
+            return Status(DB_ERROR, "Unknown partition tag " + manifest.segments_[i].partition_tag_ + " in manifest");
+        }
+        files[i].collection_id_ = iter->second;
+    }
+
+    Status status;
+    std::vector<std::future<Status>> futures;
+    {
+        ThreadPool pool(CopyThreads(files.size()), files.size() + 1);
+        for (size_t i = 0; i < files.size(); ++i) {
+            futures.push_back(pool.enqueue(&CollectionBackup::ImportSegment, this, std::cref(source_dir),
+                                           std::cref(manifest.segments_[i]), std::ref(files[i])));
+        }
+        for (auto& future : futures) {
+            auto segment_status = future.get();
+            if (status.ok() && !segment_status.ok()) {
+                status = segment_status;
+            }
+        }
+    }
+
+    // the segments are registered together, or dropped together
+    meta::SegmentsSchema updated;
+    for (auto& file : files) {
+        if (file.id_ == 0) {
+            continue;
+        }
+        if (!status.ok()) {
+            file.file_type_ = meta::SegmentSchema::TO_DELETE;
+        }
+        updated.push_back(file);
+    }
+    auto update_status = meta_ptr_->UpdateCollectionFiles(updated);
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Import of " << collection_id << " failed: " << status.message();
+        return status;
+    }
+    if (!update_status.ok()) {
+        return update_status;
+    }
+
+    LOG_ENGINE_DEBUG_ << "Imported " << updated.size() << " segments to " << collection_id << " from " << source_dir;
+    return Status::OK();
+}
+
+Status
+CollectionBackup::ImportSegment(const std::string& source_dir, const Segment& segment, meta::SegmentSchema& file) {
+    file.file_type_ = meta::SegmentSchema::NEW;
+    file.date_ = segment.file_.date_;
+    auto status = meta_ptr_->CreateCollectionFile(file);
+    if (!status.ok()) {
+        file.id_ = 0;
+        return status;
+    }
+
+    std::string segment_dir;
+    utils::GetParentPath(file.location_, segment_dir);
+    auto from = DiskFSHandler(source_dir);
+    auto to = DiskFSHandler(segment_dir);
+    for (auto& entry : segment.entries_) {
+        // the index files take the id of the new collection file, the location the engine loads them from
+        auto name = entry.name_;
+        if (IndexFileId(name) == segment.file_.file_id_) {
+            name = file.file_id_ + name.substr(segment.file_.file_id_.size());
+        }
+
+        int64_t size = 0;
+        uint32_t crc = 0;
+        status = CopyFile(from, source_dir + "/" + entry.path_, to, segment_dir + "/" + name, size, crc);
+        if (!status.ok()) {
+            return status;
+        }
+        if (size != entry.size_ || crc != entry.crc_) {
+            return Status(DB_ERROR, "Checksum mismatch of " + source_dir + "/" + entry.path_);
+        }
+    }
+
+    file.file_type_ = segment.file_.file_type_;
+    file.row_count_ = segment.file_.row_count_;
+    file.file_size_ = segment.file_.file_size_;
+    file.engine_type_ = segment.file_.engine_type_;
+    file.index_params_ = segment.file_.index_params_;
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,90 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "db/Options.h"
+#include "db/meta/Meta.h"
+#include "db/meta/MetaTypes.h"
+#include "storage/FSHandler.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Backup of a collection as the files of its segments. The export holds the RAW, TO_INDEX and INDEX files of the
+ * collection and its partitions, so that neither a merge nor the cleanup removes them, and copies their segment
+ * directories, raw vectors, uids, deleted docs, bloom filter and index, to a flat target directory with a pool of
+ * threads. The MANIFEST, the schema of the collection, the partition tags and the segments with the size and crc32 of
+ * each of their files, is written last: a directory without it is an unfinished export.
+ * The import copies the files back to new segments, checking their size and crc, and registers them in a single meta
+ * update as they were exported, nothing is rebuilt.
+ */
+class CollectionBackup {
+ public:
+    static constexpr const char* MANIFEST_NAME = "MANIFEST";
+    static constexpr int64_t COPY_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    struct FileEntry {
+        std::string name_;  // in the segment directory
+        std::string path_;  // in the backup directory
+        int64_t size_ = 0;
+        uint32_t crc_ = 0;
+    };
+
+    struct Segment {
+        std::string partition_tag_;
+        meta::SegmentSchema file_;
+        std::vector<FileEntry> entries_;
+    };
+
+    struct Manifest {
+        meta::CollectionSchema collection_;
+        std::vector<std::string> partition_tags_;
+        std::vector<Segment> segments_;
+    };
+
+    CollectionBackup(const meta::MetaPtr& meta_ptr, const DBOptions& options);
+
+    Status
+    Export(const std::string& collection_id, const std::string& target_dir);
+
+    static Status
+    ReadManifest(const std::string& source_dir, Manifest& manifest);
+
+    // the collection and the partitions of the manifest must exist, empty
+    Status
+    Import(const std::string& source_dir, const Manifest& manifest, const std::string& collection_id);
+
+    // copies a file between two file systems in chunks, size and crc of the bytes copied
+    static Status
+    CopyFile(const storage::FSHandlerPtr& from, const std::string& from_path, const storage::FSHandlerPtr& to,
+             const std::string& to_path, int64_t& size, uint32_t& crc);
+
+ private:
+    Status
+    ExportSegment(const std::string& target_dir, Segment& segment);
+
+    Status
+    ImportSegment(const std::string& source_dir, const Segment& segment, meta::SegmentSchema& file);
+
+ private:
+    meta::MetaPtr meta_ptr_;
+    DBOptions options_;
+};
+
+}  // namespace engine
+}  // namespace milvus
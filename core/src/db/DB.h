@@ -72,6 +72,14 @@ class DB {
     PreloadCollection(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                       bool force = false) = 0;
 
+    // preload the collections at startup, the files searched before the last shutdown are loaded before it
+    // returns and the others in background
+    virtual Status
+    WarmUp(const std::vector<std::string>& collection_ids) = 0;
+
+    virtual Status
+    GetWarmUpProgress(WarmUpProgress& progress) = 0;
+
     virtual Status
     ReLoadSegmentsDeletedDocs(const std::string& collection_id, const std::vector<int64_t>& segment_ids) = 0;
 
@@ -97,6 +105,21 @@ class DB {
     virtual Status
     InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData& vectors) = 0;
 
+    // import the vectors of .npy files as segments of their own, bypassing the wal and the insert buffer,
+    // build_index waits for the index of the imported segments to be built
+    virtual Status
+    BulkImport(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+               const std::string& partition_tag, const std::vector<std::string>& file_paths, IDNumbers& ids,
+               bool build_index) = 0;
+
+    // copy the segment files of a collection and its partitions, with a manifest of their checksums, to target_dir
+    virtual Status
+    ExportCollection(const std::string& collection_id, const std::string& target_dir) = 0;
+
+    // create a collection from an export, registering its segment files as they are
+    virtual Status
+    ImportCollection(const std::string& collection_id, const std::string& source_dir) = 0;
+
     virtual Status
     DeleteVector(const std::string& collection_id, IDNumber vector_id) = 0;
 
@@ -109,6 +132,10 @@ class DB {
     virtual Status
     Flush() = 0;
 
+    // wait until the wal records of the finished inserts and deletes are synced, see wal.sync_mode
+    virtual Status
+    SyncWal() = 0;
+
     virtual Status
     Compact(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
             double threshold = 0.0) = 0;
@@ -137,6 +164,14 @@ class DB {
           const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
           VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) = 0;
 
+    // search the root collections and all their partitions as one job, the metric and dimension of the collections
+    // must match. result_ids[i] and result_distances[i] hold the top k of collection_ids[i], k per query padded
+    // with -1
+    virtual Status
+    QueryCollections(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& collection_ids,
+                     uint64_t k, const milvus::json& extra_params, VectorsData& vectors,
+                     std::vector<ResultIds>& result_ids, std::vector<ResultDistances>& result_distances) = 0;
+
     virtual Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids, uint64_t k,
                   const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
@@ -155,6 +190,12 @@ class DB {
     virtual Status
     DropIndex(const std::string& collection_id) = 0;
 
+    // measures candidate indexes on a sample of the collection, see IndexTuner, with apply the recommended one is
+    // created
+    virtual Status
+    TuneIndex(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+              const milvus::json& tune_params, milvus::json& report) = 0;
+
     virtual Status
     DropAll() = 0;
 
@@ -14,12 +14,15 @@
 #include <assert.h>
 #include <fiu-local.h>
 
-#include <knowhere/index/structured_index/StructuredIndexSort.h>
+#include <knowhere/index/structured_index/StructuredIndexFactory.h>
 #include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <mutex>
@@ -27,34 +30,48 @@
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "Utils.h"
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
 #include "config/Utils.h"
+#include "db/CollectionBackup.h"
 #include "db/IDGenerator.h"
+#include "db/IndexBuildTracker.h"
+#include "db/SegmentAccessLog.h"
+#include "db/merge/CompactTask.h"
 #include "db/merge/MergeManagerFactory.h"
 #include "engine/EngineFactory.h"
-#include "index/knowhere/knowhere/index/vector_index/helpers/BuilderSuspend.h"
+#include "engine/IndexTuner.h"
 #include "index/thirdparty/faiss/utils/distances.h"
+#include "insert/BulkImportTask.h"
 #include "insert/MemManagerFactory.h"
+#include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
 #include "meta/MetaConsts.h"
 #include "meta/MetaFactory.h"
 #include "meta/SqliteMetaImpl.h"
 #include "metrics/Metrics.h"
+#include "query/BinaryQuery.h"
 #include "scheduler/Definition.h"
+#include "scheduler/NumaTopology.h"
+#include "scheduler/ParallelismGovernor.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "segment/AttrZoneMap.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
+#include "utils/StartupStages.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
 #include "wal/WalDefinations.h"
+#include "wal/WalReplayer.h"
 
 #include "search/TaskInst.h"
 
@@ -65,6 +82,11 @@ namespace {
 constexpr uint64_t BACKGROUND_METRIC_INTERVAL = 1;
 constexpr uint64_t BACKGROUND_INDEX_INTERVAL = 1;
 constexpr uint64_t WAIT_BUILD_INDEX_INTERVAL = 5;
+constexpr uint64_t WAIT_INSERT_BUFFER_INTERVAL_MS = 10;
+constexpr uint64_t WAIT_INSERT_BUFFER_TIMEOUT_MS = 1000;
+// bounds of the retry after hint of an insert into a full buffer
+constexpr int64_t INSERT_RETRY_AFTER_MIN_MS = 100;
+constexpr int64_t INSERT_RETRY_AFTER_MAX_MS = 10000;
 
 constexpr const char* JSON_ROW_COUNT = "row_count";
 constexpr const char* JSON_PARTITIONS = "partitions";
@@ -73,14 +95,147 @@ constexpr const char* JSON_SEGMENTS = "segments";
 constexpr const char* JSON_SEGMENT_NAME = "name";
 constexpr const char* JSON_INDEX_NAME = "index_name";
 constexpr const char* JSON_DATA_SIZE = "data_size";
+constexpr const char* JSON_INDEX_BUILD = "index_build";
+constexpr const char* JSON_INDEX_BUILD_STAGE = "stage";
+constexpr const char* JSON_INDEX_BUILD_ROWS_INDEXED = "rows_indexed";
+constexpr const char* JSON_INDEX_BUILD_BYTES_WRITTEN = "bytes_written";
+constexpr const char* JSON_INDEX_BUILD_ELAPSED_MS = "elapsed_ms";
+constexpr const char* JSON_INDEX_BUILD_STAGE_ELAPSED_MS = "stage_elapsed_ms";
+
+constexpr size_t COMPACT_THREAD_NUM = 4;
+constexpr uint64_t COMPACT_IO_BUDGET = 2UL * 1024 * 1024 * 1024;  // bytes of the segments compacted at once
+
+constexpr const char* SEGMENT_ACCESS_LOG = "segment_access_log";
+constexpr uint64_t ACCESS_LOG_SAVE_INTERVAL = 60;
+constexpr int64_t TIER_PIN_US = 3600LL * 1000 * 1000;  // segments created since are kept in the hot tier
+constexpr int64_t EXPIRE_INTERVAL = 60;                 // seconds between the passes dropping the expired segments
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+// engine to load a file searched by a search, the raw files are searched by brute force
+ExecutionEnginePtr
+BuildPreloadEngine(const meta::SegmentSchema& file) {
+    EngineType engine_type;
+    if (file.file_type_ == meta::SegmentSchema::FILE_TYPE::RAW ||
+        file.file_type_ == meta::SegmentSchema::FILE_TYPE::TO_INDEX ||
+        file.file_type_ == meta::SegmentSchema::FILE_TYPE::BACKUP) {
+        engine_type =
+            utils::IsBinaryMetricType(file.metric_type_) ? EngineType::FAISS_BIN_IDMAP : EngineType::FAISS_IDMAP;
+    } else {
+        engine_type = (EngineType)file.engine_type_;
+    }
+
+    auto json = milvus::json::parse(file.index_params_);
+    return EngineFactory::Build(file.dimension_, file.location_, engine_type, (MetricType)file.metric_type_, json);
+}
+
+// put the files searched last first, the files never searched keep their order after them,
+// return the number of files searched
+size_t
+OrderByAccess(meta::SegmentsSchema& files) {
+    auto& access_log = SegmentAccessLog::GetInstance();
+    std::vector<std::pair<uint64_t, size_t>> ranks;  // rank and index of each file
+    ranks.reserve(files.size());
+    size_t searched_num = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto rank = access_log.Rank(files[i].location_);
+        ranks.emplace_back(rank, i);
+        searched_num += (rank > 0) ? 1 : 0;
+    }
+    std::stable_sort(ranks.begin(), ranks.end(),
+                     [](const std::pair<uint64_t, size_t>& a, const std::pair<uint64_t, size_t>& b) {
+                         return a.first > b.first;
+                     });
+
+    meta::SegmentsSchema ordered;
+    ordered.reserve(files.size());
+    for (auto& rank : ranks) {
+        ordered.emplace_back(std::move(files[rank.second]));
+    }
+    files.swap(ordered);
+    return searched_num;
+}
+
+// bytes of a value of the attribute type, 0 for a type without a fixed width
+size_t
+AttrWidth(meta::hybrid::DataType data_type) {
+    switch (data_type) {
+        case meta::hybrid::DataType::INT8:
+            return sizeof(int8_t);
+        case meta::hybrid::DataType::INT16:
+            return sizeof(int16_t);
+        case meta::hybrid::DataType::INT32:
+            return sizeof(int32_t);
+        case meta::hybrid::DataType::INT64:
+            return sizeof(int64_t);
+        case meta::hybrid::DataType::FLOAT:
+            return sizeof(float);
+        case meta::hybrid::DataType::DOUBLE:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+
+bool
+IsVectorType(meta::hybrid::DataType data_type) {
+    return data_type == meta::hybrid::DataType::VECTOR || data_type == meta::hybrid::DataType::VECTOR_FLOAT ||
+           data_type == meta::hybrid::DataType::VECTOR_BINARY;
+}
+
+// Finds ids in a segment by its id index, a segment written without one falls back to scanning its uids
+class SegmentIdLocator {
+ public:
+    explicit SegmentIdLocator(segment::SegmentReader& segment_reader) : segment_reader_(segment_reader) {
+    }
+
+    // offset is -1 if the id is not in the segment
+    Status
+    Find(int64_t id, int64_t& offset) {
+        if (!loaded_) {
+            auto status = segment_reader_.LoadIdIndex(id_index_ptr_);
+            if (status.ok() && id_index_ptr_ == nullptr) {
+                status = segment_reader_.LoadUids(uids_);
+            }
+            if (!status.ok()) {
+                return status;
+            }
+            loaded_ = true;
+        }
+
+        offset = -1;
+        if (id_index_ptr_ != nullptr) {
+            id_index_ptr_->Find(id, offset);
+        } else {
+            auto found = std::find(uids_.begin(), uids_.end(), id);
+            if (found != uids_.end()) {
+                offset = std::distance(uids_.begin(), found);
+            }
+        }
+        return Status::OK();
+    }
+
+ private:
+    segment::SegmentReader& segment_reader_;
+    bool loaded_ = false;
+    segment::IdIndexPtr id_index_ptr_;
+    std::vector<segment::doc_id_t> uids_;
+};
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
-    : options_(options), initialized_(false), merge_thread_pool_(1, 1), index_thread_pool_(1, 1) {
-    meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
+    : options_(options),
+      initialized_(false),
+      merge_thread_pool_(1, "merge"),
+      index_thread_pool_(1, "build_index"),
+      preload_thread_pool_(options.preload_thread_num_, 1000, "preload"),
+      preload_limiter_(options.preload_bandwidth_) {
+    {
+        // schema checks and cleanup of the files an interrupted flush, merge or build left
+        StartupStageGuard stage("meta_init");
+        meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
+    }
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
     merge_mgr_ptr_ = MergeManagerFactory::Build(meta_ptr_, options_);
 
@@ -90,12 +245,52 @@ DBImpl::DBImpl(const DBOptions& options)
         // 2 buffers in the WAL
         mxlog_config.buffer_size = options_.buffer_size_ / 2;
         mxlog_config.mxlog_path = options_.mxlog_path_;
+        mxlog_config.sync_mode = wal::WalManager::ParseSyncMode(options_.wal_sync_mode_);
+        mxlog_config.sync_interval = options_.wal_sync_interval_;
+        mxlog_config.compress = options_.wal_compress_;
         wal_mgr_ = std::make_shared<wal::WalManager>(mxlog_config);
     }
 
+    // a readonly node never sees the flushes of the writer, its cached results could not be invalidated
+    if (options_.result_cache_capacity_ > 0 && options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        result_cache_ = std::make_shared<QueryResultCache>(options_.result_cache_capacity_);
+    }
+    if (options_.recall_sample_rate_ > 0) {
+        recall_sampler_ = std::make_shared<RecallSampler>(options_.recall_sample_rate_);
+    }
+    build_throttle_ = std::make_shared<BuildThrottle>(options_.build_cpu_share_, options_.search_latency_slo_ms_);
+    // a readonly node doesn't see the partitions the writer creates or drops
+    if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        partition_index_ = std::make_shared<PartitionIndex>();
+    } else if (options_.replica_refresh_interval_ms_ > 0) {
+        // the files new to the replica are loaded into the free part of the cache before they are searched
+        auto loader = [this](const meta::SegmentsSchema& files) {
+            int64_t available_size =
+                cache::CpuCacheMgr::GetInstance()->CacheCapacity() - cache::CpuCacheMgr::GetInstance()->CacheUsage();
+            return PreloadFiles(nullptr, files, [available_size](int64_t size, bool& stop) {
+                stop = size >= available_size;
+                return Status::OK();
+            });
+        };
+        replica_tailer_ = std::make_shared<ReplicaTailer>(meta_ptr_, loader);
+    }
+    // the writable node moves the segments, a readonly node reads them through the links it left
+    if (!options_.meta_.cold_path_.empty() && options_.hot_tier_capacity_ > 0 &&
+        options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        storage_tier_ = std::make_shared<StorageTier>(options_.meta_.path_, options_.meta_.cold_path_);
+    }
+
+    // nothing to warm up until WarmUp is called
+    warm_up_progress_.hot_loaded_ = true;
+    warm_up_progress_.done_ = true;
+
     SetIdentity("DBImpl");
     AddCacheInsertDataListener();
+    AddInsertBufferSizeListener();
     AddUseBlasThresholdListener();
+    AddOmpThreadNumListener();
+    AddBuildCpuShareListener();
+    AddWalBufferSizeListener();
 
     Start();
 }
@@ -126,10 +321,20 @@ DBImpl::Start() {
     }
     StartMergeTask(merge_collection_ids, true);
 
+    // the access log is only read by the warm up, it loads while the wal recovers
+    auto access_log_loaded = std::async(std::launch::async, [this]() {
+        StartupStageGuard stage("access_log");
+        auto status = SegmentAccessLog::GetInstance().Load(options_.meta_.path_ + "/" + SEGMENT_ACCESS_LOG);
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << status.message();
+        }
+    });
+
     // wal
     if (options_.wal_enable_) {
         auto error_code = DB_ERROR;
         if (wal_mgr_ != nullptr) {
+            StartupStageGuard stage("wal_init");
             error_code = wal_mgr_->Init(meta_ptr_);
         }
         if (error_code != WAL_SUCCESS) {
@@ -137,16 +342,9 @@ DBImpl::Start() {
         }
 
         // recovery
-        while (1) {
-            wal::MXLogRecord record;
-            auto error_code = wal_mgr_->GetNextRecovery(record);
-            if (error_code != WAL_SUCCESS) {
-                throw Exception(error_code, "Wal recovery error!");
-            }
-            if (record.type == wal::MXLogType::None) {
-                break;
-            }
-            ExecWalRecord(record);
+        {
+            StartupStageGuard stage("wal_recovery");
+            RecoverWal();
         }
 
         // for distribute version, some nodes are read only
@@ -162,12 +360,23 @@ DBImpl::Start() {
         }
     }
 
+    access_log_loaded.wait();
+    bg_access_log_thread_ = std::thread(&DBImpl::BackgroundAccessLogThread, this);
+
     // for distribute version, some nodes are read only
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         // background build index thread
         bg_index_thread_ = std::thread(&DBImpl::BackgroundIndexThread, this);
     }
 
+    if (replica_tailer_ != nullptr) {
+        auto status = replica_tailer_->Refresh();
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to load the files of the replica: " << status.message();
+        }
+        bg_replica_thread_ = std::thread(&DBImpl::BackgroundReplicaThread, this);
+    }
+
     // background metric thread
     fiu_do_on("options_metric_enable", options_.metric_enable_ = true);
     if (options_.metric_enable_) {
@@ -185,6 +394,11 @@ DBImpl::Stop() {
 
     initialized_.store(false, std::memory_order_release);
 
+    // the background warm up stops at the next file once the db is not initialized
+    if (warm_up_thread_.joinable()) {
+        warm_up_thread_.join();
+    }
+
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         if (options_.wal_enable_) {
             // wait wal thread finish
@@ -215,6 +429,21 @@ DBImpl::Stop() {
         bg_metric_thread_.join();
     }
 
+    if (replica_tailer_ != nullptr) {
+        swn_replica_.Notify();
+        bg_replica_thread_.join();
+    }
+
+    // the exact searches of the samples need the scheduler, which stops after the db
+    if (recall_sampler_ != nullptr) {
+        recall_sampler_->Stop();
+    }
+
+    // the next start preloads the files searched last first
+    swn_access_log_.Notify();
+    bg_access_log_thread_.join();
+    SaveAccessLog();
+
     // LOG_ENGINE_TRACE_ << "DB service stop";
     return Status::OK();
 }
@@ -245,13 +474,31 @@ DBImpl::CreateHybridCollection(meta::CollectionSchema& collection_schema, meta::
         return SHUTDOWN_ERROR;
     }
 
+    PartitionKeyPtr partition_key;
+    auto status = PartitionKey::FromFields(fields_schema, partition_key);
+    if (!status.ok()) {
+        return status;
+    }
+
     meta::CollectionSchema temp_schema = collection_schema;
     temp_schema.index_file_size_ *= MB;
     if (options_.wal_enable_) {
         temp_schema.flush_lsn_ = wal_mgr_->CreateHybridCollection(collection_schema.collection_id_);
     }
 
-    return meta_ptr_->CreateHybridCollection(temp_schema, fields_schema);
+    status = meta_ptr_->CreateHybridCollection(temp_schema, fields_schema);
+    if (!status.ok() || partition_key == nullptr) {
+        return status;
+    }
+
+    // the key partitions exist as long as the collection, the inserts never create them
+    for (int64_t i = 0; i < partition_key->PartitionCount(); ++i) {
+        status = CreatePartition(collection_schema.collection_id_, "", PartitionKey::PartitionTag(i));
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
 }
 
 Status
@@ -281,6 +528,12 @@ DBImpl::DropCollection(const std::string& collection_id) {
 
     status = mem_mgr_->EraseMemVector(collection_id);      // not allow insert
     status = meta_ptr_->DropCollections({collection_id});  // soft delete collection
+    if (result_cache_ != nullptr) {
+        result_cache_->Invalidate(collection_id);
+    }
+    if (partition_index_ != nullptr) {
+        partition_index_->Invalidate(collection_id);
+    }
     index_failed_checker_.CleanFailedIndexFileOfCollection(collection_id);
 
     std::vector<meta::CollectionSchema> partition_array;
@@ -392,6 +645,22 @@ DBImpl::GetCollectionInfo(const std::string& collection_id, std::string& collect
             json_segment[JSON_ROW_COUNT] = file.row_count_;
             json_segment[JSON_INDEX_NAME] = utils::GetIndexName(file.engine_type_);
             json_segment[JSON_DATA_SIZE] = (int64_t)file.file_size_;
+
+            IndexBuildProgress build;
+            if (IndexBuildTracker::GetInstance().GetBuild(file.id_, build)) {
+                auto now = std::chrono::steady_clock::now();
+                milvus::json json_build;
+                json_build[JSON_INDEX_BUILD_STAGE] = IndexBuildStageName(build.stage_);
+                json_build[JSON_INDEX_NAME] = build.index_type_;
+                json_build[JSON_ROW_COUNT] = build.row_count_;
+                json_build[JSON_INDEX_BUILD_ROWS_INDEXED] = build.rows_indexed_;
+                json_build[JSON_INDEX_BUILD_BYTES_WRITTEN] = build.bytes_written_;
+                json_build[JSON_INDEX_BUILD_ELAPSED_MS] =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(now - build.queued_time_).count();
+                json_build[JSON_INDEX_BUILD_STAGE_ELAPSED_MS] =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(now - build.stage_time_).count();
+                json_segment[JSON_INDEX_BUILD] = json_build;
+            }
             json_segments.push_back(json_segment);
 
             row_count += file.row_count_;
@@ -435,99 +704,152 @@ DBImpl::PreloadCollection(const std::shared_ptr<server::Context>& context, const
         return SHUTDOWN_ERROR;
     }
 
-    // step 1: get all collection files from parent collection
+    // step 1: get all collection files from parent collection and partitions
     meta::FilesHolder files_holder;
-#if 0
-    auto status = meta_ptr_->FilesToSearch(collection_id, files_holder);
-    if (!status.ok()) {
-        return status;
-    }
-
-    // step 2: get files from partition collections
-    std::vector<meta::CollectionSchema> partition_array;
-    status = meta_ptr_->ShowPartitions(collection_id, partition_array);
-    for (auto& schema : partition_array) {
-        status = meta_ptr_->FilesToSearch(schema.collection_id_, files_holder);
-    }
-#else
-    auto status = meta_ptr_->FilesToSearch(collection_id, files_holder);
-    if (!status.ok()) {
-        return status;
-    }
-
-    std::vector<meta::CollectionSchema> partition_array;
-    status = meta_ptr_->ShowPartitions(collection_id, partition_array);
-
-    std::set<std::string> partition_ids;
-    for (auto& schema : partition_array) {
-        partition_ids.insert(schema.collection_id_);
-    }
-
-    status = meta_ptr_->FilesToSearchEx(collection_id, partition_ids, files_holder);
+    auto status = GetFilesToPreload(collection_id, files_holder);
     if (!status.ok()) {
         return status;
     }
-#endif
 
-    int64_t size = 0;
     int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
     int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
     int64_t available_size = cache_total - cache_usage;
 
-    // step 3: load file one by one
-    milvus::engine::meta::SegmentsSchema& files_array = files_holder.HoldFiles();
+    // a collection with cache quota stops loading once the quota is used up, even for a forced preload
+    int64_t quota_available = -1;
+    cache::CacheGroupStat cache_stat;
+    if (cache::CpuCacheMgr::GetInstance()->GetCollectionStat(collection_id, cache_stat) && cache_stat.quota_ > 0) {
+        quota_available = std::max(cache_stat.quota_ - cache_stat.usage_, (int64_t)0);
+    }
+
+    // step 2: load the files searched last first, several at once
+    meta::SegmentsSchema files_array = files_holder.HoldFiles();
+    OrderByAccess(files_array);
     LOG_ENGINE_DEBUG_ << "Begin pre-load collection:" + collection_id + ", totally " << files_array.size()
                       << " files need to be pre-loaded";
     TimeRecorderAuto rc("Pre-load collection:" + collection_id);
-    for (auto& file : files_array) {
-        // client break the connection, no need to continue
-        if (context && context->IsConnectionBroken()) {
-            LOG_ENGINE_DEBUG_ << "Client connection broken, stop load collection";
-            break;
+    auto check = [&](int64_t size, bool& stop) {
+        fiu_do_on("DBImpl.PreloadCollection.exceed_cache", size = available_size + 1);
+        if (quota_available >= 0 && size >= quota_available) {
+            LOG_ENGINE_DEBUG_ << "Pre-load stopped since cache quota of collection " << collection_id
+                              << " is used up";
+            stop = true;
+        } else if (!force && size > available_size) {
+            LOG_ENGINE_DEBUG_ << "Pre-load cancelled since cache is almost full";
+            return Status(SERVER_CACHE_FULL, "Cache is full");
         }
+        return Status::OK();
+    };
 
-        EngineType engine_type;
-        if (file.file_type_ == meta::SegmentSchema::FILE_TYPE::RAW ||
-            file.file_type_ == meta::SegmentSchema::FILE_TYPE::TO_INDEX ||
-            file.file_type_ == meta::SegmentSchema::FILE_TYPE::BACKUP) {
-            engine_type =
-                utils::IsBinaryMetricType(file.metric_type_) ? EngineType::FAISS_BIN_IDMAP : EngineType::FAISS_IDMAP;
-        } else {
-            engine_type = (EngineType)file.engine_type_;
+    // a file which doesn't fit in the rest of the quota is skipped before it is loaded, otherwise the cache
+    // would evict other files of the collection to make room for it, files already cached cost nothing
+    int64_t reserved_size = 0;
+    auto filter = [&](const meta::SegmentSchema& file) {
+        if (quota_available < 0 || cache::CpuCacheMgr::GetInstance()->ItemExists(file.location_)) {
+            return true;
         }
+        if (reserved_size + (int64_t)file.file_size_ > quota_available) {
+            LOG_ENGINE_DEBUG_ << "Pre-load skipped file " << file.file_id_ << " size: " << file.file_size_
+                              << " since it exceeds the rest of cache quota of collection " << collection_id;
+            return false;
+        }
+        reserved_size += file.file_size_;
+        return true;
+    };
+    return PreloadFiles(context, files_array, check, filter);
+}
+
+Status
+DBImpl::WarmUp(const std::vector<std::string>& collection_ids) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
 
-        auto json = milvus::json::parse(file.index_params_);
-        ExecutionEnginePtr engine =
-            EngineFactory::Build(file.dimension_, file.location_, engine_type, (MetricType)file.metric_type_, json);
-        fiu_do_on("DBImpl.PreloadCollection.null_engine", engine = nullptr);
-        if (engine == nullptr) {
-            LOG_ENGINE_ERROR_ << "Invalid engine type";
-            return Status(DB_ERROR, "Invalid engine type");
+    // the background part of an earlier warm up is finished first, its files may be wanted again
+    if (warm_up_thread_.joinable()) {
+        warm_up_thread_.join();
+    }
+
+    auto files_holder = std::make_shared<meta::FilesHolder>();
+    for (auto& collection_id : collection_ids) {
+        auto status = GetFilesToPreload(collection_id, *files_holder);
+        if (!status.ok()) {
+            return status;
         }
+    }
 
-        fiu_do_on("DBImpl.PreloadCollection.exceed_cache", size = available_size + 1);
+    // the files searched before the last shutdown are the hot set, the node serves once they are loaded
+    meta::SegmentsSchema files = files_holder->HoldFiles();
+    size_t hot_num = OrderByAccess(files);
+    meta::SegmentsSchema hot_files(files.begin(), files.begin() + hot_num);
+    auto cold_files = std::make_shared<meta::SegmentsSchema>(files.begin() + hot_num, files.end());
+    {
+        std::lock_guard<std::mutex> lock(warm_up_mutex_);
+        warm_up_progress_ = WarmUpProgress();
+        warm_up_progress_.hot_files_ = hot_num;
+        warm_up_progress_.total_files_ = files.size();
+    }
+
+    int64_t available_size =
+        cache::CpuCacheMgr::GetInstance()->CacheCapacity() - cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    auto check = [this, available_size](int64_t size, bool& stop) {
+        std::lock_guard<std::mutex> lock(warm_up_mutex_);
+        warm_up_progress_.loaded_files_++;
+        warm_up_progress_.loaded_bytes_ = size;
+        if (size > available_size) {
+            LOG_ENGINE_DEBUG_ << "Warm up stopped since cache is almost full";
+            stop = true;
+        }
+        return Status::OK();
+    };
 
-        try {
-            fiu_do_on("DBImpl.PreloadCollection.engine_throw_exception", throw std::exception());
-            std::string msg = "Pre-loaded file: " + file.file_id_ + " size: " + std::to_string(file.file_size_);
-            TimeRecorderAuto rc_1(msg);
-            status = engine->Load(true);
-            if (!status.ok()) {
-                return status;
-            }
+    LOG_ENGINE_DEBUG_ << "Begin warm up, " << hot_num << " of " << files.size()
+                      << " files were searched before the last shutdown";
+    TimeRecorderAuto rc("Warm up hot files");
+    auto status = PreloadFiles(nullptr, hot_files, check);
+    {
+        std::lock_guard<std::mutex> lock(warm_up_mutex_);
+        warm_up_progress_.hot_loaded_ = true;
+        warm_up_progress_.done_ = !status.ok() || cold_files->empty();
+    }
+    if (!status.ok() || cold_files->empty()) {
+        return status;
+    }
 
-            size += engine->Size();
-            if (!force && size > available_size) {
-                LOG_ENGINE_DEBUG_ << "Pre-load cancelled since cache is almost full";
-                return Status(SERVER_CACHE_FULL, "Cache is full");
+    // the cache usage counted so far continues in the background, the hot files took their share of it
+    warm_up_thread_ = std::thread([this, files_holder, cold_files, available_size]() {
+        SetThreadName("warm_up");
+        int64_t hot_size = 0;
+        {
+            std::lock_guard<std::mutex> lock(warm_up_mutex_);
+            hot_size = warm_up_progress_.loaded_bytes_;
+        }
+        auto status = PreloadFiles(nullptr, *cold_files, [this, hot_size, available_size](int64_t size, bool& stop) {
+            std::lock_guard<std::mutex> lock(warm_up_mutex_);
+            warm_up_progress_.loaded_files_++;
+            warm_up_progress_.loaded_bytes_ = hot_size + size;
+            if (hot_size + size > available_size) {
+                LOG_ENGINE_DEBUG_ << "Warm up stopped since cache is almost full";
+                stop = true;
             }
-        } catch (std::exception& ex) {
-            std::string msg = "Pre-load collection encounter exception: " + std::string(ex.what());
-            LOG_ENGINE_ERROR_ << msg;
-            return Status(DB_ERROR, msg);
+            return Status::OK();
+        });
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to warm up in background: " << status.message();
         }
-    }
+        files_holder->ReleaseFiles();
+
+        std::lock_guard<std::mutex> lock(warm_up_mutex_);
+        warm_up_progress_.done_ = true;
+    });
+
+    return Status::OK();
+}
 
+Status
+DBImpl::GetWarmUpProgress(WarmUpProgress& progress) {
+    std::lock_guard<std::mutex> lock(warm_up_mutex_);
+    progress = warm_up_progress_;
     return Status::OK();
 }
 
@@ -619,7 +941,11 @@ DBImpl::CreatePartition(const std::string& collection_id, const std::string& par
     } else {
         meta_ptr_->GetCollectionFlushLSN(collection_id, lsn);
     }
-    return meta_ptr_->CreatePartition(collection_id, partition_name, partition_tag, lsn);
+    auto status = meta_ptr_->CreatePartition(collection_id, partition_name, partition_tag, lsn);
+    if (partition_index_ != nullptr) {
+        partition_index_->Invalidate(collection_id);
+    }
+    return status;
 }
 
 Status
@@ -647,8 +973,18 @@ DBImpl::DropPartition(const std::string& partition_name) {
         return SHUTDOWN_ERROR;
     }
 
+    InvalidateQueryResults({partition_name});
+    // the owner is looked up while the partition is still in the meta
+    meta::CollectionSchema partition_schema;
+    partition_schema.collection_id_ = partition_name;
+    if (partition_index_ != nullptr) {
+        meta_ptr_->DescribeCollection(partition_schema);
+    }
     mem_mgr_->EraseMemVector(partition_name);                // not allow insert
     auto status = meta_ptr_->DropPartition(partition_name);  // soft delete collection
+    if (partition_index_ != nullptr && !partition_schema.owner_collection_.empty()) {
+        partition_index_->Invalidate(partition_schema.owner_collection_);
+    }
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << status.message();
         return status;
@@ -719,6 +1055,10 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
             return status;
         }
 
+        status = WaitInsertBuffer();
+        if (!status.ok()) {
+            return status;
+        }
         if (!vectors.float_data_.empty()) {
             wal_mgr_->Insert(collection_id, partition_tag, vectors.id_array_, vectors.float_data_);
         } else if (!vectors.binary_data_.empty()) {
@@ -750,6 +1090,170 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
     return status;
 }
 
+Status
+DBImpl::BulkImport(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+                   const std::string& partition_tag, const std::vector<std::string>& file_paths, IDNumbers& ids,
+                   bool build_index) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    std::string target_collection_name;
+    auto status = GetPartitionByTag(collection_id, partition_tag, target_collection_name);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // the imported segments reach the meta directly, the wal and the insert buffer never see them
+    BulkImportTask task(meta_ptr_, options_, target_collection_name, file_paths);
+    status = task.Execute(ids);
+    if (!status.ok() || !build_index) {
+        return status;
+    }
+
+    CollectionIndex index;
+    status = DescribeIndex(collection_id, index);
+    if (!status.ok()) {
+        return status;
+    }
+    return WaitCollectionIndexRecursively(context, target_collection_name, index);
+}
+
+Status
+DBImpl::ExportCollection(const std::string& collection_id, const std::string& target_dir) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    // the export is a snapshot of the files, the inserts still in the buffer are flushed to be part of it
+    auto status = Flush(collection_id);
+    if (!status.ok()) {
+        return status;
+    }
+
+    CollectionBackup backup(meta_ptr_, options_);
+    return backup.Export(collection_id, target_dir);
+}
+
+Status
+DBImpl::ImportCollection(const std::string& collection_id, const std::string& source_dir) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    CollectionBackup::Manifest manifest;
+    auto status = CollectionBackup::ReadManifest(source_dir, manifest);
+    if (!status.ok()) {
+        return status;
+    }
+
+    meta::CollectionSchema collection_schema = manifest.collection_;
+    collection_schema.collection_id_ = collection_id;
+    collection_schema.index_file_size_ /= MB;
+    status = CreateCollection(collection_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto& tag : manifest.partition_tags_) {
+        status = CreatePartition(collection_id, "", tag);
+        if (!status.ok()) {
+            break;
+        }
+    }
+
+    if (status.ok()) {
+        CollectionBackup backup(meta_ptr_, options_);
+        status = backup.Import(source_dir, manifest, collection_id);
+    }
+    if (!status.ok()) {
+        DropCollection(collection_id);
+    }
+    return status;
+}
+
+Status
+DBImpl::WaitInsertBuffer() {
+    // the wal thread flushes a full insert buffer before it applies the next records, holding the insert meanwhile
+    // pushes back on the client instead of piling up records in the wal
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_INSERT_BUFFER_TIMEOUT_MS);
+    while (initialized_.load(std::memory_order_acquire) && !wal_parallel_replay_) {
+        size_t mem = mem_mgr_->GetCurrentMem();
+        if (mem <= options_.insert_buffer_size_) {
+            break;
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            // the time the flushes take to bring the buffer down to its target at the rate seen so far
+            auto target = static_cast<size_t>(options_.insert_buffer_size_ * options_.insert_buffer_target_);
+            double rate = insert_flush_rate_.load();
+            int64_t retry_after_ms = INSERT_RETRY_AFTER_MAX_MS;
+            if (rate > 0) {
+                retry_after_ms = static_cast<int64_t>((mem - target) / rate * 1000);
+                retry_after_ms = std::max(retry_after_ms, INSERT_RETRY_AFTER_MIN_MS);
+                retry_after_ms = std::min(retry_after_ms, INSERT_RETRY_AFTER_MAX_MS);
+            }
+            std::string msg = "Insert buffer is full, retry after " + std::to_string(retry_after_ms) + " ms";
+            LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] ", "insert", 0) << msg;
+            return Status(DB_INSERT_BUFFER_FULL, msg);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INSERT_BUFFER_INTERVAL_MS));
+    }
+    return Status::OK();
+}
+
+void
+DBImpl::FlushInsertBuffer() {
+    size_t mem = mem_mgr_->GetCurrentMem();
+    if (mem <= options_.insert_buffer_size_) {
+        return;
+    }
+
+    // flushing the whole buffer at once would stall the inserts for the longest, and make small segments of the
+    // collections barely inserted into
+    auto target = static_cast<size_t>(options_.insert_buffer_size_ * options_.insert_buffer_target_);
+    auto collection_ids = mem_mgr_->FlushCandidates(mem - target);
+    LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] ", "insert", 0) << "Insert buffer size exceeds limit, flush "
+                      << collection_ids.size() << " collections";
+
+    auto start = std::chrono::steady_clock::now();
+    std::set<std::string> flushed_collections;
+    for (auto& collection_id : collection_ids) {
+        {
+            const std::lock_guard<std::mutex> lock(flush_merge_compact_mutex_);
+            auto status = mem_mgr_->Flush(collection_id);
+            if (!status.ok()) {
+                break;
+            }
+        }
+        flushed_collections.insert(collection_id);
+        FlushAttrsIndex(collection_id);
+
+        if (options_.wal_enable_) {
+            // the wal tracks a partition under its owner collection and tag
+            uint64_t lsn = 0;
+            meta_ptr_->GetCollectionFlushLSN(collection_id, lsn);
+            meta::CollectionSchema collection_schema;
+            collection_schema.collection_id_ = collection_id;
+            meta_ptr_->DescribeCollection(collection_schema);
+            if (collection_schema.owner_collection_.empty()) {
+                wal_mgr_->PartitionFlushed(collection_id, "", lsn);
+            } else {
+                wal_mgr_->PartitionFlushed(collection_schema.owner_collection_, collection_schema.partition_tag_, lsn);
+            }
+        }
+    }
+
+    size_t freed = mem > mem_mgr_->GetCurrentMem() ? mem - mem_mgr_->GetCurrentMem() : 0;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (freed > 0 && seconds > 0) {
+        double rate = freed / seconds;
+        double last_rate = insert_flush_rate_.load();
+        insert_flush_rate_ = last_rate > 0 ? 0.8 * last_rate + 0.2 * rate : rate;
+    }
+
+    InvalidateQueryResults(flushed_collections);
+    StartMergeTask(flushed_collections);
+}
+
 Status
 CopyToAttr(std::vector<uint8_t>& record, uint64_t row_num, const std::vector<std::string>& field_names,
            std::unordered_map<std::string, meta::hybrid::DataType>& attr_types,
@@ -898,6 +1402,16 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
         return status;
     }
 
+    // entities without a tag go to the partitions their partition key picks
+    auto vector_it = entity.vector_data_.begin();
+    if (partition_tag.empty() && vector_it->second.binary_data_.empty()) {
+        PartitionKeyPtr partition_key;
+        GetPartitionKey(collection_id, partition_key);
+        if (partition_key != nullptr) {
+            return InsertByPartitionKey(collection_id, partition_key, entity, attr_data, attr_nbytes);
+        }
+    }
+
     wal::MXLogRecord record;
     record.lsn = 0;
     record.collection_id = collection_id;
@@ -905,7 +1419,6 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
     record.ids = entity.id_array_.data();
     record.length = entity.entity_count_;
 
-    auto vector_it = entity.vector_data_.begin();
     if (vector_it->second.binary_data_.empty()) {
         record.type = wal::MXLogType::Entity;
         record.data = vector_it->second.float_data_.data();
@@ -1040,6 +1553,21 @@ DBImpl::Flush(const std::string& collection_id) {
     return status;
 }
 
+Status
+DBImpl::SyncWal() {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    if (options_.wal_enable_) {
+        auto error_code = wal_mgr_->WaitSynced();
+        if (error_code != WAL_SUCCESS) {
+            return Status(error_code, "Failed to sync wal files");
+        }
+    }
+    return Status::OK();
+}
+
 Status
 DBImpl::Flush() {
     if (!initialized_.load(std::memory_order_acquire)) {
@@ -1118,54 +1646,97 @@ DBImpl::Compact(const std::shared_ptr<server::Context>& context, const std::stri
 
     LOG_ENGINE_DEBUG_ << "Found " << files_holder.HoldFiles().size() << " segment to compact";
 
-    Status compact_status;
     // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
     milvus::engine::meta::SegmentsSchema files_to_compact = files_holder.HoldFiles();
-    for (auto iter = files_to_compact.begin(); iter != files_to_compact.end();) {
-        // client break the connection, no need to continue
-        if (context && context->IsConnectionBroken()) {
-            LOG_ENGINE_DEBUG_ << "Client connection broken, stop compact operation";
-            break;
-        }
 
-        meta::SegmentSchema file = *iter;
-        iter = files_to_compact.erase(iter);
+    // the segments are compacted on a few threads, the bytes of the segments in flight are kept under an io budget.
+    // a compacted segment replaces the old one in one meta update, the old one is searched until then
+    std::mutex compact_mutex;
+    std::condition_variable budget_cv;
+    uint64_t bytes_in_flight = 0;
+    size_t next_file = 0;
+    bool stopped = false;
+    Status compact_status;
 
-        // Check if the segment needs compacting
-        std::string segment_dir;
-        utils::GetParentPath(file.location_, segment_dir);
+    auto compact_next = [&]() {
+        for (;;) {
+            meta::SegmentSchema file;
+            {
+                std::unique_lock<std::mutex> lock(compact_mutex);
+                // client break the connection, no need to continue
+                if (!stopped && context && context->IsConnectionBroken()) {
+                    LOG_ENGINE_DEBUG_ << "Client connection broken, stop compact operation";
+                    stopped = true;
+                }
+                if (stopped || next_file >= files_to_compact.size()) {
+                    return;
+                }
+                file = files_to_compact[next_file++];
 
-        segment::SegmentReader segment_reader(segment_dir);
-        size_t deleted_docs_size;
-        status = segment_reader.ReadDeletedDocsSize(deleted_docs_size);
-        if (!status.ok()) {
-            files_holder.UnmarkFile(file);
-            continue;  // skip this file and try compact next one
-        }
+                // a segment larger than the budget runs alone
+                budget_cv.wait(lock, [&] {
+                    return bytes_in_flight == 0 || bytes_in_flight + file.file_size_ <= COMPACT_IO_BUDGET;
+                });
+                bytes_in_flight += file.file_size_;
+            }
+
+            auto release = [&](const Status& status) {
+                std::lock_guard<std::mutex> lock(compact_mutex);
+                bytes_in_flight -= file.file_size_;
+                if (!status.ok()) {
+                    compact_status = status;
+                }
+                budget_cv.notify_all();
+            };
 
-        meta::SegmentsSchema files_to_update;
-        if (deleted_docs_size != 0) {
-            compact_status = CompactFile(file, threshold, files_to_update);
+            // Check if the segment needs compacting
+            std::string segment_dir;
+            utils::GetParentPath(file.location_, segment_dir);
 
-            if (!compact_status.ok()) {
-                LOG_ENGINE_ERROR_ << "Compact failed for segment " << file.segment_id_ << ": "
-                                  << compact_status.message();
+            segment::SegmentReader segment_reader(segment_dir);
+            size_t deleted_docs_size;
+            auto status = segment_reader.ReadDeletedDocsSize(deleted_docs_size);
+            if (!status.ok()) {
                 files_holder.UnmarkFile(file);
+                release(Status::OK());
                 continue;  // skip this file and try compact next one
             }
-        } else {
+            if (deleted_docs_size == 0) {
+                files_holder.UnmarkFile(file);
+                LOG_ENGINE_DEBUG_ << "Segment " << file.segment_id_ << " has no deleted data. No need to compact";
+                release(Status::OK());
+                continue;  // skip this file and try compact next one
+            }
+
+            meta::SegmentsSchema files_to_update;
+            status = CompactFile(file, threshold, files_to_update);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << "Compact failed for segment " << file.segment_id_ << ": " << status.message();
+                files_holder.UnmarkFile(file);
+                release(status);
+                continue;  // skip this file and try compact next one
+            }
+
+            LOG_ENGINE_DEBUG_ << "Updating meta after compaction...";
+            status = meta_ptr_->UpdateCollectionFiles(files_to_update);
             files_holder.UnmarkFile(file);
-            LOG_ENGINE_DEBUG_ << "Segment " << file.segment_id_ << " has no deleted data. No need to compact";
-            continue;  // skip this file and try compact next one
+            release(status);
+            if (!status.ok()) {
+                std::lock_guard<std::mutex> lock(compact_mutex);
+                stopped = true;  // meta error, could not go on
+                return;
+            }
         }
+    };
 
-        LOG_ENGINE_DEBUG_ << "Updating meta after compaction...";
-        status = meta_ptr_->UpdateCollectionFiles(files_to_update);
-        files_holder.UnmarkFile(file);
-        if (!status.ok()) {
-            compact_status = status;
-            break;  // meta error, could not go on
-        }
+    size_t thread_num = std::min<size_t>(COMPACT_THREAD_NUM, files_to_compact.size());
+    std::vector<std::thread> compact_threads;
+    for (size_t i = 1; i < thread_num; ++i) {
+        compact_threads.emplace_back(compact_next);
+    }
+    compact_next();
+    for (auto& thread : compact_threads) {
+        thread.join();
     }
 
     if (compact_status.ok()) {
@@ -1177,8 +1748,6 @@ DBImpl::Compact(const std::shared_ptr<server::Context>& context, const std::stri
 
 Status
 DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::SegmentsSchema& files_to_update) {
-    LOG_ENGINE_DEBUG_ << "Compacting segment " << file.segment_id_ << " for collection: " << file.collection_id_;
-
     std::string segment_dir_to_merge;
     utils::GetParentPath(file.location_, segment_dir_to_merge);
 
@@ -1198,81 +1767,8 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
         }
     }
 
-    // Create new collection file
-    meta::SegmentSchema compacted_file;
-    compacted_file.collection_id_ = file.collection_id_;
-    compacted_file.file_type_ = meta::SegmentSchema::NEW_MERGE;  // TODO: use NEW_MERGE for now
-    auto status = meta_ptr_->CreateCollectionFile(compacted_file);
-
-    if (!status.ok()) {
-        LOG_ENGINE_ERROR_ << "Failed to create collection file: " << status.message();
-        return status;
-    }
-
-    // Compact (merge) file to the newly created collection file
-    std::string new_segment_dir;
-    utils::GetParentPath(compacted_file.location_, new_segment_dir);
-    auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
-
-    LOG_ENGINE_DEBUG_ << "Compacting begin...";
-    segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
-
-    // Serialize
-    LOG_ENGINE_DEBUG_ << "Serializing compacted segment...";
-    status = segment_writer_ptr->Serialize();
-    if (!status.ok()) {
-        LOG_ENGINE_ERROR_ << "Failed to serialize compacted segment: " << status.message();
-        compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
-        auto mark_status = meta_ptr_->UpdateCollectionFile(compacted_file);
-        if (mark_status.ok()) {
-            LOG_ENGINE_DEBUG_ << "Mark file: " << compacted_file.file_id_ << " to to_delete";
-        }
-
-        return status;
-    }
-
-    // Update compacted file state, if origin file is backup or to_index, set compacted file to to_index
-    compacted_file.file_size_ = segment_writer_ptr->Size();
-    compacted_file.row_count_ = segment_writer_ptr->VectorCount();
-    if ((file.file_type_ == (int32_t)meta::SegmentSchema::BACKUP ||
-         file.file_type_ == (int32_t)meta::SegmentSchema::TO_INDEX) &&
-        (compacted_file.row_count_ > meta::BUILD_INDEX_THRESHOLD)) {
-        compacted_file.file_type_ = meta::SegmentSchema::TO_INDEX;
-    } else {
-        compacted_file.file_type_ = meta::SegmentSchema::RAW;
-    }
-
-    if (compacted_file.row_count_ == 0) {
-        LOG_ENGINE_DEBUG_ << "Compacted segment is empty. Mark it as TO_DELETE";
-        compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
-    }
-
-    files_to_update.emplace_back(compacted_file);
-
-    // Set all files in segment to TO_DELETE
-    auto& segment_id = file.segment_id_;
-    meta::FilesHolder files_holder;
-    status = meta_ptr_->GetCollectionFilesBySegmentId(segment_id, files_holder);
-    if (!status.ok()) {
-        return status;
-    }
-
-    milvus::engine::meta::SegmentsSchema& segment_files = files_holder.HoldFiles();
-    for (auto& f : segment_files) {
-        f.file_type_ = meta::SegmentSchema::FILE_TYPE::TO_DELETE;
-        files_to_update.emplace_back(f);
-    }
-    files_holder.ReleaseFiles();
-
-    LOG_ENGINE_DEBUG_ << "Compacted segment " << compacted_file.segment_id_ << " from "
-                      << std::to_string(file.file_size_) << " bytes to " << std::to_string(compacted_file.file_size_)
-                      << " bytes";
-
-    if (options_.insert_cache_immediately_) {
-        segment_writer_ptr->Cache();
-    }
-
-    return status;
+    CompactTask task(meta_ptr_, options_, file);
+    return task.Execute(files_to_update);
 }
 
 Status
@@ -1282,14 +1778,36 @@ DBImpl::GetVectorsByID(const engine::meta::CollectionSchema& collection, const I
         return SHUTDOWN_ERROR;
     }
 
+    // the index files are held for the raw vectors their cached indexes keep
     meta::FilesHolder files_holder;
     std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
-                                meta::SegmentSchema::FILE_TYPE::BACKUP};
+                                meta::SegmentSchema::FILE_TYPE::BACKUP, meta::SegmentSchema::FILE_TYPE::INDEX};
 
     std::vector<meta::CollectionSchema> collection_array;
     auto status = meta_ptr_->ShowPartitions(collection.collection_id_, collection_array);
 
     collection_array.push_back(collection);
+
+    // the insert buffer is looked up before the files are read, a flush in between is then found in either, the
+    // ids found there are newer than any in the files
+    std::vector<engine::VectorsData> buffered;
+    IDNumbers file_ids;
+    if (options_.search_insert_buffer_) {
+        std::set<std::string> buffer_ids;
+        for (auto& schema : collection_array) {
+            buffer_ids.insert(schema.collection_id_);
+        }
+        mem_mgr_->GetVectorsByID(buffer_ids, id_array, buffered);
+        for (size_t i = 0; i < id_array.size(); ++i) {
+            if (buffered[i].vector_count_ == 0) {
+                file_ids.push_back(id_array[i]);
+            }
+        }
+    } else {
+        buffered.resize(id_array.size());
+        file_ids = id_array;
+    }
+
     status = meta_ptr_->FilesByTypeEx(collection_array, file_types, files_holder);
     if (!status.ok()) {
         std::string err_msg = "Failed to get files for GetVectorByID: " + status.message();
@@ -1297,14 +1815,27 @@ DBImpl::GetVectorsByID(const engine::meta::CollectionSchema& collection, const I
         return status;
     }
 
-    if (files_holder.HoldFiles().empty()) {
+    if (files_holder.HoldFiles().empty() && file_ids.size() == id_array.size()) {
         LOG_ENGINE_DEBUG_ << "No files to get vector by id from";
         return Status(DB_NOT_FOUND, "Collection is empty");
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();
-    status = GetVectorsByIdHelper(id_array, vectors, files_holder);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();
+    std::vector<engine::VectorsData> file_vectors;
+    if (!file_ids.empty()) {
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();
+        status = GetVectorsByIdHelper(file_ids, file_vectors, files_holder);
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();
+    }
+
+    vectors.clear();
+    for (size_t i = 0, j = 0; i < id_array.size(); ++i) {
+        if (buffered[i].vector_count_ > 0) {
+            vectors.emplace_back(std::move(buffered[i]));
+        } else {
+            vectors.emplace_back(j < file_vectors.size() ? std::move(file_vectors[j]) : engine::VectorsData());
+            ++j;
+        }
+    }
 
     if (vectors.empty()) {
         std::string msg = "Vectors not found in collection " + collection.collection_id_;
@@ -1474,11 +2005,22 @@ DBImpl::GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::Vect
 
     vectors.clear();
 
+    // the index file of each segment, its cached index may keep the raw vectors
+    std::unordered_map<std::string, std::string> index_locations;
+    for (auto& file : files) {
+        if (file.file_type_ == meta::SegmentSchema::FILE_TYPE::INDEX) {
+            index_locations[file.segment_id_] = file.location_;
+        }
+    }
+
     IDNumbers temp_ids = id_array;
     for (auto& file : files) {
         if (temp_ids.empty()) {
             break;  // all vectors found, no need to continue
         }
+        if (file.file_type_ == meta::SegmentSchema::FILE_TYPE::INDEX) {
+            continue;
+        }
         // Load bloom filter
         std::string segment_dir;
         engine::utils::GetParentPath(file.location_, segment_dir);
@@ -1488,66 +2030,80 @@ DBImpl::GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::Vect
         if (!status.ok()) {
             return status;
         }
+        SegmentIdLocator id_locator(segment_reader);
 
+        // the ids found in the segment and their offsets, the deleted docs are loaded once by the first one found
+        std::vector<int64_t> found_ids, offsets;
+        segment::DeletedDocsPtr deleted_docs_ptr;
+        std::unordered_set<segment::offset_t> deleted_offsets;
         for (IDNumbers::iterator it = temp_ids.begin(); it != temp_ids.end();) {
             int64_t vector_id = *it;
             // each id must has a VectorsData
             // if vector not found for an id, its VectorsData's vector_count = 0, else 1
-            VectorsData& vector_ref = map_id2vector[vector_id];
+            map_id2vector[vector_id];
 
             // Check if the id is present in bloom filter.
             if (id_bloom_filter_ptr->Check(vector_id)) {
-                // Load uids and check if the id is indeed present. If yes, find its offset.
-                std::vector<segment::doc_id_t> uids;
-                auto status = segment_reader.LoadUids(uids);
+                // Check if the id is indeed present. If yes, find its offset.
+                int64_t offset;
+                auto status = id_locator.Find(vector_id, offset);
                 if (!status.ok()) {
                     return status;
                 }
 
-                auto found = std::find(uids.begin(), uids.end(), vector_id);
-                if (found != uids.end()) {
-                    auto offset = std::distance(uids.begin(), found);
-
-                    // Check whether the id has been deleted
-                    segment::DeletedDocsPtr deleted_docs_ptr;
+                if (offset != -1 && deleted_docs_ptr == nullptr) {
                     status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
                     if (!status.ok()) {
                         LOG_ENGINE_ERROR_ << status.message();
                         return status;
                     }
                     auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+                    deleted_offsets.insert(deleted_docs.begin(), deleted_docs.end());
+                }
 
-                    auto deleted = std::find(deleted_docs.begin(), deleted_docs.end(), offset);
-                    if (deleted == deleted_docs.end()) {
-                        // Load raw vector
-                        bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
-                        size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
-                        std::vector<uint8_t> raw_vector;
-                        status =
-                            segment_reader.LoadVectors(offset * single_vector_bytes, single_vector_bytes, raw_vector);
-                        if (!status.ok()) {
-                            LOG_ENGINE_ERROR_ << status.message();
-                            return status;
-                        }
-
-                        vector_ref.vector_count_ = 1;
-                        if (is_binary) {
-                            vector_ref.binary_data_.swap(raw_vector);
-                        } else {
-                            std::vector<float> float_vector;
-                            float_vector.resize(file.dimension_);
-                            memcpy(float_vector.data(), raw_vector.data(), single_vector_bytes);
-                            vector_ref.float_data_.swap(float_vector);
-                        }
-                        temp_ids.erase(it);
-                        continue;
-                    }
+                // Check whether the id has been deleted
+                if (offset != -1 && deleted_offsets.find(offset) == deleted_offsets.end()) {
+                    found_ids.push_back(vector_id);
+                    offsets.push_back(offset);
+                    it = temp_ids.erase(it);
+                    continue;
                 }
             }
 
             it++;
         }
 
+        if (!found_ids.empty()) {
+            // the raw vectors are copied from the cached index of the segment when it keeps them, else read at once
+            bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
+            size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
+            std::vector<uint8_t> raw_vectors;
+            auto index_location = index_locations.find(file.segment_id_);
+            bool cached = !is_binary && (CopyCachedVectors(file.location_, file.dimension_, offsets, raw_vectors) ||
+                                         (index_location != index_locations.end() &&
+                                          CopyCachedVectors(index_location->second, file.dimension_, offsets,
+                                                            raw_vectors)));
+            if (!cached) {
+                status = segment_reader.LoadVectors(offsets, single_vector_bytes, raw_vectors);
+                if (!status.ok()) {
+                    LOG_ENGINE_ERROR_ << status.message();
+                    return status;
+                }
+            }
+
+            for (size_t i = 0; i < found_ids.size(); ++i) {
+                VectorsData& vector_ref = map_id2vector[found_ids[i]];
+                auto begin = raw_vectors.begin() + i * single_vector_bytes;
+                vector_ref.vector_count_ = 1;
+                if (is_binary) {
+                    vector_ref.binary_data_.assign(begin, begin + single_vector_bytes);
+                } else {
+                    vector_ref.float_data_.resize(file.dimension_);
+                    memcpy(vector_ref.float_data_.data(), &(*begin), single_vector_bytes);
+                }
+            }
+        }
+
         // unmark file, allow the file to be deleted
         files_holder.UnmarkFile(file);
     }
@@ -1567,6 +2123,41 @@ DBImpl::GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::Vect
     return Status::OK();
 }
 
+bool
+DBImpl::CopyCachedVectors(const std::string& location, int64_t dimension, const std::vector<int64_t>& offsets,
+                          std::vector<uint8_t>& raw_vectors) {
+    auto index = std::static_pointer_cast<knowhere::VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location));
+    if (index == nullptr) {
+        return false;
+    }
+
+    raw_vectors.resize(offsets.size() * dimension * sizeof(float));
+    auto vectors = reinterpret_cast<float*>(raw_vectors.data());
+    if (auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF_NM>(index)) {
+        return ivf_index->GetRawVectors(offsets.data(), offsets.size(), vectors);
+    }
+
+    // the brute force index of a raw file holds the rows in their order, under their offsets
+    auto bf_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index);
+    if (bf_index == nullptr || bf_index->Dim() != dimension) {
+        return false;
+    }
+    int64_t count = bf_index->Count();
+    auto ids = bf_index->GetRawIds();
+    auto data = bf_index->GetRawVectors();
+    // the rows of a compressed raw file are read from disk
+    if (data == nullptr) {
+        return false;
+    }
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (offsets[i] < 0 || offsets[i] >= count || ids[offsets[i]] != offsets[i]) {
+            return false;
+        }
+        memcpy(vectors + i * dimension, data + offsets[i] * dimension, dimension * sizeof(float));
+    }
+    return true;
+}
+
 Status
 DBImpl::GetEntitiesByIdHelper(const std::string& collection_id, const milvus::engine::IDNumbers& id_array,
                               std::unordered_map<std::string, engine::meta::hybrid::DataType>& attr_type,
@@ -1594,6 +2185,7 @@ DBImpl::GetEntitiesByIdHelper(const std::string& collection_id, const milvus::en
         segment::SegmentReader segment_reader(segment_dir);
         segment::IdBloomFilterPtr id_bloom_filter_ptr;
         segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+        SegmentIdLocator id_locator(segment_reader);
 
         for (IDNumbers::iterator it = temp_ids.begin(); it != temp_ids.end();) {
             int64_t vector_id = *it;
@@ -1604,16 +2196,14 @@ DBImpl::GetEntitiesByIdHelper(const std::string& collection_id, const milvus::en
 
             // Check if the id is present in bloom filter.
             if (id_bloom_filter_ptr->Check(vector_id)) {
-                // Load uids and check if the id is indeed present. If yes, find its offset.
-                std::vector<segment::doc_id_t> uids;
-                auto status = segment_reader.LoadUids(uids);
+                // Check if the id is indeed present. If yes, find its offset.
+                int64_t offset;
+                auto status = id_locator.Find(vector_id, offset);
                 if (!status.ok()) {
                     return status;
                 }
 
-                auto found = std::find(uids.begin(), uids.end(), vector_id);
-                if (found != uids.end()) {
-                    auto offset = std::distance(uids.begin(), found);
+                if (offset != -1) {
 
                     // Check whether the id has been deleted
                     segment::DeletedDocsPtr deleted_docs_ptr;
@@ -1640,36 +2230,10 @@ DBImpl::GetEntitiesByIdHelper(const std::string& collection_id, const milvus::en
                         std::unordered_map<std::string, std::vector<uint8_t>> raw_attrs;
                         auto attr_it = attr_type.begin();
                         for (; attr_it != attr_type.end(); attr_it++) {
-                            size_t num_bytes;
-                            switch (attr_it->second) {
-                                case engine::meta::hybrid::DataType::INT8: {
-                                    num_bytes = 1;
-                                    break;
-                                }
-                                case engine::meta::hybrid::DataType::INT16: {
-                                    num_bytes = 2;
-                                    break;
-                                }
-                                case engine::meta::hybrid::DataType::INT32: {
-                                    num_bytes = 4;
-                                    break;
-                                }
-                                case engine::meta::hybrid::DataType::INT64: {
-                                    num_bytes = 8;
-                                    break;
-                                }
-                                case engine::meta::hybrid::DataType::FLOAT: {
-                                    num_bytes = 4;
-                                    break;
-                                }
-                                case engine::meta::hybrid::DataType::DOUBLE: {
-                                    num_bytes = 8;
-                                    break;
-                                }
-                                default: {
-                                    std::string msg = "Field type of " + attr_it->first + " is wrong";
-                                    return Status{DB_ERROR, msg};
-                                }
+                            size_t num_bytes = AttrWidth(attr_it->second);
+                            if (num_bytes == 0) {
+                                std::string msg = "Field type of " + attr_it->first + " is wrong";
+                                return Status{DB_ERROR, msg};
                             }
                             std::vector<uint8_t> raw_attr;
                             status = segment_reader.LoadAttrs(attr_it->first, offset * num_bytes, num_bytes, raw_attr);
@@ -1727,6 +2291,100 @@ DBImpl::GetEntitiesByIdHelper(const std::string& collection_id, const milvus::en
     return Status::OK();
 }
 
+Status
+DBImpl::MaterializeEntities(const IDNumbers& id_array, const std::vector<meta::SegmentDescPtr>& sources,
+                            const std::vector<std::string>& field_names,
+                            const std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
+                            std::vector<VectorsData>& vectors, std::vector<AttrsData>& attrs) {
+    std::unordered_map<std::string, meta::hybrid::DataType> result_attr_type;
+    for (auto& pair : attr_type) {
+        if (!IsVectorType(pair.second)) {
+            result_attr_type.insert(pair);
+        }
+    }
+
+    std::vector<std::pair<std::string, size_t>> fetch_attrs;  // name and width
+    bool fetch_vectors = false;
+    for (auto& name : field_names) {
+        auto iter = attr_type.find(name);
+        if (iter == attr_type.end()) {
+            continue;
+        }
+        if (IsVectorType(iter->second)) {
+            fetch_vectors = true;
+        } else if (AttrWidth(iter->second) > 0) {
+            fetch_attrs.emplace_back(name, AttrWidth(iter->second));
+        }
+    }
+
+    attrs.assign(id_array.size(), AttrsData());
+    for (auto& attr : attrs) {
+        attr.attr_type_ = result_attr_type;
+    }
+    vectors.assign(fetch_vectors ? id_array.size() : 0, VectorsData());
+
+    // the results of each segment, the rows of a field are read in one batch
+    std::map<std::string, std::vector<size_t>> segment_results;
+    for (size_t i = 0; i < id_array.size() && i < sources.size(); ++i) {
+        if (sources[i] != nullptr) {
+            segment_results[sources[i]->location_].push_back(i);
+        }
+    }
+
+    for (auto& pair : segment_results) {
+        auto& file = sources[pair.second.front()];
+        std::string segment_dir;
+        utils::GetParentPath(file->location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        SegmentIdLocator id_locator(segment_reader);
+
+        std::vector<size_t> found;
+        std::vector<int64_t> offsets;
+        for (auto i : pair.second) {
+            int64_t offset = -1;
+            STATUS_CHECK(id_locator.Find(id_array[i], offset));
+            if (offset != -1) {
+                found.push_back(i);
+                offsets.push_back(offset);
+                attrs[i].attr_count_ = 1;
+            }
+        }
+        if (found.empty()) {
+            continue;
+        }
+
+        for (auto& fetch : fetch_attrs) {
+            std::vector<uint8_t> raw;
+            STATUS_CHECK(segment_reader.LoadAttrs(fetch.first, offsets, fetch.second, raw));
+            for (size_t k = 0; k < found.size(); ++k) {
+                auto begin = raw.begin() + k * fetch.second;
+                attrs[found[k]].attr_data_[fetch.first].assign(begin, begin + fetch.second);
+            }
+        }
+
+        if (fetch_vectors) {
+            bool is_binary = utils::IsBinaryMetricType(file->metric_type_);
+            size_t width = is_binary ? file->dimension_ / 8 : file->dimension_ * sizeof(float);
+            std::vector<uint8_t> raw;
+            STATUS_CHECK(segment_reader.LoadVectors(offsets, width, raw));
+            for (size_t k = 0; k < found.size(); ++k) {
+                auto& vector_ref = vectors[found[k]];
+                vector_ref.vector_count_ = 1;
+                if (is_binary) {
+                    vector_ref.binary_data_.assign(raw.begin() + k * width, raw.begin() + (k + 1) * width);
+                } else {
+                    vector_ref.float_data_.resize(file->dimension_);
+                    memcpy(vector_ref.float_data_.data(), raw.data() + k * width, width);
+                }
+            }
+        }
+    }
+
+    LOG_ENGINE_DEBUG_ << "Materialized " << fetch_attrs.size() << " attributes" << (fetch_vectors ? " and vectors" : "")
+                      << " of " << id_array.size() << " results from " << segment_results.size() << " segments";
+    return Status::OK();
+}
+
 Status
 DBImpl::CreateIndex(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                     const CollectionIndex& index) {
@@ -1796,9 +2454,151 @@ DBImpl::SerializeStructuredIndex(const meta::SegmentSchema& segment_schema,
         return status;
     }
 
+    // the bounds of the segment let a hybrid query skip it before it is loaded
+    meta::hybrid::FieldsStatsSchema fields_stats;
+    for (auto& pair : attr_indexes) {
+        auto type_iter = attr_types.find(pair.first);
+        if (type_iter == attr_types.end()) {
+            continue;
+        }
+        auto zone_map = segment::AttrZoneMap::Build(pair.second, type_iter->second);
+        meta::hybrid::FieldStatsSchema stats;
+        if (zone_map == nullptr || !zone_map->GetBounds(stats.min_value_, stats.max_value_)) {
+            continue;
+        }
+        stats.collection_id_ = segment_schema.collection_id_;
+        stats.segment_id_ = segment_schema.segment_id_;
+        stats.field_name_ = pair.first;
+        stats.field_type_ = type_iter->second;
+        stats.row_count_ = zone_map->GetRowCount();
+        fields_stats.emplace_back(std::move(stats));
+    }
+    auto stats_status = meta_ptr_->UpdateFieldsStats(fields_stats);
+    if (!stats_status.ok()) {
+        LOG_ENGINE_WARNING_ << "Failed to record field stats of segment " << segment_schema.segment_id_ << ": "
+                            << stats_status.message();
+    }
+
     return status;
 }
 
+void
+DBImpl::PruneFilesByFieldsStats(const query::GeneralQueryPtr& general_query, meta::FilesHolder& files_holder) {
+    std::vector<std::string> segment_ids;
+    for (auto& file : files_holder.HoldFiles()) {
+        segment_ids.emplace_back(file.segment_id_);
+    }
+    meta::hybrid::FieldsStatsSchema fields_stats;
+    auto status = meta_ptr_->GetFieldsStats(segment_ids, fields_stats);
+    if (!status.ok() || fields_stats.empty()) {
+        return;
+    }
+
+    // a segment without stats, flushed by an older version or merged, may always match
+    std::unordered_map<std::string, segment::AttrZoneMaps> segment_zone_maps;
+    for (auto& stats : fields_stats) {
+        auto zone_map = segment::AttrZoneMap::FromBounds((meta::hybrid::DataType)stats.field_type_, stats.row_count_,
+                                                         stats.min_value_, stats.max_value_);
+        if (zone_map != nullptr) {
+            segment_zone_maps[stats.segment_id_][stats.field_name_] = zone_map;
+        }
+    }
+
+    meta::SegmentsSchema pruned_files;
+    for (auto& file : files_holder.HoldFiles()) {
+        auto iter = segment_zone_maps.find(file.segment_id_);
+        if (iter != segment_zone_maps.end() && !segment::ZoneMapsMayMatch(iter->second, general_query)) {
+            pruned_files.push_back(file);
+        }
+    }
+    if (!pruned_files.empty()) {
+        files_holder.UnmarkFiles(pruned_files);
+        LOG_ENGINE_DEBUG_ << "Prune " << pruned_files.size() << " files by field stats, "
+                          << files_holder.HoldFiles().size() << " files left";
+    }
+}
+
+void
+DBImpl::GetPartitionKey(const std::string& collection_id, PartitionKeyPtr& key) {
+    key = nullptr;
+    meta::CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_id;
+    meta::hybrid::FieldsSchema fields_schema;
+    if (!meta_ptr_->DescribeHybridCollection(collection_schema, fields_schema).ok()) {
+        return;  // not a hybrid collection
+    }
+
+    // the key was checked when the collection was created
+    PartitionKey::FromFields(fields_schema, key);
+}
+
+Status
+DBImpl::InsertByPartitionKey(const std::string& collection_id, const PartitionKeyPtr& partition_key,
+                             const Entity& entity,
+                             const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data,
+                             const std::unordered_map<std::string, uint64_t>& attr_nbytes) {
+    auto key_iter = attr_data.find(partition_key->FieldName());
+    if (key_iter == attr_data.end()) {
+        return Status(DB_ERROR, "The entities have no value of partition key " + partition_key->FieldName());
+    }
+    if (entity.entity_count_ == 0) {
+        return Status::OK();
+    }
+
+    std::vector<int64_t> partitions;
+    partition_key->Route(key_iter->second, entity.entity_count_, partitions);
+    std::vector<std::vector<uint64_t>> partition_rows(partition_key->PartitionCount());
+    for (uint64_t i = 0; i < entity.entity_count_; ++i) {
+        partition_rows[partitions[i]].push_back(i);
+    }
+
+    auto& float_data = entity.vector_data_.begin()->second.float_data_;
+    size_t dim = float_data.size() / entity.entity_count_;
+    for (int64_t partition = 0; partition < partition_key->PartitionCount(); ++partition) {
+        auto& rows = partition_rows[partition];
+        if (rows.empty()) {
+            continue;
+        }
+
+        IDNumbers ids;
+        std::vector<float> vectors;
+        vectors.reserve(rows.size() * dim);
+        std::unordered_map<std::string, std::vector<uint8_t>> part_attr_data;
+        std::unordered_map<std::string, uint64_t> part_attr_data_size;
+        for (auto row : rows) {
+            ids.push_back(entity.id_array_[row]);
+            vectors.insert(vectors.end(), float_data.begin() + row * dim, float_data.begin() + (row + 1) * dim);
+        }
+        for (auto& pair : attr_data) {
+            auto nbytes = attr_nbytes.at(pair.first);
+            auto& data = part_attr_data[pair.first];
+            data.resize(rows.size() * nbytes);
+            for (size_t i = 0; i < rows.size(); ++i) {
+                memcpy(data.data() + i * nbytes, pair.second.data() + rows[i] * nbytes, nbytes);
+            }
+            part_attr_data_size[pair.first] = data.size();
+        }
+
+        wal::MXLogRecord record;
+        record.lsn = 0;
+        record.type = wal::MXLogType::Entity;
+        record.collection_id = collection_id;
+        record.partition_tag = PartitionKey::PartitionTag(partition);
+        record.ids = ids.data();
+        record.length = ids.size();
+        record.data = vectors.data();
+        record.data_size = vectors.size() * sizeof(float);
+        record.attr_data = part_attr_data;
+        record.attr_nbytes = attr_nbytes;
+        record.attr_data_size = part_attr_data_size;
+        auto status = ExecWalRecord(record);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 Status
 DBImpl::FlushAttrsIndex(const std::string& collection_id) {
     std::vector<int> file_types = {
@@ -1819,12 +2619,21 @@ DBImpl::FlushAttrsIndex(const std::string& collection_id) {
         return Status::OK();
     }
 
-    std::unordered_map<std::string, std::vector<uint8_t>> attr_datas;
-    std::unordered_map<std::string, int64_t> attr_sizes;
     std::unordered_map<std::string, meta::hybrid::DataType> attr_types;
     std::vector<std::string> field_names;
+    for (auto& field_schema : fields_schema.fields_schema_) {
+        if (field_schema.field_type_ != (int32_t)meta::hybrid::DataType::VECTOR) {
+            attr_types.insert(
+                std::make_pair(field_schema.field_name_, (meta::hybrid::DataType)field_schema.field_type_));
+            field_names.emplace_back(field_schema.field_name_);
+        }
+    }
 
     for (auto& segment_schema : files_holder.HoldFiles()) {
+        // the columns of every segment are its own, their indexes and stats are written with the segment
+        std::unordered_map<std::string, std::vector<uint8_t>> attr_datas;
+        std::unordered_map<std::string, int64_t> attr_sizes;
+
         std::string segment_dir;
         utils::GetParentPath(segment_schema.location_, segment_dir);
         auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
@@ -1836,14 +2645,6 @@ DBImpl::FlushAttrsIndex(const std::string& collection_id) {
             return status;
         }
 
-        for (auto& field_schema : fields_schema.fields_schema_) {
-            if (field_schema.field_type_ != (int32_t)meta::hybrid::DataType::VECTOR) {
-                attr_types.insert(
-                    std::make_pair(field_schema.field_name_, (meta::hybrid::DataType)field_schema.field_type_));
-                field_names.emplace_back(field_schema.field_name_);
-            }
-        }
-
         auto attrs = segment_ptr->attrs_ptr_->attrs;
 
         auto attr_it = attrs.begin();
@@ -1863,6 +2664,8 @@ DBImpl::FlushAttrsIndex(const std::string& collection_id) {
             return status;
         }
     }
+
+    return Status::OK();
 }
 
 Status
@@ -1883,7 +2686,7 @@ DBImpl::CreateStructuredIndex(const std::string& collection_id, const std::vecto
                 std::vector<int8_t> attr_data(attr_size);
                 memcpy(attr_data.data(), attr_datas.at(field_name).data(), attr_size);
 
-                auto int8_index_ptr = std::make_shared<knowhere::StructuredIndexSort<int8_t>>(
+                auto int8_index_ptr = knowhere::CreateStructuredIndex<int8_t>(
                     (size_t)attr_size, reinterpret_cast<const signed char*>(attr_data.data()));
                 index_ptr = std::static_pointer_cast<knowhere::Index>(int8_index_ptr);
 
@@ -1896,7 +2699,7 @@ DBImpl::CreateStructuredIndex(const std::string& collection_id, const std::vecto
                 std::vector<int16_t> attr_data(attr_size);
                 memcpy(attr_data.data(), attr_datas.at(field_name).data(), attr_size);
 
-                auto int16_index_ptr = std::make_shared<knowhere::StructuredIndexSort<int16_t>>(
+                auto int16_index_ptr = knowhere::CreateStructuredIndex<int16_t>(
                     (size_t)attr_size, reinterpret_cast<const int16_t*>(attr_data.data()));
                 index_ptr = std::static_pointer_cast<knowhere::Index>(int16_index_ptr);
 
@@ -1909,7 +2712,7 @@ DBImpl::CreateStructuredIndex(const std::string& collection_id, const std::vecto
                 std::vector<int32_t> attr_data(attr_size);
                 memcpy(attr_data.data(), attr_datas.at(field_name).data(), attr_size);
 
-                auto int32_index_ptr = std::make_shared<knowhere::StructuredIndexSort<int32_t>>(
+                auto int32_index_ptr = knowhere::CreateStructuredIndex<int32_t>(
                     (size_t)attr_size, reinterpret_cast<const int32_t*>(attr_data.data()));
                 index_ptr = std::static_pointer_cast<knowhere::Index>(int32_index_ptr);
 
@@ -1922,7 +2725,7 @@ DBImpl::CreateStructuredIndex(const std::string& collection_id, const std::vecto
                 std::vector<int64_t> attr_data(attr_size);
                 memcpy(attr_data.data(), attr_datas.at(field_name).data(), attr_size);
 
-                auto int64_index_ptr = std::make_shared<knowhere::StructuredIndexSort<int64_t>>(
+                auto int64_index_ptr = knowhere::CreateStructuredIndex<int64_t>(
                     (size_t)attr_size, reinterpret_cast<const int64_t*>(attr_data.data()));
                 index_ptr = std::static_pointer_cast<knowhere::Index>(int64_index_ptr);
 
@@ -1935,7 +2738,7 @@ DBImpl::CreateStructuredIndex(const std::string& collection_id, const std::vecto
                 std::vector<float> attr_data(attr_size);
                 memcpy(attr_data.data(), attr_datas.at(field_name).data(), attr_size);
 
-                auto float_index_ptr = std::make_shared<knowhere::StructuredIndexSort<float>>(
+                auto float_index_ptr = knowhere::CreateStructuredIndex<float>(
                     (size_t)attr_size, reinterpret_cast<const float*>(attr_data.data()));
                 index_ptr = std::static_pointer_cast<knowhere::Index>(float_index_ptr);
 
@@ -1948,7 +2751,7 @@ DBImpl::CreateStructuredIndex(const std::string& collection_id, const std::vecto
                 std::vector<double> attr_data(attr_size);
                 memcpy(attr_data.data(), attr_datas.at(field_name).data(), attr_size);
 
-                auto double_index_ptr = std::make_shared<knowhere::StructuredIndexSort<double>>(
+                auto double_index_ptr = knowhere::CreateStructuredIndex<double>(
                     (size_t)attr_size, reinterpret_cast<const double*>(attr_data.data()));
                 index_ptr = std::static_pointer_cast<knowhere::Index>(double_index_ptr);
 
@@ -2021,6 +2824,129 @@ DBImpl::DropIndex(const std::string& collection_id) {
     return status;
 }
 
+Status
+DBImpl::TuneIndex(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+                  const milvus::json& tune_params, milvus::json& report) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_id;
+    auto status = DescribeCollection(collection_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (utils::IsBinaryMetricType(collection_schema.metric_type_)) {
+        return Status(DB_ERROR, "Index tuning only supports float vector collections");
+    }
+
+    int64_t sample_rows, nq, topk;
+    double target_recall;
+    bool apply;
+    std::vector<int32_t> index_types;
+    try {
+        sample_rows = tune_params.value("sample_rows", IndexTuner::DEFAULT_SAMPLE_ROWS);
+        nq = tune_params.value("queries", IndexTuner::DEFAULT_QUERIES);
+        topk = tune_params.value("topk", IndexTuner::DEFAULT_TOPK);
+        target_recall = tune_params.value("target_recall", IndexTuner::DEFAULT_TARGET_RECALL);
+        apply = tune_params.value("apply", false);
+        index_types = tune_params.value(
+            "index_types", std::vector<int32_t>{(int32_t)EngineType::FAISS_IVFFLAT, (int32_t)EngineType::FAISS_IVFSQ8,
+                                                (int32_t)EngineType::FAISS_PQ, (int32_t)EngineType::HNSW});
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, std::string("Invalid tune params: ") + ex.what());
+    }
+    if (sample_rows < 1 || nq < 1 || topk < 1 || target_recall <= 0.0 || target_recall > 1.0) {
+        return Status(DB_ERROR, "Invalid tune params: sample_rows, queries, topk or target_recall out of range");
+    }
+
+    // the files of a segment share its raw vectors
+    meta::FilesHolder files_holder;
+    std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
+                                meta::SegmentSchema::FILE_TYPE::BACKUP, meta::SegmentSchema::FILE_TYPE::INDEX};
+    std::vector<meta::CollectionSchema> collection_array;
+    status = meta_ptr_->ShowPartitions(collection_id, collection_array);
+    collection_array.push_back(collection_schema);
+    status = meta_ptr_->FilesByTypeEx(collection_array, file_types, files_holder);
+    if (!status.ok()) {
+        return status;
+    }
+    std::map<std::string, meta::SegmentSchema> segments;
+    int64_t total_rows = 0;
+    for (auto& file : files_holder.HoldFiles()) {
+        if (file.row_count_ > 0 && segments.emplace(file.segment_id_, file).second) {
+            total_rows += file.row_count_;
+        }
+    }
+    if (total_rows < 2) {
+        return Status(DB_ERROR, "Too few entities to tune the index of collection " + collection_id);
+    }
+
+    // the rows of each segment sampled evenly, every stride-th one held out as a query
+    int64_t dimension = collection_schema.dimension_;
+    int64_t wanted = std::min(total_rows, sample_rows + nq);
+    std::vector<float> vectors;
+    for (auto& item : segments) {
+        auto& file = item.second;
+        int64_t count = std::min(file.row_count_, (file.row_count_ * wanted + total_rows - 1) / total_rows);
+        std::vector<int64_t> offsets(count);
+        for (int64_t i = 0; i < count; ++i) {
+            offsets[i] = i * file.row_count_ / count;
+        }
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        std::vector<uint8_t> raw_vectors;
+        status = segment_reader.LoadVectors(offsets, dimension * sizeof(float), raw_vectors);
+        if (!status.ok()) {
+            return status;
+        }
+        auto begin = reinterpret_cast<const float*>(raw_vectors.data());
+        vectors.insert(vectors.end(), begin, begin + count * dimension);
+    }
+    files_holder.ReleaseFiles();
+
+    int64_t rows = vectors.size() / dimension;
+    nq = std::min(nq, rows / 2);
+    int64_t stride = rows / nq;
+    std::vector<float> data, queries;
+    data.reserve((rows - nq) * dimension);
+    queries.reserve(nq * dimension);
+    for (int64_t i = 0; i < rows; ++i) {
+        auto& target = (i % stride == 0 && i / stride < nq) ? queries : data;
+        target.insert(target.end(), vectors.begin() + i * dimension, vectors.begin() + (i + 1) * dimension);
+    }
+    vectors = std::vector<float>();
+
+    std::vector<EngineType> engine_types;
+    for (auto index_type : index_types) {
+        engine_types.push_back((EngineType)index_type);
+    }
+    LOG_ENGINE_DEBUG_ << "Tune index of collection " << collection_id << " on " << rows - nq << " entities and " << nq
+                      << " queries";
+    IndexTuner tuner((MetricType)collection_schema.metric_type_, dimension, topk, target_recall);
+    status = tuner.Tune(engine_types, data, queries);
+    if (!status.ok()) {
+        return status;
+    }
+    report = tuner.Report();
+
+    if (apply) {
+        IndexTuner::Point point;
+        if (!tuner.Recommend(point)) {
+            return Status(DB_ERROR, "No index candidate reaches recall " + std::to_string(target_recall));
+        }
+        CollectionIndex index;
+        index.engine_type_ = (int32_t)point.engine_type_;
+        index.metric_type_ = collection_schema.metric_type_;
+        index.extra_params_ = point.build_params_;
+        status = CreateIndex(context, collection_id, index);
+        report["applied"] = status.ok();
+    }
+    return status;
+}
+
 Status
 DBImpl::QueryByIDs(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                    const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
@@ -2160,12 +3086,15 @@ DBImpl::HybridQuery(const std::shared_ptr<server::Context>& context, const std::
         return SHUTDOWN_ERROR;
     }
 
+    // once per query, the segments share the tree
+    query::FuseRangeQueries(general_query->bin);
+
     Status status;
     meta::FilesHolder files_holder;
     if (partition_tags.empty()) {
         // no partition tag specified, means search in whole table
         // get all table files from parent table
-        status = meta_ptr_->FilesToSearch(collection_id, files_holder);
+        status = GetFilesToSearch(collection_id, files_holder);
         if (!status.ok()) {
             return status;
         }
@@ -2175,14 +3104,34 @@ DBImpl::HybridQuery(const std::shared_ptr<server::Context>& context, const std::
         if (!status.ok()) {
             return status;
         }
+
+        // the key partitions none of whose values may satisfy the query are skipped
+        std::unordered_set<std::string> pruned_tags;
+        PartitionKeyPtr partition_key;
+        GetPartitionKey(collection_id, partition_key);
+        if (partition_key != nullptr) {
+            for (int64_t i = 0; i < partition_key->PartitionCount(); ++i) {
+                if (!partition_key->PartitionMayMatch(i, general_query)) {
+                    pruned_tags.insert(PartitionKey::PartitionTag(i));
+                }
+            }
+        }
+
         for (auto& schema : partition_array) {
-            status = meta_ptr_->FilesToSearch(schema.collection_id_, files_holder);
+            if (pruned_tags.find(schema.partition_tag_) != pruned_tags.end()) {
+                continue;
+            }
+            status = GetFilesToSearch(schema.collection_id_, files_holder);
             if (!status.ok()) {
                 return Status(DB_ERROR, "get files to search failed in HybridQuery");
             }
         }
+        if (!pruned_tags.empty()) {
+            LOG_ENGINE_DEBUG_ << "Skip " << pruned_tags.size() << " partitions by the partition key of "
+                              << collection_id;
+        }
 
-        if (files_holder.HoldFiles().empty()) {
+        if (files_holder.HoldDescs().empty()) {
             return Status::OK();  // no files to search
         }
     } else {
@@ -2191,17 +3140,22 @@ DBImpl::HybridQuery(const std::shared_ptr<server::Context>& context, const std::
         GetPartitionsByTags(collection_id, partition_tags, partition_name_array);
 
         for (auto& partition_name : partition_name_array) {
-            status = meta_ptr_->FilesToSearch(partition_name, files_holder);
+            status = GetFilesToSearch(partition_name, files_holder);
             if (!status.ok()) {
                 return Status(DB_ERROR, "get files to search failed in HybridQuery");
             }
         }
 
-        if (files_holder.HoldFiles().empty()) {
+        if (files_holder.HoldDescs().empty()) {
             return Status::OK();
         }
     }
 
+    PruneFilesByFieldsStats(general_query, files_holder);
+    if (files_holder.HoldDescs().empty()) {
+        return Status::OK();  // no segment can match
+    }
+
     cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
     status = HybridQueryAsync(query_ctx, collection_id, files_holder, general_query, query_ptr, field_names, attr_type,
                               result);
@@ -2225,13 +3179,47 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         return SHUTDOWN_ERROR;
     }
 
+    // the generation is read before the files, a flush from now on makes the result stale
+    uint64_t generation = 0;
+    if (result_cache_ != nullptr) {
+        generation = result_cache_->Generation(collection_id);
+    }
+
+    // the insert buffer is copied before the files are read, a flush in between is then found in either
+    MemSnapshot buffer;
+    if (options_.search_insert_buffer_) {
+        std::set<std::string> buffer_ids;
+        if (partition_tags.empty()) {
+            buffer_ids.insert(collection_id);
+            PartitionIndex::PartitionsPtr partitions;
+            if (GetPartitions(collection_id, partitions).ok()) {
+                for (auto& partition : *partitions) {
+                    buffer_ids.insert(partition.second);
+                }
+            }
+        } else {
+            GetPartitionsByTags(collection_id, partition_tags, buffer_ids);
+        }
+        mem_mgr_->Snapshot(buffer_ids, buffer);
+    }
+
+    // the cached results don't see the insert buffer
+    if (result_cache_ != nullptr && buffer.Empty()) {
+        if (result_cache_->Get(collection_id, partition_tags, k, extra_params, vectors, result_ids,
+                               result_distances)) {
+            LOG_ENGINE_DEBUG_ << "Query result of collection " << collection_id << " served from result cache";
+            return Status::OK();
+        }
+    }
+
+    auto meta_start = std::chrono::steady_clock::now();
     Status status;
     meta::FilesHolder files_holder;
     if (partition_tags.empty()) {
 #if 0
         // no partition tag specified, means search in whole collection
         // get all collection files from parent collection
-        status = meta_ptr_->FilesToSearch(collection_id, files_holder);
+        status = GetFilesToSearch(collection_id, files_holder);
         if (!status.ok()) {
             return status;
         }
@@ -2239,22 +3227,24 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         std::vector<meta::CollectionSchema> partition_array;
         status = meta_ptr_->ShowPartitions(collection_id, partition_array);
         for (auto& schema : partition_array) {
-            status = meta_ptr_->FilesToSearch(schema.collection_id_, files_holder);
+            status = GetFilesToSearch(schema.collection_id_, files_holder);
         }
 #else
         // no partition tag specified, means search in whole collection
         // get files from root collection
-        status = meta_ptr_->FilesToSearch(collection_id, files_holder);
+        status = GetFilesToSearch(collection_id, files_holder);
         if (!status.ok()) {
             return status;
         }
 
         // get files from partitions
         std::set<std::string> partition_ids;
-        std::vector<meta::CollectionSchema> partition_array;
-        status = meta_ptr_->ShowPartitions(collection_id, partition_array);
-        for (auto& id : partition_array) {
-            partition_ids.insert(id.collection_id_);
+        PartitionIndex::PartitionsPtr partitions;
+        status = GetPartitions(collection_id, partitions);
+        if (status.ok()) {
+            for (auto& partition : *partitions) {
+                partition_ids.insert(partition.second);
+            }
         }
 
         status = meta_ptr_->FilesToSearchEx(collection_id, partition_ids, files_holder);
@@ -2263,7 +3253,7 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         }
 #endif
 
-        if (files_holder.HoldFiles().empty()) {
+        if (files_holder.HoldDescs().empty() && buffer.Empty()) {
             return Status::OK();  // no files to search
         }
     } else {
@@ -2276,7 +3266,7 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         }
 
         for (auto& partition_name : partition_name_array) {
-            status = meta_ptr_->FilesToSearch(partition_name, files_holder);
+            status = GetFilesToSearch(partition_name, files_holder);
         }
 #else
         std::set<std::string> partition_name_array;
@@ -2291,17 +3281,142 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         }
 
         status = meta_ptr_->FilesToSearchEx(collection_id, partition_ids, files_holder);
-#endif
-        if (files_holder.HoldFiles().empty()) {
-            return Status::OK();  // no files to search
+#endif
+        if (files_holder.HoldDescs().empty() && buffer.Empty()) {
+            return Status::OK();  // no files to search
+        }
+    }
+
+    auto meta_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - meta_start).count();
+    server::Metrics::GetInstance().SearchStageObserve(server::SEARCH_STAGE_META, collection_id, "", meta_us);
+
+    // a sampled search holds its files until the recall sampler has searched them exactly,
+    // the buffered vectors are not in the files
+    std::shared_ptr<meta::FilesHolder> sample_files;
+    if (recall_sampler_ != nullptr && buffer.Empty() && recall_sampler_->ShouldSample()) {
+        sample_files = std::make_shared<meta::FilesHolder>();
+        sample_files->MarkFiles(files_holder.HoldDescs());
+    }
+
+    if (!files_holder.HoldDescs().empty()) {
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+        status = QueryAsync(tracer.Context(), collection_id, files_holder, k, extra_params, vectors, result_ids,
+                            result_distances);
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    } else {
+        status = Status::OK();  // only the insert buffer to search
+    }
+
+    if (status.ok() && !buffer.Empty()) {
+        status = buffer.Search(k, vectors, result_ids, result_distances);
+    }
+
+    if (status.ok() && sample_files != nullptr) {
+        recall_sampler_->Submit(collection_id, sample_files, k, vectors, result_ids);
+    }
+
+    if (status.ok() && result_cache_ != nullptr && buffer.Empty()) {
+        result_cache_->Put(collection_id, partition_tags, k, extra_params, vectors, generation, result_ids,
+                           result_distances);
+    }
+    return status;
+}
+
+Status
+DBImpl::QueryCollections(const std::shared_ptr<server::Context>& context,
+                         const std::vector<std::string>& collection_ids, uint64_t k,
+                         const milvus::json& extra_params, VectorsData& vectors, std::vector<ResultIds>& result_ids,
+                         std::vector<ResultDistances>& result_distances) {
+    milvus::server::ContextChild tracer(context, "QueryCollections");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+    if (collection_ids.empty()) {
+        return Status(DB_ERROR, "No collection to search");
+    }
+
+    // the files of a partition go to the group of its collection
+    Status status;
+    meta::FilesHolder files_holder;
+    std::unordered_map<std::string, size_t> file_groups;
+    std::vector<MemSnapshot> buffers(collection_ids.size());
+    meta::CollectionSchema first_schema;
+    for (size_t g = 0; g < collection_ids.size(); ++g) {
+        auto& collection_id = collection_ids[g];
+        meta::CollectionSchema collection_schema;
+        collection_schema.collection_id_ = collection_id;
+        status = DescribeCollection(collection_schema);
+        if (!status.ok()) {
+            return status;
+        }
+        if (!collection_schema.owner_collection_.empty()) {
+            return Status(DB_ERROR, "Collection " + collection_id + " is a partition");
+        }
+        if (g == 0) {
+            first_schema = collection_schema;
+        } else if (collection_schema.metric_type_ != first_schema.metric_type_ ||
+                   collection_schema.dimension_ != first_schema.dimension_) {
+            return Status(DB_ERROR, "Collection " + collection_id + " doesn't match the metric type and dimension of " +
+                                        first_schema.collection_id_);
+        }
+        if (file_groups.find(collection_id) != file_groups.end()) {
+            return Status(DB_ERROR, "Collection " + collection_id + " is searched twice");
+        }
+
+        std::set<std::string> partition_ids;
+        PartitionIndex::PartitionsPtr partitions;
+        if (GetPartitions(collection_id, partitions).ok()) {
+            for (auto& partition : *partitions) {
+                partition_ids.insert(partition.second);
+            }
+        }
+        file_groups[collection_id] = g;
+        for (auto& partition_id : partition_ids) {
+            file_groups[partition_id] = g;
+        }
+
+        // the insert buffer is copied before the files are read, as by Query()
+        if (options_.search_insert_buffer_) {
+            std::set<std::string> buffer_ids = partition_ids;
+            buffer_ids.insert(collection_id);
+            mem_mgr_->Snapshot(buffer_ids, buffers[g]);
+        }
+
+        status = GetFilesToSearch(collection_id, files_holder);
+        if (!status.ok()) {
+            return status;
+        }
+        status = meta_ptr_->FilesToSearchEx(collection_id, partition_ids, files_holder);
+        if (!status.ok()) {
+            return status;
         }
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    // every group gets its rows, whether any file of it was searched or not
+    size_t nq = vectors.vector_count_;
+    ResultIds ids(collection_ids.size() * nq * k, -1);
+    ResultDistances distances(collection_ids.size() * nq * k, 0.0);
+    if (!files_holder.HoldDescs().empty()) {
+        status = QueryAsync(tracer.Context(), collection_ids.front(), files_holder, k, extra_params, vectors, ids,
+                            distances, file_groups);
+        if (!status.ok()) {
+            return status;
+        }
+    }
 
-    return status;
+    result_ids.resize(collection_ids.size());
+    result_distances.resize(collection_ids.size());
+    for (size_t g = 0; g < collection_ids.size(); ++g) {
+        result_ids[g].assign(ids.begin() + g * nq * k, ids.begin() + (g + 1) * nq * k);
+        result_distances[g].assign(distances.begin() + g * nq * k, distances.begin() + (g + 1) * nq * k);
+        status = buffers[g].Search(k, vectors, result_ids[g], result_distances[g]);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
 }
 
 Status
@@ -2327,13 +3442,14 @@ DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std
         return status;
     }
 
-    milvus::engine::meta::SegmentsSchema& search_files = files_holder.HoldFiles();
+    auto& search_files = files_holder.HoldDescs();
     if (search_files.empty()) {
         return Status(DB_ERROR, "Invalid file id");
     }
 
     cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
+    status = QueryAsync(tracer.Context(), search_files.front()->collection_id_, files_holder, k, extra_params, vectors,
+                        result_ids, result_distances);
     cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
 
     return status;
@@ -2352,13 +3468,118 @@ DBImpl::Size(uint64_t& result) {
 // internal methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 Status
-DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesHolder& files_holder, uint64_t k,
-                   const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
-                   ResultDistances& result_distances) {
+DBImpl::GetFilesToSearch(const std::string& collection_id, meta::FilesHolder& files_holder) {
+    if (replica_tailer_ != nullptr && replica_tailer_->Ready()) {
+        return replica_tailer_->FilesToSearch(collection_id, files_holder);
+    }
+    return meta_ptr_->FilesToSearch(collection_id, files_holder);
+}
+
+Status
+DBImpl::GetFilesToPreload(const std::string& collection_id, meta::FilesHolder& files_holder) {
+    auto status = GetFilesToSearch(collection_id, files_holder);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::CollectionSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(collection_id, partition_array);
+
+    std::set<std::string> partition_ids;
+    for (auto& schema : partition_array) {
+        partition_ids.insert(schema.collection_id_);
+    }
+
+    return meta_ptr_->FilesToSearchEx(collection_id, partition_ids, files_holder);
+}
+
+Status
+DBImpl::PreloadFiles(const std::shared_ptr<server::Context>& context, const meta::SegmentsSchema& files,
+                     const PreloadCheck& check, const PreloadFilter& filter) {
+    // the files are queued in order, so the threads start them in order too
+    std::mutex mutex;
+    Status status;
+    bool stop = false;
+    int64_t size = 0;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(files.size());
+    for (auto& file : files) {
+        futures.emplace_back(preload_thread_pool_.enqueue([&, file]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                // client break the connection, no need to continue
+                if (context && context->IsConnectionBroken()) {
+                    LOG_ENGINE_DEBUG_ << "Client connection broken, stop load collection";
+                    stop = true;
+                }
+                if (stop || !status.ok() || !initialized_.load(std::memory_order_acquire)) {
+                    return;
+                }
+                if (filter && !filter(file)) {
+                    return;
+                }
+            }
+
+            ExecutionEnginePtr engine = BuildPreloadEngine(file);
+            fiu_do_on("DBImpl.PreloadCollection.null_engine", engine = nullptr);
+            if (engine == nullptr) {
+                LOG_ENGINE_ERROR_ << "Invalid engine type";
+                std::lock_guard<std::mutex> lock(mutex);
+                status = Status(DB_ERROR, "Invalid engine type");
+                return;
+            }
+
+            // first touch the pages of the file on the numa node its searches are sent to
+            auto& numa = scheduler::NumaTopology::GetInstance();
+            if (options_.numa_aware_ && numa.NodeNum() > 1) {
+                numa.BindThread(numa.NodeOfFile(file.id_));
+            }
+
+            Status load_status;
+            try {
+                fiu_do_on("DBImpl.PreloadCollection.engine_throw_exception", throw std::exception());
+                preload_limiter_.Acquire(file.file_size_);
+                std::string msg = "Pre-loaded file: " + file.file_id_ + " size: " + std::to_string(file.file_size_);
+                TimeRecorderAuto rc_1(msg);
+                load_status = engine->Load(true);
+            } catch (std::exception& ex) {
+                std::string msg = "Pre-load collection encounter exception: " + std::string(ex.what());
+                LOG_ENGINE_ERROR_ << msg;
+                load_status = Status(DB_ERROR, msg);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!load_status.ok()) {
+                if (status.ok()) {
+                    status = load_status;
+                }
+                return;
+            }
+            if (stop || !status.ok()) {
+                return;
+            }
+            size += engine->Size();
+            status = check(size, stop);
+        }));
+    }
+
+    for (auto& future : futures) {
+        future.wait();
+    }
+    return status;
+}
+
+Status
+DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+                   meta::FilesHolder& files_holder, uint64_t k, const milvus::json& extra_params, VectorsData& vectors,
+                   ResultIds& result_ids, ResultDistances& result_distances,
+                   const std::unordered_map<std::string, size_t>& file_groups) {
     milvus::server::ContextChild tracer(context, "Query Async");
     server::CollectQueryMetrics metrics(vectors.vector_count_);
 
-    milvus::engine::meta::SegmentsSchema& files = files_holder.HoldFiles();
+    // the job shares the descriptors of the held files
+    auto& files = files_holder.HoldDescs();
     if (files.size() > milvus::scheduler::TASK_TABLE_MAX_COUNT) {
         std::string msg =
             "Search files count exceed scheduler limit: " + std::to_string(milvus::scheduler::TASK_TABLE_MAX_COUNT);
@@ -2366,25 +3587,31 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
         return Status(DB_ERROR, msg);
     }
 
-    TimeRecorder rc("");
+    ScopedTimer rc("DBImpl::QueryAsync");
 
     // step 1: construct search job
     LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files.size());
     scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(tracer.Context(), k, extra_params, vectors);
+    job->SetCollectionId(collection_id);
+    size_t groups = 1;
+    for (auto& pair : file_groups) {
+        groups = std::max(groups, pair.second + 1);
+    }
+    job->SetResultGroups(groups);
     for (auto& file : files) {
-        scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
-        job->AddIndexFile(file_ptr);
+        auto iter = file_groups.find(file->collection_id_);
+        job->AddIndexFile(file, iter != file_groups.end() ? iter->second : 0);
     }
+    job->RouteIndexFiles();
+    merge_mgr_ptr_->RecordSearch(files);
 
-    // Suspend builder
-    SuspendIfFirst();
-
-    // step 2: put search job to scheduler and wait result
+    // step 2: put search job to scheduler and wait result, the index builds are throttled meanwhile
+    build_throttle_->SearchBegin();
+    auto search_begin = std::chrono::steady_clock::now();
     scheduler::JobMgrInst::GetInstance()->Put(job);
     job->WaitResult();
-
-    // Resume builder
-    ResumeIfLast();
+    auto search_cost = std::chrono::steady_clock::now() - search_begin;
+    build_throttle_->SearchEnd(std::chrono::duration_cast<std::chrono::microseconds>(search_cost).count());
 
     files_holder.ReleaseFiles();
     if (!job->GetStatus().ok()) {
@@ -2394,7 +3621,6 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     // step 3: construct results
     result_ids = job->GetResultIds();
     result_distances = job->GetResultDistances();
-    rc.ElapseFromBegin("Engine query totally cost");
 
     return Status::OK();
 }
@@ -2429,21 +3655,21 @@ DBImpl::HybridQueryAsync(const std::shared_ptr<server::Context>& context, const
 
     // step 1: construct search job
     VectorsData vectors;
-    milvus::engine::meta::SegmentsSchema& files = files_holder.HoldFiles();
-    LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files_holder.HoldFiles().size());
+    auto& files = files_holder.HoldDescs();
+    LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files.size());
     scheduler::SearchJobPtr job =
         std::make_shared<scheduler::SearchJob>(query_async_ctx, general_query, query_ptr, attr_type, vectors);
     for (auto& file : files) {
-        scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
-        job->AddIndexFile(file_ptr);
+        job->AddIndexFile(file);
     }
+    merge_mgr_ptr_->RecordSearch(files);
 
     // step 2: put search job to scheduler and wait result
     scheduler::JobMgrInst::GetInstance()->Put(job);
     job->WaitResult();
 
-    files_holder.ReleaseFiles();
     if (!job->GetStatus().ok()) {
+        files_holder.ReleaseFiles();
         return job->GetStatus();
     }
 
@@ -2452,30 +3678,17 @@ DBImpl::HybridQueryAsync(const std::shared_ptr<server::Context>& context, const
     result.result_ids_ = job->GetResultIds();
     result.result_distances_ = job->GetResultDistances();
 
-    // step 4: get entities by result ids
-    auto status = GetEntitiesByID(collection_id, result.result_ids_, result.vectors_, result.attrs_);
+    // step 4: fetch the requested fields of the final top k, the files are held until then
+    std::vector<meta::SegmentDescPtr> sources;
+    job->GetResultSources(sources);
+    auto status = MaterializeEntities(result.result_ids_, sources, field_names, attr_type, result.vectors_,
+                                      result.attrs_);
+    files_holder.ReleaseFiles();
     if (!status.ok()) {
         query_async_ctx->GetTraceContext()->GetSpan()->Finish();
         return status;
     }
 
-    // step 5: filter entities by field names
-    std::vector<engine::AttrsData> filter_attrs;
-    for (auto attr : result.attrs_) {
-        AttrsData attrs_data;
-        attrs_data.attr_type_ = attr.attr_type_;
-        attrs_data.attr_count_ = attr.attr_count_;
-        attrs_data.id_array_ = attr.id_array_;
-        for (auto& name : field_names) {
-            if (attr.attr_data_.find(name) != attr.attr_data_.end()) {
-                attrs_data.attr_data_.insert(std::make_pair(name, attr.attr_data_.at(name)));
-            }
-        }
-        filter_attrs.emplace_back(attrs_data);
-    }
-
-    result.attrs_ = filter_attrs;
-
     rc.ElapseFromBegin("Engine query totally cost");
 
     query_async_ctx->GetTraceContext()->GetSpan()->Finish();
@@ -2546,6 +3759,10 @@ DBImpl::StartMetricTask() {
     server::Metrics::GetInstance().GPUPercentGaugeSet();
     server::Metrics::GetInstance().GPUMemoryUsageGaugeSet();
     server::Metrics::GetInstance().OctetsSet();
+    server::Metrics::GetInstance().ContentionSet();
+    server::Metrics::GetInstance().MemoryUsageSet();
+    server::Metrics::GetInstance().IndexBuildProgressSet();
+    server::Metrics::GetInstance().StartupStagesSet();
 
     server::Metrics::GetInstance().CPUCoreUsagePercentSet();
     server::Metrics::GetInstance().GPUTemperature();
@@ -2696,6 +3913,13 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
                               << " reason:" << status.message();
         }
 
+        int64_t reclaimed_bytes = 0;
+        status = merge_mgr_ptr_->CompactFiles(collection_id, reclaimed_bytes);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to compact files for collection: " << collection_id
+                              << " reason:" << status.message();
+        }
+
         if (!initialized_.load(std::memory_order_acquire)) {
             LOG_ENGINE_DEBUG_ << "Server will shutdown, skip merge action for collection: " << collection_id;
             break;
@@ -2704,6 +3928,13 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
 
     //    meta_ptr_->Archive();
 
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_expire_time_ >= std::chrono::seconds(EXPIRE_INTERVAL)) {
+        last_expire_time_ = now;
+        const std::lock_guard<std::mutex> lock(flush_merge_compact_mutex_);
+        ExpireSegments();
+    }
+
     {
         uint64_t timeout = (options_.file_cleanup_timeout_ >= 0) ? options_.file_cleanup_timeout_ : 10;
         uint64_t ttl = timeout * meta::SECOND;  // default: file will be hard-deleted few seconds after soft-deleted
@@ -2713,6 +3944,63 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
     // LOG_ENGINE_TRACE_ << " Background merge thread exit";
 }
 
+void
+DBImpl::ExpireSegments() {
+    std::vector<meta::CollectionSchema> collections;
+    auto status = meta_ptr_->AllCollections(collections, true);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << "Failed to get the collections to expire: " << status.message();
+        return;
+    }
+
+    for (auto& collection : collections) {
+        int64_t ttl_days = utils::GetCollectionTTL(collection.flag_);
+        if (ttl_days <= 0) {
+            continue;
+        }
+
+        std::vector<meta::CollectionSchema> collection_array;
+        status = meta_ptr_->ShowPartitions(collection.collection_id_, collection_array);
+        collection_array.push_back(collection);
+        std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
+                                    meta::SegmentSchema::FILE_TYPE::INDEX, meta::SegmentSchema::FILE_TYPE::BACKUP};
+        meta::FilesHolder files_holder;
+        status = meta_ptr_->FilesByTypeEx(collection_array, file_types, files_holder);
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to get the files to expire of " << collection.collection_id_ << ": "
+                                << status.message();
+            continue;
+        }
+
+        // the date of a file is the day of its last insert, a segment is dropped once all its files are expired
+        meta::DateT expire_date = utils::GetDateWithDelta(-ttl_days);
+        std::unordered_map<std::string, bool> segment_expired;
+        for (auto& file : files_holder.HoldFiles()) {
+            auto iter = segment_expired.emplace(file.segment_id_, true).first;
+            iter->second = iter->second && file.date_ < expire_date;
+        }
+        meta::SegmentsSchema files_to_drop;
+        for (auto& file : files_holder.HoldFiles()) {
+            if (segment_expired[file.segment_id_]) {
+                files_to_drop.push_back(file);
+                files_to_drop.back().file_type_ = meta::SegmentSchema::TO_DELETE;
+            }
+        }
+        if (files_to_drop.empty()) {
+            continue;
+        }
+
+        status = meta_ptr_->UpdateCollectionFiles(files_to_drop);
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to drop the expired files of " << collection.collection_id_ << ": "
+                                << status.message();
+            continue;
+        }
+        InvalidateQueryResults({collection.collection_id_});
+        LOG_ENGINE_DEBUG_ << "Dropped " << files_to_drop.size() << " expired files of " << collection.collection_id_;
+    }
+}
+
 void
 DBImpl::StartBuildIndexTask() {
     // build index has been finished?
@@ -2836,8 +4124,8 @@ DBImpl::GetPartitionByTag(const std::string& collection_id, const std::string& p
 Status
 DBImpl::GetPartitionsByTags(const std::string& collection_id, const std::vector<std::string>& partition_tags,
                             std::set<std::string>& partition_name_array) {
-    std::vector<meta::CollectionSchema> partition_array;
-    auto status = meta_ptr_->ShowPartitions(collection_id, partition_array);
+    PartitionIndex::PartitionsPtr partitions;
+    auto status = GetPartitions(collection_id, partitions);
 
     for (auto& tag : partition_tags) {
         // trim side-blank of tag, only compare valid characters
@@ -2850,10 +4138,8 @@ DBImpl::GetPartitionsByTags(const std::string& collection_id, const std::vector<
             return status;
         }
 
-        for (auto& schema : partition_array) {
-            if (StringHelpFunctions::IsRegexMatch(schema.partition_tag_, valid_tag)) {
-                partition_name_array.insert(schema.collection_id_);
-            }
+        if (partitions != nullptr) {
+            PartitionIndex::MatchTag(*partitions, valid_tag, partition_name_array);
         }
     }
 
@@ -2864,6 +4150,31 @@ DBImpl::GetPartitionsByTags(const std::string& collection_id, const std::vector<
     return Status::OK();
 }
 
+Status
+DBImpl::GetPartitions(const std::string& collection_id, PartitionIndex::PartitionsPtr& partitions) {
+    // the generation is read before the meta, a partition created or dropped from now on drops the load
+    uint64_t generation = 0;
+    if (partition_index_ != nullptr) {
+        partitions = partition_index_->Get(collection_id);
+        if (partitions != nullptr) {
+            return Status::OK();
+        }
+        generation = partition_index_->Generation(collection_id);
+    }
+
+    std::vector<meta::CollectionSchema> partition_array;
+    auto status = meta_ptr_->ShowPartitions(collection_id, partition_array);
+    if (!status.ok()) {
+        return status;
+    }
+
+    partitions = PartitionIndex::Build(partition_array);
+    if (partition_index_ != nullptr) {
+        partition_index_->Put(collection_id, generation, partitions);
+    }
+    return Status::OK();
+}
+
 Status
 DBImpl::UpdateCollectionIndexRecursively(const std::string& collection_id, const CollectionIndex& index) {
     DropIndex(collection_id);
@@ -3035,6 +4346,9 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
             wal_mgr_->CollectionFlushed(collection_id, lsn);
         }
 
+        // flushed inserts and deletes become searchable
+        InvalidateQueryResults(target_collection_names);
+
         std::set<std::string> merge_collection_ids;
         for (auto& collection : target_collection_names) {
             merge_collection_ids.insert(collection);
@@ -3043,10 +4357,9 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
         return max_lsn;
     };
 
-    auto force_flush_if_mem_full = [&]() -> uint64_t {
-        if (mem_mgr_->GetCurrentMem() > options_.insert_buffer_size_) {
-            LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] ", "insert", 0) << "Insert buffer size exceeds limit. Force flush";
-            InternalFlush();
+    auto force_flush_if_mem_full = [&]() {
+        if (!wal_parallel_replay_) {
+            FlushInsertBuffer();
         }
     };
 
@@ -3192,6 +4505,82 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
     return status;
 }
 
+void
+DBImpl::InvalidateQueryResults(const std::set<std::string>& collection_ids) {
+    if (result_cache_ == nullptr) {
+        return;
+    }
+
+    // results are cached under the collection searched, a partition invalidates its owner
+    for (auto& collection_id : collection_ids) {
+        meta::CollectionSchema collection_schema;
+        collection_schema.collection_id_ = collection_id;
+        auto status = meta_ptr_->DescribeCollection(collection_schema);
+        if (status.ok() && !collection_schema.owner_collection_.empty()) {
+            result_cache_->Invalidate(collection_schema.owner_collection_);
+        } else {
+            result_cache_->Invalidate(collection_id);
+        }
+    }
+}
+
+void
+DBImpl::RecoverWal() {
+    TimeRecorderAuto rc("Wal recovery");
+
+    wal_parallel_replay_ = options_.wal_recovery_thread_num_ > 1;
+    wal::MXLogReplayer replayer(options_.wal_recovery_thread_num_,
+                                [&](const wal::MXLogRecord& record) { return ExecWalRecord(record); });
+
+    double logged_progress = 0.0;
+    while (true) {
+        wal::MXLogRecord record;
+        auto error_code = wal_mgr_->GetNextRecovery(record);
+        if (error_code != WAL_SUCCESS) {
+            replayer.Barrier();
+            wal_parallel_replay_ = false;
+            throw Exception(error_code, "Wal recovery error!");
+        }
+        if (record.type == wal::MXLogType::None) {
+            break;
+        }
+
+        switch (record.type) {
+            case wal::MXLogType::InsertBinary:
+            case wal::MXLogType::InsertVector:
+            case wal::MXLogType::Entity:
+            case wal::MXLogType::Delete: {
+                replayer.Dispatch(record);
+                break;
+            }
+            default: {
+                // flush and the others may touch all the collections, wait for the records before them
+                replayer.Barrier();
+                ExecWalRecord(record);
+                break;
+            }
+        }
+
+        if (wal_parallel_replay_ && mem_mgr_->GetCurrentMem() > options_.insert_buffer_size_) {
+            replayer.Barrier();
+            FlushInsertBuffer();
+        }
+
+        double progress = wal_mgr_->RecoveryProgress(record.lsn);
+        server::Metrics::GetInstance().WalRecoveryProgressSet(progress);
+        if (progress - logged_progress >= 0.1) {
+            LOG_ENGINE_INFO_ << "Wal recovery progress " << (int32_t)(progress * 100) << "%";
+            logged_progress = progress;
+        }
+    }
+
+    replayer.Barrier();
+    wal_parallel_replay_ = false;
+    server::Metrics::GetInstance().WalRecoveryProgressSet(1.0);
+    LOG_ENGINE_INFO_ << "Wal recovery replayed " << replayer.ReplayedCount() << " records with "
+                     << options_.wal_recovery_thread_num_ << " threads";
+}
+
 void
 DBImpl::InternalFlush(const std::string& collection_id) {
     wal::MXLogRecord record;
@@ -3291,10 +4680,223 @@ DBImpl::BackgroundMetricThread() {
 
         swn_metric_.Wait_For(std::chrono::seconds(BACKGROUND_METRIC_INTERVAL));
         StartMetricTask();
+        cache::CpuCacheMgr::GetInstance()->EnforceMemoryLimit();
         meta::FilesHolder::PrintInfo();
     }
 }
 
+void
+DBImpl::BackgroundAccessLogThread() {
+    SetThreadName("access_log");
+    if (options_.warm_up_size_ > 0) {
+        WarmUpFromManifest();
+    }
+
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            LOG_ENGINE_DEBUG_ << "DB background access log thread exit";
+            break;
+        }
+
+        swn_access_log_.Wait_For(std::chrono::seconds(ACCESS_LOG_SAVE_INTERVAL));
+        if (initialized_.load(std::memory_order_acquire)) {
+            SaveAccessLog();
+            if (storage_tier_ != nullptr) {
+                TierSegments();
+            }
+        }
+    }
+}
+
+void
+DBImpl::BackgroundReplicaThread() {
+    SetThreadName("replica_tail");
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            LOG_ENGINE_DEBUG_ << "DB background replica thread exit";
+            break;
+        }
+
+        swn_replica_.Wait_For(std::chrono::milliseconds(options_.replica_refresh_interval_ms_));
+        if (initialized_.load(std::memory_order_acquire)) {
+            auto status = replica_tailer_->Refresh();
+            if (!status.ok()) {
+                LOG_ENGINE_WARNING_ << "Failed to refresh the files of the replica: " << status.message();
+            }
+        }
+    }
+}
+
+void
+DBImpl::SaveAccessLog() {
+    auto mark = [](SegmentAccessLog::Entry& entry) {
+        entry.cached_ = cache::CpuCacheMgr::GetInstance()->ItemExists(entry.location_);
+#ifdef MILVUS_GPU_VERSION
+        auto gpu_cache_mgr = entry.gpu_device_ >= 0 ? cache::GpuCacheMgr::GetInstance(entry.gpu_device_) : nullptr;
+        if (gpu_cache_mgr == nullptr || !gpu_cache_mgr->ItemExists(entry.location_)) {
+            entry.gpu_device_ = -1;
+        }
+#else
+        entry.gpu_device_ = -1;
+#endif
+    };
+    auto status = SegmentAccessLog::GetInstance().Save(options_.meta_.path_ + "/" + SEGMENT_ACCESS_LOG, mark);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << status.message();
+    }
+}
+
+void
+DBImpl::TierSegments() {
+    std::vector<meta::CollectionSchema> collections;
+    auto status = meta_ptr_->AllCollections(collections);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << "Failed to get the collections to tier: " << status.message();
+        return;
+    }
+
+    // the files held are not deleted while their segments move
+    std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
+                                meta::SegmentSchema::FILE_TYPE::INDEX, meta::SegmentSchema::FILE_TYPE::BACKUP};
+    meta::FilesHolder files_holder;
+    status = meta_ptr_->FilesByTypeEx(collections, file_types, files_holder);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << "Failed to get the files to tier: " << status.message();
+        return;
+    }
+
+    // the raw and index files of a segment share its directory
+    auto& access_log = SegmentAccessLog::GetInstance();
+    int64_t pin_since = utils::GetMicroSecTimeStamp() - TIER_PIN_US;
+    uint64_t last_rank = tier_promote_rank_;
+    std::unordered_map<std::string, StorageTier::Segment> segment_map;
+    for (auto& file : files_holder.HoldFiles()) {
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        auto& segment = segment_map[segment_dir];
+        segment.dir_ = segment_dir;
+        segment.size_ += file.file_size_;
+        segment.rank_ = std::max(segment.rank_, access_log.Rank(file.location_));
+        segment.pinned_ = segment.pinned_ || file.created_on_ > pin_since;
+        last_rank = std::max(last_rank, segment.rank_);
+    }
+    std::vector<StorageTier::Segment> segments;
+    for (auto& pair : segment_map) {
+        pair.second.cold_ = StorageTier::IsCold(pair.first);
+        segments.emplace_back(std::move(pair.second));
+    }
+
+    std::vector<std::string> to_demote, to_promote;
+    StorageTier::Plan(segments, options_.hot_tier_capacity_, tier_promote_rank_, to_demote, to_promote);
+    tier_promote_rank_ = last_rank;
+
+    // the segment is copied first, the index builds and the flushes writing into it only wait for the files they
+    // changed meanwhile to be copied again
+    auto move = [&](const std::string& segment_dir, bool demote) {
+        STATUS_CHECK(storage_tier_->Stage(segment_dir));
+        const std::lock_guard<std::mutex> index_lock(build_index_mutex_);
+        const std::lock_guard<std::mutex> merge_lock(flush_merge_compact_mutex_);
+        return demote ? storage_tier_->Demote(segment_dir) : storage_tier_->Promote(segment_dir);
+    };
+    size_t demoted = 0, promoted = 0;
+    for (auto& segment_dir : to_demote) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            return;
+        }
+        status = move(segment_dir, true);
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to demote segment: " << status.message();
+            continue;
+        }
+        ++demoted;
+    }
+    for (auto& segment_dir : to_promote) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            return;
+        }
+        status = move(segment_dir, false);
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to promote segment: " << status.message();
+            continue;
+        }
+        ++promoted;
+    }
+    if (demoted > 0 || promoted > 0) {
+        LOG_ENGINE_DEBUG_ << "Storage tiering demoted " << demoted << " segments, promoted " << promoted;
+    }
+}
+
+void
+DBImpl::WarmUpFromManifest() {
+    auto manifest = SegmentAccessLog::GetInstance().Manifest();
+    std::vector<size_t> file_ids;
+    for (auto& entry : manifest) {
+        file_ids.push_back(entry.file_id_);
+    }
+    if (file_ids.empty()) {
+        return;
+    }
+
+    // the files merged or rebuilt since the last shutdown are gone, or moved to another location
+    meta::FilesHolder files_holder;
+    auto status = meta_ptr_->FilesByID(file_ids, files_holder);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << "Failed to get the files of the warm up manifest: " << status.message();
+        return;
+    }
+    std::unordered_map<std::string, meta::SegmentSchema> files_by_location;
+    for (auto& file : files_holder.HoldFiles()) {
+        if (file.file_type_ == meta::SegmentSchema::RAW || file.file_type_ == meta::SegmentSchema::TO_INDEX ||
+            file.file_type_ == meta::SegmentSchema::INDEX || file.file_type_ == meta::SegmentSchema::BACKUP) {
+            files_by_location[file.location_] = file;
+        }
+    }
+
+    // the most searched files up to the warm up size, in the order of the manifest
+    meta::SegmentsSchema files;
+    std::vector<int64_t> gpu_devices;
+    int64_t files_size = 0;
+    for (auto& entry : manifest) {
+        auto iter = files_by_location.find(entry.location_);
+        if (iter == files_by_location.end()) {
+            continue;
+        }
+        if (files_size + iter->second.file_size_ > options_.warm_up_size_) {
+            break;
+        }
+        files_size += iter->second.file_size_;
+        files.push_back(iter->second);
+        gpu_devices.push_back(entry.gpu_device_);
+    }
+
+    LOG_ENGINE_DEBUG_ << "Begin warm up " << files.size() << " files of " << files_size
+                      << " bytes cached before the last shutdown";
+    TimeRecorderAuto rc("Warm up cached files");
+    int64_t available_size =
+        cache::CpuCacheMgr::GetInstance()->CacheCapacity() - cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    status = PreloadFiles(nullptr, files, [available_size](int64_t size, bool& stop) {
+        stop = (size > available_size);
+        return Status::OK();
+    });
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << "Failed to warm up the cached files: " << status.message();
+        return;
+    }
+
+#ifdef MILVUS_GPU_VERSION
+    // the gpu copies are queued to the prefetch threads, which copy from the warm cpu cache
+    for (size_t i = 0; i < files.size() && initialized_.load(std::memory_order_acquire); ++i) {
+        if (gpu_devices[i] < 0) {
+            continue;
+        }
+        auto engine = BuildPreloadEngine(files[i]);
+        if (engine != nullptr) {
+            engine->PrefetchFileToGpu(gpu_devices[i], files[i].file_size_);
+        }
+    }
+#endif
+}
+
 void
 DBImpl::OnCacheInsertDataChanged(bool value) {
     options_.insert_cache_immediately_ = value;
@@ -3306,20 +4908,31 @@ DBImpl::OnUseBlasThresholdChanged(int64_t threshold) {
 }
 
 void
-DBImpl::SuspendIfFirst() {
-    std::lock_guard<std::mutex> lock(suspend_build_mutex_);
-    if (++live_search_num_ == 1) {
-        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_;
-        knowhere::BuilderSuspend();
+DBImpl::OnInsertBufferSizeChanged(int64_t value) {
+    options_.insert_buffer_size_ = value;
+}
+
+void
+DBImpl::OnOmpThreadNumChanged(int64_t thread_num) {
+    // 0 is half of the cores, as at startup
+    int64_t sys_thread_cnt = 0;
+    if (thread_num <= 0 && server::GetSystemAvailableThreads(sys_thread_cnt)) {
+        thread_num = static_cast<int64_t>(ceil(sys_thread_cnt * 0.5));
     }
+    scheduler::ParallelismGovernor::GetInstance().SetTaskMaxThreads(thread_num);
+}
+
+void
+DBImpl::OnBuildCpuShareChanged(float share) {
+    build_throttle_->SetBuildShare(share);
 }
 
 void
-DBImpl::ResumeIfLast() {
-    std::lock_guard<std::mutex> lock(suspend_build_mutex_);
-    if (--live_search_num_ == 0) {
-        LOG_ENGINE_TRACE_ << "live_search_num_: " << live_search_num_;
-        knowhere::BuildResume();
+DBImpl::OnWalBufferSizeChanged(int64_t value) {
+    options_.buffer_size_ = value / UNIT_MB;
+    if (wal_mgr_ != nullptr) {
+        // 2 buffers in the WAL, as at startup
+        wal_mgr_->SetBufferSize(options_.buffer_size_ / 2);
     }
 }
 
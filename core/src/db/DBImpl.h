@@ -12,6 +12,8 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -24,14 +26,24 @@
 
 #include "config/handler/CacheConfigHandler.h"
 #include "config/handler/EngineConfigHandler.h"
+#include "config/handler/WalConfigHandler.h"
+#include "db/BuildThrottle.h"
 #include "db/DB.h"
 #include "db/IndexFailedChecker.h"
+#include "db/PartitionIndex.h"
+#include "db/PartitionKey.h"
+#include "db/QueryResultCache.h"
+#include "db/RecallSampler.h"
+#include "db/ReplicaTailer.h"
 #include "db/SimpleWaitNotify.h"
+#include "db/StorageTier.h"
 #include "db/Types.h"
 #include "db/insert/MemManager.h"
-#include "db/merge/MergeManager.h"
+#include "db/merge/MergeManagerImpl.h"
 #include "db/meta/FilesHolder.h"
+#include "utils/RateLimiter.h"
 #include "utils/ThreadPool.h"
+#include "utils/WorkStealingThreadPool.h"
 #include "wal/WalManager.h"
 
 namespace milvus {
@@ -41,7 +53,10 @@ namespace meta {
 class Meta;
 }
 
-class DBImpl : public DB, public server::CacheConfigHandler, public server::EngineConfigHandler {
+class DBImpl : public DB,
+               public server::CacheConfigHandler,
+               public server::EngineConfigHandler,
+               public server::WalConfigHandler {
  public:
     explicit DBImpl(const DBOptions& options);
 
@@ -81,6 +96,12 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     PreloadCollection(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                       bool force = false) override;
 
+    Status
+    WarmUp(const std::vector<std::string>& collection_ids) override;
+
+    Status
+    GetWarmUpProgress(WarmUpProgress& progress) override;
+
     Status
     ReLoadSegmentsDeletedDocs(const std::string& collection_id, const std::vector<int64_t>& segment_ids) override;
 
@@ -110,6 +131,17 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     InsertVectors(const std::string& collection_id, const std::string& partition_tag, VectorsData& vectors) override;
 
+    Status
+    BulkImport(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+               const std::string& partition_tag, const std::vector<std::string>& file_paths, IDNumbers& ids,
+               bool build_index) override;
+
+    Status
+    ExportCollection(const std::string& collection_id, const std::string& target_dir) override;
+
+    Status
+    ImportCollection(const std::string& collection_id, const std::string& source_dir) override;
+
     Status
     DeleteVector(const std::string& collection_id, IDNumber vector_id) override;
 
@@ -122,6 +154,9 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     Flush() override;
 
+    Status
+    SyncWal() override;
+
     Status
     Compact(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
             double threshold = 0.0) override;
@@ -157,6 +192,10 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     DropIndex(const std::string& collection_id) override;
 
+    Status
+    TuneIndex(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+              const milvus::json& tune_params, milvus::json& report) override;
+
     Status
     CreateHybridCollection(meta::CollectionSchema& collection_schema,
                            meta::hybrid::FieldsSchema& fields_schema) override;
@@ -192,6 +231,11 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
                   const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
                   ResultDistances& result_distances) override;
 
+    Status
+    QueryCollections(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& collection_ids,
+                     uint64_t k, const milvus::json& extra_params, VectorsData& vectors,
+                     std::vector<ResultIds>& result_ids, std::vector<ResultDistances>& result_distances) override;
+
     Status
     Size(uint64_t& result) override;
 
@@ -205,11 +249,44 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     OnUseBlasThresholdChanged(int64_t threshold) override;
 
+    void
+    OnInsertBufferSizeChanged(int64_t value) override;
+
+    void
+    OnOmpThreadNumChanged(int64_t thread_num) override;
+
+    void
+    OnBuildCpuShareChanged(float share) override;
+
+    void
+    OnWalBufferSizeChanged(int64_t value) override;
+
  private:
+    // called after each preloaded file with the bytes preloaded so far, set stop to load no more
+    using PreloadCheck = std::function<Status(int64_t size, bool& stop)>;
+
+    // called under the same lock as PreloadCheck before a file is loaded, return false to skip the file
+    using PreloadFilter = std::function<bool(const meta::SegmentSchema& file)>;
+
+    // from the replica view on a readonly node tailing the meta, from the meta otherwise
+    Status
+    GetFilesToSearch(const std::string& collection_id, meta::FilesHolder& files_holder);
+
     Status
-    QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesHolder& files_holder, uint64_t k,
-               const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
-               ResultDistances& result_distances);
+    GetFilesToPreload(const std::string& collection_id, meta::FilesHolder& files_holder);
+
+    // load the files into the cpu cache with the preload threads, started in the order of files
+    Status
+    PreloadFiles(const std::shared_ptr<server::Context>& context, const meta::SegmentsSchema& files,
+                 const PreloadCheck& check, const PreloadFilter& filter = nullptr);
+
+    // with file_groups, the files of the collection ids mapped to group g are reduced into the rows
+    // [g * nq, (g + 1) * nq) of the result, see SearchJob::SetResultGroups()
+    Status
+    QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+               meta::FilesHolder& files_holder, uint64_t k, const milvus::json& extra_params, VectorsData& vectors,
+               ResultIds& result_ids, ResultDistances& result_distances,
+               const std::unordered_map<std::string, size_t>& file_groups = {});
 
     Status
     HybridQueryAsync(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
@@ -222,6 +299,20 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::VectorsData>& vectors,
                          meta::FilesHolder& files_holder);
 
+    // copies the float vectors of the rows at the offsets from the index cached at location, when it is a brute force
+    // or an IVF_FLAT index keeping them, returns false if it is not cached or does not keep them
+    bool
+    CopyCachedVectors(const std::string& location, int64_t dimension, const std::vector<int64_t>& offsets,
+                      std::vector<uint8_t>& raw_vectors);
+
+    // the fields of the search results, each result is read from the segment it was found in, the rows of a segment
+    // are read in one batch per field
+    Status
+    MaterializeEntities(const IDNumbers& id_array, const std::vector<meta::SegmentDescPtr>& sources,
+                        const std::vector<std::string>& field_names,
+                        const std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
+                        std::vector<VectorsData>& vectors, std::vector<AttrsData>& attrs);
+
     Status
     GetEntitiesByIdHelper(const std::string& collection_id, const IDNumbers& id_array,
                           std::unordered_map<std::string, engine::meta::hybrid::DataType>& attr_type,
@@ -231,6 +322,15 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     InternalFlush(const std::string& collection_id = "");
 
+    // holds a wal insert while the insert buffer is over its size for the wal thread to flush it, for a short while
+    // only, a buffer still full then fails the insert with DB_INSERT_BUFFER_FULL and the time to retry after
+    Status
+    WaitInsertBuffer();
+
+    // flushes the largest mem tables of a full insert buffer until it is down to the target fraction of its size
+    void
+    FlushInsertBuffer();
+
     void
     BackgroundWalThread();
 
@@ -240,6 +340,29 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     BackgroundMetricThread();
 
+    // saves the segment access log periodically, after warming up the cache from it
+    void
+    BackgroundAccessLogThread();
+
+    void
+    SaveAccessLog();
+
+    // drops the segments of the collections with a ttl whose last insert is older than the ttl
+    void
+    ExpireSegments();
+
+    // demotes the segments searched least lately beyond the hot tier capacity, promotes the ones searched again
+    void
+    TierSegments();
+
+    // keeps the searchable files of a readonly node up to date with the changes of the writable node
+    void
+    BackgroundReplicaThread();
+
+    // reload the files cached before the last shutdown, the most searched first
+    void
+    WarmUpFromManifest();
+
     void
     BackgroundIndexThread();
 
@@ -281,6 +404,10 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     GetPartitionsByTags(const std::string& collection_id, const std::vector<std::string>& partition_tags,
                         std::set<std::string>& partition_name_array);
 
+    // the partitions of the collection from the partition index, loaded from the meta on a miss
+    Status
+    GetPartitions(const std::string& collection_id, PartitionIndex::PartitionsPtr& partitions);
+
     Status
     UpdateCollectionIndexRecursively(const std::string& collection_id, const CollectionIndex& index);
 
@@ -297,11 +424,13 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     ExecWalRecord(const wal::MXLogRecord& record);
 
+    // the cached results of collections and partitions whose searchable data changed are stale
     void
-    SuspendIfFirst();
+    InvalidateQueryResults(const std::set<std::string>& collection_ids);
 
+    // replay the records which are not flushed yet, throw Exception on wal error
     void
-    ResumeIfLast();
+    RecoverWal();
 
     Status
     SerializeStructuredIndex(const meta::SegmentSchema& segment_schema,
@@ -309,6 +438,20 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
                              const std::unordered_map<std::string, int64_t>& attr_sizes,
                              const std::unordered_map<std::string, meta::hybrid::DataType>& attr_types);
 
+    // unmark the files whose segment has no row satisfying the query by the field stats of meta
+    void
+    PruneFilesByFieldsStats(const query::GeneralQueryPtr& general_query, meta::FilesHolder& files_holder);
+
+    // the partition key of a hybrid collection, key is null if it has none
+    void
+    GetPartitionKey(const std::string& collection_id, PartitionKeyPtr& key);
+
+    // insert the entities into the partitions their values of the key pick
+    Status
+    InsertByPartitionKey(const std::string& collection_id, const PartitionKeyPtr& partition_key, const Entity& entity,
+                         const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data,
+                         const std::unordered_map<std::string, uint64_t>& attr_nbytes);
+
  private:
     DBOptions options_;
 
@@ -316,39 +459,60 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
 
     meta::MetaPtr meta_ptr_;
     MemManagerPtr mem_mgr_;
-    MergeManagerPtr merge_mgr_ptr_;
+    MergeManagerImplPtr merge_mgr_ptr_;
 
     std::shared_ptr<wal::WalManager> wal_mgr_;
+    // set while the wal is replayed by several threads, the recovery thread flushes a full insert buffer
+    bool wal_parallel_replay_ = false;
     std::thread bg_wal_thread_;
+    // bytes per second the insert buffer flushes free, 0 until the first one
+    std::atomic<double> insert_flush_rate_{0};
 
     std::thread bg_flush_thread_;
     std::thread bg_metric_thread_;
     std::thread bg_index_thread_;
+    std::thread bg_access_log_thread_;
+    std::thread bg_replica_thread_;
 
     SimpleWaitNotify swn_wal_;
     SimpleWaitNotify swn_flush_;
     SimpleWaitNotify swn_metric_;
     SimpleWaitNotify swn_index_;
+    SimpleWaitNotify swn_access_log_;
+    SimpleWaitNotify swn_replica_;
 
     SimpleWaitNotify flush_req_swn_;
     SimpleWaitNotify index_req_swn_;
 
-    ThreadPool merge_thread_pool_;
+    WorkStealingThreadPool merge_thread_pool_;
     std::mutex merge_result_mutex_;
     std::list<std::future<void>> merge_thread_results_;
 
-    ThreadPool index_thread_pool_;
+    WorkStealingThreadPool index_thread_pool_;
     std::mutex index_result_mutex_;
     std::list<std::future<void>> index_thread_results_;
 
     std::mutex build_index_mutex_;
 
+    ThreadPool preload_thread_pool_;
+    RateLimiter preload_limiter_;
+    std::thread warm_up_thread_;  // loads the files not searched before the last shutdown
+    std::mutex warm_up_mutex_;
+    WarmUpProgress warm_up_progress_;
+
     IndexFailedChecker index_failed_checker_;
 
+    QueryResultCachePtr result_cache_;  // null when the result cache is disabled
+    RecallSamplerPtr recall_sampler_;   // null when recall sampling is disabled
+    PartitionIndexPtr partition_index_;  // null on a readonly node
+    ReplicaTailerPtr replica_tailer_;    // null unless a readonly node tails the meta
+    StorageTierPtr storage_tier_;        // null unless segments are demoted to a cold path
+    uint64_t tier_promote_rank_ = 0;     // the cold segments searched after it are promoted
+    std::chrono::steady_clock::time_point last_expire_time_;  // of the merge thread only
+
     std::mutex flush_merge_compact_mutex_;
 
-    int64_t live_search_num_ = 0;
-    std::mutex suspend_build_mutex_;
+    BuildThrottlePtr build_throttle_;
 };  // DBImpl
 
 }  // namespace engine
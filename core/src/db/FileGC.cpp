@@ -0,0 +1,114 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/FileGC.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <future>
+#include <thread>
+
+#include "db/StorageTier.h"
+#include "metrics/Metrics.h"
+#include "storage/IOScheduler.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+FileGC::FileGC(int64_t thread_num, int64_t unlink_rate)
+    : pool_(std::max<int64_t>(1, thread_num), 10000),
+      unlink_rate_(unlink_rate),
+      next_unlink_(std::chrono::steady_clock::now()) {
+    deleter_ = [this](const std::vector<std::string>& paths) { return RemoveLocal(paths); };
+}
+
+void
+FileGC::SetDeleter(const Deleter& deleter) {
+    deleter_ = deleter;
+}
+
+Status
+FileGC::Remove(const std::vector<std::string>& paths) {
+    if (paths.empty()) {
+        return Status::OK();
+    }
+
+    backlog_ += paths.size();
+    server::Metrics::GetInstance().FileGCBacklogSet(backlog_.load());
+
+    std::vector<std::future<Status>> futures;
+    for (size_t begin = 0; begin < paths.size(); begin += DELETE_BATCH) {
+        auto end = std::min(paths.size(), begin + DELETE_BATCH);
+        std::vector<std::string> batch(paths.begin() + begin, paths.begin() + end);
+        futures.push_back(pool_.enqueue([this, batch]() {
+            auto status = deleter_(batch);
+            BacklogSub(batch.size());
+            return status;
+        }));
+    }
+
+    Status status;
+    for (auto& future : futures) {
+        auto batch_status = future.get();
+        if (status.ok() && !batch_status.ok()) {
+            status = batch_status;
+        }
+    }
+    return status;
+}
+
+Status
+FileGC::RemoveLocal(const std::vector<std::string>& paths) {
+    storage::IOClassGuard io_guard(storage::IOClass::BACKGROUND);
+    auto& io_scheduler = storage::IOScheduler::GetInstance();
+    for (auto& path : paths) {
+        Throttle();
+        io_scheduler.Acquire(storage::IOScheduler::METADATA_IO_BYTES);
+
+        boost::system::error_code ec;
+        if (boost::filesystem::is_directory(path, ec)) {
+            // a demoted segment is a link to its cold copy
+            StorageTier::RemoveSegment(path);
+        } else {
+            boost::filesystem::remove(path, ec);
+            if (ec) {
+                LOG_ENGINE_WARNING_ << "Failed to remove " << path << ": " << ec.message();
+            }
+        }
+    }
+    return Status::OK();
+}
+
+void
+FileGC::Throttle() {
+    if (unlink_rate_ <= 0) {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point turn;
+    {
+        std::lock_guard<std::mutex> lock(throttle_mutex_);
+        // the unlinks not taken while idle are not saved up for a burst
+        turn = std::max(next_unlink_, std::chrono::steady_clock::now());
+        next_unlink_ = turn + std::chrono::microseconds(1000000 / unlink_rate_);
+    }
+    std::this_thread::sleep_until(turn);
+}
+
+void
+FileGC::BacklogSub(uint64_t count) {
+    backlog_ -= count;
+    server::Metrics::GetInstance().FileGCBacklogSet(backlog_.load());
+}
+
+}  // namespace engine
+}  // namespace milvus
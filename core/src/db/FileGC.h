@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/Status.h"
+#include "utils/ThreadPool.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Removes the files and segment directories of the cleaned up collection files on a pool of threads. The paths are
+ * cut in batches of DELETE_BATCH, the key limit of an S3 DeleteObjects request, and handed to the deleter. The local
+ * deleter unlinks them one by one, at most unlink_rate per second over all the threads so that a cleanup after a
+ * large merge doesn't starve the searches of disk IO, an object store deleter removes a batch with one request.
+ * The paths queued and not removed yet are reported as the file_gc_backlog gauge.
+ */
+class FileGC {
+ public:
+    static constexpr size_t DELETE_BATCH = 1000;
+
+    // removes a batch of paths, files or segment directories
+    using Deleter = std::function<Status(const std::vector<std::string>& paths)>;
+
+    // unlink_rate: unlinks per second of the local deleter, 0 means no limit
+    FileGC(int64_t thread_num, int64_t unlink_rate);
+
+    void
+    SetDeleter(const Deleter& deleter);
+
+    // blocks until all the paths are removed, returns the first error
+    Status
+    Remove(const std::vector<std::string>& paths);
+
+    uint64_t
+    Backlog() const {
+        return backlog_.load();
+    }
+
+ private:
+    Status
+    RemoveLocal(const std::vector<std::string>& paths);
+
+    // waits for the turn of the next unlink
+    void
+    Throttle();
+
+    void
+    BacklogSub(uint64_t count);
+
+ private:
+    ThreadPool pool_;
+    int64_t unlink_rate_;
+    Deleter deleter_;
+
+    std::mutex throttle_mutex_;
+    std::chrono::steady_clock::time_point next_unlink_;
+
+    std::atomic<uint64_t> backlog_{0};
+};
+
+using FileGCPtr = std::shared_ptr<FileGC>;
+
+}  // namespace engine
+}  // namespace milvus
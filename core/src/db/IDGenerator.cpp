@@ -14,8 +14,10 @@
 
 #include <assert.h>
 #include <fiu-local.h>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <numeric>
 #include <string>
 
 namespace milvus {
@@ -61,65 +63,79 @@ SimpleIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
     return Status::OK();
 }
 
+constexpr size_t SafeIDGenerator::MAX_IDS_PER_MICRO;
+
+namespace {
+
+struct ReservedIDs {
+    IDNumber next_ = 0;
+    IDNumber end_ = 0;
+};
+
+thread_local ReservedIDs reserved_ids;
+
+}  // namespace
+
 IDNumber
 SafeIDGenerator::GetNextIDNumber() {
-    auto now = std::chrono::system_clock::now();
-    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (micros <= time_stamp_ms_) {
-        time_stamp_ms_ += 1;
-    } else {
-        time_stamp_ms_ = micros;
-    }
-    return time_stamp_ms_ * MAX_IDS_PER_MICRO;
+    IDRange range;
+    GetNextIDRange(1, range);
+    return range.begin_;
 }
 
 Status
 SafeIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
     ids.clear();
-    std::lock_guard<std::mutex> lock(mtx_);
-    while (n > 0) {
-        if (n > MAX_IDS_PER_MICRO) {
-            Status status = NextIDNumbers(MAX_IDS_PER_MICRO, ids);
-            if (!status.ok()) {
-                return status;
-            }
-            n -= MAX_IDS_PER_MICRO;
-        } else {
-            Status status = NextIDNumbers(n, ids);
-            if (!status.ok()) {
-                return status;
-            }
-            break;
-        }
+    IDRange range;
+    auto status = GetNextIDRange(n, range);
+    if (!status.ok()) {
+        return status;
     }
+
+    ids.resize(range.count_);
+    std::iota(ids.begin(), ids.end(), range.begin_);
     return Status::OK();
 }
 
 Status
-SafeIDGenerator::NextIDNumbers(size_t n, IDNumbers& ids) {
-    if (n <= 0 || n > MAX_IDS_PER_MICRO) {
-        std::string msg = "Invalid ID number: " + std::to_string(n);
-        LOG_ENGINE_ERROR_ << msg;
-        return Status(SERVER_UNEXPECTED_ERROR, msg);
-    }
-
-    auto now = std::chrono::system_clock::now();
-    int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
-    if (micros <= time_stamp_ms_) {
-        time_stamp_ms_ += 1;
-    } else {
-        time_stamp_ms_ = micros;
+SafeIDGenerator::GetNextIDRange(size_t n, IDRange& range) {
+    range.count_ = n;
+    if (n == 0) {
+        range.begin_ = 0;
+        return Status::OK();
     }
 
-    int64_t ID_high_part = time_stamp_ms_ * MAX_IDS_PER_MICRO;
+    auto& reserved = reserved_ids;
+    if (n > MAX_IDS_PER_MICRO) {
+        int64_t ticks = (n + MAX_IDS_PER_MICRO - 1) / MAX_IDS_PER_MICRO;
+        range.begin_ = ReserveTicks(ticks) * MAX_IDS_PER_MICRO;
 
-    for (size_t pos = 0; pos < n; ++pos) {
-        ids.push_back(ID_high_part + pos);
+        // the rest of the reserved tick is smaller than these ids, drop it to keep the ids of a thread increasing
+        reserved = ReservedIDs();
+        return Status::OK();
     }
 
+    if (reserved.end_ - reserved.next_ < static_cast<IDNumber>(n)) {
+        reserved.next_ = ReserveTicks(1) * MAX_IDS_PER_MICRO;
+        reserved.end_ = reserved.next_ + MAX_IDS_PER_MICRO;
+    }
+    range.begin_ = reserved.next_;
+    reserved.next_ += n;
     return Status::OK();
 }
 
+int64_t
+SafeIDGenerator::ReserveTicks(int64_t ticks) {
+    auto now = std::chrono::system_clock::now();
+    int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+    int64_t last = time_stamp_ms_.load(std::memory_order_relaxed);
+    int64_t first = 0;
+    do {
+        first = std::max(last + 1, micros);
+    } while (!time_stamp_ms_.compare_exchange_weak(last, first + ticks - 1, std::memory_order_relaxed));
+    return first;
+}
+
 }  // namespace engine
 }  // namespace milvus
@@ -14,6 +14,7 @@
 #include "Types.h"
 #include "utils/Status.h"
 
+#include <atomic>
 #include <cstddef>
 #include <vector>
 
@@ -48,6 +49,17 @@ class SimpleIDGenerator : public IDGenerator {
     static constexpr size_t MAX_IDS_PER_MICRO = 1000;
 };  // SimpleIDGenerator
 
+// consecutive ids [begin_, begin_ + count_)
+struct IDRange {
+    IDNumber begin_ = 0;
+    size_t count_ = 0;
+};
+
+/*
+ * Ids are micro-second ticks multiplied by MAX_IDS_PER_MICRO, the ticks are handed out by an atomic counter
+ * which is never behind the clock, so ids keep growing across restarts.
+ * Small requests are served from a tick each thread reserved in advance.
+ */
 class SafeIDGenerator : public IDGenerator {
  public:
     static SafeIDGenerator&
@@ -64,16 +76,20 @@ class SafeIDGenerator : public IDGenerator {
     Status
     GetNextIDNumbers(size_t n, IDNumbers& ids) override;
 
+    // same as GetNextIDNumbers, for callers which don't need the ids in a vector
+    Status
+    GetNextIDRange(size_t n, IDRange& range);
+
  private:
     SafeIDGenerator() = default;
 
-    Status
-    NextIDNumbers(size_t n, IDNumbers& ids);
+    // returns the first of the reserved ticks
+    int64_t
+    ReserveTicks(int64_t ticks);
 
     static constexpr size_t MAX_IDS_PER_MICRO = 1000;
 
-    std::mutex mtx_;
-    int64_t time_stamp_ms_ = 0;
+    std::atomic<int64_t> time_stamp_ms_ = {0};
 };
 
 }  // namespace engine
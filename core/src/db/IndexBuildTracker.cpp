@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/IndexBuildTracker.h"
+#include "db/Utils.h"
+
+namespace milvus {
+namespace engine {
+
+const char*
+IndexBuildStageName(IndexBuildStage stage) {
+    switch (stage) {
+        case IndexBuildStage::QUEUED:
+            return "queued";
+        case IndexBuildStage::LOADING:
+            return "loading";
+        case IndexBuildStage::BUILDING:
+            return "building";
+        case IndexBuildStage::SERIALIZING:
+            return "serializing";
+    }
+    return "unknown";
+}
+
+IndexBuildTracker&
+IndexBuildTracker::GetInstance() {
+    static IndexBuildTracker instance;
+    return instance;
+}
+
+void
+IndexBuildTracker::Queued(const meta::SegmentSchema& file) {
+    IndexBuildProgress progress;
+    progress.file_id_ = file.id_;
+    progress.collection_id_ = file.collection_id_;
+    progress.segment_id_ = file.segment_id_;
+    progress.index_type_ = utils::GetIndexName(file.engine_type_);
+    progress.row_count_ = file.row_count_;
+    progress.queued_time_ = progress.stage_time_ = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    builds_[file.id_] = progress;
+}
+
+void
+IndexBuildTracker::SetStage(size_t file_id, IndexBuildStage stage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = builds_.find(file_id);
+    if (iter != builds_.end()) {
+        iter->second.stage_ = stage;
+        iter->second.stage_time_ = std::chrono::steady_clock::now();
+    }
+}
+
+void
+IndexBuildTracker::SetRowsIndexed(size_t file_id, int64_t rows) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = builds_.find(file_id);
+    if (iter != builds_.end()) {
+        iter->second.rows_indexed_ = rows;
+    }
+}
+
+void
+IndexBuildTracker::SetBytesWritten(size_t file_id, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = builds_.find(file_id);
+    if (iter != builds_.end()) {
+        iter->second.bytes_written_ = bytes;
+    }
+}
+
+void
+IndexBuildTracker::Finished(size_t file_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    builds_.erase(file_id);
+}
+
+bool
+IndexBuildTracker::GetBuild(size_t file_id, IndexBuildProgress& progress) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = builds_.find(file_id);
+    if (iter == builds_.end()) {
+        return false;
+    }
+    progress = iter->second;
+    return true;
+}
+
+std::vector<IndexBuildProgress>
+IndexBuildTracker::Builds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<IndexBuildProgress> builds;
+    builds.reserve(builds_.size());
+    for (auto& pair : builds_) {
+        builds.push_back(pair.second);
+    }
+    return builds;
+}
+
+}  // namespace engine
+}  // namespace milvus
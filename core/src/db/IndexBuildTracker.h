@@ -0,0 +1,89 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/MetaTypes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// training and adding happen in one knowhere BuildAll call, so they are a single stage
+enum class IndexBuildStage {
+    QUEUED,
+    LOADING,
+    BUILDING,
+    SERIALIZING,
+};
+
+const char*
+IndexBuildStageName(IndexBuildStage stage);
+
+struct IndexBuildProgress {
+    size_t file_id_ = 0;  // id of the to_index file
+    std::string collection_id_;
+    std::string segment_id_;
+    std::string index_type_;
+    IndexBuildStage stage_ = IndexBuildStage::QUEUED;
+    int64_t row_count_ = 0;
+    int64_t rows_indexed_ = 0;
+    int64_t bytes_written_ = 0;
+    std::chrono::steady_clock::time_point queued_time_;
+    std::chrono::steady_clock::time_point stage_time_;  // when the current stage began
+};
+
+/*
+ * The index builds from the moment a file joins a build index job until the job is done with it,
+ * read by ShowCollectionInfo and the metrics to follow the builds and spot stalled ones.
+ */
+class IndexBuildTracker {
+ public:
+    static IndexBuildTracker&
+    GetInstance();
+
+    void
+    Queued(const meta::SegmentSchema& file);
+
+    void
+    SetStage(size_t file_id, IndexBuildStage stage);
+
+    void
+    SetRowsIndexed(size_t file_id, int64_t rows);
+
+    void
+    SetBytesWritten(size_t file_id, int64_t bytes);
+
+    void
+    Finished(size_t file_id);
+
+    bool
+    GetBuild(size_t file_id, IndexBuildProgress& progress) const;
+
+    std::vector<IndexBuildProgress>
+    Builds() const;
+
+ private:
+    IndexBuildTracker() = default;
+
+ private:
+    mutable std::mutex mutex_;
+    std::map<size_t, IndexBuildProgress> builds_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -59,6 +59,10 @@ struct DBMetaOptions {
     std::string path_;
     std::string backend_uri_;
     ArchiveConf archive_conf_ = ArchiveConf("delete");
+    int64_t cache_ttl_ms_ = 1000;  // 0 means FilesToSearch always reads the meta database
+    std::string cold_path_;        // mirror of path_ holding the demoted segments, empty means a single tier
+    int64_t gc_thread_num_ = 4;    // threads removing the cleaned up files
+    int64_t gc_unlink_rate_ = 0;   // unlinks per second of the file cleanup, 0 means no limit
 };  // DBMetaOptions
 
 struct DBOptions {
@@ -67,20 +71,46 @@ struct DBOptions {
     uint16_t merge_trigger_number_ = 2;
     DBMetaOptions meta_;
     int mode_ = MODE::SINGLE;
+    int64_t replica_refresh_interval_ms_ = 0;  // readonly node only, 0 means each search reads the meta
 
     size_t insert_buffer_size_ = 4 * GB;
+    double insert_buffer_target_ = 0.5;  // fraction of the insert buffer left by the flush of a full one
     bool insert_cache_immediately_ = false;
+    bool write_through_index_ = false;   // cache a built index in place of the raw vectors of its segment
+    int64_t result_cache_capacity_ = 0;  // number of search results cached, 0 means disabled
+    int64_t preload_thread_num_ = 4;     // segments loaded at once by a preload
+    int64_t preload_bandwidth_ = 0;      // bytes read per second by the preloads, 0 means no limit
+    int64_t warm_up_size_ = 0;           // bytes of the cached segments reloaded after a restart, 0 means none
 
     int64_t auto_flush_interval_ = 1;
     int64_t file_cleanup_timeout_ = 10;
 
+    std::string merge_strategy_ = "layered";  // simple, layered, adaptive or tiered
+    int64_t merge_write_amplification_ = 3;    // tiered only
+    int64_t merge_bytes_limit_ = 0;            // bytes merged per collection and round, 0 means no limit
+
+    double auto_compact_threshold_ = 0.0;  // deleted ratio to compact a segment in background, 0 means disabled
+    int64_t auto_compact_bytes_limit_ = 1 * GB;
+
+    int64_t hot_tier_capacity_ = 0;  // bytes of segments kept under meta_.path_, 0 means no demotion
+
     bool metric_enable_ = false;
+    double recall_sample_rate_ = 0.0;  // fraction of searches re-run exactly to estimate recall, 0 means disabled
+
+    double build_cpu_share_ = 0.25;      // cpu share of the index builds while searches are running
+    int64_t search_latency_slo_ms_ = 0;  // search p99 target shrinking the build share, 0 means none
+    bool search_insert_buffer_ = false;  // brute-force search the vectors not flushed yet
+    bool numa_aware_ = false;            // load a file on the numa node searching it
 
     // wal relative configurations
     bool wal_enable_ = true;
     bool recovery_error_ignore_ = true;
     int64_t buffer_size_ = 256;
     std::string mxlog_path_ = "/tmp/milvus/wal/";
+    std::string wal_sync_mode_ = "none";  // none, interval or batch
+    int64_t wal_sync_interval_ = 10;      // ms
+    int64_t wal_recovery_thread_num_ = 1;
+    bool wal_compress_ = false;
 };  // Options
 
 }  // namespace engine
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/PartitionIndex.h"
+
+#include <regex>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+bool
+IsRegexPattern(const std::string& tag) {
+    return tag.find_first_of(".^$|()[]{}*+?\\") != std::string::npos;
+}
+
+}  // namespace
+
+PartitionIndex::PartitionsPtr
+PartitionIndex::Build(const std::vector<meta::CollectionSchema>& partition_array) {
+    auto partitions = std::make_shared<Partitions>();
+    for (auto& schema : partition_array) {
+        partitions->insert(std::make_pair(schema.partition_tag_, schema.collection_id_));
+    }
+    return partitions;
+}
+
+uint64_t
+PartitionIndex::Generation(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generations_[collection_id];
+}
+
+PartitionIndex::PartitionsPtr
+PartitionIndex::Get(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = collections_.find(collection_id);
+    return iter == collections_.end() ? nullptr : iter->second;
+}
+
+void
+PartitionIndex::Put(const std::string& collection_id, uint64_t generation, const PartitionsPtr& partitions) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generations_[collection_id]) {
+        return;  // the partitions changed during the load
+    }
+    collections_[collection_id] = partitions;
+}
+
+void
+PartitionIndex::Invalidate(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generations_[collection_id];
+    collections_.erase(collection_id);
+}
+
+void
+PartitionIndex::MatchTag(const Partitions& partitions, const std::string& tag, std::set<std::string>& partition_ids) {
+    auto iter = partitions.find(tag);
+    if (iter != partitions.end()) {
+        partition_ids.insert(iter->second);
+    }
+    if (!IsRegexPattern(tag)) {
+        return;
+    }
+
+    std::regex pattern(tag);
+    for (auto& partition : partitions) {
+        if (std::regex_match(partition.first, pattern)) {
+            partition_ids.insert(partition.second);
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
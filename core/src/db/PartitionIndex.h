@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/MetaTypes.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * The partitions of collections by tag, so that resolving the partition tags of a search costs no meta query.
+ * A collection is loaded from the meta on first use and dropped by Invalidate() whenever its partitions change.
+ * Like QueryResultCache, a load is only kept if no Invalidate() of the collection happened meanwhile.
+ */
+class PartitionIndex {
+ public:
+    using Partitions = std::unordered_map<std::string, std::string>;  // partition tag -> partition id
+    using PartitionsPtr = std::shared_ptr<const Partitions>;
+
+    static PartitionsPtr
+    Build(const std::vector<meta::CollectionSchema>& partition_array);
+
+    uint64_t
+    Generation(const std::string& collection_id);
+
+    // null when the collection is not loaded
+    PartitionsPtr
+    Get(const std::string& collection_id);
+
+    void
+    Put(const std::string& collection_id, uint64_t generation, const PartitionsPtr& partitions);
+
+    void
+    Invalidate(const std::string& collection_id);
+
+    // Adds the partitions whose tag is the tag, or matches it when the tag is a regular expression. The lookup of a
+    // plain tag is exact, a regular expression is compiled once and run over all partitions.
+    static void
+    MatchTag(const Partitions& partitions, const std::string& tag, std::set<std::string>& partition_ids);
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, PartitionsPtr> collections_;
+    std::map<std::string, uint64_t> generations_;
+};
+
+using PartitionIndexPtr = std::shared_ptr<PartitionIndex>;
+
+}  // namespace engine
+}  // namespace milvus
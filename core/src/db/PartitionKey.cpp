@@ -0,0 +1,222 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/PartitionKey.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "segment/AttrZoneMap.h"
+#include "utils/Json.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+bool
+IsIntegerType(meta::hybrid::DataType data_type) {
+    return data_type == meta::hybrid::DataType::INT8 || data_type == meta::hybrid::DataType::INT16 ||
+           data_type == meta::hybrid::DataType::INT32 || data_type == meta::hybrid::DataType::INT64;
+}
+
+size_t
+ValueSize(meta::hybrid::DataType data_type) {
+    switch (data_type) {
+        case meta::hybrid::DataType::INT8:
+            return sizeof(int8_t);
+        case meta::hybrid::DataType::INT16:
+            return sizeof(int16_t);
+        case meta::hybrid::DataType::INT32:
+            return sizeof(int32_t);
+        default:
+            return sizeof(int64_t);
+    }
+}
+
+// the partition of a value must not change between builds, so the hash is spelled out rather than std::hash
+uint64_t
+MixValue(int64_t value) {
+    uint64_t x = static_cast<uint64_t>(value);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+Status
+ParseKey(const meta::hybrid::FieldSchema& field_schema, PartitionKeyPtr& key) {
+    key = nullptr;
+    if (field_schema.field_params_.empty()) {
+        return Status::OK();
+    }
+
+    milvus::json params;
+    try {
+        params = milvus::json::parse(field_schema.field_params_);
+    } catch (std::exception& ex) {
+        return Status::OK();  // params of other kinds are none of our business
+    }
+    if (!params.is_object() || !params.contains(PartitionKey::PARAM_KEY)) {
+        return Status::OK();
+    }
+
+    std::string msg = "Invalid partition key of field " + field_schema.field_name_ + ": ";
+    auto data_type = (meta::hybrid::DataType)field_schema.field_type_;
+    if (!IsIntegerType(data_type)) {
+        return Status(DB_ERROR, msg + "the field is not an integer");
+    }
+
+    try {
+        auto& key_params = params[PartitionKey::PARAM_KEY];
+        std::string type = key_params.at("type").get<std::string>();
+        if (type == "hash") {
+            int64_t partitions = key_params.at("partitions").get<int64_t>();
+            if (partitions < 1 || partitions > PartitionKey::MAX_PARTITIONS) {
+                return Status(DB_ERROR, msg + "partitions is not in range [1, " +
+                                            std::to_string(PartitionKey::MAX_PARTITIONS) + "]");
+            }
+            key = std::make_shared<PartitionKey>(field_schema.field_name_, data_type, PartitionKey::Type::HASH,
+                                                 partitions, std::vector<int64_t>());
+        } else if (type == "range") {
+            auto bounds = key_params.at("bounds").get<std::vector<int64_t>>();
+            if (bounds.empty() || static_cast<int64_t>(bounds.size()) >= PartitionKey::MAX_PARTITIONS) {
+                return Status(DB_ERROR, msg + "bounds is empty or too long");
+            }
+            for (size_t i = 1; i < bounds.size(); ++i) {
+                if (bounds[i] <= bounds[i - 1]) {
+                    return Status(DB_ERROR, msg + "bounds are not strictly ascending");
+                }
+            }
+            int64_t partitions = bounds.size() + 1;
+            key = std::make_shared<PartitionKey>(field_schema.field_name_, data_type, PartitionKey::Type::RANGE,
+                                                 partitions, std::move(bounds));
+        } else {
+            return Status(DB_ERROR, msg + "type is neither hash nor range");
+        }
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, msg + ex.what());
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+PartitionKey::PartitionKey(std::string field_name, meta::hybrid::DataType data_type, Type type, int64_t partitions,
+                           std::vector<int64_t> bounds)
+    : field_name_(std::move(field_name)),
+      data_type_(data_type),
+      type_(type),
+      partitions_(partitions),
+      bounds_(std::move(bounds)) {
+}
+
+Status
+PartitionKey::FromFields(const meta::hybrid::FieldsSchema& fields_schema, PartitionKeyPtr& key) {
+    key = nullptr;
+    for (auto& field_schema : fields_schema.fields_schema_) {
+        PartitionKeyPtr field_key;
+        auto status = ParseKey(field_schema, field_key);
+        if (!status.ok()) {
+            return status;
+        }
+        if (field_key == nullptr) {
+            continue;
+        }
+        if (key != nullptr) {
+            return Status(DB_ERROR, "Invalid partition key: fields " + key->FieldName() + " and " +
+                                        field_key->FieldName() + " are both partition keys");
+        }
+        key = field_key;
+    }
+    return Status::OK();
+}
+
+std::string
+PartitionKey::PartitionTag(int64_t partition) {
+    return std::string(PARAM_KEY) + "_" + std::to_string(partition);
+}
+
+void
+PartitionKey::Route(const std::vector<uint8_t>& field_data, uint64_t row_count,
+                    std::vector<int64_t>& partitions) const {
+    partitions.resize(row_count);
+    for (uint64_t i = 0; i < row_count; ++i) {
+        partitions[i] = PartitionOf(ValueAt(field_data.data(), i));
+    }
+}
+
+bool
+PartitionKey::PartitionMayMatch(int64_t partition, const query::GeneralQueryPtr& general_query) const {
+    if (type_ == Type::RANGE) {
+        // the partition as a zone map of its bounds, the conditions on the key are checked like those of a segment
+        segment::AttrZoneMap::Value min, max;
+        min.i_ = (partition == 0) ? std::numeric_limits<int64_t>::min() : bounds_[partition - 1];
+        max.i_ = (partition == partitions_ - 1) ? std::numeric_limits<int64_t>::max() : bounds_[partition] - 1;
+        segment::AttrZoneMaps zone_maps;
+        zone_maps[field_name_] = std::make_shared<segment::AttrZoneMap>(data_type_, 1, 1, std::vector{min},
+                                                                          std::vector{max});
+        return segment::ZoneMapsMayMatch(zone_maps, general_query);
+    }
+
+    // only terms on the key narrow the hash partitions
+    return segment::QueryMayMatch(general_query, [&](const query::LeafQuery& leaf) {
+        if (leaf.term_query == nullptr || leaf.term_query->field_name != field_name_) {
+            return true;
+        }
+        auto& field_value = leaf.term_query->field_value;
+        size_t term_size = field_value.size() / ValueSize(data_type_);
+        for (size_t i = 0; i < term_size; ++i) {
+            if (PartitionOf(ValueAt(field_value.data(), i)) == partition) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+int64_t
+PartitionKey::ValueAt(const uint8_t* data, size_t index) const {
+    switch (data_type_) {
+        case meta::hybrid::DataType::INT8: {
+            int8_t value;
+            memcpy(&value, data + index * sizeof(value), sizeof(value));
+            return value;
+        }
+        case meta::hybrid::DataType::INT16: {
+            int16_t value;
+            memcpy(&value, data + index * sizeof(value), sizeof(value));
+            return value;
+        }
+        case meta::hybrid::DataType::INT32: {
+            int32_t value;
+            memcpy(&value, data + index * sizeof(value), sizeof(value));
+            return value;
+        }
+        default: {
+            int64_t value;
+            memcpy(&value, data + index * sizeof(value), sizeof(value));
+            return value;
+        }
+    }
+}
+
+int64_t
+PartitionKey::PartitionOf(int64_t value) const {
+    if (type_ == Type::HASH) {
+        return MixValue(value) % partitions_;
+    }
+    return std::upper_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+}
+
+}  // namespace engine
+}  // namespace milvus
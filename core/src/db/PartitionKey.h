@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "db/meta/MetaTypes.h"
+#include "query/GeneralQuery.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+class PartitionKey;
+using PartitionKeyPtr = std::shared_ptr<PartitionKey>;
+
+/*
+ * An integer attribute of a hybrid collection whose value picks the partition of each entity inserted without a
+ * partition tag. It is declared in the params of the field:
+ *  {"partition_key": {"type": "hash", "partitions": 8}}
+ *  {"partition_key": {"type": "range", "bounds": [100, 1000]}}  -- (-inf, 100), [100, 1000), [1000, +inf)
+ * The partitions are created with the collection and tagged by PartitionTag(). A query without partition tags only
+ * searches the key partitions its term or range conditions on the key may match.
+ */
+class PartitionKey {
+ public:
+    static constexpr const char* PARAM_KEY = "partition_key";
+    static constexpr int64_t MAX_PARTITIONS = 4096;
+
+    enum class Type {
+        HASH,
+        RANGE,
+    };
+
+    PartitionKey(std::string field_name, meta::hybrid::DataType data_type, Type type, int64_t partitions,
+                 std::vector<int64_t> bounds);
+
+    // the key declared by the fields, key is null if there is none
+    static Status
+    FromFields(const meta::hybrid::FieldsSchema& fields_schema, PartitionKeyPtr& key);
+
+    static std::string
+    PartitionTag(int64_t partition);
+
+    const std::string&
+    FieldName() const {
+        return field_name_;
+    }
+
+    int64_t
+    PartitionCount() const {
+        return partitions_;
+    }
+
+    // the partition of each row, field_data holds the values of the key as the insert copies them to the attrs
+    void
+    Route(const std::vector<uint8_t>& field_data, uint64_t row_count, std::vector<int64_t>& partitions) const;
+
+    // whether some row of the partition may satisfy the query
+    bool
+    PartitionMayMatch(int64_t partition, const query::GeneralQueryPtr& general_query) const;
+
+ private:
+    int64_t
+    ValueAt(const uint8_t* data, size_t index) const;
+
+    int64_t
+    PartitionOf(int64_t value) const;
+
+ private:
+    std::string field_name_;
+    meta::hybrid::DataType data_type_;
+    Type type_;
+    int64_t partitions_;
+    std::vector<int64_t> bounds_;  // ascending, the lower bound of each range partition but the first
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/QueryResultCache.h"
+
+#include <functional>
+
+namespace milvus {
+namespace engine {
+
+QueryResultCache::QueryResultCache(size_t capacity) : lru_(capacity) {
+}
+
+uint64_t
+QueryResultCache::Generation(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generations_[collection_id];
+}
+
+bool
+QueryResultCache::Get(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                      const milvus::json& extra_params, const VectorsData& vectors, ResultIds& result_ids,
+                      ResultDistances& result_distances) {
+    auto search = SearchKey(collection_id, partition_tags, k, extra_params, vectors);
+    auto hash = std::hash<std::string>()(search);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!lru_.exists(hash)) {
+        return false;
+    }
+    auto entry = lru_.get(hash);
+    if (entry->search_ != search || entry->generation_ != generations_[collection_id]) {
+        return false;
+    }
+    result_ids = entry->result_ids_;
+    result_distances = entry->result_distances_;
+    return true;
+}
+
+void
+QueryResultCache::Put(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                      const milvus::json& extra_params, const VectorsData& vectors, uint64_t generation,
+                      const ResultIds& result_ids, const ResultDistances& result_distances) {
+    auto entry = std::make_shared<Entry>();
+    entry->collection_id_ = collection_id;
+    entry->search_ = SearchKey(collection_id, partition_tags, k, extra_params, vectors);
+    entry->generation_ = generation;
+    entry->result_ids_ = result_ids;
+    entry->result_distances_ = result_distances;
+    auto hash = std::hash<std::string>()(entry->search_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generations_[collection_id]) {
+        return;  // the collection changed during the search
+    }
+    lru_.put(hash, entry);
+}
+
+void
+QueryResultCache::Invalidate(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generations_[collection_id];
+
+    // stale entries would be ignored anyway, dropping them keeps room for live ones
+    std::vector<size_t> stale;
+    lru_.visit_victims([&](const std::pair<size_t, EntryPtr>& item) {
+        if (item.second->collection_id_ == collection_id) {
+            stale.push_back(item.first);
+        }
+        return true;
+    });
+    for (auto hash : stale) {
+        lru_.erase(hash);
+    }
+}
+
+size_t
+QueryResultCache::Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+std::string
+QueryResultCache::SearchKey(const std::string& collection_id, const std::vector<std::string>& partition_tags,
+                            uint64_t k, const milvus::json& extra_params, const VectorsData& vectors) {
+    std::string key = collection_id;
+    for (auto& tag : partition_tags) {
+        key += '\0' + tag;
+    }
+    key += '\0' + std::to_string(k) + '\0' + extra_params.dump() + '\0' + std::to_string(vectors.vector_count_);
+    key += '\0';
+    key.append(reinterpret_cast<const char*>(vectors.float_data_.data()), vectors.float_data_.size() * sizeof(float));
+    key += '\0';
+    key.append(reinterpret_cast<const char*>(vectors.binary_data_.data()), vectors.binary_data_.size());
+    return key;
+}
+
+}  // namespace engine
+}  // namespace milvus
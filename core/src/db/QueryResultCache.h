@@ -0,0 +1,80 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/LRU.h"
+#include "db/Types.h"
+#include "utils/Json.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Results of recent searches, keyed by collection, partition tags, topk, search params and query vectors.
+ * Every collection has a generation which Invalidate() bumps whenever the searchable data of the collection
+ * changes. A search reads the generation before it starts and stores its result under it, so a result computed
+ * across a flush is never served afterwards.
+ */
+class QueryResultCache {
+ public:
+    explicit QueryResultCache(size_t capacity);
+
+    uint64_t
+    Generation(const std::string& collection_id);
+
+    // true when a result of the same search and the current generation of the collection is cached
+    bool
+    Get(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+        const milvus::json& extra_params, const VectorsData& vectors, ResultIds& result_ids,
+        ResultDistances& result_distances);
+
+    void
+    Put(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+        const milvus::json& extra_params, const VectorsData& vectors, uint64_t generation,
+        const ResultIds& result_ids, const ResultDistances& result_distances);
+
+    void
+    Invalidate(const std::string& collection_id);
+
+    size_t
+    Size();
+
+ private:
+    struct Entry {
+        std::string collection_id_;
+        std::string search_;  // the whole key, a hash match is confirmed against it
+        uint64_t generation_ = 0;
+        ResultIds result_ids_;
+        ResultDistances result_distances_;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    static std::string
+    SearchKey(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+              const milvus::json& extra_params, const VectorsData& vectors);
+
+ private:
+    std::mutex mutex_;
+    cache::LRU<size_t, EntryPtr> lru_;
+    std::map<std::string, uint64_t> generations_;
+};
+
+using QueryResultCachePtr = std::shared_ptr<QueryResultCache>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,221 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/RecallSampler.h"
+#include "db/Utils.h"
+#include "metrics/Metrics.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/job/SearchJob.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// samples waiting for their exact search, more are dropped so that the sampler never piles up work
+constexpr size_t MAX_PENDING_SAMPLES = 16;
+
+// the recall is computed over the last samples of each collection and index type
+constexpr size_t RECALL_WINDOW_SIZE = 100;
+
+}  // namespace
+
+RecallSampler::RecallSampler(double sample_rate) : sample_rate_(sample_rate) {
+    worker_thread_ = std::thread(&RecallSampler::WorkerFunction, this);
+}
+
+RecallSampler::~RecallSampler() {
+    Stop();
+}
+
+bool
+RecallSampler::ShouldSample() {
+    static thread_local std::mt19937_64 engine(std::random_device{}());
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    return distribution(engine) < sample_rate_;
+}
+
+void
+RecallSampler::Submit(const std::string& collection_id, const std::shared_ptr<meta::FilesHolder>& files_holder,
+                      uint64_t k, const VectorsData& vectors, const ResultIds& result_ids) {
+    // the raw files are searched exactly already, there is nothing to estimate without an index
+    auto& files = files_holder->HoldFiles();
+    auto indexed = std::find_if(files.begin(), files.end(), [](const meta::SegmentSchema& file) {
+        return file.file_type_ == meta::SegmentSchema::INDEX;
+    });
+    if (indexed == files.end() || k == 0) {
+        return;
+    }
+
+    auto sample = std::make_shared<Sample>();
+    sample->collection_id_ = collection_id;
+    sample->index_type_ = utils::GetIndexName(indexed->engine_type_);
+    sample->files_holder_ = files_holder;
+    sample->k_ = k;
+    sample->vectors_ = vectors;
+    sample->result_ids_ = result_ids;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_ || samples_.size() >= MAX_PENDING_SAMPLES) {
+        return;
+    }
+    samples_.push_back(sample);
+    cv_.notify_one();
+}
+
+void
+RecallSampler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        samples_.clear();
+    }
+    cv_.notify_all();
+
+    if (worker_thread_.joinable()) {
+        worker_thread_.join();
+    }
+}
+
+bool
+RecallSampler::GetRecall(const std::string& collection_id, const std::string& index_type, double& recall) {
+    std::lock_guard<std::mutex> lock(windows_mutex_);
+    auto iter = windows_.find(std::make_pair(collection_id, index_type));
+    if (iter == windows_.end() || iter->second.expected_ == 0) {
+        return false;
+    }
+    recall = static_cast<double>(iter->second.hits_) / iter->second.expected_;
+    return true;
+}
+
+void
+RecallSampler::CountHits(const ResultIds& ids, const ResultIds& exact_ids, uint64_t k, int64_t& hits,
+                         int64_t& expected) {
+    hits = 0;
+    expected = 0;
+    if (k == 0) {
+        return;
+    }
+
+    size_t nq = std::min(ids.size(), exact_ids.size()) / k;
+    std::unordered_set<faiss::Index::idx_t> exact;
+    for (size_t i = 0; i < nq; ++i) {
+        exact.clear();
+        for (size_t j = i * k; j < (i + 1) * k; ++j) {
+            if (exact_ids[j] != -1) {
+                exact.insert(exact_ids[j]);
+            }
+        }
+        expected += exact.size();
+        for (size_t j = i * k; j < (i + 1) * k; ++j) {
+            // an id is counted once, even if a buggy index returns it twice
+            if (exact.erase(ids[j]) > 0) {
+                ++hits;
+            }
+        }
+    }
+}
+
+void
+RecallSampler::WorkerFunction() {
+    SetThreadName("recall_sampler");
+
+    while (true) {
+        SamplePtr sample;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !samples_.empty(); });
+            if (stop_) {
+                break;
+            }
+            sample = samples_.front();
+            samples_.pop_front();
+        }
+
+        ResultIds exact_ids;
+        auto status = ExactSearch(*sample, exact_ids);
+        sample->files_holder_->ReleaseFiles();
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to search a recall sample of collection " << sample->collection_id_
+                                << " exactly: " << status.message();
+            continue;
+        }
+
+        int64_t hits = 0, expected = 0;
+        CountHits(sample->result_ids_, exact_ids, sample->k_, hits, expected);
+        if (expected > 0) {
+            Record(*sample, hits, expected);
+        }
+    }
+}
+
+Status
+RecallSampler::ExactSearch(Sample& sample, ResultIds& exact_ids) {
+    // no collection id, the exact searches are not observed as searches of the collection
+    auto job = std::make_shared<scheduler::SearchJob>(nullptr, sample.k_, milvus::json(), sample.vectors_);
+    job->SetPriority(scheduler::JobPriority::LOW);
+    job->SetCacheFiles(false);
+
+    for (auto& file : sample.files_holder_->HoldFiles()) {
+        auto exact_file = std::make_shared<meta::SegmentSchema>(file);
+        if (file.file_type_ == meta::SegmentSchema::INDEX) {
+            // the raw vectors stay in the segment folder after the index is built, they are searched under the
+            // name of the raw file so that the cached index of the segment isn't taken for them
+            std::string segment_dir;
+            utils::GetParentPath(file.location_, segment_dir);
+            exact_file->location_ = segment_dir + "/" + file.segment_id_;
+            exact_file->file_type_ = meta::SegmentSchema::RAW;
+        }
+        exact_file->engine_type_ = utils::IsBinaryMetricType(file.metric_type_)
+                                       ? static_cast<int32_t>(EngineType::FAISS_BIN_IDMAP)
+                                       : static_cast<int32_t>(EngineType::FAISS_IDMAP);
+        job->AddIndexFile(exact_file);
+    }
+
+    scheduler::JobMgrInst::GetInstance()->Put(job);
+    job->WaitResult();
+    if (!job->GetStatus().ok()) {
+        return job->GetStatus();
+    }
+
+    exact_ids = job->GetResultIds();
+    return Status::OK();
+}
+
+void
+RecallSampler::Record(const Sample& sample, int64_t hits, int64_t expected) {
+    double recall = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(windows_mutex_);
+        auto& window = windows_[std::make_pair(sample.collection_id_, sample.index_type_)];
+        window.samples_.emplace_back(hits, expected);
+        window.hits_ += hits;
+        window.expected_ += expected;
+        if (window.samples_.size() > RECALL_WINDOW_SIZE) {
+            window.hits_ -= window.samples_.front().first;
+            window.expected_ -= window.samples_.front().second;
+            window.samples_.pop_front();
+        }
+        recall = static_cast<double>(window.hits_) / window.expected_;
+    }
+
+    LOG_ENGINE_DEBUG_ << "Recall sample of collection " << sample.collection_id_ << " index " << sample.index_type_
+                      << ": " << hits << "/" << expected << ", recall of the last samples " << recall;
+    server::Metrics::GetInstance().SearchRecallSet(sample.collection_id_, sample.index_type_, recall);
+}
+
+}  // namespace engine
+}  // namespace milvus
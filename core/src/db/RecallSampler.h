@@ -0,0 +1,106 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+#include "db/meta/FilesHolder.h"
+#include "utils/Status.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Estimates the recall of the indexes from live searches. A fraction of the searches is kept with its files and
+ * result, and searched again in the background as an exact search over the raw vectors of the same files, at low
+ * priority and without filling the cpu cache. The recall@k of the last samples is reported per collection and
+ * index type, so a change of nprobe or ef shows up in both the latency and the recall.
+ */
+class RecallSampler {
+ public:
+    explicit RecallSampler(double sample_rate);
+
+    ~RecallSampler();
+
+    // whether to sample the search about to run
+    bool
+    ShouldSample();
+
+    // queue a sampled search, files_holder keeps the searched files until the exact search is done,
+    // dropped when no file is indexed or too many samples are waiting
+    void
+    Submit(const std::string& collection_id, const std::shared_ptr<meta::FilesHolder>& files_holder, uint64_t k,
+           const VectorsData& vectors, const ResultIds& result_ids);
+
+    void
+    Stop();
+
+    // recall of the last samples, false if the collection and index type have none
+    bool
+    GetRecall(const std::string& collection_id, const std::string& index_type, double& recall);
+
+    // the exact results found in ids, k results per query, the placeholders of -1 are not expected
+    static void
+    CountHits(const ResultIds& ids, const ResultIds& exact_ids, uint64_t k, int64_t& hits, int64_t& expected);
+
+ private:
+    struct Sample {
+        std::string collection_id_;
+        std::string index_type_;
+        std::shared_ptr<meta::FilesHolder> files_holder_;
+        uint64_t k_ = 0;
+        VectorsData vectors_;
+        ResultIds result_ids_;
+    };
+    using SamplePtr = std::shared_ptr<Sample>;
+
+    struct Window {
+        std::deque<std::pair<int64_t, int64_t>> samples_;  // hits and expected of each sample
+        int64_t hits_ = 0;
+        int64_t expected_ = 0;
+    };
+
+    void
+    WorkerFunction();
+
+    Status
+    ExactSearch(Sample& sample, ResultIds& exact_ids);
+
+    void
+    Record(const Sample& sample, int64_t hits, int64_t expected);
+
+ private:
+    double sample_rate_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<SamplePtr> samples_;
+    bool stop_ = false;
+    std::thread worker_thread_;
+
+    std::mutex windows_mutex_;
+    std::map<std::pair<std::string, std::string>, Window> windows_;  // by collection and index type
+};
+
+using RecallSamplerPtr = std::shared_ptr<RecallSampler>;
+
+}  // namespace engine
+}  // namespace milvus
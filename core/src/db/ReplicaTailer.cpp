@@ -0,0 +1,154 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/ReplicaTailer.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// The writer commits its transactions with the time they started, so one may show up after a later one. The files
+// updated this long before the watermark are asked again, the ones already applied are skipped.
+constexpr int64_t REFRESH_OVERLAP_US = 10 * 1000 * 1000;
+
+bool
+IsSearchable(int32_t file_type) {
+    return file_type == meta::SegmentSchema::RAW || file_type == meta::SegmentSchema::TO_INDEX ||
+           file_type == meta::SegmentSchema::INDEX;
+}
+
+}  // namespace
+
+ReplicaTailer::ReplicaTailer(const meta::MetaPtr& meta, const Loader& loader)
+    : meta_(meta), loader_(loader), view_(std::make_shared<View>()) {
+}
+
+Status
+ReplicaTailer::Refresh() {
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    auto view = CurrentView();
+
+    int64_t since = view->ready_ ? std::max<int64_t>(view->watermark_ - REFRESH_OVERLAP_US, 0) : 0;
+    meta::SegmentsSchema updated;
+    auto status = meta_->FilesUpdatedSince(since, updated);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // the collections changed by this refresh are copied, the others are shared with the current view
+    auto next = std::make_shared<View>(*view);
+    std::unordered_map<std::string, std::shared_ptr<Files>> changed;
+    meta::SegmentsSchema added;
+    for (auto& file : updated) {
+        next->watermark_ = std::max(next->watermark_, file.updated_time_);
+
+        std::shared_ptr<Files> files;
+        auto changed_iter = changed.find(file.collection_id_);
+        if (changed_iter != changed.end()) {
+            files = changed_iter->second;
+        }
+        const Files* current = files.get();
+        if (current == nullptr) {
+            auto iter = view->collections_.find(file.collection_id_);
+            current = (iter != view->collections_.end()) ? iter->second.get() : nullptr;
+        }
+
+        auto file_iter = (current != nullptr) ? current->find(file.id_) : Files::const_iterator();
+        bool present = (current != nullptr) && file_iter != current->end();
+        bool searchable = IsSearchable(file.file_type_);
+        if (present && file_iter->second->updated_time_ == file.updated_time_ &&
+            file_iter->second->file_type_ == file.file_type_) {
+            continue;
+        }
+        if (!present && !searchable) {
+            continue;
+        }
+
+        if (files == nullptr) {
+            files = (current != nullptr) ? std::make_shared<Files>(*current) : std::make_shared<Files>();
+            changed[file.collection_id_] = files;
+        }
+        if (searchable) {
+            // a raw file turning to-index is the same data, only new files are loaded
+            if (!present) {
+                added.push_back(file);
+            }
+            (*files)[file.id_] = std::make_shared<const meta::SegmentSchema>(file);
+        } else {
+            files->erase(file.id_);
+        }
+    }
+
+    // the files of the first refresh are loaded by the searches or the warm up, like on a writable node
+    if (view->ready_ && !added.empty() && loader_) {
+        auto load_status = loader_(added);
+        if (!load_status.ok()) {
+            LOG_ENGINE_WARNING_ << "Failed to load new files of the replica: " << load_status.message();
+        }
+    }
+
+    for (auto& pair : changed) {
+        if (pair.second->empty()) {
+            next->collections_.erase(pair.first);
+        } else {
+            next->collections_[pair.first] = pair.second;
+        }
+    }
+    next->ready_ = true;
+
+    {
+        std::lock_guard<std::mutex> view_lock(view_mutex_);
+        view_ = next;
+    }
+    if (!changed.empty()) {
+        LOG_ENGINE_DEBUG_ << "Replica refreshed " << changed.size() << " collections, " << added.size()
+                          << " new files, watermark " << next->watermark_;
+    }
+    return Status::OK();
+}
+
+bool
+ReplicaTailer::Ready() const {
+    return CurrentView()->ready_;
+}
+
+Status
+ReplicaTailer::FilesToSearch(const std::string& collection_id, meta::FilesHolder& files_holder) const {
+    auto view = CurrentView();
+    auto iter = view->collections_.find(collection_id);
+    if (iter == view->collections_.end()) {
+        return Status::OK();
+    }
+
+    for (auto& pair : *iter->second) {
+        files_holder.MarkFile(pair.second);
+    }
+    return Status::OK();
+}
+
+int64_t
+ReplicaTailer::Watermark() const {
+    return CurrentView()->watermark_;
+}
+
+ReplicaTailer::ViewPtr
+ReplicaTailer::CurrentView() const {
+    std::lock_guard<std::mutex> lock(view_mutex_);
+    return view_;
+}
+
+}  // namespace engine
+}  // namespace milvus
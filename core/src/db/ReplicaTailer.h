@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/FilesHolder.h"
+#include "db/meta/Meta.h"
+#include "utils/Status.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * The searchable files of a readonly node, kept up to date from the files the writable node changes.
+ * Refresh() asks the meta only for the files updated since the last refresh, gives the newly searchable ones to the
+ * loader and then publishes the new set of files at once, so a search sees either the set before a refresh or the
+ * one after it, never a mix. A collection or partition is looked up by the id its files are stored under.
+ */
+class ReplicaTailer {
+ public:
+    // loads the files about to become searchable, the files are published whatever it returns
+    using Loader = std::function<Status(const meta::SegmentsSchema& files)>;
+
+    ReplicaTailer(const meta::MetaPtr& meta, const Loader& loader);
+
+    Status
+    Refresh();
+
+    // false until the first refresh succeeds, the files are to be asked from the meta till then
+    bool
+    Ready() const;
+
+    // marks the searchable files of the collection in the holder
+    Status
+    FilesToSearch(const std::string& collection_id, meta::FilesHolder& files_holder) const;
+
+    int64_t
+    Watermark() const;
+
+ private:
+    using Files = std::map<size_t, meta::SegmentDescPtr>;  // file id -> file
+    using FilesPtr = std::shared_ptr<const Files>;
+
+    struct View {
+        std::unordered_map<std::string, FilesPtr> collections_;
+        int64_t watermark_ = 0;  // the latest update time seen, in microseconds
+        bool ready_ = false;
+    };
+    using ViewPtr = std::shared_ptr<const View>;
+
+    ViewPtr
+    CurrentView() const;
+
+ private:
+    meta::MetaPtr meta_;
+    Loader loader_;
+
+    // only one refresh at a time
+    std::mutex refresh_mutex_;
+
+    mutable std::mutex view_mutex_;
+    ViewPtr view_;
+};
+
+using ReplicaTailerPtr = std::shared_ptr<ReplicaTailer>;
+
+}  // namespace engine
+}  // namespace milvus
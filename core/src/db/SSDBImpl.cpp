@@ -33,6 +33,7 @@
 
 #include <fiu-local.h>
 #include <limits>
+#include <numeric>
 #include <utility>
 
 namespace milvus {
@@ -52,7 +53,10 @@ static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown
     }
 
 SSDBImpl::SSDBImpl(const DBOptions& options)
-    : options_(options), initialized_(false), merge_thread_pool_(1, 1), index_thread_pool_(1, 1) {
+    : options_(options),
+      initialized_(false),
+      merge_thread_pool_(1, 1, "merge"),
+      index_thread_pool_(1, 1, "build_index") {
     mem_mgr_ = MemManagerFactory::SSBuild(options_);
     merge_mgr_ptr_ = MergeManagerFactory::SSBuild(options_);
 
@@ -62,6 +66,9 @@ SSDBImpl::SSDBImpl(const DBOptions& options)
         // 2 buffers in the WAL
         mxlog_config.buffer_size = options_.buffer_size_ / 2;
         mxlog_config.mxlog_path = options_.mxlog_path_;
+        mxlog_config.sync_mode = wal::WalManager::ParseSyncMode(options_.wal_sync_mode_);
+        mxlog_config.sync_interval = options_.wal_sync_interval_;
+        mxlog_config.compress = options_.wal_compress_;
         wal_mgr_ = std::make_shared<wal::WalManager>(mxlog_config);
     }
     Start();
@@ -359,11 +366,12 @@ SSDBImpl::InsertEntities(const std::string& collection_name, const std::string&
     /* Generate id */
     if (data_chunk->fixed_fields_.find(engine::DEFAULT_UID_NAME) == data_chunk->fixed_fields_.end()) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
-        IDNumbers ids;
-        STATUS_CHECK(id_generator.GetNextIDNumbers(data_chunk->count_, ids));
+        IDRange range;
+        STATUS_CHECK(id_generator.GetNextIDRange(data_chunk->count_, range));
         FIXED_FIELD_DATA& id_data = data_chunk->fixed_fields_[engine::DEFAULT_UID_NAME];
-        id_data.resize(ids.size() * sizeof(int64_t));
-        memcpy(id_data.data(), ids.data(), ids.size() * sizeof(int64_t));
+        id_data.resize(range.count_ * sizeof(int64_t));
+        auto id_ptr = reinterpret_cast<int64_t*>(id_data.data());
+        std::iota(id_ptr, id_ptr + range.count_, range.begin_);
     }
 
     if (options_.wal_enable_) {
@@ -744,6 +752,8 @@ SSDBImpl::StartMetricTask() {
     server::Metrics::GetInstance().GPUPercentGaugeSet();
     server::Metrics::GetInstance().GPUMemoryUsageGaugeSet();
     server::Metrics::GetInstance().OctetsSet();
+    server::Metrics::GetInstance().ContentionSet();
+    server::Metrics::GetInstance().MemoryUsageSet();
 
     server::Metrics::GetInstance().CPUCoreUsagePercentSet();
     server::Metrics::GetInstance().GPUTemperature();
@@ -763,6 +773,7 @@ SSDBImpl::BackgroundMetricThread() {
 
         swn_metric_.Wait_For(std::chrono::seconds(BACKGROUND_METRIC_INTERVAL));
         StartMetricTask();
+        cache::CpuCacheMgr::GetInstance()->EnforceMemoryLimit();
         meta::FilesHolder::PrintInfo();
     }
 }
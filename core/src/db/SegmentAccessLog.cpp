@@ -0,0 +1,184 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SegmentAccessLog.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+void
+SegmentAccessLog::Touch(const std::string& location, int64_t file_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& record = records_[location];
+    record.rank_ = ++last_rank_;
+    record.entry_.location_ = location;
+    record.entry_.file_id_ = file_id;
+    record.entry_.hits_++;
+    if (records_.size() > 2 * MAX_ENTRIES) {
+        Prune();
+    }
+}
+
+void
+SegmentAccessLog::TouchGpu(const std::string& location, int64_t device_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = records_.find(location);
+    if (iter != records_.end()) {
+        iter->second.entry_.gpu_device_ = device_id;
+    }
+}
+
+uint64_t
+SegmentAccessLog::Rank(const std::string& location) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = records_.find(location);
+    return iter == records_.end() ? 0 : iter->second.rank_;
+}
+
+std::vector<SegmentAccessLog::Entry>
+SegmentAccessLog::Entries() const {
+    std::vector<std::pair<uint64_t, Entry>> records;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records.reserve(records_.size());
+        for (auto& pair : records_) {
+            records.emplace_back(pair.second.rank_, pair.second.entry_);
+        }
+    }
+    std::sort(records.begin(), records.end(),
+              [](const std::pair<uint64_t, Entry>& a, const std::pair<uint64_t, Entry>& b) {
+                  return a.first > b.first;
+              });
+
+    std::vector<Entry> entries;
+    entries.reserve(std::min(records.size(), MAX_ENTRIES));
+    for (auto& record : records) {
+        if (entries.size() >= MAX_ENTRIES) {
+            break;
+        }
+        entries.emplace_back(std::move(record.second));
+    }
+    return entries;
+}
+
+std::vector<SegmentAccessLog::Entry>
+SegmentAccessLog::Manifest() const {
+    std::vector<Entry> manifest;
+    for (auto& entry : Entries()) {
+        if (entry.cached_) {
+            manifest.emplace_back(std::move(entry));
+        }
+    }
+    // the entries are searched last first, which breaks the ties of hits
+    std::stable_sort(manifest.begin(), manifest.end(),
+                     [](const Entry& a, const Entry& b) { return a.hits_ > b.hits_; });
+    return manifest;
+}
+
+Status
+SegmentAccessLog::Load(const std::string& path) {
+    Clear();
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return Status::OK();
+    }
+
+    // a line is the location, file id, hits, gpu device and cached flag of an entry, separated by tabs
+    std::vector<Entry> entries;
+    std::string line;
+    while (std::getline(file, line) && entries.size() < MAX_ENTRIES) {
+        std::vector<std::string> fields;
+        StringHelpFunctions::SplitStringByDelimeter(line, "\t", fields);
+        if (fields.size() != 5 || fields[0].empty()) {
+            continue;
+        }
+
+        Entry entry;
+        entry.location_ = fields[0];
+        try {
+            entry.file_id_ = std::stoll(fields[1]);
+            entry.hits_ = std::stoll(fields[2]) / 2;
+            entry.gpu_device_ = std::stoll(fields[3]);
+            entry.cached_ = (fields[4] == "1");
+        } catch (std::exception& ex) {
+            LOG_ENGINE_WARNING_ << "Skip invalid line of segment access log " << path << ": " << line;
+            continue;
+        }
+        entries.emplace_back(std::move(entry));
+    }
+    if (file.bad()) {
+        return Status(DB_ERROR, "Failed to read segment access log " + path);
+    }
+
+    // the file lists the last searched first
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto iter = entries.rbegin(); iter != entries.rend(); ++iter) {
+        auto& record = records_[iter->location_];
+        record.rank_ = ++last_rank_;
+        record.entry_ = std::move(*iter);
+    }
+    LOG_ENGINE_DEBUG_ << "Loaded the access order of " << records_.size() << " segment files";
+    return Status::OK();
+}
+
+Status
+SegmentAccessLog::Save(const std::string& path, const std::function<void(Entry&)>& mark) const {
+    auto entries = Entries();
+
+    // a crash while writing leaves the saved log as it was
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        for (auto& entry : entries) {
+            mark(entry);
+            file << entry.location_ << '\t' << entry.file_id_ << '\t' << entry.hits_ << '\t' << entry.gpu_device_
+                 << '\t' << (entry.cached_ ? 1 : 0) << '\n';
+        }
+        if (!file.good()) {
+            return Status(DB_ERROR, "Failed to write segment access log " + temp_path);
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        return Status(DB_ERROR, "Failed to rename segment access log " + temp_path);
+    }
+    return Status::OK();
+}
+
+void
+SegmentAccessLog::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+    last_rank_ = 0;
+}
+
+void
+SegmentAccessLog::Prune() {
+    // only the files searched within the last MAX_ENTRIES searched files can have a rank above the bar
+    uint64_t bar = last_rank_ > MAX_ENTRIES ? last_rank_ - MAX_ENTRIES : 0;
+    for (auto iter = records_.begin(); iter != records_.end();) {
+        if (iter->second.rank_ <= bar) {
+            iter = records_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Status.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * The order and the number of times the segment files were searched, kept across restarts. A preload loads the
+ * files searched last before the others, and the files found in the caches when the log was saved are the warm up
+ * manifest, reloaded after a restart most searched first. Files are keyed by location, a file not searched for the
+ * last MAX_ENTRIES searched files is forgotten.
+ */
+class SegmentAccessLog {
+ public:
+    static constexpr size_t MAX_ENTRIES = 65536;
+
+    struct Entry {
+        std::string location_;
+        int64_t file_id_ = 0;
+        int64_t hits_ = 0;         // the hits of the earlier runs weigh half at each restart
+        int64_t gpu_device_ = -1;  // device the file was last searched on, -1 if none
+        bool cached_ = false;      // in the cpu cache when the log was saved
+    };
+
+    static SegmentAccessLog&
+    GetInstance() {
+        static SegmentAccessLog instance;
+        return instance;
+    }
+
+    void
+    Touch(const std::string& location, int64_t file_id);
+
+    void
+    TouchGpu(const std::string& location, int64_t device_id);
+
+    // the higher the later the file was searched, 0 if it is not in the log
+    uint64_t
+    Rank(const std::string& location) const;
+
+    // entries searched last first
+    std::vector<Entry>
+    Entries() const;
+
+    // entries cached when the log was loaded, most searched first
+    std::vector<Entry>
+    Manifest() const;
+
+    // replace the log with the one saved at path, a missing file leaves it empty
+    Status
+    Load(const std::string& path);
+
+    // mark sets whether the file of an entry is cached now, and clears a gpu device not holding it
+    Status
+    Save(const std::string& path, const std::function<void(Entry&)>& mark) const;
+
+    void
+    Clear();
+
+ private:
+    SegmentAccessLog() = default;
+
+    void
+    Prune();
+
+ private:
+    struct Record {
+        uint64_t rank_ = 0;
+        Entry entry_;
+    };
+
+    mutable std::mutex mutex_;
+    uint64_t last_rank_ = 0;
+    std::unordered_map<std::string, Record> records_;
+};
+
+}  // namespace engine
+}  // namespace milvus
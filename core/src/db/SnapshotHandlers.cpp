@@ -140,10 +140,14 @@ GetEntityByIdSegmentHandler::Handle(const snapshot::SegmentPtr& segment) {
 
     auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
 
+    std::vector<bool> may_exist;
+    id_bloom_filter_ptr->CheckMany(ids_, may_exist);
+
     std::vector<int64_t> offsets;
-    for (auto id : ids_) {
+    for (size_t i = 0; i < ids_.size(); ++i) {
+        auto id = ids_[i];
         // fast check using bloom filter
-        if (!id_bloom_filter_ptr->Check(id)) {
+        if (!may_exist[i]) {
             continue;
         }
 
@@ -0,0 +1,224 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/StorageTier.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr const char* LINK_SUFFIX = ".tier_link";
+constexpr const char* ASIDE_SUFFIX = ".tier_aside";
+constexpr const char* STAGING_SUFFIX = ".tier_staging";
+
+// Makes the directory to a copy of the segment directory from, the files of to of the same size and written in a later
+// second than those of from are kept. The segment directories hold their files only.
+Status
+SyncSegmentFiles(const fs::path& from, const fs::path& to) {
+    boost::system::error_code ec, ignored;
+    fs::create_directories(to, ec);
+    for (fs::directory_iterator iter(to, ec), end; !ec && iter != end; iter.increment(ec)) {
+        if (!fs::exists(from / iter->path().filename(), ignored)) {
+            fs::remove(iter->path(), ignored);
+        }
+    }
+    for (fs::directory_iterator iter(from, ec), end; !ec && iter != end; iter.increment(ec)) {
+        auto& source = iter->path();
+        if (!fs::is_regular_file(source, ignored)) {
+            continue;
+        }
+        fs::path target = to / source.filename();
+        if (fs::exists(target, ignored) && fs::file_size(target, ignored) == fs::file_size(source, ignored) &&
+            fs::last_write_time(target, ignored) > fs::last_write_time(source, ignored)) {
+            continue;
+        }
+        fs::remove(target, ignored);
+        fs::copy_file(source, target, ec);
+        if (ec) {
+            break;
+        }
+    }
+    if (ec) {
+        fs::remove_all(to, ignored);
+        return Status(DB_ERROR,
+                      "Failed to copy segment " + from.string() + " to " + to.string() + ": " + ec.message());
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+StorageTier::StorageTier(const std::string& hot_path, const std::string& cold_path)
+    : hot_path_(hot_path), cold_path_(cold_path) {
+}
+
+bool
+StorageTier::IsCold(const std::string& segment_dir) {
+    boost::system::error_code ec;
+    return fs::is_symlink(segment_dir, ec);
+}
+
+Status
+StorageTier::Stage(const std::string& segment_dir) {
+    if (IsCold(segment_dir)) {
+        boost::system::error_code ec;
+        fs::path cold_dir = fs::read_symlink(segment_dir, ec);
+        if (ec) {
+            return Status(DB_ERROR, "Failed to read the link of segment " + segment_dir + ": " + ec.message());
+        }
+        return SyncSegmentFiles(cold_dir, segment_dir + STAGING_SUFFIX);
+    }
+
+    std::string cold_dir;
+    STATUS_CHECK(ColdDir(segment_dir, cold_dir));
+    return SyncSegmentFiles(segment_dir, cold_dir);
+}
+
+Status
+StorageTier::Demote(const std::string& segment_dir) {
+    if (IsCold(segment_dir)) {
+        return Status::OK();
+    }
+    std::string cold_dir;
+    STATUS_CHECK(ColdDir(segment_dir, cold_dir));
+    STATUS_CHECK(SyncSegmentFiles(segment_dir, cold_dir));
+
+    // a file opened between the two renames is not found, the files open already stay readable until closed
+    boost::system::error_code ec, ignored;
+    std::string link = segment_dir + LINK_SUFFIX;
+    std::string aside = segment_dir + ASIDE_SUFFIX;
+    fs::remove(link, ignored);
+    fs::create_directory_symlink(cold_dir, link, ec);
+    if (!ec) {
+        fs::rename(segment_dir, aside, ec);
+        if (!ec) {
+            fs::rename(link, segment_dir, ec);
+            if (ec) {
+                fs::rename(aside, segment_dir, ignored);
+            }
+        }
+    }
+    if (ec) {
+        fs::remove(link, ignored);
+        fs::remove_all(cold_dir, ignored);
+        return Status(DB_ERROR, "Failed to link segment " + segment_dir + " to " + cold_dir + ": " + ec.message());
+    }
+
+    fs::remove_all(aside, ignored);
+    LOG_ENGINE_DEBUG_ << "Segment " << segment_dir << " demoted to " << cold_dir;
+    return Status::OK();
+}
+
+Status
+StorageTier::Promote(const std::string& segment_dir) {
+    if (!IsCold(segment_dir)) {
+        return Status::OK();
+    }
+    boost::system::error_code ec, ignored;
+    fs::path cold_dir = fs::read_symlink(segment_dir, ec);
+    if (ec) {
+        return Status(DB_ERROR, "Failed to read the link of segment " + segment_dir + ": " + ec.message());
+    }
+    std::string staging = segment_dir + STAGING_SUFFIX;
+    STATUS_CHECK(SyncSegmentFiles(cold_dir, staging));
+
+    fs::remove(segment_dir, ec);
+    if (!ec) {
+        fs::rename(staging, segment_dir, ec);
+        if (ec) {
+            fs::create_directory_symlink(cold_dir, segment_dir, ignored);
+        }
+    }
+    if (ec) {
+        fs::remove_all(staging, ignored);
+        return Status(DB_ERROR, "Failed to move segment " + cold_dir.string() + " to " + segment_dir + ": " +
+                                    ec.message());
+    }
+
+    fs::remove_all(cold_dir, ignored);
+    LOG_ENGINE_DEBUG_ << "Segment " << segment_dir << " promoted from " << cold_dir.string();
+    return Status::OK();
+}
+
+void
+StorageTier::RemoveSegment(const std::string& segment_dir) {
+    boost::system::error_code ec;
+    if (IsCold(segment_dir)) {
+        fs::path cold_dir = fs::read_symlink(segment_dir, ec);
+        if (!ec) {
+            fs::remove_all(cold_dir, ec);
+        }
+    }
+    fs::remove_all(segment_dir, ec);
+}
+
+void
+StorageTier::Plan(const std::vector<Segment>& segments, int64_t capacity, uint64_t promote_rank,
+                  std::vector<std::string>& demote, std::vector<std::string>& promote) {
+    demote.clear();
+    promote.clear();
+
+    int64_t hot_size = 0;
+    std::vector<const Segment*> hot, cold;
+    for (auto& segment : segments) {
+        if (segment.cold_) {
+            if (segment.rank_ > promote_rank) {
+                cold.push_back(&segment);
+            }
+        } else {
+            hot_size += segment.size_;
+            if (!segment.pinned_) {
+                hot.push_back(&segment);
+            }
+        }
+    }
+
+    if (hot_size > capacity) {
+        std::sort(hot.begin(), hot.end(), [](const Segment* a, const Segment* b) { return a->rank_ < b->rank_; });
+        for (auto segment : hot) {
+            if (hot_size <= capacity) {
+                break;
+            }
+            demote.push_back(segment->dir_);
+            hot_size -= segment->size_;
+        }
+        return;
+    }
+
+    int64_t room = static_cast<int64_t>(capacity * PROMOTE_RATIO) - hot_size;
+    std::sort(cold.begin(), cold.end(), [](const Segment* a, const Segment* b) { return a->rank_ > b->rank_; });
+    for (auto segment : cold) {
+        if (segment->size_ <= room) {
+            promote.push_back(segment->dir_);
+            room -= segment->size_;
+        }
+    }
+}
+
+Status
+StorageTier::ColdDir(const std::string& segment_dir, std::string& cold_dir) const {
+    if (segment_dir.compare(0, hot_path_.size(), hot_path_) != 0) {
+        return Status(DB_INVALID_PATH, "Segment " + segment_dir + " is not under " + hot_path_);
+    }
+    cold_dir = cold_path_ + segment_dir.substr(hot_path_.size());
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
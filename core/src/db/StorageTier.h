@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Two storage tiers of the segments: the hot one is the db path, usually a local disk, the cold one is a mirror of it
+ * on a larger and slower file system, such as a network or object store mount. A demoted segment directory is moved
+ * to the mirror and replaced by a symbolic link, so the meta, the readers and the writers keep the same location and
+ * read through to the cold copy. A promoted segment is copied back and the link replaced by the directory.
+ */
+class StorageTier {
+ public:
+    // hot tier room kept free by the promotions, so that a promoted segment is not demoted by the next flush
+    static constexpr double PROMOTE_RATIO = 0.9;
+
+    struct Segment {
+        std::string dir_;
+        int64_t size_ = 0;
+        uint64_t rank_ = 0;    // SegmentAccessLog rank of its files, 0 if not searched lately
+        bool cold_ = false;
+        bool pinned_ = false;  // created lately, kept hot whatever its rank
+    };
+
+    StorageTier(const std::string& hot_path, const std::string& cold_path);
+
+    static bool
+    IsCold(const std::string& segment_dir);
+
+    // Copies a segment to the tier it is moved to, without moving it yet. The copy is made before taking the locks
+    // of the writers of the segment, Demote and Promote then copy only the files changed since.
+    Status
+    Stage(const std::string& segment_dir);
+
+    Status
+    Demote(const std::string& segment_dir);
+
+    Status
+    Promote(const std::string& segment_dir);
+
+    // removes a segment directory and the cold copy it links to
+    static void
+    RemoveSegment(const std::string& segment_dir);
+
+    // The segments to demote so that the hot ones fit the capacity, least recently searched first. When they fit,
+    // the cold segments searched after promote_rank to promote, most recently searched first, while they fit
+    // PROMOTE_RATIO of the capacity.
+    static void
+    Plan(const std::vector<Segment>& segments, int64_t capacity, uint64_t promote_rank,
+         std::vector<std::string>& demote, std::vector<std::string>& promote);
+
+ private:
+    Status
+    ColdDir(const std::string& segment_dir, std::string& cold_dir) const;
+
+ private:
+    std::string hot_path_;
+    std::string cold_path_;
+};
+
+using StorageTierPtr = std::shared_ptr<StorageTier>;
+
+}  // namespace engine
+}  // namespace milvus
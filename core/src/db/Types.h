@@ -74,6 +74,16 @@ struct QueryResult {
     std::vector<engine::AttrsData> attrs_;
 };
 
+// the startup preload, the hot files are the ones searched before the last shutdown
+struct WarmUpProgress {
+    int64_t hot_files_ = 0;
+    int64_t total_files_ = 0;
+    int64_t loaded_files_ = 0;
+    int64_t loaded_bytes_ = 0;
+    bool hot_loaded_ = false;
+    bool done_ = false;
+};
+
 using File2ErrArray = std::map<std::string, std::vector<std::string>>;
 using Table2FileErr = std::map<std::string, File2ErrArray>;
 
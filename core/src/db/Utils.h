@@ -44,6 +44,10 @@ DeleteCollectionFilePath(const DBMetaOptions& options, meta::SegmentSchema& tabl
 Status
 DeleteSegment(const DBMetaOptions& options, meta::SegmentSchema& table_file);
 
+// erases the cached id index and vector summary of a segment before its directory is removed
+Status
+EraseSegmentFromCache(const DBMetaOptions& options, meta::SegmentSchema& table_file, std::string& segment_dir);
+
 Status
 GetParentPath(const std::string& path, std::string& parent_path);
 
@@ -62,6 +66,14 @@ meta::DateT
 GetDate();
 meta::DateT
 GetDateWithDelta(int day_delta);
+// days since the epoch of a date of GetDate
+int64_t
+GetDateDays(meta::DateT date);
+
+int64_t
+GetCollectionTTL(int64_t flag);
+int64_t
+SetCollectionTTL(int64_t flag, int64_t ttl_days);
 
 struct MetaUriInfo {
     std::string dialect_;
@@ -46,7 +46,13 @@ class AttrIndex : public milvus::cache::DataObj {
         entity_count_ = entity_count;
     }
 
-    std::unordered_map<std::string, knowhere::IndexPtr>
+    // raw columns of the attributes without a structured index
+    void
+    SetRawData(std::unordered_map<std::string, std::vector<uint8_t>> raw_data) {
+        raw_data_ = std::move(raw_data);
+    }
+
+    const std::unordered_map<std::string, knowhere::IndexPtr>&
     attr_index_data() {
         return index_data_;
     }
@@ -56,6 +62,11 @@ class AttrIndex : public milvus::cache::DataObj {
         return index_size_;
     }
 
+    const std::unordered_map<std::string, std::vector<uint8_t>>&
+    attr_raw_data() {
+        return raw_data_;
+    }
+
     int64_t
     entity_count() {
         return entity_count_;
@@ -68,6 +79,9 @@ class AttrIndex : public milvus::cache::DataObj {
         for (; attr_it != index_size_.end(); attr_it++) {
             attr_data_size += attr_it->first.size() + attr_it->second;
         }
+        for (auto& raw : raw_data_) {
+            attr_data_size += raw.first.size() + raw.second.size();
+        }
         return attr_data_size;
     }
 
@@ -79,7 +93,8 @@ class AttrIndex : public milvus::cache::DataObj {
  private:
     std::unordered_map<std::string, knowhere::IndexPtr> index_data_;
     std::unordered_map<std::string, int64_t> index_size_;
-    int64_t entity_count_;
+    std::unordered_map<std::string, std::vector<uint8_t>> raw_data_;
+    int64_t entity_count_ = 0;
 };
 
 using AttrIndexPtr = std::shared_ptr<AttrIndex>;
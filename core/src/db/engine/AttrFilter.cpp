@@ -0,0 +1,223 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/AttrFilter.h"
+
+#include <faiss/FaissHook.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr int64_t WORD_ROWS = 64;
+
+// more terms than this are probed in a hash set rather than compared one pass each
+constexpr size_t SCAN_MAX_TERMS = 16;
+
+enum class Merge {
+    SET,
+    AND,
+    OR,
+};
+
+#define ATTR_FILTER_INLINE inline __attribute__((always_inline))
+
+template <typename T, typename Compare>
+ATTR_FILTER_INLINE uint64_t
+CompareWord(const T* rows, int64_t n, T value, Compare compare) {
+    uint64_t word = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        word |= static_cast<uint64_t>(compare(rows[i], value)) << i;
+    }
+    return word;
+}
+
+ATTR_FILTER_INLINE void
+MergeWord(uint8_t* bits, int64_t begin, int64_t n, uint64_t word, Merge merge) {
+    // bit i of the bitset is bit i % 8 of byte i / 8, the layout of a little endian word
+    uint8_t* dst = bits + begin / 8;
+    size_t bytes = (n + 7) / 8;
+    if (merge != Merge::SET) {
+        uint64_t old = 0;
+        memcpy(&old, dst, bytes);
+        word = merge == Merge::AND ? (word & old) : (word | old);
+    }
+    memcpy(dst, &word, bytes);
+}
+
+template <typename T, typename Compare>
+ATTR_FILTER_INLINE void
+CompareColumn(const T* column, int64_t row_count, T value, Compare compare, Merge merge, uint8_t* bits) {
+    int64_t full = row_count / WORD_ROWS * WORD_ROWS;
+    for (int64_t begin = 0; begin < full; begin += WORD_ROWS) {
+        MergeWord(bits, begin, WORD_ROWS, CompareWord(column + begin, WORD_ROWS, value, compare), merge);
+    }
+    if (full < row_count) {
+        int64_t n = row_count - full;
+        MergeWord(bits, full, n, CompareWord(column + full, n, value, compare), merge);
+    }
+}
+
+template <typename T>
+ATTR_FILTER_INLINE void
+CompareColumn(const T* column, int64_t row_count, query::CompareOperator op, T value, Merge merge, uint8_t* bits) {
+    switch (op) {
+        case query::CompareOperator::LT:
+            CompareColumn(column, row_count, value, std::less<T>(), merge, bits);
+            break;
+        case query::CompareOperator::LTE:
+            CompareColumn(column, row_count, value, std::less_equal<T>(), merge, bits);
+            break;
+        case query::CompareOperator::EQ:
+            CompareColumn(column, row_count, value, std::equal_to<T>(), merge, bits);
+            break;
+        case query::CompareOperator::GT:
+            CompareColumn(column, row_count, value, std::greater<T>(), merge, bits);
+            break;
+        case query::CompareOperator::GTE:
+            CompareColumn(column, row_count, value, std::greater_equal<T>(), merge, bits);
+            break;
+        case query::CompareOperator::NE:
+            CompareColumn(column, row_count, value, std::not_equal_to<T>(), merge, bits);
+            break;
+    }
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void
+CompareColumnAvx2(const T* column, int64_t row_count, query::CompareOperator op, T value, Merge merge,
+                  uint8_t* bits) {
+    CompareColumn(column, row_count, op, value, merge, bits);
+}
+
+template <typename T>
+void
+CompareColumnDefault(const T* column, int64_t row_count, query::CompareOperator op, T value, Merge merge,
+                     uint8_t* bits) {
+    CompareColumn(column, row_count, op, value, merge, bits);
+}
+
+template <typename T>
+void
+DispatchCompareColumn(const T* column, int64_t row_count, query::CompareOperator op, T value, Merge merge,
+                      uint8_t* bits) {
+    static const bool avx2 = faiss::support_avx2();
+    if (avx2) {
+        CompareColumnAvx2(column, row_count, op, value, merge, bits);
+    } else {
+        CompareColumnDefault(column, row_count, op, value, merge, bits);
+    }
+}
+
+template <typename T>
+Status
+RangeColumn(const std::vector<uint8_t>& column, int64_t row_count, const std::vector<query::CompareExpr>& exprs,
+            faiss::ConcurrentBitsetPtr& bitset) {
+    if (column.size() < row_count * sizeof(T)) {
+        return Status(DB_ERROR, "Attribute column is shorter than the rows");
+    }
+
+    auto data = reinterpret_cast<const T*>(column.data());
+    bitset = std::make_shared<faiss::ConcurrentBitset>(row_count);
+    auto merge = Merge::SET;
+    for (auto& expr : exprs) {
+        DispatchCompareColumn(data, row_count, expr.compare_operator, ParseAttrOperand<T>(expr.operand), merge,
+                              bitset->mutable_data());
+        merge = Merge::AND;
+    }
+    return Status::OK();
+}
+
+template <typename T>
+Status
+TermColumn(const std::vector<uint8_t>& column, int64_t row_count, const std::vector<uint8_t>& field_value,
+           faiss::ConcurrentBitsetPtr& bitset) {
+    if (column.size() < row_count * sizeof(T)) {
+        return Status(DB_ERROR, "Attribute column is shorter than the rows");
+    }
+
+    auto data = reinterpret_cast<const T*>(column.data());
+    std::vector<T> terms(field_value.size() / sizeof(T));
+    memcpy(terms.data(), field_value.data(), terms.size() * sizeof(T));
+    bitset = std::make_shared<faiss::ConcurrentBitset>(row_count);
+    auto bits = bitset->mutable_data();
+
+    if (terms.size() > SCAN_MAX_TERMS) {
+        std::unordered_set<T> term_set(terms.begin(), terms.end());
+        for (int64_t i = 0; i < row_count; ++i) {
+            if (term_set.count(data[i]) > 0) {
+                bitset->set(i);
+            }
+        }
+        return Status::OK();
+    }
+
+    auto merge = Merge::SET;
+    for (auto term : terms) {
+        DispatchCompareColumn(data, row_count, query::CompareOperator::EQ, term, merge, bits);
+        merge = Merge::OR;
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+Status
+FilterAttrRange(meta::hybrid::DataType data_type, const std::vector<uint8_t>& column, int64_t row_count,
+                const std::vector<query::CompareExpr>& exprs, faiss::ConcurrentBitsetPtr& bitset) {
+    switch (data_type) {
+        case meta::hybrid::DataType::INT8:
+            return RangeColumn<int8_t>(column, row_count, exprs, bitset);
+        case meta::hybrid::DataType::INT16:
+            return RangeColumn<int16_t>(column, row_count, exprs, bitset);
+        case meta::hybrid::DataType::INT32:
+            return RangeColumn<int32_t>(column, row_count, exprs, bitset);
+        case meta::hybrid::DataType::INT64:
+            return RangeColumn<int64_t>(column, row_count, exprs, bitset);
+        case meta::hybrid::DataType::FLOAT:
+            return RangeColumn<float>(column, row_count, exprs, bitset);
+        case meta::hybrid::DataType::DOUBLE:
+            return RangeColumn<double>(column, row_count, exprs, bitset);
+        default:
+            return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
+    }
+}
+
+Status
+FilterAttrTerm(meta::hybrid::DataType data_type, const std::vector<uint8_t>& column, int64_t row_count,
+               const std::vector<uint8_t>& field_value, faiss::ConcurrentBitsetPtr& bitset) {
+    switch (data_type) {
+        case meta::hybrid::DataType::INT8:
+            return TermColumn<int8_t>(column, row_count, field_value, bitset);
+        case meta::hybrid::DataType::INT16:
+            return TermColumn<int16_t>(column, row_count, field_value, bitset);
+        case meta::hybrid::DataType::INT32:
+            return TermColumn<int32_t>(column, row_count, field_value, bitset);
+        case meta::hybrid::DataType::INT64:
+            return TermColumn<int64_t>(column, row_count, field_value, bitset);
+        case meta::hybrid::DataType::FLOAT:
+            return TermColumn<float>(column, row_count, field_value, bitset);
+        case meta::hybrid::DataType::DOUBLE:
+            return TermColumn<double>(column, row_count, field_value, bitset);
+        default:
+            return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
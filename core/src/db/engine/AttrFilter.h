@@ -0,0 +1,60 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/utils/ConcurrentBitset.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "db/meta/MetaTypes.h"
+#include "query/GeneralQuery.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// the operand of a compare expression as a value of the attribute type, 0 if it is not a number
+template <typename T>
+T
+ParseAttrOperand(const std::string& operand) {
+    if (std::is_floating_point<T>::value) {
+        std::istringstream iss(operand);
+        double value = 0;
+        iss >> value;
+        return static_cast<T>(value);
+    }
+    return static_cast<T>(atoll(operand.c_str()));
+}
+
+/*
+ * Filters the raw column of an attribute which has no structured index, a segment whose attribute index was never
+ * written for one. The rows are compared 64 at a time into a word of the bitset by a loop without branches, which
+ * the compiler vectorizes, and which runs as an avx2 build on the cpus supporting it.
+ */
+
+// rows of the column satisfying all the compare expressions
+Status
+FilterAttrRange(meta::hybrid::DataType data_type, const std::vector<uint8_t>& column, int64_t row_count,
+                const std::vector<query::CompareExpr>& exprs, faiss::ConcurrentBitsetPtr& bitset);
+
+// rows of the column equal to one of the terms, field_value holds them as raw values of the data type
+Status
+FilterAttrTerm(meta::hybrid::DataType data_type, const std::vector<uint8_t>& column, int64_t row_count,
+               const std::vector<uint8_t>& field_value, faiss::ConcurrentBitsetPtr& bitset);
+
+}  // namespace engine
+}  // namespace milvus
@@ -33,6 +33,9 @@ using SearchJobPtr = std::shared_ptr<SearchJob>;
 
 namespace engine {
 
+// the ids of the rows of a segment by offset, kept alive by whatever holds them
+using SegmentUidsPtr = std::shared_ptr<const std::vector<int64_t>>;
+
 class ExecutionEngine {
  public:
     virtual Status
@@ -62,6 +65,15 @@ class ExecutionEngine {
     virtual Status
     CopyToGpu(uint64_t device_id, bool hybrid) = 0;
 
+    // queue an asynchronous copy of the loaded cpu index to gpu cache, the engine itself is not changed
+    virtual Status
+    PrefetchToGpu(uint64_t device_id) = 0;
+
+    // queue an asynchronous load of the file and copy to gpu cache without loading this engine,
+    // size is the expected size of the index
+    virtual Status
+    PrefetchFileToGpu(uint64_t device_id, int64_t size) = 0;
+
     virtual Status
     CopyToIndexFileToGpu(uint64_t device_id) = 0;
 
@@ -87,6 +99,10 @@ class ExecutionEngine {
                     std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
                     std::string& vector_placeholder) = 0;
 
+    // check the attribute zone maps of the segment, may_match is false if no entity can satisfy general_query
+    virtual Status
+    PruneByZoneMap(query::GeneralQueryPtr general_query, bool& may_match) = 0;
+
     virtual Status
     HybridSearch(scheduler::SearchJobPtr job, std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
                  std::vector<float>& distances, std::vector<int64_t>& search_ids, bool hybrid) = 0;
@@ -94,12 +110,29 @@ class ExecutionEngine {
     virtual Status
     Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job, bool hybrid) = 0;
 
+    // Search leaving the results as row offsets of the segment, uids maps them to ids later. An engine which can't
+    // leave them as offsets returns the ids and a null uids
+    virtual Status
+    SearchOffsets(std::vector<int64_t>& offsets, std::vector<float>& distances, scheduler::SearchJobPtr job,
+                  bool hybrid, SegmentUidsPtr& uids) = 0;
+
     virtual std::shared_ptr<ExecutionEngine>
     BuildIndex(const std::string& location, EngineType engine_type) = 0;
 
+    // derive the index of a compacted segment from the loaded index without training or encoding again,
+    // new_offsets maps each offset of this segment to its offset in the compacted one, -1 for the deleted ones,
+    // return nullptr if the index type doesn't support it
+    virtual std::shared_ptr<ExecutionEngine>
+    CompactIndex(const std::string& location, const std::vector<int64_t>& new_offsets) = 0;
+
     virtual Status
     Cache() = 0;
 
+    // cache the index in place of the one cached at old_location, cached is false if it doesn't fit in the free
+    // cache space, the old one is evicted either way
+    virtual Status
+    CacheReplacing(const std::string& old_location, bool& cached) = 0;
+
     virtual Status
     AttrCache() = 0;
 
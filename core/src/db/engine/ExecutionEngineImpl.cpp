@@ -11,24 +11,44 @@
 
 #include "db/engine/ExecutionEngineImpl.h"
 
+#include <faiss/FaissHook.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/clone_index.h>
+#include <faiss/index_io.h>
 #include <faiss/utils/ConcurrentBitset.h>
+#include <faiss/utils/Heap.h>
 #include <fiu-local.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "cache/GpuResidencyMgr.h"
 #include "config/Config.h"
 #include "db/Utils.h"
+#include "db/engine/AttrFilter.h"
+#include "db/engine/HybridSearchPlan.h"
 #include "knowhere/common/Config.h"
-#include "knowhere/index/structured_index/StructuredIndexSort.h"
+#include "knowhere/index/structured_index/StructuredIndex.h"
 #include "knowhere/index/vector_index/ConfAdapter.h"
 #include "knowhere/index/vector_index/ConfAdapterMgr.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+#include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -38,7 +58,11 @@
 #include "knowhere/index/vector_index/gpu/Quantizer.h"
 #include "knowhere/index/vector_index/helpers/Cloner.h"
 #endif
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IVFCompact.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
 #include "metrics/Metrics.h"
 #include "scheduler/Utils.h"
 #include "scheduler/job/SearchJob.h"
@@ -89,7 +113,8 @@ MappingMetricType(MetricType metric_type, milvus::json& conf) {
 
 bool
 IsBinaryIndexType(knowhere::IndexType type) {
-    return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
+    return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT ||
+           type == knowhere::IndexEnum::INDEX_FAISS_BIN_HASH;
 }
 
 codec::ExternalData
@@ -109,6 +134,521 @@ GetIndexDataType(EngineType type) {
     }
 }
 
+// the faiss ivf index behind a cpu ivf index, nullptr for the other indexes
+faiss::IndexIVF*
+GetCpuIVFIndex(const knowhere::VecIndexPtr& index) {
+    if (index->index_mode() != knowhere::IndexMode::MODE_CPU) {
+        return nullptr;
+    }
+    if (auto ivf = std::dynamic_pointer_cast<knowhere::IVF>(index)) {
+        return dynamic_cast<faiss::IndexIVF*>(ivf->index_.get());
+    }
+    if (auto ivf_nm = std::dynamic_pointer_cast<knowhere::IVF_NM>(index)) {
+        return dynamic_cast<faiss::IndexIVF*>(ivf_nm->index_.get());
+    }
+    return nullptr;
+}
+
+uint64_t
+GetCentroidsFingerprint(const knowhere::VecIndexPtr& index) {
+    if (auto ivf = std::dynamic_pointer_cast<knowhere::IVF>(index)) {
+        return ivf->CentroidsFingerprint();
+    }
+    if (auto ivf_nm = std::dynamic_pointer_cast<knowhere::IVF_NM>(index)) {
+        return ivf_nm->CentroidsFingerprint();
+    }
+    return 0;
+}
+
+// the float ivf types trained on cpu by knowhere::TrainIVF, and IVFSQ8H which takes the shared centroids on gpu
+bool
+IsSharedQuantizerType(EngineType type) {
+    return type == EngineType::FAISS_IVFFLAT || type == EngineType::FAISS_IVFSQ8 ||
+           type == EngineType::FAISS_IVFSQ8NR || type == EngineType::FAISS_PQ ||
+           type == EngineType::FAISS_PQ_FASTSCAN || type == EngineType::FAISS_IVFSQ8H;
+}
+
+// the gpu cache key of the quantizer of a hybrid index, the segments trained with the same centroids share one
+// quantizer per device
+std::string
+HybridQuantizerKey(const knowhere::VecIndexPtr& index, const std::string& location) {
+    auto fingerprint = GetCentroidsFingerprint(index);
+    if (fingerprint == 0) {
+        return location + ".quantizer";
+    }
+    return "quantizer_" + std::to_string(fingerprint);
+}
+
+// the compression of the float raw files loaded into the cache, one of knowhere::Compression. The gpu only takes
+// the flat ones
+std::string
+RawVectorCompression() {
+    server::Config& config = server::Config::GetInstance();
+#ifdef MILVUS_GPU_VERSION
+    bool gpu_enable = false;
+    if (config.GetGpuResourceConfigEnable(gpu_enable).ok() && gpu_enable) {
+        return knowhere::Compression::NONE;
+    }
+#endif
+    std::string compression;
+    if (!config.GetEngineConfigRawVectorCompression(compression).ok()) {
+        return knowhere::Compression::NONE;
+    }
+    return compression;
+}
+
+#ifdef MILVUS_GPU_VERSION
+// the gpu indexes whose inverted lists can be spread over several devices
+bool
+IsShardableType(EngineType type) {
+    return type == EngineType::FAISS_IVFFLAT || type == EngineType::FAISS_IVFSQ8 || type == EngineType::FAISS_PQ;
+}
+
+// the search devices an index too large for the gpu cache of device_id is spread over, device_id first,
+// only the IVF indexes keeping their codes in the inverted lists are sharded
+bool
+ShardedSearchDevices(EngineType type, const knowhere::VecIndexPtr& index, uint64_t device_id,
+                     std::vector<int64_t>& devices) {
+    if (!IsShardableType(type) || std::dynamic_pointer_cast<knowhere::IVF>(index) == nullptr) {
+        return false;
+    }
+
+    server::Config& config = server::Config::GetInstance();
+    bool sharded = false;
+    std::vector<int64_t> search_devices;
+    config.GetGpuResourceConfigSearchSharded(sharded);
+    if (!sharded || !config.GetGpuResourceConfigSearchResources(search_devices).ok() || search_devices.size() < 2) {
+        return false;
+    }
+    if (index->Size() <= cache::GpuCacheMgr::GetInstance(device_id)->CacheCapacity()) {
+        return false;
+    }
+
+    devices = {static_cast<int64_t>(device_id)};
+    for (auto search_device : search_devices) {
+        if (search_device != static_cast<int64_t>(device_id)) {
+            devices.push_back(search_device);
+        }
+    }
+    return true;
+}
+#endif
+
+// the centroids shared by the segments of a collection live next to its segment folders, one file per nlist
+// and metric since the nlist is tuned by the row count of each segment
+std::string
+SharedQuantizerPath(const std::string& location, const milvus::json& conf) {
+    std::string segment_path, collection_path;
+    utils::GetParentPath(location, segment_path);
+    utils::GetParentPath(segment_path, collection_path);
+    return collection_path + "/ivf_quantizer_" + conf[knowhere::Metric::TYPE].get<std::string>() + "_" +
+           std::to_string(conf[knowhere::IndexParams::nlist].get<int64_t>());
+}
+
+// false if no segment of the collection saved its centroids yet
+bool
+LoadSharedCentroids(const std::string& path, int64_t dim, int64_t nlist, std::vector<float>& centroids) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    fclose(file);
+
+    try {
+        std::unique_ptr<faiss::Index> index(faiss::read_index(path.c_str()));
+        auto flat = dynamic_cast<faiss::IndexFlat*>(index.get());
+        if (flat == nullptr || flat->d != dim || flat->ntotal != nlist) {
+            LOG_ENGINE_WARNING_ << "Ignore mismatched shared quantizer " << path;
+            return false;
+        }
+        centroids.swap(flat->xb);
+    } catch (std::exception& e) {
+        LOG_ENGINE_WARNING_ << "Failed to read shared quantizer " << path << ": " << e.what();
+        return false;
+    }
+    return true;
+}
+
+// a concurrent build may save its own centroids at the same time, the last rename wins and the segments built
+// with the other centroids just keep their coarse search to themselves
+void
+SaveSharedCentroids(const std::string& path, const std::string& location, const knowhere::VecIndexPtr& index) {
+    auto ivf_index = GetCpuIVFIndex(index);
+    auto flat = ivf_index ? dynamic_cast<faiss::IndexFlat*>(ivf_index->quantizer) : nullptr;
+    if (flat == nullptr) {
+        return;
+    }
+
+    std::string tmp_path = location + ".quantizer.tmp";
+    try {
+        faiss::write_index(flat, tmp_path.c_str());
+    } catch (std::exception& e) {
+        LOG_ENGINE_WARNING_ << "Failed to write shared quantizer " << tmp_path << ": " << e.what();
+        std::remove(tmp_path.c_str());
+        return;
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG_ENGINE_WARNING_ << "Failed to save shared quantizer " << path;
+        std::remove(tmp_path.c_str());
+        return;
+    }
+    LOG_ENGINE_DEBUG_ << "Save shared quantizer " << path;
+}
+
+// the coarse assignment of the queries shared by the index files of the job trained with the same centroids,
+// nullptr if the index has no centroids to share
+scheduler::CoarseAssignPtr
+ShareCoarseAssign(const knowhere::VecIndexPtr& index, const scheduler::SearchJobPtr& job, const milvus::json& conf) {
+    auto ivf_index = GetCpuIVFIndex(index);
+    if (ivf_index == nullptr || job->vectors().float_data_.empty() || !conf.contains(knowhere::IndexParams::nprobe)) {
+        return nullptr;
+    }
+    auto fingerprint = GetCentroidsFingerprint(index);
+    if (fingerprint == 0) {
+        return nullptr;
+    }
+
+    int64_t nq = job->nq();
+    int64_t nprobe = knowhere::GetProbeCount(conf);
+    const float* queries = job->vectors().float_data_.data();
+    return job->GetCoarseAssign(fingerprint, nprobe, [&](scheduler::CoarseAssign& assign) {
+        assign.ids_.resize(nq * nprobe);
+        assign.distances_.resize(nq * nprobe);
+        ivf_index->quantizer->search(nq, queries, nprobe, assign.distances_.data(), assign.ids_.data());
+    });
+}
+
+// the ivf types whose knowhere index is only their faiss index, the codes are kept in the inverted lists or come
+// from the raw data by offset
+bool
+IsWrappableIVFType(EngineType type) {
+    return type == EngineType::FAISS_IVFFLAT || type == EngineType::FAISS_IVFSQ8 || type == EngineType::FAISS_PQ ||
+           type == EngineType::FAISS_PQ_FASTSCAN;
+}
+
+// the knowhere index of a cpu faiss index of an IsWrappableIVFType type
+knowhere::VecIndexPtr
+WrapCpuIVFIndex(EngineType type, const std::shared_ptr<faiss::Index>& index) {
+    if (type == EngineType::FAISS_IVFFLAT) {
+        return std::make_shared<knowhere::IVF_NM>(index);
+    } else if (type == EngineType::FAISS_IVFSQ8) {
+        return std::make_shared<knowhere::IVFSQ>(index);
+    } else if (type == EngineType::FAISS_PQ_FASTSCAN) {
+        return std::make_shared<knowhere::IVFPQFastScan>(index);
+    }
+    return std::make_shared<knowhere::IVFPQ>(index);
+}
+
+// A long build saves its progress next to the raw file it indexes, so that the build of the same file restarted
+// after a crash resumes from it: an IVF index once trained, before its vectors are added, an HNSW graph every
+// BUILD_CHECKPOINT_SECONDS while its vectors are added. The first line of a checkpoint is the signature of the
+// build, the type and the config, a checkpoint of another build is ignored.
+constexpr int64_t BUILD_CHECKPOINT_ROWS = 262144;  // rows added to a graph between two looks at the clock
+constexpr int64_t BUILD_CHECKPOINT_SECONDS = 600;
+
+std::string
+BuildCheckpointPath(const std::string& raw_location) {
+    return raw_location + ".build_checkpoint";
+}
+
+bool
+LoadBuildCheckpoint(const std::string& path, const std::string& signature, std::vector<uint8_t>& payload) {
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return false;
+    }
+    if (line != signature) {
+        LOG_ENGINE_WARNING_ << "Ignore build checkpoint " << path << " of another build";
+        return false;
+    }
+    payload.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !payload.empty();
+}
+
+// a checkpoint failing to save only costs the progress since the previous one
+void
+SaveBuildCheckpoint(const std::string& path, const std::string& signature, const uint8_t* data, size_t size) {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        file << signature << '\n';
+        file.write(reinterpret_cast<const char*>(data), size);
+        if (!file.good()) {
+            LOG_ENGINE_WARNING_ << "Failed to write build checkpoint " << tmp_path;
+            file.close();
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG_ENGINE_WARNING_ << "Failed to save build checkpoint " << path;
+        std::remove(tmp_path.c_str());
+        return;
+    }
+    LOG_ENGINE_DEBUG_ << "Save build checkpoint " << path << " of " << size << " bytes";
+}
+
+// Train and Add of a cpu index on the float dataset, to_index may be replaced by the index resumed from a checkpoint.
+// The other IVF types, the on disk IVF indexes and the other graphs are built at once.
+void
+BuildWithCheckpoints(knowhere::VecIndexPtr& to_index, EngineType type, const knowhere::DatasetPtr& dataset,
+                     const milvus::json& conf, const std::string& checkpoint_path) {
+    std::string signature = std::to_string(static_cast<int>(type)) + " " + conf.dump();
+    std::vector<uint8_t> payload;
+    bool on_disk = conf.contains(knowhere::IndexParams::on_disk) && conf[knowhere::IndexParams::on_disk].get<bool>();
+
+    if (IsWrappableIVFType(type) && !on_disk) {
+        if (LoadBuildCheckpoint(checkpoint_path, signature, payload)) {
+            try {
+                knowhere::MemoryIOReader reader;
+                reader.data_ = payload.data();
+                reader.total = payload.size();
+                to_index = WrapCpuIVFIndex(type, std::shared_ptr<faiss::Index>(faiss::read_index(&reader)));
+                LOG_ENGINE_DEBUG_ << "Resume build from the trained index of " << checkpoint_path;
+            } catch (std::exception& e) {
+                LOG_ENGINE_WARNING_ << "Failed to read build checkpoint " << checkpoint_path << ": " << e.what();
+                payload.clear();
+            }
+        }
+        if (payload.empty()) {
+            to_index->Train(dataset, conf);
+            knowhere::MemoryIOWriter writer;
+            faiss::write_index(GetCpuIVFIndex(to_index), &writer);
+            std::unique_ptr<uint8_t[]> data(writer.data_);
+            SaveBuildCheckpoint(checkpoint_path, signature, data.get(), writer.rp);
+        }
+        to_index->Add(dataset, conf);
+    } else if (type == EngineType::HNSW) {
+        int64_t rows = dataset->Get<int64_t>(knowhere::meta::ROWS);
+        int64_t dim = dataset->Get<int64_t>(knowhere::meta::DIM);
+        auto p_data = dataset->Get<const void*>(knowhere::meta::TENSOR);
+        auto p_ids = dataset->Get<const int64_t*>(knowhere::meta::IDS);
+
+        int64_t added = 0;
+        if (LoadBuildCheckpoint(checkpoint_path, signature, payload)) {
+            knowhere::BinarySet binary_set;
+            auto size = payload.size();
+            binary_set.Append("HNSW", std::shared_ptr<uint8_t[]>(payload.data(), [](uint8_t*) {}), size);
+            binary_set.Append(RAW_DATA, std::shared_ptr<uint8_t[]>(), 0);
+            try {
+                to_index->Load(binary_set);
+                added = to_index->Count();
+                LOG_ENGINE_DEBUG_ << "Resume build from " << added << " rows of " << checkpoint_path;
+            } catch (std::exception& e) {
+                LOG_ENGINE_WARNING_ << "Failed to read build checkpoint " << checkpoint_path << ": " << e.what();
+                added = -1;
+            }
+        }
+        if (added <= 0) {
+            added = 0;
+            to_index->Train(dataset, conf);
+        }
+
+        int64_t round_rows = BUILD_CHECKPOINT_ROWS;
+        int64_t checkpoint_seconds = BUILD_CHECKPOINT_SECONDS;
+        fiu_do_on("ExecutionEngineImpl.BuildWithCheckpoints.small_rounds", round_rows = 100; checkpoint_seconds = 0);
+
+        // the rows of each round are added by their offset in the raw data, the graph holds the rows before them
+        auto last_checkpoint = std::chrono::steady_clock::now();
+        while (added < rows) {
+            int64_t count = std::min(round_rows, rows - added);
+            auto round_data = static_cast<const float*>(p_data) + added * dim;
+            to_index->Add(knowhere::GenDatasetWithIds(count, dim, round_data, p_ids + added), conf);
+            added += count;
+
+            auto now = std::chrono::steady_clock::now();
+            if (added < rows && now - last_checkpoint >= std::chrono::seconds(checkpoint_seconds)) {
+                auto binary = to_index->Serialize(conf).GetByName("HNSW");
+                SaveBuildCheckpoint(checkpoint_path, signature, binary->data.get(), binary->size);
+                last_checkpoint = now;
+                fiu_do_on("ExecutionEngineImpl.BuildWithCheckpoints.interrupt",
+                          throw Exception(DB_ERROR, "Build interrupted"));
+            }
+        }
+    } else {
+        to_index->BuildAll(dataset, conf);
+    }
+}
+
+// the indexes whose QueryByRange is implemented, the others answer a range search with their top k
+bool
+SupportsRangeSearch(const knowhere::VecIndexPtr& index, EngineType type, MetricType metric) {
+    if (index->index_mode() != knowhere::IndexMode::MODE_CPU) {
+        return false;
+    }
+    switch (type) {
+        case EngineType::FAISS_IDMAP:
+        case EngineType::FAISS_IVFFLAT:
+        case EngineType::FAISS_IVFSQ8:
+        case EngineType::FAISS_PQ:
+            return true;
+        case EngineType::FAISS_BIN_IDMAP:
+        case EngineType::FAISS_BIN_HASH:
+            return metric == MetricType::HAMMING;
+        default:
+            return false;
+    }
+}
+
+// the indexes whose distances are approximated by compressed codes, raw vectors can refine their results
+bool
+SupportsRefine(EngineType type) {
+    switch (type) {
+        case EngineType::FAISS_IVFSQ8:
+        case EngineType::FAISS_IVFSQ8NR:
+        case EngineType::FAISS_IVFSQ8H:
+        case EngineType::FAISS_PQ:
+        case EngineType::FAISS_PQ_FASTSCAN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the candidates per query of a raw file held compressed, times topk, re-scored with the raw vectors on disk
+constexpr int64_t COMPRESSED_RAW_REFINE_FACTOR = 2;
+
+// the config of the job for the index, completed and checked once per index type, mode, topk asked and whether the
+// results are filtered, the index files of the job with the same key share it
+scheduler::SearchParamsPtr
+CompileSearchParams(const knowhere::VecIndexPtr& index, EngineType engine_type, const scheduler::SearchJobPtr& job,
+                    uint64_t query_topk, bool filtered) {
+    auto index_type = index->index_type();
+    auto index_mode = index->index_mode();
+    auto bf_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index);
+    bool compressed = bf_index != nullptr && bf_index->Compressed();
+    std::string key = index_type + "/" + std::to_string(static_cast<int>(index_mode)) + "/" +
+                      std::to_string(static_cast<int>(engine_type)) + "/" + std::to_string(query_topk) + "/" +
+                      std::to_string(filtered) + "/" + std::to_string(compressed);
+    return job->GetSearchParams(key, [&](scheduler::SearchParams& params) {
+        // the adapter may complete the config, this is the one copy of the request params per key
+        auto& request_params = job->request_params();
+        milvus::json conf = request_params.extra_params_;
+        conf[knowhere::meta::TOPK] = query_topk;
+
+        // a compressed index is asked for refine_k candidates per query which are re-scored with the raw vectors
+        if (!filtered && !request_params.range_ && SupportsRefine(engine_type) &&
+            request_params.refine_k_ > (int64_t)job->topk()) {
+            params.refine_k_ = request_params.refine_k_;
+            conf[knowhere::meta::TOPK] = params.refine_k_;
+        }
+        // so is a raw file held compressed in the cache, its final top k has exact distances
+        if (!filtered && !request_params.range_ && compressed) {
+            params.refine_k_ = std::max((int64_t)job->topk() * COMPRESSED_RAW_REFINE_FACTOR, request_params.refine_k_);
+            conf[knowhere::meta::TOPK] = params.refine_k_;
+        }
+
+        auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_type);
+        params.valid_ = adapter->CheckSearch(conf, index_type, index_mode);
+        params.conf_ = std::move(conf);
+    });
+}
+
+// the at most topk nearest results of each query of a range search in the nq * topk layout of Query, padded
+// with -1, the range result is released
+knowhere::DatasetPtr
+RangeResultToTopk(const knowhere::DatasetPtr& range_result, int64_t nq, int64_t topk, bool ascending) {
+    auto lims = range_result->Get<size_t*>(knowhere::meta::LIMS);
+    auto range_ids = range_result->Get<int64_t*>(knowhere::meta::IDS);
+    auto range_dist = range_result->Get<float*>(knowhere::meta::DISTANCE);
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * nq * topk);
+    auto p_dist = (float*)malloc(sizeof(float) * nq * topk);
+
+    std::vector<std::pair<float, int64_t>> hits;
+    for (int64_t q = 0; q < nq; ++q) {
+        hits.clear();
+        for (size_t i = lims[q]; i < lims[q + 1]; ++i) {
+            hits.emplace_back(range_dist[i], range_ids[i]);
+        }
+        auto n = std::min<int64_t>(hits.size(), topk);
+        auto middle = hits.begin() + n;
+        if (ascending) {
+            std::partial_sort(hits.begin(), middle, hits.end());
+        } else {
+            std::partial_sort(hits.begin(), middle, hits.end(), std::greater<std::pair<float, int64_t>>());
+        }
+        for (int64_t i = 0; i < topk; ++i) {
+            p_id[q * topk + i] = i < n ? hits[i].second : -1;
+            p_dist[q * topk + i] = i < n ? hits[i].first : 0;
+        }
+    }
+    free(lims);
+    free(range_ids);
+    free(range_dist);
+
+    auto result = std::make_shared<knowhere::Dataset>();
+    result->Set(knowhere::meta::IDS, p_id);
+    result->Set(knowhere::meta::DISTANCE, p_dist);
+    return result;
+}
+
+// drops the n results which are not within radius, results are sorted so the dropped ones are the last of a query
+void
+DropOutsideRadius(int64_t* ids, float* distances, int64_t n, float radius, bool ascending) {
+    for (int64_t i = 0; i < n; ++i) {
+        if (ids[i] != -1 && (ascending ? distances[i] >= radius : distances[i] <= radius)) {
+            ids[i] = -1;
+            distances[i] = 0;
+        }
+    }
+}
+
+// selectivity of the leaves without a zone map to tell
+constexpr double TERM_SELECTIVITY = 0.1;
+constexpr double RANGE_SELECTIVITY = 0.5;
+
+bool
+IsConjunction(query::QueryRelation relation) {
+    return relation == query::QueryRelation::AND || relation == query::QueryRelation::R1;
+}
+
+bool
+IsDisjunction(query::QueryRelation relation) {
+    return relation == query::QueryRelation::OR || relation == query::QueryRelation::R2 ||
+           relation == query::QueryRelation::R3;
+}
+
+// a skipped subtree may hold the vector query, whose placeholder is still needed
+void
+FindVectorPlaceholder(const query::GeneralQueryPtr& general_query, std::string& vector_placeholder) {
+    if (general_query == nullptr) {
+        return;
+    }
+    if (general_query->leaf != nullptr) {
+        if (!general_query->leaf->vector_placeholder.empty()) {
+            vector_placeholder = general_query->leaf->vector_placeholder;
+        }
+        return;
+    }
+    if (general_query->bin != nullptr) {
+        FindVectorPlaceholder(general_query->bin->left_query, vector_placeholder);
+        FindVectorPlaceholder(general_query->bin->right_query, vector_placeholder);
+    }
+}
+
+template <typename T>
+Status
+BetweenBitset(const knowhere::IndexPtr& index_ptr, const query::CompareExpr& lower, const query::CompareExpr& upper,
+              int64_t row_count, faiss::ConcurrentBitsetPtr& bitset) {
+    auto index = std::dynamic_pointer_cast<knowhere::StructuredIndex<T>>(index_ptr);
+    if (index == nullptr) {
+        return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
+    }
+
+    T lower_value = ParseAttrOperand<T>(lower.operand);
+    T upper_value = ParseAttrOperand<T>(upper.operand);
+    bool lower_inclusive = lower.compare_operator == query::CompareOperator::GTE;
+    bool upper_inclusive = upper.compare_operator == query::CompareOperator::LTE;
+    // the index swaps crossed bounds, they match no row here
+    if (lower_value > upper_value || (lower_value == upper_value && !(lower_inclusive && upper_inclusive))) {
+        bitset = std::make_shared<faiss::ConcurrentBitset>(row_count);
+        return Status::OK();
+    }
+    bitset = index->Range(lower_value, lower_inclusive, upper_value, upper_inclusive);
+    return Status::OK();
+}
+
 }  // namespace
 
 #ifdef MILVUS_GPU_VERSION
@@ -204,6 +744,10 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFPQ, mode);
             break;
         }
+        case EngineType::FAISS_PQ_FASTSCAN: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, mode);
+            break;
+        }
         case EngineType::FAISS_IVFSQ8: {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFSQ8, mode);
             break;
@@ -226,6 +770,10 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT, mode);
             break;
         }
+        case EngineType::FAISS_BIN_HASH: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_BIN_HASH, mode);
+            break;
+        }
         case EngineType::NSG_MIX: {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_NSG, mode);
             break;
@@ -252,6 +800,10 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_ANNOY, mode);
             break;
         }
+        case EngineType::DISKANN: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_DISKANN, mode);
+            break;
+        }
         default: {
             LOG_ENGINE_ERROR_ << "Unsupported index type " << (int)type;
             return nullptr;
@@ -274,7 +826,7 @@ ExecutionEngineImpl::HybridLoad() const {
         return;
     }
 
-    const std::string key = location_ + ".quantizer";
+    const std::string key = HybridQuantizerKey(index_, location_);
 
     server::Config& config = server::Config::GetInstance();
     std::vector<int64_t> gpus;
@@ -412,6 +964,7 @@ ExecutionEngineImpl::Load(bool to_cache) {
     index_ = std::static_pointer_cast<knowhere::VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
     bool already_in_cache = (index_ != nullptr);
     if (!already_in_cache) {
+        TimeRecorder rc("ExecutionEngineImpl::Load " + location_);
         std::string segment_dir;
         utils::GetParentPath(location_, segment_dir);
         auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
@@ -425,37 +978,48 @@ ExecutionEngineImpl::Load(bool to_cache) {
             }
             milvus::json conf{{knowhere::meta::DEVICEID, gpu_num_}, {knowhere::meta::DIM, dim_}};
             MappingMetricType(metric_type_, conf);
+            if (index_type_ == EngineType::FAISS_IDMAP) {
+                conf[knowhere::IndexParams::compression] = RawVectorCompression();
+            }
             auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_->index_type());
             LOG_ENGINE_DEBUG_ << "Index params: " << conf.dump();
             if (!adapter->CheckTrain(conf, index_->index_mode())) {
                 throw Exception(DB_ERROR, "Illegal index params");
             }
 
-            auto status = segment_reader_ptr->Load();
+            // only the raw vectors, uids and deleted docs are needed, the raw vectors are copied into the
+            // index once, so a memory mapped file is scanned sequentially and never held on the heap twice
+            knowhere::BinaryPtr raw_vectors;
+            auto status = segment_reader_ptr->LoadVectors(raw_vectors, storage::MmapAdvice::SEQUENTIAL);
+            std::vector<segment::doc_id_t> uids;
+            if (status.ok()) {
+                status = segment_reader_ptr->LoadUids(uids);
+            }
+            segment::DeletedDocsPtr deleted_docs_ptr;
+            if (status.ok()) {
+                status = segment_reader_ptr->LoadDeletedDocs(deleted_docs_ptr);
+            }
             if (!status.ok()) {
                 std::string msg = "Failed to load segment from " + location_;
                 LOG_ENGINE_ERROR_ << msg;
                 return Status(DB_ERROR, msg);
             }
-
-            segment::SegmentPtr segment_ptr;
-            segment_reader_ptr->GetSegment(segment_ptr);
-            auto& vectors = segment_ptr->vectors_ptr_;
-            auto& deleted_docs = segment_ptr->deleted_docs_ptr_->GetDeletedDocs();
-
-            auto& vectors_uids = vectors->GetMutableUids();
-            auto count = vectors_uids.size();
-            index_->SetUids(vectors_uids);
+            auto count = uids.size();
+            index_->SetUids(uids);
             LOG_ENGINE_DEBUG_ << "set uids " << index_->GetUids().size() << " for index " << location_;
 
-            auto& vectors_data = vectors->GetData();
+            faiss::ConcurrentBitsetPtr concurrent_bitset_ptr;
+            deleted_docs_ptr->GetBitset(count, concurrent_bitset_ptr);
 
-            faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(count);
-            for (auto& offset : deleted_docs) {
-                concurrent_bitset_ptr->set(offset);
+            int64_t vector_bytes = (index_type_ == EngineType::FAISS_IDMAP) ? dim_ * sizeof(float) : dim_ / 8;
+            int64_t raw_bytes = (raw_vectors != nullptr) ? raw_vectors->size : 0;
+            if (raw_bytes < (int64_t)count * vector_bytes) {
+                std::string msg = "Raw vectors of " + location_ + " don't match the uids";
+                LOG_ENGINE_ERROR_ << msg;
+                return Status(DB_ERROR, msg);
             }
-
-            auto dataset = knowhere::GenDataset(count, this->dim_, vectors_data.data());
+            const uint8_t* vectors_data = (raw_vectors != nullptr) ? raw_vectors->data.get() : nullptr;
+            auto dataset = knowhere::GenDataset(count, this->dim_, vectors_data);
             if (index_type_ == EngineType::FAISS_IDMAP) {
                 auto bf_index = std::static_pointer_cast<knowhere::IDMAP>(index_);
                 bf_index->Train(knowhere::DatasetPtr(), conf);
@@ -501,15 +1065,9 @@ ExecutionEngineImpl::Load(bool to_cache) {
                         LOG_ENGINE_ERROR_ << msg;
                         return Status(DB_ERROR, msg);
                     }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
 
-                    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
-                        std::make_shared<faiss::ConcurrentBitset>(index_->Count());
-                    for (auto& offset : deleted_docs) {
-                        if (!concurrent_bitset_ptr->test(offset)) {
-                            concurrent_bitset_ptr->set(offset);
-                        }
-                    }
+                    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr;
+                    deleted_docs_ptr->GetBitset(index_->Count(), concurrent_bitset_ptr);
 
                     index_->SetBlacklist(concurrent_bitset_ptr);
 
@@ -525,6 +1083,9 @@ ExecutionEngineImpl::Load(bool to_cache) {
                 return Status(DB_ERROR, e.what());
             }
         }
+
+        // the measured time covers the storage backend latency, the cost aware cache policy relies on it
+        index_->SetReloadCost((int64_t)(rc.ElapseFromBegin("done") / 1000));
     }
 
     if (!already_in_cache && to_cache) {
@@ -548,6 +1109,7 @@ ExecutionEngineImpl::LoadAttr(bool to_cache) {
         std::string segment_dir;
         utils::GetParentPath(location_, segment_dir);
         auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
+        TimeRecorder rc("ExecutionEngineImpl::LoadAttr " + attr_location_);
 
         attr_index_ = std::make_shared<Attr::AttrIndex>();
 
@@ -563,18 +1125,27 @@ ExecutionEngineImpl::LoadAttr(bool to_cache) {
         std::unordered_map<std::string, knowhere::IndexPtr> attr_indexes;
         std::unordered_map<std::string, int64_t> attr_sizes;
 
-        auto attr_it = attrs_index->attr_indexes.begin();
-        if (attr_it == attrs_index->attr_indexes.end()) {
-            return Status::OK();
+        for (auto attr_it = attrs_index->attr_indexes.begin(); attr_it != attrs_index->attr_indexes.end(); attr_it++) {
+            attr_indexes.insert(std::make_pair(attr_it->first, attr_it->second->GetAttrIndex()));
         }
 
-        for (; attr_it != attrs_index->attr_indexes.end(); attr_it++) {
-            attr_indexes.insert(std::make_pair(attr_it->first, attr_it->second->GetAttrIndex()));
+        // an attribute whose index was never written is filtered on its raw column
+        std::unordered_map<std::string, std::vector<uint8_t>> attr_raw_data;
+        int64_t count = 0;
+        for (auto& attr : segment_ptr->attrs_ptr_->attrs) {
+            count = attr.second->GetUids().size();
+            if (attr_indexes.find(attr.first) == attr_indexes.end()) {
+                attr_raw_data.insert(std::make_pair(attr.first, std::move(attr.second->GetMutableData())));
+            }
+        }
+        if (attr_indexes.empty() && attr_raw_data.empty()) {
+            return Status::OK();
         }
 
-        auto count = segment_ptr->attrs_ptr_->attrs.begin()->second->GetUids().size();
         attr_index_->SetIndexData(attr_indexes);
+        attr_index_->SetRawData(std::move(attr_raw_data));
         attr_index_->SetEntityCount(count);
+        attr_index_->SetReloadCost((int64_t)(rc.ElapseFromBegin("done") / 1000));
     }
 
     if (!already_in_cache && to_cache) {
@@ -641,6 +1212,9 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
 #endif
 
 #ifdef MILVUS_GPU_VERSION
+    // the index may be copied by a prefetch right now, take it from gpu cache once the copy is done
+    cache::GpuResidencyMgr::GetInstance().Wait(device_id, location_);
+
     auto data_obj_ptr = cache::GpuCacheMgr::GetInstance(device_id)->GetIndex(location_);
     auto index = std::static_pointer_cast<knowhere::VecIndex>(data_obj_ptr);
     bool already_in_cache = (index != nullptr);
@@ -660,7 +1234,14 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
             LOG_ENGINE_DEBUG_ << "CPU to GPU" << device_id << " start";
             auto gpu_cache_mgr = cache::GpuCacheMgr::GetInstance(device_id);
             // gpu_cache_mgr->Reserve(index_->Size());
-            index_ = knowhere::cloner::CopyCpuToGpu(index_, device_id, knowhere::Config());
+            std::vector<int64_t> shard_devices;
+            if (ShardedSearchDevices(index_type_, index_, device_id, shard_devices)) {
+                LOG_ENGINE_DEBUG_ << "Index " << location_ << " exceeds the cache of GPU" << device_id
+                                  << ", spread over " << shard_devices.size() << " GPUs";
+                index_ = knowhere::cloner::CopyCpuToGpuSharded(index_, shard_devices, knowhere::Config());
+            } else {
+                index_ = knowhere::cloner::CopyCpuToGpu(index_, device_id, knowhere::Config());
+            }
             // gpu_cache_mgr->InsertItem(location_, std::static_pointer_cast<cache::DataObj>(index_));
             LOG_ENGINE_DEBUG_ << "CPU to GPU" << device_id << " finished";
         } catch (std::exception& e) {
@@ -673,6 +1254,49 @@ ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::PrefetchToGpu(uint64_t device_id) {
+#ifdef MILVUS_GPU_VERSION
+    // hybrid index shares the quantizer with cpu, it is not cached on gpu as a whole
+    if (index_ == nullptr || index_->index_mode() != knowhere::IndexMode::MODE_CPU ||
+        index_type_ == EngineType::FAISS_IVFSQ8H) {
+        return Status::OK();
+    }
+
+    auto cpu_index = index_;
+    auto copy = [cpu_index, device_id]() -> cache::DataObjPtr {
+        auto gpu_index = knowhere::cloner::CopyCpuToGpu(cpu_index, device_id, knowhere::Config());
+        return std::static_pointer_cast<cache::DataObj>(gpu_index);
+    };
+    cache::GpuResidencyMgr::GetInstance().Prefetch(device_id, location_, cpu_index->Size(), copy);
+#endif
+    return Status::OK();
+}
+
+Status
+ExecutionEngineImpl::PrefetchFileToGpu(uint64_t device_id, int64_t size) {
+#ifdef MILVUS_GPU_VERSION
+    if (index_type_ == EngineType::FAISS_IVFSQ8H) {
+        return Status::OK();
+    }
+
+    // the file is read by the prefetch thread, into an engine of its own
+    auto engine = std::make_shared<ExecutionEngineImpl>(dim_, location_, index_type_, metric_type_, index_params_);
+    auto copy = [engine, device_id]() -> cache::DataObjPtr {
+        auto status = engine->Load(false);
+        if (!status.ok() || engine->index_ == nullptr) {
+            LOG_ENGINE_WARNING_ << "Failed to load " << engine->location_ << " for gpu" << device_id << ": "
+                                << status.message();
+            return nullptr;
+        }
+        auto gpu_index = knowhere::cloner::CopyCpuToGpu(engine->index_, device_id, knowhere::Config());
+        return std::static_pointer_cast<cache::DataObj>(gpu_index);
+    };
+    cache::GpuResidencyMgr::GetInstance().Prefetch(device_id, location_, size, copy);
+#endif
+    return Status::OK();
+}
+
 Status
 ExecutionEngineImpl::CopyToIndexFileToGpu(uint64_t device_id) {
 #ifdef MILVUS_GPU_VERSION
@@ -738,6 +1362,17 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     conf[knowhere::meta::DIM] = Dimension();
     conf[knowhere::meta::ROWS] = Count();
     conf[knowhere::meta::DEVICEID] = gpu_num_;
+#ifdef MILVUS_GPU_VERSION
+    if (to_index->index_mode() == knowhere::IndexMode::MODE_GPU && IsShardableType(engine_type)) {
+        server::Config& config = server::Config::GetInstance();
+        bool sharded = false;
+        std::vector<int64_t> gpu_ids;
+        config.GetGpuResourceConfigBuildIndexSharded(sharded);
+        if (sharded && config.GetGpuResourceConfigBuildIndexResources(gpu_ids).ok() && gpu_ids.size() > 1) {
+            conf[knowhere::meta::SHARD_DEVICES] = gpu_ids;
+        }
+    }
+#endif
     MappingMetricType(metric_type_, conf);
     LOG_ENGINE_DEBUG_ << "Index params: " << conf.dump();
     auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(to_index->index_type());
@@ -746,12 +1381,49 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     }
     LOG_ENGINE_DEBUG_ << "Index config: " << conf.dump();
 
+    // the vector transforms are trained in front of the index and saved in its file
+    bool preprocessed = conf.contains(knowhere::IndexParams::preprocess);
+    if (preprocessed) {
+        to_index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(to_index->index_type(), conf,
+                                                                           to_index->index_mode());
+    }
+
+    // with shared_quantizer the first build of the collection saves its centroids, the later ones only add
+    std::string quantizer_path;
+    std::vector<float> centroids;
+    bool shared_mode =
+        to_index->index_mode() == knowhere::IndexMode::MODE_CPU || engine_type == EngineType::FAISS_IVFSQ8H;
+    if (from_index && IsSharedQuantizerType(engine_type) && shared_mode &&
+        conf.contains(knowhere::IndexParams::shared_quantizer) &&
+        conf[knowhere::IndexParams::shared_quantizer].get<bool>()) {
+        quantizer_path = SharedQuantizerPath(location, conf);
+        LoadSharedCentroids(quantizer_path, Dimension(), conf[knowhere::IndexParams::nlist].get<int64_t>(), centroids);
+    }
+
     std::vector<segment::doc_id_t> uids;
     faiss::ConcurrentBitsetPtr blacklist;
     if (from_index) {
-        auto dataset =
-            knowhere::GenDatasetWithIds(Count(), Dimension(), from_index->GetRawVectors(), from_index->GetRawIds());
-        to_index->BuildAll(dataset, conf);
+        // compressed vectors would lose their precision in the index, the raw vectors are read from disk instead
+        const float* raw_data = from_index->GetRawVectors();
+        knowhere::BinaryPtr raw_vectors;
+        if (raw_data == nullptr) {
+            auto status = LoadRawVectors(Count(), raw_vectors);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << "ExecutionEngineImpl: " << status.message() << ", failed to build index";
+                return nullptr;
+            }
+            raw_data = reinterpret_cast<const float*>(raw_vectors->data.get());
+        }
+        auto dataset = knowhere::GenDatasetWithIds(Count(), Dimension(), raw_data, from_index->GetRawIds());
+        if (!centroids.empty()) {
+            dataset->Set(knowhere::meta::CENTROIDS, static_cast<const float*>(centroids.data()));
+        }
+        if (to_index->index_mode() == knowhere::IndexMode::MODE_CPU && !preprocessed) {
+            BuildWithCheckpoints(to_index, engine_type, dataset, conf, BuildCheckpointPath(location_));
+        } else {
+            to_index->BuildAll(dataset, conf);
+        }
+        std::remove(BuildCheckpointPath(location_).c_str());
         uids = from_index->GetUids();
         blacklist = from_index->GetBlacklist();
     } else if (bin_from_index) {
@@ -770,6 +1442,15 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     }
 #endif
 
+    if (!quantizer_path.empty() && centroids.empty()) {
+        SaveSharedCentroids(quantizer_path, location, to_index);
+    }
+
+    // the largest lists bound the latency of the queries probing them
+    if (auto ivf_index = GetCpuIVFIndex(to_index)) {
+        LOG_ENGINE_INFO_ << "Inverted lists of " << location << ": " << knowhere::GetIVFListSizeHistogram(ivf_index);
+    }
+
     to_index->SetUids(uids);
     LOG_ENGINE_DEBUG_ << "Set " << to_index->GetUids().size() << "uids for " << location;
     if (blacklist != nullptr) {
@@ -781,8 +1462,52 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, index_params_);
 }
 
+ExecutionEnginePtr
+ExecutionEngineImpl::CompactIndex(const std::string& location, const std::vector<int64_t>& new_offsets) {
+    // the codes of these types are kept in the inverted lists or come from the raw data by offset,
+    // the sq8 data of IVFSQ8NR is arranged by the lists and would need to be rebuilt
+    std::shared_ptr<faiss::Index> from_index;
+    if (index_type_ == EngineType::FAISS_IVFFLAT) {
+        auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF_NM>(index_);
+        if (ivf_index != nullptr) {
+            from_index = ivf_index->index_;
+        }
+    } else if (IsWrappableIVFType(index_type_)) {
+        auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+        if (ivf_index != nullptr) {
+            from_index = ivf_index->index_;
+        }
+    }
+
+    // gpu indexes are not supported
+    auto from_ivf = dynamic_cast<faiss::IndexIVF*>(from_index.get());
+    if (from_ivf == nullptr || from_ivf->ntotal != (int64_t)new_offsets.size()) {
+        return nullptr;
+    }
+
+    // the loaded index may be cached and searched, work on a copy
+    std::shared_ptr<faiss::Index> to_index(faiss::clone_index(from_ivf));
+    if (!knowhere::CompactInvertedLists(dynamic_cast<faiss::IndexIVF*>(to_index.get()), new_offsets)) {
+        return nullptr;
+    }
+
+    auto compacted = WrapCpuIVFIndex(index_type_, to_index);
+
+    // the copy is on the heap, the compacted file keeps its lists on disk again once loaded
+    auto from_ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    auto compacted_ivf = std::dynamic_pointer_cast<knowhere::IVF>(compacted);
+    if (from_ivf_index != nullptr && compacted_ivf != nullptr) {
+        compacted_ivf->SetOnDisk(from_ivf_index->OnDisk());
+    }
+
+    LOG_ENGINE_DEBUG_ << "Compacted index " << location_ << " to " << location << ", " << to_index->ntotal << " of "
+                      << new_offsets.size() << " entities left";
+    return std::make_shared<ExecutionEngineImpl>(compacted, location, index_type_, metric_type_, index_params_);
+}
+
+// the offsets are copied as they are without uids
 void
-MapAndCopyResult(const knowhere::DatasetPtr& dataset, const std::vector<milvus::segment::doc_id_t>& uids, int64_t nq,
+MapAndCopyResult(const knowhere::DatasetPtr& dataset, const std::vector<milvus::segment::doc_id_t>* uids, int64_t nq,
                  int64_t k, float* distances, int64_t* labels) {
     int64_t* res_ids = dataset->Get<int64_t*>(knowhere::meta::IDS);
     float* res_dist = dataset->Get<float*>(knowhere::meta::DISTANCE);
@@ -791,17 +1516,108 @@ MapAndCopyResult(const knowhere::DatasetPtr& dataset, const std::vector<milvus::
 
     /* map offsets to ids */
     int64_t num = nq * k;
+    if (uids == nullptr) {
+        memcpy(labels, res_ids, sizeof(int64_t) * num);
+    } else {
+        for (int64_t i = 0; i < num; ++i) {
+            int64_t offset = res_ids[i];
+            if (offset != -1) {
+                labels[i] = (*uids)[offset];
+            } else {
+                labels[i] = -1;
+            }
+        }
+    }
+
+    free(res_ids);
+    free(res_dist);
+}
+
+// map the offsets of the labels to the uids of the segment in place
+void
+MapUids(const std::vector<milvus::segment::doc_id_t>& uids, int64_t num, int64_t* labels) {
     for (int64_t i = 0; i < num; ++i) {
-        int64_t offset = res_ids[i];
-        if (offset != -1) {
-            labels[i] = uids[offset];
-        } else {
-            labels[i] = -1;
+        if (labels[i] != -1) {
+            labels[i] = uids[labels[i]];
+        }
+    }
+}
+
+// keep the first topk of the query_topk results of each query whose rows are set in filter, all of them without a
+// filter, in place
+void
+FilterResult(const knowhere::DatasetPtr& dataset, const faiss::ConcurrentBitsetPtr& filter, int64_t nq,
+             int64_t query_topk, int64_t topk) {
+    int64_t* res_ids = dataset->Get<int64_t*>(knowhere::meta::IDS);
+    float* res_dist = dataset->Get<float*>(knowhere::meta::DISTANCE);
+    for (int64_t q = 0; q < nq; ++q) {
+        int64_t kept = 0;
+        for (int64_t i = q * query_topk; i < (q + 1) * query_topk && kept < topk; ++i) {
+            if (res_ids[i] != -1 && (filter == nullptr || filter->test(res_ids[i]))) {
+                res_ids[q * topk + kept] = res_ids[i];
+                res_dist[q * topk + kept] = res_dist[i];
+                ++kept;
+            }
+        }
+        for (; kept < topk; ++kept) {
+            res_ids[q * topk + kept] = -1;
+            res_dist[q * topk + kept] = 0;
         }
     }
+}
+
+// the top k of the given rows for each query, C is faiss::CMax for a distance and faiss::CMin for a similarity
+template <class C>
+void
+BruteForceRows(const float* queries, int64_t nq, const float* data, int64_t dim, const std::vector<int64_t>& rows,
+               int64_t topk, faiss::fvec_func_ptr compute, float* distances, int64_t* labels) {
+#pragma omp parallel for
+    for (int64_t q = 0; q < nq; ++q) {
+        auto query = queries + q * dim;
+        auto heap_dis = distances + q * topk;
+        auto heap_ids = labels + q * topk;
+        faiss::heap_heapify<C>(topk, heap_dis, heap_ids);
+        for (auto row : rows) {
+            float dis = compute(query, data + row * dim, dim);
+            if (C::cmp(heap_dis[0], dis)) {
+                faiss::heap_swap_top<C>(topk, heap_dis, heap_ids, dis, row);
+            }
+        }
+        faiss::heap_reorder<C>(topk, heap_dis, heap_ids);
+    }
+}
 
+// re-scores the refine_k candidates of each query with the raw vectors and keeps the top k of them, C is
+// faiss::CMax for a distance and faiss::CMin for a similarity
+template <class C>
+void
+RefineResult(const knowhere::DatasetPtr& dataset, const float* queries, int64_t nq, const float* data, int64_t dim,
+             int64_t refine_k, int64_t topk, faiss::fvec_func_ptr compute) {
+    auto res_ids = dataset->Get<int64_t*>(knowhere::meta::IDS);
+    auto res_dist = dataset->Get<float*>(knowhere::meta::DISTANCE);
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * nq * topk);
+    auto p_dist = (float*)malloc(sizeof(float) * nq * topk);
+#pragma omp parallel for
+    for (int64_t q = 0; q < nq; ++q) {
+        auto query = queries + q * dim;
+        auto heap_dis = p_dist + q * topk;
+        auto heap_ids = p_id + q * topk;
+        faiss::heap_heapify<C>(topk, heap_dis, heap_ids);
+        for (int64_t i = q * refine_k; i < (q + 1) * refine_k; ++i) {
+            if (res_ids[i] == -1) {
+                continue;
+            }
+            float dis = compute(query, data + res_ids[i] * dim, dim);
+            if (C::cmp(heap_dis[0], dis)) {
+                faiss::heap_swap_top<C>(topk, heap_dis, heap_ids, dis, res_ids[i]);
+            }
+        }
+        faiss::heap_reorder<C>(topk, heap_dis, heap_ids);
+    }
     free(res_ids);
     free(res_dist);
+    dataset->Set(knowhere::meta::IDS, p_id);
+    dataset->Set(knowhere::meta::DISTANCE, p_dist);
 }
 
 Status
@@ -812,7 +1628,7 @@ ExecutionEngineImpl::ProcessTermQuery(faiss::ConcurrentBitsetPtr& bitset, query:
 
     switch (type) {
         case meta::hybrid::DataType::INT8: {
-            auto int8_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int8_t>>(
+            auto int8_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int8_t>>(
                 attr_index_->attr_index_data().at(field_name));
             if (not int8_index) {
                 return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
@@ -827,7 +1643,7 @@ ExecutionEngineImpl::ProcessTermQuery(faiss::ConcurrentBitsetPtr& bitset, query:
             break;
         }
         case meta::hybrid::DataType::INT16: {
-            auto int16_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int16_t>>(
+            auto int16_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int16_t>>(
                 attr_index_->attr_index_data().at(field_name));
             if (not int16_index) {
                 return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
@@ -842,7 +1658,7 @@ ExecutionEngineImpl::ProcessTermQuery(faiss::ConcurrentBitsetPtr& bitset, query:
             break;
         }
         case meta::hybrid::DataType::INT32: {
-            auto int32_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int32_t>>(
+            auto int32_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int32_t>>(
                 attr_index_->attr_index_data().at(field_name));
             if (not int32_index) {
                 return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
@@ -857,7 +1673,7 @@ ExecutionEngineImpl::ProcessTermQuery(faiss::ConcurrentBitsetPtr& bitset, query:
             break;
         }
         case meta::hybrid::DataType::INT64: {
-            auto int64_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int64_t>>(
+            auto int64_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int64_t>>(
                 attr_index_->attr_index_data().at(field_name));
             if (not int64_index) {
                 return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
@@ -872,7 +1688,7 @@ ExecutionEngineImpl::ProcessTermQuery(faiss::ConcurrentBitsetPtr& bitset, query:
             break;
         }
         case meta::hybrid::DataType::FLOAT: {
-            auto float_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<float>>(
+            auto float_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<float>>(
                 attr_index_->attr_index_data().at(field_name));
             if (not float_index) {
                 return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
@@ -887,7 +1703,7 @@ ExecutionEngineImpl::ProcessTermQuery(faiss::ConcurrentBitsetPtr& bitset, query:
             break;
         }
         case meta::hybrid::DataType::DOUBLE: {
-            auto double_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<double>>(
+            auto double_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<double>>(
                 attr_index_->attr_index_data().at(field_name));
             if (not double_index) {
                 return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
@@ -913,35 +1729,35 @@ ExecutionEngineImpl::ProcessRangeQuery(const meta::hybrid::DataType data_type, c
                                        faiss::ConcurrentBitsetPtr& bitset) {
     switch (data_type) {
         case meta::hybrid::DataType::INT8: {
-            auto int8_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int8_t>>(index_ptr);
+            auto int8_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int8_t>>(index_ptr);
 
             int8_t value = atoi(operand.c_str());
             bitset = int8_index->Range(value, (knowhere::OperatorType)com_operator);
             break;
         }
         case meta::hybrid::DataType::INT16: {
-            auto int16_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int16_t>>(index_ptr);
+            auto int16_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int16_t>>(index_ptr);
 
             int16_t value = atoi(operand.c_str());
             bitset = int16_index->Range(value, (knowhere::OperatorType)com_operator);
             break;
         }
         case meta::hybrid::DataType::INT32: {
-            auto int32_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int32_t>>(index_ptr);
+            auto int32_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int32_t>>(index_ptr);
 
             int32_t value = atoi(operand.c_str());
             bitset = int32_index->Range(value, (knowhere::OperatorType)com_operator);
             break;
         }
         case meta::hybrid::DataType::INT64: {
-            auto int64_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<int64_t>>(index_ptr);
+            auto int64_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<int64_t>>(index_ptr);
 
             int64_t value = atoi(operand.c_str());
             bitset = int64_index->Range(value, (knowhere::OperatorType)com_operator);
             break;
         }
         case meta::hybrid::DataType::FLOAT: {
-            auto float_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<float>>(index_ptr);
+            auto float_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<float>>(index_ptr);
 
             std::istringstream iss(operand);
             float value;
@@ -950,7 +1766,7 @@ ExecutionEngineImpl::ProcessRangeQuery(const meta::hybrid::DataType data_type, c
             break;
         }
         case meta::hybrid::DataType::DOUBLE: {
-            auto double_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<double>>(index_ptr);
+            auto double_index = std::dynamic_pointer_cast<knowhere::StructuredIndex<double>>(index_ptr);
 
             std::istringstream iss(operand);
             double value;
@@ -964,6 +1780,29 @@ ExecutionEngineImpl::ProcessRangeQuery(const meta::hybrid::DataType data_type, c
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::ProcessBetweenQuery(const meta::hybrid::DataType data_type, const query::CompareExpr& lower,
+                                         const query::CompareExpr& upper, knowhere::IndexPtr& index_ptr,
+                                         faiss::ConcurrentBitsetPtr& bitset) {
+    int64_t row_count = attr_index_->entity_count();
+    switch (data_type) {
+        case meta::hybrid::DataType::INT8:
+            return BetweenBitset<int8_t>(index_ptr, lower, upper, row_count, bitset);
+        case meta::hybrid::DataType::INT16:
+            return BetweenBitset<int16_t>(index_ptr, lower, upper, row_count, bitset);
+        case meta::hybrid::DataType::INT32:
+            return BetweenBitset<int32_t>(index_ptr, lower, upper, row_count, bitset);
+        case meta::hybrid::DataType::INT64:
+            return BetweenBitset<int64_t>(index_ptr, lower, upper, row_count, bitset);
+        case meta::hybrid::DataType::FLOAT:
+            return BetweenBitset<float>(index_ptr, lower, upper, row_count, bitset);
+        case meta::hybrid::DataType::DOUBLE:
+            return BetweenBitset<double>(index_ptr, lower, upper, row_count, bitset);
+        default:
+            return Status{SERVER_INVALID_ARGUMENT, "Attribute's type is wrong"};
+    }
+}
+
 Status
 ExecutionEngineImpl::HybridSearch(scheduler::SearchJobPtr search_job,
                                   std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
@@ -975,17 +1814,6 @@ ExecutionEngineImpl::HybridSearch(scheduler::SearchJobPtr search_job,
         return status;
     }
 
-    // Do search
-    faiss::ConcurrentBitsetPtr list;
-    list = index_->GetBlacklist();
-    // Do AND
-    for (uint64_t i = 0; i < attr_index_->entity_count(); ++i) {
-        if (list->test(i) && !bitset->test(i)) {
-            list->clear(i);
-        }
-    }
-    index_->SetBlacklist(list);
-
     auto vector_query = search_job->query_ptr()->vectors.at(vector_placeholder);
     int64_t topk = vector_query->topk;
     int64_t nq = vector_query->query_vector.float_data.size() / dim_;
@@ -999,28 +1827,91 @@ ExecutionEngineImpl::HybridSearch(scheduler::SearchJobPtr search_job,
     search_job->vector_count() = nq;
     search_job->topk() = topk;
 
-    status = Search(search_ids, distances, search_job, hybrid);
-    if (!status.ok()) {
-        return status;
+    // the rows passing the filter which are not deleted, their count is exact and cheap once the bitset is built
+    auto deleted = index_->GetBlacklist();
+    auto filter = bitset;
+    if (deleted != nullptr && deleted->capacity() == bitset->capacity()) {
+        filter = bitset->andnot(deleted);
+    }
+    int64_t row_count = filter->capacity();
+    int64_t pass_count = filter->count();
+    bool brute_force_enable =
+        !vectors.float_data_.empty() && (metric_type_ == MetricType::L2 || metric_type_ == MetricType::IP);
+    auto plan = PlanHybridSearch(row_count, pass_count, topk, brute_force_enable);
+    LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] %ld of %ld rows pass the filter, search by %s", "search", 0, pass_count,
+                                row_count, HybridStrategyName(plan.strategy_).c_str());
+
+    if (plan.strategy_ == HybridStrategy::PRE_FILTER) {
+        status = PreFilterSearch(filter, search_job, search_ids, distances);
+        if (status.ok()) {
+            return status;
+        }
+        LOG_ENGINE_WARNING_ << "Failed to brute force the filtered rows, fall back to the index: " << status.message();
+    } else if (plan.strategy_ == HybridStrategy::POST_FILTER) {
+        status = Search(search_ids, distances, search_job, hybrid, plan.query_topk_, filter);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // too few of the results passed, the filter is applied while searching instead
+        int64_t expected = std::min(topk, pass_count);
+        bool complete = true;
+        for (int64_t i = 0; i < nq && complete; ++i) {
+            complete = expected == 0 || search_ids[i * topk + expected - 1] != -1;
+        }
+        if (complete) {
+            return status;
+        }
     }
 
-    return Status::OK();
+    // the blacklist of the index holds the deleted rows, it skips the rows failing the filter for this search only
+    auto blacklist = std::make_shared<faiss::ConcurrentBitset>(row_count);
+    *blacklist |= *filter;
+    blacklist->negate();
+    index_->SetBlacklist(blacklist);
+    status = Search(search_ids, distances, search_job, hybrid);
+    index_->SetBlacklist(deleted);
+    return status;
 }
+
 Status
 ExecutionEngineImpl::ExecBinaryQuery(milvus::query::GeneralQueryPtr general_query, faiss::ConcurrentBitsetPtr& bitset,
                                      std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
                                      std::string& vector_placeholder) {
     Status status = Status::OK();
     if (general_query->leaf == nullptr) {
+        auto relation = general_query->bin->relation;
+        auto left_query = general_query->bin->left_query;
+        auto right_query = general_query->bin->right_query;
+        // an AND starts with the child passing fewer rows and an OR with the one passing more, the second one is
+        // skipped if the first already decides the result
+        if (left_query != nullptr && right_query != nullptr) {
+            double left_selectivity = EstimateSelectivity(left_query);
+            double right_selectivity = EstimateSelectivity(right_query);
+            if ((IsConjunction(relation) && right_selectivity < left_selectivity) ||
+                (IsDisjunction(relation) && right_selectivity > left_selectivity)) {
+                std::swap(left_query, right_query);
+            }
+        }
+
         faiss::ConcurrentBitsetPtr left_bitset, right_bitset;
-        if (general_query->bin->left_query != nullptr) {
-            status = ExecBinaryQuery(general_query->bin->left_query, left_bitset, attr_type, vector_placeholder);
+        if (left_query != nullptr) {
+            status = ExecBinaryQuery(left_query, left_bitset, attr_type, vector_placeholder);
             if (!status.ok()) {
                 return status;
             }
         }
-        if (general_query->bin->right_query != nullptr) {
-            status = ExecBinaryQuery(general_query->bin->right_query, right_bitset, attr_type, vector_placeholder);
+        if (left_bitset != nullptr && right_query != nullptr) {
+            bool none = (IsConjunction(relation) || relation == query::QueryRelation::R4) && left_bitset->count() == 0;
+            bool all = IsDisjunction(relation) && left_bitset->count() == left_bitset->capacity();
+            if (none || all) {
+                FindVectorPlaceholder(right_query, vector_placeholder);
+                bitset = left_bitset;
+                return status;
+            }
+        }
+        if (right_query != nullptr) {
+            status = ExecBinaryQuery(right_query, right_bitset, attr_type, vector_placeholder);
             if (!status.ok()) {
                 return status;
             }
@@ -1042,11 +1933,7 @@ ExecutionEngineImpl::ExecBinaryQuery(milvus::query::GeneralQueryPtr general_quer
                     break;
                 }
                 case milvus::query::QueryRelation::R4: {
-                    for (uint64_t i = 0; i < attr_->entity_count(); ++i) {
-                        if (left_bitset->test(i) && !right_bitset->test(i)) {
-                            bitset->set(i);
-                        }
-                    }
+                    bitset = left_bitset->andnot(right_bitset);
                     break;
                 }
                 default: {
@@ -1058,7 +1945,17 @@ ExecutionEngineImpl::ExecBinaryQuery(milvus::query::GeneralQueryPtr general_quer
         return status;
     } else {
         bitset = std::make_shared<faiss::ConcurrentBitset>(attr_index_->entity_count());
+        // the bitset stays empty if the zone map rules the leaf out
+        if (!ZoneMapMayMatch(general_query)) {
+            return status;
+        }
         if (general_query->leaf->term_query != nullptr) {
+            auto& term_query = general_query->leaf->term_query;
+            auto raw_iter = attr_index_->attr_raw_data().find(term_query->field_name);
+            if (raw_iter != attr_index_->attr_raw_data().end()) {
+                return FilterAttrTerm(attr_type.at(term_query->field_name), raw_iter->second,
+                                      attr_index_->entity_count(), term_query->field_value, bitset);
+            }
             // process attrs_data
             status = ProcessTermQuery(bitset, general_query, attr_type);
             if (!status.ok()) {
@@ -1238,15 +2135,49 @@ ExecutionEngineImpl::ExecBinaryQuery(milvus::query::GeneralQueryPtr general_quer
             auto field_name = general_query->leaf->range_query->field_name;
             auto com_expr = general_query->leaf->range_query->compare_expr;
             auto type = attr_type.at(field_name);
-            for (uint64_t j = 0; j < com_expr.size(); ++j) {
-                auto operand = com_expr[j].operand;
-                auto com_operator = com_expr[j].compare_operator;
+            auto index_iter = attr_index_->attr_index_data().find(field_name);
+            if (index_iter == attr_index_->attr_index_data().end()) {
+                auto raw_iter = attr_index_->attr_raw_data().find(field_name);
+                if (raw_iter == attr_index_->attr_raw_data().end()) {
+                    return Status{SERVER_INVALID_BINARY_QUERY, "Attribute's field_name is wrong"};
+                }
+                return FilterAttrRange(type, raw_iter->second, attr_index_->entity_count(), com_expr, bitset);
+            }
+            auto index_ptr = index_iter->second;
+
+            // a lower and an upper bound, often fused from two range queries, are looked up together
+            std::vector<query::CompareExpr> lowers, uppers, others;
+            for (auto& expr : com_expr) {
+                if (expr.compare_operator == query::CompareOperator::GT ||
+                    expr.compare_operator == query::CompareOperator::GTE) {
+                    lowers.push_back(expr);
+                } else if (expr.compare_operator == query::CompareOperator::LT ||
+                           expr.compare_operator == query::CompareOperator::LTE) {
+                    uppers.push_back(expr);
+                } else {
+                    others.push_back(expr);
+                }
+            }
+            bool between = lowers.size() == 1 && uppers.size() == 1;
+            if (between) {
+                status = ProcessBetweenQuery(type, lowers[0], uppers[0], index_ptr, bitset);
+                if (!status.ok()) {
+                    return status;
+                }
+            } else {
+                others = com_expr;
+            }
 
-                status = ProcessRangeQuery(type, operand, com_operator, attr_index_->attr_index_data().at(field_name),
-                                           bitset);
+            bool first = !between;
+            for (auto& expr : others) {
+                faiss::ConcurrentBitsetPtr expr_bitset;
+                status = ProcessRangeQuery(type, expr.operand, expr.compare_operator, index_ptr, expr_bitset);
                 if (!status.ok()) {
                     return status;
                 }
+                // every compare expression of the range must hold
+                bitset = first ? expr_bitset : (*bitset) & expr_bitset;
+                first = false;
             }
         }
         if (general_query->leaf->vector_placeholder.size() > 0) {
@@ -1258,10 +2189,126 @@ ExecutionEngineImpl::ExecBinaryQuery(milvus::query::GeneralQueryPtr general_quer
     return status;
 }
 
+Status
+ExecutionEngineImpl::LoadZoneMaps() {
+    if (zone_maps_loaded_) {
+        return Status::OK();
+    }
+
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
+    auto status = segment_reader_ptr->LoadAttrsZoneMaps(attr_zone_maps_);
+    if (!status.ok()) {
+        attr_zone_maps_.clear();
+        return status;
+    }
+    zone_maps_loaded_ = true;
+    return Status::OK();
+}
+
+bool
+ExecutionEngineImpl::ZoneMapMayMatch(const query::GeneralQueryPtr& general_query) const {
+    return segment::ZoneMapsMayMatch(attr_zone_maps_, general_query);
+}
+
+double
+ExecutionEngineImpl::EstimateSelectivity(const query::GeneralQueryPtr& general_query) const {
+    if (general_query == nullptr) {
+        return 1.0;
+    }
+
+    if (general_query->leaf == nullptr) {
+        if (general_query->bin == nullptr) {
+            return 1.0;
+        }
+        auto left = general_query->bin->left_query;
+        auto right = general_query->bin->right_query;
+        if (left == nullptr || right == nullptr) {
+            return EstimateSelectivity(left != nullptr ? left : right);
+        }
+        // the children are taken as independent
+        double left_selectivity = EstimateSelectivity(left);
+        double right_selectivity = EstimateSelectivity(right);
+        switch (general_query->bin->relation) {
+            case query::QueryRelation::AND:
+            case query::QueryRelation::R1:
+                return left_selectivity * right_selectivity;
+            case query::QueryRelation::R4:
+                return left_selectivity * (1.0 - right_selectivity);
+            default:
+                return 1.0 - (1.0 - left_selectivity) * (1.0 - right_selectivity);
+        }
+    }
+
+    // the vector query filters nothing
+    auto& leaf = general_query->leaf;
+    if (leaf->term_query != nullptr) {
+        auto iter = attr_zone_maps_.find(leaf->term_query->field_name);
+        if (iter != attr_zone_maps_.end() && !iter->second->MayMatchTerm(leaf->term_query->field_value)) {
+            return 0.0;
+        }
+        return TERM_SELECTIVITY;
+    }
+    if (leaf->range_query != nullptr) {
+        auto iter = attr_zone_maps_.find(leaf->range_query->field_name);
+        if (iter == attr_zone_maps_.end() || iter->second->GetBlockCount() == 0) {
+            return RANGE_SELECTIVITY;
+        }
+        auto& zone_map = iter->second;
+        int64_t match_blocks = 0;
+        for (int64_t block = 0; block < zone_map->GetBlockCount(); ++block) {
+            if (zone_map->BlockMayMatch(block, leaf->range_query->compare_expr)) {
+                ++match_blocks;
+            }
+        }
+        return static_cast<double>(match_blocks) / zone_map->GetBlockCount();
+    }
+    return 1.0;
+}
+
+Status
+ExecutionEngineImpl::PruneByZoneMap(query::GeneralQueryPtr general_query, bool& may_match) {
+    may_match = true;
+    auto status = LoadZoneMaps();
+    if (!status.ok()) {
+        // segments written before zone maps existed are searched as usual
+        LOG_ENGINE_DEBUG_ << "No attribute zone maps for " << location_ << ": " << status.message();
+        return Status::OK();
+    }
+
+    may_match = ZoneMapMayMatch(general_query);
+    return Status::OK();
+}
+
 Status
 ExecutionEngineImpl::Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job,
                             bool hybrid) {
-    TimeRecorder rc(LogOut("[%s][%ld] ExecutionEngineImpl::Search", "search", 0));
+    return Search(ids, distances, job, hybrid, job->topk(), nullptr);
+}
+
+Status
+ExecutionEngineImpl::SearchOffsets(std::vector<int64_t>& offsets, std::vector<float>& distances,
+                                   scheduler::SearchJobPtr job, bool hybrid, SegmentUidsPtr& uids) {
+    uids = nullptr;
+    // the offsets are kept as int32 until they are mapped
+    if (index_ == nullptr || index_->GetUids().size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        return Search(offsets, distances, job, hybrid);
+    }
+
+    auto status = Search(offsets, distances, job, hybrid, job->topk(), nullptr, false);
+    if (status.ok()) {
+        // the uids live in the index, which the results keep alive until they are mapped
+        uids = SegmentUidsPtr(index_, &index_->GetUids());
+    }
+    return status;
+}
+
+Status
+ExecutionEngineImpl::Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job,
+                            bool hybrid, uint64_t query_topk, const faiss::ConcurrentBitsetPtr& filter,
+                            bool map_uids) {
+    ScopedTimer rc("ExecutionEngineImpl::Search");
 
     if (index_ == nullptr) {
         LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] ExecutionEngineImpl: index is null, failed to search", "search", 0);
@@ -1277,33 +2324,103 @@ ExecutionEngineImpl::Search(std::vector<int64_t>& ids, std::vector<float>& dista
     ids.resize(topk * nq);
     distances.resize(topk * nq);
 
-    milvus::json conf = job->extra_params();
-    conf[knowhere::meta::TOPK] = topk;
-    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_->index_type());
-    if (!adapter->CheckSearch(conf, index_->index_type(), index_->index_mode())) {
+    auto params = CompileSearchParams(index_, index_type_, job, query_topk, filter != nullptr);
+    if (!params->valid_) {
         LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] Illegal search params", "search", 0);
         throw Exception(DB_ERROR, "Illegal search params");
     }
+    const milvus::json& conf = params->conf_;
+
+    // a range search keeps the at most topk nearest results within the radius of each query
+    auto& request_params = job->request_params();
+    bool range = request_params.range_;
+    bool range_query = range && filter == nullptr && SupportsRangeSearch(index_, index_type_, metric_type_);
+    int64_t refine_k = params->refine_k_;
 
     if (hybrid) {
         HybridLoad();
     }
 
-    rc.RecordSection("query prepare");
+    rc.RecordSection("ExecutionEngineImpl::Search prepare");
     knowhere::DatasetPtr dataset;
     if (!vectors.float_data_.empty()) {
         dataset = knowhere::GenDataset(nq, index_->Dim(), vectors.float_data_.data());
     } else {
         dataset = knowhere::GenDataset(nq, index_->Dim(), vectors.binary_data_.data());
     }
-    auto result = index_->Query(dataset, conf);
-    span = rc.RecordSection("query done");
+
+    // results of other segments which already fill the top k of a query let the index skip worse candidates,
+    // PQ is left out since its results are not reduced in the order of its metric
+    std::vector<float> bounds;
+    bool ascending = metric_type_ != MetricType::IP;
+    // the same goes for the approximated distances of the candidates to refine
+    if (!hybrid && refine_k == 0 && index_type_ != EngineType::FAISS_PQ &&
+        index_type_ != EngineType::FAISS_PQ_FASTSCAN && job->GetTopkBounds(ascending, bounds) && bounds.size() == nq) {
+        dataset->Set(knowhere::meta::BOUNDS, static_cast<const float*>(bounds.data()));
+    }
+    dataset->Set(knowhere::meta::CANCEL, job->cancel_flag());
+
+    // the quantizer search of the files trained with the same centroids is done once per job
+    scheduler::CoarseAssignPtr coarse_assign;
+    if (!hybrid && !range_query && index_type_ != EngineType::FAISS_IVFSQ8H) {
+        coarse_assign = ShareCoarseAssign(index_, job, conf);
+    }
+    if (coarse_assign != nullptr) {
+        dataset->Set(knowhere::meta::COARSE_IDS, static_cast<const int64_t*>(coarse_assign->ids_.data()));
+        dataset->Set(knowhere::meta::COARSE_DISTANCES, static_cast<const float*>(coarse_assign->distances_.data()));
+    }
+
+    // a plain top k search writes into ids and distances, whose buffers the caller reuses, and maps them in place
+    if (!range_query && refine_k == 0 && filter == nullptr) {
+        index_->QueryInto(dataset, conf, ids.data(), distances.data());
+        span = rc.RecordSection("ExecutionEngineImpl::Search query");
+        job->time_stat().query_time += span / 1000;
+
+        if (range) {
+            DropOutsideRadius(ids.data(), distances.data(), nq * topk, request_params.radius_, ascending);
+        }
+        if (map_uids) {
+            MapUids(index_->GetUids(), nq * topk, ids.data());
+        }
+        span = rc.RecordSection("ExecutionEngineImpl::Search map uids");
+        job->time_stat().map_uids_time += span / 1000;
+
+        if (hybrid) {
+            HybridUnset();
+        }
+        return Status::OK();
+    }
+
+    knowhere::DatasetPtr result;
+    if (range_query) {
+        result = RangeResultToTopk(index_->QueryByRange(dataset, conf), nq, topk, ascending);
+    } else {
+        result = index_->Query(dataset, conf);
+    }
+    span = rc.RecordSection("ExecutionEngineImpl::Search query");
     job->time_stat().query_time += span / 1000;
 
+    if (refine_k > 0) {
+        auto status = RefineSearch(result, vectors.float_data_.data(), nq, refine_k, topk);
+        if (!status.ok()) {
+            LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] Not refined: %s", "search", 0, status.message().c_str());
+            FilterResult(result, nullptr, nq, refine_k, topk);
+        }
+        span = rc.RecordSection("ExecutionEngineImpl::Search refine");
+        job->time_stat().query_time += span / 1000;
+    }
+    if (filter != nullptr) {
+        FilterResult(result, filter, nq, query_topk, topk);
+    }
+    if (range && !range_query) {
+        DropOutsideRadius(result->Get<int64_t*>(knowhere::meta::IDS), result->Get<float*>(knowhere::meta::DISTANCE),
+                          nq * topk, request_params.radius_, ascending);
+    }
+
     LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] get %ld uids from index %s", "search", 0, index_->GetUids().size(),
                                 location_.c_str());
-    MapAndCopyResult(result, index_->GetUids(), nq, topk, distances.data(), ids.data());
-    span = rc.RecordSection("map uids " + std::to_string(nq * topk));
+    MapAndCopyResult(result, map_uids ? &index_->GetUids() : nullptr, nq, topk, distances.data(), ids.data());
+    span = rc.RecordSection("ExecutionEngineImpl::Search map uids");
     job->time_stat().map_uids_time += span / 1000;
 
     if (hybrid) {
@@ -1313,6 +2430,98 @@ ExecutionEngineImpl::Search(std::vector<int64_t>& ids, std::vector<float>& dista
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::LoadRawVectors(int64_t rows, knowhere::BinaryPtr& raw_vectors) {
+    // the rows are read at random, a memory mapped file only faults in their pages
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
+    auto status = segment_reader_ptr->LoadVectors(raw_vectors, storage::MmapAdvice::RANDOM);
+    if (!status.ok()) {
+        return status;
+    }
+    if (raw_vectors == nullptr || raw_vectors->size < rows * dim_ * (int64_t)sizeof(float)) {
+        return Status(DB_ERROR, "Raw vectors of " + location_ + " don't match the rows");
+    }
+    return Status::OK();
+}
+
+Status
+ExecutionEngineImpl::RefineSearch(const knowhere::DatasetPtr& result, const float* queries, int64_t nq,
+                                  int64_t refine_k, int64_t topk) {
+    knowhere::BinaryPtr raw_vectors;
+    auto status = LoadRawVectors(index_->Count(), raw_vectors);
+    if (!status.ok()) {
+        return status;
+    }
+
+    auto data = reinterpret_cast<const float*>(raw_vectors->data.get());
+    if (metric_type_ == MetricType::IP) {
+        RefineResult<faiss::CMin<float, int64_t>>(result, queries, nq, data, dim_, refine_k, topk,
+                                                  faiss::fvec_inner_product);
+    } else {
+        RefineResult<faiss::CMax<float, int64_t>>(result, queries, nq, data, dim_, refine_k, topk, faiss::fvec_L2sqr);
+    }
+    return Status::OK();
+}
+
+Status
+ExecutionEngineImpl::PreFilterSearch(const faiss::ConcurrentBitsetPtr& filter, scheduler::SearchJobPtr job,
+                                     std::vector<int64_t>& ids, std::vector<float>& distances) {
+    ScopedTimer rc("ExecutionEngineImpl::PreFilterSearch");
+    int64_t nq = job->nq();
+    int64_t topk = job->topk();
+    const VectorsData& vectors = job->vectors();
+
+    std::vector<int64_t> rows;
+    auto words = reinterpret_cast<const uint64_t*>(filter->data());
+    int64_t n64 = filter->size() / sizeof(uint64_t);
+    for (int64_t w = 0; w < n64; ++w) {
+        for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+            rows.push_back(w * 64 + __builtin_ctzll(bits));
+        }
+    }
+    for (int64_t row = n64 * 64; row < (int64_t)filter->capacity(); ++row) {
+        if (filter->test(row)) {
+            rows.push_back(row);
+        }
+    }
+
+    knowhere::BinaryPtr raw_vectors;
+    auto status = LoadRawVectors(filter->capacity(), raw_vectors);
+    if (!status.ok()) {
+        return status;
+    }
+    rc.RecordSection("ExecutionEngineImpl::PreFilterSearch load");
+
+    ids.resize(nq * topk);
+    distances.resize(nq * topk);
+    auto data = reinterpret_cast<const float*>(raw_vectors->data.get());
+    if (metric_type_ == MetricType::IP) {
+        BruteForceRows<faiss::CMin<float, int64_t>>(vectors.float_data_.data(), nq, data, dim_, rows, topk,
+                                                    faiss::fvec_inner_product, distances.data(), ids.data());
+    } else {
+        BruteForceRows<faiss::CMax<float, int64_t>>(vectors.float_data_.data(), nq, data, dim_, rows, topk,
+                                                    faiss::fvec_L2sqr, distances.data(), ids.data());
+    }
+    auto span = rc.RecordSection("ExecutionEngineImpl::PreFilterSearch brute force");
+    job->time_stat().query_time += span / 1000;
+
+    auto& request_params = job->request_params();
+    if (request_params.range_) {
+        DropOutsideRadius(ids.data(), distances.data(), nq * topk, request_params.radius_,
+                          metric_type_ != MetricType::IP);
+    }
+
+    auto& uids = index_->GetUids();
+    for (auto& id : ids) {
+        if (id != -1) {
+            id = uids[id];
+        }
+    }
+    return Status::OK();
+}
+
 #if 0
 Status
 ExecutionEngineImpl::GetVectorByID(const int64_t id, float* vector, bool hybrid) {
@@ -1375,6 +2584,14 @@ ExecutionEngineImpl::Cache() {
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::CacheReplacing(const std::string& old_location, bool& cached) {
+    auto cpu_cache_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(index_);
+    cached = cpu_cache_mgr->ReplaceItem(old_location, location_, obj);
+    return Status::OK();
+}
+
 Status
 ExecutionEngineImpl::AttrCache() {
     auto cpu_cache_mgr = milvus::cache::CpuCacheMgr::GetInstance();
@@ -62,6 +62,12 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Status
     CopyToGpu(uint64_t device_id, bool hybrid = false) override;
 
+    Status
+    PrefetchToGpu(uint64_t device_id) override;
+
+    Status
+    PrefetchFileToGpu(uint64_t device_id, int64_t size) override;
+
     Status
     CopyToIndexFileToGpu(uint64_t device_id) override;
 
@@ -81,6 +87,9 @@ class ExecutionEngineImpl : public ExecutionEngine {
                     std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
                     std::string& vector_placeholder) override;
 
+    Status
+    PruneByZoneMap(query::GeneralQueryPtr general_query, bool& may_match) override;
+
     Status
     HybridSearch(scheduler::SearchJobPtr job, std::unordered_map<std::string, meta::hybrid::DataType>& attr_type,
                  std::vector<float>& distances, std::vector<int64_t>& search_ids, bool hybrid) override;
@@ -88,12 +97,22 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Status
     Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job, bool hybrid) override;
 
+    Status
+    SearchOffsets(std::vector<int64_t>& offsets, std::vector<float>& distances, scheduler::SearchJobPtr job,
+                  bool hybrid, SegmentUidsPtr& uids) override;
+
     ExecutionEnginePtr
     BuildIndex(const std::string& location, EngineType engine_type) override;
 
+    ExecutionEnginePtr
+    CompactIndex(const std::string& location, const std::vector<int64_t>& new_offsets) override;
+
     Status
     Cache() override;
 
+    Status
+    CacheReplacing(const std::string& old_location, bool& cached) override;
+
     Status
     AttrCache() override;
 
@@ -136,6 +155,41 @@ class ExecutionEngineImpl : public ExecutionEngine {
                       const query::CompareOperator& com_operator, knowhere::IndexPtr& index_ptr,
                       faiss::ConcurrentBitsetPtr& bitset);
 
+    // rows between a lower and an upper bound of a range query, found by a single lookup of the index
+    Status
+    ProcessBetweenQuery(const meta::hybrid::DataType data_type, const query::CompareExpr& lower,
+                        const query::CompareExpr& upper, knowhere::IndexPtr& index_ptr,
+                        faiss::ConcurrentBitsetPtr& bitset);
+
+    // the index is asked for query_topk results per query, those whose rows are not set in filter are dropped and
+    // the job gets the first topk of the others, as ids or left as the row offsets without map_uids
+    Status
+    Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job, bool hybrid,
+           uint64_t query_topk, const faiss::ConcurrentBitsetPtr& filter, bool map_uids = true);
+
+    // the raw float vectors of the segment, at least rows of them
+    Status
+    LoadRawVectors(int64_t rows, knowhere::BinaryPtr& raw_vectors);
+
+    // replaces the refine_k candidates per query of result by the topk nearest of them by the raw vectors
+    Status
+    RefineSearch(const knowhere::DatasetPtr& result, const float* queries, int64_t nq, int64_t refine_k, int64_t topk);
+
+    // brute force over the rows set in filter, the raw vectors are read from the segment
+    Status
+    PreFilterSearch(const faiss::ConcurrentBitsetPtr& filter, scheduler::SearchJobPtr job, std::vector<int64_t>& ids,
+                    std::vector<float>& distances);
+
+    Status
+    LoadZoneMaps();
+
+    bool
+    ZoneMapMayMatch(const query::GeneralQueryPtr& general_query) const;
+
+    // fraction of the rows expected to pass the query, the share of the blocks its zone maps don't rule out
+    double
+    EstimateSelectivity(const query::GeneralQueryPtr& general_query) const;
+
     void
     HybridLoad() const;
 
@@ -153,6 +207,9 @@ class ExecutionEngineImpl : public ExecutionEngine {
 
     Attr::AttrPtr attr_ = nullptr;
 
+    segment::AttrZoneMaps attr_zone_maps_;
+    bool zone_maps_loaded_ = false;
+
     std::string attr_location_;
 
     milvus::json index_params_;
@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "db/engine/HybridSearchPlan.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace milvus {
+namespace engine {
+
+HybridSearchPlan
+PlanHybridSearch(int64_t row_count, int64_t pass_count, int64_t topk, bool brute_force_enable) {
+    if (row_count <= 0 || pass_count <= 0) {
+        // nothing passes, the brute force returns at once
+        return {brute_force_enable ? HybridStrategy::PRE_FILTER : HybridStrategy::FILTERED_ANN, topk};
+    }
+
+    double selectivity = (double)pass_count / row_count;
+    if (brute_force_enable && (pass_count <= topk || selectivity <= PRE_FILTER_MAX_SELECTIVITY)) {
+        return {HybridStrategy::PRE_FILTER, topk};
+    }
+    if (selectivity >= POST_FILTER_MIN_SELECTIVITY) {
+        auto query_topk = (int64_t)std::ceil(topk / selectivity * POST_FILTER_TOPK_MARGIN);
+        return {HybridStrategy::POST_FILTER, std::min(std::max(query_topk, topk), row_count)};
+    }
+    return {HybridStrategy::FILTERED_ANN, topk};
+}
+
+std::string
+HybridStrategyName(HybridStrategy strategy) {
+    switch (strategy) {
+        case HybridStrategy::PRE_FILTER:
+            return "pre filter";
+        case HybridStrategy::POST_FILTER:
+            return "post filter";
+        default:
+            return "filtered ann";
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace milvus {
+namespace engine {
+
+enum class HybridStrategy {
+    PRE_FILTER,    // brute force over the rows passing the filter
+    FILTERED_ANN,  // the index skips the rows failing the filter while it searches
+    POST_FILTER,   // the index searches for more than topk results, those failing the filter are dropped
+};
+
+struct HybridSearchPlan {
+    HybridStrategy strategy_;
+    int64_t query_topk_;  // results asked from the index per query
+};
+
+// at most this fraction of the rows pass the filter for the brute force to be cheaper than the index
+constexpr double PRE_FILTER_MAX_SELECTIVITY = 0.01;
+// at least this fraction of the rows pass the filter for the index to find topk of them among a few more results
+constexpr double POST_FILTER_MIN_SELECTIVITY = 0.5;
+// the post filtered search asks for topk / selectivity results times this margin
+constexpr double POST_FILTER_TOPK_MARGIN = 1.5;
+
+// pass_count of the row_count rows pass the attribute filter and are not deleted, the brute force needs float
+// vectors and a metric it can compute
+HybridSearchPlan
+PlanHybridSearch(int64_t row_count, int64_t pass_count, int64_t topk, bool brute_force_enable);
+
+std::string
+HybridStrategyName(HybridStrategy strategy);
+
+}  // namespace engine
+}  // namespace milvus
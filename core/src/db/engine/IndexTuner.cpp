@@ -0,0 +1,329 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/IndexTuner.h"
+
+#include <faiss/AutoTune.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <string>
+
+#include "db/RecallSampler.h"
+#include "db/Utils.h"
+#include "knowhere/index/vector_index/ConfAdapter.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr int64_t MAX_EF = 4096;  // the largest ef the HNSW search accepts
+
+using Clock = std::chrono::steady_clock;
+
+double
+ElapsedMs(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+knowhere::IndexType
+TunedIndexType(EngineType engine_type) {
+    switch (engine_type) {
+        case EngineType::FAISS_IVFFLAT:
+            return knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+        case EngineType::FAISS_IVFSQ8:
+            return knowhere::IndexEnum::INDEX_FAISS_IVFSQ8;
+        case EngineType::FAISS_PQ:
+            return knowhere::IndexEnum::INDEX_FAISS_IVFPQ;
+        case EngineType::HNSW:
+            return knowhere::IndexEnum::INDEX_HNSW;
+        default:
+            return "";
+    }
+}
+
+// the nlist around 4 * sqrt(rows) as powers of 2, the faiss rule of thumb, the largest one still trained with about
+// 64 vectors per list
+std::vector<int64_t>
+NlistCandidates(int64_t rows) {
+    int64_t max_nlist = std::max<int64_t>(1, rows / 64);
+    int64_t nlist = 1;
+    while (nlist * 2 <= 4 * std::sqrt(static_cast<double>(rows))) {
+        nlist *= 2;
+    }
+    std::vector<int64_t> candidates;
+    for (int64_t candidate : {nlist / 2, nlist, nlist * 2}) {
+        candidate = std::min(std::max<int64_t>(candidate, 1), max_nlist);
+        if (std::find(candidates.begin(), candidates.end(), candidate) == candidates.end()) {
+            candidates.push_back(candidate);
+        }
+    }
+    return candidates;
+}
+
+// the search params from the cheapest up, the last one the most accurate
+std::vector<milvus::json>
+SearchSweep(EngineType engine_type, const milvus::json& build_params, int64_t topk) {
+    std::vector<milvus::json> sweep;
+    if (engine_type == EngineType::HNSW) {
+        for (int64_t ef = std::max<int64_t>(topk, 16); ef < MAX_EF * 2; ef *= 2) {
+            sweep.push_back({{knowhere::IndexParams::ef, std::min(ef, MAX_EF)}});
+        }
+    } else {
+        int64_t nlist = build_params[knowhere::IndexParams::nlist].get<int64_t>();
+        for (int64_t nprobe = 1; nprobe < nlist * 2; nprobe *= 2) {
+            sweep.push_back({{knowhere::IndexParams::nprobe, std::min(nprobe, nlist)}});
+        }
+    }
+    return sweep;
+}
+
+milvus::json
+PointJson(const IndexTuner::Point& point) {
+    milvus::json json;
+    json["index_type"] = static_cast<int32_t>(point.engine_type_);
+    json["index_name"] = utils::GetIndexName(static_cast<int32_t>(point.engine_type_));
+    json["params"] = point.build_params_;
+    json["search_params"] = point.search_params_;
+    json["recall"] = point.recall_;
+    json["latency_ms"] = point.latency_ms_;
+    json["build_ms"] = point.build_ms_;
+    json["index_size"] = point.index_size_;
+    return json;
+}
+
+}  // namespace
+
+IndexTuner::IndexTuner(MetricType metric_type, int64_t dimension, int64_t topk, double target_recall)
+    : metric_type_(metric_type), dimension_(dimension), topk_(topk), target_recall_(target_recall) {
+}
+
+std::vector<milvus::json>
+IndexTuner::Candidates(EngineType engine_type, int64_t rows, int64_t dimension) {
+    std::vector<milvus::json> candidates;
+    switch (engine_type) {
+        case EngineType::FAISS_IVFFLAT:
+        case EngineType::FAISS_IVFSQ8: {
+            for (auto nlist : NlistCandidates(rows)) {
+                candidates.push_back({{knowhere::IndexParams::nlist, nlist}});
+            }
+            break;
+        }
+        case EngineType::FAISS_PQ: {
+            // codes of 1 byte per 4 and per 8 dimensions, when the sub-quantizers of such a size are supported
+            std::vector<int64_t> valid_m;
+            knowhere::IVFPQConfAdapter::GetValidMList(dimension, valid_m);
+            for (auto nlist : NlistCandidates(rows)) {
+                for (int64_t m : {dimension / 4, dimension / 8}) {
+                    if (m > 0 && std::find(valid_m.begin(), valid_m.end(), m) != valid_m.end()) {
+                        candidates.push_back({{knowhere::IndexParams::nlist, nlist}, {knowhere::IndexParams::m, m}});
+                    }
+                }
+            }
+            break;
+        }
+        case EngineType::HNSW: {
+            for (int64_t M : {8, 16, 32}) {
+                candidates.push_back({{knowhere::IndexParams::M, M}, {knowhere::IndexParams::efConstruction, 200}});
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return candidates;
+}
+
+Status
+IndexTuner::Tune(const std::vector<EngineType>& engine_types, const std::vector<float>& data,
+                 const std::vector<float>& queries) {
+    if (metric_type_ != MetricType::L2 && metric_type_ != MetricType::IP) {
+        return Status(DB_ERROR, "Index tuning only supports the L2 and IP metrics");
+    }
+    if (dimension_ <= 0 || topk_ <= 0 || data.empty() || queries.empty()) {
+        return Status(DB_ERROR, "Nothing to tune the index on");
+    }
+    rows_ = data.size() / dimension_;
+    nq_ = queries.size() / dimension_;
+    points_.clear();
+
+    milvus::json conf;
+    conf[knowhere::meta::DIM] = dimension_;
+    conf[knowhere::meta::TOPK] = topk_;
+    conf[knowhere::Metric::TYPE] = (metric_type_ == MetricType::IP) ? knowhere::Metric::IP : knowhere::Metric::L2;
+
+    ResultIds exact_ids;
+    try {
+        std::vector<int64_t> ids(rows_);
+        std::iota(ids.begin(), ids.end(), 0);
+        auto exact_index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(
+            knowhere::IndexEnum::INDEX_FAISS_IDMAP, knowhere::IndexMode::MODE_CPU);
+        exact_index->BuildAll(knowhere::GenDatasetWithIds(rows_, dimension_, data.data(), ids.data()), conf);
+        auto result = exact_index->Query(knowhere::GenDataset(nq_, dimension_, queries.data()), conf);
+        auto res_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        exact_ids.assign(res_ids, res_ids + nq_ * topk_);
+        free(res_ids);
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+    } catch (std::exception& ex) {
+        return Status(DB_ERROR, std::string("Failed to search the tuning sample exactly: ") + ex.what());
+    }
+
+    for (auto engine_type : engine_types) {
+        auto candidates = Candidates(engine_type, rows_, dimension_);
+        if (candidates.empty()) {
+            LOG_ENGINE_WARNING_ << "Index type " << (int32_t)engine_type << " is not tuned";
+        }
+        for (auto& build_params : candidates) {
+            TuneCandidate(engine_type, build_params, data, queries, exact_ids);
+        }
+    }
+    return Status::OK();
+}
+
+void
+IndexTuner::TuneCandidate(EngineType engine_type, const milvus::json& build_params, const std::vector<float>& data,
+                          const std::vector<float>& queries, const ResultIds& exact_ids) {
+    auto index_type = TunedIndexType(engine_type);
+    milvus::json conf = build_params;
+    conf[knowhere::meta::DIM] = dimension_;
+    conf[knowhere::meta::ROWS] = rows_;
+    conf[knowhere::meta::TOPK] = topk_;
+    conf[knowhere::Metric::TYPE] = (metric_type_ == MetricType::IP) ? knowhere::Metric::IP : knowhere::Metric::L2;
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_type);
+    if (!adapter->CheckTrain(conf, knowhere::IndexMode::MODE_CPU)) {
+        LOG_ENGINE_WARNING_ << "Skip index " << index_type << " of illegal params " << build_params.dump();
+        return;
+    }
+
+    // the params as the check adjusted them, as a build of the collection would
+    milvus::json params;
+    for (auto& item : build_params.items()) {
+        params[item.key()] = conf[item.key()];
+    }
+
+    try {
+        auto& factory = knowhere::VecIndexFactory::GetInstance();
+        auto start = Clock::now();
+        std::vector<int64_t> ids(rows_);
+        std::iota(ids.begin(), ids.end(), 0);
+        auto index = factory.CreateVecIndex(index_type, knowhere::IndexMode::MODE_CPU);
+        index->BuildAll(knowhere::GenDatasetWithIds(rows_, dimension_, data.data(), ids.data()), conf);
+        double build_ms = ElapsedMs(start);
+
+        // loaded back like a segment index, the indexes without their own vectors read those of the sample
+        auto binary_set = index->Serialize(conf);
+        int64_t index_size = 0;
+        for (auto& item : binary_set.binary_map_) {
+            index_size += item.second->size;
+        }
+        auto raw_data = std::shared_ptr<uint8_t[]>((uint8_t*)data.data(), [](uint8_t*) {});
+        binary_set.Append(RAW_DATA, raw_data, rows_ * dimension_ * sizeof(float));
+        index = factory.CreateVecIndex(index_type, knowhere::IndexMode::MODE_CPU);
+        index->Load(binary_set);
+
+        auto query_dataset = knowhere::GenDataset(nq_, dimension_, queries.data());
+        for (auto& search_params : SearchSweep(engine_type, params, topk_)) {
+            milvus::json search_conf = conf;
+            search_conf.update(search_params);
+            start = Clock::now();
+            auto result = index->Query(query_dataset, search_conf);
+            double latency_ms = ElapsedMs(start) / nq_;
+
+            auto res_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+            ResultIds result_ids(res_ids, res_ids + nq_ * topk_);
+            free(res_ids);
+            free(result->Get<float*>(knowhere::meta::DISTANCE));
+            int64_t hits = 0, expected = 0;
+            RecallSampler::CountHits(result_ids, exact_ids, topk_, hits, expected);
+
+            Point point;
+            point.engine_type_ = engine_type;
+            point.build_params_ = params;
+            point.search_params_ = search_params;
+            point.recall_ = (expected > 0) ? static_cast<double>(hits) / expected : 1.0;
+            point.latency_ms_ = latency_ms;
+            point.build_ms_ = build_ms;
+            point.index_size_ = index_size;
+            points_.push_back(point);
+            LOG_ENGINE_DEBUG_ << "Tuning " << index_type << " " << params.dump() << " " << search_params.dump()
+                              << ": recall " << point.recall_ << ", " << latency_ms << " ms per query";
+
+            // a larger nprobe or ef only costs more
+            if (point.recall_ >= target_recall_) {
+                break;
+            }
+        }
+    } catch (std::exception& ex) {
+        LOG_ENGINE_WARNING_ << "Skip index " << index_type << " " << params.dump() << ": " << ex.what();
+    }
+}
+
+std::vector<IndexTuner::Point>
+IndexTuner::ParetoFront() const {
+    faiss::OperatingPoints operating_points;
+    for (size_t i = 0; i < points_.size(); ++i) {
+        operating_points.add(points_[i].recall_, points_[i].latency_ms_, "", i);
+    }
+    std::vector<Point> front;
+    for (auto& operating_point : operating_points.optimal_pts) {
+        if (operating_point.cno >= 0) {  // not the point of doing nothing
+            front.push_back(points_[operating_point.cno]);
+        }
+    }
+    return front;
+}
+
+bool
+IndexTuner::Recommend(Point& point) const {
+    for (auto& front_point : ParetoFront()) {
+        if (front_point.recall_ >= target_recall_) {
+            point = front_point;
+            return true;
+        }
+    }
+    return false;
+}
+
+milvus::json
+IndexTuner::Report() const {
+    milvus::json report;
+    report["sample_rows"] = rows_;
+    report["queries"] = nq_;
+    report["topk"] = topk_;
+    report["target_recall"] = target_recall_;
+    report["points"] = milvus::json::array();
+    for (auto& point : points_) {
+        report["points"].push_back(PointJson(point));
+    }
+    report["pareto_front"] = milvus::json::array();
+    for (auto& point : ParetoFront()) {
+        report["pareto_front"].push_back(PointJson(point));
+    }
+    Point recommended;
+    if (Recommend(recommended)) {
+        report["recommended"] = PointJson(recommended);
+    }
+    return report;
+}
+
+}  // namespace engine
+}  // namespace milvus
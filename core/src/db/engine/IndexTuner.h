@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "db/Types.h"
+#include "db/meta/MetaTypes.h"
+#include "utils/Json.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Picks the index params of a collection from a sample of its vectors. Each candidate index is built on the sample
+ * and searched with the sampled queries from the cheapest search params up, nprobe or ef doubling, until the recall@k
+ * against an exact search reaches the target recall. Every point measured is kept, those no other point beats in
+ * both recall and latency make the pareto front, as the faiss OperatingPoints of AutoTune keep them. The recommended
+ * point is the fastest one reaching the target recall.
+ */
+class IndexTuner {
+ public:
+    static constexpr int64_t DEFAULT_SAMPLE_ROWS = 100000;
+    static constexpr int64_t DEFAULT_QUERIES = 100;
+    static constexpr int64_t DEFAULT_TOPK = 10;
+    static constexpr double DEFAULT_TARGET_RECALL = 0.95;
+
+    struct Point {
+        EngineType engine_type_ = EngineType::INVALID;
+        milvus::json build_params_;
+        milvus::json search_params_;
+        double recall_ = 0.0;
+        double latency_ms_ = 0.0;  // search time of the query batch per query
+        double build_ms_ = 0.0;
+        int64_t index_size_ = 0;  // serialized size, the raw vectors an index reads from the segment excluded
+    };
+
+    IndexTuner(MetricType metric_type, int64_t dimension, int64_t topk, double target_recall);
+
+    // the build params tried for an index type on rows vectors, none for the types not tuned
+    static std::vector<milvus::json>
+    Candidates(EngineType engine_type, int64_t rows, int64_t dimension);
+
+    // data and queries are row major float vectors, a candidate failing to build is skipped
+    Status
+    Tune(const std::vector<EngineType>& engine_types, const std::vector<float>& data,
+         const std::vector<float>& queries);
+
+    const std::vector<Point>&
+    Points() const {
+        return points_;
+    }
+
+    // by ascending recall and latency
+    std::vector<Point>
+    ParetoFront() const;
+
+    // false if no point reaches the target recall
+    bool
+    Recommend(Point& point) const;
+
+    milvus::json
+    Report() const;
+
+ private:
+    void
+    TuneCandidate(EngineType engine_type, const milvus::json& build_params, const std::vector<float>& data,
+                  const std::vector<float>& queries, const ResultIds& exact_ids);
+
+ private:
+    MetricType metric_type_;
+    int64_t dimension_;
+    int64_t topk_;
+    double target_recall_;
+
+    int64_t rows_ = 0;
+    int64_t nq_ = 0;
+    std::vector<Point> points_;
+};
+
+}  // namespace engine
+}  // namespace milvus
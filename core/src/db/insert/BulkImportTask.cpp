@@ -0,0 +1,297 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/BulkImportTask.h"
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "db/IDGenerator.h"
+#include "db/Utils.h"
+#include "segment/SegmentWriter.h"
+#include "utils/Log.h"
+#include "utils/ThreadPool.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr char NPY_MAGIC[] = "\x93NUMPY";
+constexpr size_t NPY_MAGIC_LEN = 6;
+
+// the value of a key of the header dict, as written by numpy: {'descr': '<f4', 'fortran_order': False, ...}
+bool
+NpyDictValue(const std::string& dict, const std::string& key, std::string& value) {
+    auto pos = dict.find("'" + key + "'");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = dict.find(':', pos);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = dict.find_first_not_of(' ', pos + 1);
+    if (pos == std::string::npos) {
+        return false;
+    }
+
+    size_t end;
+    if (dict[pos] == '\'') {
+        end = dict.find('\'', ++pos);
+    } else if (dict[pos] == '(') {
+        end = dict.find(')', ++pos);
+    } else {
+        end = dict.find_first_of(",}", pos);
+    }
+    if (end == std::string::npos) {
+        return false;
+    }
+    value = dict.substr(pos, end - pos);
+    return true;
+}
+
+}  // namespace
+
+BulkImportTask::BulkImportTask(const meta::MetaPtr& meta_ptr, const DBOptions& options,
+                               const std::string& collection_id, const std::vector<std::string>& file_paths)
+    : meta_ptr_(meta_ptr), options_(options), collection_id_(collection_id), file_paths_(file_paths) {
+}
+
+Status
+BulkImportTask::ReadNpyHeader(const std::string& path, NpyHeader& header) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return Status(DB_ERROR, "Cannot open file: " + path);
+    }
+
+    char prefix[NPY_MAGIC_LEN + 2];
+    if (!in.read(prefix, sizeof(prefix)) || std::string(prefix, NPY_MAGIC_LEN) != NPY_MAGIC) {
+        return Status(DB_ERROR, "Not a npy file: " + path);
+    }
+
+    // version 1 stores the dict length on 2 bytes, later versions on 4, little endian both
+    uint8_t major = prefix[NPY_MAGIC_LEN];
+    uint8_t len_bytes[4] = {0, 0, 0, 0};
+    size_t len_size = (major == 1) ? 2 : 4;
+    if (!in.read(reinterpret_cast<char*>(len_bytes), len_size)) {
+        return Status(DB_ERROR, "Truncated npy header: " + path);
+    }
+    uint32_t dict_len = len_bytes[0] | (len_bytes[1] << 8) | (len_bytes[2] << 16) | ((uint32_t)len_bytes[3] << 24);
+
+    std::string dict(dict_len, '\0');
+    if (!in.read(&dict[0], dict_len)) {
+        return Status(DB_ERROR, "Truncated npy header: " + path);
+    }
+    header.data_offset_ = sizeof(prefix) + len_size + dict_len;
+
+    std::string descr, fortran_order, shape;
+    if (!NpyDictValue(dict, "descr", descr) || !NpyDictValue(dict, "fortran_order", fortran_order) ||
+        !NpyDictValue(dict, "shape", shape)) {
+        return Status(DB_ERROR, "Invalid npy header: " + path);
+    }
+
+    size_t elem_size;
+    if (descr == "<f4") {
+        header.binary_ = false;
+        elem_size = sizeof(float);
+    } else if (descr == "|u1" || descr == "<u1") {
+        header.binary_ = true;
+        elem_size = sizeof(uint8_t);
+    } else {
+        return Status(DB_ERROR, "Unsupported npy dtype " + descr + ": " + path);
+    }
+    if (fortran_order.find("False") == std::string::npos) {
+        return Status(DB_ERROR, "Only C order npy arrays are supported: " + path);
+    }
+
+    std::vector<int64_t> dims;
+    std::string token;
+    for (auto c : shape + ",") {
+        if (c == ',') {
+            token.erase(std::remove(token.begin(), token.end(), ' '), token.end());
+            if (!token.empty()) {
+                try {
+                    dims.push_back(std::stoll(token));
+                } catch (std::exception& ex) {
+                    return Status(DB_ERROR, "Invalid npy shape (" + shape + "): " + path);
+                }
+            }
+            token.clear();
+        } else {
+            token += c;
+        }
+    }
+    if (dims.size() != 2 || dims[0] < 0 || dims[1] <= 0) {
+        return Status(DB_ERROR, "Only 2-d npy arrays are supported: " + path);
+    }
+    header.rows_ = dims[0];
+    header.cols_ = dims[1];
+
+    in.seekg(0, std::ios::end);
+    int64_t file_size = in.tellg();
+    if (file_size < header.data_offset_ + header.rows_ * header.cols_ * (int64_t)elem_size) {
+        return Status(DB_ERROR, "Truncated npy data: " + path);
+    }
+
+    return Status::OK();
+}
+
+Status
+BulkImportTask::Execute(IDNumbers& ids) {
+    ids.clear();
+    TimeRecorderAuto rc("BulkImportTask::Execute " + collection_id_);
+
+    collection_schema_.collection_id_ = collection_id_;
+    auto status = meta_ptr_->DescribeCollection(collection_schema_);
+    if (!status.ok()) {
+        return status;
+    }
+
+    bool binary = utils::IsBinaryMetricType(collection_schema_.metric_type_);
+    row_size_ = binary ? collection_schema_.dimension_ / 8 : collection_schema_.dimension_ * sizeof(float);
+    for (auto& path : file_paths_) {
+        NpyHeader header;
+        status = ReadNpyHeader(path, header);
+        if (!status.ok()) {
+            return status;
+        }
+        if (header.binary_ != binary) {
+            return Status(DB_ERROR, "The npy dtype doesn't match the metric of the collection: " + path);
+        }
+        int64_t cols = binary ? collection_schema_.dimension_ / 8 : collection_schema_.dimension_;
+        if (header.cols_ != cols) {
+            return Status(DB_ERROR, "The npy columns don't match the dimension of the collection: " + path);
+        }
+        headers_.push_back(header);
+    }
+
+    // a chunk fills a segment up to the index file size, the size the merge of inserted segments stops at
+    int64_t chunk_rows = std::max<int64_t>(1, collection_schema_.index_file_size_ / row_size_);
+    std::vector<Chunk> chunks;
+    for (size_t i = 0; i < headers_.size(); ++i) {
+        for (int64_t begin = 0; begin < headers_[i].rows_; begin += chunk_rows) {
+            chunks.push_back(Chunk{i, begin, std::min(chunk_rows, headers_[i].rows_ - begin)});
+        }
+    }
+    if (chunks.empty()) {
+        return Status::OK();
+    }
+
+    size_t threads = std::min<size_t>({chunks.size(), std::max(1u, std::thread::hardware_concurrency()),
+                                       (size_t)MAX_THREADS_NUM});
+    std::vector<meta::SegmentSchema> files(chunks.size());
+    std::vector<IDNumbers> chunk_ids(chunks.size());
+    std::vector<std::future<Status>> futures;
+    {
+        ThreadPool pool(threads, chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            futures.push_back(pool.enqueue(&BulkImportTask::WriteSegment, this, std::cref(chunks[i]),
+                                           std::ref(files[i]), std::ref(chunk_ids[i])));
+        }
+        for (auto& future : futures) {
+            auto chunk_status = future.get();
+            if (status.ok() && !chunk_status.ok()) {
+                status = chunk_status;
+            }
+        }
+    }
+
+    // the segments are published together, or dropped together
+    meta::SegmentsSchema updated;
+    for (auto& file : files) {
+        if (file.id_ != 0 && !status.ok()) {
+            file.file_type_ = meta::SegmentSchema::TO_DELETE;
+        }
+        if (file.id_ != 0) {
+            updated.push_back(file);
+        }
+    }
+    auto update_status = meta_ptr_->UpdateCollectionFiles(updated);
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Bulk import to " << collection_id_ << " failed: " << status.message();
+        return status;
+    }
+    if (!update_status.ok()) {
+        return update_status;
+    }
+
+    for (auto& part : chunk_ids) {
+        ids.insert(ids.end(), part.begin(), part.end());
+    }
+    LOG_ENGINE_DEBUG_ << "Bulk imported " << ids.size() << " vectors to " << collection_id_ << " in "
+                      << updated.size() << " segments";
+    return Status::OK();
+}
+
+Status
+BulkImportTask::WriteSegment(const Chunk& chunk, meta::SegmentSchema& file, IDNumbers& ids) {
+    file.collection_id_ = collection_id_;
+    file.file_type_ = meta::SegmentSchema::NEW;
+    auto status = meta_ptr_->CreateCollectionFile(file);
+    if (!status.ok()) {
+        file.id_ = 0;
+        return status;
+    }
+
+    auto& header = headers_[chunk.source_];
+    std::vector<uint8_t> data(chunk.rows_ * row_size_);
+    std::ifstream in(file_paths_[chunk.source_], std::ios::binary);
+    in.seekg(header.data_offset_ + chunk.begin_ * row_size_);
+    if (!in.read(reinterpret_cast<char*>(data.data()), data.size())) {
+        return Status(DB_ERROR, "Failed to read " + file_paths_[chunk.source_]);
+    }
+
+    status = SafeIDGenerator::GetInstance().GetNextIDNumbers(chunk.rows_, ids);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::string segment_dir;
+    utils::GetParentPath(file.location_, segment_dir);
+    auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(segment_dir);
+    if (!utils::IsBinaryMetricType(file.metric_type_)) {
+        segment_writer_ptr->EnableVectorSummary(file.dimension_);
+    }
+    try {
+        status = segment_writer_ptr->AddVectors(file.file_id_, data.data(), data.size(), ids);
+        if (status.ok()) {
+            status = segment_writer_ptr->Serialize();
+        }
+    } catch (std::exception& ex) {
+        status = Status(DB_ERROR, "Serialize imported segment encounter exception: " + std::string(ex.what()));
+    }
+    if (!status.ok()) {
+        return status;
+    }
+
+    if (!utils::IsRawIndexType(file.engine_type_)) {
+        file.file_type_ = (segment_writer_ptr->Size() >= (size_t)(file.index_file_size_))
+                              ? meta::SegmentSchema::TO_INDEX
+                              : meta::SegmentSchema::RAW;
+    } else {
+        file.file_type_ = meta::SegmentSchema::RAW;
+    }
+    file.file_size_ = segment_writer_ptr->Size();
+    file.row_count_ = segment_writer_ptr->VectorCount();
+
+    if (options_.insert_cache_immediately_) {
+        segment_writer_ptr->Cache();
+    }
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,75 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "db/Options.h"
+#include "db/Types.h"
+#include "db/meta/Meta.h"
+#include "db/meta/MetaTypes.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Imports the vectors of NumPy .npy files into a collection without the insert path: no wal record, no insert
+ * buffer and no flush. The files are cut in chunks of index_file_size, each chunk is read, given a range of ids and
+ * serialized to a segment of its own by a pool of threads. The segments are created NEW, invisible to search, and
+ * turned RAW or TO_INDEX by a single meta update once all of them are on disk, a failed import marks them TO_DELETE.
+ * A float collection takes '<f4' arrays of dimension columns, a binary one '|u1' arrays of dimension / 8 columns.
+ */
+class BulkImportTask {
+ public:
+    struct NpyHeader {
+        bool binary_ = false;
+        int64_t rows_ = 0;
+        int64_t cols_ = 0;
+        int64_t data_offset_ = 0;  // bytes of the magic, version, length and dict before the data
+    };
+
+    BulkImportTask(const meta::MetaPtr& meta_ptr, const DBOptions& options, const std::string& collection_id,
+                   const std::vector<std::string>& file_paths);
+
+    // ids are the ids given to the rows, in the order of the files and their rows
+    Status
+    Execute(IDNumbers& ids);
+
+    static Status
+    ReadNpyHeader(const std::string& path, NpyHeader& header);
+
+ private:
+    struct Chunk {
+        size_t source_ = 0;
+        int64_t begin_ = 0;
+        int64_t rows_ = 0;
+    };
+
+    Status
+    WriteSegment(const Chunk& chunk, meta::SegmentSchema& file, IDNumbers& ids);
+
+ private:
+    meta::MetaPtr meta_ptr_;
+    DBOptions options_;
+    std::string collection_id_;
+    std::vector<std::string> file_paths_;
+
+    meta::CollectionSchema collection_schema_;
+    std::vector<NpyHeader> headers_;
+    int64_t row_size_ = 0;
+};  // BulkImportTask
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "db/insert/MemBufferPool.h"
+
+#include <iterator>
+#include <utility>
+
+#include "db/Constants.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// small enough for thousands of partitions taking a few inserts each
+constexpr uint64_t MIN_SIZE_CLASS = 64 * KB;
+
+}  // namespace
+
+MemBufferPool&
+MemBufferPool::GetInstance() {
+    static MemBufferPool s_pool;
+    return s_pool;
+}
+
+uint64_t
+MemBufferPool::SizeClass(uint64_t size) {
+    uint64_t size_class = MIN_SIZE_CLASS;
+    while (size_class < size) {
+        size_class <<= 1;
+    }
+    return size_class;
+}
+
+std::vector<uint8_t>
+MemBufferPool::Acquire(uint64_t size) {
+    auto size_class = SizeClass(size);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = free_buffers_.find(size_class);
+        if (iter != free_buffers_.end() && !iter->second.empty()) {
+            std::vector<uint8_t> buffer = std::move(iter->second.back());
+            iter->second.pop_back();
+            pooled_size_ -= buffer.capacity();
+            return buffer;
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve(size_class);
+    return buffer;
+}
+
+void
+MemBufferPool::Release(std::vector<uint8_t>&& buffer) {
+    // only the buffers handed out by Acquire have the capacity of a size class
+    auto capacity = buffer.capacity();
+    if (capacity < MIN_SIZE_CLASS || SizeClass(capacity) != capacity) {
+        std::vector<uint8_t>().swap(buffer);
+        return;
+    }
+
+    std::vector<uint8_t> pooled;
+    pooled.swap(buffer);
+    pooled.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pooled_size_ + capacity > capacity_) {
+        return;
+    }
+    pooled_size_ += capacity;
+    free_buffers_[capacity].emplace_back(std::move(pooled));
+}
+
+void
+MemBufferPool::SetCapacity(uint64_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    ShrinkNoLock();
+}
+
+uint64_t
+MemBufferPool::PooledSize() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooled_size_;
+}
+
+void
+MemBufferPool::ShrinkNoLock() {
+    // free the largest buffers first, the fewest buffers are freed
+    while (pooled_size_ > capacity_ && !free_buffers_.empty()) {
+        auto iter = std::prev(free_buffers_.end());
+        if (iter->second.empty()) {
+            free_buffers_.erase(iter);
+            continue;
+        }
+        pooled_size_ -= iter->second.back().capacity();
+        iter->second.pop_back();
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
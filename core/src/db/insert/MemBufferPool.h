@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Recycles the raw vector buffers of the mem table files.
+ * Buffers are handed out in power of two size classes, a mem table file grows its buffer by acquiring a larger
+ * class and returns the buffers after they are serialized, so the buffers of the flushed files are reused by the
+ * following inserts instead of being reallocated.
+ */
+class MemBufferPool {
+ public:
+    static MemBufferPool&
+    GetInstance();
+
+    // an empty buffer with the capacity of the smallest size class not less than size
+    std::vector<uint8_t>
+    Acquire(uint64_t size);
+
+    // keep the buffer for reuse unless the pooled size would exceed the capacity
+    void
+    Release(std::vector<uint8_t>&& buffer);
+
+    void
+    SetCapacity(uint64_t capacity);
+
+    uint64_t
+    PooledSize();
+
+    static uint64_t
+    SizeClass(uint64_t size);
+
+ private:
+    MemBufferPool() = default;
+
+    void
+    ShrinkNoLock();
+
+ private:
+    std::mutex mutex_;
+    std::map<uint64_t, std::vector<std::vector<uint8_t>>> free_buffers_;
+    uint64_t capacity_ = 0;
+    uint64_t pooled_size_ = 0;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "db/Types.h"
+#include "db/insert/MemSnapshot.h"
 #include "utils/Status.h"
 
 namespace milvus {
@@ -57,6 +58,16 @@ class MemManager {
     virtual Status
     EraseMemVector(const std::string& collection_id) = 0;
 
+    // copy the vectors of collection_ids not committed to meta yet, all of them up to the same insert
+    virtual Status
+    Snapshot(const std::set<std::string>& collection_ids, MemSnapshot& snapshot) = 0;
+
+    // the vectors of ids in collection_ids not committed to meta yet, an entry per id, empty for those not found,
+    // the newest insert of an id wins
+    virtual Status
+    GetVectorsByID(const std::set<std::string>& collection_ids, const IDNumbers& ids,
+                   std::vector<VectorsData>& vectors) = 0;
+
     virtual size_t
     GetCurrentMutableMem() = 0;
 
@@ -65,6 +76,11 @@ class MemManager {
 
     virtual size_t
     GetCurrentMem() = 0;
+
+    // the collections to flush to free bytes of the insert buffer, the largest mem tables first, of equal sizes the
+    // oldest first
+    virtual std::vector<std::string>
+    FlushCandidates(size_t bytes) = 0;
 };  // MemManagerAbstract
 
 using MemManagerPtr = std::shared_ptr<MemManager>;
@@ -12,7 +12,10 @@
 #include "db/insert/MemManagerImpl.h"
 
 #include <fiu-local.h>
+#include <algorithm>
+#include <future>
 #include <thread>
+#include <utility>
 
 #include "VectorSource.h"
 #include "db/Constants.h"
@@ -35,15 +38,10 @@ MemManagerImpl::GetMemByTable(const std::string& collection_id) {
 Status
 MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const float* vectors, uint64_t lsn) {
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.float_data_.resize(length * dim);
-    memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    // the source is consumed before returning, the vectors are copied into the mem table files only
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
 
     return InsertVectorsNoLock(collection_id, source, lsn);
 }
@@ -51,15 +49,9 @@ MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length,
 Status
 MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const uint8_t* vectors, uint64_t lsn) {
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.binary_data_.resize(length * dim);
-    memcpy(vectors_data.binary_data_.data(), vectors, length * dim * sizeof(uint8_t));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
 
     return InsertVectorsNoLock(collection_id, source, lsn);
 }
@@ -70,16 +62,10 @@ MemManagerImpl::InsertEntities(const std::string& collection_id, int64_t length,
                                const std::unordered_map<std::string, uint64_t>& attr_nbytes,
                                const std::unordered_map<std::string, uint64_t>& attr_size,
                                const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, uint64_t lsn) {
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.float_data_.resize(length * dim);
-    memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
+    VectorSourcePtr source =
+        std::make_shared<VectorSource>(length, vector_ids, vectors, attr_nbytes, attr_size, attr_data);
 
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data, attr_nbytes, attr_size, attr_data);
-
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
 
     return InsertEntitiesNoLock(collection_id, source, lsn);
 }
@@ -105,7 +91,7 @@ MemManagerImpl::InsertEntitiesNoLock(const std::string& collection_id, const mil
 
 Status
 MemManagerImpl::DeleteVector(const std::string& collection_id, IDNumber vector_id, uint64_t lsn) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
     MemTablePtr mem = GetMemByTable(collection_id);
     mem->SetLSN(lsn);
     auto status = mem->Delete(vector_id);
@@ -115,7 +101,7 @@ MemManagerImpl::DeleteVector(const std::string& collection_id, IDNumber vector_i
 Status
 MemManagerImpl::DeleteVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids,
                               uint64_t lsn) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
     MemTablePtr mem = GetMemByTable(collection_id);
     mem->SetLSN(lsn);
 
@@ -145,23 +131,15 @@ MemManagerImpl::Flush(const std::string& collection_id) {
     // TODO: There is actually only one memTable in the immutable list
     MemList temp_immutable_list;
     {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InstrumentedMutex> lock(mutex_);
         immu_mem_list_.swap(temp_immutable_list);
+        flushing_mem_list_.insert(flushing_mem_list_.end(), temp_immutable_list.begin(), temp_immutable_list.end());
     }
 
-    std::unique_lock<std::mutex> lock(serialization_mtx_);
+    std::unique_lock<InstrumentedMutex> lock(serialization_mtx_);
     auto max_lsn = GetMaxLSN(temp_immutable_list);
-    for (auto& mem : temp_immutable_list) {
-        LOG_ENGINE_DEBUG_ << "Flushing collection: " << mem->GetTableId();
-        auto status = mem->Serialize(max_lsn, true);
-        if (!status.ok()) {
-            LOG_ENGINE_ERROR_ << "Flush collection " << mem->GetTableId() << " failed";
-            return status;
-        }
-        LOG_ENGINE_DEBUG_ << "Flushed collection: " << mem->GetTableId();
-    }
-
-    return Status::OK();
+    std::set<std::string> flushed_ids;
+    return SerializeMems(temp_immutable_list, max_lsn, flushed_ids);
 }
 
 Status
@@ -170,22 +148,17 @@ MemManagerImpl::Flush(std::set<std::string>& collection_ids) {
 
     MemList temp_immutable_list;
     {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InstrumentedMutex> lock(mutex_);
         immu_mem_list_.swap(temp_immutable_list);
+        flushing_mem_list_.insert(flushing_mem_list_.end(), temp_immutable_list.begin(), temp_immutable_list.end());
     }
 
-    std::unique_lock<std::mutex> lock(serialization_mtx_);
+    std::unique_lock<InstrumentedMutex> lock(serialization_mtx_);
     collection_ids.clear();
     auto max_lsn = GetMaxLSN(temp_immutable_list);
-    for (auto& mem : temp_immutable_list) {
-        LOG_ENGINE_DEBUG_ << "Flushing collection: " << mem->GetTableId();
-        auto status = mem->Serialize(max_lsn, true);
-        if (!status.ok()) {
-            LOG_ENGINE_ERROR_ << "Flush collection " << mem->GetTableId() << " failed";
-            return status;
-        }
-        collection_ids.insert(mem->GetTableId());
-        LOG_ENGINE_DEBUG_ << "Flushed collection: " << mem->GetTableId();
+    auto status = SerializeMems(temp_immutable_list, max_lsn, collection_ids);
+    if (!status.ok()) {
+        return status;
     }
 
     meta_->SetGlobalLastLSN(max_lsn);
@@ -193,9 +166,94 @@ MemManagerImpl::Flush(std::set<std::string>& collection_ids) {
     return Status::OK();
 }
 
+Status
+MemManagerImpl::SerializeMems(const MemList& mems, uint64_t wal_lsn, std::set<std::string>& collection_ids) {
+    // the mem tables of a collection are serialized in order by one task, the collections and partitions
+    // are serialized in parallel
+    std::vector<std::string> group_ids;
+    std::map<std::string, MemList> groups;
+    for (auto& mem : mems) {
+        auto& group = groups[mem->GetTableId()];
+        if (group.empty()) {
+            group_ids.push_back(mem->GetTableId());
+        }
+        group.push_back(mem);
+    }
+
+    struct GroupResult {
+        Status status_;
+        meta::SegmentsSchema update_files_;
+        bool serialized_ = false;  // some files of the collection are serialized, even if it failed after
+    };
+    std::vector<GroupResult> results(group_ids.size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(group_ids.size());
+    for (size_t i = 0; i < group_ids.size(); ++i) {
+        futures.emplace_back(flush_thread_pool_.enqueue([&, i] {
+            auto& result = results[i];
+            for (auto& mem : groups[group_ids[i]]) {
+                LOG_ENGINE_DEBUG_ << "Flushing collection: " << mem->GetTableId();
+                result.status_ = mem->SerializeFiles(wal_lsn, true, result.update_files_);
+                if (!result.status_.ok()) {
+                    LOG_ENGINE_ERROR_ << "Flush collection " << mem->GetTableId() << " failed";
+                    break;
+                }
+                result.serialized_ = true;
+                LOG_ENGINE_DEBUG_ << "Flushed collection: " << mem->GetTableId();
+            }
+        }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    // the files of all the collections are committed to meta at once, rather than one transaction per collection
+    meta::SegmentsSchema update_files;
+    Status status;
+    for (size_t i = 0; i < group_ids.size(); ++i) {
+        auto& result = results[i];
+        if (!result.status_.ok() && status.ok()) {
+            status = result.status_;
+        }
+        if (result.serialized_) {
+            collection_ids.insert(group_ids[i]);
+        }
+        update_files.insert(update_files.end(), result.update_files_.begin(), result.update_files_.end());
+    }
+
+    // the collections serialized before a failure still get their files into meta
+    if (!collection_ids.empty()) {
+        auto update_status = MemTable::UpdateFlushedFiles(meta_, update_files, collection_ids, wal_lsn);
+        if (status.ok()) {
+            status = update_status;
+        }
+    }
+
+    // the flushed vectors are found in the new files from now on
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    for (auto& mem : mems) {
+        mem->ReleaseFlushedFiles();
+        flushing_mem_list_.erase(std::remove(flushing_mem_list_.begin(), flushing_mem_list_.end(), mem),
+                                 flushing_mem_list_.end());
+    }
+
+    return status;
+}
+
+size_t
+MemManagerImpl::FlushThreadNum() {
+    // the flush is mostly file io, a few threads overlap it without taking the cpu from the searches
+    constexpr size_t MAX_FLUSH_THREADS = 8;
+    size_t threads = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, std::min(threads, MAX_FLUSH_THREADS));
+}
+
 Status
 MemManagerImpl::ToImmutable(const std::string& collection_id) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
     auto memIt = mem_id_map_.find(collection_id);
     if (memIt != mem_id_map_.end()) {
         if (!memIt->second->Empty()) {
@@ -212,7 +270,7 @@ MemManagerImpl::ToImmutable(const std::string& collection_id) {
 
 Status
 MemManagerImpl::ToImmutable() {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
     MemIdMap temp_map;
     for (auto& kv : mem_id_map_) {
         if (kv.second->Empty()) {
@@ -230,12 +288,12 @@ MemManagerImpl::ToImmutable() {
 Status
 MemManagerImpl::EraseMemVector(const std::string& collection_id) {
     {  // erase MemVector from rapid-insert cache
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InstrumentedMutex> lock(mutex_);
         mem_id_map_.erase(collection_id);
     }
 
     {  // erase MemVector from serialize cache
-        std::unique_lock<std::mutex> lock(serialization_mtx_);
+        std::unique_lock<InstrumentedMutex> lock(serialization_mtx_);
         MemList temp_list;
         for (auto& mem : immu_mem_list_) {
             if (mem->GetTableId() != collection_id) {
@@ -248,10 +306,62 @@ MemManagerImpl::EraseMemVector(const std::string& collection_id) {
     return Status::OK();
 }
 
+Status
+MemManagerImpl::Snapshot(const std::set<std::string>& collection_ids, MemSnapshot& snapshot) {
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    uint64_t lsn = 0;
+    auto snapshot_mem = [&](const MemTablePtr& mem) {
+        lsn = std::max(lsn, mem->GetLSN());
+        if (collection_ids.find(mem->GetTableId()) != collection_ids.end()) {
+            mem->Snapshot(snapshot);
+        }
+    };
+
+    for (auto& kv : mem_id_map_) {
+        snapshot_mem(kv.second);
+    }
+    for (auto& mem : immu_mem_list_) {
+        snapshot_mem(mem);
+    }
+    for (auto& mem : flushing_mem_list_) {
+        snapshot_mem(mem);
+    }
+    snapshot.SetLSN(lsn);
+
+    return Status::OK();
+}
+
+Status
+MemManagerImpl::GetVectorsByID(const std::set<std::string>& collection_ids, const IDNumbers& ids,
+                               std::vector<VectorsData>& vectors) {
+    vectors.clear();
+    vectors.resize(ids.size());
+
+    // the mutable tables hold the newest inserts, then the immutable ones in the order they were made
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    auto get_mem = [&](const MemTablePtr& mem) {
+        if (collection_ids.find(mem->GetTableId()) != collection_ids.end()) {
+            mem->GetVectorsByID(ids, vectors);
+        }
+    };
+
+    for (auto& kv : mem_id_map_) {
+        get_mem(kv.second);
+    }
+    for (auto it = immu_mem_list_.rbegin(); it != immu_mem_list_.rend(); ++it) {
+        get_mem(*it);
+    }
+    for (auto it = flushing_mem_list_.rbegin(); it != flushing_mem_list_.rend(); ++it) {
+        get_mem(*it);
+    }
+
+    return Status::OK();
+}
+
 size_t
 MemManagerImpl::GetCurrentMutableMem() {
     size_t total_mem = 0;
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
     for (auto& kv : mem_id_map_) {
         auto memTable = kv.second;
         total_mem += memTable->GetCurrentMem();
@@ -262,7 +372,7 @@ MemManagerImpl::GetCurrentMutableMem() {
 size_t
 MemManagerImpl::GetCurrentImmutableMem() {
     size_t total_mem = 0;
-    std::unique_lock<std::mutex> lock(serialization_mtx_);
+    std::unique_lock<InstrumentedMutex> lock(serialization_mtx_);
     for (auto& mem_table : immu_mem_list_) {
         total_mem += mem_table->GetCurrentMem();
     }
@@ -274,6 +384,31 @@ MemManagerImpl::GetCurrentMem() {
     return GetCurrentMutableMem() + GetCurrentImmutableMem();
 }
 
+std::vector<std::string>
+MemManagerImpl::FlushCandidates(size_t bytes) {
+    std::vector<std::pair<size_t, MemTablePtr>> mems;
+    {
+        std::unique_lock<InstrumentedMutex> lock(mutex_);
+        for (auto& kv : mem_id_map_) {
+            mems.emplace_back(kv.second->GetCurrentMem(), kv.second);
+        }
+    }
+    std::sort(mems.begin(), mems.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second->CreateTime() < b.second->CreateTime();
+    });
+
+    std::vector<std::string> collection_ids;
+    size_t freed = 0;
+    for (auto& mem : mems) {
+        if (freed >= bytes || mem.first == 0) {
+            break;
+        }
+        collection_ids.push_back(mem.second->GetTableId());
+        freed += mem.first;
+    }
+    return collection_ids;
+}
+
 uint64_t
 MemManagerImpl::GetMaxLSN(const MemList& tables) {
     uint64_t max_lsn = 0;
@@ -289,6 +424,7 @@ MemManagerImpl::GetMaxLSN(const MemList& tables) {
 void
 MemManagerImpl::OnInsertBufferSizeChanged(int64_t value) {
     options_.insert_buffer_size_ = value * GB;
+    MemBufferPool::GetInstance().SetCapacity(options_.insert_buffer_size_);
 }
 
 }  // namespace engine
@@ -22,10 +22,14 @@
 
 #include "config/Config.h"
 #include "config/handler/CacheConfigHandler.h"
+#include "db/insert/MemBufferPool.h"
 #include "db/insert/MemManager.h"
 #include "db/insert/MemTable.h"
 #include "db/meta/Meta.h"
+#include "utils/ContentionStats.h"
+#include "utils/MemoryAccounting.h"
 #include "utils/Status.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace engine {
@@ -36,9 +40,13 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     using MemIdMap = std::map<std::string, MemTablePtr>;
     using MemList = std::vector<MemTablePtr>;
 
-    MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options) : meta_(meta), options_(options) {
+    MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options)
+        : meta_(meta), options_(options), flush_thread_pool_(FlushThreadNum(), FLUSH_QUEUE_SIZE, "flush") {
         SetIdentity("MemManagerImpl");
         AddInsertBufferSizeListener();
+        // the pooled buffers are the memory of flushed files, no more than the insert buffer held
+        MemBufferPool::GetInstance().SetCapacity(options_.insert_buffer_size_);
+        memory_probe_.Set(MemorySubsystem::INSERT_BUFFER, [this] { return static_cast<int64_t>(GetCurrentMem()); });
     }
 
     Status
@@ -73,6 +81,13 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     Status
     EraseMemVector(const std::string& collection_id) override;
 
+    Status
+    Snapshot(const std::set<std::string>& collection_ids, MemSnapshot& snapshot) override;
+
+    Status
+    GetVectorsByID(const std::set<std::string>& collection_ids, const IDNumbers& ids,
+                   std::vector<VectorsData>& vectors) override;
+
     size_t
     GetCurrentMutableMem() override;
 
@@ -82,6 +97,9 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     size_t
     GetCurrentMem() override;
 
+    std::vector<std::string>
+    FlushCandidates(size_t bytes) override;
+
  protected:
     void
     OnInsertBufferSizeChanged(int64_t value) override;
@@ -105,12 +123,23 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     uint64_t
     GetMaxLSN(const MemList& tables);
 
+    Status
+    SerializeMems(const MemList& mems, uint64_t wal_lsn, std::set<std::string>& collection_ids);
+
+    static size_t
+    FlushThreadNum();
+
+    static constexpr size_t FLUSH_QUEUE_SIZE = 4096;
+
     MemIdMap mem_id_map_;
     MemList immu_mem_list_;
+    MemList flushing_mem_list_;  // being serialized, searched until their files are in meta
     meta::MetaPtr meta_;
     DBOptions options_;
-    std::mutex mutex_;
-    std::mutex serialization_mtx_;
+    InstrumentedMutex mutex_{"mem_manager"};
+    InstrumentedMutex serialization_mtx_{"mem_manager.serialization"};
+    ThreadPool flush_thread_pool_;  // serializes the mem tables of different collections at once
+    MemoryProbe memory_probe_;
 };  // NewMemManager
 
 }  // namespace engine
@@ -0,0 +1,103 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/MemSnapshot.h"
+#include "scheduler/task/SearchTask.h"
+#include "utils/Log.h"
+
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/distances.h>
+
+#include <unordered_set>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+void
+MemSnapshot::AddPart(Part&& part) {
+    if (!part.uids_.empty()) {
+        parts_.emplace_back(std::move(part));
+    }
+}
+
+int64_t
+MemSnapshot::RowCount() const {
+    int64_t count = 0;
+    for (auto& part : parts_) {
+        count += part.uids_.size();
+    }
+    return count;
+}
+
+Status
+MemSnapshot::Search(uint64_t k, const VectorsData& vectors, ResultIds& result_ids,
+                    ResultDistances& result_distances) const {
+    uint64_t nq = vectors.vector_count_;
+    if (parts_.empty() || nq == 0 || k == 0) {
+        return Status::OK();
+    }
+
+    for (auto& part : parts_) {
+        if (part.metric_type_ != MetricType::L2 && part.metric_type_ != MetricType::IP) {
+            return Status(DB_ERROR, "Insert buffer search supports L2 and IP metrics only");
+        }
+        if (vectors.float_data_.size() != nq * part.dimension_) {
+            return Status(DB_ERROR, "Query vectors don't match the dimension of collection " + part.collection_id_);
+        }
+
+        bool ascending = (part.metric_type_ == MetricType::L2);
+        size_t ny = part.uids_.size();
+        ResultIds ids(nq * k);
+        ResultDistances distances(nq * k);
+        if (ascending) {
+            faiss::float_maxheap_array_t heaps = {nq, k, ids.data(), distances.data()};
+            faiss::knn_L2sqr(vectors.float_data_.data(), part.vectors_.data(), part.dimension_, nq, ny, &heaps);
+        } else {
+            faiss::float_minheap_array_t heaps = {nq, k, ids.data(), distances.data()};
+            faiss::knn_inner_product(vectors.float_data_.data(), part.vectors_.data(), part.dimension_, nq, ny,
+                                     &heaps);
+        }
+        for (auto& id : ids) {
+            if (id >= 0) {
+                id = part.uids_[id];
+            }
+        }
+
+        scheduler::XSearchTask::MergeTopkToResultSet(ids, distances, k, nq, k, ascending, result_ids,
+                                                     result_distances);
+
+        // a flush between the snapshot and the reading of the files puts the same vectors in both
+        std::unordered_set<faiss::Index::idx_t> seen;
+        for (uint64_t i = 0; i < nq; ++i) {
+            seen.clear();
+            size_t kept = i * k;
+            for (size_t j = i * k; j < (i + 1) * k; ++j) {
+                if (result_ids[j] != -1 && !seen.insert(result_ids[j]).second) {
+                    continue;
+                }
+                result_ids[kept] = result_ids[j];
+                result_distances[kept] = result_distances[j];
+                ++kept;
+            }
+            for (; kept < (i + 1) * k; ++kept) {
+                result_ids[kept] = -1;
+                result_distances[kept] = 0.0;
+            }
+        }
+    }
+
+    LOG_ENGINE_DEBUG_ << "Searched " << RowCount() << " buffered vectors up to lsn " << lsn_;
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,72 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+#include "utils/Status.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * A copy of the float vectors not flushed yet of some collections, taken at once under the lock of the inserts so
+ * that it holds exactly the inserts up to lsn_. It is searched by brute force and merged into the result of the
+ * segments. It is taken before the files to search are read, a flush in between is then found in both and its
+ * vectors are counted once.
+ */
+class MemSnapshot {
+ public:
+    struct Part {
+        std::string collection_id_;
+        int64_t dimension_ = 0;
+        MetricType metric_type_ = MetricType::L2;
+        std::vector<float> vectors_;
+        IDNumbers uids_;
+    };
+
+    void
+    AddPart(Part&& part);
+
+    bool
+    Empty() const {
+        return parts_.empty();
+    }
+
+    int64_t
+    RowCount() const;
+
+    uint64_t
+    LSN() const {
+        return lsn_;
+    }
+
+    void
+    SetLSN(uint64_t lsn) {
+        lsn_ = lsn;
+    }
+
+    // search the k nearest vectors of every query and merge them into result_ids and result_distances,
+    // which hold k results per query or nothing
+    Status
+    Search(uint64_t k, const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) const;
+
+ private:
+    uint64_t lsn_ = 0;
+    std::vector<Part> parts_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -10,9 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <algorithm>
-#include <chrono>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "cache/CpuCacheMgr.h"
@@ -27,6 +30,37 @@
 namespace milvus {
 namespace engine {
 
+namespace {
+
+// runs func for each index on up to MAX_APPLY_THREADS threads, the deletes of segments are independent
+void
+ParallelFor(size_t count, const std::function<void(size_t)>& func) {
+    constexpr size_t MAX_APPLY_THREADS = 8;
+    size_t threads = std::min<size_t>({count, std::max<size_t>(1, std::thread::hardware_concurrency()),
+                                       MAX_APPLY_THREADS});
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (size_t i = next++; i < count; i = next++) {
+                func(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+}  // namespace
+
 MemTable::MemTable(const std::string& collection_id, const meta::MetaPtr& meta, const DBOptions& options)
     : collection_id_(collection_id), meta_(meta), options_(options) {
     SetIdentity("MemTable");
@@ -127,6 +161,19 @@ MemTable::GetTableFileCount() {
 
 Status
 MemTable::Serialize(uint64_t wal_lsn, bool apply_delete) {
+    meta::SegmentsSchema update_files;
+    auto status = SerializeFiles(wal_lsn, apply_delete, update_files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    status = UpdateFlushedFiles(meta_, update_files, {collection_id_}, wal_lsn);
+    ReleaseFlushedFiles();
+    return status;
+}
+
+Status
+MemTable::SerializeFiles(uint64_t wal_lsn, bool apply_delete, meta::SegmentsSchema& update_files) {
     TimeRecorder recorder("MemTable::Serialize collection " + collection_id_);
 
     if (!doc_ids_to_delete_.empty() && apply_delete) {
@@ -136,10 +183,10 @@ MemTable::Serialize(uint64_t wal_lsn, bool apply_delete) {
         }
     }
 
-    meta::SegmentsSchema update_files;
+    meta::SegmentsSchema serialized_files;
     for (auto mem_table_file = mem_table_file_list_.begin(); mem_table_file != mem_table_file_list_.end();) {
         auto status = (*mem_table_file)->Serialize(wal_lsn);
-        update_files.push_back((*mem_table_file)->GetSegmentSchema());
+        serialized_files.push_back((*mem_table_file)->GetSegmentSchema());
         if (!status.ok()) {
             return status;
         }
@@ -148,25 +195,59 @@ MemTable::Serialize(uint64_t wal_lsn, bool apply_delete) {
 
         {
             std::lock_guard<std::mutex> lock(mutex_);
+            flushed_file_list_.push_back(*mem_table_file);
             mem_table_file = mem_table_file_list_.erase(mem_table_file);
         }
     }
+    update_files.insert(update_files.end(), serialized_files.begin(), serialized_files.end());
 
-    // Update meta files and flush lsn
-    auto status = meta_->UpdateCollectionFiles(update_files);
-    if (!status.ok()) {
-        return status;
+    recorder.RecordSection("Finished flushing");
+
+    return Status::OK();
+}
+
+void
+MemTable::ReleaseFlushedFiles() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& mem_table_file : flushed_file_list_) {
+        mem_table_file->ReleaseSerialized();
     }
+    flushed_file_list_.clear();
+}
 
-    status = meta_->UpdateCollectionFlushLSN(collection_id_, wal_lsn);
+void
+MemTable::Snapshot(MemSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& mem_table_file : flushed_file_list_) {
+        mem_table_file->Snapshot(snapshot);
+    }
+    for (auto& mem_table_file : mem_table_file_list_) {
+        mem_table_file->Snapshot(snapshot);
+    }
+}
+
+void
+MemTable::GetVectorsByID(const IDNumbers& ids, std::vector<VectorsData>& vectors) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = mem_table_file_list_.rbegin(); it != mem_table_file_list_.rend(); ++it) {
+        (*it)->GetVectorsByID(ids, vectors);
+    }
+    for (auto it = flushed_file_list_.rbegin(); it != flushed_file_list_.rend(); ++it) {
+        (*it)->GetVectorsByID(ids, vectors);
+    }
+}
+
+Status
+MemTable::UpdateFlushedFiles(const meta::MetaPtr& meta, meta::SegmentsSchema& update_files,
+                             const std::set<std::string>& collection_ids, uint64_t wal_lsn) {
+    // Update meta files and flush lsn
+    auto status = meta->UpdateCollectionFilesAndFlushLSN(update_files, collection_ids, wal_lsn);
     if (!status.ok()) {
-        std::string err_msg = "Failed to write flush lsn to meta: " + status.ToString();
+        std::string err_msg = "Failed to write flushed files and flush lsn to meta: " + status.ToString();
         LOG_ENGINE_ERROR_ << err_msg;
         return Status(DB_ERROR, err_msg);
     }
 
-    recorder.RecordSection("Finished flushing");
-
     return Status::OK();
 }
 
@@ -193,16 +274,15 @@ MemTable::GetCurrentMem() {
 Status
 MemTable::ApplyDeletes() {
     // Applying deletes to other segments on disk and their corresponding cache:
-    // For each segment in collection:
+    // For each segment in collection, in parallel:
     //     Load its bloom filter
-    //     For each id in delete list:
-    //         If present, add the uid to segment's uid list
-    // For each segment
+    //     Probe the sorted delete list at once, the ids that may be present are the segment's id list
+    // For each segment with ids to check, in parallel:
     //     Get its cache if exists
     //     Load its uids file.
-    //     Scan the uids, if any uid in segment's uid list exists:
-    //         add its offset to deletedDoc
-    //         remove the id from bloom filter
+    //     Intersect the uids with the segment's id list:
+    //         add the offsets to deletedDoc
+    //         remove the ids from bloom filter
     //         set black list in cache
     //     Serialize segment's deletedDoc TODO(zhiru): append directly to previous file for now, may have duplicates
     //     Serialize bloom filter
@@ -224,27 +304,35 @@ MemTable::ApplyDeletes() {
     // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
     milvus::engine::meta::SegmentsSchema files = files_holder.HoldFiles();
 
-    // which file need to be apply delete
-    std::unordered_map<size_t, std::vector<segment::doc_id_t>> ids_to_check_map;  // file id mapping to delete ids
-    for (auto& file : files) {
+    // which file need to be apply delete, the ids of each file stay sorted like the delete list
+    std::vector<segment::doc_id_t> ids_to_delete(doc_ids_to_delete_.begin(), doc_ids_to_delete_.end());
+    std::vector<std::vector<segment::doc_id_t>> ids_to_check(files.size());
+    ParallelFor(files.size(), [&](size_t i) {
         std::string segment_dir;
-        utils::GetParentPath(file.location_, segment_dir);
+        utils::GetParentPath(files[i].location_, segment_dir);
 
         segment::SegmentReader segment_reader(segment_dir);
         segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+        if (!segment_reader.LoadBloomFilter(id_bloom_filter_ptr).ok() || id_bloom_filter_ptr == nullptr) {
+            return;
+        }
 
-        for (auto& id : doc_ids_to_delete_) {
-            if (id_bloom_filter_ptr->Check(id)) {
-                ids_to_check_map[file.id_].emplace_back(id);
+        std::vector<bool> may_exist;
+        id_bloom_filter_ptr->CheckMany(ids_to_delete, may_exist);
+        for (size_t j = 0; j < ids_to_delete.size(); ++j) {
+            if (may_exist[j]) {
+                ids_to_check[i].emplace_back(ids_to_delete[j]);
             }
         }
-    }
+    });
 
     // release unused files
-    for (auto& file : files) {
-        if (ids_to_check_map.find(file.id_) == ids_to_check_map.end()) {
-            files_holder.UnmarkFile(file);
+    std::unordered_map<size_t, std::vector<segment::doc_id_t>> ids_to_check_map;  // file id mapping to delete ids
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (ids_to_check[i].empty()) {
+            files_holder.UnmarkFile(files[i]);
+        } else {
+            ids_to_check_map[files[i].id_].swap(ids_to_check[i]);
         }
     }
 
@@ -252,149 +340,196 @@ MemTable::ApplyDeletes() {
     milvus::engine::meta::SegmentsSchema hold_files = files_holder.HoldFiles();
     recorder.RecordSection("Found " + std::to_string(hold_files.size()) + " segment to apply deletes");
 
-    meta::SegmentsSchema files_to_update;
-    for (auto& file : hold_files) {
-        LOG_ENGINE_DEBUG_ << "Applying deletes in segment: " << file.segment_id_;
-
-        TimeRecorder rec("handle segment " + file.segment_id_);
-
-        std::string segment_dir;
-        utils::GetParentPath(file.location_, segment_dir);
-        segment::SegmentReader segment_reader(segment_dir);
-
-        auto& segment_id = file.segment_id_;
-        meta::FilesHolder segment_holder;
-        status = meta_->GetCollectionFilesBySegmentId(segment_id, segment_holder);
-        if (!status.ok()) {
-            break;
+    std::vector<meta::SegmentsSchema> segment_updates(hold_files.size());
+    std::vector<Status> segment_statuses(hold_files.size());
+    ParallelFor(hold_files.size(), [&](size_t i) {
+        auto& file = hold_files[i];
+        segment_statuses[i] = ApplyDeletesToSegment(file, ids_to_check_map[file.id_], segment_updates[i]);
+        if (!segment_statuses[i].ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to apply deletes in segment " << file.segment_id_ << ": "
+                              << segment_statuses[i].message();
         }
+    });
 
-        // Get all index that contains blacklist in cache
-        std::vector<knowhere::VecIndexPtr> indexes;
-        std::vector<faiss::ConcurrentBitsetPtr> blacklists;
-        milvus::engine::meta::SegmentsSchema& segment_files = segment_holder.HoldFiles();
-        for (auto& segment_file : segment_files) {
-            auto data_obj_ptr = cache::CpuCacheMgr::GetInstance()->GetIndex(segment_file.location_);
-            auto index = std::static_pointer_cast<knowhere::VecIndex>(data_obj_ptr);
-            if (index != nullptr) {
-                faiss::ConcurrentBitsetPtr blacklist = index->GetBlacklist();
-                if (blacklist != nullptr) {
-                    indexes.emplace_back(index);
-                    blacklists.emplace_back(blacklist);
-                }
-            }
-        }
+    recorder.RecordSection("Finished " + std::to_string(ids_to_check_map.size()) + " segment to apply deletes");
 
-        std::vector<segment::doc_id_t> uids;
-        status = segment_reader.LoadUids(uids);
-        if (!status.ok()) {
-            break;
-        }
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
-        }
+    // the segments done are committed even if another one failed, applying their deletes again would count twice
+    meta::SegmentsSchema files_to_update;
+    for (auto& updates : segment_updates) {
+        files_to_update.insert(files_to_update.end(), updates.begin(), updates.end());
+    }
+    status = meta_->UpdateCollectionFilesRowCount(files_to_update);
 
-        auto& ids_to_check = ids_to_check_map[file.id_];
+    if (!status.ok()) {
+        std::string err_msg = "Failed to apply deletes: " + status.ToString();
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
 
-        segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>();
+    doc_ids_to_delete_.clear();
 
-        rec.RecordSection("Loading uids and deleted docs");
+    recorder.RecordSection("Update deletes to meta");
+    recorder.ElapseFromBegin("Finished deletes");
 
-        std::sort(ids_to_check.begin(), ids_to_check.end());
+    for (auto& segment_status : segment_statuses) {
+        if (!segment_status.ok()) {
+            return segment_status;
+        }
+    }
+    return Status::OK();
+}
 
-        rec.RecordSection("Sorting " + std::to_string(ids_to_check.size()) + " ids");
+Status
+MemTable::ApplyDeletesToSegment(const meta::SegmentSchema& file, const std::vector<segment::doc_id_t>& ids_to_check,
+                                meta::SegmentsSchema& files_to_update) {
+    LOG_ENGINE_DEBUG_ << "Applying deletes in segment: " << file.segment_id_;
+
+    TimeRecorder rec("handle segment " + file.segment_id_);
+
+    std::string segment_dir;
+    utils::GetParentPath(file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    auto& segment_id = file.segment_id_;
+    meta::FilesHolder segment_holder;
+    STATUS_CHECK(meta_->GetCollectionFilesBySegmentId(segment_id, segment_holder));
+
+    // Get all index that contains blacklist in cache
+    std::vector<knowhere::VecIndexPtr> indexes;
+    std::vector<faiss::ConcurrentBitsetPtr> blacklists;
+    milvus::engine::meta::SegmentsSchema& segment_files = segment_holder.HoldFiles();
+    for (auto& segment_file : segment_files) {
+        auto data_obj_ptr = cache::CpuCacheMgr::GetInstance()->GetIndex(segment_file.location_);
+        auto index = std::static_pointer_cast<knowhere::VecIndex>(data_obj_ptr);
+        if (index != nullptr) {
+            faiss::ConcurrentBitsetPtr blacklist = index->GetBlacklist();
+            if (blacklist != nullptr) {
+                indexes.emplace_back(index);
+                blacklists.emplace_back(blacklist);
+            }
+        }
+    }
 
-        size_t delete_count = 0;
-        auto find_diff = std::chrono::duration<double>::zero();
-        auto set_diff = std::chrono::duration<double>::zero();
+    std::vector<segment::doc_id_t> uids;
+    STATUS_CHECK(segment_reader.LoadUids(uids));
+    segment::IdBloomFilterPtr id_bloom_filter_ptr;
+    STATUS_CHECK(segment_reader.LoadBloomFilter(id_bloom_filter_ptr));
 
-        for (size_t i = 0; i < uids.size(); ++i) {
-            auto find_start = std::chrono::high_resolution_clock::now();
+    rec.RecordSection("Loading uids and deleted docs");
 
-            auto found = std::binary_search(ids_to_check.begin(), ids_to_check.end(), uids[i]);
+    std::vector<segment::offset_t> offsets;
+    FindDeletedOffsets(uids, ids_to_check, offsets);
 
-            auto find_end = std::chrono::high_resolution_clock::now();
-            find_diff += (find_end - find_start);
+    rec.RecordSection("Found " + std::to_string(offsets.size()) + " of " + std::to_string(ids_to_check.size()) +
+                      " ids in " + std::to_string(uids.size()) + " uids");
 
-            if (found) {
-                auto set_start = std::chrono::high_resolution_clock::now();
+    segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>(offsets);
+    for (auto offset : offsets) {
+        if (id_bloom_filter_ptr->Check(uids[offset])) {
+            id_bloom_filter_ptr->Remove(uids[offset]);
+        }
 
-                delete_count++;
+        for (auto& blacklist : blacklists) {
+            if (!blacklist->test(offset)) {
+                blacklist->set(offset);
+            }
+        }
+    }
 
-                deleted_docs->AddDeletedDoc(i);
+    rec.RecordSection("Set deleted docs and bloom filter");
 
-                if (id_bloom_filter_ptr->Check(uids[i])) {
-                    id_bloom_filter_ptr->Remove(uids[i]);
-                }
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i]->SetBlacklist(blacklists[i]);
+    }
 
-                for (auto& blacklist : blacklists) {
-                    if (!blacklist->test(i)) {
-                        blacklist->set(i);
-                    }
-                }
+    segment::SegmentWriter segment_writer(segment_dir);
+    STATUS_CHECK(segment_writer.WriteDeletedDocs(deleted_docs));
 
-                auto set_end = std::chrono::high_resolution_clock::now();
-                set_diff += (set_end - set_start);
-            }
-        }
+    rec.RecordSection("Appended " + std::to_string(deleted_docs->GetSize()) + " offsets to deleted docs");
 
-        LOG_ENGINE_DEBUG_ << "Finding " << ids_to_check.size() << " uids in " << uids.size() << " uids took "
-                          << find_diff.count() << " s in total";
-        LOG_ENGINE_DEBUG_ << "Setting deleted docs and bloom filter took " << set_diff.count() << " s in total";
+    STATUS_CHECK(segment_writer.WriteBloomFilter(id_bloom_filter_ptr));
 
-        rec.RecordSection("Find uids and set deleted docs and bloom filter");
+    rec.RecordSection("Updated bloom filter");
 
-        for (size_t i = 0; i < indexes.size(); ++i) {
-            indexes[i]->SetBlacklist(blacklists[i]);
+    // Update collection file row count
+    for (auto& segment_file : segment_files) {
+        if (segment_file.file_type_ == meta::SegmentSchema::RAW ||
+            segment_file.file_type_ == meta::SegmentSchema::TO_INDEX ||
+            segment_file.file_type_ == meta::SegmentSchema::INDEX ||
+            segment_file.file_type_ == meta::SegmentSchema::BACKUP) {
+            segment_file.row_count_ -= offsets.size();
+            files_to_update.emplace_back(segment_file);
         }
+    }
+    rec.RecordSection("Update collection file row count in vector");
 
-        segment::Segment tmp_segment;
-        segment::SegmentWriter segment_writer(segment_dir);
-        status = segment_writer.WriteDeletedDocs(deleted_docs);
-        if (!status.ok()) {
-            break;
-        }
+    return Status::OK();
+}
 
-        rec.RecordSection("Appended " + std::to_string(deleted_docs->GetSize()) + " offsets to deleted docs");
+void
+MemTable::FindDeletedOffsets(const std::vector<segment::doc_id_t>& uids,
+                             const std::vector<segment::doc_id_t>& sorted_ids,
+                             std::vector<segment::offset_t>& offsets) {
+    offsets.clear();
+    if (uids.empty() || sorted_ids.empty()) {
+        return;
+    }
 
-        status = segment_writer.WriteBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
+    // the uids of a segment are usually ascending already, otherwise their offsets are sorted by uid
+    std::vector<segment::offset_t> order;
+    bool ascending = std::is_sorted(uids.begin(), uids.end());
+    if (!ascending) {
+        order.resize(uids.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&](segment::offset_t a, segment::offset_t b) { return uids[a] < uids[b]; });
+    }
+    auto uid_at = [&](size_t i) { return ascending ? uids[i] : uids[order[i]]; };
+    auto offset_at = [&](size_t i) { return ascending ? static_cast<segment::offset_t>(i) : order[i]; };
+
+    // galloping intersection: the side behind jumps ahead by doubling steps, then a binary search in the last step,
+    // so a few ids cost a few searches in many uids and the other way round
+    auto gallop = [](auto value_at, size_t from, size_t size, segment::doc_id_t target) {
+        size_t step = 1;
+        size_t low = from;
+        size_t high = from;
+        while (high < size && value_at(high) < target) {
+            low = high + 1;
+            high = from + step;
+            step <<= 1;
         }
-
-        rec.RecordSection("Updated bloom filter");
-
-        // Update collection file row count
-        for (auto& segment_file : segment_files) {
-            if (segment_file.file_type_ == meta::SegmentSchema::RAW ||
-                segment_file.file_type_ == meta::SegmentSchema::TO_INDEX ||
-                segment_file.file_type_ == meta::SegmentSchema::INDEX ||
-                segment_file.file_type_ == meta::SegmentSchema::BACKUP) {
-                segment_file.row_count_ -= delete_count;
-                files_to_update.emplace_back(segment_file);
+        high = std::min(high, size);
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (value_at(mid) < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
             }
         }
-        rec.RecordSection("Update collection file row count in vector");
+        return low;
+    };
+    auto id_at = [&](size_t i) { return sorted_ids[i]; };
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < uids.size() && j < sorted_ids.size()) {
+        auto uid = uid_at(i);
+        auto id = sorted_ids[j];
+        if (uid < id) {
+            i = gallop(uid_at, i, uids.size(), id);
+        } else if (id < uid) {
+            j = gallop(id_at, j, sorted_ids.size(), uid);
+        } else {
+            // a uid inserted more than once is deleted at every offset
+            offsets.push_back(offset_at(i));
+            ++i;
+        }
     }
 
-    recorder.RecordSection("Finished " + std::to_string(ids_to_check_map.size()) + " segment to apply deletes");
-
-    status = meta_->UpdateCollectionFilesRowCount(files_to_update);
-
-    if (!status.ok()) {
-        std::string err_msg = "Failed to apply deletes: " + status.ToString();
-        LOG_ENGINE_ERROR_ << err_msg;
-        return Status(DB_ERROR, err_msg);
+    if (!ascending) {
+        std::sort(offsets.begin(), offsets.end());
     }
-
-    doc_ids_to_delete_.clear();
-
-    recorder.RecordSection("Update deletes to meta");
-    recorder.ElapseFromBegin("Finished deletes");
-
-    return Status::OK();
 }
 
 uint64_t
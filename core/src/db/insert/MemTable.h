@@ -12,6 +12,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -53,6 +54,27 @@ class MemTable : public server::CacheConfigHandler {
     Status
     Serialize(uint64_t wal_lsn, bool apply_delete = true);
 
+    // Serialize the mem files without touching meta, the serialized files are appended to update_files
+    Status
+    SerializeFiles(uint64_t wal_lsn, bool apply_delete, meta::SegmentsSchema& update_files);
+
+    // Give back the vectors of the serialized files once they are committed to meta
+    void
+    ReleaseFlushedFiles();
+
+    // Copy the vectors of the files not committed to meta yet into snapshot
+    void
+    Snapshot(MemSnapshot& snapshot);
+
+    // Copy the vectors of ids not committed to meta yet into the entries of vectors still empty, newest file first
+    void
+    GetVectorsByID(const IDNumbers& ids, std::vector<VectorsData>& vectors);
+
+    // Commit the files serialized by one flush of several collections in one meta transaction
+    static Status
+    UpdateFlushedFiles(const meta::MetaPtr& meta, meta::SegmentsSchema& update_files,
+                       const std::set<std::string>& collection_ids, uint64_t wal_lsn);
+
     bool
     Empty();
 
@@ -68,6 +90,16 @@ class MemTable : public server::CacheConfigHandler {
     void
     SetLSN(uint64_t lsn);
 
+    std::chrono::steady_clock::time_point
+    CreateTime() const {
+        return create_time_;
+    }
+
+    // the offsets of the uids found in sorted_ids, ascending, the uids of a segment need not be sorted
+    static void
+    FindDeletedOffsets(const std::vector<segment::doc_id_t>& uids, const std::vector<segment::doc_id_t>& sorted_ids,
+                       std::vector<segment::offset_t>& offsets);
+
  protected:
     void
     OnCacheInsertDataChanged(bool value) override;
@@ -76,11 +108,19 @@ class MemTable : public server::CacheConfigHandler {
     Status
     ApplyDeletes();
 
+    // the row counts of the segment files to update are appended to files_to_update
+    Status
+    ApplyDeletesToSegment(const meta::SegmentSchema& file, const std::vector<segment::doc_id_t>& ids_to_check,
+                          meta::SegmentsSchema& files_to_update);
+
  private:
     const std::string collection_id_;
 
     MemTableFileList mem_table_file_list_;
 
+    // serialized, still searched until they are committed to meta
+    MemTableFileList flushed_file_list_;
+
     meta::MetaPtr meta_;
 
     DBOptions options_;
@@ -90,6 +130,8 @@ class MemTable : public server::CacheConfigHandler {
     std::set<segment::doc_id_t> doc_ids_to_delete_;
 
     std::atomic<uint64_t> lsn_;
+
+    const std::chrono::steady_clock::time_point create_time_ = std::chrono::steady_clock::now();
 };  // MemTable
 
 using MemTablePtr = std::shared_ptr<MemTable>;
@@ -17,9 +17,11 @@
 #include <string>
 #include <vector>
 
+#include "cache/GpuResidencyMgr.h"
 #include "db/Constants.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/insert/MemBufferPool.h"
 #include "metrics/Metrics.h"
 #include "segment/SegmentReader.h"
 #include "utils/Log.h"
@@ -38,6 +40,9 @@ MemTableFile::MemTableFile(const std::string& collection_id, const meta::MetaPtr
         std::string directory;
         utils::GetParentPath(table_file_schema_.location_, directory);
         segment_writer_ptr_ = std::make_shared<segment::SegmentWriter>(directory);
+        if (!utils::IsBinaryMetricType(table_file_schema_.metric_type_)) {
+            segment_writer_ptr_->EnableVectorSummary(table_file_schema_.dimension_);
+        }
     }
 
     SetIdentity("MemTableFile");
@@ -74,11 +79,14 @@ MemTableFile::Add(const VectorSourcePtr& source) {
         size_t num_vectors_to_add = std::ceil(mem_left / single_vector_mem_size);
         size_t num_vectors_added;
 
+        ReserveVectorData(std::min(num_vectors_to_add, source->GetNumVectorsLeft()) * single_vector_mem_size);
+        size_t from = segment_writer_ptr_->VectorCount();
         auto status = source->Add(/*execution_engine_,*/ segment_writer_ptr_, table_file_schema_, num_vectors_to_add,
                                   num_vectors_added);
         if (status.ok()) {
             current_mem_ += (num_vectors_added * single_vector_mem_size);
         }
+        IndexIdOffsets(from);
         return status;
     }
     return Status::OK();
@@ -100,12 +108,16 @@ MemTableFile::AddEntities(const VectorSourcePtr& source) {
         size_t num_entities_to_add = std::ceil(mem_left / single_entity_mem_size);
         size_t num_entities_added;
 
+        ReserveVectorData(std::min(num_entities_to_add, source->GetNumVectorsLeft()) *
+                          source->SingleVectorSize(table_file_schema_.dimension_));
+        size_t from = segment_writer_ptr_->VectorCount();
         auto status =
             source->AddEntities(segment_writer_ptr_, table_file_schema_, num_entities_to_add, num_entities_added);
 
         if (status.ok()) {
             current_mem_ += (num_entities_added * single_entity_mem_size);
         }
+        IndexIdOffsets(from);
         return status;
     }
     return Status::OK();
@@ -121,6 +133,8 @@ MemTableFile::Delete(segment::doc_id_t doc_id) {
     if (found != uids.end()) {
         auto offset = std::distance(uids.begin(), found);
         segment_ptr->vectors_ptr_->Erase(offset);
+        id_offsets_.clear();
+        IndexIdOffsets(0);
     }
 
     return Status::OK();
@@ -149,6 +163,10 @@ MemTableFile::Delete(const std::vector<segment::doc_id_t>& doc_ids) {
             ++deleted;
         }
     }
+    if (deleted > 0) {
+        id_offsets_.clear();
+        IndexIdOffsets(0);
+    }
     /*
     for (auto& doc_id : doc_ids) {
         auto found = std::find(uids.begin(), uids.end(), doc_id);
@@ -207,6 +225,7 @@ MemTableFile::Serialize(uint64_t wal_lsn) {
     //    table_file_schema_.row_count_ = execution_engine_->Count();
     table_file_schema_.file_size_ = segment_writer_ptr_->Size();
     table_file_schema_.row_count_ = segment_writer_ptr_->VectorCount();
+    table_file_schema_.date_ = utils::GetDate();  // the day of the last insert, the collection ttl expires it
 
     // if index type isn't IDMAP, set file type to TO_INDEX if file size exceed index_file_size
     // else set file type to RAW, no need to build index
@@ -230,10 +249,141 @@ MemTableFile::Serialize(uint64_t wal_lsn) {
     if (options_.insert_cache_immediately_) {
         segment_writer_ptr_->Cache();
     }
+    serialized_ = true;
+
+    KeepOnGpu();
 
     return status;
 }
 
+void
+MemTableFile::ReserveVectorData(size_t size) {
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetMutableData();
+    if (data.size() + size <= data.capacity()) {
+        return;
+    }
+
+    auto& pool = MemBufferPool::GetInstance();
+    auto buffer = pool.Acquire(data.size() + size);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+    data.swap(buffer);
+    pool.Release(std::move(buffer));
+}
+
+void
+MemTableFile::RecycleVectorData() {
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    MemBufferPool::GetInstance().Release(std::move(segment_ptr->vectors_ptr_->GetMutableData()));
+}
+
+void
+MemTableFile::ReleaseSerialized() {
+    // the cached segment shares the buffer
+    if (serialized_ && !options_.insert_cache_immediately_) {
+        RecycleVectorData();
+    }
+}
+
+void
+MemTableFile::Snapshot(MemSnapshot& snapshot) {
+    if (utils::IsBinaryMetricType(table_file_schema_.metric_type_)) {
+        return;
+    }
+
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    auto& uids = segment_ptr->vectors_ptr_->GetUids();
+
+    MemSnapshot::Part part;
+    part.collection_id_ = collection_id_;
+    part.dimension_ = table_file_schema_.dimension_;
+    part.metric_type_ = (MetricType)table_file_schema_.metric_type_;
+    if (part.dimension_ <= 0) {
+        return;
+    }
+    size_t rows = std::min(uids.size(), data.size() / (part.dimension_ * sizeof(float)));
+    auto data_ptr = reinterpret_cast<const float*>(data.data());
+    part.vectors_.assign(data_ptr, data_ptr + rows * part.dimension_);
+    part.uids_.assign(uids.begin(), uids.begin() + rows);
+    snapshot.AddPart(std::move(part));
+}
+
+void
+MemTableFile::GetVectorsByID(const IDNumbers& ids, std::vector<VectorsData>& vectors) {
+    if (id_offsets_.empty() || table_file_schema_.dimension_ <= 0) {
+        return;
+    }
+
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    bool is_binary = utils::IsBinaryMetricType(table_file_schema_.metric_type_);
+    size_t single_vector_bytes =
+        is_binary ? table_file_schema_.dimension_ / 8 : table_file_schema_.dimension_ * sizeof(float);
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (vectors[i].vector_count_ > 0) {
+            continue;
+        }
+        auto found = id_offsets_.find(ids[i]);
+        // the raw vectors are given back once the serialized file is in meta
+        if (found == id_offsets_.end() || (found->second + 1) * single_vector_bytes > data.size()) {
+            continue;
+        }
+
+        auto begin = data.begin() + found->second * single_vector_bytes;
+        VectorsData& vector_ref = vectors[i];
+        vector_ref.vector_count_ = 1;
+        if (is_binary) {
+            vector_ref.binary_data_.assign(begin, begin + single_vector_bytes);
+        } else {
+            vector_ref.float_data_.resize(table_file_schema_.dimension_);
+            memcpy(vector_ref.float_data_.data(), &(*begin), single_vector_bytes);
+        }
+    }
+}
+
+void
+MemTableFile::IndexIdOffsets(size_t from) {
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    auto& uids = segment_ptr->vectors_ptr_->GetUids();
+    for (size_t i = from; i < uids.size(); ++i) {
+        id_offsets_[uids[i]] = i;
+    }
+}
+
+void
+MemTableFile::KeepOnGpu() {
+#ifdef MILVUS_GPU_VERSION
+    // the binary raw files are always searched on cpu
+    if (utils::IsBinaryMetricType(table_file_schema_.metric_type_)) {
+        return;
+    }
+
+    int64_t device_id = cache::GpuResidencyMgr::GetInstance().FreshSegmentDevice(table_file_schema_.segment_id_);
+    if (device_id < 0) {
+        return;
+    }
+
+    try {
+        auto engine = EngineFactory::Build(table_file_schema_.dimension_, table_file_schema_.location_,
+                                           EngineType::FAISS_IDMAP, (MetricType)table_file_schema_.metric_type_,
+                                           milvus::json());
+        if (engine != nullptr) {
+            engine->PrefetchFileToGpu(device_id, table_file_schema_.file_size_);
+        }
+    } catch (std::exception& ex) {
+        LOG_ENGINE_WARNING_ << "Failed to keep segment " << table_file_schema_.segment_id_ << " on gpu" << device_id
+                            << ": " << ex.what();
+    }
+#endif
+}
+
 const std::string&
 MemTableFile::GetSegmentId() const {
     return table_file_schema_.segment_id_;
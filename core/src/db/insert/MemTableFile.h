@@ -13,10 +13,12 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "config/handler/CacheConfigHandler.h"
 #include "db/engine/ExecutionEngine.h"
+#include "db/insert/MemSnapshot.h"
 #include "db/insert/VectorSource.h"
 #include "db/meta/Meta.h"
 #include "segment/SegmentWriter.h"
@@ -56,6 +58,18 @@ class MemTableFile : public server::CacheConfigHandler {
     Status
     Serialize(uint64_t wal_lsn);
 
+    // give the raw vectors back once the serialized file is in meta, they are searchable until then
+    void
+    ReleaseSerialized();
+
+    // copy the float vectors and their ids into snapshot
+    void
+    Snapshot(MemSnapshot& snapshot);
+
+    // copy the vectors of ids held by the file into the entries of vectors still empty, by the id offsets
+    void
+    GetVectorsByID(const IDNumbers& ids, std::vector<VectorsData>& vectors);
+
     const std::string&
     GetSegmentId() const;
 
@@ -70,15 +84,35 @@ class MemTableFile : public server::CacheConfigHandler {
     Status
     CreateCollectionFile();
 
+    // make room for size more bytes of raw vectors, so that adding them doesn't reallocate the buffer
+    void
+    ReserveVectorData(size_t size);
+
+    // give the raw vector buffer back to the pool once the data is serialized
+    void
+    RecycleVectorData();
+
+    // copy the serialized segment to its gpu, it is searched there until its index is built
+    void
+    KeepOnGpu();
+
+    // index the offsets of the uids from the from-th on, a later duplicate of an id overrides the earlier
+    void
+    IndexIdOffsets(size_t from);
+
  private:
     const std::string collection_id_;
     meta::SegmentSchema table_file_schema_;
     meta::MetaPtr meta_;
     DBOptions options_;
     size_t current_mem_;
+    bool serialized_ = false;
 
     //    ExecutionEnginePtr execution_engine_;
     segment::SegmentWriterPtr segment_writer_ptr_;
+
+    // the offset of each uid in the segment, rebuilt when a delete shifts the rows
+    std::unordered_map<segment::doc_id_t, segment::offset_t> id_offsets_;
 };  // MemTableFile
 
 using MemTableFilePtr = std::shared_ptr<MemTableFile>;
@@ -24,6 +24,7 @@
 #include "config/handler/CacheConfigHandler.h"
 #include "db/insert/SSMemCollection.h"
 #include "db/insert/SSMemManager.h"
+#include "utils/MemoryAccounting.h"
 #include "utils/Status.h"
 
 namespace milvus {
@@ -39,6 +40,7 @@ class SSMemManagerImpl : public SSMemManager, public server::CacheConfigHandler
     explicit SSMemManagerImpl(const DBOptions& options) : options_(options) {
         SetIdentity("SSMemManagerImpl");
         AddInsertBufferSizeListener();
+        memory_probe_.Set(MemorySubsystem::INSERT_BUFFER, [this] { return static_cast<int64_t>(GetCurrentMem()); });
     }
 
     Status
@@ -103,6 +105,7 @@ class SSMemManagerImpl : public SSMemManager, public server::CacheConfigHandler
     DBOptions options_;
     std::mutex mutex_;
     std::mutex serialization_mtx_;
+    MemoryProbe memory_probe_;
 };  // NewMemManager
 
 }  // namespace engine
@@ -33,7 +33,8 @@ SSVectorSource::Add(const segment::SSSegmentWriterPtr& segment_writer_ptr, const
     int64_t n = chunk_->count_;
     num_entities_added = current_num_added_ + num_entities_to_add <= n ? num_entities_to_add : n - current_num_added_;
 
-    auto status = segment_writer_ptr->AddChunk(chunk_, current_num_added_, num_entities_added);
+    auto status =
+        segment_writer_ptr->AddChunk(chunk_, current_num_added_, current_num_added_ + num_entities_added);
     if (!status.ok()) {
         return status;
     }
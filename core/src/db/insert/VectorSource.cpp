@@ -24,28 +24,47 @@ namespace milvus {
 namespace engine {
 
 VectorSource::VectorSource(VectorsData vectors) : vectors_(std::move(vectors)) {
-    current_num_vectors_added = 0;
+    vector_count_ = vectors_.vector_count_;
+    if (!vectors_.id_array_.empty()) {
+        id_array_ = vectors_.id_array_.data();
+    }
+    if (!vectors_.float_data_.empty()) {
+        float_data_ = vectors_.float_data_.data();
+    } else if (!vectors_.binary_data_.empty()) {
+        binary_data_ = vectors_.binary_data_.data();
+    }
 }
 
-VectorSource::VectorSource(milvus::engine::VectorsData vectors,
+VectorSource::VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const float* vectors)
+    : vector_count_(vector_count), id_array_(vector_ids), float_data_(vectors) {
+}
+
+VectorSource::VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const uint8_t* vectors)
+    : vector_count_(vector_count), id_array_(vector_ids), binary_data_(vectors) {
+}
+
+VectorSource::VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const float* vectors,
                            const std::unordered_map<std::string, uint64_t>& attr_nbytes,
                            const std::unordered_map<std::string, uint64_t>& attr_size,
                            const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data)
-    : vectors_(std::move(vectors)), attr_nbytes_(attr_nbytes), attr_size_(attr_size), attr_data_(attr_data) {
-    current_num_vectors_added = 0;
-    current_num_attrs_added = 0;
+    : vector_count_(vector_count),
+      id_array_(vector_ids),
+      float_data_(vectors),
+      attr_nbytes_(attr_nbytes),
+      attr_size_(attr_size),
+      attr_data_(attr_data) {
 }
 
 Status
 VectorSource::Add(const segment::SegmentWriterPtr& segment_writer_ptr, const meta::SegmentSchema& table_file_schema,
                   const size_t& num_vectors_to_add, size_t& num_vectors_added) {
-    uint64_t n = vectors_.vector_count_;
+    uint64_t n = vector_count_;
     server::CollectAddMetrics metrics(n, table_file_schema.dimension_);
 
     num_vectors_added =
         current_num_vectors_added + num_vectors_to_add <= n ? num_vectors_to_add : n - current_num_vectors_added;
     IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    if (id_array_ == nullptr) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
         Status status = id_generator.GetNextIDNumbers(num_vectors_added, vector_ids_to_add);
         if (!status.ok()) {
@@ -53,24 +72,21 @@ VectorSource::Add(const segment::SegmentWriterPtr& segment_writer_ptr, const met
             return status;
         }
     } else {
-        vector_ids_to_add.resize(num_vectors_added);
-        for (size_t pos = current_num_vectors_added; pos < current_num_vectors_added + num_vectors_added; pos++) {
-            vector_ids_to_add[pos - current_num_vectors_added] = vectors_.id_array_[pos];
-        }
+        vector_ids_to_add.assign(id_array_ + current_num_vectors_added,
+                                 id_array_ + current_num_vectors_added + num_vectors_added);
     }
 
     Status status;
-    if (!vectors_.float_data_.empty()) {
+    if (float_data_ != nullptr) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert float data into segment";
         auto size = num_vectors_added * table_file_schema.dimension_ * sizeof(float);
-        float* ptr = vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_;
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, (uint8_t*)ptr, size, vector_ids_to_add);
-    } else if (!vectors_.binary_data_.empty()) {
+        auto ptr = float_data_ + current_num_vectors_added * table_file_schema.dimension_;
+        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, (const uint8_t*)ptr, size,
+                                                vector_ids_to_add);
+    } else if (binary_data_ != nullptr) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert binary data into segment";
-        std::vector<uint8_t> vectors;
         auto size = num_vectors_added * SingleVectorSize(table_file_schema.dimension_) * sizeof(uint8_t);
-        uint8_t* ptr =
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_);
+        auto ptr = binary_data_ + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_);
         status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, ptr, size, vector_ids_to_add);
     }
 
@@ -92,21 +108,19 @@ VectorSource::AddEntities(const milvus::segment::SegmentWriterPtr& segment_write
                           const milvus::engine::meta::SegmentSchema& collection_file_schema,
                           const size_t& num_entities_to_add, size_t& num_entities_added) {
     // TODO: n = vectors_.vector_count_;???
-    uint64_t n = vectors_.vector_count_;
+    uint64_t n = vector_count_;
     num_entities_added =
         current_num_attrs_added + num_entities_to_add <= n ? num_entities_to_add : n - current_num_attrs_added;
     IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    if (id_array_ == nullptr) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
         Status status = id_generator.GetNextIDNumbers(num_entities_added, vector_ids_to_add);
         if (!status.ok()) {
             return status;
         }
     } else {
-        vector_ids_to_add.resize(num_entities_added);
-        for (size_t pos = current_num_attrs_added; pos < current_num_attrs_added + num_entities_added; pos++) {
-            vector_ids_to_add[pos - current_num_attrs_added] = vectors_.id_array_[pos];
-        }
+        vector_ids_to_add.assign(id_array_ + current_num_attrs_added,
+                                 id_array_ + current_num_attrs_added + num_entities_added);
     }
 
     Status status;
@@ -120,13 +134,11 @@ VectorSource::AddEntities(const milvus::segment::SegmentWriterPtr& segment_write
         return status;
     }
 
-    std::vector<uint8_t> vectors;
     auto size = num_entities_added * collection_file_schema.dimension_ * sizeof(float);
-    vectors.resize(size);
-    memcpy(vectors.data(), vectors_.float_data_.data() + current_num_vectors_added * collection_file_schema.dimension_,
-           size);
+    auto ptr = float_data_ + current_num_vectors_added * collection_file_schema.dimension_;
     LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert into segment";
-    status = segment_writer_ptr->AddVectors(collection_file_schema.file_id_, vectors, vector_ids_to_add);
+    status = segment_writer_ptr->AddVectors(collection_file_schema.file_id_, (const uint8_t*)ptr, size,
+                                            vector_ids_to_add);
     if (status.ok()) {
         current_num_vectors_added += num_entities_added;
         vector_ids_.insert(vector_ids_.end(), std::make_move_iterator(vector_ids_to_add.begin()),
@@ -147,11 +159,16 @@ VectorSource::GetNumVectorsAdded() {
     return current_num_vectors_added;
 }
 
+size_t
+VectorSource::GetNumVectorsLeft() {
+    return vector_count_ - current_num_vectors_added;
+}
+
 size_t
 VectorSource::SingleVectorSize(uint16_t dimension) {
-    if (!vectors_.float_data_.empty()) {
+    if (float_data_ != nullptr) {
         return dimension * FLOAT_TYPE_SIZE;
-    } else if (!vectors_.binary_data_.empty()) {
+    } else if (binary_data_ != nullptr) {
         return dimension / 8;
     }
 
@@ -172,7 +189,7 @@ VectorSource::SingleEntitySize(uint16_t dimension) {
 
 bool
 VectorSource::AllAdded() {
-    return (current_num_vectors_added == vectors_.vector_count_);
+    return (current_num_vectors_added == vector_count_);
 }
 
 IDNumbers
@@ -31,7 +31,14 @@ class VectorSource {
  public:
     explicit VectorSource(VectorsData vectors);
 
-    VectorSource(VectorsData vectors, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
+    // the sources below refer to the ids and vectors of the caller instead of copying them,
+    // they must stay valid until all the vectors are added
+    VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const float* vectors);
+
+    VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const uint8_t* vectors);
+
+    VectorSource(uint64_t vector_count, const IDNumber* vector_ids, const float* vectors,
+                 const std::unordered_map<std::string, uint64_t>& attr_nbytes,
                  const std::unordered_map<std::string, uint64_t>& attr_size,
                  const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data);
 
@@ -46,6 +53,9 @@ class VectorSource {
     size_t
     GetNumVectorsAdded();
 
+    size_t
+    GetNumVectorsLeft();
+
     size_t
     SingleVectorSize(uint16_t dimension);
 
@@ -59,14 +69,19 @@ class VectorSource {
     GetVectorIds();
 
  private:
-    VectorsData vectors_;
+    VectorsData vectors_;  // only holds the data of an owning source
+    uint64_t vector_count_ = 0;
+    const IDNumber* id_array_ = nullptr;
+    const float* float_data_ = nullptr;
+    const uint8_t* binary_data_ = nullptr;
+
     IDNumbers vector_ids_;
     const std::unordered_map<std::string, uint64_t> attr_nbytes_;
     std::unordered_map<std::string, uint64_t> attr_size_;
     std::unordered_map<std::string, std::vector<uint8_t>> attr_data_;
 
-    size_t current_num_vectors_added;
-    size_t current_num_attrs_added;
+    size_t current_num_vectors_added = 0;
+    size_t current_num_attrs_added = 0;
 };  // VectorSource
 
 using VectorSourcePtr = std::shared_ptr<VectorSource>;
@@ -0,0 +1,234 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "db/merge/CompactTask.h"
+#include "db/Utils.h"
+#include "db/engine/EngineFactory.h"
+#include "db/meta/MetaConsts.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
+#include "storage/IOScheduler.h"
+#include "utils/CommonUtil.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+// the raw vectors of a segment are compacted this many bytes at a time
+constexpr size_t COMPACT_CHUNK_SIZE = 64 * 1024 * 1024;
+}  // namespace
+
+CompactTask::CompactTask(const meta::MetaPtr& meta_ptr, const DBOptions& options, const meta::SegmentSchema& file)
+    : meta_ptr_(meta_ptr), options_(options), file_(file) {
+}
+
+Status
+CompactTask::Execute(meta::SegmentsSchema& files_to_update) {
+    storage::IOClassGuard io_guard(storage::IOClass::BACKGROUND);
+    LOG_ENGINE_DEBUG_ << "Compacting segment " << file_.segment_id_ << " for collection: " << file_.collection_id_;
+
+    std::string segment_dir_to_merge;
+    utils::GetParentPath(file_.location_, segment_dir_to_merge);
+
+    // Create new collection file
+    meta::SegmentSchema compacted_file;
+    compacted_file.collection_id_ = file_.collection_id_;
+    // a rewrite of existing entities like a merge: until it is done the file is neither searched nor merged, and
+    // the shadow file cleanup drops it if the server stops halfway
+    compacted_file.file_type_ = meta::SegmentSchema::NEW_MERGE;
+    compacted_file.date_ = file_.date_;
+    auto status = meta_ptr_->CreateCollectionFile(compacted_file);
+
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Failed to create collection file: " << status.message();
+        return status;
+    }
+
+    // Compact (merge) file to the newly created collection file
+    std::string new_segment_dir;
+    utils::GetParentPath(compacted_file.location_, new_segment_dir);
+    auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
+    if (!utils::IsBinaryMetricType(compacted_file.metric_type_)) {
+        segment_writer_ptr->EnableVectorSummary(compacted_file.dimension_);
+    }
+
+    LOG_ENGINE_DEBUG_ << "Compacting begin...";
+    size_t vector_width = utils::IsBinaryMetricType(compacted_file.metric_type_)
+                              ? compacted_file.dimension_ / 8
+                              : compacted_file.dimension_ * sizeof(float);
+    status = segment_writer_ptr->Compact(segment_dir_to_merge, compacted_file.file_id_, vector_width,
+                                         COMPACT_CHUNK_SIZE);
+
+    // Serialize
+    if (status.ok()) {
+        LOG_ENGINE_DEBUG_ << "Serializing compacted segment...";
+        status = segment_writer_ptr->Serialize();
+    }
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Failed to write compacted segment: " << status.message();
+        compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
+        auto mark_status = meta_ptr_->UpdateCollectionFile(compacted_file);
+        if (mark_status.ok()) {
+            LOG_ENGINE_DEBUG_ << "Mark file: " << compacted_file.file_id_ << " to to_delete";
+        }
+
+        return status;
+    }
+
+    // Update compacted file state, if origin file is backup or to_index, set compacted file to to_index
+    compacted_file.file_size_ = segment_writer_ptr->Size();
+    compacted_file.row_count_ = segment_writer_ptr->VectorCount();
+    if ((file_.file_type_ == (int32_t)meta::SegmentSchema::BACKUP ||
+         file_.file_type_ == (int32_t)meta::SegmentSchema::TO_INDEX) &&
+        (compacted_file.row_count_ > meta::BUILD_INDEX_THRESHOLD)) {
+        compacted_file.file_type_ = meta::SegmentSchema::TO_INDEX;
+    } else {
+        compacted_file.file_type_ = meta::SegmentSchema::RAW;
+    }
+
+    if (compacted_file.row_count_ == 0) {
+        LOG_ENGINE_DEBUG_ << "Compacted segment is empty. Mark it as TO_DELETE";
+        compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
+    }
+
+    files_to_update.emplace_back(compacted_file);
+
+    // Set all files in segment to TO_DELETE
+    auto& segment_id = file_.segment_id_;
+    meta::FilesHolder files_holder;
+    status = meta_ptr_->GetCollectionFilesBySegmentId(segment_id, files_holder);
+    if (!status.ok()) {
+        return status;
+    }
+
+    milvus::engine::meta::SegmentsSchema& segment_files = files_holder.HoldFiles();
+    for (auto& f : segment_files) {
+        // the compacted segment inherits the index instead of waiting for the build index thread
+        if (f.file_type_ == (int32_t)meta::SegmentSchema::INDEX &&
+            compacted_file.file_type_ == (int32_t)meta::SegmentSchema::TO_INDEX) {
+            meta::SegmentSchema compacted_index;
+            auto index_status = CompactIndex(f, compacted_file, compacted_index);
+            if (index_status.ok()) {
+                compacted_file.file_type_ = meta::SegmentSchema::BACKUP;
+                files_to_update.front().file_type_ = meta::SegmentSchema::BACKUP;
+                files_to_update.emplace_back(compacted_index);
+            } else {
+                LOG_ENGINE_DEBUG_ << "Index of segment " << segment_id << " is built again: " << index_status.message();
+            }
+        }
+
+        f.file_type_ = meta::SegmentSchema::FILE_TYPE::TO_DELETE;
+        files_to_update.emplace_back(f);
+    }
+    files_holder.ReleaseFiles();
+
+    LOG_ENGINE_DEBUG_ << "Compacted segment " << compacted_file.segment_id_ << " from "
+                      << std::to_string(file_.file_size_) << " bytes to " << std::to_string(compacted_file.file_size_)
+                      << " bytes";
+
+    if (options_.insert_cache_immediately_) {
+        segment_writer_ptr->Cache();
+    }
+
+    return status;
+}
+
+Status
+CompactTask::CompactIndex(const meta::SegmentSchema& index_file, const meta::SegmentSchema& compacted_file,
+                          meta::SegmentSchema& compacted_index) {
+    auto engine = EngineFactory::Build(index_file.dimension_, index_file.location_,
+                                       (EngineType)index_file.engine_type_, (MetricType)index_file.metric_type_,
+                                       milvus::json::parse(index_file.index_params_));
+    if (engine == nullptr) {
+        return Status(DB_ERROR, "Invalid engine type");
+    }
+    auto status = engine->Load(false);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::string segment_dir;
+    utils::GetParentPath(file_.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+    segment::DeletedDocsPtr deleted_docs_ptr;
+    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // the segment writer keeps the remaining entities in order, an entity moves ahead by the deleted ones before it
+    auto deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+    std::sort(deleted_docs.begin(), deleted_docs.end());
+    deleted_docs.erase(std::unique(deleted_docs.begin(), deleted_docs.end()), deleted_docs.end());
+
+    int64_t count = engine->Count();
+    std::vector<int64_t> new_offsets(count);
+    auto deleted = deleted_docs.begin();
+    int64_t new_offset = 0;
+    for (int64_t offset = 0; offset < count; ++offset) {
+        if (deleted != deleted_docs.end() && *deleted == offset) {
+            new_offsets[offset] = -1;
+            ++deleted;
+        } else {
+            new_offsets[offset] = new_offset++;
+        }
+    }
+    if (new_offset != (int64_t)compacted_file.row_count_) {
+        return Status(DB_ERROR, "Index doesn't match the compacted segment");
+    }
+
+    compacted_index.collection_id_ = compacted_file.collection_id_;
+    compacted_index.segment_id_ = compacted_file.segment_id_;
+    compacted_index.date_ = compacted_file.date_;
+    compacted_index.file_type_ = meta::SegmentSchema::NEW_INDEX;
+    status = meta_ptr_->CreateCollectionFile(compacted_index);
+    if (!status.ok()) {
+        return status;
+    }
+
+    auto failed = [&](const Status& fail_status) {
+        compacted_index.file_type_ = meta::SegmentSchema::TO_DELETE;
+        meta_ptr_->UpdateCollectionFile(compacted_index);
+        return fail_status;
+    };
+
+    // the index type or params might be changed since the origin index was built
+    if (compacted_index.engine_type_ != index_file.engine_type_ ||
+        compacted_index.index_params_ != index_file.index_params_) {
+        return failed(Status(DB_ERROR, "Index of collection is changed"));
+    }
+
+    auto compacted_engine = engine->CompactIndex(compacted_index.location_, new_offsets);
+    if (compacted_engine == nullptr) {
+        return failed(Status(DB_ERROR, "Index type doesn't support compacting"));
+    }
+    status = compacted_engine->Serialize();
+    if (!status.ok()) {
+        return failed(status);
+    }
+
+    compacted_index.file_type_ = meta::SegmentSchema::INDEX;
+    compacted_index.file_size_ = CommonUtil::GetFileSize(compacted_index.location_);
+    compacted_index.row_count_ = compacted_file.row_count_;
+    LOG_ENGINE_DEBUG_ << "Compacted index " << index_file.file_id_ << " to " << compacted_index.file_id_ << " of size "
+                      << compacted_index.file_size_ << " bytes";
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
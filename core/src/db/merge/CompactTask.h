@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "db/merge/MergeManager.h"
+#include "db/meta/MetaTypes.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// rewrite a segment without its deleted entities
+class CompactTask {
+ public:
+    CompactTask(const meta::MetaPtr& meta, const DBOptions& options, const meta::SegmentSchema& file);
+
+    // the compacted file and the files of the old segment are appended to files_to_update,
+    // the caller commits them to meta
+    Status
+    Execute(meta::SegmentsSchema& files_to_update);
+
+ private:
+    // build the index of the compacted segment from the index of the origin segment
+    Status
+    CompactIndex(const meta::SegmentSchema& index_file, const meta::SegmentSchema& compacted_file,
+                 meta::SegmentSchema& compacted_index);
+
+ private:
+    meta::MetaPtr meta_ptr_;
+    DBOptions options_;
+
+    meta::SegmentSchema file_;
+};  // CompactTask
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,98 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "db/merge/CompactionPolicy.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+constexpr std::chrono::seconds CompactionPolicy::DECAY_INTERVAL;
+
+void
+CompactionPolicy::RecordSearch(const std::string& segment_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    search_counts_[segment_id] += 1.0;
+}
+
+std::vector<CompactionPolicy::Candidate>
+CompactionPolicy::Pick(const std::vector<Candidate>& candidates, double threshold, int64_t bytes_limit) {
+    std::vector<std::pair<double, Candidate>> ranked;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        DecayNoLock();
+        for (auto& candidate : candidates) {
+            double ratio = DeletedRatio(candidate);
+            if (candidate.deleted_count_ <= 0 || ratio < threshold) {
+                continue;
+            }
+
+            double searches = 0.0;
+            auto iter = search_counts_.find(candidate.segment_id_);
+            if (iter != search_counts_.end()) {
+                searches = iter->second;
+            }
+            // segments that are never searched are still compacted to reclaim disk
+            ranked.emplace_back(ratio * (1.0 + searches), candidate);
+        }
+    }
+
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const std::pair<double, Candidate>& left, const std::pair<double, Candidate>& right) {
+                         return left.first > right.first;
+                     });
+
+    std::vector<Candidate> picked;
+    int64_t picked_bytes = 0;
+    for (auto& pair : ranked) {
+        if (bytes_limit > 0 && !picked.empty() && picked_bytes + pair.second.size_ > bytes_limit) {
+            break;
+        }
+        picked_bytes += pair.second.size_;
+        picked.emplace_back(std::move(pair.second));
+    }
+
+    return picked;
+}
+
+double
+CompactionPolicy::DeletedRatio(const Candidate& candidate) {
+    int64_t total = candidate.row_count_ + candidate.deleted_count_;
+    if (total <= 0) {
+        return 0.0;
+    }
+    return (double)candidate.deleted_count_ / (double)total;
+}
+
+void
+CompactionPolicy::DecayNoLock() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_decay_ < DECAY_INTERVAL) {
+        return;
+    }
+    last_decay_ = now;
+
+    // entries of merged or compacted segments fade out here
+    for (auto iter = search_counts_.begin(); iter != search_counts_.end();) {
+        iter->second /= 2.0;
+        if (iter->second < 0.5) {
+            iter = search_counts_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
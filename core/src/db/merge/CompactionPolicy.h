@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Ranks segments for background compaction.
+ * Deleted entities are only filtered by a blacklist, so every search of a segment still scans them.
+ * The priority of a segment is its deleted ratio weighted by how often it was searched recently,
+ * the search counts are halved every DECAY_INTERVAL.
+ */
+class CompactionPolicy {
+ public:
+    struct Candidate {
+        std::string segment_id_;
+        int64_t row_count_ = 0;  // live entities
+        int64_t deleted_count_ = 0;
+        int64_t size_ = 0;
+    };
+
+    static constexpr std::chrono::seconds DECAY_INTERVAL = std::chrono::seconds(60);
+
+    void
+    RecordSearch(const std::string& segment_id);
+
+    /*
+     * Pick the segments to compact
+     * @param candidates: segments of a collection
+     * @param threshold: minimal deleted ratio, segments below it are skipped
+     * @param bytes_limit: total size of the picked segments, the first one is always picked, 0 means no limit
+     * @return: picked segments in priority order
+     */
+    std::vector<Candidate>
+    Pick(const std::vector<Candidate>& candidates, double threshold, int64_t bytes_limit);
+
+    static double
+    DeletedRatio(const Candidate& candidate);
+
+ private:
+    void
+    DecayNoLock();
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, double> search_counts_;
+    std::chrono::steady_clock::time_point last_decay_ = std::chrono::steady_clock::now();
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -38,10 +38,14 @@ namespace engine {
 //    third, if some file's create time is 30 seconds ago, and it still un-merged, force merge with upper layer files
 // 3. ADAPTIVE
 //    Pick files that sum of size is close to index_file_size, merge them
+// 4. TIERED
+//    put files to tiers by size ratio, merge fan-in files of a tier at a time, the fan-in is derived from
+//    the write amplification budget so that each row is rewritten a bounded number of times
 enum class MergeStrategyType {
     SIMPLE = 1,
     LAYERED = 2,
     ADAPTIVE = 3,
+    TIERED = 4,
 };
 
 class MergeManager {
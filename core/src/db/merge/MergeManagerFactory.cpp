@@ -15,12 +15,29 @@
 #include "utils/Exception.h"
 #include "utils/Log.h"
 
+#include <string>
+#include <unordered_map>
+
 namespace milvus {
 namespace engine {
 
-MergeManagerPtr
+MergeManagerImplPtr
 MergeManagerFactory::Build(const meta::MetaPtr& meta_ptr, const DBOptions& options) {
-    return std::make_shared<MergeManagerImpl>(meta_ptr, options, MergeStrategyType::LAYERED);
+    static const std::unordered_map<std::string, MergeStrategyType> strategy_map = {
+        {"simple", MergeStrategyType::SIMPLE},
+        {"layered", MergeStrategyType::LAYERED},
+        {"adaptive", MergeStrategyType::ADAPTIVE},
+        {"tiered", MergeStrategyType::TIERED},
+    };
+
+    auto type = MergeStrategyType::LAYERED;
+    auto iter = strategy_map.find(options.merge_strategy_);
+    if (iter != strategy_map.end()) {
+        type = iter->second;
+    } else {
+        LOG_ENGINE_WARNING_ << "Unknown merge strategy " << options.merge_strategy_ << ", use layered";
+    }
+    return std::make_shared<MergeManagerImpl>(meta_ptr, options, type);
 }
 
 MergeManagerPtr
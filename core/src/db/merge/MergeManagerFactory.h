@@ -12,6 +12,7 @@
 #pragma once
 
 #include "MergeManager.h"
+#include "MergeManagerImpl.h"
 #include "db/Options.h"
 
 #include <memory>
@@ -21,7 +22,7 @@ namespace engine {
 
 class MergeManagerFactory {
  public:
-    static MergeManagerPtr
+    static MergeManagerImplPtr
     Build(const meta::MetaPtr& meta_ptr, const DBOptions& options);
 
     static MergeManagerPtr
@@ -10,17 +10,31 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/merge/MergeManagerImpl.h"
+#include "db/Utils.h"
+#include "db/merge/CompactTask.h"
 #include "db/merge/MergeAdaptiveStrategy.h"
 #include "db/merge/MergeLayeredStrategy.h"
 #include "db/merge/MergeSimpleStrategy.h"
 #include "db/merge/MergeStrategy.h"
 #include "db/merge/MergeTask.h"
+#include "db/merge/MergeTieredStrategy.h"
+#include "segment/SegmentReader.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
 namespace milvus {
 namespace engine {
 
+namespace {
+
+constexpr int64_t TTL_MERGE_BUCKETS = 10;  // a merged segment of a collection with a ttl spans a tenth of it at most
+
+}  // namespace
+
 MergeManagerImpl::MergeManagerImpl(const meta::MetaPtr& meta_ptr, const DBOptions& options, MergeStrategyType type)
     : meta_ptr_(meta_ptr), options_(options), strategy_type_(type) {
     UseStrategy(type);
@@ -41,6 +55,10 @@ MergeManagerImpl::UseStrategy(MergeStrategyType type) {
             strategy_ = std::make_shared<MergeAdaptiveStrategy>();
             break;
         }
+        case MergeStrategyType::TIERED: {
+            strategy_ = std::make_shared<MergeTieredStrategy>(options_.merge_write_amplification_);
+            break;
+        }
         default: {
             std::string msg = "Unsupported merge strategy type: " + std::to_string((int32_t)type);
             LOG_ENGINE_ERROR_ << msg;
@@ -71,8 +89,44 @@ MergeManagerImpl::MergeFiles(const std::string& collection_id) {
         return Status::OK();
     }
 
+    int64_t ttl_days = 0;
+    status = CollectionTTL(collection_id, ttl_days);
+    if (!status.ok()) {
+        return status;
+    }
+    int64_t merged_bytes = 0;
+    if (ttl_days <= 0) {
+        return MergeFileGroups(collection_id, files_holder, merged_bytes);
+    }
+
+    // a segment expires with its last insert, the files inserted in different buckets of the ttl are merged apart so
+    // that a merged segment doesn't keep older rows alive for long
+    int64_t bucket_days = std::max<int64_t>(1, ttl_days / TTL_MERGE_BUCKETS);
+    std::map<int64_t, meta::SegmentsSchema> buckets;
+    for (auto& file : files_holder.HoldFiles()) {
+        buckets[utils::GetDateDays(file.date_) / bucket_days].push_back(file);
+    }
+    for (auto& pair : buckets) {
+        meta::FilesHolder bucket_holder;
+        bucket_holder.MarkFiles(pair.second);
+        files_holder.UnmarkFiles(pair.second);
+        if (pair.second.size() < 2) {
+            continue;
+        }
+        auto bucket_status = MergeFileGroups(collection_id, bucket_holder, merged_bytes);
+        if (!bucket_status.ok()) {
+            status = bucket_status;
+        }
+    }
+
+    return status;
+}
+
+Status
+MergeManagerImpl::MergeFileGroups(const std::string& collection_id, meta::FilesHolder& files_holder,
+                                  int64_t& merged_bytes) {
     MergeFilesGroups files_groups;
-    status = strategy_->RegroupFiles(files_holder, files_groups);
+    auto status = strategy_->RegroupFiles(files_holder, files_groups);
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << "Failed to regroup files for: " << collection_id
                           << ", continue to merge all files into one";
@@ -82,8 +136,19 @@ MergeManagerImpl::MergeFiles(const std::string& collection_id) {
     }
 
     for (auto& group : files_groups) {
+        // merge I/O competes with searches, leave the other groups to the next round once the limit is reached
+        if (options_.merge_bytes_limit_ > 0 && merged_bytes >= options_.merge_bytes_limit_) {
+            LOG_ENGINE_DEBUG_ << "Merge bytes limit reached for " << collection_id << ", defer "
+                              << group.size() << " files";
+            files_holder.UnmarkFiles(group);
+            continue;
+        }
+
         MergeTask task(meta_ptr_, options_, group);
         status = task.Execute();
+        for (auto& file : group) {
+            merged_bytes += file.file_size_;
+        }
 
         files_holder.UnmarkFiles(group);
     }
@@ -91,5 +156,103 @@ MergeManagerImpl::MergeFiles(const std::string& collection_id) {
     return status;
 }
 
+Status
+MergeManagerImpl::CollectionTTL(const std::string& collection_id, int64_t& ttl_days) {
+    meta::CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_id;
+    auto status = meta_ptr_->DescribeCollection(collection_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // the ttl of a partition is the one of its collection
+    if (!collection_schema.owner_collection_.empty()) {
+        collection_schema.collection_id_ = collection_schema.owner_collection_;
+        status = meta_ptr_->DescribeCollection(collection_schema);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    ttl_days = utils::GetCollectionTTL(collection_schema.flag_);
+    return Status::OK();
+}
+
+void
+MergeManagerImpl::RecordSearch(const meta::SegmentDescs& files) {
+    if (options_.auto_compact_threshold_ <= 0.0) {
+        return;
+    }
+
+    for (auto& file : files) {
+        compaction_policy_.RecordSearch(file->segment_id_);
+    }
+}
+
+Status
+MergeManagerImpl::CompactFiles(const std::string& collection_id, int64_t& reclaimed_bytes) {
+    reclaimed_bytes = 0;
+    if (options_.auto_compact_threshold_ <= 0.0) {
+        return Status::OK();
+    }
+
+    // to_index files are left to the manual compaction, which waits for the build index thread
+    std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::BACKUP};
+    meta::FilesHolder files_holder;
+    auto status = meta_ptr_->FilesByType(collection_id, file_types, files_holder);
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Failed to get files to compact for collection: " << collection_id;
+        return status;
+    }
+
+    std::unordered_map<std::string, meta::SegmentSchema> segment_files;
+    std::vector<CompactionPolicy::Candidate> candidates;
+    meta::SegmentsSchema hold_files = files_holder.HoldFiles();
+    for (auto& file : hold_files) {
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        size_t deleted_count = 0;
+        if (!segment_reader.ReadDeletedDocsSize(deleted_count).ok() || deleted_count == 0) {
+            files_holder.UnmarkFile(file);
+            continue;
+        }
+
+        CompactionPolicy::Candidate candidate;
+        candidate.segment_id_ = file.segment_id_;
+        candidate.row_count_ = file.row_count_;
+        candidate.deleted_count_ = deleted_count;
+        candidate.size_ = file.file_size_;
+        candidates.emplace_back(candidate);
+        segment_files.insert(std::make_pair(file.segment_id_, file));
+    }
+
+    auto picked =
+        compaction_policy_.Pick(candidates, options_.auto_compact_threshold_, options_.auto_compact_bytes_limit_);
+    for (auto& candidate : picked) {
+        auto& file = segment_files[candidate.segment_id_];
+        meta::SegmentsSchema files_to_update;
+        CompactTask task(meta_ptr_, options_, file);
+        status = task.Execute(files_to_update);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Compact failed for segment " << file.segment_id_ << ": " << status.message();
+            continue;
+        }
+
+        status = meta_ptr_->UpdateCollectionFiles(files_to_update);
+        if (!status.ok()) {
+            break;  // meta error, could not go on
+        }
+        reclaimed_bytes += file.file_size_ - files_to_update.front().file_size_;
+    }
+
+    if (!picked.empty()) {
+        LOG_ENGINE_INFO_ << "Compacted " << picked.size() << " of " << candidates.size() << " segments with deleted "
+                         << "entities for collection " << collection_id << ", reclaimed " << reclaimed_bytes
+                         << " bytes";
+    }
+
+    return status;
+}
+
 }  // namespace engine
 }  // namespace milvus
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "db/merge/CompactionPolicy.h"
 #include "db/merge/MergeManager.h"
 #include "db/merge/MergeStrategy.h"
 #include "utils/Status.h"
@@ -42,13 +43,34 @@ class MergeManagerImpl : public MergeManager {
     Status
     MergeFiles(const std::string& collection_id) override;
 
+    // segments searched often are compacted first
+    void
+    RecordSearch(const meta::SegmentDescs& files);
+
+    // compact the segments with many deleted entities, reclaimed_bytes returns the size freed. Only the collections
+    // without snapshot are compacted in the background, SSMergeTask doesn't rewrite a single segment
+    Status
+    CompactFiles(const std::string& collection_id, int64_t& reclaimed_bytes);
+
+ private:
+    // merges the files held as the strategy groups them, until merged_bytes reaches the merge bytes limit
+    Status
+    MergeFileGroups(const std::string& collection_id, meta::FilesHolder& files_holder, int64_t& merged_bytes);
+
+    Status
+    CollectionTTL(const std::string& collection_id, int64_t& ttl_days);
+
  private:
     meta::MetaPtr meta_ptr_;
     DBOptions options_;
 
     MergeStrategyType strategy_type_ = MergeStrategyType::SIMPLE;
     MergeStrategyPtr strategy_;
+
+    CompactionPolicy compaction_policy_;
 };  // MergeManagerImpl
 
+using MergeManagerImplPtr = std::shared_ptr<MergeManagerImpl>;
+
 }  // namespace engine
 }  // namespace milvus
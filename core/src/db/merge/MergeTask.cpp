@@ -14,8 +14,10 @@
 #include "metrics/Metrics.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
+#include "storage/IOScheduler.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -31,6 +33,7 @@ MergeTask::Execute() {
     if (files_.empty()) {
         return Status::OK();
     }
+    storage::IOClassGuard io_guard(storage::IOClass::BACKGROUND);
 
     // check input
     std::string collection_id = files_.front().collection_id_;
@@ -44,6 +47,9 @@ MergeTask::Execute() {
     meta::SegmentSchema collection_file;
     collection_file.collection_id_ = collection_id;
     collection_file.file_type_ = meta::SegmentSchema::NEW_MERGE;
+    for (auto& file : files_) {
+        collection_file.date_ = std::max(collection_file.date_, file.date_);  // the day of the last insert
+    }
     Status status = meta_ptr_->CreateCollectionFile(collection_file);
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << "Failed to create collection: " << status.ToString();
@@ -56,6 +62,16 @@ MergeTask::Execute() {
     std::string new_segment_dir;
     utils::GetParentPath(collection_file.location_, new_segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
+    if (!utils::IsBinaryMetricType(collection_file.metric_type_)) {
+        segment_writer_ptr->EnableVectorSummary(collection_file.dimension_);
+    }
+
+    // the raw files are copied file to file when all the segments keep them plain, otherwise the segments are loaded
+    bool merge_files = std::all_of(files_.begin(), files_.end(), [](const meta::SegmentSchema& file) {
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        return segment::SegmentWriter::CanMergeFiles(segment_dir);
+    });
 
     // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
     std::string info = "Merge task files size info:";
@@ -66,7 +82,18 @@ MergeTask::Execute() {
         server::CollectMergeFilesMetrics metrics;
         std::string segment_dir_to_merge;
         utils::GetParentPath(file.location_, segment_dir_to_merge);
-        segment_writer_ptr->Merge(segment_dir_to_merge, collection_file.file_id_);
+        if (merge_files) {
+            // a half copied segment can't be taken back, the merged one is dropped
+            status = segment_writer_ptr->MergeFiles(segment_dir_to_merge, collection_file.file_id_);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << "Failed to merge " << segment_dir_to_merge << ": " << status.message();
+                collection_file.file_type_ = meta::SegmentSchema::TO_DELETE;
+                meta_ptr_->UpdateCollectionFile(collection_file);
+                return status;
+            }
+        } else {
+            segment_writer_ptr->Merge(segment_dir_to_merge, collection_file.file_id_);
+        }
 
         auto file_schema = file;
         file_schema.file_type_ = meta::SegmentSchema::TO_DELETE;
@@ -76,7 +103,7 @@ MergeTask::Execute() {
             break;
         }
     }
-    LOG_ENGINE_DEBUG_ << info;
+    LOG_ENGINE_DEBUG_ << info << (merge_files ? " copied file to file" : " loaded");
 
     // step 3: serialize to disk
     try {
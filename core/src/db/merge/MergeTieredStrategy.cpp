@@ -0,0 +1,114 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/MergeTieredStrategy.h"
+#include "db/Constants.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// files smaller than this are in the lowest tier, merging tiny flushed files costs little
+constexpr uint64_t MIN_TIER_SIZE = 1 * MB;
+
+}  // namespace
+
+MergeTieredStrategy::MergeTieredStrategy(int64_t write_amplification)
+    : write_amplification_(std::max<int64_t>(write_amplification, 1)) {
+}
+
+int64_t
+MergeTieredStrategy::FanIn(uint64_t base_size, uint64_t target_size, int64_t write_amplification) {
+    if (base_size == 0 || target_size <= base_size || write_amplification <= 0) {
+        return 2;
+    }
+    double ratio = (double)target_size / (double)base_size;
+    auto fan_in = (int64_t)std::ceil(std::pow(ratio, 1.0 / write_amplification) - 1e-9);
+    return std::max<int64_t>(fan_in, 2);
+}
+
+Status
+MergeTieredStrategy::RegroupFiles(meta::FilesHolder& files_holder, MergeFilesGroups& files_groups) {
+    meta::SegmentsSchema hold_files = files_holder.HoldFiles();
+    meta::SegmentsSchema candidates;
+    for (auto& file : hold_files) {
+        if (file.index_file_size_ > 0 && file.file_size_ >= (size_t)(file.index_file_size_)) {
+            // file that reached the top tier
+            files_holder.UnmarkFile(file);
+        } else {
+            candidates.push_back(file);
+        }
+    }
+
+    // no need to merge single file
+    if (candidates.size() < 2) {
+        files_holder.UnmarkFiles(candidates);
+        return Status::OK();
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const meta::SegmentSchema& left, const meta::SegmentSchema& right) {
+                  return left.file_size_ < right.file_size_;
+              });
+
+    uint64_t target_size = 0;
+    if (candidates[0].index_file_size_ > 0) {
+        target_size = candidates[0].index_file_size_;
+    } else {
+        for (auto& file : candidates) {
+            target_size += file.file_size_;
+        }
+    }
+    uint64_t base_size = std::max<uint64_t>(candidates[0].file_size_, MIN_TIER_SIZE);
+    int64_t fan_in = FanIn(base_size, target_size, write_amplification_);
+
+    // tier t holds the files of size in [base_size * fan_in^t, base_size * fan_in^(t+1))
+    std::map<int64_t, meta::SegmentsSchema> tiers;
+    for (auto& file : candidates) {
+        int64_t tier = 0;
+        for (uint64_t bound = base_size * fan_in; file.file_size_ >= bound && bound < target_size; bound *= fan_in) {
+            ++tier;
+        }
+        tiers[tier].push_back(file);
+    }
+
+    for (auto& pair : tiers) {
+        meta::SegmentsSchema group;
+        uint64_t group_size = 0;
+        for (auto& file : pair.second) {
+            group.push_back(file);
+            group_size += file.file_size_;
+            // the merged file climbs at least one tier, or is big enough to be indexed
+            if ((int64_t)group.size() >= fan_in || group_size >= target_size) {
+                files_groups.emplace_back(std::move(group));
+                group.clear();
+                group_size = 0;
+            }
+        }
+
+        // wait for more files of the tier rather than rewriting these rows again
+        files_holder.UnmarkFiles(group);
+    }
+
+    LOG_ENGINE_DEBUG_ << "Tiered merge of " << candidates.size() << " files, fan-in " << fan_in << ", "
+                      << files_groups.size() << " groups";
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,43 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "db/merge/MergeStrategy.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Size-ratio merge: files are put into tiers whose sizes grow by a fan-in factor, and fan-in files of a tier are
+ * merged into one file of the next tier. The fan-in is chosen so that a row climbs from the smallest file to
+ * index_file_size in no more than write_amplification merges, and is indexed only once it gets there.
+ */
+class MergeTieredStrategy : public MergeStrategy {
+ public:
+    explicit MergeTieredStrategy(int64_t write_amplification);
+
+    Status
+    RegroupFiles(meta::FilesHolder& files_holder, MergeFilesGroups& files_groups) override;
+
+    // number of files merged at a time to reach target_size from base_size in write_amplification merges
+    static int64_t
+    FanIn(uint64_t base_size, uint64_t target_size, int64_t write_amplification);
+
+ private:
+    int64_t write_amplification_;
+};  // MergeTieredStrategy
+
+}  // namespace engine
+}  // namespace milvus
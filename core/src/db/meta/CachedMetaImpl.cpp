@@ -0,0 +1,461 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/CachedMetaImpl.h"
+
+#include <unordered_map>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+CachedMetaImpl::CachedMetaImpl(const MetaPtr& meta, int64_t ttl_ms)
+    : meta_(meta), ttl_(std::chrono::milliseconds(ttl_ms)) {
+}
+
+Status
+CachedMetaImpl::CreateCollection(CollectionSchema& collection_schema) {
+    return meta_->CreateCollection(collection_schema);
+}
+
+Status
+CachedMetaImpl::DescribeCollection(CollectionSchema& collection_schema) {
+    return meta_->DescribeCollection(collection_schema);
+}
+
+Status
+CachedMetaImpl::HasCollection(const std::string& collection_id, bool& has_or_not, bool is_root) {
+    return meta_->HasCollection(collection_id, has_or_not, is_root);
+}
+
+Status
+CachedMetaImpl::AllCollections(std::vector<CollectionSchema>& collection_schema_array, bool is_root) {
+    return meta_->AllCollections(collection_schema_array, is_root);
+}
+
+Status
+CachedMetaImpl::DropCollections(const std::vector<std::string>& collection_id_array) {
+    auto status = meta_->DropCollections(collection_id_array);
+    InvalidateAll();
+    return status;
+}
+
+Status
+CachedMetaImpl::DeleteCollectionFiles(const std::vector<std::string>& collection_id_array) {
+    auto status = meta_->DeleteCollectionFiles(collection_id_array);
+    for (auto& collection_id : collection_id_array) {
+        Invalidate(collection_id);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
+    return meta_->CreateCollectionFile(file_schema);
+}
+
+Status
+CachedMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::vector<size_t>& ids,
+                                   FilesHolder& files_holder) {
+    return meta_->GetCollectionFiles(collection_id, ids, files_holder);
+}
+
+Status
+CachedMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, FilesHolder& files_holder) {
+    return meta_->GetCollectionFilesBySegmentId(segment_id, files_holder);
+}
+
+Status
+CachedMetaImpl::UpdateCollectionIndex(const std::string& collection_id, const CollectionIndex& index) {
+    auto status = meta_->UpdateCollectionIndex(collection_id, index);
+    InvalidateAll();
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFlag(const std::string& collection_id, int64_t flag) {
+    auto status = meta_->UpdateCollectionFlag(collection_id, flag);
+    InvalidatePartitions();
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFlushLSN(const std::string& collection_id, uint64_t flush_lsn) {
+    auto status = meta_->UpdateCollectionFlushLSN(collection_id, flush_lsn);
+    InvalidatePartitions();
+    return status;
+}
+
+Status
+CachedMetaImpl::GetCollectionFlushLSN(const std::string& collection_id, uint64_t& flush_lsn) {
+    return meta_->GetCollectionFlushLSN(collection_id, flush_lsn);
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFile(SegmentSchema& file_schema) {
+    auto status = meta_->UpdateCollectionFile(file_schema);
+    Invalidate(file_schema.collection_id_);
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFilesToIndex(const std::string& collection_id) {
+    auto status = meta_->UpdateCollectionFilesToIndex(collection_id);
+    Invalidate(collection_id);
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
+    auto status = meta_->UpdateCollectionFiles(files);
+    Invalidate(files);
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
+    auto status = meta_->UpdateCollectionFilesRowCount(files);
+    Invalidate(files);
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                                 uint64_t flush_lsn) {
+    auto status = meta_->UpdateCollectionFilesAndFlushLSN(files, collection_ids, flush_lsn);
+    Invalidate(files);
+    InvalidatePartitions();
+    return status;
+}
+
+Status
+CachedMetaImpl::DescribeCollectionIndex(const std::string& collection_id, CollectionIndex& index) {
+    return meta_->DescribeCollectionIndex(collection_id, index);
+}
+
+Status
+CachedMetaImpl::DropCollectionIndex(const std::string& collection_id) {
+    auto status = meta_->DropCollectionIndex(collection_id);
+    InvalidateAll();
+    return status;
+}
+
+Status
+CachedMetaImpl::CreatePartition(const std::string& collection_id, const std::string& partition_name,
+                                const std::string& tag, uint64_t lsn) {
+    auto status = meta_->CreatePartition(collection_id, partition_name, tag, lsn);
+    InvalidatePartitions();
+    return status;
+}
+
+Status
+CachedMetaImpl::HasPartition(const std::string& collection_id, const std::string& tag, bool& has_or_not) {
+    return meta_->HasPartition(collection_id, tag, has_or_not);
+}
+
+Status
+CachedMetaImpl::DropPartition(const std::string& partition_name) {
+    auto status = meta_->DropPartition(partition_name);
+    Invalidate(partition_name);
+    InvalidatePartitions();
+    return status;
+}
+
+Status
+CachedMetaImpl::ShowPartitions(const std::string& collection_id,
+                               std::vector<meta::CollectionSchema>& partition_schema_array) {
+    auto cached = GetCachedPartitions(collection_id);
+    if (cached != nullptr) {
+        partition_schema_array.insert(partition_schema_array.end(), cached->begin(), cached->end());
+        return Status::OK();
+    }
+
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version = version_;
+    }
+    auto load_time = Clock::now();
+
+    std::vector<meta::CollectionSchema> loaded;
+    auto status = meta_->ShowPartitions(collection_id, loaded);
+    partition_schema_array.insert(partition_schema_array.end(), loaded.begin(), loaded.end());
+    if (status.ok()) {
+        PutCachedPartitions(collection_id, loaded, version, load_time);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::GetPartitionName(const std::string& collection_id, const std::string& tag,
+                                 std::string& partition_name) {
+    return meta_->GetPartitionName(collection_id, tag, partition_name);
+}
+
+Status
+CachedMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& files_holder) {
+    auto cached = GetCached(collection_id);
+    if (cached != nullptr) {
+        return files_holder.MarkFiles(*cached);
+    }
+
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version = version_;
+    }
+    auto load_time = Clock::now();
+
+    FilesHolder loaded;
+    auto status = meta_->FilesToSearch(collection_id, loaded);
+    files_holder.MarkFiles(loaded.HoldDescs());
+    if (status.ok()) {
+        PutCached(collection_id, loaded.HoldDescs(), version, load_time);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::set<std::string>& partition_id_array,
+                                FilesHolder& files_holder) {
+    // the partitions share the dimension and index of the root collection, their entries are interchangeable
+    // with the ones loaded by FilesToSearch
+    std::set<std::string> missed;
+    for (auto& partition_id : partition_id_array) {
+        auto cached = GetCached(partition_id);
+        if (cached != nullptr) {
+            files_holder.MarkFiles(*cached);
+        } else {
+            missed.insert(partition_id);
+        }
+    }
+    if (missed.empty()) {
+        return Status::OK();
+    }
+
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version = version_;
+    }
+    auto load_time = Clock::now();
+
+    FilesHolder loaded;
+    auto status = meta_->FilesToSearchEx(root_collection, missed, loaded);
+    files_holder.MarkFiles(loaded.HoldDescs());
+    if (status.ok()) {
+        std::unordered_map<std::string, SegmentDescs> partition_files;
+        for (auto& file : loaded.HoldDescs()) {
+            partition_files[file->collection_id_].push_back(file);
+        }
+        for (auto& partition_id : missed) {
+            PutCached(partition_id, partition_files[partition_id], version, load_time);
+        }
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& files_holder) {
+    return meta_->FilesToMerge(collection_id, files_holder);
+}
+
+Status
+CachedMetaImpl::FilesToIndex(FilesHolder& files_holder) {
+    return meta_->FilesToIndex(files_holder);
+}
+
+Status
+CachedMetaImpl::FilesByType(const std::string& collection_id, const std::vector<int>& file_types,
+                            FilesHolder& files_holder) {
+    return meta_->FilesByType(collection_id, file_types, files_holder);
+}
+
+Status
+CachedMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collections,
+                              const std::vector<int>& file_types, FilesHolder& files_holder) {
+    return meta_->FilesByTypeEx(collections, file_types, files_holder);
+}
+
+Status
+CachedMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_holder) {
+    return meta_->FilesByID(ids, files_holder);
+}
+
+Status
+CachedMetaImpl::FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) {
+    return meta_->FilesUpdatedSince(updated_time, files);
+}
+
+Status
+CachedMetaImpl::Size(uint64_t& result) {
+    return meta_->Size(result);
+}
+
+Status
+CachedMetaImpl::Archive() {
+    auto status = meta_->Archive();
+    InvalidateAll();
+    return status;
+}
+
+Status
+CachedMetaImpl::CleanUpShadowFiles() {
+    return meta_->CleanUpShadowFiles();
+}
+
+Status
+CachedMetaImpl::CleanUpFilesWithTTL(uint64_t seconds) {
+    return meta_->CleanUpFilesWithTTL(seconds);
+}
+
+Status
+CachedMetaImpl::DropAll() {
+    auto status = meta_->DropAll();
+    InvalidateAll();
+    return status;
+}
+
+Status
+CachedMetaImpl::Count(const std::string& collection_id, uint64_t& result) {
+    // the counted files are the to-search ones, loading them serves the searches as well
+    auto cached = GetCached(collection_id);
+    FilesHolder files_holder;
+    if (cached == nullptr) {
+        auto status = FilesToSearch(collection_id, files_holder);
+        if (!status.ok()) {
+            return meta_->Count(collection_id, result);
+        }
+    }
+
+    result = 0;
+    for (auto& file : (cached != nullptr) ? *cached : files_holder.HoldDescs()) {
+        result += file->row_count_;
+    }
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::SetGlobalLastLSN(uint64_t lsn) {
+    return meta_->SetGlobalLastLSN(lsn);
+}
+
+Status
+CachedMetaImpl::GetGlobalLastLSN(uint64_t& lsn) {
+    return meta_->GetGlobalLastLSN(lsn);
+}
+
+Status
+CachedMetaImpl::CreateHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) {
+    return meta_->CreateHybridCollection(collection_schema, fields_schema);
+}
+
+Status
+CachedMetaImpl::DescribeHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) {
+    return meta_->DescribeHybridCollection(collection_schema, fields_schema);
+}
+
+Status
+CachedMetaImpl::UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) {
+    return meta_->UpdateFieldsStats(fields_stats);
+}
+
+Status
+CachedMetaImpl::GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) {
+    return meta_->GetFieldsStats(segment_ids, fields_stats);
+}
+
+CachedMetaImpl::FilesPtr
+CachedMetaImpl::GetCached(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(collection_id);
+    if (iter == entries_.end()) {
+        return nullptr;
+    }
+
+    // poll the meta database again, another node may have changed the files
+    if (Clock::now() - iter->second.load_time_ >= ttl_) {
+        entries_.erase(iter);
+        return nullptr;
+    }
+    return iter->second.files_;
+}
+
+void
+CachedMetaImpl::PutCached(const std::string& collection_id, const SegmentDescs& files, uint64_t version,
+                          Clock::time_point load_time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (version != version_) {
+        return;
+    }
+    entries_[collection_id] = Entry{std::make_shared<const SegmentDescs>(files), load_time};
+}
+
+CachedMetaImpl::PartitionsPtr
+CachedMetaImpl::GetCachedPartitions(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = partitions_.find(collection_id);
+    if (iter == partitions_.end()) {
+        return nullptr;
+    }
+
+    if (Clock::now() - iter->second.load_time_ >= ttl_) {
+        partitions_.erase(iter);
+        return nullptr;
+    }
+    return iter->second.partitions_;
+}
+
+void
+CachedMetaImpl::PutCachedPartitions(const std::string& collection_id, const std::vector<CollectionSchema>& partitions,
+                                    uint64_t version, Clock::time_point load_time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (version != version_) {
+        return;
+    }
+    partitions_[collection_id] =
+        PartitionsEntry{std::make_shared<const std::vector<CollectionSchema>>(partitions), load_time};
+}
+
+void
+CachedMetaImpl::Invalidate(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    entries_.erase(collection_id);
+}
+
+void
+CachedMetaImpl::Invalidate(const SegmentsSchema& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    for (auto& file : files) {
+        entries_.erase(file.collection_id_);
+    }
+}
+
+void
+CachedMetaImpl::InvalidatePartitions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    partitions_.clear();
+}
+
+void
+CachedMetaImpl::InvalidateAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    entries_.clear();
+    partitions_.clear();
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,238 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Meta.h"
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+/*
+ * Keeps the to-search files and the partitions of each collection in memory, so that a query or a
+ * count doesn't go to the meta database unless they changed. The row count of a collection is the
+ * sum over its to-search files. The cached files are shared with the holders they are marked in, not copied.
+ * The cache is dropped by the writes done through this object. The writes of other nodes sharing
+ * the same MySQL database are not seen, so an entry is loaded again once it is older than ttl.
+ * All the other calls go to the wrapped meta directly.
+ */
+class CachedMetaImpl : public Meta {
+ public:
+    CachedMetaImpl(const MetaPtr& meta, int64_t ttl_ms);
+
+    Status
+    CreateCollection(CollectionSchema& collection_schema) override;
+
+    Status
+    DescribeCollection(CollectionSchema& collection_schema) override;
+
+    Status
+    HasCollection(const std::string& collection_id, bool& has_or_not, bool is_root = false) override;
+
+    Status
+    AllCollections(std::vector<CollectionSchema>& collection_schema_array, bool is_root = false) override;
+
+    Status
+    DropCollections(const std::vector<std::string>& collection_id_array) override;
+
+    Status
+    DeleteCollectionFiles(const std::vector<std::string>& collection_id_array) override;
+
+    Status
+    CreateCollectionFile(SegmentSchema& file_schema) override;
+
+    Status
+    GetCollectionFiles(const std::string& collection_id, const std::vector<size_t>& ids,
+                       FilesHolder& files_holder) override;
+
+    Status
+    GetCollectionFilesBySegmentId(const std::string& segment_id, FilesHolder& files_holder) override;
+
+    Status
+    UpdateCollectionIndex(const std::string& collection_id, const CollectionIndex& index) override;
+
+    Status
+    UpdateCollectionFlag(const std::string& collection_id, int64_t flag) override;
+
+    Status
+    UpdateCollectionFlushLSN(const std::string& collection_id, uint64_t flush_lsn) override;
+
+    Status
+    GetCollectionFlushLSN(const std::string& collection_id, uint64_t& flush_lsn) override;
+
+    Status
+    UpdateCollectionFile(SegmentSchema& file_schema) override;
+
+    Status
+    UpdateCollectionFilesToIndex(const std::string& collection_id) override;
+
+    Status
+    UpdateCollectionFiles(SegmentsSchema& files) override;
+
+    Status
+    UpdateCollectionFilesRowCount(SegmentsSchema& files) override;
+
+    Status
+    UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                     uint64_t flush_lsn) override;
+
+    Status
+    DescribeCollectionIndex(const std::string& collection_id, CollectionIndex& index) override;
+
+    Status
+    DropCollectionIndex(const std::string& collection_id) override;
+
+    Status
+    CreatePartition(const std::string& collection_id, const std::string& partition_name, const std::string& tag,
+                    uint64_t lsn) override;
+
+    Status
+    HasPartition(const std::string& collection_id, const std::string& tag, bool& has_or_not) override;
+
+    Status
+    DropPartition(const std::string& partition_name) override;
+
+    Status
+    ShowPartitions(const std::string& collection_id,
+                   std::vector<meta::CollectionSchema>& partition_schema_array) override;
+
+    Status
+    GetPartitionName(const std::string& collection_id, const std::string& tag, std::string& partition_name) override;
+
+    Status
+    FilesToSearch(const std::string& collection_id, FilesHolder& files_holder) override;
+
+    Status
+    FilesToSearchEx(const std::string& root_collection, const std::set<std::string>& partition_id_array,
+                    FilesHolder& files_holder) override;
+
+    Status
+    FilesToMerge(const std::string& collection_id, FilesHolder& files_holder) override;
+
+    Status
+    FilesToIndex(FilesHolder& files_holder) override;
+
+    Status
+    FilesByType(const std::string& collection_id, const std::vector<int>& file_types,
+                FilesHolder& files_holder) override;
+
+    Status
+    FilesByTypeEx(const std::vector<meta::CollectionSchema>& collections, const std::vector<int>& file_types,
+                  FilesHolder& files_holder) override;
+
+    Status
+    FilesByID(const std::vector<size_t>& ids, FilesHolder& files_holder) override;
+
+    Status
+    FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) override;
+
+    Status
+    Size(uint64_t& result) override;
+
+    Status
+    Archive() override;
+
+    Status
+    CleanUpShadowFiles() override;
+
+    Status
+    CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter = nullptr*/) override;
+
+    Status
+    DropAll() override;
+
+    Status
+    Count(const std::string& collection_id, uint64_t& result) override;
+
+    Status
+    SetGlobalLastLSN(uint64_t lsn) override;
+
+    Status
+    GetGlobalLastLSN(uint64_t& lsn) override;
+
+    Status
+    CreateHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) override;
+
+    Status
+    DescribeHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) override;
+
+    Status
+    UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) override;
+
+    Status
+    GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) override;
+
+ private:
+    using Clock = std::chrono::steady_clock;
+    using FilesPtr = std::shared_ptr<const SegmentDescs>;
+
+    using PartitionsPtr = std::shared_ptr<const std::vector<CollectionSchema>>;
+
+    struct Entry {
+        FilesPtr files_;
+        Clock::time_point load_time_;
+    };
+
+    struct PartitionsEntry {
+        PartitionsPtr partitions_;
+        Clock::time_point load_time_;
+    };
+
+    FilesPtr
+    GetCached(const std::string& collection_id);
+
+    void
+    PutCached(const std::string& collection_id, const SegmentDescs& files, uint64_t version,
+              Clock::time_point load_time);
+
+    PartitionsPtr
+    GetCachedPartitions(const std::string& collection_id);
+
+    void
+    PutCachedPartitions(const std::string& collection_id, const std::vector<CollectionSchema>& partitions,
+                        uint64_t version, Clock::time_point load_time);
+
+    void
+    Invalidate(const std::string& collection_id);
+
+    void
+    Invalidate(const SegmentsSchema& files);
+
+    // drops the partitions of every collection, for the writes changing a collection schema
+    void
+    InvalidatePartitions();
+
+    void
+    InvalidateAll();
+
+ private:
+    MetaPtr meta_;
+    const Clock::duration ttl_;
+
+    std::mutex mutex_;
+    // bumped by every invalidation, a load started before an invalidation is not put into the cache
+    uint64_t version_ = 0;
+    std::unordered_map<std::string, Entry> entries_;
+    std::unordered_map<std::string, PartitionsEntry> partitions_;
+};  // CachedMetaImpl
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -12,6 +12,7 @@
 #include "db/meta/FilesHolder.h"
 #include "utils/Log.h"
 
+#include <memory>
 #include <utility>
 
 namespace milvus {
@@ -49,11 +50,11 @@ FilesHolder::OngoingFileChecker::UnmarkOngoingFile(const meta::SegmentSchema& ta
 }
 
 Status
-FilesHolder::OngoingFileChecker::UnmarkOngoingFiles(const meta::SegmentsSchema& table_files) {
+FilesHolder::OngoingFileChecker::UnmarkOngoingFiles(const meta::SegmentDescs& table_files) {
     std::lock_guard<std::mutex> lck(mutex_);
 
     for (auto& table_file : table_files) {
-        UnmarkOngoingFileNoLock(table_file);
+        UnmarkOngoingFileNoLock(*table_file);
     }
 
     return Status::OK();
@@ -149,12 +150,33 @@ FilesHolder::~FilesHolder() {
 
 Status
 FilesHolder::MarkFile(const meta::SegmentSchema& file) {
+    std::lock_guard<std::mutex> lck(mutex_);
+    if (unique_ids_.find(file.id_) != unique_ids_.end()) {
+        return Status::OK();  // already marked
+    }
+    return MarkFileInternal(std::make_shared<const meta::SegmentSchema>(file));
+}
+
+Status
+FilesHolder::MarkFile(const meta::SegmentDescPtr& file) {
     std::lock_guard<std::mutex> lck(mutex_);
     return MarkFileInternal(file);
 }
 
 Status
 FilesHolder::MarkFiles(const meta::SegmentsSchema& files) {
+    std::lock_guard<std::mutex> lck(mutex_);
+    for (auto& file : files) {
+        if (unique_ids_.find(file.id_) == unique_ids_.end()) {
+            MarkFileInternal(std::make_shared<const meta::SegmentSchema>(file));
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+FilesHolder::MarkFiles(const meta::SegmentDescs& files) {
     std::lock_guard<std::mutex> lck(mutex_);
     for (auto& file : files) {
         MarkFileInternal(file);
@@ -179,11 +201,31 @@ FilesHolder::UnmarkFiles(const meta::SegmentsSchema& files) {
     return Status::OK();
 }
 
+const milvus::engine::meta::SegmentsSchema&
+FilesHolder::HoldFiles() const {
+    if (!hold_files_copied_) {
+        hold_files_.reserve(hold_descs_.size());
+        for (auto& file : hold_descs_) {
+            hold_files_.push_back(*file);
+        }
+        hold_files_copied_ = true;
+    }
+    return hold_files_;
+}
+
+milvus::engine::meta::SegmentsSchema&
+FilesHolder::HoldFiles() {
+    static_cast<const FilesHolder*>(this)->HoldFiles();
+    return hold_files_;
+}
+
 void
 FilesHolder::ReleaseFiles() {
     std::lock_guard<std::mutex> lck(mutex_);
-    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(hold_files_);
+    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(hold_descs_);
+    hold_descs_.clear();
     hold_files_.clear();
+    hold_files_copied_ = false;
     unique_ids_.clear();
 }
 
@@ -198,15 +240,18 @@ FilesHolder::PrintInfo() {
 }
 
 Status
-FilesHolder::MarkFileInternal(const meta::SegmentSchema& file) {
-    if (unique_ids_.find(file.id_) != unique_ids_.end()) {
+FilesHolder::MarkFileInternal(const meta::SegmentDescPtr& file) {
+    if (unique_ids_.find(file->id_) != unique_ids_.end()) {
         return Status::OK();  // already marked
     }
 
-    auto status = OngoingFileChecker::GetInstance().MarkOngoingFile(file);
+    auto status = OngoingFileChecker::GetInstance().MarkOngoingFile(*file);
     if (status.ok()) {
-        unique_ids_.insert(file.id_);
-        hold_files_.push_back(file);
+        unique_ids_.insert(file->id_);
+        hold_descs_.push_back(file);
+        if (hold_files_copied_) {
+            hold_files_.push_back(*file);
+        }
     }
 
     return status;
@@ -220,14 +265,22 @@ FilesHolder::UnmarkFileInternal(const meta::SegmentSchema& file) {
 
     auto status = OngoingFileChecker::GetInstance().UnmarkOngoingFile(file);
     if (status.ok()) {
+        // file may be one of the held ones, it is not read once they are erased
+        auto id = file.id_;
         for (auto iter = hold_files_.begin(); iter != hold_files_.end(); ++iter) {
-            if (file.id_ == (*iter).id_) {
+            if (id == (*iter).id_) {
                 hold_files_.erase(iter);
                 break;
             }
         }
+        for (auto iter = hold_descs_.begin(); iter != hold_descs_.end(); ++iter) {
+            if (id == (*iter)->id_) {
+                hold_descs_.erase(iter);
+                break;
+            }
+        }
 
-        unique_ids_.erase(file.id_);
+        unique_ids_.erase(id);
     }
     return status;
 }
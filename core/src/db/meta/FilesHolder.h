@@ -31,23 +31,33 @@ class FilesHolder {
     Status
     MarkFile(const meta::SegmentSchema& file);
 
+    Status
+    MarkFile(const meta::SegmentDescPtr& file);
+
     Status
     MarkFiles(const meta::SegmentsSchema& files);
 
+    // share the descriptors, nothing is copied
+    Status
+    MarkFiles(const meta::SegmentDescs& files);
+
     Status
     UnmarkFile(const meta::SegmentSchema& file);
 
     Status
     UnmarkFiles(const meta::SegmentsSchema& files);
 
+    // a copy of the held files made on first use, kept in step with the marks from then on, the changes made to it
+    // are not seen by HoldDescs
     const milvus::engine::meta::SegmentsSchema&
-    HoldFiles() const {
-        return hold_files_;
-    }
+    HoldFiles() const;
 
     milvus::engine::meta::SegmentsSchema&
-    HoldFiles() {
-        return hold_files_;
+    HoldFiles();
+
+    const milvus::engine::meta::SegmentDescs&
+    HoldDescs() const {
+        return hold_descs_;
     }
 
     void
@@ -75,7 +85,7 @@ class FilesHolder {
         UnmarkOngoingFile(const meta::SegmentSchema& file);
 
         Status
-        UnmarkOngoingFiles(const meta::SegmentsSchema& files);
+        UnmarkOngoingFiles(const meta::SegmentDescs& files);
 
         bool
         CanBeDeleted(const meta::SegmentSchema& file);
@@ -97,14 +107,16 @@ class FilesHolder {
 
  private:
     Status
-    MarkFileInternal(const meta::SegmentSchema& file);
+    MarkFileInternal(const meta::SegmentDescPtr& file);
 
     Status
     UnmarkFileInternal(const meta::SegmentSchema& file);
 
  private:
     std::mutex mutex_;
-    milvus::engine::meta::SegmentsSchema hold_files_;
+    milvus::engine::meta::SegmentDescs hold_descs_;
+    mutable milvus::engine::meta::SegmentsSchema hold_files_;
+    mutable bool hold_files_copied_ = false;
     std::set<uint64_t> unique_ids_;
 };
 
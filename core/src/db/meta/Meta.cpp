@@ -21,6 +21,7 @@ const char* META_TABLEFILES = "TableFiles";
 const char* META_COLLECTIONS = "Collections";
 const char* META_FIELDS = "Fields";
 const char* META_COLLECTIONFILES = "CollectionFiles";
+const char* META_FIELDSTATS = "FieldStats";
 
 }  // namespace meta
 }  // namespace engine
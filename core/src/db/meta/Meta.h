@@ -33,6 +33,7 @@ extern const char* META_TABLEFILES;
 extern const char* META_COLLECTIONS;
 extern const char* META_FIELDS;
 extern const char* META_COLLECTIONFILES;
+extern const char* META_FIELDSTATS;
 
 class FilesHolder;
 
@@ -94,6 +95,11 @@ class Meta {
     virtual Status
     UpdateCollectionFilesRowCount(SegmentsSchema& files) = 0;
 
+    // update the files produced by a flush and the flush lsn of the flushed collections in one transaction
+    virtual Status
+    UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                     uint64_t flush_lsn) = 0;
+
     virtual Status
     UpdateCollectionIndex(const std::string& collection_id, const CollectionIndex& index) = 0;
 
@@ -145,6 +151,10 @@ class Meta {
     virtual Status
     FilesByID(const std::vector<size_t>& ids, FilesHolder& files_holder) = 0;
 
+    // the files of all collections updated at or after updated_time, of any file type, the files are not held
+    virtual Status
+    FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) = 0;
+
     virtual Status
     Size(uint64_t& result) = 0;
 
@@ -174,6 +184,13 @@ class Meta {
 
     virtual Status
     DescribeHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) = 0;
+
+    // replace the stats of the segments the given stats are of
+    virtual Status
+    UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) = 0;
+
+    virtual Status
+    GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) = 0;
 };  // MetaData
 
 using MetaPtr = std::shared_ptr<Meta>;
@@ -42,13 +42,17 @@ enum class EngineType {
     ANNOY = 12,
     FAISS_IVFSQ8NR = 13,
     HNSW_SQ8NR = 14,
-    MAX_VALUE = HNSW_SQ8NR,
+    FAISS_PQ_FASTSCAN = 15,
+    DISKANN = 16,
+    FAISS_BIN_HASH = 17,
+    MAX_VALUE = FAISS_BIN_HASH,
 };
 
 static std::map<std::string, EngineType> s_map_engine_type = {
     {knowhere::IndexEnum::INDEX_FAISS_IDMAP, EngineType::FAISS_IDMAP},
     {knowhere::IndexEnum::INDEX_FAISS_IVFFLAT, EngineType::FAISS_IVFFLAT},
     {knowhere::IndexEnum::INDEX_FAISS_IVFPQ, EngineType::FAISS_PQ},
+    {knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, EngineType::FAISS_PQ_FASTSCAN},
     {knowhere::IndexEnum::INDEX_FAISS_IVFSQ8, EngineType::FAISS_IVFSQ8},
     {knowhere::IndexEnum::INDEX_FAISS_IVFSQ8NR, EngineType::FAISS_IVFSQ8NR},
     {knowhere::IndexEnum::INDEX_FAISS_IVFSQ8H, EngineType::FAISS_IVFSQ8H},
@@ -59,7 +63,9 @@ static std::map<std::string, EngineType> s_map_engine_type = {
 #endif
     {knowhere::IndexEnum::INDEX_HNSW, EngineType::HNSW},
     {knowhere::IndexEnum::INDEX_HNSW_SQ8NR, EngineType::HNSW_SQ8NR},
-    {knowhere::IndexEnum::INDEX_ANNOY, EngineType::ANNOY}};
+    {knowhere::IndexEnum::INDEX_ANNOY, EngineType::ANNOY},
+    {knowhere::IndexEnum::INDEX_DISKANN, EngineType::DISKANN},
+    {knowhere::IndexEnum::INDEX_FAISS_BIN_HASH, EngineType::FAISS_BIN_HASH}};
 
 enum class MetricType {
     L2 = 1,              // Euclidean Distance
@@ -82,6 +88,10 @@ constexpr char CURRENT_VERSION[] = MILVUS_VERSION;
 constexpr int64_t FLAG_MASK_NO_USERID = 0x1;
 constexpr int64_t FLAG_MASK_HAS_USERID = 0x1 << 1;
 
+// the ttl of a collection in days is kept in the bits of its flag from FLAG_TTL_SHIFT, 0 means its data never expire
+constexpr int64_t FLAG_TTL_SHIFT = 32;
+constexpr int64_t MAX_COLLECTION_TTL_DAYS = 36500;
+
 using DateT = int;
 const DateT EmptyDate = -1;
 
@@ -146,6 +156,10 @@ struct SegmentSchema {
 using SegmentSchemaPtr = std::shared_ptr<meta::SegmentSchema>;
 using SegmentsSchema = std::vector<SegmentSchema>;
 
+// a file as meta listed it, shared read only by the holders, the meta cache and the search tasks
+using SegmentDescPtr = std::shared_ptr<const meta::SegmentSchema>;
+using SegmentDescs = std::vector<SegmentDescPtr>;
+
 using File2RefCount = std::map<uint64_t, int64_t>;
 using Table2FileRef = std::map<std::string, File2RefCount>;
 
@@ -199,6 +213,19 @@ struct FieldsSchema {
 
 using FieldSchemaPtr = std::shared_ptr<FieldSchema>;
 
+// bounds of a numeric field over the rows of a segment, as text exact for the field type
+struct FieldStatsSchema {
+    std::string collection_id_;
+    std::string segment_id_;
+    std::string field_name_;
+    int32_t field_type_ = 0;
+    int64_t row_count_ = 0;
+    std::string min_value_;
+    std::string max_value_;
+};
+
+using FieldsStatsSchema = std::vector<FieldStatsSchema>;
+
 struct VectorFileSchema {
     std::string field_name_;
     int64_t index_file_size_ = DEFAULT_INDEX_FILE_SIZE;  // not persist to meta
@@ -11,7 +11,6 @@
 
 #include "db/meta/MySQLConnectionPool.h"
 #include <fiu-local.h>
-#include <thread>
 
 namespace milvus::engine::meta {
 
@@ -22,11 +21,14 @@ namespace milvus::engine::meta {
 // we keep our own count; ConnectionPool::size() isn't the same!
 mysqlpp::Connection*
 MySQLConnectionPool::grab() {
-    while (conns_in_use_ > max_pool_size_) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    {
+        // a released connection wakes one waiter at once, rather than at its next poll
+        std::unique_lock<std::mutex> lock(conns_mutex_);
+        conns_cv_.wait(lock, [this] { return conns_in_use_ < max_pool_size_; });
+        ++conns_in_use_;
     }
 
-    ++conns_in_use_;
+    // a failed connection is released as well by the ScopedConnection
     return mysqlpp::ConnectionPool::grab();
 }
 
@@ -34,12 +36,16 @@ MySQLConnectionPool::grab() {
 void
 MySQLConnectionPool::release(const mysqlpp::Connection* pc) {
     mysqlpp::ConnectionPool::release(pc);
-    if (conns_in_use_ <= 0) {
-        LOG_ENGINE_WARNING_ << "MySQLConnetionPool::release: conns_in_use_ is less than zero.  conns_in_use_ = "
-                            << conns_in_use_;
-    } else {
+    {
+        std::lock_guard<std::mutex> lock(conns_mutex_);
+        if (conns_in_use_ <= 0) {
+            LOG_ENGINE_WARNING_ << "MySQLConnetionPool::release: conns_in_use_ is less than zero.  conns_in_use_ = "
+                                << conns_in_use_;
+            return;
+        }
         --conns_in_use_;
     }
+    conns_cv_.notify_one();
 }
 
 //    int MySQLConnectionPool::getConnectionsInUse() {
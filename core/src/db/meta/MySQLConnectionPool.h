@@ -13,7 +13,8 @@
 
 #include <unistd.h>
 
-#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 #include <mysql++/mysql++.h>
@@ -67,8 +68,10 @@ class MySQLConnectionPool : public mysqlpp::ConnectionPool {
     max_idle_time() override;
 
  private:
-    // Number of connections currently in use
-    std::atomic<int> conns_in_use_ = 0;
+    // Number of connections currently in use, a grab waits on conns_cv_ while max_pool_size_ are
+    std::mutex conns_mutex_;
+    std::condition_variable conns_cv_;
+    int conns_in_use_ = 0;
 
     // Our connection parameters
     std::string db_name_, user_, password_, server_;
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <regex>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -211,10 +212,24 @@ static const MetaSchema FIELDS_SCHEMA(META_FIELDS, {
                                                        MetaField("field_params", "VARCHAR(255)", "NOT NULL"),
                                                    });
 
+// FieldStats schema, no existing column changes so it is created on the databases of older versions too
+static const MetaSchema FIELDSTATS_SCHEMA(META_FIELDSTATS, {
+                                                               MetaField("table_id", "VARCHAR(255)", "NOT NULL"),
+                                                               MetaField("segment_id", "VARCHAR(255)", "NOT NULL"),
+                                                               MetaField("field_name", "VARCHAR(255)", "NOT NULL"),
+                                                               MetaField("field_type", "INT", "DEFAULT 0 NOT NULL"),
+                                                               MetaField("row_count", "BIGINT", "DEFAULT 0 NOT NULL"),
+                                                               MetaField("min_value", "VARCHAR(64)", "NOT NULL"),
+                                                               MetaField("max_value", "VARCHAR(64)", "NOT NULL"),
+                                                           });
+
 }  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-MySQLMetaImpl::MySQLMetaImpl(const DBMetaOptions& options, const int& mode) : options_(options), mode_(mode) {
+MySQLMetaImpl::MySQLMetaImpl(const DBMetaOptions& options, const int& mode)
+    : options_(options),
+      file_gc_(std::make_shared<FileGC>(options.gc_thread_num_, options.gc_unlink_rate_)),
+      mode_(mode) {
     Initialize();
 }
 
@@ -426,6 +441,19 @@ MySQLMetaImpl::Initialize() {
         throw Exception(DB_META_TRANSACTION_FAILED, msg);
     }
 
+    // step 11: create meta table FieldStats
+    InitializeQuery << "CREATE TABLE IF NOT EXISTS " << FIELDSTATS_SCHEMA.name() << " ("
+                    << FIELDSTATS_SCHEMA.ToString() + ", INDEX (segment_id));";
+
+    LOG_ENGINE_DEBUG_ << "Initialize: " << InitializeQuery.str();
+
+    initialize_query_exec = InitializeQuery.exec();
+    if (!initialize_query_exec) {
+        std::string msg = "Failed to create meta table 'FieldStats' in MySQL";
+        LOG_ENGINE_ERROR_ << msg;
+        throw Exception(DB_META_TRANSACTION_FAILED, msg);
+    }
+
     return Status::OK();
 }
 
@@ -676,7 +704,7 @@ MySQLMetaImpl::DropCollections(const std::vector<std::string>& collection_id_arr
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
             // soft delete collection
             mysqlpp::Query statement = connectionPtr->query();
@@ -728,7 +756,7 @@ MySQLMetaImpl::DeleteCollectionFiles(const std::vector<std::string>& collection_
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
             // soft delete collection files
             mysqlpp::Query statement = connectionPtr->query();
@@ -811,7 +839,7 @@ MySQLMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
 
@@ -865,7 +893,7 @@ MySQLMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::v
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement
@@ -924,7 +952,7 @@ MySQLMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, File
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, engine_type, file_id, file_type, file_size, "
@@ -1144,7 +1172,7 @@ MySQLMetaImpl::UpdateCollectionFile(SegmentSchema& file_schema) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
 
@@ -1213,7 +1241,7 @@ MySQLMetaImpl::UpdateCollectionFilesToIndex(const std::string& collection_id) {
         }
 
         // to ensure UpdateCollectionFiles to be a atomic operation
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
         mysqlpp::Query statement = connectionPtr->query();
 
@@ -1251,7 +1279,7 @@ MySQLMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
 
@@ -1276,6 +1304,8 @@ MySQLMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
                 has_collections[file_schema.collection_id_] = (check == 1);
             }
 
+            // all or none of the files are updated, and the server syncs its log once
+            mysqlpp::Transaction trans(*connectionPtr);
             for (auto& file_schema : files) {
                 if (!has_collections[file_schema.collection_id_]) {
                     file_schema.file_type_ = SegmentSchema::TO_DELETE;
@@ -1305,6 +1335,7 @@ MySQLMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
                     return HandleException("Failed to update collection files", statement.error());
                 }
             }
+            trans.commit();
         }  // Scoped Connection
 
         LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files";
@@ -1328,10 +1359,11 @@ MySQLMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
 
+            mysqlpp::Transaction trans(*connectionPtr);
             for (auto& file : files) {
                 std::string row_count = std::to_string(file.row_count_);
                 std::string updated_time = std::to_string(utils::GetMicroSecTimeStamp());
@@ -1347,6 +1379,7 @@ MySQLMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
 
                 LOG_ENGINE_DEBUG_ << "Update file " << file.file_id_ << " row count to " << file.row_count_;
             }
+            trans.commit();
         }  // Scoped Connection
 
         LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files";
@@ -1357,6 +1390,85 @@ MySQLMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
     return Status::OK();
 }
 
+Status
+MySQLMetaImpl::UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                                uint64_t flush_lsn) {
+    try {
+        server::MetricCollector metric;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            if (connectionPtr == nullptr) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            // to ensure UpdateCollectionFiles to be a atomic operation
+            std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
+
+            mysqlpp::Query statement = connectionPtr->query();
+
+            std::map<std::string, bool> has_collections;
+            for (auto& file_schema : files) {
+                if (has_collections.find(file_schema.collection_id_) != has_collections.end()) {
+                    continue;
+                }
+
+                statement << "SELECT EXISTS"
+                          << " (SELECT 1 FROM " << META_TABLES << " WHERE table_id = " << mysqlpp::quote
+                          << file_schema.collection_id_ << " AND state <> "
+                          << std::to_string(CollectionSchema::TO_DELETE) << ")"
+                          << " AS " << mysqlpp::quote << "check"
+                          << ";";
+
+                LOG_ENGINE_DEBUG_ << "UpdateCollectionFilesAndFlushLSN: " << statement.str();
+
+                mysqlpp::StoreQueryResult res = statement.store();
+
+                int check = res[0]["check"];
+                has_collections[file_schema.collection_id_] = (check == 1);
+            }
+
+            mysqlpp::Transaction trans(*connectionPtr);
+            for (auto& file_schema : files) {
+                if (!has_collections[file_schema.collection_id_]) {
+                    file_schema.file_type_ = SegmentSchema::TO_DELETE;
+                }
+                file_schema.updated_time_ = utils::GetMicroSecTimeStamp();
+
+                statement << "UPDATE " << META_TABLEFILES << " SET file_type = " << file_schema.file_type_
+                          << " ,file_size = " << file_schema.file_size_ << " ,row_count = " << file_schema.row_count_
+                          << " ,updated_time = " << file_schema.updated_time_ << " WHERE id = " << file_schema.id_
+                          << ";";
+
+                LOG_ENGINE_DEBUG_ << "UpdateCollectionFilesAndFlushLSN: " << statement.str();
+
+                if (!statement.exec()) {
+                    return HandleException("Failed to update flushed collection files", statement.error());
+                }
+            }
+
+            for (auto& collection_id : collection_ids) {
+                statement << "UPDATE " << META_TABLES << " SET flush_lsn = " << flush_lsn
+                          << " WHERE table_id = " << mysqlpp::quote << collection_id << ";";
+
+                LOG_ENGINE_DEBUG_ << "UpdateCollectionFilesAndFlushLSN: " << statement.str();
+
+                if (!statement.exec()) {
+                    return HandleException("Failed to update collection lsn", statement.error());
+                }
+            }
+            trans.commit();
+        }  // Scoped Connection
+
+        LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files and flush_lsn of "
+                          << collection_ids.size() << " collections to " << flush_lsn;
+    } catch (std::exception& e) {
+        return HandleException("Failed to update flushed collection files", e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 MySQLMetaImpl::DescribeCollectionIndex(const std::string& collection_id, CollectionIndex& index) {
     try {
@@ -1675,7 +1787,7 @@ MySQLMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& file
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
@@ -1776,7 +1888,7 @@ MySQLMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::se
                 }
 
                 // to ensure UpdateCollectionFiles to be a atomic operation
-                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+                std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
                 mysqlpp::Query statement = connectionPtr->query();
                 statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
@@ -1867,7 +1979,7 @@ MySQLMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& files
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
@@ -1944,7 +2056,7 @@ MySQLMetaImpl::FilesToIndex(FilesHolder& files_holder) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
@@ -2036,7 +2148,7 @@ MySQLMetaImpl::FilesByType(const std::string& collection_id, const std::vector<i
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             // since collection_id is a unique column we just need to check whether it exists or not
@@ -2199,7 +2311,7 @@ MySQLMetaImpl::FilesByTypeEx(const std::vector<meta::CollectionSchema>& collecti
                 }
 
                 // to ensure UpdateCollectionFiles to be a atomic operation
-                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+                std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
                 mysqlpp::Query statement = connectionPtr->query();
                 // since collection_id is a unique column we just need to check whether it exists or not
@@ -2331,7 +2443,7 @@ MySQLMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hold
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
@@ -2410,6 +2522,74 @@ MySQLMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hold
     }
 }
 
+Status
+MySQLMetaImpl::FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) {
+    try {
+        server::MetricCollector metric;
+        mysqlpp::StoreQueryResult res;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.FilesUpdatedSince.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.FilesUpdatedSince.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query statement = connectionPtr->query();
+            statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date,"
+                      << " engine_type, created_on, updated_time"
+                      << " FROM " << META_TABLEFILES << " WHERE updated_time >= " << updated_time << ";";
+
+            LOG_ENGINE_DEBUG_ << "FilesUpdatedSince: " << statement.str();
+
+            res = statement.store();
+        }  // Scoped Connection
+
+        std::map<std::string, meta::CollectionSchema> collections;
+        Status ret;
+        for (auto& resRow : res) {
+            SegmentSchema collection_file;
+            collection_file.id_ = resRow["id"];  // implicit conversion
+            resRow["table_id"].to_string(collection_file.collection_id_);
+            resRow["segment_id"].to_string(collection_file.segment_id_);
+            resRow["file_id"].to_string(collection_file.file_id_);
+            collection_file.file_type_ = resRow["file_type"];
+            collection_file.file_size_ = resRow["file_size"];
+            collection_file.row_count_ = resRow["row_count"];
+            collection_file.date_ = resRow["date"];
+            collection_file.engine_type_ = resRow["engine_type"];
+            collection_file.created_on_ = resRow["created_on"];
+            collection_file.updated_time_ = resRow["updated_time"];
+
+            // the collection of a file being dropped may be gone already, the file is returned as it is
+            auto iter = collections.find(collection_file.collection_id_);
+            if (iter == collections.end()) {
+                CollectionSchema collection_schema;
+                collection_schema.collection_id_ = collection_file.collection_id_;
+                DescribeCollection(collection_schema);
+                iter = collections.insert(std::make_pair(collection_file.collection_id_, collection_schema)).first;
+            }
+            collection_file.dimension_ = iter->second.dimension_;
+            collection_file.index_file_size_ = iter->second.index_file_size_;
+            collection_file.index_params_ = iter->second.index_params_;
+            collection_file.metric_type_ = iter->second.metric_type_;
+
+            auto status = utils::GetCollectionFilePath(options_, collection_file);
+            if (!status.ok()) {
+                ret = status;
+            }
+            files.emplace_back(collection_file);
+        }
+
+        LOG_ENGINE_DEBUG_ << "Collect " << files.size() << " files updated since " << updated_time;
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("Failed to get updated files", e.what());
+    }
+}
+
 // TODO(myh): Support swap to cloud storage
 Status
 MySQLMetaImpl::Archive() {
@@ -2483,7 +2663,7 @@ MySQLMetaImpl::Size(uint64_t& result) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT IFNULL(SUM(file_size),0) AS sum"
@@ -2577,7 +2757,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/)
             mysqlpp::StoreQueryResult res;
             {
                 // to ensure UpdateCollectionFiles to be a atomic operation
-                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+                std::lock_guard<std::shared_mutex> meta_lock(meta_mutex_);
 
                 statement << "SELECT id, table_id, segment_id, engine_type, file_id, file_type, date"
                           << " FROM " << META_TABLEFILES << " WHERE file_type IN ("
@@ -2592,6 +2772,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/)
 
             SegmentSchema collection_file;
             std::vector<std::string> delete_ids;
+            std::vector<std::string> file_paths;
 
             int64_t clean_files = 0;
             for (auto& resRow : res) {
@@ -2616,8 +2797,8 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/)
                 utils::EraseFromCache(collection_file.location_);
 
                 if (collection_file.file_type_ == (int)SegmentSchema::TO_DELETE) {
-                    // delete file from disk storage
-                    utils::DeleteCollectionFilePath(options_, collection_file);
+                    // delete file from disk storage, with the other files of the round
+                    file_paths.push_back(collection_file.location_);
                     LOG_ENGINE_DEBUG_ << "Remove file id:" << collection_file.id_
                                       << " location:" << collection_file.location_;
 
@@ -2646,6 +2827,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/)
                     return HandleException("Failed to clean up with ttl", statement.error());
                 }
             }
+            file_gc_->Remove(file_paths);
 
             if (clean_files > 0) {
                 LOG_ENGINE_DEBUG_ << "Clean " << clean_files << " files expired in " << seconds << " seconds";
@@ -2768,7 +2950,7 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/)
                 return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
             }
 
-            int64_t remove_segments = 0;
+            std::vector<std::string> segment_dirs;
             for (auto& segment_id : segment_ids) {
                 mysqlpp::Query statement = connectionPtr->query();
                 statement << "SELECT id"
@@ -2780,13 +2962,20 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/)
                 mysqlpp::StoreQueryResult res = statement.store();
 
                 if (res.empty()) {
-                    utils::DeleteSegment(options_, segment_id.second);
+                    mysqlpp::Query stats_statement = connectionPtr->query();
+                    stats_statement << "DELETE FROM " << META_FIELDSTATS << " WHERE segment_id = " << mysqlpp::quote
+                                    << segment_id.first << ";";
+                    if (!stats_statement.exec()) {
+                        LOG_ENGINE_WARNING_ << "Failed to remove field stats of segment " << segment_id.first;
+                    }
                     std::string segment_dir;
-                    utils::GetParentPath(segment_id.second.location_, segment_dir);
+                    utils::EraseSegmentFromCache(options_, segment_id.second, segment_dir);
                     LOG_ENGINE_DEBUG_ << "Remove segment directory: " << segment_dir;
-                    ++remove_segments;
+                    segment_dirs.emplace_back(segment_dir);
                 }
             }
+            file_gc_->Remove(segment_dirs);
+            int64_t remove_segments = segment_dirs.size();
 
             if (remove_segments > 0) {
                 LOG_ENGINE_DEBUG_ << "Remove " << remove_segments << " segments folder";
@@ -2824,7 +3013,7 @@ MySQLMetaImpl::Count(const std::string& collection_id, uint64_t& result) {
             }
 
             // to ensure UpdateCollectionFiles to be a atomic operation
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            std::shared_lock<std::shared_mutex> meta_lock(meta_mutex_);
 
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT row_count"
@@ -2865,7 +3054,8 @@ MySQLMetaImpl::DropAll() {
 
         mysqlpp::Query statement = connectionPtr->query();
         statement << "DROP TABLE IF EXISTS " << TABLES_SCHEMA.name() << ", " << TABLEFILES_SCHEMA.name() << ", "
-                  << ENVIRONMENT_SCHEMA.name() << ", " << FIELDS_SCHEMA.name() << ";";
+                  << ENVIRONMENT_SCHEMA.name() << ", " << FIELDS_SCHEMA.name() << ", " << FIELDSTATS_SCHEMA.name()
+                  << ";";
 
         LOG_ENGINE_DEBUG_ << "DropAll: " << statement.str();
 
@@ -3202,6 +3392,113 @@ MySQLMetaImpl::DescribeHybridCollection(CollectionSchema& collection_schema, hyb
     return Status::OK();
 }
 
+Status
+MySQLMetaImpl::UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) {
+    if (fields_stats.empty()) {
+        return Status::OK();
+    }
+
+    try {
+        server::MetricCollector metric;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.UpdateFieldsStats.null_connection", is_null_connection = true);
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            std::set<std::string> segment_ids;
+            for (auto& stats : fields_stats) {
+                segment_ids.insert(stats.segment_id_);
+            }
+
+            // the stats of a segment are replaced as a whole
+            mysqlpp::Transaction trans(*connectionPtr);
+            mysqlpp::Query statement = connectionPtr->query();
+            for (auto& segment_id : segment_ids) {
+                statement << "DELETE FROM " << META_FIELDSTATS << " WHERE segment_id = " << mysqlpp::quote
+                          << segment_id << ";";
+
+                LOG_ENGINE_DEBUG_ << "UpdateFieldsStats: " << statement.str();
+
+                if (!statement.exec()) {
+                    return HandleException("Failed to update fields stats", statement.error());
+                }
+            }
+            for (auto& stats : fields_stats) {
+                statement << "INSERT INTO " << META_FIELDSTATS << " VALUES(" << mysqlpp::quote << stats.collection_id_
+                          << ", " << mysqlpp::quote << stats.segment_id_ << ", " << mysqlpp::quote
+                          << stats.field_name_ << ", " << stats.field_type_ << ", " << stats.row_count_ << ", "
+                          << mysqlpp::quote << stats.min_value_ << ", " << mysqlpp::quote << stats.max_value_
+                          << ");";
+
+                LOG_ENGINE_DEBUG_ << "UpdateFieldsStats: " << statement.str();
+
+                if (!statement.exec()) {
+                    return HandleException("Failed to update fields stats", statement.error());
+                }
+            }
+            trans.commit();
+        }  // Scoped Connection
+    } catch (std::exception& e) {
+        return HandleException("Failed to update fields stats", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+MySQLMetaImpl::GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) {
+    fields_stats.clear();
+    if (segment_ids.empty()) {
+        return Status::OK();
+    }
+
+    try {
+        server::MetricCollector metric;
+        mysqlpp::StoreQueryResult res;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.GetFieldsStats.null_connection", is_null_connection = true);
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query statement = connectionPtr->query();
+            statement << "SELECT table_id, segment_id, field_name, field_type, row_count, min_value, max_value"
+                      << " FROM " << META_FIELDSTATS << " WHERE segment_id IN (";
+            for (size_t i = 0; i < segment_ids.size(); ++i) {
+                statement << (i == 0 ? "" : ", ") << mysqlpp::quote << segment_ids[i];
+            }
+            statement << ");";
+
+            LOG_ENGINE_DEBUG_ << "GetFieldsStats: " << statement.str();
+
+            res = statement.store();
+        }  // Scoped Connection
+
+        fields_stats.resize(res.num_rows());
+        for (size_t i = 0; i < res.num_rows(); ++i) {
+            const mysqlpp::Row& resRow = res[i];
+            resRow["table_id"].to_string(fields_stats[i].collection_id_);
+            resRow["segment_id"].to_string(fields_stats[i].segment_id_);
+            resRow["field_name"].to_string(fields_stats[i].field_name_);
+            fields_stats[i].field_type_ = resRow["field_type"];
+            fields_stats[i].row_count_ = resRow["row_count"];
+            resRow["min_value"].to_string(fields_stats[i].min_value_);
+            resRow["max_value"].to_string(fields_stats[i].max_value_);
+        }
+    } catch (std::exception& e) {
+        return HandleException("Failed to get fields stats", e.what());
+    }
+
+    return Status::OK();
+}
+
 }  // namespace meta
 }  // namespace engine
 }  // namespace milvus
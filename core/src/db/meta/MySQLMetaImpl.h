@@ -16,11 +16,13 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
 #include "Meta.h"
 #include "MySQLConnectionPool.h"
+#include "db/FileGC.h"
 #include "db/Options.h"
 
 namespace milvus {
@@ -84,6 +86,10 @@ class MySQLMetaImpl : public Meta {
     Status
     UpdateCollectionFilesRowCount(SegmentsSchema& files) override;
 
+    Status
+    UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                     uint64_t flush_lsn) override;
+
     Status
     DescribeCollectionIndex(const std::string& collection_id, CollectionIndex& index) override;
 
@@ -131,6 +137,9 @@ class MySQLMetaImpl : public Meta {
     Status
     FilesByID(const std::vector<size_t>& ids, FilesHolder& files_holder) override;
 
+    Status
+    FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) override;
+
     Status
     Archive() override;
 
@@ -161,6 +170,12 @@ class MySQLMetaImpl : public Meta {
     Status
     DescribeHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) override;
 
+    Status
+    UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) override;
+
+    Status
+    GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) override;
+
  private:
     Status
     NextFileId(std::string& file_id);
@@ -176,12 +191,13 @@ class MySQLMetaImpl : public Meta {
 
  private:
     const DBMetaOptions options_;
+    FileGCPtr file_gc_;
     const int mode_;
 
     std::shared_ptr<MySQLConnectionPool> mysql_connection_pool_;
     bool safe_grab_ = false;  // Safely graps a connection from mysql pool
 
-    std::mutex meta_mutex_;
+    std::shared_mutex meta_mutex_;  // the selects share it, each on its own connection
     std::mutex genid_mutex_;
     //        std::mutex connectionMutex_;
 };  // DBMetaImpl
@@ -47,6 +47,9 @@ namespace {
 
 constexpr uint64_t SQL_BATCH_SIZE = 50;
 
+// wait for the lock of another process on the database rather than failing at once
+constexpr int SQLITE_BUSY_TIMEOUT_MS = 5000;
+
 template <typename T>
 void
 DistributeBatch(const T& id_array, std::vector<std::vector<std::string>>& id_groups) {
@@ -112,13 +115,21 @@ StoragePrototype(const std::string& path) {
                    make_column("row_count", &SegmentSchema::row_count_, default_value(0)),
                    make_column("updated_time", &SegmentSchema::updated_time_),
                    make_column("created_on", &SegmentSchema::created_on_), make_column("date", &SegmentSchema::date_),
-                   make_column("flush_lsn", &SegmentSchema::flush_lsn_)));
+                   make_column("flush_lsn", &SegmentSchema::flush_lsn_)),
+        make_table(META_FIELDSTATS, make_column("table_id", &hybrid::FieldStatsSchema::collection_id_),
+                   make_column("segment_id", &hybrid::FieldStatsSchema::segment_id_),
+                   make_column("field_name", &hybrid::FieldStatsSchema::field_name_),
+                   make_column("field_type", &hybrid::FieldStatsSchema::field_type_),
+                   make_column("row_count", &hybrid::FieldStatsSchema::row_count_, default_value(0)),
+                   make_column("min_value", &hybrid::FieldStatsSchema::min_value_),
+                   make_column("max_value", &hybrid::FieldStatsSchema::max_value_)));
 }
 
 using ConnectorT = decltype(StoragePrototype("table"));
 static std::unique_ptr<ConnectorT> ConnectorPtr;
 
-SqliteMetaImpl::SqliteMetaImpl(const DBMetaOptions& options) : options_(options) {
+SqliteMetaImpl::SqliteMetaImpl(const DBMetaOptions& options)
+    : options_(options), file_gc_(std::make_shared<FileGC>(options.gc_thread_num_, options.gc_unlink_rate_)) {
     Initialize();
 }
 
@@ -188,6 +199,10 @@ SqliteMetaImpl::Initialize() {
     ConnectorPtr->sync_schema();
     ConnectorPtr->open_forever();                          // thread safe option
     ConnectorPtr->pragma.journal_mode(journal_mode::WAL);  // WAL => write ahead log
+    // NORMAL only syncs the log at the checkpoints: a commit may be lost by a power failure but the database is never
+    // corrupted
+    ConnectorPtr->pragma.synchronous(1);
+    ConnectorPtr->busy_timeout(SQLITE_BUSY_TIMEOUT_MS);
 
     CleanUpShadowFiles();
 
@@ -382,11 +397,20 @@ SqliteMetaImpl::DropCollections(const std::vector<std::string>& collection_id_ar
             // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
             std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
-            for (auto group : id_groups) {
-                // soft delete collection
-                ConnectorPtr->update_all(set(c(&CollectionSchema::state_) = (int)CollectionSchema::TO_DELETE),
-                                         where(in(&CollectionSchema::collection_id_, group) and
-                                               c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+            // the batches are committed once
+            auto commited = ConnectorPtr->transaction([&]() mutable {
+                for (auto& group : id_groups) {
+                    // soft delete collection
+                    ConnectorPtr->update_all(
+                        set(c(&CollectionSchema::state_) = (int)CollectionSchema::TO_DELETE),
+                        where(in(&CollectionSchema::collection_id_, group) and
+                              c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+                }
+                return true;
+            });
+
+            if (!commited) {
+                return HandleException("DropCollections error: sqlite transaction failed");
             }
         }
 
@@ -414,12 +438,19 @@ SqliteMetaImpl::DeleteCollectionFiles(const std::vector<std::string>& collection
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
-        for (auto group : id_groups) {
-            // soft delete collection files
-            ConnectorPtr->update_all(set(c(&SegmentSchema::file_type_) = (int)SegmentSchema::TO_DELETE,
-                                         c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
-                                     where(in(&SegmentSchema::collection_id_, group) and
-                                           c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
+        auto commited = ConnectorPtr->transaction([&]() mutable {
+            for (auto& group : id_groups) {
+                // soft delete collection files
+                ConnectorPtr->update_all(set(c(&SegmentSchema::file_type_) = (int)SegmentSchema::TO_DELETE,
+                                             c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
+                                         where(in(&SegmentSchema::collection_id_, group) and
+                                               c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
+            }
+            return true;
+        });
+
+        if (!commited) {
+            return HandleException("DeleteCollectionFiles error: sqlite transaction failed");
         }
 
         LOG_ENGINE_DEBUG_ << "Successfully delete collection files";
@@ -739,11 +770,18 @@ SqliteMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
-        for (auto& file : files) {
-            ConnectorPtr->update_all(set(c(&SegmentSchema::row_count_) = file.row_count_,
-                                         c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
-                                     where(c(&SegmentSchema::file_id_) == file.file_id_));
-            LOG_ENGINE_DEBUG_ << "Update file " << file.file_id_ << " row count to " << file.row_count_;
+        auto commited = ConnectorPtr->transaction([&]() mutable {
+            for (auto& file : files) {
+                ConnectorPtr->update_all(set(c(&SegmentSchema::row_count_) = file.row_count_,
+                                             c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
+                                         where(c(&SegmentSchema::file_id_) == file.file_id_));
+                LOG_ENGINE_DEBUG_ << "Update file " << file.file_id_ << " row count to " << file.row_count_;
+            }
+            return true;
+        });
+
+        if (!commited) {
+            return HandleException("UpdateCollectionFilesRowCount error: sqlite transaction failed");
         }
     } catch (std::exception& e) {
         return HandleException("Encounter exception when update collection files row count", e.what());
@@ -751,6 +789,56 @@ SqliteMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                                 uint64_t flush_lsn) {
+    try {
+        server::MetricCollector metric;
+
+        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        std::map<std::string, bool> has_collections;
+        for (auto& file : files) {
+            if (has_collections.find(file.collection_id_) != has_collections.end()) {
+                continue;
+            }
+            auto collections =
+                ConnectorPtr->select(columns(&CollectionSchema::id_),
+                                     where(c(&CollectionSchema::collection_id_) == file.collection_id_ and
+                                           c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+            has_collections[file.collection_id_] = (collections.size() >= 1);
+        }
+
+        // one transaction means one journal sync for the whole flush
+        auto commited = ConnectorPtr->transaction([&]() mutable {
+            for (auto& file : files) {
+                if (!has_collections[file.collection_id_]) {
+                    file.file_type_ = SegmentSchema::TO_DELETE;
+                }
+
+                file.updated_time_ = utils::GetMicroSecTimeStamp();
+                ConnectorPtr->update(file);
+            }
+            for (auto& collection_id : collection_ids) {
+                ConnectorPtr->update_all(set(c(&CollectionSchema::flush_lsn_) = flush_lsn),
+                                         where(c(&CollectionSchema::collection_id_) == collection_id));
+            }
+            return true;
+        });
+
+        if (!commited) {
+            return HandleException("UpdateCollectionFilesAndFlushLSN error: sqlite transaction failed");
+        }
+
+        LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files and flush_lsn of "
+                          << collection_ids.size() << " collections to " << flush_lsn;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when update flushed collection files", e.what());
+    }
+    return Status::OK();
+}
+
 Status
 SqliteMetaImpl::UpdateCollectionIndex(const std::string& collection_id, const CollectionIndex& index) {
     try {
@@ -1714,6 +1802,69 @@ SqliteMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hol
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) {
+    try {
+        server::MetricCollector metric;
+        fiu_do_on("SqliteMetaImpl.FilesUpdatedSince.throw_exception", throw std::exception());
+
+        auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
+                                      &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
+                                      &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::engine_type_,
+                                      &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
+
+        // perform query
+        decltype(ConnectorPtr->select(select_columns)) selected;
+        auto filter = where(c(&SegmentSchema::updated_time_) >= updated_time);
+        {
+            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            selected = ConnectorPtr->select(select_columns, filter);
+        }
+
+        std::map<std::string, meta::CollectionSchema> collections;
+        Status ret;
+        for (auto& file : selected) {
+            SegmentSchema collection_file;
+            collection_file.id_ = std::get<0>(file);
+            collection_file.collection_id_ = std::get<1>(file);
+            collection_file.segment_id_ = std::get<2>(file);
+            collection_file.file_id_ = std::get<3>(file);
+            collection_file.file_type_ = std::get<4>(file);
+            collection_file.file_size_ = std::get<5>(file);
+            collection_file.row_count_ = std::get<6>(file);
+            collection_file.date_ = std::get<7>(file);
+            collection_file.engine_type_ = std::get<8>(file);
+            collection_file.created_on_ = std::get<9>(file);
+            collection_file.updated_time_ = std::get<10>(file);
+
+            // the collection of a file being dropped may be gone already, the file is returned as it is
+            auto iter = collections.find(collection_file.collection_id_);
+            if (iter == collections.end()) {
+                CollectionSchema collection_schema;
+                collection_schema.collection_id_ = collection_file.collection_id_;
+                DescribeCollection(collection_schema);
+                iter = collections.insert(std::make_pair(collection_file.collection_id_, collection_schema)).first;
+            }
+            collection_file.dimension_ = iter->second.dimension_;
+            collection_file.index_file_size_ = iter->second.index_file_size_;
+            collection_file.index_params_ = iter->second.index_params_;
+            collection_file.metric_type_ = iter->second.metric_type_;
+
+            auto status = utils::GetCollectionFilePath(options_, collection_file);
+            if (!status.ok()) {
+                ret = status;
+            }
+            files.emplace_back(collection_file);
+        }
+
+        LOG_ENGINE_DEBUG_ << "Collect " << files.size() << " files updated since " << updated_time;
+        return ret;
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when get updated files", e.what());
+    }
+}
+
 // TODO(myh): Support swap to cloud storage
 Status
 SqliteMetaImpl::Archive() {
@@ -1824,6 +1975,7 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
     // remove to_delete files
     try {
         fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveFile_ThrowException", throw std::exception());
+        std::vector<std::string> file_paths;
 
         server::MetricCollector metric;
 
@@ -1833,7 +1985,7 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
         };
 
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        std::unique_lock<std::mutex> meta_lock(meta_mutex_);
 
         // collect files to be deleted
         auto files =
@@ -1869,11 +2021,9 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
                 utils::EraseFromCache(collection_file.location_);
 
                 if (collection_file.file_type_ == (int)SegmentSchema::TO_DELETE) {
-                    // delete file from meta
+                    // delete file from meta, from disk storage once the meta lock is released
                     ConnectorPtr->remove<SegmentSchema>(collection_file.id_);
-
-                    // delete file from disk storage
-                    utils::DeleteCollectionFilePath(options_, collection_file);
+                    file_paths.push_back(collection_file.location_);
 
                     LOG_ENGINE_DEBUG_ << "Remove file id:" << collection_file.file_id_
                                       << " location:" << collection_file.location_;
@@ -1890,6 +2040,8 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
         if (!commited) {
             return HandleException("CleanUpFilesWithTTL error: sqlite transaction failed");
         }
+        meta_lock.unlock();
+        file_gc_->Remove(file_paths);
 
         if (clean_files > 0) {
             LOG_ENGINE_DEBUG_ << "Clean " << clean_files << " files expired in " << seconds << " seconds";
@@ -1960,18 +2112,21 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
         fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveSegmentFolder_ThrowException", throw std::exception());
         server::MetricCollector metric;
 
-        int64_t remove_segments = 0;
+        std::vector<std::string> segment_dirs;
         for (auto& segment_id : segment_ids) {
             auto selected = ConnectorPtr->select(columns(&SegmentSchema::id_),
                                                  where(c(&SegmentSchema::segment_id_) == segment_id.first));
             if (selected.size() == 0) {
-                utils::DeleteSegment(options_, segment_id.second);
+                ConnectorPtr->remove_all<hybrid::FieldStatsSchema>(
+                    where(c(&hybrid::FieldStatsSchema::segment_id_) == segment_id.first));
                 std::string segment_dir;
-                utils::GetParentPath(segment_id.second.location_, segment_dir);
+                utils::EraseSegmentFromCache(options_, segment_id.second, segment_dir);
                 LOG_ENGINE_DEBUG_ << "Remove segment directory: " << segment_dir;
-                ++remove_segments;
+                segment_dirs.emplace_back(segment_dir);
             }
         }
+        file_gc_->Remove(segment_dirs);
+        int64_t remove_segments = segment_dirs.size();
 
         if (remove_segments > 0) {
             LOG_ENGINE_DEBUG_ << "Remove " << remove_segments << " segments folder";
@@ -2028,6 +2183,7 @@ SqliteMetaImpl::DropAll() {
         ConnectorPtr->drop_table(META_TABLEFILES);
         ConnectorPtr->drop_table(META_ENVIRONMENT);
         ConnectorPtr->drop_table(META_FIELDS);
+        ConnectorPtr->drop_table(META_FIELDSTATS);
     } catch (std::exception& e) {
         return HandleException("Encounter exception when drop all meta", e.what());
     }
@@ -2258,6 +2414,76 @@ SqliteMetaImpl::DescribeHybridCollection(milvus::engine::meta::CollectionSchema&
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) {
+    if (fields_stats.empty()) {
+        return Status::OK();
+    }
+
+    try {
+        server::MetricCollector metric;
+
+        std::vector<std::string> segment_ids;
+        for (auto& stats : fields_stats) {
+            segment_ids.push_back(stats.segment_id_);
+        }
+
+        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        auto commited = ConnectorPtr->transaction([&]() mutable {
+            ConnectorPtr->remove_all<hybrid::FieldStatsSchema>(
+                where(in(&hybrid::FieldStatsSchema::segment_id_, segment_ids)));
+            for (auto& stats : fields_stats) {
+                ConnectorPtr->insert(stats);
+            }
+            return true;
+        });
+
+        if (!commited) {
+            return HandleException("UpdateFieldsStats error: sqlite transaction failed");
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when update fields stats", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+SqliteMetaImpl::GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) {
+    fields_stats.clear();
+    if (segment_ids.empty()) {
+        return Status::OK();
+    }
+
+    try {
+        server::MetricCollector metric;
+
+        auto selected = ConnectorPtr->select(
+            columns(&hybrid::FieldStatsSchema::collection_id_, &hybrid::FieldStatsSchema::segment_id_,
+                    &hybrid::FieldStatsSchema::field_name_, &hybrid::FieldStatsSchema::field_type_,
+                    &hybrid::FieldStatsSchema::row_count_, &hybrid::FieldStatsSchema::min_value_,
+                    &hybrid::FieldStatsSchema::max_value_),
+            where(in(&hybrid::FieldStatsSchema::segment_id_, segment_ids)));
+
+        fields_stats.resize(selected.size());
+        for (size_t i = 0; i < selected.size(); ++i) {
+            fields_stats[i].collection_id_ = std::get<0>(selected[i]);
+            fields_stats[i].segment_id_ = std::get<1>(selected[i]);
+            fields_stats[i].field_name_ = std::get<2>(selected[i]);
+            fields_stats[i].field_type_ = std::get<3>(selected[i]);
+            fields_stats[i].row_count_ = std::get<4>(selected[i]);
+            fields_stats[i].min_value_ = std::get<5>(selected[i]);
+            fields_stats[i].max_value_ = std::get<6>(selected[i]);
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when get fields stats", e.what());
+    }
+
+    return Status::OK();
+}
+
 }  // namespace meta
 }  // namespace engine
 }  // namespace milvus
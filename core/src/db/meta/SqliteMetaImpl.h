@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "Meta.h"
+#include "db/FileGC.h"
 #include "db/Options.h"
 
 namespace milvus {
@@ -86,6 +87,10 @@ class SqliteMetaImpl : public Meta {
     Status
     UpdateCollectionFilesRowCount(SegmentsSchema& files) override;
 
+    Status
+    UpdateCollectionFilesAndFlushLSN(SegmentsSchema& files, const std::set<std::string>& collection_ids,
+                                     uint64_t flush_lsn) override;
+
     Status
     DescribeCollectionIndex(const std::string& collection_id, CollectionIndex& index) override;
 
@@ -133,6 +138,9 @@ class SqliteMetaImpl : public Meta {
     Status
     FilesByID(const std::vector<size_t>& ids, FilesHolder& files_holder) override;
 
+    Status
+    FilesUpdatedSince(int64_t updated_time, SegmentsSchema& files) override;
+
     Status
     Size(uint64_t& result) override;
 
@@ -163,6 +171,12 @@ class SqliteMetaImpl : public Meta {
     Status
     DescribeHybridCollection(CollectionSchema& collection_schema, hybrid::FieldsSchema& fields_schema) override;
 
+    Status
+    UpdateFieldsStats(const hybrid::FieldsStatsSchema& fields_stats) override;
+
+    Status
+    GetFieldsStats(const std::vector<std::string>& segment_ids, hybrid::FieldsStatsSchema& fields_stats) override;
+
  private:
     Status
     NextFileId(std::string& file_id);
@@ -178,7 +192,8 @@ class SqliteMetaImpl : public Meta {
 
  private:
     const DBMetaOptions options_;
-    std::mutex meta_mutex_;
+    FileGCPtr file_gc_;
+    std::mutex meta_mutex_;  // every statement holds it, the threads share one connection
     std::mutex genid_mutex_;
 };  // DBMetaImpl
 
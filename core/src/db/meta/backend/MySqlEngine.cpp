@@ -342,8 +342,8 @@ MySqlEngine::Query(const MetaQueryContext& context, AttrsMapList& attrs) {
             return status;
         }
 
-        std::lock_guard<std::mutex> lock(meta_mutex_);
-
+        // each query runs on a connection of its own and sees the committed transactions only, so the queries are
+        // not serialized by meta_mutex_
         mysqlpp::Query query = connectionPtr->query(sql);
         auto res = query.store();
         if (!res) {
@@ -51,7 +51,7 @@ class MySqlEngine : public MetaEngine {
     std::shared_ptr<meta::MySQLConnectionPool> mysql_connection_pool_;
     bool safe_grab_ = false;  // Safely graps a connection from mysql pool
 
-    std::mutex meta_mutex_;
+    std::mutex meta_mutex_;  // serializes the transactions
 };
 
 }  // namespace milvus::engine::meta
@@ -510,6 +510,183 @@ MergeOperation::DoExecute(StorePtr store) {
     return Status::OK();
 }
 
+BatchSegmentsOperation::BatchSegmentsOperation(const OperationContext& context, ScopedSnapshotT prev_ss)
+    : BaseT(context, prev_ss) {
+}
+
+Status
+BatchSegmentsOperation::CommitNewSegment(ID_TYPE partition_id, SegmentPtr& created) {
+    OperationContext context;
+    context.prev_partition = GetStartedSS()->GetResource<Partition>(partition_id);
+    if (!context.prev_partition) {
+        std::stringstream emsg;
+        emsg << GetRepr() << ". Partition " << partition_id << " not found";
+        return Status(SS_NOT_FOUND_ERROR, emsg.str());
+    }
+
+    auto op = std::make_shared<SegmentOperation>(context, GetStartedSS());
+    STATUS_CHECK(op->Push());
+    STATUS_CHECK(op->GetResource(created));
+    auto s_ctx_p = ResourceContextBuilder<Segment>().SetOp(meta::oUpdate).CreatePtr();
+    AddStepWithLsn(*created, context_.lsn, s_ctx_p);
+    new_segments_[created->GetID()] = created;
+    return Status::OK();
+}
+
+Status
+BatchSegmentsOperation::CommitNewSegmentFile(const SegmentFileContext& context, SegmentFilePtr& created) {
+    auto it = new_segments_.find(context.segment_id);
+    if (it == new_segments_.end()) {
+        std::stringstream emsg;
+        emsg << GetRepr() << ". Segment " << context.segment_id << " is not a new segment of this operation";
+        return Status(SS_INVALID_CONTEX_ERROR, emsg.str());
+    }
+
+    auto ctx = context;
+    ctx.partition_id = it->second->GetPartitionId();
+    ctx.collection_id = GetStartedSS()->GetCollectionId();
+    auto new_sf_op = std::make_shared<SegmentFileOperation>(ctx, GetStartedSS());
+    STATUS_CHECK(new_sf_op->Push());
+    STATUS_CHECK(new_sf_op->GetResource(created));
+    auto sf_ctx_p = ResourceContextBuilder<SegmentFile>().SetOp(meta::oUpdate).CreatePtr();
+    AddStepWithLsn(*created, context_.lsn, sf_ctx_p);
+    context_.new_segment_files.push_back(created);
+    return Status::OK();
+}
+
+Status
+BatchSegmentsOperation::CommitRowCount(ID_TYPE segment_id, SIZE_TYPE row_cnt) {
+    if (new_segments_.find(segment_id) == new_segments_.end()) {
+        std::stringstream emsg;
+        emsg << GetRepr() << ". Segment " << segment_id << " is not a new segment of this operation";
+        return Status(SS_INVALID_CONTEX_ERROR, emsg.str());
+    }
+    row_cnts_[segment_id] = row_cnt;
+    return Status::OK();
+}
+
+Status
+BatchSegmentsOperation::CommitDropSegment(ID_TYPE segment_id) {
+    auto segment = GetStartedSS()->GetResource<Segment>(segment_id);
+    if (!segment) {
+        std::stringstream emsg;
+        emsg << GetRepr() << ". Segment " << segment_id << " not found";
+        return Status(SS_NOT_FOUND_ERROR, emsg.str());
+    }
+    context_.stale_segments.push_back(segment);
+    return Status::OK();
+}
+
+Status
+BatchSegmentsOperation::OnSnapshotStale() {
+    for (auto& stale_seg : context_.stale_segments) {
+        auto expect_sc = GetStartedSS()->GetSegmentCommitBySegmentId(stale_seg->GetID());
+        auto latest_sc = GetAdjustedSS()->GetSegmentCommitBySegmentId(stale_seg->GetID());
+        if (!latest_sc || (latest_sc->GetID() != expect_sc->GetID())) {
+            std::stringstream emsg;
+            emsg << GetRepr() << ". Stale segment " << stale_seg->GetID() << " in context";
+            return Status(SS_STALE_ERROR, emsg.str());
+        }
+    }
+    return Status::OK();
+}
+
+Status
+BatchSegmentsOperation::DoExecute(StorePtr store) {
+    if (new_segments_.empty() && context_.stale_segments.empty()) {
+        std::stringstream emsg;
+        emsg << GetRepr() << ". No segment to add or drop";
+        return Status(SS_INVALID_CONTEX_ERROR, emsg.str());
+    }
+
+    auto& ss = GetAdjustedSS();
+    std::map<ID_TYPE, SegmentFile::VecT> segment_files;
+    for (auto& new_file : context_.new_segment_files) {
+        auto update_ctx = ResourceContextBuilder<SegmentFile>().SetOp(meta::oUpdate).CreatePtr();
+        update_ctx->AddAttr(SizeField::Name);
+        AddStepWithLsn(*new_file, context_.lsn, update_ctx);
+        segment_files[new_file->GetSegmentId()].push_back(new_file);
+    }
+
+    SegmentCommit::VecT segment_commits;
+    for (auto& kv : new_segments_) {
+        auto& segment = kv.second;
+        auto sc = std::make_shared<SegmentCommit>(ss->GetLatestSchemaCommitId(), segment->GetPartitionId(),
+                                                  segment->GetID());
+        SIZE_TYPE size = 0;
+        for (auto& file : segment_files[segment->GetID()]) {
+            sc->GetMappings().insert(file->GetID());
+            size += file->GetSize();
+        }
+        sc->SetSize(size);
+        sc->SetRowCount(row_cnts_[segment->GetID()]);
+        segment_commits.push_back(sc);
+    }
+    STATUS_CHECK(store->CreateResources<SegmentCommit>(segment_commits));
+
+    std::map<ID_TYPE, PartitionCommitPtr> partition_commits;
+    auto get_partition_commit = [&](ID_TYPE partition_id, PartitionCommitPtr& pc) -> Status {
+        auto& new_pc = partition_commits[partition_id];
+        if (!new_pc) {
+            auto prev_pc = ss->GetPartitionCommitByPartitionId(partition_id);
+            if (!prev_pc) {
+                std::stringstream emsg;
+                emsg << GetRepr() << ". Cannot find partition commit of partition " << partition_id;
+                return Status(SS_NOT_FOUND_ERROR, emsg.str());
+            }
+            new_pc = std::make_shared<PartitionCommit>(*prev_pc);
+            new_pc->SetID(0);
+            new_pc->ResetStatus();
+        }
+        pc = new_pc;
+        return Status::OK();
+    };
+
+    for (auto& stale_segment : context_.stale_segments) {
+        auto stale_sc = ss->GetSegmentCommitBySegmentId(stale_segment->GetID());
+        if (!stale_sc) {
+            std::stringstream emsg;
+            emsg << GetRepr() << ". Stale segment " << stale_segment->GetID() << " in context";
+            return Status(SS_STALE_ERROR, emsg.str());
+        }
+        PartitionCommitPtr pc;
+        STATUS_CHECK(get_partition_commit(stale_segment->GetPartitionId(), pc));
+        pc->GetMappings().erase(stale_sc->GetID());
+        pc->SetRowCount(pc->GetRowCount() - stale_sc->GetRowCount());
+        pc->SetSize(pc->GetSize() - stale_sc->GetSize());
+    }
+
+    for (auto& sc : segment_commits) {
+        PartitionCommitPtr pc;
+        STATUS_CHECK(get_partition_commit(sc->GetPartitionId(), pc));
+        pc->GetMappings().insert(sc->GetID());
+        pc->SetRowCount(pc->GetRowCount() + sc->GetRowCount());
+        pc->SetSize(pc->GetSize() + sc->GetSize());
+
+        auto sc_ctx_p = ResourceContextBuilder<SegmentCommit>().SetOp(meta::oUpdate).CreatePtr();
+        AddStepWithLsn(*sc, context_.lsn, sc_ctx_p);
+    }
+
+    OperationContext cc_context;
+    for (auto& kv : partition_commits) {
+        cc_context.new_partition_commits.push_back(kv.second);
+    }
+    STATUS_CHECK(store->CreateResources<PartitionCommit>(cc_context.new_partition_commits));
+    for (auto& pc : cc_context.new_partition_commits) {
+        auto pc_ctx_p = ResourceContextBuilder<PartitionCommit>().SetOp(meta::oUpdate).CreatePtr();
+        AddStepWithLsn(*pc, context_.lsn, pc_ctx_p);
+    }
+    context_.new_partition_commits = cc_context.new_partition_commits;
+
+    CollectionCommitOperation cc_op(cc_context, ss);
+    STATUS_CHECK(cc_op(store));
+    STATUS_CHECK(cc_op.GetResource(context_.new_collection_commit));
+    auto cc_ctx_p = ResourceContextBuilder<CollectionCommit>().SetOp(meta::oUpdate).CreatePtr();
+    AddStepWithLsn(*context_.new_collection_commit, context_.lsn, cc_ctx_p);
+
+    return Status::OK();
+}
+
 GetSnapshotIDsOperation::GetSnapshotIDsOperation(ID_TYPE collection_id, bool reversed)
     : BaseT(OperationContext(), ScopedSnapshotT(), OperationsType::O_Compound),
       collection_id_(collection_id),
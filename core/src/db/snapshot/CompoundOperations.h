@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 #include "ResourceOperations.h"
 #include "Snapshot.h"
@@ -154,6 +155,40 @@ class MergeOperation : public CompoundBaseOperation<MergeOperation> {
     OnSnapshotStale() override;
 };
 
+/*
+ * Adds and drops segments of many partitions of a collection in one snapshot transition.
+ * The segment commits, and then the partition commits, of all the touched partitions are created in one
+ * meta transaction each, rather than one operation and one snapshot per segment.
+ */
+class BatchSegmentsOperation : public CompoundBaseOperation<BatchSegmentsOperation> {
+ public:
+    using BaseT = CompoundBaseOperation<BatchSegmentsOperation>;
+    static constexpr const char* Name = "BS";
+
+    BatchSegmentsOperation(const OperationContext& context, ScopedSnapshotT prev_ss);
+
+    Status DoExecute(StorePtr) override;
+
+    Status
+    CommitNewSegment(ID_TYPE partition_id, SegmentPtr& created);
+
+    Status
+    CommitNewSegmentFile(const SegmentFileContext& context, SegmentFilePtr& created);
+
+    Status
+    CommitRowCount(ID_TYPE segment_id, SIZE_TYPE row_cnt);
+
+    Status
+    CommitDropSegment(ID_TYPE segment_id);
+
+    Status
+    OnSnapshotStale() override;
+
+ protected:
+    std::map<ID_TYPE, SegmentPtr> new_segments_;
+    std::map<ID_TYPE, SIZE_TYPE> row_cnts_;
+};
+
 class CreateCollectionOperation : public CompoundBaseOperation<CreateCollectionOperation> {
  public:
     using BaseT = CompoundBaseOperation<CreateCollectionOperation>;
@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/snapshot/EpochManager.h"
+
+#include <thread>
+
+namespace milvus {
+namespace engine {
+namespace snapshot {
+
+struct EpochManager::ThreadSlot {
+    static constexpr int64_t UNASSIGNED = -2;
+    static constexpr int64_t NO_SLOT = -1;
+
+    ~ThreadSlot() {
+        if (index_ >= 0) {
+            EpochManager::GetInstance().ReleaseSlot(index_);
+        }
+    }
+
+    int64_t index_ = UNASSIGNED;
+    int64_t depth_ = 0;
+};
+
+EpochManager&
+EpochManager::GetInstance() {
+    static EpochManager s_mgr;
+    return s_mgr;
+}
+
+EpochManager::ThreadSlot&
+EpochManager::LocalSlot() {
+    thread_local ThreadSlot slot;
+    return slot;
+}
+
+bool
+EpochManager::Enter() {
+    auto& local = LocalSlot();
+    if (local.index_ == ThreadSlot::UNASSIGNED) {
+        local.index_ = AcquireSlot();
+    }
+    if (local.index_ == ThreadSlot::NO_SLOT) {
+        return false;
+    }
+
+    // nested guards share the epoch of the outermost one
+    if (local.depth_++ == 0) {
+        slots_[local.index_].epoch_.store(global_epoch_.load());
+    }
+    return true;
+}
+
+void
+EpochManager::Exit() {
+    auto& local = LocalSlot();
+    if (--local.depth_ == 0) {
+        slots_[local.index_].epoch_.store(0);
+    }
+}
+
+void
+EpochManager::Synchronize() {
+    // a guard entered after the increment loads the pointer stored before this call
+    auto epoch = global_epoch_.fetch_add(1);
+    for (auto& slot : slots_) {
+        while (true) {
+            auto entered = slot.epoch_.load();
+            if (entered == 0 || entered > epoch) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+int64_t
+EpochManager::AcquireSlot() {
+    for (size_t i = 0; i < MAX_SLOTS; ++i) {
+        bool used = false;
+        if (slots_[i].used_.compare_exchange_strong(used, true)) {
+            return i;
+        }
+    }
+    return ThreadSlot::NO_SLOT;
+}
+
+void
+EpochManager::ReleaseSlot(int64_t index) {
+    slots_[index].epoch_.store(0);
+    slots_[index].used_.store(false);
+}
+
+}  // namespace snapshot
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,98 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace milvus {
+namespace engine {
+namespace snapshot {
+
+/*
+ * Epoch based reclamation of the objects published to lock-free readers.
+ * A reader loads the published pointer inside a Guard and takes its own reference to the object
+ * before the Guard ends. A writer that replaced the pointer calls Synchronize, which returns once
+ * every Guard that could have loaded the old pointer has ended, and then frees the old object.
+ * Synchronize must not be called inside a Guard.
+ *
+ * Readers only write their own slot, so they don't contend with each other. A thread keeps its slot
+ * until it exits. The threads beyond MAX_SLOTS get no slot, their Guard is not entered and they are
+ * expected to take the locked path.
+ */
+class EpochManager {
+ public:
+    static constexpr size_t MAX_SLOTS = 256;
+
+    static EpochManager&
+    GetInstance();
+
+    class Guard {
+     public:
+        Guard() : entered_(EpochManager::GetInstance().Enter()) {
+        }
+
+        ~Guard() {
+            if (entered_) {
+                EpochManager::GetInstance().Exit();
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard&
+        operator=(const Guard&) = delete;
+
+        bool
+        Entered() const {
+            return entered_;
+        }
+
+     private:
+        bool entered_;
+    };
+
+    bool
+    Enter();
+
+    void
+    Exit();
+
+    void
+    Synchronize();
+
+ private:
+    EpochManager() = default;
+
+    struct ThreadSlot;
+
+    ThreadSlot&
+    LocalSlot();
+
+    int64_t
+    AcquireSlot();
+
+    void
+    ReleaseSlot(int64_t index);
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch_ = {0};  // epoch the running Guard entered at, 0 if none
+        std::atomic<bool> used_ = {false};
+    };
+
+    std::atomic<uint64_t> global_epoch_ = {1};
+    Slot slots_[MAX_SLOTS];
+};
+
+}  // namespace snapshot
+}  // namespace engine
+}  // namespace milvus
@@ -35,6 +35,18 @@ class ReferenceProxy {
         ++ref_count_;
     }
 
+    // Take a reference unless the count already dropped to zero, the resource is released then
+    bool
+    TryRef() {
+        auto count = ref_count_.load();
+        while (count > 0) {
+            if (ref_count_.compare_exchange_weak(count, count + 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     virtual void
     UnRef() {
         if (ref_count_ == 0) {
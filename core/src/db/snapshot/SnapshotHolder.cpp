@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/snapshot/SnapshotHolder.h"
+#include "db/snapshot/EpochManager.h"
 #include "db/snapshot/Operations.h"
 #include "db/snapshot/ResourceHolders.h"
 
@@ -33,6 +34,32 @@ SnapshotHolder::~SnapshotHolder() {
     if (release) {
         active_.clear();
     }
+
+    delete latest_.load();
+}
+
+bool
+SnapshotHolder::GetLatest(ScopedSnapshotT& ss, bool scoped) const {
+    Snapshot::Ptr raw;
+    {
+        EpochManager::Guard guard;
+        if (!guard.Entered()) {
+            return false;
+        }
+        auto latest = latest_.load();
+        if (latest == nullptr) {
+            return false;
+        }
+        raw = *latest;
+    }
+
+    // the holder dropped its reference, a newer snapshot is published or about to be
+    if (!raw->TryRef()) {
+        return false;
+    }
+    ss = ScopedSnapshotT(raw, scoped);
+    raw->UnRef();
+    return true;
 }
 
 Status
@@ -48,6 +75,10 @@ SnapshotHolder::Load(StorePtr store, ScopedSnapshotT& ss, ID_TYPE id, bool scope
             return status;
     }
 
+    if (id == 0 && GetLatest(ss, scoped)) {
+        return status;
+    }
+
     std::unique_lock<std::mutex> lock(mutex_);
     if (id == 0 || id == max_id_) {
         auto raw = active_.at(max_id_);
@@ -85,6 +116,10 @@ SnapshotHolder::Get(ScopedSnapshotT& ss, ID_TYPE id, bool scoped) const {
         return Status(SS_NOT_FOUND_ERROR, emsg.str());
     }
 
+    if (id == 0 && GetLatest(ss, scoped)) {
+        return status;
+    }
+
     std::unique_lock<std::mutex> lock(mutex_);
     if (id == 0 || id == max_id_) {
         auto raw = active_.at(max_id_);
@@ -139,6 +174,7 @@ SnapshotHolder::Add(StorePtr store, ID_TYPE id) {
         }
     }
     Snapshot::Ptr oldest_ss;
+    Snapshot::Ptr* replaced = nullptr;
     {
         auto ss = std::make_shared<Snapshot>(store, id);
 
@@ -160,15 +196,25 @@ SnapshotHolder::Add(StorePtr store, ID_TYPE id) {
         }
 
         active_[id] = ss;
-        if (active_.size() <= num_versions_)
-            return status;
+        if (id == max_id_) {
+            replaced = latest_.exchange(new Snapshot::Ptr(ss));
+        }
 
-        auto oldest_it = active_.find(min_id_);
-        oldest_ss = oldest_it->second;
-        active_.erase(oldest_it);
-        min_id_ = active_.begin()->first;
+        if (active_.size() > num_versions_) {
+            auto oldest_it = active_.find(min_id_);
+            oldest_ss = oldest_it->second;
+            active_.erase(oldest_it);
+            min_id_ = active_.begin()->first;
+        }
+    }
+
+    if (oldest_ss) {
+        ReadyForRelease(oldest_ss);
+    }
+    if (replaced != nullptr) {
+        EpochManager::GetInstance().Synchronize();
+        delete replaced;
     }
-    ReadyForRelease(oldest_ss);
     return status;
 }
 
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
@@ -55,6 +56,10 @@ class SnapshotHolder {
     Status
     LoadNoLock(ID_TYPE collection_commit_id, CollectionCommitPtr& cc, StorePtr store);
 
+    // pin the latest snapshot without the mutex, false if it is being replaced
+    bool
+    GetLatest(ScopedSnapshotT& ss, bool scoped) const;
+
     void
     ReadyForRelease(Snapshot::Ptr ss) {
         if (gc_handler_) {
@@ -70,6 +75,9 @@ class SnapshotHolder {
     std::vector<Snapshot::Ptr> to_release_;
     size_t num_versions_ = 1;
     GCHandler gc_handler_;
+
+    // copy of active_.at(max_id_) for the readers, freed through EpochManager once replaced
+    std::atomic<Snapshot::Ptr*> latest_ = {nullptr};
 };
 
 using SnapshotHolderPtr = std::shared_ptr<SnapshotHolder>;
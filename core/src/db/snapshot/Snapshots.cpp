@@ -11,11 +11,16 @@
 
 #include "db/snapshot/Snapshots.h"
 #include "db/snapshot/CompoundOperations.h"
+#include "db/snapshot/EpochManager.h"
 
 namespace milvus {
 namespace engine {
 namespace snapshot {
 
+Snapshots::~Snapshots() {
+    delete view_.load();
+}
+
 /* Status */
 /* Snapshots::DropAll() { */
 /* } */
@@ -47,9 +52,14 @@ Snapshots::DoDropCollection(ScopedSnapshotT& ss, const LSN_TYPE& lsn) {
     op->Push();
     auto status = op->GetStatus();
 
-    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-    name_id_map_.erase(context.collection->GetName());
-    holders_.erase(context.collection->GetID());
+    HoldersView* replaced = nullptr;
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+        name_id_map_.erase(context.collection->GetName());
+        holders_.erase(context.collection->GetID());
+        replaced = PublishViewNoLock();
+    }
+    RetireView(replaced);
     return status;
 }
 
@@ -160,6 +170,21 @@ Snapshots::Init(StorePtr store) {
 
 Status
 Snapshots::GetHolder(const std::string& name, SnapshotHolderPtr& holder) const {
+    {
+        EpochManager::Guard guard;
+        auto view = guard.Entered() ? view_.load() : nullptr;
+        if (view != nullptr) {
+            auto kv = view->name_id_map_.find(name);
+            if (kv != view->name_id_map_.end()) {
+                auto it = view->holders_.find(kv->second);
+                if (it != view->holders_.end()) {
+                    holder = it->second;
+                    return Status::OK();
+                }
+            }
+        }
+    }
+
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
     auto kv = name_id_map_.find(name);
     if (kv != name_id_map_.end()) {
@@ -175,6 +200,18 @@ Snapshots::GetHolder(const std::string& name, SnapshotHolderPtr& holder) const {
 
 Status
 Snapshots::GetHolder(const ID_TYPE& collection_id, SnapshotHolderPtr& holder) const {
+    {
+        EpochManager::Guard guard;
+        auto view = guard.Entered() ? view_.load() : nullptr;
+        if (view != nullptr) {
+            auto it = view->holders_.find(collection_id);
+            if (it != view->holders_.end()) {
+                holder = it->second;
+                return Status::OK();
+            }
+        }
+    }
+
     Status status;
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
     status = GetHolderNoLock(collection_id, holder);
@@ -195,13 +232,18 @@ Snapshots::LoadHolder(StorePtr store, const ID_TYPE& collection_id, SnapshotHold
     if (!status.ok())
         return status;
 
-    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-    holders_[collection_id] = holder;
-    ScopedSnapshotT ss;
-    status = holder->Load(store, ss);
-    if (!status.ok())
-        return status;
-    name_id_map_[ss->GetName()] = collection_id;
+    HoldersView* replaced = nullptr;
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+        holders_[collection_id] = holder;
+        ScopedSnapshotT ss;
+        status = holder->Load(store, ss);
+        if (status.ok()) {
+            name_id_map_[ss->GetName()] = collection_id;
+        }
+        replaced = PublishViewNoLock();
+    }
+    RetireView(replaced);
     return status;
 }
 
@@ -220,13 +262,33 @@ Snapshots::GetHolderNoLock(ID_TYPE collection_id, SnapshotHolderPtr& holder) con
 
 Status
 Snapshots::Reset() {
-    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-    holders_.clear();
-    name_id_map_.clear();
-    to_release_.clear();
+    HoldersView* replaced = nullptr;
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+        holders_.clear();
+        name_id_map_.clear();
+        to_release_.clear();
+        replaced = view_.exchange(nullptr);
+    }
+    RetireView(replaced);
     return Status::OK();
 }
 
+Snapshots::HoldersView*
+Snapshots::PublishViewNoLock() {
+    auto view = new HoldersView{holders_, name_id_map_};
+    return view_.exchange(view);
+}
+
+void
+Snapshots::RetireView(HoldersView* view) {
+    if (view == nullptr) {
+        return;
+    }
+    EpochManager::GetInstance().Synchronize();
+    delete view;
+}
+
 void
 Snapshots::SnapshotGCCallback(Snapshot::Ptr ss_ptr) {
     /* to_release_.push_back(ss_ptr); */
@@ -70,6 +70,7 @@ class Snapshots {
     void
     SnapshotGCCallback(Snapshot::Ptr ss_ptr);
     Snapshots() = default;
+    ~Snapshots();
     Status
     DoDropCollection(ScopedSnapshotT& ss, const LSN_TYPE& lsn);
 
@@ -78,10 +79,27 @@ class Snapshots {
     Status
     GetHolderNoLock(ID_TYPE collection_id, SnapshotHolderPtr& holder) const;
 
+    /*
+     * Copy of holders_ and name_id_map_ for the lock-free readers.
+     * Every change of the maps publishes a new view, the old one is freed through EpochManager.
+     */
+    struct HoldersView {
+        std::map<ID_TYPE, SnapshotHolderPtr> holders_;
+        std::map<std::string, ID_TYPE> name_id_map_;
+    };
+
+    // called with mutex_ held exclusively, returns the replaced view for RetireView
+    HoldersView*
+    PublishViewNoLock();
+
+    void
+    RetireView(HoldersView* view);
+
     mutable std::shared_timed_mutex mutex_;
     std::map<ID_TYPE, SnapshotHolderPtr> holders_;
     std::map<std::string, ID_TYPE> name_id_map_;
     std::vector<Snapshot::Ptr> to_release_;
+    std::atomic<HoldersView*> view_ = {nullptr};
 };
 
 }  // namespace snapshot
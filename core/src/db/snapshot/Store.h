@@ -113,6 +113,32 @@ class Store : public std::enable_shared_from_this<Store> {
         }
     }
 
+    // Creates the resources in one meta transaction and assigns the new ids to them
+    template <typename ResourceT>
+    Status
+    CreateResources(std::vector<typename ResourceT::Ptr>& resources) {
+        if (resources.empty()) {
+            return Status::OK();
+        }
+
+        auto session = adapter_->CreateSession();
+        for (auto& res : resources) {
+            auto res_ctx_p = ResourceContextBuilder<ResourceT>().SetResource(res).SetOp(meta::oAdd).CreatePtr();
+            STATUS_CHECK(session->Apply<ResourceT>(res_ctx_p));
+        }
+
+        std::vector<int64_t> result_ids;
+        STATUS_CHECK(session->Commit(result_ids));
+        if (result_ids.size() != resources.size()) {
+            return Status(SS_ERROR, "Unexpected number of created " + std::string(ResourceT::Name));
+        }
+        for (size_t i = 0; i < resources.size(); ++i) {
+            resources[i]->SetID(result_ids[i]);
+        }
+
+        return Status::OK();
+    }
+
     template <typename OpT>
     void
     Apply(OpT& op) {
@@ -12,9 +12,11 @@
 #include "db/wal/WalBuffer.h"
 
 #include <cstring>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "codecs/default/RawDataCodec.h"
 #include "db/wal/WalDefinations.h"
 #include "utils/Log.h"
 
@@ -38,6 +40,23 @@ ParserLsn(uint64_t lsn, uint32_t& file_no, uint32_t& offset) {
     offset = uint32_t(lsn & LSN_OFFSET_MASK);
 }
 
+namespace {
+
+// a compressed payload is a list of sections: uint8 codec type (0: plain) | uint32 stored size | stored bytes
+// ids, vector data, then the attribute values in field order
+constexpr uint8_t PLAIN_SECTION = 0;
+
+// offset of reserved_lsn_ while the wal file is being switched, no record can be reserved
+constexpr uint32_t SEALED_OFFSET = UINT32_MAX;
+
+struct PayloadSection {
+    const uint8_t* data_;
+    uint64_t size_;
+    codec::RawDataCodecType type_;
+};
+
+}  // namespace
+
 MXLogBuffer::MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size)
     : mxlog_buffer_size_(buffer_size * UNIT_MB), mxlog_writer_(mxlog_path) {
 }
@@ -91,8 +110,8 @@ MXLogBuffer::Init(uint64_t start_lsn, uint64_t end_lsn) {
         }
     }
 
-    buf_[0] = BufferPtr(new char[mxlog_buffer_size_]);
-    buf_[1] = BufferPtr(new char[mxlog_buffer_size_]);
+    AllocBuffer(0, mxlog_buffer_size_);
+    AllocBuffer(1, mxlog_buffer_size_);
 
     if (mxlog_buffer_reader_.file_no == mxlog_buffer_writer_.file_no) {
         // read-write buffer
@@ -147,6 +166,7 @@ MXLogBuffer::Init(uint64_t start_lsn, uint64_t end_lsn) {
     }
 
     SetFileNoFrom(mxlog_buffer_reader_.file_no);
+    ResetReservation();
 
     return true;
 }
@@ -155,8 +175,8 @@ void
 MXLogBuffer::Reset(uint64_t lsn) {
     LOG_WAL_DEBUG_ << "reset lsn " << lsn;
 
-    buf_[0] = BufferPtr(new char[mxlog_buffer_size_]);
-    buf_[1] = BufferPtr(new char[mxlog_buffer_size_]);
+    AllocBuffer(0, mxlog_buffer_size_);
+    AllocBuffer(1, mxlog_buffer_size_);
 
     ParserLsn(lsn, mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset);
     if (mxlog_buffer_writer_.buf_offset != 0) {
@@ -172,6 +192,7 @@ MXLogBuffer::Reset(uint64_t lsn) {
     mxlog_writer_.SetFileOpenMode("w");
 
     SetFileNoFrom(mxlog_buffer_reader_.file_no);
+    ResetReservation();
 }
 
 uint32_t
@@ -179,10 +200,281 @@ MXLogBuffer::GetBufferSize() {
     return mxlog_buffer_size_;
 }
 
+void
+MXLogBuffer::SetBufferSize(uint32_t buffer_size) {
+    pending_buffer_size_ = buffer_size;
+}
+
+void
+MXLogBuffer::AllocBuffer(uint8_t buf_idx, uint32_t size) {
+    buf_[buf_idx] = BufferPtr(new char[size]);
+    buf_capacity_[buf_idx] = size;
+    buffer_memory_.Set(static_cast<int64_t>(buf_capacity_[0]) + buf_capacity_[1]);
+}
+
+ErrorCode
+MXLogBuffer::LoadReaderFile() {
+    MXLogFileHandler mxlog_reader(mxlog_writer_.GetFilePath());
+    mxlog_reader.SetFileName(ToFileName(mxlog_buffer_reader_.file_no));
+    mxlog_reader.SetFileOpenMode("r");
+
+    // the writer never uses the reader's buffer while the reader is behind, it is safe to replace here
+    uint32_t file_size = mxlog_reader.GetFileSize();
+    if (file_size > buf_capacity_[mxlog_buffer_reader_.buf_idx]) {
+        AllocBuffer(mxlog_buffer_reader_.buf_idx, file_size);
+    }
+
+    file_size = mxlog_reader.Load(buf_[mxlog_buffer_reader_.buf_idx].get(), 0);
+    if (file_size == 0) {
+        LOG_WAL_ERROR_ << "load wal file error " << mxlog_buffer_reader_.file_no;
+        return WAL_FILE_ERROR;
+    }
+    mxlog_buffer_reader_.max_offset = file_size;
+    return WAL_SUCCESS;
+}
+
+bool
+MXLogBuffer::Sync() {
+    std::lock_guard<InstrumentedMutex> file_lck(file_mutex_);
+    if (!mxlog_writer_.Sync()) {
+        LOG_WAL_ERROR_ << "sync wal file error " << mxlog_writer_.GetFileName();
+        return false;
+    }
+    return true;
+}
+
+void
+MXLogBuffer::SetSyncOnSwitch(bool sync_on_switch) {
+    std::lock_guard<InstrumentedMutex> file_lck(file_mutex_);
+    sync_on_switch_ = sync_on_switch;
+}
+
+void
+MXLogBuffer::ResetReservation() {
+    uint64_t lsn;
+    BuildLsn(mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset, lsn);
+    committed_lsn_.store(lsn, std::memory_order_release);
+    reserved_lsn_.store(lsn, std::memory_order_release);
+    writer_opened_.store(false, std::memory_order_release);
+}
+
+ErrorCode
+MXLogBuffer::Reserve(uint32_t record_size, uint64_t& begin_lsn) {
+    while (true) {
+        uint64_t lsn = reserved_lsn_.load(std::memory_order_acquire);
+        uint32_t file_no, offset;
+        ParserLsn(lsn, file_no, offset);
+        if (offset == SEALED_OFFSET) {
+            // the switcher holds switch_mutex_ until the next file is ready
+            std::lock_guard<InstrumentedMutex> switch_lck(switch_mutex_);
+            continue;
+        }
+
+        if (mxlog_buffer_size_ - offset >= record_size) {
+            uint64_t end_lsn;
+            BuildLsn(file_no, offset + record_size, end_lsn);
+            if (reserved_lsn_.compare_exchange_weak(lsn, end_lsn, std::memory_order_acq_rel)) {
+                begin_lsn = lsn;
+                return WAL_SUCCESS;
+            }
+            continue;
+        }
+
+        if (offset == 0) {
+            LOG_WAL_ERROR_ << "record size " << record_size << " exceeds wal buffer size " << mxlog_buffer_size_;
+            return WAL_ERROR;
+        }
+
+        // writer buffer has no space, switch wal file and write to a new buffer
+        if (!SwitchFile(lsn)) {
+            return WAL_FILE_ERROR;
+        }
+    }
+}
+
+void
+MXLogBuffer::Commit(uint64_t begin_lsn, uint64_t end_lsn) {
+    // records become visible in lsn order, wait for the producers which reserved the space before
+    while (committed_lsn_.load(std::memory_order_acquire) != begin_lsn) {
+        std::this_thread::yield();
+    }
+    mxlog_buffer_writer_.buf_offset = uint32_t(end_lsn & LSN_OFFSET_MASK);
+    committed_lsn_.store(end_lsn, std::memory_order_release);
+}
+
+bool
+MXLogBuffer::SwitchFile(uint64_t full_lsn) {
+    std::lock_guard<InstrumentedMutex> switch_lck(switch_mutex_);
+    uint32_t file_no, offset;
+    ParserLsn(full_lsn, file_no, offset);
+
+    uint64_t sealed_lsn;
+    BuildLsn(file_no, SEALED_OFFSET, sealed_lsn);
+    if (!reserved_lsn_.compare_exchange_strong(full_lsn, sealed_lsn, std::memory_order_acq_rel)) {
+        // another producer reserved space or switched the file first, the caller retries
+        return true;
+    }
+
+    // the reader may only take over the buffer once all the reserved records are in it
+    while (committed_lsn_.load(std::memory_order_acquire) != full_lsn) {
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<InstrumentedMutex> lck(mutex_);
+    if (mxlog_buffer_writer_.buf_idx == mxlog_buffer_reader_.buf_idx) {
+        // swith writer buffer
+        mxlog_buffer_reader_.max_offset = mxlog_buffer_writer_.buf_offset;
+        mxlog_buffer_writer_.buf_idx ^= 1;
+    }
+    mxlog_buffer_writer_.file_no++;
+    mxlog_buffer_writer_.buf_offset = 0;
+
+    // neither the reader nor a producer is in the writer's buffer now, it takes the size set since the last switch
+    uint32_t buffer_size = pending_buffer_size_.exchange(0);
+    if (buffer_size != 0 && buffer_size != mxlog_buffer_size_) {
+        LOG_WAL_INFO_ << "wal buffer size changed from " << mxlog_buffer_size_ << " to " << buffer_size;
+        mxlog_buffer_size_ = buffer_size;
+    }
+    if (buf_capacity_[mxlog_buffer_writer_.buf_idx] != mxlog_buffer_size_) {
+        AllocBuffer(mxlog_buffer_writer_.buf_idx, mxlog_buffer_size_);
+    }
+    lck.unlock();
+
+    bool rst = true;
+    {
+        std::lock_guard<InstrumentedMutex> file_lck(file_mutex_);
+        // the sync thread only syncs the current file, the records of the old one must reach disk before it is closed
+        if (sync_on_switch_ && !mxlog_writer_.Sync()) {
+            LOG_WAL_ERROR_ << "sync wal file error " << mxlog_writer_.GetFileName();
+            rst = false;
+        }
+
+        // Reborn means close old wal file and open new wal file
+        if (rst && !mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "w")) {
+            LOG_WAL_ERROR_ << "ReBorn wal file error " << mxlog_buffer_writer_.file_no;
+            rst = false;
+        }
+        writer_opened_.store(rst, std::memory_order_release);
+    }
+
+    // open the next file for reservations even on error, the waiting producers would hang otherwise
+    uint64_t next_lsn;
+    BuildLsn(mxlog_buffer_writer_.file_no, 0, next_lsn);
+    committed_lsn_.store(next_lsn, std::memory_order_release);
+    reserved_lsn_.store(next_lsn, std::memory_order_release);
+    return rst;
+}
+
+bool
+MXLogBuffer::WriteRecord(const char* data, uint32_t size, uint32_t offset) {
+    if (!writer_opened_.load(std::memory_order_acquire)) {
+        std::lock_guard<InstrumentedMutex> file_lck(file_mutex_);
+        if (!writer_opened_.load(std::memory_order_relaxed)) {
+            if (!mxlog_writer_.OpenFile()) {
+                return false;
+            }
+            writer_opened_.store(true, std::memory_order_release);
+        }
+    }
+    return mxlog_writer_.WriteAt(data, size, offset);
+}
+
+void
+MXLogBuffer::SetCompress(bool compress) {
+    compress_ = compress;
+}
+
+bool
+MXLogBuffer::CompressPayload(const MXLogRecord& record, bool entity, uint64_t payload_size,
+                             std::vector<uint8_t>& compressed) {
+    std::vector<PayloadSection> sections;
+    sections.push_back({reinterpret_cast<const uint8_t*>(record.ids), (uint64_t)record.length * sizeof(IDNumber),
+                        codec::RawDataCodecType::DELTA_INT64});
+    sections.push_back(
+        {reinterpret_cast<const uint8_t*>(record.data), record.data_size, codec::RawDataCodecType::BYTE_PLANE});
+    if (entity) {
+        for (auto& name : record.field_names) {
+            // 8 bytes columns are mostly int64 ids or timestamps, the others are split into byte planes
+            auto type = record.attr_nbytes.at(name) == sizeof(int64_t) ? codec::RawDataCodecType::DELTA_INT64
+                                                                       : codec::RawDataCodecType::BYTE_PLANE;
+            sections.push_back({record.attr_data.at(name).data(), record.attr_data_size.at(name), type});
+        }
+    }
+
+    compressed.clear();
+    std::vector<uint8_t> encoded;
+    for (auto& section : sections) {
+        if (section.size_ == 0) {
+            compressed.push_back(PLAIN_SECTION);
+            compressed.resize(compressed.size() + sizeof(uint32_t), 0);
+            continue;
+        }
+        if (section.data_ == nullptr) {
+            return false;
+        }
+
+        encoded.clear();
+        codec::EncodeRawDataBlock(section.type_, section.data_, section.size_, encoded);
+        bool plain = encoded.size() >= section.size_;
+        const uint8_t* stored = plain ? section.data_ : encoded.data();
+        uint32_t stored_size = plain ? section.size_ : encoded.size();
+
+        compressed.push_back(plain ? PLAIN_SECTION : (uint8_t)section.type_);
+        auto size_bytes = reinterpret_cast<const uint8_t*>(&stored_size);
+        compressed.insert(compressed.end(), size_bytes, size_bytes + sizeof(uint32_t));
+        compressed.insert(compressed.end(), stored, stored + stored_size);
+        if (compressed.size() >= payload_size) {
+            return false;
+        }
+    }
+    return compressed.size() < payload_size;
+}
+
+bool
+MXLogBuffer::DecompressPayload(const char* payload, uint32_t payload_size, const std::vector<uint64_t>& section_sizes) {
+    uint64_t total_size = 0;
+    for (auto size : section_sizes) {
+        total_size += size;
+    }
+    decompressed_.resize(total_size);
+
+    auto src = reinterpret_cast<const uint8_t*>(payload);
+    auto end = src + payload_size;
+    uint8_t* dst = decompressed_.data();
+    for (auto size : section_sizes) {
+        if ((size_t)(end - src) < sizeof(uint8_t) + sizeof(uint32_t)) {
+            return false;
+        }
+        uint8_t type = *src++;
+        uint32_t stored_size = 0;
+        memcpy(&stored_size, src, sizeof(uint32_t));
+        src += sizeof(uint32_t);
+        if ((size_t)(end - src) < stored_size) {
+            return false;
+        }
+
+        if (type == PLAIN_SECTION) {
+            if (stored_size != size) {
+                return false;
+            }
+            if (size > 0) {
+                memcpy(dst, src, size);
+            }
+        } else if (!codec::DecodeRawDataBlock((codec::RawDataCodecType)type, src, stored_size, dst, size)) {
+            return false;
+        }
+        src += stored_size;
+        dst += size;
+    }
+    return src == end;
+}
+
 // buffer writer cares about surplus space of buffer
 uint32_t
 MXLogBuffer::SurplusSpace() {
-    return mxlog_buffer_size_ - mxlog_buffer_writer_.buf_offset;
+    uint32_t file_no, offset;
+    ParserLsn(reserved_lsn_.load(std::memory_order_acquire), file_no, offset);
+    return offset == SEALED_OFFSET ? 0 : mxlog_buffer_size_ - offset;
 }
 
 uint32_t
@@ -216,32 +508,27 @@ MXLogBuffer::EntityRecordSize(const milvus::engine::wal::MXLogRecord& record, ui
 ErrorCode
 MXLogBuffer::Append(MXLogRecord& record) {
     uint32_t record_size = RecordSize(record);
-    if (SurplusSpace() < record_size) {
-        // writer buffer has no space, switch wal file and write to a new buffer
-        std::unique_lock<std::mutex> lck(mutex_);
-        if (mxlog_buffer_writer_.buf_idx == mxlog_buffer_reader_.buf_idx) {
-            // swith writer buffer
-            mxlog_buffer_reader_.max_offset = mxlog_buffer_writer_.buf_offset;
-            mxlog_buffer_writer_.buf_idx ^= 1;
-        }
-        mxlog_buffer_writer_.file_no++;
-        mxlog_buffer_writer_.buf_offset = 0;
-        lck.unlock();
-
-        // Reborn means close old wal file and open new wal file
-        if (!mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "w")) {
-            LOG_WAL_ERROR_ << "ReBorn wal file error " << mxlog_buffer_writer_.file_no;
-            return WAL_FILE_ERROR;
-        }
+    uint64_t payload_size = (uint64_t)record.length * sizeof(IDNumber) + record.data_size;
+    std::vector<uint8_t> compressed_payload;
+    bool compressed = compress_ && payload_size > 0 && CompressPayload(record, false, payload_size, compressed_payload);
+    if (compressed) {
+        record_size -= payload_size - compressed_payload.size();
+    }
+    uint64_t begin_lsn = 0;
+    auto error_code = Reserve(record_size, begin_lsn);
+    if (error_code != WAL_SUCCESS) {
+        return error_code;
     }
 
-    // point to the offset of current record in wal file
+    // point to the offset of current record in wal file, the buffer can't be switched before the record is committed
+    uint32_t file_no, record_offset;
+    ParserLsn(begin_lsn, file_no, record_offset);
     char* current_write_buf = buf_[mxlog_buffer_writer_.buf_idx].get();
-    uint32_t current_write_offset = mxlog_buffer_writer_.buf_offset;
+    uint32_t current_write_offset = record_offset;
 
     MXLogRecordHeader head;
-    BuildLsn(mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset + (uint32_t)record_size, head.mxl_lsn);
-    head.mxl_type = (uint8_t)record.type;
+    BuildLsn(file_no, record_offset + (uint32_t)record_size, head.mxl_lsn);
+    head.mxl_type = (uint8_t)record.type | (compressed ? MXLogTypeCompressed : 0);
     head.collection_id_size = (uint16_t)record.collection_id.size();
     head.partition_tag_size = (uint16_t)record.partition_tag.size();
     head.vector_num = record.length;
@@ -259,24 +546,30 @@ MXLogBuffer::Append(MXLogRecord& record) {
         memcpy(current_write_buf + current_write_offset, record.partition_tag.data(), record.partition_tag.size());
         current_write_offset += record.partition_tag.size();
     }
-    if (record.ids != nullptr && record.length > 0) {
-        memcpy(current_write_buf + current_write_offset, record.ids, record.length * sizeof(IDNumber));
-        current_write_offset += record.length * sizeof(IDNumber);
-    }
 
-    if (record.data != nullptr && record.data_size > 0) {
-        memcpy(current_write_buf + current_write_offset, record.data, record.data_size);
-        current_write_offset += record.data_size;
+    if (compressed) {
+        memcpy(current_write_buf + current_write_offset, compressed_payload.data(), compressed_payload.size());
+        current_write_offset += compressed_payload.size();
+    } else {
+        if (record.ids != nullptr && record.length > 0) {
+            memcpy(current_write_buf + current_write_offset, record.ids, record.length * sizeof(IDNumber));
+            current_write_offset += record.length * sizeof(IDNumber);
+        }
+
+        if (record.data != nullptr && record.data_size > 0) {
+            memcpy(current_write_buf + current_write_offset, record.data, record.data_size);
+            current_write_offset += record.data_size;
+        }
     }
 
-    bool write_rst = mxlog_writer_.Write(current_write_buf + mxlog_buffer_writer_.buf_offset, record_size);
+    // the space is committed even if the write failed, otherwise the following producers wait forever
+    bool write_rst = WriteRecord(current_write_buf + record_offset, record_size, record_offset);
+    Commit(begin_lsn, head.mxl_lsn);
     if (!write_rst) {
         LOG_WAL_ERROR_ << "write wal file error";
         return WAL_FILE_ERROR;
     }
 
-    mxlog_buffer_writer_.buf_offset = current_write_offset;
-
     record.lsn = head.mxl_lsn;
     return WAL_SUCCESS;
 }
@@ -294,32 +587,30 @@ MXLogBuffer::AppendEntity(milvus::engine::wal::MXLogRecord& record) {
     }
 
     uint32_t record_size = EntityRecordSize(record, attr_header.attr_num, field_name_size);
-    if (SurplusSpace() < record_size) {
-        // writer buffer has no space, switch wal file and write to a new buffer
-        std::unique_lock<std::mutex> lck(mutex_);
-        if (mxlog_buffer_writer_.buf_idx == mxlog_buffer_reader_.buf_idx) {
-            // swith writer buffer
-            mxlog_buffer_reader_.max_offset = mxlog_buffer_writer_.buf_offset;
-            mxlog_buffer_writer_.buf_idx ^= 1;
-        }
-        mxlog_buffer_writer_.file_no++;
-        mxlog_buffer_writer_.buf_offset = 0;
-        lck.unlock();
-
-        // Reborn means close old wal file and open new wal file
-        if (!mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "w")) {
-            LOG_WAL_ERROR_ << "ReBorn wal file error " << mxlog_buffer_writer_.file_no;
-            return WAL_FILE_ERROR;
-        }
+    uint64_t payload_size = (uint64_t)record.length * sizeof(IDNumber) + record.data_size;
+    for (auto& size : attr_header.attr_size) {
+        payload_size += size;
+    }
+    std::vector<uint8_t> compressed_payload;
+    bool compressed = compress_ && payload_size > 0 && CompressPayload(record, true, payload_size, compressed_payload);
+    if (compressed) {
+        record_size -= payload_size - compressed_payload.size();
+    }
+    uint64_t begin_lsn = 0;
+    auto error_code = Reserve(record_size, begin_lsn);
+    if (error_code != WAL_SUCCESS) {
+        return error_code;
     }
 
-    // point to the offset of current record in wal file
+    // point to the offset of current record in wal file, the buffer can't be switched before the record is committed
+    uint32_t file_no, record_offset;
+    ParserLsn(begin_lsn, file_no, record_offset);
     char* current_write_buf = buf_[mxlog_buffer_writer_.buf_idx].get();
-    uint32_t current_write_offset = mxlog_buffer_writer_.buf_offset;
+    uint32_t current_write_offset = record_offset;
 
     MXLogRecordHeader head;
-    BuildLsn(mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset + (uint32_t)record_size, head.mxl_lsn);
-    head.mxl_type = (uint8_t)record.type;
+    BuildLsn(file_no, record_offset + (uint32_t)record_size, head.mxl_lsn);
+    head.mxl_type = (uint8_t)record.type | (compressed ? MXLogTypeCompressed : 0);
     head.collection_id_size = (uint16_t)record.collection_id.size();
     head.partition_tag_size = (uint16_t)record.partition_tag.size();
     head.vector_num = record.length;
@@ -352,14 +643,18 @@ MXLogBuffer::AppendEntity(milvus::engine::wal::MXLogRecord& record) {
         memcpy(current_write_buf + current_write_offset, record.partition_tag.data(), record.partition_tag.size());
         current_write_offset += record.partition_tag.size();
     }
-    if (record.ids != nullptr && record.length > 0) {
-        memcpy(current_write_buf + current_write_offset, record.ids, record.length * sizeof(IDNumber));
-        current_write_offset += record.length * sizeof(IDNumber);
-    }
 
-    if (record.data != nullptr && record.data_size > 0) {
-        memcpy(current_write_buf + current_write_offset, record.data, record.data_size);
-        current_write_offset += record.data_size;
+    // a compressed record has the attr names before the payload: ids, vector data and attr values
+    if (!compressed) {
+        if (record.ids != nullptr && record.length > 0) {
+            memcpy(current_write_buf + current_write_offset, record.ids, record.length * sizeof(IDNumber));
+            current_write_offset += record.length * sizeof(IDNumber);
+        }
+
+        if (record.data != nullptr && record.data_size > 0) {
+            memcpy(current_write_buf + current_write_offset, record.data, record.data_size);
+            current_write_offset += record.data_size;
+        }
     }
 
     // Assign attr names
@@ -370,23 +665,28 @@ MXLogBuffer::AppendEntity(milvus::engine::wal::MXLogRecord& record) {
         }
     }
 
-    // Assign attr values
-    for (auto name : record.field_names) {
-        if (record.attr_data_size.at(name) != 0) {
-            memcpy(current_write_buf + current_write_offset, record.attr_data.at(name).data(),
-                   record.attr_data_size.at(name));
-            current_write_offset += record.attr_data_size.at(name);
+    if (compressed) {
+        memcpy(current_write_buf + current_write_offset, compressed_payload.data(), compressed_payload.size());
+        current_write_offset += compressed_payload.size();
+    } else {
+        // Assign attr values
+        for (auto name : record.field_names) {
+            if (record.attr_data_size.at(name) != 0) {
+                memcpy(current_write_buf + current_write_offset, record.attr_data.at(name).data(),
+                       record.attr_data_size.at(name));
+                current_write_offset += record.attr_data_size.at(name);
+            }
         }
     }
 
-    bool write_rst = mxlog_writer_.Write(current_write_buf + mxlog_buffer_writer_.buf_offset, record_size);
+    // the space is committed even if the write failed, otherwise the following producers wait forever
+    bool write_rst = WriteRecord(current_write_buf + record_offset, record_size, record_offset);
+    Commit(begin_lsn, head.mxl_lsn);
     if (!write_rst) {
         LOG_WAL_ERROR_ << "write wal file error";
         return WAL_FILE_ERROR;
     }
 
-    mxlog_buffer_writer_.buf_offset = current_write_offset;
-
     record.lsn = head.mxl_lsn;
     return WAL_SUCCESS;
 }
@@ -403,7 +703,7 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
 
     // otherwise, it means there must exists next record, in buffer or wal log
     bool need_load_new = false;
-    std::unique_lock<std::mutex> lck(mutex_);
+    std::unique_lock<InstrumentedMutex> lck(mutex_);
     if (mxlog_buffer_reader_.file_no != mxlog_buffer_writer_.file_no) {
         if (mxlog_buffer_reader_.buf_offset == mxlog_buffer_reader_.max_offset) {  // last record
             mxlog_buffer_reader_.file_no++;
@@ -418,22 +718,18 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
     lck.unlock();
 
     if (need_load_new) {
-        MXLogFileHandler mxlog_reader(mxlog_writer_.GetFilePath());
-        mxlog_reader.SetFileName(ToFileName(mxlog_buffer_reader_.file_no));
-        mxlog_reader.SetFileOpenMode("r");
-        uint32_t file_size = mxlog_reader.Load(buf_[mxlog_buffer_reader_.buf_idx].get(), 0);
-        if (file_size == 0) {
-            LOG_WAL_ERROR_ << "load wal file error " << mxlog_buffer_reader_.file_no;
-            return WAL_FILE_ERROR;
+        auto error_code = LoadReaderFile();
+        if (error_code != WAL_SUCCESS) {
+            return error_code;
         }
-        mxlog_buffer_reader_.max_offset = file_size;
     }
 
     char* current_read_buf = buf_[mxlog_buffer_reader_.buf_idx].get();
     uint64_t current_read_offset = mxlog_buffer_reader_.buf_offset;
 
     MXLogRecordHeader* head = (MXLogRecordHeader*)(current_read_buf + current_read_offset);
-    record.type = (MXLogType)head->mxl_type;
+    bool compressed = (head->mxl_type & MXLogTypeCompressed) != 0;
+    record.type = (MXLogType)(head->mxl_type & (uint8_t)~MXLogTypeCompressed);
     record.lsn = head->mxl_lsn;
     record.length = head->vector_num;
     record.data_size = head->data_size;
@@ -454,17 +750,31 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
         record.partition_tag = "";
     }
 
-    if (head->vector_num != 0) {
-        record.ids = (IDNumber*)(current_read_buf + current_read_offset);
-        current_read_offset += head->vector_num * sizeof(IDNumber);
+    if (compressed) {
+        uint64_t ids_size = (uint64_t)head->vector_num * sizeof(IDNumber);
+        uint32_t record_end = uint32_t(head->mxl_lsn & LSN_OFFSET_MASK);
+        if (record_end < current_read_offset ||
+            !DecompressPayload(current_read_buf + current_read_offset, record_end - current_read_offset,
+                               {ids_size, record.data_size})) {
+            LOG_WAL_ERROR_ << "decompress wal record error, lsn " << head->mxl_lsn;
+            record.type = MXLogType::None;
+            return WAL_FILE_ERROR;
+        }
+        record.ids = (head->vector_num != 0) ? (IDNumber*)decompressed_.data() : nullptr;
+        record.data = (record.data_size != 0) ? decompressed_.data() + ids_size : nullptr;
     } else {
-        record.ids = nullptr;
-    }
+        if (head->vector_num != 0) {
+            record.ids = (IDNumber*)(current_read_buf + current_read_offset);
+            current_read_offset += head->vector_num * sizeof(IDNumber);
+        } else {
+            record.ids = nullptr;
+        }
 
-    if (record.data_size != 0) {
-        record.data = current_read_buf + current_read_offset;
-    } else {
-        record.data = nullptr;
+        if (record.data_size != 0) {
+            record.data = current_read_buf + current_read_offset;
+        } else {
+            record.data = nullptr;
+        }
     }
 
     mxlog_buffer_reader_.buf_offset = uint32_t(head->mxl_lsn & LSN_OFFSET_MASK);
@@ -483,7 +793,7 @@ MXLogBuffer::NextEntity(const uint64_t last_applied_lsn, milvus::engine::wal::MX
 
     // otherwise, it means there must exists next record, in buffer or wal log
     bool need_load_new = false;
-    std::unique_lock<std::mutex> lck(mutex_);
+    std::unique_lock<InstrumentedMutex> lck(mutex_);
     if (mxlog_buffer_reader_.file_no != mxlog_buffer_writer_.file_no) {
         if (mxlog_buffer_reader_.buf_offset == mxlog_buffer_reader_.max_offset) {  // last record
             mxlog_buffer_reader_.file_no++;
@@ -498,23 +808,19 @@ MXLogBuffer::NextEntity(const uint64_t last_applied_lsn, milvus::engine::wal::MX
     lck.unlock();
 
     if (need_load_new) {
-        MXLogFileHandler mxlog_reader(mxlog_writer_.GetFilePath());
-        mxlog_reader.SetFileName(ToFileName(mxlog_buffer_reader_.file_no));
-        mxlog_reader.SetFileOpenMode("r");
-        uint32_t file_size = mxlog_reader.Load(buf_[mxlog_buffer_reader_.buf_idx].get(), 0);
-        if (file_size == 0) {
-            LOG_WAL_ERROR_ << "load wal file error " << mxlog_buffer_reader_.file_no;
-            return WAL_FILE_ERROR;
+        auto error_code = LoadReaderFile();
+        if (error_code != WAL_SUCCESS) {
+            return error_code;
         }
-        mxlog_buffer_reader_.max_offset = file_size;
     }
 
     char* current_read_buf = buf_[mxlog_buffer_reader_.buf_idx].get();
     uint64_t current_read_offset = mxlog_buffer_reader_.buf_offset;
 
     MXLogRecordHeader* head = (MXLogRecordHeader*)(current_read_buf + current_read_offset);
+    bool compressed = (head->mxl_type & MXLogTypeCompressed) != 0;
 
-    record.type = (MXLogType)head->mxl_type;
+    record.type = (MXLogType)(head->mxl_type & (uint8_t)~MXLogTypeCompressed);
     record.lsn = head->mxl_lsn;
     record.length = head->vector_num;
     record.data_size = head->data_size;
@@ -553,18 +859,20 @@ MXLogBuffer::NextEntity(const uint64_t last_applied_lsn, milvus::engine::wal::MX
         record.partition_tag = "";
     }
 
-    if (head->vector_num != 0) {
-        record.ids = (IDNumber*)(current_read_buf + current_read_offset);
-        current_read_offset += head->vector_num * sizeof(IDNumber);
-    } else {
-        record.ids = nullptr;
-    }
+    if (!compressed) {
+        if (head->vector_num != 0) {
+            record.ids = (IDNumber*)(current_read_buf + current_read_offset);
+            current_read_offset += head->vector_num * sizeof(IDNumber);
+        } else {
+            record.ids = nullptr;
+        }
 
-    if (record.data_size != 0) {
-        record.data = current_read_buf + current_read_offset;
-        current_read_offset += record.data_size;
-    } else {
-        record.data = nullptr;
+        if (record.data_size != 0) {
+            record.data = current_read_buf + current_read_offset;
+            current_read_offset += record.data_size;
+        } else {
+            record.data = nullptr;
+        }
     }
 
     // Read field names
@@ -583,6 +891,24 @@ MXLogBuffer::NextEntity(const uint64_t last_applied_lsn, milvus::engine::wal::MX
         }
     }
 
+    const char* attr_values = current_read_buf + current_read_offset;
+    if (compressed) {
+        uint64_t ids_size = (uint64_t)head->vector_num * sizeof(IDNumber);
+        std::vector<uint64_t> section_sizes = {ids_size, record.data_size};
+        section_sizes.insert(section_sizes.end(), attr_head.attr_size.begin(), attr_head.attr_size.end());
+        uint32_t record_end = uint32_t(head->mxl_lsn & LSN_OFFSET_MASK);
+        if (record_end < current_read_offset ||
+            !DecompressPayload(current_read_buf + current_read_offset, record_end - current_read_offset,
+                               section_sizes)) {
+            LOG_WAL_ERROR_ << "decompress wal record error, lsn " << head->mxl_lsn;
+            record.type = MXLogType::None;
+            return WAL_FILE_ERROR;
+        }
+        record.ids = (head->vector_num != 0) ? (IDNumber*)decompressed_.data() : nullptr;
+        record.data = (record.data_size != 0) ? decompressed_.data() + ids_size : nullptr;
+        attr_values = (const char*)decompressed_.data() + ids_size + record.data_size;
+    }
+
     // Read attributes data
     record.attr_data.clear();
     record.attr_data_size.clear();
@@ -593,9 +919,9 @@ MXLogBuffer::NextEntity(const uint64_t last_applied_lsn, milvus::engine::wal::MX
             record.attr_data_size.insert(std::make_pair(record.field_names[i], attr_size));
             record.attr_nbytes.insert(std::make_pair(record.field_names[i], attr_head.attr_nbytes[i]));
             std::vector<uint8_t> data(attr_size);
-            memcpy(data.data(), current_read_buf + current_read_offset, attr_size);
+            memcpy(data.data(), attr_values, attr_size);
             record.attr_data.insert(std::make_pair(record.field_names[i], data));
-            current_read_offset += attr_size;
+            attr_values += attr_size;
         }
     }
 
@@ -616,12 +942,13 @@ MXLogBuffer::ResetWriteLsn(uint64_t lsn) {
 
     uint32_t old_file_no = mxlog_buffer_writer_.file_no;
     ParserLsn(lsn, mxlog_buffer_writer_.file_no, mxlog_buffer_writer_.buf_offset);
+    ResetReservation();
     if (old_file_no == mxlog_buffer_writer_.file_no) {
         LOG_WAL_DEBUG_ << "file No. is not changed";
         return true;
     }
 
-    std::unique_lock<std::mutex> lck(mutex_);
+    std::unique_lock<InstrumentedMutex> lck(mutex_);
     if (mxlog_buffer_writer_.file_no == mxlog_buffer_reader_.file_no) {
         mxlog_buffer_writer_.buf_idx = mxlog_buffer_reader_.buf_idx;
         LOG_WAL_DEBUG_ << "file No. is the same as reader";
@@ -629,10 +956,13 @@ MXLogBuffer::ResetWriteLsn(uint64_t lsn) {
     }
     lck.unlock();
 
+    std::unique_lock<InstrumentedMutex> file_lck(file_mutex_);
     if (!mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "r+")) {
         LOG_WAL_ERROR_ << "reborn file error " << mxlog_buffer_writer_.file_no;
         return false;
     }
+    writer_opened_.store(true, std::memory_order_release);
+    file_lck.unlock();
     if (!mxlog_writer_.Load(buf_[mxlog_buffer_writer_.buf_idx].get(), 0, mxlog_buffer_writer_.buf_offset)) {
         LOG_WAL_ERROR_ << "load file error";
         return false;
@@ -20,7 +20,9 @@
 #include "WalDefinations.h"
 #include "WalFileHandler.h"
 #include "WalMetaHandler.h"
+#include "utils/ContentionStats.h"
 #include "utils/Error.h"
+#include "utils/MemoryAccounting.h"
 
 namespace milvus {
 namespace engine {
@@ -40,6 +42,9 @@ struct MXLogRecordHeader {
 
 const uint32_t SizeOfMXLogRecordHeader = sizeof(MXLogRecordHeader);
 
+// set in mxl_type if the ids, vector data and attribute values of the record are encoded
+const uint8_t MXLogTypeCompressed = 0x80;
+
 struct MXLogAttrRecordHeader {
     uint32_t attr_num;
     std::vector<uint64_t> field_name_size;
@@ -71,6 +76,7 @@ class MXLogBuffer {
     Reset(uint64_t lsn);
 
     // Note: record.lsn will be set inner
+    // appends may run concurrently, they are not allowed to run with Init, Reset or ResetWriteLsn
     ErrorCode
     Append(MXLogRecord& record);
 
@@ -98,10 +104,51 @@ class MXLogBuffer {
     uint32_t
     GetBufferSize();
 
+    // the size of the wal files written after the next switch, the buffers follow it as they are switched to
+    void
+    SetBufferSize(uint32_t buffer_size);
+
     uint32_t
     SurplusSpace();
 
+    // sync the current wal file, a switched out file is synced before it is closed if sync_on_switch is set
+    bool
+    Sync();
+
+    void
+    SetSyncOnSwitch(bool sync_on_switch);
+
+    // encode the payload of appended records if it makes them smaller
+    void
+    SetCompress(bool compress);
+
  private:
+    // reserve record_size bytes in the current wal file, begin_lsn is the start of the reserved space
+    ErrorCode
+    Reserve(uint32_t record_size, uint64_t& begin_lsn);
+
+    // publish a record after all the records before it, the reader only sees a contiguous prefix
+    void
+    Commit(uint64_t begin_lsn, uint64_t end_lsn);
+
+    // switch to the next wal file once full_lsn is the reserved end of the current one
+    bool
+    SwitchFile(uint64_t full_lsn);
+
+    bool
+    WriteRecord(const char* data, uint32_t size, uint32_t offset);
+
+    // load the reader's file from disk, its buffer grows if the file was written with a bigger buffer size
+    ErrorCode
+    LoadReaderFile();
+
+    void
+    AllocBuffer(uint8_t buf_idx, uint32_t size);
+
+    // the writer handler was set by a single thread, restart the reservations from it
+    void
+    ResetReservation();
+
     uint32_t
     RecordSize(const MXLogRecord& record);
 
@@ -109,14 +156,41 @@ class MXLogBuffer {
     EntityRecordSize(const milvus::engine::wal::MXLogRecord& record, uint32_t attr_num,
                      std::vector<uint32_t>& field_name_size);
 
+    // encode ids, vector data and for entity records the attribute values into compressed
+    // return false if the encoded payload is not smaller
+    bool
+    CompressPayload(const MXLogRecord& record, bool entity, uint64_t payload_size, std::vector<uint8_t>& compressed);
+
+    // decode a compressed payload of the given raw section sizes into decompressed_
+    bool
+    DecompressPayload(const char* payload, uint32_t payload_size, const std::vector<uint64_t>& section_sizes);
+
  private:
-    uint32_t mxlog_buffer_size_;  // from config
+    std::atomic<uint32_t> mxlog_buffer_size_;     // from config
+    std::atomic<uint32_t> pending_buffer_size_{0};  // set live, applied on the next switch
     BufferPtr buf_[2];
-    std::mutex mutex_;
+    std::atomic<uint32_t> buf_capacity_[2] = {{0}, {0}};
+    TrackedMemory buffer_memory_{MemorySubsystem::WAL_BUFFER};  // both buffers of buf_
+    InstrumentedMutex mutex_{"wal.buffer"};
     uint32_t file_no_from_;
     MXLogBufferHandler mxlog_buffer_reader_;
     MXLogBufferHandler mxlog_buffer_writer_;
     MXLogFileHandler mxlog_writer_;
+
+    // guards the file of mxlog_writer_ against the sync thread
+    InstrumentedMutex file_mutex_{"wal.file"};
+    bool sync_on_switch_ = false;
+
+    // producers reserve space by advancing reserved_lsn_ and publish their records by advancing committed_lsn_
+    // in lsn order, mxlog_buffer_writer_.buf_offset follows committed_lsn_
+    std::atomic<uint64_t> reserved_lsn_{0};
+    std::atomic<uint64_t> committed_lsn_{0};
+    InstrumentedMutex switch_mutex_{"wal.switch"};
+    std::atomic<bool> writer_opened_{false};
+
+    bool compress_ = false;
+    // payload of the last compressed record read, the ids and data of that record point into it
+    std::vector<uint8_t> decompressed_;
 };
 
 using MXLogBufferPtr = std::shared_ptr<MXLogBuffer>;
@@ -52,10 +52,19 @@ struct MXLogRecord {
     engine::DataChunkPtr data_chunk;  // for hybird data transfer
 };
 
+enum class MXLogSyncMode {
+    NONE,      // never sync, the OS writes the files back
+    INTERVAL,  // a background thread syncs periodically
+    BATCH,     // writers wait for the sync of their records, one sync serves all the writers of a batch
+};
+
 struct MXLogConfiguration {
     bool recovery_error_ignore;
     uint32_t buffer_size;
     std::string mxlog_path;
+    MXLogSyncMode sync_mode = MXLogSyncMode::NONE;
+    uint32_t sync_interval = 10;  // ms
+    bool compress = false;
 };
 
 }  // namespace wal
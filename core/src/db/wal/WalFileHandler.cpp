@@ -14,6 +14,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <cerrno>
+
 namespace milvus {
 namespace engine {
 namespace wal {
@@ -73,6 +75,36 @@ MXLogFileHandler::Write(char* buf, uint32_t data_size, bool is_sync) {
     return (written_size == data_size);
 }
 
+bool
+MXLogFileHandler::WriteAt(const char* buf, uint32_t data_size, uint32_t data_offset) {
+    if (p_file_ == nullptr) {
+        return false;
+    }
+
+    int fd = fileno(p_file_);
+    while (data_size > 0) {
+        auto written_size = pwrite(fd, buf, data_size, data_offset);
+        if (written_size <= 0) {
+            if (written_size < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf += written_size;
+        data_size -= written_size;
+        data_offset += written_size;
+    }
+    return true;
+}
+
+bool
+MXLogFileHandler::Sync() {
+    if (p_file_ == nullptr) {
+        return true;
+    }
+    return fdatasync(fileno(p_file_)) == 0;
+}
+
 bool
 MXLogFileHandler::ReBorn(const std::string& file_name, const std::string& open_mode) {
     CloseFile();
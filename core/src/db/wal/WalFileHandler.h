@@ -38,6 +38,12 @@ class MXLogFileHandler {
     Load(char* buf, uint32_t data_offset, uint32_t data_size);
     bool
     Write(char* buf, uint32_t data_size, bool is_sync = false);
+    // write at the given offset of the opened file, several threads may write different ranges at the same time
+    bool
+    WriteAt(const char* buf, uint32_t data_size, uint32_t data_offset);
+    // flush the written data of the opened file to disk
+    bool
+    Sync();
     bool
     ReBorn(const std::string& file_name, const std::string& open_mode);
     uint32_t
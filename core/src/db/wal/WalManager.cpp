@@ -14,6 +14,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 
@@ -34,6 +35,9 @@ WalManager::WalManager(const MXLogConfiguration& config) {
     mxlog_config_.recovery_error_ignore = config.recovery_error_ignore;
     mxlog_config_.buffer_size = config.buffer_size;
     mxlog_config_.mxlog_path = config.mxlog_path;
+    mxlog_config_.sync_mode = config.sync_mode;
+    mxlog_config_.sync_interval = std::max(config.sync_interval, (uint32_t)1);
+    mxlog_config_.compress = config.compress;
 
     // check the path end with '/'
     if (mxlog_config_.mxlog_path.back() != '/') {
@@ -49,6 +53,7 @@ WalManager::WalManager(const MXLogConfiguration& config) {
 }
 
 WalManager::~WalManager() {
+    StopSync();
 }
 
 ErrorCode
@@ -63,6 +68,7 @@ WalManager::Init(const meta::MetaPtr& meta) {
     if (meta != nullptr) {
         meta->GetGlobalLastLSN(recovery_start);
 
+        // the collections and their partitions in one scan of the meta, rather than a query per collection
         std::vector<meta::CollectionSchema> collention_schema_array;
         auto status = meta->AllCollections(collention_schema_array);
         if (!status.ok()) {
@@ -82,18 +88,14 @@ WalManager::Init(const meta::MetaPtr& meta) {
             };
 
             for (auto& col_schema : collention_schema_array) {
-                auto& collection = collections_[col_schema.collection_id_];
-                auto& default_part = collection[""];
+                auto& default_part = collections_[col_schema.collection_id_][""];
                 default_part.flush_lsn = col_schema.flush_lsn_;
                 update_limit_lsn(default_part.flush_lsn);
-
-                std::vector<meta::CollectionSchema> partition_schema_array;
-                status = meta->ShowPartitions(col_schema.collection_id_, partition_schema_array);
-                if (!status.ok()) {
-                    return WAL_META_ERROR;
-                }
-                for (auto& par_schema : partition_schema_array) {
-                    auto& partition = collection[par_schema.partition_tag_];
+            }
+            for (auto& par_schema : collention_schema_array) {
+                auto iter = collections_.find(par_schema.owner_collection_);
+                if (!par_schema.owner_collection_.empty() && iter != collections_.end()) {
+                    auto& partition = iter->second[par_schema.partition_tag_];
                     partition.flush_lsn = par_schema.flush_lsn_;
                     update_limit_lsn(partition.flush_lsn);
                 }
@@ -124,6 +126,7 @@ WalManager::Init(const meta::MetaPtr& meta) {
     ErrorCode error_code = WAL_ERROR;
     p_buffer_ = std::make_shared<MXLogBuffer>(mxlog_config_.mxlog_path, mxlog_config_.buffer_size);
     if (p_buffer_ != nullptr) {
+        p_buffer_->SetCompress(mxlog_config_.compress);
         if (p_buffer_->Init(recovery_start, applied_lsn)) {
             error_code = WAL_SUCCESS;
         } else if (mxlog_config_.recovery_error_ignore) {
@@ -138,6 +141,10 @@ WalManager::Init(const meta::MetaPtr& meta) {
     mxlog_config_.buffer_size = p_buffer_->GetBufferSize();
 
     last_applied_lsn_ = applied_lsn;
+    recovery_start_lsn_ = recovery_start;
+    if (error_code == WAL_SUCCESS) {
+        StartSync();
+    }
     return error_code;
 }
 
@@ -219,6 +226,7 @@ WalManager::Init() {
     ErrorCode error_code = WAL_ERROR;
     p_buffer_ = std::make_shared<MXLogBuffer>(mxlog_config_.mxlog_path, mxlog_config_.buffer_size);
     if (p_buffer_ != nullptr) {
+        p_buffer_->SetCompress(mxlog_config_.compress);
         if (p_buffer_->Init(recovery_start, applied_lsn)) {
             error_code = WAL_SUCCESS;
         } else if (mxlog_config_.recovery_error_ignore) {
@@ -233,6 +241,10 @@ WalManager::Init() {
     mxlog_config_.buffer_size = p_buffer_->GetBufferSize();
 
     last_applied_lsn_ = applied_lsn;
+    recovery_start_lsn_ = recovery_start;
+    if (error_code == WAL_SUCCESS) {
+        StartSync();
+    }
     return error_code;
 }
 
@@ -275,6 +287,22 @@ WalManager::GetNextRecovery(MXLogRecord& record) {
     return error_code;
 }
 
+double
+WalManager::RecoveryProgress(uint64_t lsn) {
+    // lsn is file_no << 32 | offset and a file holds at most one buffer, so the lsn is mapped to a byte position
+    uint64_t buffer_size = p_buffer_->GetBufferSize();
+    auto position = [&](uint64_t value) -> double {
+        return (double)(value >> 32) * buffer_size + (double)(value & 0xFFFFFFFF);
+    };
+
+    double total = position(last_applied_lsn_) - position(recovery_start_lsn_);
+    if (total <= 0) {
+        return 1.0;
+    }
+    double progress = (position(lsn) - position(recovery_start_lsn_)) / total;
+    return std::min(std::max(progress, 0.0), 1.0);
+}
+
 ErrorCode
 WalManager::GetNextEntityRecovery(milvus::engine::wal::MXLogRecord& record) {
     ErrorCode error_code = WAL_SUCCESS;
@@ -500,7 +528,7 @@ WalManager::CollectionUpdated(const std::string& collection_id, uint64_t lsn) {
     auto it_col = collections_.find(collection_id);
     if (it_col != collections_.end()) {
         for (auto& part : it_col->second) {
-            part.second.wal_lsn = lsn;
+            part.second.wal_lsn = std::max(part.second.wal_lsn, lsn);
         }
     }
     lck.unlock();
@@ -513,12 +541,19 @@ WalManager::PartitionUpdated(const std::string& collection_id, const std::string
     if (it_col != collections_.end()) {
         auto it_part = it_col->second.find(partition_tag);
         if (it_part != it_col->second.end()) {
-            it_part->second.wal_lsn = lsn;
+            it_part->second.wal_lsn = std::max(it_part->second.wal_lsn, lsn);
         }
     }
     lck.unlock();
 }
 
+void
+WalManager::UpdateAppliedLsn(uint64_t lsn) {
+    uint64_t applied_lsn = last_applied_lsn_.load();
+    while (applied_lsn < lsn && !last_applied_lsn_.compare_exchange_weak(applied_lsn, lsn)) {
+    }
+}
+
 template <typename T>
 bool
 WalManager::Insert(const std::string& collection_id, const std::string& partition_tag, const IDNumbers& vector_ids,
@@ -574,7 +609,7 @@ WalManager::Insert(const std::string& collection_id, const std::string& partitio
         new_lsn = record.lsn;
     }
 
-    last_applied_lsn_ = new_lsn;
+    UpdateAppliedLsn(new_lsn);
     PartitionUpdated(collection_id, partition_tag, new_lsn);
 
     LOG_WAL_INFO_ << LogOut("[%s][%ld]", "insert", 0) << collection_id << " insert in part " << partition_tag
@@ -661,7 +696,7 @@ WalManager::InsertEntities(const std::string& collection_id, const std::string&
         new_lsn = record.lsn;
     }
 
-    last_applied_lsn_ = new_lsn;
+    UpdateAppliedLsn(new_lsn);
     PartitionUpdated(collection_id, partition_tag, new_lsn);
 
     LOG_WAL_INFO_ << LogOut("[%s][%ld]", "insert", 0) << collection_id << " insert in part " << partition_tag
@@ -709,7 +744,7 @@ WalManager::DeleteById(const std::string& collection_id, const IDNumbers& vector
         new_lsn = record.lsn;
     }
 
-    last_applied_lsn_ = new_lsn;
+    UpdateAppliedLsn(new_lsn);
     CollectionUpdated(collection_id, new_lsn);
 
     LOG_WAL_INFO_ << collection_id << " delete rows by id, lsn " << new_lsn;
@@ -760,6 +795,130 @@ WalManager::Flush(const std::string& collection_id) {
     return lsn;
 }
 
+ErrorCode
+WalManager::WaitSynced() {
+    if (mxlog_config_.sync_mode != MXLogSyncMode::BATCH) {
+        return WAL_SUCCESS;
+    }
+
+    std::unique_lock<std::mutex> lck(sync_mutex_);
+    uint64_t lsn = last_applied_lsn_;
+    if (!sync_running_ || lsn <= synced_lsn_) {
+        return WAL_SUCCESS;
+    }
+
+    if (lsn > sync_request_lsn_) {
+        sync_request_lsn_ = lsn;
+        sync_cv_.notify_one();
+    }
+    while (synced_lsn_ < lsn && sync_running_) {
+        // a round may have started before the records arrived, then wait for the next one
+        uint64_t round = sync_round_;
+        synced_cv_.wait(lck, [&] { return synced_lsn_ >= lsn || !sync_running_ || sync_round_ != round; });
+        if (synced_lsn_ < lsn && sync_failed_) {
+            break;
+        }
+    }
+    return synced_lsn_ >= lsn ? WAL_SUCCESS : WAL_FILE_ERROR;
+}
+
+void
+WalManager::SetBufferSize(uint32_t buffer_size) {
+    mxlog_config_.buffer_size = buffer_size;
+    if (p_buffer_ != nullptr) {
+        p_buffer_->SetBufferSize(buffer_size * UNIT_MB);
+    }
+}
+
+MXLogSyncMode
+WalManager::ParseSyncMode(const std::string& mode) {
+    if (mode == "batch") {
+        return MXLogSyncMode::BATCH;
+    } else if (mode == "interval") {
+        return MXLogSyncMode::INTERVAL;
+    }
+    return MXLogSyncMode::NONE;
+}
+
+void
+WalManager::StartSync() {
+    if (mxlog_config_.sync_mode == MXLogSyncMode::NONE) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lck(sync_mutex_);
+    if (sync_running_) {
+        return;
+    }
+    p_buffer_->SetSyncOnSwitch(true);
+    synced_lsn_ = last_applied_lsn_;
+    sync_request_lsn_ = synced_lsn_;
+    sync_running_ = true;
+    sync_thread_ = std::thread(&WalManager::SyncFunction, this);
+}
+
+void
+WalManager::StopSync() {
+    {
+        std::lock_guard<std::mutex> lck(sync_mutex_);
+        if (!sync_running_) {
+            return;
+        }
+        sync_running_ = false;
+    }
+    sync_cv_.notify_all();
+    sync_thread_.join();
+
+    // the records appended since the last round
+    uint64_t lsn = last_applied_lsn_;
+    if (p_buffer_->Sync()) {
+        std::lock_guard<std::mutex> lck(sync_mutex_);
+        synced_lsn_ = std::max(synced_lsn_, lsn);
+    }
+    synced_cv_.notify_all();
+}
+
+void
+WalManager::SyncFunction() {
+    SetThreadName("wal_sync");
+    auto interval = std::chrono::milliseconds(mxlog_config_.sync_interval);
+    bool batch = (mxlog_config_.sync_mode == MXLogSyncMode::BATCH);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lck(sync_mutex_);
+            if (batch) {
+                sync_cv_.wait(lck, [&] { return !sync_running_ || sync_request_lsn_ > synced_lsn_; });
+                if (!sync_running_) {
+                    break;
+                }
+                // the batch window, the records of the inserts arriving meanwhile are synced together
+                sync_cv_.wait_for(lck, interval, [&] { return !sync_running_; });
+            } else {
+                sync_cv_.wait_for(lck, interval, [&] { return !sync_running_; });
+            }
+            if (!sync_running_) {
+                break;
+            }
+        }
+
+        uint64_t lsn = last_applied_lsn_;
+        bool synced = true;
+        if (lsn > synced_lsn_) {
+            synced = p_buffer_->Sync();
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(sync_mutex_);
+            if (synced && lsn > synced_lsn_) {
+                synced_lsn_ = lsn;
+            }
+            sync_failed_ = !synced;
+            ++sync_round_;
+        }
+        synced_cv_.notify_all();
+    }
+}
+
 void
 WalManager::RemoveOldFiles(uint64_t flushed_lsn) {
     if (p_buffer_ != nullptr) {
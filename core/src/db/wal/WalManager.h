@@ -12,8 +12,11 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -55,6 +58,14 @@ class WalManager {
     ErrorCode
     GetNextEntityRecovery(MXLogRecord& record);
 
+    /*
+     * Recovery progress
+     * @param lsn: lsn of the last recovered record
+     * @retval ratio of the recovered records, from 0 to 1
+     */
+    double
+    RecoveryProgress(uint64_t lsn);
+
     /*
      * Get next record
      * @param record[out]: record
@@ -143,6 +154,10 @@ class WalManager {
     void
     PartitionUpdated(const std::string& collection_id, const std::string& partition_tag, uint64_t lsn);
 
+    // raise last_applied_lsn_ to lsn, appends may finish out of lsn order
+    void
+    UpdateAppliedLsn(uint64_t lsn);
+
     /*
      * Insert
      * @param collection_id: collection id
@@ -190,10 +205,38 @@ class WalManager {
     void
     RemoveOldFiles(uint64_t flushed_lsn);
 
+    /*
+     * Wait until the records appended before the call are synced to disk
+     * Return at once unless the sync mode is batch
+     * @retval error_code
+     */
+    ErrorCode
+    WaitSynced();
+
+    /*
+     * Change the size of each of the two buffers, it applies from the next wal file
+     * @param buffer_size: size in MB
+     */
+    void
+    SetBufferSize(uint32_t buffer_size);
+
+    // none, interval or batch, see MXLogSyncMode
+    static MXLogSyncMode
+    ParseSyncMode(const std::string& mode);
+
  private:
     WalManager
     operator=(WalManager&);
 
+    void
+    StartSync();
+
+    void
+    StopSync();
+
+    void
+    SyncFunction();
+
     MXLogConfiguration mxlog_config_;
 
     MXLogBufferPtr p_buffer_;
@@ -206,6 +249,7 @@ class WalManager {
     std::mutex mutex_;
     std::map<std::string, std::map<std::string, TableLsn>> collections_;
     std::atomic<uint64_t> last_applied_lsn_;
+    uint64_t recovery_start_lsn_ = 0;
 
     // if multi-thread call Flush(), use list
     struct FlushInfo {
@@ -222,6 +266,17 @@ class WalManager {
         }
     };
     FlushInfo flush_info_;
+
+    // sync thread, see MXLogSyncMode
+    std::thread sync_thread_;
+    std::mutex sync_mutex_;
+    std::condition_variable sync_cv_;
+    std::condition_variable synced_cv_;
+    bool sync_running_ = false;
+    bool sync_failed_ = false;
+    uint64_t sync_round_ = 0;
+    uint64_t sync_request_lsn_ = 0;
+    uint64_t synced_lsn_ = 0;
 };
 
 extern template bool
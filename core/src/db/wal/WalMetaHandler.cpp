@@ -54,6 +54,11 @@ MXLogMetaHandler::GetMXLogInternalMeta(uint64_t& wal_lsn) {
 
 bool
 MXLogMetaHandler::SetMXLogInternalMeta(uint64_t wal_lsn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (wal_lsn < latest_wal_lsn_) {
+        return true;
+    }
+
     if (wal_meta_fp_ != nullptr) {
         uint64_t all_wal_lsn[3] = {latest_wal_lsn_, wal_lsn, wal_lsn};
         fseek(wal_meta_fp_, 0, SEEK_SET);
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -35,10 +36,12 @@ class MXLogMetaHandler {
     bool
     GetMXLogInternalMeta(uint64_t& wal_lsn);
 
+    // an lsn lower than the latest one is ignored, the appends may finish out of order
     bool
     SetMXLogInternalMeta(uint64_t wal_lsn);
 
  private:
+    std::mutex mutex_;
     FILE* wal_meta_fp_;
     uint64_t latest_wal_lsn_ = 0;
 };
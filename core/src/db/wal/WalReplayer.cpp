@@ -0,0 +1,119 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/wal/WalReplayer.h"
+
+#include <string>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+namespace wal {
+
+MXLogReplayer::MXLogReplayer(int64_t thread_num, const ReplayFunc& replay)
+    : replay_(replay), workers_(thread_num > 1 ? thread_num : 0) {
+    for (auto& worker : workers_) {
+        worker.thread_ = std::thread(&MXLogReplayer::WorkerFunction, this, std::ref(worker));
+    }
+}
+
+MXLogReplayer::~MXLogReplayer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    for (auto& worker : workers_) {
+        worker.cv_.notify_one();
+        worker.thread_.join();
+    }
+}
+
+void
+MXLogReplayer::Dispatch(const MXLogRecord& record) {
+    if (workers_.empty()) {
+        Replay(record);
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++replayed_;
+        return;
+    }
+
+    auto item = std::make_shared<Item>();
+    item->record_ = record;
+    if (record.ids != nullptr && record.length > 0) {
+        item->ids_.assign(record.ids, record.ids + record.length);
+        item->record_.ids = item->ids_.data();
+    }
+    if (record.data != nullptr && record.data_size > 0) {
+        auto data = static_cast<const uint8_t*>(record.data);
+        item->data_.assign(data, data + record.data_size);
+        item->record_.data = item->data_.data();
+    }
+
+    auto& worker = workers_[std::hash<std::string>()(record.collection_id) % workers_.size()];
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        worker.queue_.emplace_back(item);
+        ++pending_;
+    }
+    worker.cv_.notify_one();
+}
+
+void
+MXLogReplayer::Barrier() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&] { return pending_ == 0; });
+}
+
+uint64_t
+MXLogReplayer::ReplayedCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return replayed_;
+}
+
+void
+MXLogReplayer::Replay(const MXLogRecord& record) {
+    auto status = replay_(record);
+    if (!status.ok()) {
+        LOG_WAL_ERROR_ << "Failed to replay record lsn " << record.lsn << " of " << record.collection_id << ": "
+                       << status.message();
+    }
+}
+
+void
+MXLogReplayer::WorkerFunction(Worker& worker) {
+    SetThreadName("wal_replay");
+    while (true) {
+        ItemPtr item;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            worker.cv_.wait(lock, [&] { return !running_ || !worker.queue_.empty(); });
+            if (worker.queue_.empty()) {
+                return;
+            }
+            item = worker.queue_.front();
+            worker.queue_.pop_front();
+        }
+
+        Replay(item->record_);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++replayed_;
+            --pending_;
+        }
+        done_cv_.notify_all();
+    }
+}
+
+}  // namespace wal
+}  // namespace engine
+}  // namespace milvus
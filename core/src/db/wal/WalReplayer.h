@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "db/wal/WalDefinations.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+namespace wal {
+
+/*
+ * Replays recovered records on a group of threads.
+ * Records are partitioned by collection id, so the records of a collection and its partitions are replayed
+ * by one thread in lsn order while different collections are replayed in parallel.
+ * With thread_num <= 1 the records are replayed in the calling thread.
+ */
+class MXLogReplayer {
+ public:
+    using ReplayFunc = std::function<Status(const MXLogRecord& record)>;
+
+    MXLogReplayer(int64_t thread_num, const ReplayFunc& replay);
+    ~MXLogReplayer();
+
+    /*
+     * Replay a record asynchronously
+     * the record points into the wal buffer which is reused by the next read, its data is copied
+     * @param record: record
+     */
+    void
+    Dispatch(const MXLogRecord& record);
+
+    /*
+     * Wait until all the dispatched records are replayed
+     */
+    void
+    Barrier();
+
+    // number of replayed records, including the failed ones
+    uint64_t
+    ReplayedCount();
+
+ private:
+    struct Item {
+        MXLogRecord record_;
+        std::vector<IDNumber> ids_;
+        std::vector<uint8_t> data_;
+    };
+    using ItemPtr = std::shared_ptr<Item>;
+
+    struct Worker {
+        std::deque<ItemPtr> queue_;
+        std::condition_variable cv_;
+        std::thread thread_;
+    };
+
+    void
+    Replay(const MXLogRecord& record);
+
+    void
+    WorkerFunction(Worker& worker);
+
+ private:
+    ReplayFunc replay_;
+    std::vector<Worker> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+    bool running_ = true;
+    uint64_t pending_ = 0;
+    uint64_t replayed_ = 0;
+};
+
+}  // namespace wal
+}  // namespace engine
+}  // namespace milvus
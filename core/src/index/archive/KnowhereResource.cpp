@@ -16,6 +16,7 @@
 
 #include "config/Config.h"
 #include "faiss/FaissHook.h"
+#include "faiss/utils/HugePage.h"
 #include "scheduler/Utils.h"
 #include "utils/Error.h"
 #include "utils/Log.h"
@@ -62,6 +63,9 @@ KnowhereResource::Initialize() {
         return Status(KNOWHERE_UNEXPECTED_ERROR, "FAISS hook fail, CPU not supported!");
     }
 
+    STATUS_CHECK(config.GetEngineConfigHugePage(faiss::faiss_use_huge_page));
+    LOG_ENGINE_DEBUG_ << "Huge pages for index memory: " << faiss::faiss_use_huge_page;
+
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = false;
     STATUS_CHECK(config.GetGpuResourceConfigEnable(enable_gpu));
@@ -70,7 +74,8 @@ KnowhereResource::Initialize() {
         return Status::OK();
 
     struct GpuResourceSetting {
-        int64_t pinned_memory = 256 * M_BYTE;
+        // staging of the queries searched from host memory, two pages of PAGED_SEARCH_MIN_BYTES
+        int64_t pinned_memory = 32 * M_BYTE;
         int64_t temp_memory = 256 * M_BYTE;
         int64_t resource_num = 2;
     };
@@ -0,0 +1,504 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifdef KNOWHERE_BENCHMARK_WITH_HDF5
+#include <hdf5.h>
+#endif
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/IndexType.h"
+#include "knowhere/index/vector_index/ConfAdapter.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+namespace knowhere = milvus::knowhere;
+using milvus::knowhere::KnowhereException;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// the command line options besides those of google benchmark
+struct Options {
+    std::string dataset;      // an ann-benchmarks .hdf5 file or a .fvecs file, random vectors if empty
+    std::string query;        // the .fvecs queries of a .fvecs dataset, its first vectors if empty
+    std::string groundtruth;  // the .ivecs neighbors of the queries, computed by brute force if empty
+    std::vector<std::string> index_types;
+    int64_t topk = 10;
+    int64_t nq = 1000;     // at most this many queries are searched
+    int64_t rows = 100000;  // of the random dataset
+    int64_t dim = 128;      // of the random dataset
+};
+
+struct Data {
+    int64_t dim = 0;
+    int64_t nb = 0;
+    int64_t nq = 0;
+    std::string metric = knowhere::Metric::L2;
+    std::vector<float> xb;
+    std::vector<int64_t> ids;
+    std::vector<float> xq;
+    int64_t gt_k = 0;
+    std::vector<int64_t> gt;  // the gt_k nearest ids of every query
+};
+
+// an index type with its build params and the search param whose values make the recall curve
+struct IndexSpec {
+    knowhere::IndexType type;
+    knowhere::Config build;
+    std::string search_param;
+    std::vector<int64_t> search_values;
+};
+
+struct BuiltIndex {
+    knowhere::VecIndexPtr index;
+    double build_seconds = 0;
+    int64_t index_bytes = 0;  // the serialized size, what a segment of the index takes on disk and in the cache
+    int64_t rss_bytes = 0;    // the growth of the resident memory during the build
+};
+
+Options options;
+Data data;
+std::map<knowhere::IndexType, BuiltIndex> built_indexes;
+
+int64_t
+ResidentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    int64_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+void
+Normalize(std::vector<float>& vectors, int64_t dim) {
+    for (size_t i = 0; i < vectors.size(); i += dim) {
+        double norm = 0;
+        for (int64_t j = 0; j < dim; ++j) {
+            norm += vectors[i + j] * vectors[i + j];
+        }
+        norm = std::sqrt(norm);
+        if (norm > 0) {
+            for (int64_t j = 0; j < dim; ++j) {
+                vectors[i + j] /= norm;
+            }
+        }
+    }
+}
+
+// the .fvecs and .ivecs formats: every vector is its int32 dimension followed by its components
+template <typename T>
+std::vector<T>
+ReadVecs(const std::string& path, int64_t& dim, int64_t& count) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        KNOWHERE_THROW_MSG("Failed to open " + path);
+    }
+    std::vector<T> vectors;
+    int32_t d = 0;
+    count = 0;
+    while (file.read(reinterpret_cast<char*>(&d), sizeof(d))) {
+        dim = d;
+        vectors.resize((count + 1) * dim);
+        file.read(reinterpret_cast<char*>(vectors.data() + count * dim), dim * sizeof(T));
+        ++count;
+    }
+    return vectors;
+}
+
+#ifdef KNOWHERE_BENCHMARK_WITH_HDF5
+template <typename T>
+std::vector<T>
+ReadHdf5Dataset(hid_t file, const char* name, hid_t mem_type, int64_t& rows, int64_t& cols) {
+    hid_t dataset = H5Dopen2(file, name, H5P_DEFAULT);
+    if (dataset < 0) {
+        KNOWHERE_THROW_MSG(std::string("No dataset ") + name + " in the hdf5 file");
+    }
+    hid_t space = H5Dget_space(dataset);
+    hsize_t dims[2] = {0, 0};
+    H5Sget_simple_extent_dims(space, dims, nullptr);
+    rows = dims[0];
+    cols = dims[1];
+    std::vector<T> values(rows * cols);
+    H5Dread(dataset, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Sclose(space);
+    H5Dclose(dataset);
+    return values;
+}
+
+std::string
+ReadHdf5StringAttribute(hid_t file, const char* name) {
+    std::string value;
+    if (H5Aexists(file, name) <= 0) {
+        return value;
+    }
+    hid_t attribute = H5Aopen(file, name, H5P_DEFAULT);
+    hid_t type = H5Aget_type(attribute);
+    if (H5Tis_variable_str(type) > 0) {
+        char* str = nullptr;
+        if (H5Aread(attribute, type, &str) >= 0 && str != nullptr) {
+            value = str;
+            H5free_memory(str);
+        }
+    } else {
+        std::vector<char> buffer(H5Tget_size(type) + 1, 0);
+        H5Aread(attribute, type, buffer.data());
+        value = buffer.data();
+    }
+    H5Tclose(type);
+    H5Aclose(attribute);
+    return value;
+}
+
+// train, test and neighbors of an ann-benchmarks file, angular distances are inner products of unit vectors
+void
+LoadHdf5(const std::string& path) {
+    hid_t file = H5Fopen(path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0) {
+        KNOWHERE_THROW_MSG("Failed to open " + path);
+    }
+    int64_t cols = 0;
+    data.xb = ReadHdf5Dataset<float>(file, "train", H5T_NATIVE_FLOAT, data.nb, data.dim);
+    data.xq = ReadHdf5Dataset<float>(file, "test", H5T_NATIVE_FLOAT, data.nq, cols);
+    auto neighbors = ReadHdf5Dataset<int32_t>(file, "neighbors", H5T_NATIVE_INT32, data.nq, data.gt_k);
+    data.gt.assign(neighbors.begin(), neighbors.end());
+    if (ReadHdf5StringAttribute(file, "distance") == "angular") {
+        data.metric = knowhere::Metric::IP;
+        Normalize(data.xb, data.dim);
+        Normalize(data.xq, data.dim);
+    }
+    H5Fclose(file);
+}
+#endif
+
+void
+ComputeGroundTruth() {
+    data.gt_k = std::min<int64_t>(100, data.nb);
+    knowhere::Config conf{{knowhere::meta::DIM, data.dim},
+                          {knowhere::meta::TOPK, data.gt_k},
+                          {knowhere::Metric::TYPE, data.metric}};
+    auto index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IDMAP);
+    index->Train(knowhere::DatasetPtr(), conf);
+    index->AddWithoutIds(knowhere::GenDataset(data.nb, data.dim, data.xb.data()), conf);
+    auto result = index->Query(knowhere::GenDataset(data.nq, data.dim, data.xq.data()), conf);
+    auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    data.gt.assign(ids, ids + data.nq * data.gt_k);
+    free(ids);
+    free(result->Get<float*>(knowhere::meta::DISTANCE));
+}
+
+void
+LoadData() {
+    bool has_groundtruth = false;
+    if (options.dataset.empty()) {
+        data.dim = options.dim;
+        data.nb = options.rows;
+        data.nq = options.nq;
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> distribution(0, 1);
+        data.xb.resize(data.nb * data.dim);
+        data.xq.resize(data.nq * data.dim);
+        std::generate(data.xb.begin(), data.xb.end(), [&] { return distribution(rng); });
+        std::generate(data.xq.begin(), data.xq.end(), [&] { return distribution(rng); });
+    } else if (options.dataset.size() > 5 && options.dataset.substr(options.dataset.size() - 5) == ".hdf5") {
+#ifdef KNOWHERE_BENCHMARK_WITH_HDF5
+        LoadHdf5(options.dataset);
+        has_groundtruth = true;
+#else
+        KNOWHERE_THROW_MSG("The benchmark is built without hdf5, " + options.dataset + " can't be read");
+#endif
+    } else {
+        data.xb = ReadVecs<float>(options.dataset, data.dim, data.nb);
+        if (options.query.empty()) {
+            data.nq = std::min(options.nq, data.nb);
+            data.xq.assign(data.xb.begin(), data.xb.begin() + data.nq * data.dim);
+        } else {
+            int64_t dim = 0;
+            data.xq = ReadVecs<float>(options.query, dim, data.nq);
+        }
+        if (!options.groundtruth.empty()) {
+            auto neighbors = ReadVecs<int32_t>(options.groundtruth, data.gt_k, data.nq);
+            data.gt.assign(neighbors.begin(), neighbors.end());
+            has_groundtruth = true;
+        }
+    }
+
+    if (data.nq > options.nq) {
+        data.xq.resize(options.nq * data.dim);
+        if (has_groundtruth) {
+            data.gt.resize(options.nq * data.gt_k);
+        }
+        data.nq = options.nq;
+    }
+    data.ids.resize(data.nb);
+    for (int64_t i = 0; i < data.nb; ++i) {
+        data.ids[i] = i;
+    }
+    if (!has_groundtruth) {
+        ComputeGroundTruth();
+    }
+}
+
+// the indexes which search float vectors on the cpu, DISKANN works on files of its own and is left out
+std::vector<IndexSpec>
+IndexSpecs() {
+    std::vector<int64_t> nprobes{1, 4, 16, 64, 256};
+    std::vector<int64_t> efs{16, 32, 64, 128, 256, 512};
+
+    // about 4 dimensions per sub-quantizer
+    std::vector<int64_t> m_list;
+    knowhere::IVFPQConfAdapter::GetValidMList(data.dim, m_list);
+    int64_t m = m_list.empty() ? 1 : m_list.back();
+    for (auto valid_m : m_list) {
+        if (data.dim / valid_m >= 4) {
+            m = valid_m;
+        }
+    }
+
+    namespace IndexEnum = knowhere::IndexEnum;
+    namespace IndexParams = knowhere::IndexParams;
+    return {
+        {IndexEnum::INDEX_FAISS_IDMAP, {}, "", {}},
+        {IndexEnum::INDEX_FAISS_IVFFLAT, {{IndexParams::nlist, 1024}}, IndexParams::nprobe, nprobes},
+        {IndexEnum::INDEX_FAISS_IVFSQ8, {{IndexParams::nlist, 1024}}, IndexParams::nprobe, nprobes},
+        {IndexEnum::INDEX_FAISS_IVFSQ8NR, {{IndexParams::nlist, 1024}}, IndexParams::nprobe, nprobes},
+        {IndexEnum::INDEX_FAISS_IVFPQ, {{IndexParams::nlist, 1024}, {IndexParams::m, m}}, IndexParams::nprobe,
+         nprobes},
+        {IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, {{IndexParams::nlist, 1024}, {IndexParams::m, m}},
+         IndexParams::nprobe, nprobes},
+        {IndexEnum::INDEX_HNSW, {{IndexParams::M, 16}, {IndexParams::efConstruction, 200}}, IndexParams::ef, efs},
+        {IndexEnum::INDEX_HNSW_SQ8NR, {{IndexParams::M, 16}, {IndexParams::efConstruction, 200}}, IndexParams::ef,
+         efs},
+        {IndexEnum::INDEX_NSG,
+         {{IndexParams::knng, 32},
+          {IndexParams::search_length, 60},
+          {IndexParams::out_degree, 32},
+          {IndexParams::candidate, 300}},
+         IndexParams::search_length,
+         {20, 40, 80, 160, 300}},
+        {IndexEnum::INDEX_ANNOY, {{IndexParams::n_trees, 16}}, IndexParams::search_k, {100, 1000, 10000, 100000}},
+    };
+}
+
+// built the way the engine builds a segment, then serialized and loaded back with the raw vectors attached the
+// way the engine loads it, which the indexes keeping no raw vectors of their own need to search
+BuiltIndex&
+BuildIndex(const IndexSpec& spec) {
+    auto conf = spec.build;
+    conf[knowhere::meta::DIM] = data.dim;
+    conf[knowhere::meta::ROWS] = data.nb;
+    conf[knowhere::Metric::TYPE] = data.metric;
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(spec.type);
+    if (!adapter->CheckTrain(conf, knowhere::IndexMode::MODE_CPU)) {
+        KNOWHERE_THROW_MSG("Illegal build params of " + spec.type + ": " + conf.dump());
+    }
+
+    BuiltIndex built;
+    int64_t rss = ResidentBytes();
+    auto start = Clock::now();
+    built.index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(spec.type, knowhere::IndexMode::MODE_CPU);
+    built.index->BuildAll(knowhere::GenDatasetWithIds(data.nb, data.dim, data.xb.data(), data.ids.data()), conf);
+    built.build_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    auto binary_set = built.index->Serialize(conf);
+    for (auto& binary : binary_set.binary_map_) {
+        built.index_bytes += binary.second->size;
+    }
+    auto raw_data = std::make_shared<knowhere::Binary>();
+    raw_data->data = std::shared_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(data.xb.data()), [](uint8_t*) {});
+    raw_data->size = data.xb.size() * sizeof(float);
+    binary_set.Append(RAW_DATA, raw_data);
+    built.index->Load(binary_set);
+    built.rss_bytes = ResidentBytes() - rss;
+
+    built_indexes[spec.type] = built;
+    return built_indexes[spec.type];
+}
+
+double
+Percentile(const std::vector<double>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(percentile * sorted.size()));
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+// the share of the true topk neighbors found in the topk results
+double
+Recall(const std::vector<int64_t>& result_ids, int64_t topk) {
+    int64_t k = std::min(topk, data.gt_k);
+    int64_t hits = 0;
+    for (int64_t q = 0; q < data.nq; ++q) {
+        std::unordered_set<int64_t> truth(data.gt.begin() + q * data.gt_k, data.gt.begin() + q * data.gt_k + k);
+        for (int64_t i = 0; i < topk; ++i) {
+            hits += truth.count(result_ids[q * topk + i]);
+        }
+    }
+    return static_cast<double>(hits) / (data.nq * k);
+}
+
+void
+BM_Build(benchmark::State& state, const IndexSpec& spec) {
+    BuiltIndex* built = nullptr;
+    for (auto _ : state) {
+        built = &BuildIndex(spec);
+    }
+    state.counters["build_s"] = built->build_seconds;
+    state.counters["index_bytes"] = built->index_bytes;
+    state.counters["rss_bytes"] = built->rss_bytes;
+}
+
+// one query at a time, the latencies are those of single queries and qps is what one thread serves
+void
+BM_Search(benchmark::State& state, const IndexSpec& spec, int64_t search_value) {
+    auto iter = built_indexes.find(spec.type);
+    auto& built = iter == built_indexes.end() ? BuildIndex(spec) : iter->second;
+
+    knowhere::Config conf{{knowhere::meta::DIM, data.dim},
+                          {knowhere::meta::TOPK, options.topk},
+                          {knowhere::Metric::TYPE, data.metric}};
+    if (!spec.search_param.empty()) {
+        conf[spec.search_param] = search_value;
+    }
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(spec.type);
+    if (!adapter->CheckSearch(conf, spec.type, knowhere::IndexMode::MODE_CPU)) {
+        state.SkipWithError(("Illegal search params: " + conf.dump()).c_str());
+        return;
+    }
+
+    std::vector<double> latencies;
+    std::vector<int64_t> result_ids(data.nq * options.topk);
+    for (auto _ : state) {
+        for (int64_t q = 0; q < data.nq; ++q) {
+            auto query = knowhere::GenDataset(1, data.dim, data.xq.data() + q * data.dim);
+            auto start = Clock::now();
+            auto result = built.index->Query(query, conf);
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+            auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+            std::copy_n(ids, options.topk, result_ids.begin() + q * options.topk);
+            free(ids);
+            free(result->Get<float*>(knowhere::meta::DISTANCE));
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["recall"] = Recall(result_ids, options.topk);
+    state.counters["p50_us"] = Percentile(latencies, 0.50);
+    state.counters["p99_us"] = Percentile(latencies, 0.99);
+    state.counters["qps"] = benchmark::Counter(latencies.size(), benchmark::Counter::kIsRate);
+}
+
+std::vector<std::string>
+Split(const std::string& str) {
+    std::vector<std::string> items;
+    std::stringstream stream(str);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// the options left in argv once google benchmark took its own
+void
+ParseOptions(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto pos = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || pos == std::string::npos) {
+            KNOWHERE_THROW_MSG("Unknown argument " + arg);
+        }
+        auto name = arg.substr(2, pos - 2);
+        auto value = arg.substr(pos + 1);
+        if (name == "dataset") {
+            options.dataset = value;
+        } else if (name == "query") {
+            options.query = value;
+        } else if (name == "groundtruth") {
+            options.groundtruth = value;
+        } else if (name == "index_types") {
+            options.index_types = Split(value);
+        } else if (name == "topk") {
+            options.topk = std::stoll(value);
+        } else if (name == "nq") {
+            options.nq = std::stoll(value);
+        } else if (name == "rows") {
+            options.rows = std::stoll(value);
+        } else if (name == "dim") {
+            options.dim = std::stoll(value);
+        } else {
+            KNOWHERE_THROW_MSG("Unknown argument " + arg);
+        }
+    }
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    try {
+        ParseOptions(argc, argv);
+        LoadData();
+    } catch (std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    std::cerr << "dataset: " << data.nb << " x " << data.dim << " " << data.metric << ", " << data.nq
+              << " queries, topk " << options.topk << std::endl;
+
+    for (auto& spec : IndexSpecs()) {
+        if (!options.index_types.empty() &&
+            std::find(options.index_types.begin(), options.index_types.end(), spec.type) == options.index_types.end()) {
+            continue;
+        }
+        benchmark::RegisterBenchmark(("Build/" + spec.type).c_str(), BM_Build, spec)
+            ->Iterations(1)
+            ->Unit(benchmark::kMillisecond);
+        if (spec.search_param.empty()) {
+            benchmark::RegisterBenchmark(("Search/" + spec.type).c_str(), BM_Search, spec, 0)
+                ->Unit(benchmark::kMillisecond);
+        }
+        for (auto value : spec.search_values) {
+            auto name = "Search/" + spec.type + "/" + spec.search_param + ":" + std::to_string(value);
+            benchmark::RegisterBenchmark(name.c_str(), BM_Search, spec, value)->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
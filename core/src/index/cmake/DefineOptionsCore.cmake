@@ -93,6 +93,8 @@ else ()
     define_option(KNOWHERE_BUILD_TESTS "Build the KNOWHERE googletest unit tests" OFF)
 endif (BUILD_UNIT_TEST)
 
+define_option(KNOWHERE_BUILD_BENCHMARKS "Build the KNOWHERE index benchmarks" OFF)
+
 #----------------------------------------------------------------------
 macro(config_summary)
     message(STATUS "---------------------------------------------------------------------")
@@ -0,0 +1,23 @@
+# Finds an installed google benchmark, defines the imported library gbenchmark
+#
+#  GBenchmark_FOUND - the library and its headers are found
+#  GBENCHMARK_INCLUDE_DIR - the directory of benchmark/benchmark.h
+#  GBENCHMARK_STATIC_LIB - the benchmark library
+
+find_path(GBENCHMARK_INCLUDE_DIR benchmark/benchmark.h
+        PATHS $ENV{GBENCHMARK_HOME}/include /usr/local/include /usr/include)
+
+find_library(GBENCHMARK_STATIC_LIB NAMES benchmark
+        PATHS $ENV{GBENCHMARK_HOME}/lib /usr/local/lib /usr/local/lib64 /usr/lib /usr/lib64)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(GBenchmark DEFAULT_MSG GBENCHMARK_INCLUDE_DIR GBENCHMARK_STATIC_LIB)
+
+if (GBenchmark_FOUND AND NOT TARGET gbenchmark)
+    add_library(gbenchmark UNKNOWN IMPORTED)
+    set_target_properties(gbenchmark
+            PROPERTIES IMPORTED_LOCATION "${GBENCHMARK_STATIC_LIB}"
+            INTERFACE_INCLUDE_DIRECTORIES "${GBENCHMARK_INCLUDE_DIR}")
+endif ()
+
+mark_as_advanced(GBENCHMARK_INCLUDE_DIR GBENCHMARK_STATIC_LIB)
@@ -15,6 +15,7 @@ set(KNOWHERE_THIRDPARTY_DEPENDENCIES
         Arrow
         FAISS
         GTest
+        GBenchmark
         OpenBLAS
         MKL
         )
@@ -33,6 +34,8 @@ macro(build_dependency DEPENDENCY_NAME)
         build_arrow()
     elseif ("${DEPENDENCY_NAME}" STREQUAL "GTest")
         build_gtest()
+    elseif ("${DEPENDENCY_NAME}" STREQUAL "GBenchmark")
+        build_gbenchmark()
     elseif ("${DEPENDENCY_NAME}" STREQUAL "OpenBLAS")
         build_openblas()
     elseif ("${DEPENDENCY_NAME}" STREQUAL "FAISS")
@@ -221,6 +224,13 @@ else ()
             "https://github.com/google/googletest/archive/release-${GTEST_VERSION}.tar.gz")
 endif ()
 
+if (DEFINED ENV{KNOWHERE_GBENCHMARK_URL})
+    set(GBENCHMARK_SOURCE_URL "$ENV{KNOWHERE_GBENCHMARK_URL}")
+else ()
+    set(GBENCHMARK_SOURCE_URL
+            "https://github.com/google/benchmark/archive/v${GBENCHMARK_VERSION}.tar.gz")
+endif ()
+
 if (DEFINED ENV{KNOWHERE_OPENBLAS_URL})
     set(OPENBLAS_SOURCE_URL "$ENV{KNOWHERE_OPENBLAS_URL}")
 else ()
@@ -467,6 +477,54 @@ if (KNOWHERE_BUILD_TESTS AND NOT TARGET googletest_ep)
     include_directories(SYSTEM ${GTEST_INCLUDE_DIR})
 endif ()
 
+# ----------------------------------------------------------------------
+# Google benchmark
+
+macro(build_gbenchmark)
+    message(STATUS "Building google benchmark-${GBENCHMARK_VERSION} from source")
+    set(GBENCHMARK_PREFIX "${INDEX_BINARY_DIR}/gbenchmark_ep-prefix/src/gbenchmark_ep")
+    set(GBENCHMARK_INCLUDE_DIR "${GBENCHMARK_PREFIX}/include")
+    set(GBENCHMARK_STATIC_LIB
+            "${GBENCHMARK_PREFIX}/lib/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}")
+
+    set(GBENCHMARK_CMAKE_ARGS
+            ${EP_COMMON_CMAKE_ARGS}
+            "-DCMAKE_INSTALL_PREFIX=${GBENCHMARK_PREFIX}"
+            "-DCMAKE_INSTALL_LIBDIR=lib"
+            -DCMAKE_BUILD_TYPE=Release
+            -DBENCHMARK_ENABLE_TESTING=OFF
+            -DBENCHMARK_ENABLE_GTEST_TESTS=OFF)
+
+    ExternalProject_Add(gbenchmark_ep
+            URL
+            ${GBENCHMARK_SOURCE_URL}
+            BUILD_COMMAND
+            ${MAKE}
+            ${MAKE_BUILD_ARGS}
+            BUILD_BYPRODUCTS
+            ${GBENCHMARK_STATIC_LIB}
+            CMAKE_ARGS
+            ${GBENCHMARK_CMAKE_ARGS}
+            ${EP_LOG_OPTIONS})
+
+    # The include directory must exist before it is referenced by a target.
+    file(MAKE_DIRECTORY "${GBENCHMARK_INCLUDE_DIR}")
+
+    add_library(gbenchmark STATIC IMPORTED)
+    set_target_properties(gbenchmark
+            PROPERTIES IMPORTED_LOCATION "${GBENCHMARK_STATIC_LIB}"
+            INTERFACE_INCLUDE_DIRECTORIES "${GBENCHMARK_INCLUDE_DIR}")
+
+    add_dependencies(gbenchmark gbenchmark_ep)
+endmacro()
+
+if (KNOWHERE_BUILD_BENCHMARKS AND NOT TARGET gbenchmark_ep)
+    resolve_dependency(GBenchmark)
+
+    get_target_property(GBENCHMARK_INCLUDE_DIR gbenchmark INTERFACE_INCLUDE_DIRECTORIES)
+    include_directories(SYSTEM ${GBENCHMARK_INCLUDE_DIR})
+endif ()
+
 # ----------------------------------------------------------------------
 # MKL
 
@@ -512,10 +570,15 @@ macro(build_faiss)
     set(FAISS_STATIC_LIB
             "${FAISS_PREFIX}/lib/${CMAKE_STATIC_LIBRARY_PREFIX}faiss${CMAKE_STATIC_LIBRARY_SUFFIX}")
 
+    # -mf16c is an x86 flag, the aarch64 build relies on the neon kernels instead
+    if (KNOWHERE_BUILD_ARCH STREQUAL "x86_64")
+        set(FAISS_CPU_FLAGS "-mf16c")
+    endif ()
+
     set(FAISS_CONFIGURE_ARGS
             "--prefix=${FAISS_PREFIX}"
             "CFLAGS=${EP_C_FLAGS}"
-            "CXXFLAGS=${EP_CXX_FLAGS} -mf16c -O3"
+            "CXXFLAGS=${EP_CXX_FLAGS} ${FAISS_CPU_FLAGS} -O3"
             --without-python)
 
     if (FAISS_WITH_MKL)
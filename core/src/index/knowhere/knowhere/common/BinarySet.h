@@ -24,6 +24,8 @@ namespace knowhere {
 struct Binary {
     std::shared_ptr<uint8_t[]> data;
     int64_t size = 0;
+    // data aliases a read-only file mapping instead of an owned heap copy
+    bool mapped = false;
 };
 using BinaryPtr = std::shared_ptr<Binary>;
 
@@ -40,8 +40,11 @@ static std::unordered_map<int32_t, std::string> old_index_type_str_map = {
     {(int32_t)OldIndexType::ANNOY, IndexEnum::INDEX_ANNOY},
     {(int32_t)OldIndexType::HNSW_SQ8NR, IndexEnum::INDEX_HNSW_SQ8NR},
     {(int32_t)OldIndexType::FAISS_IVFSQ8NR, IndexEnum::INDEX_FAISS_IVFSQ8NR},
+    {(int32_t)OldIndexType::FAISS_IVFPQ_FASTSCAN, IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN},
+    {(int32_t)OldIndexType::DISKANN, IndexEnum::INDEX_DISKANN},
     {(int32_t)OldIndexType::FAISS_BIN_IDMAP, IndexEnum::INDEX_FAISS_BIN_IDMAP},
     {(int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU, IndexEnum::INDEX_FAISS_BIN_IVFFLAT},
+    {(int32_t)OldIndexType::FAISS_BIN_HASH, IndexEnum::INDEX_FAISS_BIN_HASH},
 };
 
 static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
@@ -60,8 +63,11 @@ static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
     {IndexEnum::INDEX_ANNOY, (int32_t)OldIndexType::ANNOY},
     {IndexEnum::INDEX_FAISS_IVFSQ8NR, (int32_t)OldIndexType::FAISS_IVFSQ8NR},
     {IndexEnum::INDEX_HNSW_SQ8NR, (int32_t)OldIndexType::HNSW_SQ8NR},
+    {IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, (int32_t)OldIndexType::FAISS_IVFPQ_FASTSCAN},
+    {IndexEnum::INDEX_DISKANN, (int32_t)OldIndexType::DISKANN},
     {IndexEnum::INDEX_FAISS_BIN_IDMAP, (int32_t)OldIndexType::FAISS_BIN_IDMAP},
     {IndexEnum::INDEX_FAISS_BIN_IVFFLAT, (int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU},
+    {IndexEnum::INDEX_FAISS_BIN_HASH, (int32_t)OldIndexType::FAISS_BIN_HASH},
 };
 
 /* used in 0.8.0 */
@@ -70,11 +76,13 @@ const char* INVALID = "";
 const char* INDEX_FAISS_IDMAP = "IDMAP";
 const char* INDEX_FAISS_IVFFLAT = "IVF_FLAT";
 const char* INDEX_FAISS_IVFPQ = "IVF_PQ";
+const char* INDEX_FAISS_IVFPQ_FASTSCAN = "IVF_PQ_FASTSCAN";
 const char* INDEX_FAISS_IVFSQ8 = "IVF_SQ8";
 const char* INDEX_FAISS_IVFSQ8NR = "IVF_SQ8NR";
 const char* INDEX_FAISS_IVFSQ8H = "IVF_SQ8_HYBRID";
 const char* INDEX_FAISS_BIN_IDMAP = "BIN_IDMAP";
 const char* INDEX_FAISS_BIN_IVFFLAT = "BIN_IVF_FLAT";
+const char* INDEX_FAISS_BIN_HASH = "BIN_HASH";
 const char* INDEX_NSG = "NSG";
 #ifdef MILVUS_SUPPORT_SPTAG
 const char* INDEX_SPTAG_KDT_RNT = "SPTAG_KDT_RNT";
@@ -83,6 +91,7 @@ const char* INDEX_SPTAG_BKT_RNT = "SPTAG_BKT_RNT";
 const char* INDEX_HNSW = "HNSW";
 const char* INDEX_ANNOY = "ANNOY";
 const char* INDEX_HNSW_SQ8NR = "HNSW_SQ8NR";
+const char* INDEX_DISKANN = "DISKANN";
 }  // namespace IndexEnum
 
 std::string
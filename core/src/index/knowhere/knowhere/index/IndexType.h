@@ -37,8 +37,11 @@ enum class OldIndexType {
     ANNOY,
     FAISS_IVFSQ8NR,
     HNSW_SQ8NR,
+    FAISS_IVFPQ_FASTSCAN,
+    DISKANN,
     FAISS_BIN_IDMAP = 100,
     FAISS_BIN_IVFLAT_CPU = 101,
+    FAISS_BIN_HASH = 102,
 };
 
 using IndexType = std::string;
@@ -49,11 +52,13 @@ extern const char* INVALID;
 extern const char* INDEX_FAISS_IDMAP;
 extern const char* INDEX_FAISS_IVFFLAT;
 extern const char* INDEX_FAISS_IVFPQ;
+extern const char* INDEX_FAISS_IVFPQ_FASTSCAN;
 extern const char* INDEX_FAISS_IVFSQ8;
 extern const char* INDEX_FAISS_IVFSQ8NR;
 extern const char* INDEX_FAISS_IVFSQ8H;
 extern const char* INDEX_FAISS_BIN_IDMAP;
 extern const char* INDEX_FAISS_BIN_IVFFLAT;
+extern const char* INDEX_FAISS_BIN_HASH;
 extern const char* INDEX_NSG;
 #ifdef MILVUS_SUPPORT_SPTAG
 extern const char* INDEX_SPTAG_KDT_RNT;
@@ -62,6 +67,7 @@ extern const char* INDEX_SPTAG_BKT_RNT;
 extern const char* INDEX_HNSW;
 extern const char* INDEX_ANNOY;
 extern const char* INDEX_HNSW_SQ8NR;
+extern const char* INDEX_DISKANN;
 }  // namespace IndexEnum
 
 enum class IndexMode { MODE_CPU = 0, MODE_GPU = 1 };
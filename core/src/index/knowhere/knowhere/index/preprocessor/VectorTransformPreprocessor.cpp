@@ -0,0 +1,204 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/preprocessor/VectorTransformPreprocessor.h"
+
+#include <faiss/VectorTransform.h>
+#include <faiss/index_io.h>
+#include <sstream>
+#include <utility>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+
+// keeps the transformed vectors of a preprocessed dataset alive
+constexpr const char* PREPROCESSED_TENSOR = "preprocessed_tensor";
+
+bool
+ParseDim(const std::string& str, int64_t& value) {
+    if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos || str.size() > 9) {
+        return false;
+    }
+    value = std::stoll(str);
+    return value > 0;
+}
+
+std::unique_ptr<faiss::VectorTransform>
+CreateStage(const std::string& stage, int64_t dim) {
+    int64_t m = 0, d_out = dim;
+    if (stage.compare(0, 3, "OPQ") == 0) {
+        auto pos = stage.find('_');
+        if (!ParseDim(stage.substr(3, pos == std::string::npos ? pos : pos - 3), m) ||
+            (pos != std::string::npos && !ParseDim(stage.substr(pos + 1), d_out))) {
+            KNOWHERE_THROW_MSG("invalid preprocess stage " + stage);
+        }
+        if (d_out > dim || d_out % m != 0) {
+            KNOWHERE_THROW_MSG("preprocess stage " + stage + " does not fit dimension " + std::to_string(dim));
+        }
+        return std::make_unique<faiss::OPQMatrix>(dim, m, d_out);
+    } else if (stage.compare(0, 3, "PCA") == 0) {
+        bool random_rotation = stage.compare(0, 4, "PCAR") == 0;
+        if (!ParseDim(stage.substr(random_rotation ? 4 : 3), d_out)) {
+            KNOWHERE_THROW_MSG("invalid preprocess stage " + stage);
+        }
+        if (d_out > dim) {
+            KNOWHERE_THROW_MSG("preprocess stage " + stage + " does not fit dimension " + std::to_string(dim));
+        }
+        return std::make_unique<faiss::PCAMatrix>(dim, d_out, 0, random_rotation);
+    } else if (stage == "L2norm") {
+        return std::make_unique<faiss::NormalizationTransform>(dim, 2.0);
+    }
+    KNOWHERE_THROW_MSG("invalid preprocess stage " + stage);
+}
+
+}  // namespace
+
+VectorTransformPreprocessor::VectorTransformPreprocessor() = default;
+
+VectorTransformPreprocessor::VectorTransformPreprocessor(const std::string& spec, int64_t dim) {
+    std::stringstream ss(spec);
+    std::string stage;
+    while (std::getline(ss, stage, ',')) {
+        auto stage_ptr = CreateStage(stage, dim);
+        dim = stage_ptr->d_out;
+        chain_.push_back(std::move(stage_ptr));
+    }
+    if (chain_.empty()) {
+        KNOWHERE_THROW_MSG("empty preprocess spec");
+    }
+}
+
+VectorTransformPreprocessor::~VectorTransformPreprocessor() = default;
+
+void
+VectorTransformPreprocessor::Train(const DatasetPtr& dataset) {
+    GET_TENSOR_DATA_DIM(dataset)
+    if (dim != DimIn()) {
+        KNOWHERE_THROW_MSG("preprocess dimension " + std::to_string(DimIn()) + " got vectors of dimension " +
+                           std::to_string(dim));
+    }
+
+    auto x = static_cast<const float*>(p_data);
+    std::unique_ptr<float[]> xt;
+    for (size_t i = 0; i < chain_.size(); ++i) {
+        auto& stage = chain_[i];
+        if (!stage->is_trained) {
+            stage->train(rows, x);
+        }
+        if (i + 1 < chain_.size()) {
+            xt.reset(stage->apply(rows, x));
+            x = xt.get();
+        }
+    }
+}
+
+bool
+VectorTransformPreprocessor::IsTrained() const {
+    for (auto& stage : chain_) {
+        if (!stage->is_trained) {
+            return false;
+        }
+    }
+    return !chain_.empty();
+}
+
+DatasetPtr
+VectorTransformPreprocessor::Preprocess(const DatasetPtr& input) {
+    if (!IsTrained()) {
+        KNOWHERE_THROW_MSG("preprocessor not trained");
+    }
+    GET_TENSOR_DATA_DIM(input)
+    if (dim != DimIn()) {
+        KNOWHERE_THROW_MSG("preprocess dimension " + std::to_string(DimIn()) + " got vectors of dimension " +
+                           std::to_string(dim));
+    }
+
+    // the stages of a chain may not work in place, each one writes a new buffer
+    std::shared_ptr<float[]> xt(chain_[0]->apply(rows, static_cast<const float*>(p_data)));
+    for (size_t i = 1; i < chain_.size(); ++i) {
+        xt.reset(chain_[i]->apply(rows, xt.get()));
+    }
+
+    auto result = std::make_shared<Dataset>();
+    for (auto& pair : input->data()) {
+        result->Set(pair.first, *pair.second);
+    }
+    result->Set(meta::TENSOR, static_cast<const void*>(xt.get()));
+    result->Set(meta::DIM, DimOut());
+    result->Set(PREPROCESSED_TENSOR, std::move(xt));
+    return result;
+}
+
+void
+VectorTransformPreprocessor::Serialize(BinarySet& binary_set) const {
+    try {
+        MemoryIOWriter writer;
+        size_t stages = chain_.size();
+        writer.write(&stages, sizeof(stages));
+        for (auto& stage : chain_) {
+            faiss::write_VectorTransform(stage.get(), &writer);
+        }
+        std::shared_ptr<uint8_t[]> data(writer.data_);
+        binary_set.Append(PREPROCESSOR_DATA, data, writer.rp);
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+VectorTransformPreprocessor::Load(const BinarySet& binary_set) {
+    try {
+        auto binary = binary_set.GetByName(PREPROCESSOR_DATA);
+
+        MemoryIOReader reader;
+        reader.total = binary->size;
+        reader.data_ = binary->data.get();
+
+        size_t stages = 0;
+        reader.read(&stages, sizeof(stages));
+        chain_.clear();
+        for (size_t i = 0; i < stages; ++i) {
+            chain_.emplace_back(faiss::read_VectorTransform(&reader));
+        }
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+int64_t
+VectorTransformPreprocessor::DimIn() const {
+    return chain_.empty() ? 0 : chain_.front()->d_in;
+}
+
+int64_t
+VectorTransformPreprocessor::DimOut() const {
+    return chain_.empty() ? 0 : chain_.back()->d_out;
+}
+
+int64_t
+VectorTransformPreprocessor::Size() const {
+    int64_t size = 0;
+    for (auto& stage : chain_) {
+        if (auto lt = dynamic_cast<const faiss::LinearTransform*>(stage.get())) {
+            size += (lt->A.size() + lt->b.size()) * sizeof(float);
+        }
+    }
+    return size;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,80 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "knowhere/common/BinarySet.h"
+#include "knowhere/index/preprocessor/Preprocessor.h"
+
+namespace faiss {
+struct VectorTransform;
+}
+
+namespace milvus {
+namespace knowhere {
+
+#define PREPROCESSOR_DATA "PREPROCESSOR_DATA"
+
+/*
+ * Chain of faiss vector transforms applied to the float vectors before they reach an index. The spec lists the
+ * stages separated by commas, in the faiss factory notation:
+ *   OPQ<M>[_<d>]  rotation balancing the variance over M product quantizer sub-vectors, optionally to d dimensions
+ *   PCA<d>        projection on the d principal components, PCAR<d> adds a random rotation after it
+ *   L2norm        scales the vectors to unit length, the inner product becomes the cosine
+ * e.g. "PCA256,OPQ32" before an IVF_PQ with m 32, or "L2norm" before any IP index.
+ */
+class VectorTransformPreprocessor : public Preprocessor {
+ public:
+    // an empty chain, to be loaded
+    VectorTransformPreprocessor();
+
+    VectorTransformPreprocessor(const std::string& spec, int64_t dim);
+
+    ~VectorTransformPreprocessor();
+
+    // trains the stages one after the other, each on the output of the previous ones
+    void
+    Train(const DatasetPtr& dataset);
+
+    bool
+    IsTrained() const;
+
+    // a copy of input with meta::TENSOR and meta::DIM replaced by the transformed vectors, which the new dataset owns
+    DatasetPtr
+    Preprocess(const DatasetPtr& input) override;
+
+    void
+    Serialize(BinarySet& binary_set) const;
+
+    void
+    Load(const BinarySet& binary_set);
+
+    int64_t
+    DimIn() const;
+
+    int64_t
+    DimOut() const;
+
+    int64_t
+    Size() const;
+
+ private:
+    std::vector<std::unique_ptr<faiss::VectorTransform>> chain_;
+};
+
+using VectorTransformPreprocessorPtr = std::shared_ptr<VectorTransformPreprocessor>;
+
+}  // namespace knowhere
+}  // namespace milvus
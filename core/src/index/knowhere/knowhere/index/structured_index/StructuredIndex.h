@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include "faiss/utils/ConcurrentBitset.h"
 #include "knowhere/index/Index.h"
@@ -20,6 +22,27 @@ namespace knowhere {
 
 enum OperatorType { LT = 0, LE = 1, GT = 3, GE = 4 };
 
+// the bitsets built by the structured indexes belong to the query alone until they are returned, their bytes are
+// written with plain stores instead of the atomics of ConcurrentBitset::set
+inline void
+SetBit(uint8_t* bits, size_t id) {
+    bits[id >> 3] |= static_cast<uint8_t>(1 << (id & 0x7));
+}
+
+inline void
+ClearBit(uint8_t* bits, size_t id) {
+    bits[id >> 3] &= static_cast<uint8_t>(~(1 << (id & 0x7)));
+}
+
+// clear the bits past the capacity in the last byte of a bitset which was set byte by byte
+inline void
+ClearTailBits(faiss::ConcurrentBitset& bitset) {
+    size_t tail = bitset.capacity() & 0x7;
+    if (tail != 0) {
+        bitset.mutable_data()[bitset.size() - 1] &= static_cast<uint8_t>((1 << tail) - 1);
+    }
+}
+
 template <typename T>
 class StructuredIndex : public Index {
  public:
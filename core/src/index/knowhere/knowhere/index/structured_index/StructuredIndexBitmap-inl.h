@@ -0,0 +1,201 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "knowhere/index/structured_index/StructuredIndexBitmap.h"
+
+namespace milvus {
+namespace knowhere {
+
+template <typename T>
+StructuredIndexBitmap<T>::StructuredIndexBitmap() {
+}
+
+template <typename T>
+StructuredIndexBitmap<T>::StructuredIndexBitmap(const size_t n, const T* values) {
+    Build(n, values);
+}
+
+template <typename T>
+void
+StructuredIndexBitmap<T>::Build(const size_t n, const T* values) {
+    if (n == 0) {
+        KNOWHERE_THROW_MSG("StructuredIndexBitmap cannot build null values!");
+    }
+    values_.assign(values, values + n);
+    std::sort(values_.begin(), values_.end());
+    values_.erase(std::unique(values_.begin(), values_.end()), values_.end());
+
+    count_ = n;
+    words_ = (n + 63) / 64;
+    bitmaps_.assign(values_.size() * words_, 0);
+    for (size_t i = 0; i < n; ++i) {
+        size_t pos = std::lower_bound(values_.begin(), values_.end(), values[i]) - values_.begin();
+        bitmaps_[pos * words_ + (i >> 6)] |= uint64_t(1) << (i & 63);
+    }
+}
+
+template <typename T>
+BinarySet
+StructuredIndexBitmap<T>::Serialize(const milvus::knowhere::Config& config) {
+    auto values_size = values_.size() * sizeof(T);
+    std::shared_ptr<uint8_t[]> values_data(new uint8_t[values_size]);
+    memcpy(values_data.get(), values_.data(), values_size);
+
+    auto bitmaps_size = bitmaps_.size() * sizeof(uint64_t);
+    std::shared_ptr<uint8_t[]> bitmaps_data(new uint8_t[bitmaps_size]);
+    memcpy(bitmaps_data.get(), bitmaps_.data(), bitmaps_size);
+
+    std::shared_ptr<uint8_t[]> count_data(new uint8_t[sizeof(size_t)]);
+    memcpy(count_data.get(), &count_, sizeof(size_t));
+
+    BinarySet res_set;
+    res_set.Append("bitmap_values", values_data, values_size);
+    res_set.Append("bitmap_data", bitmaps_data, bitmaps_size);
+    res_set.Append("bitmap_count", count_data, sizeof(size_t));
+    return res_set;
+}
+
+template <typename T>
+void
+StructuredIndexBitmap<T>::Load(const milvus::knowhere::BinarySet& index_binary) {
+    try {
+        auto count_data = index_binary.GetByName("bitmap_count");
+        memcpy(&count_, count_data->data.get(), sizeof(size_t));
+        words_ = (count_ + 63) / 64;
+
+        auto values_data = index_binary.GetByName("bitmap_values");
+        values_.resize(values_data->size / sizeof(T));
+        memcpy(values_.data(), values_data->data.get(), values_.size() * sizeof(T));
+
+        auto bitmaps_data = index_binary.GetByName("bitmap_data");
+        bitmaps_.resize(values_.size() * words_);
+        if (bitmaps_data->size != bitmaps_.size() * sizeof(uint64_t)) {
+            KNOWHERE_THROW_MSG("invalid bitmap size");
+        }
+        memcpy(bitmaps_.data(), bitmaps_data->data.get(), bitmaps_data->size);
+    } catch (...) {
+        KNOHWERE_ERROR_MSG("StructuredIndexBitmap Load failed!");
+    }
+}
+
+template <typename T>
+const faiss::ConcurrentBitsetPtr
+StructuredIndexBitmap<T>::In(const size_t n, const T* values) {
+    std::vector<bool> selected(values_.size(), false);
+    for (size_t i = 0; i < n; ++i) {
+        auto it = std::lower_bound(values_.begin(), values_.end(), values[i]);
+        if (it != values_.end() && *it == values[i]) {
+            selected[it - values_.begin()] = true;
+        }
+    }
+    return Union(selected);
+}
+
+template <typename T>
+const faiss::ConcurrentBitsetPtr
+StructuredIndexBitmap<T>::NotIn(const size_t n, const T* values) {
+    std::vector<bool> selected(values_.size(), true);
+    for (size_t i = 0; i < n; ++i) {
+        auto it = std::lower_bound(values_.begin(), values_.end(), values[i]);
+        if (it != values_.end() && *it == values[i]) {
+            selected[it - values_.begin()] = false;
+        }
+    }
+    return Union(selected);
+}
+
+template <typename T>
+const faiss::ConcurrentBitsetPtr
+StructuredIndexBitmap<T>::Range(const T value, const OperatorType op) {
+    auto lb = values_.begin();
+    auto ub = values_.end();
+    switch (op) {
+        case OperatorType::LT:
+            ub = std::lower_bound(values_.begin(), values_.end(), value);
+            break;
+        case OperatorType::LE:
+            ub = std::upper_bound(values_.begin(), values_.end(), value);
+            break;
+        case OperatorType::GT:
+            lb = std::upper_bound(values_.begin(), values_.end(), value);
+            break;
+        case OperatorType::GE:
+            lb = std::lower_bound(values_.begin(), values_.end(), value);
+            break;
+        default:
+            KNOWHERE_THROW_MSG("Invalid OperatorType:" + std::to_string((int)op) + "!");
+    }
+    return Union(lb - values_.begin(), ub - values_.begin());
+}
+
+template <typename T>
+const faiss::ConcurrentBitsetPtr
+StructuredIndexBitmap<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
+    if (lower_bound_value > upper_bound_value) {
+        std::swap(lower_bound_value, upper_bound_value);
+        std::swap(lb_inclusive, ub_inclusive);
+    }
+    auto lb = lb_inclusive ? std::lower_bound(values_.begin(), values_.end(), lower_bound_value)
+                           : std::upper_bound(values_.begin(), values_.end(), lower_bound_value);
+    auto ub = ub_inclusive ? std::upper_bound(values_.begin(), values_.end(), upper_bound_value)
+                           : std::lower_bound(values_.begin(), values_.end(), upper_bound_value);
+    return Union(lb - values_.begin(), std::max(lb, ub) - values_.begin());
+}
+
+template <typename T>
+faiss::ConcurrentBitsetPtr
+StructuredIndexBitmap<T>::Union(size_t begin, size_t end) const {
+    std::vector<bool> selected(values_.size(), false);
+    std::fill(selected.begin() + begin, selected.begin() + end, true);
+    return Union(selected);
+}
+
+template <typename T>
+faiss::ConcurrentBitsetPtr
+StructuredIndexBitmap<T>::Union(const std::vector<bool>& selected) const {
+    size_t selected_count = std::count(selected.begin(), selected.end(), true);
+    bool invert = selected_count > values_.size() / 2;
+
+    // the bitset bytes are little endian words of the bitmaps, the last word may be cut short
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(count_);
+    auto bits = bitset->mutable_data();
+    size_t n8 = bitset->size();
+    size_t n64 = n8 / sizeof(uint64_t);
+    auto words = reinterpret_cast<uint64_t*>(bits);
+    for (size_t v = 0; v < values_.size(); ++v) {
+        if (selected[v] == invert) {
+            continue;
+        }
+        auto bitmap = GetBitmap(v);
+        for (size_t i = 0; i < n64; ++i) {
+            words[i] |= bitmap[i];
+        }
+        if (n64 < words_) {
+            for (size_t i = n64 * sizeof(uint64_t); i < n8; ++i) {
+                bits[i] |= static_cast<uint8_t>(bitmap[n64] >> (8 * (i - n64 * sizeof(uint64_t))));
+            }
+        }
+    }
+
+    if (invert) {
+        bitset->negate();
+    }
+    return bitset;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,102 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/structured_index/StructuredIndex.h"
+
+namespace milvus {
+namespace knowhere {
+
+// a column with at most this many distinct values is indexed by StructuredIndexBitmap
+constexpr size_t BITMAP_INDEX_MAX_CARDINALITY = 64;
+
+/*
+ * Bitmap index of a low cardinality attribute: the distinct values in order and, for each of them, the bitmap of
+ * the rows holding it. A term or range query ORs the bitmaps of the matching values 64 rows at a time instead of
+ * setting the rows one by one, NotIn is the complement of In.
+ */
+template <typename T>
+class StructuredIndexBitmap : public StructuredIndex<T> {
+ public:
+    StructuredIndexBitmap();
+    StructuredIndexBitmap(const size_t n, const T* values);
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    void
+    Build(const size_t n, const T* values) override;
+
+    const faiss::ConcurrentBitsetPtr
+    In(const size_t n, const T* values) override;
+
+    const faiss::ConcurrentBitsetPtr
+    NotIn(const size_t n, const T* values) override;
+
+    const faiss::ConcurrentBitsetPtr
+    Range(const T value, const OperatorType op) override;
+
+    const faiss::ConcurrentBitsetPtr
+    Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) override;
+
+    // the distinct values in ascending order
+    const std::vector<T>&
+    GetValues() const {
+        return values_;
+    }
+
+    // the rows holding GetValues()[i], row r is bit r & 63 of word r >> 6
+    const uint64_t*
+    GetBitmap(size_t i) const {
+        return bitmaps_.data() + i * words_;
+    }
+
+    size_t
+    Count() const {
+        return count_;
+    }
+
+    int64_t
+    Size() override {
+        return values_.size() * sizeof(T) + bitmaps_.size() * sizeof(uint64_t);
+    }
+
+ private:
+    // the rows holding one of the selected values_, with more than half of them selected the others are ORed
+    // and the result is inverted
+    faiss::ConcurrentBitsetPtr
+    Union(const std::vector<bool>& selected) const;
+
+    faiss::ConcurrentBitsetPtr
+    Union(size_t begin, size_t end) const;
+
+ private:
+    size_t count_ = 0;
+    size_t words_ = 0;
+    std::vector<T> values_;
+    std::vector<uint64_t> bitmaps_;
+};
+
+template <typename T>
+using StructuredIndexBitmapPtr = std::shared_ptr<StructuredIndexBitmap<T>>;
+}  // namespace knowhere
+}  // namespace milvus
+
+#include "knowhere/index/structured_index/StructuredIndexBitmap-inl.h"
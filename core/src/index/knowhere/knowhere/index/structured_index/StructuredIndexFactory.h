@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "knowhere/index/structured_index/StructuredIndexBitmap.h"
+#include "knowhere/index/structured_index/StructuredIndexSort.h"
+
+namespace milvus {
+namespace knowhere {
+
+// a bitmap index when the values have at most BITMAP_INDEX_MAX_CARDINALITY distinct values, a sort index otherwise
+template <typename T>
+StructuredIndexPtr<T>
+CreateStructuredIndex(const size_t n, const T* values) {
+    std::vector<T> distinct;
+    for (size_t i = 0; i < n; ++i) {
+        auto it = std::lower_bound(distinct.begin(), distinct.end(), values[i]);
+        if (it != distinct.end() && *it == values[i]) {
+            continue;
+        }
+        if (distinct.size() == BITMAP_INDEX_MAX_CARDINALITY) {
+            return std::make_shared<StructuredIndexSort<T>>(n, values);
+        }
+        distinct.insert(it, values[i]);
+    }
+    return std::make_shared<StructuredIndexBitmap<T>>(n, values);
+}
+
+// an empty index of the kind the binary set was serialized from, to be loaded from it
+template <typename T>
+StructuredIndexPtr<T>
+CreateStructuredIndex(const BinarySet& index_binary) {
+    if (index_binary.binary_map_.find("bitmap_data") != index_binary.binary_map_.end()) {
+        return std::make_shared<StructuredIndexBitmap<T>>();
+    }
+    return std::make_shared<StructuredIndexSort<T>>();
+}
+
+}  // namespace knowhere
+}  // namespace milvus
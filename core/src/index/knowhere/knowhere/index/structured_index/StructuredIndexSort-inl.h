@@ -12,6 +12,7 @@
 #include <src/index/knowhere/knowhere/common/Log.h>
 #include <algorithm>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 #include "knowhere/index/structured_index/StructuredIndexSort.h"
 
@@ -100,15 +101,36 @@ StructuredIndexSort<T>::In(const size_t n, const T* values) {
         build();
     }
     faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(data_.size());
-    for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                LOG_KNOWHERE_ERROR_ << "error happens in StructuredIndexSort<T>::In, experted value is: "
-                                    << *(values + i) << ", but real value is: " << lb->a_;
+    auto bits = bitset->mutable_data();
+
+    // a term costs two binary searches, once they add up to more than the rows a single scan of the sorted rows
+    // probing a hash set of the terms once per distinct value is cheaper
+    constexpr size_t SCAN_MIN_TERMS = 16;
+    size_t log_size = 1;
+    while ((size_t(1) << log_size) < data_.size()) {
+        ++log_size;
+    }
+    if (n >= SCAN_MIN_TERMS && 2 * n * log_size > data_.size()) {
+        std::unordered_set<T> terms(values, values + n);
+        for (size_t i = 0; i < data_.size();) {
+            size_t j = i + 1;
+            while (j < data_.size() && data_[j].a_ == data_[i].a_) {
+                ++j;
+            }
+            if (terms.count(data_[i].a_) > 0) {
+                for (; i < j; ++i) {
+                    SetBit(bits, data_[i].idx_);
+                }
             }
-            bitset->set(lb->idx_);
+            i = j;
+        }
+        return bitset;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        auto range = std::equal_range(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+        for (auto it = range.first; it < range.second; ++it) {
+            SetBit(bits, it->idx_);
         }
     }
     return bitset;
@@ -117,21 +139,8 @@ StructuredIndexSort<T>::In(const size_t n, const T* values) {
 template <typename T>
 const faiss::ConcurrentBitsetPtr
 StructuredIndexSort<T>::NotIn(const size_t n, const T* values) {
-    if (!is_built_) {
-        build();
-    }
-    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(data_.size(), 0xff);
-    for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                LOG_KNOWHERE_ERROR_ << "error happens in StructuredIndexSort<T>::NotIn, experted value is: "
-                                    << *(values + i) << ", but real value is: " << lb->a_;
-            }
-            bitset->clear(lb->idx_);
-        }
-    }
+    auto bitset = In(n, values);
+    bitset->negate();
     return bitset;
 }
 
@@ -141,7 +150,6 @@ StructuredIndexSort<T>::Range(const T value, const OperatorType op) {
     if (!is_built_) {
         build();
     }
-    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(data_.size());
     auto lb = data_.begin();
     auto ub = data_.end();
     switch (op) {
@@ -160,10 +168,7 @@ StructuredIndexSort<T>::Range(const T value, const OperatorType op) {
         default:
             KNOWHERE_THROW_MSG("Invalid OperatorType:" + std::to_string((int)op) + "!");
     }
-    for (; lb < ub; ++lb) {
-        bitset->set(lb->idx_);
-    }
-    return bitset;
+    return RowsBitset(lb - data_.begin(), ub - data_.begin());
 }
 
 template <typename T>
@@ -172,7 +177,6 @@ StructuredIndexSort<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bo
     if (!is_built_) {
         build();
     }
-    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(data_.size());
     if (lower_bound_value > upper_bound_value) {
         std::swap(lower_bound_value, upper_bound_value);
         std::swap(lb_inclusive, ub_inclusive);
@@ -189,8 +193,31 @@ StructuredIndexSort<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bo
     } else {
         ub = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
     }
-    for (; lb < ub; ++lb) {
-        bitset->set(lb->idx_);
+    // an empty range with exclusive bounds on the same value ends before it begins
+    return RowsBitset(lb - data_.begin(), std::max(lb, ub) - data_.begin());
+}
+
+template <typename T>
+faiss::ConcurrentBitsetPtr
+StructuredIndexSort<T>::RowsBitset(size_t begin, size_t end) const {
+    size_t size = data_.size();
+    if (end - begin > size / 2) {
+        auto bitset = std::make_shared<faiss::ConcurrentBitset>(size, 0xff);
+        ClearTailBits(*bitset);
+        auto bits = bitset->mutable_data();
+        for (size_t i = 0; i < begin; ++i) {
+            ClearBit(bits, data_[i].idx_);
+        }
+        for (size_t i = end; i < size; ++i) {
+            ClearBit(bits, data_[i].idx_);
+        }
+        return bitset;
+    }
+
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(size);
+    auto bits = bitset->mutable_data();
+    for (size_t i = begin; i < end; ++i) {
+        SetBit(bits, data_[i].idx_);
     }
     return bitset;
 }
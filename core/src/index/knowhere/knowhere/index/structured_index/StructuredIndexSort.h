@@ -87,6 +87,12 @@ class StructuredIndexSort : public StructuredIndex<T> {
         return is_built_;
     }
 
+ private:
+    // bitset of the rows of data_[begin, end), the bitset is private to the caller until returned so its bytes are
+    // written without atomics, a range covering most rows clears the rows outside of it instead
+    faiss::ConcurrentBitsetPtr
+    RowsBitset(size_t begin, size_t end) const;
+
  private:
     bool is_built_;
     std::vector<IndexStructure<T>> data_;
@@ -11,9 +11,11 @@
 
 #include "knowhere/index/vector_index/ConfAdapter.h"
 #include <cmath>
+#include <exception>
 #include <memory>
 #include <string>
 #include <vector>
+#include "knowhere/index/preprocessor/VectorTransformPreprocessor.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 #ifdef MILVUS_GPU_VERSION
@@ -56,11 +58,46 @@ namespace knowhere {
         }                                                                                                    \
     }
 
+// the graph and binary indexes are not built behind vector transforms
+#define CheckNoPreprocess()                                   \
+    if (oricfg.contains(knowhere::IndexParams::preprocess)) { \
+        return false;                                         \
+    }
+
+// the vector transforms in front of a float index are optional and run by cpu, index_dim is the dimension of the
+// vectors the index behind them gets. A shared quantizer would mix the centroids of differently trained transforms
+static bool
+CheckPreprocess(const Config& oricfg, const IndexMode mode, int64_t& index_dim) {
+    index_dim = oricfg[knowhere::meta::DIM].get<int64_t>();
+    if (!oricfg.contains(knowhere::IndexParams::preprocess)) {
+        return true;
+    }
+    if (mode == IndexMode::MODE_GPU || !oricfg[knowhere::IndexParams::preprocess].is_string()) {
+        return false;
+    }
+    if (oricfg.contains(knowhere::IndexParams::shared_quantizer) &&
+        oricfg[knowhere::IndexParams::shared_quantizer] == true) {
+        return false;
+    }
+    try {
+        VectorTransformPreprocessor preprocessor(oricfg[knowhere::IndexParams::preprocess].get<std::string>(),
+                                                 index_dim);
+        index_dim = preprocessor.DimOut();
+    } catch (std::exception& e) {
+        return false;
+    }
+    return true;
+}
+
 bool
 ConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
     CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
     CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    int64_t index_dim;
+    if (!CheckPreprocess(oricfg, mode, index_dim)) {
+        return false;
+    }
     return true;
 }
 
@@ -70,6 +107,54 @@ ConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode m
     return true;
 }
 
+// the inverted lists of IVF_SQ8 and IVF_PQ may be left in the index file, off by default
+#define CheckOnDisk()                                           \
+    if (oricfg.contains(knowhere::IndexParams::on_disk) &&      \
+        !oricfg[knowhere::IndexParams::on_disk].is_boolean()) { \
+        return false;                                           \
+    }
+
+// the training params of the float ivf indexes are optional, the nlist of oricfg has to be tuned already
+static bool
+CheckIVFTrainParams(Config& oricfg) {
+    if (oricfg.contains(knowhere::IndexParams::train_mode)) {
+        static std::vector<std::string> TRAIN_MODES{knowhere::TrainMode::LLOYD, knowhere::TrainMode::MINI_BATCH,
+                                                    knowhere::TrainMode::HIERARCHICAL, knowhere::TrainMode::BALANCED};
+        CheckStrByValues(knowhere::IndexParams::train_mode, TRAIN_MODES);
+    }
+    if (oricfg.contains(knowhere::IndexParams::train_size)) {
+        CheckIntByRange(knowhere::IndexParams::train_size, oricfg[knowhere::IndexParams::nlist].get<int64_t>(),
+                        DEFAULT_MAX_ROWS);
+    }
+    if (oricfg.contains(knowhere::IndexParams::batch_size)) {
+        CheckIntByRange(knowhere::IndexParams::batch_size, 1, DEFAULT_MAX_ROWS);
+    }
+    if (oricfg.contains(knowhere::IndexParams::shared_quantizer) &&
+        !oricfg[knowhere::IndexParams::shared_quantizer].is_boolean()) {
+        return false;
+    }
+    return true;
+}
+
+// the bits per dimension of the scalar quantizers are optional, 8 by default, 4 and 6 are built and searched by cpu
+static bool
+CheckSQBits(Config& oricfg, const IndexMode mode) {
+    static int64_t DEFAULT_NBITS = 8;
+    static std::vector<int64_t> CPU_NBITS{4, 6, 8};
+    static std::vector<int64_t> GPU_NBITS{8};
+
+    if (!oricfg.contains(knowhere::IndexParams::nbits)) {
+        oricfg[knowhere::IndexParams::nbits] = DEFAULT_NBITS;
+        return true;
+    }
+    if (mode == IndexMode::MODE_GPU) {
+        CheckIntByValues(knowhere::IndexParams::nbits, GPU_NBITS);
+    } else {
+        CheckIntByValues(knowhere::IndexParams::nbits, CPU_NBITS);
+    }
+    return true;
+}
+
 int64_t
 MatchNlist(int64_t size, int64_t nlist) {
     const int64_t TYPICAL_COUNT = 1000000;
@@ -90,6 +175,13 @@ IVFConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
 
+    // storage type of the raw data is optional, float32 by default
+    if (oricfg.contains(knowhere::IndexParams::storage_type)) {
+        static std::vector<std::string> STORAGE_TYPES{knowhere::StorageType::FLOAT32, knowhere::StorageType::FLOAT16,
+                                                      knowhere::StorageType::BFLOAT16};
+        CheckStrByValues(knowhere::IndexParams::storage_type, STORAGE_TYPES);
+    }
+
     // int64_t nlist = oricfg[knowhere::IndexParams::nlist];
     // CheckIntByRange(knowhere::meta::ROWS, nlist, DEFAULT_MAX_ROWS);
 
@@ -97,6 +189,9 @@ IVFConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     int64_t nq = oricfg[knowhere::meta::ROWS].get<int64_t>();
     int64_t nlist = oricfg[knowhere::IndexParams::nlist].get<int64_t>();
     oricfg[knowhere::IndexParams::nlist] = MatchNlist(nq, nlist);
+    if (!CheckIVFTrainParams(oricfg)) {
+        return false;
+    }
 
     // Best Practice
     // static int64_t MIN_POINTS_PER_CENTROID = 40;
@@ -117,6 +212,10 @@ IVFConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMod
 #endif
     } else {
         CheckIntByRange(knowhere::IndexParams::nprobe, MIN_NPROBE, MAX_NPROBE);
+        if (oricfg.contains(knowhere::IndexParams::max_nprobe)) {
+            CheckIntByRange(knowhere::IndexParams::max_nprobe, oricfg[knowhere::IndexParams::nprobe].get<int64_t>(),
+                            MAX_NPROBE);
+        }
     }
 
     return ConfAdapter::CheckSearch(oricfg, type, mode);
@@ -124,16 +223,28 @@ IVFConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMod
 
 bool
 IVFSQConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    if (!CheckSQBits(oricfg, mode)) {
+        return false;
+    }
+    CheckOnDisk();
+
+    return IVFConfAdapter::CheckTrain(oricfg, mode);
+}
+
+bool
+IVFSQ8HConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t DEFAULT_NBITS = 8;
     oricfg[knowhere::IndexParams::nbits] = DEFAULT_NBITS;
+    CheckOnDisk();
 
     return IVFConfAdapter::CheckTrain(oricfg, mode);
 }
 
 bool
 IVFSQ8NRConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
-    static int64_t DEFAULT_NBITS = 8;
-    oricfg[knowhere::IndexParams::nbits] = DEFAULT_NBITS;
+    if (!CheckSQBits(oricfg, mode)) {
+        return false;
+    }
 
     return IVFConfAdapter::CheckTrain(oricfg, mode);
 }
@@ -151,6 +262,7 @@ IVFPQConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
     CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
+    CheckOnDisk();
 
     // int64_t nlist = oricfg[knowhere::IndexParams::nlist];
     // CheckIntByRange(knowhere::meta::ROWS, nlist, DEFAULT_MAX_ROWS);
@@ -158,14 +270,21 @@ IVFPQConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     // auto tune params
     oricfg[knowhere::IndexParams::nlist] =
         MatchNlist(oricfg[knowhere::meta::ROWS].get<int64_t>(), oricfg[knowhere::IndexParams::nlist].get<int64_t>());
+    if (!CheckIVFTrainParams(oricfg)) {
+        return false;
+    }
 
     // Best Practice
     // static int64_t MIN_POINTS_PER_CENTROID = 40;
     // static int64_t MAX_POINTS_PER_CENTROID = 256;
     // CheckIntByRange(knowhere::meta::ROWS, MIN_POINTS_PER_CENTROID * nlist, MAX_POINTS_PER_CENTROID * nlist);
 
+    // m splits the vectors the quantizer gets, after the transforms in front of it
+    int64_t dimension;
+    if (!CheckPreprocess(oricfg, mode, dimension)) {
+        return false;
+    }
     std::vector<int64_t> resset;
-    int64_t dimension = oricfg[knowhere::meta::DIM].get<int64_t>();
     IVFPQConfAdapter::GetValidMList(dimension, resset);
 
     CheckIntByValues(knowhere::IndexParams::m, resset);
@@ -195,6 +314,21 @@ IVFPQConfAdapter::GetValidMList(int64_t dimension, std::vector<int64_t>& resset)
     }
 }
 
+bool
+IVFPQFastScanConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static int64_t FAST_SCAN_NBITS = 4;
+
+    if (!IVFPQConfAdapter::CheckTrain(oricfg, mode)) {
+        return false;
+    }
+    // the packed copy of the codes that is scanned lives on the heap anyway
+    if (oricfg.contains(knowhere::IndexParams::on_disk) && oricfg[knowhere::IndexParams::on_disk].get<bool>()) {
+        return false;
+    }
+    oricfg[knowhere::IndexParams::nbits] = FAST_SCAN_NBITS;
+    return true;
+}
+
 bool
 NSGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_KNNG = 5;
@@ -208,6 +342,7 @@ NSGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
 
     CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckNoPreprocess();
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
     CheckIntByRange(knowhere::IndexParams::knng, MIN_KNNG, MAX_KNNG);
     CheckIntByRange(knowhere::IndexParams::search_length, MIN_SEARCH_LENGTH, MAX_SEARCH_LENGTH);
@@ -243,6 +378,9 @@ HNSWConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
     CheckIntByRange(knowhere::IndexParams::efConstruction, MIN_EFCONSTRUCTION, MAX_EFCONSTRUCTION);
     CheckIntByRange(knowhere::IndexParams::M, MIN_M, MAX_M);
+    if (oricfg.contains(knowhere::IndexParams::reorder) && !oricfg[knowhere::IndexParams::reorder].is_boolean()) {
+        return false;
+    }
 
     return ConfAdapter::CheckTrain(oricfg, mode);
 }
@@ -256,6 +394,48 @@ HNSWConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMo
     return ConfAdapter::CheckSearch(oricfg, type, mode);
 }
 
+bool
+DiskANNConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    // PQ with 8 bits codes needs 256 training vectors
+    static int64_t MIN_ROWS = 256;
+    static int64_t MIN_OUT_DEGREE = 5;
+    static int64_t MAX_OUT_DEGREE = 300;
+    static int64_t MIN_CANDIDATE_POOL_SIZE = 50;
+    static int64_t MAX_CANDIDATE_POOL_SIZE = 1000;
+    static std::vector<std::string> METRICS{knowhere::Metric::L2};
+
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    CheckIntByRange(knowhere::meta::ROWS, MIN_ROWS, DEFAULT_MAX_ROWS);
+    CheckIntByRange(knowhere::IndexParams::out_degree, MIN_OUT_DEGREE, MAX_OUT_DEGREE);
+    CheckIntByRange(knowhere::IndexParams::candidate, MIN_CANDIDATE_POOL_SIZE, MAX_CANDIDATE_POOL_SIZE);
+    CheckNoPreprocess();
+
+    int64_t dimension = oricfg[knowhere::meta::DIM].get<int64_t>();
+    CheckIntByRange(knowhere::IndexParams::m, 1, dimension);
+    if (dimension % oricfg[knowhere::IndexParams::m].get<int64_t>() != 0) {
+        return false;
+    }
+
+    return true;
+}
+
+bool
+DiskANNConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) {
+    static int64_t MAX_SEARCH_LENGTH = 4096;
+    static int64_t DEFAULT_BEAM_WIDTH = 4;
+    static int64_t MIN_BEAM_WIDTH = 1;
+    static int64_t MAX_BEAM_WIDTH = 64;
+
+    CheckIntByRange(knowhere::IndexParams::search_length, oricfg[knowhere::meta::TOPK], MAX_SEARCH_LENGTH);
+    if (!oricfg.contains(knowhere::IndexParams::beam_width)) {
+        oricfg[knowhere::IndexParams::beam_width] = DEFAULT_BEAM_WIDTH;
+    }
+    CheckIntByRange(knowhere::IndexParams::beam_width, MIN_BEAM_WIDTH, MAX_BEAM_WIDTH);
+
+    return ConfAdapter::CheckSearch(oricfg, type, mode);
+}
+
 bool
 HNSWSQ8NRConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_EFCONSTRUCTION = 8;
@@ -266,6 +446,12 @@ HNSWSQ8NRConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
     CheckIntByRange(knowhere::IndexParams::efConstruction, MIN_EFCONSTRUCTION, MAX_EFCONSTRUCTION);
     CheckIntByRange(knowhere::IndexParams::M, MIN_M, MAX_M);
+    if (oricfg.contains(knowhere::IndexParams::reorder) && !oricfg[knowhere::IndexParams::reorder].is_boolean()) {
+        return false;
+    }
+    if (!CheckSQBits(oricfg, mode)) {
+        return false;
+    }
 
     return ConfAdapter::CheckTrain(oricfg, mode);
 }
@@ -287,6 +473,7 @@ BinIDMAPConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
 
     CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
     CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckNoPreprocess();
 
     return true;
 }
@@ -302,6 +489,7 @@ BinIVFConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
     CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
     CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckNoPreprocess();
 
     int64_t nlist = oricfg[knowhere::IndexParams::nlist];
     CheckIntByRange(knowhere::meta::ROWS, nlist, DEFAULT_MAX_ROWS);
@@ -314,6 +502,36 @@ BinIVFConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     return true;
 }
 
+bool
+BinHashConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static std::vector<std::string> METRICS{knowhere::Metric::HAMMING};
+    static int64_t MAX_NBITS = 32;
+    static int64_t MIN_NBITS = 1;
+
+    CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    CheckIntByRange(knowhere::IndexParams::nbits, MIN_NBITS, MAX_NBITS);
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckNoPreprocess();
+
+    // the hash keys are cut from the code without overlapping
+    int64_t dim = oricfg[knowhere::meta::DIM];
+    int64_t nbits = oricfg[knowhere::IndexParams::nbits];
+    CheckIntByRange(knowhere::IndexParams::nhash, 1, dim / nbits);
+
+    return true;
+}
+
+bool
+BinHashConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) {
+    // the buckets looked up grow as nbits^nflip
+    static int64_t MAX_NFLIP = 8;
+
+    CheckIntByRange(knowhere::IndexParams::nflip, 0, MAX_NFLIP);
+
+    return ConfAdapter::CheckSearch(oricfg, type, mode);
+}
+
 bool
 ANNOYConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_NTREES = 1;
@@ -46,6 +46,13 @@ class IVFSQConfAdapter : public IVFConfAdapter {
     CheckTrain(Config& oricfg, const IndexMode mode) override;
 };
 
+// the hybrid index quantizes by 8 bits only
+class IVFSQ8HConfAdapter : public IVFConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class IVFPQConfAdapter : public IVFConfAdapter {
  public:
     bool
@@ -55,6 +62,12 @@ class IVFPQConfAdapter : public IVFConfAdapter {
     GetValidMList(int64_t dimension, std::vector<int64_t>& resset);
 };
 
+class IVFPQFastScanConfAdapter : public IVFPQConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class NSGConfAdapter : public IVFConfAdapter {
  public:
     bool
@@ -76,6 +89,15 @@ class BinIVFConfAdapter : public IVFConfAdapter {
     CheckTrain(Config& oricfg, const IndexMode mode) override;
 };
 
+class BinHashConfAdapter : public ConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+
+    bool
+    CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
+};
+
 class HNSWConfAdapter : public ConfAdapter {
  public:
     bool
@@ -94,6 +116,15 @@ class ANNOYConfAdapter : public ConfAdapter {
     CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
 };
 
+class DiskANNConfAdapter : public ConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+
+    bool
+    CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
+};
+
 class HNSWSQ8NRConfAdapter : public ConfAdapter {
  public:
     bool
@@ -71,7 +71,16 @@ IndexAnnoy::Load(const BinarySet& index_binary) {
 
     auto index_data = index_binary.GetByName("annoy_index_data");
     char* p = nullptr;
-    if (!index_->load_index(reinterpret_cast<void*>(index_data->data.get()), index_data->size, &p)) {
+    bool loaded;
+    if (index_data->mapped) {
+        // the nodes are used in place instead of copied, the load does not read the file
+        loaded = index_->load_index_in_place(reinterpret_cast<void*>(index_data->data.get()), index_data->size, &p);
+        mapped_data_ = index_data;
+    } else {
+        loaded = index_->load_index(reinterpret_cast<void*>(index_data->data.get()), index_data->size, &p);
+        mapped_data_ = nullptr;
+    }
+    if (!loaded) {
         std::string error_msg(p);
         free(p);
         KNOWHERE_THROW_MSG(error_msg);
@@ -118,22 +127,28 @@ IndexAnnoy::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     auto p_dist = (float*)malloc(all_num * sizeof(float));
     faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
 
-#pragma omp parallel for
-    for (unsigned int i = 0; i < rows; ++i) {
+#pragma omp parallel
+    {
+        // reused by the queries of a thread
         std::vector<int64_t> result;
         result.reserve(k);
         std::vector<float> distances;
         distances.reserve(k);
-        index_->get_nns_by_vector((const float*)p_data + i * dim, k, search_k, &result, &distances, blacklist);
-
-        int64_t result_num = result.size();
-        auto local_p_id = p_id + k * i;
-        auto local_p_dist = p_dist + k * i;
-        memcpy(local_p_id, result.data(), result_num * sizeof(int64_t));
-        memcpy(local_p_dist, distances.data(), result_num * sizeof(float));
-        for (; result_num < k; result_num++) {
-            local_p_id[result_num] = -1;
-            local_p_dist[result_num] = 1.0 / 0.0;
+#pragma omp for
+        for (unsigned int i = 0; i < rows; ++i) {
+            result.clear();
+            distances.clear();
+            index_->get_nns_by_vector((const float*)p_data + i * dim, k, search_k, &result, &distances, blacklist);
+
+            int64_t result_num = result.size();
+            auto local_p_id = p_id + k * i;
+            auto local_p_dist = p_dist + k * i;
+            memcpy(local_p_id, result.data(), result_num * sizeof(int64_t));
+            memcpy(local_p_dist, distances.data(), result_num * sizeof(float));
+            for (; result_num < k; result_num++) {
+                local_p_id[result_num] = -1;
+                local_p_dist[result_num] = 1.0 / 0.0;
+            }
         }
     }
 
@@ -159,5 +174,13 @@ IndexAnnoy::Dim() {
     return index_->get_dim();
 }
 
+int64_t
+IndexAnnoy::IndexSize() {
+    if (mapped_data_ == nullptr) {
+        return VecIndex::IndexSize();
+    }
+    return VecIndex::IndexSize() - mapped_data_->size;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -62,9 +62,15 @@ class IndexAnnoy : public VecIndex {
     int64_t
     Dim() override;
 
+    // only the resident part when the nodes are used in place in the mapped index file
+    int64_t
+    IndexSize() override;
+
  private:
     MetricType metric_type_;
     std::shared_ptr<AnnoyIndexInterface<int64_t, float>> index_ = nullptr;
+    // the mapped index data the nodes are used in place from, kept alive as long as the index
+    BinaryPtr mapped_data_ = nullptr;
 };
 
 }  // namespace knowhere
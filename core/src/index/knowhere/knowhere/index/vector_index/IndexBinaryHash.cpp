@@ -0,0 +1,152 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/IndexBinaryHash.h"
+
+#include <faiss/IndexBinaryHash.h>
+#include <faiss/impl/AuxIndexStructures.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+
+namespace milvus {
+namespace knowhere {
+
+BinarySet
+BinaryHash::Serialize(const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    return SerializeImpl(index_type_);
+}
+
+void
+BinaryHash::Load(const BinarySet& index_binary) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    LoadImpl(index_binary, index_type_);
+}
+
+void
+BinaryHash::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    GET_TENSOR_DATA_DIM(dataset_ptr)
+
+    int64_t nhash = config[IndexParams::nhash];
+    int64_t nbits = config[IndexParams::nbits];
+    try {
+        auto index = std::make_shared<faiss::IndexBinaryMultiHash>(dim, nhash, nbits);
+        index->metric_type = faiss::METRIC_Hamming;
+        // the labels are the row offsets, as the ids of the raw data the index is built from
+        index->add(rows, (const uint8_t*)p_data);
+        index_ = index;
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+DatasetPtr
+BinaryHash::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto elems = rows * k;
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * elems);
+    auto p_dist = (float*)malloc(sizeof(float) * elems);
+
+    QueryInto(dataset_ptr, config, p_id, p_dist);
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+BinaryHash::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto elems = rows * k;
+
+    // the hamming distances are written as int32 in place, then converted
+    auto pi_dist = (int32_t*)distances;
+    SetSearchParams(config);
+    index_->search(rows, (const uint8_t*)p_data, k, pi_dist, ids, bitset_);
+    for (int64_t i = 0; i < elems; i++) {
+        distances[i] = (float)pi_dist[i];
+    }
+}
+
+DatasetPtr
+BinaryHash::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    // hamming distances are integers, a distance below radius is at most ceil(radius) - 1
+    auto radius = static_cast<int>(std::ceil(config[meta::RADIUS].get<float>()));
+    faiss::RangeSearchResult result(rows);
+    SetSearchParams(config);
+    index_->range_search(rows, (const uint8_t*)p_data, radius, &result, bitset_);
+    return GenRangeResultDataset(result);
+}
+
+int64_t
+BinaryHash::Count() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->ntotal;
+}
+
+int64_t
+BinaryHash::Dim() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->d;
+}
+
+int64_t
+BinaryHash::IndexSize() {
+    auto hash_index = dynamic_cast<faiss::IndexBinaryMultiHash*>(index_.get());
+    if (hash_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    // the codes, the ids of every table and a key with a list per bucket
+    int64_t buckets = hash_index->hashtable_size();
+    return hash_index->ntotal * (hash_index->code_size + hash_index->nhash * sizeof(int64_t)) +
+           buckets * (sizeof(int64_t) + sizeof(std::vector<int64_t>));
+}
+
+void
+BinaryHash::SetSearchParams(const Config& config) {
+    auto hash_index = dynamic_cast<faiss::IndexBinaryMultiHash*>(index_.get());
+    if (hash_index != nullptr && config.contains(IndexParams::nflip)) {
+        // the flips enumerated are bounded by the bits of a key
+        hash_index->nflip = std::min(config[IndexParams::nflip].get<int64_t>(), (int64_t)hash_index->b);
+    }
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/FaissBaseBinaryIndex.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus {
+namespace knowhere {
+
+// Multi-index hashing of binary vectors, hamming metric only. The code is cut in nhash substrings of nbits bits, each
+// the key of a hash table, a search looks up the buckets of the query substrings with up to nflip bits flipped and
+// ranks the vectors found by their full hamming distance. A vector within radius r of the query is within r / nhash
+// of it on one substring at least, so a range search with nflip >= (r - 1) / nhash misses none.
+// Search results are row offsets.
+class BinaryHash : public VecIndex, public FaissBaseBinaryIndex {
+ public:
+    BinaryHash() : FaissBaseBinaryIndex(nullptr) {
+        index_type_ = IndexEnum::INDEX_FAISS_BIN_HASH;
+    }
+
+    explicit BinaryHash(std::shared_ptr<faiss::IndexBinary> index) : FaissBaseBinaryIndex(std::move(index)) {
+        index_type_ = IndexEnum::INDEX_FAISS_BIN_HASH;
+    }
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    BuildAll(const DatasetPtr& dataset_ptr, const Config& config) override {
+        Train(dataset_ptr, config);
+    }
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    void
+    Train(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset_ptr, const Config& config) override {
+        KNOWHERE_THROW_MSG("not support yet");
+    }
+
+    void
+    AddWithoutIds(const DatasetPtr&, const Config&) override {
+        KNOWHERE_THROW_MSG("AddWithoutIds is not supported");
+    }
+
+    DatasetPtr
+    Query(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    int64_t
+    Count() override;
+
+    int64_t
+    Dim() override;
+
+    int64_t
+    IndexSize() override;
+
+ protected:
+    void
+    SetSearchParams(const Config& config);
+
+ protected:
+    std::mutex mutex_;
+};
+
+using BinaryHashIndexPtr = std::shared_ptr<BinaryHash>;
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -13,8 +13,10 @@
 
 #include <faiss/IndexBinaryFlat.h>
 #include <faiss/MetaIndexes.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_factory.h>
 
+#include <cmath>
 #include <string>
 
 #include "knowhere/common/Exception.h"
@@ -53,23 +55,49 @@ BinaryIDMAP::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     auto p_id = (int64_t*)malloc(p_id_size);
     auto p_dist = (float*)malloc(p_dist_size);
 
-    QueryImpl(rows, (uint8_t*)p_data, k, p_dist, p_id, Config());
+    QueryInto(dataset_ptr, config, p_id, p_dist);
 
     auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+BinaryIDMAP::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto elems = rows * k;
+    QueryImpl(rows, (uint8_t*)p_data, k, distances, ids, Config());
+
+    // the hamming distances are written as int32 in place, then converted
     if (index_->metric_type == faiss::METRIC_Hamming) {
-        auto pf_dist = (float*)malloc(p_dist_size);
-        int32_t* pi_dist = (int32_t*)p_dist;
-        for (int i = 0; i < elems; i++) {
-            *(pf_dist + i) = (float)(*(pi_dist + i));
+        auto pi_dist = (int32_t*)distances;
+        for (int64_t i = 0; i < elems; i++) {
+            distances[i] = (float)pi_dist[i];
         }
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, pf_dist);
-        free(p_dist);
-    } else {
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, p_dist);
     }
-    return ret_ds;
+}
+
+DatasetPtr
+BinaryIDMAP::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    if (index_->metric_type != faiss::METRIC_Hamming) {
+        KNOWHERE_THROW_MSG("range search only supports the hamming metric");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    // hamming distances are integers, a distance below radius is at most ceil(radius) - 1
+    auto radius = static_cast<int>(std::ceil(config[meta::RADIUS].get<float>()));
+    faiss::RangeSearchResult result(rows);
+    index_->range_search(rows, (uint8_t*)p_data, radius, &result, bitset_);
+    return GenRangeResultDataset(result);
 }
 
 #if 0
@@ -50,6 +50,13 @@ class BinaryIDMAP : public VecIndex, public FaissBaseBinaryIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t* ids, float* distances) override;
+
+    // hamming metric only
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset_ptr, const Config& config) override;
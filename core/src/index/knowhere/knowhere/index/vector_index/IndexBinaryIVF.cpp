@@ -50,32 +50,43 @@ BinaryIVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
     GET_TENSOR_DATA(dataset_ptr)
 
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto elems = rows * k;
+
+    size_t p_id_size = sizeof(int64_t) * elems;
+    size_t p_dist_size = sizeof(float) * elems;
+    auto p_id = (int64_t*)malloc(p_id_size);
+    auto p_dist = (float*)malloc(p_dist_size);
+
+    QueryInto(dataset_ptr, config, p_id, p_dist);
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+BinaryIVF::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GET_TENSOR_DATA(dataset_ptr)
+
     try {
         int64_t k = config[meta::TOPK].get<int64_t>();
         auto elems = rows * k;
 
-        size_t p_id_size = sizeof(int64_t) * elems;
-        size_t p_dist_size = sizeof(float) * elems;
-        auto p_id = (int64_t*)malloc(p_id_size);
-        auto p_dist = (float*)malloc(p_dist_size);
-
-        QueryImpl(rows, (uint8_t*)p_data, k, p_dist, p_id, config);
+        QueryImpl(rows, (uint8_t*)p_data, k, distances, ids, config);
 
-        auto ret_ds = std::make_shared<Dataset>();
+        // the hamming distances are written as int32 in place, then converted
         if (index_->metric_type == faiss::METRIC_Hamming) {
-            auto pf_dist = (float*)malloc(p_dist_size);
-            int32_t* pi_dist = (int32_t*)p_dist;
-            for (int i = 0; i < elems; i++) {
-                *(pf_dist + i) = (float)(*(pi_dist + i));
+            auto pi_dist = (int32_t*)distances;
+            for (int64_t i = 0; i < elems; i++) {
+                distances[i] = (float)pi_dist[i];
             }
-            ret_ds->Set(meta::IDS, p_id);
-            ret_ds->Set(meta::DISTANCE, pf_dist);
-            free(p_dist);
-        } else {
-            ret_ds->Set(meta::IDS, p_id);
-            ret_ds->Set(meta::DISTANCE, p_dist);
         }
-        return ret_ds;
     } catch (faiss::FaissException& e) {
         KNOWHERE_THROW_MSG(e.what());
     } catch (std::exception& e) {
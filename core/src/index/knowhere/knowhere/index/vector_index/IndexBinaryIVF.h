@@ -62,6 +62,9 @@ class BinaryIVF : public VecIndex, public FaissBaseBinaryIndex {
     DatasetPtr
     Query(const DatasetPtr& dataset_ptr, const Config& config) override;
 
+    void
+    QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset_ptr, const Config& config) override;
@@ -0,0 +1,133 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "knowhere/index/vector_index/IndexDiskANN.h"
+
+#include <string>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+constexpr const char* DISKANN_META = "DISKANN_META";
+constexpr const char* DISKANN_DATA = "DISKANN_DATA";
+constexpr float DISKANN_ALPHA = 1.2f;
+}  // namespace
+
+BinarySet
+IndexDiskANN::Serialize(const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    int64_t meta_size;
+    auto meta = index_->SerializeMeta(meta_size);
+
+    BinarySet res_set;
+    res_set.Append(DISKANN_META, meta, meta_size);
+    res_set.Append(DISKANN_DATA, index_->Sectors(), index_->SectorsSize());
+    return res_set;
+}
+
+void
+IndexDiskANN::Load(const BinarySet& index_binary) {
+    auto meta = index_binary.GetByName(DISKANN_META);
+    auto data = index_binary.GetByName(DISKANN_DATA);
+
+    // the sectors are used in place: a mapped index file is paged in node by node while searching
+    index_ = std::make_shared<impl::DiskANNIndex>();
+    index_->Load(meta->data.get(), meta->size, data->data, data->size, data->mapped);
+}
+
+void
+IndexDiskANN::BuildAll(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (index_) {
+        // it is builded all
+        LOG_KNOWHERE_DEBUG_ << "IndexDiskANN::BuildAll: index_ has been built!";
+        return;
+    }
+
+    GET_TENSOR_DATA_DIM(dataset_ptr)
+
+    if (config[Metric::TYPE] != Metric::L2) {
+        KNOWHERE_THROW_MSG("metric not supported " + config[Metric::TYPE].get<std::string>());
+    }
+
+    impl::DiskANNIndex::BuildParams params;
+    params.max_degree = config[IndexParams::out_degree].get<int64_t>();
+    params.search_length = config[IndexParams::candidate].get<int64_t>();
+    params.alpha = DISKANN_ALPHA;
+    params.pq_m = config[IndexParams::m].get<int64_t>();
+
+    auto index = std::make_shared<impl::DiskANNIndex>();
+    index->Build(rows, dim, (const float*)p_data, params);
+    index_ = index;
+}
+
+DatasetPtr
+IndexDiskANN::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GET_TENSOR_DATA_DIM(dataset_ptr)
+    auto k = config[meta::TOPK].get<int64_t>();
+    auto all_num = rows * k;
+    auto p_id = (int64_t*)malloc(all_num * sizeof(int64_t));
+    auto p_dist = (float*)malloc(all_num * sizeof(float));
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+
+    impl::DiskANNIndex::SearchParams params;
+    params.search_length = config[IndexParams::search_length].get<int64_t>();
+    params.beam_width = config[IndexParams::beam_width].get<int64_t>();
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < rows; ++i) {
+        index_->Search((const float*)p_data + i * dim, k, params, p_dist + i * k, p_id + i * k, blacklist);
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+int64_t
+IndexDiskANN::Count() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->Count();
+}
+
+int64_t
+IndexDiskANN::Dim() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->Dim();
+}
+
+int64_t
+IndexDiskANN::IndexSize() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->ResidentSize();
+}
+
+}  // namespace knowhere
+}  // namespace milvus
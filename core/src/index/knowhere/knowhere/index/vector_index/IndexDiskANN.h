@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+#include "knowhere/index/vector_index/impl/diskann/DiskANN.h"
+
+namespace milvus {
+namespace knowhere {
+
+// Vamana graph with the vectors and the adjacency lists kept in sectors on disk, only PQ codes on the heap.
+// Search results are row offsets.
+class IndexDiskANN : public VecIndex {
+ public:
+    IndexDiskANN() {
+        index_type_ = IndexEnum::INDEX_DISKANN;
+    }
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    void
+    BuildAll(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    Train(const DatasetPtr& dataset_ptr, const Config& config) override {
+        KNOWHERE_THROW_MSG("DiskANN not support build item dynamically, please invoke BuildAll interface.");
+    }
+
+    void
+    Add(const DatasetPtr& dataset_ptr, const Config& config) override {
+        KNOWHERE_THROW_MSG("DiskANN not support add item dynamically, please invoke BuildAll interface.");
+    }
+
+    void
+    AddWithoutIds(const DatasetPtr&, const Config&) override {
+        KNOWHERE_THROW_MSG("Incremental index is not supported");
+    }
+
+    DatasetPtr
+    Query(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    int64_t
+    Count() override;
+
+    int64_t
+    Dim() override;
+
+    // the sectors are left out once they alias the index file mapping, the page cache holds them
+    int64_t
+    IndexSize() override;
+
+ private:
+    std::shared_ptr<impl::DiskANNIndex> index_ = nullptr;
+};
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -29,6 +29,9 @@
 namespace milvus {
 namespace knowhere {
 
+// number of points inserted serially at the start of a build
+constexpr int64_t HNSW_SERIAL_ADD_ROWS = 1000;
+
 // void
 // normalize_vector(float* data, float* norm_array, size_t dim) {
 //     float norm = 0.0f;
@@ -123,12 +126,22 @@ IndexHNSW::Add(const DatasetPtr& dataset_ptr, const Config& config) {
     //         }
     //     }
 
-    index_->addPoint(p_data, p_ids[0]);
-#pragma omp parallel for
-    for (int i = 1; i < rows; ++i) {
+    // the first points are inserted serially so that the upper layers are built before the threads contend
+    // on them, the rest go in parallel under the per node locks of hnswlib
+    int64_t serial_rows = std::min<int64_t>(rows, HNSW_SERIAL_ADD_ROWS);
+    for (int64_t i = 0; i < serial_rows; ++i) {
         faiss::BuilderSuspend::check_wait();
         index_->addPoint(((float*)p_data + Dim() * i), p_ids[i]);
     }
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int64_t i = serial_rows; i < rows; ++i) {
+        faiss::BuilderSuspend::check_wait();
+        index_->addPoint(((float*)p_data + Dim() * i), p_ids[i]);
+    }
+
+    if (config.contains(IndexParams::reorder) && config[IndexParams::reorder].get<bool>()) {
+        index_->reorderByBFS();
+    }
 }
 
 DatasetPtr
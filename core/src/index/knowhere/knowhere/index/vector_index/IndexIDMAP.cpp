@@ -13,9 +13,11 @@
 
 #include <faiss/AutoTune.h>
 #include <faiss/IndexFlat.h>
+#include <faiss/IndexScalarQuantizer.h>
 #include <faiss/MetaIndexes.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuCloner.h>
@@ -54,7 +56,18 @@ IDMAP::Load(const BinarySet& binary_set) {
 
 void
 IDMAP::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    // the compressed vectors are decoded by the distance computation of the scalar quantizer
     const char* desc = "IDMap,Flat";
+    if (config.contains(IndexParams::compression)) {
+        auto compression = config[IndexParams::compression].get<std::string>();
+        if (compression == Compression::SQ8) {
+            desc = "IDMap,SQ8";
+        } else if (compression == Compression::FP16) {
+            desc = "IDMap,SQfp16";
+        } else if (compression != Compression::NONE) {
+            KNOWHERE_THROW_MSG("Unsupported compression: " + compression);
+        }
+    }
     int64_t dim = config[meta::DIM].get<int64_t>();
     faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
     auto index = faiss::index_factory(dim, desc, metric_type);
@@ -69,6 +82,9 @@ IDMAP::Add(const DatasetPtr& dataset_ptr, const Config& config) {
 
     std::lock_guard<std::mutex> lk(mutex_);
     GET_TENSOR_DATA_ID(dataset_ptr)
+    if (!index_->is_trained) {
+        index_->train(rows, (float*)p_data);
+    }
     index_->add_with_ids(rows, (float*)p_data, p_ids);
 }
 
@@ -88,6 +104,10 @@ IDMAP::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
         new_ids[i] = i;
     }
 
+    // the value ranges of sq8 are those of the first vectors added
+    if (!index_->is_trained) {
+        index_->train(rows, (float*)p_data);
+    }
     index_->add_with_ids(rows, (float*)p_data, new_ids.data());
 }
 
@@ -105,7 +125,7 @@ IDMAP::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     auto p_id = (int64_t*)malloc(p_id_size);
     auto p_dist = (float*)malloc(p_dist_size);
 
-    QueryImpl(rows, (float*)p_data, k, p_dist, p_id, Config());
+    QueryInto(dataset_ptr, config, p_id, p_dist);
 
     auto ret_ds = std::make_shared<Dataset>();
     ret_ds->Set(meta::IDS, p_id);
@@ -113,6 +133,35 @@ IDMAP::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     return ret_ds;
 }
 
+void
+IDMAP::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto bounds = GetDatasetBounds(dataset_ptr);
+    if (bounds != nullptr) {
+        BoundedQueryImpl(rows, (float*)p_data, k, distances, ids, Config(), bounds);
+    } else {
+        QueryImpl(rows, (float*)p_data, k, distances, ids, Config());
+    }
+}
+
+DatasetPtr
+IDMAP::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset_ptr)
+
+    auto radius = config[meta::RADIUS].get<float>();
+    faiss::RangeSearchResult result(rows);
+    index_->range_search(rows, (float*)p_data, radius, &result, bitset_);
+    return GenRangeResultDataset(result);
+}
+
 #if 0
 DatasetPtr
 IDMAP::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
@@ -158,6 +207,22 @@ IDMAP::Dim() {
     return index_->d;
 }
 
+int64_t
+IDMAP::IndexSize() {
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto sq = id_map ? dynamic_cast<faiss::IndexScalarQuantizer*>(id_map->index) : nullptr;
+    if (sq != nullptr) {
+        return Count() * (sq->code_size + sizeof(int64_t));
+    }
+    return Count() * Dim() * sizeof(FloatType);
+}
+
+bool
+IDMAP::Compressed() {
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    return id_map != nullptr && dynamic_cast<faiss::IndexFlat*>(id_map->index) == nullptr;
+}
+
 VecIndexPtr
 IDMAP::CopyCpuToGpu(const int64_t device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
@@ -181,7 +246,7 @@ IDMAP::GetRawVectors() {
     try {
         auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
         auto flat_index = dynamic_cast<faiss::IndexFlat*>(file_index->index);
-        return flat_index->xb.data();
+        return flat_index != nullptr ? flat_index->xb.data() : nullptr;
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
     }
@@ -224,5 +289,21 @@ IDMAP::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int6
     index_->search(n, (float*)data, k, distances, labels, bitset_);
 }
 
+void
+IDMAP::BoundedQueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                        const Config& config, const float* bounds) {
+    auto id_map = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat = id_map ? dynamic_cast<faiss::IndexFlat*>(id_map->index) : nullptr;
+    if (flat == nullptr) {
+        QueryImpl(n, data, k, distances, labels, config);
+        return;
+    }
+
+    flat->search_bounded(n, data, k, distances, labels, bounds, bitset_);
+    for (int64_t i = 0; i < n * k; ++i) {
+        labels[i] = labels[i] < 0 ? labels[i] : id_map->id_map[labels[i]];
+    }
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -48,6 +48,12 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t* ids, float* distances) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -60,9 +66,11 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     Dim() override;
 
     int64_t
-    IndexSize() override {
-        return Count() * Dim() * sizeof(FloatType);
-    }
+    IndexSize() override;
+
+    // whether the vectors are held compressed, there are no raw vectors then
+    bool
+    Compressed();
 
 #if 0
     DatasetPtr
@@ -72,6 +80,7 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     VecIndexPtr
     CopyCpuToGpu(const int64_t, const Config&);
 
+    // nullptr for compressed vectors
     virtual const float*
     GetRawVectors();
 
@@ -82,6 +91,10 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     virtual void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&);
 
+    // QueryImpl that only keeps the results beating the per query bounds, indexes which can't prune ignore them
+    virtual void
+    BoundedQueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&, const float* bounds);
+
  protected:
     std::mutex mutex_;
 };
@@ -15,7 +15,10 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/InvertedLists.h>
 #include <faiss/clone_index.h>
+#include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/impl/io.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
@@ -35,9 +38,11 @@
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/gpu/IndexGPUIVF.h"
+#include "knowhere/index/vector_index/gpu/IndexGPUIVFShards.h"
 #include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
 #endif
 
@@ -46,6 +51,26 @@ namespace knowhere {
 
 using stdclock = std::chrono::high_resolution_clock;
 
+namespace {
+
+// marks an index built with on_disk, the flag is not part of the faiss index
+constexpr const char* IVF_ON_DISK = "IVF_ON_DISK";
+
+// a batch of queries scans each probed list once when the scanner is cheap to point at another query,
+// IVFPQ rebuilds its distance tables per query so it keeps scanning query by query
+int
+SearchParallelMode(faiss::IndexIVF* ivf_index, int64_t n, int64_t nprobe) {
+    if (nprobe > 1 && n <= 4) {
+        return 1;
+    }
+    if (dynamic_cast<faiss::IndexIVFPQ*>(ivf_index) == nullptr) {
+        return 3;
+    }
+    return 0;
+}
+
+}  // namespace
+
 BinarySet
 IVF::Serialize(const Config& config) {
     if (!index_ || !index_->is_trained) {
@@ -53,12 +78,28 @@ IVF::Serialize(const Config& config) {
     }
 
     std::lock_guard<std::mutex> lk(mutex_);
-    return SerializeImpl(index_type_);
+    auto res_set = SerializeImpl(index_type_);
+    if (on_disk_) {
+        std::shared_ptr<uint8_t[]> flag(new uint8_t[1]{1});
+        res_set.Append(IVF_ON_DISK, flag, 1);
+    }
+    return res_set;
 }
 
 void
 IVF::Load(const BinarySet& binary_set) {
     std::lock_guard<std::mutex> lk(mutex_);
+    fingerprint_ = 0;
+    on_disk_ = binary_set.binary_map_.count(IVF_ON_DISK) > 0;
+    auto binary = binary_set.GetByName("IVF");
+    if (on_disk_ && binary->mapped) {
+        // the lists are used in place, they share the ownership of the mapping
+        faiss::MappedIOReader reader(binary->data.get(), binary->size,
+                                     std::shared_ptr<const void>(binary->data, binary->data.get()));
+        index_.reset(faiss::read_index(&reader, faiss::IO_FLAG_MMAP));
+        SealImpl();
+        return;
+    }
     LoadImpl(binary_set, index_type_);
 }
 
@@ -70,7 +111,9 @@ IVF::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
     int64_t nlist = config[IndexParams::nlist].get<int64_t>();
     index_ = std::shared_ptr<faiss::Index>(new faiss::IndexIVFFlat(coarse_quantizer, dim, nlist, metric_type));
-    index_->train(rows, (float*)p_data);
+    TrainIVF(static_cast<faiss::IndexIVF*>(index_.get()), rows, (float*)p_data, config,
+             GetDatasetCentroids(dataset_ptr));
+    on_disk_ = config.contains(IndexParams::on_disk) && config[IndexParams::on_disk].get<bool>();
 }
 
 void
@@ -103,40 +146,78 @@ IVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
     GET_TENSOR_DATA(dataset_ptr)
 
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto elems = rows * k;
+
+    size_t p_id_size = sizeof(int64_t) * elems;
+    size_t p_dist_size = sizeof(float) * elems;
+    auto p_id = (int64_t*)malloc(p_id_size);
+    auto p_dist = (float*)malloc(p_dist_size);
+
+    QueryInto(dataset_ptr, config, p_id, p_dist);
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IVF::QueryInto(const DatasetPtr& dataset_ptr, const Config& config, int64_t* ids, float* distances) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GET_TENSOR_DATA(dataset_ptr)
+
     try {
         fiu_do_on("IVF.Search.throw_std_exception", throw std::exception());
         fiu_do_on("IVF.Search.throw_faiss_exception", throw faiss::FaissException(""));
         int64_t k = config[meta::TOPK].get<int64_t>();
-        auto elems = rows * k;
 
-        size_t p_id_size = sizeof(int64_t) * elems;
-        size_t p_dist_size = sizeof(float) * elems;
-        auto p_id = (int64_t*)malloc(p_id_size);
-        auto p_dist = (float*)malloc(p_dist_size);
+        auto bounds = GetDatasetBounds(dataset_ptr);
+        auto cancel = GetDatasetCancel(dataset_ptr);
+        const int64_t* coarse_ids = nullptr;
+        const float* coarse_distances = nullptr;
+        if (GetDatasetCoarseAssign(dataset_ptr, coarse_ids, coarse_distances)) {
+            PreassignedQueryImpl(rows, (float*)p_data, k, distances, ids, config, coarse_ids, coarse_distances, bounds,
+                                 cancel);
+        } else if (bounds != nullptr || cancel != nullptr) {
+            BoundedQueryImpl(rows, (float*)p_data, k, distances, ids, config, bounds, cancel);
+        } else {
+            QueryImpl(rows, (float*)p_data, k, distances, ids, config);
+        }
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
 
-        QueryImpl(rows, (float*)p_data, k, p_dist, p_id, config);
+DatasetPtr
+IVF::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        KNOWHERE_THROW_MSG("range search not supported by index type " + index_type_);
+    }
 
-        //    std::stringstream ss_res_id, ss_res_dist;
-        //    for (int i = 0; i < 10; ++i) {
-        //        printf("%llu", p_id[i]);
-        //        printf("\n");
-        //        printf("%.6f", p_dist[i]);
-        //        printf("\n");
-        //        ss_res_id << p_id[i] << " ";
-        //        ss_res_dist << p_dist[i] << " ";
-        //    }
-        //    std::cout << std::endl << "after search: " << std::endl;
-        //    std::cout << ss_res_id.str() << std::endl;
-        //    std::cout << ss_res_dist.str() << std::endl << std::endl;
+    GET_TENSOR_DATA(dataset_ptr)
 
-        auto ret_ds = std::make_shared<Dataset>();
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, p_dist);
-        return ret_ds;
+    try {
+        auto radius = config[meta::RADIUS].get<float>();
+        // the lists of a range search are not pruned, max_nprobe is left to the top k searches
+        ivf_index->nprobe = config[IndexParams::nprobe].get<int64_t>();
+        ivf_index->prune_lists = false;
+        // the range search has no list major mode, the lists are split between the threads for a few queries
+        ivf_index->parallel_mode = ivf_index->nprobe > 1 && rows <= 4 ? 1 : 0;
+        faiss::RangeSearchResult result(rows);
+        ivf_index->range_search(rows, (float*)p_data, radius, &result, bitset_);
+        return GenRangeResultDataset(result);
     } catch (faiss::FaissException& e) {
         KNOWHERE_THROW_MSG(e.what());
-    } catch (std::exception& e) {
-        KNOWHERE_THROW_MSG(e.what());
     }
 }
 
@@ -231,6 +312,33 @@ IVF::Dim() {
     return index_->d;
 }
 
+uint64_t
+IVF::CentroidsFingerprint() {
+    auto fingerprint = fingerprint_.load();
+    if (fingerprint == 0) {
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+        if (ivf_index != nullptr) {
+            fingerprint = GetIVFCentroidsFingerprint(ivf_index);
+            fingerprint_ = fingerprint;
+        }
+    }
+    return fingerprint;
+}
+
+int64_t
+IVF::IndexSize() {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto mapped_lists = ivf_index ? dynamic_cast<faiss::MappedInvertedLists*>(ivf_index->invlists) : nullptr;
+    if (mapped_lists == nullptr) {
+        return VecIndex::IndexSize();
+    }
+    int64_t mapped_size = 0;
+    for (auto& list : mapped_lists->lists) {
+        mapped_size += list.size * (mapped_lists->code_size + sizeof(faiss::Index::idx_t));
+    }
+    return VecIndex::IndexSize() - mapped_size;
+}
+
 void
 IVF::Seal() {
     if (!index_ || !index_->is_trained) {
@@ -258,6 +366,42 @@ IVF::CopyCpuToGpu(const int64_t device_id, const Config& config) {
 #endif
 }
 
+VecIndexPtr
+IVF::CopyCpuToGpuSharded(const std::vector<int64_t>& devices, const Config& config) {
+#ifdef MILVUS_GPU_VERSION
+    std::vector<ResPtr> res;
+    std::vector<faiss::gpu::GpuResources*> faiss_res;
+    std::vector<int> device_ids;
+    for (auto device_id : devices) {
+        auto device_res = FaissGpuResourceMgr::GetInstance().GetRes(device_id);
+        if (device_res == nullptr) {
+            KNOWHERE_THROW_MSG("CopyCpuToGpuSharded Error, can't get gpu_resource of device " +
+                               std::to_string(device_id));
+        }
+        res.push_back(device_res);
+        faiss_res.push_back(device_res->faiss_res.get());
+        device_ids.push_back(device_id);
+    }
+
+    // the vectors are dealt to the shards by id modulo the shard count, every shard holds all the lists
+    // with a part of their vectors and its own copy of the quantizer
+    faiss::gpu::GpuMultipleClonerOptions option;
+    option.shard = true;
+    option.shard_type = 1;
+    std::shared_ptr<faiss::Index> device_index;
+    {
+        std::vector<std::unique_ptr<ResScope>> scopes;
+        for (size_t i = 0; i < res.size(); ++i) {
+            scopes.emplace_back(std::make_unique<ResScope>(res[i], devices[i], false));
+        }
+        device_index.reset(faiss::gpu::index_cpu_to_gpu_multiple(faiss_res, device_ids, index_.get(), &option));
+    }
+    return std::make_shared<GPUIVFShards>(device_index, devices, res);
+#else
+    KNOWHERE_THROW_MSG("Calling IVF::CopyCpuToGpuSharded when we are using CPU version");
+#endif
+}
+
 void
 IVF::GenGraph(const float* data, const int64_t k, GraphType& graph, const Config& config) {
     int64_t K = k + 1;
@@ -298,7 +442,7 @@ IVF::GenGraph(const float* data, const int64_t k, GraphType& graph, const Config
 std::shared_ptr<faiss::IVFSearchParameters>
 IVF::GenParams(const Config& config) {
     auto params = std::make_shared<faiss::IVFSearchParameters>();
-    params->nprobe = config[IndexParams::nprobe];
+    params->nprobe = GetProbeCount(config);
     // params->max_codes = config["max_codes"];
     return params;
 }
@@ -308,12 +452,9 @@ IVF::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_
     auto params = GenParams(config);
     auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
     ivf_index->nprobe = params->nprobe;
+    ivf_index->prune_lists = IsAdaptiveProbe(config);
     stdclock::time_point before = stdclock::now();
-    if (params->nprobe > 1 && n <= 4) {
-        ivf_index->parallel_mode = 1;
-    } else {
-        ivf_index->parallel_mode = 0;
-    }
+    ivf_index->parallel_mode = SearchParallelMode(ivf_index, n, params->nprobe);
     ivf_index->search(n, (float*)data, k, distances, labels, bitset_);
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
@@ -324,6 +465,55 @@ IVF::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_
     faiss::indexIVF_stats.search_time = 0;
 }
 
+void
+IVF::BoundedQueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                      const Config& config, const float* bounds, const std::atomic<bool>* cancel) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        QueryImpl(n, data, k, distances, labels, config);
+        return;
+    }
+
+    auto params = GenParams(config);
+    ivf_index->nprobe = params->nprobe;
+    ivf_index->prune_lists = IsAdaptiveProbe(config);
+    stdclock::time_point before = stdclock::now();
+    ivf_index->parallel_mode = SearchParallelMode(ivf_index, n, params->nprobe);
+    ivf_index->search_bounded(n, (float*)data, k, distances, labels, bounds, bitset_, cancel);
+    stdclock::time_point after = stdclock::now();
+    double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
+    LOG_KNOWHERE_DEBUG_ << "IVF bounded search cost: " << search_cost
+                        << ", quantization cost: " << faiss::indexIVF_stats.quantization_time
+                        << ", data search cost: " << faiss::indexIVF_stats.search_time;
+    faiss::indexIVF_stats.quantization_time = 0;
+    faiss::indexIVF_stats.search_time = 0;
+}
+
+void
+IVF::PreassignedQueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                          const Config& config, const int64_t* coarse_ids, const float* coarse_distances,
+                          const float* bounds, const std::atomic<bool>* cancel) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        QueryImpl(n, data, k, distances, labels, config);
+        return;
+    }
+
+    auto params = GenParams(config);
+    params->max_codes = ivf_index->max_codes;
+    params->bounds = bounds;
+    ivf_index->prune_lists = IsAdaptiveProbe(config);
+    params->cancel = cancel;
+    stdclock::time_point before = stdclock::now();
+    ivf_index->parallel_mode = SearchParallelMode(ivf_index, n, params->nprobe);
+    ivf_index->invlists->prefetch_lists(coarse_ids, n * params->nprobe);
+    ivf_index->search_preassigned(n, data, k, coarse_ids, coarse_distances, distances, labels, false, params.get(),
+                                  bitset_);
+    stdclock::time_point after = stdclock::now();
+    double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
+    LOG_KNOWHERE_DEBUG_ << "IVF preassigned search cost: " << search_cost;
+}
+
 void
 IVF::SealImpl() {
 #ifdef MILVUS_GPU_VERSION
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -53,6 +54,13 @@ class IVF : public VecIndex, public FaissBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    void
+    QueryInto(const DatasetPtr&, const Config&, int64_t* ids, float* distances) override;
+
+    // probes nprobe lists per query like Query
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -75,9 +83,31 @@ class IVF : public VecIndex, public FaissBaseIndex {
     virtual VecIndexPtr
     CopyCpuToGpu(const int64_t, const Config&);
 
+    // spreads the inverted lists over the devices, one shard per device
+    VecIndexPtr
+    CopyCpuToGpuSharded(const std::vector<int64_t>& devices, const Config&);
+
     virtual void
     GenGraph(const float* data, const int64_t k, GraphType& graph, const Config& config);
 
+    // only the resident part when the inverted lists are used in place in the mapped index file
+    int64_t
+    IndexSize() override;
+
+    bool
+    OnDisk() const {
+        return on_disk_;
+    }
+
+    void
+    SetOnDisk(bool on_disk) {
+        on_disk_ = on_disk;
+    }
+
+    // GetIVFCentroidsFingerprint of the index, computed by the first call after the index is loaded
+    uint64_t
+    CentroidsFingerprint();
+
  protected:
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config&);
@@ -85,11 +115,26 @@ class IVF : public VecIndex, public FaissBaseIndex {
     virtual void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&);
 
+    // QueryImpl that only keeps the results beating the per query bounds and stops once cancel is set,
+    // either may be nullptr, indexes which can't prune or stop ignore them
+    virtual void
+    BoundedQueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&, const float* bounds,
+                     const std::atomic<bool>* cancel = nullptr);
+
+    // BoundedQueryImpl probing the lists of the given nq * nprobe coarse assignment instead of searching the
+    // coarse quantizer, the assignment has to come from centroids with the same fingerprint
+    virtual void
+    PreassignedQueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&, const int64_t* coarse_ids,
+                         const float* coarse_distances, const float* bounds, const std::atomic<bool>* cancel);
+
     void
     SealImpl() override;
 
  protected:
     std::mutex mutex_;
+    // the inverted lists are searched in place once loaded from a mapped file
+    bool on_disk_ = false;
+    std::atomic<uint64_t> fingerprint_{0};
 };
 
 using IVFPtr = std::shared_ptr<IVF>;
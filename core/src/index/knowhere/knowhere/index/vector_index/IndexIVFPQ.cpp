@@ -22,6 +22,7 @@
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/gpu/IndexGPUIVF.h"
@@ -41,7 +42,9 @@ IVFPQ::Train(const DatasetPtr& dataset_ptr, const Config& config) {
         coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(), config[IndexParams::m].get<int64_t>(),
         config[IndexParams::nbits].get<int64_t>(), metric_type));
 
-    index_->train(rows, (float*)p_data);
+    TrainIVF(static_cast<faiss::IndexIVF*>(index_.get()), rows, (float*)p_data, config,
+             GetDatasetCentroids(dataset_ptr));
+    on_disk_ = config.contains(IndexParams::on_disk) && config[IndexParams::on_disk].get<bool>();
 }
 
 VecIndexPtr
@@ -65,7 +68,7 @@ IVFPQ::CopyCpuToGpu(const int64_t device_id, const Config& config) {
 std::shared_ptr<faiss::IVFSearchParameters>
 IVFPQ::GenParams(const Config& config) {
     auto params = std::make_shared<faiss::IVFPQSearchParameters>();
-    params->nprobe = config[IndexParams::nprobe];
+    params->nprobe = GetProbeCount(config);
     // params->scan_table_threshold = config["scan_table_threhold"]
     // params->polysemous_ht = config["polysemous_ht"]
     // params->max_codes = config["max_codes"]
@@ -0,0 +1,47 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <string>
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQFastScan.h>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+void
+IVFPQFastScan::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    GET_TENSOR_DATA_DIM(dataset_ptr)
+
+    faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
+    index_ = std::shared_ptr<faiss::Index>(new faiss::IndexIVFPQFastScan(
+        coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(), config[IndexParams::m].get<int64_t>(),
+        metric_type));
+
+    TrainIVF(static_cast<faiss::IndexIVF*>(index_.get()), rows, (float*)p_data, config,
+             GetDatasetCentroids(dataset_ptr));
+}
+
+VecIndexPtr
+IVFPQFastScan::CopyCpuToGpu(const int64_t device_id, const Config& config) {
+    // the gpu ivfpq has no fast-scan layout, the index is searched on cpu only
+    KNOWHERE_THROW_MSG("IVFPQFastScan does not support transfer to gpu");
+}
+
+}  // namespace knowhere
+}  // namespace milvus
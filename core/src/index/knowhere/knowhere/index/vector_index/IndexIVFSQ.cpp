@@ -24,6 +24,7 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/gpu/IndexGPUIVFSQ.h"
@@ -46,14 +47,20 @@ IVFSQ::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
     faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
     index_ = std::shared_ptr<faiss::Index>(new faiss::IndexIVFScalarQuantizer(
-        coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(), faiss::QuantizerType::QT_8bit, metric_type));
+        coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(), GetSQQuantizerType(config), metric_type));
+    on_disk_ = config.contains(IndexParams::on_disk) && config[IndexParams::on_disk].get<bool>();
 
-    index_->train(rows, (float*)p_data);
+    TrainIVF(static_cast<faiss::IndexIVF*>(index_.get()), rows, (float*)p_data, config,
+             GetDatasetCentroids(dataset_ptr));
 }
 
 VecIndexPtr
 IVFSQ::CopyCpuToGpu(const int64_t device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
+    // the 4 and 6 bits quantizers are searched by cpu only
+    if (static_cast<faiss::IndexIVFScalarQuantizer*>(index_.get())->sq.qtype != faiss::QuantizerType::QT_8bit) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpu Error, only the 8 bits scalar quantizer is supported by gpu");
+    }
     if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id)) {
         ResScope rs(res, device_id, false);
 
@@ -16,7 +16,6 @@
 #include "knowhere/common/Timer.h"
 #include "knowhere/index/IndexType.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
-#include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/impl/nsg/NSG.h"
@@ -109,35 +108,27 @@ NSG::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
 void
 NSG::Train(const DatasetPtr& dataset_ptr, const Config& config) {
-    auto idmap = std::make_shared<IDMAP>();
-    idmap->Train(dataset_ptr, config);
-    idmap->AddWithoutIds(dataset_ptr, config);
+    // without a gpu the kNN graph is built by NN-Descent in NsgIndex::Build_with_ids
     impl::Graph knng;
-    const float* raw_data = idmap->GetRawVectors();
-    const int64_t device_id = config[knowhere::meta::DEVICEID].get<int64_t>();
     const int64_t k = config[IndexParams::knng].get<int64_t>();
 #ifdef MILVUS_GPU_VERSION
-    if (device_id == -1) {
-        auto preprocess_index = std::make_shared<IVF>();
-        preprocess_index->Train(dataset_ptr, config);
-        preprocess_index->AddWithoutIds(dataset_ptr, config);
-        preprocess_index->GenGraph(raw_data, k, knng, config);
-    } else {
+    const int64_t device_id = config[knowhere::meta::DEVICEID].get<int64_t>();
+    if (device_id != -1) {
+        auto idmap = std::make_shared<IDMAP>();
+        idmap->Train(dataset_ptr, config);
+        idmap->AddWithoutIds(dataset_ptr, config);
+        const float* raw_data = idmap->GetRawVectors();
         auto gpu_idx = cloner::CopyCpuToGpu(idmap, device_id, config);
         auto gpu_idmap = std::dynamic_pointer_cast<GPUIDMAP>(gpu_idx);
         gpu_idmap->GenGraph(raw_data, k, knng, config);
     }
-#else
-    auto preprocess_index = std::make_shared<IVF>();
-    preprocess_index->Train(dataset_ptr, config);
-    preprocess_index->AddWithoutIds(dataset_ptr, config);
-    preprocess_index->GenGraph(raw_data, k, knng, config);
 #endif
 
     impl::BuildParams b_params;
     b_params.candidate_pool_size = config[IndexParams::candidate];
     b_params.out_degree = config[IndexParams::out_degree];
     b_params.search_length = config[IndexParams::search_length];
+    b_params.knng = k;
 
     GET_TENSOR(dataset_ptr)
 
@@ -0,0 +1,96 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/IndexPreprocessed.h"
+
+#include <utility>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+PreprocessedIndex::PreprocessedIndex(VectorTransformPreprocessorPtr preprocessor, VecIndexPtr index)
+    : preprocessor_(std::move(preprocessor)), index_(std::move(index)) {
+    if (preprocessor_ == nullptr || index_ == nullptr) {
+        KNOWHERE_THROW_MSG("preprocessed index needs a preprocessor and an index");
+    }
+    index_type_ = index_->index_type();
+    index_mode_ = index_->index_mode();
+}
+
+PreprocessedIndex::PreprocessedIndex(VecIndexPtr index)
+    : PreprocessedIndex(std::make_shared<VectorTransformPreprocessor>(), std::move(index)) {
+}
+
+BinarySet
+PreprocessedIndex::Serialize(const Config& config) {
+    auto binary_set = index_->Serialize(config);
+    preprocessor_->Serialize(binary_set);
+    return binary_set;
+}
+
+void
+PreprocessedIndex::Load(const BinarySet& binary_set) {
+    preprocessor_->Load(binary_set);
+    index_->Load(binary_set);
+}
+
+void
+PreprocessedIndex::Train(const DatasetPtr& dataset, const Config& config) {
+    if (!preprocessor_->IsTrained()) {
+        preprocessor_->Train(dataset);
+    }
+    index_->Train(preprocessor_->Preprocess(dataset), IndexConfig(config));
+}
+
+void
+PreprocessedIndex::Add(const DatasetPtr& dataset, const Config& config) {
+    index_->Add(preprocessor_->Preprocess(dataset), IndexConfig(config));
+}
+
+void
+PreprocessedIndex::AddWithoutIds(const DatasetPtr& dataset, const Config& config) {
+    index_->AddWithoutIds(preprocessor_->Preprocess(dataset), IndexConfig(config));
+}
+
+DatasetPtr
+PreprocessedIndex::Query(const DatasetPtr& dataset, const Config& config) {
+    index_->SetBlacklist(GetBlacklist());
+    return index_->Query(preprocessor_->Preprocess(dataset), IndexConfig(config));
+}
+
+DatasetPtr
+PreprocessedIndex::QueryByRange(const DatasetPtr& dataset, const Config& config) {
+    index_->SetBlacklist(GetBlacklist());
+    return index_->QueryByRange(preprocessor_->Preprocess(dataset), IndexConfig(config));
+}
+
+int64_t
+PreprocessedIndex::IndexSize() {
+    if (index_size_ != -1) {
+        return index_size_;
+    }
+    return index_->IndexSize() + preprocessor_->Size();
+}
+
+Config
+PreprocessedIndex::IndexConfig(const Config& config) const {
+    auto index_config = config;
+    if (index_config.contains(meta::DIM)) {
+        index_config[meta::DIM] = preprocessor_->DimOut();
+    }
+    return index_config;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+
+#include "knowhere/index/preprocessor/VectorTransformPreprocessor.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * Any float vector index behind a VectorTransformPreprocessor: the vectors to build, add and query go through the
+ * preprocessor first and the inner index only sees the transformed ones. The preprocessor is trained on the
+ * training set unless it already is, and is serialized next to the binaries of the inner index.
+ */
+class PreprocessedIndex : public VecIndex {
+ public:
+    PreprocessedIndex(VectorTransformPreprocessorPtr preprocessor, VecIndexPtr index);
+
+    // an index loading the preprocessor from the binary set
+    explicit PreprocessedIndex(VecIndexPtr index);
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    Load(const BinarySet& binary_set) override;
+
+    void
+    Train(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    AddWithoutIds(const DatasetPtr& dataset, const Config& config) override;
+
+    DatasetPtr
+    Query(const DatasetPtr& dataset, const Config& config) override;
+
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config) override;
+
+    int64_t
+    Dim() override {
+        return preprocessor_->DimIn();
+    }
+
+    int64_t
+    Count() override {
+        return index_->Count();
+    }
+
+    int64_t
+    IndexSize() override;
+
+    const VectorTransformPreprocessorPtr&
+    GetPreprocessor() const {
+        return preprocessor_;
+    }
+
+    const VecIndexPtr&
+    GetIndex() const {
+        return index_;
+    }
+
+ private:
+    // the config of the inner index, with meta::DIM the dimension of the transformed vectors
+    Config
+    IndexConfig(const Config& config) const;
+
+ private:
+    VectorTransformPreprocessorPtr preprocessor_;
+    VecIndexPtr index_;
+};
+
+using PreprocessedIndexPtr = std::shared_ptr<PreprocessedIndex>;
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -104,7 +104,7 @@ CPUSPTAGRNG::Load(const BinarySet& binary_set) {
     index_blobs.push_back(SPTAG::ByteArray(deleteid->data.get(), deleteid->size, false));
 
     auto metadata1 = binary_set.GetByName("metadata1");
-    index_blobs.push_back(SPTAG::ByteArray(CopyBinary(metadata1), metadata1->size, true));
+    index_blobs.push_back(SPTAG::ByteArray(metadata1->data.get(), metadata1->size, false));
 
     auto metadata2 = binary_set.GetByName("metadata2");
     index_blobs.push_back(SPTAG::ByteArray(metadata2->data.get(), metadata2->size, false));
@@ -113,6 +113,8 @@ CPUSPTAGRNG::Load(const BinarySet& binary_set) {
     index_config = reinterpret_cast<char*>(config->data.get());
 
     index_ptr_->LoadIndex(index_config, index_blobs);
+    // the samples, the graph and the metadata are used in place, mapped from the index file or not
+    binary_set_ = binary_set;
 }
 
 void
@@ -179,23 +181,28 @@ DatasetPtr
 CPUSPTAGRNG::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     SetParameters(config);
 
-    float* p_data = (float*)dataset_ptr->Get<const void*>(meta::TENSOR);
-    for (auto i = 0; i < 10; ++i) {
-        for (auto j = 0; j < 10; ++j) {
-            std::cout << p_data[i * 10 + j] << " ";
+    GET_TENSOR_DATA_DIM(dataset_ptr)
+    int64_t k = config[meta::TOPK].get<int64_t>();
+    auto p_id = (int64_t*)malloc(rows * k * sizeof(int64_t));
+    auto p_dist = (float*)malloc(rows * k * sizeof(float));
+
+#pragma omp parallel
+    {
+        // the results of a thread are reused by its queries, the search workspaces come from the pool of the index
+        SPTAG::QueryResult query_result(nullptr, k, true);
+#pragma omp for
+        for (int64_t i = 0; i < rows; ++i) {
+            query_result.SetTarget((const float*)p_data + i * dim);
+            query_result.Reset();
+            index_ptr_->SearchIndex(query_result);
+            CopyQueryResult(query_result, p_id + i * k, p_dist + i * k);
         }
-        std::cout << std::endl;
     }
-    std::vector<SPTAG::QueryResult> query_results = ConvertToQueryResult(dataset_ptr, config);
 
-#pragma omp parallel for
-    for (auto i = 0; i < query_results.size(); ++i) {
-        auto target = (float*)query_results[i].GetTarget();
-        std::cout << target[0] << ", " << target[1] << ", " << target[2] << std::endl;
-        index_ptr_->SearchIndex(query_results[i]);
-    }
-
-    return ConvertToDataset(query_results);
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
 }
 
 int64_t
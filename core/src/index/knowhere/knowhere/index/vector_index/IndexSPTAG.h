@@ -66,6 +66,8 @@ class CPUSPTAGRNG : public VecIndex {
 
  private:
     std::shared_ptr<SPTAG::VectorIndex> index_ptr_;
+    // the blobs of a loaded index, SPTAG uses them in place
+    BinarySet binary_set_;
 };
 
 using CPUSPTAGRNGPtr = std::shared_ptr<CPUSPTAGRNG>;
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <faiss/utils/ConcurrentBitset.h>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -21,6 +23,7 @@
 #include "knowhere/common/Typedef.h"
 #include "knowhere/index/Index.h"
 #include "knowhere/index/IndexType.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus {
 namespace knowhere {
@@ -49,6 +52,20 @@ class VecIndex : public Index {
     virtual DatasetPtr
     Query(const DatasetPtr& dataset, const Config& config) = 0;
 
+    // Query writing the ROWS * TOPK results into the caller's ids and distances, which a caller searching often
+    // reuses instead of the buffers Query allocates. The faiss indexes search into them, the others copy the result
+    virtual void
+    QueryInto(const DatasetPtr& dataset, const Config& config, int64_t* ids, float* distances) {
+        auto result = Query(dataset, config);
+        auto elems = dataset->Get<int64_t>(meta::ROWS) * config[meta::TOPK].get<int64_t>();
+        auto res_ids = result->Get<int64_t*>(meta::IDS);
+        auto res_dist = result->Get<float*>(meta::DISTANCE);
+        memcpy(ids, res_ids, sizeof(int64_t) * elems);
+        memcpy(distances, res_dist, sizeof(float) * elems);
+        free(res_ids);
+        free(res_dist);
+    }
+
 #if 0
     virtual DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) {
@@ -56,9 +73,13 @@ class VecIndex : public Index {
     }
 #endif
 
-    // virtual DatasetPtr
-    // QueryByRange(const DatasetPtr&, const Config&) = 0;
-    //
+    // all the vectors closer to a query than meta::RADIUS of the config: a squared L2 or hamming distance below it,
+    // an inner product above it. The results of query i are IDS and DISTANCE [LIMS[i], LIMS[i + 1]), unsorted
+    virtual DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config) {
+        KNOWHERE_THROW_MSG("range search not supported by index type " + index_type_);
+    }
+
     // virtual MetricType
     // metric_type() = 0;
 
@@ -11,15 +11,23 @@
 
 #include "knowhere/index/vector_index/VecIndexFactory.h"
 
+#include <memory>
+#include <string>
+
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
+#include "knowhere/index/preprocessor/VectorTransformPreprocessor.h"
 #include "knowhere/index/vector_index/IndexAnnoy.h"
+#include "knowhere/index/vector_index/IndexBinaryHash.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 #include "knowhere/index/vector_index/IndexBinaryIVF.h"
+#include "knowhere/index/vector_index/IndexDiskANN.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
+#include "knowhere/index/vector_index/IndexPreprocessed.h"
 #include "knowhere/index/vector_offset_index/IndexHNSW_NM.h"
 #include "knowhere/index/vector_offset_index/IndexHNSW_SQ8NR.h"
 #include "knowhere/index/vector_offset_index/IndexIVFSQNR_NM.h"
@@ -63,6 +71,8 @@ VecIndexFactory::CreateVecIndex(const IndexType& type, const IndexMode mode) {
         }
 #endif
         return std::make_shared<knowhere::IVFPQ>();
+    } else if (type == IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN) {
+        return std::make_shared<knowhere::IVFPQFastScan>();
     } else if (type == IndexEnum::INDEX_FAISS_IVFSQ8) {
 #ifdef MILVUS_GPU_VERSION
         if (mode == IndexMode::MODE_GPU) {
@@ -78,6 +88,8 @@ VecIndexFactory::CreateVecIndex(const IndexType& type, const IndexMode mode) {
         return std::make_shared<knowhere::BinaryIDMAP>();
     } else if (type == IndexEnum::INDEX_FAISS_BIN_IVFFLAT) {
         return std::make_shared<knowhere::BinaryIVF>();
+    } else if (type == IndexEnum::INDEX_FAISS_BIN_HASH) {
+        return std::make_shared<knowhere::BinaryHash>();
     } else if (type == IndexEnum::INDEX_NSG) {
         return std::make_shared<knowhere::NSG_NM>(-1);
 #ifdef MILVUS_SUPPORT_SPTAG
@@ -94,10 +106,32 @@ VecIndexFactory::CreateVecIndex(const IndexType& type, const IndexMode mode) {
         return std::make_shared<knowhere::IVFSQNR_NM>();
     } else if (type == IndexEnum::INDEX_HNSW_SQ8NR) {
         return std::make_shared<knowhere::IndexHNSW_SQ8NR>();
+    } else if (type == IndexEnum::INDEX_DISKANN) {
+        return std::make_shared<knowhere::IndexDiskANN>();
     } else {
         return nullptr;
     }
 }
 
+VecIndexPtr
+VecIndexFactory::CreateVecIndex(const IndexType& type, const Config& conf, const IndexMode mode) {
+    auto index = CreateVecIndex(type, mode);
+    if (index == nullptr || !conf.contains(IndexParams::preprocess)) {
+        return index;
+    }
+    auto preprocessor = std::make_shared<VectorTransformPreprocessor>(conf[IndexParams::preprocess].get<std::string>(),
+                                                                      conf[meta::DIM].get<int64_t>());
+    return std::make_shared<PreprocessedIndex>(preprocessor, index);
+}
+
+VecIndexPtr
+VecIndexFactory::CreateVecIndex(const IndexType& type, const BinarySet& binary_set, const IndexMode mode) {
+    auto index = CreateVecIndex(type, mode);
+    if (index == nullptr || binary_set.binary_map_.find(PREPROCESSOR_DATA) == binary_set.binary_map_.end()) {
+        return index;
+    }
+    return std::make_shared<PreprocessedIndex>(index);
+}
+
 }  // namespace knowhere
 }  // namespace milvus
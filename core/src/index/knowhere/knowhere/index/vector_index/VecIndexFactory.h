@@ -13,6 +13,8 @@
 
 #include <memory>
 
+#include "knowhere/common/BinarySet.h"
+#include "knowhere/common/Config.h"
 #include "knowhere/index/IndexType.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 
@@ -35,6 +37,14 @@ class VecIndexFactory {
 
     knowhere::VecIndexPtr
     CreateVecIndex(const IndexType& type, const IndexMode mode = IndexMode::MODE_CPU);
+
+    // the index to build, behind the vector transforms of IndexParams::preprocess if conf has them
+    knowhere::VecIndexPtr
+    CreateVecIndex(const IndexType& type, const Config& conf, const IndexMode mode = IndexMode::MODE_CPU);
+
+    // the index to load binary_set into, behind the vector transforms it was serialized with if any
+    knowhere::VecIndexPtr
+    CreateVecIndex(const IndexType& type, const BinarySet& binary_set, const IndexMode mode = IndexMode::MODE_CPU);
 };
 
 }  // namespace knowhere
@@ -10,6 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "knowhere/index/vector_index/adapter/SptagAdapter.h"
+
+#include <cstring>
+#include <limits>
+
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 
 namespace milvus {
@@ -40,44 +44,19 @@ ConvertToVectorSet(const DatasetPtr& dataset_ptr) {
     return vectorset;
 }
 
-std::vector<SPTAG::QueryResult>
-ConvertToQueryResult(const DatasetPtr& dataset_ptr, const Config& config) {
-    GET_TENSOR_DATA_DIM(dataset_ptr);
-
-    int64_t k = config[meta::TOPK].get<int64_t>();
-    std::vector<SPTAG::QueryResult> query_results(rows, SPTAG::QueryResult(nullptr, k, true));
-    for (auto i = 0; i < rows; ++i) {
-        query_results[i].SetTarget((float*)p_data + i * dim);
-    }
-
-    return query_results;
-}
-
-DatasetPtr
-ConvertToDataset(std::vector<SPTAG::QueryResult> query_results) {
-    auto k = query_results[0].GetResultNum();
-    auto elems = query_results.size() * k;
-
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = (int64_t*)malloc(p_id_size);
-    auto p_dist = (float*)malloc(p_dist_size);
-
-#pragma omp parallel for
-    for (auto i = 0; i < query_results.size(); ++i) {
-        auto results = query_results[i].GetResults();
-        auto num_result = query_results[i].GetResultNum();
-        for (auto j = 0; j < num_result; ++j) {
-            //            p_id[i * k + j] = results[j].VID;
-            p_id[i * k + j] = *(int64_t*)query_results[i].GetMetadata(j).Data();
-            p_dist[i * k + j] = results[j].Dist;
+void
+CopyQueryResult(const SPTAG::QueryResult& query_result, int64_t* p_id, float* p_dist) {
+    for (int j = 0; j < query_result.GetResultNum(); ++j) {
+        auto result = query_result.GetResult(j);
+        if (result->VID < 0) {
+            p_id[j] = -1;
+            p_dist[j] = std::numeric_limits<float>::infinity();
+            continue;
         }
+        // the ids are the metadata of the vectors
+        memcpy(&p_id[j], query_result.GetMetadata(j).Data(), sizeof(int64_t));
+        p_dist[j] = result->Dist;
     }
-
-    auto ret_ds = std::make_shared<Dataset>();
-    ret_ds->Set(meta::IDS, p_id);
-    ret_ds->Set(meta::DISTANCE, p_dist);
-    return ret_ds;
 }
 
 }  // namespace knowhere
@@ -12,8 +12,8 @@
 #pragma once
 
 #include <SPTAG/AnnService/inc/Core/VectorIndex.h>
+#include <cstdint>
 #include <memory>
-#include <vector>
 
 #include "knowhere/common/Config.h"
 #include "knowhere/common/Dataset.h"
@@ -27,11 +27,9 @@ ConvertToVectorSet(const DatasetPtr& dataset_ptr);
 std::shared_ptr<SPTAG::MetadataSet>
 ConvertToMetadataSet(const DatasetPtr& dataset_ptr);
 
-std::vector<SPTAG::QueryResult>
-ConvertToQueryResult(const DatasetPtr& dataset_ptr, const Config& config);
-
-DatasetPtr
-ConvertToDataset(std::vector<SPTAG::QueryResult> query_results);
+// copies the top k of a query to its rows of ids and distances, -1 where fewer were found
+void
+CopyQueryResult(const SPTAG::QueryResult& query_result, int64_t* p_id, float* p_dist);
 
 }  // namespace knowhere
 }  // namespace milvus
@@ -9,6 +9,9 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <faiss/impl/AuxIndexStructures.h>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
 #include "knowhere/common/Dataset.h"
@@ -37,5 +40,57 @@ GenDataset(const int64_t nb, const int64_t dim, const void* xb) {
     return ret_ds;
 }
 
+DatasetPtr
+GenRangeResultDataset(const faiss::RangeSearchResult& result) {
+    auto total = result.lims[result.nq];
+    auto p_lims = (size_t*)malloc(sizeof(size_t) * (result.nq + 1));
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * total);
+    auto p_dist = (float*)malloc(sizeof(float) * total);
+    memcpy(p_lims, result.lims, sizeof(size_t) * (result.nq + 1));
+    memcpy(p_id, result.labels, sizeof(int64_t) * total);
+    memcpy(p_dist, result.distances, sizeof(float) * total);
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    ret_ds->Set(meta::LIMS, p_lims);
+    return ret_ds;
+}
+
+const float*
+GetDatasetBounds(const DatasetPtr& dataset) {
+    if (dataset->data().find(meta::BOUNDS) == dataset->data().end()) {
+        return nullptr;
+    }
+    return dataset->Get<const float*>(meta::BOUNDS);
+}
+
+const std::atomic<bool>*
+GetDatasetCancel(const DatasetPtr& dataset) {
+    if (dataset->data().find(meta::CANCEL) == dataset->data().end()) {
+        return nullptr;
+    }
+    return dataset->Get<const std::atomic<bool>*>(meta::CANCEL);
+}
+
+bool
+GetDatasetCoarseAssign(const DatasetPtr& dataset, const int64_t*& ids, const float*& distances) {
+    if (dataset->data().find(meta::COARSE_IDS) == dataset->data().end() ||
+        dataset->data().find(meta::COARSE_DISTANCES) == dataset->data().end()) {
+        return false;
+    }
+    ids = dataset->Get<const int64_t*>(meta::COARSE_IDS);
+    distances = dataset->Get<const float*>(meta::COARSE_DISTANCES);
+    return true;
+}
+
+const float*
+GetDatasetCentroids(const DatasetPtr& dataset) {
+    if (dataset->data().find(meta::CENTROIDS) == dataset->data().end()) {
+        return nullptr;
+    }
+    return dataset->Get<const float*>(meta::CENTROIDS);
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -11,10 +11,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include "knowhere/common/Dataset.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
+namespace faiss {
+struct RangeSearchResult;
+}
+
 namespace milvus {
 namespace knowhere {
 
@@ -41,5 +46,25 @@ GenDatasetWithIds(const int64_t nb, const int64_t dim, const void* xb, const int
 extern DatasetPtr
 GenDataset(const int64_t nb, const int64_t dim, const void* xb);
 
+// copies a faiss range search result into the meta::IDS, meta::DISTANCE and meta::LIMS of a new dataset
+extern DatasetPtr
+GenRangeResultDataset(const faiss::RangeSearchResult& result);
+
+// the meta::BOUNDS of the dataset, nullptr if it has none
+extern const float*
+GetDatasetBounds(const DatasetPtr& dataset);
+
+// the meta::CANCEL of the dataset, nullptr if it has none
+extern const std::atomic<bool>*
+GetDatasetCancel(const DatasetPtr& dataset);
+
+// the meta::COARSE_IDS and meta::COARSE_DISTANCES of the dataset, false if it has none
+extern bool
+GetDatasetCoarseAssign(const DatasetPtr& dataset, const int64_t*& ids, const float*& distances);
+
+// the meta::CENTROIDS of the dataset, nullptr if it has none
+extern const float*
+GetDatasetCentroids(const DatasetPtr& dataset);
+
 }  // namespace knowhere
 }  // namespace milvus
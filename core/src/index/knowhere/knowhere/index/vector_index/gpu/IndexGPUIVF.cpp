@@ -11,12 +11,17 @@
 
 #include <memory>
 
+#include <faiss/IndexIVF.h>
 #include <faiss/gpu/GpuCloner.h>
 #include <faiss/gpu/GpuIndexIVF.h>
 #include <faiss/gpu/GpuIndexIVFFlat.h>
 #include <faiss/index_io.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <exception>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -28,6 +33,11 @@
 namespace milvus {
 namespace knowhere {
 
+namespace {
+// smaller segments are added on the training device, the copies between the devices would outweigh the gain
+constexpr int64_t SHARD_MIN_ROWS = 500000;
+}  // namespace
+
 void
 GPUIVF::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     GET_TENSOR_DATA_DIM(dataset_ptr)
@@ -54,6 +64,21 @@ GPUIVF::Train(const DatasetPtr& dataset_ptr, const Config& config) {
 void
 GPUIVF::Add(const DatasetPtr& dataset_ptr, const Config& config) {
     if (auto spt = res_.lock()) {
+        std::vector<int64_t> devices;
+        if (config.contains(meta::SHARD_DEVICES)) {
+            for (int64_t device_id : config[meta::SHARD_DEVICES]) {
+                if (device_id != gpu_id_ && std::find(devices.begin(), devices.end(), device_id) == devices.end()) {
+                    devices.push_back(device_id);
+                }
+            }
+        }
+
+        int64_t rows = dataset_ptr->Get<int64_t>(meta::ROWS);
+        if (!devices.empty() && rows >= SHARD_MIN_ROWS) {
+            ShardedAdd(dataset_ptr, devices);
+            return;
+        }
+
         ResScope rs(res_, gpu_id_);
         IVF::Add(dataset_ptr, config);
     } else {
@@ -61,6 +86,93 @@ GPUIVF::Add(const DatasetPtr& dataset_ptr, const Config& config) {
     }
 }
 
+/*
+ * Splits the vectors in one shard per device. The training device adds its shard to the index itself, every
+ * other device adds its shard to a copy of the trained empty index, all devices at once. faiss pages the host
+ * vectors to each device through the pinned memory of its resource, so the copies and adds of the devices
+ * overlap. The inverted lists of the shards are merged into the index on the host and copied back at last.
+ */
+void
+GPUIVF::ShardedAdd(const DatasetPtr& dataset_ptr, const std::vector<int64_t>& devices) {
+    GET_TENSOR_DATA_ID(dataset_ptr)
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::unique_ptr<faiss::Index> trained;
+    {
+        ResScope rs(res_, gpu_id_);
+        trained.reset(faiss::gpu::index_gpu_to_cpu(index_.get()));
+    }
+
+    int64_t dim = index_->d;
+    int64_t shard_num = devices.size() + 1;
+    int64_t shard_rows = (rows + shard_num - 1) / shard_num;
+    std::vector<std::unique_ptr<faiss::Index>> shards(shard_num);
+    std::vector<std::exception_ptr> errors(shard_num);
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < shard_num; ++i) {
+        int64_t begin = std::min(i * shard_rows, rows);
+        int64_t count = std::min(shard_rows, rows - begin);
+        if (count <= 0) {
+            continue;
+        }
+        const float* x = (const float*)p_data + begin * dim;
+        const int64_t* ids = p_ids + begin;
+
+        threads.emplace_back([&, i, count, x, ids]() {
+            try {
+                if (i == 0) {
+                    ResScope rs(res_, gpu_id_);
+                    index_->add_with_ids(count, x, ids);
+                    return;
+                }
+
+                int64_t device_id = devices[i - 1];
+                auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id);
+                if (res == nullptr) {
+                    KNOWHERE_THROW_MSG("Sharded add of IVF can't get gpu resource of device " +
+                                       std::to_string(device_id));
+                }
+                ResScope rs(res, device_id, true);
+                std::unique_ptr<faiss::Index> device_index(
+                    faiss::gpu::index_cpu_to_gpu(res->faiss_res.get(), device_id, trained.get()));
+                device_index->add_with_ids(count, x, ids);
+                shards[i].reset(faiss::gpu::index_gpu_to_cpu(device_index.get()));
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    ResScope rs(res_, gpu_id_);
+    std::unique_ptr<faiss::Index> host_index(faiss::gpu::index_gpu_to_cpu(index_.get()));
+    auto host_ivf = dynamic_cast<faiss::IndexIVF*>(host_index.get());
+    if (host_ivf == nullptr) {
+        KNOWHERE_THROW_MSG("Sharded add needs an IVF index");
+    }
+    for (auto& shard : shards) {
+        if (shard != nullptr) {
+            // the ids are kept as they are
+            host_ivf->merge_from(*dynamic_cast<faiss::IndexIVF*>(shard.get()), 0);
+        }
+    }
+
+    // the device copy is dropped first, a huge segment may not fit twice on the device
+    auto spt = res_.lock();
+    index_.reset();
+    index_.reset(faiss::gpu::index_cpu_to_gpu(spt->faiss_res.get(), gpu_id_, host_index.get()));
+}
+
 VecIndexPtr
 GPUIVF::CopyGpuToCpu(const Config& config) {
     std::lock_guard<std::mutex> lk(mutex_);
@@ -142,10 +254,17 @@ GPUIVF::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int
     if (device_index) {
         device_index->nprobe = config[IndexParams::nprobe];
         ResScope rs(res_, gpu_id_);
+        SetDeviceSearchParams(config);
 
-        // if query size > 2048 we search by blocks to avoid malloc issue
-        const int64_t block_size = 2048;
+        // if query size > 2048 we search by blocks to avoid malloc issue, unless the queries are large enough to be
+        // staged through the pinned memory, then the blocks are as large as their results allow
         int64_t dim = device_index->d;
+        int64_t block_size = 2048;
+        if (n * dim * static_cast<int64_t>(sizeof(float)) >= PAGED_SEARCH_MIN_BYTES) {
+            device_index->setMinPagingSize(PAGED_SEARCH_MIN_BYTES);
+            int64_t result_size = k * static_cast<int64_t>(sizeof(float) + sizeof(int64_t));
+            block_size = std::max(block_size, PAGED_SEARCH_MAX_RESULT_BYTES / std::max(result_size, int64_t(1)));
+        }
         for (int64_t i = 0; i < n; i += block_size) {
             int64_t search_size = (n - i > block_size) ? block_size : (n - i);
             device_index->search(search_size, (float*)data + i * dim, k, distances + i * k, labels + i * k, bitset_);
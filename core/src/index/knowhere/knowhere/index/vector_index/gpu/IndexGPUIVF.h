@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/gpu/GPUIndex.h"
@@ -52,6 +53,14 @@ class GPUIVF : public IVF, public GPUIndex {
 
     void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&) override;
+
+    // the search params of the device index besides nprobe, set under the lock of the query
+    virtual void
+    SetDeviceSearchParams(const Config&) {
+    }
+
+    void
+    ShardedAdd(const DatasetPtr&, const std::vector<int64_t>& devices);
 };
 
 using GPUIVFPtr = std::shared_ptr<GPUIVF>;
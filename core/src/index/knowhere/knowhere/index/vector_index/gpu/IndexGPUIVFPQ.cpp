@@ -69,5 +69,24 @@ GPUIVFPQ::GenParams(const Config& config) {
     return params;
 }
 
+void
+GPUIVFPQ::SetDeviceSearchParams(const Config& config) {
+    auto device_index = dynamic_cast<faiss::gpu::GpuIndexIVFPQ*>(index_.get());
+    if (device_index == nullptr) {
+        return;
+    }
+    if (!copied_lut_captured_) {
+        copied_lut_fp16_ = device_index->getFloat16LookupTables();
+        copied_lut_captured_ = true;
+    }
+
+    // switched in place, the float16 tables take half the shared memory of the list scans
+    bool lut_fp16 = copied_lut_fp16_;
+    if (config.contains(IndexParams::lut_fp16)) {
+        lut_fp16 = config[IndexParams::lut_fp16].get<bool>();
+    }
+    device_index->setFloat16LookupTables(lut_fp16);
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -39,6 +39,14 @@ class GPUIVFPQ : public GPUIVF {
  protected:
     std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config& config) override;
+
+    void
+    SetDeviceSearchParams(const Config& config) override;
+
+ private:
+    // the lookup tables the index was copied to the gpu with, used by the queries without lut_fp16
+    bool copied_lut_captured_ = false;
+    bool copied_lut_fp16_ = false;
 };
 
 using GPUIVFPQPtr = std::shared_ptr<GPUIVFPQ>;
@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexScalarQuantizer.h>
+#include <faiss/IndexShards.h>
+#include <faiss/gpu/GpuCloner.h>
+#include <faiss/gpu/GpuIndexIVF.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFSQ.h"
+#include "knowhere/index/vector_index/gpu/IndexGPUIVFShards.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+GPUIVFShards::GPUIVFShards(std::shared_ptr<faiss::Index> index, const std::vector<int64_t>& devices,
+                           std::vector<ResPtr>& res)
+    : GPUIVF(std::move(index), devices.front(), res.front()), devices_(devices) {
+    for (auto& shard_res : res) {
+        shard_res_.emplace_back(shard_res);
+    }
+}
+
+VecIndexPtr
+GPUIVFShards::CopyGpuToCpu(const Config& config) {
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    // the lists of the shards are gathered back into one host index
+    std::shared_ptr<faiss::Index> host_index(faiss::gpu::index_gpu_to_cpu(index_.get()));
+    VecIndexPtr result;
+    if (dynamic_cast<faiss::IndexIVFPQ*>(host_index.get()) != nullptr) {
+        result = std::make_shared<IVFPQ>(host_index);
+    } else if (dynamic_cast<faiss::IndexIVFScalarQuantizer*>(host_index.get()) != nullptr) {
+        result = std::make_shared<IVFSQ>(host_index);
+    } else {
+        result = std::make_shared<IVF>(host_index);
+    }
+    return result;
+}
+
+VecIndexPtr
+GPUIVFShards::CopyGpuToGpu(const int64_t device_id, const Config& config) {
+    auto host_index = CopyGpuToCpu(config);
+    return std::static_pointer_cast<IVF>(host_index)->CopyCpuToGpu(device_id, config);
+}
+
+void
+GPUIVFShards::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                        const Config& config) {
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    auto shards = dynamic_cast<faiss::IndexShards*>(index_.get());
+    if (shards == nullptr) {
+        KNOWHERE_THROW_MSG("Not a faiss::IndexShards type.");
+    }
+    int nprobe = config[IndexParams::nprobe];
+    for (int i = 0; i < shards->count(); ++i) {
+        if (auto device_index = dynamic_cast<faiss::gpu::GpuIndexIVF*>(shards->at(i))) {
+            device_index->nprobe = nprobe;
+        }
+    }
+
+    // own every device of the shards while searching, taken in the order of the device ids so that two sharded
+    // searches can't deadlock
+    std::vector<size_t> order(devices_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return devices_[a] < devices_[b]; });
+    std::vector<std::unique_ptr<ResScope>> scopes;
+    for (auto i : order) {
+        scopes.emplace_back(std::make_unique<ResScope>(shard_res_[i], devices_[i]));
+    }
+
+    // if query size > 2048 we search by blocks to avoid malloc issue
+    const int64_t block_size = 2048;
+    int64_t dim = index_->d;
+    for (int64_t i = 0; i < n; i += block_size) {
+        int64_t search_size = (n - i > block_size) ? block_size : (n - i);
+        index_->search(search_size, (float*)data + i * dim, k, distances + i * k, labels + i * k, bitset_);
+    }
+}
+
+}  // namespace knowhere
+}  // namespace milvus
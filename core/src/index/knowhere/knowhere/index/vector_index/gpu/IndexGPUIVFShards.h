@@ -0,0 +1,55 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "knowhere/index/vector_index/gpu/IndexGPUIVF.h"
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * One IVF index whose inverted lists are spread over several gpus by a faiss::IndexShards, for the segments
+ * too large for the memory of a single gpu. Every device searches its part of the lists and the top k of the
+ * parts are merged.
+ */
+class GPUIVFShards : public GPUIVF {
+ public:
+    // devices and res are in the order of the shards
+    GPUIVFShards(std::shared_ptr<faiss::Index> index, const std::vector<int64_t>& devices, std::vector<ResPtr>& res);
+
+    VecIndexPtr
+    CopyGpuToCpu(const Config&) override;
+
+    VecIndexPtr
+    CopyGpuToGpu(const int64_t, const Config&) override;
+
+    const std::vector<int64_t>&
+    Devices() const {
+        return devices_;
+    }
+
+ protected:
+    void
+    QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&) override;
+
+ private:
+    std::vector<int64_t> devices_;
+    std::vector<ResWPtr> shard_res_;
+};
+
+using GPUIVFShardsPtr = std::shared_ptr<GPUIVFShards>;
+
+}  // namespace knowhere
+}  // namespace milvus
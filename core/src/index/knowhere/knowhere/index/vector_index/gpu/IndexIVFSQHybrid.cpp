@@ -43,6 +43,11 @@ IVFSQHybrid::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     if (gpu_res != nullptr) {
         ResScope rs(gpu_res, gpu_id_, true);
         auto device_index = faiss::gpu::index_cpu_to_gpu(gpu_res->faiss_res.get(), gpu_id_, build_index);
+        // the shared centroids of the collection skip the training of the quantizer
+        if (auto centroids = GetDatasetCentroids(dataset_ptr)) {
+            auto gpu_ivf = dynamic_cast<faiss::gpu::GpuIndexIVF*>(device_index);
+            gpu_ivf->quantizer->add(gpu_ivf->nlist, centroids);
+        }
         device_index->train(rows, (float*)p_data);
 
         index_.reset(device_index);
@@ -252,6 +257,12 @@ IVFSQHybrid::QueryImpl(int64_t n, const float* data, int64_t k, float* distances
     } else if (gpu_mode_ == 1) {  // hybrid
         if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(quantizer_gpu_id_)) {
             ResScope rs(res, quantizer_gpu_id_, true);
+            // the queries go to the gpu quantizer from host memory, large batches are staged through the pinned
+            // memory so that their upload overlaps the coarse search
+            auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+            if (auto gpu_quantizer = dynamic_cast<faiss::gpu::GpuIndex*>(ivf_index->quantizer)) {
+                gpu_quantizer->setMinPagingSize(PAGED_SEARCH_MIN_BYTES);
+            }
             IVF::QueryImpl(n, data, k, distances, labels, config);
         } else {
             KNOWHERE_THROW_MSG("Hybrid Search Error, can't get gpu: " + std::to_string(quantizer_gpu_id_) + "resource");
@@ -87,6 +87,20 @@ class IVFSQHybrid : public GPUIVFSQ {
     void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&) override;
 
+    // the quantizer may live on gpu, the bounds, cancel and coarse assignment are ignored
+    void
+    BoundedQueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                     const Config& config, const float* bounds, const std::atomic<bool>* cancel) override {
+        QueryImpl(n, data, k, distances, labels, config);
+    }
+
+    void
+    PreassignedQueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                         const Config& config, const int64_t* coarse_ids, const float* coarse_distances,
+                         const float* bounds, const std::atomic<bool>* cancel) override {
+        QueryImpl(n, data, k, distances, labels, config);
+    }
+
  protected:
     int64_t gpu_mode_ = 0;  // 0,1,2
     int64_t quantizer_gpu_id_ = -1;
@@ -26,5 +26,16 @@ BuildResume() {
     faiss::BuilderSuspend::resume();
 }
 
+// the share of the time the builders keep running, 1.0 means unthrottled
+inline void
+BuilderSetShare(double share) {
+    faiss::BuilderSuspend::set_share(share);
+}
+
+inline double
+BuilderShare() {
+    return faiss::BuilderSuspend::share();
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -73,6 +73,18 @@ CopyCpuToGpu(const VecIndexPtr& index, const int64_t device_id, const Config& co
     return result;
 }
 
+VecIndexPtr
+CopyCpuToGpuSharded(const VecIndexPtr& index, const std::vector<int64_t>& devices, const Config& config) {
+    auto cpu_index = std::dynamic_pointer_cast<IVF>(index);
+    if (cpu_index == nullptr || std::dynamic_pointer_cast<GPUIndex>(index) != nullptr) {
+        KNOWHERE_THROW_MSG("this index type not support sharded transfer to gpu");
+    }
+
+    VecIndexPtr result = cpu_index->CopyCpuToGpuSharded(devices, config);
+    CopyIndexData(result, index);
+    return result;
+}
+
 }  // namespace cloner
 }  // namespace knowhere
 }  // namespace milvus
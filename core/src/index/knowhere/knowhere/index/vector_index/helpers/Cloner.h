@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "knowhere/index/vector_index/VecIndex.h"
 
 namespace milvus {
@@ -23,6 +25,10 @@ CopyCpuToGpu(const VecIndexPtr& index, const int64_t device_id, const Config& co
 extern VecIndexPtr
 CopyGpuToCpu(const VecIndexPtr& index, const Config& config);
 
+// only the IVF indexes keeping their codes in the inverted lists can be sharded
+extern VecIndexPtr
+CopyCpuToGpuSharded(const VecIndexPtr& index, const std::vector<int64_t>& devices, const Config& config);
+
 }  // namespace cloner
 }  // namespace knowhere
 }  // namespace milvus
@@ -67,8 +67,10 @@ FaissGpuResourceMgr::InitResource() {
 
                 for (int64_t i = 0; i < device_param.resource_num; ++i) {
                     auto raw_resource = std::make_shared<faiss::gpu::StandardGpuResources>();
+                    if (device_param.pinned_mem_size > 0) {
+                        raw_resource->setPinnedMemory(device_param.pinned_mem_size);
+                    }
 
-                    // TODO(linxj): enable set pinned memory
                     auto res_wrapper = std::make_shared<Resource>(raw_resource);
                     AllocateTempMem(res_wrapper, device_id, 0);
 
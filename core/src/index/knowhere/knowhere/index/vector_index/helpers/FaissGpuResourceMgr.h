@@ -23,6 +23,13 @@
 namespace milvus {
 namespace knowhere {
 
+// queries searched from host memory are staged through the pinned memory of the resource from this size on,
+// faiss splits it in two pages and uploads the next page on its copy stream while the current one is searched
+constexpr int64_t PAGED_SEARCH_MIN_BYTES = 16LL * 1024 * 1024;
+
+// bound of the results of one paged search block, they stay on the gpu until the whole block is searched
+constexpr int64_t PAGED_SEARCH_MAX_RESULT_BYTES = 64LL * 1024 * 1024;
+
 struct Resource {
     explicit Resource(std::shared_ptr<faiss::gpu::StandardGpuResources>& r) : faiss_res(r) {
         static int64_t global_id = 0;
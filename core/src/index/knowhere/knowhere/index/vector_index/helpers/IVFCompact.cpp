@@ -0,0 +1,75 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/helpers/IVFCompact.h"
+
+#include <faiss/IndexIVFPQFastScan.h>
+#include <faiss/InvertedLists.h>
+#include <cstring>
+
+namespace milvus {
+namespace knowhere {
+
+bool
+CompactInvertedLists(faiss::IndexIVF* index, const std::vector<int64_t>& new_offsets) {
+    auto ails = dynamic_cast<faiss::ArrayInvertedLists*>(index->invlists);
+    if (ails == nullptr) {
+        return false;
+    }
+
+    size_t code_size = ails->code_size;
+    int64_t ntotal = 0;
+    for (size_t list_no = 0; list_no < ails->nlist; ++list_no) {
+        auto& ids = ails->ids[list_no];
+        auto& codes = ails->codes[list_no];
+        // offset indexes keep the ids only, their codes are the raw data of the segment
+        bool has_codes = !codes.empty();
+
+        size_t kept = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            auto offset = ids[i];
+            if (offset < 0 || offset >= (int64_t)new_offsets.size() || new_offsets[offset] < 0) {
+                continue;
+            }
+
+            ids[kept] = new_offsets[offset];
+            if (has_codes && kept != i) {
+                memmove(codes.data() + kept * code_size, codes.data() + i * code_size, code_size);
+            }
+            ++kept;
+        }
+
+        ids.resize(kept);
+        ids.shrink_to_fit();
+        if (has_codes) {
+            codes.resize(kept * code_size);
+            codes.shrink_to_fit();
+        }
+        ntotal += kept;
+    }
+    index->ntotal = ntotal;
+
+    // the direct map is keyed by the old offsets
+    auto direct_map_type = index->direct_map.type;
+    if (direct_map_type != faiss::DirectMap::NoMap) {
+        index->set_direct_map_type(faiss::DirectMap::NoMap);
+        index->set_direct_map_type(direct_map_type);
+    }
+
+    // the packed copy of the fast-scan codes follows the list order
+    if (auto fast_scan = dynamic_cast<faiss::IndexIVFPQFastScan*>(index)) {
+        fast_scan->repack();
+    }
+    return true;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,31 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/IndexIVF.h>
+#include <vector>
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * Drop entries from the inverted lists of an ivf index and renumber the others,
+ * the coarse quantizer and the codes are kept as they are, nothing is trained or encoded again.
+ * @param index: ivf index with array inverted lists, modified in place
+ * @param new_offsets: new offset of each offset in the index, -1 for the entries to drop
+ * @return false if the inverted lists are not supported, the index is untouched then
+ */
+bool
+CompactInvertedLists(faiss::IndexIVF* index, const std::vector<int64_t>& new_offsets);
+
+}  // namespace knowhere
+}  // namespace milvus
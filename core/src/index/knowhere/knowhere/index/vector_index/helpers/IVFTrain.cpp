@@ -0,0 +1,172 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
+
+#include <faiss/Clustering.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/utils/random.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+
+// mini-batch iterations, each one assigns batch_size vectors only
+constexpr int MINI_BATCH_ITERATIONS = 100;
+constexpr int64_t MINI_BATCH_SIZE_PER_LIST = 4;
+constexpr int64_t TRAIN_SEED = 1234;
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t
+Fnv1a(uint64_t hash, const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+}  // namespace
+
+void
+TrainIVF(faiss::IndexIVF* index, int64_t rows, const float* data, const Config& config, const float* centroids) {
+    int64_t dim = index->d;
+
+    if (centroids != nullptr) {
+        index->quantizer->reset();
+        index->quantizer->add(index->nlist, centroids);
+        index->quantizer->is_trained = true;
+    }
+
+    std::vector<float> sampled;
+    if (config.contains(IndexParams::train_size)) {
+        auto train_size = config[IndexParams::train_size].get<int64_t>();
+        if (train_size < (int64_t)index->nlist) {
+            KNOWHERE_THROW_MSG("train_size is smaller than nlist");
+        }
+        if (train_size < rows) {
+            std::vector<int> perm(rows);
+            faiss::rand_perm(perm.data(), rows, TRAIN_SEED);
+            sampled.resize(train_size * dim);
+            for (int64_t i = 0; i < train_size; ++i) {
+                memcpy(sampled.data() + i * dim, data + (int64_t)perm[i] * dim, sizeof(float) * dim);
+            }
+            rows = train_size;
+            data = sampled.data();
+        }
+    }
+
+    std::string mode = TrainMode::LLOYD;
+    if (config.contains(IndexParams::train_mode)) {
+        mode = config[IndexParams::train_mode].get<std::string>();
+    }
+
+    if (mode != TrainMode::LLOYD && !(index->quantizer->is_trained && index->quantizer->ntotal == index->nlist)) {
+        // train the coarse quantizer here, IndexIVF::train only trains the residual then
+        std::unique_ptr<faiss::Clustering> clus;
+        if (mode == TrainMode::MINI_BATCH) {
+            int64_t batch_size = MINI_BATCH_SIZE_PER_LIST * index->nlist;
+            if (config.contains(IndexParams::batch_size)) {
+                batch_size = config[IndexParams::batch_size].get<int64_t>();
+            }
+            clus.reset(new faiss::MiniBatchClustering(dim, index->nlist, batch_size, index->cp));
+            clus->niter = MINI_BATCH_ITERATIONS;
+        } else if (mode == TrainMode::HIERARCHICAL) {
+            clus.reset(new faiss::HierarchicalClustering(dim, index->nlist, index->cp));
+        } else if (mode == TrainMode::BALANCED) {
+            clus.reset(new faiss::BalancedClustering(dim, index->nlist, index->cp));
+        } else {
+            KNOWHERE_THROW_MSG("Unsupported train_mode: " + mode);
+        }
+
+        index->quantizer->reset();
+        clus->train(rows, data, *index->quantizer);
+        index->quantizer->is_trained = true;
+    }
+
+    index->train(rows, data);
+}
+
+std::string
+GetIVFListSizeHistogram(const faiss::IndexIVF* index) {
+    // the upper bounds of the histogram buckets, relative to the mean list size
+    static const std::vector<double> BUCKET_BOUNDS{0.5, 1, 2, 4};
+
+    std::vector<size_t> sizes(index->nlist);
+    size_t total = 0;
+    for (size_t i = 0; i < index->nlist; ++i) {
+        sizes[i] = index->invlists->list_size(i);
+        total += sizes[i];
+    }
+    std::stringstream ss;
+    if (sizes.empty()) {
+        ss << "no list";
+        return ss.str();
+    }
+
+    std::sort(sizes.begin(), sizes.end());
+    double mean = (double)total / sizes.size();
+    std::vector<size_t> buckets(BUCKET_BOUNDS.size() + 1, 0);
+    for (auto size : sizes) {
+        double ratio = mean > 0 ? size / mean : 0;
+        buckets[std::upper_bound(BUCKET_BOUNDS.begin(), BUCKET_BOUNDS.end(), ratio) - BUCKET_BOUNDS.begin()]++;
+    }
+
+    ss << "nlist " << sizes.size() << ", min " << sizes.front() << ", median " << sizes[sizes.size() / 2] << ", max "
+       << sizes.back() << ", max/mean " << (mean > 0 ? sizes.back() / mean : 0) << ", lists by size/mean:";
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        if (i == 0) {
+            ss << " <" << BUCKET_BOUNDS[i] << "x ";
+        } else if (i == BUCKET_BOUNDS.size()) {
+            ss << ", >=" << BUCKET_BOUNDS[i - 1] << "x ";
+        } else {
+            ss << ", " << BUCKET_BOUNDS[i - 1] << "-" << BUCKET_BOUNDS[i] << "x ";
+        }
+        ss << buckets[i];
+    }
+    return ss.str();
+}
+
+const float*
+GetIVFCentroids(const faiss::IndexIVF* index) {
+    auto flat = dynamic_cast<const faiss::IndexFlat*>(index->quantizer);
+    if (flat == nullptr || flat->ntotal != (int64_t)index->nlist) {
+        return nullptr;
+    }
+    return flat->xb.data();
+}
+
+uint64_t
+GetIVFCentroidsFingerprint(const faiss::IndexIVF* index) {
+    auto centroids = GetIVFCentroids(index);
+    if (centroids == nullptr) {
+        return 0;
+    }
+    int64_t header[] = {(int64_t)index->metric_type, index->d, (int64_t)index->nlist};
+    uint64_t hash = Fnv1a(FNV_OFFSET_BASIS, header, sizeof(header));
+    hash = Fnv1a(hash, centroids, sizeof(float) * index->d * index->nlist);
+    return hash == 0 ? 1 : hash;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
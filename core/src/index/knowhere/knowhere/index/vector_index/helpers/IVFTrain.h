@@ -0,0 +1,53 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/IndexIVF.h>
+
+#include <cstdint>
+#include <string>
+
+#include "knowhere/common/Config.h"
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * Train an ivf index on the training set described by config.
+ * train_size samples the vectors used for the whole training, all of them by default.
+ * train_mode picks the k-means of the coarse quantizer:
+ *   lloyd (default): full k-means, on at most 256 vectors per list
+ *   mini_batch: k-means on random batches of batch_size vectors, 4 * nlist by default
+ *   hierarchical: k-means to sqrt(nlist) clusters, then each cluster split on its own
+ *   balanced: lloyd, then the lists over twice the mean size split in two, taking the place of the smallest ones
+ * The residual training, PQ or SQ, always runs on the sampled vectors.
+ * With centroids, nlist * dim already trained ones, the coarse quantizer is not trained at all.
+ */
+void
+TrainIVF(faiss::IndexIVF* index, int64_t rows, const float* data, const Config& config,
+         const float* centroids = nullptr);
+
+// the min, median and max sizes of the inverted lists, and the nb of lists by their size relative to the mean
+std::string
+GetIVFListSizeHistogram(const faiss::IndexIVF* index);
+
+// the nlist * dim centroids of a flat coarse quantizer, nullptr for the other quantizers
+const float*
+GetIVFCentroids(const faiss::IndexIVF* index);
+
+// hash of the metric and the centroids of a flat coarse quantizer, 0 for the other quantizers,
+// the indexes with the same fingerprint assign a query to the same lists
+uint64_t
+GetIVFCentroidsFingerprint(const faiss::IndexIVF* index);
+
+}  // namespace knowhere
+}  // namespace milvus
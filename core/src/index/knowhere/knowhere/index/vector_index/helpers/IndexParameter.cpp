@@ -44,5 +44,34 @@ GetMetricType(const std::string& type) {
     KNOWHERE_THROW_MSG("Metric type is invalid");
 }
 
+faiss::QuantizerType
+GetSQQuantizerType(const Config& config) {
+    if (!config.contains(IndexParams::nbits)) {
+        return faiss::QuantizerType::QT_8bit;
+    }
+    switch (config[IndexParams::nbits].get<int64_t>()) {
+        case 4:
+            return faiss::QuantizerType::QT_4bit;
+        case 6:
+            return faiss::QuantizerType::QT_6bit;
+        case 8:
+            return faiss::QuantizerType::QT_8bit;
+        default:
+            KNOWHERE_THROW_MSG("Scalar quantizer nbits is invalid, it must be 4, 6 or 8");
+    }
+}
+
+int64_t
+GetProbeCount(const Config& config) {
+    return IsAdaptiveProbe(config) ? config[IndexParams::max_nprobe].get<int64_t>()
+                                   : config[IndexParams::nprobe].get<int64_t>();
+}
+
+bool
+IsAdaptiveProbe(const Config& config) {
+    return config.contains(IndexParams::max_nprobe) &&
+           config[IndexParams::max_nprobe].get<int64_t>() > config[IndexParams::nprobe].get<int64_t>();
+}
+
 }  // namespace knowhere
 }  // namespace milvus
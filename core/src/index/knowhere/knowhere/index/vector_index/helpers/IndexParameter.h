@@ -12,8 +12,11 @@
 #pragma once
 
 #include <faiss/Index.h>
+#include <faiss/impl/ScalarQuantizerOp.h>
 #include <string>
 
+#include "knowhere/common/Config.h"
+
 namespace milvus {
 namespace knowhere {
 
@@ -24,15 +27,50 @@ constexpr const char* ROWS = "rows";
 constexpr const char* IDS = "ids";
 constexpr const char* DISTANCE = "distance";
 constexpr const char* TOPK = "k";
+// optional per query distances, a result has to beat the bound of its query to be kept
+constexpr const char* BOUNDS = "bounds";
+// optional flag the search polls, it stops scanning once the flag is set
+constexpr const char* CANCEL = "cancel";
+// optional nq * nprobe coarse assignment of the queries, the IVF indexes trained with the same centroids probe
+// these lists instead of searching their own quantizer
+constexpr const char* COARSE_IDS = "coarse_ids";
+constexpr const char* COARSE_DISTANCES = "coarse_distances";
+// optional nlist * dim trained centroids, the IVF training only trains the residual then
+constexpr const char* CENTROIDS = "centroids";
+// range search: the distance bound of the results and the nq + 1 offsets of the per query results in IDS and DISTANCE
+constexpr const char* RADIUS = "radius";
+constexpr const char* LIMS = "lims";
 constexpr const char* DEVICEID = "gpu_id";
+// optional gpu ids the add of a gpu IVF build is split across, the index is still trained on DEVICEID alone
+constexpr const char* SHARD_DEVICES = "shard_devices";
 };  // namespace meta
 
 namespace IndexParams {
 // IVF Params
 constexpr const char* nprobe = "nprobe";
+// optional, IVF adaptive search of L2 indexes: up to max_nprobe lists are probed, skipping those that can't hold a
+// result beating the current top k
+constexpr const char* max_nprobe = "max_nprobe";
 constexpr const char* nlist = "nlist";
 constexpr const char* m = "m";          // PQ
 constexpr const char* nbits = "nbits";  // PQ/SQ
+constexpr const char* storage_type = "storage_type";  // IVF_NM raw data, one of StorageType
+constexpr const char* on_disk = "on_disk";            // optional, IVF_SQ8/IVF_PQ lists stay in the index file
+constexpr const char* train_mode = "train_mode";      // optional, IVF coarse quantizer training, one of TrainMode
+constexpr const char* train_size = "train_size";      // optional, IVF training vectors sampled from the data
+constexpr const char* batch_size = "batch_size";      // optional, IVF mini-batch k-means points per iteration
+// optional, IVF centroids trained by the first build of the collection and reused by the later ones
+constexpr const char* shared_quantizer = "shared_quantizer";
+// optional, IVF_SQ8/IVF_PQ candidates per query re-scored with the raw vectors before the top k is kept
+constexpr const char* refine_k = "refine_k";
+// optional, IVF_PQ on gpu scans the lists with float16 lookup tables, false by default
+constexpr const char* lut_fp16 = "lut_fp16";
+// optional, vector transforms in front of the index, the spec of a VectorTransformPreprocessor
+constexpr const char* preprocess = "preprocess";
+
+// IDMAP Params
+// optional, the vectors held as one of Compression, distances are then approximated
+constexpr const char* compression = "compression";
 
 // NSG Params
 constexpr const char* knng = "knng";
@@ -44,10 +82,18 @@ constexpr const char* candidate = "candidate_pool_size";
 constexpr const char* efConstruction = "efConstruction";
 constexpr const char* M = "M";
 constexpr const char* ef = "ef";
+constexpr const char* reorder = "reorder";  // optional, lay out the nodes in bfs order after the build
 
 // Annoy Params
 constexpr const char* n_trees = "n_trees";
 constexpr const char* search_k = "search_k";
+
+// DiskANN Params, besides out_degree, candidate_pool_size, m and search_length
+constexpr const char* beam_width = "beam_width";  // optional, nodes read per search step
+
+// Binary hash Params, besides nbits, the bits of a hash table key
+constexpr const char* nhash = "nhash";
+constexpr const char* nflip = "nflip";  // the bits of the query keys flipped to look up the neighbor buckets
 }  // namespace IndexParams
 
 namespace Metric {
@@ -61,8 +107,38 @@ constexpr const char* SUBSTRUCTURE = "SUBSTRUCTURE";
 constexpr const char* SUPERSTRUCTURE = "SUPERSTRUCTURE";
 }  // namespace Metric
 
+namespace StorageType {
+constexpr const char* FLOAT32 = "float32";
+constexpr const char* FLOAT16 = "float16";
+constexpr const char* BFLOAT16 = "bfloat16";
+}  // namespace StorageType
+
+namespace Compression {
+constexpr const char* NONE = "none";
+constexpr const char* SQ8 = "sq8";
+constexpr const char* FP16 = "fp16";
+}  // namespace Compression
+
+namespace TrainMode {
+constexpr const char* LLOYD = "lloyd";
+constexpr const char* MINI_BATCH = "mini_batch";
+constexpr const char* HIERARCHICAL = "hierarchical";
+constexpr const char* BALANCED = "balanced";
+}  // namespace TrainMode
+
 extern faiss::MetricType
 GetMetricType(const std::string& type);
 
+// the scalar quantizer of the nbits per dimension of an SQ index, 8 when not given
+extern faiss::QuantizerType
+GetSQQuantizerType(const Config& config);
+
+// the lists an IVF search probes per query, max_nprobe for an adaptive search
+extern int64_t
+GetProbeCount(const Config& config);
+
+extern bool
+IsAdaptiveProbe(const Config& config);
+
 }  // namespace knowhere
 }  // namespace milvus
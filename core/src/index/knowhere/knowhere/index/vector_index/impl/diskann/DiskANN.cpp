@@ -0,0 +1,496 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/impl/diskann/DiskANN.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+#include "faiss/BuilderSuspend.h"
+#include "faiss/FaissHook.h"
+#include "knowhere/common/Exception.h"
+
+namespace milvus {
+namespace knowhere {
+namespace impl {
+
+namespace {
+
+constexpr uint64_t DISKANN_VERSION = 1;
+constexpr size_t PQ_NBITS = 8;
+constexpr size_t PQ_TRAIN_SIZE = 65536;
+constexpr unsigned int BUILD_SEED = 100;
+
+struct MetaHeader {
+    uint64_t version;
+    uint64_t ntotal;
+    uint64_t dim;
+    uint64_t max_degree;
+    uint64_t medoid;
+    uint64_t pq_m;
+};
+
+struct Candidate {
+    uint32_t id;
+    float distance;
+    bool expanded;
+
+    bool
+    operator<(const Candidate& other) const {
+        return distance < other.distance;
+    }
+};
+
+// keeps list sorted by distance and at most capacity long
+inline void
+InsertCandidate(std::vector<Candidate>& list, size_t capacity, const Candidate& candidate) {
+    if (list.size() >= capacity && !(candidate < list.back())) {
+        return;
+    }
+    list.insert(std::upper_bound(list.begin(), list.end(), candidate), candidate);
+    if (list.size() > capacity) {
+        list.pop_back();
+    }
+}
+
+using Graph = std::vector<std::vector<uint32_t>>;
+
+class VamanaBuilder {
+ public:
+    VamanaBuilder(size_t n, size_t dim, const float* data, const DiskANNIndex::BuildParams& params)
+        : n_(n), dim_(dim), data_(data), params_(params), graph_(n), locks_(n) {
+    }
+
+    uint32_t
+    Build() {
+        InitRandomGraph();
+        FindMedoid();
+        // the first pass builds short edges only, the second one adds long range edges with alpha > 1
+        Refine(1.0f);
+        Refine(params_.alpha);
+        return medoid_;
+    }
+
+    const Graph&
+    graph() const {
+        return graph_;
+    }
+
+ private:
+    float
+    Distance(uint32_t a, uint32_t b) const {
+        return faiss::fvec_L2sqr(data_ + a * dim_, data_ + b * dim_, dim_);
+    }
+
+    void
+    InitRandomGraph() {
+        size_t degree = std::min(params_.max_degree, n_ - 1);
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (int64_t i = 0; i < (int64_t)n_; i++) {
+            std::mt19937 rng(BUILD_SEED + i);
+            auto& neighbors = graph_[i];
+            neighbors.reserve(params_.max_degree);
+            if (degree == n_ - 1) {
+                for (size_t j = 0; j < n_; j++) {
+                    if (j != (size_t)i) {
+                        neighbors.push_back(j);
+                    }
+                }
+                continue;
+            }
+            std::unordered_set<uint32_t> chosen;
+            while (neighbors.size() < degree) {
+                uint32_t j = rng() % n_;
+                if (j != (uint32_t)i && chosen.insert(j).second) {
+                    neighbors.push_back(j);
+                }
+            }
+        }
+    }
+
+    // entry point: the vector nearest to the centroid of the data
+    void
+    FindMedoid() {
+        std::vector<double> sum(dim_, 0.0);
+        for (size_t i = 0; i < n_; i++) {
+            const float* x = data_ + i * dim_;
+            for (size_t j = 0; j < dim_; j++) {
+                sum[j] += x[j];
+            }
+        }
+        std::vector<float> centroid(dim_);
+        for (size_t j = 0; j < dim_; j++) {
+            centroid[j] = sum[j] / n_;
+        }
+
+        float best = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < n_; i++) {
+            float dist = faiss::fvec_L2sqr(centroid.data(), data_ + i * dim_, dim_);
+            if (dist < best) {
+                best = dist;
+                medoid_ = i;
+            }
+        }
+    }
+
+    // returns every node expanded by a greedy search of p from the medoid, with its distance to p
+    void
+    GreedySearch(uint32_t p, std::vector<Candidate>& expanded) {
+        const float* query = data_ + p * dim_;
+        std::vector<Candidate> list;
+        list.reserve(params_.search_length + 1);
+        std::unordered_set<uint32_t> visited;
+        std::vector<uint32_t> neighbors;
+
+        list.push_back({medoid_, faiss::fvec_L2sqr(query, data_ + medoid_ * dim_, dim_), false});
+        visited.insert(medoid_);
+        while (true) {
+            auto it = std::find_if(list.begin(), list.end(), [](const Candidate& c) { return !c.expanded; });
+            if (it == list.end()) {
+                break;
+            }
+            it->expanded = true;
+            expanded.push_back(*it);
+            {
+                std::lock_guard<std::mutex> lock(locks_[it->id]);
+                neighbors = graph_[it->id];
+            }
+            for (auto id : neighbors) {
+                if (visited.insert(id).second) {
+                    InsertCandidate(list, params_.search_length,
+                                    {id, faiss::fvec_L2sqr(query, data_ + id * dim_, dim_), false});
+                }
+            }
+        }
+    }
+
+    // picks at most max_degree neighbors of p out of pool, dropping the candidates that an already picked
+    // neighbor covers within a factor alpha
+    void
+    RobustPrune(uint32_t p, std::vector<Candidate>& pool, float alpha, std::vector<uint32_t>& result) const {
+        std::sort(pool.begin(), pool.end());
+        std::unordered_set<uint32_t> seen;
+        std::vector<Candidate> unique;
+        unique.reserve(pool.size());
+        for (auto& c : pool) {
+            if (c.id != p && seen.insert(c.id).second) {
+                unique.push_back(c);
+            }
+        }
+
+        result.clear();
+        std::vector<bool> pruned(unique.size(), false);
+        for (size_t i = 0; i < unique.size() && result.size() < params_.max_degree; i++) {
+            if (pruned[i]) {
+                continue;
+            }
+            result.push_back(unique[i].id);
+            for (size_t j = i + 1; j < unique.size(); j++) {
+                if (!pruned[j] && alpha * Distance(unique[i].id, unique[j].id) <= unique[j].distance) {
+                    pruned[j] = true;
+                }
+            }
+        }
+    }
+
+    void
+    Refine(float alpha) {
+        std::vector<uint32_t> order(n_);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937(BUILD_SEED));
+
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int64_t i = 0; i < (int64_t)n_; i++) {
+            if (i % 4096 == 0) {
+                faiss::BuilderSuspend::check_wait();
+            }
+            uint32_t p = order[i];
+            std::vector<Candidate> pool;
+            GreedySearch(p, pool);
+
+            std::vector<uint32_t> pruned;
+            {
+                std::lock_guard<std::mutex> lock(locks_[p]);
+                for (auto id : graph_[p]) {
+                    pool.push_back({id, Distance(p, id), false});
+                }
+            }
+            RobustPrune(p, pool, alpha, pruned);
+            {
+                std::lock_guard<std::mutex> lock(locks_[p]);
+                graph_[p] = pruned;
+            }
+
+            // back edges, a full list is pruned again
+            std::vector<Candidate> back_pool;
+            std::vector<uint32_t> back_pruned;
+            for (auto j : pruned) {
+                std::lock_guard<std::mutex> lock(locks_[j]);
+                auto& neighbors = graph_[j];
+                if (std::find(neighbors.begin(), neighbors.end(), p) != neighbors.end()) {
+                    continue;
+                }
+                if (neighbors.size() < params_.max_degree) {
+                    neighbors.push_back(p);
+                    continue;
+                }
+                back_pool.clear();
+                back_pool.push_back({p, Distance(j, p), false});
+                for (auto id : neighbors) {
+                    back_pool.push_back({id, Distance(j, id), false});
+                }
+                RobustPrune(j, back_pool, alpha, back_pruned);
+                neighbors = back_pruned;
+            }
+        }
+    }
+
+ private:
+    size_t n_;
+    size_t dim_;
+    const float* data_;
+    const DiskANNIndex::BuildParams& params_;
+    Graph graph_;
+    std::vector<std::mutex> locks_;
+    uint32_t medoid_ = 0;
+};
+
+size_t
+PageSize() {
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+}  // namespace
+
+void
+DiskANNIndex::SetLayout() {
+    node_size_ = dim_ * sizeof(float) + sizeof(uint32_t) + max_degree_ * sizeof(uint32_t);
+    if (node_size_ <= SECTOR_SIZE) {
+        nodes_per_sector_ = SECTOR_SIZE / node_size_;
+        sectors_per_node_ = 0;
+        sectors_size_ = (ntotal_ + nodes_per_sector_ - 1) / nodes_per_sector_ * SECTOR_SIZE;
+    } else {
+        nodes_per_sector_ = 0;
+        sectors_per_node_ = (node_size_ + SECTOR_SIZE - 1) / SECTOR_SIZE;
+        sectors_size_ = ntotal_ * sectors_per_node_ * SECTOR_SIZE;
+    }
+}
+
+void
+DiskANNIndex::Build(size_t n, size_t dim, const float* data, const BuildParams& params) {
+    if (n < (1 << PQ_NBITS)) {
+        KNOWHERE_THROW_MSG("DISKANN needs at least " + std::to_string(1 << PQ_NBITS) + " vectors to train PQ");
+    }
+    if (params.pq_m == 0 || dim % params.pq_m != 0) {
+        KNOWHERE_THROW_MSG("DISKANN dimension must be a multiple of m");
+    }
+    ntotal_ = n;
+    dim_ = dim;
+    max_degree_ = params.max_degree;
+    mapped_ = false;
+
+    pq_ = faiss::ProductQuantizer(dim, params.pq_m, PQ_NBITS);
+    if (n > PQ_TRAIN_SIZE) {
+        std::vector<size_t> rows(n);
+        std::iota(rows.begin(), rows.end(), 0);
+        std::shuffle(rows.begin(), rows.end(), std::mt19937(BUILD_SEED));
+        std::vector<float> sample(PQ_TRAIN_SIZE * dim);
+        for (size_t i = 0; i < PQ_TRAIN_SIZE; i++) {
+            memcpy(sample.data() + i * dim, data + rows[i] * dim, dim * sizeof(float));
+        }
+        pq_.train(PQ_TRAIN_SIZE, sample.data());
+    } else {
+        pq_.train(n, data);
+    }
+    codes_.resize(n * pq_.code_size);
+    pq_.compute_codes(data, codes_.data(), n);
+
+    VamanaBuilder builder(n, dim, data, params);
+    medoid_ = builder.Build();
+    auto& graph = builder.graph();
+
+    SetLayout();
+    sectors_ = std::shared_ptr<uint8_t[]>(new uint8_t[sectors_size_]);
+    memset(sectors_.get(), 0, sectors_size_);
+#pragma omp parallel for
+    for (int64_t i = 0; i < (int64_t)n; i++) {
+        uint8_t* record = sectors_.get() + NodeOffset(i);
+        uint32_t degree = graph[i].size();
+        memcpy(record, data + i * dim, dim * sizeof(float));
+        memcpy(record + dim * sizeof(float), &degree, sizeof(degree));
+        memcpy(record + dim * sizeof(float) + sizeof(degree), graph[i].data(), degree * sizeof(uint32_t));
+    }
+}
+
+std::shared_ptr<uint8_t[]>
+DiskANNIndex::SerializeMeta(int64_t& size) const {
+    MetaHeader header{DISKANN_VERSION, ntotal_, dim_, max_degree_, medoid_, pq_.M};
+    size_t centroids_size = pq_.centroids.size() * sizeof(float);
+    size = sizeof(header) + centroids_size + codes_.size();
+
+    std::shared_ptr<uint8_t[]> meta(new uint8_t[size]);
+    uint8_t* p = meta.get();
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    memcpy(p, pq_.centroids.data(), centroids_size);
+    p += centroids_size;
+    memcpy(p, codes_.data(), codes_.size());
+    return meta;
+}
+
+void
+DiskANNIndex::Load(const uint8_t* meta, int64_t meta_size, const std::shared_ptr<uint8_t[]>& sectors,
+                   int64_t sectors_size, bool mapped) {
+    MetaHeader header;
+    if (meta_size < (int64_t)sizeof(header)) {
+        KNOWHERE_THROW_MSG("DISKANN meta is truncated");
+    }
+    memcpy(&header, meta, sizeof(header));
+    if (header.version != DISKANN_VERSION) {
+        KNOWHERE_THROW_MSG("DISKANN meta version " + std::to_string(header.version) + " is not supported");
+    }
+    ntotal_ = header.ntotal;
+    dim_ = header.dim;
+    max_degree_ = header.max_degree;
+    medoid_ = header.medoid;
+
+    pq_ = faiss::ProductQuantizer(dim_, header.pq_m, PQ_NBITS);
+    size_t centroids_size = pq_.centroids.size() * sizeof(float);
+    size_t codes_size = ntotal_ * pq_.code_size;
+    if ((size_t)meta_size != sizeof(header) + centroids_size + codes_size) {
+        KNOWHERE_THROW_MSG("DISKANN meta size does not match its header");
+    }
+    memcpy(pq_.centroids.data(), meta + sizeof(header), centroids_size);
+    codes_.assign(meta + sizeof(header) + centroids_size, meta + meta_size);
+
+    SetLayout();
+    if (sectors_size != sectors_size_) {
+        KNOWHERE_THROW_MSG("DISKANN data size does not match its meta");
+    }
+    sectors_ = sectors;
+    mapped_ = mapped;
+    if (mapped_) {
+        // the read-ahead of sequential access only wastes I/O on graph walks
+        uintptr_t begin = reinterpret_cast<uintptr_t>(sectors_.get()) & ~(PageSize() - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(sectors_.get()) + sectors_size_;
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_RANDOM);
+    }
+}
+
+void
+DiskANNIndex::Prefetch(size_t id) const {
+    if (!mapped_) {
+        return;
+    }
+    uintptr_t record = reinterpret_cast<uintptr_t>(sectors_.get() + NodeOffset(id));
+    uintptr_t begin = record & ~(PageSize() - 1);
+    madvise(reinterpret_cast<void*>(begin), record + node_size_ - begin, MADV_WILLNEED);
+}
+
+void
+DiskANNIndex::Search(const float* query, size_t k, const SearchParams& params, float* distances, int64_t* labels,
+                     const faiss::ConcurrentBitsetPtr& bitset) const {
+    size_t search_length = std::max(params.search_length, k);
+    size_t beam_width = std::max(params.beam_width, (size_t)1);
+
+    std::vector<float> table(pq_.M * pq_.ksub);
+    pq_.compute_distance_table(query, table.data());
+    auto pq_distance = [&](uint32_t id) {
+        const uint8_t* code = codes_.data() + id * pq_.code_size;
+        const float* t = table.data();
+        float dist = 0;
+        for (size_t m = 0; m < pq_.M; m++, t += pq_.ksub) {
+            dist += t[code[m]];
+        }
+        return dist;
+    };
+
+    std::vector<Candidate> list;
+    list.reserve(search_length + 1);
+    std::unordered_set<uint32_t> visited;
+    std::vector<std::pair<float, int64_t>> results;
+    std::vector<uint32_t> beam;
+    std::vector<float> vector(dim_);
+    std::vector<uint32_t> neighbors(max_degree_);
+
+    list.push_back({medoid_, pq_distance(medoid_), false});
+    visited.insert(medoid_);
+    while (true) {
+        beam.clear();
+        for (auto& c : list) {
+            if (!c.expanded) {
+                c.expanded = true;
+                beam.push_back(c.id);
+                if (beam.size() == beam_width) {
+                    break;
+                }
+            }
+        }
+        if (beam.empty()) {
+            break;
+        }
+
+        for (auto id : beam) {
+            Prefetch(id);
+        }
+        for (auto id : beam) {
+            // records are not aligned within a mapping, copy them out
+            const uint8_t* record = sectors_.get() + NodeOffset(id);
+            uint32_t degree;
+            memcpy(vector.data(), record, dim_ * sizeof(float));
+            memcpy(&degree, record + dim_ * sizeof(float), sizeof(degree));
+            memcpy(neighbors.data(), record + dim_ * sizeof(float) + sizeof(degree), degree * sizeof(uint32_t));
+
+            if (bitset == nullptr || !bitset->test(id)) {
+                results.emplace_back(faiss::fvec_L2sqr(query, vector.data(), dim_), id);
+            }
+            for (uint32_t i = 0; i < degree; i++) {
+                if (visited.insert(neighbors[i]).second) {
+                    InsertCandidate(list, search_length, {neighbors[i], pq_distance(neighbors[i]), false});
+                }
+            }
+        }
+    }
+
+    size_t found = std::min(k, results.size());
+    std::partial_sort(results.begin(), results.begin() + found, results.end());
+    for (size_t i = 0; i < found; i++) {
+        distances[i] = results[i].first;
+        labels[i] = results[i].second;
+    }
+    for (size_t i = found; i < k; i++) {
+        distances[i] = std::numeric_limits<float>::max();
+        labels[i] = -1;
+    }
+}
+
+int64_t
+DiskANNIndex::ResidentSize() const {
+    int64_t size = sizeof(MetaHeader) + pq_.centroids.size() * sizeof(float) + codes_.size();
+    if (!mapped_) {
+        size += sectors_size_;
+    }
+    return size;
+}
+
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,130 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <faiss/impl/ProductQuantizer.h>
+#include <faiss/utils/ConcurrentBitset.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace milvus {
+namespace knowhere {
+namespace impl {
+
+/*
+ * Vamana graph searched from disk, as in DiskANN.
+ *
+ * Only the PQ codes of the vectors live on the heap. The full precision vectors and the adjacency lists are
+ * stored together, one record per node, in sector aligned blocks: a record never straddles a sector, so
+ * expanding a node costs a single random read. The beam search ranks candidates by their PQ distance, reads
+ * the records of the beam only, and orders the results by the exact distances found in those records.
+ *
+ * When the sectors alias a file mapping, the records of a beam are requested with madvise(MADV_WILLNEED)
+ * before the first one is touched, so the reads of one beam are issued together and overlap.
+ */
+class DiskANNIndex {
+ public:
+    struct BuildParams {
+        size_t max_degree;     // R, out degree bound of every node
+        size_t search_length;  // L, candidate list size of the searches run while building
+        float alpha;           // pruning slack of the second pass, > 1 keeps long range edges
+        size_t pq_m;           // number of 8 bits sub-quantizers of the in-memory codes
+    };
+
+    struct SearchParams {
+        size_t search_length;  // L, candidate list size
+        size_t beam_width;     // W, nodes read per step
+    };
+
+    static constexpr size_t SECTOR_SIZE = 4096;
+
+    DiskANNIndex() = default;
+
+    void
+    Build(size_t n, size_t dim, const float* data, const BuildParams& params);
+
+    // header, PQ centroids and PQ codes, everything that is kept on the heap
+    std::shared_ptr<uint8_t[]>
+    SerializeMeta(int64_t& size) const;
+
+    const std::shared_ptr<uint8_t[]>&
+    Sectors() const {
+        return sectors_;
+    }
+
+    int64_t
+    SectorsSize() const {
+        return sectors_size_;
+    }
+
+    // mapped tells whether sectors alias a file mapping, they are used in place in both cases
+    void
+    Load(const uint8_t* meta, int64_t meta_size, const std::shared_ptr<uint8_t[]>& sectors, int64_t sectors_size,
+         bool mapped);
+
+    void
+    Search(const float* query, size_t k, const SearchParams& params, float* distances, int64_t* labels,
+           const faiss::ConcurrentBitsetPtr& bitset) const;
+
+    size_t
+    Count() const {
+        return ntotal_;
+    }
+
+    size_t
+    Dim() const {
+        return dim_;
+    }
+
+    // bytes kept on the heap, the sectors are not counted when they are mapped
+    int64_t
+    ResidentSize() const;
+
+ private:
+    size_t
+    NodeOffset(size_t id) const {
+        if (nodes_per_sector_ > 0) {
+            return (id / nodes_per_sector_) * SECTOR_SIZE + (id % nodes_per_sector_) * node_size_;
+        }
+        return id * sectors_per_node_ * SECTOR_SIZE;
+    }
+
+    void
+    SetLayout();
+
+    void
+    Prefetch(size_t id) const;
+
+ private:
+    size_t ntotal_ = 0;
+    size_t dim_ = 0;
+    size_t max_degree_ = 0;
+    uint32_t medoid_ = 0;
+
+    size_t node_size_ = 0;         // vector, degree and max_degree_ neighbor ids
+    size_t nodes_per_sector_ = 0;  // 0 when a node spans several sectors
+    size_t sectors_per_node_ = 0;
+
+    faiss::ProductQuantizer pq_;
+    std::vector<uint8_t> codes_;
+
+    std::shared_ptr<uint8_t[]> sectors_;
+    int64_t sectors_size_ = 0;
+    bool mapped_ = false;
+};
+
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
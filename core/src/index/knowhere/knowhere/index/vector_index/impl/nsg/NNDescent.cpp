@@ -0,0 +1,203 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/impl/nsg/NNDescent.h"
+
+#include <omp.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "faiss/BuilderSuspend.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/common/Timer.h"
+
+namespace milvus {
+namespace knowhere {
+namespace impl {
+
+NNDescent::NNDescent(size_t dimension, size_t n, const float* data, const Distance* distance)
+    : dimension_(dimension), ntotal_(n), data_(data), distance_(distance) {
+}
+
+void
+NNDescent::Build(const Params& params, Graph& graph) {
+    params_ = params;
+    params_.pool_size = std::min(std::max(params_.pool_size, params_.k), ntotal_ - 1);
+    graph.clear();
+    graph.resize(ntotal_);
+    if (ntotal_ < 2) {
+        return;
+    }
+
+    TimeRecorder rc("NNDescent", 1);
+    nodes_.reset(new Node[ntotal_]);
+    InitPools();
+    rc.RecordSection("init");
+
+    auto threshold = static_cast<size_t>(params_.delta * ntotal_ * params_.k);
+    for (size_t it = 0; it < params_.iterations; ++it) {
+        Sample();
+        auto updates = Join();
+        LOG_KNOWHERE_DEBUG_ << "NNDescent iteration " << it << ", " << updates << " updates";
+        if (updates <= threshold) {
+            break;
+        }
+    }
+    rc.RecordSection("refine");
+
+#pragma omp parallel for schedule(static, 1024)
+    for (size_t n = 0; n < ntotal_; ++n) {
+        auto& node = nodes_[n];
+        auto k = std::min(params_.k, node.pool.size());
+        graph[n].resize(k);
+        for (size_t i = 0; i < k; ++i) {
+            graph[n][i] = node.pool[i].id;
+        }
+        std::vector<Neighbor>().swap(node.pool);
+        std::vector<node_t>().swap(node.nn_new);
+        std::vector<node_t>().swap(node.nn_old);
+    }
+    nodes_.reset();
+    rc.ElapseFromBegin("finish");
+}
+
+void
+NNDescent::InitPools() {
+#pragma omp parallel for schedule(dynamic, 256)
+    for (size_t n = 0; n < ntotal_; ++n) {
+        std::mt19937 rng(n);
+        std::uniform_int_distribution<node_t> dist(0, ntotal_ - 1);
+        auto& pool = nodes_[n].pool;
+        pool.reserve(params_.pool_size + 1);
+        while (pool.size() < params_.pool_size) {
+            auto id = dist(rng);
+            if (id == static_cast<node_t>(n) ||
+                std::any_of(pool.begin(), pool.end(), [id](const Neighbor& nn) { return nn.id == id; })) {
+                continue;
+            }
+            pool.emplace_back(id, Compare(n, id), false);
+        }
+        std::sort(pool.begin(), pool.end());
+    }
+}
+
+void
+NNDescent::Sample() {
+    // forward: at most sample new neighbors are joined per iteration, they are old from now on
+#pragma omp parallel for schedule(static, 1024)
+    for (size_t n = 0; n < ntotal_; ++n) {
+        auto& node = nodes_[n];
+        node.nn_new.clear();
+        node.nn_old.clear();
+        for (auto& nn : node.pool) {
+            if (!nn.has_explored) {
+                if (node.nn_new.size() < params_.sample) {
+                    node.nn_new.push_back(nn.id);
+                    nn.has_explored = true;
+                }
+            } else {
+                node.nn_old.push_back(nn.id);
+            }
+        }
+    }
+
+    // backward: n is a reverse neighbor of everything it points to, once the list of a node is full a
+    // random half of the later candidates replace an entry so that the first nodes are not favored
+#pragma omp parallel
+    {
+        std::mt19937 rng(omp_get_thread_num());
+        auto add_reverse = [&](std::vector<node_t>& rnn, node_t n) {
+            if (rnn.size() < params_.reverse) {
+                rnn.push_back(n);
+            } else {
+                auto pos = rng() % (2 * params_.reverse);
+                if (pos < params_.reverse) {
+                    rnn[pos] = n;
+                }
+            }
+        };
+#pragma omp for schedule(static, 1024)
+        for (size_t n = 0; n < ntotal_; ++n) {
+            for (auto id : nodes_[n].nn_new) {
+                LockGuard lock(nodes_[id].mutex);
+                add_reverse(nodes_[id].rnn_new, n);
+            }
+            for (auto id : nodes_[n].nn_old) {
+                LockGuard lock(nodes_[id].mutex);
+                add_reverse(nodes_[id].rnn_old, n);
+            }
+        }
+    }
+
+#pragma omp parallel for schedule(static, 1024)
+    for (size_t n = 0; n < ntotal_; ++n) {
+        auto& node = nodes_[n];
+        node.nn_new.insert(node.nn_new.end(), node.rnn_new.begin(), node.rnn_new.end());
+        node.nn_old.insert(node.nn_old.end(), node.rnn_old.begin(), node.rnn_old.end());
+        std::sort(node.nn_new.begin(), node.nn_new.end());
+        node.nn_new.erase(std::unique(node.nn_new.begin(), node.nn_new.end()), node.nn_new.end());
+        std::sort(node.nn_old.begin(), node.nn_old.end());
+        node.nn_old.erase(std::unique(node.nn_old.begin(), node.nn_old.end()), node.nn_old.end());
+        std::vector<node_t>().swap(node.rnn_new);
+        std::vector<node_t>().swap(node.rnn_old);
+    }
+}
+
+size_t
+NNDescent::Join() {
+    size_t updates = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+ : updates)
+    for (size_t n = 0; n < ntotal_; ++n) {
+        faiss::BuilderSuspend::check_wait();
+        auto& nn_new = nodes_[n].nn_new;
+        auto& nn_old = nodes_[n].nn_old;
+        for (size_t i = 0; i < nn_new.size(); ++i) {
+            auto a = nn_new[i];
+            for (size_t j = i + 1; j < nn_new.size(); ++j) {
+                auto b = nn_new[j];
+                auto dist = Compare(a, b);
+                updates += Insert(a, b, dist) + Insert(b, a, dist);
+            }
+            for (auto b : nn_old) {
+                if (a == b) {
+                    continue;
+                }
+                auto dist = Compare(a, b);
+                updates += Insert(a, b, dist) + Insert(b, a, dist);
+            }
+        }
+    }
+    return updates;
+}
+
+size_t
+NNDescent::Insert(node_t n, node_t id, float distance) {
+    auto& node = nodes_[n];
+    LockGuard lock(node.mutex);
+    auto& pool = node.pool;
+    if (distance >= pool.back().distance) {
+        return 0;
+    }
+    for (auto& nn : pool) {
+        if (nn.id == id) {
+            return 0;
+        }
+    }
+    auto pos = std::upper_bound(pool.begin(), pool.end(), Neighbor(id, distance));
+    pool.insert(pos, Neighbor(id, distance, false));
+    pool.pop_back();
+    return 1;
+}
+
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
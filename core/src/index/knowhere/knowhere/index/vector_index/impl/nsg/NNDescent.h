@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Distance.h"
+#include "Neighbor.h"
+
+namespace milvus {
+namespace knowhere {
+namespace impl {
+
+using Graph = std::vector<std::vector<node_t>>;
+
+/*
+ * Approximate kNN graph built by NN-Descent (Dong et al., "Efficient k-nearest neighbor graph construction for
+ * generic similarity measures").
+ *
+ * Every node starts from a random pool of neighbors. Each iteration joins the new neighbors of a node, sampled
+ * forward and backward, with each other and with its old neighbors: a neighbor of a neighbor is likely a neighbor.
+ * It stops once an iteration improves less than delta * n * k pool entries.
+ */
+class NNDescent {
+ public:
+    struct Params {
+        size_t k;           // neighbors kept per node in the result
+        size_t pool_size;   // candidates kept per node while refining, >= k
+        size_t sample;      // new neighbors joined per node and iteration
+        size_t reverse;     // reverse neighbors joined per node and iteration
+        size_t iterations;  // upper bound of the refining iterations
+        float delta;        // early termination threshold
+    };
+
+    NNDescent(size_t dimension, size_t n, const float* data, const Distance* distance);
+
+    // the pool of a node is released as soon as its neighbors are moved into graph
+    void
+    Build(const Params& params, Graph& graph);
+
+ private:
+    struct Node {
+        std::mutex mutex;
+        std::vector<Neighbor> pool;  // sorted, has_explored tells the old neighbors from the new ones
+        std::vector<node_t> nn_new;
+        std::vector<node_t> nn_old;
+        std::vector<node_t> rnn_new;
+        std::vector<node_t> rnn_old;
+    };
+
+    void
+    InitPools();
+
+    void
+    Sample();
+
+    size_t
+    Join();
+
+    // returns 1 when the pool of n changed
+    size_t
+    Insert(node_t n, node_t id, float distance);
+
+    float
+    Compare(node_t a, node_t b) const {
+        return distance_->Compare(data_ + a * dimension_, data_ + b * dimension_, dimension_);
+    }
+
+ private:
+    size_t dimension_;
+    size_t ntotal_;
+    const float* data_;
+    const Distance* distance_;
+
+    Params params_;
+    std::unique_ptr<Node[]> nodes_;
+};
+
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
@@ -23,6 +23,7 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
 #include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/impl/nsg/NNDescent.h"
 #include "knowhere/index/vector_index/impl/nsg/NSGHelper.h"
 
 namespace milvus {
@@ -59,6 +60,11 @@ NsgIndex::Build_with_ids(size_t nb, float* data, const int64_t* ids, const Build
     candidate_pool_size = parameters.candidate_pool_size;
 
     TimeRecorder rc("NSG", 1);
+    if (knng.empty()) {
+        BuildKnnGraph(data, parameters.knng);
+        rc.RecordSection("knng");
+    }
+
     InitNavigationPoint(data);
     rc.RecordSection("init");
 
@@ -88,6 +94,20 @@ NsgIndex::Build_with_ids(size_t nb, float* data, const int64_t* ids, const Build
     // }
 }
 
+void
+NsgIndex::BuildKnnGraph(float* data, size_t k) {
+    NNDescent::Params params;
+    params.k = k;
+    params.pool_size = k + 10;
+    params.sample = 10;
+    params.reverse = 100;
+    params.iterations = 12;
+    params.delta = 0.002;
+
+    NNDescent nn_descent(dimension, ntotal, data, distance_);
+    nn_descent.Build(params, knng);
+}
+
 void
 NsgIndex::InitNavigationPoint(float* data) {
     // calculate the center of vectors
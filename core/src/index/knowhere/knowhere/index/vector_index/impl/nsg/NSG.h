@@ -32,6 +32,7 @@ struct BuildParams {
     size_t search_length;
     size_t out_degree;
     size_t candidate_pool_size;
+    size_t knng;  // neighbors per node of the kNN graph built by NN-Descent when none is set
 };
 
 struct SearchParams {
@@ -100,6 +101,9 @@ class NsgIndex {
     //                   const BuildParam &parameters);
 
  protected:
+    void
+    BuildKnnGraph(float* data, size_t k);
+
     void
     InitNavigationPoint(float* data);
 
@@ -28,6 +28,9 @@
 namespace milvus {
 namespace knowhere {
 
+// number of points inserted serially at the start of a build
+constexpr int64_t HNSW_SERIAL_ADD_ROWS = 1000;
+
 // void
 // normalize_vector(float* data, float* norm_array, size_t dim) {
 //     float norm = 0.0f;
@@ -111,9 +114,13 @@ IndexHNSW_NM::Add(const DatasetPtr& dataset_ptr, const Config& config) {
 
     auto base = index_->getCurrentElementCount();
     auto pp_data = const_cast<void*>(p_data);
-    index_->addPoint(pp_data, p_ids[0], base, 0);
-#pragma omp parallel for
-    for (int i = 1; i < rows; ++i) {
+    int64_t serial_rows = std::min<int64_t>(rows, HNSW_SERIAL_ADD_ROWS);
+    for (int64_t i = 0; i < serial_rows; ++i) {
+        faiss::BuilderSuspend::check_wait();
+        index_->addPoint(pp_data, p_ids[i], base, i);
+    }
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int64_t i = serial_rows; i < rows; ++i) {
         faiss::BuilderSuspend::check_wait();
         index_->addPoint(pp_data, p_ids[i], base, i);
     }
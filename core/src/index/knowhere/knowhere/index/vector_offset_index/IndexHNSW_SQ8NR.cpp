@@ -24,10 +24,17 @@
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus {
 namespace knowhere {
 
+// number of points inserted serially at the start of a build
+constexpr int64_t HNSW_SERIAL_ADD_ROWS = 1000;
+
+// the quantizer type of the codes, an index serialized without it has 8 bits codes
+constexpr const char* HNSW_SQ_TYPE = "HNSW_SQ_TYPE";
+
 BinarySet
 IndexHNSW_SQ8NR::Serialize(const Config& config) {
     if (!index_) {
@@ -41,7 +48,11 @@ IndexHNSW_SQ8NR::Serialize(const Config& config) {
 
         BinarySet res_set;
         res_set.Append("HNSW_SQ8", data, writer.rp);
-        res_set.Append(SQ8_DATA, data_, Dim() * (2 * sizeof(float) + Count()));
+        res_set.Append(SQ8_DATA, data_, index_->sq_->code_size * Count() + Dim() * 2 * sizeof(float));
+
+        std::shared_ptr<uint8_t[]> qtype(new uint8_t[sizeof(int32_t)]);
+        *(int32_t*)qtype.get() = static_cast<int32_t>(index_->sq_->qtype);
+        res_set.Append(HNSW_SQ_TYPE, qtype, sizeof(int32_t));
         return res_set;
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
@@ -63,8 +74,14 @@ IndexHNSW_SQ8NR::Load(const BinarySet& index_binary) {
 
         normalize = (index_->metric_type_ == 1);  // 1 == InnerProduct
 
+        auto qtype = faiss::QuantizerType::QT_8bit;
+        if (index_binary.binary_map_.find(HNSW_SQ_TYPE) != index_binary.binary_map_.end()) {
+            qtype = static_cast<faiss::QuantizerType>(*(int32_t*)index_binary.GetByName(HNSW_SQ_TYPE)->data.get());
+        }
+        faiss::ScalarQuantizer sq(Dim(), qtype);
+
         data_ = index_binary.GetByName(SQ8_DATA)->data;
-        index_->SetSq8((float*)(data_.get() + Dim() * Count()));
+        index_->SetSq8((float*)(data_.get() + sq.code_size * Count()), qtype);
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
     }
@@ -84,8 +101,10 @@ IndexHNSW_SQ8NR::Train(const DatasetPtr& dataset_ptr, const Config& config) {
         }
         index_ = std::make_shared<hnswlib_nm::HierarchicalNSW_NM<float>>(
             space, rows, config[IndexParams::M].get<int64_t>(), config[IndexParams::efConstruction].get<int64_t>());
-        auto data_space = new uint8_t[dim * (rows + 2 * sizeof(float))];
-        index_->sq_train(rows, (const float*)p_data, data_space);
+        auto qtype = GetSQQuantizerType(config);
+        faiss::ScalarQuantizer sq(dim, qtype);
+        auto data_space = new uint8_t[sq.code_size * rows + dim * 2 * sizeof(float)];
+        index_->sq_train(rows, (const float*)p_data, data_space, qtype);
         data_ = std::shared_ptr<uint8_t[]>(data_space);
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
@@ -107,9 +126,13 @@ IndexHNSW_SQ8NR::Add(const DatasetPtr& dataset_ptr, const Config& config) {
 
     auto base = index_->getCurrentElementCount();
     auto pp_data = const_cast<void*>(p_data);
-    index_->addPoint(pp_data, p_ids[0], base, 0);
-#pragma omp parallel for
-    for (int i = 1; i < rows; ++i) {
+    int64_t serial_rows = std::min<int64_t>(rows, HNSW_SERIAL_ADD_ROWS);
+    for (int64_t i = 0; i < serial_rows; ++i) {
+        faiss::BuilderSuspend::check_wait();
+        index_->addPoint(pp_data, p_ids[i], base, i);
+    }
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int64_t i = serial_rows; i < rows; ++i) {
         faiss::BuilderSuspend::check_wait();
         index_->addPoint(pp_data, p_ids[i], base, i);
     }
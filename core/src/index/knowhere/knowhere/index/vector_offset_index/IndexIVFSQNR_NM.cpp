@@ -25,6 +25,7 @@
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "knowhere/index/vector_offset_index/IndexIVFSQNR_NM.h"
 #ifdef MILVUS_GPU_VERSION
@@ -73,6 +74,7 @@ IVFSQNR_NM::Serialize(const Config& config) {
 void
 IVFSQNR_NM::Load(const BinarySet& binary_set) {
     std::lock_guard<std::mutex> lk(mutex_);
+    fingerprint_ = 0;
     data_ = binary_set.GetByName(SQ8_DATA)->data;
     LoadImpl(binary_set, index_type_);
     // arrange sq8 data
@@ -122,9 +124,10 @@ IVFSQNR_NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
     index_ = std::shared_ptr<faiss::Index>(
         new faiss::IndexIVFScalarQuantizer(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
-                                           faiss::QuantizerType::QT_8bit, metric_type, false));
+                                           GetSQQuantizerType(config), metric_type, false));
 
-    index_->train(rows, (float*)p_data);
+    TrainIVF(static_cast<faiss::IndexIVF*>(index_.get()), rows, (float*)p_data, config,
+             GetDatasetCentroids(dataset_ptr));
 }
 
 void
@@ -156,6 +159,10 @@ IVFSQNR_NM::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
 VecIndexPtr
 IVFSQNR_NM::CopyCpuToGpu(const int64_t device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
+    // the 4 and 6 bits quantizers are searched by cpu only
+    if (static_cast<faiss::IndexIVFScalarQuantizer*>(index_.get())->sq.qtype != faiss::QuantizerType::QT_8bit) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpu Error, only the 8 bits scalar quantizer is supported by gpu");
+    }
     if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id)) {
         ResScope rs(res, device_id, false);
 
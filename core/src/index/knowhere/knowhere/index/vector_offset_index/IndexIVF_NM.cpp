@@ -15,6 +15,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexScalarQuantizer.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
@@ -34,6 +35,7 @@
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
 #ifdef MILVUS_GPU_VERSION
@@ -59,6 +61,7 @@ IVF_NM::Serialize(const Config& config) {
 void
 IVF_NM::Load(const BinarySet& binary_set) {
     std::lock_guard<std::mutex> lk(mutex_);
+    fingerprint_ = 0;
     LoadImpl(binary_set, index_type_);
 
     // Construct arranged data from original data
@@ -67,8 +70,18 @@ IVF_NM::Load(const BinarySet& binary_set) {
     auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
     auto invlists = ivf_index->invlists;
     auto d = ivf_index->d;
-    auto nb = (size_t)(binary->size / invlists->code_size);
-    auto arranged_data = new uint8_t[d * sizeof(float) * nb];
+    auto nb = (size_t)(binary->size / (d * sizeof(float)));
+    // float32 storage keeps the raw vectors, float16 / bfloat16 storage encodes them to half precision
+    auto code_size = invlists->code_size;
+    auto sq_index = dynamic_cast<faiss::IndexIVFScalarQuantizer*>(ivf_index);
+    auto copy_code = [&](uint8_t* dst, int64_t id) {
+        if (sq_index != nullptr) {
+            sq_index->sq.compute_codes(original_data + d * id, dst, 1);
+        } else {
+            memcpy(dst, original_data + d * id, code_size);
+        }
+    };
+    auto arranged_data = new uint8_t[code_size * nb];
     prefix_sum.resize(invlists->nlist);
     size_t curr_index = 0;
 
@@ -77,8 +90,7 @@ IVF_NM::Load(const BinarySet& binary_set) {
     for (size_t i = 0; i < invlists->nlist; i++) {
         auto list_size = ails->ids[i].size();
         for (size_t j = 0; j < list_size; j++) {
-            memcpy(arranged_data + d * sizeof(float) * (curr_index + j), original_data + d * ails->ids[i][j],
-                   d * sizeof(float));
+            copy_code(arranged_data + code_size * (curr_index + j), ails->ids[i][j]);
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
@@ -90,14 +102,20 @@ IVF_NM::Load(const BinarySet& binary_set) {
     for (size_t i = 0; i < invlists->nlist; i++) {
         auto list_size = lengths[i];
         for (size_t j = 0; j < list_size; j++) {
-            memcpy(arranged_data + d * sizeof(float) * (curr_index + j), original_data + d * rol_ids[curr_index + j],
-                   d * sizeof(float));
+            copy_code(arranged_data + code_size * (curr_index + j), rol_ids[curr_index + j]);
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
     }
 #endif
     data_ = std::shared_ptr<uint8_t[]>(arranged_data);
+
+    // the ids of a segment index are its row offsets, an array direct map finds the arranged vector of a row
+    try {
+        ivf_index->make_direct_map(true);
+    } catch (faiss::FaissException& e) {
+        ivf_index->make_direct_map(false);
+    }
 }
 
 void
@@ -107,8 +125,24 @@ IVF_NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
     faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
     int64_t nlist = config[IndexParams::nlist].get<int64_t>();
-    index_ = std::shared_ptr<faiss::Index>(new faiss::IndexIVFFlat(coarse_quantizer, dim, nlist, metric_type));
-    index_->train(rows, (float*)p_data);
+    std::string storage_type = StorageType::FLOAT32;
+    if (config.contains(IndexParams::storage_type)) {
+        storage_type = config[IndexParams::storage_type].get<std::string>();
+    }
+
+    if (storage_type == StorageType::FLOAT32) {
+        index_ = std::shared_ptr<faiss::Index>(new faiss::IndexIVFFlat(coarse_quantizer, dim, nlist, metric_type));
+    } else if (storage_type == StorageType::FLOAT16 || storage_type == StorageType::BFLOAT16) {
+        auto qtype =
+            storage_type == StorageType::FLOAT16 ? faiss::QuantizerType::QT_fp16 : faiss::QuantizerType::QT_bf16;
+        index_ = std::shared_ptr<faiss::Index>(
+            new faiss::IndexIVFScalarQuantizer(coarse_quantizer, dim, nlist, qtype, metric_type, false));
+    } else {
+        delete coarse_quantizer;
+        KNOWHERE_THROW_MSG("Invalid storage type: " + storage_type);
+    }
+    TrainIVF(static_cast<faiss::IndexIVF*>(index_.get()), rows, (float*)p_data, config,
+             GetDatasetCentroids(dataset_ptr));
 }
 
 void
@@ -152,7 +186,13 @@ IVF_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
         auto p_id = (int64_t*)malloc(p_id_size);
         auto p_dist = (float*)malloc(p_dist_size);
 
-        QueryImpl(rows, (float*)p_data, k, p_dist, p_id, config);
+        const int64_t* coarse_ids = nullptr;
+        const float* coarse_distances = nullptr;
+        if (GetDatasetCoarseAssign(dataset_ptr, coarse_ids, coarse_distances)) {
+            PreassignedQueryImpl(rows, (float*)p_data, k, p_dist, p_id, config, coarse_ids, coarse_distances);
+        } else {
+            QueryImpl(rows, (float*)p_data, k, p_dist, p_id, config);
+        }
 
         auto ret_ds = std::make_shared<Dataset>();
         ret_ds->Set(meta::IDS, p_id);
@@ -238,6 +278,10 @@ IVF_NM::Seal() {
 VecIndexPtr
 IVF_NM::CopyCpuToGpu(const int64_t device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
+    if (dynamic_cast<faiss::IndexIVFScalarQuantizer*>(index_.get()) != nullptr) {
+        KNOWHERE_THROW_MSG("CopyCpuToGpu Error, half precision storage is only searchable on cpu");
+    }
+
     if (auto res = FaissGpuResourceMgr::GetInstance().GetRes(device_id)) {
         ResScope rs(res, device_id, false);
         auto gpu_index =
@@ -295,7 +339,7 @@ IVF_NM::GenGraph(const float* data, const int64_t k, GraphType& graph, const Con
 std::shared_ptr<faiss::IVFSearchParameters>
 IVF_NM::GenParams(const Config& config) {
     auto params = std::make_shared<faiss::IVFSearchParameters>();
-    params->nprobe = config[IndexParams::nprobe];
+    params->nprobe = GetProbeCount(config);
     // params->max_codes = config["max_codes"];
     return params;
 }
@@ -305,6 +349,7 @@ IVF_NM::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int
     auto params = GenParams(config);
     auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
     ivf_index->nprobe = params->nprobe;
+    ivf_index->prune_lists = IsAdaptiveProbe(config);
     stdclock::time_point before = stdclock::now();
     if (params->nprobe > 1 && n <= 4) {
         ivf_index->parallel_mode = 1;
@@ -324,6 +369,24 @@ IVF_NM::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int
     faiss::indexIVF_stats.search_time = 0;
 }
 
+void
+IVF_NM::PreassignedQueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                             const Config& config, const int64_t* coarse_ids, const float* coarse_distances) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto params = GenParams(config);
+    params->max_codes = ivf_index->max_codes;
+    ivf_index->prune_lists = IsAdaptiveProbe(config);
+    stdclock::time_point before = stdclock::now();
+    ivf_index->parallel_mode = (params->nprobe > 1 && n <= 4) ? 1 : 0;
+    bool is_sq8 = index_type_ == IndexEnum::INDEX_FAISS_IVFSQ8 || index_type_ == IndexEnum::INDEX_FAISS_IVFSQ8NR;
+    ivf_index->search_preassigned_without_codes(n, data, (const uint8_t*)data_.get(), prefix_sum, is_sq8, k,
+                                                coarse_ids, coarse_distances, distances, labels, false, params.get(),
+                                                bitset_);
+    stdclock::time_point after = stdclock::now();
+    double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
+    LOG_KNOWHERE_DEBUG_ << "IVF_NM preassigned search cost: " << search_cost;
+}
+
 void
 IVF_NM::SealImpl() {
 #ifdef MILVUS_GPU_VERSION
@@ -335,6 +398,40 @@ IVF_NM::SealImpl() {
 #endif
 }
 
+uint64_t
+IVF_NM::CentroidsFingerprint() {
+    auto fingerprint = fingerprint_.load();
+    if (fingerprint == 0) {
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+        if (ivf_index != nullptr) {
+            fingerprint = GetIVFCentroidsFingerprint(ivf_index);
+            fingerprint_ = fingerprint;
+        }
+    }
+    return fingerprint;
+}
+
+bool
+IVF_NM::GetRawVectors(const int64_t* offsets, int64_t n, float* vectors) {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (data_ == nullptr || ivf_index == nullptr || ivf_index->direct_map.type != faiss::DirectMap::Array ||
+        dynamic_cast<faiss::IndexIVFScalarQuantizer*>(ivf_index) != nullptr) {
+        return false;
+    }
+
+    auto d = ivf_index->d;
+    auto& array = ivf_index->direct_map.array;
+    for (int64_t i = 0; i < n; ++i) {
+        if (offsets[i] < 0 || offsets[i] >= static_cast<int64_t>(array.size()) || array[offsets[i]] < 0) {
+            return false;
+        }
+        auto lo = array[offsets[i]];
+        auto arranged = prefix_sum[faiss::lo_listno(lo)] + faiss::lo_offset(lo);
+        memcpy(vectors + d * i, data_.get() + arranged * d * sizeof(float), d * sizeof(float));
+    }
+    return true;
+}
+
 int64_t
 IVF_NM::Count() {
     if (!index_) {
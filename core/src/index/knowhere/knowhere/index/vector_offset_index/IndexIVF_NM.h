@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -78,6 +79,15 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     virtual void
     GenGraph(const float* data, const int64_t k, GraphType& graph, const Config& config);
 
+    // Copies the raw vectors of the rows at the offsets, found through the direct map made by Load. Returns false
+    // when the index keeps no exact copy of them, with a half precision storage, or an offset is not in the index.
+    bool
+    GetRawVectors(const int64_t* offsets, int64_t n, float* vectors);
+
+    // GetIVFCentroidsFingerprint of the index, computed by the first call after the index is loaded
+    uint64_t
+    CentroidsFingerprint();
+
  protected:
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config&);
@@ -85,6 +95,12 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     virtual void
     QueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&);
 
+    // QueryImpl probing the lists of the given nq * nprobe coarse assignment instead of searching the coarse
+    // quantizer, the assignment has to come from centroids with the same fingerprint
+    void
+    PreassignedQueryImpl(int64_t, const float*, int64_t, float*, int64_t*, const Config&, const int64_t* coarse_ids,
+                         const float* coarse_distances);
+
     void
     SealImpl() override;
 
@@ -92,6 +108,7 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     std::mutex mutex_;
     std::shared_ptr<uint8_t[]> data_ = nullptr;
     std::vector<size_t> prefix_sum;
+    std::atomic<uint64_t> fingerprint_{0};
 };
 
 using IVFNMPtr = std::shared_ptr<IVF_NM>;
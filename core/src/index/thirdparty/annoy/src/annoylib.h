@@ -836,6 +836,8 @@ class AnnoyIndexInterface {
   virtual void unload() = 0;
   virtual bool load(const char* filename, bool prefault=false, char** error=nullptr) = 0;
   virtual bool load_index(void* index_data, const int64_t& index_size, char** error = nullptr) = 0;
+  // uses the nodes in place instead of a copy, the caller keeps them alive until the index is unloaded
+  virtual bool load_index_in_place(void* index_data, const int64_t& index_size, char** error = nullptr) = 0;
   virtual T get_distance(S i, S j) const = 0;
   virtual void get_nns_by_item(S item, size_t n, int64_t search_k, vector<S>* result, vector<T>* distances,
                                faiss::ConcurrentBitsetPtr& bitset = nullptr) const = 0;
@@ -880,6 +882,7 @@ protected:
   int _fd;
   bool _on_disk;
   bool _built;
+  bool _in_place; // _nodes are owned by the caller of load_index_in_place
 public:
 
    AnnoyIndex(int f) : _f(f), _random() {
@@ -962,20 +965,37 @@ public:
     D::template preprocess<T, S, Node>(_nodes, _s, _n_items, _f);
 
     _n_nodes = _n_items;
-    while (1) {
-      if (q == -1 && _n_nodes >= _n_items * 2)
-        break;
-      if (q != -1 && _roots.size() >= (size_t)q)
-        break;
-      if (_verbose) showUpdate("pass %zd...\n", _roots.size());
+    vector<S> indices;
+    for (S i = 0; i < _n_items; i++) {
+      if (_get(i)->n_descendants >= 1) // Issue #223
+        indices.push_back(i);
+    }
 
-      vector<S> indices;
-      for (S i = 0; i < _n_items; i++) {
-        if (_get(i)->n_descendants >= 1) // Issue #223
-          indices.push_back(i);
+    if (q == -1) {
+      while (_n_nodes < _n_items * 2) {
+        if (_verbose) showUpdate("pass %zd...\n", _roots.size());
+        vector<uint8_t> tree_nodes;
+        S root = _make_tree(indices, true, _random, tree_nodes);
+        _roots.push_back(_append_tree(tree_nodes, root));
+      }
+    } else {
+      // The trees are independent, they are built in parallel into nodes of their own and appended in order once
+      // all are built. Each tree has its own random generator seeded in order, so the forest does not depend on the
+      // number of threads.
+      vector<uint64_t> seeds(q);
+      for (auto& seed : seeds)
+        seed = _random.kiss();
+      vector<vector<uint8_t> > trees(q);
+      vector<S> roots(q);
+#pragma omp parallel for schedule(dynamic, 1)
+      for (int t = 0; t < q; t++) {
+        Random random(seeds[t]);
+        roots[t] = _make_tree(indices, true, random, trees[t]);
+      }
+      for (int t = 0; t < q; t++) {
+        _roots.push_back(_append_tree(trees[t], roots[t]));
+        vector<uint8_t>().swap(trees[t]);
       }
-
-      _roots.push_back(_make_tree(indices, true));
     }
 
     // Also, copy the roots into the last segment of the array
@@ -1053,6 +1073,7 @@ public:
     _n_nodes = 0;
     _nodes_size = 0;
     _on_disk = false;
+    _in_place = false;
     _roots.clear();
   }
 
@@ -1065,7 +1086,7 @@ public:
         // we have mmapped data
         close(_fd);
         munmap(_nodes, _n_nodes * _s);
-      } else if (_nodes) {
+      } else if (_nodes && !_in_place) {
         // We have heap allocated data
         free(_nodes);
       }
@@ -1128,47 +1149,11 @@ public:
   }
 
   bool load_index(void* index_data, const int64_t& index_size, char** error) {
-    if (index_size == -1) {
-      set_error_from_errno(error, "Unable to get size");
-      return false;
-    } else if (index_size == 0) {
-      set_error_from_errno(error, "Size of file is zero");
-      return false;
-    } else if (index_size % _s) {
-      // Something is fishy with this index!
-      set_error_from_errno(error, "Index size is not a multiple of vector size");
-      return false;
-    }
-
-    _n_nodes = (S)(index_size / _s);
-//    _nodes = (Node*)malloc(_s * _n_nodes);
-    _nodes = (Node*)malloc((size_t)index_size);
-    if (_nodes == nullptr) {
-        set_error_from_errno(error, "alloc failed when load_index 4 annoy");
-        return false;
-    }
-    memcpy(_nodes, index_data, (size_t)index_size);
+    return _load_nodes(index_data, index_size, false, error);
+  }
 
-    // Find the roots by scanning the end of the file and taking the nodes with most descendants
-    _roots.clear();
-    S m = -1;
-    for (S i = _n_nodes - 1; i >= 0; i--) {
-      S k = _get(i)->n_descendants;
-      if (m == -1 || k == m) {
-        _roots.push_back(i);
-        m = k;
-      } else {
-        break;
-      }
-    }
-    // hacky fix: since the last root precedes the copy of all roots, delete it
-    if (_roots.size() > 1 && _get(_roots.front())->children[0] == _get(_roots.back())->children[0])
-      _roots.pop_back();
-    _loaded = true;
-    _built = true;
-    _n_items = m;
-    if (_verbose) showUpdate("found %lu roots with degree %ld\n", _roots.size(), m);
-    return true;
+  bool load_index_in_place(void* index_data, const int64_t& index_size, char** error) {
+    return _load_nodes(index_data, index_size, true, error);
   }
 
   T get_distance(S i, S j) const {
@@ -1222,6 +1207,55 @@ public:
   }
 
 protected:
+  bool _load_nodes(void* index_data, const int64_t& index_size, bool in_place, char** error) {
+    if (index_size == -1) {
+      set_error_from_errno(error, "Unable to get size");
+      return false;
+    } else if (index_size == 0) {
+      set_error_from_errno(error, "Size of file is zero");
+      return false;
+    } else if (index_size % _s) {
+      // Something is fishy with this index!
+      set_error_from_errno(error, "Index size is not a multiple of vector size");
+      return false;
+    }
+
+    _n_nodes = (S)(index_size / _s);
+    if (in_place) {
+      _nodes = index_data;
+      _in_place = true;
+    } else {
+//      _nodes = (Node*)malloc(_s * _n_nodes);
+      _nodes = (Node*)malloc((size_t)index_size);
+      if (_nodes == nullptr) {
+          set_error_from_errno(error, "alloc failed when load_index 4 annoy");
+          return false;
+      }
+      memcpy(_nodes, index_data, (size_t)index_size);
+    }
+
+    // Find the roots by scanning the end of the file and taking the nodes with most descendants
+    _roots.clear();
+    S m = -1;
+    for (S i = _n_nodes - 1; i >= 0; i--) {
+      S k = _get(i)->n_descendants;
+      if (m == -1 || k == m) {
+        _roots.push_back(i);
+        m = k;
+      } else {
+        break;
+      }
+    }
+    // hacky fix: since the last root precedes the copy of all roots, delete it
+    if (_roots.size() > 1 && _get(_roots.front())->children[0] == _get(_roots.back())->children[0])
+      _roots.pop_back();
+    _loaded = true;
+    _built = true;
+    _n_items = m;
+    if (_verbose) showUpdate("found %lu roots with degree %ld\n", _roots.size(), m);
+    return true;
+  }
+
   void _allocate_size(S n) {
     if (n > _nodes_size) {
       const double reallocation_factor = 1.3;
@@ -1246,7 +1280,29 @@ protected:
     return get_node_ptr<S, Node>(_nodes, _s, i);
   }
 
-  S _make_tree(const vector<S >& indices, bool is_root) {
+  // Appends the nodes of a tree built by _make_tree to the index, renumbering its nodes, and returns its root.
+  S _append_tree(const vector<uint8_t>& tree_nodes, S root) {
+    S n = (S)(tree_nodes.size() / _s);
+    S base = _n_nodes;
+    _allocate_size(_n_nodes + n);
+    if (n > 0)
+      memcpy(_get(base), tree_nodes.data(), tree_nodes.size());
+    _n_nodes += n;
+    for (S i = base; i < base + n; i++) {
+      Node* m = _get(i);
+      if (m->n_descendants > _K) { // split node, its children are items or nodes of the tree
+        for (int side = 0; side < 2; side++) {
+          if (m->children[side] >= _n_items)
+            m->children[side] += base - _n_items;
+        }
+      }
+    }
+    return root >= _n_items ? root + base - _n_items : root;
+  }
+
+  // Builds a tree into nodes of its own, node i of tree_nodes being numbered _n_items + i, so that trees can be built
+  // in parallel while the items are read only. _append_tree adds it to the index.
+  S _make_tree(const vector<S >& indices, bool is_root, Random& random, vector<uint8_t>& tree_nodes) {
     // The basic rule is that if we have <= _K items, then it's a leaf node, otherwise it's a split node.
     // There's some regrettable complications caused by the problem that root nodes have to be "special":
     // 1. We identify root nodes by the arguable logic that _n_items == n->n_descendants, regardless of how many descendants they actually have
@@ -1256,9 +1312,9 @@ protected:
       return indices[0];
 
     if (indices.size() <= (size_t)_K && (!is_root || (size_t)_n_items <= (size_t)_K || indices.size() == 1)) {
-      _allocate_size(_n_nodes + 1);
-      S item = _n_nodes++;
-      Node* m = _get(item);
+      S item = _n_items + (S)(tree_nodes.size() / _s);
+      tree_nodes.resize(tree_nodes.size() + _s, 0);
+      Node* m = (Node*)(tree_nodes.data() + tree_nodes.size() - _s);
       m->n_descendants = is_root ? _n_items : (S)indices.size();
 
       // Using std::copy instead of a loop seems to resolve issues #3 and #13,
@@ -1280,14 +1336,15 @@ protected:
 
     vector<S> children_indices[2];
     Node* m = (Node*)alloca(_s);
-    D::create_split(children, _f, _s, _random, m);
+    memset(m, 0, _s); // the padding is copied to the index too, which is then the same whatever the threads
+    D::create_split(children, _f, _s, random, m);
     faiss::BuilderSuspend::check_wait();
 
     for (size_t i = 0; i < indices.size(); i++) {
       S j = indices[i];
       Node* n = _get(j);
       if (n) {
-        bool side = D::side(m, n->v, _f, _random);
+        bool side = D::side(m, n->v, _f, random);
         children_indices[side].push_back(j);
       } else {
         showUpdate("No node for index %ld?\n", j);
@@ -1312,7 +1369,7 @@ protected:
       for (size_t i = 0; i < indices.size(); i++) {
         S j = indices[i];
         // Just randomize...
-        children_indices[_random.flip()].push_back(j);
+        children_indices[random.flip()].push_back(j);
       }
     }
 
@@ -1322,12 +1379,11 @@ protected:
     for (int side = 0; side < 2; side++) {
       // run _make_tree for the smallest child first (for cache locality)
       faiss::BuilderSuspend::check_wait();
-      m->children[side^flip] = _make_tree(children_indices[side^flip], false);
+      m->children[side^flip] = _make_tree(children_indices[side^flip], false, random, tree_nodes);
     }
 
-    _allocate_size(_n_nodes + 1);
-    S item = _n_nodes++;
-    memcpy(_get(item), m, _s);
+    S item = _n_items + (S)(tree_nodes.size() / _s);
+    tree_nodes.insert(tree_nodes.end(), (uint8_t*)m, (uint8_t*)m + _s);
 
     return item;
   }
@@ -1339,23 +1395,29 @@ protected:
     memcpy(v_node->v, v, sizeof(T) * _f);
     D::init_node(v_node, _f);
 
-    std::priority_queue<pair<T, S> > q;
+    // the scratch of the search is kept per thread, a batch of queries reuses it instead of allocating it per query
+    static thread_local vector<pair<T, S> > q;
+    static thread_local vector<S> nns;
+    static thread_local vector<pair<T, S> > nns_dist;
+    q.clear();
+    nns.clear();
+    nns_dist.clear();
 
     if (search_k <= 0) {
       search_k = std::max(int64_t(n * _roots.size()), int64_t(_n_items * 5 / 100));
     }
 
     for (size_t i = 0; i < _roots.size(); i++) {
-      q.push(make_pair(Distance::template pq_initial_value<T>(), _roots[i]));
+      q.push_back(make_pair(Distance::template pq_initial_value<T>(), _roots[i]));
+      std::push_heap(q.begin(), q.end());
     }
 
-    std::vector<S> nns;
     while (nns.size() < (size_t)search_k && !q.empty()) {
-      const pair<T, S>& top = q.top();
-      T d = top.first;
-      S i = top.second;
+      std::pop_heap(q.begin(), q.end());
+      T d = q.back().first;
+      S i = q.back().second;
       Node* nd = _get(i);
-      q.pop();
+      q.pop_back();
       if (nd->n_descendants == 1 && i < _n_items) { // raw data
         if (bitset == nullptr || !bitset->test((faiss::ConcurrentBitset::id_type_t)i))
           nns.push_back(i);
@@ -1368,15 +1430,16 @@ protected:
         }
       } else {
         T margin = D::margin(nd, v, _f);
-        q.push(make_pair(D::pq_distance(d, margin, 1), static_cast<S>(nd->children[1])));
-        q.push(make_pair(D::pq_distance(d, margin, 0), static_cast<S>(nd->children[0])));
+        q.push_back(make_pair(D::pq_distance(d, margin, 1), static_cast<S>(nd->children[1])));
+        std::push_heap(q.begin(), q.end());
+        q.push_back(make_pair(D::pq_distance(d, margin, 0), static_cast<S>(nd->children[0])));
+        std::push_heap(q.begin(), q.end());
       }
     }
 
     // Get distances for all items
     // To avoid calculating distance multiple times for any items, sort by id
     std::sort(nns.begin(), nns.end());
-    vector<pair<T, S> > nns_dist;
     S last = -1;
     for (size_t i = 0; i < nns.size(); i++) {
       S j = nns[i];
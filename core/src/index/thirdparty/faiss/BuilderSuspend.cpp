@@ -11,9 +11,28 @@
 
 #include "BuilderSuspend.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 namespace faiss {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// a throttled builder runs this long before it sleeps
+constexpr auto THROTTLE_PERIOD = std::chrono::milliseconds(10);
+
+// a thread silent for longer has left the build, its next check starts a new period
+constexpr auto MAX_CHECK_GAP = std::chrono::seconds(1);
+
+constexpr auto MAX_SLEEP = std::chrono::milliseconds(500);
+
+}  // namespace
+
 std::atomic<bool> BuilderSuspend::suspend_flag_(false);
+std::atomic<double> BuilderSuspend::share_(1.0);
 std::mutex BuilderSuspend::mutex_;
 std::condition_variable BuilderSuspend::cv_;
 
@@ -25,11 +44,46 @@ void BuilderSuspend::resume() {
     suspend_flag_ = false;
 }
 
+void BuilderSuspend::set_share(double share) {
+    share_ = std::min(std::max(share, 0.01), 1.0);
+}
+
+double BuilderSuspend::share() {
+    return share_;
+}
+
 void BuilderSuspend::check_wait() {
     while (suspend_flag_) {
         std::unique_lock<std::mutex> lck(mutex_);
         cv_.wait_for(lck, std::chrono::seconds(5));
     }
+
+    thread_local bool throttled = false;
+    thread_local Clock::time_point period_begin;
+    thread_local Clock::time_point last_check;
+
+    double share = share_.load(std::memory_order_relaxed);
+    if (share >= 1.0) {
+        throttled = false;
+        return;
+    }
+
+    auto now = Clock::now();
+    if (!throttled || now - last_check > MAX_CHECK_GAP) {
+        throttled = true;
+        period_begin = last_check = now;
+        return;
+    }
+    last_check = now;
+
+    auto busy = now - period_begin;
+    if (busy < THROTTLE_PERIOD) {
+        return;
+    }
+
+    auto idle = std::chrono::duration_cast<Clock::duration>(busy * ((1.0 - share) / share));
+    std::this_thread::sleep_for(std::min<Clock::duration>(idle, MAX_SLEEP));
+    period_begin = last_check = Clock::now();
 }
 
 }  // namespace faiss
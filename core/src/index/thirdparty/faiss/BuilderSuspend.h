@@ -17,14 +17,22 @@
 
 namespace faiss {
 
+/*
+ * The index builders call check_wait() regularly. suspend() stops them at the next check,
+ * set_share() lets them keep running for only a share of the time: a builder thread sleeps at
+ * its checks so that it runs `share` of every period, like a cpu quota.
+ */
 class BuilderSuspend {
 public:
     static void suspend();
     static void resume();
+    static void set_share(double share);
+    static double share();
     static void check_wait();
 
 private:
     static std::atomic<bool> suspend_flag_;
+    static std::atomic<double> share_;
     static std::mutex mutex_;
     static std::condition_variable cv_;
 
@@ -10,9 +10,11 @@
 #include <faiss/Clustering.h>
 #include <faiss/impl/AuxIndexStructures.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 
 #include <omp.h>
 
@@ -510,6 +512,414 @@ void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
 
 }
 
+/***************************************************************
+ * MiniBatchClustering
+ ***************************************************************/
+
+MiniBatchClustering::MiniBatchClustering (int d, int k, size_t batch_size):
+    Clustering (d, k), batch_size (batch_size) {}
+
+MiniBatchClustering::MiniBatchClustering (int d, int k, size_t batch_size,
+                                          const ClusteringParameters &cp):
+    Clustering (d, k, cp), batch_size (batch_size) {}
+
+void MiniBatchClustering::train (idx_t nx, const float *x, Index & index,
+                                 const float *weights) {
+
+    FAISS_THROW_IF_NOT_FMT (nx >= k,
+             "Number of training points (%ld) should be at least "
+             "as large as number of clusters (%ld)", nx, k);
+
+    FAISS_THROW_IF_NOT_FMT (index.d == d,
+            "Index dimension %d not the same as data dimension %d",
+            int(index.d), int(d));
+
+    FAISS_THROW_IF_NOT (batch_size > 0);
+
+    if (batch_size >= nx) {
+        // a batch would hold the whole training set
+        Clustering::train (nx, x, index, weights);
+        return;
+    }
+
+    if (verbose) {
+        printf("Mini-batch clustering %ld points in %ldD to %ld clusters, "
+               "%d batches of %ld points\n",
+               nx, d, k, niter, batch_size);
+    }
+
+    double t0 = getmillisecs();
+
+    // initialize the centroids with random points from the dataset
+    centroids.resize (d * k);
+    {
+        std::vector<int> perm (nx);
+        rand_perm (perm.data(), nx, seed + 1);
+        for (size_t i = 0; i < k; i++) {
+            memcpy (&centroids[i * d], x + perm[i] * d, sizeof(float) * d);
+        }
+    }
+    post_process_centroids ();
+
+    if (index.ntotal != 0) {
+        index.reset();
+    }
+    if (!index.is_trained) {
+        index.train (k, centroids.data());
+    }
+    index.add (k, centroids.data());
+
+    RandomGenerator rng (seed);
+    std::vector<idx_t> batch (batch_size);
+    std::vector<float> xb (batch_size * d);
+    std::unique_ptr<idx_t []> assign (new idx_t[batch_size]);
+    std::unique_ptr<float []> dis (new float[batch_size]);
+
+    // nb of points (or total weight) each centroid received so far
+    std::vector<float> counts (k, 0);
+    double t_search_tot = 0;
+
+    for (int i = 0; i < niter; i++) {
+        for (size_t j = 0; j < batch_size; j++) {
+            batch[j] = (uint64_t)rng.rand_int64 () % nx;
+            memcpy (xb.data() + j * d, x + batch[j] * d, sizeof(float) * d);
+        }
+
+        double t0s = getmillisecs();
+        index.assign (batch_size, xb.data(), assign.get(), dis.get());
+        InterruptCallback::check();
+        t_search_tot += getmillisecs() - t0s;
+
+        float err = 0;
+        for (size_t j = 0; j < batch_size; j++) {
+            err += dis[j];
+        }
+
+        // each thread moves its own range of centroids, visiting the
+        // points in batch order so that the result does not depend on
+        // the nb of threads
+#pragma omp parallel
+        {
+            int nt = omp_get_num_threads();
+            int rank = omp_get_thread_num();
+            size_t c0 = (k * rank) / nt;
+            size_t c1 = (k * (rank + 1)) / nt;
+
+            for (size_t j = 0; j < batch_size; j++) {
+                size_t ci = assign[j];
+                if (ci < c0 || ci >= c1) {
+                    continue;
+                }
+                float w = weights ? weights[batch[j]] : 1.0;
+                counts[ci] += w;
+                if (counts[ci] == 0) {
+                    continue;
+                }
+                float eta = w / counts[ci];
+                float * c = centroids.data() + ci * d;
+                const float * xj = xb.data() + j * d;
+                for (size_t l = 0; l < d; l++) {
+                    c[l] += eta * (xj[l] - c[l]);
+                }
+            }
+        }
+
+        ClusteringIterationStats stats =
+            { err, (getmillisecs() - t0) / 1000.0,
+              t_search_tot / 1000,
+              imbalance_factor (batch_size, k, assign.get()), 0 };
+        iteration_stats.push_back(stats);
+
+        if (verbose) {
+            printf ("  Iteration %d (%.2f s, search %.2f s): "
+                    "objective=%g imbalance=%.3f       \r",
+                    i, stats.time, stats.time_search, stats.obj,
+                    stats.imbalance_factor);
+            fflush (stdout);
+        }
+
+        post_process_centroids ();
+
+        index.reset ();
+        if (update_index) {
+            index.train (k, centroids.data());
+        }
+        index.add (k, centroids.data());
+        InterruptCallback::check ();
+    }
+
+    if (verbose) printf("\n");
+}
+
+/***************************************************************
+ * HierarchicalClustering
+ ***************************************************************/
+
+HierarchicalClustering::HierarchicalClustering (int d, int k):
+    Clustering (d, k), k1 (0) {}
+
+HierarchicalClustering::HierarchicalClustering (int d, int k,
+                                                const ClusteringParameters &cp):
+    Clustering (d, k, cp), k1 (0) {}
+
+void HierarchicalClustering::train (idx_t nx, const float *x_in, Index & index,
+                                    const float *weights) {
+
+    FAISS_THROW_IF_NOT_FMT (nx >= k,
+             "Number of training points (%ld) should be at least "
+             "as large as number of clusters (%ld)", nx, k);
+
+    FAISS_THROW_IF_NOT_FMT (index.d == d,
+            "Index dimension %d not the same as data dimension %d",
+            int(index.d), int(d));
+
+    FAISS_THROW_IF_NOT_MSG (!weights,
+            "weights are not supported by the two-level clustering");
+
+    size_t nc1 = k1 > 0 ? k1 : (size_t)sqrt ((double)k);
+    if (nc1 <= 1 || nc1 >= k) {
+        Clustering::train (nx, x_in, index, weights);
+        return;
+    }
+
+    double t0 = getmillisecs();
+
+    const float *x = x_in;
+    std::unique_ptr<uint8_t []> del1;
+    if (nx > k * max_points_per_centroid) {
+        uint8_t *x_new;
+        float *weights_new;
+        nx = subsample_training_set (*this, nx,
+                                     reinterpret_cast<const uint8_t *>(x_in),
+                                     sizeof(float) * d, nullptr,
+                                     &x_new, &weights_new);
+        del1.reset (x_new);
+        x = reinterpret_cast<const float *>(x_new);
+    }
+
+    if (verbose) {
+        printf("Two-level clustering %ld points in %ldD to %ld clusters, "
+               "%ld first level clusters\n", nx, d, k, nc1);
+    }
+
+    // first level, on the whole training set
+    const ClusteringParameters &cp = *this;
+    IndexFlat assigner1 (d, index.metric_type);
+    Clustering clus1 (d, nc1, cp);
+    clus1.train (nx, x, assigner1);
+
+    std::vector<idx_t> assign1 (nx);
+    std::vector<float> dis1 (nx);
+    assigner1.assign (nx, x, assign1.data(), dis1.data());
+
+    std::vector<std::vector<idx_t>> members (nc1);
+    for (idx_t i = 0; i < nx; i++) {
+        members[assign1[i]].push_back (i);
+    }
+
+    // second level centroids of each cluster, proportional to its size
+    std::vector<size_t> nc2 (nc1);
+    size_t total = 0;
+    for (size_t c = 0; c < nc1; c++) {
+        nc2[c] = std::min (members[c].size(),
+                           (size_t)(k * members[c].size() / nx));
+        total += nc2[c];
+    }
+    // the rounded off ones go to the clusters with the most points per centroid
+    while (total < k) {
+        size_t best = nc1;
+        double best_ratio = -1;
+        for (size_t c = 0; c < nc1; c++) {
+            if (nc2[c] < members[c].size()) {
+                double ratio = members[c].size() / (nc2[c] + 1.0);
+                if (ratio > best_ratio) {
+                    best_ratio = ratio;
+                    best = c;
+                }
+            }
+        }
+        nc2[best]++;
+        total++;
+    }
+
+    // second level, each cluster on its own
+    centroids.resize (d * k);
+    std::vector<float> xc;
+    size_t c0 = 0;
+    float err = 0;
+    for (size_t c = 0; c < nc1; c++) {
+        if (nc2[c] == 0) {
+            continue;
+        }
+        size_t nc = members[c].size();
+        xc.resize (nc * d);
+        for (size_t i = 0; i < nc; i++) {
+            memcpy (xc.data() + i * d, x + members[c][i] * d,
+                    sizeof(float) * d);
+        }
+
+        ClusteringParameters cp2 = cp;
+        cp2.verbose = false;
+        IndexFlat assigner2 (d, index.metric_type);
+        Clustering clus2 (d, nc2[c], cp2);
+        clus2.train (nc, xc.data(), assigner2);
+
+        memcpy (centroids.data() + c0 * d, clus2.centroids.data(),
+                sizeof(float) * d * nc2[c]);
+        err += clus2.iteration_stats.back().obj;
+        c0 += nc2[c];
+        InterruptCallback::check ();
+    }
+
+    // a single summary iteration, with the imbalance of the first level
+    ClusteringIterationStats stats =
+        { err, (getmillisecs() - t0) / 1000.0, 0.0,
+          imbalance_factor (nx, nc1, assign1.data()), 0 };
+    iteration_stats.push_back (stats);
+
+    if (verbose) {
+        printf ("  Done (%.2f s): objective=%g first level imbalance=%.3f\n",
+                stats.time, stats.obj, stats.imbalance_factor);
+    }
+
+    post_process_centroids ();
+
+    if (index.ntotal != 0) {
+        index.reset();
+    }
+    if (!index.is_trained) {
+        index.train (k, centroids.data());
+    }
+    index.add (k, centroids.data());
+}
+
+/***************************************************************
+ * BalancedClustering
+ ***************************************************************/
+
+BalancedClustering::BalancedClustering (int d, int k):
+    Clustering (d, k), max_size_ratio (2.0), balance_niter (10) {}
+
+BalancedClustering::BalancedClustering (int d, int k,
+                                        const ClusteringParameters &cp):
+    Clustering (d, k, cp), max_size_ratio (2.0), balance_niter (10) {}
+
+void BalancedClustering::train (idx_t nx, const float *x_in, Index & index,
+                                const float *weights) {
+
+    FAISS_THROW_IF_NOT_MSG (!weights,
+            "weights are not supported by the balanced clustering");
+    FAISS_THROW_IF_NOT (max_size_ratio > 1);
+
+    // the sizes are measured on the points the k-means is trained on
+    const float *x = x_in;
+    std::unique_ptr<uint8_t []> del1;
+    if (nx > k * max_points_per_centroid) {
+        uint8_t *x_new;
+        float *weights_new;
+        nx = subsample_training_set (*this, nx,
+                                     reinterpret_cast<const uint8_t *>(x_in),
+                                     sizeof(float) * d, nullptr,
+                                     &x_new, &weights_new);
+        del1.reset (x_new);
+        x = reinterpret_cast<const float *>(x_new);
+    }
+
+    Clustering::train (nx, x, index);
+
+    double t0 = getmillisecs();
+    size_t mean_size = nx / k;
+    size_t max_size = std::max ((size_t)2, (size_t)(max_size_ratio * nx / k));
+
+    if (verbose) {
+        printf("Balancing %ld clusters of %ld points, at most %ld points "
+               "per cluster\n", k, nx, max_size);
+    }
+
+    ClusteringParameters cp2 = *this;
+    cp2.verbose = false;
+    cp2.min_points_per_centroid = 1;
+
+    std::vector<idx_t> assign (nx);
+    std::vector<float> dis (nx);
+    std::vector<float> xc;
+    int nsplit = 0;
+    for (int iter = 0; ; iter++) {
+        index.assign (nx, x, assign.data(), dis.data());
+        InterruptCallback::check ();
+        if (iter == balance_niter) {
+            break;
+        }
+
+        std::vector<std::vector<idx_t>> members (k);
+        for (idx_t i = 0; i < nx; i++) {
+            members[assign[i]].push_back (i);
+        }
+        std::vector<idx_t> order (k);
+        for (size_t c = 0; c < k; c++) {
+            order[c] = c;
+        }
+        std::sort (order.begin(), order.end(), [&](idx_t a, idx_t b) {
+            return members[a].size() < members[b].size();
+        });
+
+        // the largest clusters are paired with the smallest ones
+        int round_nsplit = 0;
+        for (size_t lo = 0, hi = k; lo + 1 < hi; lo++, hi--) {
+            idx_t big = order[hi - 1];
+            idx_t small = order[lo];
+            if (members[big].size() <= max_size ||
+                members[small].size() >= mean_size) {
+                break;
+            }
+
+            size_t nc = members[big].size();
+            xc.resize (nc * d);
+            for (size_t i = 0; i < nc; i++) {
+                memcpy (xc.data() + i * d, x + members[big][i] * d,
+                        sizeof(float) * d);
+            }
+            IndexFlat assigner2 (d, index.metric_type);
+            Clustering clus2 (d, 2, cp2);
+            clus2.train (nc, xc.data(), assigner2);
+
+            memcpy (centroids.data() + big * d, clus2.centroids.data(),
+                    sizeof(float) * d);
+            memcpy (centroids.data() + small * d, clus2.centroids.data() + d,
+                    sizeof(float) * d);
+            round_nsplit++;
+        }
+        if (round_nsplit == 0) {
+            break;
+        }
+        nsplit += round_nsplit;
+
+        post_process_centroids ();
+        index.reset ();
+        if (update_index) {
+            index.train (k, centroids.data());
+        }
+        index.add (k, centroids.data());
+    }
+
+    // a summary iteration, with the imbalance of the balanced clusters
+    float err = 0;
+    for (idx_t i = 0; i < nx; i++) {
+        err += dis[i];
+    }
+    ClusteringIterationStats stats =
+        { err, (getmillisecs() - t0) / 1000.0, 0.0,
+          imbalance_factor (nx, k, assign.data()), nsplit };
+    iteration_stats.push_back (stats);
+
+    if (verbose) {
+        printf ("  Balanced (%.2f s): %d splits, objective=%g "
+                "imbalance=%.3f\n",
+                stats.time, nsplit, stats.obj, stats.imbalance_factor);
+    }
+}
+
+
 float kmeans_clustering (size_t d, size_t n, size_t k,
                          const float *x,
                          float *centroids)
@@ -108,6 +108,66 @@ struct Clustering: ClusteringParameters {
 };
 
 
+/** Mini-batch k-means (Sculley, "Web-scale k-means clustering").
+ *
+ * Each of the niter iterations assigns a random batch of batch_size
+ * training points only, and moves every centroid towards the points
+ * assigned to it with a learning rate of 1 / (nb of points it got so
+ * far). An iteration costs batch_size instead of n assignments.
+ */
+struct MiniBatchClustering: Clustering {
+    size_t batch_size;     ///< nb of training points per iteration
+
+    MiniBatchClustering (int d, int k, size_t batch_size);
+
+    MiniBatchClustering (int d, int k, size_t batch_size,
+                         const ClusteringParameters &cp);
+
+    void train (idx_t n, const float * x, faiss::Index & index,
+                const float *x_weights = nullptr) override;
+};
+
+/** Two-level k-means, for a large number of centroids.
+ *
+ * The training set is clustered to k1 centroids first, then the points
+ * of each first level cluster are clustered on their own, to a number
+ * of centroids proportional to the size of the cluster. With k1 =
+ * sqrt(k), an assignment costs about 2 sqrt(k) distances instead of k.
+ */
+struct HierarchicalClustering: Clustering {
+    size_t k1;             ///< nb of first level clusters, sqrt(k) if 0
+
+    HierarchicalClustering (int d, int k);
+
+    HierarchicalClustering (int d, int k, const ClusteringParameters &cp);
+
+    void train (idx_t n, const float * x, faiss::Index & index,
+                const float *x_weights = nullptr) override;
+};
+
+
+/** K-means with bounded cluster sizes.
+ *
+ * The training set is clustered by k-means first. Then, as long as a
+ * cluster holds more than max_size_ratio times the mean nb of points,
+ * it is split in two by a 2-means on its own points. The second half
+ * takes the centroid of one of the smallest clusters, whose points go
+ * to their next nearest centroids. At most balance_niter rounds of
+ * splits are done, each one after a full assignment.
+ */
+struct BalancedClustering: Clustering {
+    float max_size_ratio;  ///< max cluster size, relative to the mean size
+    int balance_niter;     ///< max nb of split rounds
+
+    BalancedClustering (int d, int k);
+
+    BalancedClustering (int d, int k, const ClusteringParameters &cp);
+
+    void train (idx_t n, const float * x, faiss::Index & index,
+                const float *x_weights = nullptr) override;
+};
+
+
 /** simplified interface
  *
  * @param d dimension of the data
@@ -9,9 +9,15 @@
 #include <faiss/impl/ScalarQuantizerDC.h>
 #include <faiss/impl/ScalarQuantizerDC_avx.h>
 #include <faiss/impl/ScalarQuantizerDC_avx512.h>
+#include <faiss/impl/ScalarQuantizerDC_neon.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/utils/binary_distances_avx512.h>
+#include <faiss/utils/binary_distances_neon.h>
 #include <faiss/utils/distances.h>
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
+#include <faiss/utils/distances_neon.h>
 #include <faiss/utils/instruction_set.h>
 
 namespace faiss {
@@ -19,19 +25,64 @@ namespace faiss {
 bool faiss_use_avx512 = true;
 bool faiss_use_avx2 = true;
 bool faiss_use_sse = true;
+bool faiss_use_neon = true;
+
+#if defined(__aarch64__)
+
+/* set default to NEON */
+fvec_func_ptr fvec_inner_product = fvec_inner_product_neon;
+fvec_func_ptr fvec_L2sqr = fvec_L2sqr_neon;
+fvec_func_ptr fvec_L1 = fvec_L1_neon;
+fvec_func_ptr fvec_Linf = fvec_Linf_neon;
+fvec_batch_4_func_ptr fvec_inner_product_batch_4 = fvec_inner_product_batch_4_neon;
+fvec_batch_4_func_ptr fvec_L2sqr_batch_4 = fvec_L2sqr_batch_4_neon;
+
+bvec_popcount_func_ptr bvec_popcount_xor = bvec_popcount_xor_neon;
+bvec_popcount_func_ptr bvec_popcount_and = bvec_popcount_and_neon;
+bvec_popcount_func_ptr bvec_popcount_or = bvec_popcount_or_neon;
+bvec_structure_func_ptr bvec_substructure = bvec_substructure_neon;
+bvec_structure_func_ptr bvec_superstructure = bvec_superstructure_neon;
+
+sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_computer_neon;
+sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_neon;
+sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_neon;
+
+#else
 
 /* set default to AVX */
 fvec_func_ptr fvec_inner_product = fvec_inner_product_avx;
 fvec_func_ptr fvec_L2sqr = fvec_L2sqr_avx;
 fvec_func_ptr fvec_L1 = fvec_L1_avx;
 fvec_func_ptr fvec_Linf = fvec_Linf_avx;
+fvec_batch_4_func_ptr fvec_inner_product_batch_4 = fvec_inner_product_batch_4_avx;
+fvec_batch_4_func_ptr fvec_L2sqr_batch_4 = fvec_L2sqr_batch_4_avx;
+
+bvec_popcount_func_ptr bvec_popcount_xor = bvec_popcount_xor_avx;
+bvec_popcount_func_ptr bvec_popcount_and = bvec_popcount_and_avx;
+bvec_popcount_func_ptr bvec_popcount_or = bvec_popcount_or_avx;
+bvec_structure_func_ptr bvec_substructure = bvec_substructure_avx;
+bvec_structure_func_ptr bvec_superstructure = bvec_superstructure_avx;
 
 sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_computer_avx;
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+#endif
+
 /*****************************************************************************/
 
+FvecKernels fvec_kernels_for_dim(size_t d) {
+    FvecKernels kernels{fvec_inner_product, fvec_L2sqr, fvec_inner_product_batch_4, fvec_L2sqr_batch_4};
+#if !defined(__aarch64__)
+    if (fvec_L2sqr == fvec_L2sqr_avx512) {
+        fvec_kernels_avx512(d, kernels);
+    } else if (fvec_L2sqr == fvec_L2sqr_avx) {
+        fvec_kernels_avx(d, kernels);
+    }
+#endif
+    return kernels;
+}
+
 bool support_avx512() {
     if (!faiss_use_avx512) return false;
 
@@ -41,6 +92,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VPOPCNTDQ());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -55,16 +113,66 @@ bool support_sse() {
     return (instruction_set_inst.SSE42());
 }
 
+bool support_neon() {
+    if (!faiss_use_neon) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.NEON());
+}
+
 bool hook_init(std::string& cpu_flag) {
     static std::mutex hook_mutex;
     std::lock_guard<std::mutex> lock(hook_mutex);
 
+#if defined(__aarch64__)
+    if (support_neon()) {
+        /* for IVFFLAT */
+        fvec_inner_product = fvec_inner_product_neon;
+        fvec_L2sqr = fvec_L2sqr_neon;
+        fvec_L1 = fvec_L1_neon;
+        fvec_Linf = fvec_Linf_neon;
+        fvec_inner_product_batch_4 = fvec_inner_product_batch_4_neon;
+        fvec_L2sqr_batch_4 = fvec_L2sqr_batch_4_neon;
+
+        /* for binary indexes */
+        bvec_popcount_xor = bvec_popcount_xor_neon;
+        bvec_popcount_and = bvec_popcount_and_neon;
+        bvec_popcount_or = bvec_popcount_or_neon;
+        bvec_substructure = bvec_substructure_neon;
+        bvec_superstructure = bvec_superstructure_neon;
+
+        /* for IVFSQ */
+        sq_get_distance_computer = sq_get_distance_computer_neon;
+        sq_sel_quantizer = sq_select_quantizer_neon;
+        sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_neon;
+
+        cpu_flag = "NEON";
+    } else {
+        cpu_flag = "UNSUPPORTED";
+        return false;
+    }
+#else
     if (support_avx512()) {
         /* for IVFFLAT */
         fvec_inner_product = fvec_inner_product_avx512;
         fvec_L2sqr = fvec_L2sqr_avx512;
         fvec_L1 = fvec_L1_avx512;
         fvec_Linf = fvec_Linf_avx512;
+        fvec_inner_product_batch_4 = fvec_inner_product_batch_4_avx512;
+        fvec_L2sqr_batch_4 = fvec_L2sqr_batch_4_avx512;
+
+        /* for binary indexes, the bit counts of avx512 need VPOPCNTDQ */
+        if (support_avx512_vpopcntdq()) {
+            bvec_popcount_xor = bvec_popcount_xor_avx512;
+            bvec_popcount_and = bvec_popcount_and_avx512;
+            bvec_popcount_or = bvec_popcount_or_avx512;
+        } else {
+            bvec_popcount_xor = bvec_popcount_xor_avx;
+            bvec_popcount_and = bvec_popcount_and_avx;
+            bvec_popcount_or = bvec_popcount_or_avx;
+        }
+        bvec_substructure = bvec_substructure_avx512;
+        bvec_superstructure = bvec_superstructure_avx512;
 
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx512;
@@ -78,6 +186,15 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L2sqr = fvec_L2sqr_avx;
         fvec_L1 = fvec_L1_avx;
         fvec_Linf = fvec_Linf_avx;
+        fvec_inner_product_batch_4 = fvec_inner_product_batch_4_avx;
+        fvec_L2sqr_batch_4 = fvec_L2sqr_batch_4_avx;
+
+        /* for binary indexes */
+        bvec_popcount_xor = bvec_popcount_xor_avx;
+        bvec_popcount_and = bvec_popcount_and_avx;
+        bvec_popcount_or = bvec_popcount_or_avx;
+        bvec_substructure = bvec_substructure_avx;
+        bvec_superstructure = bvec_superstructure_avx;
 
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx;
@@ -91,6 +208,15 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L2sqr = fvec_L2sqr_sse;
         fvec_L1 = fvec_L1_sse;
         fvec_Linf = fvec_Linf_sse;
+        fvec_inner_product_batch_4 = fvec_inner_product_batch_4_sse;
+        fvec_L2sqr_batch_4 = fvec_L2sqr_batch_4_sse;
+
+        /* for binary indexes */
+        bvec_popcount_xor = bvec_popcount_xor_ref;
+        bvec_popcount_and = bvec_popcount_and_ref;
+        bvec_popcount_or = bvec_popcount_or_ref;
+        bvec_substructure = bvec_substructure_ref;
+        bvec_superstructure = bvec_superstructure_ref;
 
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_ref;
@@ -102,6 +228,7 @@ bool hook_init(std::string& cpu_flag) {
         cpu_flag = "UNSUPPORTED";
         return false;
     }
+#endif
 
     return true;
 }
@@ -13,6 +13,11 @@
 namespace faiss {
 
 typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
+typedef void (*fvec_batch_4_func_ptr)(const float*, const float*, const float*, const float*, const float*, size_t,
+                                      float&, float&, float&, float&);
+
+typedef int (*bvec_popcount_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+typedef bool (*bvec_structure_func_ptr)(const uint8_t*, const uint8_t*, size_t);
 
 typedef SQDistanceComputer* (*sq_get_distance_computer_func_ptr)(MetricType, QuantizerType, size_t, const std::vector<float>&);
 typedef Quantizer* (*sq_sel_quantizer_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
@@ -21,19 +26,42 @@ typedef InvertedListScanner* (*sq_sel_inv_list_scanner_func_ptr)(MetricType, con
 extern bool faiss_use_avx512;
 extern bool faiss_use_avx2;
 extern bool faiss_use_sse;
+extern bool faiss_use_neon;
 
 extern fvec_func_ptr fvec_inner_product;
 extern fvec_func_ptr fvec_L2sqr;
 extern fvec_func_ptr fvec_L1;
 extern fvec_func_ptr fvec_Linf;
+extern fvec_batch_4_func_ptr fvec_inner_product_batch_4;
+extern fvec_batch_4_func_ptr fvec_L2sqr_batch_4;
+
+/// the distance kernels of one dimension
+struct FvecKernels {
+    fvec_func_ptr inner_product;
+    fvec_func_ptr L2sqr;
+    fvec_batch_4_func_ptr inner_product_batch_4;
+    fvec_batch_4_func_ptr L2sqr_batch_4;
+};
+
+/// the hooked kernels for dimension d, unrolled ones for the common dimensions of the hooked instruction set,
+/// resolved once per scan rather than branching on d in every distance
+extern FvecKernels fvec_kernels_for_dim(size_t d);
+
+extern bvec_popcount_func_ptr bvec_popcount_xor;
+extern bvec_popcount_func_ptr bvec_popcount_and;
+extern bvec_popcount_func_ptr bvec_popcount_or;
+extern bvec_structure_func_ptr bvec_substructure;
+extern bvec_structure_func_ptr bvec_superstructure;
 
 extern sq_get_distance_computer_func_ptr sq_get_distance_computer;
 extern sq_sel_quantizer_func_ptr sq_sel_quantizer;
 extern sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner;
 
 extern bool support_avx512();
+extern bool support_avx512_vpopcntdq();
 extern bool support_avx2();
 extern bool support_sse();
+extern bool support_neon();
 
 extern bool hook_init(std::string& cpu_flag);
 
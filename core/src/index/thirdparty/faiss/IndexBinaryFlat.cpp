@@ -126,7 +126,7 @@ void IndexBinaryFlat::range_search(idx_t n, const uint8_t *x, int radius,
                                    RangeSearchResult *result,
                                    ConcurrentBitsetPtr bitset) const
 {
-    hamming_range_search (x, xb.data(), n, ntotal, radius, code_size, result);
+    hamming_range_search (x, xb.data(), n, ntotal, radius, code_size, result, bitset);
 }
 
 }  // namespace faiss
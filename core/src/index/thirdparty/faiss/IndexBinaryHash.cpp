@@ -10,7 +10,9 @@
 
 #include <faiss/IndexBinaryHash.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 
 #include <faiss/utils/hamming.h>
@@ -22,6 +24,21 @@
 
 namespace faiss {
 
+namespace {
+
+/// the b bits of a code at bit offset ho, the word they are read from
+/// does not go past the end of the code
+inline uint64_t extract_hash (const uint8_t *code, size_t code_size,
+                              int ho, uint64_t mask)
+{
+    uint64_t word = 0;
+    size_t byte = ho >> 3;
+    memcpy (&word, code + byte, std::min (sizeof(word), code_size - byte));
+    return (word >> (ho & 7)) & mask;
+}
+
+} // anonymous namespace
+
 void IndexBinaryHash::InvertedList::add (
         idx_t id, size_t code_size, const uint8_t *code)
 {
@@ -32,6 +49,7 @@ void IndexBinaryHash::InvertedList::add (
 IndexBinaryHash::IndexBinaryHash(int d, int b):
     IndexBinary(d), b(b), nflip(0)
 {
+    FAISS_THROW_IF_NOT(b > 0 && b <= 56 && b <= d);
     is_trained = true;
 }
 
@@ -60,7 +78,7 @@ void IndexBinaryHash::add_with_ids(idx_t n, const uint8_t *x, const idx_t *xids)
     for (idx_t i = 0; i < n; i++) {
         idx_t id = xids ? xids[i] : ntotal + i;
         const uint8_t * xi = x + i * code_size;
-        idx_t hash = *((uint64_t*)xi) & mask;
+        idx_t hash = extract_hash (xi, code_size, 0, mask);
         invlists[hash].add(id, code_size, xi);
     }
     ntotal += n;
@@ -147,11 +165,12 @@ template<class HammingComputer, class SearchResults>
 void
 search_single_query_template(const IndexBinaryHash & index, const uint8_t *q,
                     SearchResults &res,
-                    size_t &n0, size_t &nlist, size_t &ndis)
+                    size_t &n0, size_t &nlist, size_t &ndis,
+                    const ConcurrentBitsetPtr &bitset)
 {
     size_t code_size = index.code_size;
     uint64_t mask = ((uint64_t)1 << index.b) - 1;
-    uint64_t qhash = *((uint64_t*)q) & mask;
+    uint64_t qhash = extract_hash (q, code_size, 0, mask);
     HammingComputer hc (q, code_size);
     FlipEnumerator fe(index.b, index.nflip);
 
@@ -172,10 +191,12 @@ search_single_query_template(const IndexBinaryHash & index, const uint8_t *q,
             n0++;
         } else {
             const uint8_t *codes = il.vecs.data();
-            for (size_t i = 0; i < nv; i++) {
+            for (size_t i = 0; i < nv; i++, codes += code_size) {
+                if (bitset && bitset->test(il.ids[i])) {
+                    continue;
+                }
                 int dis = hc.hamming (codes);
                 res.add(dis, il.ids[i]);
-                codes += code_size;
             }
             ndis += nv;
             nlist++;
@@ -187,9 +208,10 @@ template<class SearchResults>
 void
 search_single_query(const IndexBinaryHash & index, const uint8_t *q,
                     SearchResults &res,
-                    size_t &n0, size_t &nlist, size_t &ndis)
+                    size_t &n0, size_t &nlist, size_t &ndis,
+                    const ConcurrentBitsetPtr &bitset)
 {
-#define HC(name) search_single_query_template<name>(index, q, res, n0, nlist, ndis);
+#define HC(name) search_single_query_template<name>(index, q, res, n0, nlist, ndis, bitset);
     switch(index.code_size) {
     case 4: HC(HammingComputer4); break;
     case 8: HC(HammingComputer8); break;
@@ -228,7 +250,7 @@ void IndexBinaryHash::range_search(idx_t n, const uint8_t *x, int radius,
             RangeSearchResults res = {radius, qres};
             const uint8_t *q = x + i * code_size;
 
-            search_single_query (*this, q, res, n0, nlist, ndis);
+            search_single_query (*this, q, res, n0, nlist, ndis, bitset);
 
         }
         pres.finalize ();
@@ -256,8 +278,8 @@ void IndexBinaryHash::search(idx_t n, const uint8_t *x, idx_t k,
         KnnSearchResults res = {k, simi, idxi};
         const uint8_t *q = x + i * code_size;
 
-        search_single_query (*this, q, res, n0, nlist, ndis);
-
+        search_single_query (*this, q, res, n0, nlist, ndis, bitset);
+        heap_reorder<HeapForL2> (k, simi, idxi);
     }
     indexBinaryHash_stats.nq += n;
     indexBinaryHash_stats.n0 += n0;
@@ -302,7 +324,7 @@ IndexBinaryMultiHash::IndexBinaryMultiHash(int d, int nhash, int b):
     storage(new IndexBinaryFlat(d)), own_fields(true),
     maps(nhash), nhash(nhash), b(b), nflip(0)
 {
-    FAISS_THROW_IF_NOT(nhash * b <= d);
+    FAISS_THROW_IF_NOT(nhash > 0 && b > 0 && b <= 56 && nhash * b <= d);
 }
 
 IndexBinaryMultiHash::IndexBinaryMultiHash():
@@ -322,7 +344,7 @@ void IndexBinaryMultiHash::reset()
 {
     storage->reset();
     ntotal = 0;
-    for(auto map: maps) {
+    for(auto & map: maps) {
         map.clear();
     }
 }
@@ -337,8 +359,7 @@ void IndexBinaryMultiHash::add(idx_t n, const uint8_t *x)
         const uint8_t *xi = x + i * code_size;
         int ho = 0;
         for(int h = 0; h < nhash; h++) {
-            uint64_t hash = *(uint64_t*)(xi + (ho >> 3)) >> (ho & 7);
-            hash &= mask;
+            uint64_t hash = extract_hash (xi, code_size, ho, mask);
             maps[h][hash].push_back(i + ntotal);
             ho += b;
         }
@@ -354,7 +375,7 @@ static
 void verify_shortlist(
         const IndexBinaryFlat & index,
         const uint8_t * q,
-        const std::unordered_set<Index::idx_t> & shortlist,
+        const std::vector<Index::idx_t> & shortlist,
         SearchResults &res)
 {
     size_t code_size = index.code_size;
@@ -373,17 +394,19 @@ template<class SearchResults>
 void
 search_1_query_multihash(const IndexBinaryMultiHash & index, const uint8_t *xi,
                          SearchResults &res,
-                         size_t &n0, size_t &nlist, size_t &ndis)
+                         size_t &n0, size_t &nlist, size_t &ndis,
+                         const ConcurrentBitsetPtr &bitset)
 {
 
-    std::unordered_set<idx_t> shortlist;
+    // the ids found in several buckets are verified once, a sorted vector
+    // is cheaper to dedup than a hash set
+    std::vector<idx_t> shortlist;
     int b = index.b;
     uint64_t mask = ((uint64_t)1 << b) - 1;
 
     int ho = 0;
     for(int h = 0; h < index.nhash; h++) {
-        uint64_t qhash = *(uint64_t*)(xi + (ho >> 3)) >> (ho & 7);
-        qhash &= mask;
+        uint64_t qhash = extract_hash (xi, index.code_size, ho, mask);
         const IndexBinaryMultiHash::Map & map = index.maps[h];
 
         FlipEnumerator fe(index.b, index.nflip);
@@ -395,7 +418,9 @@ search_1_query_multihash(const IndexBinaryMultiHash & index, const uint8_t *xi,
             if (it != map.end()) {
                 const std::vector<idx_t> & v = it->second;
                 for (auto i: v) {
-                    shortlist.insert(i);
+                    if (!bitset || !bitset->test(i)) {
+                        shortlist.push_back(i);
+                    }
                 }
                 nlist++;
             } else {
@@ -405,6 +430,9 @@ search_1_query_multihash(const IndexBinaryMultiHash & index, const uint8_t *xi,
 
         ho += b;
     }
+    std::sort (shortlist.begin(), shortlist.end());
+    shortlist.erase (std::unique (shortlist.begin(), shortlist.end()),
+                     shortlist.end());
     ndis += shortlist.size();
 
     // verify shortlist
@@ -445,7 +473,7 @@ void IndexBinaryMultiHash::range_search(idx_t n, const uint8_t *x, int radius,
             RangeSearchResults res = {radius, qres};
             const uint8_t *q = x + i * code_size;
 
-            search_1_query_multihash (*this, q, res, n0, nlist, ndis);
+            search_1_query_multihash (*this, q, res, n0, nlist, ndis, bitset);
 
         }
         pres.finalize ();
@@ -473,8 +501,8 @@ void IndexBinaryMultiHash::search(idx_t n, const uint8_t *x, idx_t k,
         KnnSearchResults res = {k, simi, idxi};
         const uint8_t *q = x + i * code_size;
 
-        search_1_query_multihash (*this, q, res, n0, nlist, ndis);
-
+        search_1_query_multihash (*this, q, res, n0, nlist, ndis, bitset);
+        heap_reorder<HeapForL2> (k, simi, idxi);
     }
     indexBinaryHash_stats.nq += n;
     indexBinaryHash_stats.n0 += n0;
@@ -485,7 +513,7 @@ void IndexBinaryMultiHash::search(idx_t n, const uint8_t *x, idx_t k,
 size_t IndexBinaryMultiHash::hashtable_size() const
 {
     size_t tot = 0;
-    for (auto map: maps) {
+    for (auto & map: maps) {
         tot += map.size();
     }
 
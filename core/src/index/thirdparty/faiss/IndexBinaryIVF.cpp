@@ -472,7 +472,9 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
         case 32: HC(HammingComputer32);
         case 64: HC(HammingComputer64);
         default:
-            if (code_size % 8 == 0) {
+            if (code_size >= BINARY_SIMD_MIN_CODE_SIZE) {
+                HC(HammingComputerSIMD);
+            } else if (code_size % 8 == 0) {
                 HC(HammingComputerM8);
             } else if (code_size % 4 == 0) {
                 HC(HammingComputerM4);
@@ -485,6 +487,9 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
 
 template <bool store_pairs>
 BinaryInvertedListScanner *select_IVFBinaryScannerJaccard (size_t code_size) {
+    if (code_size >= BINARY_SIMD_MIN_CODE_SIZE) {
+        return new IVFBinaryScannerJaccard<JaccardComputerSIMD, store_pairs> (code_size);
+    }
     switch (code_size) {
 #define HANDLE_CS(cs)                                                  \
     case cs:                                                            \
@@ -492,9 +497,6 @@ BinaryInvertedListScanner *select_IVFBinaryScannerJaccard (size_t code_size) {
      HANDLE_CS(16)
      HANDLE_CS(32)
      HANDLE_CS(64)
-     HANDLE_CS(128)
-     HANDLE_CS(256)
-     HANDLE_CS(512)
 #undef HANDLE_CS
     default:
         return new IVFBinaryScannerJaccard<JaccardComputerDefault,
@@ -798,7 +800,10 @@ void search_knn_hamming_count_1 (
       HANDLE_CS(64);
 #undef HANDLE_CS
     default:
-        if (ivf.code_size % 8 == 0) {
+        if (ivf.code_size >= BINARY_SIMD_MIN_CODE_SIZE) {
+            search_knn_hamming_count<HammingComputerSIMD, store_pairs>
+                (ivf, nx, x, keys, k, distances, labels, params, bitset);
+        } else if (ivf.code_size % 8 == 0) {
             search_knn_hamming_count<HammingComputerM8, store_pairs>
                 (ivf, nx, x, keys, k, distances, labels, params, bitset);
         } else if (ivf.code_size % 4 == 0) {
@@ -66,6 +66,24 @@ void IndexFlat::search (idx_t n, const float *x, idx_t k,
     }
 }
 
+void IndexFlat::search_bounded (idx_t n, const float *x, idx_t k,
+                                float *distances, idx_t *labels,
+                                const float *bounds,
+                                ConcurrentBitsetPtr bitset) const
+{
+    if (metric_type == METRIC_INNER_PRODUCT) {
+        float_minheap_array_t res = {
+            size_t(n), size_t(k), labels, distances};
+        knn_inner_product (x, xb.data(), d, n, ntotal, &res, bitset, bounds);
+    } else if (metric_type == METRIC_L2) {
+        float_maxheap_array_t res = {
+            size_t(n), size_t(k), labels, distances};
+        knn_L2sqr (x, xb.data(), d, n, ntotal, &res, bitset, bounds);
+    } else {
+        search (n, x, k, distances, labels, bitset);
+    }
+}
+
 void IndexFlat::assign(idx_t n, const float * x, idx_t * labels, float* distances)
 {
     // usually used in IVF k-means algorithm
@@ -96,10 +114,10 @@ void IndexFlat::range_search (idx_t n, const float *x, float radius,
     switch (metric_type) {
     case METRIC_INNER_PRODUCT:
         range_search_inner_product (x, xb.data(), d, n, ntotal,
-                                    radius, result);
+                                    radius, result, bitset);
         break;
     case METRIC_L2:
-        range_search_L2sqr (x, xb.data(), d, n, ntotal, radius, result);
+        range_search_L2sqr (x, xb.data(), d, n, ntotal, radius, result, bitset);
         break;
     default:
         FAISS_THROW_MSG("metric type not supported");
@@ -162,14 +180,15 @@ struct FlatL2Dis : DistanceComputer {
     const float *q;
     const float *b;
     size_t ndis;
+    fvec_func_ptr L2sqr;
 
     float operator () (idx_t i) override {
         ndis++;
-        return fvec_L2sqr(q, b + i * d, d);
+        return L2sqr(q, b + i * d, d);
     }
 
     float symmetric_dis(idx_t i, idx_t j) override {
-        return fvec_L2sqr(b + j * d, b + i * d, d);
+        return L2sqr(b + j * d, b + i * d, d);
     }
 
     explicit FlatL2Dis(const IndexFlat& storage, const float *q = nullptr)
@@ -177,7 +196,8 @@ struct FlatL2Dis : DistanceComputer {
           nb(storage.ntotal),
           q(q),
           b(storage.xb.data()),
-          ndis(0) {}
+          ndis(0),
+          L2sqr(fvec_kernels_for_dim(storage.d).L2sqr) {}
 
     void set_query(const float *x) override {
         q = x;
@@ -190,14 +210,15 @@ struct FlatIPDis : DistanceComputer {
     const float *q;
     const float *b;
     size_t ndis;
+    fvec_func_ptr inner_product;
 
     float operator () (idx_t i) override {
         ndis++;
-        return fvec_inner_product (q, b + i * d, d);
+        return inner_product (q, b + i * d, d);
     }
 
     float symmetric_dis(idx_t i, idx_t j) override {
-        return fvec_inner_product (b + j * d, b + i * d, d);
+        return inner_product (b + j * d, b + i * d, d);
     }
 
     explicit FlatIPDis(const IndexFlat& storage, const float *q = nullptr)
@@ -205,7 +226,8 @@ struct FlatIPDis : DistanceComputer {
           nb(storage.ntotal),
           q(q),
           b(storage.xb.data()),
-          ndis(0) {}
+          ndis(0),
+          inner_product(fvec_kernels_for_dim(storage.d).inner_product) {}
 
     void set_query(const float *x) override {
         q = x;
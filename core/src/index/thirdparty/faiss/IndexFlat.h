@@ -37,6 +37,21 @@ struct IndexFlat: Index {
         idx_t* labels,
         ConcurrentBitsetPtr bitset = nullptr) const override;
 
+    /** search that only keeps the results beating bounds[i] for query i,
+     * the remaining results of the query are -1 at distance bounds[i].
+     * Metrics other than L2 and inner product ignore the bounds.
+     *
+     * @param bounds  size n
+     */
+    void search_bounded(
+        idx_t n,
+        const float* x,
+        idx_t k,
+        float* distances,
+        idx_t* labels,
+        const float* bounds,
+        ConcurrentBitsetPtr bitset = nullptr) const;
+
     void assign (
         idx_t n,
         const float * x,
@@ -12,6 +12,7 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <iostream>
@@ -22,6 +23,7 @@
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/IndexFlat.h>
 #include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/FaissHook.h>
 
 namespace faiss {
 
@@ -333,6 +335,32 @@ void IndexIVF::search (idx_t n, const float *x, idx_t k,
     indexIVF_stats.search_time += getmillisecs() - t0;
 }
 
+void IndexIVF::search_bounded (idx_t n, const float *x, idx_t k,
+                               float *distances, idx_t *labels,
+                               const float *bounds,
+                               ConcurrentBitsetPtr bitset,
+                               const std::atomic<bool> *cancel) const
+{
+    std::unique_ptr<idx_t[]> idx(new idx_t[n * nprobe]);
+    std::unique_ptr<float[]> coarse_dis(new float[n * nprobe]);
+
+    double t0 = getmillisecs();
+    quantizer->search (n, x, nprobe, coarse_dis.get(), idx.get());
+    indexIVF_stats.quantization_time += getmillisecs() - t0;
+
+    t0 = getmillisecs();
+    invlists->prefetch_lists (idx.get(), n * nprobe);
+
+    IVFSearchParameters params;
+    params.nprobe = nprobe;
+    params.max_codes = max_codes;
+    params.bounds = bounds;
+    params.cancel = cancel;
+    search_preassigned (n, x, k, idx.get(), coarse_dis.get(),
+                        distances, labels, false, &params, bitset);
+    indexIVF_stats.search_time += getmillisecs() - t0;
+}
+
 void IndexIVF::search_without_codes (idx_t n, const float *x, 
                                      const uint8_t *arranged_codes, std::vector<size_t> prefix_sum, 
                                      bool is_sq8, idx_t k, float *distances, idx_t *labels,
@@ -380,6 +408,47 @@ void IndexIVF::search_by_id (idx_t n, const idx_t *xid, idx_t k, float *distance
 }
 #endif
 
+namespace {
+
+/* The lists of a query that can't improve its top-k, see prune_lists.
+ * The vectors of the list of centroid c are nearer to c than to the
+ * centroid c1 nearest to the query, so they are at least
+ * (|q - c|^2 - |q - c1|^2) / (2 |c - c1|) away from the query. */
+struct ListPruner {
+    const float *centroids = nullptr;
+    size_t d = 0;
+
+    ListPruner (const IndexIVF & index) {
+        if (!index.prune_lists || index.metric_type != METRIC_L2) {
+            return;
+        }
+        auto flat = dynamic_cast<const IndexFlat *> (index.quantizer);
+        if (flat && flat->metric_type == METRIC_L2 &&
+            flat->ntotal == (Index::idx_t) index.nlist) {
+            centroids = flat->xb.data();
+            d = flat->d;
+        }
+    }
+
+    /// keys and coarse_dis are the probes of the query, nearest first,
+    /// top the distance a result has to beat
+    bool skip (const Index::idx_t *keys, const float *coarse_dis,
+               size_t ik, float top) const {
+        if (!centroids || ik == 0 || keys[0] < 0 || keys[ik] < 0) {
+            return false;
+        }
+        float margin = coarse_dis[ik] - coarse_dis[0];
+        if (margin <= 0) {
+            return false;
+        }
+        float cc = fvec_L2sqr (centroids + keys[0] * d,
+                               centroids + keys[ik] * d, d);
+        return margin * margin >= 4 * cc * top;
+    }
+};
+
+} // namespace
+
 void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                                    const idx_t *keys,
                                    const float *coarse_dis ,
@@ -390,6 +459,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
 {
     long nprobe = params ? params->nprobe : this->nprobe;
     long max_codes = params ? params->max_codes : this->max_codes;
+    const float *bounds = params ? params->bounds : nullptr;
+    const std::atomic<bool> *cancel = params ? params->cancel : nullptr;
 
     size_t nlistv = 0, ndis = 0, nheap = 0;
 
@@ -397,10 +468,22 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
     using HeapForL2 = CMax<float, idx_t>;
 
     bool interrupt = false;
+    bool cancelled = false;
 
     int pmode = this->parallel_mode & ~PARALLEL_MODE_NO_HEAP_INIT;
     bool do_heap_init = !(this->parallel_mode & PARALLEL_MODE_NO_HEAP_INIT);
 
+    ListPruner pruner (*this);
+
+    if (pmode == 3) {
+        if (!store_pairs && do_heap_init && max_codes == 0 && !pruner.centroids &&
+            search_preassigned_list_major (n, x, k, keys, coarse_dis,
+                                           distances, labels, params, bitset)) {
+            return;
+        }
+        pmode = 0;
+    }
+
     // don't start parallel section if single query
     bool do_parallel =
         pmode == 0 ? n > 1 :
@@ -420,13 +503,19 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
 
         // intialize + reorder a result heap
 
-        auto init_result = [&](float *simi, idx_t *idxi) {
+        auto init_result = [&](float *simi, idx_t *idxi, size_t i) {
             if (!do_heap_init) return;
             if (metric_type == METRIC_INNER_PRODUCT) {
                 heap_heapify<HeapForIP> (k, simi, idxi);
             } else {
                 heap_heapify<HeapForL2> (k, simi, idxi);
             }
+            // placeholders at the bound keep out what can't beat it
+            if (bounds) {
+                for (idx_t j = 0; j < k; j++) {
+                    simi[j] = bounds[i];
+                }
+            }
         };
 
         auto reorder_result = [&] (float *simi, idx_t *idxi) {
@@ -497,13 +586,24 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 float * simi = distances + i * k;
                 idx_t * idxi = labels + i * k;
 
-                init_result (simi, idxi);
+                init_result (simi, idxi, i);
+
+                if (cancelled) {
+                    // the remaining queries keep their empty results
+                    reorder_result (simi, idxi);
+                    continue;
+                }
 
                 long nscan = 0;
 
                 // loop over probes
                 for (size_t ik = 0; ik < nprobe; ik++) {
 
+                    if (pruner.skip (keys + i * nprobe, coarse_dis + i * nprobe,
+                                     ik, simi[0])) {
+                        continue;
+                    }
+
                     nscan += scan_one_list (
                          keys [i * nprobe + ik],
                          coarse_dis[i * nprobe + ik],
@@ -521,6 +621,9 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 if (InterruptCallback::is_interrupted ()) {
                     interrupt = true;
                 }
+                if (cancel && cancel->load (std::memory_order_relaxed)) {
+                    cancelled = true;
+                }
 
             } // parallel for
         } else if (pmode == 1) {
@@ -529,10 +632,22 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
 
             for (size_t i = 0; i < n; i++) {
                 scanner->set_query (x + i * d);
-                init_result (local_dis.data(), local_idx.data());
+                init_result (local_dis.data(), local_idx.data(), i);
 
 #pragma omp for schedule(dynamic)
                 for (size_t ik = 0; ik < nprobe; ik++) {
+                    if (cancelled) {
+                        continue;
+                    }
+                    if (cancel && cancel->load (std::memory_order_relaxed)) {
+                        cancelled = true;
+                        continue;
+                    }
+                    // the thread-local top-k is never better than the merged one
+                    if (pruner.skip (keys + i * nprobe, coarse_dis + i * nprobe,
+                                     ik, local_dis[0])) {
+                        continue;
+                    }
                     ndis += scan_one_list
                         (keys [i * nprobe + ik],
                          coarse_dis[i * nprobe + ik],
@@ -545,7 +660,7 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 float * simi = distances + i * k;
                 idx_t * idxi = labels + i * k;
 #pragma omp single
-                init_result (simi, idxi);
+                init_result (simi, idxi, i);
 
 #pragma omp barrier
 #pragma omp critical
@@ -582,6 +697,188 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
 }
 
 
+namespace {
+
+// a chunk of an inverted list stays in cache while the queries probing the list scan it
+const size_t LIST_MAJOR_CHUNK_BYTES = 64 * 1024;
+const size_t LIST_MAJOR_MIN_CHUNK = 256;
+
+// below it the queries probe mostly distinct lists, nothing to share
+const size_t LIST_MAJOR_MIN_SHARE = 2;
+
+// thread-local heaps of all the queries beyond it are not worth the sharing
+const size_t LIST_MAJOR_MAX_HEAP_BYTES = 64 * 1024 * 1024;
+
+} // namespace
+
+bool IndexIVF::search_preassigned_list_major (idx_t n, const float *x, idx_t k,
+                                              const idx_t *keys,
+                                              const float *coarse_dis,
+                                              float *distances, idx_t *labels,
+                                              const IVFSearchParameters *params,
+                                              ConcurrentBitsetPtr bitset) const
+{
+    long nprobe = params ? params->nprobe : this->nprobe;
+    const float *bounds = params ? params->bounds : nullptr;
+    const std::atomic<bool> *cancel = params ? params->cancel : nullptr;
+
+    int nt = omp_get_max_threads();
+    size_t heap_bytes = (size_t)nt * n * k * (sizeof(float) + sizeof(idx_t));
+    if (n < 2 || nprobe < 1 || heap_bytes > LIST_MAJOR_MAX_HEAP_BYTES) {
+        return false;
+    }
+
+    // (list, query * nprobe + probe) sorted by list, the probes of a list are adjacent
+    std::vector<std::pair<idx_t, size_t>> probes;
+    probes.reserve (n * nprobe);
+    for (size_t i = 0; i < n * nprobe; i++) {
+        idx_t key = keys[i];
+        if (key < 0) {
+            // not enough centroids for multiprobe
+            continue;
+        }
+        FAISS_THROW_IF_NOT_FMT (key < (idx_t) nlist,
+                                "Invalid key=%ld nlist=%ld\n",
+                                key, nlist);
+        probes.emplace_back (key, i);
+    }
+    std::sort (probes.begin(), probes.end());
+
+    std::vector<size_t> group_begin;
+    for (size_t j = 0; j < probes.size(); j++) {
+        if (j == 0 || probes[j].first != probes[j - 1].first) {
+            group_begin.push_back (j);
+        }
+    }
+    size_t ngroup = group_begin.size();
+    group_begin.push_back (probes.size());
+    if (probes.size() < LIST_MAJOR_MIN_SHARE * ngroup) {
+        return false;
+    }
+
+    using HeapForIP = CMin<float, idx_t>;
+    using HeapForL2 = CMax<float, idx_t>;
+
+    auto init_result = [&](float *simi, idx_t *idxi, size_t i) {
+        if (metric_type == METRIC_INNER_PRODUCT) {
+            heap_heapify<HeapForIP> (k, simi, idxi);
+        } else {
+            heap_heapify<HeapForL2> (k, simi, idxi);
+        }
+        // placeholders at the bound keep out what can't beat it
+        if (bounds) {
+            for (idx_t j = 0; j < k; j++) {
+                simi[j] = bounds[i];
+            }
+        }
+    };
+
+    // every thread keeps the heaps of all queries, merged at the end
+    std::unique_ptr<float[]> local_dis (new float[(size_t)nt * n * k]);
+    std::unique_ptr<idx_t[]> local_idx (new idx_t[(size_t)nt * n * k]);
+    std::vector<char> used (nt, 0);
+
+    size_t chunk = std::max (LIST_MAJOR_MIN_CHUNK, LIST_MAJOR_CHUNK_BYTES / std::max (code_size, (size_t)1));
+    size_t nlistv = 0, ndis = 0, nheap = 0;
+    bool interrupt = false;
+    bool cancelled = false;
+
+#pragma omp parallel num_threads(nt) reduction(+: nlistv, ndis, nheap)
+    {
+        int rank = omp_get_thread_num();
+        float *thread_dis = local_dis.get() + (size_t)rank * n * k;
+        idx_t *thread_idx = local_idx.get() + (size_t)rank * n * k;
+
+        InvertedListScanner *scanner = get_InvertedListScanner (false);
+        ScopeDeleter1<InvertedListScanner> del (scanner);
+
+#pragma omp for schedule(dynamic)
+        for (size_t g = 0; g < ngroup; g++) {
+            if (interrupt || cancelled) {
+                continue;
+            }
+
+            idx_t key = probes[group_begin[g]].first;
+            size_t list_size = invlists->list_size (key);
+            if (list_size == 0) {
+                continue;
+            }
+
+            if (!used[rank]) {
+                for (size_t i = 0; i < n; i++) {
+                    init_result (thread_dis + i * k, thread_idx + i * k, i);
+                }
+                used[rank] = 1;
+            }
+
+            InvertedLists::ScopedCodes scodes (invlists, key);
+            InvertedLists::ScopedIds sids (invlists, key);
+            const uint8_t *codes = scodes.get();
+            const idx_t *ids = sids.get();
+
+            for (size_t begin = 0; begin < list_size; begin += chunk) {
+                size_t end = std::min (begin + chunk, list_size);
+                for (size_t j = group_begin[g]; j < group_begin[g + 1]; j++) {
+                    size_t i = probes[j].second / nprobe;
+                    scanner->set_query (x + i * d);
+                    scanner->set_list (key, coarse_dis[probes[j].second]);
+                    nheap += scanner->scan_codes (end - begin,
+                                                  codes + begin * code_size,
+                                                  ids + begin,
+                                                  thread_dis + i * k,
+                                                  thread_idx + i * k,
+                                                  k, bitset);
+                }
+            }
+            nlistv += group_begin[g + 1] - group_begin[g];
+            ndis += (group_begin[g + 1] - group_begin[g]) * list_size;
+
+            if (InterruptCallback::is_interrupted ()) {
+                interrupt = true;
+            }
+            if (cancel && cancel->load (std::memory_order_relaxed)) {
+                cancelled = true;
+            }
+        }
+    }
+
+    if (interrupt) {
+        FAISS_THROW_MSG ("computation interrupted");
+    }
+
+    // merge the heaps of the threads, the queries are independent
+#pragma omp parallel for
+    for (size_t i = 0; i < n; i++) {
+        float *simi = distances + i * k;
+        idx_t *idxi = labels + i * k;
+        init_result (simi, idxi, i);
+        for (int rank = 0; rank < nt; rank++) {
+            if (!used[rank]) {
+                continue;
+            }
+            size_t offset = ((size_t)rank * n + i) * k;
+            if (metric_type == METRIC_INNER_PRODUCT) {
+                heap_addn<HeapForIP> (k, simi, idxi,
+                                      local_dis.get() + offset, local_idx.get() + offset, k);
+            } else {
+                heap_addn<HeapForL2> (k, simi, idxi,
+                                      local_dis.get() + offset, local_idx.get() + offset, k);
+            }
+        }
+        if (metric_type == METRIC_INNER_PRODUCT) {
+            heap_reorder<HeapForIP> (k, simi, idxi);
+        } else {
+            heap_reorder<HeapForL2> (k, simi, idxi);
+        }
+    }
+
+    indexIVF_stats.nq += n;
+    indexIVF_stats.nlist += nlistv;
+    indexIVF_stats.ndis += ndis;
+    indexIVF_stats.nheap_updates += nheap;
+    return true;
+}
+
 void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x, 
                                                  const uint8_t *arranged_codes, 
                                                  std::vector<size_t> prefix_sum,  
@@ -602,6 +899,7 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
     using HeapForL2 = CMax<float, idx_t>;
 
     bool interrupt = false;
+    ListPruner pruner (*this);
 
     int pmode = this->parallel_mode & ~PARALLEL_MODE_NO_HEAP_INIT;
     bool do_heap_init = !(this->parallel_mode & PARALLEL_MODE_NO_HEAP_INIT);
@@ -678,8 +976,10 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
                 ids = sids->get();
             }
 
-            size_t size = is_sq8 ? sizeof(uint8_t) : sizeof(float);
-            nheap += scanner->scan_codes (list_size, (const uint8_t *) (scodes.get() + d * offset * size),
+            // arranged data holds one code per vector: d floats for IVFFlat,
+            // d bytes for SQ8 and 2 * d bytes for the fp16 / bf16 quantizers
+            size_t code_stride = is_sq8 ? d * sizeof(uint8_t) : code_size;
+            nheap += scanner->scan_codes (list_size, (const uint8_t *) (scodes.get() + offset * code_stride),
                                           ids, simi, idxi, k, bitset);
 
             return list_size;
@@ -710,6 +1010,11 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
                 // loop over probes
                 for (size_t ik = 0; ik < nprobe; ik++) {
 
+                    if (pruner.skip (keys + i * nprobe, coarse_dis + i * nprobe,
+                                     ik, simi[0])) {
+                        continue;
+                    }
+
                     nscan += scan_one_list (
                          keys [i * nprobe + ik],
                          coarse_dis[i * nprobe + ik],
@@ -740,6 +1045,10 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
 
 #pragma omp for schedule(dynamic)
                 for (size_t ik = 0; ik < nprobe; ik++) {
+                    if (pruner.skip (keys + i * nprobe, coarse_dis + i * nprobe,
+                                     ik, local_dis[0])) {
+                        continue;
+                    }
                     ndis += scan_one_list
                         (keys [i * nprobe + ik],
                          coarse_dis[i * nprobe + ik],
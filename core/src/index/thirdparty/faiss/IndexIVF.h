@@ -11,6 +11,7 @@
 #define FAISS_INDEX_IVF_H
 
 
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <stdint.h>
@@ -69,6 +70,11 @@ struct Level1Quantizer {
 struct IVFSearchParameters {
     size_t nprobe;            ///< number of probes at query time
     size_t max_codes;         ///< max nb of codes to visit to do a query
+    /// if set, size n: only the results beating bounds[i] are kept for query i
+    const float *bounds = nullptr;
+    /// if set, the search stops scanning once it turns true, the
+    /// results found so far are returned
+    const std::atomic<bool> *cancel = nullptr;
     virtual ~IVFSearchParameters () {}
 };
 
@@ -111,6 +117,9 @@ struct IndexIVF: Index, Level1Quantizer {
      * 0 (default): parallelize over queries
      * 1: parallelize over inverted lists
      * 2: parallelize over both
+     * 3: parallelize over inverted lists, the queries probing a list
+     *    scan it together one cache-sized chunk at a time. Falls back
+     *    to 0 if the queries share few lists
      *
      * PARALLEL_MODE_NO_HEAP_INIT: binary or with the previous to
      * prevent the heap to be initialized and finalized
@@ -118,6 +127,16 @@ struct IndexIVF: Index, Level1Quantizer {
     int parallel_mode;
     const int PARALLEL_MODE_NO_HEAP_INIT = 1024;
 
+    /** Skip the probed lists that can't hold a result beating the
+     * current top-k, L2 with a flat quantizer only. The vectors of a
+     * list lie on its side of the bisector of its centroid and of the
+     * centroid nearest to the query, which bounds their distance to the
+     * query. The nprobe lists are then a cap the easy queries stop short
+     * of. Exact for IndexIVFFlat, the codes of the other indexes may
+     * land slightly off the cell of their vector.
+     */
+    bool prune_lists = false;
+
     /** optional map that maps back ids to invlist entries. This
      *  enables reconstruct() */
     DirectMap direct_map;
@@ -205,11 +224,32 @@ struct IndexIVF: Index, Level1Quantizer {
                                                    const IVFSearchParameters *params = nullptr,
                                                    ConcurrentBitsetPtr bitset = nullptr);
 
+    /** search_preassigned with parallel_mode 3, returns false without
+     * searching if the lists are not shared enough to pay off */
+    bool search_preassigned_list_major (idx_t n, const float *x, idx_t k,
+                                        const idx_t *assign,
+                                        const float *centroid_dis,
+                                        float *distances, idx_t *labels,
+                                        const IVFSearchParameters *params,
+                                        ConcurrentBitsetPtr bitset) const;
+
     /** assign the vectors, then call search_preassign */
     void search (idx_t n, const float *x, idx_t k,
                  float *distances, idx_t *labels,
                  ConcurrentBitsetPtr bitset = nullptr) const override;
 
+    /** Similar to search, but only keeps the results beating bounds[i]
+     * for query i, the remaining results are -1 at distance bounds[i]
+     *
+     * @param bounds  size n, nullptr keeps all the results
+     * @param cancel  if set, the search stops once it turns true
+     */
+    void search_bounded (idx_t n, const float *x, idx_t k,
+                         float *distances, idx_t *labels,
+                         const float *bounds,
+                         ConcurrentBitsetPtr bitset = nullptr,
+                         const std::atomic<bool> *cancel = nullptr) const;
+
     /** Similar to search, but does not store codes **/
     void search_without_codes (idx_t n, const float *x, 
                                const uint8_t *arranged_codes, std::vector<size_t> prefix_sum, 
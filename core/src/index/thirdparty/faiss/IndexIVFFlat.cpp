@@ -158,9 +158,10 @@ template<MetricType metric, class C>
 struct IVFFlatScanner: InvertedListScanner {
     size_t d;
     bool store_pairs;
+    FvecKernels kernels;
 
     IVFFlatScanner(size_t d, bool store_pairs):
-        d(d), store_pairs(store_pairs) {}
+        d(d), store_pairs(store_pairs), kernels(fvec_kernels_for_dim(d)) {}
 
     const float *xi;
     void set_query (const float *query) override {
@@ -175,7 +176,7 @@ struct IVFFlatScanner: InvertedListScanner {
     float distance_to_code (const uint8_t *code) const override {
         const float *yj = (float*)code;
         float dis = metric == METRIC_INNER_PRODUCT ?
-            fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+            kernels.inner_product (xi, yj, d) : kernels.L2sqr (xi, yj, d);
         return dis;
     }
 
@@ -188,18 +189,40 @@ struct IVFFlatScanner: InvertedListScanner {
     {
         const float *list_vecs = (const float*)codes;
         size_t nup = 0;
+
+        // gather unfiltered codes in groups of 4 so each load of the
+        // query feeds four distance accumulators, the distances of 16
+        // codes are then offered to the heap at once
+        const size_t nbuf_max = 16;
+        size_t buf[nbuf_max];
+        float dis[nbuf_max];
+        size_t nbuf = 0;
+        auto id_of = [&] (size_t b) -> int64_t {
+            return store_pairs ? (list_no << 32 | buf[b]) : ids[buf[b]];
+        };
+        fvec_batch_4_func_ptr batch_4 = metric == METRIC_INNER_PRODUCT ?
+                                        kernels.inner_product_batch_4 : kernels.L2sqr_batch_4;
         for (size_t j = 0; j < list_size; j++) {
-            if (!bitset || !bitset->test(ids[j])) {
-                const float * yj = list_vecs + d * j;
-                float dis = metric == METRIC_INNER_PRODUCT ?
-                            fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
-                if (C::cmp (simi[0], dis)) {
-                    int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
-                    heap_swap_top<C> (k, simi, idxi, dis, id);
-                    nup++;
-                }
+            if (bitset && bitset->test(ids[j])) {
+                continue;
+            }
+            buf[nbuf++] = j;
+            if (nbuf % 4 == 0) {
+                size_t *b = buf + nbuf - 4;
+                float *dis_b = dis + nbuf - 4;
+                batch_4 (xi, list_vecs + d * b[0], list_vecs + d * b[1],
+                         list_vecs + d * b[2], list_vecs + d * b[3], d,
+                         dis_b[0], dis_b[1], dis_b[2], dis_b[3]);
             }
+            if (nbuf == nbuf_max) {
+                nup += heap_addn_filtered<C> (k, simi, idxi, dis, nbuf, id_of);
+                nbuf = 0;
+            }
+        }
+        for (size_t b = nbuf / 4 * 4; b < nbuf; b++) {
+            dis[b] = distance_to_code ((const uint8_t*)(list_vecs + d * buf[b]));
         }
+        nup += heap_addn_filtered<C> (k, simi, idxi, dis, nbuf, id_of);
         return nup;
     }
 
@@ -212,9 +235,12 @@ struct IVFFlatScanner: InvertedListScanner {
     {
         const float *list_vecs = (const float*)codes;
         for (size_t j = 0; j < list_size; j++) {
+            if (bitset && bitset->test(ids[j])) {
+                continue;
+            }
             const float * yj = list_vecs + d * j;
             float dis = metric == METRIC_INNER_PRODUCT ?
-                fvec_inner_product (xi, yj, d) : fvec_L2sqr (xi, yj, d);
+                kernels.inner_product (xi, yj, d) : kernels.L2sqr (xi, yj, d);
             if (C::cmp (radius, dis)) {
                 int64_t id = store_pairs ? lo_build (list_no, j) : ids[j];
                 res.add (dis, id);
@@ -801,12 +801,13 @@ struct KnnSearchResults {
 
     size_t nup;
 
-    inline void add (idx_t j, float dis, ConcurrentBitsetPtr bitset = nullptr) {
+    inline idx_t id_of (size_t j) const {
+        return ids ? ids[j] : lo_build (key, j);
+    }
+
+    inline void add (idx_t j, float dis) {
         if (C::cmp (heap_sim[0], dis)) {
-            idx_t id = ids ? ids[j] : lo_build (key, j);
-            if (bitset != nullptr && bitset->test((faiss::ConcurrentBitset::id_type_t)id))
-                return;
-            heap_swap_top<C> (k, heap_sim, heap_ids, dis, id);
+            heap_swap_top<C> (k, heap_sim, heap_ids, dis, id_of (j));
             nup++;
         }
     }
@@ -822,10 +823,13 @@ struct RangeSearchResults {
     float radius;
     RangeQueryResult & rres;
 
-    inline void add (idx_t j, float dis, faiss::ConcurrentBitsetPtr bitset = nullptr) {
+    inline idx_t id_of (size_t j) const {
+        return ids ? ids[j] : lo_build (key, j);
+    }
+
+    inline void add (idx_t j, float dis) {
         if (C::cmp (radius, dis)) {
-            idx_t id = ids ? ids[j] : lo_build (key, j);
-            rres.add (dis, id);
+            rres.add (dis, id_of (j));
         }
     }
 };
@@ -864,6 +868,35 @@ struct IVFPQScannerT: QueryTables {
         }
     }
 
+    /// Calls scan_one (j, code) on the entries of the list that are not
+    /// deleted. The bitset is tested before any distance is computed,
+    /// for 64 entries at a time, so that a block of deleted entries is
+    /// skipped without decoding its codes.
+    template<class SearchResultType, class ScanOne>
+    void scan_live (size_t ncode, const uint8_t *codes,
+                    const SearchResultType & res,
+                    const ConcurrentBitsetPtr & bitset,
+                    ScanOne scan_one) const
+    {
+        size_t code_size = pq.code_size;
+        for (size_t j0 = 0; j0 < ncode; j0 += 64) {
+            size_t n = std::min (ncode - j0, (size_t)64);
+            uint64_t live = n == 64 ? ~(uint64_t)0 : ((uint64_t)1 << n) - 1;
+            if (bitset) {
+                for (size_t b = 0; b < n; b++) {
+                    if (bitset->test (res.id_of (j0 + b))) {
+                        live &= ~((uint64_t)1 << b);
+                    }
+                }
+            }
+            while (live) {
+                size_t j = j0 + __builtin_ctzll (live);
+                live &= live - 1;
+                scan_one (j, codes + j * code_size);
+            }
+        }
+    }
+
     /*****************************************************
      * Scaning the codes: simple PQ scan.
      *****************************************************/
@@ -874,9 +907,9 @@ struct IVFPQScannerT: QueryTables {
                                SearchResultType & res,
                                ConcurrentBitsetPtr bitset = nullptr) const
     {
-        for (size_t j = 0; j < ncode; j++) {
-            PQDecoder decoder(codes, pq.nbits);
-            codes += pq.code_size;
+        scan_live (ncode, codes, res, bitset,
+                   [&] (size_t j, const uint8_t *code) {
+            PQDecoder decoder(code, pq.nbits);
             float dis = dis0;
             const float *tab = sim_table;
 
@@ -885,8 +918,8 @@ struct IVFPQScannerT: QueryTables {
                 tab += pq.ksub;
             }
 
-            res.add(j, dis, bitset);
-        }
+            res.add(j, dis);
+        });
     }
 
 
@@ -897,9 +930,9 @@ struct IVFPQScannerT: QueryTables {
                                  SearchResultType & res,
                                  faiss::ConcurrentBitsetPtr bitset = nullptr) const
     {
-        for (size_t j = 0; j < ncode; j++) {
-            PQDecoder decoder(codes, pq.nbits);
-            codes += pq.code_size;
+        scan_live (ncode, codes, res, bitset,
+                   [&] (size_t j, const uint8_t *code) {
+            PQDecoder decoder(code, pq.nbits);
 
             float dis = dis0;
             const float *tab = sim_table_2;
@@ -909,8 +942,8 @@ struct IVFPQScannerT: QueryTables {
                 dis += sim_table_ptrs [m][ci] - 2 * tab [ci];
                 tab += pq.ksub;
             }
-            res.add (j, dis, bitset);
-        }
+            res.add (j, dis);
+        });
     }
 
 
@@ -935,10 +968,9 @@ struct IVFPQScannerT: QueryTables {
             dis0 = 0;
         }
 
-        for (size_t j = 0; j < ncode; j++) {
-
-            pq.decode (codes, decoded_vec);
-            codes += pq.code_size;
+        scan_live (ncode, codes, res, bitset,
+                   [&] (size_t j, const uint8_t *code) {
+            pq.decode (code, decoded_vec);
 
             float dis;
             if (METRIC_TYPE == METRIC_INNER_PRODUCT) {
@@ -946,8 +978,8 @@ struct IVFPQScannerT: QueryTables {
             } else {
                 dis = fvec_L2sqr (decoded_vec, dvec, d);
             }
-            res.add (j, dis, bitset);
-        }
+            res.add (j, dis);
+        });
     }
 
     /*****************************************************
@@ -967,12 +999,12 @@ struct IVFPQScannerT: QueryTables {
 
         HammingComputer hc (q_code.data(), code_size);
 
-        for (size_t j = 0; j < ncode; j++) {
-            const uint8_t *b_code = codes;
-            int hd = hc.hamming (b_code);
+        scan_live (ncode, codes, res, bitset,
+                   [&] (size_t j, const uint8_t *code) {
+            int hd = hc.hamming (code);
             if (hd < ht) {
                 n_hamming_pass ++;
-                PQDecoder decoder(codes, pq.nbits);
+                PQDecoder decoder(code, pq.nbits);
 
                 float dis = dis0;
                 const float *tab = sim_table;
@@ -982,10 +1014,9 @@ struct IVFPQScannerT: QueryTables {
                     tab += pq.ksub;
                 }
 
-                res.add (j, dis, bitset);
+                res.add (j, dis);
             }
-            codes += code_size;
-        }
+        });
 #pragma omp critical
         {
             indexIVFPQ_stats.n_hamming_pass += n_hamming_pass;
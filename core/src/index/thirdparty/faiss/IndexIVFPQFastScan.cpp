@@ -0,0 +1,404 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/IndexIVFPQFastScan.h>
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+
+#ifdef __SSE4_1__
+#include <immintrin.h>
+#endif
+
+#include <faiss/FaissHook.h>
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/distances.h>
+#include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/AuxIndexStructures.h>
+
+namespace faiss {
+
+/*****************************************
+ * IndexIVFPQFastScan implementation
+ ******************************************/
+
+IndexIVFPQFastScan::IndexIVFPQFastScan (Index * quantizer, size_t d,
+                                        size_t nlist, size_t M,
+                                        MetricType metric):
+    IndexIVFPQ (quantizer, d, nlist, M, 4, metric),
+    packed_codes (nlist), packed_sizes (nlist, 0)
+{
+    // the uint16 accumulators hold up to M * 255
+    FAISS_THROW_IF_NOT (M <= 256);
+}
+
+IndexIVFPQFastScan::IndexIVFPQFastScan ()
+{}
+
+void IndexIVFPQFastScan::add_with_ids (idx_t n, const float * x,
+                                       const idx_t *xids)
+{
+    IndexIVFPQ::add_with_ids (n, x, xids);
+    repack ();
+}
+
+void IndexIVFPQFastScan::reset ()
+{
+    IndexIVFPQ::reset ();
+    packed_codes.assign (nlist, std::vector<uint8_t> ());
+    packed_sizes.assign (nlist, 0);
+}
+
+size_t IndexIVFPQFastScan::remove_ids (const IDSelector& sel)
+{
+    size_t nremove = IndexIVFPQ::remove_ids (sel);
+    packed_sizes.assign (nlist, (size_t)-1);
+    repack ();
+    return nremove;
+}
+
+void IndexIVFPQFastScan::update_vectors (int nv, const idx_t *idx,
+                                         const float *v)
+{
+    IndexIVFPQ::update_vectors (nv, idx, v);
+    packed_sizes.assign (nlist, (size_t)-1);
+    repack ();
+}
+
+void IndexIVFPQFastScan::merge_from (IndexIVF &other, idx_t add_id)
+{
+    IndexIVFPQ::merge_from (other, add_id);
+    repack ();
+}
+
+void IndexIVFPQFastScan::repack ()
+{
+    packed_codes.resize (nlist);
+    packed_sizes.resize (nlist, (size_t)-1);
+
+#pragma omp parallel for
+    for (size_t list_no = 0; list_no < nlist; list_no++) {
+        if (packed_sizes[list_no] != invlists->list_size (list_no)) {
+            repack_list (list_no);
+        }
+    }
+}
+
+void IndexIVFPQFastScan::repack_list (size_t list_no)
+{
+    size_t M = pq.M;
+    size_t list_size = invlists->list_size (list_no);
+    size_t nblock = (list_size + bbs - 1) / bbs;
+    size_t block_size = M * bbs / 2;
+
+    std::vector<uint8_t> & packed = packed_codes[list_no];
+    packed.assign (nblock * block_size, 0);
+
+    if (list_size > 0) {
+        InvertedLists::ScopedCodes codes (invlists, list_no);
+        for (size_t j = 0; j < list_size; j++) {
+            const uint8_t *code = codes.get () + j * code_size;
+            uint8_t *block = packed.data () + (j / bbs) * block_size;
+            size_t t = j % bbs;
+            int shift = t < bbs / 2 ? 0 : 4;
+            for (size_t m = 0; m < M; m++) {
+                uint8_t c = (code[m >> 1] >> ((m & 1) * 4)) & 15;
+                block[m * (bbs / 2) + t % (bbs / 2)] |= c << shift;
+            }
+        }
+    }
+    packed_sizes[list_no] = list_size;
+}
+
+
+namespace {
+
+/// sums the uint8 tables of the M sub-quantizers over one block of
+/// bbs vectors. qlut holds M tables of 16 entries
+void accumulate_block (const uint8_t *block, const uint8_t *qlut,
+                       size_t M, uint16_t *out)
+{
+#ifdef __SSE4_1__
+    __m128i accu0 = _mm_setzero_si128 ();
+    __m128i accu1 = _mm_setzero_si128 ();
+    __m128i accu2 = _mm_setzero_si128 ();
+    __m128i accu3 = _mm_setzero_si128 ();
+    const __m128i mask = _mm_set1_epi8 (0xf);
+
+    for (size_t m = 0; m < M; m++) {
+        __m128i lut = _mm_loadu_si128 ((const __m128i*)(qlut + m * 16));
+        __m128i c = _mm_loadu_si128 ((const __m128i*)(block + m * 16));
+        __m128i clo = _mm_and_si128 (c, mask);
+        __m128i chi = _mm_and_si128 (_mm_srli_epi16 (c, 4), mask);
+
+        __m128i dlo = _mm_shuffle_epi8 (lut, clo);
+        __m128i dhi = _mm_shuffle_epi8 (lut, chi);
+
+        accu0 = _mm_add_epi16 (accu0, _mm_cvtepu8_epi16 (dlo));
+        accu1 = _mm_add_epi16 (accu1, _mm_cvtepu8_epi16 (_mm_srli_si128 (dlo, 8)));
+        accu2 = _mm_add_epi16 (accu2, _mm_cvtepu8_epi16 (dhi));
+        accu3 = _mm_add_epi16 (accu3, _mm_cvtepu8_epi16 (_mm_srli_si128 (dhi, 8)));
+    }
+
+    _mm_storeu_si128 ((__m128i*)(out + 0), accu0);
+    _mm_storeu_si128 ((__m128i*)(out + 8), accu1);
+    _mm_storeu_si128 ((__m128i*)(out + 16), accu2);
+    _mm_storeu_si128 ((__m128i*)(out + 24), accu3);
+#else
+    memset (out, 0, sizeof (*out) * 32);
+    for (size_t m = 0; m < M; m++) {
+        const uint8_t *lut = qlut + m * 16;
+        const uint8_t *c = block + m * 16;
+        for (size_t t = 0; t < 16; t++) {
+            out[t] += lut[c[t] & 15];
+            out[t + 16] += lut[c[t] >> 4];
+        }
+    }
+#endif
+}
+
+
+template<MetricType METRIC_TYPE, class C>
+struct IVFPQFastScanScanner: InvertedListScanner {
+    const IndexIVFPQFastScan & index;
+    const ProductQuantizer & pq;
+    bool store_pairs;
+
+    // query and list dependent state
+    const float *qi;
+    idx_t key;
+    float dis0;                  ///< added to all float table sums
+    std::vector<float> sim_table, ip_table, residual;
+    std::vector<uint8_t> qlut;   ///< sim_table quantized to uint8
+    float bias, delta, margin;   ///< dis ~= bias + delta * sum(qlut)
+    const uint8_t *list_codes;   ///< start of the list in invlists
+    bool packed;                 ///< packed copy is usable for this list
+
+    IVFPQFastScanScanner (const IndexIVFPQFastScan & index, bool store_pairs):
+        index (index), pq (index.pq), store_pairs (store_pairs),
+        qi (nullptr), key (-1), dis0 (0),
+        sim_table (pq.M * pq.ksub), ip_table (pq.M * pq.ksub),
+        residual (index.d), qlut (pq.M * pq.ksub),
+        bias (0), delta (1), margin (0),
+        list_codes (nullptr), packed (false)
+    {}
+
+    void set_query (const float *query) override {
+        qi = query;
+        if (index.metric_type == METRIC_INNER_PRODUCT) {
+            pq.compute_inner_prod_table (qi, sim_table.data ());
+        } else if (!index.by_residual) {
+            pq.compute_distance_table (qi, sim_table.data ());
+        } else if (index.use_precomputed_table == 1) {
+            pq.compute_inner_prod_table (qi, ip_table.data ());
+        }
+    }
+
+    void set_list (idx_t list_no, float coarse_dis) override {
+        key = list_no;
+        dis0 = 0;
+        if (index.by_residual) {
+            if (index.metric_type == METRIC_INNER_PRODUCT) {
+                index.quantizer->reconstruct (key, residual.data ());
+                dis0 = fvec_inner_product (qi, residual.data (), index.d);
+            } else if (index.use_precomputed_table == 1) {
+                dis0 = coarse_dis;
+                fvec_madd (pq.M * pq.ksub,
+                           &index.precomputed_table[key * pq.M * pq.ksub],
+                           -2.0, ip_table.data (), sim_table.data ());
+            } else {
+                index.quantizer->compute_residual (qi, residual.data (), key);
+                pq.compute_distance_table (residual.data (), sim_table.data ());
+            }
+        }
+
+        packed = index.packed_sizes.size () > (size_t)key &&
+                 index.packed_sizes[key] == index.invlists->list_size (key);
+        if (packed) {
+            InvertedLists::ScopedCodes codes (index.invlists, key);
+            list_codes = codes.get ();
+            quantize_table ();
+        }
+    }
+
+    /// 8-bit version of sim_table with a common step for all
+    /// sub-quantizers, so that the uint8 sums stay comparable
+    void quantize_table () {
+        size_t M = pq.M, ksub = pq.ksub;
+        float max_span = 0;
+        bias = dis0;
+        for (size_t m = 0; m < M; m++) {
+            const float *tab = sim_table.data () + m * ksub;
+            float tmin = *std::min_element (tab, tab + ksub);
+            float tmax = *std::max_element (tab, tab + ksub);
+            max_span = std::max (max_span, tmax - tmin);
+            bias += tmin;
+        }
+        delta = max_span > 0 ? max_span / 255 : 1;
+
+        float abs_sum = std::fabs (dis0);
+        for (size_t m = 0; m < M; m++) {
+            const float *tab = sim_table.data () + m * ksub;
+            float tmin = *std::min_element (tab, tab + ksub);
+            for (size_t j = 0; j < ksub; j++) {
+                float q = std::floor ((tab[j] - tmin) / delta + 0.5f);
+                qlut[m * ksub + j] = (uint8_t)std::min (std::max (q, 0.0f), 255.0f);
+            }
+            abs_sum += std::fabs (tmin) + max_span;
+        }
+        // rounding to the grid moves each term by at most delta / 2, plus
+        // slack for the float error of the two sums being compared
+        margin = M * delta * 0.5f + abs_sum * 1e-5f;
+    }
+
+    /// exact distance, summed in the same order as IndexIVFPQ
+    float exact_distance (const uint8_t *code) const {
+        float dis = dis0;
+        const float *tab = sim_table.data ();
+        for (size_t m = 0; m < pq.M; m++) {
+            dis += tab[(code[m >> 1] >> ((m & 1) * 4)) & 15];
+            tab += pq.ksub;
+        }
+        return dis;
+    }
+
+    float distance_to_code (const uint8_t *code) const override {
+        return exact_distance (code);
+    }
+
+    /// largest (L2) or smallest (IP) uint8 sum that may still enter the heap
+    int64_t sum_threshold (float heap_top) const {
+        float t = (METRIC_TYPE == METRIC_L2 ? heap_top - bias + margin
+                             : heap_top - bias - margin) / delta;
+        if (!(t > -1)) {
+            return -1;
+        }
+        if (!(t < 65536)) {
+            return 65536;
+        }
+        return (int64_t)std::floor (t);
+    }
+
+    inline void add_result (size_t j, float dis, const idx_t *ids,
+                            float *heap_sim, idx_t *heap_ids, size_t k,
+                            ConcurrentBitsetPtr & bitset, size_t & nup) const {
+        if (C::cmp (heap_sim[0], dis)) {
+            idx_t id = store_pairs ? lo_build (key, j) : ids[j];
+            if (bitset != nullptr &&
+                bitset->test ((faiss::ConcurrentBitset::id_type_t)id)) {
+                return;
+            }
+            heap_swap_top<C> (k, heap_sim, heap_ids, dis, id);
+            nup++;
+        }
+    }
+
+    size_t scan_codes (size_t ncode,
+                       const uint8_t *codes,
+                       const idx_t *ids,
+                       float *heap_sim, idx_t *heap_ids,
+                       size_t k,
+                       ConcurrentBitsetPtr bitset) const override
+    {
+        size_t nup = 0;
+        size_t code_size = pq.code_size;
+        size_t bbs = IndexIVFPQFastScan::bbs;
+
+        // position of this range in the list, a chunk may start mid-list
+        size_t offset = 0;
+        bool use_packed = packed && codes >= list_codes &&
+                          (codes - list_codes) % code_size == 0;
+        if (use_packed) {
+            offset = (codes - list_codes) / code_size;
+            use_packed = offset + ncode <= index.packed_sizes[key];
+        }
+
+        size_t j = 0;
+        if (use_packed) {
+            const uint8_t *packed_list = index.packed_codes[key].data ();
+            size_t block_size = pq.M * bbs / 2;
+            uint16_t sums[32];
+
+            // codes before the first full block go through the float path
+            size_t head = std::min (ncode, (bbs - offset % bbs) % bbs);
+            for (; j < head; j++) {
+                add_result (j, exact_distance (codes + j * code_size), ids,
+                            heap_sim, heap_ids, k, bitset, nup);
+            }
+
+            // the last block of the list is zero-padded, so a partial
+            // block is accumulated the same way
+            int64_t thr = sum_threshold (heap_sim[0]);
+            for (; j < ncode; j += bbs) {
+                accumulate_block (packed_list + (offset + j) / bbs * block_size,
+                                  qlut.data (), pq.M, sums);
+                size_t nt = std::min (bbs, ncode - j);
+                for (size_t t = 0; t < nt; t++) {
+                    bool pass = METRIC_TYPE == METRIC_L2 ? sums[t] <= thr : sums[t] >= thr;
+                    if (!pass) {
+                        continue;
+                    }
+                    size_t jt = j + t;
+                    float dis = exact_distance (codes + jt * code_size);
+                    size_t nup0 = nup;
+                    add_result (jt, dis, ids, heap_sim, heap_ids, k, bitset, nup);
+                    if (nup != nup0) {
+                        thr = sum_threshold (heap_sim[0]);
+                    }
+                }
+            }
+        }
+
+        for (; j < ncode; j++) {
+            add_result (j, exact_distance (codes + j * code_size), ids,
+                        heap_sim, heap_ids, k, bitset, nup);
+        }
+        return nup;
+    }
+
+    void scan_codes_range (size_t ncode,
+                           const uint8_t *codes,
+                           const idx_t *ids,
+                           float radius,
+                           RangeQueryResult & rres,
+                           ConcurrentBitsetPtr bitset = nullptr) const override
+    {
+        for (size_t j = 0; j < ncode; j++) {
+            if (bitset && !store_pairs && bitset->test(ids[j])) {
+                continue;
+            }
+            float dis = exact_distance (codes + j * pq.code_size);
+            if (C::cmp (radius, dis)) {
+                idx_t id = store_pairs ? lo_build (key, j) : ids[j];
+                rres.add (dis, id);
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+
+InvertedListScanner *
+IndexIVFPQFastScan::get_InvertedListScanner (bool store_pairs) const
+{
+    if (metric_type == METRIC_INNER_PRODUCT) {
+        return new IVFPQFastScanScanner<METRIC_INNER_PRODUCT, CMin<float, idx_t> > (*this, store_pairs);
+    } else if (metric_type == METRIC_L2) {
+        return new IVFPQFastScanScanner<METRIC_L2, CMax<float, idx_t> > (*this, store_pairs);
+    }
+    return nullptr;
+}
+
+
+} // namespace faiss
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#ifndef FAISS_INDEX_IVFPQ_FAST_SCAN_H
+#define FAISS_INDEX_IVFPQ_FAST_SCAN_H
+
+#include <vector>
+
+#include <faiss/IndexIVFPQ.h>
+
+
+namespace faiss {
+
+/** IVFPQ with 4-bit sub-quantizer codes that are scanned with SIMD
+ * in-register table lookups.
+ *
+ * Besides the regular inverted lists, each list keeps a copy of its
+ * codes transposed in blocks of bbs vectors: for sub-quantizer m, the
+ * 16 bytes of a block hold the codes of vectors 0..15 in the low
+ * nibbles and of vectors 16..31 in the high nibbles, so a single
+ * pshufb over a 16-entry uint8 table looks up 16 vectors at once.
+ *
+ * The uint8 tables only give a bounded approximation of the distance.
+ * Vectors whose approximation can still enter the result heap are
+ * rescored with the float tables, so results match IndexIVFPQ with
+ * nbits = 4.
+ */
+struct IndexIVFPQFastScan: IndexIVFPQ {
+    static const size_t bbs = 32;  ///< vectors per packed block
+
+    /// per list, ceil(list_size / bbs) blocks of pq.M * bbs / 2 bytes
+    std::vector<std::vector<uint8_t> > packed_codes;
+
+    /// list sizes at the time the lists were packed. A list whose
+    /// size changed since is scanned without the packed codes
+    std::vector<size_t> packed_sizes;
+
+    IndexIVFPQFastScan (Index * quantizer, size_t d, size_t nlist,
+                        size_t M, MetricType metric = METRIC_L2);
+
+    IndexIVFPQFastScan ();
+
+    void add_with_ids (idx_t n, const float* x, const idx_t* xids = nullptr)
+        override;
+
+    void reset () override;
+
+    size_t remove_ids (const IDSelector& sel) override;
+
+    void update_vectors (int nv, const idx_t *idx, const float *v) override;
+
+    void merge_from (IndexIVF &other, idx_t add_id) override;
+
+    /// rebuild the packed copy of the lists whose size changed
+    void repack ();
+
+    /// rebuild the packed copy of one list
+    void repack_list (size_t list_no);
+
+    InvertedListScanner *get_InvertedListScanner (bool store_pairs)
+        const override;
+};
+
+
+} // namespace faiss
+
+
+#endif
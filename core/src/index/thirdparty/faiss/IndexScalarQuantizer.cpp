@@ -36,6 +36,7 @@ IndexScalarQuantizer::IndexScalarQuantizer
 {
     is_trained =
         qtype == QuantizerType::QT_fp16 ||
+        qtype == QuantizerType::QT_bf16 ||
         qtype == QuantizerType::QT_8bit_direct;
     code_size = sq.code_size;
 }
@@ -272,14 +272,15 @@ IndexShardsTemplate<IndexT>::search(idx_t n,
   std::vector<idx_t> all_labels(nshard * k * n);
 
   auto fn =
-    [n, k, x, &all_distances, &all_labels](int no, const IndexT *index) {
+    [n, k, x, &all_distances, &all_labels, &bitset](int no, const IndexT *index) {
       if (index->verbose) {
         printf ("begin query shard %d on %ld points\n", no, n);
       }
 
       index->search (n, x, k,
                      all_distances.data() + no * k * n,
-                     all_labels.data() + no * k * n);
+                     all_labels.data() + no * k * n,
+                     bitset);
 
       if (index->verbose) {
         printf ("end query shard %d\n", no);
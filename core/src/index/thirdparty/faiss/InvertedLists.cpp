@@ -10,8 +10,13 @@
 #include <faiss/InvertedLists.h>
 
 #include <cstdio>
+#include <algorithm>
 #include <numeric>
 
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <faiss/utils/HugePage.h>
 #include <faiss/utils/utils.h>
 #include <faiss/impl/FaissAssert.h>
 
@@ -302,6 +307,8 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(size_t nlist,
 #ifdef USE_CPU
     readonly_codes.reserve(total_size * code_size);
     readonly_ids.reserve(total_size);
+    advise_huge_page(readonly_codes.data(), readonly_codes.capacity());
+    advise_huge_page(readonly_ids.data(), readonly_ids.capacity() * sizeof(idx_t));
 #endif
 
     size_t offset = 0;
@@ -324,6 +331,10 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(const ArrayInvertedLists&
     }
 
 #ifdef USE_CPU
+    readonly_ids.reserve(offset);
+    readonly_codes.reserve(offset * code_size);
+    advise_huge_page(readonly_ids.data(), readonly_ids.capacity() * sizeof(idx_t));
+    advise_huge_page(readonly_codes.data(), readonly_codes.capacity());
     for (auto i = 0; i < other.ids.size(); i++) {
         auto& list_ids = other.ids[i];
         readonly_ids.insert(readonly_ids.end(), list_ids.begin(), list_ids.end());
@@ -913,5 +924,56 @@ void MaskedInvertedLists::prefetch_lists (
 }
 
 
+/*****************************************
+ * MappedInvertedLists implementation
+ ******************************************/
+
+MappedInvertedLists::MappedInvertedLists (size_t nlist, size_t code_size):
+    ReadOnlyInvertedLists (nlist, code_size),
+    lists (nlist, List {0, nullptr, nullptr})
+{}
+
+size_t MappedInvertedLists::list_size(size_t list_no) const
+{
+    FAISS_ASSERT(list_no < nlist);
+    return lists[list_no].size;
+}
+
+const uint8_t * MappedInvertedLists::get_codes (size_t list_no) const
+{
+    FAISS_ASSERT(list_no < nlist);
+    return lists[list_no].codes;
+}
+
+const InvertedLists::idx_t * MappedInvertedLists::get_ids (size_t list_no) const
+{
+    FAISS_ASSERT(list_no < nlist);
+    return lists[list_no].ids;
+}
+
+void MappedInvertedLists::prefetch_lists (
+       const idx_t *list_nos, int nlist) const
+{
+    static const uintptr_t page_mask = ~(uintptr_t)(sysconf (_SC_PAGESIZE) - 1);
+
+    // a batch of queries probes the same lists many times
+    std::vector<idx_t> probed (list_nos, list_nos + nlist);
+    std::sort (probed.begin(), probed.end());
+    probed.erase (std::unique (probed.begin(), probed.end()), probed.end());
+
+    auto will_need = [] (const void *p, size_t nbytes) {
+        uintptr_t begin = (uintptr_t)p & page_mask;
+        madvise ((void*)begin, (uintptr_t)p + nbytes - begin, MADV_WILLNEED);
+    };
+    for (idx_t list_no : probed) {
+        if (list_no < 0) continue;
+        const List & l = lists[list_no];
+        if (l.size == 0) continue;
+        will_need (l.codes, l.size * code_size);
+        will_need (l.ids, l.size * sizeof (idx_t));
+    }
+}
+
+
 
 } // namespace faiss
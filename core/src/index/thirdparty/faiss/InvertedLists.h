@@ -402,6 +402,34 @@ struct VStackInvertedLists: ReadOnlyInvertedLists {
 };
 
 
+/** read-only inverted lists used in place in memory owned by someone
+ * else, typically the mapping of an index file. Only the list sizes and
+ * addresses live on the heap: the pages of a list are read from disk
+ * when it is first scanned and the page cache keeps the hot lists.
+ * prefetch_lists asks the kernel to read all the probed lists ahead.
+ *
+ * The ids are not necessarily 8-byte aligned in the serialized index. */
+struct MappedInvertedLists: ReadOnlyInvertedLists {
+    struct List {
+        size_t size;
+        const uint8_t *codes;
+        const idx_t *ids;
+    };
+    std::vector<List> lists;
+
+    /// keeps the memory the lists point to alive
+    std::shared_ptr<const void> owner;
+
+    MappedInvertedLists (size_t nlist, size_t code_size);
+
+    size_t list_size(size_t list_no) const override;
+    const uint8_t * get_codes (size_t list_no) const override;
+    const idx_t * get_ids (size_t list_no) const override;
+
+    void prefetch_lists (const idx_t *list_nos, int nlist) const override;
+};
+
+
 /** use the first inverted lists if they are non-empty otherwise use the second
  *
  * This is useful if il1 has a few inverted lists that are too long,
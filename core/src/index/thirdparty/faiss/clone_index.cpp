@@ -22,6 +22,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -71,6 +72,7 @@ VectorTransform *Cloner::clone_VectorTransform (const VectorTransform *vt)
 IndexIVF * Cloner::clone_IndexIVF (const IndexIVF *ivf)
 {
     TRYCLONE (IndexIVFPQR, ivf)
+    TRYCLONE (IndexIVFPQFastScan, ivf)
     TRYCLONE (IndexIVFPQ, ivf)
     TRYCLONE (IndexIVFFlat, ivf)
     TRYCLONE (IndexIVFScalarQuantizer, ivf)
@@ -106,6 +108,17 @@ Index *Cloner::clone_Index (const Index *index)
         } else if (auto *ails = dynamic_cast<const ReadOnlyArrayInvertedLists*>(ivf->invlists)) {
             res->invlists = new ReadOnlyArrayInvertedLists(*ails);
             res->own_invlists = true;
+        } else if (auto *mils = dynamic_cast<const MappedInvertedLists*>(ivf->invlists)) {
+            // the clone owns its lists and may modify them
+            auto ails = new ArrayInvertedLists(mils->nlist, mils->code_size);
+            for (size_t i = 0; i < mils->nlist; i++) {
+                size_t list_size = mils->list_size(i);
+                if (list_size > 0) {
+                    ails->add_entries(i, list_size, mils->get_ids(i), mils->get_codes(i));
+                }
+            }
+            res->invlists = ails;
+            res->own_invlists = true;
         } else {
             FAISS_THROW_MSG( "clone not supported for this type of inverted lists");
         }
@@ -217,6 +217,36 @@ GpuIndexIVFPQ::getPrecomputedCodes() const {
   return ivfpqConfig_.usePrecomputedTables;
 }
 
+void
+GpuIndexIVFPQ::setFloat16LookupTables(bool enable) {
+#ifndef FAISS_USE_FLOAT16
+  FAISS_THROW_IF_NOT_MSG(!enable, "float16 lookup tables are not supported");
+#endif
+
+  if (ivfpqConfig_.useFloat16LookupTables == enable) {
+    return;
+  }
+
+  // float32 tables may not fit in the shared memory
+  ivfpqConfig_.useFloat16LookupTables = enable;
+  try {
+    verifySettings_();
+  } catch (...) {
+    ivfpqConfig_.useFloat16LookupTables = !enable;
+    throw;
+  }
+
+  if (index_) {
+    DeviceScope scope(device_);
+    index_->setFloat16LookupTables(enable);
+  }
+}
+
+bool
+GpuIndexIVFPQ::getFloat16LookupTables() const {
+  return ivfpqConfig_.useFloat16LookupTables;
+}
+
 int
 GpuIndexIVFPQ::getNumSubQuantizers() const {
   return subQuantizers_;
@@ -75,6 +75,13 @@ class GpuIndexIVFPQ : public GpuIndexIVF {
   /// Are pre-computed codes enabled?
   bool getPrecomputedCodes() const;
 
+  /// Enable or disable float16 lookup tables, half the shared memory
+  /// of the list scans at a small precision loss
+  void setFloat16LookupTables(bool enable);
+
+  /// Are float16 lookup tables enabled?
+  bool getFloat16LookupTables() const;
+
   /// Return the number of sub-quantizers we are using
   int getNumSubQuantizers() const;
 
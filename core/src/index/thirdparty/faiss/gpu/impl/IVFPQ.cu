@@ -123,6 +123,26 @@ IVFPQ::setPrecomputedCodes(bool enable) {
   }
 }
 
+void
+IVFPQ::setFloat16LookupTables(bool enable) {
+#ifndef FAISS_USE_FLOAT16
+  FAISS_ASSERT(!enable);
+#endif
+
+  if (useFloat16LookupTables_ != enable) {
+    useFloat16LookupTables_ = enable;
+
+    // The precomputed terms are kept in the precision of the tables
+    if (precomputedCodes_) {
+      precomputedCode_ = std::move(DeviceTensor<float, 3, true>());
+#ifdef FAISS_USE_FLOAT16
+      precomputedCodeHalf_ = std::move(DeviceTensor<half, 3, true>());
+#endif
+      precomputeCodes_();
+    }
+  }
+}
+
 int
 IVFPQ::classifyAndAddVectors(Tensor<float, 2, true>& vecs,
                              Tensor<long, 1, true>& indices) {
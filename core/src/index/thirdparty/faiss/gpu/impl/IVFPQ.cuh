@@ -42,6 +42,9 @@ class IVFPQ : public IVFBase {
   /// Enable or disable pre-computed codes
   void setPrecomputedCodes(bool enable);
 
+  /// Enable or disable float16 lookup tables and precomputed terms
+  void setFloat16LookupTables(bool enable);
+
   /// Adds a set of codes and indices to a list; the data can be
   /// resident on either the host or the device
   void addCodeVectorsFromCpu(int listId,
@@ -133,7 +136,7 @@ class IVFPQ : public IVFBase {
 
   /// Do we maintain precomputed terms and lookup tables in float16
   /// form?
-  const bool useFloat16LookupTables_;
+  bool useFloat16LookupTables_;
 
   /// On the GPU, we prefer different PQ centroid data layouts for
   /// different purposes.
@@ -58,6 +58,7 @@ ScalarQuantizer::ScalarQuantizer
         code_size = (d * 6 + 7) / 8;
         break;
     case QuantizerType::QT_fp16:
+    case QuantizerType::QT_bf16:
         code_size = d * 2;
         break;
     }
@@ -90,6 +91,7 @@ void ScalarQuantizer::train (size_t n, const float *x)
                           n, d, 1 << bit_per_dim, x, trained);
         break;
     case QuantizerType::QT_fp16:
+    case QuantizerType::QT_bf16:
     case QuantizerType::QT_8bit_direct:
         // no training necessary
         break;
@@ -128,7 +130,7 @@ void ScalarQuantizer::train_residual(size_t n,
 Quantizer *ScalarQuantizer::select_quantizer () const
 {
     /* use hook to decide use AVX512 or not */
-    sq_sel_quantizer(qtype, d, trained);
+    return sq_sel_quantizer(qtype, d, trained);
 }
 
 
@@ -140,13 +140,15 @@ struct IVFSQScannerIP: InvertedListScanner {
                            RangeQueryResult & res,
                            ConcurrentBitsetPtr bitset = nullptr) const override
     {
-        for (size_t j = 0; j < list_size; j++) {
+        for (size_t j = 0; j < list_size; j++, codes += code_size) {
+            if (bitset && bitset->test(ids[j])) {
+                continue;
+            }
             float accu = accu0 + dc.query_to_code (codes);
             if (accu > radius) {
                 int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
                 res.add (accu, id);
             }
-            codes += code_size;
         }
     }
 };
@@ -227,13 +229,15 @@ struct IVFSQScannerL2: InvertedListScanner {
                            RangeQueryResult & res,
                            ConcurrentBitsetPtr bitset = nullptr) const override
     {
-        for (size_t j = 0; j < list_size; j++) {
+        for (size_t j = 0; j < list_size; j++, codes += code_size) {
+            if (bitset && bitset->test(ids[j])) {
+                continue;
+            }
             float dis = dc.query_to_code (codes);
             if (dis < radius) {
                 int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
                 res.add (dis, id);
             }
-            codes += code_size;
         }
     }
 };
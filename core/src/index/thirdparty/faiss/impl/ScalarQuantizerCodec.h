@@ -210,6 +210,39 @@ struct QuantizerFP16<1>: Quantizer {
 };
 
 
+/*******************************************************************
+ * BF16 quantizer
+ *******************************************************************/
+
+template<int SIMDWIDTH>
+struct QuantizerBF16 {};
+
+template<>
+struct QuantizerBF16<1>: Quantizer {
+    const size_t d;
+
+    QuantizerBF16(size_t d, const std::vector<float> & /* unused */):
+        d(d) {}
+
+    void encode_vector(const float* x, uint8_t* code) const final {
+        for (size_t i = 0; i < d; i++) {
+            ((uint16_t*)code)[i] = encode_bf16(x[i]);
+        }
+    }
+
+    void decode_vector(const uint8_t* code, float* x) const final {
+        for (size_t i = 0; i < d; i++) {
+            x[i] = decode_bf16(((uint16_t*)code)[i]);
+        }
+    }
+
+    float reconstruct_component (const uint8_t * code, int i) const
+    {
+        return decode_bf16(((uint16_t*)code)[i]);
+    }
+};
+
+
 /*******************************************************************
  * 8bit_direct quantizer
  *******************************************************************/
@@ -262,6 +295,8 @@ Quantizer *select_quantizer_1 (
         return new QuantizerTemplate<Codec4bit, true, SIMDWIDTH>(d, trained);
     case QuantizerType::QT_fp16:
         return new QuantizerFP16<SIMDWIDTH> (d, trained);
+    case QuantizerType::QT_bf16:
+        return new QuantizerBF16<SIMDWIDTH> (d, trained);
     case QuantizerType::QT_8bit_direct:
         return new Quantizer8bitDirect<SIMDWIDTH> (d, trained);
     }
@@ -501,6 +536,10 @@ SQDistanceComputer *select_distance_computer (
         return new DCTemplate
             <QuantizerFP16<SIMDWIDTH>, Sim, SIMDWIDTH>(d, trained);
 
+    case QuantizerType::QT_bf16:
+        return new DCTemplate
+            <QuantizerBF16<SIMDWIDTH>, Sim, SIMDWIDTH>(d, trained);
+
     case QuantizerType::QT_8bit_direct:
         if (d % 16 == 0) {
             return new DistanceComputerByte<Sim, SIMDWIDTH>(d, trained);
@@ -567,6 +606,10 @@ InvertedListScanner* sel1_InvertedListScanner (
         return sel2_InvertedListScanner
             <DCTemplate<QuantizerFP16<SIMDWIDTH>, Similarity, SIMDWIDTH> >
             (sq, quantizer, store_pairs, r);
+    case QuantizerType::QT_bf16:
+        return sel2_InvertedListScanner
+            <DCTemplate<QuantizerBF16<SIMDWIDTH>, Similarity, SIMDWIDTH> >
+            (sq, quantizer, store_pairs, r);
     case QuantizerType::QT_8bit_direct:
         if (sq->d % 16 == 0) {
             return sel2_InvertedListScanner
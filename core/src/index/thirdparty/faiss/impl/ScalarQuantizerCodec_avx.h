@@ -149,6 +149,33 @@ struct QuantizerFP16_avx<8>: public QuantizerFP16<1> {
 };
 
 
+/*******************************************************************
+ * BF16 quantizer
+ *******************************************************************/
+
+template<int SIMDWIDTH>
+struct QuantizerBF16_avx {};
+
+template<>
+struct QuantizerBF16_avx<1> : public QuantizerBF16<1> {
+    QuantizerBF16_avx (size_t d, const std::vector<float> &unused) :
+        QuantizerBF16<1> (d, unused) {}
+};
+
+template<>
+struct QuantizerBF16_avx<8>: public QuantizerBF16<1> {
+    QuantizerBF16_avx (size_t d, const std::vector<float> &trained):
+        QuantizerBF16<1> (d, trained) {}
+
+    // a bf16 value is the upper half of the float32 bits
+    __m256 reconstruct_8_components (const uint8_t * code, int i) const {
+        __m128i codei = _mm_loadu_si128 ((const __m128i*)(code + 2 * i));
+        __m256i bits = _mm256_slli_epi32 (_mm256_cvtepu16_epi32 (codei), 16);
+        return _mm256_castsi256_ps (bits);
+    }
+};
+
+
 /*******************************************************************
  * 8bit_direct quantizer
  *******************************************************************/
@@ -190,6 +217,8 @@ Quantizer *select_quantizer_1_avx (QuantizerType qtype, size_t d,
             return new QuantizerTemplate_avx<Codec4bit_avx, true, SIMDWIDTH>(d, trained);
         case QuantizerType::QT_fp16:
             return new QuantizerFP16_avx<SIMDWIDTH>(d, trained);
+        case QuantizerType::QT_bf16:
+            return new QuantizerBF16_avx<SIMDWIDTH>(d, trained);
         case QuantizerType::QT_8bit_direct:
             return new Quantizer8bitDirect_avx<SIMDWIDTH>(d, trained);
     }
@@ -446,6 +475,113 @@ struct DistanceComputerByte_avx<Similarity, 8> : SQDistanceComputer {
 };
 
 
+/*******************************************************************
+ * DC8bitFolded: distance computer for 8-bit codes that folds the
+ * per-dimension scale and offset into the query in set_query, so a
+ * code component costs one conversion and one multiply-add instead
+ * of a full decode
+ *******************************************************************/
+
+template<class Similarity, bool uniform, int SIMDWIDTH>
+struct DC8bitFolded_avx : SQDistanceComputer {};
+
+template<class Similarity, bool uniform>
+struct DC8bitFolded_avx<Similarity, uniform, 1> :
+    public DCTemplate_avx<QuantizerTemplate_avx<Codec8bit_avx, uniform, 1>, Similarity, 1> {
+    DC8bitFolded_avx(size_t d, const std::vector<float> &trained) :
+        DCTemplate_avx<QuantizerTemplate_avx<Codec8bit_avx, uniform, 1>, Similarity, 1>(d, trained) {}
+};
+
+template<class Similarity, bool uniform>
+struct DC8bitFolded_avx<Similarity, uniform, 8> : SQDistanceComputer {
+    using Sim = Similarity;
+
+    size_t d;
+    std::vector<float> scale;    // component = offset + scale * code
+    std::vector<float> offset;
+    std::vector<float> qfold;    // IP: q * scale, L2: q - offset
+    float accu0;                 // IP: q . offset
+
+    DC8bitFolded_avx(size_t d, const std::vector<float> &trained):
+        d(d), scale(d), offset(d), qfold(d), accu0(0) {
+        for (size_t i = 0; i < d; i++) {
+            float vmin = uniform ? trained[0] : trained[i];
+            float vdiff = uniform ? trained[1] : trained[d + i];
+            scale[i] = vdiff / 255.f;
+            offset[i] = vmin + 0.5f * scale[i];
+        }
+    }
+
+    static __m256 load_8_codes (const uint8_t *code, size_t i) {
+        __m256i i8 = _mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((const __m128i*)(code + i)));
+        return _mm256_cvtepi32_ps (i8);
+    }
+
+    void set_query (const float *x) final {
+        q = x;
+        accu0 = 0;
+        for (size_t i = 0; i < d; i++) {
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                qfold[i] = x[i] * scale[i];
+                accu0 += x[i] * offset[i];
+            } else {
+                qfold[i] = x[i] - offset[i];
+            }
+        }
+    }
+
+    __m256 term_8 (const uint8_t * code, size_t i) const {
+        __m256 ci = load_8_codes (code, i);
+        __m256 qi = _mm256_loadu_ps (qfold.data() + i);
+        if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+            return qi * ci;
+        }
+        __m256 tmp = qi - ci * _mm256_loadu_ps (scale.data() + i);
+        return tmp * tmp;
+    }
+
+    float query_to_code (const uint8_t * code) const {
+        // two accumulators so consecutive adds do not wait on each other
+        __m256 accu_a = _mm256_setzero_ps();
+        __m256 accu_b = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= d; i += 16) {
+            accu_a += term_8 (code, i);
+            accu_b += term_8 (code, i + 8);
+        }
+        if (i < d) {
+            accu_a += term_8 (code, i);
+        }
+        Similarity sim(nullptr);
+        sim.begin_8();
+        sim.accu8 = accu_a + accu_b;
+        return accu0 + sim.result_8();
+    }
+
+    float compute_code_distance(const uint8_t* code1, const uint8_t* code2) const {
+        Similarity sim(nullptr);
+        sim.begin_8();
+        for (size_t i = 0; i < d; i += 8) {
+            __m256 si = _mm256_loadu_ps (scale.data() + i);
+            __m256 oi = _mm256_loadu_ps (offset.data() + i);
+            sim.add_8_components_2 (oi + load_8_codes (code1, i) * si,
+                                    oi + load_8_codes (code2, i) * si);
+        }
+        return sim.result_8();
+    }
+
+    /// compute distance of vector i to current query
+    float operator () (idx_t i) final {
+        return query_to_code (codes + i * code_size);
+    }
+
+    float symmetric_dis (idx_t i, idx_t j) override {
+        return compute_code_distance (codes + i * code_size,
+                                      codes + j * code_size);
+    }
+};
+
+
 /*******************************************************************
  * select_distance_computer: runtime selection of template
  * specialization
@@ -459,16 +595,14 @@ SQDistanceComputer *select_distance_computer_avx (
     constexpr int SIMDWIDTH = Sim::simdwidth;
     switch(qtype) {
         case QuantizerType::QT_8bit_uniform:
-            return new DCTemplate_avx<QuantizerTemplate_avx<Codec8bit_avx, true, SIMDWIDTH>,
-                    Sim, SIMDWIDTH>(d, trained);
+            return new DC8bitFolded_avx<Sim, true, SIMDWIDTH>(d, trained);
 
         case QuantizerType::QT_4bit_uniform:
             return new DCTemplate_avx<QuantizerTemplate_avx<Codec4bit_avx, true, SIMDWIDTH>,
                     Sim, SIMDWIDTH>(d, trained);
 
         case QuantizerType::QT_8bit:
-            return new DCTemplate_avx<QuantizerTemplate_avx<Codec8bit_avx, false, SIMDWIDTH>,
-                    Sim, SIMDWIDTH>(d, trained);
+            return new DC8bitFolded_avx<Sim, false, SIMDWIDTH>(d, trained);
 
         case QuantizerType::QT_6bit:
             return new DCTemplate_avx<QuantizerTemplate_avx<Codec6bit_avx, false, SIMDWIDTH>,
@@ -482,6 +616,10 @@ SQDistanceComputer *select_distance_computer_avx (
             return new DCTemplate_avx
                     <QuantizerFP16_avx<SIMDWIDTH>, Sim, SIMDWIDTH>(d, trained);
 
+        case QuantizerType::QT_bf16:
+            return new DCTemplate_avx
+                    <QuantizerBF16_avx<SIMDWIDTH>, Sim, SIMDWIDTH>(d, trained);
+
         case QuantizerType::QT_8bit_direct:
             if (d % 16 == 0) {
                 return new DistanceComputerByte_avx<Sim, SIMDWIDTH>(d, trained);
@@ -522,14 +660,14 @@ InvertedListScanner* sel1_InvertedListScanner_avx (
     constexpr int SIMDWIDTH = Similarity::simdwidth;
     switch(sq->qtype) {
     case QuantizerType::QT_8bit_uniform:
-        return sel12_InvertedListScanner_avx
-            <Similarity, Codec8bit_avx, true>(sq, quantizer, store_pairs, r);
+        return sel2_InvertedListScanner_avx
+            <DC8bitFolded_avx<Similarity, true, SIMDWIDTH> >(sq, quantizer, store_pairs, r);
     case QuantizerType::QT_4bit_uniform:
         return sel12_InvertedListScanner_avx
             <Similarity, Codec4bit_avx, true>(sq, quantizer, store_pairs, r);
     case QuantizerType::QT_8bit:
-        return sel12_InvertedListScanner_avx
-            <Similarity, Codec8bit_avx, false>(sq, quantizer, store_pairs, r);
+        return sel2_InvertedListScanner_avx
+            <DC8bitFolded_avx<Similarity, false, SIMDWIDTH> >(sq, quantizer, store_pairs, r);
     case QuantizerType::QT_4bit:
         return sel12_InvertedListScanner_avx
             <Similarity, Codec4bit_avx, false>(sq, quantizer, store_pairs, r);
@@ -540,6 +678,10 @@ InvertedListScanner* sel1_InvertedListScanner_avx (
         return sel2_InvertedListScanner_avx
             <DCTemplate_avx<QuantizerFP16_avx<SIMDWIDTH>, Similarity, SIMDWIDTH> >
             (sq, quantizer, store_pairs, r);
+    case QuantizerType::QT_bf16:
+        return sel2_InvertedListScanner_avx
+            <DCTemplate_avx<QuantizerBF16_avx<SIMDWIDTH>, Similarity, SIMDWIDTH> >
+            (sq, quantizer, store_pairs, r);
     case QuantizerType::QT_8bit_direct:
         if (sq->d % 16 == 0) {
             return sel2_InvertedListScanner_avx
@@ -191,6 +191,38 @@ struct QuantizerFP16_avx512<16>: public QuantizerFP16_avx<8> {
     }
 };
 
+/*******************************************************************
+ * BF16 quantizer
+ *******************************************************************/
+
+template<int SIMDWIDTH>
+struct QuantizerBF16_avx512 {};
+
+template<>
+struct QuantizerBF16_avx512<1> : public QuantizerBF16_avx<1> {
+    QuantizerBF16_avx512(size_t d, const std::vector<float> &unused) :
+        QuantizerBF16_avx<1> (d, unused) {}
+};
+
+template<>
+struct QuantizerBF16_avx512<8> : public QuantizerBF16_avx<8> {
+    QuantizerBF16_avx512 (size_t d, const std::vector<float> &trained) :
+        QuantizerBF16_avx<8> (d, trained) {}
+};
+
+template<>
+struct QuantizerBF16_avx512<16>: public QuantizerBF16_avx<8> {
+    QuantizerBF16_avx512 (size_t d, const std::vector<float> &trained):
+        QuantizerBF16_avx<8> (d, trained) {}
+
+    // a bf16 value is the upper half of the float32 bits
+    __m512 reconstruct_16_components (const uint8_t * code, int i) const {
+        __m256i codei = _mm256_loadu_si256 ((const __m256i*)(code + 2 * i));
+        __m512i bits = _mm512_slli_epi32 (_mm512_cvtepu16_epi32 (codei), 16);
+        return _mm512_castsi512_ps (bits);
+    }
+};
+
 /*******************************************************************
  * 8bit_direct quantizer
  *******************************************************************/
@@ -240,6 +272,8 @@ Quantizer *select_quantizer_1_avx512 (QuantizerType qtype, size_t d,
             return new QuantizerTemplate_avx512<Codec4bit_avx512, true, SIMDWIDTH>(d, trained);
         case QuantizerType::QT_fp16:
             return new QuantizerFP16_avx512<SIMDWIDTH>(d, trained);
+        case QuantizerType::QT_bf16:
+            return new QuantizerBF16_avx512<SIMDWIDTH>(d, trained);
         case QuantizerType::QT_8bit_direct:
             return new Quantizer8bitDirect_avx512<SIMDWIDTH>(d, trained);
     }
@@ -530,6 +564,116 @@ struct DistanceComputerByte_avx512<Similarity, 16> : SQDistanceComputer {
 };
 
 
+/*******************************************************************
+ * DC8bitFolded: 8-bit codes with the per-dimension scale and offset
+ * folded into the query, see DC8bitFolded_avx
+ *******************************************************************/
+
+template<class Similarity, bool uniform, int SIMDWIDTH>
+struct DC8bitFolded_avx512 : SQDistanceComputer {};
+
+template<class Similarity, bool uniform>
+struct DC8bitFolded_avx512<Similarity, uniform, 1> : public DC8bitFolded_avx<Similarity, uniform, 1> {
+    DC8bitFolded_avx512(size_t d, const std::vector<float> &trained) :
+        DC8bitFolded_avx<Similarity, uniform, 1>(d, trained) {}
+};
+
+template<class Similarity, bool uniform>
+struct DC8bitFolded_avx512<Similarity, uniform, 8> : public DC8bitFolded_avx<Similarity, uniform, 8> {
+    DC8bitFolded_avx512(size_t d, const std::vector<float> &trained) :
+        DC8bitFolded_avx<Similarity, uniform, 8>(d, trained) {}
+};
+
+template<class Similarity, bool uniform>
+struct DC8bitFolded_avx512<Similarity, uniform, 16> : SQDistanceComputer {
+    using Sim = Similarity;
+
+    size_t d;
+    std::vector<float> scale;    // component = offset + scale * code
+    std::vector<float> offset;
+    std::vector<float> qfold;    // IP: q * scale, L2: q - offset
+    float accu0;                 // IP: q . offset
+
+    DC8bitFolded_avx512(size_t d, const std::vector<float> &trained):
+        d(d), scale(d), offset(d), qfold(d), accu0(0) {
+        for (size_t i = 0; i < d; i++) {
+            float vmin = uniform ? trained[0] : trained[i];
+            float vdiff = uniform ? trained[1] : trained[d + i];
+            scale[i] = vdiff / 255.f;
+            offset[i] = vmin + 0.5f * scale[i];
+        }
+    }
+
+    static __m512 load_16_codes (const uint8_t *code, size_t i) {
+        __m512i i16 = _mm512_cvtepu8_epi32 (_mm_loadu_si128 ((const __m128i*)(code + i)));
+        return _mm512_cvtepi32_ps (i16);
+    }
+
+    void set_query (const float *x) final {
+        q = x;
+        accu0 = 0;
+        for (size_t i = 0; i < d; i++) {
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                qfold[i] = x[i] * scale[i];
+                accu0 += x[i] * offset[i];
+            } else {
+                qfold[i] = x[i] - offset[i];
+            }
+        }
+    }
+
+    __m512 term_16 (const uint8_t * code, size_t i) const {
+        __m512 ci = load_16_codes (code, i);
+        __m512 qi = _mm512_loadu_ps (qfold.data() + i);
+        if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+            return qi * ci;
+        }
+        __m512 tmp = qi - ci * _mm512_loadu_ps (scale.data() + i);
+        return tmp * tmp;
+    }
+
+    float query_to_code (const uint8_t * code) const {
+        // two accumulators so consecutive adds do not wait on each other
+        __m512 accu_a = _mm512_setzero_ps();
+        __m512 accu_b = _mm512_setzero_ps();
+        size_t i = 0;
+        for (; i + 32 <= d; i += 32) {
+            accu_a += term_16 (code, i);
+            accu_b += term_16 (code, i + 16);
+        }
+        if (i < d) {
+            accu_a += term_16 (code, i);
+        }
+        Similarity sim(nullptr);
+        sim.begin_16();
+        sim.accu16 = accu_a + accu_b;
+        return accu0 + sim.result_16();
+    }
+
+    float compute_code_distance(const uint8_t* code1, const uint8_t* code2) const {
+        Similarity sim(nullptr);
+        sim.begin_16();
+        for (size_t i = 0; i < d; i += 16) {
+            __m512 si = _mm512_loadu_ps (scale.data() + i);
+            __m512 oi = _mm512_loadu_ps (offset.data() + i);
+            sim.add_16_components_2 (oi + load_16_codes (code1, i) * si,
+                                     oi + load_16_codes (code2, i) * si);
+        }
+        return sim.result_16();
+    }
+
+    /// compute distance of vector i to current query
+    float operator () (idx_t i) final {
+        return query_to_code (codes + i * code_size);
+    }
+
+    float symmetric_dis (idx_t i, idx_t j) override {
+        return compute_code_distance (codes + i * code_size,
+                                      codes + j * code_size);
+    }
+};
+
+
 /*******************************************************************
  * select_distance_computer: runtime selection of template
  * specialization
@@ -543,16 +687,14 @@ SQDistanceComputer *select_distance_computer_avx512 (
     constexpr int SIMDWIDTH = Sim::simdwidth;
     switch(qtype) {
         case QuantizerType::QT_8bit_uniform:
-            return new DCTemplate_avx512<QuantizerTemplate_avx512<Codec8bit_avx512, true, SIMDWIDTH>,
-                    Sim, SIMDWIDTH>(d, trained);
+            return new DC8bitFolded_avx512<Sim, true, SIMDWIDTH>(d, trained);
 
         case QuantizerType::QT_4bit_uniform:
             return new DCTemplate_avx512<QuantizerTemplate_avx512<Codec4bit_avx512, true, SIMDWIDTH>,
                     Sim, SIMDWIDTH>(d, trained);
 
         case QuantizerType::QT_8bit:
-            return new DCTemplate_avx512<QuantizerTemplate_avx512<Codec8bit_avx512, false, SIMDWIDTH>,
-                    Sim, SIMDWIDTH>(d, trained);
+            return new DC8bitFolded_avx512<Sim, false, SIMDWIDTH>(d, trained);
 
         case QuantizerType::QT_6bit:
             return new DCTemplate_avx512<QuantizerTemplate_avx512<Codec6bit_avx512, false, SIMDWIDTH>,
@@ -566,6 +708,10 @@ SQDistanceComputer *select_distance_computer_avx512 (
             return new DCTemplate_avx512
                     <QuantizerFP16_avx512<SIMDWIDTH>, Sim, SIMDWIDTH>(d, trained);
 
+        case QuantizerType::QT_bf16:
+            return new DCTemplate_avx512
+                    <QuantizerBF16_avx512<SIMDWIDTH>, Sim, SIMDWIDTH>(d, trained);
+
         case QuantizerType::QT_8bit_direct:
             if (d % 16 == 0) {
                 return new DistanceComputerByte_avx512<Sim, SIMDWIDTH>(d, trained);
@@ -607,14 +753,14 @@ InvertedListScanner* sel1_InvertedListScanner_avx512 (
     constexpr int SIMDWIDTH = Similarity::simdwidth;
     switch(sq->qtype) {
     case QuantizerType::QT_8bit_uniform:
-        return sel12_InvertedListScanner_avx512
-            <Similarity, Codec8bit_avx512, true>(sq, quantizer, store_pairs, r);
+        return sel2_InvertedListScanner_avx512
+            <DC8bitFolded_avx512<Similarity, true, SIMDWIDTH> >(sq, quantizer, store_pairs, r);
     case QuantizerType::QT_4bit_uniform:
         return sel12_InvertedListScanner_avx512
             <Similarity, Codec4bit_avx512, true>(sq, quantizer, store_pairs, r);
     case QuantizerType::QT_8bit:
-        return sel12_InvertedListScanner_avx512
-            <Similarity, Codec8bit_avx512, false>(sq, quantizer, store_pairs, r);
+        return sel2_InvertedListScanner_avx512
+            <DC8bitFolded_avx512<Similarity, false, SIMDWIDTH> >(sq, quantizer, store_pairs, r);
     case QuantizerType::QT_4bit:
         return sel12_InvertedListScanner_avx512
             <Similarity, Codec4bit_avx512, false>(sq, quantizer, store_pairs, r);
@@ -625,6 +771,10 @@ InvertedListScanner* sel1_InvertedListScanner_avx512 (
         return sel2_InvertedListScanner_avx512
             <DCTemplate_avx512<QuantizerFP16_avx512<SIMDWIDTH>, Similarity, SIMDWIDTH> >
             (sq, quantizer, store_pairs, r);
+    case QuantizerType::QT_bf16:
+        return sel2_InvertedListScanner_avx512
+            <DCTemplate_avx512<QuantizerBF16_avx512<SIMDWIDTH>, Similarity, SIMDWIDTH> >
+            (sq, quantizer, store_pairs, r);
     case QuantizerType::QT_8bit_direct:
         if (sq->d % 16 == 0) {
             return sel2_InvertedListScanner_avx512
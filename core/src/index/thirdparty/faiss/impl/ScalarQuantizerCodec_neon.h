@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#pragma once
+
+#include <vector>
+#include <arm_neon.h>
+
+#include <faiss/impl/ScalarQuantizer.h>
+#include <faiss/impl/ScalarQuantizerCodec.h>
+#include <faiss/MetricType.h>
+
+namespace faiss {
+
+/*******************************************************************
+ * DC8bitFolded_neon: distance computer for 8-bit codes that folds the
+ * per-dimension scale and offset into the query in set_query, so a
+ * code component costs one conversion and one multiply-add instead
+ * of a full decode. Only the metric of Similarity is used, the
+ * remaining components of d % 8 are computed in scalar code.
+ *******************************************************************/
+
+template<class Similarity, bool uniform>
+struct DC8bitFolded_neon : SQDistanceComputer {
+    using Sim = Similarity;
+
+    size_t d;
+    std::vector<float> scale;    // component = offset + scale * code
+    std::vector<float> offset;
+    std::vector<float> qfold;    // IP: q * scale, L2: q - offset
+    float accu0;                 // IP: q . offset
+
+    DC8bitFolded_neon(size_t d, const std::vector<float> &trained):
+        d(d), scale(d), offset(d), qfold(d), accu0(0) {
+        for (size_t i = 0; i < d; i++) {
+            float vmin = uniform ? trained[0] : trained[i];
+            float vdiff = uniform ? trained[1] : trained[d + i];
+            scale[i] = vdiff / 255.f;
+            offset[i] = vmin + 0.5f * scale[i];
+        }
+    }
+
+    // widens 8 codes to two vectors of 4 floats
+    static void load_8_codes (const uint8_t *code, size_t i,
+                              float32x4_t& lo, float32x4_t& hi) {
+        uint16x8_t c16 = vmovl_u8 (vld1_u8 (code + i));
+        lo = vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (c16)));
+        hi = vcvtq_f32_u32 (vmovl_high_u16 (c16));
+    }
+
+    void set_query (const float *x) final {
+        q = x;
+        accu0 = 0;
+        for (size_t i = 0; i < d; i++) {
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                qfold[i] = x[i] * scale[i];
+                accu0 += x[i] * offset[i];
+            } else {
+                qfold[i] = x[i] - offset[i];
+            }
+        }
+    }
+
+    float query_to_code (const uint8_t * code) const {
+        const float *qf = qfold.data();
+        const float *sc = scale.data();
+        // two accumulators so consecutive fma do not wait on each other
+        float32x4_t accu_a = vdupq_n_f32 (0);
+        float32x4_t accu_b = vdupq_n_f32 (0);
+        size_t i = 0;
+        for (; i + 8 <= d; i += 8) {
+            float32x4_t c0, c1;
+            load_8_codes (code, i, c0, c1);
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                accu_a = vfmaq_f32 (accu_a, vld1q_f32 (qf + i), c0);
+                accu_b = vfmaq_f32 (accu_b, vld1q_f32 (qf + i + 4), c1);
+            } else {
+                float32x4_t t0 = vfmsq_f32 (vld1q_f32 (qf + i), c0, vld1q_f32 (sc + i));
+                float32x4_t t1 = vfmsq_f32 (vld1q_f32 (qf + i + 4), c1, vld1q_f32 (sc + i + 4));
+                accu_a = vfmaq_f32 (accu_a, t0, t0);
+                accu_b = vfmaq_f32 (accu_b, t1, t1);
+            }
+        }
+        float accu = accu0 + vaddvq_f32 (vaddq_f32 (accu_a, accu_b));
+        for (; i < d; i++) {
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                accu += qf[i] * code[i];
+            } else {
+                float tmp = qf[i] - sc[i] * code[i];
+                accu += tmp * tmp;
+            }
+        }
+        return accu;
+    }
+
+    float compute_code_distance (const uint8_t* code1, const uint8_t* code2) const {
+        float accu = 0;
+        for (size_t i = 0; i < d; i++) {
+            float x1 = offset[i] + scale[i] * code1[i];
+            float x2 = offset[i] + scale[i] * code2[i];
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                accu += x1 * x2;
+            } else {
+                accu += (x1 - x2) * (x1 - x2);
+            }
+        }
+        return accu;
+    }
+
+    /// compute distance of vector i to current query
+    float operator () (idx_t i) final {
+        return query_to_code (codes + i * code_size);
+    }
+
+    float symmetric_dis (idx_t i, idx_t j) override {
+        return compute_code_distance (codes + i * code_size,
+                                      codes + j * code_size);
+    }
+};
+
+} // namespace faiss
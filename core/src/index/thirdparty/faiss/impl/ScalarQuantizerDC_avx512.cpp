@@ -28,7 +28,7 @@ sq_get_distance_computer_avx512 (MetricType metric, QuantizerType qtype, size_t
         }
     } else {
         if (dim % 16 == 0) {
-            return select_distance_computer_avx512<SimilarityL2_avx512<16>>(qtype, dim, trained);
+            return select_distance_computer_avx512<SimilarityIP_avx512<16>>(qtype, dim, trained);
         } else if (dim % 8 == 0) {
             return select_distance_computer_avx512<SimilarityIP_avx512<8>>(qtype, dim, trained);
         } else {
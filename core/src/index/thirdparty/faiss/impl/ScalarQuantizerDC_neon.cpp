@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/impl/ScalarQuantizerDC_neon.h>
+#include <faiss/impl/ScalarQuantizerDC.h>
+#include <faiss/impl/FaissAssert.h>
+
+#ifdef __aarch64__
+#include <faiss/impl/ScalarQuantizerCodec_neon.h>
+#endif
+
+namespace faiss {
+
+/*******************************************************************
+ * ScalarQuantizer Distance Computer
+ *
+ * Only the 8-bit codecs have a NEON distance computer, the other
+ * quantizer types and the encoders use the reference implementation
+ ********************************************************************/
+
+#ifdef __aarch64__
+
+SQDistanceComputer *
+sq_get_distance_computer_neon (MetricType metric, QuantizerType qtype, size_t dim, const std::vector<float>& trained) {
+    bool is_ip = (metric != METRIC_L2);
+    switch (qtype) {
+        case QuantizerType::QT_8bit_uniform:
+            if (is_ip) {
+                return new DC8bitFolded_neon<SimilarityIP<1>, true>(dim, trained);
+            }
+            return new DC8bitFolded_neon<SimilarityL2<1>, true>(dim, trained);
+        case QuantizerType::QT_8bit:
+            if (is_ip) {
+                return new DC8bitFolded_neon<SimilarityIP<1>, false>(dim, trained);
+            }
+            return new DC8bitFolded_neon<SimilarityL2<1>, false>(dim, trained);
+        default:
+            return sq_get_distance_computer_ref (metric, qtype, dim, trained);
+    }
+}
+
+Quantizer *
+sq_select_quantizer_neon (QuantizerType qtype, size_t dim, const std::vector<float>& trained) {
+    return sq_select_quantizer_ref (qtype, dim, trained);
+}
+
+InvertedListScanner*
+sq_select_inverted_list_scanner_neon (MetricType mt, const ScalarQuantizer *sq, const Index *quantizer, size_t dim, bool store_pairs, bool by_residual) {
+    if (mt != METRIC_L2 && mt != METRIC_INNER_PRODUCT) {
+        FAISS_THROW_MSG("unsupported metric type");
+    }
+    bool is_ip = (mt == METRIC_INNER_PRODUCT);
+    switch (sq->qtype) {
+        case QuantizerType::QT_8bit_uniform:
+            if (is_ip) {
+                return sel2_InvertedListScanner<DC8bitFolded_neon<SimilarityIP<1>, true> >
+                    (sq, quantizer, store_pairs, by_residual);
+            }
+            return sel2_InvertedListScanner<DC8bitFolded_neon<SimilarityL2<1>, true> >
+                (sq, quantizer, store_pairs, by_residual);
+        case QuantizerType::QT_8bit:
+            if (is_ip) {
+                return sel2_InvertedListScanner<DC8bitFolded_neon<SimilarityIP<1>, false> >
+                    (sq, quantizer, store_pairs, by_residual);
+            }
+            return sel2_InvertedListScanner<DC8bitFolded_neon<SimilarityL2<1>, false> >
+                (sq, quantizer, store_pairs, by_residual);
+        default:
+            return sq_select_inverted_list_scanner_ref (mt, sq, quantizer, dim, store_pairs, by_residual);
+    }
+}
+
+#else
+
+SQDistanceComputer *
+sq_get_distance_computer_neon (MetricType metric, QuantizerType qtype, size_t dim, const std::vector<float>& trained) {
+    FAISS_ASSERT(false);
+    return nullptr;
+}
+
+Quantizer *
+sq_select_quantizer_neon (QuantizerType qtype, size_t dim, const std::vector<float>& trained) {
+    FAISS_ASSERT(false);
+    return nullptr;
+}
+
+InvertedListScanner*
+sq_select_inverted_list_scanner_neon (MetricType mt, const ScalarQuantizer *sq, const Index *quantizer, size_t dim, bool store_pairs, bool by_residual) {
+    FAISS_ASSERT(false);
+    return nullptr;
+}
+
+#endif
+
+} // namespace faiss
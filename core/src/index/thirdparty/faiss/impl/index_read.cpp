@@ -19,6 +19,7 @@
 
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/impl/io.h>
+#include <faiss/utils/HugePage.h>
 #include <faiss/utils/hamming.h>
 
 #include <faiss/IndexFlat.h>
@@ -29,6 +30,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -234,6 +236,9 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         std::vector<size_t> sizes (ails->nlist);
         read_ArrayInvertedLists_sizes (f, sizes);
         for (size_t i = 0; i < ails->nlist; i++) {
+            // advised before resize() touches the pages
+            ails->codes[i].reserve (sizes[i] * ails->code_size);
+            advise_huge_page (ails->codes[i].data(), ails->codes[i].capacity());
             ails->ids[i].resize (sizes[i]);
             ails->codes[i].resize (sizes[i] * ails->code_size);
         }
@@ -245,6 +250,59 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
             }
         }
         return ails;
+    } else if (h == fourcc ("iloa") && (io_flags & IO_FLAG_MMAP) &&
+               dynamic_cast<MappedIOReader*>(f)) {
+        // used in place: all the ids, then all the codes, in list order
+        MappedIOReader *reader = dynamic_cast<MappedIOReader*>(f);
+        size_t nlist;
+        size_t code_size;
+        std::vector <size_t> list_length;
+        READ1(nlist);
+        READ1(code_size);
+        READVECTOR(list_length);
+        size_t n;
+        READ1(n);
+        size_t nbytes = n * (sizeof(InvertedLists::idx_t) + code_size);
+        FAISS_THROW_IF_NOT(nbytes <= reader->total - reader->rp);
+
+        auto ails = new MappedInvertedLists (nlist, code_size);
+        ails->owner = reader->owner;
+        auto ids = (const InvertedLists::idx_t*)(reader->data + reader->rp);
+        auto codes = reader->data + reader->rp + n * sizeof(InvertedLists::idx_t);
+        size_t o = 0;
+        for (size_t i = 0; i < nlist; i++) {
+            MappedInvertedLists::List & l = ails->lists[i];
+            l.size = list_length[i];
+            l.ids = ids + o;
+            l.codes = codes + o * code_size;
+            o += l.size;
+        }
+        FAISS_THROW_IF_NOT(o == n);
+        reader->rp += nbytes;
+        return ails;
+    } else if (h == fourcc ("ilar") && (io_flags & IO_FLAG_MMAP) &&
+               dynamic_cast<MappedIOReader*>(f)) {
+        // used in place: the codes then the ids of each list
+        MappedIOReader *reader = dynamic_cast<MappedIOReader*>(f);
+        size_t nlist;
+        size_t code_size;
+        READ1 (nlist);
+        READ1 (code_size);
+        std::vector<size_t> sizes (nlist);
+        read_ArrayInvertedLists_sizes (f, sizes);
+
+        auto ails = new MappedInvertedLists (nlist, code_size);
+        ails->owner = reader->owner;
+        for (size_t i = 0; i < nlist; i++) {
+            MappedInvertedLists::List & l = ails->lists[i];
+            size_t nbytes = sizes[i] * (code_size + sizeof(InvertedLists::idx_t));
+            FAISS_THROW_IF_NOT(nbytes <= reader->total - reader->rp);
+            l.size = sizes[i];
+            l.codes = reader->data + reader->rp;
+            l.ids = (const InvertedLists::idx_t*)(l.codes + l.size * code_size);
+            reader->rp += nbytes;
+        }
+        return ails;
     } else if (h == fourcc ("ilar") && (io_flags & IO_FLAG_MMAP)) {
         // then we load it as an OnDiskInvertedLists
 
@@ -527,7 +585,10 @@ static IndexIVFPQ *read_ivfpq (IOReader *f, uint32_t h, int io_flags)
     IndexIVFPQR *ivfpqr =
         h == fourcc ("IvQR") || h == fourcc ("IwQR") ?
         new IndexIVFPQR () : nullptr;
-    IndexIVFPQ * ivpq = ivfpqr ? ivfpqr : new IndexIVFPQ ();
+    IndexIVFPQFastScan *ivfpqfs =
+        h == fourcc ("IwP4") ? new IndexIVFPQFastScan () : nullptr;
+    IndexIVFPQ * ivpq = ivfpqr ? ivfpqr :
+                        ivfpqfs ? ivfpqfs : new IndexIVFPQ ();
 
     std::vector<std::vector<Index::idx_t> > ids;
     read_ivf_header (ivpq, f, legacy ? &ids : nullptr);
@@ -554,6 +615,9 @@ static IndexIVFPQ *read_ivfpq (IOReader *f, uint32_t h, int io_flags)
             READ1 (ivfpqr->k_factor);
         }
     }
+    if (ivfpqfs) {
+        ivfpqfs->repack ();
+    }
     return ivpq;
 }
 
@@ -728,7 +792,8 @@ Index *read_index (IOReader *f, int io_flags) {
         read_InvertedLists (ivsp, f, io_flags);
         idx = ivsp;
     } else if(h == fourcc ("IvPQ") || h == fourcc ("IvQR") ||
-              h == fourcc ("IwPQ") || h == fourcc ("IwQR")) {
+              h == fourcc ("IwPQ") || h == fourcc ("IwQR") ||
+              h == fourcc ("IwP4")) {
 
         idx = read_ivfpq (f, h, io_flags);
 
@@ -29,6 +29,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -499,8 +500,11 @@ void write_index (const Index *idx, IOWriter *f) {
     } else if(const IndexIVFPQ * ivpq =
               dynamic_cast<const IndexIVFPQ *> (idx)) {
         const IndexIVFPQR * ivfpqr = dynamic_cast<const IndexIVFPQR *> (idx);
+        const IndexIVFPQFastScan * ivfpqfs =
+            dynamic_cast<const IndexIVFPQFastScan *> (idx);
 
-        uint32_t h = fourcc (ivfpqr ? "IwQR" : "IwPQ");
+        // the packed codes of IwP4 are rebuilt from the lists on read
+        uint32_t h = fourcc (ivfpqr ? "IwQR" : ivfpqfs ? "IwP4" : "IwPQ");
         WRITE1 (h);
         write_ivf_header (ivpq, f);
         WRITE1 (ivpq->by_residual);
@@ -684,8 +688,9 @@ static void write_binary_multi_hash_map(
         int b, size_t ntotal,
         IOWriter *f)
 {
+    // the list sizes are written with id_bits too, a list may hold all ntotal ids
     int id_bits = 0;
-    while ((ntotal > ((Index::idx_t)1 << id_bits))) {
+    while ((ntotal >= ((Index::idx_t)1 << id_bits))) {
         id_bits++;
     }
     WRITE1(id_bits);
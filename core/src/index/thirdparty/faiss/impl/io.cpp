@@ -65,6 +65,25 @@ size_t VectorIOReader::operator()(
 
 
 
+MappedIOReader::MappedIOReader (const uint8_t *data, size_t total,
+                                std::shared_ptr<const void> owner):
+    data (data), total (total), owner (std::move (owner))
+{}
+
+size_t MappedIOReader::operator()(
+                  void *ptr, size_t size, size_t nitems)
+{
+    if (rp >= total) return 0;
+    size_t nremain = (total - rp) / size;
+    if (nremain < nitems) nitems = nremain;
+    if (size * nitems > 0) {
+        memcpy (ptr, data + rp, size * nitems);
+        rp += size * nitems;
+    }
+    return nitems;
+}
+
+
 /***********************************************************************
  * IO File
  ***********************************************************************/
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <cstdio>
+#include <memory>
 #include <vector>
 
 #include <faiss/Index.h>
@@ -60,6 +61,21 @@ struct VectorIOReader:IOReader {
     size_t operator()(void *ptr, size_t size, size_t nitems) override;
 };
 
+/** reads memory that outlives the index read from it, such as the
+ * mapping of an index file. read_index with IO_FLAG_MMAP then uses the
+ * inverted lists in place instead of copying them */
+struct MappedIOReader: IOReader {
+    const uint8_t *data;
+    size_t total;
+    size_t rp = 0;
+    std::shared_ptr<const void> owner; ///< handed to the lists kept in data
+
+    MappedIOReader (const uint8_t *data, size_t total,
+                    std::shared_ptr<const void> owner);
+
+    size_t operator()(void *ptr, size_t size, size_t nitems) override;
+};
+
 struct VectorIOWriter:IOWriter {
     std::vector<uint8_t> data;
     size_t operator()(const void *ptr, size_t size, size_t nitems) override;
@@ -5,12 +5,17 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 
 #include <gtest/gtest.h>
 
+#include <faiss/FaissHook.h>
 #include <faiss/IndexBinaryFlat.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/utils/binary_distances_avx512.h>
 #include <faiss/utils/hamming.h>
 
 TEST(BinaryFlat, accuracy) {
@@ -62,3 +67,76 @@ TEST(BinaryFlat, accuracy) {
     }
   }
 }
+
+TEST(BinaryFlat, long_codes_simd) {
+  std::string cpu_flag;
+  faiss::hook_init(cpu_flag);
+
+  typedef int (*popcount_t)(const uint8_t*, const uint8_t*, size_t);
+  std::vector<std::vector<popcount_t>> kernels;
+  if (faiss::support_avx2()) {
+    kernels.push_back({faiss::bvec_popcount_xor_avx, faiss::bvec_popcount_and_avx,
+                       faiss::bvec_popcount_or_avx});
+  }
+  if (faiss::support_avx512_vpopcntdq()) {
+    kernels.push_back({faiss::bvec_popcount_xor_avx512, faiss::bvec_popcount_and_avx512,
+                       faiss::bvec_popcount_or_avx512});
+  }
+
+  srand(35);
+  // the sizes cover the Harley-Seal blocks, the 32/64 byte vectors and the tails
+  for (size_t n : {1, 31, 128, 200, 256, 511, 512, 1100}) {
+    std::vector<uint8_t> a(n), b(n);
+    for (size_t i = 0; i < n; i++) {
+      a[i] = rand() % 0x100;
+      b[i] = rand() % 0x100;
+    }
+    int ref_xor = faiss::bvec_popcount_xor_ref(a.data(), b.data(), n);
+    int ref_and = faiss::bvec_popcount_and_ref(a.data(), b.data(), n);
+    int ref_or = faiss::bvec_popcount_or_ref(a.data(), b.data(), n);
+    for (auto& k : kernels) {
+      EXPECT_EQ(ref_xor, k[0](a.data(), b.data(), n));
+      EXPECT_EQ(ref_and, k[1](a.data(), b.data(), n));
+      EXPECT_EQ(ref_or, k[2](a.data(), b.data(), n));
+    }
+
+    std::vector<uint8_t> c(n);
+    for (size_t i = 0; i < n; i++) {
+      c[i] = a[i] | b[i];
+    }
+    EXPECT_TRUE(faiss::bvec_substructure(a.data(), c.data(), n));
+    EXPECT_TRUE(faiss::bvec_superstructure(c.data(), b.data(), n));
+    c[n - 1] &= ~a[n - 1];
+    EXPECT_EQ(a[n - 1] == 0, faiss::bvec_substructure(a.data(), c.data(), n));
+  }
+
+  // 2048-bit fingerprints searched with the simd computers
+  int d = 2048;
+  size_t nb = 1000, nq = 20, code_size = d / 8;
+  std::vector<uint8_t> database(nb * code_size), queries(nq * code_size);
+  for (auto& x : database) x = rand() % 0x100;
+  for (auto& x : queries) x = rand() % 0x100;
+
+  for (auto metric : {faiss::METRIC_Hamming, faiss::METRIC_Jaccard}) {
+    faiss::IndexBinaryFlat index(d, metric);
+    index.add(nb, database.data());
+
+    int k = 5;
+    std::vector<faiss::IndexBinary::idx_t> nns(k * nq);
+    std::vector<int32_t> dis(k * nq);
+    index.search(nq, queries.data(), k, dis.data(), nns.data());
+
+    for (size_t i = 0; i < nq; ++i) {
+      faiss::HammingComputerM8 hc(queries.data() + i * code_size, code_size);
+      faiss::JaccardComputer256 jc(queries.data() + i * code_size, code_size);
+      float dist_min = 1e30;
+      for (size_t j = 0; j < nb; ++j) {
+        const uint8_t* y = database.data() + j * code_size;
+        float dist = metric == faiss::METRIC_Hamming ? hc.hamming(y) : jc.compute(y);
+        dist_min = std::min(dist_min, dist);
+      }
+      float got = metric == faiss::METRIC_Hamming ? dis[k * i] : *(float*)&dis[k * i];
+      EXPECT_EQ(dist_min, got);
+    }
+  }
+}
@@ -59,6 +59,12 @@ class IndexAccuracy(unittest.TestCase):
         assert (Iref != Inew).sum() < Iref.size / 5000.0
         assert np.all(Dref == Dnew)
 
+        # queries sharing the lists scan them together
+        ivfk.parallel_mode = 3
+        Dnew, Inew = ivfk.search(ev.xq, 100)
+        assert (Iref != Inew).sum() < Iref.size / 5000.0
+        assert np.all(Dref == Dnew)
+
     def test_indexLSH(self):
         q = faiss.IndexLSH(d, nbits)
         res = ev.launch('FLAT / LSH Cosine', q)
@@ -134,6 +134,11 @@ void binary_distence_knn_hc (
     switch (metric_type) {
     case METRIC_Jaccard:
     case METRIC_Tanimoto:
+        if (ncodes >= BINARY_SIMD_MIN_CODE_SIZE) {
+            binary_distence_knn_hc<faiss::JaccardComputerSIMD>
+                    (ncodes, ha, a, b, nb, order, true, bitset);
+            break;
+        }
         switch (ncodes) {
 #define binary_distence_knn_hc_jaccard(ncodes) \
         case ncodes: \
@@ -286,6 +291,11 @@ void binary_distence_knn_mc (
 
     switch (metric_type) {
     case METRIC_Substructure:
+        if (ncodes >= BINARY_SIMD_MIN_CODE_SIZE) {
+            binary_distence_knn_mc<faiss::SubstructureComputerSIMD>
+                    (ncodes, a, b, na, nb, k, distances, labels, bitset);
+            break;
+        }
         switch (ncodes) {
 #define binary_distence_knn_mc_Substructure(ncodes) \
         case ncodes: \
@@ -308,6 +318,11 @@ void binary_distence_knn_mc (
         break;
 
     case METRIC_Superstructure:
+        if (ncodes >= BINARY_SIMD_MIN_CODE_SIZE) {
+            binary_distence_knn_mc<faiss::SuperstructureComputerSIMD>
+                    (ncodes, a, b, na, nb, k, distances, labels, bitset);
+            break;
+        }
         switch (ncodes) {
 #define binary_distence_knn_mc_Superstructure(ncodes) \
         case ncodes: \
@@ -334,4 +349,63 @@ void binary_distence_knn_mc (
     }
 }
 
+int bvec_popcount_xor_ref (const uint8_t * a, const uint8_t * b, size_t n)
+{
+    int accu = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        accu += popcount64 (*(const uint64_t *)(a + i) ^ *(const uint64_t *)(b + i));
+    }
+    for (; i < n; i++) {
+        accu += popcount64 (a[i] ^ b[i]);
+    }
+    return accu;
+}
+
+int bvec_popcount_and_ref (const uint8_t * a, const uint8_t * b, size_t n)
+{
+    int accu = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        accu += popcount64 (*(const uint64_t *)(a + i) & *(const uint64_t *)(b + i));
+    }
+    for (; i < n; i++) {
+        accu += popcount64 (a[i] & b[i]);
+    }
+    return accu;
+}
+
+int bvec_popcount_or_ref (const uint8_t * a, const uint8_t * b, size_t n)
+{
+    int accu = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        accu += popcount64 (*(const uint64_t *)(a + i) | *(const uint64_t *)(b + i));
+    }
+    for (; i < n; i++) {
+        accu += popcount64 (a[i] | b[i]);
+    }
+    return accu;
+}
+
+bool bvec_substructure_ref (const uint8_t * a, const uint8_t * b, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if ((a[i] & b[i]) != a[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool bvec_superstructure_ref (const uint8_t * a, const uint8_t * b, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if ((a[i] & b[i]) != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace faiss
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <faiss/utils/Heap.h>
+#include <faiss/FaissHook.h>
 
 /* The binary distance type */
 typedef float tadis_t;
@@ -53,10 +54,116 @@ namespace faiss {
             int64_t *labels,
             ConcurrentBitsetPtr bitset);
 
+/// bit counts and inclusion tests on codes of any length, one 64-bit word at a time
+int bvec_popcount_xor_ref (const uint8_t * a, const uint8_t * b, size_t n);
+
+int bvec_popcount_and_ref (const uint8_t * a, const uint8_t * b, size_t n);
+
+int bvec_popcount_or_ref (const uint8_t * a, const uint8_t * b, size_t n);
+
+bool bvec_substructure_ref (const uint8_t * a, const uint8_t * b, size_t n);
+
+bool bvec_superstructure_ref (const uint8_t * a, const uint8_t * b, size_t n);
+
 } // namespace faiss
 
 #include <faiss/utils/jaccard-inl.h>
 #include <faiss/utils/substructure-inl.h>
 #include <faiss/utils/superstructure-inl.h>
 
+namespace faiss {
+
+/* Computers for long codes (fingerprints of 1024 bits and more), they
+ * call the bvec_* kernels picked by hook_init, the call is amortized
+ * over the length of the code */
+
+/// code size from which the binary searches switch to the SIMD computers
+static const int BINARY_SIMD_MIN_CODE_SIZE = 128;
+
+struct HammingComputerSIMD {
+    const uint8_t *a;
+    int n;
+
+    HammingComputerSIMD () {}
+
+    HammingComputerSIMD (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    inline int hamming (const uint8_t *b8) const {
+        return bvec_popcount_xor (a, b8, n);
+    }
+};
+
+struct JaccardComputerSIMD {
+    const uint8_t *a;
+    int n;
+
+    JaccardComputerSIMD () {}
+
+    JaccardComputerSIMD (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    inline float compute (const uint8_t *b8) const {
+        int accu_num = bvec_popcount_and (a, b8, n);
+        if (accu_num == 0)
+            return 1.0;
+        int accu_den = bvec_popcount_or (a, b8, n);
+        return 1.0 - (float)(accu_num) / (float)(accu_den);
+    }
+};
+
+struct SubstructureComputerSIMD {
+    const uint8_t *a;
+    int n;
+
+    SubstructureComputerSIMD () {}
+
+    SubstructureComputerSIMD (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    inline bool compute (const uint8_t *b8) const {
+        return bvec_substructure (a, b8, n);
+    }
+};
+
+struct SuperstructureComputerSIMD {
+    const uint8_t *a;
+    int n;
+
+    SuperstructureComputerSIMD () {}
+
+    SuperstructureComputerSIMD (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    inline bool compute (const uint8_t *b8) const {
+        return bvec_superstructure (a, b8, n);
+    }
+};
+
+} // namespace faiss
+
 #endif // FAISS_BINARY_DISTANCE_H
@@ -31,154 +31,138 @@ ConcurrentBitset::bitset() {
     return bitset_;
 }
 
-ConcurrentBitset&
-ConcurrentBitset::operator&=(ConcurrentBitset& bitset) {
-    //    for (id_type_t i = 0; i < ((capacity_ + 8 -1) >> 3); ++i) {
-    //        bitset_[i].fetch_and(bitset.bitset()[i].load());
-    //    }
-
-    auto u8_1 = const_cast<uint8_t*>(data());
-    auto u8_2 = const_cast<uint8_t*>(bitset.data());
-    auto u64_1 = reinterpret_cast<uint64_t*>(u8_1);
-    auto u64_2 = reinterpret_cast<uint64_t*>(u8_2);
-
-    size_t n8 = bitset_.size();
-    size_t n64 = n8 / 8;
+namespace {
 
-    for (size_t i = 0; i < n64; i++) {
-        u64_1[i] &= u64_2[i];
+struct AndOp {
+    template <typename T>
+    T
+    operator()(T a, T b) const {
+        return a & b;
     }
+};
 
-    size_t remain = n8 % 8;
-    u8_1 += n64 * 8;
-    u8_2 += n64 * 8;
-    for (size_t i = 0; i < remain; i++) {
-        u8_1[i] &= u8_2[i];
+struct OrOp {
+    template <typename T>
+    T
+    operator()(T a, T b) const {
+        return a | b;
     }
+};
 
-    return *this;
-}
-
-std::shared_ptr<ConcurrentBitset>
-ConcurrentBitset::operator&(std::shared_ptr<ConcurrentBitset>& bitset) {
-    auto result_bitset = std::make_shared<ConcurrentBitset>(bitset->capacity());
-
-    auto result_8 = const_cast<uint8_t*>(result_bitset->data());
-    auto result_64 = reinterpret_cast<uint64_t*>(result_8);
+struct XorOp {
+    template <typename T>
+    T
+    operator()(T a, T b) const {
+        return a ^ b;
+    }
+};
 
-    auto u8_1 = const_cast<uint8_t*>(data());
-    auto u8_2 = const_cast<uint8_t*>(bitset->data());
-    auto u64_1 = reinterpret_cast<uint64_t*>(u8_1);
-    auto u64_2 = reinterpret_cast<uint64_t*>(u8_2);
+struct AndNotOp {
+    template <typename T>
+    T
+    operator()(T a, T b) const {
+        return a & static_cast<T>(~b);
+    }
+};
 
-    size_t n8 = bitset_.size();
+// result = op(a, b) over n8 bytes, a word at a time and then byte by byte for the bytes past the last word,
+// result may alias a
+template <typename Op>
+void
+bitwise_op(uint8_t* result, const uint8_t* a, const uint8_t* b, size_t n8, Op op) {
     size_t n64 = n8 / 8;
-
+    auto result_64 = reinterpret_cast<uint64_t*>(result);
+    auto a_64 = reinterpret_cast<const uint64_t*>(a);
+    auto b_64 = reinterpret_cast<const uint64_t*>(b);
     for (size_t i = 0; i < n64; i++) {
-        result_64[i] = u64_1[i] & u64_2[i];
+        result_64[i] = op(a_64[i], b_64[i]);
     }
-
-    size_t remain = n8 % 8;
-    u8_1 += n64 * 8;
-    u8_2 += n64 * 8;
-    result_8 += n64 * 8;
-    for (size_t i = 0; i < remain; i++) {
-         result_8[i] = u8_1[i] & u8_2[i];
+    for (size_t i = n64 * 8; i < n8; i++) {
+        result[i] = op(a[i], b[i]);
     }
+}
+
+}  // namespace
 
+ConcurrentBitset&
+ConcurrentBitset::operator&=(ConcurrentBitset& bitset) {
+    bitwise_op(mutable_data(), data(), bitset.data(), size(), AndOp());
+    return *this;
+}
 
+std::shared_ptr<ConcurrentBitset>
+ConcurrentBitset::operator&(std::shared_ptr<ConcurrentBitset>& bitset) {
+    auto result_bitset = std::make_shared<ConcurrentBitset>(bitset->capacity());
+    bitwise_op(result_bitset->mutable_data(), data(), bitset->data(), size(), AndOp());
     return result_bitset;
 }
 
 ConcurrentBitset&
 ConcurrentBitset::operator|=(ConcurrentBitset& bitset) {
-    //    for (id_type_t i = 0; i < ((capacity_ + 8 -1) >> 3); ++i) {
-    //        bitset_[i].fetch_or(bitset.bitset()[i].load());
-    //    }
-
-    auto u8_1 = const_cast<uint8_t*>(data());
-    auto u8_2 = const_cast<uint8_t*>(bitset.data());
-    auto u64_1 = reinterpret_cast<uint64_t*>(u8_1);
-    auto u64_2 = reinterpret_cast<uint64_t*>(u8_2);
-
-    size_t n8 = bitset_.size();
-    size_t n64 = n8 / 8;
-
-    for (size_t i = 0; i < n64; i++) {
-        u64_1[i] &= u64_2[i];
-    }
-
-    size_t remain = n8 % 8;
-    u8_1 += n64 * 8;
-    u8_2 += n64 * 8;
-    for (size_t i = 0; i < remain; i++) {
-        u8_1[i] |= u8_2[i];
-    }
-
+    bitwise_op(mutable_data(), data(), bitset.data(), size(), OrOp());
     return *this;
 }
 
 std::shared_ptr<ConcurrentBitset>
 ConcurrentBitset::operator|(std::shared_ptr<ConcurrentBitset>& bitset) {
     auto result_bitset = std::make_shared<ConcurrentBitset>(bitset->capacity());
+    bitwise_op(result_bitset->mutable_data(), data(), bitset->data(), size(), OrOp());
+    return result_bitset;
+}
 
-    auto result_8 = const_cast<uint8_t*>(result_bitset->data());
-    auto result_64 = reinterpret_cast<uint64_t*>(result_8);
+ConcurrentBitset&
+ConcurrentBitset::operator^=(ConcurrentBitset& bitset) {
+    bitwise_op(mutable_data(), data(), bitset.data(), size(), XorOp());
+    return *this;
+}
 
-    auto u8_1 = const_cast<uint8_t*>(data());
-    auto u8_2 = const_cast<uint8_t*>(bitset->data());
-    auto u64_1 = reinterpret_cast<uint64_t*>(u8_1);
-    auto u64_2 = reinterpret_cast<uint64_t*>(u8_2);
+std::shared_ptr<ConcurrentBitset>
+ConcurrentBitset::andnot(std::shared_ptr<ConcurrentBitset>& bitset) {
+    auto result_bitset = std::make_shared<ConcurrentBitset>(bitset->capacity());
+    bitwise_op(result_bitset->mutable_data(), data(), bitset->data(), size(), AndNotOp());
+    return result_bitset;
+}
 
-    size_t n8 = bitset_.size();
+ConcurrentBitset&
+ConcurrentBitset::negate() {
+    auto u8 = mutable_data();
+    auto u64 = reinterpret_cast<uint64_t*>(u8);
+    size_t n8 = size();
     size_t n64 = n8 / 8;
-
     for (size_t i = 0; i < n64; i++) {
-        result_64[i] = u64_1[i] & u64_2[i];
+        u64[i] = ~u64[i];
     }
-
-    size_t remain = n8 % 8;
-    u8_1 += n64 * 8;
-    u8_2 += n64 * 8;
-    result_8 += n64 * 8;
-    for (size_t i = 0; i < remain; i++) {
-        result_8[i] = u8_1[i] | u8_2[i];
+    for (size_t i = n64 * 8; i < n8; i++) {
+        u8[i] = ~u8[i];
     }
 
-    return result_bitset;
+    // the bits past the capacity stay clear
+    size_t tail = capacity_ & 0x7;
+    if (tail != 0) {
+        u8[n8 - 1] &= (1 << tail) - 1;
+    }
+    return *this;
 }
 
-ConcurrentBitset&
-ConcurrentBitset::operator^=(ConcurrentBitset& bitset) {
-    //    for (id_type_t i = 0; i < ((capacity_ + 8 -1) >> 3); ++i) {
-    //        bitset_[i].fetch_xor(bitset.bitset()[i].load());
-    //    }
-
-    auto u8_1 = const_cast<uint8_t*>(data());
-    auto u8_2 = const_cast<uint8_t*>(bitset.data());
-    auto u64_1 = reinterpret_cast<uint64_t*>(u8_1);
-    auto u64_2 = reinterpret_cast<uint64_t*>(u8_2);
-
-    size_t n8 = bitset_.size();
+size_t
+ConcurrentBitset::count() {
+    auto u8 = data();
+    auto u64 = reinterpret_cast<const uint64_t*>(u8);
+    size_t n8 = size();
     size_t n64 = n8 / 8;
-
+    size_t ret = 0;
     for (size_t i = 0; i < n64; i++) {
-        u64_1[i] &= u64_2[i];
+        ret += __builtin_popcountll(u64[i]);
     }
-
-    size_t remain = n8 % 8;
-    u8_1 += n64 * 8;
-    u8_2 += n64 * 8;
-    for (size_t i = 0; i < remain; i++) {
-        u8_1[i] ^= u8_2[i];
+    for (size_t i = n64 * 8; i < n8; i++) {
+        ret += __builtin_popcount(u8[i]);
     }
-
-    return *this;
+    return ret;
 }
 
 bool
 ConcurrentBitset::test(id_type_t id) {
-    return bitset_[id >> 3].load() & (0x1 << (id & 0x7));
+    return bitset_[id >> 3].load(std::memory_order_relaxed) & (0x1 << (id & 0x7));
 }
 
 void
@@ -23,6 +23,10 @@
 
 namespace faiss {
 
+/* The atomics are only needed by set() and clear() of a bitset which is shared while it is written, e.g. the
+ * blacklist of a segment taking deletes. test() is a relaxed load, and the bulk operators, negate(), andnot() and
+ * count() work on 64 bit words with plain loads and stores: they are meant for a bitset owned by a single writer,
+ * such as the results of a query. */
 class ConcurrentBitset {
  public:
     using id_type_t = int64_t;
@@ -51,6 +55,18 @@ class ConcurrentBitset {
     ConcurrentBitset&
     operator^=(ConcurrentBitset& bitset);
 
+    // this & ~bitset
+    std::shared_ptr<ConcurrentBitset>
+    andnot(std::shared_ptr<ConcurrentBitset>& bitset);
+
+    // flip every bit below the capacity
+    ConcurrentBitset&
+    negate();
+
+    // number of bits set
+    size_t
+    count();
+
     bool
     test(id_type_t id);
 
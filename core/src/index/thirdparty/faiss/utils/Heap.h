@@ -119,6 +119,55 @@ void heap_swap_top (size_t k,
 }
 
 
+/** Adds the values x[0..n-1] that beat the top of the heap
+ * bh_val[0..k-1], bh_ids[0..k-1]. The values are first compared to the
+ * top 16 at a time, in a loop without branches that the compiler turns
+ * into SIMD compares, and a chunk is only walked one by one when it
+ * holds a candidate, which is seldom once the heap is warm. id_of (i)
+ * gives the id of x[i], or a negative id to drop it; it is only called
+ * for the candidates. Returns the number of values added.
+ */
+template <class C, class IdOf> inline
+size_t heap_addn_filtered (size_t k,
+                           typename C::T * bh_val, typename C::TI * bh_ids,
+                           const typename C::T * x, size_t n,
+                           const IdOf & id_of)
+{
+    const size_t chunk = 16;
+    size_t nup = 0;
+    size_t i0 = 0;
+    for (; i0 + chunk <= n; i0 += chunk) {
+        typename C::T top = bh_val[0];
+        int any = 0;
+        for (size_t i = i0; i < i0 + chunk; i++) {
+            any |= C::cmp (top, x[i]);
+        }
+        if (!any) {
+            continue;
+        }
+        for (size_t i = i0; i < i0 + chunk; i++) {
+            if (C::cmp (bh_val[0], x[i])) {
+                typename C::TI id = id_of (i);
+                if (id >= 0) {
+                    heap_swap_top<C> (k, bh_val, bh_ids, x[i], id);
+                    nup++;
+                }
+            }
+        }
+    }
+    for (size_t i = i0; i < n; i++) {
+        if (C::cmp (bh_val[0], x[i])) {
+            typename C::TI id = id_of (i);
+            if (id >= 0) {
+                heap_swap_top<C> (k, bh_val, bh_ids, x[i], id);
+                nup++;
+            }
+        }
+    }
+    return nup;
+}
+
+
 /** Pops the top element from the heap defined by bh_val[0..k-1] and
  * bh_ids[0..k-1].  on output the element at k-1 is undefined.
  */
@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "faiss/utils/HugePage.h"
+
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace faiss {
+
+bool faiss_use_huge_page = false;
+
+void
+advise_huge_page(void* addr, size_t size) {
+#ifdef MADV_HUGEPAGE
+    if (!faiss_use_huge_page || addr == nullptr) {
+        return;
+    }
+    auto begin = ((uintptr_t)addr + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    auto end = ((uintptr_t)addr + size) & ~(HUGE_PAGE_SIZE - 1);
+    if (begin < end) {
+        // a failure leaves the range on regular pages, as when the kernel has no huge page to give
+        madvise((void*)begin, end - begin, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+void*
+alloc_huge_page(size_t size) {
+    if (!faiss_use_huge_page || size < HUGE_PAGE_SIZE) {
+        return malloc(size);
+    }
+    // rounded up to whole huge pages, the last one would be split otherwise
+    size_t aligned_size = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, HUGE_PAGE_SIZE, aligned_size) != 0) {
+        return nullptr;
+    }
+    advise_huge_page(ptr, aligned_size);
+    return ptr;
+}
+
+int64_t
+huge_page_usage() {
+    FILE* file = fopen("/proc/self/smaps_rollup", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    int64_t usage = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        long long kb = 0;
+        if (sscanf(line, "AnonHugePages: %lld kB", &kb) == 1) {
+            usage = kb * 1024;
+            break;
+        }
+    }
+    fclose(file);
+    return usage;
+}
+
+}  // namespace faiss
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace faiss {
+
+/* Large index arrays, such as the hnsw level 0 graph, the readonly inverted lists and the raw vectors, are accessed
+ * at random: on 4KB pages most of the accesses miss the TLB. When faiss_use_huge_page is set their allocations
+ * are asked to the kernel as transparent huge pages of HUGE_PAGE_SIZE, it has effect when
+ * /sys/kernel/mm/transparent_hugepage/enabled is "madvise" or "always". The memory is advised before it is touched,
+ * the huge pages are then given at the page faults rather than later by khugepaged. */
+extern bool faiss_use_huge_page;
+
+constexpr size_t HUGE_PAGE_SIZE = 2UL * 1024 * 1024;
+
+/// advises the huge pages fully within [addr, addr + size) when faiss_use_huge_page is set
+void
+advise_huge_page(void* addr, size_t size);
+
+/// allocates size bytes to be released by free(), huge page aligned and advised when faiss_use_huge_page is set
+/// and size is a huge page at least; nullptr when out of memory
+void*
+alloc_huge_page(size_t size);
+
+/// bytes of the process backed by transparent huge pages
+int64_t
+huge_page_usage();
+
+}  // namespace faiss
@@ -0,0 +1,35 @@
+
+// -*- c++ -*-
+
+/* Binary distances on codes of any length.
+ * The actual functions are implemented in binary_distances_simd_avx512.cpp,
+ * the bit counts need AVX512 VPOPCNTDQ on top of AVX512F/BW */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// number of bits set in a ^ b
+int
+bvec_popcount_xor_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// number of bits set in a & b
+int
+bvec_popcount_and_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// number of bits set in a | b
+int
+bvec_popcount_or_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// whether a is contained in b
+bool
+bvec_substructure_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// whether a contains b
+bool
+bvec_superstructure_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+} // namespace faiss
@@ -0,0 +1,34 @@
+
+// -*- c++ -*-
+
+/* Binary distances on codes of any length.
+ * The actual functions are implemented in binary_distances_simd_neon.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// number of bits set in a ^ b
+int
+bvec_popcount_xor_neon(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// number of bits set in a & b
+int
+bvec_popcount_and_neon(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// number of bits set in a | b
+int
+bvec_popcount_or_neon(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// whether a is contained in b
+bool
+bvec_substructure_neon(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// whether a contains b
+bool
+bvec_superstructure_neon(const uint8_t* a, const uint8_t* b, size_t n);
+
+} // namespace faiss
@@ -0,0 +1,206 @@
+
+// -*- c++ -*-
+
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+namespace {
+
+struct OpXor {
+    static inline __m256i apply (__m256i x, __m256i y) { return _mm256_xor_si256 (x, y); }
+    static inline uint64_t apply (uint64_t x, uint64_t y) { return x ^ y; }
+};
+
+struct OpAnd {
+    static inline __m256i apply (__m256i x, __m256i y) { return _mm256_and_si256 (x, y); }
+    static inline uint64_t apply (uint64_t x, uint64_t y) { return x & y; }
+};
+
+struct OpOr {
+    static inline __m256i apply (__m256i x, __m256i y) { return _mm256_or_si256 (x, y); }
+    static inline uint64_t apply (uint64_t x, uint64_t y) { return x | y; }
+};
+
+// per byte bit counts, looked up by nibble
+inline __m256i popcount_bytes (__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8 (
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8 (0x0f);
+    __m256i lo = _mm256_and_si256 (v, low_mask);
+    __m256i hi = _mm256_and_si256 (_mm256_srli_epi16 (v, 4), low_mask);
+    return _mm256_add_epi8 (_mm256_shuffle_epi8 (lookup, lo),
+                            _mm256_shuffle_epi8 (lookup, hi));
+}
+
+// bit counts summed in the four 64-bit lanes
+inline __m256i popcount_epi64 (__m256i v) {
+    return _mm256_sad_epu8 (popcount_bytes (v), _mm256_setzero_si256 ());
+}
+
+// carry-save adder: h:l = a + b + c, bit by bit
+inline void csa (__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256 (a, b);
+    h = _mm256_or_si256 (_mm256_and_si256 (a, b), _mm256_and_si256 (u, c));
+    l = _mm256_xor_si256 (u, c);
+}
+
+template <class Op>
+inline __m256i load_op (const uint8_t* a, const uint8_t* b, size_t i) {
+    return Op::apply (_mm256_loadu_si256 ((const __m256i*)(a + i)),
+                      _mm256_loadu_si256 ((const __m256i*)(b + i)));
+}
+
+// number of bits set in Op(a, b). Long codes go through the Harley-Seal
+// carry-save tree, 16 vectors at a time, so only one vector in 16 needs a
+// full bit count; the rest use the nibble lookup with byte accumulators
+template <class Op>
+int popcount_op (const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t i = 0;
+    __m256i total = _mm256_setzero_si256 ();
+
+    if (n >= 512) {
+        __m256i ones = _mm256_setzero_si256 ();
+        __m256i twos = _mm256_setzero_si256 ();
+        __m256i fours = _mm256_setzero_si256 ();
+        __m256i eights = _mm256_setzero_si256 ();
+        __m256i sixteens_total = _mm256_setzero_si256 ();
+        __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+
+        for (; i + 512 <= n; i += 512) {
+            csa (twos_a, ones, ones, load_op<Op> (a, b, i), load_op<Op> (a, b, i + 32));
+            csa (twos_b, ones, ones, load_op<Op> (a, b, i + 64), load_op<Op> (a, b, i + 96));
+            csa (fours_a, twos, twos, twos_a, twos_b);
+            csa (twos_a, ones, ones, load_op<Op> (a, b, i + 128), load_op<Op> (a, b, i + 160));
+            csa (twos_b, ones, ones, load_op<Op> (a, b, i + 192), load_op<Op> (a, b, i + 224));
+            csa (fours_b, twos, twos, twos_a, twos_b);
+            csa (eights_a, fours, fours, fours_a, fours_b);
+            csa (twos_a, ones, ones, load_op<Op> (a, b, i + 256), load_op<Op> (a, b, i + 288));
+            csa (twos_b, ones, ones, load_op<Op> (a, b, i + 320), load_op<Op> (a, b, i + 352));
+            csa (fours_a, twos, twos, twos_a, twos_b);
+            csa (twos_a, ones, ones, load_op<Op> (a, b, i + 384), load_op<Op> (a, b, i + 416));
+            csa (twos_b, ones, ones, load_op<Op> (a, b, i + 448), load_op<Op> (a, b, i + 480));
+            csa (fours_b, twos, twos, twos_a, twos_b);
+            csa (eights_b, fours, fours, fours_a, fours_b);
+            csa (sixteens, eights, eights, eights_a, eights_b);
+            sixteens_total = _mm256_add_epi64 (sixteens_total, popcount_epi64 (sixteens));
+        }
+
+        total = _mm256_slli_epi64 (sixteens_total, 4);
+        total = _mm256_add_epi64 (total, _mm256_slli_epi64 (popcount_epi64 (eights), 3));
+        total = _mm256_add_epi64 (total, _mm256_slli_epi64 (popcount_epi64 (fours), 2));
+        total = _mm256_add_epi64 (total, _mm256_slli_epi64 (popcount_epi64 (twos), 1));
+        total = _mm256_add_epi64 (total, popcount_epi64 (ones));
+    }
+
+    // a byte counts at most 8 bits per vector, flush before it overflows
+    __m256i bytes = _mm256_setzero_si256 ();
+    int nacc = 0;
+    for (; i + 32 <= n; i += 32) {
+        bytes = _mm256_add_epi8 (bytes, popcount_bytes (load_op<Op> (a, b, i)));
+        if (++nacc == 31) {
+            total = _mm256_add_epi64 (total, _mm256_sad_epu8 (bytes, _mm256_setzero_si256 ()));
+            bytes = _mm256_setzero_si256 ();
+            nacc = 0;
+        }
+    }
+    total = _mm256_add_epi64 (total, _mm256_sad_epu8 (bytes, _mm256_setzero_si256 ()));
+
+    int accu = _mm256_extract_epi64 (total, 0) + _mm256_extract_epi64 (total, 1) +
+               _mm256_extract_epi64 (total, 2) + _mm256_extract_epi64 (total, 3);
+
+    for (; i + 8 <= n; i += 8) {
+        accu += __builtin_popcountll (Op::apply (*(const uint64_t*)(a + i), *(const uint64_t*)(b + i)));
+    }
+    for (; i < n; i++) {
+        accu += __builtin_popcountll (Op::apply ((uint64_t)a[i], (uint64_t)b[i]));
+    }
+    return accu;
+}
+
+// whether no bit of x is missing from y
+inline bool contained (const uint8_t* x, const uint8_t* y, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i vx = _mm256_loadu_si256 ((const __m256i*)(x + i));
+        __m256i vy = _mm256_loadu_si256 ((const __m256i*)(y + i));
+        if (!_mm256_testc_si256 (vy, vx)) {
+            return false;
+        }
+    }
+    for (; i < n; i++) {
+        if ((x[i] & y[i]) != x[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int
+bvec_popcount_xor_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpXor> (a, b, n);
+}
+
+int
+bvec_popcount_and_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpAnd> (a, b, n);
+}
+
+int
+bvec_popcount_or_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpOr> (a, b, n);
+}
+
+bool
+bvec_substructure_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return contained (a, b, n);
+}
+
+bool
+bvec_superstructure_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return contained (b, a, n);
+}
+
+#else
+
+int
+bvec_popcount_xor_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+bvec_popcount_and_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+bvec_popcount_or_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+bool
+bvec_substructure_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+bool
+bvec_superstructure_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+#endif
+
+} // namespace faiss
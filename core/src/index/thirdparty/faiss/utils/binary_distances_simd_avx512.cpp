@@ -0,0 +1,135 @@
+
+// -*- c++ -*-
+
+#include <faiss/utils/binary_distances_avx512.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512BW__))
+
+namespace {
+
+struct OpXor {
+    static inline __m512i apply (__m512i x, __m512i y) { return _mm512_xor_si512 (x, y); }
+};
+
+struct OpAnd {
+    static inline __m512i apply (__m512i x, __m512i y) { return _mm512_and_si512 (x, y); }
+};
+
+struct OpOr {
+    static inline __m512i apply (__m512i x, __m512i y) { return _mm512_or_si512 (x, y); }
+};
+
+// VPOPCNTDQ is not part of the flags this file is built with, it is only
+// enabled here and hook_init only picks these functions when the cpu has it
+template <class Op>
+__attribute__((target("avx512vpopcntdq")))
+int popcount_op (const uint8_t* a, const uint8_t* b, size_t n) {
+    __m512i acc0 = _mm512_setzero_si512 ();
+    __m512i acc1 = _mm512_setzero_si512 ();
+    size_t i = 0;
+    for (; i + 128 <= n; i += 128) {
+        __m512i x0 = Op::apply (_mm512_loadu_si512 (a + i), _mm512_loadu_si512 (b + i));
+        __m512i x1 = Op::apply (_mm512_loadu_si512 (a + i + 64), _mm512_loadu_si512 (b + i + 64));
+        acc0 = _mm512_add_epi64 (acc0, _mm512_popcnt_epi64 (x0));
+        acc1 = _mm512_add_epi64 (acc1, _mm512_popcnt_epi64 (x1));
+    }
+    for (; i + 64 <= n; i += 64) {
+        __m512i x = Op::apply (_mm512_loadu_si512 (a + i), _mm512_loadu_si512 (b + i));
+        acc0 = _mm512_add_epi64 (acc0, _mm512_popcnt_epi64 (x));
+    }
+    if (i < n) {
+        // the masked out bytes are 0 in both codes, and so in Op(a, b)
+        __mmask64 mask = (1ULL << (n - i)) - 1;
+        __m512i x = Op::apply (_mm512_maskz_loadu_epi8 (mask, a + i), _mm512_maskz_loadu_epi8 (mask, b + i));
+        acc1 = _mm512_add_epi64 (acc1, _mm512_popcnt_epi64 (x));
+    }
+    return _mm512_reduce_add_epi64 (_mm512_add_epi64 (acc0, acc1));
+}
+
+// whether no bit of x is missing from y
+inline bool contained (const uint8_t* x, const uint8_t* y, size_t n) {
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i missing = _mm512_andnot_si512 (_mm512_loadu_si512 (y + i), _mm512_loadu_si512 (x + i));
+        if (_mm512_test_epi64_mask (missing, missing)) {
+            return false;
+        }
+    }
+    if (i < n) {
+        __mmask64 mask = (1ULL << (n - i)) - 1;
+        __m512i missing = _mm512_andnot_si512 (_mm512_maskz_loadu_epi8 (mask, y + i),
+                                               _mm512_maskz_loadu_epi8 (mask, x + i));
+        if (_mm512_test_epi64_mask (missing, missing)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int
+bvec_popcount_xor_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpXor> (a, b, n);
+}
+
+int
+bvec_popcount_and_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpAnd> (a, b, n);
+}
+
+int
+bvec_popcount_or_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpOr> (a, b, n);
+}
+
+bool
+bvec_substructure_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    return contained (a, b, n);
+}
+
+bool
+bvec_superstructure_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    return contained (b, a, n);
+}
+
+#else
+
+int
+bvec_popcount_xor_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+bvec_popcount_and_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+bvec_popcount_or_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+bool
+bvec_substructure_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+bool
+bvec_superstructure_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,153 @@
+
+// -*- c++ -*-
+
+#include <faiss/utils/binary_distances_neon.h>
+#include <faiss/impl/FaissAssert.h>
+
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
+
+namespace faiss {
+
+#ifdef __aarch64__
+
+namespace {
+
+struct OpXor {
+    static inline uint8x16_t apply (uint8x16_t x, uint8x16_t y) { return veorq_u8 (x, y); }
+    static inline uint64_t apply (uint64_t x, uint64_t y) { return x ^ y; }
+};
+
+struct OpAnd {
+    static inline uint8x16_t apply (uint8x16_t x, uint8x16_t y) { return vandq_u8 (x, y); }
+    static inline uint64_t apply (uint64_t x, uint64_t y) { return x & y; }
+};
+
+struct OpOr {
+    static inline uint8x16_t apply (uint8x16_t x, uint8x16_t y) { return vorrq_u8 (x, y); }
+    static inline uint64_t apply (uint64_t x, uint64_t y) { return x | y; }
+};
+
+template <class Op>
+inline uint8x16_t cnt_op (const uint8_t* a, const uint8_t* b, size_t i) {
+    return vcntq_u8 (Op::apply (vld1q_u8 (a + i), vld1q_u8 (b + i)));
+}
+
+// number of bits set in Op(a, b). vcnt gives per byte bit counts; four of
+// them still fit in a byte, which is then widened pairwise into 16-bit
+// lanes and, before those can overflow, into 32-bit lanes
+template <class Op>
+int popcount_op (const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t i = 0;
+    uint32x4_t total = vdupq_n_u32 (0);
+    uint16x8_t acc16 = vdupq_n_u16 (0);
+    int nacc = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        uint8x16_t c = vaddq_u8 (vaddq_u8 (cnt_op<Op> (a, b, i), cnt_op<Op> (a, b, i + 16)),
+                                 vaddq_u8 (cnt_op<Op> (a, b, i + 32), cnt_op<Op> (a, b, i + 48)));
+        // each 16-bit lane grows by at most 64
+        acc16 = vpadalq_u8 (acc16, c);
+        if (++nacc == 1000) {
+            total = vpadalq_u16 (total, acc16);
+            acc16 = vdupq_n_u16 (0);
+            nacc = 0;
+        }
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc16 = vpadalq_u8 (acc16, cnt_op<Op> (a, b, i));
+    }
+    total = vpadalq_u16 (total, acc16);
+
+    int accu = vaddvq_u32 (total);
+
+    for (; i + 8 <= n; i += 8) {
+        accu += __builtin_popcountll (Op::apply (*(const uint64_t*)(a + i), *(const uint64_t*)(b + i)));
+    }
+    for (; i < n; i++) {
+        accu += __builtin_popcountll (Op::apply ((uint64_t)a[i], (uint64_t)b[i]));
+    }
+    return accu;
+}
+
+// whether no bit of x is missing from y
+inline bool contained (const uint8_t* x, const uint8_t* y, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        // bits of x that are not in y
+        uint8x16_t missing = vbicq_u8 (vld1q_u8 (x + i), vld1q_u8 (y + i));
+        if (vmaxvq_u8 (missing) != 0) {
+            return false;
+        }
+    }
+    for (; i < n; i++) {
+        if ((x[i] & y[i]) != x[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int
+bvec_popcount_xor_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpXor> (a, b, n);
+}
+
+int
+bvec_popcount_and_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpAnd> (a, b, n);
+}
+
+int
+bvec_popcount_or_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_op<OpOr> (a, b, n);
+}
+
+bool
+bvec_substructure_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    return contained (a, b, n);
+}
+
+bool
+bvec_superstructure_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    return contained (b, a, n);
+}
+
+#else
+
+int
+bvec_popcount_xor_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+bvec_popcount_and_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int
+bvec_popcount_or_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+bool
+bvec_substructure_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+bool
+bvec_superstructure_neon(const uint8_t* a, const uint8_t* b, size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+#endif
+
+} // namespace faiss
@@ -143,12 +143,27 @@ void fvec_renorm_L2 (size_t d, size_t nx, float * __restrict x)
 
 
 
+/* Fill the heaps of res with placeholders at bounds[i], only the
+ * results beating the bound of their query make it into the heap */
+template<class HeapArray>
+static void seed_heaps (HeapArray * res, const float * bounds)
+{
+    if (!bounds) return;
+    for (size_t i = 0; i < res->nh; i++) {
+        float * simi = res->get_val (i);
+        for (size_t j = 0; j < res->k; j++) {
+            simi[j] = bounds[i];
+        }
+    }
+}
+
 /* Find the nearest neighbors for nx queries in a set of ny vectors */
 static void knn_inner_product_sse (const float * x,
                         const float * y,
                         size_t d, size_t nx, size_t ny,
                         float_minheap_array_t * res,
-                        ConcurrentBitsetPtr bitset = nullptr)
+                        ConcurrentBitsetPtr bitset = nullptr,
+                        const float * bounds = nullptr)
 {
     size_t k = res->k;
 
@@ -158,10 +173,11 @@ static void knn_inner_product_sse (const float * x,
     size_t all_heap_size = thread_heap_size * thread_max_num;
     float *value = new float[all_heap_size];
     int64_t *labels = new int64_t[all_heap_size];
+    FvecKernels kernels = fvec_kernels_for_dim(d);
 
-    // init heap
+    // init heap, a bound makes the heap start out full of placeholders
     for (size_t i = 0; i < all_heap_size; i++) {
-        value[i] = -1.0 / 0.0;
+        value[i] = bounds ? bounds[(i % thread_heap_size) / k] : -1.0 / 0.0;
         labels[i] = -1;
     }
 
@@ -170,15 +186,27 @@ static void knn_inner_product_sse (const float * x,
         if(!bitset || !bitset->test(j)) {
             size_t thread_no = omp_get_thread_num();
             const float *y_j = y + j * d;
-            for (size_t i = 0; i < nx; i++) {
-                const float *x_i = x + i * d;
-                float ip = fvec_inner_product (x_i, y_j, d);
-
+            auto add_result = [&] (size_t i, float ip) {
                 float * val_ = value + thread_no * thread_heap_size + i * k;
                 int64_t * ids_ = labels + thread_no * thread_heap_size + i * k;
                 if (ip > val_[0]) {
                     minheap_swap_top (k, val_, ids_, ip, j);
                 }
+            };
+
+            // four queries share each load of y_j
+            size_t i = 0;
+            for (; i + 4 <= nx; i += 4) {
+                const float *x_i = x + i * d;
+                float ip[4];
+                kernels.inner_product_batch_4 (y_j, x_i, x_i + d, x_i + 2 * d, x_i + 3 * d, d,
+                                               ip[0], ip[1], ip[2], ip[3]);
+                for (size_t b = 0; b < 4; b++) {
+                    add_result (i + b, ip[b]);
+                }
+            }
+            for (; i < nx; i++) {
+                add_result (i, kernels.inner_product (x + i * d, y_j, d));
             }
         }
     }
@@ -253,7 +281,8 @@ static void knn_L2sqr_sse (
                 const float * y,
                 size_t d, size_t nx, size_t ny,
                 float_maxheap_array_t * res,
-                ConcurrentBitsetPtr bitset = nullptr)
+                ConcurrentBitsetPtr bitset = nullptr,
+                const float * bounds = nullptr)
 {
     size_t k = res->k;
 
@@ -263,10 +292,11 @@ static void knn_L2sqr_sse (
     size_t all_heap_size = thread_heap_size * thread_max_num;
     float *value = new float[all_heap_size];
     int64_t *labels = new int64_t[all_heap_size];
+    FvecKernels kernels = fvec_kernels_for_dim(d);
 
-    // init heap
+    // init heap, a bound makes the heap start out full of placeholders
     for (size_t i = 0; i < all_heap_size; i++) {
-        value[i] = 1.0 / 0.0;
+        value[i] = bounds ? bounds[(i % thread_heap_size) / k] : 1.0 / 0.0;
         labels[i] = -1;
     }
 
@@ -275,15 +305,27 @@ static void knn_L2sqr_sse (
         if(!bitset || !bitset->test(j)) {
             size_t thread_no = omp_get_thread_num();
             const float *y_j = y + j * d;
-            for (size_t i = 0; i < nx; i++) {
-                const float *x_i = x + i * d;
-                float disij = fvec_L2sqr (x_i, y_j, d);
-
+            auto add_result = [&] (size_t i, float disij) {
                 float * val_ = value + thread_no * thread_heap_size + i * k;
                 int64_t * ids_ = labels + thread_no * thread_heap_size + i * k;
                 if (disij < val_[0]) {
                     maxheap_swap_top (k, val_, ids_, disij, j);
                 }
+            };
+
+            // four queries share each load of y_j
+            size_t i = 0;
+            for (; i + 4 <= nx; i += 4) {
+                const float *x_i = x + i * d;
+                float disij[4];
+                kernels.L2sqr_batch_4 (y_j, x_i, x_i + d, x_i + 2 * d, x_i + 3 * d, d,
+                                       disij[0], disij[1], disij[2], disij[3]);
+                for (size_t b = 0; b < 4; b++) {
+                    add_result (i + b, disij[b]);
+                }
+            }
+            for (; i < nx; i++) {
+                add_result (i, kernels.L2sqr (x + i * d, y_j, d));
             }
         }
     }
@@ -358,9 +400,11 @@ static void knn_inner_product_blas (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float_minheap_array_t * res,
-        ConcurrentBitsetPtr bitset = nullptr)
+        ConcurrentBitsetPtr bitset = nullptr,
+        const float * bounds = nullptr)
 {
     res->heapify ();
+    seed_heaps (res, bounds);
 
     // BLAS does not like empty matrices
     if (nx == 0 || ny == 0) return;
@@ -397,16 +441,12 @@ static void knn_inner_product_blas (
                 int64_t * __restrict idxi = res->get_ids (i);
                 const float *ip_line = ip_block + (i - i0) * (j1 - j0);
 
-                for(size_t j = j0; j < j1; j++){
-                    if(!bitset || !bitset->test(j)){
-                        float dis = *ip_line;
-
-                        if(dis > simi[0]){
-                            minheap_swap_top(k, simi, idxi, dis, j);
-                        }
-                    }
-                    ip_line++;
-                }
+                heap_addn_filtered<CMin<float, int64_t> > (
+                        k, simi, idxi, ip_line, j1 - j0,
+                        [&] (size_t jj) -> int64_t {
+                            size_t j = j0 + jj;
+                            return (bitset && bitset->test(j)) ? -1 : (int64_t)j;
+                        });
             }
         }
         InterruptCallback::check ();
@@ -422,9 +462,11 @@ static void knn_L2sqr_blas (const float * x,
         size_t d, size_t nx, size_t ny,
         float_maxheap_array_t * res,
         const DistanceCorrection &corr,
-        ConcurrentBitsetPtr bitset = nullptr)
+        ConcurrentBitsetPtr bitset = nullptr,
+        const float * bounds = nullptr)
 {
     res->heapify ();
+    seed_heaps (res, bounds);
 
     // BLAS does not like empty matrices
     if (nx == 0 || ny == 0) return;
@@ -465,25 +507,26 @@ static void knn_L2sqr_blas (const float * x,
             for (size_t i = i0; i < i1; i++) {
                 float * __restrict simi = res->get_val(i);
                 int64_t * __restrict idxi = res->get_ids (i);
-                const float *ip_line = ip_block + (i - i0) * (j1 - j0);
+                // the line of the block is only read by this query, the
+                // distances overwrite the dot products in place
+                float * __restrict dis_line = ip_block + (i - i0) * (j1 - j0);
 
                 for (size_t j = j0; j < j1; j++) {
-                    if(!bitset || !bitset->test(j)){
-                        float ip = *ip_line;
-                        float dis = x_norms[i] + y_norms[j] - 2 * ip;
-
-                        // negative values can occur for identical vectors
-                        // due to roundoff errors
-                        if (dis < 0) dis = 0;
+                    float dis = x_norms[i] + y_norms[j] - 2 * dis_line[j - j0];
 
-                        dis = corr (dis, i, j);
+                    // negative values can occur for identical vectors
+                    // due to roundoff errors
+                    if (dis < 0) dis = 0;
 
-                        if (dis < simi[0]) {
-                            maxheap_swap_top (k, simi, idxi, dis, j);
-                        }
-                    }
-                    ip_line++;
+                    dis_line[j - j0] = corr (dis, i, j);
                 }
+
+                heap_addn_filtered<CMax<float, int64_t> > (
+                        k, simi, idxi, dis_line, j1 - j0,
+                        [&] (size_t jj) -> int64_t {
+                            size_t j = j0 + jj;
+                            return (bitset && bitset->test(j)) ? -1 : (int64_t)j;
+                        });
             }
         }
         InterruptCallback::check ();
@@ -583,12 +626,13 @@ void knn_inner_product (const float * x,
         const float * y,
         size_t d, size_t nx, size_t ny,
         float_minheap_array_t * res,
-        ConcurrentBitsetPtr bitset)
+        ConcurrentBitsetPtr bitset,
+        const float * bounds)
 {
     if (nx < distance_compute_blas_threshold) {
-        knn_inner_product_sse (x, y, d, nx, ny, res, bitset);
+        knn_inner_product_sse (x, y, d, nx, ny, res, bitset, bounds);
     } else {
-        knn_inner_product_blas (x, y, d, nx, ny, res, bitset);
+        knn_inner_product_blas (x, y, d, nx, ny, res, bitset, bounds);
     }
 }
 
@@ -604,13 +648,14 @@ void knn_L2sqr (const float * x,
                 const float * y,
                 size_t d, size_t nx, size_t ny,
                 float_maxheap_array_t * res,
-                ConcurrentBitsetPtr bitset)
+                ConcurrentBitsetPtr bitset,
+                const float * bounds)
 {
     if (nx < distance_compute_blas_threshold) {
-        knn_L2sqr_sse (x, y, d, nx, ny, res, bitset);
+        knn_L2sqr_sse (x, y, d, nx, ny, res, bitset, bounds);
     } else {
         NopDistanceCorrection nop;
-        knn_L2sqr_blas (x, y, d, nx, ny, res, nop, bitset);
+        knn_L2sqr_blas (x, y, d, nx, ny, res, nop, bitset, bounds);
     }
 }
 
@@ -802,7 +847,8 @@ static void range_search_blas (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result)
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset)
 {
 
     // BLAS does not like empty matrices
@@ -856,6 +902,9 @@ static void range_search_blas (
 
                 for (size_t j = j0; j < j1; j++) {
                     float ip = *ip_line++;
+                    if (bitset && bitset->test(j)) {
+                        continue;
+                    }
                     if (compute_l2) {
                         float dis =  x_norms[i] + y_norms[j] - 2 * ip;
                         if (dis < radius) {
@@ -881,7 +930,8 @@ static void range_search_sse (const float * x,
                 const float * y,
                 size_t d, size_t nx, size_t ny,
                 float radius,
-                RangeSearchResult *res)
+                RangeSearchResult *res,
+                ConcurrentBitsetPtr bitset)
 {
 
 #pragma omp parallel
@@ -896,7 +946,10 @@ static void range_search_sse (const float * x,
 
             RangeQueryResult & qres = pres.new_result (i);
 
-            for (j = 0; j < ny; j++) {
+            for (j = 0; j < ny; j++, y_ += d) {
+                if (bitset && bitset->test(j)) {
+                    continue;
+                }
                 if (compute_l2) {
                     float disij = fvec_L2sqr (x_, y_, d);
                     if (disij < radius) {
@@ -908,7 +961,6 @@ static void range_search_sse (const float * x,
                         qres.add (ip, j);
                     }
                 }
-                y_ += d;
             }
 
         }
@@ -929,13 +981,14 @@ void range_search_L2sqr (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *res)
+        RangeSearchResult *res,
+        ConcurrentBitsetPtr bitset)
 {
 
     if (nx < distance_compute_blas_threshold) {
-        range_search_sse<true> (x, y, d, nx, ny, radius, res);
+        range_search_sse<true> (x, y, d, nx, ny, radius, res, bitset);
     } else {
-        range_search_blas<true> (x, y, d, nx, ny, radius, res);
+        range_search_blas<true> (x, y, d, nx, ny, radius, res, bitset);
     }
 }
 
@@ -944,13 +997,14 @@ void range_search_inner_product (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *res)
+        RangeSearchResult *res,
+        ConcurrentBitsetPtr bitset)
 {
 
     if (nx < distance_compute_blas_threshold) {
-        range_search_sse<false> (x, y, d, nx, ny, radius, res);
+        range_search_sse<false> (x, y, d, nx, ny, radius, res, bitset);
     } else {
-        range_search_blas<false> (x, y, d, nx, ny, radius, res);
+        range_search_blas<false> (x, y, d, nx, ny, radius, res, bitset);
     }
 }
 
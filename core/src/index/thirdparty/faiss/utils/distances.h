@@ -24,6 +24,15 @@ namespace faiss {
  * Optimized distance/norm/inner prod computations
  *********************************************************/
 
+/// scalar reference implementations, the baseline of the SIMD kernels
+float fvec_L2sqr_ref (const float * x, const float * y, size_t d);
+
+float fvec_inner_product_ref (const float * x, const float * y, size_t d);
+
+float fvec_L1_ref (const float * x, const float * y, size_t d);
+
+float fvec_Linf_ref (const float * x, const float * y, size_t d);
+
 #ifdef __SSE__
 float fvec_L2sqr_sse (
         const float * x,
@@ -44,6 +53,32 @@ float fvec_Linf_sse (
         const float * x,
         const float * y,
         size_t d);
+
+/// squared L2 distances between x and y0..y3, one load of x per step
+void fvec_L2sqr_batch_4_sse (
+        const float * x,
+        const float * y0,
+        const float * y1,
+        const float * y2,
+        const float * y3,
+        size_t d,
+        float & dis0,
+        float & dis1,
+        float & dis2,
+        float & dis3);
+
+/// inner products between x and y0..y3, one load of x per step
+void fvec_inner_product_batch_4_sse (
+        const float * x,
+        const float * y0,
+        const float * y1,
+        const float * y2,
+        const float * y3,
+        size_t d,
+        float & dis0,
+        float & dis1,
+        float & dis2,
+        float & dis3);
 #endif
 
 float fvec_jaccard (
@@ -164,13 +199,17 @@ extern int distance_compute_blas_threshold;
  * @param x    query vectors, size nx * d
  * @param y    database vectors, size ny * d
  * @param res  result array, which also provides k. Sorted on output
+ * @param bounds  optional, size nx. Only the results beating bounds[i]
+ *                are kept for query i, the rest of its heap is filled
+ *                with label -1 at distance bounds[i]
  */
 void knn_inner_product (
         const float * x,
         const float * y,
         size_t d, size_t nx, size_t ny,
         float_minheap_array_t * res,
-        ConcurrentBitsetPtr bitset = nullptr);
+        ConcurrentBitsetPtr bitset = nullptr,
+        const float * bounds = nullptr);
 
 /** Same as knn_inner_product, for the L2 distance */
 void knn_L2sqr (
@@ -178,7 +217,8 @@ void knn_L2sqr (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float_maxheap_array_t * res,
-        ConcurrentBitsetPtr bitset = nullptr);
+        ConcurrentBitsetPtr bitset = nullptr,
+        const float * bounds = nullptr);
 
 void knn_jaccard (
         const float * x,
@@ -231,13 +271,15 @@ struct RangeSearchResult;
  * @param y      database vectors, size ny * d
  * @param radius search radius around the x vectors
  * @param result result structure
+ * @param bitset database vectors whose bit is set are skipped
  */
 void range_search_L2sqr (
         const float * x,
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result);
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset = nullptr);
 
 /// same as range_search_L2sqr for the inner product similarity
 void range_search_inner_product (
@@ -245,7 +287,8 @@ void range_search_inner_product (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result);
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset = nullptr);
 
 
 /***************************************************************************
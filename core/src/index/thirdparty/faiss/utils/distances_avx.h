@@ -10,6 +10,8 @@
 
 namespace faiss {
 
+struct FvecKernels;
+
 /*********************************************************
  * Optimized distance/norm/inner prod computations
  *********************************************************/
@@ -22,6 +24,22 @@ fvec_L2sqr_avx(const float* x, const float* y, size_t d);
 float
 fvec_inner_product_avx(const float* x, const float* y, size_t d);
 
+/// inner products between x and four vectors at once
+void
+fvec_inner_product_batch_4_avx(const float* x, const float* y0, const float* y1,
+                               const float* y2, const float* y3, size_t d,
+                               float& dis0, float& dis1, float& dis2, float& dis3);
+
+/// squared L2 distances between x and four vectors at once
+void
+fvec_L2sqr_batch_4_avx(const float* x, const float* y0, const float* y1,
+                       const float* y2, const float* y3, size_t d,
+                       float& dis0, float& dis1, float& dis2, float& dis3);
+
+/// sets the kernels unrolled for dimension d, false if d has none
+bool
+fvec_kernels_avx(size_t d, FvecKernels& kernels);
+
 /// L1 distance
 float
 fvec_L1_avx(const float* x, const float* y, size_t d);
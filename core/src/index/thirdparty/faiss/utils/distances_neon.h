@@ -0,0 +1,48 @@
+
+// -*- c++ -*-
+
+/* All distance functions for L2 and IP distances.
+ * The actual functions are implemented in distances_simd_neon.cpp */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace faiss {
+
+/*********************************************************
+ * Optimized distance/norm/inner prod computations
+ *********************************************************/
+
+/// Squared L2 distance between two vectors
+float
+fvec_L2sqr_neon(const float* x, const float* y, size_t d);
+
+/// inner product
+float
+fvec_inner_product_neon(const float* x, const float* y, size_t d);
+
+/// inner products between x and four vectors at once
+void
+fvec_inner_product_batch_4_neon(const float* x, const float* y0, const float* y1,
+                                const float* y2, const float* y3, size_t d,
+                                float& dis0, float& dis1, float& dis2, float& dis3);
+
+/// squared L2 distances between x and four vectors at once
+void
+fvec_L2sqr_batch_4_neon(const float* x, const float* y0, const float* y1,
+                        const float* y2, const float* y3, size_t d,
+                        float& dis0, float& dis1, float& dis2, float& dis3);
+
+/// L1 distance
+float
+fvec_L1_neon(const float* x, const float* y, size_t d);
+
+float
+fvec_Linf_neon(const float* x, const float* y, size_t d);
+
+/// squared norm of a vector
+float
+fvec_norm_L2sqr_neon(const float* x, size_t d);
+
+} // namespace faiss
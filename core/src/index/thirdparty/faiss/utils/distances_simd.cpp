@@ -20,7 +20,7 @@
 #endif
 
 #ifdef __aarch64__
-#include <arm_neon.h>
+#include <faiss/utils/distances_neon.h>
 #endif
 
 #include <omp.h>
@@ -376,108 +376,111 @@ float fvec_inner_product_sse (const float * x,
     return  _mm_cvtss_f32 (msum1);
 }
 
+// reduces an SSE accumulator plus the last 0..3 values, as fvec_L2sqr_sse does
+static inline float L2sqr_tail_sse (__m128 msum1, const float * x, const float * y, size_t d)
+{
+    if (d > 0) {
+        __m128 mx = masked_read (d, x);
+        __m128 my = masked_read (d, y);
+        __m128 a_m_b1 = mx - my;
+        msum1 += a_m_b1 * a_m_b1;
+    }
+
+    msum1 = _mm_hadd_ps (msum1, msum1);
+    msum1 = _mm_hadd_ps (msum1, msum1);
+    return  _mm_cvtss_f32 (msum1);
+}
+
+static inline float inner_product_tail_sse (__m128 msum1, const float * x, const float * y, size_t d)
+{
+    __m128 mx = masked_read (d, x);
+    __m128 my = masked_read (d, y);
+    msum1 = _mm_add_ps (msum1, _mm_mul_ps (mx, my));
+
+    msum1 = _mm_hadd_ps (msum1, msum1);
+    msum1 = _mm_hadd_ps (msum1, msum1);
+    return  _mm_cvtss_f32 (msum1);
+}
+
+void fvec_L2sqr_batch_4_sse (const float * x,
+                             const float * y0, const float * y1,
+                             const float * y2, const float * y3,
+                             size_t d,
+                             float & dis0, float & dis1, float & dis2, float & dis3)
+{
+    __m128 msum0 = _mm_setzero_ps();
+    __m128 msum1 = _mm_setzero_ps();
+    __m128 msum2 = _mm_setzero_ps();
+    __m128 msum3 = _mm_setzero_ps();
+
+    const size_t d4 = d & ~(size_t)3;
+    for (size_t i = 0; i < d4; i += 4) {
+        __m128 mx = _mm_loadu_ps (x + i);
+        const __m128 a_m_b0 = mx - _mm_loadu_ps (y0 + i);
+        const __m128 a_m_b1 = mx - _mm_loadu_ps (y1 + i);
+        const __m128 a_m_b2 = mx - _mm_loadu_ps (y2 + i);
+        const __m128 a_m_b3 = mx - _mm_loadu_ps (y3 + i);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+
+    dis0 = L2sqr_tail_sse (msum0, x + d4, y0 + d4, d - d4);
+    dis1 = L2sqr_tail_sse (msum1, x + d4, y1 + d4, d - d4);
+    dis2 = L2sqr_tail_sse (msum2, x + d4, y2 + d4, d - d4);
+    dis3 = L2sqr_tail_sse (msum3, x + d4, y3 + d4, d - d4);
+}
+
+void fvec_inner_product_batch_4_sse (const float * x,
+                                     const float * y0, const float * y1,
+                                     const float * y2, const float * y3,
+                                     size_t d,
+                                     float & dis0, float & dis1, float & dis2, float & dis3)
+{
+    __m128 msum0 = _mm_setzero_ps();
+    __m128 msum1 = _mm_setzero_ps();
+    __m128 msum2 = _mm_setzero_ps();
+    __m128 msum3 = _mm_setzero_ps();
+
+    const size_t d4 = d & ~(size_t)3;
+    for (size_t i = 0; i < d4; i += 4) {
+        __m128 mx = _mm_loadu_ps (x + i);
+        msum0 = _mm_add_ps (msum0, _mm_mul_ps (mx, _mm_loadu_ps (y0 + i)));
+        msum1 = _mm_add_ps (msum1, _mm_mul_ps (mx, _mm_loadu_ps (y1 + i)));
+        msum2 = _mm_add_ps (msum2, _mm_mul_ps (mx, _mm_loadu_ps (y2 + i)));
+        msum3 = _mm_add_ps (msum3, _mm_mul_ps (mx, _mm_loadu_ps (y3 + i)));
+    }
+
+    dis0 = inner_product_tail_sse (msum0, x + d4, y0 + d4, d - d4);
+    dis1 = inner_product_tail_sse (msum1, x + d4, y1 + d4, d - d4);
+    dis2 = inner_product_tail_sse (msum2, x + d4, y2 + d4, d - d4);
+    dis3 = inner_product_tail_sse (msum3, x + d4, y3 + d4, d - d4);
+}
+
 #endif /* defined(__SSE__) */
 
-//#elif defined(__aarch64__)
-//
-//float fvec_L2sqr (const float * x,
-//                  const float * y,
-//                  size_t d)
-//{
-//    if (d & 3) return fvec_L2sqr_ref (x, y, d);
-//    float32x4_t accu = vdupq_n_f32 (0);
-//    for (size_t i = 0; i < d; i += 4) {
-//        float32x4_t xi = vld1q_f32 (x + i);
-//        float32x4_t yi = vld1q_f32 (y + i);
-//        float32x4_t sq = vsubq_f32 (xi, yi);
-//        accu = vfmaq_f32 (accu, sq, sq);
-//    }
-//    float32x4_t a2 = vpaddq_f32 (accu, accu);
-//    return vdups_laneq_f32 (a2, 0) + vdups_laneq_f32 (a2, 1);
-//}
-//
-//float fvec_inner_product (const float * x,
-//                          const float * y,
-//                          size_t d)
-//{
-//    if (d & 3) return fvec_inner_product_ref (x, y, d);
-//    float32x4_t accu = vdupq_n_f32 (0);
-//    for (size_t i = 0; i < d; i += 4) {
-//        float32x4_t xi = vld1q_f32 (x + i);
-//        float32x4_t yi = vld1q_f32 (y + i);
-//        accu = vfmaq_f32 (accu, xi, yi);
-//    }
-//    float32x4_t a2 = vpaddq_f32 (accu, accu);
-//    return vdups_laneq_f32 (a2, 0) + vdups_laneq_f32 (a2, 1);
-//}
-//
-//float fvec_norm_L2sqr (const float *x, size_t d)
-//{
-//    if (d & 3) return fvec_norm_L2sqr_ref (x, d);
-//    float32x4_t accu = vdupq_n_f32 (0);
-//    for (size_t i = 0; i < d; i += 4) {
-//        float32x4_t xi = vld1q_f32 (x + i);
-//        accu = vfmaq_f32 (accu, xi, xi);
-//    }
-//    float32x4_t a2 = vpaddq_f32 (accu, accu);
-//    return vdups_laneq_f32 (a2, 0) + vdups_laneq_f32 (a2, 1);
-//}
-//
-//// not optimized for ARM
-//void fvec_L2sqr_ny (float * dis, const float * x,
-//                        const float * y, size_t d, size_t ny) {
-//    fvec_L2sqr_ny_ref (dis, x, y, d, ny);
-//}
-//
-//float fvec_L1 (const float * x, const float * y, size_t d)
-//{
-//    return fvec_L1_ref (x, y, d);
-//}
-//
-//float fvec_Linf (const float * x, const float * y, size_t d)
-//{
-//    return fvec_Linf_ref (x, y, d);
-//}
-//
-//
-//#else
-// scalar implementation
-
-//float fvec_L2sqr (const float * x,
-//                  const float * y,
-//                  size_t d)
-//{
-//    return fvec_L2sqr_ref (x, y, d);
-//}
-//
-//float fvec_L1 (const float * x, const float * y, size_t d)
-//{
-//    return fvec_L1_ref (x, y, d);
-//}
-//
-//float fvec_Linf (const float * x, const float * y, size_t d)
-//{
-//    return fvec_Linf_ref (x, y, d);
-//}
-//
-//float fvec_inner_product (const float * x,
-//                             const float * y,
-//                             size_t d)
-//{
-//    return fvec_inner_product_ref (x, y, d);
-//}
-//
-//float fvec_norm_L2sqr (const float *x, size_t d)
-//{
-//    return fvec_norm_L2sqr_ref (x, d);
-//}
-//
-//void fvec_L2sqr_ny (float * dis, const float * x,
-//                        const float * y, size_t d, size_t ny) {
-//    fvec_L2sqr_ny_ref (dis, x, y, d, ny);
-//}
-//
-//#endif
+#if !defined(__SSE__)
+
+/* fvec_L2sqr, fvec_inner_product, fvec_L1 and fvec_Linf are hooks set by
+   hook_init (NEON kernels on aarch64), only the functions below need a
+   version for targets without SSE */
+
+float fvec_norm_L2sqr (const float *x, size_t d)
+{
+#ifdef __aarch64__
+    return fvec_norm_L2sqr_neon (x, d);
+#else
+    return fvec_norm_L2sqr_ref (x, d);
+#endif
+}
+
+void fvec_L2sqr_ny (float * dis, const float * x,
+                    const float * y, size_t d, size_t ny) {
+    fvec_L2sqr_ny_ref (dis, x, y, d, ny);
+}
+
+#endif /* !defined(__SSE__) */
 
 
 
@@ -2,6 +2,7 @@
 // -*- c++ -*-
 
 #include <faiss/utils/distances_avx.h>
+#include <faiss/FaissHook.h>
 #include <faiss/impl/FaissAssert.h>
 
 #include <cstdio>
@@ -48,16 +49,8 @@ static inline __m256 masked_read_8 (int d, const float* x) {
     }
 }
 
-float fvec_inner_product_avx (const float* x, const float* y, size_t d) {
-    __m256 msum1 = _mm256_setzero_ps();
-
-    while (d >= 8) {
-        __m256 mx = _mm256_loadu_ps (x); x += 8;
-        __m256 my = _mm256_loadu_ps (y); y += 8;
-        msum1 = _mm256_add_ps (msum1, _mm256_mul_ps (mx, my));
-        d -= 8;
-    }
-
+// finishes an inner product from the 8-wide partial sums, 0 <= d < 8
+static inline float inner_product_tail_avx (__m256 msum1, const float* x, const float* y, size_t d) {
     __m128 msum2 = _mm256_extractf128_ps(msum1, 1);
     msum2 +=       _mm256_extractf128_ps(msum1, 0);
 
@@ -79,17 +72,8 @@ float fvec_inner_product_avx (const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
-float fvec_L2sqr_avx (const float* x, const float* y, size_t d) {
-    __m256 msum1 = _mm256_setzero_ps();
-
-    while (d >= 8) {
-        __m256 mx = _mm256_loadu_ps (x); x += 8;
-        __m256 my = _mm256_loadu_ps (y); y += 8;
-        const __m256 a_m_b1 = mx - my;
-        msum1 += a_m_b1 * a_m_b1;
-        d -= 8;
-    }
-
+// finishes a squared L2 distance from the 8-wide partial sums, 0 <= d < 8
+static inline float L2sqr_tail_avx (__m256 msum1, const float* x, const float* y, size_t d) {
     __m128 msum2 = _mm256_extractf128_ps(msum1, 1);
     msum2 +=       _mm256_extractf128_ps(msum1, 0);
 
@@ -113,6 +97,179 @@ float fvec_L2sqr_avx (const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+float fvec_inner_product_avx (const float* x, const float* y, size_t d) {
+    __m256 msum1 = _mm256_setzero_ps();
+
+    while (d >= 8) {
+        __m256 mx = _mm256_loadu_ps (x); x += 8;
+        __m256 my = _mm256_loadu_ps (y); y += 8;
+        msum1 = _mm256_add_ps (msum1, _mm256_mul_ps (mx, my));
+        d -= 8;
+    }
+
+    return inner_product_tail_avx (msum1, x, y, d);
+}
+
+float fvec_L2sqr_avx (const float* x, const float* y, size_t d) {
+    __m256 msum1 = _mm256_setzero_ps();
+
+    while (d >= 8) {
+        __m256 mx = _mm256_loadu_ps (x); x += 8;
+        __m256 my = _mm256_loadu_ps (y); y += 8;
+        const __m256 a_m_b1 = mx - my;
+        msum1 += a_m_b1 * a_m_b1;
+        d -= 8;
+    }
+
+    return L2sqr_tail_avx (msum1, x, y, d);
+}
+
+// one load of x feeds four accumulators; summation order matches fvec_inner_product_avx
+void fvec_inner_product_batch_4_avx (const float* x, const float* y0, const float* y1,
+                                     const float* y2, const float* y3, size_t d,
+                                     float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m256 msum0 = _mm256_setzero_ps();
+    __m256 msum1 = _mm256_setzero_ps();
+    __m256 msum2 = _mm256_setzero_ps();
+    __m256 msum3 = _mm256_setzero_ps();
+
+    const size_t d8 = d & ~(size_t)7;
+    for (size_t i = 0; i < d8; i += 8) {
+        __m256 mx = _mm256_loadu_ps (x + i);
+        msum0 = _mm256_add_ps (msum0, _mm256_mul_ps (mx, _mm256_loadu_ps (y0 + i)));
+        msum1 = _mm256_add_ps (msum1, _mm256_mul_ps (mx, _mm256_loadu_ps (y1 + i)));
+        msum2 = _mm256_add_ps (msum2, _mm256_mul_ps (mx, _mm256_loadu_ps (y2 + i)));
+        msum3 = _mm256_add_ps (msum3, _mm256_mul_ps (mx, _mm256_loadu_ps (y3 + i)));
+    }
+
+    dis0 = inner_product_tail_avx (msum0, x + d8, y0 + d8, d - d8);
+    dis1 = inner_product_tail_avx (msum1, x + d8, y1 + d8, d - d8);
+    dis2 = inner_product_tail_avx (msum2, x + d8, y2 + d8, d - d8);
+    dis3 = inner_product_tail_avx (msum3, x + d8, y3 + d8, d - d8);
+}
+
+void fvec_L2sqr_batch_4_avx (const float* x, const float* y0, const float* y1,
+                             const float* y2, const float* y3, size_t d,
+                             float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m256 msum0 = _mm256_setzero_ps();
+    __m256 msum1 = _mm256_setzero_ps();
+    __m256 msum2 = _mm256_setzero_ps();
+    __m256 msum3 = _mm256_setzero_ps();
+
+    const size_t d8 = d & ~(size_t)7;
+    for (size_t i = 0; i < d8; i += 8) {
+        __m256 mx = _mm256_loadu_ps (x + i);
+        const __m256 a_m_b0 = mx - _mm256_loadu_ps (y0 + i);
+        const __m256 a_m_b1 = mx - _mm256_loadu_ps (y1 + i);
+        const __m256 a_m_b2 = mx - _mm256_loadu_ps (y2 + i);
+        const __m256 a_m_b3 = mx - _mm256_loadu_ps (y3 + i);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+
+    dis0 = L2sqr_tail_avx (msum0, x + d8, y0 + d8, d - d8);
+    dis1 = L2sqr_tail_avx (msum1, x + d8, y1 + d8, d - d8);
+    dis2 = L2sqr_tail_avx (msum2, x + d8, y2 + d8, d - d8);
+    dis3 = L2sqr_tail_avx (msum3, x + d8, y3 + d8, d - d8);
+}
+
+// kernels of a dimension D known at compile time, a multiple of 8: the loop is unrolled and has no tail,
+// the summation order is the one of the generic kernels so are the results
+template <size_t D>
+static float fvec_inner_product_avx_d (const float* x, const float* y, size_t) {
+    __m256 msum1 = _mm256_setzero_ps();
+#pragma GCC unroll 128
+    for (size_t i = 0; i < D; i += 8) {
+        msum1 = _mm256_add_ps (msum1, _mm256_mul_ps (_mm256_loadu_ps (x + i), _mm256_loadu_ps (y + i)));
+    }
+    return inner_product_tail_avx (msum1, x + D, y + D, 0);
+}
+
+template <size_t D>
+static float fvec_L2sqr_avx_d (const float* x, const float* y, size_t) {
+    __m256 msum1 = _mm256_setzero_ps();
+#pragma GCC unroll 128
+    for (size_t i = 0; i < D; i += 8) {
+        const __m256 a_m_b1 = _mm256_loadu_ps (x + i) - _mm256_loadu_ps (y + i);
+        msum1 += a_m_b1 * a_m_b1;
+    }
+    return L2sqr_tail_avx (msum1, x + D, y + D, 0);
+}
+
+template <size_t D>
+static void fvec_inner_product_batch_4_avx_d (const float* x, const float* y0, const float* y1,
+                                              const float* y2, const float* y3, size_t,
+                                              float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m256 msum0 = _mm256_setzero_ps();
+    __m256 msum1 = _mm256_setzero_ps();
+    __m256 msum2 = _mm256_setzero_ps();
+    __m256 msum3 = _mm256_setzero_ps();
+
+#pragma GCC unroll 128
+    for (size_t i = 0; i < D; i += 8) {
+        __m256 mx = _mm256_loadu_ps (x + i);
+        msum0 = _mm256_add_ps (msum0, _mm256_mul_ps (mx, _mm256_loadu_ps (y0 + i)));
+        msum1 = _mm256_add_ps (msum1, _mm256_mul_ps (mx, _mm256_loadu_ps (y1 + i)));
+        msum2 = _mm256_add_ps (msum2, _mm256_mul_ps (mx, _mm256_loadu_ps (y2 + i)));
+        msum3 = _mm256_add_ps (msum3, _mm256_mul_ps (mx, _mm256_loadu_ps (y3 + i)));
+    }
+
+    dis0 = inner_product_tail_avx (msum0, x + D, y0 + D, 0);
+    dis1 = inner_product_tail_avx (msum1, x + D, y1 + D, 0);
+    dis2 = inner_product_tail_avx (msum2, x + D, y2 + D, 0);
+    dis3 = inner_product_tail_avx (msum3, x + D, y3 + D, 0);
+}
+
+template <size_t D>
+static void fvec_L2sqr_batch_4_avx_d (const float* x, const float* y0, const float* y1,
+                                      const float* y2, const float* y3, size_t,
+                                      float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m256 msum0 = _mm256_setzero_ps();
+    __m256 msum1 = _mm256_setzero_ps();
+    __m256 msum2 = _mm256_setzero_ps();
+    __m256 msum3 = _mm256_setzero_ps();
+
+#pragma GCC unroll 128
+    for (size_t i = 0; i < D; i += 8) {
+        __m256 mx = _mm256_loadu_ps (x + i);
+        const __m256 a_m_b0 = mx - _mm256_loadu_ps (y0 + i);
+        const __m256 a_m_b1 = mx - _mm256_loadu_ps (y1 + i);
+        const __m256 a_m_b2 = mx - _mm256_loadu_ps (y2 + i);
+        const __m256 a_m_b3 = mx - _mm256_loadu_ps (y3 + i);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+
+    dis0 = L2sqr_tail_avx (msum0, x + D, y0 + D, 0);
+    dis1 = L2sqr_tail_avx (msum1, x + D, y1 + D, 0);
+    dis2 = L2sqr_tail_avx (msum2, x + D, y2 + D, 0);
+    dis3 = L2sqr_tail_avx (msum3, x + D, y3 + D, 0);
+}
+
+template <size_t D>
+static void set_kernels_avx (FvecKernels& kernels) {
+    kernels.inner_product = fvec_inner_product_avx_d<D>;
+    kernels.L2sqr = fvec_L2sqr_avx_d<D>;
+    kernels.inner_product_batch_4 = fvec_inner_product_batch_4_avx_d<D>;
+    kernels.L2sqr_batch_4 = fvec_L2sqr_batch_4_avx_d<D>;
+}
+
+bool fvec_kernels_avx (size_t d, FvecKernels& kernels) {
+    switch (d) {
+        case 64: set_kernels_avx<64> (kernels); return true;
+        case 128: set_kernels_avx<128> (kernels); return true;
+        case 256: set_kernels_avx<256> (kernels); return true;
+        case 512: set_kernels_avx<512> (kernels); return true;
+        case 768: set_kernels_avx<768> (kernels); return true;
+        case 1024: set_kernels_avx<1024> (kernels); return true;
+        default: return false;
+    }
+}
+
 float fvec_L1_avx (const float * x, const float * y, size_t d)
 {
     __m256 msum1 = _mm256_setzero_ps();
@@ -198,6 +355,22 @@ float fvec_L2sqr_avx(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+void fvec_inner_product_batch_4_avx(const float* x, const float* y0, const float* y1,
+                                    const float* y2, const float* y3, size_t d,
+                                    float& dis0, float& dis1, float& dis2, float& dis3) {
+    FAISS_ASSERT(false);
+}
+
+void fvec_L2sqr_batch_4_avx(const float* x, const float* y0, const float* y1,
+                            const float* y2, const float* y3, size_t d,
+                            float& dis0, float& dis1, float& dis2, float& dis3) {
+    FAISS_ASSERT(false);
+}
+
+bool fvec_kernels_avx(size_t d, FvecKernels& kernels) {
+    return false;
+}
+
 float fvec_L1_avx(const float* x, const float* y, size_t d) {
     FAISS_ASSERT(false);
     return 0.0;
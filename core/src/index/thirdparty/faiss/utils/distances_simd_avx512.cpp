@@ -2,6 +2,7 @@
 // -*- c++ -*-
 
 #include <faiss/utils/distances_avx512.h>
+#include <faiss/FaissHook.h>
 #include <faiss/impl/FaissAssert.h>
 
 #include <cstdio>
@@ -33,17 +34,9 @@ static inline __m128 masked_read (int d, const float *x) {
 
 #if (defined(__AVX512F__) && defined(__AVX512DQ__))
 
-float
-fvec_inner_product_avx512(const float* x, const float* y, size_t d) {
-    __m512 msum0 = _mm512_setzero_ps();
-
-    while (d >= 16) {
-        __m512 mx = _mm512_loadu_ps (x); x += 16;
-        __m512 my = _mm512_loadu_ps (y); y += 16;
-        msum0 = _mm512_add_ps (msum0, _mm512_mul_ps (mx, my));
-        d -= 16;
-    }
-
+// finishes an inner product from the 16-wide partial sums, 0 <= d < 16
+static inline float
+inner_product_tail_avx512(__m512 msum0, const float* x, const float* y, size_t d) {
     __m256 msum1 = _mm512_extractf32x8_ps(msum0, 1);
     msum1 +=       _mm512_extractf32x8_ps(msum0, 0);
 
@@ -75,18 +68,9 @@ fvec_inner_product_avx512(const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
-float
-fvec_L2sqr_avx512(const float* x, const float* y, size_t d) {
-    __m512 msum0 = _mm512_setzero_ps();
-
-    while (d >= 16) {
-        __m512 mx = _mm512_loadu_ps (x); x += 16;
-        __m512 my = _mm512_loadu_ps (y); y += 16;
-        const __m512 a_m_b1 = mx - my;
-        msum0 += a_m_b1 * a_m_b1;
-        d -= 16;
-    }
-
+// finishes a squared L2 distance from the 16-wide partial sums, 0 <= d < 16
+static inline float
+L2sqr_tail_avx512(__m512 msum0, const float* x, const float* y, size_t d) {
     __m256 msum1 = _mm512_extractf32x8_ps(msum0, 1);
     msum1 +=       _mm512_extractf32x8_ps(msum0, 0);
 
@@ -121,6 +105,189 @@ fvec_L2sqr_avx512(const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+float
+fvec_inner_product_avx512(const float* x, const float* y, size_t d) {
+    __m512 msum0 = _mm512_setzero_ps();
+
+    while (d >= 16) {
+        __m512 mx = _mm512_loadu_ps (x); x += 16;
+        __m512 my = _mm512_loadu_ps (y); y += 16;
+        msum0 = _mm512_add_ps (msum0, _mm512_mul_ps (mx, my));
+        d -= 16;
+    }
+
+    return inner_product_tail_avx512(msum0, x, y, d);
+}
+
+float
+fvec_L2sqr_avx512(const float* x, const float* y, size_t d) {
+    __m512 msum0 = _mm512_setzero_ps();
+
+    while (d >= 16) {
+        __m512 mx = _mm512_loadu_ps (x); x += 16;
+        __m512 my = _mm512_loadu_ps (y); y += 16;
+        const __m512 a_m_b1 = mx - my;
+        msum0 += a_m_b1 * a_m_b1;
+        d -= 16;
+    }
+
+    return L2sqr_tail_avx512(msum0, x, y, d);
+}
+
+// one load of x feeds four accumulators; summation order matches fvec_inner_product_avx512
+void
+fvec_inner_product_batch_4_avx512(const float* x, const float* y0, const float* y1,
+                                  const float* y2, const float* y3, size_t d,
+                                  float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m512 msum0 = _mm512_setzero_ps();
+    __m512 msum1 = _mm512_setzero_ps();
+    __m512 msum2 = _mm512_setzero_ps();
+    __m512 msum3 = _mm512_setzero_ps();
+
+    const size_t d16 = d & ~(size_t)15;
+    for (size_t i = 0; i < d16; i += 16) {
+        __m512 mx = _mm512_loadu_ps (x + i);
+        msum0 = _mm512_add_ps (msum0, _mm512_mul_ps (mx, _mm512_loadu_ps (y0 + i)));
+        msum1 = _mm512_add_ps (msum1, _mm512_mul_ps (mx, _mm512_loadu_ps (y1 + i)));
+        msum2 = _mm512_add_ps (msum2, _mm512_mul_ps (mx, _mm512_loadu_ps (y2 + i)));
+        msum3 = _mm512_add_ps (msum3, _mm512_mul_ps (mx, _mm512_loadu_ps (y3 + i)));
+    }
+
+    dis0 = inner_product_tail_avx512(msum0, x + d16, y0 + d16, d - d16);
+    dis1 = inner_product_tail_avx512(msum1, x + d16, y1 + d16, d - d16);
+    dis2 = inner_product_tail_avx512(msum2, x + d16, y2 + d16, d - d16);
+    dis3 = inner_product_tail_avx512(msum3, x + d16, y3 + d16, d - d16);
+}
+
+void
+fvec_L2sqr_batch_4_avx512(const float* x, const float* y0, const float* y1,
+                          const float* y2, const float* y3, size_t d,
+                          float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m512 msum0 = _mm512_setzero_ps();
+    __m512 msum1 = _mm512_setzero_ps();
+    __m512 msum2 = _mm512_setzero_ps();
+    __m512 msum3 = _mm512_setzero_ps();
+
+    const size_t d16 = d & ~(size_t)15;
+    for (size_t i = 0; i < d16; i += 16) {
+        __m512 mx = _mm512_loadu_ps (x + i);
+        const __m512 a_m_b0 = mx - _mm512_loadu_ps (y0 + i);
+        const __m512 a_m_b1 = mx - _mm512_loadu_ps (y1 + i);
+        const __m512 a_m_b2 = mx - _mm512_loadu_ps (y2 + i);
+        const __m512 a_m_b3 = mx - _mm512_loadu_ps (y3 + i);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+
+    dis0 = L2sqr_tail_avx512(msum0, x + d16, y0 + d16, d - d16);
+    dis1 = L2sqr_tail_avx512(msum1, x + d16, y1 + d16, d - d16);
+    dis2 = L2sqr_tail_avx512(msum2, x + d16, y2 + d16, d - d16);
+    dis3 = L2sqr_tail_avx512(msum3, x + d16, y3 + d16, d - d16);
+}
+
+// kernels of a dimension D known at compile time, a multiple of 16: the loop is unrolled and has no tail,
+// the summation order is the one of the generic kernels so are the results
+template <size_t D>
+static float
+fvec_inner_product_avx512_d(const float* x, const float* y, size_t) {
+    __m512 msum0 = _mm512_setzero_ps();
+#pragma GCC unroll 64
+    for (size_t i = 0; i < D; i += 16) {
+        msum0 = _mm512_add_ps (msum0, _mm512_mul_ps (_mm512_loadu_ps (x + i), _mm512_loadu_ps (y + i)));
+    }
+    return inner_product_tail_avx512(msum0, x + D, y + D, 0);
+}
+
+template <size_t D>
+static float
+fvec_L2sqr_avx512_d(const float* x, const float* y, size_t) {
+    __m512 msum0 = _mm512_setzero_ps();
+#pragma GCC unroll 64
+    for (size_t i = 0; i < D; i += 16) {
+        const __m512 a_m_b1 = _mm512_loadu_ps (x + i) - _mm512_loadu_ps (y + i);
+        msum0 += a_m_b1 * a_m_b1;
+    }
+    return L2sqr_tail_avx512(msum0, x + D, y + D, 0);
+}
+
+template <size_t D>
+static void
+fvec_inner_product_batch_4_avx512_d(const float* x, const float* y0, const float* y1,
+                                    const float* y2, const float* y3, size_t,
+                                    float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m512 msum0 = _mm512_setzero_ps();
+    __m512 msum1 = _mm512_setzero_ps();
+    __m512 msum2 = _mm512_setzero_ps();
+    __m512 msum3 = _mm512_setzero_ps();
+
+#pragma GCC unroll 64
+    for (size_t i = 0; i < D; i += 16) {
+        __m512 mx = _mm512_loadu_ps (x + i);
+        msum0 = _mm512_add_ps (msum0, _mm512_mul_ps (mx, _mm512_loadu_ps (y0 + i)));
+        msum1 = _mm512_add_ps (msum1, _mm512_mul_ps (mx, _mm512_loadu_ps (y1 + i)));
+        msum2 = _mm512_add_ps (msum2, _mm512_mul_ps (mx, _mm512_loadu_ps (y2 + i)));
+        msum3 = _mm512_add_ps (msum3, _mm512_mul_ps (mx, _mm512_loadu_ps (y3 + i)));
+    }
+
+    dis0 = inner_product_tail_avx512(msum0, x + D, y0 + D, 0);
+    dis1 = inner_product_tail_avx512(msum1, x + D, y1 + D, 0);
+    dis2 = inner_product_tail_avx512(msum2, x + D, y2 + D, 0);
+    dis3 = inner_product_tail_avx512(msum3, x + D, y3 + D, 0);
+}
+
+template <size_t D>
+static void
+fvec_L2sqr_batch_4_avx512_d(const float* x, const float* y0, const float* y1,
+                            const float* y2, const float* y3, size_t,
+                            float& dis0, float& dis1, float& dis2, float& dis3) {
+    __m512 msum0 = _mm512_setzero_ps();
+    __m512 msum1 = _mm512_setzero_ps();
+    __m512 msum2 = _mm512_setzero_ps();
+    __m512 msum3 = _mm512_setzero_ps();
+
+#pragma GCC unroll 64
+    for (size_t i = 0; i < D; i += 16) {
+        __m512 mx = _mm512_loadu_ps (x + i);
+        const __m512 a_m_b0 = mx - _mm512_loadu_ps (y0 + i);
+        const __m512 a_m_b1 = mx - _mm512_loadu_ps (y1 + i);
+        const __m512 a_m_b2 = mx - _mm512_loadu_ps (y2 + i);
+        const __m512 a_m_b3 = mx - _mm512_loadu_ps (y3 + i);
+        msum0 += a_m_b0 * a_m_b0;
+        msum1 += a_m_b1 * a_m_b1;
+        msum2 += a_m_b2 * a_m_b2;
+        msum3 += a_m_b3 * a_m_b3;
+    }
+
+    dis0 = L2sqr_tail_avx512(msum0, x + D, y0 + D, 0);
+    dis1 = L2sqr_tail_avx512(msum1, x + D, y1 + D, 0);
+    dis2 = L2sqr_tail_avx512(msum2, x + D, y2 + D, 0);
+    dis3 = L2sqr_tail_avx512(msum3, x + D, y3 + D, 0);
+}
+
+template <size_t D>
+static void
+set_kernels_avx512(FvecKernels& kernels) {
+    kernels.inner_product = fvec_inner_product_avx512_d<D>;
+    kernels.L2sqr = fvec_L2sqr_avx512_d<D>;
+    kernels.inner_product_batch_4 = fvec_inner_product_batch_4_avx512_d<D>;
+    kernels.L2sqr_batch_4 = fvec_L2sqr_batch_4_avx512_d<D>;
+}
+
+bool
+fvec_kernels_avx512(size_t d, FvecKernels& kernels) {
+    switch (d) {
+        case 64: set_kernels_avx512<64>(kernels); return true;
+        case 128: set_kernels_avx512<128>(kernels); return true;
+        case 256: set_kernels_avx512<256>(kernels); return true;
+        case 512: set_kernels_avx512<512>(kernels); return true;
+        case 768: set_kernels_avx512<768>(kernels); return true;
+        case 1024: set_kernels_avx512<1024>(kernels); return true;
+        default: return false;
+    }
+}
+
 float
 fvec_L1_avx512(const float* x, const float* y, size_t d) {
     __m512 msum0 = _mm512_setzero_ps();
@@ -233,6 +400,25 @@ fvec_L2sqr_avx512(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+void
+fvec_inner_product_batch_4_avx512(const float* x, const float* y0, const float* y1,
+                                  const float* y2, const float* y3, size_t d,
+                                  float& dis0, float& dis1, float& dis2, float& dis3) {
+    FAISS_ASSERT(false);
+}
+
+void
+fvec_L2sqr_batch_4_avx512(const float* x, const float* y0, const float* y1,
+                          const float* y2, const float* y3, size_t d,
+                          float& dis0, float& dis1, float& dis2, float& dis3) {
+    FAISS_ASSERT(false);
+}
+
+bool
+fvec_kernels_avx512(size_t d, FvecKernels& kernels) {
+    return false;
+}
+
 float
 fvec_L1_avx512(const float* x, const float* y, size_t d) {
     FAISS_ASSERT(false);
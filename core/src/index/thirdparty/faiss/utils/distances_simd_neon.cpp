@@ -0,0 +1,224 @@
+
+// -*- c++ -*-
+
+#include <faiss/utils/distances_neon.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+#include <cmath>
+
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
+
+namespace faiss {
+
+#ifdef __aarch64__
+
+/* Advanced SIMD is mandatory on aarch64, so these kernels only need
+ * the baseline -march. Vectors of any dimension are handled: the last
+ * d % 4 components are accumulated in scalar code. */
+
+float fvec_inner_product_neon (const float* x, const float* y, size_t d) {
+    // two accumulators so consecutive fma do not wait on each other
+    float32x4_t msum0 = vdupq_n_f32 (0);
+    float32x4_t msum1 = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 8 <= d; i += 8) {
+        msum0 = vfmaq_f32 (msum0, vld1q_f32 (x + i), vld1q_f32 (y + i));
+        msum1 = vfmaq_f32 (msum1, vld1q_f32 (x + i + 4), vld1q_f32 (y + i + 4));
+    }
+    if (i + 4 <= d) {
+        msum0 = vfmaq_f32 (msum0, vld1q_f32 (x + i), vld1q_f32 (y + i));
+        i += 4;
+    }
+
+    float res = vaddvq_f32 (vaddq_f32 (msum0, msum1));
+    for (; i < d; i++) {
+        res += x[i] * y[i];
+    }
+    return res;
+}
+
+float fvec_L2sqr_neon (const float* x, const float* y, size_t d) {
+    float32x4_t msum0 = vdupq_n_f32 (0);
+    float32x4_t msum1 = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 8 <= d; i += 8) {
+        float32x4_t a0 = vsubq_f32 (vld1q_f32 (x + i), vld1q_f32 (y + i));
+        float32x4_t a1 = vsubq_f32 (vld1q_f32 (x + i + 4), vld1q_f32 (y + i + 4));
+        msum0 = vfmaq_f32 (msum0, a0, a0);
+        msum1 = vfmaq_f32 (msum1, a1, a1);
+    }
+    if (i + 4 <= d) {
+        float32x4_t a0 = vsubq_f32 (vld1q_f32 (x + i), vld1q_f32 (y + i));
+        msum0 = vfmaq_f32 (msum0, a0, a0);
+        i += 4;
+    }
+
+    float res = vaddvq_f32 (vaddq_f32 (msum0, msum1));
+    for (; i < d; i++) {
+        float tmp = x[i] - y[i];
+        res += tmp * tmp;
+    }
+    return res;
+}
+
+float fvec_norm_L2sqr_neon (const float* x, size_t d) {
+    float32x4_t msum0 = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 4 <= d; i += 4) {
+        float32x4_t mx = vld1q_f32 (x + i);
+        msum0 = vfmaq_f32 (msum0, mx, mx);
+    }
+
+    float res = vaddvq_f32 (msum0);
+    for (; i < d; i++) {
+        res += x[i] * x[i];
+    }
+    return res;
+}
+
+void fvec_inner_product_batch_4_neon (const float* x, const float* y0, const float* y1,
+                                      const float* y2, const float* y3, size_t d,
+                                      float& dis0, float& dis1, float& dis2, float& dis3) {
+    float32x4_t msum0 = vdupq_n_f32 (0);
+    float32x4_t msum1 = vdupq_n_f32 (0);
+    float32x4_t msum2 = vdupq_n_f32 (0);
+    float32x4_t msum3 = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 4 <= d; i += 4) {
+        float32x4_t mx = vld1q_f32 (x + i);
+        msum0 = vfmaq_f32 (msum0, mx, vld1q_f32 (y0 + i));
+        msum1 = vfmaq_f32 (msum1, mx, vld1q_f32 (y1 + i));
+        msum2 = vfmaq_f32 (msum2, mx, vld1q_f32 (y2 + i));
+        msum3 = vfmaq_f32 (msum3, mx, vld1q_f32 (y3 + i));
+    }
+
+    dis0 = vaddvq_f32 (msum0);
+    dis1 = vaddvq_f32 (msum1);
+    dis2 = vaddvq_f32 (msum2);
+    dis3 = vaddvq_f32 (msum3);
+    for (; i < d; i++) {
+        dis0 += x[i] * y0[i];
+        dis1 += x[i] * y1[i];
+        dis2 += x[i] * y2[i];
+        dis3 += x[i] * y3[i];
+    }
+}
+
+void fvec_L2sqr_batch_4_neon (const float* x, const float* y0, const float* y1,
+                              const float* y2, const float* y3, size_t d,
+                              float& dis0, float& dis1, float& dis2, float& dis3) {
+    float32x4_t msum0 = vdupq_n_f32 (0);
+    float32x4_t msum1 = vdupq_n_f32 (0);
+    float32x4_t msum2 = vdupq_n_f32 (0);
+    float32x4_t msum3 = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 4 <= d; i += 4) {
+        float32x4_t mx = vld1q_f32 (x + i);
+        float32x4_t a0 = vsubq_f32 (mx, vld1q_f32 (y0 + i));
+        float32x4_t a1 = vsubq_f32 (mx, vld1q_f32 (y1 + i));
+        float32x4_t a2 = vsubq_f32 (mx, vld1q_f32 (y2 + i));
+        float32x4_t a3 = vsubq_f32 (mx, vld1q_f32 (y3 + i));
+        msum0 = vfmaq_f32 (msum0, a0, a0);
+        msum1 = vfmaq_f32 (msum1, a1, a1);
+        msum2 = vfmaq_f32 (msum2, a2, a2);
+        msum3 = vfmaq_f32 (msum3, a3, a3);
+    }
+
+    dis0 = vaddvq_f32 (msum0);
+    dis1 = vaddvq_f32 (msum1);
+    dis2 = vaddvq_f32 (msum2);
+    dis3 = vaddvq_f32 (msum3);
+    for (; i < d; i++) {
+        float t0 = x[i] - y0[i];
+        float t1 = x[i] - y1[i];
+        float t2 = x[i] - y2[i];
+        float t3 = x[i] - y3[i];
+        dis0 += t0 * t0;
+        dis1 += t1 * t1;
+        dis2 += t2 * t2;
+        dis3 += t3 * t3;
+    }
+}
+
+float fvec_L1_neon (const float* x, const float* y, size_t d) {
+    float32x4_t msum0 = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 4 <= d; i += 4) {
+        msum0 = vaddq_f32 (msum0, vabdq_f32 (vld1q_f32 (x + i), vld1q_f32 (y + i)));
+    }
+
+    float res = vaddvq_f32 (msum0);
+    for (; i < d; i++) {
+        res += fabs (x[i] - y[i]);
+    }
+    return res;
+}
+
+float fvec_Linf_neon (const float* x, const float* y, size_t d) {
+    float32x4_t mmax = vdupq_n_f32 (0);
+
+    size_t i = 0;
+    for (; i + 4 <= d; i += 4) {
+        mmax = vmaxq_f32 (mmax, vabdq_f32 (vld1q_f32 (x + i), vld1q_f32 (y + i)));
+    }
+
+    float res = vmaxvq_f32 (mmax);
+    for (; i < d; i++) {
+        res = fmax (res, fabs (x[i] - y[i]));
+    }
+    return res;
+}
+
+#else
+
+float fvec_inner_product_neon(const float* x, const float* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float fvec_L2sqr_neon(const float* x, const float* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float fvec_norm_L2sqr_neon(const float* x, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+void fvec_inner_product_batch_4_neon(const float* x, const float* y0, const float* y1,
+                                     const float* y2, const float* y3, size_t d,
+                                     float& dis0, float& dis1, float& dis2, float& dis3) {
+    FAISS_ASSERT(false);
+}
+
+void fvec_L2sqr_batch_4_neon(const float* x, const float* y0, const float* y1,
+                             const float* y2, const float* y3, size_t d,
+                             float& dis0, float& dis1, float& dis2, float& dis3) {
+    FAISS_ASSERT(false);
+}
+
+float fvec_L1_neon(const float* x, const float* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float fvec_Linf_neon(const float* x, const float* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+#endif
+
+} // namespace faiss
@@ -32,6 +32,7 @@
 #include <math.h>
 #include <omp.h>
 
+#include <faiss/utils/BinaryDistance.h>
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
@@ -687,7 +688,10 @@ void hammings_knn_hc (
             (32, ha, a, b, nb, order, true, bitset);
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (ncodes >= BINARY_SIMD_MIN_CODE_SIZE) {
+            hammings_knn_hc<faiss::HammingComputerSIMD>
+                (ncodes, ha, a, b, nb, order, true, bitset);
+        } else if(ncodes % 8 == 0) {
             hammings_knn_hc<faiss::HammingComputerM8>
                 (ncodes, ha, a, b, nb, order, true, bitset);
         } else {
@@ -733,7 +737,11 @@ void hammings_knn_mc(
         );
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (ncodes >= BINARY_SIMD_MIN_CODE_SIZE) {
+            hammings_knn_mc<faiss::HammingComputerSIMD>(
+              ncodes, a, b, na, nb, k, distances, labels, bitset
+            );
+        } else if(ncodes % 8 == 0) {
             hammings_knn_mc<faiss::HammingComputerM8>(
               ncodes, a, b, na, nb, k, distances, labels, bitset
             );
@@ -753,7 +761,8 @@ void hamming_range_search_template (
     size_t nb,
     int radius,
     size_t code_size,
-    RangeSearchResult *res)
+    RangeSearchResult *res,
+    ConcurrentBitsetPtr bitset)
 {
 
 #pragma omp parallel
@@ -766,12 +775,14 @@ void hamming_range_search_template (
             const uint8_t * yi = b;
             RangeQueryResult & qres = pres.new_result (i);
 
-            for (size_t j = 0; j < nb; j++) {
+            for (size_t j = 0; j < nb; j++, yi += code_size) {
+                if (bitset && bitset->test(j)) {
+                    continue;
+                }
                 int dis = hc.hamming (yi);
                 if (dis < radius) {
                     qres.add(dis, j);
                 }
-                yi += code_size;
             }
         }
         pres.finalize ();
@@ -785,10 +796,11 @@ void hamming_range_search (
     size_t nb,
     int radius,
     size_t code_size,
-    RangeSearchResult *result)
+    RangeSearchResult *result,
+    ConcurrentBitsetPtr bitset)
 {
 
-#define HC(name) hamming_range_search_template<name> (a, b, na, nb, radius, code_size, result)
+#define HC(name) hamming_range_search_template<name> (a, b, na, nb, radius, code_size, result, bitset)
 
     switch(code_size) {
     case 4: HC(HammingComputer4); break;
@@ -796,7 +808,9 @@ void hamming_range_search (
     case 16: HC(HammingComputer16); break;
     case 32: HC(HammingComputer32); break;
     default:
-        if (code_size % 8 == 0) {
+        if (code_size >= BINARY_SIMD_MIN_CODE_SIZE) {
+            HC(HammingComputerSIMD);
+        } else if (code_size % 8 == 0) {
             HC(HammingComputerM8);
         } else {
             HC(HammingComputerDefault);
@@ -191,7 +191,8 @@ void hamming_range_search (
     size_t nb,
     int radius,
     size_t ncodes,
-    RangeSearchResult *result);
+    RangeSearchResult *result,
+    ConcurrentBitsetPtr bitset = nullptr);
 
 
 /* Counting the number of matches or of cross-matches (without returning them)
@@ -3,12 +3,18 @@
 
 #include <array>
 #include <bitset>
-#include <cpuid.h>
 #include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
 namespace faiss {
 
 class InstructionSet {
@@ -31,8 +37,13 @@ class InstructionSet {
           f_7_ECX_{0},
           f_81_ECX_{0},
           f_81_EDX_{0},
+          hwcap_{0},
           data_{},
           extdata_{} {
+#if defined(__aarch64__)
+        // aarch64 has no cpuid, the kernel reports the features in the auxiliary vector
+        hwcap_ = getauxval(AT_HWCAP);
+#elif defined(__x86_64__) || defined(__i386__)
         std::array<int, 4> cpui;
 
         // Calling __cpuid with 0x0 as the function_id argument
@@ -96,6 +107,7 @@ class InstructionSet {
             memcpy(brand + 32, extdata_[4].data(), sizeof(cpui));
             brand_ = brand;
         }
+#endif
     };
 
  public:
@@ -288,6 +300,10 @@ class InstructionSet {
     PREFETCHWT1(void) {
         return f_7_ECX_[0];
     }
+    bool
+    AVX512VPOPCNTDQ(void) {
+        return f_7_ECX_[14];
+    }
 
     bool
     LAHF(void) {
@@ -335,6 +351,15 @@ class InstructionSet {
         return isAMD_ && f_81_EDX_[31];
     }
 
+    bool
+    NEON(void) {
+#if defined(__aarch64__)
+        return hwcap_ & HWCAP_ASIMD;
+#else
+        return false;
+#endif
+    }
+
  private:
     int nIds_;
     int nExIds_;
@@ -348,6 +373,7 @@ class InstructionSet {
     std::bitset<32> f_7_ECX_;
     std::bitset<32> f_81_ECX_;
     std::bitset<32> f_81_EDX_;
+    unsigned long hwcap_;
     std::vector<std::array<int, 4>> data_;
     std::vector<std::array<int, 4>> extdata_;
 };
@@ -264,9 +264,8 @@ namespace faiss {
         }
 
         bool compute (const uint8_t *b8) const {
-            const uint64_t *b = (uint64_t *)b8;
             for (int i = 0; i < n; i++) {
-                if ((a[i] & b[i]) != a[i]) {
+                if ((a[i] & b8[i]) != a[i]) {
                     return false;
                 }
             }
@@ -7,6 +7,7 @@
 #include <unordered_set>
 #include <list>
 
+#include "faiss/utils/HugePage.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
 namespace hnswlib {
@@ -56,7 +57,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         label_offset_ = size_links_level0_ + data_size_;
         offsetLevel0_ = 0;
 
-        data_level0_memory_ = (char *) malloc(max_elements_ * size_data_per_element_);
+        data_level0_memory_ = (char *) faiss::alloc_huge_page(max_elements_ * size_data_per_element_);
         if (data_level0_memory_ == nullptr)
             throw std::runtime_error("Not enough memory");
 
@@ -143,6 +144,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
     std::unordered_map<labeltype, tableint> label_lookup_;
 
     std::default_random_engine level_generator_;
+    std::mutex level_generator_guard_;  // addPoint runs concurrently during a parallel build
 
     inline labeltype getExternalLabel(tableint internal_id) const {
         labeltype return_label;
@@ -164,6 +166,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     int getRandomLevel(double reverse_size) {
         std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        std::unique_lock <std::mutex> lock(level_generator_guard_);
         double r = -log(distribution(level_generator_)) * reverse_size;
         return (int) r;
     }
@@ -299,9 +302,11 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
                 int candidate_id = *(data + j);
                 // if (candidate_id == 0) continue;
 #ifdef USE_SSE
-                _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
-                _mm_prefetch(data_level0_memory_ + (*(data + j + 1)) * size_data_per_element_ + offsetData_,
-                             _MM_HINT_T0);////////////
+                if (j < size) {
+                    _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
+                    _mm_prefetch(data_level0_memory_ + (*(data + j + 1)) * size_data_per_element_ + offsetData_,
+                                 _MM_HINT_T0);
+                }
 #endif
                 if (!(visited_array[candidate_id] == visited_array_tag)) {
 
@@ -566,7 +571,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
 
         // Reallocate base layer
-        char * data_level0_memory_new = (char *) malloc(new_max_elements * size_data_per_element_);
+        char * data_level0_memory_new = (char *) faiss::alloc_huge_page(new_max_elements * size_data_per_element_);
         if (data_level0_memory_new == nullptr)
             throw std::runtime_error("Not enough memory: resizeIndex failed to allocate base layer");
         memcpy(data_level0_memory_new, data_level0_memory_,cur_element_count * size_data_per_element_);
@@ -687,7 +692,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         // input.seekg(pos,input.beg);
 
 
-        data_level0_memory_ = (char *) malloc(max_elements * size_data_per_element_);
+        data_level0_memory_ = (char *) faiss::alloc_huge_page(max_elements * size_data_per_element_);
         if (data_level0_memory_ == nullptr)
             throw std::runtime_error("Not enough memory: loadIndex failed to allocate level0");
         input.read(data_level0_memory_, cur_element_count * size_data_per_element_);
@@ -830,7 +835,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
         input.seekg(pos,input.beg);
 
-        data_level0_memory_ = (char *) malloc(max_elements * size_data_per_element_);
+        data_level0_memory_ = (char *) faiss::alloc_huge_page(max_elements * size_data_per_element_);
         if (data_level0_memory_ == nullptr)
             throw std::runtime_error("Not enough memory: loadIndex failed to allocate level0");
         input.read(data_level0_memory_, cur_element_count * size_data_per_element_);
@@ -1076,10 +1081,18 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
                 data = (unsigned int *) get_linklist(currObj, level);
                 int size = getListCount(data);
                 tableint *datal = (tableint *) (data + 1);
+#ifdef USE_SSE
+                if (size > 0)
+                    _mm_prefetch(getDataByInternalId(*datal), _MM_HINT_T0);
+#endif
                 for (int i = 0; i < size; i++) {
                     tableint cand = datal[i];
                     if (cand < 0 || cand > max_elements_)
                         throw std::runtime_error("cand error");
+#ifdef USE_SSE
+                    if (i + 1 < size)
+                        _mm_prefetch(getDataByInternalId(datal[i + 1]), _MM_HINT_T0);
+#endif
                     dist_t d = fstdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
 
                     if (d < curdist) {
@@ -1131,6 +1144,81 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return result;
     }
 
+    /**
+     * Renumber the internal ids in breadth first order of the base layer graph, starting from the entry
+     * point, so that the neighbors of a node mostly sit next to it in data_level0_memory_. Ids of nodes
+     * unreachable from the entry point follow in their previous order. Not thread safe.
+     */
+    void reorderByBFS() {
+        size_t n = cur_element_count;
+        if (n == 0)
+            return;
+
+        const tableint unvisited = (tableint) -1;
+        std::vector<tableint> new_id(n, unvisited);
+        std::vector<tableint> order;
+        order.reserve(n);
+
+        size_t next_root = 0;
+        tableint root = enterpoint_node_;
+        while (order.size() < n) {
+            new_id[root] = order.size();
+            order.push_back(root);
+            // order doubles as the bfs queue
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                linklistsizeint *ll = get_linklist0(order[head]);
+                size_t size = getListCount(ll);
+                tableint *datal = (tableint *) (ll + 1);
+                for (size_t j = 0; j < size; j++) {
+                    if (new_id[datal[j]] == unvisited) {
+                        new_id[datal[j]] = order.size();
+                        order.push_back(datal[j]);
+                    }
+                }
+            }
+            while (next_root < n && new_id[next_root] != unvisited)
+                next_root++;
+            root = next_root;
+        }
+
+        char *new_level0 = (char *) faiss::alloc_huge_page(max_elements_ * size_data_per_element_);
+        char **new_link_lists = (char **) malloc(sizeof(void *) * max_elements_);
+        if (new_level0 == nullptr || new_link_lists == nullptr) {
+            free(new_level0);
+            free(new_link_lists);
+            throw std::runtime_error("Not enough memory: reorderByBFS failed to allocate");
+        }
+        std::vector<int> new_levels(max_elements_);
+
+        for (tableint i = 0; i < n; i++) {
+            tableint old = order[i];
+            memcpy(new_level0 + i * size_data_per_element_, data_level0_memory_ + old * size_data_per_element_,
+                   size_data_per_element_);
+            new_link_lists[i] = linkLists_[old];
+            new_levels[i] = element_levels_[old];
+
+            linklistsizeint *ll = get_linklist0(i, new_level0);
+            tableint *datal = (tableint *) (ll + 1);
+            for (size_t j = 0, size = getListCount(ll); j < size; j++)
+                datal[j] = new_id[datal[j]];
+            for (int level = 1; level <= new_levels[i]; level++) {
+                ll = (linklistsizeint *) (new_link_lists[i] + (level - 1) * size_links_per_element_);
+                datal = (tableint *) (ll + 1);
+                for (size_t j = 0, size = getListCount(ll); j < size; j++)
+                    datal[j] = new_id[datal[j]];
+            }
+        }
+
+        free(data_level0_memory_);
+        free(linkLists_);
+        data_level0_memory_ = new_level0;
+        linkLists_ = new_link_lists;
+        element_levels_.swap(new_levels);
+        for (auto &kv : label_lookup_)
+            kv.second = new_id[kv.second];
+        enterpoint_node_ = new_id[enterpoint_node_];
+    }
+
     void addPoint(void *datapoint, labeltype label, size_t base, size_t offset) {
         return;
     }
@@ -7,19 +7,15 @@
 #include <unordered_set>
 #include <list>
 
+#include "faiss/utils/HugePage.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 #include "faiss/impl/ScalarQuantizer.h"
-#include "faiss/impl/ScalarQuantizerCodec.h"
 
 namespace hnswlib_nm {
 
     typedef unsigned int tableint;
     typedef unsigned int linklistsizeint;
 
-    using QuantizerClass = faiss::QuantizerTemplate<faiss::Codec8bit, false, 1>;
-    using DCClassIP = faiss::DCTemplate<QuantizerClass, faiss::SimilarityIP<1>, 1>;
-    using DCClassL2 = faiss::DCTemplate<QuantizerClass, faiss::SimilarityL2<1>, 1>;
-
     template<typename dist_t>
     class HierarchicalNSW_NM : public AlgorithmInterface<dist_t> {
     public:
@@ -63,7 +59,7 @@ namespace hnswlib_nm {
             size_data_per_element_ = size_links_level0_; // + sizeof(labeltype); + data_size_;;
 //            label_offset_ = size_links_level0_;
 
-            data_level0_memory_ = (char *) malloc(max_elements_ * size_data_per_element_);
+            data_level0_memory_ = (char *) faiss::alloc_huge_page(max_elements_ * size_data_per_element_);
             if (data_level0_memory_ == nullptr)
                 throw std::runtime_error("Not enough memory");
 
@@ -152,36 +148,79 @@ namespace hnswlib_nm {
         void *dist_func_param_;
 
         std::default_random_engine level_generator_;
+        std::mutex level_generator_guard_;  // addPoint runs concurrently during a parallel build
 
         inline char *getDataByInternalId(void *pdata, tableint offset) const {
             return ((char*)pdata + offset * data_size_);
         }
 
-        void SetSq8(const float *trained) {
+        // address of the float vector or of the sq8 code of a node, used for prefetching
+        inline char *getVectorByInternalId(void *pdata, tableint offset) const {
+            return is_sq8_ ? ((char*)pdata + offset * sq_->code_size) : getDataByInternalId(pdata, offset);
+        }
+
+        // prefetches every cache line of the float vector or of the sq8 code of a node, not only the first one
+        inline void prefetchVector(void *pdata, tableint offset) const {
+#ifdef USE_SSE
+            char *p = getVectorByInternalId(pdata, offset);
+            size_t size = is_sq8_ ? sq_->code_size : data_size_;
+            for (size_t line = 0; line < size; line += 64)
+                _mm_prefetch(p + line, _MM_HINT_T0);
+#endif
+        }
+
+        // Distances of the query to the sq8 codes, computed on the codes without decoding them to floats first. The
+        // faiss hook picks the AVX2 or AVX512 kernels the cpu supports.
+        faiss::SQDistanceComputer *getSq8DistanceComputer(const void *query_data, void *pdata) const {
+            faiss::SQDistanceComputer *sqdc;
+            if (metric_type_ == 0) { // L2
+                sqdc = sq_->get_distance_computer(faiss::METRIC_L2);
+            } else if (metric_type_ == 1) { // IP
+                sqdc = sq_->get_distance_computer(faiss::METRIC_INNER_PRODUCT);
+            } else {
+                throw std::runtime_error("unsupported metric_type, it must be 0(L2) or 1(IP)!");
+            }
+            sqdc->code_size = sq_->code_size;
+            sqdc->codes = (uint8_t*)pdata;
+            sqdc->set_query((const float*)query_data);
+            return sqdc;
+        }
+
+        // the inner product turned to 1 - ip as InnerProductSpace does, the graph walk keeps the least distances
+        inline dist_t sq8Distance(faiss::SQDistanceComputer *sqdc, tableint id) const {
+            dist_t dist = (*sqdc)(id);
+            return metric_type_ == 1 ? 1.0f - dist : dist;
+        }
+
+        // the qtype is one of QT_8bit, QT_6bit and QT_4bit, the codes are code_size bytes a node
+        void SetSq8(const float *trained, faiss::QuantizerType qtype = faiss::QuantizerType::QT_8bit) {
             if (!trained)
                 throw std::runtime_error("trained sq8 data cannot be null in SetSq8!");
             if (sq_) delete sq_;
             is_sq8_ = true;
-            sq_ = new faiss::ScalarQuantizer(*(size_t*)dist_func_param_, faiss::QuantizerType::QT_8bit); // hard code
+            sq_ = new faiss::ScalarQuantizer(*(size_t*)dist_func_param_, qtype);
             sq_->trained.resize((sq_->d) << 1);
             memcpy(sq_->trained.data(), trained, sq_->trained.size() * sizeof(float));
         }
 
-        void sq_train(size_t nb, const float *xb, uint8_t *p_codes) {
+        // p_codes holds nb codes followed by the trained data of the quantizer, 2 * dim floats
+        void sq_train(size_t nb, const float *xb, uint8_t *p_codes,
+                      faiss::QuantizerType qtype = faiss::QuantizerType::QT_8bit) {
             if (!p_codes)
                 throw std::runtime_error("p_codes cannot be null in sq_train!");
             if (!xb)
                 throw std::runtime_error("base vector cannot be null in sq_train!");
             if (sq_) delete sq_;
             is_sq8_ = true;
-            sq_ = new faiss::ScalarQuantizer(*(size_t*)dist_func_param_, faiss::QuantizerType::QT_8bit); // hard code
+            sq_ = new faiss::ScalarQuantizer(*(size_t*)dist_func_param_, qtype);
             sq_->train(nb, xb);
             sq_->compute_codes(xb, p_codes, nb);
-            memcpy(p_codes + *(size_t*)dist_func_param_ * nb, sq_->trained.data(), *(size_t*)dist_func_param_ * sizeof(float) * 2);
+            memcpy(p_codes + sq_->code_size * nb, sq_->trained.data(), *(size_t*)dist_func_param_ * sizeof(float) * 2);
         }
 
         int getRandomLevel(double reverse_size) {
             std::uniform_real_distribution<double> distribution(0.0, 1.0);
+            std::unique_lock <std::mutex> lock(level_generator_guard_);
             double r = -log(distribution(level_generator_)) * reverse_size;
             return (int) r;
         }
@@ -277,16 +316,7 @@ namespace hnswlib_nm {
 
             faiss::SQDistanceComputer *sqdc = nullptr;
             if (is_sq8_) {
-                if (metric_type_ == 0) { // L2
-                    sqdc = new DCClassL2(sq_->d, sq_->trained);
-                } else if (metric_type_ == 1) { // IP
-                    sqdc = new DCClassIP(sq_->d, sq_->trained);
-                } else {
-                    throw std::runtime_error("unsupported metric_type, it must be 0(L2) or 1(IP)!");
-                }
-                sqdc->code_size = sq_->code_size;
-                sqdc->codes = (uint8_t*)pdata;
-                sqdc->set_query((const float*)data_point);
+                sqdc = getSq8DistanceComputer(data_point, pdata);
             }
 
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
@@ -297,7 +327,7 @@ namespace hnswlib_nm {
             if (!has_deletions || !bitset->test((faiss::ConcurrentBitset::id_type_t)(ep_id))) {
                 dist_t dist;
                 if (is_sq8_) {
-                    dist = (*sqdc)(ep_id);
+                    dist = sq8Distance(sqdc, ep_id);
                 } else {
                     dist = fstdistfunc_(data_point, getDataByInternalId(pdata, ep_id), dist_func_param_);
                 }
@@ -329,7 +359,7 @@ namespace hnswlib_nm {
                 _mm_prefetch((char *) (visited_array + *(data + 1)), _MM_HINT_T0);
                 _mm_prefetch((char *) (visited_array + *(data + 1) + 64), _MM_HINT_T0);
 //            _mm_prefetch(data_level0_memory_ + (*(data + 1)) * size_data_per_element_ + offsetData_, _MM_HINT_T0);
-                _mm_prefetch(getDataByInternalId(pdata, *(data + 1)), _MM_HINT_T0);
+                prefetchVector(pdata, *(data + 1));
                 _mm_prefetch((char *) (data + 2), _MM_HINT_T0);
 #endif
 
@@ -337,9 +367,10 @@ namespace hnswlib_nm {
                     int candidate_id = *(data + j);
                     // if (candidate_id == 0) continue;
 #ifdef USE_SSE
-                    _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
-                    _mm_prefetch(getDataByInternalId(pdata, *(data + j + 1)),
-                                 _MM_HINT_T0);////////////
+                    if (j < size) {
+                        _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
+                        prefetchVector(pdata, *(data + j + 1));
+                    }
 #endif
                     if (!(visited_array[candidate_id] == visited_array_tag)) {
 
@@ -347,7 +378,7 @@ namespace hnswlib_nm {
 
                         dist_t dist;
                         if (is_sq8_) {
-                            dist = (*sqdc)(candidate_id);
+                            dist = sq8Distance(sqdc, candidate_id);
                         } else {
                             char *currObj1 = (getDataByInternalId(pdata, candidate_id));
                             dist = fstdistfunc_(data_point, currObj1, dist_func_param_);
@@ -613,7 +644,7 @@ namespace hnswlib_nm {
             std::vector<std::mutex>(new_max_elements).swap(link_list_locks_);
 
             // Reallocate base layer
-            char * data_level0_memory_new = (char *) malloc(new_max_elements * size_data_per_element_);
+            char * data_level0_memory_new = (char *) faiss::alloc_huge_page(new_max_elements * size_data_per_element_);
             if (data_level0_memory_new == nullptr)
                 throw std::runtime_error("Not enough memory: resizeIndex failed to allocate base layer");
             memcpy(data_level0_memory_new, data_level0_memory_,cur_element_count * size_data_per_element_);
@@ -734,7 +765,7 @@ namespace hnswlib_nm {
             // input.seekg(pos,input.beg);
 
 
-            data_level0_memory_ = (char *) malloc(max_elements * size_data_per_element_);
+            data_level0_memory_ = (char *) faiss::alloc_huge_page(max_elements * size_data_per_element_);
             if (data_level0_memory_ == nullptr)
                 throw std::runtime_error("Not enough memory: loadIndex failed to allocate level0");
             input.read(data_level0_memory_, cur_element_count * size_data_per_element_);
@@ -877,7 +908,7 @@ namespace hnswlib_nm {
 
             input.seekg(pos,input.beg);
 
-            data_level0_memory_ = (char *) malloc(max_elements * size_data_per_element_);
+            data_level0_memory_ = (char *) faiss::alloc_huge_page(max_elements * size_data_per_element_);
             if (data_level0_memory_ == nullptr)
                 throw std::runtime_error("Not enough memory: loadIndex failed to allocate level0");
             input.read(data_level0_memory_, cur_element_count * size_data_per_element_);
@@ -1122,17 +1153,8 @@ namespace hnswlib_nm {
             dist_t curdist;
             faiss::SQDistanceComputer *sqdc = nullptr;
             if (is_sq8_) {
-                if (metric_type_ == 0) { // L2
-                    sqdc = new DCClassL2(sq_->d, sq_->trained);
-                } else if (metric_type_ == 1) { // IP
-                    sqdc = new DCClassIP(sq_->d, sq_->trained);
-                } else {
-                    throw std::runtime_error("unsupported metric_type, it must be 0(L2) or 1(IP)!");
-                }
-                sqdc->code_size = sq_->code_size;
-                sqdc->set_query((const float*)query_data);
-                sqdc->codes = (uint8_t*)pdata;
-                curdist = (*sqdc)(currObj);
+                sqdc = getSq8DistanceComputer(query_data, pdata);
+                curdist = sq8Distance(sqdc, currObj);
             } else {
                 curdist = fstdistfunc_(query_data, getDataByInternalId(pdata, enterpoint_node_), dist_func_param_);
             }
@@ -1146,13 +1168,21 @@ namespace hnswlib_nm {
                     data = (unsigned int *) get_linklist(currObj, level);
                     int size = getListCount(data);
                     tableint *datal = (tableint *) (data + 1);
+#ifdef USE_SSE
+                    if (size > 0)
+                        prefetchVector(pdata, *datal);
+#endif
                     for (int i = 0; i < size; i++) {
                         tableint cand = datal[i];
                         if (cand < 0 || cand > max_elements_)
                             throw std::runtime_error("cand error");
+#ifdef USE_SSE
+                        if (i + 1 < size)
+                            prefetchVector(pdata, datal[i + 1]);
+#endif
                         dist_t d;
                         if (is_sq8_) {
-                            d = (*sqdc)(cand);
+                            d = sq8Distance(sqdc, cand);
                         } else {
                             d = fstdistfunc_(query_data, getDataByInternalId(pdata, cand), dist_func_param_);
                         }
@@ -29,6 +29,7 @@
 #include <faiss/gpu/StandardGpuResources.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
+#include <faiss/utils/HugePage.h>
 #include <faiss/utils/distances.h>
 
 /*****************************************************
@@ -46,6 +47,9 @@ const char HDF5_DATASET_DISTANCES[] = "distances";
 
 const int32_t GPU_DEVICE_IDX = 0;
 
+// set to compare the search times with the indexes on transparent huge pages
+const bool USE_HUGE_PAGE = false;
+
 enum QueryMode { MODE_CPU = 0, MODE_MIX, MODE_GPU };
 
 double
@@ -282,6 +286,7 @@ load_base_data(faiss::Index*& index, const std::string& ann_test_name, const std
         delete[] xb;
     }
 
+    printf("[%.3f s] Index on huge pages: %ld MB\n", elapsed() - t0, faiss::huge_page_usage() >> 20);
     index = cpu_index;
 }
 
@@ -530,6 +535,7 @@ test_ann_hdf5(const std::string& ann_test_name, const std::string& cluster_type,
  *************************************************************************************/
 
 TEST(FAISSTEST, BENCHMARK) {
+    faiss::faiss_use_huge_page = USE_HUGE_PAGE;
     std::vector<size_t> param_nprobes = {8, 128};
     const int32_t SEARCH_LOOPS = 5;
 
@@ -11,11 +11,23 @@
 
 #include <gtest/gtest.h>
 #include <immintrin.h>
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <faiss/FaissHook.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/binary_distances_avx.h>
+#include <faiss/utils/binary_distances_avx512.h>
+#include <faiss/utils/distances.h>
+#include <faiss/utils/distances_avx.h>
+#include <faiss/utils/distances_avx512.h>
+
 typedef float (*metric_func_ptr)(const float*, const float*, size_t);
 
 constexpr int64_t DIM = 512;
@@ -413,3 +425,242 @@ TEST(METRICTEST, BENCHMARK) {
     TestMetricAlg(func_map, "ANNOY::IP", LOOP, distance_annoy.data(), NB, xb.data(), NQ, xq.data(), DIM);
     CheckResult(distance_faiss.data(), distance_annoy.data(), NB * NQ);
 }
+
+///////////////////////////////////////////////////////////////////////////////
+/* the faiss kernels behind FaissHook, every kernel x simd level x dim, with the base vectors in L1 or in DRAM */
+namespace MATRIX {
+constexpr size_t L1_BYTES = 16 * 1024;            // fits the L1 data cache of any x86 core
+constexpr size_t DRAM_BYTES = 256 * 1024 * 1024;  // larger than the last level cache of any x86 socket
+constexpr double MIN_SECONDS = 0.1;               // every measurement repeats its pass for at least this long
+
+typedef void (*batch_4_func_ptr)(const float*, const float*, const float*, const float*, const float*, size_t,
+                                 float&, float&, float&, float&);
+typedef int (*popcount_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+typedef bool (*structure_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+
+struct FloatKernel {
+    std::string name;
+    std::string level;
+    metric_func_ptr func;
+    batch_4_func_ptr batch_4_func;
+    int64_t flops_per_dim;  // sub/mul/add or sub/abs/max per dimension
+};
+
+struct BinaryKernel {
+    std::string name;
+    std::string level;
+    popcount_func_ptr popcount_func;
+    structure_func_ptr structure_func;
+};
+
+std::vector<FloatKernel>
+FloatKernels() {
+    std::vector<FloatKernel> kernels = {
+        {"L2sqr", "REF", faiss::fvec_L2sqr_ref, nullptr, 3},
+        {"IP", "REF", faiss::fvec_inner_product_ref, nullptr, 2},
+        {"L1", "REF", faiss::fvec_L1_ref, nullptr, 3},
+        {"Linf", "REF", faiss::fvec_Linf_ref, nullptr, 3},
+    };
+    if (faiss::support_sse()) {
+        kernels.insert(kernels.end(), {
+                                          {"L2sqr", "SSE", faiss::fvec_L2sqr_sse, nullptr, 3},
+                                          {"IP", "SSE", faiss::fvec_inner_product_sse, nullptr, 2},
+                                          {"L1", "SSE", faiss::fvec_L1_sse, nullptr, 3},
+                                          {"Linf", "SSE", faiss::fvec_Linf_sse, nullptr, 3},
+                                          {"L2sqr_batch_4", "SSE", nullptr, faiss::fvec_L2sqr_batch_4_sse, 3},
+                                          {"IP_batch_4", "SSE", nullptr, faiss::fvec_inner_product_batch_4_sse, 2},
+                                      });
+    }
+    if (faiss::support_avx2()) {
+        kernels.insert(kernels.end(), {
+                                          {"L2sqr", "AVX2", faiss::fvec_L2sqr_avx, nullptr, 3},
+                                          {"IP", "AVX2", faiss::fvec_inner_product_avx, nullptr, 2},
+                                          {"L1", "AVX2", faiss::fvec_L1_avx, nullptr, 3},
+                                          {"Linf", "AVX2", faiss::fvec_Linf_avx, nullptr, 3},
+                                          {"L2sqr_batch_4", "AVX2", nullptr, faiss::fvec_L2sqr_batch_4_avx, 3},
+                                          {"IP_batch_4", "AVX2", nullptr, faiss::fvec_inner_product_batch_4_avx, 2},
+                                      });
+    }
+    if (faiss::support_avx512()) {
+        kernels.insert(kernels.end(),
+                       {
+                           {"L2sqr", "AVX512", faiss::fvec_L2sqr_avx512, nullptr, 3},
+                           {"IP", "AVX512", faiss::fvec_inner_product_avx512, nullptr, 2},
+                           {"L1", "AVX512", faiss::fvec_L1_avx512, nullptr, 3},
+                           {"Linf", "AVX512", faiss::fvec_Linf_avx512, nullptr, 3},
+                           {"L2sqr_batch_4", "AVX512", nullptr, faiss::fvec_L2sqr_batch_4_avx512, 3},
+                           {"IP_batch_4", "AVX512", nullptr, faiss::fvec_inner_product_batch_4_avx512, 2},
+                       });
+    }
+    return kernels;
+}
+
+std::vector<BinaryKernel>
+BinaryKernels() {
+    std::vector<BinaryKernel> kernels = {
+        {"popcount_xor", "REF", faiss::bvec_popcount_xor_ref, nullptr},
+        {"popcount_and", "REF", faiss::bvec_popcount_and_ref, nullptr},
+        {"popcount_or", "REF", faiss::bvec_popcount_or_ref, nullptr},
+        {"substructure", "REF", nullptr, faiss::bvec_substructure_ref},
+        {"superstructure", "REF", nullptr, faiss::bvec_superstructure_ref},
+    };
+    if (faiss::support_avx2()) {
+        kernels.insert(kernels.end(), {
+                                          {"popcount_xor", "AVX2", faiss::bvec_popcount_xor_avx, nullptr},
+                                          {"popcount_and", "AVX2", faiss::bvec_popcount_and_avx, nullptr},
+                                          {"popcount_or", "AVX2", faiss::bvec_popcount_or_avx, nullptr},
+                                          {"substructure", "AVX2", nullptr, faiss::bvec_substructure_avx},
+                                          {"superstructure", "AVX2", nullptr, faiss::bvec_superstructure_avx},
+                                      });
+    }
+    if (faiss::support_avx512()) {
+        if (faiss::support_avx512_vpopcntdq()) {
+            kernels.insert(kernels.end(), {
+                                              {"popcount_xor", "AVX512", faiss::bvec_popcount_xor_avx512, nullptr},
+                                              {"popcount_and", "AVX512", faiss::bvec_popcount_and_avx512, nullptr},
+                                              {"popcount_or", "AVX512", faiss::bvec_popcount_or_avx512, nullptr},
+                                          });
+        }
+        kernels.insert(kernels.end(), {
+                                          {"substructure", "AVX512", nullptr, faiss::bvec_substructure_avx512},
+                                          {"superstructure", "AVX512", nullptr, faiss::bvec_superstructure_avx512},
+                                      });
+    }
+    return kernels;
+}
+
+// one pass computes the distances of the query to all n base vectors, the sum keeps the calls observable
+float
+FloatPass(const FloatKernel& kernel, const float* xb, size_t n, const float* xq, size_t dim) {
+    float sum = 0;
+    if (kernel.func != nullptr) {
+        for (size_t i = 0; i < n; i++) {
+            sum += kernel.func(xq, xb + i * dim, dim);
+        }
+    } else {
+        float d0, d1, d2, d3;
+        for (size_t i = 0; i + 4 <= n; i += 4) {
+            kernel.batch_4_func(xq, xb + i * dim, xb + (i + 1) * dim, xb + (i + 2) * dim, xb + (i + 3) * dim, dim, d0,
+                                d1, d2, d3);
+            sum += d0 + d1 + d2 + d3;
+        }
+    }
+    return sum;
+}
+
+int64_t
+BinaryPass(const BinaryKernel& kernel, const uint8_t* xb, size_t n, const uint8_t* xq, size_t code_size) {
+    int64_t sum = 0;
+    if (kernel.popcount_func != nullptr) {
+        for (size_t i = 0; i < n; i++) {
+            sum += kernel.popcount_func(xq, xb + i * code_size, code_size);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            sum += kernel.structure_func(xq, xb + i * code_size, code_size);
+        }
+    }
+    return sum;
+}
+
+// repeats the pass for MIN_SECONDS after a warmup pass, returns seconds per pass
+template <typename Pass>
+double
+TimePass(Pass pass) {
+    pass();
+    int64_t passes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double seconds = 0;
+    do {
+        pass();
+        ++passes;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (seconds < MIN_SECONDS);
+    return seconds / passes;
+}
+
+void
+PrintRow(const std::string& name, const std::string& level, size_t dim, const char* footprint, size_t n,
+         double seconds, double flops, double bytes) {
+    char gflops[16] = "-";
+    if (flops > 0) {
+        snprintf(gflops, sizeof(gflops), "%.2f", flops / seconds / 1e9);
+    }
+    printf("%-16s %-8s %6zu %-6s %12.2f %10s %10.2f\n", name.c_str(), level.c_str(), dim, footprint,
+           seconds / n * 1e9, gflops, bytes / seconds / 1e9);
+}
+}  // namespace MATRIX
+
+TEST(METRICTEST, SIMD_MATRIX) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+    printf("hook_init selects %s\n", cpu_flag.c_str());
+    printf("%-16s %-8s %6s %-6s %12s %10s %10s\n", "kernel", "simd", "dim", "data", "ns/distance", "GFLOP/s",
+           "GB/s");
+
+    // the DRAM set is one buffer, each dim views it as base vectors of its own size
+    std::vector<float> buffer(MATRIX::DRAM_BYTES / sizeof(float));
+    GenerateData(1, buffer.size(), buffer.data());
+    std::vector<float> xq(4096);
+    GenerateData(1, xq.size(), xq.data());
+
+    auto float_kernels = MATRIX::FloatKernels();
+    for (size_t dim : {16, 64, 128, 256, 512, 960}) {
+        // every simd level agrees with the reference kernel of the same metric
+        for (auto& kernel : float_kernels) {
+            auto ref = std::find_if(float_kernels.begin(), float_kernels.end(), [&](const MATRIX::FloatKernel& k) {
+                return k.level == "REF" && kernel.name.compare(0, k.name.size(), k.name) == 0;
+            });
+            float expect = MATRIX::FloatPass(*ref, buffer.data(), 4, xq.data(), dim);
+            float actual = MATRIX::FloatPass(kernel, buffer.data(), 4, xq.data(), dim);
+            ASSERT_NEAR(expect, actual, std::fabs(expect) * 1e-4) << kernel.name << " " << kernel.level << " " << dim;
+        }
+
+        for (auto footprint : {"L1", "DRAM"}) {
+            size_t bytes = footprint == std::string("L1") ? MATRIX::L1_BYTES : MATRIX::DRAM_BYTES;
+            size_t n = std::max<size_t>(bytes / (dim * sizeof(float)), 4) / 4 * 4;
+            for (auto& kernel : float_kernels) {
+                volatile float sink = 0;
+                double seconds = MATRIX::TimePass([&] {
+                    sink = sink + MATRIX::FloatPass(kernel, buffer.data(), n, xq.data(), dim);
+                });
+                MATRIX::PrintRow(kernel.name, kernel.level, dim, footprint, n, seconds,
+                                 (double)kernel.flops_per_dim * dim * n, (double)n * dim * sizeof(float));
+            }
+        }
+    }
+
+    auto binary_kernels = MATRIX::BinaryKernels();
+    auto xb_codes = reinterpret_cast<const uint8_t*>(buffer.data());
+    // the structure kernels return at the first mismatch, their queries match every code to scan it whole
+    std::vector<uint8_t> xq_code(xb_codes, xb_codes + 1024), xq_empty(1024, 0x00), xq_full(1024, 0xff);
+    auto query = [&](const MATRIX::BinaryKernel& kernel) {
+        if (kernel.popcount_func != nullptr) {
+            return xq_code.data();
+        }
+        return kernel.name == "substructure" ? xq_empty.data() : xq_full.data();
+    };
+    for (size_t dim : {256, 512, 1024, 2048, 8192}) {
+        size_t code_size = dim / 8;
+        for (auto& kernel : binary_kernels) {
+            auto ref = std::find_if(binary_kernels.begin(), binary_kernels.end(), [&](const MATRIX::BinaryKernel& k) {
+                return k.level == "REF" && k.name == kernel.name;
+            });
+            ASSERT_EQ(MATRIX::BinaryPass(*ref, xb_codes, 64, query(kernel), code_size),
+                      MATRIX::BinaryPass(kernel, xb_codes, 64, query(kernel), code_size))
+                << kernel.name << " " << kernel.level << " " << dim;
+        }
+
+        for (auto footprint : {"L1", "DRAM"}) {
+            size_t bytes = footprint == std::string("L1") ? MATRIX::L1_BYTES : MATRIX::DRAM_BYTES;
+            size_t n = std::max<size_t>(bytes / code_size, 1);
+            for (auto& kernel : binary_kernels) {
+                volatile int64_t sink = 0;
+                double seconds = MATRIX::TimePass([&] {
+                    sink = sink + MATRIX::BinaryPass(kernel, xb_codes, n, query(kernel), code_size);
+                });
+                MATRIX::PrintRow(kernel.name, kernel.level, dim, footprint, n, seconds, 0, (double)n * code_size);
+            }
+        }
+    }
+}
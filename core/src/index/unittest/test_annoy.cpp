@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <omp.h>
 #include <src/index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h>
 #include <iostream>
 #include <sstream>
@@ -205,6 +206,39 @@ TEST_P(AnnoyTest, annoy_serialize) {
     }
 }
 
+TEST_P(AnnoyTest, annoy_parallel_build_mapped_load) {
+    // the trees are built in parallel, the index does not depend on the number of threads
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    index_->BuildAll(base_dataset, conf);
+    omp_set_num_threads(threads);
+    auto serial_bin = index_->Serialize().GetByName("annoy_index_data");
+
+    auto parallel_index = std::make_shared<milvus::knowhere::IndexAnnoy>();
+    parallel_index->BuildAll(base_dataset, conf);
+    auto binaryset = parallel_index->Serialize();
+    auto bin = binaryset.GetByName("annoy_index_data");
+    ASSERT_EQ(bin->size, serial_bin->size);
+    ASSERT_EQ(memcmp(bin->data.get(), serial_bin->data.get(), bin->size), 0);
+
+    // the nodes of a mapped index are used in place
+    bin->mapped = true;
+    auto mapped_index = std::make_shared<milvus::knowhere::IndexAnnoy>();
+    mapped_index->Load(binaryset);
+    mapped_index->SetIndexSize(bin->size);
+    EXPECT_EQ(mapped_index->Count(), nb);
+    EXPECT_EQ(mapped_index->IndexSize(), 0);
+
+    auto result = index_->Query(query_dataset, conf);
+    auto mapped_result = mapped_index->Query(query_dataset, conf);
+    AssertAnns(mapped_result, nq, k);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto mapped_ids = mapped_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], mapped_ids[i]);
+    }
+}
+
 /*
  * faiss style test
  * keep it
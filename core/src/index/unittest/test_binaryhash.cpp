@@ -0,0 +1,124 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <set>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexBinaryHash.h"
+#include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
+
+#include "unittest/Helper.h"
+#include "unittest/utils.h"
+
+class BinaryHashTest : public DataGen, public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        Init_with_default(true);
+        index_ = std::make_shared<milvus::knowhere::BinaryHash>();
+        conf_ = milvus::knowhere::Config{
+            {milvus::knowhere::meta::DIM, dim},
+            {milvus::knowhere::meta::ROWS, nb},
+            {milvus::knowhere::meta::TOPK, k},
+            {milvus::knowhere::IndexParams::nhash, 8},
+            {milvus::knowhere::IndexParams::nbits, 8},
+            {milvus::knowhere::IndexParams::nflip, 0},
+            {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::HAMMING},
+        };
+    }
+
+ protected:
+    milvus::knowhere::BinaryHashIndexPtr index_ = nullptr;
+    milvus::knowhere::Config conf_;
+};
+
+TEST_F(BinaryHashTest, binaryhash_basic) {
+    ASSERT_ANY_THROW(index_->Serialize());
+    ASSERT_ANY_THROW(index_->Query(query_dataset, conf_));
+    ASSERT_ANY_THROW(index_->Add(base_dataset, conf_));
+
+    // the keys have to fit the code
+    auto bad_conf = conf_;
+    bad_conf[milvus::knowhere::IndexParams::nhash] = dim / 8 + 1;
+    ASSERT_ANY_THROW(index_->BuildAll(base_dataset, bad_conf));
+
+    index_->BuildAll(base_dataset, conf_);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+    EXPECT_GT(index_->IndexSize(), 0);
+
+    // a query from the base shares all its buckets with itself
+    auto result = index_->Query(query_dataset, conf_);
+    AssertAnns(result, nq, k);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; i++) {
+        if (i % k != 0) {
+            ASSERT_LE(dist[i - 1], dist[i]);
+        }
+    }
+
+    auto binaryset = index_->Serialize();
+    auto new_index = std::make_shared<milvus::knowhere::BinaryHash>();
+    new_index->Load(binaryset);
+    EXPECT_EQ(new_index->Count(), nb);
+    auto result2 = new_index->Query(query_dataset, conf_);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto ids2 = result2->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; i++) {
+        ASSERT_EQ(ids[i], ids2[i]);
+    }
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    auto result_bs = index_->Query(query_dataset, conf_);
+    AssertAnns(result_bs, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_F(BinaryHashTest, binaryhash_range_search) {
+    index_->BuildAll(base_dataset, conf_);
+
+    auto flat_index = std::make_shared<milvus::knowhere::BinaryIDMAP>();
+    flat_index->Train(base_dataset, conf_);
+    flat_index->Add(base_dataset, conf_);
+
+    // a result below the radius is within (radius - 1) / nhash bits of the query on one key at least,
+    // enough flips find all of them
+    const int radius = 24;
+    conf_[milvus::knowhere::meta::RADIUS] = radius;
+    conf_[milvus::knowhere::IndexParams::nflip] = (radius - 1) / 8;
+
+    auto check = [&]() {
+        auto result = index_->QueryByRange(query_dataset, conf_);
+        auto expect = flat_index->QueryByRange(query_dataset, conf_);
+        auto lims = result->Get<size_t*>(milvus::knowhere::meta::LIMS);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto expect_lims = expect->Get<size_t*>(milvus::knowhere::meta::LIMS);
+        auto expect_ids = expect->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        for (int64_t i = 0; i < nq; i++) {
+            std::set<int64_t> hits(ids + lims[i], ids + lims[i + 1]);
+            std::set<int64_t> expect_hits(expect_ids + expect_lims[i], expect_ids + expect_lims[i + 1]);
+            ASSERT_EQ(hits, expect_hits);
+        }
+    };
+    check();
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nb; i += 2) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    flat_index->SetBlacklist(concurrent_bitset_ptr);
+    check();
+}
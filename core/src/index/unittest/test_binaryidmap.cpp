@@ -87,6 +87,36 @@ TEST_P(BinaryIDMAPTest, binaryidmap_basic) {
     // AssertAneq(result4, nq, k);
 }
 
+TEST_P(BinaryIDMAPTest, binaryidmap_range_search) {
+    std::string MetricType = GetParam();
+    milvus::knowhere::Config conf{
+        {milvus::knowhere::meta::DIM, dim},
+        {milvus::knowhere::meta::TOPK, k},
+        {milvus::knowhere::Metric::TYPE, MetricType},
+    };
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Query(query_dataset, conf);
+    auto radius = result->Get<float*>(milvus::knowhere::meta::DISTANCE)[k / 2];
+    conf[milvus::knowhere::meta::RADIUS] = radius;
+    if (MetricType != milvus::knowhere::Metric::HAMMING) {
+        ASSERT_ANY_THROW(index_->QueryByRange(query_dataset, conf));
+        return;
+    }
+    auto range_result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(range_result, result, nq, k, radius);
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    result = index_->Query(query_dataset, conf);
+    range_result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(range_result, result, nq, k, radius);
+}
+
 TEST_P(BinaryIDMAPTest, binaryidmap_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
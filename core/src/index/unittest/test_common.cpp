@@ -9,7 +9,9 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <faiss/utils/HugePage.h>
 #include <gtest/gtest.h>
+#include <cstring>
 #include "knowhere/common/Dataset.h"
 #include "knowhere/common/Timer.h"
 #include "knowhere/knowhere/common/Exception.h"
@@ -43,3 +45,21 @@ TEST(COMMON_TEST, time_recoder) {
     double span = recoder.ElapseFromBegin("get time");
     ASSERT_GE(span, 1.0);
 }
+
+TEST(COMMON_TEST, huge_page_test) {
+    faiss::faiss_use_huge_page = true;
+    size_t size = 3 * faiss::HUGE_PAGE_SIZE + 100;
+    auto ptr = faiss::alloc_huge_page(size);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ((uintptr_t)ptr % faiss::HUGE_PAGE_SIZE, 0);
+    memset(ptr, 1, size);
+    // the pages are only given when the kernel has transparent huge pages enabled
+    ASSERT_GE(faiss::huge_page_usage(), 0);
+    free(ptr);
+
+    // small allocations stay on regular pages
+    ptr = faiss::alloc_huge_page(100);
+    ASSERT_NE(ptr, nullptr);
+    free(ptr);
+    faiss::faiss_use_huge_page = false;
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexDiskANN.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+#include "unittest/utils.h"
+
+using ::testing::Combine;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+class DiskANNTest : public DataGen, public TestWithParam<std::string> {
+ protected:
+    void
+    SetUp() override {
+        IndexType = GetParam();
+        Generate(64, 2000, 10);
+        index_ = std::make_shared<milvus::knowhere::IndexDiskANN>();
+        conf = milvus::knowhere::Config{
+            {milvus::knowhere::meta::DIM, dim},
+            {milvus::knowhere::meta::TOPK, 10},
+            {milvus::knowhere::IndexParams::out_degree, 32},
+            {milvus::knowhere::IndexParams::candidate, 64},
+            {milvus::knowhere::IndexParams::m, 16},
+            {milvus::knowhere::IndexParams::search_length, 40},
+            {milvus::knowhere::IndexParams::beam_width, 4},
+            {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+        };
+    }
+
+ protected:
+    milvus::knowhere::Config conf;
+    std::shared_ptr<milvus::knowhere::IndexDiskANN> index_ = nullptr;
+    std::string IndexType;
+};
+
+INSTANTIATE_TEST_CASE_P(DiskANNParameters, DiskANNTest, Values("DiskANN"));
+
+TEST_P(DiskANNTest, diskann_basic) {
+    assert(!xb.empty());
+
+    // null index
+    {
+        ASSERT_ANY_THROW(index_->Train(base_dataset, conf));
+        ASSERT_ANY_THROW(index_->Query(query_dataset, conf));
+        ASSERT_ANY_THROW(index_->Serialize(conf));
+        ASSERT_ANY_THROW(index_->Add(base_dataset, conf));
+        ASSERT_ANY_THROW(index_->AddWithoutIds(base_dataset, conf));
+        ASSERT_ANY_THROW(index_->Count());
+        ASSERT_ANY_THROW(index_->Dim());
+    }
+
+    index_->BuildAll(base_dataset, conf);
+    ASSERT_EQ(index_->Count(), nb);
+    ASSERT_EQ(index_->Dim(), dim);
+
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+}
+
+TEST_P(DiskANNTest, diskann_delete) {
+    assert(!xb.empty());
+
+    index_->BuildAll(base_dataset, conf);
+
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (auto i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+
+    auto result1 = index_->Query(query_dataset, conf);
+    AssertAnns(result1, nq, k);
+
+    index_->SetBlacklist(bitset);
+    auto result2 = index_->Query(query_dataset, conf);
+    AssertAnns(result2, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_P(DiskANNTest, diskann_serialize) {
+    assert(!xb.empty());
+
+    index_->BuildAll(base_dataset, conf);
+    auto binaryset = index_->Serialize(conf);
+
+    auto new_index = std::make_shared<milvus::knowhere::IndexDiskANN>();
+    new_index->Load(binaryset);
+    ASSERT_EQ(new_index->Count(), nb);
+    ASSERT_EQ(new_index->Dim(), dim);
+    ASSERT_EQ(new_index->IndexSize(), index_->IndexSize());
+
+    auto result = new_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+}
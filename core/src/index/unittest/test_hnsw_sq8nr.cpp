@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <knowhere/index/vector_offset_index/IndexHNSW_SQ8NR.h>
 #include <src/index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h>
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include "knowhere/common/Exception.h"
@@ -89,6 +90,34 @@ TEST_P(HNSWSQ8NRTest, HNSW_basic) {
     AssertAnns(result, nq, k);
 }
 
+TEST_P(HNSWSQ8NRTest, HNSW_ip) {
+    conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::IP;
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    milvus::knowhere::BinarySet bs = index_->Serialize();
+    index_->Load(bs);
+
+    // the graph walk keeps the largest inner products, they come first
+    auto result = index_->Query(query_dataset, conf);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (auto i = 0; i < nq; i++) {
+        float max_ip = 0;
+        for (auto j = 0; j < nb; j++) {
+            float ip = 0;
+            for (auto d = 0; d < dim; d++) {
+                ip += xq[i * dim + d] * xb[j * dim + d];
+            }
+            max_ip = std::max(max_ip, ip);
+        }
+        ASSERT_NE(ids[i * k], -1);
+        EXPECT_GT(dist[i * k], max_ip * 0.95);
+        for (auto j = 1; j < k; j++) {
+            EXPECT_LE(dist[i * k + j], dist[i * k + j - 1]);
+        }
+    }
+}
+
 TEST_P(HNSWSQ8NRTest, HNSW_delete) {
     assert(!xb.empty());
 
@@ -183,6 +212,25 @@ TEST_P(HNSWSQ8NRTest, HNSW_serialize) {
     }
 }
 
+TEST_P(HNSWSQ8NRTest, HNSW_low_bits) {
+    for (int64_t nbits : {4, 6}) {
+        conf[milvus::knowhere::IndexParams::nbits] = nbits;
+        index_ = std::make_shared<milvus::knowhere::IndexHNSW_SQ8NR>();
+        index_->Train(base_dataset, conf);
+        index_->Add(base_dataset, conf);
+        auto binaryset = index_->Serialize();
+        auto bin_sq8 = binaryset.GetByName(SQ8_DATA);
+        EXPECT_EQ(bin_sq8->size, (dim * nbits + 7) / 8 * nb + 2 * dim * sizeof(float));
+
+        // the quantizer type is loaded with the index
+        auto loaded = std::make_shared<milvus::knowhere::IndexHNSW_SQ8NR>();
+        loaded->Load(binaryset);
+        EXPECT_EQ(loaded->Count(), nb);
+        auto result = loaded->Query(query_dataset, conf);
+        AssertAnns(result, nq, conf[milvus::knowhere::meta::TOPK]);
+    }
+}
+
 /*
  * faiss style test
  * keep it
@@ -15,6 +15,7 @@
 #include <fiu-local.h>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/IndexType.h"
@@ -128,6 +129,86 @@ TEST_P(IDMAPTest, idmap_basic) {
 #endif
 }
 
+TEST_P(IDMAPTest, idmap_range_search) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    ASSERT_ANY_THROW(index_->QueryByRange(query_dataset, conf));
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Query(query_dataset, conf);
+    auto radius = result->Get<float*>(milvus::knowhere::meta::DISTANCE)[k / 2];
+    conf[milvus::knowhere::meta::RADIUS] = radius;
+    auto range_result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(range_result, result, nq, k, radius);
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    result = index_->Query(query_dataset, conf);
+    range_result = index_->QueryByRange(query_dataset, conf);
+    AssertRangeResult(range_result, result, nq, k, radius);
+}
+
+TEST_P(IDMAPTest, idmap_query_into) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Query(query_dataset, conf);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+
+    // the faiss search into the buffers and the copy of the Query result agree with Query
+    std::vector<int64_t> into_ids(nq * k);
+    std::vector<float> into_dist(nq * k);
+    std::vector<int64_t> copy_ids(nq * k);
+    std::vector<float> copy_dist(nq * k);
+    index_->QueryInto(query_dataset, conf, into_ids.data(), into_dist.data());
+    index_->VecIndex::QueryInto(query_dataset, conf, copy_ids.data(), copy_dist.data());
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(into_ids[i], ids[i]);
+        ASSERT_EQ(into_dist[i], dist[i]);
+        ASSERT_EQ(copy_ids[i], ids[i]);
+        ASSERT_EQ(copy_dist[i], dist[i]);
+    }
+}
+
+TEST_P(IDMAPTest, idmap_compressed) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+                                  {milvus::knowhere::IndexParams::compression, "pq"}};
+    ASSERT_ANY_THROW(index_->Train(base_dataset, conf));
+
+    for (auto compression : {milvus::knowhere::Compression::SQ8, milvus::knowhere::Compression::FP16}) {
+        conf[milvus::knowhere::IndexParams::compression] = compression;
+        index_ = std::make_shared<milvus::knowhere::IDMAP>();
+        index_->Train(base_dataset, conf);
+        index_->AddWithoutIds(base_dataset, conf);
+        EXPECT_EQ(index_->Count(), nb);
+        ASSERT_TRUE(index_->Compressed());
+        ASSERT_EQ(index_->GetRawVectors(), nullptr);
+        ASSERT_LT(index_->IndexSize(), nb * dim * sizeof(float));
+
+        // the queries are base vectors, their own row is still the nearest
+        auto result = index_->Query(query_dataset, conf);
+        AssertAnns(result, nq, k);
+
+        auto binaryset = index_->Serialize();
+        auto new_index = std::make_shared<milvus::knowhere::IDMAP>();
+        new_index->Load(binaryset);
+        ASSERT_TRUE(new_index->Compressed());
+        AssertAnns(new_index->Query(query_dataset, conf), nq, k);
+    }
+}
+
 TEST_P(IDMAPTest, idmap_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
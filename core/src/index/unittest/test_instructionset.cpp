@@ -15,10 +15,13 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include "faiss/FaissHook.h"
 #include "faiss/utils/instruction_set.h"
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <random>
+#include <vector>
 
 void
 ShowInstructionSet() {
@@ -93,3 +96,36 @@ ShowInstructionSet() {
 TEST(InstructionSetTest, INSTRUCTION_SET_TEST) {
     ASSERT_NO_FATAL_FAILURE(ShowInstructionSet());
 }
+
+TEST(InstructionSetTest, DIM_KERNELS_TEST) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> distrib;
+    std::vector<float> data(5 * 1024);
+    for (auto& v : data) {
+        v = distrib(gen);
+    }
+    const float* x = data.data();
+    const float* y = x + 1024;
+
+    // the unrolled kernels sum in the order of the generic ones, the results are the same
+    for (size_t d : {100, 128, 768}) {
+        auto kernels = faiss::fvec_kernels_for_dim(d);
+        ASSERT_EQ(kernels.L2sqr(x, y, d), faiss::fvec_L2sqr(x, y, d));
+        ASSERT_EQ(kernels.inner_product(x, y, d), faiss::fvec_inner_product(x, y, d));
+
+        float dis[8];
+        kernels.L2sqr_batch_4(x, y, y + 1024, y + 2048, y + 3072, d, dis[0], dis[1], dis[2], dis[3]);
+        faiss::fvec_L2sqr_batch_4(x, y, y + 1024, y + 2048, y + 3072, d, dis[4], dis[5], dis[6], dis[7]);
+        for (int i = 0; i < 4; i++) {
+            ASSERT_EQ(dis[i], dis[i + 4]);
+        }
+        kernels.inner_product_batch_4(x, y, y + 1024, y + 2048, y + 3072, d, dis[0], dis[1], dis[2], dis[3]);
+        faiss::fvec_inner_product_batch_4(x, y, y + 1024, y + 2048, y + 3072, d, dis[4], dis[5], dis[6], dis[7]);
+        for (int i = 0; i < 4; i++) {
+            ASSERT_EQ(dis[i], dis[i + 4]);
+        }
+    }
+}
@@ -12,8 +12,12 @@
 #include <gtest/gtest.h>
 
 #include <fiu-control.h>
+#include <fcntl.h>
 #include <fiu-local.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <iostream>
+#include <random>
 #include <thread>
 
 #ifdef MILVUS_GPU_VERSION
@@ -25,8 +29,11 @@
 #include "knowhere/index/IndexType.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IVFCompact.h"
+#include "knowhere/index/vector_index/helpers/IVFTrain.h"
 
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/gpu/IndexGPUIVF.h"
@@ -86,6 +93,7 @@ INSTANTIATE_TEST_CASE_P(
         std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFSQ8H, milvus::knowhere::IndexMode::MODE_GPU),
 #endif
         std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ, milvus::knowhere::IndexMode::MODE_CPU),
+        std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, milvus::knowhere::IndexMode::MODE_CPU),
         std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFSQ8, milvus::knowhere::IndexMode::MODE_CPU)));
 
 TEST_P(IVFTest, ivf_basic_cpu) {
@@ -148,6 +156,39 @@ TEST_P(IVFTest, ivf_basic_cpu) {
 #endif
 }
 
+TEST_P(IVFTest, ivf_range_search) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto result = index_->Query(query_dataset, conf_);
+    auto radius = result->Get<float*>(milvus::knowhere::meta::DISTANCE)[k / 2];
+    conf_[milvus::knowhere::meta::RADIUS] = radius;
+
+    // the scanners of the top k and of the range search round the quantized distances differently, so the hits
+    // near the radius may differ and only the bound and the blacklist are checked
+    auto check = [&](const milvus::knowhere::DatasetPtr& range_result, bool blacklisted) {
+        auto lims = range_result->Get<size_t*>(milvus::knowhere::meta::LIMS);
+        auto ids = range_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto distances = range_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        ASSERT_GT(lims[nq], 0);
+        for (size_t i = 0; i < lims[nq]; ++i) {
+            ASSERT_LT(distances[i], radius);
+            ASSERT_TRUE(!blacklisted || ids[i] >= nq);
+        }
+    };
+    check(index_->QueryByRange(query_dataset, conf_), false);
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    check(index_->QueryByRange(query_dataset, conf_), true);
+}
+
 TEST_P(IVFTest, ivf_basic_gpu) {
     assert(!xb.empty());
 
@@ -215,6 +256,167 @@ TEST_P(IVFTest, ivf_serialize) {
     }
 }
 
+TEST_P(IVFTest, ivf_train_mode) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    for (auto mode : {milvus::knowhere::TrainMode::MINI_BATCH, milvus::knowhere::TrainMode::HIERARCHICAL,
+                      milvus::knowhere::TrainMode::BALANCED}) {
+        conf_[milvus::knowhere::IndexParams::train_mode] = mode;
+        conf_[milvus::knowhere::IndexParams::train_size] = nb / 2;
+        index_->Train(base_dataset, conf_);
+        index_->AddWithoutIds(base_dataset, conf_);
+        EXPECT_EQ(index_->Count(), nb);
+        auto result = index_->Query(query_dataset, conf_);
+        AssertAnns(result, nq, k);
+    }
+}
+
+TEST_P(IVFTest, ivf_balanced_train) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    // half of the vectors in a tight blob, which k-means leaves to a few huge lists
+    std::vector<float> skewed(xb);
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> noise(0, 0.01);
+    for (int64_t i = 1; i < nb / 2; ++i) {
+        for (int64_t j = 0; j < dim; ++j) {
+            skewed[i * dim + j] = xb[j] + noise(e);
+        }
+    }
+    auto skewed_dataset = milvus::knowhere::GenDatasetWithIds(nb, dim, skewed.data(), ids.data());
+
+    auto max_list_size = [&](const std::string& mode) {
+        conf_[milvus::knowhere::IndexParams::train_mode] = mode;
+        auto index = IndexFactory(index_type_, index_mode_);
+        index->Train(skewed_dataset, conf_);
+        index->AddWithoutIds(skewed_dataset, conf_);
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index->index_.get());
+        size_t max_size = 0;
+        for (size_t i = 0; i < ivf_index->nlist; ++i) {
+            max_size = std::max(max_size, ivf_index->invlists->list_size(i));
+        }
+        // the histogram logged after a build reports these lists
+        auto histogram = milvus::knowhere::GetIVFListSizeHistogram(ivf_index);
+        EXPECT_EQ(histogram.find("nlist " + std::to_string(ivf_index->nlist) + ","), 0);
+        EXPECT_NE(histogram.find(", max " + std::to_string(max_size) + ","), std::string::npos);
+        return max_size;
+    };
+
+    EXPECT_LT(max_list_size(milvus::knowhere::TrainMode::BALANCED), max_list_size(milvus::knowhere::TrainMode::LLOYD));
+}
+
+TEST_P(IVFTest, ivf_shared_quantizer) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto fingerprint = index_->CentroidsFingerprint();
+    ASSERT_NE(fingerprint, 0);
+
+    // an index trained with the centroids of another one shares its fingerprint
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+    auto centroids = milvus::knowhere::GetIVFCentroids(ivf_index);
+    ASSERT_NE(centroids, nullptr);
+    std::vector<float> shared_centroids(centroids, centroids + ivf_index->nlist * dim);
+    base_dataset->Set(milvus::knowhere::meta::CENTROIDS, static_cast<const float*>(shared_centroids.data()));
+    auto shared = IndexFactory(index_type_, index_mode_);
+    shared->Train(base_dataset, conf_);
+    shared->AddWithoutIds(base_dataset, conf_);
+    EXPECT_EQ(shared->CentroidsFingerprint(), fingerprint);
+
+    // and searches the lists of a coarse assignment made with the first one
+    int64_t nprobe = conf_[milvus::knowhere::IndexParams::nprobe].get<int64_t>();
+    std::vector<int64_t> coarse_ids(nq * nprobe);
+    std::vector<float> coarse_distances(nq * nprobe);
+    ivf_index->quantizer->search(nq, xq.data(), nprobe, coarse_distances.data(), coarse_ids.data());
+    auto preassigned_dataset = milvus::knowhere::GenDataset(nq, dim, xq.data());
+    preassigned_dataset->Set(milvus::knowhere::meta::COARSE_IDS, static_cast<const int64_t*>(coarse_ids.data()));
+    preassigned_dataset->Set(milvus::knowhere::meta::COARSE_DISTANCES,
+                             static_cast<const float*>(coarse_distances.data()));
+
+    auto expected = shared->Query(query_dataset, conf_);
+    auto result = shared->Query(preassigned_dataset, conf_);
+    auto expected_ids = expected->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto result_ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(result_ids[i], expected_ids[i]);
+    }
+}
+
+TEST_P(IVFTest, ivf_on_disk) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU ||
+        index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN) {
+        return;
+    }
+
+    conf_[milvus::knowhere::IndexParams::on_disk] = true;
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto binaryset = index_->Serialize();
+    ASSERT_EQ(binaryset.binary_map_.count("IVF_ON_DISK"), 1);
+    auto bin = binaryset.GetByName("IVF");
+
+    // map the serialized index the way the index files are loaded
+    std::string filename = "/tmp/ivf_test_on_disk.bin";
+    {
+        FileIOWriter writer(filename);
+        writer(static_cast<void*>(bin->data.get()), bin->size);
+    }
+    int fd = open(filename.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    int64_t size = bin->size;
+    auto addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(addr, MAP_FAILED);
+    std::shared_ptr<uint8_t[]> data(static_cast<uint8_t*>(addr), [size](uint8_t* p) { munmap(p, size); });
+
+    milvus::knowhere::BinarySet mapped_set;
+    mapped_set.Append("IVF", data, size);
+    mapped_set.GetByName("IVF")->mapped = true;
+    mapped_set.Append("IVF_ON_DISK", binaryset.GetByName("IVF_ON_DISK")->data, 1);
+
+    auto loaded = IndexFactory(index_type_, index_mode_);
+    loaded->Load(mapped_set);
+    loaded->SetIndexSize(size);
+    EXPECT_TRUE(loaded->OnDisk());
+    EXPECT_EQ(loaded->Count(), nb);
+    EXPECT_LT(loaded->IndexSize(), size);
+
+    auto result = loaded->Query(query_dataset, conf_);
+    AssertAnns(result, nq, k);
+}
+
+TEST_P(IVFTest, ivf_compact) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+
+    // drop the odd offsets
+    std::vector<int64_t> new_offsets(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        new_offsets[i] = (i % 2 == 0) ? i / 2 : -1;
+    }
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+    ASSERT_NE(ivf_index, nullptr);
+    ASSERT_TRUE(milvus::knowhere::CompactInvertedLists(ivf_index, new_offsets));
+    EXPECT_EQ(index_->Count(), (nb + 1) / 2);
+
+    auto result = index_->Query(query_dataset, conf_);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq; i += 2) {
+        ASSERT_EQ(ids[i * k], i / 2);
+    }
+}
+
 // TODO(linxj): deprecated
 #ifdef MILVUS_GPU_VERSION
 TEST_P(IVFTest, clone_test) {
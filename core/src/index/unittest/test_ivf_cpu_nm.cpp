@@ -24,6 +24,7 @@
 #include "knowhere/common/Timer.h"
 #include "knowhere/index/IndexType.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
 
 #ifdef MILVUS_GPU_VERSION
@@ -129,3 +130,105 @@ TEST_P(IVFNMCPUTest, ivf_basic_cpu) {
     milvus::knowhere::FaissGpuResourceMgr::GetInstance().Dump();
 #endif
 }
+
+TEST_P(IVFNMCPUTest, ivf_half_storage_cpu) {
+    assert(!xb.empty());
+
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
+    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
+    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
+
+    for (auto storage_type : {milvus::knowhere::StorageType::FLOAT16, milvus::knowhere::StorageType::BFLOAT16}) {
+        auto index = std::make_shared<milvus::knowhere::IVF_NM>();
+        auto conf = conf_;
+        conf[milvus::knowhere::IndexParams::storage_type] = storage_type;
+
+        index->Train(base_dataset, conf);
+        index->AddWithoutIds(base_dataset, conf);
+        EXPECT_EQ(index->Count(), nb);
+
+        milvus::knowhere::BinarySet bs = index->Serialize(conf);
+        milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
+        bptr->size = dim * rows * sizeof(float);
+        bs.Append(RAW_DATA, bptr);
+        index->Load(bs);
+
+        auto result = index->Query(query_dataset, conf);
+        AssertAnns(result, nq, k);
+    }
+
+    auto conf = conf_;
+    conf[milvus::knowhere::IndexParams::storage_type] = "int8";
+    ASSERT_ANY_THROW(index_->Train(base_dataset, conf));
+}
+
+TEST_P(IVFNMCPUTest, ivf_adaptive_nprobe_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
+    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
+    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
+    bptr->size = dim * rows * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+
+    // the lists skipped by an adaptive search cannot hold a better neighbor than those of a full max_nprobe search
+    auto full_conf = conf_;
+    full_conf[milvus::knowhere::IndexParams::nprobe] = 32;
+    auto adaptive_conf = conf_;
+    adaptive_conf[milvus::knowhere::IndexParams::max_nprobe] = 32;
+    ASSERT_TRUE(milvus::knowhere::IsAdaptiveProbe(adaptive_conf));
+    EXPECT_EQ(milvus::knowhere::GetProbeCount(adaptive_conf), 32);
+
+    auto expected = index_->Query(query_dataset, full_conf);
+    auto result = index_->Query(query_dataset, adaptive_conf);
+    auto expected_ids = expected->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto result_ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(result_ids[i], expected_ids[i]);
+    }
+}
+
+TEST_P(IVFNMCPUTest, ivf_raw_vectors_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    std::vector<int64_t> offsets{0, nb - 1, nb / 2};
+    std::vector<float> vectors(offsets.size() * dim);
+    // the direct map is made by Load
+    ASSERT_FALSE(index_->GetRawVectors(offsets.data(), offsets.size(), vectors.data()));
+
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+    bptr->size = dim * nb * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+
+    ASSERT_TRUE(index_->GetRawVectors(offsets.data(), offsets.size(), vectors.data()));
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        for (int64_t j = 0; j < dim; ++j) {
+            EXPECT_EQ(vectors[i * dim + j], xb[offsets[i] * dim + j]);
+        }
+    }
+
+    offsets.push_back(nb);
+    vectors.resize(offsets.size() * dim);
+    EXPECT_FALSE(index_->GetRawVectors(offsets.data(), offsets.size(), vectors.data()));
+}
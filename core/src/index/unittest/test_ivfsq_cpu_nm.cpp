@@ -131,3 +131,29 @@ TEST_P(IVFSQNMCPUTest, ivf_basic_cpu) {
     milvus::knowhere::FaissGpuResourceMgr::GetInstance().Dump();
 #endif
 }
+
+TEST_P(IVFSQNMCPUTest, ivf_low_bits) {
+    for (int64_t nbits : {4, 6}) {
+        conf_[milvus::knowhere::IndexParams::nbits] = nbits;
+        index_ = std::make_shared<milvus::knowhere::IVFSQNR_NM>();
+        index_->Train(base_dataset, conf_);
+        index_->AddWithoutIds(base_dataset, conf_);
+        EXPECT_EQ(index_->Count(), nb);
+
+        auto ivfsq_index = dynamic_cast<faiss::IndexIVFScalarQuantizer*>(index_->index_.get());
+        ASSERT_NE(ivfsq_index, nullptr);
+        EXPECT_EQ(ivfsq_index->code_size, static_cast<size_t>((dim * nbits + 7) / 8));
+
+        // the codes and the trained data of the quantizer are kept out of the index binary
+        auto binaryset = index_->Serialize();
+        EXPECT_EQ(binaryset.GetByName(SQ8_DATA)->size, nb * ivfsq_index->code_size + 2 * dim * sizeof(float));
+        index_->Load(binaryset);
+
+        auto result = index_->Query(query_dataset, conf_);
+        AssertAnns(result, nq, k);
+    }
+
+    conf_[milvus::knowhere::IndexParams::nbits] = 5;
+    index_ = std::make_shared<milvus::knowhere::IVFSQNR_NM>();
+    ASSERT_ANY_THROW(index_->Train(base_dataset, conf_));
+}
@@ -0,0 +1,141 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/preprocessor/VectorTransformPreprocessor.h"
+#include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexPreprocessed.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "unittest/utils.h"
+
+class PreprocessorTest : public DataGen, public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        Init_with_default();
+    }
+};
+
+TEST_F(PreprocessorTest, preprocessor_spec) {
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("", dim));
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("PCA", dim));
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("PCA128", dim));
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("OPQ5", dim));
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("OPQ8_60", dim));
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("PCA32,OPQ8_64", dim));
+    ASSERT_ANY_THROW(milvus::knowhere::VectorTransformPreprocessor("L2", dim));
+
+    milvus::knowhere::VectorTransformPreprocessor preprocessor("PCAR32,OPQ8_16,L2norm", dim);
+    ASSERT_EQ(preprocessor.DimIn(), dim);
+    ASSERT_EQ(preprocessor.DimOut(), 16);
+    ASSERT_FALSE(preprocessor.IsTrained());
+    ASSERT_ANY_THROW(preprocessor.Preprocess(query_dataset));
+}
+
+TEST_F(PreprocessorTest, preprocessor_serialize) {
+    auto preprocessor = std::make_shared<milvus::knowhere::VectorTransformPreprocessor>("PCA32,OPQ4,L2norm", dim);
+    preprocessor->Train(milvus::knowhere::GenDataset(1000, dim, xb.data()));
+    ASSERT_TRUE(preprocessor->IsTrained());
+    ASSERT_GT(preprocessor->Size(), 0);
+
+    auto result = preprocessor->Preprocess(query_dataset);
+    ASSERT_EQ(result->Get<int64_t>(milvus::knowhere::meta::ROWS), nq);
+    ASSERT_EQ(result->Get<int64_t>(milvus::knowhere::meta::DIM), 32);
+    auto xt = static_cast<const float*>(result->Get<const void*>(milvus::knowhere::meta::TENSOR));
+    for (auto i = 0; i < nq; ++i) {
+        float norm = 0;
+        for (auto j = 0; j < 32; ++j) {
+            norm += xt[i * 32 + j] * xt[i * 32 + j];
+        }
+        ASSERT_NEAR(norm, 1.0, 1e-4);
+    }
+
+    milvus::knowhere::BinarySet binary_set;
+    preprocessor->Serialize(binary_set);
+    milvus::knowhere::VectorTransformPreprocessor loaded;
+    loaded.Load(binary_set);
+    ASSERT_TRUE(loaded.IsTrained());
+    ASSERT_EQ(loaded.DimIn(), dim);
+    ASSERT_EQ(loaded.DimOut(), 32);
+
+    auto result2 = loaded.Preprocess(query_dataset);
+    auto xt2 = static_cast<const float*>(result2->Get<const void*>(milvus::knowhere::meta::TENSOR));
+    for (auto i = 0; i < nq * 32; ++i) {
+        ASSERT_FLOAT_EQ(xt[i], xt2[i]);
+    }
+}
+
+TEST_F(PreprocessorTest, preprocessed_idmap) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    auto preprocessor = std::make_shared<milvus::knowhere::VectorTransformPreprocessor>("PCA32", dim);
+    auto index = std::make_shared<milvus::knowhere::PreprocessedIndex>(preprocessor,
+                                                                       std::make_shared<milvus::knowhere::IDMAP>());
+    index->BuildAll(base_dataset, conf);
+    ASSERT_EQ(index->Dim(), dim);
+    ASSERT_EQ(index->GetIndex()->Dim(), 32);
+    ASSERT_EQ(index->Count(), nb);
+
+    auto result = index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    auto binary_set = index->Serialize(conf);
+    auto loaded = std::make_shared<milvus::knowhere::PreprocessedIndex>(std::make_shared<milvus::knowhere::IDMAP>());
+    loaded->Load(binary_set);
+    ASSERT_EQ(loaded->Dim(), dim);
+    ASSERT_EQ(loaded->Count(), nb);
+    AssertAnns(loaded->Query(query_dataset, conf), nq, k);
+
+    // the blacklist of the wrapper applies to the inner index
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+    loaded->SetBlacklist(bitset);
+    AssertAnns(loaded->Query(query_dataset, conf), nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_F(PreprocessorTest, preprocessed_ivfpq) {
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::meta::TOPK, k},
+                                  {milvus::knowhere::IndexParams::nlist, 100},
+                                  {milvus::knowhere::IndexParams::nprobe, 8},
+                                  {milvus::knowhere::IndexParams::m, 8},
+                                  {milvus::knowhere::IndexParams::nbits, 8},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    // a trained preprocessor is not trained again by the index
+    auto preprocessor = std::make_shared<milvus::knowhere::VectorTransformPreprocessor>("OPQ8", dim);
+    preprocessor->Train(milvus::knowhere::GenDataset(1000, dim, xb.data()));
+    auto index = std::make_shared<milvus::knowhere::PreprocessedIndex>(preprocessor,
+                                                                       std::make_shared<milvus::knowhere::IVFPQ>());
+    index->Train(base_dataset, conf);
+    index->AddWithoutIds(base_dataset, conf);
+    ASSERT_EQ(index->Count(), nb);
+    ASSERT_EQ(index->index_type(), milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ);
+
+    auto result = index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    auto binary_set = index->Serialize(conf);
+    auto loaded = std::make_shared<milvus::knowhere::PreprocessedIndex>(std::make_shared<milvus::knowhere::IVFPQ>());
+    loaded->Load(binary_set);
+    AssertAnns(loaded->Query(query_dataset, conf), nq, k);
+}
@@ -141,3 +141,24 @@ TEST_P(SPTAGTest, sptag_serialize) {
         PrintResult(result, nq, k);
     }
 }
+
+TEST_P(SPTAGTest, sptag_load_in_place) {
+    index_->Train(base_dataset, conf);
+    auto new_index = std::make_shared<milvus::knowhere::CPUSPTAGRNG>(IndexType);
+    {
+        // the loaded index uses the blobs in place, it keeps them once the binary set is gone
+        auto binaryset = index_->Serialize();
+        new_index->Load(binaryset);
+    }
+    ASSERT_EQ(new_index->Count(), nb);
+    auto result = new_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    // the results reused across the queries of a thread are reset between them
+    auto again = new_index->Query(query_dataset, conf);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto again_ids = again->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], again_ids[i]);
+    }
+}
@@ -12,10 +12,12 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <random>
 #include <sstream>
 
+#include "knowhere/index/structured_index/StructuredIndexFactory.h"
 #include "knowhere/index/structured_index/StructuredIndexSort.h"
 
 #include "unittest/utils.h"
@@ -268,3 +270,91 @@ TEST(STRUCTUREDINDEXSORT_TEST, test_double_border_range) {
     }
     free(p);
 }
+
+TEST(STRUCTUREDINDEXSORT_TEST, test_large_in) {
+    int range = 1000, n = 1000, *p = nullptr;
+    gen_rand_data(range, n, p);
+    milvus::knowhere::StructuredIndexSort<int> structuredIndexSort((size_t)n, p);  // Build default
+
+    // enough terms for the scan of the sorted rows
+    std::vector<int> test_vals;
+    for (auto i = 0; i < 200; ++i) {
+        test_vals.emplace_back(i * 3);
+    }
+    auto in_res = structuredIndexSort.In(test_vals.size(), test_vals.data());
+    auto not_in_res = structuredIndexSort.NotIn(test_vals.size(), test_vals.data());
+    for (auto i = 0; i < n; ++i) {
+        bool expect = *(p + i) < 600 && *(p + i) % 3 == 0;
+        ASSERT_EQ(expect, in_res->test(i));
+        ASSERT_EQ(!expect, not_in_res->test(i));
+    }
+    free(p);
+}
+
+TEST(STRUCTUREDINDEXBITMAP_TEST, test_query) {
+    // a row count which is not a multiple of the 64 bit words
+    int range = 20, n = 1003, *p = nullptr;
+    gen_rand_data(range, n, p);
+    milvus::knowhere::StructuredIndexBitmap<int> structuredIndexBitmap((size_t)n, p);
+    milvus::knowhere::StructuredIndexSort<int> structuredIndexSort((size_t)n, p);
+    ASSERT_LE(structuredIndexBitmap.GetValues().size(), (size_t)range);
+
+    auto expect_same = [&](const faiss::ConcurrentBitsetPtr& bitmap_res, const faiss::ConcurrentBitsetPtr& sort_res) {
+        // the bits past the rows are compared as well
+        ASSERT_EQ(sort_res->size(), bitmap_res->size());
+        ASSERT_EQ(0, memcmp(sort_res->data(), bitmap_res->data(), sort_res->size()));
+    };
+
+    // few and most of the values, the latter is answered from the complement
+    std::vector<int> few_vals = {1, 7, 100};
+    std::vector<int> most_vals;
+    for (auto i = 0; i < range - 3; ++i) {
+        most_vals.emplace_back(i);
+    }
+    for (auto& vals : {few_vals, most_vals}) {
+        expect_same(structuredIndexBitmap.In(vals.size(), vals.data()),
+                    structuredIndexSort.In(vals.size(), vals.data()));
+        expect_same(structuredIndexBitmap.NotIn(vals.size(), vals.data()),
+                    structuredIndexSort.NotIn(vals.size(), vals.data()));
+    }
+
+    for (int val = -1; val <= range; ++val) {
+        for (auto op : {milvus::knowhere::OperatorType::LT, milvus::knowhere::OperatorType::LE,
+                        milvus::knowhere::OperatorType::GT, milvus::knowhere::OperatorType::GE}) {
+            expect_same(structuredIndexBitmap.Range(val, op), structuredIndexSort.Range(val, op));
+        }
+        expect_same(structuredIndexBitmap.Range(val, false, 10, true), structuredIndexSort.Range(val, false, 10, true));
+        expect_same(structuredIndexBitmap.Range(5, true, val, false), structuredIndexSort.Range(5, true, val, false));
+    }
+    free(p);
+}
+
+TEST(STRUCTUREDINDEXBITMAP_TEST, test_serialize_and_load) {
+    int range = 10, n = 1000, *p = nullptr;
+    gen_rand_data(range, n, p);
+
+    auto index = milvus::knowhere::CreateStructuredIndex<int>((size_t)n, p);
+    ASSERT_NE(nullptr, std::dynamic_pointer_cast<milvus::knowhere::StructuredIndexBitmap<int>>(index));
+    auto binaryset = index->Serialize();
+
+    auto loaded = milvus::knowhere::CreateStructuredIndex<int>(binaryset);
+    loaded->Load(binaryset);
+    auto bitmap_index = std::dynamic_pointer_cast<milvus::knowhere::StructuredIndexBitmap<int>>(loaded);
+    ASSERT_NE(nullptr, bitmap_index);
+    ASSERT_EQ((size_t)n, bitmap_index->Count());
+
+    int val = 4;
+    auto res = loaded->Range(val, milvus::knowhere::OperatorType::LE);
+    for (auto i = 0; i < n; ++i) {
+        ASSERT_EQ(*(p + i) <= val, res->test(i));
+    }
+    free(p);
+
+    // too many distinct values for a bitmap index
+    gen_rand_data(1000, n, p);
+    index = milvus::knowhere::CreateStructuredIndex<int>((size_t)n, p);
+    ASSERT_NE(nullptr, std::dynamic_pointer_cast<milvus::knowhere::StructuredIndexSort<int>>(index));
+    loaded = milvus::knowhere::CreateStructuredIndex<int>(index->Serialize());
+    ASSERT_NE(nullptr, std::dynamic_pointer_cast<milvus::knowhere::StructuredIndexSort<int>>(loaded));
+    free(p);
+}
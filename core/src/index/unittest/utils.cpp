@@ -16,6 +16,7 @@
 #include <math.h>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 INITIALIZE_EASYLOGGINGPP
@@ -161,6 +162,35 @@ AssertAnns(const milvus::knowhere::DatasetPtr& result, const int nq, const int k
     }
 }
 
+void
+AssertRangeResult(const milvus::knowhere::DatasetPtr& range_result, const milvus::knowhere::DatasetPtr& topk_result,
+                  const int nq, const int k, const float radius, const bool ascending) {
+    auto lims = range_result->Get<size_t*>(milvus::knowhere::meta::LIMS);
+    auto range_ids = range_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto range_dist = range_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto topk_ids = topk_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto topk_dist = topk_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto within = [&](float dis) { return ascending ? dis < radius : dis > radius; };
+
+    for (auto i = 0; i < nq; i++) {
+        std::unordered_set<int64_t> hits;
+        for (auto j = lims[i]; j < lims[i + 1]; j++) {
+            ASSERT_TRUE(within(range_dist[j]));
+            hits.insert(range_ids[j]);
+        }
+        size_t topk_hits = 0;
+        for (auto j = i * k; j < (i + 1) * k; j++) {
+            if (topk_ids[j] != -1 && within(topk_dist[j])) {
+                ASSERT_TRUE(hits.count(topk_ids[j]));
+                topk_hits++;
+            }
+        }
+        if (topk_hits < (size_t)k) {
+            ASSERT_EQ(hits.size(), topk_hits);
+        }
+    }
+}
+
 #if 0
 void
 AssertVec(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere::DatasetPtr& base_dataset,
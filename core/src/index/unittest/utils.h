@@ -80,6 +80,12 @@ AssertBinVec(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere:
              const milvus::knowhere::DatasetPtr& id_dataset, const int n, const int dim,
              const CheckMode check_mode = CheckMode::CHECK_EQUAL);
 
+// the range result holds the hits of the top k result within radius and, unless the top k is full of them,
+// nothing else
+void
+AssertRangeResult(const milvus::knowhere::DatasetPtr& range_result, const milvus::knowhere::DatasetPtr& topk_result,
+                  const int nq, const int k, const float radius, const bool ascending = true);
+
 void
 PrintResult(const milvus::knowhere::DatasetPtr& result, const int& nq, const int& k);
 
@@ -18,6 +18,16 @@
 
 namespace milvus {
 namespace server {
+
+// the stages of a search, each one observed on its own by SearchStageObserve
+constexpr const char* SEARCH_STAGE_REQUEST_QUEUE = "request_queue";      // waiting in the request group queue
+constexpr const char* SEARCH_STAGE_META = "meta";                        // resolving partitions and files
+constexpr const char* SEARCH_STAGE_SCHEDULER_QUEUE = "scheduler_queue";  // a segment task waiting for a resource
+constexpr const char* SEARCH_STAGE_LOAD = "load";                        // loading a segment
+constexpr const char* SEARCH_STAGE_SEARCH = "search";                    // searching a segment
+constexpr const char* SEARCH_STAGE_REDUCE = "reduce";                    // merging topk results
+constexpr const char* SEARCH_STAGE_SERIALIZE = "serialize";              // building the response
+
 class MetricsBase {
  public:
     static MetricsBase&
@@ -55,6 +65,14 @@ class MetricsBase {
     BuildIndexDurationSecondsHistogramObserve(double value) {
     }
 
+    virtual void
+    IndexBuildVectorsPerSecondObserve(const std::string& index_type, double value) {
+    }
+
+    virtual void
+    IndexBuildBytesWrittenIncrement(double value) {
+    }
+
     virtual void
     CpuCacheUsageGaugeSet(double value) {
     }
@@ -183,10 +201,58 @@ class MetricsBase {
     KeepingAliveCounterIncrement(double value = 1) {
     }
 
+    virtual void
+    WalRecoveryProgressSet(double value) {
+    }
+
+    // paths of the cleaned up files queued to FileGC and not removed yet
+    virtual void
+    FileGCBacklogSet(double value) {
+    }
+
+    virtual void
+    RequestQueueWaitObserve(const std::string& group, double value) {
+    }
+
+    virtual void
+    RequestRejectedIncrement(const std::string& group) {
+    }
+
+    // index_type is empty for the stages which don't belong to a single segment
+    virtual void
+    SearchStageObserve(const char* stage, const std::string& collection_id, const std::string& index_type,
+                       double microseconds) {
+    }
+
+    // recall@k of the recently sampled searches against their exact results
+    virtual void
+    SearchRecallSet(const std::string& collection_id, const std::string& index_type, double recall) {
+    }
+
     virtual void
     OctetsSet() {
     }
 
+    // lock wait and hold times and queue depths of ContentionStats
+    virtual void
+    ContentionSet() {
+    }
+
+    // the builds of IndexBuildTracker, per collection
+    virtual void
+    IndexBuildProgressSet() {
+    }
+
+    // bytes held by each subsystem of MemoryAccounting and the memory limit
+    virtual void
+    MemoryUsageSet() {
+    }
+
+    // seconds each stage of the startup took, of StartupStages
+    virtual void
+    StartupStagesSet() {
+    }
+
     virtual void
     CPUCoreUsagePercentSet() {
     }
@@ -12,12 +12,20 @@
 #include "metrics/prometheus/PrometheusMetrics.h"
 #include "cache/GpuCacheMgr.h"
 #include "config/Config.h"
+#include "db/IndexBuildTracker.h"
 #include "metrics/SystemInfo.h"
+#include "utils/ContentionStats.h"
 #include "utils/Log.h"
+#include "utils/MemoryAccounting.h"
+#include "utils/StartupStages.h"
 
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace milvus {
 namespace server {
@@ -196,6 +204,101 @@ PrometheusMetrics::OctetsSet() {
     }
 }
 
+void
+PrometheusMetrics::ContentionSet() {
+    if (!startup_) {
+        return;
+    }
+
+    auto& stats = ContentionStats::GetInstance();
+    for (auto& lock : stats.Locks()) {
+        lock_acquisitions_.Add({{"lock", lock.name_}}).Set(lock.acquisitions_);
+        lock_contended_.Add({{"lock", lock.name_}}).Set(lock.contended_);
+        lock_wait_.Add({{"lock", lock.name_}}).Set(lock.wait_us_);
+        lock_hold_.Add({{"lock", lock.name_}}).Set(lock.hold_us_);
+        lock_max_wait_.Add({{"lock", lock.name_}}).Set(lock.max_wait_us_);
+    }
+    for (auto& queue : stats.QueueDepths()) {
+        queue_depth_.Add({{"queue", queue.name_}}).Set(queue.depth_);
+    }
+}
+
+void
+PrometheusMetrics::IndexBuildProgressSet() {
+    if (!startup_) {
+        return;
+    }
+
+    struct CollectionBuilds {
+        std::map<std::string, int64_t> segments_;  // per stage
+        int64_t rows_ = 0;
+        int64_t rows_indexed_ = 0;
+        double oldest_stage_seconds_ = 0;
+    };
+    static const std::vector<engine::IndexBuildStage> stages = {
+        engine::IndexBuildStage::QUEUED, engine::IndexBuildStage::LOADING, engine::IndexBuildStage::BUILDING,
+        engine::IndexBuildStage::SERIALIZING};
+
+    auto now = std::chrono::steady_clock::now();
+    std::map<std::string, CollectionBuilds> collections;
+    for (auto& build : engine::IndexBuildTracker::GetInstance().Builds()) {
+        auto& collection = collections[build.collection_id_];
+        collection.segments_[engine::IndexBuildStageName(build.stage_)]++;
+        collection.rows_ += build.row_count_;
+        collection.rows_indexed_ += build.rows_indexed_;
+        double stage_seconds = std::chrono::duration<double>(now - build.stage_time_).count();
+        collection.oldest_stage_seconds_ = std::max(collection.oldest_stage_seconds_, stage_seconds);
+    }
+
+    // a collection whose builds are done keeps its series at zero
+    for (auto& collection_id : index_build_collections_) {
+        collections[collection_id];
+    }
+
+    for (auto& pair : collections) {
+        index_build_collections_.insert(pair.first);
+        for (auto stage : stages) {
+            auto name = engine::IndexBuildStageName(stage);
+            index_build_segments_.Add({{"collection", pair.first}, {"stage", name}}).Set(pair.second.segments_[name]);
+        }
+        index_build_rows_.Add({{"collection", pair.first}}).Set(pair.second.rows_);
+        index_build_rows_indexed_.Add({{"collection", pair.first}}).Set(pair.second.rows_indexed_);
+        index_build_stage_age_.Add({{"collection", pair.first}}).Set(pair.second.oldest_stage_seconds_);
+    }
+}
+
+void
+PrometheusMetrics::MemoryUsageSet() {
+    if (!startup_) {
+        return;
+    }
+
+    auto& accounting = MemoryAccounting::GetInstance();
+    int64_t total = 0;
+    for (int i = 0; i < static_cast<int>(MemorySubsystem::COUNT); ++i) {
+        auto subsystem = static_cast<MemorySubsystem>(i);
+        int64_t usage = accounting.Usage(subsystem);
+        memory_usage_.Add({{"subsystem", MemorySubsystemName(subsystem)}}).Set(usage);
+        total += usage;
+    }
+    memory_usage_.Add({{"subsystem", "total"}}).Set(total);
+
+    int64_t limit = 0;
+    Config::GetInstance().GetCacheConfigMemoryLimit(limit);
+    memory_limit_gauge_.Set(limit);
+}
+
+void
+PrometheusMetrics::StartupStagesSet() {
+    if (!startup_) {
+        return;
+    }
+
+    for (auto& stage : StartupStages::GetInstance().Stages()) {
+        startup_stage_.Add({{"stage", stage.first}}).Set(stage.second);
+    }
+}
+
 void
 PrometheusMetrics::CPUCoreUsagePercentSet() {
     if (!startup_) {
@@ -16,6 +16,7 @@
 #include <prometheus/registry.h>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -94,6 +95,22 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    IndexBuildVectorsPerSecondObserve(const std::string& index_type, double value) override {
+        if (startup_) {
+            index_build_vectors_per_second_
+                .Add({{"index_type", index_type}}, BucketBoundaries{1e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6, 1e7})
+                .Observe(value);
+        }
+    }
+
+    void
+    IndexBuildBytesWrittenIncrement(double value) override {
+        if (startup_) {
+            index_build_bytes_written_counter_.Increment(value);
+        }
+    }
+
     void
     CpuCacheUsageGaugeSet(double value) override {
         if (startup_) {
@@ -281,9 +298,68 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    WalRecoveryProgressSet(double value) override {
+        if (startup_) {
+            wal_recovery_progress_gauge_.Set(value);
+        }
+    }
+
+    void
+    FileGCBacklogSet(double value) override {
+        if (startup_) {
+            file_gc_backlog_gauge_.Set(value);
+        }
+    }
+
+    void
+    RequestQueueWaitObserve(const std::string& group, double value) override {
+        if (startup_) {
+            request_queue_wait_.Add({{"group", group}}, BucketBoundaries{1e3, 1e4, 1e5, 1e6, 1e7}).Observe(value);
+        }
+    }
+
+    void
+    RequestRejectedIncrement(const std::string& group) override {
+        if (startup_) {
+            request_rejected_.Add({{"group", group}}).Increment();
+        }
+    }
+
+    void
+    SearchStageObserve(const char* stage, const std::string& collection_id, const std::string& index_type,
+                       double microseconds) override {
+        if (startup_) {
+            search_stage_duration_
+                .Add({{"stage", stage}, {"collection", collection_id}, {"index_type", index_type}},
+                     BucketBoundaries{100, 500, 1e3, 5e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6})
+                .Observe(microseconds);
+        }
+    }
+
+    void
+    SearchRecallSet(const std::string& collection_id, const std::string& index_type, double recall) override {
+        if (startup_) {
+            search_recall_.Add({{"collection", collection_id}, {"index_type", index_type}}).Set(recall);
+            search_recall_samples_.Add({{"collection", collection_id}, {"index_type", index_type}}).Increment();
+        }
+    }
+
     void
     OctetsSet() override;
 
+    void
+    ContentionSet() override;
+
+    void
+    IndexBuildProgressSet() override;
+
+    void
+    MemoryUsageSet() override;
+
+    void
+    StartupStagesSet() override;
+
     void
     GPUTemperature() override;
     void
@@ -644,6 +720,119 @@ class PrometheusMetrics : public MetricsBase {
                                                                   .Register(*registry_);
     prometheus::Counter& keeping_alive_counter_ = keeping_alive_.Add({});
 
+    prometheus::Family<prometheus::Gauge>& wal_recovery_progress_ = prometheus::BuildGauge()
+                                                                        .Name("wal_recovery_progress")
+                                                                        .Help("ratio of the replayed wal records")
+                                                                        .Register(*registry_);
+    prometheus::Gauge& wal_recovery_progress_gauge_ = wal_recovery_progress_.Add({});
+
+    prometheus::Family<prometheus::Gauge>& file_gc_backlog_ = prometheus::BuildGauge()
+                                                                  .Name("file_gc_backlog")
+                                                                  .Help("cleaned up files not removed yet")
+                                                                  .Register(*registry_);
+    prometheus::Gauge& file_gc_backlog_gauge_ = file_gc_backlog_.Add({});
+
+    // time the requests spend in the queue of their group, and the requests shed because the queue was full
+    prometheus::Family<prometheus::Histogram>& request_queue_wait_ =
+        prometheus::BuildHistogram()
+            .Name("request_queue_wait_microseconds")
+            .Help("histogram of the time requests wait in the queue of their group")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& request_rejected_ = prometheus::BuildCounter()
+                                                                     .Name("request_rejected_total")
+                                                                     .Help("total requests rejected by a full queue")
+                                                                     .Register(*registry_);
+
+    // time spent in every stage of a search, per collection and per index type of the segment
+    prometheus::Family<prometheus::Histogram>& search_stage_duration_ =
+        prometheus::BuildHistogram()
+            .Name("search_stage_duration_microseconds")
+            .Help("histogram of the time a search spends in each of its stages")
+            .Register(*registry_);
+
+    // recall estimated by re-running sampled searches exactly
+    prometheus::Family<prometheus::Gauge>& search_recall_ =
+        prometheus::BuildGauge()
+            .Name("search_recall")
+            .Help("recall@k of the recently sampled searches against their exact results")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& search_recall_samples_ = prometheus::BuildCounter()
+                                                                          .Name("search_recall_samples_total")
+                                                                          .Help("searches sampled to estimate recall")
+                                                                          .Register(*registry_);
+
+    // lock contention and queue depths, the lock figures are totals since the start
+    prometheus::Family<prometheus::Gauge>& lock_acquisitions_ = prometheus::BuildGauge()
+                                                                    .Name("lock_acquisitions_total")
+                                                                    .Help("acquisitions of the named locks")
+                                                                    .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& lock_contended_ = prometheus::BuildGauge()
+                                                                 .Name("lock_contended_total")
+                                                                 .Help("acquisitions of the named locks which waited")
+                                                                 .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& lock_wait_ = prometheus::BuildGauge()
+                                                            .Name("lock_wait_microseconds_total")
+                                                            .Help("time spent waiting for the named locks")
+                                                            .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& lock_hold_ = prometheus::BuildGauge()
+                                                            .Name("lock_hold_microseconds_total")
+                                                            .Help("time the named locks were held")
+                                                            .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& lock_max_wait_ = prometheus::BuildGauge()
+                                                                .Name("lock_max_wait_microseconds")
+                                                                .Help("longest wait for the named locks")
+                                                                .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& queue_depth_ = prometheus::BuildGauge()
+                                                              .Name("queue_depth")
+                                                              .Help("items waiting in the named queues")
+                                                              .Register(*registry_);
+
+    // progress of the running index builds per collection, the oldest stage age shows a stalled build
+    prometheus::Family<prometheus::Histogram>& index_build_vectors_per_second_ =
+        prometheus::BuildHistogram()
+            .Name("index_build_vectors_per_second")
+            .Help("histogram of the vectors indexed per second of the build stage")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& index_build_bytes_written_ = prometheus::BuildCounter()
+                                                                              .Name("index_build_bytes_written_total")
+                                                                              .Help("bytes of the index files built")
+                                                                              .Register(*registry_);
+    prometheus::Counter& index_build_bytes_written_counter_ = index_build_bytes_written_.Add({});
+    prometheus::Family<prometheus::Gauge>& index_build_segments_ = prometheus::BuildGauge()
+                                                                       .Name("index_build_segments")
+                                                                       .Help("segments queued or being indexed")
+                                                                       .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& index_build_rows_ = prometheus::BuildGauge()
+                                                                   .Name("index_build_rows")
+                                                                   .Help("rows of the segments being indexed")
+                                                                   .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& index_build_rows_indexed_ = prometheus::BuildGauge()
+                                                                           .Name("index_build_rows_indexed")
+                                                                           .Help("rows added to the new indexes")
+                                                                           .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& index_build_stage_age_ =
+        prometheus::BuildGauge()
+            .Name("index_build_oldest_stage_seconds")
+            .Help("time the longest running index build has spent in its current stage")
+            .Register(*registry_);
+    std::set<std::string> index_build_collections_;  // collections reported before, zeroed when done
+
+    // memory accounted per subsystem, cache.memory_limit shrinks the cpu cache when their total exceeds it
+    prometheus::Family<prometheus::Gauge>& memory_usage_ = prometheus::BuildGauge()
+                                                               .Name("memory_usage_bytes")
+                                                               .Help("memory held by each subsystem")
+                                                               .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& memory_limit_ = prometheus::BuildGauge()
+                                                               .Name("memory_limit_bytes")
+                                                               .Help("limit of the memory of all subsystems")
+                                                               .Register(*registry_);
+    prometheus::Gauge& memory_limit_gauge_ = memory_limit_.Add({});
+
+    prometheus::Family<prometheus::Gauge>& startup_stage_ = prometheus::BuildGauge()
+                                                                .Name("startup_stage_seconds")
+                                                                .Help("time each stage of the last startup took")
+                                                                .Register(*registry_);
+
     prometheus::Family<prometheus::Gauge>& octets_ =
         prometheus::BuildGauge().Name("octets_bytes_per_second").Help("octets bytes per second").Register(*registry_);
     prometheus::Gauge& inoctets_gauge_ = octets_.Add({{"type", "inoctets"}});
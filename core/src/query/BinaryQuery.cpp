@@ -12,6 +12,7 @@
 #include <memory>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -297,5 +298,93 @@ ValidateBinaryQuery(BinaryQueryPtr& binary_query) {
     return height > 1;
 }
 
+namespace {
+
+bool
+IsConjunction(const BinaryQueryPtr& binary_query) {
+    return binary_query != nullptr &&
+           (binary_query->relation == QueryRelation::AND || binary_query->relation == QueryRelation::R1);
+}
+
+void
+CollectConjuncts(const GeneralQueryPtr& general_query, std::vector<GeneralQueryPtr>& conjuncts) {
+    if (general_query == nullptr) {
+        return;
+    }
+    if (general_query->leaf == nullptr && IsConjunction(general_query->bin)) {
+        CollectConjuncts(general_query->bin->left_query, conjuncts);
+        CollectConjuncts(general_query->bin->right_query, conjuncts);
+        return;
+    }
+    conjuncts.push_back(general_query);
+}
+
+}  // namespace
+
+void
+FuseRangeQueries(BinaryQueryPtr& binary_query) {
+    if (binary_query == nullptr) {
+        return;
+    }
+    if (!IsConjunction(binary_query)) {
+        if (binary_query->left_query != nullptr && binary_query->left_query->leaf == nullptr) {
+            FuseRangeQueries(binary_query->left_query->bin);
+        }
+        if (binary_query->right_query != nullptr && binary_query->right_query->leaf == nullptr) {
+            FuseRangeQueries(binary_query->right_query->bin);
+        }
+        return;
+    }
+
+    std::vector<GeneralQueryPtr> conjuncts;
+    CollectConjuncts(binary_query->left_query, conjuncts);
+    CollectConjuncts(binary_query->right_query, conjuncts);
+
+    // the first range query of a field takes the compare expressions of the later ones
+    std::vector<GeneralQueryPtr> fused;
+    std::unordered_map<std::string, RangeQueryPtr> ranges;
+    for (auto& conjunct : conjuncts) {
+        if (conjunct->leaf == nullptr) {
+            FuseRangeQueries(conjunct->bin);
+        } else if (conjunct->leaf->range_query != nullptr) {
+            auto& range_query = conjunct->leaf->range_query;
+            auto iter = ranges.find(range_query->field_name);
+            if (iter != ranges.end()) {
+                auto& exprs = iter->second->compare_expr;
+                exprs.insert(exprs.end(), range_query->compare_expr.begin(), range_query->compare_expr.end());
+                continue;
+            }
+            // the boolean query still holds the leaf, it is copied before it grows
+            auto leaf = std::make_shared<LeafQuery>(*conjunct->leaf);
+            leaf->range_query = std::make_shared<RangeQuery>(*range_query);
+            conjunct = std::make_shared<GeneralQuery>();
+            conjunct->leaf = leaf;
+            ranges.insert(std::make_pair(leaf->range_query->field_name, leaf->range_query));
+        }
+        fused.push_back(conjunct);
+    }
+    if (fused.size() == conjuncts.size()) {
+        return;
+    }
+
+    // rebuild the chain from the conjuncts left, a single one hangs on the left alone
+    auto relation = binary_query->relation;
+    auto node = binary_query;
+    for (size_t i = 0; i < fused.size(); ++i) {
+        node->relation = relation;
+        node->left_query = fused[i];
+        node->right_query = nullptr;
+        if (i + 1 == fused.size()) {
+            break;
+        }
+        if (i + 2 == fused.size()) {
+            node->right_query = fused[i + 1];
+            break;
+        }
+        node->right_query = std::make_shared<GeneralQuery>();
+        node = node->right_query->bin;
+    }
+}
+
 }  // namespace query
 }  // namespace milvus
@@ -37,5 +37,9 @@ ValidateBooleanQuery(BooleanQueryPtr& boolean_query);
 bool
 ValidateBinaryQuery(BinaryQueryPtr& binary_query);
 
+// merge the range queries on the same field joined by AND into one, so the field index is looked up once
+void
+FuseRangeQueries(BinaryQueryPtr& binary_query);
+
 }  // namespace query
 }  // namespace milvus
@@ -21,14 +21,14 @@ namespace scheduler {
 constexpr uint64_t MAXINT = std::numeric_limits<uint32_t>::max();
 
 uint64_t
-ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const ResourceMgrPtr& res_mgr,
+ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const std::vector<ResourcePtr>& resources,
              std::vector<std::string>& path) {
-    uint64_t num_of_resources = res_mgr->GetAllResources().size();
+    uint64_t num_of_resources = resources.size();
     std::unordered_map<uint64_t, std::string> id_name_map;
     std::unordered_map<std::string, uint64_t> name_id_map;
     for (uint64_t i = 0; i < num_of_resources; ++i) {
-        id_name_map.insert(std::make_pair(i, res_mgr->GetAllResources().at(i)->name()));
-        name_id_map.insert(std::make_pair(res_mgr->GetAllResources().at(i)->name(), i));
+        id_name_map.insert(std::make_pair(i, resources.at(i)->name()));
+        name_id_map.insert(std::make_pair(resources.at(i)->name(), i));
     }
 
     std::vector<std::vector<uint64_t>> dis_matrix;
@@ -43,7 +43,7 @@ ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const ResourceMgrP
 
     std::vector<bool> vis(num_of_resources, false);
     std::vector<uint64_t> dis(num_of_resources, MAXINT);
-    for (auto& res : res_mgr->GetAllResources()) {
+    for (auto& res : resources) {
         auto cur_node = std::static_pointer_cast<Node>(res);
         auto cur_neighbours = cur_node->GetNeighbours();
 
@@ -95,5 +95,11 @@ ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const ResourceMgrP
     return dis[name_id_map.at(dest->name())];
 }
 
+uint64_t
+ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const ResourceMgrPtr& res_mgr,
+             std::vector<std::string>& path) {
+    return ShortestPath(src, dest, res_mgr->GetAllResources(), path);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -18,6 +18,10 @@
 namespace milvus {
 namespace scheduler {
 
+uint64_t
+ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const std::vector<ResourcePtr>& resources,
+             std::vector<std::string>& path);
+
 uint64_t
 ShortestPath(const ResourcePtr& src, const ResourcePtr& dest, const ResourceMgrPtr& res_mgr,
              std::vector<std::string>& path);
@@ -29,6 +29,7 @@ namespace milvus {
 namespace scheduler {
 
 using SegmentSchemaPtr = engine::meta::SegmentSchemaPtr;
+using SegmentDescPtr = engine::meta::SegmentDescPtr;
 using SegmentSchema = engine::meta::SegmentSchema;
 
 using ExecutionEnginePtr = engine::ExecutionEnginePtr;
@@ -39,5 +40,8 @@ using DataType = engine::meta::hybrid::DataType;
 
 constexpr uint64_t TASK_TABLE_MAX_COUNT = 1ULL << 16ULL;
 
+// max loaded tasks waiting for execution in a task table, the loader stops loading ahead beyond it
+constexpr uint64_t DEFAULT_LOAD_DEPTH = 3;
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -0,0 +1,124 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "scheduler/ExecutorPool.h"
+#include "utils/Log.h"
+
+#include <utility>
+
+namespace milvus {
+namespace scheduler {
+
+ExecutorPool::ExecutorPool(uint64_t num_workers) {
+    for (uint64_t i = 0; i < num_workers; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+}
+
+ExecutorPool::~ExecutorPool() {
+    Stop();
+}
+
+void
+ExecutorPool::Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    for (uint64_t i = 0; i < workers_.size(); ++i) {
+        threads_.emplace_back(&ExecutorPool::worker_function, this, i);
+    }
+}
+
+void
+ExecutorPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+}
+
+uint64_t
+ExecutorPool::BindWorker() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.empty() ? 0 : next_worker_++ % workers_.size();
+}
+
+void
+ExecutorPool::Submit(uint64_t worker, Job job) {
+    {
+        std::lock_guard<std::mutex> lock(workers_[worker]->mutex_);
+        workers_[worker]->jobs_.emplace_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++pending_;
+    }
+    cv_.notify_one();
+}
+
+bool
+ExecutorPool::pop_local(uint64_t index, Job& job) {
+    auto& worker = workers_[index];
+    std::lock_guard<std::mutex> lock(worker->mutex_);
+    if (worker->jobs_.empty()) {
+        return false;
+    }
+    job = std::move(worker->jobs_.front());
+    worker->jobs_.pop_front();
+    return true;
+}
+
+bool
+ExecutorPool::steal(uint64_t index, Job& job) {
+    for (uint64_t i = 1; i < workers_.size(); ++i) {
+        auto& victim = workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim->mutex_);
+        if (!victim->jobs_.empty()) {
+            job = std::move(victim->jobs_.back());
+            victim->jobs_.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ExecutorPool::worker_function(uint64_t index) {
+    SetThreadName("taskexec_pool");
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return pending_ > 0 || !running_; });
+            if (pending_ == 0) {
+                return;
+            }
+            --pending_;
+        }
+
+        // a job was counted after it was queued, so one is waiting in some deque for this worker
+        Job job;
+        while (!pop_local(index, job) && !steal(index, job)) {
+            std::this_thread::yield();
+        }
+        job();
+    }
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,94 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Runs the tasks of cpu resources on a fixed set of workers. Every worker has a local deque which the resources
+ * bound to it feed, a worker with nothing in its own deque steals from the back of the others.
+ */
+class ExecutorPool {
+ public:
+    using Job = std::function<void()>;
+
+    explicit ExecutorPool(uint64_t num_workers);
+
+    ~ExecutorPool();
+
+    /*
+     * Start workers;
+     */
+    void
+    Start();
+
+    /*
+     * Stop workers after the submitted jobs are done, blocking util threads exited;
+     */
+    void
+    Stop();
+
+    /*
+     * Worker whose deque a new resource feeds, round robin;
+     */
+    uint64_t
+    BindWorker();
+
+    void
+    Submit(uint64_t worker, Job job);
+
+    uint64_t
+    Size() const {
+        return workers_.size();
+    }
+
+ private:
+    void
+    worker_function(uint64_t index);
+
+    bool
+    pop_local(uint64_t index, Job& job);
+
+    bool
+    steal(uint64_t index, Job& job);
+
+ private:
+    struct Worker {
+        std::mutex mutex_;
+        std::deque<Job> jobs_;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    uint64_t next_worker_ = 0;
+
+    // jobs submitted but not taken by a worker yet
+    uint64_t pending_ = 0;
+    bool running_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+using ExecutorPoolPtr = std::shared_ptr<ExecutorPool>;
+
+}  // namespace scheduler
+}  // namespace milvus
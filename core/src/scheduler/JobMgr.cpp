@@ -14,7 +14,6 @@
 #include <utility>
 
 #include "db/Utils.h"
-#include "scheduler/Algorithm.h"
 #include "scheduler/CPUBuilder.h"
 #include "scheduler/JobMgr.h"
 #include "scheduler/SchedInst.h"
@@ -27,6 +26,7 @@ namespace milvus {
 namespace scheduler {
 
 JobMgr::JobMgr(ResourceMgrPtr res_mgr) : res_mgr_(std::move(res_mgr)) {
+    queue_.SetName("job_queue");
 }
 
 void
@@ -116,7 +116,7 @@ JobMgr::calculate_path(const ResourceMgrPtr& res_mgr, const TaskPtr& task) {
     auto spec_label = std::static_pointer_cast<SpecResLabel>(task->label());
     auto src = res_mgr->GetDiskResources()[0];
     auto dest = spec_label->resource();
-    ShortestPath(src.lock(), dest.lock(), res_mgr, path);
+    res_mgr->GetRoute(src.lock(), dest.lock(), path);
     task->path() = Path(path, path.size() - 1);
 }
 
@@ -0,0 +1,106 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#pragma once
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Unbounded multi-producer single-consumer queue. The producers push on a lock-free stack with a CAS, the consumer
+ * takes the whole stack with an exchange and reverses it to the push order, so a batch is drained with one atomic
+ * operation however many events it holds. The mutex and condition variable are only taken to park the consumer on
+ * an empty queue and by the producer waking it up.
+ */
+template <typename T>
+class MPSCQueue {
+ public:
+    MPSCQueue() = default;
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue&
+    operator=(const MPSCQueue&) = delete;
+
+    ~MPSCQueue() {
+        auto node = head_.exchange(nullptr);
+        while (node != nullptr) {
+            auto next = node->next_;
+            delete node;
+            node = next;
+        }
+    }
+
+    void
+    Push(T value) {
+        size_.fetch_add(1, std::memory_order_relaxed);
+        auto node = new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(node->next_, node)) {
+        }
+
+        // seq_cst on both sides: either the consumer sees the node before parking, or the producer sees it parked
+        if (waiting_.load()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    // appends the values pushed so far to values in push order, blocks while the queue is empty
+    void
+    PopAll(std::vector<T>& values) {
+        auto node = head_.exchange(nullptr);
+        if (node == nullptr) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiting_.store(true);
+            cv_.wait(lock, [&] { return (node = head_.exchange(nullptr)) != nullptr; });
+            waiting_.store(false);
+        }
+
+        auto begin = values.size();
+        uint64_t count = 0;
+        while (node != nullptr) {
+            values.emplace_back(std::move(node->value_));
+            auto next = node->next_;
+            delete node;
+            node = next;
+            ++count;
+        }
+        std::reverse(values.begin() + begin, values.end());
+        size_.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    uint64_t
+    Size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Node {
+        T value_;
+        Node* next_;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+    std::atomic<uint64_t> size_{0};
+
+    std::atomic<bool> waiting_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
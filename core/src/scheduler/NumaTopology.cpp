@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/NumaTopology.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+
+namespace milvus {
+namespace scheduler {
+
+NumaTopology::NumaTopology(const std::string& root) {
+    // nodes are numbered from 0 without holes on the hosts we run on, stop at the first missing one
+    for (int64_t node = 0;; ++node) {
+        std::ifstream file(root + "/node" + std::to_string(node) + "/cpulist");
+        std::string cpu_list;
+        if (!file.is_open() || !std::getline(file, cpu_list)) {
+            break;
+        }
+
+        auto cpus = ParseCpuList(cpu_list);
+        if (cpus.empty()) {
+            LOG_SERVER_WARNING_ << "Invalid cpu list of numa node " << node << ": " << cpu_list;
+            node_cpus_.clear();
+            break;
+        }
+        node_cpus_.emplace_back(std::move(cpus));
+    }
+    LOG_SERVER_DEBUG_ << "Found " << NodeNum() << " numa nodes";
+}
+
+Status
+NumaTopology::BindThread(int64_t node) const {
+    if (node < 0 || node >= static_cast<int64_t>(node_cpus_.size())) {
+        return Status(SERVER_INVALID_ARGUMENT, "Unknown numa node " + std::to_string(node));
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : node_cpus_[node]) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Failed to bind thread to numa node " + std::to_string(node));
+    }
+    return Status::OK();
+}
+
+std::vector<int64_t>
+NumaTopology::ParseCpuList(const std::string& cpu_list) {
+    std::vector<int64_t> cpus;
+    std::vector<std::string> ranges;
+    StringHelpFunctions::SplitStringByDelimeter(cpu_list, ",", ranges);
+    try {
+        for (auto& range : ranges) {
+            std::vector<std::string> bounds;
+            StringHelpFunctions::SplitStringByDelimeter(range, "-", bounds);
+            if (bounds.empty() || bounds.size() > 2) {
+                return {};
+            }
+            int64_t first = std::stoll(bounds[0]);
+            int64_t last = bounds.size() == 2 ? std::stoll(bounds[1]) : first;
+            if (first < 0 || last < first) {
+                return {};
+            }
+            for (auto cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+    } catch (std::exception& ex) {
+        return {};
+    }
+    return cpus;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Status.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * The numa nodes of the host and their cpus, read from sysfs. A segment file is owned by one node, picked from its
+ * id, and is loaded and searched by threads pinned to the cpus of that node, so the pages of the file are first
+ * touched, and stay, on the memory of the node searching it. A host without numa information has a single node.
+ */
+class NumaTopology {
+ public:
+    static NumaTopology&
+    GetInstance() {
+        static NumaTopology instance("/sys/devices/system/node");
+        return instance;
+    }
+
+    // root is the sysfs node directory, holding a nodeN/cpulist for every node
+    explicit NumaTopology(const std::string& root);
+
+    int64_t
+    NodeNum() const {
+        return node_cpus_.empty() ? 1 : node_cpus_.size();
+    }
+
+    int64_t
+    NodeOfFile(int64_t file_id) const {
+        return file_id < 0 ? 0 : file_id % NodeNum();
+    }
+
+    // pin the calling thread to the cpus of node, the threads it starts afterwards, openmp ones too, inherit it
+    Status
+    BindThread(int64_t node) const;
+
+    // cpus of a cpulist like "0-15,32-47", empty if it is malformed
+    static std::vector<int64_t>
+    ParseCpuList(const std::string& cpu_list);
+
+ private:
+    std::vector<std::vector<int64_t>> node_cpus_;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
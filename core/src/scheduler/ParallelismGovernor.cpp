@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/ParallelismGovernor.h"
+
+#include <omp.h>
+#include <algorithm>
+
+namespace milvus {
+namespace scheduler {
+
+ParallelismGovernor::ParallelismGovernor(int64_t budget) : budget_(std::max<int64_t>(budget, 1)) {
+}
+
+void
+ParallelismGovernor::SetTaskMaxThreads(int64_t max_threads) {
+    task_max_threads_ = std::max<int64_t>(max_threads, 0);
+}
+
+int64_t
+ParallelismGovernor::Acquire(int64_t nq) {
+    int64_t active_tasks = ++active_tasks_;
+    int64_t threads = std::max<int64_t>(budget_ / active_tasks, 1);
+    if (nq > 0) {
+        threads = std::min(threads, nq);
+    }
+    int64_t max_threads = task_max_threads_.load();
+    if (max_threads > 0) {
+        threads = std::min(threads, max_threads);
+    }
+    return threads;
+}
+
+void
+ParallelismGovernor::Release() {
+    --active_tasks_;
+}
+
+ParallelismGuard::ParallelismGuard(int64_t nq, ParallelismGovernor& governor)
+    : governor_(governor), threads_(governor.Acquire(nq)), previous_threads_(omp_get_max_threads()) {
+    omp_set_num_threads(static_cast<int>(threads_));
+}
+
+ParallelismGuard::~ParallelismGuard() {
+    omp_set_num_threads(previous_threads_);
+    governor_.Release();
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,85 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Shares the cores among the search tasks running at once. Every executor thread would otherwise start its openmp
+ * regions with as many threads as there are cores, so a few concurrent searches put several times more threads on
+ * the machine than it has cores. A task takes the cores divided by the tasks running, at most its nq, since the
+ * knowhere loops split the queries, and at most the configured openmp thread number. The share is taken when the
+ * task starts, a task started alone keeps its threads until it ends even if others start meanwhile.
+ */
+class ParallelismGovernor {
+ public:
+    static ParallelismGovernor&
+    GetInstance() {
+        static ParallelismGovernor instance(std::thread::hardware_concurrency());
+        return instance;
+    }
+
+    // budget is the number of threads all the tasks share, the cores of the host
+    explicit ParallelismGovernor(int64_t budget);
+
+    // the most threads a task gets, 0 for no limit but the budget
+    void
+    SetTaskMaxThreads(int64_t max_threads);
+
+    // register a running task and return its threads, nq of 0 is unknown
+    int64_t
+    Acquire(int64_t nq);
+
+    void
+    Release();
+
+    int64_t
+    ActiveTasks() const {
+        return active_tasks_.load();
+    }
+
+ private:
+    int64_t budget_;
+    std::atomic<int64_t> task_max_threads_{0};
+    std::atomic<int64_t> active_tasks_{0};
+};
+
+// runs the openmp regions of the calling thread with the share of a task for its lifetime
+class ParallelismGuard {
+ public:
+    explicit ParallelismGuard(int64_t nq, ParallelismGovernor& governor = ParallelismGovernor::GetInstance());
+
+    ParallelismGuard(const ParallelismGuard&) = delete;
+
+    ParallelismGuard&
+    operator=(const ParallelismGuard&) = delete;
+
+    ~ParallelismGuard();
+
+    int64_t
+    threads() const {
+        return threads_;
+    }
+
+ private:
+    ParallelismGovernor& governor_;
+    int64_t threads_;
+    int previous_threads_;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -11,6 +11,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/ResourceMgr.h"
+#include "scheduler/Algorithm.h"
+#include "scheduler/NumaTopology.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -25,6 +27,12 @@ ResourceMgr::Start() {
     }
 
     std::lock_guard<std::mutex> lck(resources_mutex_);
+    for (auto& disk : disk_resources_) {
+        for (auto& compute : GetComputeResources()) {
+            std::vector<std::string> path;
+            GetRoute(disk.lock(), compute, path);
+        }
+    }
     for (auto& resource : resources_) {
         resource->Start();
     }
@@ -34,12 +42,8 @@ ResourceMgr::Start() {
 
 void
 ResourceMgr::Stop() {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        running_ = false;
-        queue_.push(nullptr);
-        event_cv_.notify_one();
-    }
+    running_ = false;
+    queue_.Push(nullptr);
     worker_thread_.join();
 
     std::lock_guard<std::mutex> lck(resources_mutex_);
@@ -77,6 +81,8 @@ ResourceMgr::Add(ResourcePtr&& resource) {
     }
     resources_.emplace_back(resource);
 
+    std::lock_guard<std::mutex> routes_lock(routes_mutex_);
+    routes_.clear();
     return ret;
 }
 
@@ -88,6 +94,8 @@ ResourceMgr::Connect(const std::string& name1, const std::string& name2, Connect
         res1->AddNeighbour(std::static_pointer_cast<Node>(res2), connection);
         // TODO(wxyu): enable when task balance supported
         //        res2->AddNeighbour(std::static_pointer_cast<Node>(res1), connection);
+        std::lock_guard<std::mutex> routes_lock(routes_mutex_);
+        routes_.clear();
         return true;
     }
     return false;
@@ -104,6 +112,27 @@ ResourceMgr::Clear() {
     cpu_resources_.clear();
     gpu_resources_.clear();
     resources_.clear();
+
+    std::lock_guard<std::mutex> routes_lock(routes_mutex_);
+    routes_.clear();
+}
+
+void
+ResourceMgr::GetRoute(const ResourcePtr& src, const ResourcePtr& dest, std::vector<std::string>& path) {
+    auto key = std::make_pair(src->name(), dest->name());
+    {
+        std::lock_guard<std::mutex> lock(routes_mutex_);
+        auto iter = routes_.find(key);
+        if (iter != routes_.end()) {
+            path = iter->second;
+            return;
+        }
+    }
+
+    path.clear();
+    ShortestPath(src, dest, resources_, path);
+    std::lock_guard<std::mutex> lock(routes_mutex_);
+    routes_.emplace(key, path);
 }
 
 std::vector<ResourcePtr>
@@ -137,6 +166,17 @@ ResourceMgr::GetResource(const std::string& name) {
     return nullptr;
 }
 
+ResourcePtr
+ResourceMgr::GetSearchCpuResource(int64_t file_id) {
+    if (cpu_resources_.size() > 1) {
+        auto res = GetResource(ResourceType::CPU, NumaTopology::GetInstance().NodeOfFile(file_id));
+        if (res != nullptr) {
+            return res;
+        }
+    }
+    return GetResource("cpu");
+}
+
 uint64_t
 ResourceMgr::GetNumOfResource() const {
     return resources_.size();
@@ -199,7 +239,7 @@ ResourceMgr::check_resource_valid() {
         if (GetDiskResources().size() != 1) {
             return false;
         }
-        if (GetCpuResources().size() != 1) {
+        if (GetCpuResources().empty()) {
             return false;
         }
     }
@@ -228,29 +268,23 @@ ResourceMgr::check_resource_valid() {
 
 void
 ResourceMgr::post_event(const EventPtr& event) {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        queue_.emplace(event);
-    }
-    event_cv_.notify_one();
+    queue_.Push(event);
 }
 
 void
 ResourceMgr::event_process() {
     SetThreadName("resevt_thread");
+    std::vector<EventPtr> events;
     while (running_) {
-        std::unique_lock<std::mutex> lock(event_mutex_);
-        event_cv_.wait(lock, [this] { return !queue_.empty(); });
-
-        auto event = queue_.front();
-        queue_.pop();
-        lock.unlock();
-        if (event == nullptr) {
-            break;
-        }
-
-        if (subscriber_) {
-            subscriber_(event);
+        events.clear();
+        queue_.PopAll(events);
+        for (auto& event : events) {
+            if (event == nullptr) {
+                return;
+            }
+            if (subscriber_) {
+                subscriber_(event);
+            }
         }
     }
 }
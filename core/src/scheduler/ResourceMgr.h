@@ -11,14 +11,15 @@
 
 #pragma once
 
-#include <condition_variable>
+#include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "MPSCQueue.h"
 #include "interface/interfaces.h"
 #include "resource/Resource.h"
 #include "utils/Log.h"
@@ -83,6 +84,10 @@ class ResourceMgr : public interface::dumpable {
     ResourcePtr
     GetResource(const std::string& name);
 
+    // cpu resource of the numa node owning the file, "cpu" if there is a single cpu resource
+    ResourcePtr
+    GetSearchCpuResource(int64_t file_id);
+
     uint64_t
     GetNumOfResource() const;
 
@@ -92,6 +97,12 @@ class ResourceMgr : public interface::dumpable {
     uint64_t
     GetNumGpuResource() const;
 
+    // the names of the resources from dest back to src on the cheapest route, as ShortestPath gives them. The routes
+    // from the disk resources to the compute resources are computed at Start, the others on their first use, all of
+    // them are dropped when a resource or a connection is added.
+    void
+    GetRoute(const ResourcePtr& src, const ResourcePtr& dest, std::vector<std::string>& path);
+
  public:
     // TODO(wxyu): add stats interface(low)
 
@@ -114,7 +125,7 @@ class ResourceMgr : public interface::dumpable {
     event_process();
 
  private:
-    bool running_ = false;
+    std::atomic_bool running_{false};
 
     std::vector<ResourceWPtr> disk_resources_;
     std::vector<ResourceWPtr> cpu_resources_;
@@ -122,10 +133,11 @@ class ResourceMgr : public interface::dumpable {
     std::vector<ResourcePtr> resources_;
     mutable std::mutex resources_mutex_;
 
-    std::queue<EventPtr> queue_;
+    std::map<std::pair<std::string, std::string>, std::vector<std::string>> routes_;
+    std::mutex routes_mutex_;
+
+    MPSCQueue<EventPtr> queue_;
     std::function<void(EventPtr)> subscriber_ = nullptr;
-    std::mutex event_mutex_;
-    std::condition_variable event_cv_;
 
     std::thread worker_thread_;
 };
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/SchedInst.h"
+#include "NumaTopology.h"
 #include "ResourceFactory.h"
 #include "Utils.h"
 #include "config/Config.h"
@@ -41,15 +42,32 @@ std::mutex BuildMgrInst::mutex_;
 CPUBuilderPtr CPUBuilderInst::instance = nullptr;
 std::mutex CPUBuilderInst::mutex_;
 
+ExecutorPoolPtr ExecutorPoolInst::instance = nullptr;
+std::mutex ExecutorPoolInst::mutex_;
+
 void
 load_simple_config() {
     // create and connect
     ResMgrInst::GetInstance()->Add(ResourceFactory::Create("disk", "DISK", 0, false));
 
     auto io = Connection("io", 500);
-    ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
+    auto cpu = ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
     ResMgrInst::GetInstance()->Connect("disk", "cpu", io);
 
+    // one cpu resource per numa node, "cpu" is the one of node 0 and the only one the gpus connect to
+    bool numa_aware = false;
+    server::Config::GetInstance().GetEngineConfigNumaAware(numa_aware);
+    auto& numa = NumaTopology::GetInstance();
+    if (numa_aware && numa.NodeNum() > 1) {
+        cpu.lock()->BindNumaNode(0);
+        for (int64_t node = 1; node < numa.NodeNum(); ++node) {
+            auto name = "cpu" + std::to_string(node);
+            auto res = ResMgrInst::GetInstance()->Add(ResourceFactory::Create(name, "CPU", node));
+            res.lock()->BindNumaNode(node);
+            ResMgrInst::GetInstance()->Connect("disk", name, io);
+        }
+    }
+
 // get resources
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = false;
@@ -94,6 +112,7 @@ void
 StartSchedulerService() {
     load_simple_config();
     OptimizerInst::GetInstance()->Init();
+    ExecutorPoolInst::GetInstance()->Start();
     ResMgrInst::GetInstance()->Start();
     SchedInst::GetInstance()->Start();
     JobMgrInst::GetInstance()->Start();
@@ -106,6 +125,7 @@ StopSchedulerService() {
     JobMgrInst::GetInstance()->Stop();
     SchedInst::GetInstance()->Stop();
     ResMgrInst::GetInstance()->Stop();
+    ExecutorPoolInst::GetInstance()->Stop();
 }
 
 }  // namespace scheduler
@@ -11,19 +11,24 @@
 
 #pragma once
 
+#include "config/Config.h"
+
 #include "BuildMgr.h"
 #include "CPUBuilder.h"
+#include "ExecutorPool.h"
 #include "JobMgr.h"
 #include "ResourceMgr.h"
 #include "Scheduler.h"
 #include "Utils.h"
 #include "selector/BuildIndexPass.h"
+#include "selector/CostPlacementPass.h"
 #include "selector/FaissFlatPass.h"
 #include "selector/FaissIVFFlatPass.h"
 #include "selector/FaissIVFPQPass.h"
 #include "selector/FaissIVFSQ8HPass.h"
 #include "selector/FaissIVFSQ8Pass.h"
 #include "selector/FallbackPass.h"
+#include "selector/FreshSegmentPass.h"
 #include "selector/Optimizer.h"
 
 #include <memory>
@@ -121,6 +126,16 @@ class OptimizerInst {
                     LOG_SERVER_DEBUG_ << LogOut("[%s][%d] %s", "search", 0, build_msg.c_str());
 
                     pass_list.push_back(std::make_shared<BuildIndexPass>());
+                    bool keep_fresh_segments = false;
+                    config.GetGpuResourceConfigKeepFreshSegments(keep_fresh_segments);
+                    if (keep_fresh_segments) {
+                        pass_list.push_back(std::make_shared<FreshSegmentPass>());
+                    }
+                    bool cost_placement = false;
+                    config.GetGpuResourceConfigCostPlacement(cost_placement);
+                    if (cost_placement) {
+                        pass_list.push_back(std::make_shared<CostPlacementPass>());
+                    }
                     pass_list.push_back(std::make_shared<FaissFlatPass>());
                     pass_list.push_back(std::make_shared<FaissIVFFlatPass>());
                     pass_list.push_back(std::make_shared<FaissIVFSQ8Pass>());
@@ -158,6 +173,27 @@ class BuildMgrInst {
     static std::mutex mutex_;
 };
 
+class ExecutorPoolInst {
+ public:
+    // the pool has no worker if engine_config.executor_threads is 0, resources then execute on their own thread
+    static ExecutorPoolPtr
+    GetInstance() {
+        if (instance == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (instance == nullptr) {
+                int64_t executor_threads = 0;
+                server::Config::GetInstance().GetEngineConfigExecutorThreads(executor_threads);
+                instance = std::make_shared<ExecutorPool>(executor_threads > 0 ? executor_threads : 0);
+            }
+        }
+        return instance;
+    }
+
+ private:
+    static ExecutorPoolPtr instance;
+    static std::mutex mutex_;
+};
+
 class CPUBuilderInst {
  public:
     static CPUBuilderPtr
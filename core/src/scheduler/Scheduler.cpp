@@ -16,6 +16,7 @@
 #include "event/LoadCompletedEvent.h"
 
 #include <utility>
+#include <vector>
 
 namespace milvus {
 namespace scheduler {
@@ -44,29 +45,21 @@ Scheduler::Start() {
 
 void
 Scheduler::Stop() {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        running_ = false;
-        event_queue_.push(nullptr);
-        event_cv_.notify_one();
-    }
+    running_ = false;
+    event_queue_.Push(nullptr);
     worker_thread_.join();
 }
 
 void
 Scheduler::PostEvent(const EventPtr& event) {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        event_queue_.push(event);
-    }
-    event_cv_.notify_one();
+    event_queue_.Push(event);
 }
 
 json
 Scheduler::Dump() const {
     json ret{
-        {"running", running_},
-        {"event_queue_length", event_queue_.size()},
+        {"running", running_.load()},
+        {"event_queue_length", event_queue_.Size()},
     };
     return ret;
 }
@@ -80,16 +73,17 @@ Scheduler::process(const EventPtr& event) {
 void
 Scheduler::worker_function() {
     SetThreadName("schedevt_thread");
+    // the events posted meanwhile are drained at once, in the order they were posted
+    std::vector<EventPtr> events;
     while (running_) {
-        std::unique_lock<std::mutex> lock(event_mutex_);
-        event_cv_.wait(lock, [this] { return !event_queue_.empty(); });
-        auto event = event_queue_.front();
-        event_queue_.pop();
-        if (event == nullptr) {
-            break;
+        events.clear();
+        event_queue_.PopAll(events);
+        for (auto& event : events) {
+            if (event == nullptr) {
+                return;
+            }
+            process(event);
         }
-
-        process(event);
     }
 }
 
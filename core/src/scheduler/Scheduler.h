@@ -11,13 +11,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
 
+#include "MPSCQueue.h"
 #include "ResourceMgr.h"
 #include "interface/interfaces.h"
 #include "resource/Resource.h"
@@ -68,15 +68,13 @@ class Scheduler : public interface::dumpable {
     worker_function();
 
  private:
-    bool running_;
+    std::atomic_bool running_;
 
     std::unordered_map<uint64_t, std::function<void(EventPtr)>> event_register_;
 
     ResourceMgrPtr res_mgr_;
-    std::queue<EventPtr> event_queue_;
+    MPSCQueue<EventPtr> event_queue_;
     std::thread worker_thread_;
-    std::mutex event_mutex_;
-    std::condition_variable event_cv_;
 };
 
 using SchedulerPtr = std::shared_ptr<Scheduler>;
@@ -42,6 +42,7 @@ TaskCreator::Create(const SearchJobPtr& job) {
     for (auto& index_file : job->index_files()) {
         auto task = std::make_shared<XSearchTask>(job->GetContext(), index_file.second, nullptr);
         task->job_ = job;
+        task->SetSchedule(job->priority(), job->deadline());
         tasks.emplace_back(task);
     }
 
@@ -54,6 +55,7 @@ TaskCreator::Create(const DeleteJobPtr& job) {
     auto label = std::make_shared<BroadcastLabel>();
     auto task = std::make_shared<XDeleteTask>(job, label);
     task->job_ = job;
+    task->SetSchedule(job->priority(), job->deadline());
     tasks.emplace_back(task);
 
     return tasks;
@@ -65,6 +67,7 @@ TaskCreator::Create(const BuildIndexJobPtr& job) {
     for (auto& to_index_file : job->to_index_files()) {
         auto task = std::make_shared<XBuildIndexTask>(to_index_file.second, nullptr);
         task->job_ = job;
+        task->SetSchedule(job->priority(), job->deadline());
         tasks.emplace_back(task);
     }
     return tasks;
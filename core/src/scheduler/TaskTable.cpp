@@ -16,6 +16,7 @@
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
+#include <algorithm>
 #include <ctime>
 #include <sstream>
 #include <vector>
@@ -147,7 +148,7 @@ TaskTableItem::Dump() const {
 }
 
 std::vector<uint64_t>
-TaskTable::PickToLoad(uint64_t limit) {
+TaskTable::PickToLoad(uint64_t limit, uint64_t depth) {
 #if 1
     // TimeRecorder rc("");
     std::vector<uint64_t> indexes;
@@ -165,7 +166,7 @@ TaskTable::PickToLoad(uint64_t limit) {
         } else if (table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
             ++loaded_count;
-            if (loaded_count > 2)
+            if (loaded_count >= depth)
                 return std::vector<uint64_t>();
         } else if (table_[index]->state == TaskTableItemState::START) {
             auto task = table_[index]->task;
@@ -237,7 +238,7 @@ TaskTable::PickToExecute(uint64_t limit) {
     std::vector<uint64_t> indexes;
     bool cross = false;
     uint64_t available_begin = table_.front() + 1;
-    for (uint64_t i = 0, pick_count = 0; i < table_.size() && pick_count < limit; ++i) {
+    for (uint64_t i = 0; i < table_.size(); ++i) {
         uint64_t index = available_begin + i;
         if (not table_[index]) {
             break;
@@ -251,9 +252,21 @@ TaskTable::PickToExecute(uint64_t limit) {
         } else if (table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
             indexes.push_back(index);
-            ++pick_count;
         }
     }
+
+    // higher priority class first, then earliest deadline, then first come
+    std::stable_sort(indexes.begin(), indexes.end(), [&](uint64_t a, uint64_t b) {
+        auto& task_a = table_[a]->task;
+        auto& task_b = table_[b]->task;
+        if (task_a->priority() != task_b->priority()) {
+            return task_a->priority() < task_b->priority();
+        }
+        return task_a->deadline() < task_b->deadline();
+    });
+    if (indexes.size() > limit) {
+        indexes.resize(limit);
+    }
     // rc.ElapseFromBegin("PickToExecute ");
     return indexes;
 }
@@ -23,6 +23,7 @@
 #include "event/Event.h"
 #include "interface/interfaces.h"
 #include "task/SearchTask.h"
+#include "utils/ContentionStats.h"
 
 namespace milvus {
 namespace scheduler {
@@ -113,14 +114,23 @@ class TaskTable : public interface::dumpable {
         subscriber_ = std::move(subscriber);
     }
 
+    // report the tasks waiting for execution to ContentionStats
+    inline void
+    SetName(const std::string& name) {
+        depth_probe_.Set("task_table." + name, [this] { return static_cast<int64_t>(TaskToExecute()); });
+    }
+
     void
     Put(TaskPtr task, TaskTableItemPtr from = nullptr);
 
     size_t
     TaskToExecute();
 
+    /*
+     * Pick at most limit tasks to load, nothing if depth tasks are already loaded and waiting for execution;
+     */
     std::vector<uint64_t>
-    PickToLoad(uint64_t limit);
+    PickToLoad(uint64_t limit, uint64_t depth = DEFAULT_LOAD_DEPTH);
 
     std::vector<uint64_t>
     PickToExecute(uint64_t limit);
@@ -219,6 +229,8 @@ class TaskTable : public interface::dumpable {
     // pick from (last_finish_ + 1)
     // init with -1, pick from (last_finish_ + 1) = 0
     uint64_t last_finish_ = -1;
+
+    QueueDepthProbe depth_probe_;
 };
 
 }  // namespace scheduler
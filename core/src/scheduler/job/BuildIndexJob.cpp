@@ -13,6 +13,7 @@
 
 #include <utility>
 
+#include "db/IndexBuildTracker.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -24,6 +25,13 @@ BuildIndexJob::BuildIndexJob(engine::meta::MetaPtr meta_ptr, engine::DBOptions o
     AddCacheInsertDataListener();
 }
 
+BuildIndexJob::~BuildIndexJob() {
+    // the files of an abandoned job are not being built anymore
+    for (auto& pair : to_index_files_) {
+        engine::IndexBuildTracker::GetInstance().Finished(pair.first);
+    }
+}
+
 bool
 BuildIndexJob::AddToIndexFiles(const engine::meta::SegmentSchemaPtr& to_index_file) {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -35,6 +43,7 @@ BuildIndexJob::AddToIndexFiles(const engine::meta::SegmentSchemaPtr& to_index_fi
                       << ", location: " << to_index_file->location_;
 
     to_index_files_[to_index_file->id_] = to_index_file;
+    engine::IndexBuildTracker::GetInstance().Queued(*to_index_file);
     return true;
 }
 
@@ -49,6 +58,7 @@ void
 BuildIndexJob::BuildIndexDone(size_t to_index_id) {
     std::unique_lock<std::mutex> lock(mutex_);
     to_index_files_.erase(to_index_id);
+    engine::IndexBuildTracker::GetInstance().Finished(to_index_id);
     cv_.notify_all();
     LOG_SERVER_DEBUG_ << "BuildIndexJob " << id() << " finish index file: " << to_index_id;
 }
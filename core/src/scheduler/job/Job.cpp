@@ -22,6 +22,19 @@ uint64_t unique_job_id = 0;
 Job::Job(JobType type) : type_(type) {
     std::lock_guard<std::mutex> lock(unique_job_mutex);
     id_ = unique_job_id++;
+
+    // searches wait on the client side, building index is background work
+    switch (type) {
+        case JobType::SEARCH:
+            priority_ = JobPriority::HIGH;
+            break;
+        case JobType::BUILD:
+            priority_ = JobPriority::LOW;
+            break;
+        default:
+            priority_ = JobPriority::NORMAL;
+            break;
+    }
 }
 
 json
@@ -29,6 +42,7 @@ Job::Dump() const {
     json ret{
         {"id", id_},
         {"type", type_},
+        {"priority", priority_},
     };
     return ret;
 }
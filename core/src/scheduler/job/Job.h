@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <list>
@@ -35,7 +36,15 @@ enum class JobType {
     BUILD,
 };
 
+// the tasks of a higher priority class are executed first, the tasks of one class by earliest deadline
+enum class JobPriority {
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2,
+};
+
 using JobId = std::uint64_t;
+using JobDeadline = std::chrono::steady_clock::time_point;
 
 class Job : public interface::dumpable {
  public:
@@ -49,6 +58,27 @@ class Job : public interface::dumpable {
         return type_;
     }
 
+    inline JobPriority
+    priority() const {
+        return priority_;
+    }
+
+    inline void
+    SetPriority(JobPriority priority) {
+        priority_ = priority;
+    }
+
+    // time_point::max() if nobody waits for the job with a deadline
+    inline const JobDeadline&
+    deadline() const {
+        return deadline_;
+    }
+
+    inline void
+    SetDeadline(const JobDeadline& deadline) {
+        deadline_ = deadline;
+    }
+
     json
     Dump() const override;
 
@@ -58,6 +88,8 @@ class Job : public interface::dumpable {
  private:
     JobId id_ = 0;
     JobType type_;
+    JobPriority priority_ = JobPriority::NORMAL;
+    JobDeadline deadline_ = JobDeadline::max();
 };
 
 using JobPtr = std::shared_ptr<Job>;
@@ -11,14 +11,188 @@
 
 #include "scheduler/job/SearchJob.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <limits>
+#include <utility>
+
+#include "config/Config.h"
+#include "db/Utils.h"
+#include "metrics/Metrics.h"
+#include "segment/SegmentReader.h"
 #include "utils/Log.h"
+#include "utils/TimeRecorder.h"
 
 namespace milvus {
 namespace scheduler {
 
+namespace {
+
+// fewer queries are not worth a thread of their own
+constexpr size_t REDUCE_MIN_NQ_PER_THREAD = 8;
+
+// order of the distances the top k bounds were taken from, index files disagreeing on it disable the bounds
+constexpr int BOUNDS_ORDER_NONE = 0;
+constexpr int BOUNDS_ORDER_ASCENDING = 1;
+constexpr int BOUNDS_ORDER_DESCENDING = 2;
+constexpr int BOUNDS_ORDER_MIXED = 3;
+
+constexpr const char* SEGMENT_PROBE = "segment_probe";
+constexpr const char* NPROBE = "nprobe";
+constexpr const char* RADIUS = "radius";
+constexpr const char* REFINE_K = "refine_k";
+
+// how often WaitResult() checks whether the client is still there
+constexpr std::chrono::milliseconds CONNECTION_CHECK_INTERVAL(100);
+
+// Merges the sorted parts of queries [nq_begin, nq_end) into ids and distances with k results per query.
+// A loser tree over the part heads picks the next result with one match per level, where a binary heap plays two.
+// The ids of -1 are placeholders that any result goes before, an exhausted part goes after everything.
+void
+MergeResultParts(const std::vector<SearchResultPart>& parts, size_t nq_begin, size_t nq_end, size_t k,
+                 bool ascending, engine::IDNumber* ids, float* distances) {
+    std::vector<size_t> leaves;
+    for (size_t p = 0; p < parts.size(); ++p) {
+        if (parts[p].k_ > 0) {
+            leaves.push_back(p);
+        }
+    }
+    size_t m = leaves.size();
+    if (m == 0) {
+        return;
+    }
+
+    // tree[t] for 0 < t < m holds the leaf losing the match at node t, tree[0] the overall winner. The leaf m is
+    // the sentinel filling the tree before the first matches, it beats all the others
+    std::vector<size_t> tree(m);
+    std::vector<size_t> cursors(m);
+
+    for (size_t i = nq_begin; i < nq_end; ++i) {
+        // whether the head of leaf a goes after the head of leaf b
+        auto after = [&](size_t a, size_t b) {
+            if (a == m || b == m) {
+                return b == m && a != m;
+            }
+            const auto& part_a = parts[leaves[a]];
+            const auto& part_b = parts[leaves[b]];
+            bool a_done = cursors[a] >= part_a.k_;
+            bool b_done = cursors[b] >= part_b.k_;
+            if (a_done || b_done) {
+                return a_done && (!b_done || a > b);
+            }
+            size_t a_idx = i * part_a.stride_ + cursors[a];
+            size_t b_idx = i * part_b.stride_ + cursors[b];
+            bool a_valid = part_a.Valid(a_idx);
+            bool b_valid = part_b.Valid(b_idx);
+            if (a_valid != b_valid) {
+                return b_valid;
+            }
+            float a_dist = part_a.distances_[a_idx];
+            float b_dist = part_b.distances_[b_idx];
+            if (a_dist != b_dist) {
+                return ascending ? a_dist > b_dist : a_dist < b_dist;
+            }
+            return a > b;
+        };
+
+        // replays the matches from leaf s to the root, the winner of each goes on
+        auto adjust = [&](size_t s) {
+            for (size_t t = (s + m) / 2; t > 0; t /= 2) {
+                if (after(s, tree[t])) {
+                    std::swap(s, tree[t]);
+                }
+            }
+            tree[0] = s;
+        };
+
+        std::fill(tree.begin(), tree.end(), m);
+        std::fill(cursors.begin(), cursors.end(), 0);
+        for (size_t s = m; s-- > 0;) {
+            adjust(s);
+        }
+
+        for (size_t j = 0; j < k; ++j) {
+            size_t s = tree[0];
+            const auto& part = parts[leaves[s]];
+            if (cursors[s] >= part.k_) {
+                break;
+            }
+            size_t idx = i * part.stride_ + cursors[s];
+            ids[i * k + j] = part.Id(idx);
+            distances[i * k + j] = part.distances_[idx];
+            ++cursors[s];
+            adjust(s);
+        }
+    }
+}
+
+// Merges the parts of nq queries into ids and distances with k results per query, the queries are independent,
+// each thread merges a range of them
+void
+MergeResultPartsParallel(const std::vector<SearchResultPart>& parts, size_t nq, size_t k, bool ascending,
+                         engine::IDNumber* ids, float* distances) {
+    size_t max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    size_t num_threads = std::min(max_threads, (nq + REDUCE_MIN_NQ_PER_THREAD - 1) / REDUCE_MIN_NQ_PER_THREAD);
+    num_threads = std::max(num_threads, (size_t)1);
+    size_t nq_per_thread = (nq + num_threads - 1) / num_threads;
+
+    std::vector<std::future<void>> futures;
+    for (size_t begin = nq_per_thread; begin < nq; begin += nq_per_thread) {
+        size_t end = std::min(begin + nq_per_thread, nq);
+        futures.emplace_back(std::async(std::launch::async, MergeResultParts, std::cref(parts), begin, end, k,
+                                        ascending, ids, distances));
+    }
+    MergeResultParts(parts, 0, std::min(nq_per_thread, nq), k, ascending, ids, distances);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+RequestParamsPtr
+ParseRequestParams(const milvus::json& extra_params) {
+    auto params = std::make_shared<RequestParams>();
+    params->extra_params_ = extra_params;
+    if (extra_params.contains(NPROBE) && extra_params[NPROBE].is_number_integer()) {
+        params->nprobe_ = extra_params[NPROBE].get<int64_t>();
+    }
+    if (extra_params.contains(SEGMENT_PROBE) && extra_params[SEGMENT_PROBE].is_number_integer()) {
+        params->segment_probe_ = extra_params[SEGMENT_PROBE].get<int64_t>();
+    }
+    if (extra_params.contains(RADIUS) && extra_params[RADIUS].is_number()) {
+        params->range_ = true;
+        params->radius_ = extra_params[RADIUS].get<float>();
+    }
+    if (extra_params.contains(REFINE_K) && extra_params[REFINE_K].is_number_integer()) {
+        params->refine_k_ = extra_params[REFINE_K].get<int64_t>();
+    }
+    return params;
+}
+
+}  // namespace
+
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
                      engine::VectorsData& vectors)
-    : Job(JobType::SEARCH), context_(context), topk_(topk), extra_params_(extra_params), vectors_(vectors) {
+    : Job(JobType::SEARCH),
+      context_(context),
+      topk_(topk),
+      params_(ParseRequestParams(extra_params)),
+      vectors_(vectors) {
+    bool parallel_reduce = false;
+    server::Config::GetInstance().GetEngineConfigParallelReduce(parallel_reduce);
+    parallel_reduce_ = parallel_reduce;
+    server::Config::GetInstance().GetEngineConfigSearchMemoryLimit(memory_limit_);
+    if (context_ != nullptr) {
+        SetDeadline(context_->Deadline());
+    }
+
+    topk_bounds_size_ = vectors_.vector_count_;
+    topk_bounds_.reset(new std::atomic<float>[topk_bounds_size_]);
+    for (size_t i = 0; i < topk_bounds_size_; ++i) {
+        topk_bounds_[i].store(std::numeric_limits<float>::quiet_NaN(), std::memory_order_relaxed);
+    }
 }
 
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, milvus::query::GeneralQueryPtr general_query,
@@ -27,18 +201,36 @@ SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, milvus::qu
                      engine::VectorsData& vectors)
     : Job(JobType::SEARCH),
       context_(context),
+      params_(ParseRequestParams(milvus::json())),
       general_query_(general_query),
       query_ptr_(query_ptr),
       attr_type_(attr_type),
       vectors_(vectors) {
+    bool parallel_reduce = false;
+    server::Config::GetInstance().GetEngineConfigParallelReduce(parallel_reduce);
+    parallel_reduce_ = parallel_reduce;
+    server::Config::GetInstance().GetEngineConfigSearchMemoryLimit(memory_limit_);
+    if (context_ != nullptr) {
+        SetDeadline(context_->Deadline());
+    }
+}
+
+SearchJob::~SearchJob() {
+    if (context_ != nullptr) {
+        context_->Memory()->bytes -= request_bytes_;
+    }
 }
 
 bool
-SearchJob::AddIndexFile(const SegmentSchemaPtr& index_file) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (index_file == nullptr || index_files_.find(index_file->id_) != index_files_.end()) {
+SearchJob::AddIndexFile(const SegmentDescPtr& index_file, size_t group) {
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    if (index_file == nullptr || index_files_.find(index_file->id_) != index_files_.end() ||
+        group >= result_groups_) {
         return false;
     }
+    if (group > 0) {
+        file_groups_[index_file->id_] = group;
+    }
 
     LOG_SERVER_DEBUG_ << LogOut("[%s][%ld] SearchJob %ld add index file: %ld", "search", 0, id(), index_file->id_);
 
@@ -46,10 +238,121 @@ SearchJob::AddIndexFile(const SegmentSchemaPtr& index_file) {
     return true;
 }
 
+void
+SearchJob::SetResultGroups(size_t groups) {
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    result_groups_ = std::max(groups, (size_t)1);
+    if (result_groups_ > 1) {
+        parallel_reduce_ = true;
+    }
+}
+
+size_t
+SearchJob::ResultGroup(size_t index_id) const {
+    auto iter = file_groups_.find(index_id);
+    return iter != file_groups_.end() ? iter->second : 0;
+}
+
+void
+SearchJob::RouteIndexFiles() {
+    int64_t segment_probe = params_->segment_probe_;
+
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    size_t nq = vectors_.vector_count_;
+    if (segment_probe <= 0 || result_groups_ > 1 || index_files_.size() <= static_cast<size_t>(segment_probe) ||
+        nq == 0 || vectors_.float_data_.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<SegmentDescPtr, segment::VectorSummaryPtr>> routable;
+    for (auto& pair : index_files_) {
+        auto& file = pair.second;
+        std::string segment_dir;
+        engine::utils::GetParentPath(file->location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        segment::VectorSummaryPtr summary;
+        auto status = segment_reader.LoadVectorSummary(summary);
+        if (status.ok() && summary != nullptr && summary->CentroidCount() > 0 &&
+            summary->Dimension() == file->dimension_ && vectors_.float_data_.size() >= nq * file->dimension_) {
+            routable.emplace_back(file, summary);
+        }
+    }
+    if (routable.size() <= static_cast<size_t>(segment_probe)) {
+        return;
+    }
+
+    // for each query, the files whose summary bounds the distance best
+    std::vector<bool> keep(routable.size(), false);
+    std::vector<std::pair<float, size_t>> scores(routable.size());
+    for (size_t i = 0; i < nq; ++i) {
+        for (size_t j = 0; j < routable.size(); ++j) {
+            auto& file = routable[j].first;
+            auto& summary = routable[j].second;
+            const float* query = vectors_.float_data_.data() + i * file->dimension_;
+            if (file->metric_type_ == static_cast<int32_t>(engine::MetricType::IP)) {
+                scores[j] = std::make_pair(-summary->IPUpperBound(query), j);
+            } else {
+                scores[j] = std::make_pair(summary->L2LowerBound(query), j);
+            }
+        }
+        std::nth_element(scores.begin(), scores.begin() + segment_probe - 1, scores.end());
+        for (int64_t j = 0; j < segment_probe; ++j) {
+            keep[scores[j].second] = true;
+        }
+    }
+
+    size_t skipped = 0;
+    for (size_t j = 0; j < routable.size(); ++j) {
+        if (!keep[j]) {
+            index_files_.erase(routable[j].first->id_);
+            ++skipped;
+        }
+    }
+    LOG_SERVER_DEBUG_ << LogOut("[%s][%ld] SearchJob %ld skips %ld of %ld index files by vector summary", "search", 0,
+                                id(), skipped, skipped + index_files_.size());
+}
+
 void
 SearchJob::WaitResult() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] { return index_files_.empty(); });
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    while (!cv_.wait_for(lock, CONNECTION_CHECK_INTERVAL, [this] { return index_files_.empty(); })) {
+        // nobody reads the result of a client gone away
+        if (!IsCancelled() && context_ != nullptr && context_->IsConnectionBroken()) {
+            LOG_SERVER_DEBUG_ << LogOut("[%s][%ld] SearchJob %ld cancelled, client connection broken", "search", 0,
+                                        id());
+            Cancel();
+        }
+    }
+    if (IsCancelled()) {
+        if (over_memory_limit_) {
+            std::string msg = "Search cancelled, its results took more than the limit of " +
+                              std::to_string(memory_limit_) + " bytes of engine_config.search_memory_limit";
+            status_ = Status(SERVER_OUT_OF_MEMORY, msg);
+        } else {
+            status_ = Status(SERVER_REQUEST_CANCELLED, "Search cancelled");
+        }
+        result_parts_.clear();
+        arena_.Reset();
+        AccountResultMemory();
+        return;
+    }
+    if (!result_parts_.empty() || result_groups_ > 1) {
+        ScopedTimer rc;
+        if (result_groups_ > 1) {
+            ReduceResultGroups();
+        } else {
+            ReduceResultParts();
+        }
+        // the parts are gone, so is everything the tasks took from the arena
+        arena_.Reset();
+        AccountResultMemory();
+        double span = rc.ElapseFromBegin("SearchJob::ReduceResultParts");
+        time_stat_.reduce_time += span / 1000;
+        if (context_ != nullptr) {
+            context_->Cost()->reduce_us += static_cast<int64_t>(span);
+        }
+        server::Metrics::GetInstance().SearchStageObserve(server::SEARCH_STAGE_REDUCE, collection_id_, "", span);
+    }
     LOG_SERVER_DEBUG_ << LogOut("[%s][%ld] SearchJob %ld: query_time %f, map_uids_time %f, reduce_time %f", "search", 0,
                                 id(), this->time_stat().query_time, this->time_stat().map_uids_time,
                                 this->time_stat().reduce_time);
@@ -58,7 +361,7 @@ SearchJob::WaitResult() {
 
 void
 SearchJob::SearchDone(size_t index_id) {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
     index_files_.erase(index_id);
     if (index_files_.empty()) {
         cv_.notify_all();
@@ -77,17 +380,217 @@ SearchJob::GetResultDistances() {
     return result_distances_;
 }
 
+void
+SearchJob::AddResultSources(const SegmentDescPtr& index_file, const ResultIds& ids) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    for (auto id : ids) {
+        if (id != -1) {
+            result_sources_[id] = index_file;
+        }
+    }
+}
+
+void
+SearchJob::GetResultSources(std::vector<SegmentDescPtr>& sources) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    sources.clear();
+    sources.reserve(result_ids_.size());
+    for (auto id : result_ids_) {
+        auto iter = result_sources_.find(id);
+        sources.push_back(iter != result_sources_.end() ? iter->second : nullptr);
+    }
+}
+
 Status&
 SearchJob::GetStatus() {
     return status_;
 }
 
+void
+SearchJob::Cancel() {
+    cancelled_.store(true);
+}
+
+void
+SearchJob::AddResultPart(SearchResultPart&& part, size_t nq, size_t topk, bool ascending) {
+    std::unique_lock<InstrumentedMutex> lock(mutex_);
+    reduce_nq_ = nq;
+    reduce_topk_ = topk;
+    reduce_ascending_ = ascending;
+    result_parts_.emplace_back(std::move(part));
+    AccountResultMemory();
+}
+
+void
+SearchJob::AccountResultMemory() {
+    int64_t bytes = result_ids_.capacity() * sizeof(engine::IDNumber) + result_distances_.capacity() * sizeof(float);
+    for (auto& part : result_parts_) {
+        bytes += part.ids_.capacity() * sizeof(engine::IDNumber) + part.offsets_.capacity() * sizeof(int32_t) +
+                 part.distances_.capacity() * sizeof(float);
+    }
+    result_memory_.Set(bytes);
+
+    if (context_ == nullptr) {
+        return;
+    }
+    int64_t request_bytes = (context_->Memory()->bytes += bytes - request_bytes_);
+    request_bytes_ = bytes;
+    if (memory_limit_ <= 0 || IsCancelled()) {
+        return;
+    }
+    if (request_bytes > memory_limit_) {
+        LOG_SERVER_WARNING_ << LogOut("[%s][%ld] SearchJob %ld cancelled, request %s holds %ld bytes of results",
+                                      "search", 0, id(), context_->RequestID().c_str(), request_bytes);
+        over_memory_limit_ = true;
+        Cancel();
+    } else if (request_bytes > memory_limit_ / 2 && result_groups_ == 1 && parallel_reduce_.load()) {
+        // the later results are merged into the nq * topk result set, the parts kept so far wait for the reduce
+        LOG_SERVER_DEBUG_ << LogOut("[%s][%ld] SearchJob %ld merges in place, request %s holds %ld bytes of results",
+                                    "search", 0, id(), context_->RequestID().c_str(), request_bytes);
+        parallel_reduce_ = false;
+    }
+}
+
+void
+SearchJob::UpdateTopkBounds(const ResultIds& ids, const ResultDistances& distances, size_t k, size_t nq,
+                            size_t topk, bool ascending) {
+    // a file with less than topk results proves nothing about the k-th best
+    if (result_groups_ > 1 || k != topk || topk == 0 || nq > topk_bounds_size_ || ids.size() < nq * topk) {
+        return;
+    }
+
+    int order = ascending ? BOUNDS_ORDER_ASCENDING : BOUNDS_ORDER_DESCENDING;
+    int expected = BOUNDS_ORDER_NONE;
+    if (!topk_bounds_order_.compare_exchange_strong(expected, order) && expected != order) {
+        topk_bounds_order_.store(BOUNDS_ORDER_MIXED);
+        return;
+    }
+
+    for (size_t i = 0; i < nq; ++i) {
+        size_t idx = i * topk + topk - 1;
+        if (ids[idx] == -1) {
+            continue;
+        }
+        float dist = distances[idx];
+        float bound = topk_bounds_[i].load(std::memory_order_relaxed);
+        while (std::isnan(bound) || (ascending ? dist < bound : dist > bound)) {
+            if (topk_bounds_[i].compare_exchange_weak(bound, dist, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    }
+}
+
+bool
+SearchJob::GetTopkBounds(bool ascending, std::vector<float>& bounds) const {
+    int order = ascending ? BOUNDS_ORDER_ASCENDING : BOUNDS_ORDER_DESCENDING;
+    if (topk_bounds_order_.load() != order) {
+        return false;
+    }
+
+    // queries without a bound yet are not pruned
+    float unbounded = ascending ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+    bounds.resize(topk_bounds_size_);
+    for (size_t i = 0; i < topk_bounds_size_; ++i) {
+        float bound = topk_bounds_[i].load(std::memory_order_relaxed);
+        bounds[i] = std::isnan(bound) ? unbounded : bound;
+    }
+    return true;
+}
+
+CoarseAssignPtr
+SearchJob::GetCoarseAssign(uint64_t fingerprint, int64_t nprobe, const std::function<void(CoarseAssign&)>& assign) {
+    CoarseAssignPtr coarse_assign;
+    {
+        std::lock_guard<std::mutex> lock(coarse_assigns_mutex_);
+        auto& entry = coarse_assigns_[std::make_pair(fingerprint, nprobe)];
+        if (entry == nullptr) {
+            entry = std::make_shared<CoarseAssign>();
+        }
+        coarse_assign = entry;
+    }
+
+    // computed outside the lock, the index files with other centroids do not wait for it
+    std::call_once(coarse_assign->once_, assign, std::ref(*coarse_assign));
+    return coarse_assign;
+}
+
+SearchParamsPtr
+SearchJob::GetSearchParams(const std::string& key, const std::function<void(SearchParams&)>& compile) {
+    SearchParamsPtr params;
+    {
+        std::lock_guard<std::mutex> lock(search_params_mutex_);
+        auto& entry = search_params_[key];
+        if (entry == nullptr) {
+            entry = std::make_shared<SearchParams>();
+        }
+        params = entry;
+    }
+
+    std::call_once(params->once_, compile, std::ref(*params));
+    return params;
+}
+
+void
+SearchJob::ReduceResultParts() {
+    if (reduce_nq_ == 0) {
+        result_parts_.clear();
+        return;
+    }
+
+    // the result set initialized by the JobMgr takes part as well
+    SearchResultPart initial(&arena_);
+    initial.k_ = initial.stride_ = result_ids_.size() / reduce_nq_;
+    initial.ids_.assign(result_ids_.begin(), result_ids_.end());
+    initial.distances_.assign(result_distances_.begin(), result_distances_.end());
+    if (initial.k_ > 0) {
+        result_parts_.emplace_back(std::move(initial));
+    }
+
+    size_t total_k = 0;
+    for (auto& part : result_parts_) {
+        total_k += part.k_;
+    }
+    size_t k = std::min(reduce_topk_, total_k);
+    result_ids_.assign(reduce_nq_ * k, -1);
+    result_distances_.assign(reduce_nq_ * k, 0.0);
+    MergeResultPartsParallel(result_parts_, reduce_nq_, k, reduce_ascending_, result_ids_.data(),
+                             result_distances_.data());
+
+    result_parts_.clear();
+}
+
+void
+SearchJob::ReduceResultGroups() {
+    // the rows are laid out for all the groups, a group without a result keeps its -1
+    size_t nq = vectors_.vector_count_;
+    size_t k = topk_;
+    result_ids_.assign(result_groups_ * nq * k, -1);
+    result_distances_.assign(result_groups_ * nq * k, 0.0);
+    if (reduce_nq_ != nq || k == 0) {
+        result_parts_.clear();
+        return;
+    }
+
+    std::vector<std::vector<SearchResultPart>> groups(result_groups_);
+    for (auto& part : result_parts_) {
+        groups[part.group_].emplace_back(std::move(part));
+    }
+    result_parts_.clear();
+    for (size_t g = 0; g < result_groups_; ++g) {
+        if (!groups[g].empty()) {
+            MergeResultPartsParallel(groups[g], nq, k, reduce_ascending_, result_ids_.data() + g * nq * k,
+                                     result_distances_.data() + g * nq * k);
+        }
+    }
+}
+
 json
 SearchJob::Dump() const {
     json ret{
         {"topk", topk_},
         {"nq", vectors_.vector_count_},
-        {"extra_params", extra_params_.dump()},
+        {"extra_params", params_->extra_params_.dump()},
     };
     auto base = Job::Dump();
     ret.insert(base.begin(), base.end());
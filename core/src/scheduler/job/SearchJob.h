@@ -10,9 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -29,13 +32,16 @@
 #include "query/GeneralQuery.h"
 
 #include "server/context/Context.h"
+#include "utils/Arena.h"
+#include "utils/ContentionStats.h"
+#include "utils/MemoryAccounting.h"
 
 namespace milvus {
 namespace scheduler {
 
-using engine::meta::SegmentSchemaPtr;
+using engine::meta::SegmentDescPtr;
 
-using Id2IndexMap = std::unordered_map<size_t, SegmentSchemaPtr>;
+using Id2IndexMap = std::unordered_map<size_t, SegmentDescPtr>;
 
 using ResultIds = engine::ResultIds;
 using ResultDistances = engine::ResultDistances;
@@ -46,6 +52,73 @@ struct SearchTimeStat {
     double reduce_time = 0.0;
 };
 
+// top k of each query found in one index file, the results of query i begin at i * stride_. With uids_ set the
+// results are the row offsets of the file in offsets_ instead of ids_, mapped to ids only for the final top k.
+// The buffers are drawn from the arena of the job, the heap without one
+struct SearchResultPart {
+    explicit SearchResultPart(Arena* arena = nullptr)
+        : ids_(ArenaAllocator<engine::IDNumber>(arena)),
+          distances_(ArenaAllocator<float>(arena)),
+          offsets_(ArenaAllocator<int32_t>(arena)) {
+    }
+
+    ArenaVector<engine::IDNumber> ids_;
+    ArenaVector<float> distances_;
+    size_t k_ = 0;
+    size_t stride_ = 0;
+    ArenaVector<int32_t> offsets_;
+    engine::SegmentUidsPtr uids_;
+    size_t group_ = 0;  // the result group of the index file
+
+    bool
+    Valid(size_t idx) const {
+        return uids_ != nullptr ? offsets_[idx] != -1 : ids_[idx] != -1;
+    }
+
+    engine::IDNumber
+    Id(size_t idx) const {
+        if (uids_ == nullptr) {
+            return ids_[idx];
+        }
+        return offsets_[idx] != -1 ? (*uids_)[offsets_[idx]] : -1;
+    }
+};
+
+// nq * nprobe lists of the queries in the ivf centroids of one fingerprint, shared by the index files trained
+// with these centroids
+struct CoarseAssign {
+    std::once_flag once_;
+    std::vector<int64_t> ids_;
+    std::vector<float> distances_;
+};
+
+using CoarseAssignPtr = std::shared_ptr<CoarseAssign>;
+
+// the config the request params become for one index type and mode and the number of results asked per query,
+// checked by the conf adapter of the index type once for all the index files searched with it. The request params
+// themselves are parsed once per job in RequestParams
+struct SearchParams {
+    std::once_flag once_;
+    bool valid_ = false;
+    milvus::json conf_;
+    int64_t refine_k_ = 0;  // candidates per query re-scored with the raw vectors, 0 for none
+};
+
+using SearchParamsPtr = std::shared_ptr<SearchParams>;
+
+// the params of the search request read outside the index, parsed once when the job is created and shared read
+// only by all its tasks
+struct RequestParams {
+    milvus::json extra_params_;
+    int64_t nprobe_ = 0;         // 0 without an integer nprobe
+    int64_t segment_probe_ = 0;  // 0 without an integer segment_probe
+    bool range_ = false;
+    float radius_ = 0.0f;
+    int64_t refine_k_ = 0;  // 0 without an integer refine_k
+};
+
+using RequestParamsPtr = std::shared_ptr<const RequestParams>;
+
 class SearchJob : public Job {
  public:
     SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
@@ -55,9 +128,17 @@ class SearchJob : public Job {
               query::QueryPtr query_ptr, std::unordered_map<std::string, engine::meta::hybrid::DataType>& attr_type,
               engine::VectorsData& vectorsData);
 
+    ~SearchJob();
+
  public:
+    // the results of the index file are merged with those of its group only, see SetResultGroups()
     bool
-    AddIndexFile(const SegmentSchemaPtr& index_file);
+    AddIndexFile(const SegmentDescPtr& index_file, size_t group = 0);
+
+    // with the search param segment_probe, drop the index files added so far except the segment_probe files most
+    // likely to hold the nearest neighbours of each query, files without a vector summary are always searched
+    void
+    RouteIndexFiles();
 
     void
     WaitResult();
@@ -65,20 +146,101 @@ class SearchJob : public Job {
     void
     SearchDone(size_t index_id);
 
+    // search the index files of several collections at once and keep a top k apart for each: the results of the
+    // index files added to group g are reduced into the rows [g * nq, (g + 1) * nq) of the result set, every row
+    // topk long and padded with -1. Called before the index files are added, the parts are then always kept for
+    // the parallel reduce, and neither the top k bounds nor the segment routing of one group prune another
+    void
+    SetResultGroups(size_t groups);
+
+    size_t
+    result_groups() const {
+        return result_groups_;
+    }
+
+    // the result group of an index file added
+    size_t
+    ResultGroup(size_t index_id) const;
+
     ResultIds&
     GetResultIds();
 
     ResultDistances&
     GetResultDistances();
 
+    // remember the index file the result ids of a hybrid search task came from, so the fields of the final top k
+    // can be fetched from their own segments only
+    void
+    AddResultSources(const SegmentDescPtr& index_file, const ResultIds& ids);
+
+    // the index file of each final result id, null for -1 and for an id whose file is unknown
+    void
+    GetResultSources(std::vector<SegmentDescPtr>& sources);
+
+    // account the memory of the results and the parts kept so far to the job and its request, mutex() must be
+    // held. Past half the search memory limit of the request the later tasks merge into the bounded result set
+    // instead of keeping parts, past the whole limit the job is cancelled and fails with SERVER_OUT_OF_MEMORY
+    void
+    AccountResultMemory();
+
     void
     SetVectors(engine::VectorsData& vectors) {
         vectors_ = vectors;
     }
 
+    // the collection searched, the label of the stage metrics of the job
+    void
+    SetCollectionId(const std::string& collection_id) {
+        collection_id_ = collection_id;
+    }
+
+    const std::string&
+    collection_id() const {
+        return collection_id_;
+    }
+
     Status&
     GetStatus();
 
+    // give up on the result, the tasks not searched yet are dropped and the running index searches stop early
+    void
+    Cancel();
+
+    bool
+    IsCancelled() const {
+        return cancelled_.load();
+    }
+
+    // polled by the index searches of the job
+    const std::atomic<bool>*
+    cancel_flag() const {
+        return &cancelled_;
+    }
+
+    // keep the result of a task without merging it, the parts are merged by WaitResult() once all tasks are done
+    void
+    AddResultPart(SearchResultPart&& part, size_t nq, size_t topk, bool ascending);
+
+    // tighten the k-th best distance of each query with the result of one index file
+    void
+    UpdateTopkBounds(const ResultIds& ids, const ResultDistances& distances, size_t k, size_t nq, size_t topk,
+                     bool ascending);
+
+    // k-th best distance of each query found so far, a result not beating it can't make the top k,
+    // return false if there is nothing to prune with
+    bool
+    GetTopkBounds(bool ascending, std::vector<float>& bounds) const;
+
+    // coarse assignment of the queries to the centroids with the given fingerprint, filled by assign for the first
+    // index file asking for it, the others wait for it and reuse it
+    CoarseAssignPtr
+    GetCoarseAssign(uint64_t fingerprint, int64_t nprobe, const std::function<void(CoarseAssign&)>& assign);
+
+    // search params compiled by compile for the first index file of the key asking for them, the key tells apart
+    // the index type, mode, topk and whatever else compile depends on
+    SearchParamsPtr
+    GetSearchParams(const std::string& key, const std::function<void(SearchParams&)>& compile);
+
     json
     Dump() const override;
 
@@ -98,7 +260,12 @@ class SearchJob : public Job {
 
     const milvus::json&
     extra_params() const {
-        return extra_params_;
+        return params_->extra_params_;
+    }
+
+    const RequestParams&
+    request_params() const {
+        return *params_;
     }
 
     const engine::VectorsData&
@@ -111,7 +278,7 @@ class SearchJob : public Job {
         return index_files_;
     }
 
-    std::mutex&
+    InstrumentedMutex&
     mutex() {
         return mutex_;
     }
@@ -141,15 +308,49 @@ class SearchJob : public Job {
         return time_stat_;
     }
 
+    // whether the tasks hand their results to AddResultPart() instead of merging them under mutex()
+    bool
+    parallel_reduce() const {
+        return parallel_reduce_.load();
+    }
+
+    // whether the files loaded for the job are kept in the cpu cache, background searches leave the cache alone
+    bool
+    cache_files() const {
+        return cache_files_;
+    }
+
+    void
+    SetCacheFiles(bool cache_files) {
+        cache_files_ = cache_files;
+    }
+
+    // the scratch memory of the job, released once WaitResult() has the result
+    Arena&
+    arena() {
+        return arena_;
+    }
+
+ private:
+    void
+    ReduceResultParts();
+
+    void
+    ReduceResultGroups();
+
  private:
     const std::shared_ptr<server::Context> context_;
+    std::string collection_id_;
 
     uint64_t topk_ = 0;
-    milvus::json extra_params_;
+    RequestParamsPtr params_;
     // TODO: smart pointer
     engine::VectorsData& vectors_;
 
     Id2IndexMap index_files_;
+    size_t result_groups_ = 1;
+    // written before the job is scheduled, read only by its tasks
+    std::unordered_map<size_t, size_t> file_groups_;
     // TODO: column-base better ?
     ResultIds result_ids_;
     ResultDistances result_distances_;
@@ -160,10 +361,40 @@ class SearchJob : public Job {
     std::unordered_map<std::string, engine::meta::hybrid::DataType> attr_type_;
     uint64_t vector_count_;
 
-    std::mutex mutex_;
-    std::condition_variable cv_;
+    InstrumentedMutex mutex_{"search_job"};
+    std::condition_variable_any cv_;
 
     SearchTimeStat time_stat_;
+
+    std::atomic<bool> parallel_reduce_{false};
+    bool cache_files_ = true;
+    Arena arena_;
+    std::vector<SearchResultPart> result_parts_;
+    size_t reduce_nq_ = 0;
+    size_t reduce_topk_ = 0;
+    bool reduce_ascending_ = true;
+
+    // NaN until an index file returns topk results for the query
+    std::unique_ptr<std::atomic<float>[]> topk_bounds_;
+    size_t topk_bounds_size_ = 0;
+    std::atomic<int> topk_bounds_order_{0};
+
+    std::mutex coarse_assigns_mutex_;
+    std::map<std::pair<uint64_t, int64_t>, CoarseAssignPtr> coarse_assigns_;
+
+    std::mutex search_params_mutex_;
+    std::unordered_map<std::string, SearchParamsPtr> search_params_;
+
+    std::atomic<bool> cancelled_{false};
+
+    std::mutex sources_mutex_;
+    std::unordered_map<int64_t, SegmentDescPtr> result_sources_;
+
+    TrackedMemory result_memory_{MemorySubsystem::SEARCH_RESULT};
+    // engine_config.search_memory_limit, 0 for no limit, and the bytes of the job counted in the request
+    int64_t memory_limit_ = 0;
+    int64_t request_bytes_ = 0;
+    bool over_memory_limit_ = false;
 };
 
 using SearchJobPtr = std::shared_ptr<SearchJob>;
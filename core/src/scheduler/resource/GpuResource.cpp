@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/GpuResource.h"
+#include "cache/GpuResidencyMgr.h"
 
 namespace milvus {
 namespace scheduler {
@@ -26,6 +27,16 @@ GpuResource::GpuResource(std::string name, uint64_t device_id, bool enable_execu
 
 void
 GpuResource::LoadFile(TaskPtr task) {
+#ifdef MILVUS_GPU_VERSION
+    // copy the files of the next waiting tasks in background while this one is copied and searched
+    auto depth = cache::GpuResidencyMgr::GetInstance().PrefetchDepth();
+    if (depth > 0) {
+        auto indexes = task_table().PickToLoad(depth);
+        for (auto index : indexes) {
+            task_table()[index]->task->Prefetch(device_id_);
+        }
+    }
+#endif
     task->Load(LoadType::CPU2GPU, device_id_);
 }
 
@@ -10,9 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/Resource.h"
+#include "scheduler/NumaTopology.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
+#include "scheduler/selector/CostModel.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -44,6 +48,7 @@ ToString(ResourceType type) {
 
 Resource::Resource(std::string name, ResourceType type, uint64_t device_id, bool enable_executor)
     : device_id_(device_id), name_(std::move(name)), type_(type), enable_executor_(enable_executor) {
+    task_table_.SetName(name_);
     // register subscriber in tasktable
     task_table_.RegisterSubscriber([&] {
         if (subscriber_) {
@@ -55,6 +60,29 @@ Resource::Resource(std::string name, ResourceType type, uint64_t device_id, bool
 
 void
 Resource::Start() {
+    if (type_ == ResourceType::CPU) {
+        int64_t depth = DEFAULT_LOAD_DEPTH;
+        server::Config::GetInstance().GetEngineConfigPrefetchDepth(depth);
+        load_depth_ = depth;
+    }
+#ifdef MILVUS_GPU_VERSION
+    if (type_ == ResourceType::GPU) {
+        // gpu memory is scarce, copy no more files ahead than the residency manager prefetches
+        int64_t depth = DEFAULT_LOAD_DEPTH;
+        server::Config::GetInstance().GetGpuResourceConfigPrefetchDepth(depth);
+        load_depth_ = std::max<int64_t>(depth, 1);
+    }
+#endif
+
+    // the pool workers float between the nodes
+    if (enable_executor_ && type_ == ResourceType::CPU && numa_node_ < 0) {
+        auto pool = ExecutorPoolInst::GetInstance();
+        if (pool->Size() > 0) {
+            executor_pool_ = pool;
+            executor_worker_ = pool->BindWorker();
+        }
+    }
+
     running_ = true;
     loader_thread_ = std::thread(&Resource::loader_function, this);
     if (enable_executor_) {
@@ -98,8 +126,8 @@ Resource::Dump() const {
         {"name", name_},
         {"type", ToString(type_)},
         {"task_average_cost", TaskAvgCost()},
-        {"task_total_cost", total_cost_},
-        {"total_tasks", total_task_},
+        {"task_total_cost", total_cost_.load()},
+        {"total_tasks", total_task_.load()},
         {"running", running_},
         {"enable_executor", enable_executor_},
     };
@@ -113,7 +141,7 @@ Resource::NumOfTaskToExec() {
 
 TaskTableItemPtr
 Resource::pick_task_load() {
-    auto indexes = task_table_.PickToLoad(10);
+    auto indexes = task_table_.PickToLoad(10, load_depth_);
     for (auto index : indexes) {
         // try to set one task loading, then return
         if (task_table_.Load(index))
@@ -154,6 +182,7 @@ Resource::pick_task_execute() {
 void
 Resource::loader_function() {
     SetThreadName("taskloader_th");
+    bind_numa_node();
     while (running_) {
         std::unique_lock<std::mutex> lock(load_mutex_);
         load_cv_.wait(lock, [&] { return load_flag_; });
@@ -168,8 +197,21 @@ Resource::loader_function() {
                 BuildMgrInst::GetInstance()->Take();
                 LOG_SERVER_DEBUG_ << name() << " load BuildIndexTask";
             }
+#ifdef MILVUS_GPU_VERSION
+            auto load_start = std::chrono::steady_clock::now();
+            LoadFile(task_item->task);
+            if (type_ == ResourceType::GPU) {
+                std::chrono::duration<double, std::micro> load_cost = std::chrono::steady_clock::now() - load_start;
+                CostModel::GetInstance().ObserveLoad(name(), task_item->task, load_cost.count());
+            }
+#else
             LoadFile(task_item->task);
+#endif
             task_item->Loaded();
+            // hand over to the executor now rather than after the event went through the scheduler
+            if (enable_executor_) {
+                WakeupExecutor();
+            }
             if (task_item->from) {
                 task_item->from->Moved();
                 task_item->from = nullptr;
@@ -185,6 +227,7 @@ Resource::loader_function() {
 void
 Resource::executor_function() {
     SetThreadName("taskexecutor_th");
+    bind_numa_node();
     if (subscriber_) {
         auto event = std::make_shared<StartUpEvent>(shared_from_this());
         subscriber_(std::static_pointer_cast<Event>(event));
@@ -199,27 +242,59 @@ Resource::executor_function() {
             if (task_item == nullptr) {
                 break;
             }
-            auto start = get_current_timestamp();
-            Process(task_item->task);
-            auto finish = get_current_timestamp();
-            ++total_task_;
-            total_cost_ += finish - start;
-
-            task_item->Executed();
-
-            if (task_item->task->Type() == TaskType::BuildIndexTask) {
-                BuildMgrInst::GetInstance()->Put();
-                ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
-                ResMgrInst::GetInstance()->GetResource("disk")->WakeupLoader();
-            }
+            // a loaded slot is free, keep the next tasks loading while this one executes
+            WakeupLoader();
 
-            if (subscriber_) {
-                auto event = std::make_shared<FinishTaskEvent>(shared_from_this(), task_item);
-                subscriber_(std::static_pointer_cast<Event>(event));
+            // a large search doesn't hold up the rest of the table, idle workers of the pool steal them
+            if (executor_pool_ != nullptr && task_item->task->Type() == TaskType::SearchTask) {
+                auto self = shared_from_this();
+                executor_pool_->Submit(executor_worker_, [self, task_item] { self->execute_task(task_item); });
+                continue;
             }
+            execute_task(task_item);
         }
     }
 }
 
+void
+Resource::bind_numa_node() {
+    if (numa_node_ < 0) {
+        return;
+    }
+    auto status = NumaTopology::GetInstance().BindThread(numa_node_);
+    if (!status.ok()) {
+        LOG_SERVER_WARNING_ << name() << ": " << status.message();
+    }
+}
+
+void
+Resource::execute_task(const TaskTableItemPtr& task_item) {
+    auto start = get_current_timestamp();
+#ifdef MILVUS_GPU_VERSION
+    auto process_start = std::chrono::steady_clock::now();
+    Process(task_item->task);
+    std::chrono::duration<double, std::micro> process_cost = std::chrono::steady_clock::now() - process_start;
+    CostModel::GetInstance().ObserveExecute(name(), task_item->task, process_cost.count());
+#else
+    Process(task_item->task);
+#endif
+    auto finish = get_current_timestamp();
+    ++total_task_;
+    total_cost_ += finish - start;
+
+    task_item->Executed();
+
+    if (task_item->task->Type() == TaskType::BuildIndexTask) {
+        BuildMgrInst::GetInstance()->Put();
+        ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
+        ResMgrInst::GetInstance()->GetResource("disk")->WakeupLoader();
+    }
+
+    if (subscriber_) {
+        auto event = std::make_shared<FinishTaskEvent>(shared_from_this(), task_item);
+        subscriber_(std::static_pointer_cast<Event>(event));
+    }
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -19,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "../ExecutorPool.h"
 #include "../TaskTable.h"
 #include "../event/Event.h"
 #include "../event/FinishTaskEvent.h"
@@ -71,6 +73,15 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
         subscriber_ = std::move(subscriber);
     }
 
+    /*
+     * Pin loader and executor to the cpus of a numa node, called before Start;
+     * the tasks then execute on the executor rather than on the executor pool;
+     */
+    inline void
+    BindNumaNode(int64_t node) {
+        numa_node_ = node;
+    }
+
     json
     Dump() const override;
 
@@ -167,6 +178,18 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     void
     executor_function();
 
+    /*
+     * Called by load thread and worker thread when they start;
+     */
+    void
+    bind_numa_node();
+
+    /*
+     * Called by worker thread or a worker of the executor pool;
+     */
+    void
+    execute_task(const TaskTableItemPtr& task_item);
+
  protected:
     uint64_t device_id_;
     std::string name_;
@@ -176,16 +199,24 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
     TaskTable task_table_;
 
-    uint64_t total_cost_ = 0;
-    uint64_t total_task_ = 0;
+    std::atomic<uint64_t> total_cost_{0};
+    std::atomic<uint64_t> total_task_{0};
 
     std::function<void(EventPtr)> subscriber_ = nullptr;
 
     bool running_ = false;
     bool enable_executor_ = true;
+    int64_t numa_node_ = -1;
     std::thread loader_thread_;
     std::thread executor_thread_;
 
+    // how many tasks the loader keeps loaded ahead of the executor, tuned by resource type
+    uint64_t load_depth_ = DEFAULT_LOAD_DEPTH;
+
+    // search tasks of a cpu resource run on the executor pool if it has workers, fed through executor_worker_
+    ExecutorPoolPtr executor_pool_ = nullptr;
+    uint64_t executor_worker_ = 0;
+
     bool load_flag_ = false;
     bool exec_flag_ = false;
     std::mutex load_mutex_;
@@ -0,0 +1,199 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "scheduler/selector/CostModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "scheduler/job/SearchJob.h"
+#include "scheduler/task/SearchTask.h"
+#include "utils/Json.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// weight of a timing after the next one, about the last 20 timings shape the fit
+constexpr double FIT_DECAY = 0.95;
+
+// timings needed before a fit is trusted
+constexpr uint64_t FIT_MIN_COUNT = 4;
+
+constexpr const char* NLIST = "nlist";
+
+}  // namespace
+
+CostModel&
+CostModel::GetInstance() {
+    static CostModel instance;
+    return instance;
+}
+
+void
+CostModel::LinearFit::Add(double x, double y) {
+    s1_ = s1_ * FIT_DECAY + 1.0;
+    sx_ = sx_ * FIT_DECAY + x;
+    sy_ = sy_ * FIT_DECAY + y;
+    sxx_ = sxx_ * FIT_DECAY + x * x;
+    sxy_ = sxy_ * FIT_DECAY + x * y;
+    ++count_;
+}
+
+bool
+CostModel::LinearFit::Estimate(double x, double& y) const {
+    if (count_ < FIT_MIN_COUNT || s1_ <= 0.0) {
+        return false;
+    }
+
+    double a = 0.0;
+    double b = 0.0;
+    double var = s1_ * sxx_ - sx_ * sx_;
+    if (var > 1e-9 * s1_ * sxx_) {
+        b = (s1_ * sxy_ - sx_ * sy_) / var;
+        a = (sy_ - b * sx_) / s1_;
+    }
+    // the timings don't spread enough or contradict the model, assume the cost is proportional to x
+    if (b <= 0.0 || a < 0.0) {
+        a = 0.0;
+        b = sx_ > 0.0 ? sy_ / sx_ : 0.0;
+        if (b <= 0.0) {
+            y = sy_ / s1_;
+            return true;
+        }
+    }
+    y = a + b * x;
+    return true;
+}
+
+bool
+CostModel::Feature(const TaskPtr& task, TaskCostFeature& feature) {
+    if (task == nullptr || task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    auto job = search_task->job_.lock();
+    auto& file = search_task->file_;
+    if (job == nullptr || file == nullptr) {
+        return false;
+    }
+    auto search_job = std::static_pointer_cast<SearchJob>(job);
+    if (search_job->general_query() != nullptr) {
+        return false;
+    }
+
+    double nq = search_job->nq();
+    double dim = file->dimension_;
+    double rows = file->row_count_;
+    double scanned = rows;
+
+    bool indexed = file->file_type_ == engine::meta::SegmentSchema::INDEX;
+    auto engine_type = static_cast<engine::EngineType>(file->engine_type_);
+    if (indexed && (engine_type == engine::EngineType::FAISS_IVFFLAT ||
+                    engine_type == engine::EngineType::FAISS_IVFSQ8 || engine_type == engine::EngineType::FAISS_PQ ||
+                    engine_type == engine::EngineType::FAISS_PQ_FASTSCAN)) {
+        int64_t nlist = 0;
+        int64_t nprobe = 0;
+        try {
+            auto index_params = milvus::json::parse(file->index_params_);
+            if (index_params.contains(NLIST) && index_params[NLIST].is_number_integer()) {
+                nlist = index_params[NLIST].get<int64_t>();
+            }
+        } catch (std::exception&) {
+        }
+        nprobe = search_job->request_params().nprobe_;
+        if (nlist > 0 && nprobe > 0) {
+            // the query is compared with all the centroids, then the rows of nprobe lists
+            scanned = rows * std::min(1.0, static_cast<double>(nprobe) / nlist) + nlist;
+        }
+    }
+
+    feature.engine_type_ = indexed ? file->engine_type_ : static_cast<int32_t>(engine::EngineType::FAISS_IDMAP);
+    feature.work_ = nq * dim * scanned / 1e6;
+    feature.bytes_ = file->file_size_;
+    return true;
+}
+
+std::string
+CostModel::ExecuteKey(const std::string& resource, const TaskCostFeature& feature) {
+    return resource + "_" + std::to_string(feature.engine_type_);
+}
+
+bool
+CostModel::EstimateExecute(const std::string& resource, const TaskCostFeature& feature, double& cost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = execute_fits_.find(ExecuteKey(resource, feature));
+    return iter != execute_fits_.end() && iter->second.Estimate(feature.work_, cost);
+}
+
+bool
+CostModel::EstimateLoad(const std::string& resource, const TaskCostFeature& feature, double& cost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = load_fits_.find(resource);
+    return iter != load_fits_.end() && iter->second.Estimate(feature.bytes_ / 1e6, cost);
+}
+
+void
+CostModel::ObserveExecute(const std::string& resource, const TaskPtr& task, double cost) {
+    TaskCostFeature feature;
+    bool valid = Feature(task, feature);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = placed_.find(task.get());
+    if (iter != placed_.end()) {
+        auto& pending = pending_[iter->second.first];
+        pending = std::max(0.0, pending - iter->second.second);
+        placed_.erase(iter);
+    }
+    // a cancelled task tells nothing about the cost of searching
+    if (valid && !task->Expired()) {
+        execute_fits_[ExecuteKey(resource, feature)].Add(feature.work_, cost);
+    }
+}
+
+void
+CostModel::ObserveLoad(const std::string& resource, const TaskPtr& task, double cost) {
+    TaskCostFeature feature;
+    if (!Feature(task, feature) || task->Expired()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    load_fits_[resource].Add(feature.bytes_ / 1e6, cost);
+}
+
+void
+CostModel::Place(const std::string& resource, const TaskPtr& task, double cost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    placed_[task.get()] = std::make_pair(resource, cost);
+    pending_[resource] += cost;
+}
+
+double
+CostModel::Pending(const std::string& resource) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = pending_.find(resource);
+    return iter == pending_.end() ? 0.0 : iter->second;
+}
+
+void
+CostModel::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    execute_fits_.clear();
+    load_fits_.clear();
+    placed_.clear();
+    pending_.clear();
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "scheduler/task/Task.h"
+
+namespace milvus {
+namespace scheduler {
+
+// what a search task costs, independent of where it runs
+struct TaskCostFeature {
+    // engine type of indexed files, FAISS_IDMAP for raw files searched by brute force
+    int32_t engine_type_ = 0;
+    // millions of distance computations: nq * dim * (rows scanned + centroids)
+    double work_ = 0.0;
+    // bytes to copy if the file is not cached on the device
+    uint64_t bytes_ = 0;
+};
+
+/*
+ * Estimates the runtime of search tasks on each resource. The coefficients of a linear model per resource and
+ * engine type are fitted online from the timings the resources report, older timings fade out.
+ * It also keeps the estimated cost of the tasks placed but not executed yet, the queue of each resource.
+ */
+class CostModel {
+ public:
+    static CostModel&
+    GetInstance();
+
+    // false if the task is not a vector search
+    static bool
+    Feature(const TaskPtr& task, TaskCostFeature& feature);
+
+    // microseconds to execute on the resource, false if the resource hasn't reported enough timings yet
+    bool
+    EstimateExecute(const std::string& resource, const TaskCostFeature& feature, double& cost);
+
+    // microseconds to copy the file to the resource, false if the resource hasn't reported enough timings yet
+    bool
+    EstimateLoad(const std::string& resource, const TaskCostFeature& feature, double& cost);
+
+    void
+    ObserveExecute(const std::string& resource, const TaskPtr& task, double cost);
+
+    void
+    ObserveLoad(const std::string& resource, const TaskPtr& task, double cost);
+
+    // the task is queued on the resource, its cost counts until ObserveExecute()
+    void
+    Place(const std::string& resource, const TaskPtr& task, double cost);
+
+    // estimated microseconds of the tasks placed on the resource and not executed yet
+    double
+    Pending(const std::string& resource);
+
+    void
+    Clear();
+
+ private:
+    CostModel() = default;
+
+    // least squares fit of y = a + b * x with exponential forgetting
+    struct LinearFit {
+        double s1_ = 0.0;
+        double sx_ = 0.0;
+        double sy_ = 0.0;
+        double sxx_ = 0.0;
+        double sxy_ = 0.0;
+        uint64_t count_ = 0;
+
+        void
+        Add(double x, double y);
+
+        bool
+        Estimate(double x, double& y) const;
+    };
+
+    static std::string
+    ExecuteKey(const std::string& resource, const TaskCostFeature& feature);
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, LinearFit> execute_fits_;
+    std::unordered_map<std::string, LinearFit> load_fits_;
+    std::unordered_map<const Task*, std::pair<std::string, double>> placed_;
+    std::unordered_map<std::string, double> pending_;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,127 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/selector/CostPlacementPass.h"
+#include "cache/GpuCacheMgr.h"
+#include "config/Config.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/Utils.h"
+#include "scheduler/selector/CostModel.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "utils/Log.h"
+
+#include <limits>
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// one in so many tasks goes to a resource without a cost estimate yet
+constexpr uint64_t EXPLORE_INTERVAL = 16;
+
+}  // namespace
+
+void
+CostPlacementPass::Init() {
+    server::Config& config = server::Config::GetInstance();
+    Status s = config.GetGpuResourceConfigSearchResources(search_gpus_);
+    if (!s.ok()) {
+        throw std::exception();
+    }
+
+    SetIdentity("CostPlacementPass");
+    AddGpuEnableListener();
+    AddGpuSearchResourcesListener();
+}
+
+bool
+CostPlacementPass::Run(const TaskPtr& task) {
+    if (!gpu_enable_ || search_gpus_.empty()) {
+        return false;
+    }
+
+    TaskCostFeature feature;
+    if (!CostModel::Feature(task, feature)) {
+        return false;
+    }
+
+    // the hybrid index splits the search between cpu and gpu by itself
+    if (feature.engine_type_ == (int)engine::EngineType::FAISS_IVFSQ8H) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    std::vector<ResourcePtr> candidates;
+    candidates.push_back(ResMgrInst::GetInstance()->GetSearchCpuResource(search_task->file_->id_));
+    for (auto gpu_id : search_gpus_) {
+        candidates.push_back(ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, gpu_id));
+    }
+
+    auto& model = CostModel::GetInstance();
+    ResourcePtr best = nullptr;
+    ResourcePtr unknown = nullptr;
+    double best_finish = std::numeric_limits<double>::max();
+    double best_cost = 0.0;
+    for (auto& res : candidates) {
+        if (res == nullptr) {
+            continue;
+        }
+
+        double cost = 0.0;
+        if (!model.EstimateExecute(res->name(), feature, cost)) {
+            unknown = res;
+            continue;
+        }
+        if (res->type() == ResourceType::GPU &&
+            !cache::GpuCacheMgr::GetInstance(res->device_id())->ItemExists(search_task->file_->location_)) {
+            double load_cost = 0.0;
+            if (!model.EstimateLoad(res->name(), feature, load_cost)) {
+                unknown = res;
+                continue;
+            }
+            cost += load_cost;
+        }
+
+        double finish = model.Pending(res->name()) + cost;
+        if (finish < best_finish) {
+            best = res;
+            best_finish = finish;
+            best_cost = cost;
+        }
+    }
+
+    ResourcePtr res_ptr;
+    if (unknown != nullptr) {
+        if (++explore_count_ % EXPLORE_INTERVAL != 0) {
+            return false;
+        }
+        LOG_SERVER_DEBUG_ << LogOut("[%s][%d] CostPlacementPass: no estimate on %s yet, specify it to search!",
+                                    "search", 0, unknown->name().c_str());
+        res_ptr = unknown;
+    } else if (best != nullptr) {
+        LOG_SERVER_DEBUG_ << LogOut("[%s][%d] CostPlacementPass: expect %f us on %s, specify it to search!", "search",
+                                    0, best_cost, best->name().c_str());
+        res_ptr = best;
+        model.Place(res_ptr->name(), task, best_cost);
+    } else {
+        return false;
+    }
+
+    auto label = std::make_shared<SpecResLabel>(res_ptr);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
@@ -0,0 +1,49 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config/handler/GpuResourceConfigHandler.h"
+#include "scheduler/selector/Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Places a search task on the cpu or the search gpu where it is expected to finish first: the cost queued on the
+ * resource plus the cost of the task there, including the copy to the gpu if the file isn't cached on it.
+ * The costs come from the CostModel; until a resource has reported enough timings the passes by
+ * gpu_search_threshold decide, except that every EXPLORE_INTERVAL-th task goes to the unknown resource.
+ */
+class CostPlacementPass : public Pass, public server::GpuResourceConfigHandler {
+ public:
+    CostPlacementPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+
+ private:
+    uint64_t explore_count_ = 0;
+};
+
+using CostPlacementPassPtr = std::shared_ptr<CostPlacementPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
@@ -55,11 +55,11 @@ FaissFlatPass::Run(const TaskPtr& task) {
     ResourcePtr res_ptr;
     if (!gpu_enable_) {
         LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FaissFlatPass: gpu disable, specify cpu to search!", "search", 0);
-        res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
+        res_ptr = ResMgrInst::GetInstance()->GetSearchCpuResource(search_task->file_->id_);
     } else if (search_job->nq() < (uint64_t)threshold_) {
         LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FaissFlatPass: nq < gpu_search_threshold, specify cpu to search!",
                                     "search", 0);
-        res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
+        res_ptr = ResMgrInst::GetInstance()->GetSearchCpuResource(search_task->file_->id_);
     } else {
         LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FaissFlatPass: nq >= gpu_search_threshold, specify gpu %d to search!",
                                     "search", 0, search_gpus_[idx_]);
@@ -11,6 +11,7 @@
 
 #include "scheduler/selector/FallbackPass.h"
 #include "scheduler/SchedInst.h"
+#include "scheduler/task/SearchTask.h"
 #include "scheduler/tasklabel/SpecResLabel.h"
 
 namespace milvus {
@@ -28,7 +29,13 @@ FallbackPass::Run(const TaskPtr& task) {
     }
     // NEVER be empty
     LOG_SERVER_DEBUG_ << "FallbackPass!";
-    auto cpu = ResMgrInst::GetInstance()->GetCpuResources()[0];
+    ResourcePtr cpu;
+    if (task_type == TaskType::SearchTask) {
+        auto search_task = std::static_pointer_cast<XSearchTask>(task);
+        cpu = ResMgrInst::GetInstance()->GetSearchCpuResource(search_task->file_->id_);
+    } else {
+        cpu = ResMgrInst::GetInstance()->GetResource("cpu");
+    }
     auto label = std::make_shared<SpecResLabel>(cpu);
     task->label() = label;
     return true;
@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/selector/FreshSegmentPass.h"
+#include "cache/GpuCacheMgr.h"
+#include "cache/GpuResidencyMgr.h"
+#include "db/Utils.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/Utils.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+void
+FreshSegmentPass::Init() {
+    SetIdentity("FreshSegmentPass");
+    AddGpuEnableListener();
+}
+
+bool
+FreshSegmentPass::Run(const TaskPtr& task) {
+    if (!gpu_enable_ || task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    auto& file = search_task->file_;
+    if (file->file_type_ == engine::meta::SegmentSchema::INDEX ||
+        engine::utils::IsBinaryMetricType(file->metric_type_)) {
+        return false;
+    }
+
+    int64_t device_id = cache::GpuResidencyMgr::GetInstance().FreshSegmentDevice(file->segment_id_);
+    if (device_id < 0 || !cache::GpuCacheMgr::GetInstance(device_id)->ItemExists(file->location_)) {
+        return false;
+    }
+
+    auto res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, device_id);
+    if (res_ptr == nullptr) {
+        return false;
+    }
+    LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FreshSegmentPass: segment kept on gpu %ld, specify it to search!", "search",
+                                0, device_id);
+    auto label = std::make_shared<SpecResLabel>(res_ptr);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
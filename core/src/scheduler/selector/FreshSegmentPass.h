@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <memory>
+
+#include "config/handler/GpuResourceConfigHandler.h"
+#include "scheduler/selector/Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Searches a segment not indexed yet on the gpu its flush copied it to, whatever the nq, as long as the copy is
+ * still in the gpu cache. The segments are searched there by brute force until their index is built.
+ */
+class FreshSegmentPass : public Pass, public server::GpuResourceConfigHandler {
+ public:
+    FreshSegmentPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+};
+
+using FreshSegmentPassPtr = std::shared_ptr<FreshSegmentPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
@@ -13,15 +13,18 @@
 
 #include <fiu-local.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
 #include <utility>
 
+#include "db/IndexBuildTracker.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
 #include "metrics/Metrics.h"
 #include "scheduler/job/BuildIndexJob.h"
+#include "storage/IOScheduler.h"
 #include "utils/CommonUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
@@ -52,6 +55,7 @@ XBuildIndexTask::XBuildIndexTask(SegmentSchemaPtr file, TaskLabelPtr label)
 void
 XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
     TimeRecorder rc("XBuildIndexTask::Load");
+    storage::IOClassGuard io_guard(storage::IOClass::BACKGROUND);
     Status stat = Status::OK();
     std::string error_msg;
     std::string type_str;
@@ -59,6 +63,7 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
     if (auto job = job_.lock()) {
         auto build_index_job = std::static_pointer_cast<scheduler::BuildIndexJob>(job);
         auto options = build_index_job->options();
+        engine::IndexBuildTracker::GetInstance().SetStage(file_->id_, engine::IndexBuildStage::LOADING);
         try {
             if (type == LoadType::DISK2CPU) {
                 stat = to_index_engine_->Load(options.insert_cache_immediately_);
@@ -100,6 +105,7 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
         }
 
         size_t file_size = to_index_engine_->Size();
+        build_memory_.Set(file_size);
 
         std::string info = "Build index task load file id:" + std::to_string(file_->id_) + " " + type_str +
                            " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
@@ -114,6 +120,7 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
 void
 XBuildIndexTask::Execute() {
     TimeRecorderAuto rc("XBuildIndexTask::Execute " + std::to_string(to_index_id_));
+    storage::IOClassGuard io_guard(storage::IOClass::BACKGROUND);
 
     if (auto job = job_.lock()) {
         auto build_index_job = std::static_pointer_cast<scheduler::BuildIndexJob>(job);
@@ -153,9 +160,13 @@ XBuildIndexTask::Execute() {
             build_index_job->BuildIndexDone(to_index_id_);
             build_index_job->GetStatus() = Status(DB_ERROR, err_msg);
             to_index_engine_ = nullptr;
+            build_memory_.Set(0);
         };
 
         // step 2: build index
+        auto& tracker = engine::IndexBuildTracker::GetInstance();
+        tracker.SetStage(to_index_id_, engine::IndexBuildStage::BUILDING);
+        auto build_start = std::chrono::steady_clock::now();
         try {
             LOG_ENGINE_DEBUG_ << "Begin build index for file:" + table_file.location_;
             index = to_index_engine_->BuildIndex(table_file.location_, (EngineType)table_file.engine_type_);
@@ -171,6 +182,14 @@ XBuildIndexTask::Execute() {
             return;
         }
 
+        tracker.SetRowsIndexed(to_index_id_, file_->row_count_);
+        build_memory_.Set(build_memory_.bytes() + index->Size());
+        double build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+        if (build_seconds > 0) {
+            server::Metrics::GetInstance().IndexBuildVectorsPerSecondObserve(
+                engine::utils::GetIndexName(table_file.engine_type_), file_->row_count_ / build_seconds);
+        }
+
         // step 3: if collection has been deleted, dont save index file
         bool has_collection = false;
         meta_ptr->HasCollection(file_->collection_id_, has_collection);
@@ -183,6 +202,7 @@ XBuildIndexTask::Execute() {
         }
 
         // step 4: save index file
+        tracker.SetStage(to_index_id_, engine::IndexBuildStage::SERIALIZING);
         try {
             fiu_do_on("XBuildIndexTask.Execute.throw_std_exception", throw std::exception());
             status = index->Serialize();
@@ -205,6 +225,8 @@ XBuildIndexTask::Execute() {
         table_file.file_type_ = engine::meta::SegmentSchema::INDEX;
         table_file.file_size_ = CommonUtil::GetFileSize(table_file.location_);
         table_file.row_count_ = file_->row_count_;  // index->Count();
+        tracker.SetBytesWritten(to_index_id_, table_file.file_size_);
+        server::Metrics::GetInstance().IndexBuildBytesWrittenIncrement(table_file.file_size_);
 
         auto origin_file = *file_;
         origin_file.file_type_ = engine::meta::SegmentSchema::BACKUP;
@@ -220,10 +242,15 @@ XBuildIndexTask::Execute() {
             LOG_ENGINE_DEBUG_ << "New index file " << table_file.file_id_ << " of size " << table_file.file_size_
                               << " bytes"
                               << " from file " << origin_file.file_id_;
-            // XXX_Index_NM doesn't support it now.
-            // if (build_index_job->options().insert_cache_immediately_) {
-            //     index->Cache();
-            // }
+            // the raw vectors of the segment are not searched anymore, the index takes their place in the cache
+            // so that the first searches don't load it from disk
+            if (build_index_job->options().write_through_index_) {
+                bool cached = false;
+                index->CacheReplacing(origin_file.location_, cached);
+                if (!cached) {
+                    LOG_ENGINE_DEBUG_ << "Index file " << table_file.file_id_ << " doesn't fit in the cache";
+                }
+            }
         } else {
             // failed to update meta, mark the new file as to_delete, don't delete old file
             origin_file.file_type_ = engine::meta::SegmentSchema::TO_INDEX;
@@ -241,6 +268,7 @@ XBuildIndexTask::Execute() {
     }
 
     to_index_engine_ = nullptr;
+    build_memory_.Set(0);
 }
 
 }  // namespace scheduler
@@ -14,6 +14,7 @@
 #include "Task.h"
 #include "scheduler/Definition.h"
 #include "scheduler/job/BuildIndexJob.h"
+#include "utils/MemoryAccounting.h"
 
 namespace milvus {
 namespace scheduler {
@@ -34,6 +35,7 @@ class XBuildIndexTask : public Task {
     size_t to_index_id_ = 0;
     int to_index_type_ = 0;
     ExecutionEnginePtr to_index_engine_ = nullptr;
+    TrackedMemory build_memory_{MemorySubsystem::INDEX_BUILD};  // the raw data and the built index
 };
 
 }  // namespace scheduler
@@ -14,15 +14,20 @@
 #include <fiu-local.h>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <utility>
 
+#include "cache/CpuCacheMgr.h"
+#include "cache/GpuResidencyMgr.h"
+#include "db/SegmentAccessLog.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
 #include "metrics/Metrics.h"
+#include "scheduler/ParallelismGovernor.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/SearchJob.h"
 #include "segment/SegmentReader.h"
@@ -36,6 +41,41 @@ namespace scheduler {
 static constexpr size_t PARALLEL_REDUCE_THRESHOLD = 10000;
 static constexpr size_t PARALLEL_REDUCE_BATCH = 1000;
 
+// the result buffers a worker thread keeps for its next search, unless a query grew them past this many results
+static constexpr size_t MAX_REUSED_RESULTS = 1 << 20;
+
+namespace {
+
+thread_local std::vector<int64_t> reused_ids;
+thread_local std::vector<float> reused_distances;
+
+// the buffers MergeTopkToResultSet merges into, swapped with the result set it merged into before
+thread_local scheduler::ResultIds merge_ids;
+thread_local scheduler::ResultDistances merge_distances;
+
+// takes the result buffers of the thread and hands them back empty, a search writes its results into them without
+// allocating as long as they are large enough
+struct ReusedResults {
+    ReusedResults() {
+        ids_.swap(reused_ids);
+        distances_.swap(reused_distances);
+    }
+
+    ~ReusedResults() {
+        if (ids_.capacity() <= MAX_REUSED_RESULTS && distances_.capacity() <= MAX_REUSED_RESULTS) {
+            ids_.clear();
+            distances_.clear();
+            reused_ids.swap(ids_);
+            reused_distances.swap(distances_);
+        }
+    }
+
+    std::vector<int64_t> ids_;
+    std::vector<float> distances_;
+};
+
+}  // namespace
+
 // TODO(wxyu): remove unused code
 // bool
 // NeedParallelReduce(uint64_t nq, uint64_t topk) {
@@ -99,13 +139,14 @@ CollectFileMetrics(int file_type, size_t file_size) {
     }
 }
 
-XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, SegmentSchemaPtr file, TaskLabelPtr label)
+XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, SegmentDescPtr file, TaskLabelPtr label)
     : Task(TaskType::SearchTask, std::move(label)), context_(context), file_(file) {
     if (file_) {
         // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
         // similarity -- infinity value means two vectors equal, descending reduce, IP
         if (file_->metric_type_ == static_cast<int>(MetricType::IP) &&
-            file_->engine_type_ != static_cast<int>(EngineType::FAISS_PQ)) {
+            file_->engine_type_ != static_cast<int>(EngineType::FAISS_PQ) &&
+            file_->engine_type_ != static_cast<int>(EngineType::FAISS_PQ_FASTSCAN)) {
             ascending_reduce = false;
         }
 
@@ -118,6 +159,7 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, Segmen
         } else {
             engine_type = (EngineType)file->engine_type_;
         }
+        index_name_ = engine::utils::GetIndexName(static_cast<int32_t>(engine_type));
 
         milvus::json json_params;
         if (!file_->index_params_.empty()) {
@@ -143,19 +185,62 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, Segmen
     }
 }
 
+XSearchTask::~XSearchTask() {
+    // the task may be dropped without being executed, e.g. load failed
+    ReleasePrefetch();
+}
+
 void
 XSearchTask::Load(LoadType type, uint8_t device_id) {
-    milvus::server::ContextFollower tracer(context_, "XSearchTask::Load " + std::to_string(file_->id_));
+    milvus::server::ContextSampledSpan span_load(context_, "XSearchTask::Load");
+    span_load.SetTag("file_id", static_cast<int64_t>(file_->id_));
 
-    TimeRecorder rc(LogOut("[%s][%ld]", "search", 0));
+    ScopedTimer rc;
     Status stat = Status::OK();
     std::string error_msg;
     std::string type_str;
+    bool cache_hit = true;
+
+    if (!queue_observed_) {
+        queue_observed_ = true;
+        auto wait = std::chrono::steady_clock::now() - create_time_;
+        ObserveStage(server::SEARCH_STAGE_SCHEDULER_QUEUE,
+                     std::chrono::duration_cast<std::chrono::microseconds>(wait).count());
+    }
 
     try {
         fiu_do_on("XSearchTask.Load.throw_std_exception", throw std::exception());
-        if (type == LoadType::DISK2CPU) {
-            stat = index_engine_->Load();
+        if (pruned_) {
+            return;
+        } else if (Expired() || JobCancelled()) {
+            // nobody waits for the result, leave the file on disk and let Execute() cancel the task
+            index_id_ = file_->id_;
+            index_type_ = file_->file_type_;
+            return;
+        } else if (type == LoadType::DISK2CPU) {
+            auto job = job_.lock();
+            auto general_query =
+                job ? std::static_pointer_cast<scheduler::SearchJob>(job)->general_query() : query::GeneralQueryPtr();
+            if (general_query != nullptr) {
+                bool may_match = true;
+                index_engine_->PruneByZoneMap(general_query, may_match);
+                if (!may_match) {
+                    LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] Skip file id:%ld, pruned by attribute zone maps", "search",
+                                                0, file_->id_);
+                    pruned_ = true;
+                    index_id_ = file_->id_;
+                    index_type_ = file_->file_type_;
+                    return;
+                }
+            }
+            cache_hit = cache::CpuCacheMgr::GetInstance()->ItemExists(file_->location_);
+            span_load.SetTag("cache_hit", cache_hit);
+            bool to_cache = job == nullptr || std::static_pointer_cast<scheduler::SearchJob>(job)->cache_files();
+            if (to_cache) {
+                // the files searched last are preloaded first after a restart
+                engine::SegmentAccessLog::GetInstance().Touch(file_->location_, file_->id_);
+            }
+            stat = index_engine_->Load(to_cache);
             stat = index_engine_->LoadAttr();
             type_str = "DISK2CPU";
         } else if (type == LoadType::CPU2GPU) {
@@ -164,6 +249,9 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
                 hybrid = true;
             }
             stat = index_engine_->CopyToGpu(device_id, hybrid);
+            if (stat.ok()) {
+                engine::SegmentAccessLog::GetInstance().TouchGpu(file_->location_, device_id);
+            }
             type_str = "CPU2GPU" + std::to_string(device_id);
         } else if (type == LoadType::GPU2CPU) {
             stat = index_engine_->CopyToCpu();
@@ -200,11 +288,27 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     }
 
     size_t file_size = index_engine_->Size();
+    if (span_load.IsRecording()) {
+        span_load.SetTag("load_type", type_str);
+        span_load.SetTag("bytes", static_cast<int64_t>(file_size));
+    }
 
-    std::string info = "Search task load file id:" + std::to_string(file_->id_) + " " + type_str +
-                       " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
-                       " bytes from location: " + file_->location_ + " totally cost";
-    rc.ElapseFromBegin(info);
+    double span = rc.ElapseFromBegin("XSearchTask::Load");
+    LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "search", 0) << " Search task load file id:" << file_->id_ << " "
+                      << type_str << " file type:" << file_->file_type_ << " size:" << file_size
+                      << " bytes from location: " << file_->location_ << " totally cost " << span << " us";
+    if (context_ != nullptr) {
+        // only the disk load counts for the cache, a copy between devices loads nothing from the disk
+        auto& cost = context_->Cost();
+        if (type == LoadType::DISK2CPU && cache_hit) {
+            cost->cache_hits++;
+        } else if (type == LoadType::DISK2CPU) {
+            cost->cache_misses++;
+            cost->bytes_loaded += file_size;
+        }
+        cost->load_us += static_cast<int64_t>(span);
+    }
+    ObserveStage(server::SEARCH_STAGE_LOAD, span);
 
     CollectFileMetrics(file_->file_type_, file_size);
 
@@ -216,13 +320,17 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
 
 void
 XSearchTask::Execute() {
-    milvus::server::ContextFollower tracer(context_, "XSearchTask::Execute " + std::to_string(index_id_));
-    TimeRecorder rc(LogOut("[%s][%ld] DoSearch file id:%ld", "search", 0, index_id_));
+    milvus::server::ContextSampledSpan span_execute(context_, "XSearchTask::Execute");
+    span_execute.SetTag("file_id", static_cast<int64_t>(index_id_));
+    span_execute.SetTag("index_type", index_name_);
+    ScopedTimer rc("XSearchTask::Execute");
 
     server::CollectDurationMetrics metrics(index_type_);
 
-    std::vector<int64_t> output_ids;
-    std::vector<float> output_distance;
+    ReusedResults results;
+    std::vector<int64_t>& output_ids = results.ids_;
+    std::vector<float>& output_distance = results.distances_;
+    engine::SegmentUidsPtr uids;
     double span;
 
     if (auto job = job_.lock()) {
@@ -233,16 +341,51 @@ XSearchTask::Execute() {
             return;
         }
 
+        if (pruned_) {
+            auto query_ptr = search_job->query_ptr();
+            if (query_ptr != nullptr && !query_ptr->vectors.empty()) {
+                auto vector_query = query_ptr->vectors.begin()->second;
+                search_job->vector_count() = vector_query->query_vector.float_data.size() / file_->dimension_;
+            }
+            search_job->SearchDone(index_id_);
+            ReleasePrefetch();
+            index_engine_ = nullptr;
+            return;
+        }
+
+        if (search_job->IsCancelled()) {
+            LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] Cancel search on file id:%ld, job cancelled", "search", 0,
+                                        index_id_);
+            search_job->SearchDone(index_id_);
+            ReleasePrefetch();
+            index_engine_ = nullptr;
+            return;
+        }
+
+        if (Expired()) {
+            LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] Cancel search on file id:%ld, deadline exceeded", "search", 0,
+                                        index_id_);
+            search_job->GetStatus() = Status(SERVER_DEADLINE_EXCEEDED, "Search deadline exceeded");
+            search_job->SearchDone(index_id_);
+            ReleasePrefetch();
+            index_engine_ = nullptr;
+            return;
+        }
+
         /* step 1: allocate memory */
         query::GeneralQueryPtr general_query = search_job->general_query();
 
         uint64_t nq = search_job->nq();
         uint64_t topk = search_job->topk();
+        // the job may fall back to merging under its mutex while the task runs, the task sticks to one way
+        bool parallel_reduce = search_job->parallel_reduce();
 
         fiu_do_on("XSearchTask.Execute.throw_std_exception", throw std::exception());
 
         try {
             /* step 2: search */
+            // the nq of a hybrid search is only known from its query
+            ParallelismGuard parallelism(general_query != nullptr ? 0 : static_cast<int64_t>(nq));
             bool hybrid = false;
             if (index_engine_->IndexEngineType() == engine::EngineType::FAISS_IVFSQ8H &&
                 ResMgrInst::GetInstance()->GetResource(path().Last())->type() == ResourceType::CPU) {
@@ -265,7 +408,18 @@ XSearchTask::Execute() {
                 nq = vector_query->query_vector.float_data.size() / file_->dimension_;
                 search_job->vector_count() = nq;
             } else {
-                s = index_engine_->Search(output_ids, output_distance, search_job, hybrid);
+                milvus::server::ContextSampledSpan span_query(span_execute, "knowhere query");
+                if (span_query.IsRecording()) {
+                    span_query.SetTag("nq", static_cast<int64_t>(nq));
+                    span_query.SetTag("topk", static_cast<int64_t>(topk));
+                    span_query.SetTag("hybrid", hybrid);
+                }
+                // a parallel reduce keeps the results of a file as its row offsets until they make the final top k
+                if (parallel_reduce) {
+                    s = index_engine_->SearchOffsets(output_ids, output_distance, search_job, hybrid, uids);
+                } else {
+                    s = index_engine_->Search(output_ids, output_distance, search_job, hybrid);
+                }
             }
 
             fiu_do_on("XSearchTask.Execute.search_fail", s = Status(SERVER_UNEXPECTED_ERROR, ""));
@@ -275,21 +429,62 @@ XSearchTask::Execute() {
                 return;
             }
 
-            span = rc.RecordSection("search done");
+            span = rc.RecordSection("XSearchTask::Execute search");
+            if (context_ != nullptr) {
+                context_->Cost()->segments_searched++;
+                context_->Cost()->search_us += static_cast<int64_t>(span);
+            }
+            ObserveStage(server::SEARCH_STAGE_SEARCH, span);
 
             /* step 3: pick up topk result */
             auto spec_k = file_->row_count_ < topk ? file_->row_count_ : topk;
+            if (general_query == nullptr) {
+                // later files of the job skip what can't beat the k-th best found here
+                search_job->UpdateTopkBounds(output_ids, output_distance, spec_k, nq, topk, ascending_reduce);
+            }
+            if (general_query != nullptr) {
+                search_job->AddResultSources(file_, output_ids);
+            }
             if (spec_k == 0) {
                 LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] Searching in an empty file. file location = %s", "search", 0,
                                               file_->location_.c_str());
+            } else if (parallel_reduce) {
+                // only the first spec_k results of a query are read by the reduce, they are copied to the arena
+                // of the job and the result buffers stay with the thread for its next search
+                SearchResultPart part(&search_job->arena());
+                part.k_ = part.stride_ = spec_k;
+                part.group_ = search_job->ResultGroup(index_id_);
+                part.distances_.resize(nq * spec_k);
+                if (uids != nullptr) {
+                    part.offsets_.resize(nq * spec_k);
+                    part.uids_ = std::move(uids);
+                } else {
+                    part.ids_.resize(nq * spec_k);
+                }
+                for (size_t i = 0; i < nq; ++i) {
+                    for (size_t j = 0; j < spec_k; ++j) {
+                        if (part.uids_ != nullptr) {
+                            part.offsets_[i * spec_k + j] = static_cast<int32_t>(output_ids[i * topk + j]);
+                        } else {
+                            part.ids_[i * spec_k + j] = output_ids[i * topk + j];
+                        }
+                        part.distances_[i * spec_k + j] = output_distance[i * topk + j];
+                    }
+                }
+                search_job->AddResultPart(std::move(part), nq, topk, ascending_reduce);
             } else {
-                std::unique_lock<std::mutex> lock(search_job->mutex());
+                std::unique_lock<InstrumentedMutex> lock(search_job->mutex());
                 XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
                                                   search_job->GetResultIds(), search_job->GetResultDistances());
+                search_job->AccountResultMemory();
             }
 
-            span = rc.RecordSection("reduce topk done");
+            span = rc.RecordSection("XSearchTask::Execute reduce");
             search_job->time_stat().reduce_time += span / 1000;
+            if (context_ != nullptr) {
+                context_->Cost()->reduce_us += static_cast<int64_t>(span);
+            }
+            ObserveStage(server::SEARCH_STAGE_REDUCE, span);
         } catch (std::exception& ex) {
             LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] SearchTask encounter exception: %s", "search", 0, ex.what());
             search_job->GetStatus() = Status(SERVER_UNEXPECTED_ERROR, ex.what());
@@ -299,12 +494,53 @@ XSearchTask::Execute() {
         search_job->SearchDone(index_id_);
     }
 
-    rc.ElapseFromBegin("totally cost");
-
     // release index in resource
+    ReleasePrefetch();
     index_engine_ = nullptr;
 }
 
+void
+XSearchTask::Prefetch(uint8_t device_id) {
+#ifdef MILVUS_GPU_VERSION
+    if (index_engine_ == nullptr || prefetch_device_ >= 0) {
+        return;
+    }
+
+    // protect the file from gpu cache eviction before the copy is queued, until the search is done
+    cache::GpuResidencyMgr::GetInstance().Acquire(device_id, file_->location_);
+    prefetch_device_ = device_id;
+    auto status = index_engine_->PrefetchToGpu(device_id);
+    if (!status.ok()) {
+        LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] Failed to prefetch file %ld to gpu%d: %s", "search", 0, file_->id_,
+                                      device_id, status.message().c_str());
+    }
+#endif
+}
+
+bool
+XSearchTask::JobCancelled() const {
+    auto job = job_.lock();
+    return job != nullptr && std::static_pointer_cast<scheduler::SearchJob>(job)->IsCancelled();
+}
+
+void
+XSearchTask::ObserveStage(const char* stage, double microseconds) const {
+    auto job = job_.lock();
+    const std::string& collection_id =
+        job != nullptr ? std::static_pointer_cast<scheduler::SearchJob>(job)->collection_id() : std::string();
+    server::Metrics::GetInstance().SearchStageObserve(stage, collection_id, index_name_, microseconds);
+}
+
+void
+XSearchTask::ReleasePrefetch() {
+#ifdef MILVUS_GPU_VERSION
+    if (prefetch_device_ >= 0) {
+        cache::GpuResidencyMgr::GetInstance().Release(prefetch_device_, file_->location_);
+        prefetch_device_ = -1;
+    }
+#endif
+}
+
 void
 XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                                   size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
@@ -317,8 +553,10 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     size_t tar_k = tar_ids.size() / nq;
     size_t buf_k = std::min(topk, src_k + tar_k);
 
-    scheduler::ResultIds buf_ids(nq * buf_k, -1);
-    scheduler::ResultDistances buf_distances(nq * buf_k, 0.0);
+    scheduler::ResultIds& buf_ids = merge_ids;
+    scheduler::ResultDistances& buf_distances = merge_distances;
+    buf_ids.assign(nq * buf_k, -1);
+    buf_distances.assign(nq * buf_k, 0.0);
     for (uint64_t i = 0; i < nq; i++) {
         size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
         size_t buf_idx, src_idx, tar_idx;
@@ -370,6 +608,10 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     }
     tar_ids.swap(buf_ids);
     tar_distances.swap(buf_distances);
+    if (buf_ids.capacity() > MAX_REUSED_RESULTS || buf_distances.capacity() > MAX_REUSED_RESULTS) {
+        scheduler::ResultIds().swap(buf_ids);
+        scheduler::ResultDistances().swap(buf_distances);
+    }
 }
 
 const std::string&
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,7 +26,9 @@ namespace scheduler {
 // TODO(wxyu): rewrite
 class XSearchTask : public Task {
  public:
-    explicit XSearchTask(const std::shared_ptr<server::Context>& context, SegmentSchemaPtr file, TaskLabelPtr label);
+    explicit XSearchTask(const std::shared_ptr<server::Context>& context, SegmentDescPtr file, TaskLabelPtr label);
+
+    ~XSearchTask();
 
     void
     Load(LoadType type, uint8_t device_id) override;
@@ -33,6 +36,9 @@ class XSearchTask : public Task {
     void
     Execute() override;
 
+    void
+    Prefetch(uint8_t device_id) override;
+
  public:
     static void
     MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
@@ -53,7 +59,7 @@ class XSearchTask : public Task {
  public:
     const std::shared_ptr<server::Context> context_;
 
-    SegmentSchemaPtr file_;
+    SegmentDescPtr file_;
 
     size_t index_id_ = 0;
     int index_type_ = 0;
@@ -62,6 +68,32 @@ class XSearchTask : public Task {
     // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
     // similarity -- infinity value means two vectors equal, descending reduce, IP
     bool ascending_reduce = true;
+
+ private:
+    void
+    ReleasePrefetch();
+
+    // the job gave up on the result
+    bool
+    JobCancelled() const;
+
+    // observe a stage of the search on this segment, labelled with the collection of the job
+    void
+    ObserveStage(const char* stage, double microseconds) const;
+
+ private:
+    // device the index file is prefetched to, -1 means not prefetched
+    int64_t prefetch_device_ = -1;
+
+    // the attribute zone maps rule the segment out, nothing is loaded or searched
+    bool pruned_ = false;
+
+    // name of the index searched, the index type label of the stage metrics
+    std::string index_name_;
+
+    // the time spent waiting for a resource is observed once, at the first load
+    std::chrono::steady_clock::time_point create_time_ = std::chrono::steady_clock::now();
+    bool queue_observed_ = false;
 };
 
 }  // namespace scheduler
@@ -16,6 +16,7 @@
 #include "scheduler/tasklabel/TaskLabel.h"
 #include "utils/Status.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -71,6 +72,33 @@ class Task {
         return label_;
     }
 
+    /*
+     * Priority and deadline of the job, the order of execution;
+     */
+    inline void
+    SetSchedule(JobPriority priority, const JobDeadline& deadline) {
+        priority_ = priority;
+        deadline_ = deadline;
+    }
+
+    inline JobPriority
+    priority() const {
+        return priority_;
+    }
+
+    inline const JobDeadline&
+    deadline() const {
+        return deadline_;
+    }
+
+    /*
+     * Nobody waits for the result any more;
+     */
+    inline bool
+    Expired() const {
+        return deadline_ != JobDeadline::max() && std::chrono::steady_clock::now() >= deadline_;
+    }
+
  public:
     virtual void
     Load(LoadType type, uint8_t device_id) = 0;
@@ -78,11 +106,18 @@ class Task {
     virtual void
     Execute() = 0;
 
+    // hint that the task will be loaded to device_id soon, the data could be copied in advance
+    virtual void
+    Prefetch(uint8_t device_id) {
+    }
+
  public:
     Path task_path_;
     scheduler::JobWPtr job_;
     TaskType type_;
     TaskLabelPtr label_ = nullptr;
+    JobPriority priority_ = JobPriority::NORMAL;
+    JobDeadline deadline_ = JobDeadline::max();
 };
 
 }  // namespace scheduler
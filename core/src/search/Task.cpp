@@ -39,7 +39,8 @@ Task::Task(const std::shared_ptr<server::Context>& context, SegmentSchemaPtr& fi
         // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
         // similarity -- infinity value means two vectors equal, descending reduce, IP
         if (file_->metric_type_ == static_cast<int>(engine::MetricType::IP) &&
-            file_->engine_type_ != static_cast<int>(engine::EngineType::FAISS_PQ)) {
+            file_->engine_type_ != static_cast<int>(engine::EngineType::FAISS_PQ) &&
+            file_->engine_type_ != static_cast<int>(engine::EngineType::FAISS_PQ_FASTSCAN)) {
             ascending_reduce = false;
         }
 
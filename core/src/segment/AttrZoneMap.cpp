@@ -0,0 +1,402 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/AttrZoneMap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "knowhere/index/structured_index/StructuredIndexBitmap.h"
+#include "knowhere/index/structured_index/StructuredIndexSort.h"
+
+namespace milvus {
+namespace segment {
+
+namespace {
+
+constexpr uint32_t ZONE_MAP_VERSION = 1;
+
+struct ZoneMapHeader {
+    uint32_t version_;
+    int32_t data_type_;
+    int64_t row_count_;
+    int64_t block_rows_;
+    int64_t block_count_;
+};
+
+template <typename T>
+AttrZoneMapPtr
+BuildFromIndex(const knowhere::IndexPtr& index, engine::meta::hybrid::DataType data_type, int64_t block_rows) {
+    auto sort_index = std::dynamic_pointer_cast<knowhere::StructuredIndexSort<T>>(index);
+    auto bitmap_index = std::dynamic_pointer_cast<knowhere::StructuredIndexBitmap<T>>(index);
+    if (sort_index == nullptr && bitmap_index == nullptr) {
+        return nullptr;
+    }
+
+    // both indexes visit the rows in value order, the first time a block is seen gives its min and the last time
+    // its max
+    const int64_t row_count = sort_index ? sort_index->GetData().size() : bitmap_index->Count();
+    const int64_t block_count = (row_count + block_rows - 1) / block_rows;
+    std::vector<T> mins(block_count), maxs(block_count);
+    std::vector<bool> seen(block_count, false);
+    auto visit = [&](int64_t row, T value) {
+        auto block = row / block_rows;
+        if (!seen[block]) {
+            mins[block] = value;
+            seen[block] = true;
+        }
+        maxs[block] = value;
+    };
+    if (sort_index) {
+        for (auto& item : sort_index->GetData()) {
+            visit(item.idx_, item.a_);
+        }
+    } else {
+        auto& values = bitmap_index->GetValues();
+        const int64_t words = (row_count + 63) / 64;
+        for (size_t i = 0; i < values.size(); ++i) {
+            auto bitmap = bitmap_index->GetBitmap(i);
+            for (int64_t w = 0; w < words; ++w) {
+                for (uint64_t bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+                    visit(w * 64 + __builtin_ctzll(bits), values[i]);
+                }
+            }
+        }
+    }
+
+    std::vector<AttrZoneMap::Value> min_values(block_count), max_values(block_count);
+    for (int64_t i = 0; i < block_count; ++i) {
+        if (std::is_floating_point<T>::value) {
+            min_values[i].f_ = mins[i];
+            max_values[i].f_ = maxs[i];
+        } else {
+            min_values[i].i_ = mins[i];
+            max_values[i].i_ = maxs[i];
+        }
+    }
+    return std::make_shared<AttrZoneMap>(data_type, row_count, block_rows, std::move(min_values),
+                                         std::move(max_values));
+}
+
+template <typename T>
+bool
+TermMayMatch(const std::vector<uint8_t>& field_value, T min, T max) {
+    size_t term_size = field_value.size() / sizeof(T);
+    for (size_t i = 0; i < term_size; ++i) {
+        T value;
+        memcpy(&value, field_value.data() + i * sizeof(T), sizeof(T));
+        if (min <= value && value <= max) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+AttrZoneMap::AttrZoneMap(engine::meta::hybrid::DataType data_type, int64_t row_count, int64_t block_rows,
+                         std::vector<Value> mins, std::vector<Value> maxs)
+    : data_type_(data_type),
+      row_count_(row_count),
+      block_rows_(block_rows),
+      mins_(std::move(mins)),
+      maxs_(std::move(maxs)) {
+}
+
+AttrZoneMapPtr
+AttrZoneMap::Build(const knowhere::IndexPtr& index, engine::meta::hybrid::DataType data_type, int64_t block_rows) {
+    switch (data_type) {
+        case engine::meta::hybrid::DataType::INT8:
+            return BuildFromIndex<int8_t>(index, data_type, block_rows);
+        case engine::meta::hybrid::DataType::INT16:
+            return BuildFromIndex<int16_t>(index, data_type, block_rows);
+        case engine::meta::hybrid::DataType::INT32:
+            return BuildFromIndex<int32_t>(index, data_type, block_rows);
+        case engine::meta::hybrid::DataType::INT64:
+            return BuildFromIndex<int64_t>(index, data_type, block_rows);
+        case engine::meta::hybrid::DataType::FLOAT:
+            return BuildFromIndex<float>(index, data_type, block_rows);
+        case engine::meta::hybrid::DataType::DOUBLE:
+            return BuildFromIndex<double>(index, data_type, block_rows);
+        default:
+            return nullptr;
+    }
+}
+
+bool
+AttrZoneMap::IsFloat() const {
+    return data_type_ == engine::meta::hybrid::DataType::FLOAT || data_type_ == engine::meta::hybrid::DataType::DOUBLE;
+}
+
+AttrZoneMap::Value
+AttrZoneMap::ParseOperand(const std::string& operand) const {
+    Value value;
+    switch (data_type_) {
+        case engine::meta::hybrid::DataType::INT8:
+            value.i_ = (int8_t)atoi(operand.c_str());
+            break;
+        case engine::meta::hybrid::DataType::INT16:
+            value.i_ = (int16_t)atoi(operand.c_str());
+            break;
+        case engine::meta::hybrid::DataType::INT32:
+        case engine::meta::hybrid::DataType::INT64:
+            value.i_ = atoi(operand.c_str());
+            break;
+        case engine::meta::hybrid::DataType::FLOAT: {
+            std::istringstream iss(operand);
+            float float_value = 0;
+            iss >> float_value;
+            value.f_ = float_value;
+            break;
+        }
+        default: {
+            std::istringstream iss(operand);
+            value.f_ = 0;
+            iss >> value.f_;
+            break;
+        }
+    }
+    return value;
+}
+
+template <typename T>
+bool
+AttrZoneMap::BoundsMayMatch(T min, T max, T operand, query::CompareOperator op) {
+    switch (op) {
+        case query::CompareOperator::LT:
+            return min < operand;
+        case query::CompareOperator::LTE:
+            return min <= operand;
+        case query::CompareOperator::GT:
+            return max > operand;
+        case query::CompareOperator::GTE:
+            return max >= operand;
+        case query::CompareOperator::EQ:
+            return min <= operand && operand <= max;
+        case query::CompareOperator::NE:
+            return !(min == max && min == operand);
+        default:
+            return true;
+    }
+}
+
+bool
+AttrZoneMap::BlockMayMatch(int64_t block, const std::vector<query::CompareExpr>& exprs) const {
+    for (auto& expr : exprs) {
+        Value operand = ParseOperand(expr.operand);
+        auto op = expr.compare_operator;
+        bool may_match = IsFloat() ? BoundsMayMatch(mins_[block].f_, maxs_[block].f_, operand.f_, op)
+                                   : BoundsMayMatch(mins_[block].i_, maxs_[block].i_, operand.i_, op);
+        if (!may_match) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+AttrZoneMap::MayMatch(const std::vector<query::CompareExpr>& exprs) const {
+    for (int64_t block = 0; block < GetBlockCount(); ++block) {
+        if (BlockMayMatch(block, exprs)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+AttrZoneMap::MayMatchTerm(const std::vector<uint8_t>& field_value) const {
+    for (int64_t block = 0; block < GetBlockCount(); ++block) {
+        bool may_match = true;
+        auto min = mins_[block];
+        auto max = maxs_[block];
+        switch (data_type_) {
+            case engine::meta::hybrid::DataType::INT8:
+                may_match = TermMayMatch<int8_t>(field_value, min.i_, max.i_);
+                break;
+            case engine::meta::hybrid::DataType::INT16:
+                may_match = TermMayMatch<int16_t>(field_value, min.i_, max.i_);
+                break;
+            case engine::meta::hybrid::DataType::INT32:
+                may_match = TermMayMatch<int32_t>(field_value, min.i_, max.i_);
+                break;
+            case engine::meta::hybrid::DataType::INT64:
+                may_match = TermMayMatch<int64_t>(field_value, min.i_, max.i_);
+                break;
+            case engine::meta::hybrid::DataType::FLOAT:
+                may_match = TermMayMatch<float>(field_value, min.f_, max.f_);
+                break;
+            case engine::meta::hybrid::DataType::DOUBLE:
+                may_match = TermMayMatch<double>(field_value, min.f_, max.f_);
+                break;
+            default:
+                break;
+        }
+        if (may_match) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+AttrZoneMap::GetBounds(std::string& min, std::string& max) const {
+    if (mins_.empty()) {
+        return false;
+    }
+
+    if (IsFloat()) {
+        double min_value = mins_[0].f_, max_value = maxs_[0].f_;
+        for (size_t i = 1; i < mins_.size(); ++i) {
+            min_value = std::min(min_value, mins_[i].f_);
+            max_value = std::max(max_value, maxs_[i].f_);
+        }
+        // 17 digits round trip any double
+        std::ostringstream min_oss, max_oss;
+        min_oss << std::setprecision(17) << min_value;
+        max_oss << std::setprecision(17) << max_value;
+        min = min_oss.str();
+        max = max_oss.str();
+    } else {
+        int64_t min_value = mins_[0].i_, max_value = maxs_[0].i_;
+        for (size_t i = 1; i < mins_.size(); ++i) {
+            min_value = std::min(min_value, mins_[i].i_);
+            max_value = std::max(max_value, maxs_[i].i_);
+        }
+        min = std::to_string(min_value);
+        max = std::to_string(max_value);
+    }
+    return true;
+}
+
+AttrZoneMapPtr
+AttrZoneMap::FromBounds(engine::meta::hybrid::DataType data_type, int64_t row_count, const std::string& min,
+                        const std::string& max) {
+    if (row_count <= 0) {
+        return nullptr;
+    }
+
+    Value min_value, max_value;
+    try {
+        switch (data_type) {
+            case engine::meta::hybrid::DataType::INT8:
+            case engine::meta::hybrid::DataType::INT16:
+            case engine::meta::hybrid::DataType::INT32:
+            case engine::meta::hybrid::DataType::INT64:
+                min_value.i_ = std::stoll(min);
+                max_value.i_ = std::stoll(max);
+                break;
+            case engine::meta::hybrid::DataType::FLOAT:
+            case engine::meta::hybrid::DataType::DOUBLE:
+                min_value.f_ = std::stod(min);
+                max_value.f_ = std::stod(max);
+                break;
+            default:
+                return nullptr;
+        }
+    } catch (std::exception& ex) {
+        return nullptr;
+    }
+    return std::make_shared<AttrZoneMap>(data_type, row_count, row_count, std::vector<Value>{min_value},
+                                         std::vector<Value>{max_value});
+}
+
+void
+AttrZoneMap::Serialize(std::vector<uint8_t>& data) const {
+    ZoneMapHeader header{ZONE_MAP_VERSION, (int32_t)data_type_, row_count_, block_rows_, GetBlockCount()};
+    size_t bounds_size = mins_.size() * sizeof(Value);
+    data.resize(sizeof(header) + 2 * bounds_size);
+    memcpy(data.data(), &header, sizeof(header));
+    memcpy(data.data() + sizeof(header), mins_.data(), bounds_size);
+    memcpy(data.data() + sizeof(header) + bounds_size, maxs_.data(), bounds_size);
+}
+
+AttrZoneMapPtr
+AttrZoneMap::Deserialize(const uint8_t* data, size_t size) {
+    ZoneMapHeader header;
+    if (size < sizeof(header)) {
+        return nullptr;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.version_ != ZONE_MAP_VERSION || header.block_rows_ <= 0 || header.block_count_ < 0 ||
+        header.block_count_ != (header.row_count_ + header.block_rows_ - 1) / header.block_rows_ ||
+        size != sizeof(header) + 2 * header.block_count_ * sizeof(Value)) {
+        return nullptr;
+    }
+
+    std::vector<Value> mins(header.block_count_), maxs(header.block_count_);
+    size_t bounds_size = header.block_count_ * sizeof(Value);
+    memcpy(mins.data(), data + sizeof(header), bounds_size);
+    memcpy(maxs.data(), data + sizeof(header) + bounds_size, bounds_size);
+    return std::make_shared<AttrZoneMap>((engine::meta::hybrid::DataType)header.data_type_, header.row_count_,
+                                         header.block_rows_, std::move(mins), std::move(maxs));
+}
+
+bool
+QueryMayMatch(const query::GeneralQueryPtr& general_query,
+              const std::function<bool(const query::LeafQuery& leaf)>& leaf_may_match) {
+    if (general_query == nullptr) {
+        return true;
+    }
+
+    if (general_query->leaf == nullptr) {
+        if (general_query->bin == nullptr) {
+            return true;
+        }
+        auto left = general_query->bin->left_query;
+        auto right = general_query->bin->right_query;
+        if (left == nullptr || right == nullptr) {
+            return QueryMayMatch(left != nullptr ? left : right, leaf_may_match);
+        }
+        switch (general_query->bin->relation) {
+            case query::QueryRelation::AND:
+            case query::QueryRelation::R1:
+                return QueryMayMatch(left, leaf_may_match) && QueryMayMatch(right, leaf_may_match);
+            case query::QueryRelation::R4:
+                return QueryMayMatch(left, leaf_may_match);
+            default:
+                return QueryMayMatch(left, leaf_may_match) || QueryMayMatch(right, leaf_may_match);
+        }
+    }
+    return leaf_may_match(*general_query->leaf);
+}
+
+bool
+ZoneMapsMayMatch(const AttrZoneMaps& zone_maps, const query::GeneralQueryPtr& general_query) {
+    return QueryMayMatch(general_query, [&](const query::LeafQuery& leaf) {
+        if (leaf.term_query != nullptr) {
+            auto iter = zone_maps.find(leaf.term_query->field_name);
+            if (iter != zone_maps.end() && !iter->second->MayMatchTerm(leaf.term_query->field_value)) {
+                return false;
+            }
+        }
+        if (leaf.range_query != nullptr) {
+            auto iter = zone_maps.find(leaf.range_query->field_name);
+            if (iter != zone_maps.end() && !iter->second->MayMatch(leaf.range_query->compare_expr)) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+}  // namespace segment
+}  // namespace milvus
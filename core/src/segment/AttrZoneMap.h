@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "db/meta/MetaTypes.h"
+#include "knowhere/index/Index.h"
+#include "query/GeneralQuery.h"
+
+namespace milvus {
+namespace segment {
+
+class AttrZoneMap;
+using AttrZoneMapPtr = std::shared_ptr<AttrZoneMap>;
+// field name -> zone map
+using AttrZoneMaps = std::unordered_map<std::string, AttrZoneMapPtr>;
+
+/*
+ * Min/max of an attribute per block of rows. Range and term predicates ruled out by the bounds of every
+ * block can skip the attribute index, or the whole segment before anything of it is loaded.
+ * Integer attributes keep their bounds as int64 and float attributes as double, so the checks are exact.
+ * There are no null counts, attributes are never null in this version.
+ */
+class AttrZoneMap {
+ public:
+    static constexpr int64_t DEFAULT_BLOCK_ROWS = 4096;
+
+    union Value {
+        int64_t i_;
+        double f_;
+    };
+
+    AttrZoneMap(engine::meta::hybrid::DataType data_type, int64_t row_count, int64_t block_rows,
+                std::vector<Value> mins, std::vector<Value> maxs);
+
+    // build from the structured index of the attribute, return nullptr if it is neither a StructuredIndexSort
+    // nor a StructuredIndexBitmap
+    static AttrZoneMapPtr
+    Build(const knowhere::IndexPtr& index, engine::meta::hybrid::DataType data_type,
+          int64_t block_rows = DEFAULT_BLOCK_ROWS);
+
+    // whether some row of the block may satisfy all the compare expressions
+    bool
+    BlockMayMatch(int64_t block, const std::vector<query::CompareExpr>& exprs) const;
+
+    // whether some row of the segment may satisfy all the compare expressions
+    bool
+    MayMatch(const std::vector<query::CompareExpr>& exprs) const;
+
+    // whether some row may equal one of the term values, field_value holds them as raw values of the data type
+    bool
+    MayMatchTerm(const std::vector<uint8_t>& field_value) const;
+
+    // bounds of all the rows as text exact for the data type, false if there are no rows
+    bool
+    GetBounds(std::string& min, std::string& max) const;
+
+    // a zone map of a single block from the bounds given by GetBounds, nullptr if they are not valid
+    static AttrZoneMapPtr
+    FromBounds(engine::meta::hybrid::DataType data_type, int64_t row_count, const std::string& min,
+               const std::string& max);
+
+    void
+    Serialize(std::vector<uint8_t>& data) const;
+
+    // return nullptr if data is not a valid zone map
+    static AttrZoneMapPtr
+    Deserialize(const uint8_t* data, size_t size);
+
+    engine::meta::hybrid::DataType
+    GetDataType() const {
+        return data_type_;
+    }
+
+    int64_t
+    GetRowCount() const {
+        return row_count_;
+    }
+
+    int64_t
+    GetBlockRows() const {
+        return block_rows_;
+    }
+
+    int64_t
+    GetBlockCount() const {
+        return mins_.size();
+    }
+
+ private:
+    bool
+    IsFloat() const;
+
+    // parse the operand the same way the range query does for the data type
+    Value
+    ParseOperand(const std::string& operand) const;
+
+    // whether some value in [min, max] may satisfy "value op operand"
+    template <typename T>
+    static bool
+    BoundsMayMatch(T min, T max, T operand, query::CompareOperator op);
+
+ private:
+    engine::meta::hybrid::DataType data_type_;
+    int64_t row_count_;
+    int64_t block_rows_;
+    std::vector<Value> mins_;
+    std::vector<Value> maxs_;
+};
+
+// whether some row may satisfy the query, given whether some row may satisfy each leaf of it
+bool
+QueryMayMatch(const query::GeneralQueryPtr& general_query,
+              const std::function<bool(const query::LeafQuery& leaf)>& leaf_may_match);
+
+// whether some row may satisfy the query, by the zone maps of the fields, a field without one may always match
+bool
+ZoneMapsMayMatch(const AttrZoneMaps& zone_maps, const query::GeneralQueryPtr& general_query);
+
+}  // namespace segment
+}  // namespace milvus
@@ -0,0 +1,164 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/BlockedBloomFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace milvus {
+namespace segment {
+
+namespace {
+
+constexpr uint32_t SALTS[BlockedBloomFilter::BLOCK_WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                             0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+constexpr size_t PREFETCH_BATCH = 16;
+
+uint64_t
+Hash(int64_t key) {
+    // finalizer of murmur3, the ids are often sequential
+    auto h = static_cast<uint64_t>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+void
+MakeMask(uint64_t hash, uint32_t mask[BlockedBloomFilter::BLOCK_WORDS]) {
+    auto key = static_cast<uint32_t>(hash);
+    for (size_t i = 0; i < BlockedBloomFilter::BLOCK_WORDS; ++i) {
+        mask[i] = 1U << ((key * SALTS[i]) >> 27);
+    }
+}
+
+}  // namespace
+
+BlockedBloomFilter::BlockedBloomFilter(size_t capacity, double error_rate) {
+    // bits per key of a split block filter to reach the error rate, see "Cache-, Hash- and Space-Efficient
+    // Bloom Filters" by Putze et al.
+    error_rate = std::min(std::max(error_rate, 1e-6), 0.5);
+    double bits = -8.0 * std::max(capacity, (size_t)1) / std::log(1.0 - std::pow(error_rate, 1.0 / 8));
+    auto num_blocks = static_cast<size_t>(std::ceil(bits / (BLOCK_WORDS * 32)));
+    blocks_.resize(std::max(num_blocks, (size_t)1), Block{});
+}
+
+size_t
+BlockedBloomFilter::BlockIndex(uint64_t hash) const {
+    // maps the upper 32 bits onto [0, blocks) without a division
+    return ((hash >> 32) * blocks_.size()) >> 32;
+}
+
+void
+BlockedBloomFilter::Add(int64_t key) {
+    auto hash = Hash(key);
+    uint32_t mask[BLOCK_WORDS];
+    MakeMask(hash, mask);
+    auto& block = blocks_[BlockIndex(hash)];
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+        block.words_[i] |= mask[i];
+    }
+}
+
+bool
+BlockedBloomFilter::Check(int64_t key) const {
+    auto hash = Hash(key);
+    uint32_t mask[BLOCK_WORDS];
+    MakeMask(hash, mask);
+    auto& block = blocks_[BlockIndex(hash)];
+    uint32_t missing = 0;
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+        missing |= ~block.words_[i] & mask[i];
+    }
+    return missing == 0;
+}
+
+void
+BlockedBloomFilter::CheckMany(const std::vector<int64_t>& keys, std::vector<bool>& found) const {
+    found.resize(keys.size());
+    uint64_t hashes[PREFETCH_BATCH];
+    for (size_t begin = 0; begin < keys.size(); begin += PREFETCH_BATCH) {
+        size_t n = std::min(PREFETCH_BATCH, keys.size() - begin);
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = Hash(keys[begin + i]);
+            __builtin_prefetch(&blocks_[BlockIndex(hashes[i])]);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t mask[BLOCK_WORDS];
+            MakeMask(hashes[i], mask);
+            auto& block = blocks_[BlockIndex(hashes[i])];
+            uint32_t missing = 0;
+            for (size_t j = 0; j < BLOCK_WORDS; ++j) {
+                missing |= ~block.words_[j] & mask[j];
+            }
+            found[begin + i] = (missing == 0);
+        }
+    }
+}
+
+BlockedBloomFilter
+BlockedBloomFilter::EmptyCopy() const {
+    BlockedBloomFilter copy;
+    copy.blocks_.resize(blocks_.size(), Block{});
+    return copy;
+}
+
+bool
+BlockedBloomFilter::Merge(const BlockedBloomFilter& other) {
+    if (other.blocks_.size() != blocks_.size()) {
+        return false;
+    }
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+            blocks_[b].words_[i] |= other.blocks_[b].words_[i];
+        }
+    }
+    return true;
+}
+
+void
+BlockedBloomFilter::Serialize(std::vector<uint8_t>& buffer) const {
+    uint64_t num_blocks = blocks_.size();
+    auto offset = buffer.size();
+    buffer.resize(offset + sizeof(num_blocks) + NumBytes());
+    memcpy(buffer.data() + offset, &num_blocks, sizeof(num_blocks));
+    memcpy(buffer.data() + offset + sizeof(num_blocks), blocks_.data(), NumBytes());
+}
+
+bool
+BlockedBloomFilter::Deserialize(const uint8_t* data, size_t size) {
+    uint64_t num_blocks;
+    if (size < sizeof(num_blocks)) {
+        return false;
+    }
+    memcpy(&num_blocks, data, sizeof(num_blocks));
+    if (num_blocks == 0 || (size - sizeof(num_blocks)) / sizeof(Block) != num_blocks ||
+        (size - sizeof(num_blocks)) % sizeof(Block) != 0) {
+        return false;
+    }
+    blocks_.resize(num_blocks);
+    memcpy(blocks_.data(), data + sizeof(num_blocks), num_blocks * sizeof(Block));
+    return true;
+}
+
+}  // namespace segment
+}  // namespace milvus
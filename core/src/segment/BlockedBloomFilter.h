@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace milvus {
+namespace segment {
+
+/*
+ * Split block bloom filter of 64-bit keys.
+ * A key maps to one 256-bit block and sets one bit in each of its eight 32-bit words, so a check reads a
+ * single cache line instead of one per hash function. The bit positions are derived from the key hash by
+ * eight multiplications which the compiler turns into vector instructions.
+ * Keys can't be removed.
+ */
+class BlockedBloomFilter {
+ public:
+    static constexpr size_t BLOCK_WORDS = 8;
+
+    BlockedBloomFilter() = default;
+
+    BlockedBloomFilter(size_t capacity, double error_rate);
+
+    void
+    Add(int64_t key);
+
+    bool
+    Check(int64_t key) const;
+
+    // the blocks of a batch are prefetched before they are probed
+    void
+    CheckMany(const std::vector<int64_t>& keys, std::vector<bool>& found) const;
+
+    // a filter of the same size without keys, filled apart and merged back to build a filter by chunks of keys
+    BlockedBloomFilter
+    EmptyCopy() const;
+
+    // add the keys of a filter of the same size, false if the sizes differ
+    bool
+    Merge(const BlockedBloomFilter& other);
+
+    size_t
+    NumBytes() const {
+        return blocks_.size() * sizeof(Block);
+    }
+
+    void
+    Serialize(std::vector<uint8_t>& buffer) const;
+
+    // returns false if the data is malformed
+    bool
+    Deserialize(const uint8_t* data, size_t size);
+
+ private:
+    struct alignas(32) Block {
+        uint32_t words_[BLOCK_WORDS];
+    };
+
+    size_t
+    BlockIndex(uint64_t hash) const;
+
+    std::vector<Block> blocks_;
+};
+
+using BlockedBloomFilterPtr = std::shared_ptr<BlockedBloomFilter>;
+
+}  // namespace segment
+}  // namespace milvus
@@ -17,22 +17,46 @@
 
 #include "segment/DeletedDocs.h"
 
+#include <utility>
+
 namespace milvus {
 namespace segment {
 
-DeletedDocs::DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets) : deleted_doc_offsets_(deleted_doc_offsets) {
+DeletedDocs::DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets) {
+    for (auto offset : deleted_doc_offsets) {
+        deleted_docs_.Add(offset);
+    }
+    offsets_ready_ = false;
+}
+
+DeletedDocs::DeletedDocs(RoaringBitmap&& deleted_docs) : deleted_docs_(std::move(deleted_docs)) {
+    offsets_ready_ = false;
 }
 
 void
 DeletedDocs::AddDeletedDoc(offset_t offset) {
-    deleted_doc_offsets_.emplace_back(offset);
+    std::lock_guard<std::mutex> lock(offsets_mutex_);
+    deleted_docs_.Add(offset);
+    offsets_ready_ = false;
 }
 
 const std::vector<offset_t>&
 DeletedDocs::GetDeletedDocs() const {
+    std::lock_guard<std::mutex> lock(offsets_mutex_);
+    if (!offsets_ready_) {
+        deleted_doc_offsets_.clear();
+        deleted_doc_offsets_.reserve(deleted_docs_.Cardinality());
+        deleted_docs_.ForEach([&](uint32_t offset) { deleted_doc_offsets_.push_back(offset); });
+        offsets_ready_ = true;
+    }
     return deleted_doc_offsets_;
 }
 
+const RoaringBitmap&
+DeletedDocs::GetBitmap() const {
+    return deleted_docs_;
+}
+
 // const std::string&
 // DeletedDocs::GetName() const {
 //    return name_;
@@ -40,7 +64,13 @@ DeletedDocs::GetDeletedDocs() const {
 
 size_t
 DeletedDocs::GetSize() const {
-    return deleted_doc_offsets_.size();
+    return deleted_docs_.Cardinality();
+}
+
+void
+DeletedDocs::GetBitset(int64_t count, faiss::ConcurrentBitsetPtr& bitset) const {
+    bitset = std::make_shared<faiss::ConcurrentBitset>(count);
+    deleted_docs_.SetBits(bitset->mutable_data(), count);
 }
 
 }  // namespace segment
@@ -17,9 +17,14 @@
 
 #pragma once
 
+#include <faiss/utils/ConcurrentBitset.h>
+
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include "segment/RoaringBitmap.h"
+
 namespace milvus {
 namespace segment {
 
@@ -29,14 +34,20 @@ class DeletedDocs {
  public:
     explicit DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets);
 
+    explicit DeletedDocs(RoaringBitmap&& deleted_docs);
+
     DeletedDocs() = default;
 
     void
     AddDeletedDoc(offset_t offset);
 
+    // sorted and without duplicates, built from the bitmap on the first call
     const std::vector<offset_t>&
     GetDeletedDocs() const;
 
+    const RoaringBitmap&
+    GetBitmap() const;
+
     //    // TODO
     //    const std::string&
     //    GetName() const;
@@ -44,8 +55,9 @@ class DeletedDocs {
     size_t
     GetSize() const;
 
-    //    void
-    //    GetBitset(faiss::ConcurrentBitsetPtr& bitset);
+    // dense blacklist of count entities, the deleted docs beyond count are ignored
+    void
+    GetBitset(int64_t count, faiss::ConcurrentBitsetPtr& bitset) const;
 
     // No copy and move
     DeletedDocs(const DeletedDocs&) = delete;
@@ -57,8 +69,11 @@ class DeletedDocs {
     operator=(DeletedDocs&&) = delete;
 
  private:
-    std::vector<offset_t> deleted_doc_offsets_;
-    //    faiss::ConcurrentBitsetPtr bitset_;
+    RoaringBitmap deleted_docs_;
+
+    mutable std::mutex offsets_mutex_;
+    mutable std::vector<offset_t> deleted_doc_offsets_;
+    mutable bool offsets_ready_ = true;
     //    const std::string name_ = "deleted_docs";
 };
 
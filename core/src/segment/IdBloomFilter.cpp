@@ -19,14 +19,28 @@
 #include "utils/Log.h"
 #include "utils/Status.h"
 
+#include <algorithm>
+#include <future>
 #include <string>
+#include <thread>
+#include <utility>
 
 namespace milvus {
 namespace segment {
 
+namespace {
+
+// uids a thread adds at least, below the filter is filled by the calling thread
+constexpr size_t MIN_CHUNK_UIDS = 65536;
+
+}  // namespace
+
 IdBloomFilter::IdBloomFilter(scaling_bloom_t* bloom_filter) : bloom_filter_(bloom_filter) {
 }
 
+IdBloomFilter::IdBloomFilter(BlockedBloomFilterPtr blocked_filter) : blocked_filter_(std::move(blocked_filter)) {
+}
+
 IdBloomFilter::~IdBloomFilter() {
     const std::lock_guard<std::mutex> lock(mutex_);
     if (bloom_filter_) {
@@ -40,15 +54,44 @@ IdBloomFilter::GetBloomFilter() {
     return bloom_filter_;
 }
 
+BlockedBloomFilterPtr
+IdBloomFilter::GetBlockedBloomFilter() {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return blocked_filter_;
+}
+
 bool
 IdBloomFilter::Check(doc_id_t uid) {
+    if (blocked_filter_) {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        return blocked_filter_->Check(uid);
+    }
     std::string s = std::to_string(uid);
     const std::lock_guard<std::mutex> lock(mutex_);
     return scaling_bloom_check(bloom_filter_, s.c_str(), s.size());
 }
 
+void
+IdBloomFilter::CheckMany(const std::vector<doc_id_t>& uids, std::vector<bool>& found) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (blocked_filter_) {
+        blocked_filter_->CheckMany(uids, found);
+        return;
+    }
+    found.resize(uids.size());
+    for (size_t i = 0; i < uids.size(); ++i) {
+        std::string s = std::to_string(uids[i]);
+        found[i] = scaling_bloom_check(bloom_filter_, s.c_str(), s.size());
+    }
+}
+
 Status
 IdBloomFilter::Add(doc_id_t uid) {
+    if (blocked_filter_) {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        blocked_filter_->Add(uid);
+        return Status::OK();
+    }
     std::string s = std::to_string(uid);
     const std::lock_guard<std::mutex> lock(mutex_);
     if (scaling_bloom_add(bloom_filter_, s.c_str(), s.size(), uid) == -1) {
@@ -59,8 +102,48 @@ IdBloomFilter::Add(doc_id_t uid) {
     return Status::OK();
 }
 
+Status
+IdBloomFilter::AddMany(const std::vector<doc_id_t>& uids) {
+    if (blocked_filter_ == nullptr) {
+        for (auto uid : uids) {
+            Add(uid);
+        }
+        return Status::OK();
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    size_t chunks = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), uids.size() / MIN_CHUNK_UIDS);
+    if (chunks <= 1) {
+        for (auto uid : uids) {
+            blocked_filter_->Add(uid);
+        }
+        return Status::OK();
+    }
+
+    // the blocks are only ever or-ed, the chunks fill empty filters of the same size which are merged
+    std::vector<BlockedBloomFilter> filters(chunks);
+    std::vector<std::future<void>> futures;
+    for (size_t c = 0; c < chunks; ++c) {
+        futures.push_back(std::async(std::launch::async, [&, c] {
+            filters[c] = blocked_filter_->EmptyCopy();
+            size_t end = uids.size() * (c + 1) / chunks;
+            for (size_t i = uids.size() * c / chunks; i < end; ++i) {
+                filters[c].Add(uids[i]);
+            }
+        }));
+    }
+    for (size_t c = 0; c < chunks; ++c) {
+        futures[c].get();
+        blocked_filter_->Merge(filters[c]);
+    }
+    return Status::OK();
+}
+
 Status
 IdBloomFilter::Remove(doc_id_t uid) {
+    if (blocked_filter_) {
+        return Status::OK();
+    }
     std::string s = std::to_string(uid);
     const std::lock_guard<std::mutex> lock(mutex_);
     if (scaling_bloom_remove(bloom_filter_, s.c_str(), s.size(), uid) == -1) {
@@ -78,6 +161,9 @@ IdBloomFilter::Remove(doc_id_t uid) {
 
 size_t
 IdBloomFilter::Size() {
+    if (blocked_filter_) {
+        return blocked_filter_->NumBytes();
+    }
     return bloom_filter_->num_bytes;
 }
 
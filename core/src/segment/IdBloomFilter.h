@@ -19,8 +19,10 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "dablooms/dablooms.h"
+#include "segment/BlockedBloomFilter.h"
 #include "utils/Status.h"
 
 namespace milvus {
@@ -32,17 +34,32 @@ class IdBloomFilter {
  public:
     explicit IdBloomFilter(scaling_bloom_t* bloom_filter);
 
+    explicit IdBloomFilter(BlockedBloomFilterPtr blocked_filter);
+
     ~IdBloomFilter();
 
+    // nullptr if the filter is a blocked one
     scaling_bloom_t*
     GetBloomFilter();
 
+    BlockedBloomFilterPtr
+    GetBlockedBloomFilter();
+
     bool
     Check(doc_id_t uid);
 
+    // found[i] tells whether uids[i] may be present
+    void
+    CheckMany(const std::vector<doc_id_t>& uids, std::vector<bool>& found);
+
     Status
     Add(doc_id_t uid);
 
+    // a blocked filter is filled by chunks of the uids on their own threads
+    Status
+    AddMany(const std::vector<doc_id_t>& uids);
+
+    // a blocked filter keeps the removed uid, which only costs a lookup of the uids later
     Status
     Remove(doc_id_t uid);
 
@@ -62,7 +79,8 @@ class IdBloomFilter {
     operator=(IdBloomFilter&&) = delete;
 
  private:
-    scaling_bloom_t* bloom_filter_;
+    scaling_bloom_t* bloom_filter_ = nullptr;
+    BlockedBloomFilterPtr blocked_filter_;
     //    const std::string name_ = "bloom_filter";
     std::mutex mutex_;
 };
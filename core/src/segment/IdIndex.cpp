@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/IdIndex.h"
+
+#include <cstring>
+
+namespace milvus {
+namespace segment {
+
+namespace {
+
+constexpr size_t MIN_SLOTS = 16;
+
+uint64_t
+Hash(doc_id_t uid) {
+    // finalizer of murmur3, the ids are often sequential
+    auto h = static_cast<uint64_t>(uid);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace
+
+IdIndex::IdIndex(const std::vector<doc_id_t>& uids) {
+    size_t num_slots = MIN_SLOTS;
+    while (num_slots < uids.size() * 2) {
+        num_slots <<= 1;
+    }
+    slots_.resize(num_slots, Slot{0, -1});
+
+    size_t mask = num_slots - 1;
+    for (size_t offset = 0; offset < uids.size(); ++offset) {
+        auto uid = uids[offset];
+        for (size_t i = Hash(uid) & mask;; i = (i + 1) & mask) {
+            if (slots_[i].offset_ == -1) {
+                slots_[i] = Slot{uid, static_cast<int64_t>(offset)};
+                ++count_;
+                break;
+            }
+            if (slots_[i].uid_ == uid) {
+                break;
+            }
+        }
+    }
+}
+
+bool
+IdIndex::Find(doc_id_t uid, int64_t& offset) const {
+    if (slots_.empty()) {
+        return false;
+    }
+
+    size_t mask = slots_.size() - 1;
+    for (size_t i = Hash(uid) & mask;; i = (i + 1) & mask) {
+        auto& slot = slots_[i];
+        if (slot.offset_ == -1) {
+            return false;
+        }
+        if (slot.uid_ == uid) {
+            offset = slot.offset_;
+            return true;
+        }
+    }
+}
+
+void
+IdIndex::Serialize(std::vector<uint8_t>& buffer) const {
+    uint64_t num_slots = slots_.size();
+    auto offset = buffer.size();
+    buffer.resize(offset + sizeof(num_slots) + num_slots * sizeof(Slot));
+    memcpy(buffer.data() + offset, &num_slots, sizeof(num_slots));
+    memcpy(buffer.data() + offset + sizeof(num_slots), slots_.data(), num_slots * sizeof(Slot));
+}
+
+bool
+IdIndex::Deserialize(const uint8_t* data, size_t size) {
+    uint64_t num_slots;
+    if (size < sizeof(num_slots)) {
+        return false;
+    }
+    memcpy(&num_slots, data, sizeof(num_slots));
+    // the table must be a power of two and keep an empty slot to stop probing
+    if (num_slots < MIN_SLOTS || (num_slots & (num_slots - 1)) != 0 ||
+        (size - sizeof(num_slots)) / sizeof(Slot) != num_slots || (size - sizeof(num_slots)) % sizeof(Slot) != 0) {
+        return false;
+    }
+    slots_.resize(num_slots);
+    memcpy(slots_.data(), data + sizeof(num_slots), num_slots * sizeof(Slot));
+
+    count_ = 0;
+    for (auto& slot : slots_) {
+        if (slot.offset_ != -1) {
+            ++count_;
+        }
+    }
+    return count_ < static_cast<int64_t>(num_slots);
+}
+
+}  // namespace segment
+}  // namespace milvus
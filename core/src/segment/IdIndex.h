@@ -17,14 +17,67 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
-#include "AttrIndex.h"
+#include "cache/DataObj.h"
+#include "segment/IdBloomFilter.h"
 
 namespace milvus {
 namespace segment {
 
-class IdIndex : public AttrIndex {};
+/*
+ * Maps the ids of a segment to their offsets.
+ * An open addressing table with linear probing, at most half full, its slots are persisted as they are so
+ * loading it doesn't rehash anything. An id inserted more than once maps to its first offset.
+ */
+class IdIndex : public cache::DataObj {
+ public:
+    IdIndex() = default;
+
+    explicit IdIndex(const std::vector<doc_id_t>& uids);
+
+    // returns false if uid is not in the segment
+    bool
+    Find(doc_id_t uid, int64_t& offset) const;
+
+    int64_t
+    Count() const {
+        return count_;
+    }
+
+    int64_t
+    Size() override {
+        return slots_.size() * sizeof(Slot);
+    }
+
+    void
+    Serialize(std::vector<uint8_t>& buffer) const;
+
+    // returns false if the data is malformed
+    bool
+    Deserialize(const uint8_t* data, size_t size);
+
+    // No copy and move
+    IdIndex(const IdIndex&) = delete;
+    IdIndex(IdIndex&&) = delete;
+
+    IdIndex&
+    operator=(const IdIndex&) = delete;
+    IdIndex&
+    operator=(IdIndex&&) = delete;
+
+ private:
+    struct Slot {
+        doc_id_t uid_;
+        int64_t offset_;  // -1 marks an empty slot
+    };
+
+    std::vector<Slot> slots_;
+    int64_t count_ = 0;
+};
 
 using IdIndexPtr = std::shared_ptr<IdIndex>;
 
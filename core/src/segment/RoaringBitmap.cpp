@@ -0,0 +1,259 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/RoaringBitmap.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace milvus {
+namespace segment {
+
+constexpr size_t RoaringBitmap::ARRAY_MAX_SIZE;
+constexpr size_t RoaringBitmap::BITMAP_WORDS;
+
+RoaringBitmap::Container*
+RoaringBitmap::FindContainer(uint16_t key, bool create) {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, uint16_t k) { return container.key_ < k; });
+    if (it != containers_.end() && it->key_ == key) {
+        return &(*it);
+    }
+    if (!create) {
+        return nullptr;
+    }
+
+    Container container;
+    container.key_ = key;
+    it = containers_.insert(it, std::move(container));
+    return &(*it);
+}
+
+const RoaringBitmap::Container*
+RoaringBitmap::FindContainer(uint16_t key) const {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, uint16_t k) { return container.key_ < k; });
+    if (it != containers_.end() && it->key_ == key) {
+        return &(*it);
+    }
+    return nullptr;
+}
+
+void
+RoaringBitmap::Add(uint32_t value) {
+    auto container = FindContainer(static_cast<uint16_t>(value >> 16), true);
+    auto low = static_cast<uint16_t>(value & 0xFFFF);
+
+    if (container->IsBitmap()) {
+        auto& word = container->bitmap_[low >> 6];
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if ((word & mask) == 0) {
+            word |= mask;
+            ++container->cardinality_;
+            ++cardinality_;
+        }
+        return;
+    }
+
+    auto& array = container->array_;
+    auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it != array.end() && *it == low) {
+        return;
+    }
+    array.insert(it, low);
+    ++container->cardinality_;
+    ++cardinality_;
+
+    // a full array takes as much space as a bitmap
+    if (array.size() > ARRAY_MAX_SIZE) {
+        container->bitmap_.assign(BITMAP_WORDS, 0);
+        for (auto v : array) {
+            container->bitmap_[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+        std::vector<uint16_t>().swap(array);
+    }
+}
+
+bool
+RoaringBitmap::Contains(uint32_t value) const {
+    auto container = FindContainer(static_cast<uint16_t>(value >> 16));
+    if (container == nullptr) {
+        return false;
+    }
+
+    auto low = static_cast<uint16_t>(value & 0xFFFF);
+    if (container->IsBitmap()) {
+        return (container->bitmap_[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(container->array_.begin(), container->array_.end(), low);
+}
+
+void
+RoaringBitmap::Clear() {
+    containers_.clear();
+    cardinality_ = 0;
+}
+
+void
+RoaringBitmap::ForEach(const std::function<void(uint32_t)>& func) const {
+    for (auto& container : containers_) {
+        uint32_t high = uint32_t(container.key_) << 16;
+        if (!container.IsBitmap()) {
+            for (auto low : container.array_) {
+                func(high | low);
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < BITMAP_WORDS; ++i) {
+            uint64_t word = container.bitmap_[i];
+            while (word != 0) {
+                func(high | uint32_t(i * 64 + __builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+void
+RoaringBitmap::SetBits(uint8_t* bits, size_t size) const {
+    for (auto& container : containers_) {
+        size_t base = size_t(container.key_) << 16;
+        if (base >= size) {
+            break;
+        }
+
+        if (!container.IsBitmap()) {
+            for (auto low : container.array_) {
+                size_t value = base + low;
+                if (value >= size) {
+                    break;
+                }
+                bits[value >> 3] |= uint8_t(1) << (value & 7);
+            }
+            continue;
+        }
+
+        // a chunk is byte aligned, the bytes of whole words are copied
+        size_t words = std::min(BITMAP_WORDS, (size - base) / 64);
+        std::memcpy(bits + (base >> 3), container.bitmap_.data(), words * sizeof(uint64_t));
+        for (size_t value = base + words * 64; value < std::min(size, base + 65536); ++value) {
+            size_t low = value - base;
+            if ((container.bitmap_[low >> 6] >> (low & 63)) & 1) {
+                bits[value >> 3] |= uint8_t(1) << (value & 7);
+            }
+        }
+    }
+}
+
+/*
+ * serialized as:
+ *   uint32 number of chunks
+ *   for each chunk: uint16 key, uint16 cardinality - 1, then the sorted uint16 values if cardinality is at most
+ *   ARRAY_MAX_SIZE, otherwise BITMAP_WORDS uint64 words
+ */
+size_t
+RoaringBitmap::SerializedSize() const {
+    size_t size = sizeof(uint32_t);
+    for (auto& container : containers_) {
+        size += 2 * sizeof(uint16_t);
+        size += container.IsBitmap() ? BITMAP_WORDS * sizeof(uint64_t) : container.array_.size() * sizeof(uint16_t);
+    }
+    return size;
+}
+
+void
+RoaringBitmap::Serialize(std::vector<uint8_t>& buffer) const {
+    auto offset = buffer.size();
+    buffer.resize(offset + SerializedSize());
+    auto ptr = buffer.data() + offset;
+    auto append = [&](const void* data, size_t bytes) {
+        std::memcpy(ptr, data, bytes);
+        ptr += bytes;
+    };
+
+    uint32_t chunks = containers_.size();
+    append(&chunks, sizeof(chunks));
+    for (auto& container : containers_) {
+        uint16_t header[2] = {container.key_, static_cast<uint16_t>(container.cardinality_ - 1)};
+        append(header, sizeof(header));
+        if (container.IsBitmap()) {
+            append(container.bitmap_.data(), BITMAP_WORDS * sizeof(uint64_t));
+        } else {
+            append(container.array_.data(), container.array_.size() * sizeof(uint16_t));
+        }
+    }
+}
+
+bool
+RoaringBitmap::Deserialize(const uint8_t* data, size_t size) {
+    Clear();
+    auto end = data + size;
+    auto take = [&](void* dest, size_t bytes) {
+        if (end - data < static_cast<std::ptrdiff_t>(bytes)) {
+            return false;
+        }
+        std::memcpy(dest, data, bytes);
+        data += bytes;
+        return true;
+    };
+
+    uint32_t chunks = 0;
+    if (!take(&chunks, sizeof(chunks))) {
+        return false;
+    }
+    containers_.reserve(chunks);
+    for (uint32_t i = 0; i < chunks; ++i) {
+        uint16_t header[2];
+        if (!take(header, sizeof(header))) {
+            Clear();
+            return false;
+        }
+        if (!containers_.empty() && header[0] <= containers_.back().key_) {
+            Clear();
+            return false;
+        }
+
+        Container container;
+        container.key_ = header[0];
+        container.cardinality_ = uint32_t(header[1]) + 1;
+        bool ok = false;
+        if (container.cardinality_ > ARRAY_MAX_SIZE) {
+            container.bitmap_.resize(BITMAP_WORDS);
+            ok = take(container.bitmap_.data(), BITMAP_WORDS * sizeof(uint64_t));
+            uint32_t count = 0;
+            for (auto word : container.bitmap_) {
+                count += __builtin_popcountll(word);
+            }
+            ok = ok && (count == container.cardinality_);
+        } else {
+            container.array_.resize(container.cardinality_);
+            ok = take(container.array_.data(), container.cardinality_ * sizeof(uint16_t));
+        }
+        if (!ok) {
+            Clear();
+            return false;
+        }
+        cardinality_ += container.cardinality_;
+        containers_.emplace_back(std::move(container));
+    }
+
+    return data == end;
+}
+
+}  // namespace segment
+}  // namespace milvus
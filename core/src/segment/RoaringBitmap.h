@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace milvus {
+namespace segment {
+
+/*
+ * Compressed set of 32-bit integers in the layout of Roaring bitmaps.
+ * The values are split by their upper 16 bits into chunks, a chunk keeps its lower 16 bits either in a
+ * sorted array while it holds at most ARRAY_MAX_SIZE values or in a bitmap of 65536 bits.
+ */
+class RoaringBitmap {
+ public:
+    static constexpr size_t ARRAY_MAX_SIZE = 4096;
+    static constexpr size_t BITMAP_WORDS = 1024;
+
+    void
+    Add(uint32_t value);
+
+    bool
+    Contains(uint32_t value) const;
+
+    size_t
+    Cardinality() const {
+        return cardinality_;
+    }
+
+    bool
+    Empty() const {
+        return cardinality_ == 0;
+    }
+
+    void
+    Clear();
+
+    // visit the values in ascending order
+    void
+    ForEach(const std::function<void(uint32_t)>& func) const;
+
+    // set the bits of the values below size in a dense bitset of LSB first bytes
+    void
+    SetBits(uint8_t* bits, size_t size) const;
+
+    size_t
+    SerializedSize() const;
+
+    void
+    Serialize(std::vector<uint8_t>& buffer) const;
+
+    // returns false if the data is malformed
+    bool
+    Deserialize(const uint8_t* data, size_t size);
+
+ private:
+    struct Container {
+        uint16_t key_ = 0;
+        uint32_t cardinality_ = 0;
+        std::vector<uint16_t> array_;
+        std::vector<uint64_t> bitmap_;
+
+        bool
+        IsBitmap() const {
+            return !bitmap_.empty();
+        }
+    };
+
+    Container*
+    FindContainer(uint16_t key, bool create);
+
+    const Container*
+    FindContainer(uint16_t key) const;
+
+    std::vector<Container> containers_;  // sorted by key
+    size_t cardinality_ = 0;
+};
+
+}  // namespace segment
+}  // namespace milvus
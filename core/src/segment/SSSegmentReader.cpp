@@ -18,11 +18,17 @@
 #include "segment/SSSegmentReader.h"
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <map>
 #include <memory>
 #include <utility>
 
 #include "Vectors.h"
+#include "cache/CpuCacheMgr.h"
 #include "codecs/snapshot/SSCodec.h"
+#include "config/Config.h"
 #include "db/Types.h"
 #include "db/snapshot/ResourceHelper.h"
 #include "knowhere/index/vector_index/VecIndex.h"
@@ -35,6 +41,39 @@
 namespace milvus {
 namespace segment {
 
+namespace {
+
+// entities fetched by id cache the pages of the field file they read, not the whole file
+constexpr int64_t FIELD_PAGE_SIZE = 16 * 1024;
+
+class FieldPage : public cache::DataObj {
+ public:
+    explicit FieldPage(std::vector<uint8_t>&& data) : data_(std::move(data)) {
+    }
+
+    int64_t
+    Size() override {
+        return data_.size();
+    }
+
+    const std::vector<uint8_t>&
+    Data() const {
+        return data_;
+    }
+
+ private:
+    std::vector<uint8_t> data_;
+};
+
+using FieldPagePtr = std::shared_ptr<FieldPage>;
+
+std::string
+FieldPageKey(const std::string& file_path, int64_t page) {
+    return file_path + ".page." + std::to_string(page);
+}
+
+}  // namespace
+
 SSSegmentReader::SSSegmentReader(const std::string& dir_root, const engine::SegmentVisitorPtr& segment_visitor)
     : dir_root_(dir_root), segment_visitor_(segment_visitor) {
     Initialize();
@@ -42,13 +81,7 @@ SSSegmentReader::SSSegmentReader(const std::string& dir_root, const engine::Segm
 
 Status
 SSSegmentReader::Initialize() {
-    std::string directory =
-        engine::snapshot::GetResPath<engine::snapshot::Segment>(dir_root_, segment_visitor_->GetSegment());
-
-    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
-    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
-    storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(directory);
-    fs_ptr_ = std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    fs_ptr_ = NewFSHandler();
 
     segment_ptr_ = std::make_shared<engine::Segment>();
 
@@ -82,6 +115,17 @@ SSSegmentReader::Initialize() {
     return Status::OK();
 }
 
+storage::FSHandlerPtr
+SSSegmentReader::NewFSHandler() {
+    std::string directory =
+        engine::snapshot::GetResPath<engine::snapshot::Segment>(dir_root_, segment_visitor_->GetSegment());
+
+    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
+    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    storage::OperationPtr operation_ptr = std::make_shared<storage::DiskOperation>(directory);
+    return std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+}
+
 Status
 SSSegmentReader::Load() {
     STATUS_CHECK(LoadFields());
@@ -137,6 +181,12 @@ SSSegmentReader::LoadFields() {
 Status
 SSSegmentReader::LoadEntities(const std::string& field_name, const std::vector<int64_t>& offsets,
                               std::vector<uint8_t>& raw) {
+    return LoadEntities(fs_ptr_, field_name, offsets, raw);
+}
+
+Status
+SSSegmentReader::LoadEntities(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name,
+                              const std::vector<int64_t>& offsets, std::vector<uint8_t>& raw) {
     try {
         auto field_visitor = segment_visitor_->GetFieldVisitor(field_name);
         auto raw_visitor = field_visitor->GetElementVisitor(engine::FieldElementType::FET_RAW);
@@ -149,12 +199,61 @@ SSSegmentReader::LoadEntities(const std::string& field_name, const std::vector<i
             return Status(DB_ERROR, "Invalid field width");
         }
 
+        // the pages holding the entities in file order, an entity may span pages
+        std::map<int64_t, FieldPagePtr> pages;
+        for (auto offset : offsets) {
+            if (offset < 0) {
+                return Status(DB_ERROR, "Invalid entity offset: " + std::to_string(offset));
+            }
+            int64_t first = offset * field_width / FIELD_PAGE_SIZE;
+            int64_t last = ((offset + 1) * field_width - 1) / FIELD_PAGE_SIZE;
+            for (int64_t page = first; page <= last; ++page) {
+                pages[page] = nullptr;
+            }
+        }
+
+        auto cache_mgr = cache::CpuCacheMgr::GetInstance();
+        std::vector<int64_t> missing;
         codec::ReadRanges ranges;
+        for (auto& pair : pages) {
+            pair.second = std::dynamic_pointer_cast<FieldPage>(cache_mgr->GetItem(FieldPageKey(file_path, pair.first)));
+            if (pair.second == nullptr) {
+                missing.push_back(pair.first);
+                ranges.emplace_back(pair.first * FIELD_PAGE_SIZE, FIELD_PAGE_SIZE);
+            }
+        }
+
+        if (!ranges.empty()) {
+            int64_t coalesce_gap = 0;
+            server::Config::GetInstance().GetStorageConfigReadCoalesceGap(coalesce_gap);
+
+            std::vector<std::vector<uint8_t>> data;
+            auto& ss_codec = codec::SSCodec::instance();
+            ss_codec.GetBlockFormat()->read_coalesced(fs_ptr, file_path, ranges, coalesce_gap, data);
+            for (size_t i = 0; i < missing.size(); ++i) {
+                auto page = std::make_shared<FieldPage>(std::move(data[i]));
+                cache_mgr->InsertItem(FieldPageKey(file_path, missing[i]), page);
+                pages[missing[i]] = page;
+            }
+        }
+
+        raw.resize(offsets.size() * field_width);
+        uint8_t* dest = raw.data();
         for (auto offset : offsets) {
-            ranges.push_back(codec::ReadRange(offset, field_width));
+            int64_t pos = offset * field_width;
+            int64_t end = pos + field_width;
+            while (pos < end) {
+                auto& page = pages[pos / FIELD_PAGE_SIZE]->Data();
+                int64_t in_page = pos % FIELD_PAGE_SIZE;
+                int64_t num_bytes = std::min(end - pos, FIELD_PAGE_SIZE - in_page);
+                if (in_page + num_bytes > (int64_t)page.size()) {
+                    return Status(DB_ERROR, "Entity offset out of range: " + std::to_string(offset));
+                }
+                memcpy(dest, page.data() + in_page, num_bytes);
+                dest += num_bytes;
+                pos += num_bytes;
+            }
         }
-        auto& ss_codec = codec::SSCodec::instance();
-        ss_codec.GetBlockFormat()->read(fs_ptr_, file_path, ranges, raw);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -169,14 +268,28 @@ SSSegmentReader::LoadFieldsEntities(const std::vector<std::string>& fields_name,
                                     engine::DataChunkPtr& data_chunk) {
     data_chunk = std::make_shared<engine::DataChunk>();
     data_chunk->count_ = offsets.size();
-    for (auto& name : fields_name) {
-        engine::FIXED_FIELD_DATA raw_data;
-        auto status = LoadEntities(name, offsets, raw_data);
-        if (!status.ok()) {
-            return status;
+
+    std::vector<engine::FIXED_FIELD_DATA> fields_data(fields_name.size());
+    std::vector<std::future<Status>> futures;
+    for (size_t i = 0; i < fields_name.size(); ++i) {
+        futures.push_back(std::async(std::launch::async, [&, i] {
+            return LoadEntities(NewFSHandler(), fields_name[i], offsets, fields_data[i]);
+        }));
+    }
+
+    Status status;
+    for (auto& future : futures) {
+        auto field_status = future.get();
+        if (!field_status.ok() && status.ok()) {
+            status = field_status;
         }
+    }
+    if (!status.ok()) {
+        return status;
+    }
 
-        data_chunk->fixed_fields_[name] = raw_data;
+    for (size_t i = 0; i < fields_name.size(); ++i) {
+        data_chunk->fixed_fields_[fields_name[i]] = std::move(fields_data[i]);
     }
 
     return Status::OK();
@@ -43,9 +43,11 @@ class SSSegmentReader {
     Status
     LoadFields();
 
+    // offsets are rows of the segment, raw holds their values in the same order
     Status
     LoadEntities(const std::string& field_name, const std::vector<int64_t>& offsets, std::vector<uint8_t>& raw);
 
+    // the fields are fetched in parallel
     Status
     LoadFieldsEntities(const std::vector<std::string>& fields_name, const std::vector<int64_t>& offsets,
                        engine::DataChunkPtr& data_chunk);
@@ -87,6 +89,14 @@ class SSSegmentReader {
     Status
     Initialize();
 
+    // the reader of a handler keeps the open file, each parallel read needs its own
+    storage::FSHandlerPtr
+    NewFSHandler();
+
+    Status
+    LoadEntities(const storage::FSHandlerPtr& fs_ptr, const std::string& field_name,
+                 const std::vector<int64_t>& offsets, std::vector<uint8_t>& raw);
+
  private:
     engine::SegmentVisitorPtr segment_visitor_;
     storage::FSHandlerPtr fs_ptr_;
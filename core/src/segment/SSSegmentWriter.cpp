@@ -129,13 +129,15 @@ SSSegmentWriter::WriteFields() {
     for (auto& iter : field_visitors_map) {
         const engine::snapshot::FieldPtr& field = iter.second->GetField();
         std::string name = field->GetName();
-        engine::FIXED_FIELD_DATA raw_data;
+        // the field is written from the segment in place, a field without data is written empty
+        engine::FIXED_FIELD_DATA empty_data;
+        const engine::FIXED_FIELD_DATA* raw_data = &empty_data;
         segment_ptr_->GetFixedFieldData(name, raw_data);
 
         auto element_visitor = iter.second->GetElementVisitor(engine::FieldElementType::FET_RAW);
         std::string file_path =
             engine::snapshot::GetResPath<engine::snapshot::SegmentFile>(dir_root_, element_visitor->GetFile());
-        STATUS_CHECK(WriteField(file_path, raw_data));
+        STATUS_CHECK(WriteField(file_path, *raw_data));
     }
 
     return Status::OK();
@@ -146,7 +148,7 @@ SSSegmentWriter::WriteBloomFilter() {
     try {
         TimeRecorder recorder("SSSegmentWriter::WriteBloomFilter");
 
-        engine::FIXED_FIELD_DATA uid_data;
+        const engine::FIXED_FIELD_DATA* uid_data = nullptr;
         auto status = segment_ptr_->GetFixedFieldData(engine::DEFAULT_UID_NAME, uid_data);
         if (!status.ok()) {
             return status;
@@ -162,7 +164,7 @@ SSSegmentWriter::WriteBloomFilter() {
         segment::IdBloomFilterPtr bloom_filter_ptr;
         ss_codec.GetIdBloomFilterFormat()->create(fs_ptr_, uid_blf_path, bloom_filter_ptr);
 
-        int64_t* uids = (int64_t*)(uid_data.data());
+        auto uids = reinterpret_cast<const int64_t*>(uid_data->data());
         int64_t row_count = segment_ptr_->GetRowCount();
         for (int64_t i = 0; i < row_count; i++) {
             bloom_filter_ptr->Add(uids[i]);
@@ -101,26 +101,22 @@ Segment::AddChunk(const DataChunkPtr& chunk_ptr, int64_t from, int64_t to) {
         }
     }
 
-    // consume
+    // consume, the rows are appended to the field in one copy without zero filling them first
     int64_t add_count = to - from;
     for (auto& width_iter : fixed_fields_width_) {
         auto input = chunk_ptr->fixed_fields_.find(width_iter.first);
         auto& data = fixed_fields_[width_iter.first];
-        size_t origin_bytes = data.size();
         int64_t add_bytes = add_count * width_iter.second;
         int64_t previous_bytes = row_count_ * width_iter.second;
-        int64_t target_bytes = previous_bytes + add_bytes;
-        data.resize(target_bytes);
         if (input == chunk_ptr->fixed_fields_.end()) {
             // this field is not provided, complicate by 0
-            memset(data.data() + origin_bytes, 0, target_bytes - origin_bytes);
+            data.resize(previous_bytes + add_bytes);
         } else {
             // complicate by 0
-            if (origin_bytes < previous_bytes) {
-                memset(data.data() + origin_bytes, 0, previous_bytes - origin_bytes);
-            }
+            data.resize(previous_bytes);
             // copy input into this field
-            memcpy(data.data() + previous_bytes, input->second.data() + from * width_iter.second, add_bytes);
+            const uint8_t* src = input->second.data() + from * width_iter.second;
+            data.insert(data.end(), src, src + add_bytes);
         }
     }
 
@@ -176,6 +172,17 @@ Segment::GetFixedFieldData(const std::string& field_name, FIXED_FIELD_DATA& data
     return Status::OK();
 }
 
+Status
+Segment::GetFixedFieldData(const std::string& field_name, const FIXED_FIELD_DATA*& data) {
+    auto iter = fixed_fields_.find(field_name);
+    if (iter == fixed_fields_.end()) {
+        return Status(DB_ERROR, "invalid field name: " + field_name);
+    }
+
+    data = &iter->second;
+    return Status::OK();
+}
+
 Status
 Segment::GetVectorIndex(const std::string& field_name, knowhere::VecIndexPtr& index) {
     auto iter = vector_indice_.find(field_name);
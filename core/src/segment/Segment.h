@@ -71,6 +71,10 @@ class Segment {
     Status
     GetFixedFieldData(const std::string& field_name, FIXED_FIELD_DATA& data);
 
+    // the data of the field without a copy, valid until the next change of the segment
+    Status
+    GetFixedFieldData(const std::string& field_name, const FIXED_FIELD_DATA*& data);
+
     Status
     GetVectorIndex(const std::string& field_name, knowhere::VecIndexPtr& index);
 
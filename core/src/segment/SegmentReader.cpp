@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "Vectors.h"
+#include "cache/CpuCacheMgr.h"
 #include "codecs/default/DefaultCodec.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "storage/disk/DiskIOReader.h"
@@ -74,6 +75,49 @@ SegmentReader::LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>&
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadVectors(knowhere::BinaryPtr& raw_vectors, storage::MmapAdvice advice) {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsFormat()->read_vectors(fs_ptr_, raw_vectors, advice);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentReader::LoadVectors(const std::vector<int64_t>& offsets, size_t width, std::vector<uint8_t>& raw_vectors) {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsFormat()->read_vectors(fs_ptr_, offsets, width, raw_vectors);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentReader::LoadAttrs(AttrsPtr& attrs) {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        attrs = std::make_shared<Attrs>();
+        default_codec.GetAttrsFormat()->read(fs_ptr_, attrs);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load attributes: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadAttrs(const std::string& field_name, off_t offset, size_t num_bytes,
                          std::vector<uint8_t>& raw_attrs) {
@@ -89,6 +133,21 @@ SegmentReader::LoadAttrs(const std::string& field_name, off_t offset, size_t num
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadAttrs(const std::string& field_name, const std::vector<int64_t>& offsets, size_t width,
+                         std::vector<uint8_t>& raw_attrs) {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetAttrsFormat()->read_attrs(fs_ptr_, field_name, offsets, width, raw_attrs);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load raw attributes: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadUids(std::vector<doc_id_t>& uids) {
     try {
@@ -103,6 +162,32 @@ SegmentReader::LoadUids(std::vector<doc_id_t>& uids) {
     return Status::OK();
 }
 
+bool
+SegmentReader::GetPlainVectorFiles(std::string& rv_path, std::string& uid_path) {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        return !default_codec.GetAttrsFormat()->has_attrs(fs_ptr_) &&
+               default_codec.GetVectorsFormat()->plain_files(fs_ptr_, rv_path, uid_path);
+    } catch (std::exception& e) {
+        LOG_ENGINE_ERROR_ << "Failed to check the vector files: " << e.what();
+        return false;
+    }
+}
+
+Status
+SegmentReader::LoadAttrsZoneMaps(AttrZoneMaps& zone_maps) {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetAttrsIndexFormat()->read_zone_maps(fs_ptr_, zone_maps);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load attribute zone maps: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::GetSegment(SegmentPtr& segment_ptr) {
     segment_ptr = segment_ptr_;
@@ -138,6 +223,56 @@ SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadIdIndex(segment::IdIndexPtr& id_index_ptr) {
+    auto cache_key = IdIndexCacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+    auto cpu_cache_mgr = cache::CpuCacheMgr::GetInstance();
+    id_index_ptr = std::static_pointer_cast<IdIndex>(cpu_cache_mgr->GetItem(cache_key));
+    if (id_index_ptr != nullptr) {
+        return Status::OK();
+    }
+
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetIdIndexFormat()->read(fs_ptr_, id_index_ptr);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load id index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+
+    if (id_index_ptr != nullptr) {
+        cpu_cache_mgr->InsertItem(cache_key, id_index_ptr);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentReader::LoadVectorSummary(segment::VectorSummaryPtr& vector_summary_ptr) {
+    auto cache_key = VectorSummaryCacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+    auto cpu_cache_mgr = cache::CpuCacheMgr::GetInstance();
+    vector_summary_ptr = std::static_pointer_cast<VectorSummary>(cpu_cache_mgr->GetItem(cache_key));
+    if (vector_summary_ptr != nullptr) {
+        return Status::OK();
+    }
+
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorSummaryFormat()->read(fs_ptr_, vector_summary_ptr);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load vector summary: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+
+    if (vector_summary_ptr != nullptr) {
+        cpu_cache_mgr->InsertItem(cache_key, vector_summary_ptr);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
     try {
@@ -165,5 +300,16 @@ SegmentReader::ReadDeletedDocsSize(size_t& size) {
     }
     return Status::OK();
 }
+
+std::string
+SegmentReader::IdIndexCacheKey(const std::string& directory) {
+    return directory + "/id_index";
+}
+
+std::string
+SegmentReader::VectorSummaryCacheKey(const std::string& directory) {
+    return directory + "/vector_summary";
+}
+
 }  // namespace segment
 }  // namespace milvus
@@ -43,12 +43,38 @@ class SegmentReader {
     Status
     LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_vectors);
 
+    // load all raw vectors of the segment, they are memory mapped if storage.raw_vector_mmap is enabled
+    // raw_vectors is nullptr if the segment has no raw vector file
+    Status
+    LoadVectors(knowhere::BinaryPtr& raw_vectors, storage::MmapAdvice advice);
+
+    // the vectors at the row offsets, width bytes each
+    Status
+    LoadVectors(const std::vector<int64_t>& offsets, size_t width, std::vector<uint8_t>& raw_vectors);
+
     Status
     LoadAttrs(const std::string& field_name, off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_attrs);
 
+    // the values of the attribute at the row offsets, width bytes each
+    Status
+    LoadAttrs(const std::string& field_name, const std::vector<int64_t>& offsets, size_t width,
+              std::vector<uint8_t>& raw_attrs);
+
+    // load all attributes of the segment, without its raw vectors
+    Status
+    LoadAttrs(AttrsPtr& attrs);
+
     Status
     LoadUids(std::vector<doc_id_t>& uids);
 
+    // the raw vector and uid files of the segment, false unless both are plain and the segment has no attributes,
+    // then its rows can be copied file to file by byte ranges
+    bool
+    GetPlainVectorFiles(std::string& rv_path, std::string& uid_path);
+
+    Status
+    LoadAttrsZoneMaps(AttrZoneMaps& zone_maps);
+
     Status
     LoadVectorIndex(const std::string& location, codec::ExternalData external_data,
                     segment::VectorIndexPtr& vector_index_ptr);
@@ -56,6 +82,14 @@ class SegmentReader {
     Status
     LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr);
 
+    // id_index_ptr is nullptr if the segment was written without an id index, the index is kept in the cpu cache
+    Status
+    LoadIdIndex(segment::IdIndexPtr& id_index_ptr);
+
+    // vector_summary_ptr is nullptr if the segment was written without a summary, the summary is kept in the cpu cache
+    Status
+    LoadVectorSummary(segment::VectorSummaryPtr& vector_summary_ptr);
+
     Status
     LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr);
 
@@ -65,6 +99,14 @@ class SegmentReader {
     Status
     ReadDeletedDocsSize(size_t& size);
 
+    // cache key of the id index of the segment in directory
+    static std::string
+    IdIndexCacheKey(const std::string& directory);
+
+    // cache key of the vector summary of the segment in directory
+    static std::string
+    VectorSummaryCacheKey(const std::string& directory);
+
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
@@ -18,13 +18,17 @@
 #include "segment/SegmentWriter.h"
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <memory>
 #include <utility>
 
 #include "SegmentReader.h"
 #include "Vectors.h"
 #include "codecs/default/DefaultCodec.h"
+#include "codecs/default/RawDataCodec.h"
 #include "db/Utils.h"
+#include "storage/IOScheduler.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
 #include "storage/disk/DiskOperation.h"
@@ -42,6 +46,13 @@ SegmentWriter::SegmentWriter(const std::string& directory) {
     segment_ptr_ = std::make_shared<Segment>();
 }
 
+storage::FSHandlerPtr
+SegmentWriter::NewFSHandler() {
+    storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
+    storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
+    return std::make_shared<storage::FSHandler>(reader_ptr, writer_ptr, fs_ptr_->operation_ptr_);
+}
+
 Status
 SegmentWriter::AddVectors(const std::string& name, const std::vector<uint8_t>& data,
                           const std::vector<doc_id_t>& uids) {
@@ -114,46 +125,61 @@ Status
 SegmentWriter::Serialize() {
     TimeRecorder recorder("SegmentWriter::Serialize");
 
-    auto status = WriteBloomFilter();
-    if (!status.ok()) {
-        LOG_ENGINE_ERROR_ << status.message();
-        return status;
-    }
-
-    recorder.RecordSection("Writing bloom filter done");
-
-    status = WriteVectors();
-    if (!status.ok()) {
-        LOG_ENGINE_ERROR_ << "Write vectors fail: " << status.message();
-        return status;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+    } catch (std::exception& e) {
+        return Status(SERVER_WRITE_ERROR, "Failed to create segment directory: " + std::string(e.what()));
     }
 
-    status = WriteAttrs();
-    if (!status.ok()) {
-        return status;
+    // the files are independent, each is built and written on its own thread through its own handler, in the io
+    // class of the caller
+    std::vector<std::pair<std::string, std::function<Status()>>> writes = {
+        {"bloom filter", [this] { return WriteBloomFilter(); }},
+        {"vectors", [this] { return WriteVectors(); }},
+        {"id index", [this] { return WriteIdIndex(); }},
+        {"vector summary", [this] { return WriteVectorSummary(); }},
+        {"attributes", [this] { return WriteAttrs(); }},
+        {"attributes index", [this] { return WriteAttrsIndex(); }},
+        {"deleted docs", [this] { return WriteDeletedDocs(); }},
+    };
+    auto io_class = storage::IOScheduler::CurrentClass();
+    std::vector<std::future<Status>> futures;
+    for (auto& write : writes) {
+        futures.push_back(std::async(std::launch::async, [io_class, &write] {
+            storage::IOClassGuard io_guard(io_class);
+            return write.second();
+        }));
     }
 
-    status = WriteAttrsIndex();
-    if (!status.ok()) {
-        return status;
+    Status status;
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto write_status = futures[i].get();
+        if (!write_status.ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to write " << writes[i].first << ": " << write_status.message();
+            if (status.ok()) {
+                status = write_status;
+            }
+        }
     }
 
-    recorder.RecordSection("Writing vectors and uids done");
-
-    // Write an empty deleted doc
-    status = WriteDeletedDocs();
-
-    recorder.RecordSection("Writing deleted docs done");
+    recorder.RecordSection("Writing bloom filter, vectors, uids, id index and deleted docs done");
 
     return status;
 }
 
 Status
 SegmentWriter::WriteVectors() {
+    auto fs_ptr = NewFSHandler();
     try {
         auto& default_codec = codec::DefaultCodec::instance();
-        fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetVectorsFormat()->write(fs_ptr_, segment_ptr_->vectors_ptr_);
+        fs_ptr->operation_ptr_->CreateDirectory();
+        if (rv_appender_ != nullptr) {
+            // the files are appended by MergeFiles(), only their sizes are left to write
+            rv_appender_->Close();
+            uid_appender_->Close();
+        } else {
+            default_codec.GetVectorsFormat()->write(fs_ptr, segment_ptr_->vectors_ptr_);
+        }
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vectors: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -166,10 +192,11 @@ SegmentWriter::WriteVectors() {
 
 Status
 SegmentWriter::WriteAttrs() {
+    auto fs_ptr = NewFSHandler();
     try {
         auto& default_codec = codec::DefaultCodec::instance();
-        fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetAttrsFormat()->write(fs_ptr_, segment_ptr_->attrs_ptr_);
+        fs_ptr->operation_ptr_->CreateDirectory();
+        default_codec.GetAttrsFormat()->write(fs_ptr, segment_ptr_->attrs_ptr_);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vectors: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -202,10 +229,11 @@ SegmentWriter::WriteVectorIndex(const std::string& location) {
 
 Status
 SegmentWriter::WriteAttrsIndex() {
+    auto fs_ptr = NewFSHandler();
     try {
         auto& default_codec = codec::DefaultCodec::instance();
-        fs_ptr_->operation_ptr_->CreateDirectory();
-        default_codec.GetAttrsIndexFormat()->write(fs_ptr_, segment_ptr_->attrs_index_ptr_);
+        fs_ptr->operation_ptr_->CreateDirectory();
+        default_codec.GetAttrsIndexFormat()->write(fs_ptr, segment_ptr_->attrs_index_ptr_);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write vector index: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -218,25 +246,24 @@ SegmentWriter::WriteAttrsIndex() {
 
 Status
 SegmentWriter::WriteBloomFilter() {
+    auto fs_ptr = NewFSHandler();
     try {
         auto& default_codec = codec::DefaultCodec::instance();
 
-        fs_ptr_->operation_ptr_->CreateDirectory();
+        fs_ptr->operation_ptr_->CreateDirectory();
 
         TimeRecorder recorder("SegmentWriter::WriteBloomFilter");
 
-        default_codec.GetIdBloomFilterFormat()->create(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
+        default_codec.GetIdBloomFilterFormat()->create(fs_ptr, segment_ptr_->id_bloom_filter_ptr_);
 
         recorder.RecordSection("Initializing bloom filter");
 
         auto& uids = segment_ptr_->vectors_ptr_->GetUids();
-        for (auto& uid : uids) {
-            segment_ptr_->id_bloom_filter_ptr_->Add(uid);
-        }
+        segment_ptr_->id_bloom_filter_ptr_->AddMany(uids);
 
         recorder.RecordSection("Adding " + std::to_string(uids.size()) + " ids to bloom filter");
 
-        default_codec.GetIdBloomFilterFormat()->write(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
+        default_codec.GetIdBloomFilterFormat()->write(fs_ptr, segment_ptr_->id_bloom_filter_ptr_);
 
         recorder.RecordSection("Writing bloom filter");
     } catch (std::exception& e) {
@@ -249,13 +276,74 @@ SegmentWriter::WriteBloomFilter() {
     return Status::OK();
 }
 
+Status
+SegmentWriter::WriteIdIndex() {
+    auto fs_ptr = NewFSHandler();
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr->operation_ptr_->CreateDirectory();
+        segment_ptr_->id_index_ptr_ = std::make_shared<IdIndex>(segment_ptr_->vectors_ptr_->GetUids());
+        default_codec.GetIdIndexFormat()->write(fs_ptr, segment_ptr_->id_index_ptr_);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write id index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+
+        engine::utils::SendExitSignal();
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentWriter::WriteVectorSummary() {
+    auto fs_ptr = NewFSHandler();
+    auto& uids = segment_ptr_->vectors_ptr_->GetUids();
+    const uint8_t* data = segment_ptr_->vectors_ptr_->GetData().data();
+    size_t data_size = segment_ptr_->vectors_ptr_->GetData().size();
+
+    // the vectors copied by MergeFiles() are mapped from the written file, they stay in the page cache
+    std::shared_ptr<uint8_t[]> mapped_data;
+    if (rv_appender_ != nullptr && summary_dimension_ > 0 && rv_appender_->Size() > 0) {
+        std::string rv_path, uid_path;
+        codec::DefaultCodec::instance().GetVectorsFormat()->file_paths(
+            fs_ptr, segment_ptr_->vectors_ptr_->GetName(), rv_path, uid_path);
+        storage::DiskIOReader reader;
+        if (reader.open(rv_path)) {
+            mapped_data = reader.mmap(sizeof(size_t), rv_appender_->Size(), storage::MmapAdvice::SEQUENTIAL);
+            reader.close();
+        }
+        data = mapped_data.get();
+        data_size = mapped_data != nullptr ? rv_appender_->Size() : 0;
+    }
+
+    if (summary_dimension_ <= 0 || uids.empty() || data_size != uids.size() * summary_dimension_ * sizeof(float)) {
+        return Status::OK();
+    }
+
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr->operation_ptr_->CreateDirectory();
+        segment_ptr_->vector_summary_ptr_ =
+            std::make_shared<VectorSummary>(reinterpret_cast<const float*>(data), uids.size(), summary_dimension_);
+        default_codec.GetVectorSummaryFormat()->write(fs_ptr, segment_ptr_->vector_summary_ptr_);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write vector summary: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+
+        engine::utils::SendExitSignal();
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentWriter::WriteDeletedDocs() {
+    auto fs_ptr = NewFSHandler();
     try {
         auto& default_codec = codec::DefaultCodec::instance();
-        fs_ptr_->operation_ptr_->CreateDirectory();
+        fs_ptr->operation_ptr_->CreateDirectory();
         DeletedDocsPtr deleted_docs_ptr = std::make_shared<DeletedDocs>();
-        default_codec.GetDeletedDocsFormat()->write(fs_ptr_, deleted_docs_ptr);
+        default_codec.GetDeletedDocsFormat()->write(fs_ptr, deleted_docs_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to write deleted docs: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -315,6 +403,9 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
     if (dir_to_merge == fs_ptr_->operation_ptr_->GetDirectory()) {
         return Status(DB_ERROR, "Cannot Merge Self");
     }
+    if (rv_appender_ != nullptr) {
+        return Status(DB_ERROR, "Cannot merge a loaded segment after copied ones");
+    }
 
     LOG_ENGINE_DEBUG_ << "Merging from " << dir_to_merge << " to " << fs_ptr_->operation_ptr_->GetDirectory();
 
@@ -372,10 +463,197 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
     return Status::OK();
 }
 
+bool
+SegmentWriter::CanMergeFiles(const std::string& segment_dir) {
+    SegmentReader segment_reader(segment_dir);
+    std::string rv_path, uid_path;
+    return segment_reader.GetPlainVectorFiles(rv_path, uid_path);
+}
+
+Status
+SegmentWriter::MergeFiles(const std::string& segment_dir_to_merge, const std::string& name) {
+    if (segment_dir_to_merge == fs_ptr_->operation_ptr_->GetDirectory()) {
+        return Status(DB_ERROR, "Cannot Merge Self");
+    }
+    if (!segment_ptr_->vectors_ptr_->GetData().empty()) {
+        return Status(DB_ERROR, "Cannot copy a segment after loaded ones");
+    }
+
+    LOG_ENGINE_DEBUG_ << "Copying from " << segment_dir_to_merge << " to " << fs_ptr_->operation_ptr_->GetDirectory();
+
+    TimeRecorder recorder("SegmentWriter::MergeFiles");
+
+    SegmentReader segment_reader_to_merge(segment_dir_to_merge);
+    std::string src_rv_path, src_uid_path;
+    size_t rv_size = 0;
+    if (!segment_reader_to_merge.GetPlainVectorFiles(src_rv_path, src_uid_path) ||
+        !codec::ReadPlainRawDataSize(src_rv_path, rv_size)) {
+        return Status(DB_ERROR, "Cannot copy the vector files of " + segment_dir_to_merge);
+    }
+    std::vector<doc_id_t> uids;
+    STATUS_CHECK(segment_reader_to_merge.LoadUids(uids));
+    DeletedDocsPtr deleted_docs_ptr;
+    STATUS_CHECK(segment_reader_to_merge.LoadDeletedDocs(deleted_docs_ptr));
+    if (!uids.empty() && rv_size % uids.size() != 0) {
+        return Status(DB_ERROR, "Raw vectors don't match the uids of " + segment_dir_to_merge);
+    }
+    size_t vector_width = uids.empty() ? 0 : rv_size / uids.size();
+
+    std::vector<bool> live(uids.size(), true);
+    if (deleted_docs_ptr != nullptr) {
+        for (auto offset : deleted_docs_ptr->GetDeletedDocs()) {
+            if (offset >= 0 && (size_t)offset < live.size()) {
+                live[offset] = false;
+            }
+        }
+    }
+
+    // the consecutive live rows are copied as one range
+    std::vector<codec::RawDataAppender::Range> rv_ranges, uid_ranges;
+    std::vector<doc_id_t> live_uids;
+    for (size_t begin = 0; begin < uids.size();) {
+        if (!live[begin]) {
+            ++begin;
+            continue;
+        }
+        size_t end = begin;
+        for (; end < uids.size() && live[end]; ++end) {
+            live_uids.push_back(uids[end]);
+        }
+        rv_ranges.emplace_back(begin * vector_width, (end - begin) * vector_width);
+        uid_ranges.emplace_back(begin * sizeof(doc_id_t), (end - begin) * sizeof(doc_id_t));
+        begin = end;
+    }
+
+    recorder.RecordSection("Loading uids and deleted docs");
+
+    try {
+        if (rv_appender_ == nullptr) {
+            std::string rv_path, uid_path;
+            codec::DefaultCodec::instance().GetVectorsFormat()->file_paths(fs_ptr_, name, rv_path, uid_path);
+            fs_ptr_->operation_ptr_->CreateDirectory();
+            auto rv_appender = std::make_shared<codec::RawDataAppender>();
+            auto uid_appender = std::make_shared<codec::RawDataAppender>();
+            rv_appender->Open(rv_path);
+            uid_appender->Open(uid_path);
+            rv_appender_ = rv_appender;
+            uid_appender_ = uid_appender;
+        }
+        rv_appender_->Append(src_rv_path, rv_ranges);
+        uid_appender_->Append(src_uid_path, uid_ranges);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to copy vectors: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    segment_ptr_->vectors_ptr_->AddUids(live_uids);
+    segment_ptr_->vectors_ptr_->SetName(name);
+
+    recorder.RecordSection("Copying " + std::to_string(live_uids.size()) + " vectors and uids in " +
+                           std::to_string(rv_ranges.size()) + " ranges");
+
+    return Status::OK();
+}
+
+Status
+SegmentWriter::Compact(const std::string& segment_dir_to_compact, const std::string& name, size_t vector_width,
+                       size_t chunk_size) {
+    if (segment_dir_to_compact == fs_ptr_->operation_ptr_->GetDirectory()) {
+        return Status(DB_ERROR, "Cannot Compact Self");
+    }
+    if (vector_width == 0) {
+        return Status(DB_ERROR, "Invalid vector width to compact");
+    }
+
+    LOG_ENGINE_DEBUG_ << "Compacting from " << segment_dir_to_compact << " to "
+                      << fs_ptr_->operation_ptr_->GetDirectory();
+
+    TimeRecorder recorder("SegmentWriter::Compact");
+
+    SegmentReader segment_reader_to_compact(segment_dir_to_compact);
+    std::vector<doc_id_t> uids;
+    STATUS_CHECK(segment_reader_to_compact.LoadUids(uids));
+    DeletedDocsPtr deleted_docs_ptr;
+    STATUS_CHECK(segment_reader_to_compact.LoadDeletedDocs(deleted_docs_ptr));
+
+    std::vector<bool> live(uids.size(), true);
+    size_t live_count = uids.size();
+    if (deleted_docs_ptr != nullptr) {
+        for (auto offset : deleted_docs_ptr->GetDeletedDocs()) {
+            if (offset >= 0 && (size_t)offset < live.size() && live[offset]) {
+                live[offset] = false;
+                --live_count;
+            }
+        }
+    }
+
+    recorder.RecordSection("Loading uids and deleted docs");
+
+    // the raw vectors are the bulk of a segment, only a chunk of them is held besides the compacted ones
+    auto& vectors = segment_ptr_->vectors_ptr_;
+    vectors->GetMutableData().reserve(vectors->GetData().size() + live_count * vector_width);
+    vectors->GetMutableUids().reserve(vectors->GetUids().size() + live_count);
+    size_t chunk_rows = std::max<size_t>(1, chunk_size / vector_width);
+    std::vector<uint8_t> chunk;
+    std::vector<uint8_t> live_vectors;
+    std::vector<doc_id_t> live_uids;
+    for (size_t begin = 0; begin < uids.size(); begin += chunk_rows) {
+        size_t rows = std::min(chunk_rows, uids.size() - begin);
+        STATUS_CHECK(segment_reader_to_compact.LoadVectors(begin * vector_width, rows * vector_width, chunk));
+        if (chunk.size() != rows * vector_width) {
+            return Status(DB_ERROR, "Raw vectors don't match the uids of " + segment_dir_to_compact);
+        }
+
+        live_vectors.clear();
+        live_uids.clear();
+        for (size_t i = 0; i < rows; ++i) {
+            if (live[begin + i]) {
+                live_vectors.insert(live_vectors.end(), chunk.data() + i * vector_width,
+                                    chunk.data() + (i + 1) * vector_width);
+                live_uids.push_back(uids[begin + i]);
+            }
+        }
+        AddVectors(name, live_vectors.data(), live_vectors.size(), live_uids);
+    }
+    std::vector<uint8_t>().swap(chunk);
+    std::vector<uint8_t>().swap(live_vectors);
+
+    recorder.RecordSection("Adding " + std::to_string(live_count) + " vectors and uids");
+
+    // the attributes are a few bytes a row, they are loaded at once
+    AttrsPtr attrs_to_compact;
+    STATUS_CHECK(segment_reader_to_compact.LoadAttrs(attrs_to_compact));
+    std::unordered_map<std::string, uint64_t> attr_nbytes;
+    std::unordered_map<std::string, std::vector<uint8_t>> attr_data;
+    for (auto& pair : attrs_to_compact->attrs) {
+        auto& attr = pair.second;
+        if (attr->GetUids().size() != uids.size()) {
+            return Status(DB_ERROR, "Attribute " + pair.first + " doesn't match the uids of " + segment_dir_to_compact);
+        }
+        size_t width = attr->GetCodeLength();
+        auto& data = attr_data[pair.first];
+        data.reserve(live_count * width);
+        for (size_t i = 0; i < uids.size(); ++i) {
+            if (live[i]) {
+                data.insert(data.end(), attr->GetData().data() + i * width, attr->GetData().data() + (i + 1) * width);
+            }
+        }
+        attr_nbytes[pair.first] = data.size();
+    }
+    AddAttrs(name, attr_nbytes, attr_data, segment_ptr_->vectors_ptr_->GetUids());
+
+    recorder.RecordSection("Adding " + std::to_string(attr_data.size()) + " attributes");
+
+    return Status::OK();
+}
+
 size_t
 SegmentWriter::Size() {
     // TODO(zhiru): switch to actual directory size
     size_t vectors_size = segment_ptr_->vectors_ptr_->VectorsSize();
+    if (rv_appender_ != nullptr) {
+        vectors_size += rv_appender_->Size();
+    }
     size_t uids_size = segment_ptr_->vectors_ptr_->UidsSize();
     /*
     if (segment_ptr_->id_bloom_filter_ptr_) {
@@ -395,5 +673,10 @@ SegmentWriter::SetSegmentName(const std::string& name) {
     segment_ptr_->vectors_ptr_->SetName(name);
 }
 
+void
+SegmentWriter::EnableVectorSummary(int64_t dimension) {
+    summary_dimension_ = dimension;
+}
+
 }  // namespace segment
 }  // namespace milvus
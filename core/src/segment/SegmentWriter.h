@@ -28,6 +28,10 @@
 #include "utils/Status.h"
 
 namespace milvus {
+namespace codec {
+class RawDataAppender;
+}  // namespace codec
+
 namespace segment {
 
 class SegmentWriter {
@@ -70,6 +74,23 @@ class SegmentWriter {
     Status
     Merge(const std::string& segment_dir_to_merge, const std::string& name);
 
+    // the segment in segment_dir can be merged by MergeFiles(), its raw vectors and uids are kept in plain files
+    // and it has no attributes
+    static bool
+    CanMergeFiles(const std::string& segment_dir);
+
+    // add the entities of the segment in segment_dir_to_merge except the deleted ones like Merge(), the raw vectors
+    // and uids are copied file to file by the ranges of live rows instead of being loaded, only the uids are read.
+    // Merge() and MergeFiles() are not mixed in a writer
+    Status
+    MergeFiles(const std::string& segment_dir_to_merge, const std::string& name);
+
+    // add the entities of the segment in segment_dir_to_compact except the deleted ones, the raw vectors of
+    // vector_width bytes each are read chunk_size bytes at a time instead of loading the whole segment
+    Status
+    Compact(const std::string& segment_dir_to_compact, const std::string& name, size_t vector_width,
+            size_t chunk_size);
+
     size_t
     Size();
 
@@ -85,7 +106,15 @@ class SegmentWriter {
     void
     SetSegmentName(const std::string& name);
 
+    // write a summary of the vectors on Serialize(), only float vectors of dimension can be summarized
+    void
+    EnableVectorSummary(int64_t dimension);
+
  private:
+    // a handler of the segment directory, the files written at once don't share a writer
+    storage::FSHandlerPtr
+    NewFSHandler();
+
     Status
     WriteVectors();
 
@@ -95,12 +124,23 @@ class SegmentWriter {
     Status
     WriteBloomFilter();
 
+    Status
+    WriteIdIndex();
+
+    Status
+    WriteVectorSummary();
+
     Status
     WriteDeletedDocs();
 
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
+    int64_t summary_dimension_ = 0;
+
+    // the raw vector and uid files appended by MergeFiles(), completed by Serialize()
+    std::shared_ptr<codec::RawDataAppender> rv_appender_;
+    std::shared_ptr<codec::RawDataAppender> uid_appender_;
 };
 
 using SegmentWriterPtr = std::shared_ptr<SegmentWriter>;
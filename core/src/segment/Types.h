@@ -23,7 +23,9 @@
 #include "segment/AttrsIndex.h"
 #include "segment/DeletedDocs.h"
 #include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
 #include "segment/VectorIndex.h"
+#include "segment/VectorSummary.h"
 #include "segment/Vectors.h"
 
 namespace milvus {
@@ -38,6 +40,8 @@ struct Segment {
     AttrsIndexPtr attrs_index_ptr_ = std::make_shared<AttrsIndex>();
     DeletedDocsPtr deleted_docs_ptr_ = nullptr;
     IdBloomFilterPtr id_bloom_filter_ptr_ = nullptr;
+    IdIndexPtr id_index_ptr_ = nullptr;
+    VectorSummaryPtr vector_summary_ptr_ = nullptr;
 };
 
 using SegmentPtr = std::shared_ptr<Segment>;
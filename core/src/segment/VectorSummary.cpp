@@ -0,0 +1,183 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/VectorSummary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace milvus {
+namespace segment {
+
+namespace {
+
+constexpr size_t SUMMARY_CENTROIDS = 8;
+constexpr size_t SUMMARY_SAMPLE_SIZE = 4096;
+constexpr size_t SUMMARY_ITERATIONS = 10;
+
+float
+L2Sqr(const float* a, const float* b, int64_t dimension) {
+    float sum = 0;
+    for (int64_t i = 0; i < dimension; ++i) {
+        float diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+float
+InnerProduct(const float* a, const float* b, int64_t dimension) {
+    float sum = 0;
+    for (int64_t i = 0; i < dimension; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+size_t
+Nearest(const std::vector<float>& centroids, const float* vector, int64_t dimension, float& distance) {
+    size_t nearest = 0;
+    distance = std::numeric_limits<float>::max();
+    for (size_t c = 0; c * dimension < centroids.size(); ++c) {
+        float dist = L2Sqr(centroids.data() + c * dimension, vector, dimension);
+        if (dist < distance) {
+            distance = dist;
+            nearest = c;
+        }
+    }
+    return nearest;
+}
+
+}  // namespace
+
+VectorSummary::VectorSummary(const float* vectors, size_t count, int64_t dimension) : dimension_(dimension) {
+    if (count == 0 || dimension <= 0) {
+        return;
+    }
+
+    // k-means on an evenly strided sample, seeded with evenly spaced sample vectors
+    size_t stride = std::max<size_t>(1, count / SUMMARY_SAMPLE_SIZE);
+    std::vector<size_t> sample;
+    for (size_t i = 0; i < count; i += stride) {
+        sample.push_back(i);
+    }
+    size_t k = std::min(SUMMARY_CENTROIDS, sample.size());
+    centroids_.resize(k * dimension);
+    for (size_t c = 0; c < k; ++c) {
+        memcpy(centroids_.data() + c * dimension, vectors + sample[c * sample.size() / k] * dimension,
+               dimension * sizeof(float));
+    }
+
+    std::vector<double> sums(k * dimension);
+    std::vector<size_t> sizes(k);
+    for (size_t iter = 0; iter < SUMMARY_ITERATIONS; ++iter) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(sizes.begin(), sizes.end(), 0);
+        for (auto i : sample) {
+            const float* vector = vectors + i * dimension;
+            float distance;
+            size_t c = Nearest(centroids_, vector, dimension, distance);
+            for (int64_t d = 0; d < dimension; ++d) {
+                sums[c * dimension + d] += vector[d];
+            }
+            ++sizes[c];
+        }
+        // an empty cluster keeps its centroid
+        for (size_t c = 0; c < k; ++c) {
+            if (sizes[c] == 0) {
+                continue;
+            }
+            for (int64_t d = 0; d < dimension; ++d) {
+                centroids_[c * dimension + d] = static_cast<float>(sums[c * dimension + d] / sizes[c]);
+            }
+        }
+    }
+
+    // the radius covers every vector, not only the sample
+    radius_.assign(k, 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        float distance;
+        size_t c = Nearest(centroids_, vectors + i * dimension, dimension, distance);
+        radius_[c] = std::max(radius_[c], std::sqrt(distance));
+    }
+}
+
+float
+VectorSummary::L2LowerBound(const float* query) const {
+    float bound = std::numeric_limits<float>::max();
+    for (size_t c = 0; c < radius_.size(); ++c) {
+        float gap = std::sqrt(L2Sqr(centroids_.data() + c * dimension_, query, dimension_)) - radius_[c];
+        bound = std::min(bound, gap > 0 ? gap * gap : 0.0f);
+    }
+    return bound;
+}
+
+float
+VectorSummary::IPUpperBound(const float* query) const {
+    float norm = std::sqrt(InnerProduct(query, query, dimension_));
+    float bound = std::numeric_limits<float>::lowest();
+    for (size_t c = 0; c < radius_.size(); ++c) {
+        float ip = InnerProduct(centroids_.data() + c * dimension_, query, dimension_);
+        bound = std::max(bound, ip + norm * radius_[c]);
+    }
+    return bound;
+}
+
+void
+VectorSummary::Serialize(std::vector<uint8_t>& buffer) const {
+    uint64_t num_centroids = radius_.size();
+    auto offset = buffer.size();
+    buffer.resize(offset + sizeof(dimension_) + sizeof(num_centroids) +
+                  (centroids_.size() + radius_.size()) * sizeof(float));
+    uint8_t* data = buffer.data() + offset;
+    memcpy(data, &dimension_, sizeof(dimension_));
+    data += sizeof(dimension_);
+    memcpy(data, &num_centroids, sizeof(num_centroids));
+    data += sizeof(num_centroids);
+    memcpy(data, centroids_.data(), centroids_.size() * sizeof(float));
+    data += centroids_.size() * sizeof(float);
+    memcpy(data, radius_.data(), radius_.size() * sizeof(float));
+}
+
+bool
+VectorSummary::Deserialize(const uint8_t* data, size_t size) {
+    int64_t dimension;
+    uint64_t num_centroids;
+    if (size < sizeof(dimension) + sizeof(num_centroids)) {
+        return false;
+    }
+    memcpy(&dimension, data, sizeof(dimension));
+    memcpy(&num_centroids, data + sizeof(dimension), sizeof(num_centroids));
+    size -= sizeof(dimension) + sizeof(num_centroids);
+    data += sizeof(dimension) + sizeof(num_centroids);
+    if (dimension <= 0 || num_centroids > size / sizeof(float) ||
+        size != num_centroids * (dimension + 1) * sizeof(float)) {
+        return false;
+    }
+
+    dimension_ = dimension;
+    centroids_.resize(num_centroids * dimension);
+    radius_.resize(num_centroids);
+    memcpy(centroids_.data(), data, centroids_.size() * sizeof(float));
+    memcpy(radius_.data(), data + centroids_.size() * sizeof(float), radius_.size() * sizeof(float));
+    return true;
+}
+
+}  // namespace segment
+}  // namespace milvus
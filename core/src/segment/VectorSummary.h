@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cache/DataObj.h"
+
+namespace milvus {
+namespace segment {
+
+/*
+ * A few k-means centroids of the float vectors of a segment and the radius of each cluster, small enough to be
+ * checked for every segment of a collection. They bound how close any vector of the segment can get to a query.
+ */
+class VectorSummary : public cache::DataObj {
+ public:
+    VectorSummary() = default;
+
+    // clusters count vectors of dimension floats, the centroids are trained on a sample of the vectors
+    VectorSummary(const float* vectors, size_t count, int64_t dimension);
+
+    int64_t
+    Dimension() const {
+        return dimension_;
+    }
+
+    size_t
+    CentroidCount() const {
+        return radius_.size();
+    }
+
+    // no vector of the segment has a squared L2 distance to query below this
+    float
+    L2LowerBound(const float* query) const;
+
+    // no vector of the segment has an inner product with query above this
+    float
+    IPUpperBound(const float* query) const;
+
+    int64_t
+    Size() override {
+        return (centroids_.size() + radius_.size()) * sizeof(float);
+    }
+
+    void
+    Serialize(std::vector<uint8_t>& buffer) const;
+
+    // returns false if the data is malformed
+    bool
+    Deserialize(const uint8_t* data, size_t size);
+
+    // No copy and move
+    VectorSummary(const VectorSummary&) = delete;
+    VectorSummary(VectorSummary&&) = delete;
+
+    VectorSummary&
+    operator=(const VectorSummary&) = delete;
+    VectorSummary&
+    operator=(VectorSummary&&) = delete;
+
+ private:
+    int64_t dimension_ = 0;
+    std::vector<float> centroids_;
+    std::vector<float> radius_;
+};
+
+using VectorSummaryPtr = std::shared_ptr<VectorSummary>;
+
+}  // namespace segment
+}  // namespace milvus
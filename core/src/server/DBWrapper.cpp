@@ -22,8 +22,11 @@
 #include "config/Utils.h"
 #include "db/DBFactory.h"
 #include "db/snapshot/OperationExecutor.h"
+#include "scheduler/ParallelismGovernor.h"
+#include "storage/IOScheduler.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
+#include "utils/StartupStages.h"
 #include "utils/StringHelpFunctions.h"
 
 namespace milvus {
@@ -42,6 +45,12 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetGeneralConfigMetaCacheTTL(opt.meta_.cache_ttl_ms_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     std::string path;
     s = config.GetStorageConfigPath(path);
     if (!s.ok()) {
@@ -62,6 +71,81 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetStorageConfigMergeStrategy(opt.merge_strategy_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetStorageConfigMergeWriteAmplification(opt.merge_write_amplification_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetStorageConfigMergeBytesLimit(opt.merge_bytes_limit_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    float auto_compact_threshold = 0.0;
+    s = config.GetStorageConfigCompactThreshold(auto_compact_threshold);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.auto_compact_threshold_ = auto_compact_threshold;
+
+    s = config.GetStorageConfigCompactBytesLimit(opt.auto_compact_bytes_limit_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    std::string cold_path;
+    s = config.GetStorageConfigColdPath(cold_path);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    if (!cold_path.empty()) {
+        opt.meta_.cold_path_ = cold_path + "/db";
+    }
+
+    s = config.GetStorageConfigHotCapacity(opt.hot_tier_capacity_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetStorageConfigGCThreadNum(opt.meta_.gc_thread_num_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetStorageConfigGCUnlinkRate(opt.meta_.gc_unlink_rate_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    int64_t background_io_rate = 0;
+    s = config.GetStorageConfigBackgroundIORate(background_io_rate);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    float io_latency_target = 0;
+    s = config.GetStorageConfigIOLatencyTarget(io_latency_target);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    storage::IOScheduler::GetInstance().Configure(background_io_rate, io_latency_target);
+
     // metric config
     s = config.GetMetricConfigEnableMonitor(opt.metric_enable_);
     if (!s.ok()) {
@@ -69,6 +153,14 @@ DBWrapper::StartService() {
         return s;
     }
 
+    float recall_sample_rate = 0.0;
+    s = config.GetMetricConfigRecallSampleRate(recall_sample_rate);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.recall_sample_rate_ = recall_sample_rate;
+
     // cache config
     s = config.GetCacheConfigCacheInsertData(opt.insert_cache_immediately_);
     if (!s.ok()) {
@@ -76,6 +168,12 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetCacheConfigWriteThroughIndex(opt.write_through_index_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     int64_t insert_buffer_size = 1 * engine::GB;
     s = config.GetCacheConfigInsertBufferSize(insert_buffer_size);
     if (!s.ok()) {
@@ -84,6 +182,38 @@ DBWrapper::StartService() {
     }
     opt.insert_buffer_size_ = insert_buffer_size;
 
+    float insert_buffer_target = 0.5;
+    s = config.GetCacheConfigInsertBufferTarget(insert_buffer_target);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.insert_buffer_target_ = insert_buffer_target;
+
+    s = config.GetCacheConfigResultCacheCapacity(opt.result_cache_capacity_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetCacheConfigPreloadThreadNum(opt.preload_thread_num_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetCacheConfigPreloadBandwidth(opt.preload_bandwidth_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetCacheConfigWarmUpSize(opt.warm_up_size_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     bool cluster_enable = false;
     std::string cluster_role;
     STATUS_CHECK(config.GetClusterConfigEnable(cluster_enable));
@@ -92,6 +222,7 @@ DBWrapper::StartService() {
         opt.mode_ = engine::DBOptions::MODE::SINGLE;
     } else if (cluster_role == "ro") {
         opt.mode_ = engine::DBOptions::MODE::CLUSTER_READONLY;
+        STATUS_CHECK(config.GetClusterConfigReplicaRefreshInterval(opt.replica_refresh_interval_ms_));
     } else if (cluster_role == "rw") {
         opt.mode_ = engine::DBOptions::MODE::CLUSTER_WRITABLE;
     } else {
@@ -131,6 +262,34 @@ DBWrapper::StartService() {
             std::cerr << s.ToString() << std::endl;
             kill(0, SIGUSR1);
         }
+
+        s = config.GetWalConfigSyncMode(opt.wal_sync_mode_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get sync_mode configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
+
+        s = config.GetWalConfigSyncInterval(opt.wal_sync_interval_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get sync_interval configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
+
+        s = config.GetWalConfigRecoveryThreadNum(opt.wal_recovery_thread_num_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get recovery_thread_num configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
+
+        s = config.GetWalConfigCompress(opt.wal_compress_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get compress configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
     }
 
     // engine config
@@ -151,6 +310,34 @@ DBWrapper::StartService() {
             omp_set_num_threads(omp_thread);
         }
     }
+    // the threads of a search task, which the governor also shares among the tasks running at once
+    scheduler::ParallelismGovernor::GetInstance().SetTaskMaxThreads(omp_thread);
+
+    float build_cpu_share = 0.25;
+    s = config.GetEngineConfigBuildCpuShare(build_cpu_share);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.build_cpu_share_ = build_cpu_share;
+
+    s = config.GetEngineConfigSearchLatencySloMs(opt.search_latency_slo_ms_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetEngineConfigSearchInsertBuffer(opt.search_insert_buffer_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetEngineConfigNumaAware(opt.numa_aware_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
 
     // init faiss global variable
     int64_t use_blas_threshold;
@@ -217,7 +404,10 @@ DBWrapper::StartService() {
         return s;
     }
 
-    s = PreloadCollections(preload_collections);
+    {
+        StartupStageGuard stage("preload");
+        s = PreloadCollections(preload_collections);
+    }
     if (!s.ok()) {
         std::cerr << "ERROR! Failed to preload tables: " << preload_collections << std::endl;
         std::cerr << s.ToString() << std::endl;
@@ -240,35 +430,26 @@ DBWrapper::StopService() {
 
 Status
 DBWrapper::PreloadCollections(const std::string& preload_collections) {
+    std::vector<std::string> collection_names;
     if (preload_collections.empty()) {
         // do nothing
     } else if (preload_collections == "*") {
         // load all tables
         // SS TODO: Replace name with id
-        std::vector<std::string> names;
-        auto status = db_->AllCollections(names);
+        auto status = db_->AllCollections(collection_names);
         if (!status.ok()) {
             return status;
         }
-
-        for (auto& name : names) {
-            auto status = db_->PreloadCollection(nullptr, name);
-            if (!status.ok()) {
-                return status;
-            }
-        }
     } else {
-        std::vector<std::string> collection_names;
         StringHelpFunctions::SplitStringByDelimeter(preload_collections, ",", collection_names);
-        for (auto& name : collection_names) {
-            auto status = db_->PreloadCollection(nullptr, name);
-            if (!status.ok()) {
-                return status;
-            }
-        }
     }
 
-    return Status::OK();
+    if (collection_names.empty()) {
+        return Status::OK();
+    }
+
+    // the server starts serving once the segments searched before the last shutdown are loaded
+    return db_->WarmUp(collection_names);
 }
 
 }  // namespace server
@@ -0,0 +1,221 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/Profiler.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "utils/Log.h"
+
+#ifdef ENABLE_CPU_PROFILING
+#include <gperftools/profiler.h>
+#endif
+
+#ifdef ENABLE_MEM_PROFILING
+#include <gperftools/malloc_extension.h>
+#endif
+
+namespace milvus {
+namespace server {
+
+namespace {
+
+constexpr size_t MAX_KEPT_PROFILES = 48;
+
+const char* CPU_PROFILE_PREFIX = "cpu_";
+const char* HEAP_PROFILE_PREFIX = "heap_";
+const char* PROFILE_SUFFIX = ".prof";
+
+Status
+ReadFile(const std::string& file, std::string& content) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) {
+        return Status(SERVER_CANNOT_OPEN_FILE, "Cannot open profile " + file);
+    }
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    content = buffer.str();
+    return Status::OK();
+}
+
+#ifdef ENABLE_MEM_PROFILING
+Status
+WriteFile(const std::string& file, const std::string& content) {
+    std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        return Status(SERVER_CANNOT_CREATE_FILE, "Cannot create profile " + file);
+    }
+    stream.write(content.data(), content.size());
+    return Status::OK();
+}
+#endif
+
+}  // namespace
+
+Profiler&
+Profiler::GetInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Status
+Profiler::CpuProfile(int64_t seconds, std::string& profile) {
+    boost::filesystem::path file =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("milvus_cpu_%%%%%%%%.prof");
+    auto status = ProfileToFile(seconds, file.string());
+    if (status.ok()) {
+        status = ReadFile(file.string(), profile);
+    }
+    boost::system::error_code err;
+    boost::filesystem::remove(file, err);
+    return status;
+}
+
+Status
+Profiler::HeapProfile(std::string& profile) {
+#ifdef ENABLE_MEM_PROFILING
+    MallocExtension::instance()->GetHeapSample(&profile);
+    return Status::OK();
+#else
+    return Status(SERVER_UNSUPPORTED_ERROR, "Heap profiling needs a build with ENABLE_MEM_PROFILING");
+#endif
+}
+
+Status
+Profiler::Start(int64_t interval, int64_t duration, const std::string& path) {
+    if (duration >= interval) {
+        return Status(SERVER_INVALID_ARGUMENT, "The profiling duration must be shorter than the profiling interval");
+    }
+#if !defined(ENABLE_CPU_PROFILING) && !defined(ENABLE_MEM_PROFILING)
+    return Status(SERVER_UNSUPPORTED_ERROR, "Profiling needs a build with ENABLE_CPU_PROFILING or ENABLE_MEM_PROFILING");
+#endif
+
+    boost::system::error_code err;
+    boost::filesystem::create_directories(path, err);
+    if (err) {
+        return Status(SERVER_CANNOT_CREATE_FOLDER, "Cannot create profile folder " + path + ": " + err.message());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return Status::OK();
+    }
+    interval_ = interval;
+    duration_ = duration;
+    path_ = path;
+    stop_ = false;
+    running_ = true;
+    worker_thread_ = std::thread(&Profiler::WorkerFunction, this);
+    LOG_SERVER_INFO_ << "Continuous profiling every " << interval << "s for " << duration << "s into " << path;
+    return Status::OK();
+}
+
+void
+Profiler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+
+    if (worker_thread_.joinable()) {
+        worker_thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    stop_ = false;
+}
+
+Status
+Profiler::ProfileToFile(int64_t seconds, const std::string& file) {
+#ifdef ENABLE_CPU_PROFILING
+    std::lock_guard<std::mutex> lock(profile_mutex_);
+    if (!ProfilerStart(file.c_str())) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot start the CPU profiler, another profile may be running");
+    }
+    Wait(seconds);
+    ProfilerStop();
+    return Status::OK();
+#else
+    return Status(SERVER_UNSUPPORTED_ERROR, "CPU profiling needs a build with ENABLE_CPU_PROFILING");
+#endif
+}
+
+bool
+Profiler::Wait(int64_t seconds) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return !cv_.wait_for(lock, std::chrono::seconds(seconds), [this] { return stop_; });
+}
+
+void
+Profiler::WorkerFunction() {
+    SetThreadName("profiler");
+
+    while (Wait(interval_ - duration_)) {
+        auto now = std::to_string(time(nullptr));
+        Status status;
+#ifdef ENABLE_CPU_PROFILING
+        status = ProfileToFile(duration_, path_ + "/" + CPU_PROFILE_PREFIX + now + PROFILE_SUFFIX);
+        if (!status.ok()) {
+            LOG_SERVER_WARNING_ << "Continuous CPU profile failed: " << status.message();
+        }
+#else
+        if (!Wait(duration_)) {
+            break;
+        }
+#endif
+
+#ifdef ENABLE_MEM_PROFILING
+        std::string heap;
+        HeapProfile(heap);
+        status = WriteFile(path_ + "/" + HEAP_PROFILE_PREFIX + now + PROFILE_SUFFIX, heap);
+        if (!status.ok()) {
+            LOG_SERVER_WARNING_ << "Continuous heap profile failed: " << status.message();
+        }
+#endif
+
+        RemoveOldProfiles();
+    }
+}
+
+void
+Profiler::RemoveOldProfiles() {
+    // the names carry the epoch seconds, so the name order is the time order
+    for (auto prefix : {CPU_PROFILE_PREFIX, HEAP_PROFILE_PREFIX}) {
+        std::vector<std::string> files;
+        boost::system::error_code err;
+        for (boost::filesystem::directory_iterator it(path_, err), end; !err && it != end; it.increment(err)) {
+            auto name = it->path().filename().string();
+            if (name.compare(0, strlen(prefix), prefix) == 0) {
+                files.push_back(it->path().string());
+            }
+        }
+        if (files.size() <= MAX_KEPT_PROFILES) {
+            continue;
+        }
+
+        std::sort(files.begin(), files.end());
+        for (size_t i = 0; i < files.size() - MAX_KEPT_PROFILES; ++i) {
+            boost::filesystem::remove(files[i], err);
+        }
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
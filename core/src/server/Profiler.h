@@ -0,0 +1,80 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+
+/*
+ * CPU profiles of the gperftools profiler (ENABLE_CPU_PROFILING builds) and heap samples of
+ * tcmalloc (ENABLE_MEM_PROFILING builds), both in pprof format.
+ * The CPU profiler is process wide: profiles taken on demand and the continuous ones run one at a time.
+ */
+class Profiler {
+ public:
+    static Profiler&
+    GetInstance();
+
+    // profile the CPU for seconds and return the profile
+    Status
+    CpuProfile(int64_t seconds, std::string& profile);
+
+    // the sampled live heap, empty unless tcmalloc samples (TCMALLOC_SAMPLE_PARAMETER)
+    Status
+    HeapProfile(std::string& profile);
+
+    // every interval seconds profile the CPU for duration seconds, profiles are kept in path
+    Status
+    Start(int64_t interval, int64_t duration, const std::string& path);
+
+    void
+    Stop();
+
+ private:
+    Profiler() = default;
+
+    Status
+    ProfileToFile(int64_t seconds, const std::string& file);
+
+    // false if stopped while waiting
+    bool
+    Wait(int64_t seconds);
+
+    void
+    WorkerFunction();
+
+    void
+    RemoveOldProfiles();
+
+ private:
+    std::mutex profile_mutex_;  // serializes the CPU profiles
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+    bool stop_ = false;  // ends the waits of the running profiles
+    std::thread worker_thread_;
+    int64_t interval_ = 0;
+    int64_t duration_ = 0;
+    std::string path_;
+};
+
+}  // namespace server
+}  // namespace milvus
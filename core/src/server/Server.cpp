@@ -16,13 +16,18 @@
 #include <unistd.h>
 #include <boost/filesystem.hpp>
 #include <cstring>
+#include <future>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "cache/GpuResidencyMgr.h"
 #include "config/Config.h"
 #include "index/archive/KnowhereResource.h"
 #include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "server/DBWrapper.h"
+#include "server/Profiler.h"
 #include "server/grpc_impl/GrpcServer.h"
 #include "server/init/CpuChecker.h"
 #include "server/init/GpuChecker.h"
@@ -31,9 +36,11 @@
 #include "src/version.h"
 //#include "storage/s3/S3ClientWrapper.h"
 #include "tracing/TracerUtil.h"
+#include "utils/AsyncLog.h"
 #include "utils/Log.h"
 #include "utils/LogUtil.h"
 #include "utils/SignalHandler.h"
+#include "utils/StartupStages.h"
 #include "utils/TimeRecorder.h"
 
 #include "search/TaskInst.h"
@@ -145,8 +152,15 @@ Server::Start() {
     }
 
     try {
+        // until the requests are served
+        StartupStageGuard ready_stage("ready");
+
         /* Read config file */
-        Status s = LoadConfig();
+        Status s;
+        {
+            StartupStageGuard stage("load_config");
+            s = LoadConfig();
+        }
         if (!s.ok()) {
             std::cerr << "ERROR: Milvus server fail to load config file" << std::endl;
             return s;
@@ -233,6 +247,28 @@ Server::Start() {
             STATUS_CHECK(config.GetLogsLogRotateNum(delete_exceeds));
             InitLog(trace_enable, debug_enable, info_enable, warning_enable, error_enable, fatal_enable, logs_path,
                     max_log_file_size, delete_exceeds);
+
+            bool async_enable = false;
+            STATUS_CHECK(config.GetLogsAsyncEnable(async_enable));
+            if (async_enable) {
+                int64_t async_buffer_size = 0;
+                int64_t async_rate_limit = 0;
+                STATUS_CHECK(config.GetLogsAsyncBufferSize(async_buffer_size));
+                STATUS_CHECK(config.GetLogsAsyncRateLimit(async_rate_limit));
+
+                std::vector<std::pair<bool, el::Level>> level_enables{
+                    {trace_enable, el::Level::Trace},     {debug_enable, el::Level::Debug},
+                    {info_enable, el::Level::Info},       {warning_enable, el::Level::Warning},
+                    {error_enable, el::Level::Error},     {fatal_enable, el::Level::Fatal},
+                };
+                uint32_t levels = 0;
+                for (auto& level_enable : level_enables) {
+                    if (level_enable.first) {
+                        levels |= static_cast<uint32_t>(level_enable.second);
+                    }
+                }
+                AsyncLog::GetInstance().Start(async_buffer_size, async_rate_limit, levels);
+            }
         }
 
         bool cluster_enable = false;
@@ -293,11 +329,22 @@ Server::Start() {
 #else
         LOG_SERVER_INFO_ << "CPU edition";
 #endif
-        STATUS_CHECK(StorageChecker::CheckStoragePermission());
-        STATUS_CHECK(CpuChecker::CheckCpuInstructionSet());
+        {
+            // the checks are independent, the storage and gpu ones can take seconds each
+            StartupStageGuard stage("check_environment");
+            auto storage_checked = std::async(std::launch::async, &StorageChecker::CheckStoragePermission);
 #ifdef MILVUS_GPU_VERSION
-        STATUS_CHECK(GpuChecker::CheckGpuEnvironment());
+            auto gpu_checked = std::async(std::launch::async, &GpuChecker::CheckGpuEnvironment);
 #endif
+            auto cpu_status = CpuChecker::CheckCpuInstructionSet();
+            auto storage_status = storage_checked.get();
+#ifdef MILVUS_GPU_VERSION
+            auto gpu_status = gpu_checked.get();
+            STATUS_CHECK(gpu_status);
+#endif
+            STATUS_CHECK(storage_status);
+            STATUS_CHECK(cpu_status);
+        }
         /* record config and hardware information into log */
         LogConfigInFile(config_filename_);
         LogCpuInfo();
@@ -342,6 +389,9 @@ Server::Stop() {
 
     StopService();
 
+    // the lines still queued by the asynchronous logging are written before exit
+    AsyncLog::GetInstance().Stop();
+
     std::cerr << "Milvus server exit..." << std::endl;
 }
 
@@ -365,15 +415,69 @@ Server::LoadConfig() {
 Status
 Server::StartService() {
     Status stat;
-    stat = engine::KnowhereResource::Initialize();
+    {
+        // the gpu resources of knowhere and the resources of the scheduler are brought up together
+        auto knowhere_initialized = std::async(std::launch::async, []() {
+            StartupStageGuard stage("knowhere_resource");
+            return engine::KnowhereResource::Initialize();
+        });
+        {
+            StartupStageGuard stage("scheduler");
+            scheduler::StartSchedulerService();
+        }
+        stat = knowhere_initialized.get();
+    }
     if (!stat.ok()) {
         LOG_SERVER_ERROR_ << "KnowhereResource initialize fail: " << stat.message();
         goto FAIL;
     }
 
-    scheduler::StartSchedulerService();
+    {
+        int64_t reclaim_queue_size;
+        Config::GetInstance().GetCacheConfigReclaimQueueSize(reclaim_queue_size);
+        cache::CacheReclaimer::GetInstance().Start(reclaim_queue_size);
+    }
+
+    {
+        int64_t profiling_interval = 0;
+        int64_t profiling_duration = 0;
+        std::string logs_path;
+        Config::GetInstance().GetMetricConfigProfilingInterval(profiling_interval);
+        Config::GetInstance().GetMetricConfigProfilingDuration(profiling_duration);
+        Config::GetInstance().GetLogsPath(logs_path);
+        if (profiling_interval > 0) {
+            // profiling is a diagnostic aid, the server runs without it
+            auto profiling_stat =
+                Profiler::GetInstance().Start(profiling_interval, profiling_duration, logs_path + "/profiles");
+            if (!profiling_stat.ok()) {
+                LOG_SERVER_WARNING_ << "Continuous profiling not started: " << profiling_stat.message();
+            }
+        }
+    }
+
+#ifdef MILVUS_GPU_VERSION
+    {
+        bool gpu_enable = false;
+        int64_t prefetch_depth = 0;
+        bool keep_fresh_segments = false;
+        std::vector<int64_t> search_gpus;
+        Config::GetInstance().GetGpuResourceConfigEnable(gpu_enable);
+        Config::GetInstance().GetGpuResourceConfigPrefetchDepth(prefetch_depth);
+        Config::GetInstance().GetGpuResourceConfigKeepFreshSegments(keep_fresh_segments);
+        Config::GetInstance().GetGpuResourceConfigSearchResources(search_gpus);
+        if (gpu_enable) {
+            cache::GpuResidencyMgr::GetInstance().Start(prefetch_depth);
+            if (keep_fresh_segments) {
+                cache::GpuResidencyMgr::GetInstance().KeepFreshSegments(search_gpus);
+            }
+        }
+    }
+#endif
 
-    stat = DBWrapper::GetInstance().StartService();
+    {
+        StartupStageGuard stage("open_db");
+        stat = DBWrapper::GetInstance().StartService();
+    }
     if (!stat.ok()) {
         LOG_SERVER_ERROR_ << "DBWrapper start service fail: " << stat.message();
         goto FAIL;
@@ -403,7 +507,12 @@ Server::StopService() {
     web::WebServer::GetInstance().Stop();
     grpc::GrpcServer::GetInstance().Stop();
     DBWrapper::GetInstance().StopService();
+    Profiler::GetInstance().Stop();
+    cache::CacheReclaimer::GetInstance().Stop();
     scheduler::StopSchedulerService();
+#ifdef MILVUS_GPU_VERSION
+    cache::GpuResidencyMgr::GetInstance().Stop();
+#endif
     engine::KnowhereResource::Finalize();
 }
 
@@ -17,6 +17,7 @@
 #include "utils/StringHelpFunctions.h"
 
 #include <fiu-local.h>
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -88,6 +89,112 @@ CheckParameterExistence(const milvus::json& json_params, const std::string& para
     return Status::OK();
 }
 
+Status
+CheckStorageType(const milvus::json& json_params) {
+    // storage type of the raw data is optional, float32 by default
+    if (json_params.find(knowhere::IndexParams::storage_type) == json_params.end()) {
+        return Status::OK();
+    }
+
+    auto& value = json_params[knowhere::IndexParams::storage_type];
+    if (!value.is_string() || (value.get<std::string>() != knowhere::StorageType::FLOAT32 &&
+                               value.get<std::string>() != knowhere::StorageType::FLOAT16 &&
+                               value.get<std::string>() != knowhere::StorageType::BFLOAT16)) {
+        std::string msg = "Invalid " + std::string(knowhere::IndexParams::storage_type) + ": " + value.dump() +
+                          ", must be one of float32, float16, bfloat16";
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+CheckOnDisk(const milvus::json& json_params, bool supported) {
+    // the inverted lists are kept in the index file only on request
+    if (json_params.find(knowhere::IndexParams::on_disk) == json_params.end()) {
+        return Status::OK();
+    }
+
+    auto& value = json_params[knowhere::IndexParams::on_disk];
+    if (!value.is_boolean()) {
+        std::string msg = "Invalid " + std::string(knowhere::IndexParams::on_disk) + ": " + value.dump() +
+                          ", must be a boolean";
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    if (!supported && value.get<bool>()) {
+        std::string msg = std::string(knowhere::IndexParams::on_disk) + " is not supported by this index type";
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+CheckSQBits(const milvus::json& json_params, bool low_bits_supported) {
+    // the bits per dimension of the scalar quantizer are optional, 8 by default
+    if (json_params.find(knowhere::IndexParams::nbits) == json_params.end()) {
+        return Status::OK();
+    }
+
+    auto& value = json_params[knowhere::IndexParams::nbits];
+    if (value.is_number_integer()) {
+        int64_t nbits = value.get<int64_t>();
+        if (nbits == 8 || (low_bits_supported && (nbits == 4 || nbits == 6))) {
+            return Status::OK();
+        }
+    }
+    std::string msg = "Invalid " + std::string(knowhere::IndexParams::nbits) + ": " + value.dump() +
+                      (low_bits_supported ? ", must be one of 4, 6, 8" : ", must be 8");
+    LOG_SERVER_ERROR_ << msg;
+    return Status(SERVER_INVALID_ARGUMENT, msg);
+}
+
+Status
+CheckTrainParams(const milvus::json& json_params) {
+    // the training of the float ivf indexes is tuned by optional params only
+    if (json_params.find(knowhere::IndexParams::train_mode) != json_params.end()) {
+        auto& value = json_params[knowhere::IndexParams::train_mode];
+        if (!value.is_string() || (value.get<std::string>() != knowhere::TrainMode::LLOYD &&
+                                   value.get<std::string>() != knowhere::TrainMode::MINI_BATCH &&
+                                   value.get<std::string>() != knowhere::TrainMode::HIERARCHICAL &&
+                                   value.get<std::string>() != knowhere::TrainMode::BALANCED)) {
+            std::string msg = "Invalid " + std::string(knowhere::IndexParams::train_mode) + ": " + value.dump() +
+                              ", must be one of lloyd, mini_batch, hierarchical, balanced";
+            LOG_SERVER_ERROR_ << msg;
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+
+    if (json_params.find(knowhere::IndexParams::train_size) != json_params.end()) {
+        auto status = CheckParameterRange(json_params, knowhere::IndexParams::train_size, 1,
+                                          std::numeric_limits<int64_t>::max());
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    if (json_params.find(knowhere::IndexParams::batch_size) != json_params.end()) {
+        auto status = CheckParameterRange(json_params, knowhere::IndexParams::batch_size, 1,
+                                          std::numeric_limits<int64_t>::max());
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    if (json_params.find(knowhere::IndexParams::shared_quantizer) != json_params.end() &&
+        !json_params[knowhere::IndexParams::shared_quantizer].is_boolean()) {
+        std::string msg = "Invalid " + std::string(knowhere::IndexParams::shared_quantizer) + ": " +
+                          json_params[knowhere::IndexParams::shared_quantizer].dump() + ", must be a boolean";
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
 }  // namespace
 
 Status
@@ -180,7 +287,23 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
         case (int32_t)engine::EngineType::FAISS_BIN_IDMAP: {
             break;
         }
-        case (int32_t)engine::EngineType::FAISS_IVFFLAT:
+        case (int32_t)engine::EngineType::FAISS_IVFFLAT: {
+            auto status = CheckParameterRange(index_params, knowhere::IndexParams::nlist, 1, 999999);
+            if (!status.ok()) {
+                return status;
+            }
+
+            status = CheckStorageType(index_params);
+            if (!status.ok()) {
+                return status;
+            }
+
+            status = CheckTrainParams(index_params);
+            if (!status.ok()) {
+                return status;
+            }
+            break;
+        }
         case (int32_t)engine::EngineType::FAISS_IVFSQ8:
         case (int32_t)engine::EngineType::FAISS_IVFSQ8NR:
         case (int32_t)engine::EngineType::FAISS_IVFSQ8H:
@@ -189,9 +312,27 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
             if (!status.ok()) {
                 return status;
             }
+
+            status = CheckOnDisk(index_params, index_type == (int32_t)engine::EngineType::FAISS_IVFSQ8);
+            if (!status.ok()) {
+                return status;
+            }
+
+            if (index_type != (int32_t)engine::EngineType::FAISS_BIN_IVFFLAT) {
+                status = CheckSQBits(index_params, index_type != (int32_t)engine::EngineType::FAISS_IVFSQ8H);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+
+            status = CheckTrainParams(index_params);
+            if (!status.ok()) {
+                return status;
+            }
             break;
         }
-        case (int32_t)engine::EngineType::FAISS_PQ: {
+        case (int32_t)engine::EngineType::FAISS_PQ:
+        case (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN: {
             auto status = CheckParameterRange(index_params, knowhere::IndexParams::nlist, 1, 999999);
             if (!status.ok()) {
                 return status;
@@ -202,6 +343,16 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
                 return status;
             }
 
+            status = CheckOnDisk(index_params, index_type == (int32_t)engine::EngineType::FAISS_PQ);
+            if (!status.ok()) {
+                return status;
+            }
+
+            status = CheckTrainParams(index_params);
+            if (!status.ok()) {
+                return status;
+            }
+
             // special check for 'm' parameter
             std::vector<int64_t> resset;
             milvus::knowhere::IVFPQConfAdapter::GetValidMList(collection_schema.dimension_, resset);
@@ -258,6 +409,12 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
             if (!status.ok()) {
                 return status;
             }
+            if (index_type == (int32_t)engine::EngineType::HNSW_SQ8NR) {
+                status = CheckSQBits(index_params, true);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
             break;
         }
         case (int32_t)engine::EngineType::ANNOY: {
@@ -267,6 +424,51 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
             }
             break;
         }
+        case (int32_t)engine::EngineType::DISKANN: {
+            auto status = CheckParameterRange(index_params, knowhere::IndexParams::out_degree, 5, 300);
+            if (!status.ok()) {
+                return status;
+            }
+            status = CheckParameterRange(index_params, knowhere::IndexParams::candidate, 50, 1000);
+            if (!status.ok()) {
+                return status;
+            }
+            status = CheckParameterRange(index_params, knowhere::IndexParams::m, 1, collection_schema.dimension_);
+            if (!status.ok()) {
+                return status;
+            }
+
+            // each PQ sub-quantizer encodes an equal slice of the vector
+            int64_t m_value = index_params[knowhere::IndexParams::m];
+            if (collection_schema.dimension_ % m_value != 0) {
+                std::string msg = "Invalid m, dimension " + std::to_string(collection_schema.dimension_) +
+                                  " can not be divided by m " + std::to_string(m_value);
+                LOG_SERVER_ERROR_ << msg;
+                return Status(SERVER_INVALID_ARGUMENT, msg);
+            }
+            break;
+        }
+        case (int32_t)engine::EngineType::FAISS_BIN_HASH: {
+            if (collection_schema.metric_type_ != (int32_t)engine::MetricType::HAMMING) {
+                std::string msg = "Invalid index type for collection metric type, BIN_HASH supports HAMMING only";
+                LOG_SERVER_ERROR_ << msg;
+                return Status(SERVER_INVALID_INDEX_TYPE, msg);
+            }
+            auto status = CheckParameterRange(index_params, knowhere::IndexParams::nbits, 1,
+                                              std::min<int64_t>(collection_schema.dimension_, 32));
+            if (!status.ok()) {
+                return status;
+            }
+
+            // the hash keys are cut from the code without overlapping
+            int64_t nbits = index_params[knowhere::IndexParams::nbits];
+            status = CheckParameterRange(index_params, knowhere::IndexParams::nhash, 1,
+                                         collection_schema.dimension_ / nbits);
+            if (!status.ok()) {
+                return status;
+            }
+            break;
+        }
     }
     return Status::OK();
 }
@@ -274,6 +476,21 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
 Status
 ValidateSearchParams(const milvus::json& search_params, const engine::meta::CollectionSchema& collection_schema,
                      int64_t topk) {
+    // optional, turns the search into a range search keeping at most topk results per query
+    if (search_params.contains(knowhere::meta::RADIUS) && !search_params[knowhere::meta::RADIUS].is_number()) {
+        std::string msg = "Invalid " + std::string(knowhere::meta::RADIUS) + ": must be a number";
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    // optional, the compressed indexes return refine_k candidates which are re-scored with the raw vectors
+    if (search_params.contains(knowhere::IndexParams::refine_k)) {
+        auto status = CheckParameterRange(search_params, knowhere::IndexParams::refine_k, topk, 16384);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
     switch (collection_schema.engine_type_) {
         case (int32_t)engine::EngineType::FAISS_IDMAP:
         case (int32_t)engine::EngineType::FAISS_BIN_IDMAP: {
@@ -284,11 +501,19 @@ ValidateSearchParams(const milvus::json& search_params, const engine::meta::Coll
         case (int32_t)engine::EngineType::FAISS_IVFSQ8NR:
         case (int32_t)engine::EngineType::FAISS_IVFSQ8H:
         case (int32_t)engine::EngineType::FAISS_BIN_IVFFLAT:
-        case (int32_t)engine::EngineType::FAISS_PQ: {
+        case (int32_t)engine::EngineType::FAISS_PQ:
+        case (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN: {
             auto status = CheckParameterRange(search_params, knowhere::IndexParams::nprobe, 1, 999999);
             if (!status.ok()) {
                 return status;
             }
+            if (search_params.contains(knowhere::IndexParams::lut_fp16) &&
+                !search_params[knowhere::IndexParams::lut_fp16].is_boolean()) {
+                std::string msg = "Invalid " + std::string(knowhere::IndexParams::lut_fp16) + ": " +
+                                  search_params[knowhere::IndexParams::lut_fp16].dump() + ", must be a boolean";
+                LOG_SERVER_ERROR_ << msg;
+                return Status(SERVER_INVALID_ARGUMENT, msg);
+            }
             break;
         }
         case (int32_t)engine::EngineType::NSG_MIX: {
@@ -314,6 +539,26 @@ ValidateSearchParams(const milvus::json& search_params, const engine::meta::Coll
             }
             break;
         }
+        case (int32_t)engine::EngineType::DISKANN: {
+            auto status = CheckParameterRange(search_params, knowhere::IndexParams::search_length, topk, 4096);
+            if (!status.ok()) {
+                return status;
+            }
+            if (search_params.contains(knowhere::IndexParams::beam_width)) {
+                status = CheckParameterRange(search_params, knowhere::IndexParams::beam_width, 1, 64);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+            break;
+        }
+        case (int32_t)engine::EngineType::FAISS_BIN_HASH: {
+            auto status = CheckParameterRange(search_params, knowhere::IndexParams::nflip, 0, 8);
+            if (!status.ok()) {
+                return status;
+            }
+            break;
+        }
     }
     return Status::OK();
 }
@@ -407,6 +652,27 @@ ValidateSearchTopk(int64_t top_k) {
     return Status::OK();
 }
 
+Status
+ValidateSearchMemory(int64_t nq, int64_t top_k, int64_t memory_limit) {
+    if (memory_limit <= 0) {
+        return Status::OK();
+    }
+
+    // the ids and distances are held by the search job, copied to the request and again to the reply
+    constexpr int64_t RESULT_COPIES = 3;
+    int64_t bytes = nq * top_k * static_cast<int64_t>(sizeof(engine::IDNumber) + sizeof(float)) * RESULT_COPIES;
+    if (bytes > memory_limit) {
+        std::string msg = "The results of " + std::to_string(nq) + " queries of topk " + std::to_string(top_k) +
+                          " need " + std::to_string(bytes) + " bytes, more than the limit of " +
+                          std::to_string(memory_limit) + " bytes of engine_config.search_memory_limit. " +
+                          "Split the queries into smaller requests.";
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_OUT_OF_MEMORY, msg);
+    }
+
+    return Status::OK();
+}
+
 Status
 ValidatePartitionName(const std::string& partition_name) {
     if (partition_name.empty()) {
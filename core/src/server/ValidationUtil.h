@@ -56,6 +56,10 @@ ValidateCollectionIndexMetricType(int32_t metric_type);
 extern Status
 ValidateSearchTopk(int64_t top_k);
 
+// whether the results of nq queries of top_k fit in the memory limit of a request, 0 for no limit
+extern Status
+ValidateSearchMemory(int64_t nq, int64_t top_k, int64_t memory_limit);
+
 extern Status
 ValidatePartitionName(const std::string& partition_name);
 
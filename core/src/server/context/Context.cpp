@@ -14,7 +14,23 @@
 namespace milvus {
 namespace server {
 
-Context::Context(const std::string& request_id) : request_id_(request_id) {
+milvus::json
+SearchCost::ToJson() const {
+    milvus::json cost;
+    cost["segments_searched"] = segments_searched.load();
+    cost["cache_hits"] = cache_hits.load();
+    cost["cache_misses"] = cache_misses.load();
+    cost["bytes_loaded"] = bytes_loaded.load();
+    cost["queue_wait_us"] = queue_wait_us.load();
+    cost["load_us"] = load_us.load();
+    cost["search_us"] = search_us.load();
+    cost["reduce_us"] = reduce_us.load();
+    return cost;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+Context::Context(const std::string& request_id)
+    : request_id_(request_id), cost_(std::make_shared<SearchCost>()), memory_(std::make_shared<RequestMemory>()) {
 }
 
 const std::shared_ptr<tracing::TraceContext>&
@@ -30,6 +46,11 @@ std::shared_ptr<Context>
 Context::Child(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
     new_context->SetTraceContext(trace_context_->Child(operation_name));
+    new_context->SetDeadline(deadline_);
+    new_context->context_ = context_;
+    new_context->cost_ = cost_;
+    new_context->memory_ = memory_;
+    new_context->sampled_ = sampled_;
     return new_context;
 }
 
@@ -37,6 +58,11 @@ std::shared_ptr<Context>
 Context::Follower(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
     new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    new_context->SetDeadline(deadline_);
+    new_context->context_ = context_;
+    new_context->cost_ = cost_;
+    new_context->memory_ = memory_;
+    new_context->sampled_ = sampled_;
     return new_context;
 }
 
@@ -64,6 +90,36 @@ Context::SetRequestType(BaseRequest::RequestType type) {
     request_type_ = type;
 }
 
+const std::chrono::steady_clock::time_point&
+Context::Deadline() const {
+    return deadline_;
+}
+
+void
+Context::SetDeadline(const std::chrono::steady_clock::time_point& deadline) {
+    deadline_ = deadline;
+}
+
+const SearchCostPtr&
+Context::Cost() const {
+    return cost_;
+}
+
+const RequestMemoryPtr&
+Context::Memory() const {
+    return memory_;
+}
+
+bool
+Context::IsSampled() const {
+    return sampled_;
+}
+
+void
+Context::SetSampled(bool sampled) {
+    sampled_ = sampled;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 ContextChild::ContextChild(const ContextPtr& context, const std::string& operation_name) {
     if (context) {
@@ -104,5 +160,37 @@ ContextFollower::Finish() {
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+ContextSampledSpan::ContextSampledSpan(const ContextPtr& context, const std::string& operation_name) {
+    if (context != nullptr && context->IsSampled() && context->GetTraceContext() != nullptr) {
+        trace_context_ = context->GetTraceContext()->Follower(operation_name);
+    }
+}
+
+ContextSampledSpan::ContextSampledSpan(const ContextSampledSpan& parent, const std::string& operation_name) {
+    if (parent.trace_context_ != nullptr) {
+        trace_context_ = parent.trace_context_->Child(operation_name);
+    }
+}
+
+ContextSampledSpan::~ContextSampledSpan() {
+    Finish();
+}
+
+void
+ContextSampledSpan::SetTag(const std::string& key, const opentracing::Value& value) {
+    if (trace_context_ != nullptr) {
+        trace_context_->GetSpan()->SetTag(key, value);
+    }
+}
+
+void
+ContextSampledSpan::Finish() {
+    if (trace_context_ != nullptr) {
+        trace_context_->GetSpan()->Finish();
+        trace_context_ = nullptr;
+    }
+}
+
 }  // namespace server
 }  // namespace milvus
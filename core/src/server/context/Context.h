@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -20,10 +22,37 @@
 #include "server/context/ConnectionContext.h"
 #include "server/delivery/request/BaseRequest.h"
 #include "tracing/TraceContext.h"
+#include "utils/Json.h"
 
 namespace milvus {
 namespace server {
 
+// What a search request costs, summed up by the tasks of its search jobs. The contexts derived from the request
+// context share one instance, the times are in microseconds.
+struct SearchCost {
+    std::atomic<int64_t> segments_searched{0};
+    std::atomic<int64_t> cache_hits{0};
+    std::atomic<int64_t> cache_misses{0};
+    std::atomic<int64_t> bytes_loaded{0};
+    std::atomic<int64_t> queue_wait_us{0};
+    std::atomic<int64_t> load_us{0};
+    std::atomic<int64_t> search_us{0};
+    std::atomic<int64_t> reduce_us{0};
+
+    milvus::json
+    ToJson() const;
+};
+
+using SearchCostPtr = std::shared_ptr<SearchCost>;
+
+// Bytes of the results held for a request by its search jobs, checked against engine_config.search_memory_limit.
+// The contexts derived from the request context share one instance.
+struct RequestMemory {
+    std::atomic<int64_t> bytes{0};
+};
+
+using RequestMemoryPtr = std::shared_ptr<RequestMemory>;
+
 class Context {
  public:
     explicit Context(const std::string& request_id);
@@ -57,11 +86,35 @@ class Context {
     void
     SetRequestType(BaseRequest::RequestType type);
 
+    // the time the client stops waiting for the request, time_point::max() if it waits forever
+    const std::chrono::steady_clock::time_point&
+    Deadline() const;
+
+    void
+    SetDeadline(const std::chrono::steady_clock::time_point& deadline);
+
+    const SearchCostPtr&
+    Cost() const;
+
+    const RequestMemoryPtr&
+    Memory() const;
+
+    // the hot path spans of the request are recorded, decided once by the head sampler when the request is created
+    bool
+    IsSampled() const;
+
+    void
+    SetSampled(bool sampled);
+
  private:
     std::string request_id_;
     BaseRequest::RequestType request_type_;
     std::shared_ptr<tracing::TraceContext> trace_context_;
     ConnectionContextPtr context_;
+    std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+    SearchCostPtr cost_;
+    RequestMemoryPtr memory_;
+    bool sampled_ = true;
 };
 
 using ContextPtr = std::shared_ptr<milvus::server::Context>;
@@ -100,5 +153,32 @@ class ContextFollower {
     ContextPtr context_;
 };
 
+// A span of the hot path, e.g. a task load or an index query. It is only recorded for the sampled requests, for the
+// others it costs a flag check.
+class ContextSampledSpan {
+ public:
+    // follows the span of the context
+    ContextSampledSpan(const ContextPtr& context, const std::string& operation_name);
+
+    // child of another hot path span
+    ContextSampledSpan(const ContextSampledSpan& parent, const std::string& operation_name);
+
+    ~ContextSampledSpan();
+
+    bool
+    IsRecording() const {
+        return trace_context_ != nullptr;
+    }
+
+    void
+    SetTag(const std::string& key, const opentracing::Value& value);
+
+    void
+    Finish();
+
+ private:
+    std::unique_ptr<tracing::TraceContext> trace_context_;
+};
+
 }  // namespace server
 }  // namespace milvus
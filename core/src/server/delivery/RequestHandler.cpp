@@ -53,9 +53,9 @@ namespace server {
 
 Status
 RequestHandler::CreateCollection(const std::shared_ptr<Context>& context, const std::string& collection_name,
-                                 int64_t dimension, int64_t index_file_size, int64_t metric_type) {
+                                 int64_t dimension, int64_t index_file_size, int64_t metric_type, int64_t ttl_days) {
     BaseRequestPtr request_ptr =
-        CreateCollectionRequest::Create(context, collection_name, dimension, index_file_size, metric_type);
+        CreateCollectionRequest::Create(context, collection_name, dimension, index_file_size, metric_type, ttl_days);
     RequestScheduler::ExecRequest(request_ptr);
 
     return request_ptr->status();
@@ -190,8 +190,9 @@ RequestHandler::DeleteByID(const std::shared_ptr<Context>& context, const std::s
 }
 
 Status
-RequestHandler::PreloadCollection(const std::shared_ptr<Context>& context, const std::string& collection_name) {
-    BaseRequestPtr request_ptr = PreloadCollectionRequest::Create(context, collection_name);
+RequestHandler::PreloadCollection(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                                  int64_t cache_quota, bool pinned) {
+    BaseRequestPtr request_ptr = PreloadCollectionRequest::Create(context, collection_name, cache_quota, pinned);
     RequestScheduler::ExecRequest(request_ptr);
 
     return request_ptr->status();
@@ -349,5 +350,34 @@ RequestHandler::CreateHybridIndex(const std::shared_ptr<Context>& context, const
     return request_ptr->status();
 }
 
+void
+RequestHandler::InsertAsync(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                            engine::VectorsData& vectors, const std::string& partition_tag,
+                            const BaseRequest::DoneCallback& callback) {
+    BaseRequestPtr request_ptr = InsertRequest::Create(context, collection_name, vectors, partition_tag);
+    RequestScheduler::ExecRequestAsync(request_ptr, callback);
+}
+
+void
+RequestHandler::SearchAsync(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                            engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
+                            const std::vector<std::string>& partition_list,
+                            const std::vector<std::string>& file_id_list, TopKQueryResult& result,
+                            const BaseRequest::DoneCallback& callback) {
+    BaseRequestPtr request_ptr = SearchRequest::Create(context, collection_name, vectors, topk, extra_params,
+                                                       partition_list, file_id_list, result);
+    RequestScheduler::ExecRequestAsync(request_ptr, callback);
+}
+
+void
+RequestHandler::SearchByIDAsync(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                                const std::vector<int64_t>& id_array, int64_t topk, const milvus::json& extra_params,
+                                const std::vector<std::string>& partition_list, TopKQueryResult& result,
+                                const BaseRequest::DoneCallback& callback) {
+    BaseRequestPtr request_ptr =
+        SearchByIDRequest::Create(context, collection_name, id_array, topk, extra_params, partition_list, result);
+    RequestScheduler::ExecRequestAsync(request_ptr, callback);
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -31,7 +31,7 @@ class RequestHandler {
 
     Status
     CreateCollection(const std::shared_ptr<Context>& context, const std::string& collection_name, int64_t dimension,
-                     int64_t index_file_size, int64_t metric_type);
+                     int64_t index_file_size, int64_t metric_type, int64_t ttl_days = 0);
 
     Status
     HasCollection(const std::shared_ptr<Context>& context, const std::string& collection_name, bool& has_collection);
@@ -86,8 +86,11 @@ class RequestHandler {
     DeleteByID(const std::shared_ptr<Context>& context, const std::string& collection_name,
                const std::vector<int64_t>& vector_ids);
 
+    // cache_quota: bytes the collection can occupy in cpu cache, 0 means no quota, negative keeps the current setting
+    // pinned: segments of the collection are not evicted for other collections, ignored if cache_quota is negative
     Status
-    PreloadCollection(const std::shared_ptr<Context>& context, const std::string& collection_name);
+    PreloadCollection(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                      int64_t cache_quota = -1, bool pinned = false);
 
     Status
     ReLoadSegments(const std::shared_ptr<Context>& context, const std::string& collection_name,
@@ -157,6 +160,25 @@ class RequestHandler {
     Status
     CreateHybridIndex(const std::shared_ptr<Context>& context, const std::string& collection_name,
                       const std::vector<std::string>& field_names, const milvus::json& json_params);
+
+    // asynchronous variants, they return once the request is queued and callback gets its status when it is done,
+    // the arguments passed by reference must stay alive until then
+    void
+    InsertAsync(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                engine::VectorsData& vectors, const std::string& partition_tag,
+                const BaseRequest::DoneCallback& callback);
+
+    void
+    SearchAsync(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
+                const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
+                TopKQueryResult& result, const BaseRequest::DoneCallback& callback);
+
+    void
+    SearchByIDAsync(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                    const std::vector<int64_t>& id_array, int64_t topk, const milvus::json& extra_params,
+                    const std::vector<std::string>& partition_list, TopKQueryResult& result,
+                    const BaseRequest::DoneCallback& callback);
 };
 
 }  // namespace server
@@ -11,11 +11,13 @@
 
 #include "server/delivery/RequestQueue.h"
 #include "server/delivery/strategy/RequestStrategy.h"
+#include "server/delivery/strategy/SearchCombineWindow.h"
 #include "server/delivery/strategy/SearchReqStrategy.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
 #include <unistd.h>
+#include <chrono>
 #include <queue>
 #include <utility>
 
@@ -61,17 +63,46 @@ RequestQueue::~RequestQueue() {
 
 BaseRequestPtr
 RequestQueue::TakeRequest() {
-    return Take();
+    std::unique_lock<std::mutex> lock(mtx);
+    empty_.wait(lock, [this] { return !queue_.empty(); });
+
+    // a lone search at the head is held for a while, the searches queued meanwhile combine into it,
+    // anything queued behind it can't combine so it stops waiting
+    int64_t wait_us = SearchCombineWindow::GetInstance().WaitTime(queue_.front());
+    if (wait_us > 0 && queue_.size() == 1) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(wait_us);
+        empty_.wait_until(lock, deadline, [this] {
+            return queue_.size() > 1 || SearchCombineWindow::GetInstance().WaitTime(queue_.front()) == 0;
+        });
+    }
+
+    BaseRequestPtr front(queue_.front());
+    queue_.pop();
+    full_.notify_all();
+    return front;
 }
 
 Status
 RequestQueue::PutRequest(const BaseRequestPtr& request_ptr) {
     std::unique_lock<std::mutex> lock(mtx);
+    if (shed_depth_ > 0 && request_ptr != nullptr && queue_.size() >= shed_depth_) {
+        return Status(SERVER_REQUEST_QUEUE_FULL, "Request queue of " + request_ptr->RequestGroup() + " is full");
+    }
     full_.wait(lock, [this] { return (queue_.size() < capacity_); });
+    SearchCombineWindow::GetInstance().Arrive(request_ptr);
     auto status = ScheduleRequest(request_ptr, queue_);
     empty_.notify_all();
     return status;
 }
 
+void
+RequestQueue::SetShedDepth(size_t shed_depth) {
+    std::unique_lock<std::mutex> lock(mtx);
+    shed_depth_ = shed_depth;
+    if (shed_depth > capacity_) {
+        capacity_ = shed_depth;
+    }
+}
+
 }  // namespace server
 }  // namespace milvus
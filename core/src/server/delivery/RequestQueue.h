@@ -36,6 +36,13 @@ class RequestQueue : public BlockingRequestQueue {
 
     Status
     PutRequest(const BaseRequestPtr& request_ptr);
+
+    // a queue holding shed_depth requests rejects the next ones at once instead of blocking, 0 never rejects
+    void
+    SetShedDepth(size_t shed_depth);
+
+ private:
+    size_t shed_depth_ = 0;
 };
 
 using RequestQueuePtr = std::shared_ptr<RequestQueue>;
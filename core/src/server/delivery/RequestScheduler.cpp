@@ -10,10 +10,16 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestScheduler.h"
+#include "config/Config.h"
+#include "metrics/Metrics.h"
+#include "server/context/Context.h"
+#include "server/delivery/strategy/SearchCombineWindow.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
 #include <utility>
 
 namespace milvus {
@@ -21,6 +27,9 @@ namespace server {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 RequestScheduler::RequestScheduler() : stopped_(false) {
+    SetIdentity("RequestScheduler");
+    AddRequestWorkersListener();
+    AddRequestQueueDepthListener();
     Start();
 }
 
@@ -38,6 +47,23 @@ RequestScheduler::ExecRequest(BaseRequestPtr& request_ptr) {
     scheduler.ExecuteRequest(request_ptr);
 }
 
+void
+RequestScheduler::ExecRequestAsync(const BaseRequestPtr& request_ptr, const BaseRequest::DoneCallback& callback) {
+    if (request_ptr == nullptr) {
+        callback(Status::OK());
+        return;
+    }
+
+    // the request is alive while Done() runs the callback, the caller and the queue hold it
+    auto request = request_ptr.get();
+    request_ptr->SetDoneCallback([request, callback](const Status& status) {
+        callback(status.ok() ? request->PostExecute() : status);
+    });
+
+    RequestScheduler& scheduler = RequestScheduler::GetInstance();
+    scheduler.EnqueueRequest(request_ptr);
+}
+
 void
 RequestScheduler::Start() {
     if (!stopped_) {
@@ -56,8 +82,12 @@ RequestScheduler::Stop() {
     LOG_SERVER_INFO_ << "Scheduler gonna stop...";
     {
         std::lock_guard<std::mutex> lock(queue_mtx_);
+        // every worker of a group stops on its own null request
         for (auto& iter : request_groups_) {
-            if (iter.second != nullptr) {
+            if (iter.second == nullptr) {
+                continue;
+            }
+            for (int64_t i = 0; i < group_workers_[iter.first]; ++i) {
                 iter.second->Put(nullptr);
             }
         }
@@ -69,6 +99,7 @@ RequestScheduler::Stop() {
         iter->join();
     }
     request_groups_.clear();
+    group_workers_.clear();
     execute_threads_.clear();
     stopped_ = true;
     LOG_SERVER_INFO_ << "Scheduler stopped";
@@ -80,18 +111,8 @@ RequestScheduler::ExecuteRequest(const BaseRequestPtr& request_ptr) {
         return Status::OK();
     }
 
-    auto status = request_ptr->PreExecute();
+    auto status = EnqueueRequest(request_ptr);
     if (!status.ok()) {
-        request_ptr->Done();
-        return status;
-    }
-
-    status = PutToQueue(request_ptr);
-    fiu_do_on("RequestScheduler.ExecuteRequest.push_queue_fail", status = Status(SERVER_INVALID_ARGUMENT, ""));
-
-    if (!status.ok()) {
-        LOG_SERVER_ERROR_ << "Put request to queue failed with code: " << status.ToString();
-        request_ptr->Done();
         return status;
     }
 
@@ -117,13 +138,23 @@ RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
     while (true) {
         BaseRequestPtr request = request_queue->TakeRequest();
         if (request == nullptr) {
-            LOG_SERVER_ERROR_ << "Take null from request queue, stop thread";
+            LOG_SERVER_INFO_ << "Take null from request queue, stop thread";
             break;  // stop the thread
         }
 
+        int64_t wait_us = request->QueueWaitUs();
+        server::Metrics::GetInstance().RequestQueueWaitObserve(request->RequestGroup(), wait_us);
+        LOG_SERVER_DEBUG_ << "Request of group " << request->RequestGroup() << " waited " << wait_us << " us in queue";
+        if (request->Context() != nullptr) {
+            request->Context()->Cost()->queue_wait_us += wait_us;
+        }
+
         try {
             fiu_do_on("RequestScheduler.TakeToExecute.throw_std_exception1", throw std::exception());
+            auto start = std::chrono::steady_clock::now();
             auto status = request->Execute();
+            auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            SearchCombineWindow::GetInstance().Finish(request, cost.count());
             fiu_do_on("RequestScheduler.TakeToExecute.throw_std_exception", throw std::exception());
             fiu_do_on("RequestScheduler.TakeToExecute.execute_fail", status = Status(SERVER_INVALID_ARGUMENT, ""));
             if (!status.ok()) {
@@ -135,28 +166,127 @@ RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
     }
 }
 
+Status
+RequestScheduler::EnqueueRequest(const BaseRequestPtr& request_ptr) {
+    auto status = request_ptr->PreExecute();
+    if (!status.ok()) {
+        request_ptr->Done();
+        return status;
+    }
+
+    status = PutToQueue(request_ptr);
+    fiu_do_on("RequestScheduler.ExecuteRequest.push_queue_fail", status = Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!status.ok()) {
+        LOG_SERVER_ERROR_ << "Put request to queue failed with code: " << status.ToString();
+        request_ptr->set_status(status);
+        request_ptr->Done();
+        return status;
+    }
+
+    return Status::OK();
+}
+
 Status
 RequestScheduler::PutToQueue(const BaseRequestPtr& request_ptr) {
     std::lock_guard<std::mutex> lock(queue_mtx_);
 
     std::string group_name = request_ptr->RequestGroup();
+    request_ptr->MarkEnqueued();
+    Status status;
     if (request_groups_.count(group_name) > 0) {
-        request_groups_[group_name]->PutRequest(request_ptr);
+        status = request_groups_[group_name]->PutRequest(request_ptr);
     } else {
         RequestQueuePtr queue = std::make_shared<RequestQueue>();
-        queue->PutRequest(request_ptr);
+        queue->SetShedDepth(GroupQueueDepth());
+        queue->SetName("request_queue." + group_name);
+        status = queue->PutRequest(request_ptr);
         request_groups_.insert(std::make_pair(group_name, queue));
         fiu_do_on("RequestScheduler.PutToQueue.null_queue", queue = nullptr);
 
-        // start a thread
-        ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
-
+        // start the workers of the group, they share its queue
+        int64_t workers = GroupWorkers(group_name);
+        for (int64_t i = 0; i < workers; ++i) {
+            ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
+            execute_threads_.push_back(thread);
+        }
         fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
+        group_workers_[group_name] = workers;
+        LOG_SERVER_INFO_ << "Create " << workers << " threads for request group: " << group_name;
+    }
+
+    if (status.code() == SERVER_REQUEST_QUEUE_FULL) {
+        server::Metrics::GetInstance().RequestRejectedIncrement(group_name);
+    }
+    return status;
+}
+
+int64_t
+RequestScheduler::GroupWorkers(const std::string& group_name) {
+    Config& config = Config::GetInstance();
+    int64_t workers = 1;
+    Status status;
+    if (group_name == SEARCH_REQUEST_GROUP) {
+        status = config.GetEngineConfigSearchWorkers(workers);
+    } else if (group_name == INSERT_REQUEST_GROUP) {
+        status = config.GetEngineConfigInsertWorkers(workers);
+    } else if (group_name == DDL_REQUEST_GROUP) {
+        status = config.GetEngineConfigDdlWorkers(workers);
+    } else if (group_name == MAINTENANCE_REQUEST_GROUP) {
+        status = config.GetEngineConfigMaintenanceWorkers(workers);
+    }
+    return (status.ok() && workers > 0) ? workers : 1;
+}
+
+int64_t
+RequestScheduler::GroupQueueDepth() {
+    int64_t depth = 0;
+    auto status = Config::GetInstance().GetEngineConfigRequestQueueDepth(depth);
+    return status.ok() ? depth : 0;
+}
+
+void
+RequestScheduler::OnRequestWorkersChanged(const std::string& key, int64_t workers) {
+    std::string group_name;
+    if (key == CONFIG_ENGINE_SEARCH_WORKERS) {
+        group_name = SEARCH_REQUEST_GROUP;
+    } else if (key == CONFIG_ENGINE_INSERT_WORKERS) {
+        group_name = INSERT_REQUEST_GROUP;
+    } else if (key == CONFIG_ENGINE_DDL_WORKERS) {
+        group_name = DDL_REQUEST_GROUP;
+    } else {
+        group_name = MAINTENANCE_REQUEST_GROUP;
+    }
+    workers = std::max<int64_t>(workers, 1);
+
+    std::lock_guard<std::mutex> lock(queue_mtx_);
+    auto iter = request_groups_.find(group_name);
+    if (iter == request_groups_.end() || iter->second == nullptr) {
+        return;  // the group starts with the new number when its first request comes
+    }
+
+    auto& queue = iter->second;
+    int64_t& current = group_workers_[group_name];
+    int64_t previous = current;
+    for (; current < workers; ++current) {
+        ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
         execute_threads_.push_back(thread);
-        LOG_SERVER_INFO_ << "Create new thread for request group: " << group_name;
     }
+    // a worker stops on the null request, the stopped threads are joined by Stop
+    for (; current > workers; --current) {
+        queue->Put(nullptr);
+    }
+    LOG_SERVER_INFO_ << "Resize threads of request group " << group_name << " from " << previous << " to " << current;
+}
 
-    return Status::OK();
+void
+RequestScheduler::OnRequestQueueDepthChanged(int64_t depth) {
+    std::lock_guard<std::mutex> lock(queue_mtx_);
+    for (auto& iter : request_groups_) {
+        if (iter.second != nullptr) {
+            iter.second->SetShedDepth(depth);
+        }
+    }
 }
 
 }  // namespace server
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "config/handler/EngineConfigHandler.h"
 #include "server/delivery/RequestQueue.h"
 #include "utils/Status.h"
 
@@ -25,7 +26,7 @@ namespace server {
 
 using ThreadPtr = std::shared_ptr<std::thread>;
 
-class RequestScheduler {
+class RequestScheduler : public EngineConfigHandler {
  public:
     static RequestScheduler&
     GetInstance() {
@@ -45,6 +46,11 @@ class RequestScheduler {
     static void
     ExecRequest(BaseRequestPtr& request_ptr);
 
+    // queues the request and returns at once, callback gets the final status on the thread completing the request,
+    // the executor of its group unless it failed before being queued
+    static void
+    ExecRequestAsync(const BaseRequestPtr& request_ptr, const BaseRequest::DoneCallback& callback);
+
  protected:
     RequestScheduler();
 
@@ -53,14 +59,34 @@ class RequestScheduler {
     void
     TakeToExecute(RequestQueuePtr request_queue);
 
+    // pre-executes the request and puts it into the queue of its group, the request is done if either fails
+    Status
+    EnqueueRequest(const BaseRequestPtr& request_ptr);
+
+    // the queue of a group is created with its first request, along with the workers taking from it
     Status
     PutToQueue(const BaseRequestPtr& request_ptr);
 
+    static int64_t
+    GroupWorkers(const std::string& group_name);
+
+    static int64_t
+    GroupQueueDepth();
+
+    // a running group grows its workers at once, the surplus ones stop after the requests already queued
+    void
+    OnRequestWorkersChanged(const std::string& key, int64_t workers) override;
+
+    void
+    OnRequestQueueDepthChanged(int64_t depth) override;
+
  private:
     mutable std::mutex queue_mtx_;
 
     std::map<std::string, RequestQueuePtr> request_groups_;
 
+    std::map<std::string, int64_t> group_workers_;
+
     std::vector<ThreadPtr> execute_threads_;
 
     bool stopped_;
@@ -104,7 +104,7 @@ CreateHybridIndexRequest::OnExecute() {
                 adapter_index_type = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IDMAP);
             } else if (adapter_index_type == static_cast<int32_t>(engine::EngineType::FAISS_IVFFLAT)) {
                 adapter_index_type = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IVFFLAT);
-            } else {
+            } else if (adapter_index_type != static_cast<int32_t>(engine::EngineType::FAISS_BIN_HASH)) {
                 return Status(SERVER_INVALID_INDEX_TYPE, "Invalid index type for collection metric type");
             }
         }
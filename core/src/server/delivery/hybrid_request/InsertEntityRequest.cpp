@@ -175,5 +175,10 @@ InsertEntityRequest::OnExecute() {
     return Status::OK();
 }
 
+Status
+InsertEntityRequest::OnPostExecute() {
+    return DBWrapper::DB()->SyncWal();
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -37,6 +37,9 @@ class InsertEntityRequest : public BaseRequest {
     Status
     OnExecute() override;
 
+    Status
+    OnPostExecute() override;
+
  private:
     const std::string collection_name_;
     const std::string partition_tag_;
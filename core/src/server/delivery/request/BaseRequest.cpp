@@ -12,7 +12,10 @@
 #include "server/delivery/request/BaseRequest.h"
 
 #include <map>
+#include <random>
+#include <utility>
 
+#include "config/Config.h"
 #include "server/context/Context.h"
 #include "utils/CommonUtil.h"
 #include "utils/Exception.h"
@@ -21,9 +24,11 @@
 namespace milvus {
 namespace server {
 
-static const char* DQL_REQUEST_GROUP = "dql";
-static const char* DDL_DML_REQUEST_GROUP = "ddl_dml";
-static const char* INFO_REQUEST_GROUP = "info";
+const char* SEARCH_REQUEST_GROUP = "search";
+const char* INSERT_REQUEST_GROUP = "insert";
+const char* DDL_REQUEST_GROUP = "ddl";
+const char* MAINTENANCE_REQUEST_GROUP = "maintenance";
+const char* INFO_REQUEST_GROUP = "info";
 
 namespace {
 std::string
@@ -33,44 +38,45 @@ RequestGroup(BaseRequest::RequestType type) {
         {BaseRequest::kCmd, INFO_REQUEST_GROUP},
 
         // data operations
-        {BaseRequest::kInsert, DDL_DML_REQUEST_GROUP},
-        {BaseRequest::kCompact, DDL_DML_REQUEST_GROUP},
-        {BaseRequest::kFlush, DDL_DML_REQUEST_GROUP},
-        {BaseRequest::kDeleteByID, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kInsert, INSERT_REQUEST_GROUP},
+        {BaseRequest::kCompact, MAINTENANCE_REQUEST_GROUP},
+        {BaseRequest::kFlush, MAINTENANCE_REQUEST_GROUP},
+        {BaseRequest::kDeleteByID, INSERT_REQUEST_GROUP},
         {BaseRequest::kGetVectorByID, INFO_REQUEST_GROUP},
         {BaseRequest::kGetVectorIDs, INFO_REQUEST_GROUP},
-        {BaseRequest::kInsertEntity, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kInsertEntity, INSERT_REQUEST_GROUP},
         {BaseRequest::kGetEntityByID, INFO_REQUEST_GROUP},
 
         // collection operations
         {BaseRequest::kShowCollections, INFO_REQUEST_GROUP},
-        {BaseRequest::kCreateCollection, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kCreateCollection, DDL_REQUEST_GROUP},
         {BaseRequest::kHasCollection, INFO_REQUEST_GROUP},
         {BaseRequest::kDescribeCollection, INFO_REQUEST_GROUP},
         {BaseRequest::kCountCollection, INFO_REQUEST_GROUP},
         {BaseRequest::kShowCollectionInfo, INFO_REQUEST_GROUP},
-        {BaseRequest::kDropCollection, DDL_DML_REQUEST_GROUP},
-        {BaseRequest::kPreloadCollection, DQL_REQUEST_GROUP},
-        {BaseRequest::kCreateHybridCollection, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kDropCollection, DDL_REQUEST_GROUP},
+        {BaseRequest::kPreloadCollection, MAINTENANCE_REQUEST_GROUP},
+        {BaseRequest::kCreateHybridCollection, DDL_REQUEST_GROUP},
         {BaseRequest::kDescribeHybridCollection, INFO_REQUEST_GROUP},
-        {BaseRequest::kReloadSegments, DQL_REQUEST_GROUP},
+        {BaseRequest::kReloadSegments, MAINTENANCE_REQUEST_GROUP},
 
         // partition operations
-        {BaseRequest::kCreatePartition, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kCreatePartition, DDL_REQUEST_GROUP},
         {BaseRequest::kShowPartitions, INFO_REQUEST_GROUP},
-        {BaseRequest::kDropPartition, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kDropPartition, DDL_REQUEST_GROUP},
 
         // index operations
-        {BaseRequest::kCreateIndex, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kCreateIndex, MAINTENANCE_REQUEST_GROUP},
         {BaseRequest::kDescribeIndex, INFO_REQUEST_GROUP},
-        {BaseRequest::kDropIndex, DDL_DML_REQUEST_GROUP},
-        {BaseRequest::kCreateHybridIndex, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kDropIndex, DDL_REQUEST_GROUP},
+        {BaseRequest::kCreateHybridIndex, MAINTENANCE_REQUEST_GROUP},
+        {BaseRequest::kTuneIndex, MAINTENANCE_REQUEST_GROUP},
 
         // search operations
-        {BaseRequest::kSearchByID, DQL_REQUEST_GROUP},
-        {BaseRequest::kSearch, DQL_REQUEST_GROUP},
-        {BaseRequest::kSearchCombine, DQL_REQUEST_GROUP},
-        {BaseRequest::kHybridSearch, DQL_REQUEST_GROUP},
+        {BaseRequest::kSearchByID, SEARCH_REQUEST_GROUP},
+        {BaseRequest::kSearch, SEARCH_REQUEST_GROUP},
+        {BaseRequest::kSearchCombine, SEARCH_REQUEST_GROUP},
+        {BaseRequest::kHybridSearch, SEARCH_REQUEST_GROUP},
     };
 
     auto iter = s_map_type_group.find(type);
@@ -80,6 +86,32 @@ RequestGroup(BaseRequest::RequestType type) {
     }
     return iter->second;
 }
+
+// head based sampling, the hot path spans of a request are recorded with the sample rate of its group
+bool
+SampleHotPath(const std::string& group) {
+    auto& config = Config::GetInstance();
+    float rate = 1.0;
+    if (group == SEARCH_REQUEST_GROUP) {
+        config.GetTracingConfigSearchSampleRate(rate);
+    } else if (group == INSERT_REQUEST_GROUP) {
+        config.GetTracingConfigInsertSampleRate(rate);
+    } else if (group == DDL_REQUEST_GROUP) {
+        config.GetTracingConfigDdlSampleRate(rate);
+    } else if (group == MAINTENANCE_REQUEST_GROUP) {
+        config.GetTracingConfigMaintenanceSampleRate(rate);
+    } else {
+        config.GetTracingConfigInfoSampleRate(rate);
+    }
+
+    if (rate >= 1.0) {
+        return true;
+    } else if (rate <= 0.0) {
+        return false;
+    }
+    thread_local std::mt19937 engine(std::random_device{}());
+    return std::uniform_real_distribution<float>(0.0, 1.0)(engine) < rate;
+}
 }  // namespace
 
 BaseRequest::BaseRequest(const std::shared_ptr<milvus::server::Context>& context, BaseRequest::RequestType type,
@@ -88,6 +120,7 @@ BaseRequest::BaseRequest(const std::shared_ptr<milvus::server::Context>& context
     request_group_ = milvus::server::RequestGroup(type);
     if (nullptr != context_) {
         context_->SetRequestType(type_);
+        context_->SetSampled(SampleHotPath(request_group_));
     }
 }
 
@@ -129,9 +162,22 @@ BaseRequest::OnPostExecute() {
 
 void
 BaseRequest::Done() {
+    DoneCallback callback;
+    {
+        std::unique_lock<std::mutex> lock(finish_mtx_);
+        done_ = true;
+        finish_cond_.notify_all();
+        callback.swap(done_callback_);
+    }
+    if (callback) {
+        callback(status_);
+    }
+}
+
+void
+BaseRequest::SetDoneCallback(DoneCallback callback) {
     std::unique_lock<std::mutex> lock(finish_mtx_);
-    done_ = true;
-    finish_cond_.notify_all();
+    done_callback_ = std::move(callback);
 }
 
 void
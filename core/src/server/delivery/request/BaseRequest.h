@@ -20,7 +20,9 @@
 #include "utils/Json.h"
 #include "utils/Status.h"
 
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 //#include <gperftools/profiler.h>
 #include <memory>
 #include <string>
@@ -31,6 +33,13 @@
 namespace milvus {
 namespace server {
 
+// the request classes, each one has its own queue and workers in the RequestScheduler
+extern const char* SEARCH_REQUEST_GROUP;
+extern const char* INSERT_REQUEST_GROUP;
+extern const char* DDL_REQUEST_GROUP;
+extern const char* MAINTENANCE_REQUEST_GROUP;
+extern const char* INFO_REQUEST_GROUP;
+
 struct CollectionSchema {
     std::string collection_name_;
     int64_t dimension_;
@@ -56,6 +65,9 @@ struct TopKQueryResult {
     int64_t row_num_;
     engine::ResultIds id_list_;
     engine::ResultDistances distance_list_;
+    std::string cost_;  // json of the server::SearchCost of the search, empty unless asked for
+    // the collection of each result of a search over several collections merged, "" for -1, empty otherwise
+    std::vector<std::string> collection_list_;
 
     TopKQueryResult() {
         row_num_ = 0;
@@ -108,6 +120,8 @@ class Context;
 
 class BaseRequest {
  public:
+    using DoneCallback = std::function<void(const Status& status)>;
+
     enum RequestType {
         // general operations
         kCmd = 100,
@@ -146,6 +160,7 @@ class BaseRequest {
         kDescribeIndex,
         kDropIndex,
         kCreateHybridIndex,
+        kTuneIndex,
 
         // search operations
         kSearchByID = 600,
@@ -176,6 +191,10 @@ class BaseRequest {
     Status
     WaitToFinish();
 
+    // called once by Done() with the request status, on the thread finishing the request
+    void
+    SetDoneCallback(DoneCallback callback);
+
     RequestType
     GetRequestType() const {
         return type_;
@@ -199,6 +218,19 @@ class BaseRequest {
         return async_;
     }
 
+    // stamped when the request enters the queue of its group
+    void
+    MarkEnqueued() {
+        enqueue_time_ = std::chrono::steady_clock::now();
+    }
+
+    // microseconds since MarkEnqueued()
+    int64_t
+    QueueWaitUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - enqueue_time_)
+            .count();
+    }
+
  protected:
     virtual Status
     OnPreExecute();
@@ -209,7 +241,7 @@ class BaseRequest {
     virtual Status
     OnPostExecute();
 
-    std::string
+    static std::string
     CollectionNotExistMsg(const std::string& collection_name);
 
  protected:
@@ -224,6 +256,8 @@ class BaseRequest {
     mutable std::mutex finish_mtx_;
     std::condition_variable finish_cond_;
     bool done_;
+    DoneCallback done_callback_;
+    std::chrono::steady_clock::time_point enqueue_time_;
 
  public:
     const std::shared_ptr<milvus::server::Context>&
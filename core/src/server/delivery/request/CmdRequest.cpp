@@ -10,20 +10,39 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/CmdRequest.h"
+#include "cache/CpuCacheMgr.h"
 #include "config/Config.h"
 #include "metrics/SystemInfo.h"
 #include "scheduler/SchedInst.h"
+#include "server/DBWrapper.h"
+#include "utils/Json.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
+#include <cstring>
 #include <memory>
+#include <sstream>
 
 namespace milvus {
 namespace server {
 
+namespace {
+
+constexpr const char* TUNE_INDEX_CMD = "tune_index";
+
+bool
+IsTuneIndexCmd(const std::string& cmd) {
+    return cmd.compare(0, strlen(TUNE_INDEX_CMD), TUNE_INDEX_CMD) == 0;
+}
+
+}  // namespace
+
+// the index tuning builds indexes for minutes, it runs with the index builds rather than the info requests
 CmdRequest::CmdRequest(const std::shared_ptr<milvus::server::Context>& context, const std::string& cmd,
                        std::string& result)
-    : BaseRequest(context, BaseRequest::kCmd), cmd_(cmd), result_(result) {
+    : BaseRequest(context, IsTuneIndexCmd(cmd) ? BaseRequest::kTuneIndex : BaseRequest::kCmd),
+      cmd_(cmd),
+      result_(result) {
 }
 
 BaseRequestPtr
@@ -53,6 +72,53 @@ CmdRequest::OnExecute() {
     } else if (cmd_ == "get_system_info") {
         server::SystemInfo& sys_info_inst = server::SystemInfo::GetInstance();
         sys_info_inst.GetSysInfoJsonStr(result_);
+    } else if (cmd_ == "cache_stats") {
+        auto cpu_cache_mgr = cache::CpuCacheMgr::GetInstance();
+        milvus::json stats;
+        stats["usage"] = cpu_cache_mgr->CacheUsage();
+        stats["capacity"] = cpu_cache_mgr->CacheCapacity();
+        stats["huge_page_usage"] = cache::CpuCacheMgr::HugePageUsage();
+        stats["collections"] = milvus::json::array();
+        for (auto& stat : cpu_cache_mgr->GetCollectionStats()) {
+            milvus::json collection_stat;
+            collection_stat["collection_name"] = stat.name_;
+            collection_stat["usage"] = stat.usage_;
+            collection_stat["item_count"] = stat.item_count_;
+            collection_stat["quota"] = stat.quota_;
+            collection_stat["pinned"] = stat.pinned_;
+            collection_stat["hit_count"] = stat.hit_count_;
+            collection_stat["miss_count"] = stat.miss_count_;
+            stats["collections"].push_back(collection_stat);
+        }
+        result_ = stats.dump();
+    } else if (cmd_ == "preload_progress") {
+        engine::WarmUpProgress progress;
+        stat = DBWrapper::DB()->GetWarmUpProgress(progress);
+        milvus::json json;
+        json["hot_files"] = progress.hot_files_;
+        json["total_files"] = progress.total_files_;
+        json["loaded_files"] = progress.loaded_files_;
+        json["loaded_bytes"] = progress.loaded_bytes_;
+        json["ready"] = progress.hot_loaded_;
+        json["done"] = progress.done_;
+        result_ = json.dump();
+    } else if (IsTuneIndexCmd(cmd_)) {
+        // tune_index <collection_name> [{"target_recall": 0.95, "topk": 10, "apply": false, ...}]
+        std::istringstream iss(cmd_.substr(strlen(TUNE_INDEX_CMD)));
+        std::string collection_name, params;
+        iss >> collection_name;
+        std::getline(iss, params);
+        milvus::json tune_params = milvus::json::object();
+        if (params.find_first_not_of(' ') != std::string::npos) {
+            try {
+                tune_params = milvus::json::parse(params);
+            } catch (std::exception& ex) {
+                return Status(SERVER_INVALID_ARGUMENT, std::string("Invalid tune params: ") + ex.what());
+            }
+        }
+        milvus::json report;
+        stat = DBWrapper::DB()->TuneIndex(context_, collection_name, tune_params, report);
+        result_ = report.dump();
     } else if (cmd_ == "build_commit_id") {
         result_ = LAST_COMMIT_ID;
     } else if (cmd_.substr(0, 10) == "set_config" || cmd_.substr(0, 10) == "get_config") {
@@ -26,20 +26,21 @@ namespace server {
 
 CreateCollectionRequest::CreateCollectionRequest(const std::shared_ptr<milvus::server::Context>& context,
                                                  const std::string& collection_name, int64_t dimension,
-                                                 int64_t index_file_size, int64_t metric_type)
+                                                 int64_t index_file_size, int64_t metric_type, int64_t ttl_days)
     : BaseRequest(context, BaseRequest::kCreateCollection),
       collection_name_(collection_name),
       dimension_(dimension),
       index_file_size_(index_file_size),
-      metric_type_(metric_type) {
+      metric_type_(metric_type),
+      ttl_days_(ttl_days) {
 }
 
 BaseRequestPtr
 CreateCollectionRequest::Create(const std::shared_ptr<milvus::server::Context>& context,
                                 const std::string& collection_name, int64_t dimension, int64_t index_file_size,
-                                int64_t metric_type) {
+                                int64_t metric_type, int64_t ttl_days) {
     return std::shared_ptr<BaseRequest>(
-        new CreateCollectionRequest(context, collection_name, dimension, index_file_size, metric_type));
+        new CreateCollectionRequest(context, collection_name, dimension, index_file_size, metric_type, ttl_days));
 }
 
 Status
@@ -72,6 +73,12 @@ CreateCollectionRequest::OnExecute() {
             return status;
         }
 
+        if (ttl_days_ < 0 || ttl_days_ > engine::meta::MAX_COLLECTION_TTL_DAYS) {
+            return Status(SERVER_INVALID_ARGUMENT, "Invalid ttl days: " + std::to_string(ttl_days_) +
+                                                       ", it should be in range [0, " +
+                                                       std::to_string(engine::meta::MAX_COLLECTION_TTL_DAYS) + "]");
+        }
+
         rc.RecordSection("check validation");
 
         // step 2: construct collection schema
@@ -80,6 +87,7 @@ CreateCollectionRequest::OnExecute() {
         collection_info.dimension_ = static_cast<uint16_t>(dimension_);
         collection_info.index_file_size_ = index_file_size_;
         collection_info.metric_type_ = metric_type_;
+        collection_info.flag_ = engine::utils::SetCollectionTTL(collection_info.flag_, ttl_days_);
 
         // some metric type only support binary vector, adapt the index type
         if (engine::utils::IsBinaryMetricType(metric_type_)) {
@@ -23,11 +23,11 @@ class CreateCollectionRequest : public BaseRequest {
  public:
     static BaseRequestPtr
     Create(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name,
-           int64_t dimension, int64_t index_file_size, int64_t metric_type);
+           int64_t dimension, int64_t index_file_size, int64_t metric_type, int64_t ttl_days = 0);
 
  protected:
     CreateCollectionRequest(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name,
-                            int64_t dimension, int64_t index_file_size, int64_t metric_type);
+                            int64_t dimension, int64_t index_file_size, int64_t metric_type, int64_t ttl_days);
 
     Status
     OnExecute() override;
@@ -37,6 +37,7 @@ class CreateCollectionRequest : public BaseRequest {
     int64_t dimension_;
     int64_t index_file_size_;
     int64_t metric_type_;
+    int64_t ttl_days_;
 };
 
 }  // namespace server
@@ -91,5 +91,10 @@ DeleteByIDRequest::OnExecute() {
     return Status::OK();
 }
 
+Status
+DeleteByIDRequest::OnPostExecute() {
+    return DBWrapper::DB()->SyncWal();
+}
+
 }  // namespace server
 }  // namespace milvus
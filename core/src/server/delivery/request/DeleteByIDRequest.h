@@ -39,6 +39,9 @@ class DeleteByIDRequest : public BaseRequest {
     Status
     OnExecute() override;
 
+    Status
+    OnPostExecute() override;
+
  private:
     const std::string collection_name_;
     const std::vector<int64_t>& vector_ids_;
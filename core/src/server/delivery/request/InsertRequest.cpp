@@ -181,5 +181,11 @@ InsertRequest::OnExecute() {
     return Status::OK();
 }
 
+Status
+InsertRequest::OnPostExecute() {
+    // runs in the caller thread, the callers of concurrent requests wait for the same wal sync
+    return DBWrapper::DB()->SyncWal();
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -33,6 +33,9 @@ class InsertRequest : public BaseRequest {
     Status
     OnExecute() override;
 
+    Status
+    OnPostExecute() override;
+
  private:
     const std::string collection_name_;
     engine::VectorsData& vectors_data_;
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/PreloadCollectionRequest.h"
+#include "cache/CpuCacheMgr.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/Log.h"
@@ -17,19 +18,24 @@
 
 #include <fiu-local.h>
 #include <memory>
+#include <vector>
 
 namespace milvus {
 namespace server {
 
 PreloadCollectionRequest::PreloadCollectionRequest(const std::shared_ptr<milvus::server::Context>& context,
-                                                   const std::string& collection_name)
-    : BaseRequest(context, BaseRequest::kPreloadCollection), collection_name_(collection_name) {
+                                                   const std::string& collection_name, int64_t cache_quota,
+                                                   bool pinned)
+    : BaseRequest(context, BaseRequest::kPreloadCollection),
+      collection_name_(collection_name),
+      cache_quota_(cache_quota),
+      pinned_(pinned) {
 }
 
 BaseRequestPtr
 PreloadCollectionRequest::Create(const std::shared_ptr<milvus::server::Context>& context,
-                                 const std::string& collection_name) {
-    return std::shared_ptr<BaseRequest>(new PreloadCollectionRequest(context, collection_name));
+                                 const std::string& collection_name, int64_t cache_quota, bool pinned) {
+    return std::shared_ptr<BaseRequest>(new PreloadCollectionRequest(context, collection_name, cache_quota, pinned));
 }
 
 Status
@@ -60,7 +66,23 @@ PreloadCollectionRequest::OnExecute() {
             }
         }
 
-        // step 2: force load collection data into cache
+        // step 2: apply cache quota, partitions share the quota of their owner collection
+        if (cache_quota_ >= 0) {
+            std::vector<engine::meta::CollectionSchema> partition_array;
+            status = DBWrapper::DB()->ShowPartitions(collection_name_, partition_array);
+            if (!status.ok()) {
+                return status;
+            }
+
+            std::vector<std::string> partition_ids;
+            for (auto& schema : partition_array) {
+                partition_ids.emplace_back(schema.collection_id_);
+            }
+            cache::CpuCacheMgr::GetInstance()->SetCollectionQuota(collection_name_, cache_quota_, pinned_,
+                                                                  partition_ids);
+        }
+
+        // step 3: force load collection data into cache
         // load each segment and insert into cache even cache capacity is not enough
         status = DBWrapper::DB()->PreloadCollection(context_, collection_name_, true);
         fiu_do_on("PreloadCollectionRequest.OnExecute.preload_collection_fail",
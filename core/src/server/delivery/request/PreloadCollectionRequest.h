@@ -22,17 +22,20 @@ namespace server {
 class PreloadCollectionRequest : public BaseRequest {
  public:
     static BaseRequestPtr
-    Create(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name);
+    Create(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name,
+           int64_t cache_quota = -1, bool pinned = false);
 
  protected:
     PreloadCollectionRequest(const std::shared_ptr<milvus::server::Context>& context,
-                             const std::string& collection_name);
+                             const std::string& collection_name, int64_t cache_quota, bool pinned);
 
     Status
     OnExecute() override;
 
  private:
     const std::string collection_name_;
+    int64_t cache_quota_;
+    bool pinned_;
 };
 
 }  // namespace server
@@ -75,12 +75,19 @@ SearchByIDRequest::OnExecute() {
             return status;
         }
 
-        // step 3: check search topk
+        // step 3: check search topk and the memory of its results
         status = ValidateSearchTopk(topk_);
         if (!status.ok()) {
             return status;
         }
 
+        int64_t memory_limit = 0;
+        Config::GetInstance().GetEngineConfigSearchMemoryLimit(memory_limit);
+        status = ValidateSearchMemory(id_array_.size(), topk_, memory_limit);
+        if (!status.ok()) {
+            return status;
+        }
+
         // step 4: check collection existence
         // only process root collection, ignore partition collection
         engine::meta::CollectionSchema collection_schema;
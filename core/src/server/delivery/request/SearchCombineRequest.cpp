@@ -18,8 +18,11 @@
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace milvus {
 namespace server {
@@ -144,7 +147,7 @@ SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
         return false;
     }
 
-    if (extra_params_ != request->ExtraParams()) {
+    if (extra_params_ != request->ExtraParams() || extra_params_.contains(SEARCH_AGGREGATE)) {
         return false;
     }
 
@@ -185,7 +188,8 @@ SearchCombineRequest::CanCombine(const SearchRequestPtr& left, const SearchReque
         return false;
     }
 
-    if (left->ExtraParams() != right->ExtraParams()) {
+    // the results of a multi-vector query are aggregated over all its query vectors
+    if (left->ExtraParams() != right->ExtraParams() || left->ExtraParams().contains(SEARCH_AGGREGATE)) {
         return false;
     }
 
@@ -301,6 +305,16 @@ SearchCombineRequest::OnExecute() {
                 continue;
             }
 
+            std::vector<std::string> collection_names;
+            status = SearchRequest::ParseCollections(collection_name_, extra_params_, request->PartitionList(),
+                                                     request->FileIDList(), collection_names);
+            if (!status.ok()) {
+                // check failed, erase request and let it return error status
+                FreeRequest(request, status);
+                iter = request_list_.erase(iter);
+                continue;
+            }
+
             // reset topk
             search_topk_ = request->TopK() > search_topk_ ? request->TopK() : search_topk_;
 
@@ -357,13 +371,28 @@ SearchCombineRequest::OnExecute() {
         const std::vector<std::string>& partition_list = first_request->PartitionList();
         const std::vector<std::string>& file_id_list = first_request->FileIDList();
 
+        // the requests searching several collections share them, as they share the extra params
+        std::vector<std::string> collection_names;
+        SearchRequest::ParseCollections(collection_name_, extra_params_, partition_list, file_id_list,
+                                        collection_names);
+
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
+        std::vector<std::string> result_collections;
+        uint64_t rows_each_vector = 1;
         {
             TracingContextList context_list;
             context_list.CreateChild(request_list_, "Combine Query");
 
-            if (file_id_list_.empty()) {
+            if (!collection_names.empty()) {
+                TopKQueryResult result;
+                status = SearchRequest::QueryCollections(nullptr, collection_names, collection_schema, search_topk_,
+                                                         extra_params_, vectors_data_, result);
+                result_ids.swap(result.id_list_);
+                result_distances.swap(result.distance_list_);
+                result_collections.swap(result.collection_list_);
+                rows_each_vector = result.row_num_ / vectors_data_.vector_count_;
+            } else if (file_id_list_.empty()) {
                 status = DBWrapper::DB()->Query(nullptr, collection_name_, partition_list, (size_t)search_topk_,
                                                 extra_params_, vectors_data_, result_ids, result_distances);
             } else {
@@ -395,26 +424,33 @@ SearchCombineRequest::OnExecute() {
         }
 
         // step 5: construct result array
-        // engine ensure each target vector has same count of id/distance pairs
-        size_t pair_each_vector = result_ids.size() / vectors_data_.vector_count_;
+        // engine ensure each row has same count of id/distance pairs, a query vector has a row per collection
+        // searched unless they are merged
+        size_t pair_each_row = result_ids.size() / (vectors_data_.vector_count_ * rows_each_vector);
         offset = 0;
         for (auto& request : request_list_) {
-            uint64_t count = request->VectorsData().vector_count_;
+            uint64_t count = request->VectorsData().vector_count_ * rows_each_vector;
             int64_t topk = request->TopK();
-            uint64_t pair_cnt = (pair_each_vector > topk) ? topk : pair_each_vector;
+            uint64_t pair_cnt = (pair_each_row > topk) ? topk : pair_each_row;
             TopKQueryResult& result = request->QueryResult();
             result.row_num_ = count;
             result.id_list_.resize(count * pair_cnt);
             result.distance_list_.resize(count * pair_cnt);
+            if (!result_collections.empty()) {
+                result.collection_list_.resize(count * pair_cnt);
+            }
 
             for (uint64_t i = 0; i < count; i++) {
                 uint64_t poz = i * pair_cnt;
-                memcpy(result.id_list_.data() + poz, result_ids.data() + offset + poz, pair_cnt * sizeof(int64_t));
-                memcpy(result.distance_list_.data() + poz, result_distances.data() + offset + poz,
-                       pair_cnt * sizeof(float));
+                uint64_t src = (offset + i) * pair_each_row;
+                memcpy(result.id_list_.data() + poz, result_ids.data() + src, pair_cnt * sizeof(int64_t));
+                memcpy(result.distance_list_.data() + poz, result_distances.data() + src, pair_cnt * sizeof(float));
+                if (!result_collections.empty()) {
+                    std::copy_n(result_collections.begin() + src, pair_cnt, result.collection_list_.begin() + poz);
+                }
             }
 
-            offset += count * pair_cnt;
+            offset += count;
 
             // let request return
             FreeRequest(request, Status::OK());
@@ -37,6 +37,11 @@ class SearchCombineRequest : public BaseRequest {
     static bool
     CanCombine(const SearchRequestPtr& left, const SearchRequestPtr& right, int64_t max_nq = COMBINE_MAX_NQ);
 
+    int64_t
+    Nq() const {
+        return vectors_data_.vector_count_;
+    }
+
  protected:
     Status
     OnExecute() override;
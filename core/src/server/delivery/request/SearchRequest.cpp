@@ -11,11 +11,21 @@
 
 #include "server/delivery/request/SearchRequest.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <fiu-local.h>
 
+#include "config/Config.h"
 #include "db/Utils.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "metrics/Metrics.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/CommonUtil.h"
@@ -29,6 +39,222 @@
 namespace milvus {
 namespace server {
 
+namespace {
+
+// a range search returns fewer than topk results for most queries, the rows are cut to the longest one
+void
+TrimRangeResult(int64_t nq, engine::ResultIds& ids, engine::ResultDistances& distances) {
+    int64_t k = ids.size() / nq;
+    int64_t max_hits = 0;
+    for (int64_t q = 0; q < nq; ++q) {
+        int64_t hits = 0;
+        while (hits < k && ids[q * k + hits] != -1) {
+            ++hits;
+        }
+        max_hits = std::max(max_hits, hits);
+    }
+    if (max_hits == k) {
+        return;
+    }
+
+    for (int64_t q = 0; q < nq; ++q) {
+        std::copy_n(ids.begin() + q * k, max_hits, ids.begin() + q * max_hits);
+        std::copy_n(distances.begin() + q * k, max_hits, distances.begin() + q * max_hits);
+    }
+    ids.resize(nq * max_hits);
+    distances.resize(nq * max_hits);
+}
+
+Status
+ValidateAggregate(const milvus::json& extra_params, const engine::meta::CollectionSchema& collection_schema) {
+    if (!extra_params.contains(SEARCH_AGGREGATE)) {
+        return Status::OK();
+    }
+    auto& aggregate = extra_params[SEARCH_AGGREGATE];
+    if (!aggregate.is_string() || aggregate.get<std::string>() != AGGREGATE_MAX_SIM) {
+        return Status(SERVER_INVALID_ARGUMENT, "Invalid " + std::string(SEARCH_AGGREGATE) + ": only " +
+                                                   AGGREGATE_MAX_SIM + " is supported");
+    }
+    if (collection_schema.metric_type_ != (int32_t)engine::MetricType::IP) {
+        return Status(SERVER_INVALID_ARGUMENT, std::string(AGGREGATE_MAX_SIM) + " requires the IP metric");
+    }
+    return Status::OK();
+}
+
+// the score of an entity is the sum of its inner products with the query vectors whose results it is in, an
+// entity is in the results of a query vector at most once since they are merged by id
+void
+AggregateMaxSim(int64_t nq, int64_t topk, engine::ResultIds& ids, engine::ResultDistances& distances) {
+    int64_t k = ids.size() / nq;
+    std::unordered_map<int64_t, float> scores;
+    for (int64_t i = 0; i < nq * k; ++i) {
+        if (ids[i] != -1) {
+            scores[ids[i]] += distances[i];
+        }
+    }
+
+    std::vector<std::pair<float, int64_t>> ranked;
+    ranked.reserve(scores.size());
+    for (auto& pair : scores) {
+        ranked.emplace_back(pair.second, pair.first);
+    }
+    auto n = std::min<int64_t>(topk, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + n, ranked.end(),
+                      std::greater<std::pair<float, int64_t>>());
+
+    ids.resize(n);
+    distances.resize(n);
+    for (int64_t i = 0; i < n; ++i) {
+        distances[i] = ranked[i].first;
+        ids[i] = ranked[i].second;
+    }
+}
+
+// the results of query i in the collections, best first, the collection of each in collection_list
+void
+MergeCollectionResults(int64_t nq, int64_t topk, bool ascending, const std::vector<std::string>& collection_names,
+                       const std::vector<engine::ResultIds>& ids, const std::vector<engine::ResultDistances>& distances,
+                       TopKQueryResult& result) {
+    result.row_num_ = nq;
+    result.id_list_.assign(nq * topk, -1);
+    result.distance_list_.assign(nq * topk, 0.0);
+    result.collection_list_.assign(nq * topk, "");
+
+    // distance, collection and position in its row
+    std::vector<std::tuple<float, size_t, int64_t>> candidates;
+    for (int64_t i = 0; i < nq; ++i) {
+        candidates.clear();
+        for (size_t c = 0; c < ids.size(); ++c) {
+            for (int64_t j = 0; j < topk && ids[c][i * topk + j] != -1; ++j) {
+                candidates.emplace_back(distances[c][i * topk + j], c, j);
+            }
+        }
+        auto n = std::min<int64_t>(topk, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end(),
+                          [ascending](const std::tuple<float, size_t, int64_t>& a,
+                                      const std::tuple<float, size_t, int64_t>& b) {
+                              if (std::get<0>(a) != std::get<0>(b)) {
+                                  return ascending ? std::get<0>(a) < std::get<0>(b) : std::get<0>(a) > std::get<0>(b);
+                              }
+                              return std::make_pair(std::get<1>(a), std::get<2>(a)) <
+                                     std::make_pair(std::get<1>(b), std::get<2>(b));
+                          });
+        for (int64_t j = 0; j < n; ++j) {
+            size_t c = std::get<1>(candidates[j]);
+            result.id_list_[i * topk + j] = ids[c][i * topk + std::get<2>(candidates[j])];
+            result.distance_list_[i * topk + j] = std::get<0>(candidates[j]);
+            result.collection_list_[i * topk + j] = collection_names[c];
+        }
+    }
+}
+
+}  // namespace
+
+Status
+SearchRequest::ParseCollections(const std::string& collection_name, const milvus::json& extra_params,
+                                const std::vector<std::string>& partition_list,
+                                const std::vector<std::string>& file_id_list,
+                                std::vector<std::string>& collection_names) {
+    collection_names.clear();
+    if (!extra_params.contains(SEARCH_COLLECTIONS)) {
+        return Status::OK();
+    }
+
+    auto& collections = extra_params[SEARCH_COLLECTIONS];
+    if (!collections.is_array() || collections.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT,
+                      "Invalid " + std::string(SEARCH_COLLECTIONS) + ": a non-empty list of collection names expected");
+    }
+    if (!partition_list.empty() || !file_id_list.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT,
+                      std::string(SEARCH_COLLECTIONS) + " searches whole collections, no partition tag or file id");
+    }
+    if (extra_params.contains(SEARCH_AGGREGATE) || extra_params.contains(knowhere::meta::RADIUS)) {
+        return Status(SERVER_INVALID_ARGUMENT, std::string(SEARCH_COLLECTIONS) + " can't be combined with " +
+                                                   SEARCH_AGGREGATE + " or a range search");
+    }
+    if (extra_params.contains(SEARCH_MERGE) && !extra_params[SEARCH_MERGE].is_boolean()) {
+        return Status(SERVER_INVALID_ARGUMENT, "Invalid " + std::string(SEARCH_MERGE) + ": a boolean expected");
+    }
+
+    collection_names.push_back(collection_name);
+    for (auto& collection : collections) {
+        if (!collection.is_string()) {
+            collection_names.clear();
+            return Status(SERVER_INVALID_ARGUMENT, "Invalid " + std::string(SEARCH_COLLECTIONS) +
+                                                       ": a non-empty list of collection names expected");
+        }
+        auto name = collection.get<std::string>();
+        auto status = ValidateCollectionName(name);
+        if (!status.ok()) {
+            collection_names.clear();
+            return status;
+        }
+        if (std::find(collection_names.begin(), collection_names.end(), name) == collection_names.end()) {
+            collection_names.push_back(name);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+SearchRequest::QueryCollections(const std::shared_ptr<milvus::server::Context>& context,
+                                const std::vector<std::string>& collection_names,
+                                const engine::meta::CollectionSchema& collection_schema, int64_t topk,
+                                const milvus::json& extra_params, engine::VectorsData& vectors,
+                                TopKQueryResult& result) {
+    // the first collection is checked by the caller
+    for (size_t c = 1; c < collection_names.size(); ++c) {
+        engine::meta::CollectionSchema schema;
+        schema.collection_id_ = collection_names[c];
+        auto status = DBWrapper::DB()->DescribeCollection(schema);
+        if (status.code() == DB_NOT_FOUND || (status.ok() && !schema.owner_collection_.empty())) {
+            return Status(SERVER_COLLECTION_NOT_EXIST, CollectionNotExistMsg(collection_names[c]));
+        } else if (!status.ok()) {
+            return status;
+        }
+        if (schema.metric_type_ != collection_schema.metric_type_ ||
+            schema.dimension_ != collection_schema.dimension_) {
+            return Status(SERVER_INVALID_ARGUMENT, "Collection " + collection_names[c] +
+                                                       " doesn't match the metric type and dimension of collection " +
+                                                       collection_schema.collection_id_);
+        }
+        status = ValidateSearchParams(extra_params, schema, topk);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    std::vector<engine::ResultIds> result_ids;
+    std::vector<engine::ResultDistances> result_distances;
+    auto status = DBWrapper::DB()->QueryCollections(context, collection_names, (size_t)topk, extra_params, vectors,
+                                                    result_ids, result_distances);
+    if (!status.ok()) {
+        return status;
+    }
+
+    int64_t nq = vectors.vector_count_;
+    if (extra_params.contains(SEARCH_MERGE) && extra_params[SEARCH_MERGE].get<bool>()) {
+        bool ascending = collection_schema.metric_type_ != (int32_t)engine::MetricType::IP;
+        MergeCollectionResults(nq, topk, ascending, collection_names, result_ids, result_distances, result);
+        return Status::OK();
+    }
+
+    // query major, row i * n + c is the top k of query i in collection c
+    int64_t n = collection_names.size();
+    result.row_num_ = nq * n;
+    result.id_list_.resize(nq * n * topk);
+    result.distance_list_.resize(nq * n * topk);
+    for (int64_t i = 0; i < nq; ++i) {
+        for (int64_t c = 0; c < n; ++c) {
+            std::copy_n(result_ids[c].begin() + i * topk, topk, result.id_list_.begin() + (i * n + c) * topk);
+            std::copy_n(result_distances[c].begin() + i * topk, topk,
+                        result.distance_list_.begin() + (i * n + c) * topk);
+        }
+    }
+    return Status::OK();
+}
+
 SearchRequest::SearchRequest(const std::shared_ptr<milvus::server::Context>& context,
                              const std::string& collection_name, engine::VectorsData& vectors, int64_t topk,
                              const milvus::json& extra_params, const std::vector<std::string>& partition_list,
@@ -66,13 +292,20 @@ SearchRequest::OnPreExecute() {
         return status;
     }
 
-    // step 2: check search topk
+    // step 2: check search topk and the memory of its results
     status = ValidateSearchTopk(topk_);
     if (!status.ok()) {
         LOG_SERVER_ERROR_ << LogOut("[%s][%ld] %s", "search", 0, status.message().c_str());
         return status;
     }
 
+    int64_t memory_limit = 0;
+    Config::GetInstance().GetEngineConfigSearchMemoryLimit(memory_limit);
+    status = ValidateSearchMemory(vectors_data_.vector_count_, topk_, memory_limit);
+    if (!status.ok()) {
+        return status;
+    }
+
     // step 3: check partition tags
     status = ValidatePartitionTags(partition_list_);
     fiu_do_on("SearchRequest.OnExecute.invalid_partition_tags", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
@@ -93,6 +326,10 @@ SearchRequest::OnExecute() {
         std::string hdr = "SearchRequest execute(collection=" + collection_name_ +
                           ", nq=" + std::to_string(vector_count) + ", k=" + std::to_string(topk_) + ")";
         TimeRecorderAuto rc(LogOut("[%s][%ld] %s", "search", 0, hdr.c_str()));
+        if (context_ != nullptr) {
+            server::Metrics::GetInstance().SearchStageObserve(SEARCH_STAGE_REQUEST_QUEUE, collection_name_, "",
+                                                              context_->Cost()->queue_wait_us.load());
+        }
 
         // step 4: check collection existence
         // only process root collection, ignore partition collection
@@ -126,6 +363,19 @@ SearchRequest::OnExecute() {
             return status;
         }
 
+        status = ValidateAggregate(extra_params_, collection_schema_);
+        if (!status.ok()) {
+            LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Invalid search params: %s", "search", 0, status.message().c_str());
+            return status;
+        }
+
+        std::vector<std::string> collection_names;
+        status = ParseCollections(collection_name_, extra_params_, partition_list_, file_id_list_, collection_names);
+        if (!status.ok()) {
+            LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Invalid search params: %s", "search", 0, status.message().c_str());
+            return status;
+        }
+
         // step 6: check vector data according to metric type
         status = ValidateVectorData(vectors_data_, collection_schema_);
         if (!status.ok()) {
@@ -133,6 +383,15 @@ SearchRequest::OnExecute() {
             return status;
         }
 
+        if (!collection_names.empty()) {
+            status = QueryCollections(context_, collection_names, collection_schema_, topk_, extra_params_,
+                                      vectors_data_, result_);
+            if (!status.ok()) {
+                LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Query fail: %s", "search", 0, status.message().c_str());
+            }
+            return status;
+        }
+
         rc.RecordSection("check validation");
 
         // step 7: search vectors
@@ -154,6 +413,20 @@ SearchRequest::OnExecute() {
 
         rc.RecordSection("query vectors from engine");
 
+        if (context_ != nullptr) {
+            auto cost = context_->Cost()->ToJson();
+            if (context_->GetTraceContext() != nullptr) {
+                auto& span = context_->GetTraceContext()->GetSpan();
+                for (auto& item : cost.items()) {
+                    span->SetTag(item.key(), item.value().get<int64_t>());
+                }
+            }
+            if (extra_params_.contains(SEARCH_WITH_COST) && extra_params_[SEARCH_WITH_COST].is_boolean() &&
+                extra_params_[SEARCH_WITH_COST].get<bool>()) {
+                result_.cost_ = cost.dump();
+            }
+        }
+
 #ifdef ENABLE_CPU_PROFILING
         ProfilerStop();
 #endif
@@ -169,7 +442,14 @@ SearchRequest::OnExecute() {
 
         // step 8: construct result array
         milvus::server::ContextChild tracer(context_, "Constructing result");
+        if (extra_params_.contains(knowhere::meta::RADIUS)) {
+            TrimRangeResult(vector_count, result_ids, result_distances);
+        }
         result_.row_num_ = vectors_data_.vector_count_;
+        if (extra_params_.contains(SEARCH_AGGREGATE)) {
+            AggregateMaxSim(vector_count, topk_, result_ids, result_distances);
+            result_.row_num_ = 1;
+        }
         result_.id_list_.swap(result_ids);
         result_.distance_list_.swap(result_distances);
         rc.RecordSection("construct result");
@@ -20,6 +20,23 @@
 namespace milvus {
 namespace server {
 
+// optional search param, "max_sim" searches the query vectors as one multi-vector query: an entity scores the sum
+// over the query vectors of its inner product, the top k entities are returned as a single row
+constexpr const char* SEARCH_AGGREGATE = "aggregate";
+constexpr const char* AGGREGATE_MAX_SIM = "max_sim";
+
+// optional search param, true returns what the search cost along with its result
+constexpr const char* SEARCH_WITH_COST = "with_cost";
+
+// optional search param, the names of more collections searched in one job along with the collection of the request,
+// their metric and dimension must match. The rows of the result are the top k of each query in each collection,
+// query major, the collection of the request first
+constexpr const char* SEARCH_COLLECTIONS = "collections";
+
+// optional search param along with "collections", true merges the collections into one top k per query, the
+// collection of each result is then in TopKQueryResult::collection_list_
+constexpr const char* SEARCH_MERGE = "merge";
+
 class SearchRequest : public BaseRequest {
  public:
     static BaseRequestPtr
@@ -68,6 +85,20 @@ class SearchRequest : public BaseRequest {
         return collection_schema_;
     }
 
+    // the collections a search with the param "collections" runs on, the collection of the request first, empty
+    // for the search of one collection
+    static Status
+    ParseCollections(const std::string& collection_name, const milvus::json& extra_params,
+                     const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
+                     std::vector<std::string>& collection_names);
+
+    // search the collections parsed by ParseCollections(), collection_schema is the one of the first
+    static Status
+    QueryCollections(const std::shared_ptr<milvus::server::Context>& context,
+                     const std::vector<std::string>& collection_names,
+                     const engine::meta::CollectionSchema& collection_schema, int64_t topk,
+                     const milvus::json& extra_params, engine::VectorsData& vectors, TopKQueryResult& result);
+
  protected:
     SearchRequest(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name,
                   engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
@@ -0,0 +1,132 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "server/delivery/strategy/SearchCombineWindow.h"
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/delivery/request/SearchRequest.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace server {
+
+namespace {
+constexpr double ARRIVE_DECAY = 0.8;
+constexpr int64_t MIN_ARRIVE_COUNT = 8;
+
+constexpr size_t COST_SAMPLES = 256;
+constexpr size_t P99_REFRESH = 32;
+
+// the requests held together pay at most this share of the p99 execution time as extra latency
+constexpr int64_t P99_SHARE = 10;
+}  // namespace
+
+SearchCombineWindow::SearchCombineWindow() {
+    SetIdentity("SearchCombineWindow");
+    AddSearchCombineMaxNqListener();
+    AddSearchCombineWaitUsListener();
+    costs_.reserve(COST_SAMPLES);
+}
+
+int64_t
+SearchCombineWindow::RequestNq(const BaseRequestPtr& request) {
+    if (request == nullptr) {
+        return -1;
+    }
+
+    if (request->GetRequestType() == BaseRequest::kSearch) {
+        return std::static_pointer_cast<SearchRequest>(request)->VectorsData().vector_count_;
+    } else if (request->GetRequestType() == BaseRequest::kSearchCombine) {
+        return std::static_pointer_cast<SearchCombineRequest>(request)->Nq();
+    }
+    return -1;
+}
+
+void
+SearchCombineWindow::Arrive(const BaseRequestPtr& request) {
+    int64_t nq = RequestNq(request);
+    if (nq < 0) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arrive_count_ == 0) {
+        nq_ = nq;
+    } else {
+        double interval = std::chrono::duration<double, std::micro>(now - last_arrive_).count();
+        interval_us_ = (arrive_count_ == 1) ? interval : ARRIVE_DECAY * interval_us_ + (1 - ARRIVE_DECAY) * interval;
+        nq_ = ARRIVE_DECAY * nq_ + (1 - ARRIVE_DECAY) * nq;
+    }
+    last_arrive_ = now;
+    ++arrive_count_;
+}
+
+void
+SearchCombineWindow::Finish(const BaseRequestPtr& request, int64_t cost_us) {
+    if (RequestNq(request) < 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (costs_.size() < COST_SAMPLES) {
+        costs_.push_back(cost_us);
+    } else {
+        costs_[cost_index_] = cost_us;
+    }
+    cost_index_ = (cost_index_ + 1) % COST_SAMPLES;
+
+    if (cost_index_ % P99_REFRESH == 0 || p99_us_ == 0) {
+        std::vector<int64_t> costs = costs_;
+        auto p99 = costs.begin() + (costs.size() * 99) / 100;
+        std::nth_element(costs.begin(), p99, costs.end());
+        p99_us_ = *p99;
+    }
+}
+
+int64_t
+SearchCombineWindow::WaitTime(const BaseRequestPtr& request) {
+    int64_t budget = search_combine_wait_us_;
+    int64_t max_nq = search_combine_nq_;
+    if (budget <= 0 || max_nq <= 0) {
+        return 0;
+    }
+
+    int64_t nq = RequestNq(request);
+    if (nq < 0 || nq >= max_nq) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // searches arriving sparser than the budget rarely show up in time
+    if (arrive_count_ < MIN_ARRIVE_COUNT || p99_us_ <= 0 || interval_us_ >= budget) {
+        return 0;
+    }
+
+    // time for the arrivals to fill the batch up
+    double fill_us = (max_nq - nq) / std::max(nq_, 1.0) * interval_us_;
+    return std::min({budget, static_cast<int64_t>(fill_us), p99_us_ / P99_SHARE});
+}
+
+void
+SearchCombineWindow::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    arrive_count_ = 0;
+    interval_us_ = 0.0;
+    nq_ = 0.0;
+    costs_.clear();
+    cost_index_ = 0;
+    p99_us_ = 0;
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "config/handler/EngineConfigHandler.h"
+#include "server/delivery/request/BaseRequest.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// Holds a search at the head of its queue for a while so that the searches arriving behind combine into it.
+// The wait is sized from the arrival rate of the searches and the p99 of their execution, bounded by
+// engine_config.search_combine_wait_us, 0 never holds.
+class SearchCombineWindow : public EngineConfigHandler {
+ public:
+    static SearchCombineWindow&
+    GetInstance() {
+        static SearchCombineWindow window;
+        return window;
+    }
+
+    void
+    Arrive(const BaseRequestPtr& request);
+
+    void
+    Finish(const BaseRequestPtr& request, int64_t cost_us);
+
+    // microseconds to hold the request before executing it
+    int64_t
+    WaitTime(const BaseRequestPtr& request);
+
+    void
+    Clear();
+
+ private:
+    SearchCombineWindow();
+
+    static int64_t
+    RequestNq(const BaseRequestPtr& request);
+
+ private:
+    std::mutex mutex_;
+
+    std::chrono::steady_clock::time_point last_arrive_;
+    int64_t arrive_count_ = 0;
+    double interval_us_ = 0.0;
+    double nq_ = 0.0;
+
+    std::vector<int64_t> costs_;
+    size_t cost_index_ = 0;
+    int64_t p99_us_ = 0;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,247 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/grpc_impl/GrpcCoordinator.h"
+
+#include <fiu-local.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#include "db/meta/MetaTypes.h"
+#include "scheduler/task/SearchTask.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+namespace {
+
+// one call of a shard search to a replica
+struct ReplicaCall {
+    std::unique_ptr<::grpc::ClientContext> context_;
+    ::milvus::grpc::TopKQueryResult response_;
+    ::grpc::Status status_;
+};
+
+// the calls of a shard search, the first one to answer wins
+struct ShardCalls {
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::shared_ptr<ReplicaCall>> calls_;
+    std::vector<std::thread> threads_;
+    int64_t finished_ = 0;
+    int64_t winner_ = -1;
+};
+
+Status
+ToStatus(const ::grpc::Status& status, const std::string& address) {
+    std::string msg = "Search of shard replica " + address + " failed: " + status.error_message();
+    switch (status.error_code()) {
+        case ::grpc::StatusCode::DEADLINE_EXCEEDED:
+            return Status(SERVER_DEADLINE_EXCEEDED, msg);
+        case ::grpc::StatusCode::CANCELLED:
+            return Status(SERVER_REQUEST_CANCELLED, msg);
+        default:
+            return Status(SERVER_UNEXPECTED_ERROR, msg);
+    }
+}
+
+}  // namespace
+
+GrpcCoordinator::GrpcCoordinator(const std::vector<std::vector<std::string>>& shards, int64_t hedge_delay_ms)
+    : shards_(shards), hedge_delay_ms_(hedge_delay_ms) {
+}
+
+Status
+GrpcCoordinator::Search(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam& request,
+                        ::milvus::grpc::TopKQueryResult& response) {
+    TimeRecorderAuto rc("GrpcCoordinator::Search");
+    bool ascending = true;
+    STATUS_CHECK(IsAscending(request.collection_name(), ascending));
+
+    std::vector<::milvus::grpc::TopKQueryResult> shard_results(shards_.size());
+    std::vector<Status> shard_statuses(shards_.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        threads.emplace_back([&, i] { shard_statuses[i] = SearchShard(context, i, request, shard_results[i]); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& status : shard_statuses) {
+        STATUS_CHECK(status);
+    }
+
+    size_t nq = request.query_record_array_size();
+    size_t topk = request.topk();
+    engine::ResultIds result_ids;
+    engine::ResultDistances result_distances;
+    for (auto& shard_result : shard_results) {
+        STATUS_CHECK(MergeShardResult(shard_result, nq, topk, ascending, result_ids, result_distances));
+    }
+
+    response.set_row_num(nq);
+    response.mutable_ids()->Resize(static_cast<int>(result_ids.size()), 0);
+    memcpy(response.mutable_ids()->mutable_data(), result_ids.data(), result_ids.size() * sizeof(int64_t));
+    response.mutable_distances()->Resize(static_cast<int>(result_distances.size()), 0.0);
+    memcpy(response.mutable_distances()->mutable_data(), result_distances.data(),
+           result_distances.size() * sizeof(float));
+    return Status::OK();
+}
+
+Status
+GrpcCoordinator::MergeShardResult(const ::milvus::grpc::TopKQueryResult& shard_result, size_t nq, size_t topk,
+                                  bool ascending, engine::ResultIds& result_ids,
+                                  engine::ResultDistances& result_distances) {
+    size_t count = shard_result.ids_size();
+    if (count == 0 || nq == 0) {
+        return Status::OK();
+    }
+    if (count % nq != 0 || count / nq > topk || shard_result.distances_size() != static_cast<int>(count)) {
+        return Status(SERVER_ILLEGAL_SEARCH_RESULT, "The result of a shard doesn't match the query");
+    }
+
+    // the reduce reads its source with a stride of topk, a shard returns less when its collection is small
+    size_t shard_k = count / nq;
+    engine::ResultIds ids(nq * topk, -1);
+    engine::ResultDistances distances(nq * topk, 0.0);
+    for (size_t i = 0; i < nq; ++i) {
+        std::copy_n(shard_result.ids().data() + i * shard_k, shard_k, ids.data() + i * topk);
+        std::copy_n(shard_result.distances().data() + i * shard_k, shard_k, distances.data() + i * topk);
+    }
+    scheduler::XSearchTask::MergeTopkToResultSet(ids, distances, shard_k, nq, topk, ascending, result_ids,
+                                                 result_distances);
+    return Status::OK();
+}
+
+Status
+GrpcCoordinator::SearchShard(::grpc::ServerContext* context, size_t shard, const ::milvus::grpc::SearchParam& request,
+                             ::milvus::grpc::TopKQueryResult& response) {
+    auto& replicas = shards_[shard];
+    auto calls = std::make_shared<ShardCalls>();
+
+    auto launch = [&](size_t index) {
+        auto call = std::make_shared<ReplicaCall>();
+        call->context_ = (context != nullptr) ? ::grpc::ClientContext::FromServerContext(*context)
+                                              : std::make_unique<::grpc::ClientContext>();
+        calls->calls_.push_back(call);
+
+        auto stub = GetStub(replicas[index]);
+        calls->threads_.emplace_back([calls, call, stub, &request, index] {
+            call->status_ = stub->Search(call->context_.get(), request, &call->response_);
+            fiu_do_on("GrpcCoordinator.SearchShard.replica_fail",
+                      call->status_ = ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, ""));
+            std::lock_guard<std::mutex> lock(calls->mutex_);
+            ++calls->finished_;
+            if (call->status_.ok() && calls->winner_ < 0) {
+                calls->winner_ = index;
+            }
+            calls->cv_.notify_one();
+        });
+    };
+
+    {
+        std::unique_lock<std::mutex> lock(calls->mutex_);
+        launch(0);
+        auto answered = [&] {
+            return calls->winner_ >= 0 || calls->finished_ == static_cast<int64_t>(calls->calls_.size());
+        };
+        for (;;) {
+            if (hedge_delay_ms_ > 0 && calls->calls_.size() < replicas.size()) {
+                calls->cv_.wait_for(lock, std::chrono::milliseconds(hedge_delay_ms_), answered);
+            } else {
+                calls->cv_.wait(lock, answered);
+            }
+            if (calls->winner_ >= 0) {
+                break;
+            }
+            if (calls->calls_.size() == replicas.size()) {
+                if (answered()) {
+                    break;  // all replicas failed
+                }
+                continue;
+            }
+
+            // a replica failed or is late, the next one is asked as well
+            LOG_SERVER_DEBUG_ << "Shard " << shard << " asks replica " << replicas[calls->calls_.size()]
+                              << (answered() ? " after a failure" : " after the hedge delay");
+            launch(calls->calls_.size());
+        }
+
+        // the slower calls are no longer needed
+        for (size_t i = 0; i < calls->calls_.size(); ++i) {
+            if (static_cast<int64_t>(i) != calls->winner_) {
+                calls->calls_[i]->context_->TryCancel();
+            }
+        }
+    }
+    for (auto& thread : calls->threads_) {
+        thread.join();
+    }
+
+    if (calls->winner_ < 0) {
+        auto& last = calls->calls_.back();
+        return ToStatus(last->status_, replicas[calls->calls_.size() - 1]);
+    }
+
+    auto& winner = calls->calls_[calls->winner_];
+    if (winner->response_.status().error_code() != ::milvus::grpc::SUCCESS) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Search of shard replica " + replicas[calls->winner_] +
+                                                   " failed: " + winner->response_.status().reason());
+    }
+    response.Swap(&winner->response_);
+    return Status::OK();
+}
+
+GrpcCoordinator::StubPtr
+GrpcCoordinator::GetStub(const std::string& address) {
+    std::lock_guard<std::mutex> lock(stubs_mutex_);
+    auto iter = stubs_.find(address);
+    if (iter != stubs_.end()) {
+        return iter->second;
+    }
+
+    ::grpc::ChannelArguments args;
+    args.SetMaxReceiveMessageSize(-1);
+    args.SetMaxSendMessageSize(-1);
+    auto channel = ::grpc::CreateCustomChannel(address, ::grpc::InsecureChannelCredentials(), args);
+    StubPtr stub = ::milvus::grpc::MilvusService::NewStub(channel);
+    stubs_.insert(std::make_pair(address, stub));
+    return stub;
+}
+
+Status
+GrpcCoordinator::IsAscending(const std::string& collection_name, bool& ascending) {
+    engine::meta::CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_name;
+    auto status = DBWrapper::DB()->DescribeCollection(collection_schema);
+    if (!status.ok()) {
+        return Status(SERVER_COLLECTION_NOT_EXIST, "Collection " + collection_name + " not found");
+    }
+
+    // the same order as the reduce of the search tasks
+    ascending = !(collection_schema.metric_type_ == static_cast<int32_t>(engine::MetricType::IP) &&
+                  collection_schema.engine_type_ != static_cast<int32_t>(engine::EngineType::FAISS_PQ) &&
+                  collection_schema.engine_type_ != static_cast<int32_t>(engine::EngineType::FAISS_PQ_FASTSCAN));
+    return Status::OK();
+}
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
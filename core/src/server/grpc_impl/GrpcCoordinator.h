@@ -0,0 +1,78 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "db/Types.h"
+#include "grpc/gen-milvus/milvus.grpc.pb.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+/*
+ * Scatters the searches of a coordinator node to the shards of a collection and merges their top-k results.
+ * Each shard is one or more replicas serving the same data: a shard search asks the first replica, then the next one
+ * when a replica fails, or when the hedge delay passes without an answer. The first answer of a shard is taken and
+ * the calls still running are cancelled.
+ */
+class GrpcCoordinator {
+ public:
+    // hedge_delay_ms of 0 asks another replica only when one fails
+    GrpcCoordinator(const std::vector<std::vector<std::string>>& shards, int64_t hedge_delay_ms);
+
+    // the deadline and cancellation of the server call are passed on to the shard calls, context may be null
+    Status
+    Search(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam& request,
+           ::milvus::grpc::TopKQueryResult& response);
+
+    // folds the result of one shard into the merged result, the reduce of the search tasks is reused
+    static Status
+    MergeShardResult(const ::milvus::grpc::TopKQueryResult& shard_result, size_t nq, size_t topk, bool ascending,
+                     engine::ResultIds& result_ids, engine::ResultDistances& result_distances);
+
+ private:
+    using StubPtr = std::shared_ptr<::milvus::grpc::MilvusService::Stub>;
+
+    Status
+    SearchShard(::grpc::ServerContext* context, size_t shard, const ::milvus::grpc::SearchParam& request,
+                ::milvus::grpc::TopKQueryResult& response);
+
+    StubPtr
+    GetStub(const std::string& address);
+
+    // the order of the distances of the collection, known from the meta shared with the shards
+    Status
+    IsAscending(const std::string& collection_name, bool& ascending);
+
+ private:
+    std::vector<std::vector<std::string>> shards_;
+    int64_t hedge_delay_ms_ = 0;
+
+    std::mutex stubs_mutex_;
+    std::unordered_map<std::string, StubPtr> stubs_;
+};
+
+using GrpcCoordinatorPtr = std::shared_ptr<GrpcCoordinator>;
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
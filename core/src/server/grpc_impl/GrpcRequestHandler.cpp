@@ -11,21 +11,28 @@
 
 #include "server/grpc_impl/GrpcRequestHandler.h"
 
+#include <faiss/impl/ScalarQuantizerOp.h>
 #include <fiu-local.h>
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "config/Utils.h"
 #include "context/HybridSearchContext.h"
+#include "metrics/Metrics.h"
 #include "query/BinaryQuery.h"
 #include "server/context/ConnectionContext.h"
+#include "server/grpc_impl/TrafficCapture.h"
 #include "tracing/TextMapCarrier.h"
 #include "tracing/TracerUtil.h"
 #include "utils/Log.h"
 #include "utils/LogUtil.h"
+#include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
 
 namespace milvus {
@@ -34,6 +41,31 @@ namespace grpc {
 
 const char* EXTRA_PARAM_KEY = "params";
 
+// optional client metadata of PreloadCollection
+const char* CACHE_QUOTA_KEY = "cache_quota";
+const char* CACHE_PIN_KEY = "cache_pin";
+
+// optional extra param of Insert and Search: the float vectors come back to back in the binary data of a single
+// record and the value is their count, a single bytes field to parse instead of a message per vector
+const char* PACKED_FLOAT_ROWS_KEY = "packed_float_rows";
+
+// optional extra param of Search, SearchByID and SearchInFiles: a comma separated list of the encodings of the
+// reply, see EncodeResults()
+const char* RESULT_ENCODING_KEY = "result_encoding";
+
+// optional extra param of CreateCollection: the days the inserted entities are kept, 0 means forever
+const char* TTL_DAYS_KEY = "ttl_days";
+
+// trailing metadata of Search when the "with_cost" search param is true, the cost of the search as json
+const char* SEARCH_COST_KEY = "search-cost";
+
+// trailing metadata of Search when the "merge" search param merges several collections, the json list of the
+// collection of each result
+const char* SEARCH_COLLECTIONS_KEY = "search-collections";
+
+// trailing metadata of an insert failed for a full insert buffer, the milliseconds to wait before retrying
+const char* RETRY_AFTER_KEY = "retry-after-ms";
+
 ::milvus::grpc::ErrorCode
 ErrorMap(ErrorCode code) {
     static const std::map<ErrorCode, ::milvus::grpc::ErrorCode> code_map = {
@@ -66,6 +98,7 @@ ErrorMap(ErrorCode code) {
         {DB_META_TRANSACTION_FAILED, ::milvus::grpc::ErrorCode::META_FAILED},
         {SERVER_BUILD_INDEX_ERROR, ::milvus::grpc::ErrorCode::BUILD_INDEX_ERROR},
         {SERVER_OUT_OF_MEMORY, ::milvus::grpc::ErrorCode::OUT_OF_MEMORY},
+        {DB_INSERT_BUFFER_FULL, ::milvus::grpc::ErrorCode::OUT_OF_MEMORY},
     };
 
     if (code_map.find(code) != code_map.end()) {
@@ -95,6 +128,21 @@ RequestMap(BaseRequest::RequestType request_type) {
 }
 
 namespace {
+// the db ends the message of a full insert buffer with "retry after <ms> ms"
+void
+SetRetryAfter(::grpc::ServerContext* context, const Status& status) {
+    if (context == nullptr || status.code() != DB_INSERT_BUFFER_FULL) {
+        return;
+    }
+    const std::string prefix = "retry after ";
+    std::string msg = status.message();
+    auto pos = msg.rfind(prefix);
+    if (pos != std::string::npos) {
+        std::string ms = msg.substr(pos + prefix.size());
+        context->AddTrailingMetadata(RETRY_AFTER_KEY, ms.substr(0, ms.find(' ')));
+    }
+}
+
 void
 CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecord>& grpc_records,
                const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array,
@@ -106,27 +154,24 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
         binary_data_size += record.binary_data().size();
     }
 
-    std::vector<float> float_array(float_data_size, 0.0f);
-    std::vector<uint8_t> binary_array(binary_data_size, 0);
-    int64_t float_offset = 0, binary_offset = 0;
+    // the rows are gathered into one array without zero filling it first, this is the only copy before the wal
+    std::vector<float> float_array;
+    std::vector<uint8_t> binary_array;
     if (float_data_size > 0) {
+        float_array.reserve(float_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&float_array[float_offset], record.float_data().data(), record.float_data_size() * sizeof(float));
-            float_offset += record.float_data_size();
+            float_array.insert(float_array.end(), record.float_data().begin(), record.float_data().end());
         }
     } else if (binary_data_size > 0) {
+        binary_array.reserve(binary_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&binary_array[binary_offset], record.binary_data().data(), record.binary_data().size());
-            binary_offset += record.binary_data().size();
+            auto& binary_data = record.binary_data();
+            binary_array.insert(binary_array.end(), binary_data.begin(), binary_data.end());
         }
     }
 
     // step 2: copy id array
-    std::vector<int64_t> id_array;
-    if (grpc_id_array.size() > 0) {
-        id_array.resize(grpc_id_array.size());
-        memcpy(id_array.data(), grpc_id_array.data(), grpc_id_array.size() * sizeof(int64_t));
-    }
+    std::vector<int64_t> id_array(grpc_id_array.begin(), grpc_id_array.end());
 
     // step 3: contruct vectors
     vectors.vector_count_ = grpc_records.size();
@@ -135,6 +180,44 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
     vectors.id_array_.swap(id_array);
 }
 
+Status
+CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::KeyValuePair>& extra_params,
+               const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecord>& grpc_records,
+               const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array,
+               engine::VectorsData& vectors) {
+    auto iter = std::find_if(extra_params.begin(), extra_params.end(), [](const ::milvus::grpc::KeyValuePair& extra) {
+        return extra.key() == PACKED_FLOAT_ROWS_KEY;
+    });
+    if (iter == extra_params.end()) {
+        CopyRowRecords(grpc_records, grpc_id_array, vectors);
+        return Status::OK();
+    }
+
+    int64_t rows = 0;
+    try {
+        rows = std::stoll(iter->value());
+    } catch (std::exception& e) {
+        return Status(SERVER_INVALID_ARGUMENT, "Invalid packed float rows: " + iter->value());
+    }
+    if (rows <= 0 || grpc_records.size() != 1 || grpc_records[0].float_data_size() != 0) {
+        return Status(SERVER_INVALID_ROWRECORD_ARRAY, "Packed float vectors need a single record of binary data");
+    }
+    auto& packed = grpc_records[0].binary_data();
+    if (packed.empty() || packed.size() % (rows * sizeof(float)) != 0) {
+        return Status(SERVER_INVALID_ROWRECORD_ARRAY, "Packed float vectors size doesn't match the rows");
+    }
+
+    std::vector<float> float_array(packed.size() / sizeof(float));
+    memcpy(float_array.data(), packed.data(), packed.size());
+    std::vector<int64_t> id_array(grpc_id_array.begin(), grpc_id_array.end());
+
+    vectors.vector_count_ = rows;
+    vectors.float_data_.swap(float_array);
+    vectors.binary_data_.clear();
+    vectors.id_array_.swap(id_array);
+    return Status::OK();
+}
+
 void
 DeSerialization(const ::milvus::grpc::GeneralQuery& general_query, query::BooleanQueryPtr& boolean_clause,
                 query::QueryPtr& query_ptr) {
@@ -230,6 +313,127 @@ ConstructResults(const TopKQueryResult& result, ::milvus::grpc::TopKQueryResult*
            result.distance_list_.size() * sizeof(float));
 }
 
+struct ResultEncoding {
+    bool no_distances_ = false;
+    bool fp16_distances_ = false;
+    bool delta_ids_ = false;
+    bool gzip_ = false;
+};
+
+Status
+ParseResultEncoding(const google::protobuf::RepeatedPtrField<::milvus::grpc::KeyValuePair>& extra_params,
+                    ResultEncoding& encoding) {
+    auto iter = std::find_if(extra_params.begin(), extra_params.end(), [](const ::milvus::grpc::KeyValuePair& extra) {
+        return extra.key() == RESULT_ENCODING_KEY;
+    });
+    if (iter == extra_params.end()) {
+        return Status::OK();
+    }
+
+    std::vector<std::string> names;
+    StringHelpFunctions::SplitStringByDelimeter(iter->value(), ",", names);
+    for (auto& name : names) {
+        if (name == "no_distances") {
+            encoding.no_distances_ = true;
+        } else if (name == "fp16_distances") {
+            encoding.fp16_distances_ = true;
+        } else if (name == "delta_ids") {
+            encoding.delta_ids_ = true;
+        } else if (name == "gzip") {
+            encoding.gzip_ = true;
+        } else if (!name.empty()) {
+            std::string msg = "Invalid result encoding: " + name +
+                              ". Possible reason: not one of no_distances, fp16_distances, delta_ids and gzip.";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+// Shrinks the reply of a large search in place, the rows keep their topk stride, twice topk for the ids with delta_ids:
+// no_distances   the distances are left out
+// fp16_distances two distances rounded to IEEE half floats go in the bits of one float, the first one in the low half
+// delta_ids      a row of ids holds the ids of the query sorted by id, then their positions. The first sorted id is
+//                kept and each next one is replaced by its distance to the previous one plus one, the -1 padding by 0.
+//                Position r is the index in the sorted ids of the hit ranked r, the distances stay in rank order.
+//                The sorted ids and the positions become small varints on the wire
+// gzip           the reply is compressed by grpc
+void
+EncodeResults(const ResultEncoding& encoding, ::grpc::ServerContext* context,
+              ::milvus::grpc::TopKQueryResult* response) {
+    if (encoding.gzip_ && context != nullptr) {
+        context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    }
+
+    auto ids = response->mutable_ids();
+    auto distances = response->mutable_distances();
+    if (encoding.no_distances_) {
+        distances->Clear();
+    }
+
+    int64_t nq = response->row_num();
+    if (encoding.delta_ids_ && nq > 0 && ids->size() % nq == 0) {
+        int64_t k = ids->size() / nq;
+        google::protobuf::RepeatedField<google::protobuf::int64> encoded;
+        encoded.Resize(2 * nq * k, 0);
+        std::vector<int64_t> order(k);
+        for (int64_t i = 0; i < nq; ++i) {
+            const int64_t* row = ids->data() + i * k;
+            int64_t* sorted = encoded.mutable_data() + 2 * i * k;
+            int64_t* positions = sorted + k;
+
+            // the padding goes last, hits of the same id keep their rank order
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [row](int64_t a, int64_t b) {
+                return (row[a] == -1) != (row[b] == -1) ? row[b] == -1 : row[a] < row[b];
+            });
+            for (int64_t j = 0; j < k; ++j) {
+                int64_t id = row[order[j]];
+                if (j == 0 || id == -1) {
+                    sorted[j] = j == 0 ? id : 0;
+                } else {
+                    sorted[j] = id - row[order[j - 1]] + 1;
+                }
+                positions[order[j]] = j;
+            }
+        }
+        ids->Swap(&encoded);
+    }
+
+    if (encoding.fp16_distances_ && !distances->empty()) {
+        int size = distances->size();
+        for (int j = 0; j < size; j += 2) {
+            uint32_t bits = faiss::encode_fp16(distances->Get(j));
+            if (j + 1 < size) {
+                bits |= static_cast<uint32_t>(faiss::encode_fp16(distances->Get(j + 1))) << 16;
+            }
+            float packed;
+            memcpy(&packed, &bits, sizeof(packed));
+            distances->Set(j / 2, packed);
+        }
+        distances->Truncate((size + 1) / 2);
+    }
+}
+
+// the search replies of the sync and the async methods go through here, with the cost and the searched
+// collections in the trailing metadata
+void
+ReplySearchResults(const TopKQueryResult& result, const ResultEncoding& encoding, const std::string& collection_name,
+                   ::grpc::ServerContext* context, ::milvus::grpc::TopKQueryResult* response) {
+    auto serialize_start = std::chrono::steady_clock::now();
+    ConstructResults(result, response);
+    EncodeResults(encoding, context, response);
+    auto serialize_span = std::chrono::steady_clock::now() - serialize_start;
+    auto serialize_us = std::chrono::duration_cast<std::chrono::microseconds>(serialize_span).count();
+    Metrics::GetInstance().SearchStageObserve(SEARCH_STAGE_SERIALIZE, collection_name, "", serialize_us);
+    if (context != nullptr && !result.cost_.empty()) {
+        context->AddTrailingMetadata(SEARCH_COST_KEY, result.cost_);
+    }
+    if (context != nullptr && !result.collection_list_.empty()) {
+        context->AddTrailingMetadata(SEARCH_COLLECTIONS_KEY, milvus::json(result.collection_list_).dump());
+    }
+}
+
 void
 ConstructHEntityResults(const std::vector<engine::AttrsData>& attrs, const std::vector<engine::VectorsData>& vectors,
                         std::vector<std::string>& field_names, ::milvus::grpc::HEntity* response) {
@@ -490,12 +694,32 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
     auto trace_context = std::make_shared<tracing::TraceContext>(span);
     auto context = std::make_shared<Context>(request_id);
     context->SetTraceContext(trace_context);
+
+    // grpc gives time_point::max() if the client sets no deadline
+    auto deadline = server_rpc_info->server_context()->deadline();
+    if (deadline != std::chrono::system_clock::time_point::max()) {
+        auto remaining = deadline - std::chrono::system_clock::now();
+        context->SetDeadline(std::chrono::steady_clock::now() +
+                             std::chrono::duration_cast<std::chrono::steady_clock::duration>(remaining));
+    }
     SetContext(server_rpc_info->server_context(), context);
 }
 
+void
+GrpcRequestHandler::OnPostRecvMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
+                                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) {
+    auto& capture = TrafficCapture::GetInstance();
+    auto message = static_cast<const google::protobuf::Message*>(interceptor_batch_methods->GetRecvMessage());
+    if (capture.Enabled() && message != nullptr) {
+        capture.Begin(server_rpc_info->server_context(), server_rpc_info->method(), *message);
+    }
+}
+
 void
 GrpcRequestHandler::OnPreSendMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) {
+    TrafficCapture::GetInstance().End(server_rpc_info->server_context());
+
     std::lock_guard<std::mutex> lock(context_map_mutex_);
     auto request_id = get_request_id(server_rpc_info->server_context());
 
@@ -551,9 +775,24 @@ GrpcRequestHandler::CreateCollection(::grpc::ServerContext* context, const ::mil
     CHECK_NULLPTR_RETURN(request);
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
 
-    Status status =
-        request_handler_.CreateCollection(GetContext(context), request->collection_name(), request->dimension(),
-                                          request->index_file_size(), request->metric_type());
+    Status status;
+    int64_t ttl_days = 0;
+    for (int i = 0; i < request->extra_params_size(); i++) {
+        const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
+        if (extra.key() == TTL_DAYS_KEY) {
+            try {
+                ttl_days = std::stoll(extra.value());
+            } catch (std::exception& e) {
+                status = Status(SERVER_INVALID_ARGUMENT, "Invalid ttl days: " + extra.value());
+            }
+        }
+    }
+
+    if (status.ok()) {
+        status = request_handler_.CreateCollection(GetContext(context), request->collection_name(),
+                                                   request->dimension(), request->index_file_size(),
+                                                   request->metric_type(), ttl_days);
+    }
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
     SET_RESPONSE(response, status, context);
@@ -621,11 +860,14 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
 
     // step 1: copy vector data
     engine::VectorsData vectors;
-    CopyRowRecords(request->row_record_array(), request->row_id_array(), vectors);
+    Status status =
+        CopyRowRecords(request->extra_params(), request->row_record_array(), request->row_id_array(), vectors);
 
     // step 2: insert vectors
-    Status status =
-        request_handler_.Insert(GetContext(context), request->collection_name(), vectors, request->partition_tag());
+    if (status.ok()) {
+        status =
+            request_handler_.Insert(GetContext(context), request->collection_name(), vectors, request->partition_tag());
+    }
 
     // step 3: return id array
     response->mutable_vector_id_array()->Resize(static_cast<int>(vectors.id_array_.size()), 0);
@@ -633,6 +875,7 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
            vectors.id_array_.size() * sizeof(int64_t));
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
+    SetRetryAfter(context, status);
     SET_RESPONSE(response->mutable_status(), status, context);
     return ::grpc::Status::OK;
 }
@@ -700,9 +943,33 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
     CHECK_NULLPTR_RETURN(request);
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
 
+    ResultEncoding encoding;
+    Status status = ParseResultEncoding(request->extra_params(), encoding);
+    if (!status.ok()) {
+        SET_RESPONSE(response->mutable_status(), status, context);
+        return ::grpc::Status::OK;
+    }
+
+    if (coordinator_ != nullptr) {
+        // the shards reply plain results for the coordinator to merge
+        ::milvus::grpc::SearchParam shard_request = *request;
+        auto shard_params = shard_request.mutable_extra_params();
+        shard_params->erase(std::remove_if(shard_params->begin(), shard_params->end(),
+                                           [](const ::milvus::grpc::KeyValuePair& extra) {
+                                               return extra.key() == RESULT_ENCODING_KEY;
+                                           }),
+                            shard_params->end());
+        status = coordinator_->Search(context, shard_request, *response);
+        EncodeResults(encoding, context, response);
+        LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
+        SET_RESPONSE(response->mutable_status(), status, context);
+        return ::grpc::Status::OK;
+    }
+
     // step 1: copy vector data
     engine::VectorsData vectors;
-    CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(), vectors);
+    status = CopyRowRecords(request->extra_params(), request->query_record_array(),
+                            google::protobuf::RepeatedField<google::protobuf::int64>(), vectors);
 
     // step 2: partition tags
     std::vector<std::string> partitions;
@@ -723,11 +990,13 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
     TopKQueryResult result;
     fiu_do_on("GrpcRequestHandler.Search.not_empty_file_ids", file_ids.emplace_back("test_file_id"));
 
-    Status status = request_handler_.Search(GetContext(context), request->collection_name(), vectors, request->topk(),
-                                            json_params, partitions, file_ids, result);
+    if (status.ok()) {
+        status = request_handler_.Search(GetContext(context), request->collection_name(), vectors, request->topk(),
+                                         json_params, partitions, file_ids, result);
+    }
 
     // step 5: construct and return result
-    ConstructResults(result, response);
+    ReplySearchResults(result, encoding, request->collection_name(), context, response);
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
     SET_RESPONSE(response->mutable_status(), status, context);
@@ -762,12 +1031,16 @@ GrpcRequestHandler::SearchByID(::grpc::ServerContext* context, const ::milvus::g
     }
 
     // step 4: search vectors
+    ResultEncoding encoding;
     TopKQueryResult result;
-    Status status = request_handler_.SearchByID(GetContext(context), request->collection_name(), id_array,
-                                                request->topk(), json_params, partitions, result);
+    Status status = ParseResultEncoding(request->extra_params(), encoding);
+    if (status.ok()) {
+        status = request_handler_.SearchByID(GetContext(context), request->collection_name(), id_array,
+                                             request->topk(), json_params, partitions, result);
+    }
 
     // step 5: construct and return result
-    ConstructResults(result, response);
+    ReplySearchResults(result, encoding, request->collection_name(), context, response);
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
     SET_RESPONSE(response->mutable_status(), status, context);
@@ -807,12 +1080,16 @@ GrpcRequestHandler::SearchInFiles(::grpc::ServerContext* context, const ::milvus
     }
 
     // step 5: search vectors
+    ResultEncoding encoding;
     TopKQueryResult result;
-    Status status = request_handler_.Search(GetContext(context), search_request->collection_name(), vectors,
-                                            search_request->topk(), json_params, partitions, file_ids, result);
+    Status status = ParseResultEncoding(search_request->extra_params(), encoding);
+    if (status.ok()) {
+        status = request_handler_.Search(GetContext(context), search_request->collection_name(), vectors,
+                                         search_request->topk(), json_params, partitions, file_ids, result);
+    }
 
     // step 6: construct and return result
-    ConstructResults(result, response);
+    ReplySearchResults(result, encoding, search_request->collection_name(), context, response);
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
     SET_RESPONSE(response->mutable_status(), status, context);
@@ -956,7 +1233,31 @@ GrpcRequestHandler::PreloadCollection(::grpc::ServerContext* context, const ::mi
     CHECK_NULLPTR_RETURN(request);
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
 
-    Status status = request_handler_.PreloadCollection(GetContext(context), request->collection_name());
+    // cache quota and pin flag are passed in client metadata since CollectionName carries the name only
+    Status status;
+    int64_t cache_quota = -1;
+    bool pinned = false;
+    auto& client_metadata = context->client_metadata();
+    auto quota_kv = client_metadata.find(CACHE_QUOTA_KEY);
+    auto pin_kv = client_metadata.find(CACHE_PIN_KEY);
+    if (quota_kv != client_metadata.end() || pin_kv != client_metadata.end()) {
+        cache_quota = 0;
+        if (quota_kv != client_metadata.end()) {
+            std::string err;
+            cache_quota = parse_bytes(std::string(quota_kv->second.data(), quota_kv->second.length()), err);
+            if (!err.empty()) {
+                status = Status(SERVER_INVALID_ARGUMENT, err);
+            }
+        }
+        if (pin_kv != client_metadata.end()) {
+            StringHelpFunctions::ConvertToBoolean(std::string(pin_kv->second.data(), pin_kv->second.length()), pinned);
+        }
+    }
+
+    if (status.ok()) {
+        status = request_handler_.PreloadCollection(GetContext(context), request->collection_name(), cache_quota,
+                                                    pinned);
+    }
 
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), __func__);
     SET_RESPONSE(response, status, context);
@@ -1686,6 +1987,183 @@ GrpcRequestHandler::CreateHybridIndex(::grpc::ServerContext* context, const ::mi
     return ::grpc::Status::OK;
 }
 
+void
+GrpcRequestHandler::EnableAsyncMode() {
+    using InsertHandler = ::grpc_impl::internal::CallbackUnaryHandler<::milvus::grpc::InsertParam,
+                                                                      ::milvus::grpc::VectorIds>;
+    using SearchHandler = ::grpc_impl::internal::CallbackUnaryHandler<::milvus::grpc::SearchParam,
+                                                                      ::milvus::grpc::TopKQueryResult>;
+    using SearchByIDHandler = ::grpc_impl::internal::CallbackUnaryHandler<::milvus::grpc::SearchByIDParam,
+                                                                          ::milvus::grpc::TopKQueryResult>;
+
+    // the indexes of the methods in the MilvusService of milvus.proto
+    ::grpc::Service::experimental().MarkMethodCallback(
+        14, new InsertHandler([this](::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                                     ::milvus::grpc::VectorIds* response,
+                                     ::grpc::experimental::ServerCallbackRpcController* controller) {
+            InsertAsync(context, request, response, controller);
+        }));
+    if (coordinator_ == nullptr) {
+        ::grpc::Service::experimental().MarkMethodCallback(
+            17,
+            new SearchHandler([this](::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                     ::milvus::grpc::TopKQueryResult* response,
+                                     ::grpc::experimental::ServerCallbackRpcController* controller) {
+                SearchAsync(context, request, response, controller);
+            }));
+    }
+    ::grpc::Service::experimental().MarkMethodCallback(
+        18, new SearchByIDHandler([this](::grpc::ServerContext* context, const ::milvus::grpc::SearchByIDParam* request,
+                                         ::milvus::grpc::TopKQueryResult* response,
+                                         ::grpc::experimental::ServerCallbackRpcController* controller) {
+            SearchByIDAsync(context, request, response, controller);
+        }));
+}
+
+void
+GrpcRequestHandler::InsertAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                                ::milvus::grpc::VectorIds* response,
+                                ::grpc::experimental::ServerCallbackRpcController* controller) {
+    if (nullptr == request) {
+        controller->Finish(::grpc::Status::OK);
+        return;
+    }
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
+
+    // step 1: copy vector data, it lives until the call is finished
+    auto vectors = std::make_shared<engine::VectorsData>();
+    Status status =
+        CopyRowRecords(request->extra_params(), request->row_record_array(), request->row_id_array(), *vectors);
+    if (!status.ok()) {
+        LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), "Insert");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        controller->Finish(::grpc::Status::OK);
+        return;
+    }
+
+    // step 2: insert vectors, the executor returns the id array
+    request_handler_.InsertAsync(
+        GetContext(context), request->collection_name(), *vectors, request->partition_tag(),
+        [this, context, response, controller, vectors](const Status& status) {
+            response->mutable_vector_id_array()->Resize(static_cast<int>(vectors->id_array_.size()), 0);
+            memcpy(response->mutable_vector_id_array()->mutable_data(), vectors->id_array_.data(),
+                   vectors->id_array_.size() * sizeof(int64_t));
+
+            LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), "Insert");
+            SetRetryAfter(context, status);
+            SET_RESPONSE(response->mutable_status(), status, context);
+            controller->Finish(::grpc::Status::OK);
+        });
+}
+
+void
+GrpcRequestHandler::SearchAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                ::milvus::grpc::TopKQueryResult* response,
+                                ::grpc::experimental::ServerCallbackRpcController* controller) {
+    if (nullptr == request) {
+        controller->Finish(::grpc::Status::OK);
+        return;
+    }
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
+
+    // step 1: copy vector data
+    ResultEncoding encoding;
+    engine::VectorsData vectors;
+    Status status = ParseResultEncoding(request->extra_params(), encoding);
+    if (status.ok()) {
+        status = CopyRowRecords(request->extra_params(), request->query_record_array(),
+                                google::protobuf::RepeatedField<google::protobuf::int64>(), vectors);
+    }
+    if (!status.ok()) {
+        LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), "Search");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        controller->Finish(::grpc::Status::OK);
+        return;
+    }
+
+    // step 2: partition tags
+    std::vector<std::string> partitions;
+    std::copy(request->partition_tag_array().begin(), request->partition_tag_array().end(),
+              std::back_inserter(partitions));
+
+    // step 3: parse extra parameters
+    milvus::json json_params;
+    for (int i = 0; i < request->extra_params_size(); i++) {
+        const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
+        if (extra.key() == EXTRA_PARAM_KEY) {
+            json_params = json::parse(extra.value());
+        }
+    }
+
+    // step 4: search vectors, the result lives until the call is finished
+    auto result = std::make_shared<TopKQueryResult>();
+    request_handler_.SearchAsync(GetContext(context), request->collection_name(), vectors, request->topk(),
+                                 json_params, partitions, std::vector<std::string>(), *result,
+                                 [this, context, response, controller, result, encoding,
+                                  collection_name = request->collection_name()](const Status& status) {
+                                     // step 5: construct and return result
+                                     ReplySearchResults(*result, encoding, collection_name, context, response);
+
+                                     LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.",
+                                                                GetContext(context)->RequestID().c_str(), "Search");
+                                     SET_RESPONSE(response->mutable_status(), status, context);
+                                     controller->Finish(::grpc::Status::OK);
+                                 });
+}
+
+void
+GrpcRequestHandler::SearchByIDAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchByIDParam* request,
+                                    ::milvus::grpc::TopKQueryResult* response,
+                                    ::grpc::experimental::ServerCallbackRpcController* controller) {
+    if (nullptr == request) {
+        controller->Finish(::grpc::Status::OK);
+        return;
+    }
+    LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
+
+    // step 1: partition tags
+    std::vector<std::string> partitions;
+    std::copy(request->partition_tag_array().begin(), request->partition_tag_array().end(),
+              std::back_inserter(partitions));
+
+    // step 2: id array
+    std::vector<int64_t> id_array(request->id_array().begin(), request->id_array().end());
+
+    // step 3: parse extra parameters
+    ResultEncoding encoding;
+    Status status = ParseResultEncoding(request->extra_params(), encoding);
+    if (!status.ok()) {
+        LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.", GetContext(context)->RequestID().c_str(), "SearchByID");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        controller->Finish(::grpc::Status::OK);
+        return;
+    }
+
+    milvus::json json_params;
+    for (int i = 0; i < request->extra_params_size(); i++) {
+        const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
+        if (extra.key() == EXTRA_PARAM_KEY) {
+            json_params = json::parse(extra.value());
+        }
+    }
+
+    // step 4: search vectors, the result lives until the call is finished
+    auto result = std::make_shared<TopKQueryResult>();
+    request_handler_.SearchByIDAsync(GetContext(context), request->collection_name(), id_array, request->topk(),
+                                     json_params, partitions, *result,
+                                     [this, context, response, controller, result, encoding,
+                                      collection_name = request->collection_name()](const Status& status) {
+                                         // step 5: construct and return result
+                                         ReplySearchResults(*result, encoding, collection_name, context, response);
+
+                                         LOG_SERVER_INFO_ << LogOut("Request [%s] %s end.",
+                                                                    GetContext(context)->RequestID().c_str(),
+                                                                    "SearchByID");
+                                         SET_RESPONSE(response->mutable_status(), status, context);
+                                         controller->Finish(::grpc::Status::OK);
+                                     });
+}
+
 }  // namespace grpc
 }  // namespace server
 }  // namespace milvus
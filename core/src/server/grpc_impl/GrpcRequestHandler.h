@@ -25,6 +25,7 @@
 #include "opentracing/tracer.h"
 #include "server/context/Context.h"
 #include "server/delivery/RequestHandler.h"
+#include "server/grpc_impl/GrpcCoordinator.h"
 #include "server/grpc_impl/interceptor/GrpcInterceptorHookHandler.h"
 #include "src/utils/Status.h"
 
@@ -67,6 +68,11 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     OnPostRecvInitialMetaData(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                               ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) override;
 
+    // records the request when the traffic capture is on
+    void
+    OnPostRecvMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
+                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) override;
+
     void
     OnPreSendMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) override;
@@ -405,6 +411,18 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
         request_handler_ = handler;
     }
 
+    // serves Insert, Search and SearchByID with the callback API: the gRPC thread returns once the request is
+    // queued and the request scheduler executor finishes the call. Must be called before the service is registered
+    void
+    EnableAsyncMode();
+
+    // scatters Search to the shards instead of searching the local data, Search stays synchronous then.
+    // Must be called before EnableAsyncMode
+    void
+    EnableCoordinator(const GrpcCoordinatorPtr& coordinator) {
+        coordinator_ = coordinator;
+    }
+
     Status
     DeserializeJsonToBoolQuery(const google::protobuf::RepeatedPtrField<::milvus::grpc::VectorParam>& vector_params,
                                const std::string& dsl_string, query::BooleanQueryPtr& boolean_query,
@@ -416,8 +434,24 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     Status
     ProcessLeafQueryJson(const nlohmann::json& json, query::BooleanQueryPtr& query);
 
+ private:
+    void
+    InsertAsync(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                ::milvus::grpc::VectorIds* response, ::grpc::experimental::ServerCallbackRpcController* controller);
+
+    void
+    SearchAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                ::milvus::grpc::TopKQueryResult* response,
+                ::grpc::experimental::ServerCallbackRpcController* controller);
+
+    void
+    SearchByIDAsync(::grpc::ServerContext* context, const ::milvus::grpc::SearchByIDParam* request,
+                    ::milvus::grpc::TopKQueryResult* response,
+                    ::grpc::experimental::ServerCallbackRpcController* controller);
+
  private:
     RequestHandler request_handler_;
+    GrpcCoordinatorPtr coordinator_;  // null unless the node coordinates the shards
 
     // std::unordered_map<::grpc::ServerContext*, std::shared_ptr<Context>> context_map_;
     std::unordered_map<std::string, std::shared_ptr<Context>> context_map_;
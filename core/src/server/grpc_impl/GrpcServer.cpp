@@ -35,6 +35,7 @@
 #include "config/Config.h"
 #include "grpc/gen-milvus/milvus.grpc.pb.h"
 #include "server/DBWrapper.h"
+#include "server/grpc_impl/TrafficCapture.h"
 #include "server/grpc_impl/interceptor/SpanInterceptor.h"
 #include "utils/Log.h"
 
@@ -98,6 +99,34 @@ GrpcServer::StartService() {
     GrpcRequestHandler service(opentracing::Tracer::Global());
     service.RegisterRequestHandler(RequestHandler());
 
+    std::vector<std::vector<std::string>> shards;
+    STATUS_CHECK(config.GetClusterConfigShards(shards));
+    if (!shards.empty()) {
+        int64_t hedge_delay = 0;
+        STATUS_CHECK(config.GetClusterConfigHedgeDelay(hedge_delay));
+        service.EnableCoordinator(std::make_shared<GrpcCoordinator>(shards, hedge_delay));
+        LOG_SERVER_INFO_ << "gRPC server scatters Search to " << shards.size() << " shards";
+    }
+
+    bool async_mode = false;
+    STATUS_CHECK(config.GetNetworkConfigGrpcAsync(async_mode));
+    if (async_mode) {
+        service.EnableAsyncMode();
+        LOG_SERVER_INFO_ << "gRPC server serves Insert, Search and SearchByID asynchronously";
+    }
+
+    // a server that can't capture still serves
+    std::string capture_path;
+    STATUS_CHECK(config.GetNetworkConfigGrpcCapturePath(capture_path));
+    if (!capture_path.empty()) {
+        int64_t capture_size = 0;
+        STATUS_CHECK(config.GetNetworkConfigGrpcCaptureSize(capture_size));
+        auto status = TrafficCapture::GetInstance().Start(capture_path, capture_size);
+        if (!status.ok()) {
+            LOG_SERVER_ERROR_ << "Traffic capture not started: " << status.message();
+        }
+    }
+
     builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
     builder.RegisterService(&service);
 
@@ -122,6 +151,7 @@ GrpcServer::StopService() {
     if (server_ptr_ != nullptr) {
         server_ptr_->Shutdown();
     }
+    TrafficCapture::GetInstance().Stop();
 
     return Status::OK();
 }
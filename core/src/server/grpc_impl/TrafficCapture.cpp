@@ -0,0 +1,116 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/grpc_impl/TrafficCapture.h"
+
+#include <cstring>
+#include <utility>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+Status
+TrafficCapture::Start(const std::string& path, int64_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_.is_open()) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Traffic capture already started");
+    }
+
+    file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return Status(SERVER_CANNOT_CREATE_FILE, "Cannot create capture file " + path);
+    }
+    file_.write(CAPTURE_MAGIC, strlen(CAPTURE_MAGIC));
+    start_ = std::chrono::steady_clock::now();
+    max_bytes_ = max_bytes;
+    written_bytes_ = strlen(CAPTURE_MAGIC);
+    pending_.clear();
+    enabled_.store(true);
+    LOG_SERVER_INFO_ << "Capture gRPC requests to " << path << ", up to " << max_bytes << " bytes";
+    return Status::OK();
+}
+
+void
+TrafficCapture::Stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_.store(false);
+    pending_.clear();
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+void
+TrafficCapture::Begin(const void* call, const std::string& method, const google::protobuf::Message& request) {
+    if (!Enabled()) {
+        return;
+    }
+
+    // serialized outside the lock
+    PendingRequest pending;
+    pending.arrival_ = std::chrono::steady_clock::now();
+    pending.method_ = method;
+    if (!request.SerializeToString(&pending.payload_)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.size() >= MAX_PENDING) {
+        LOG_SERVER_WARNING_ << "Drop " << pending_.size() << " captured requests without a response";
+        pending_.clear();
+    }
+    pending_[call] = std::move(pending);
+}
+
+void
+TrafficCapture::End(const void* call) {
+    if (!Enabled()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = pending_.find(call);
+    if (iter == pending_.end() || !file_.is_open()) {
+        return;
+    }
+    auto& pending = iter->second;
+    uint64_t arrival = std::chrono::duration_cast<std::chrono::microseconds>(pending.arrival_ - start_).count();
+    uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(now - pending.arrival_).count();
+    uint16_t method_length = static_cast<uint16_t>(pending.method_.size());
+    uint32_t payload_length = static_cast<uint32_t>(pending.payload_.size());
+
+    int64_t record_bytes = sizeof(arrival) + sizeof(latency) + sizeof(method_length) + method_length +
+                           sizeof(payload_length) + payload_length;
+    if (written_bytes_ + record_bytes > max_bytes_) {
+        LOG_SERVER_INFO_ << "Traffic capture stopped at " << written_bytes_ << " bytes";
+        enabled_.store(false);
+        pending_.clear();
+        file_.close();
+        return;
+    }
+
+    file_.write(reinterpret_cast<const char*>(&arrival), sizeof(arrival));
+    file_.write(reinterpret_cast<const char*>(&latency), sizeof(latency));
+    file_.write(reinterpret_cast<const char*>(&method_length), sizeof(method_length));
+    file_.write(pending.method_.data(), method_length);
+    file_.write(reinterpret_cast<const char*>(&payload_length), sizeof(payload_length));
+    file_.write(pending.payload_.data(), payload_length);
+    written_bytes_ += record_bytes;
+    pending_.erase(iter);
+}
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <google/protobuf/message.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+/*
+ * Records the gRPC requests served to a binary log, to be replayed against another server by the replay tool of the
+ * sdk examples. The log begins with the 8 bytes of CAPTURE_MAGIC, then a record per request in the byte order of
+ * the host:
+ *   uint64 arrival, microseconds since the capture started
+ *   uint64 latency, microseconds from the request received to the response sent
+ *   uint16 length of the method name, then the full method name, as "/milvus.grpc.MilvusService/Search"
+ *   uint32 length of the request, then the serialized request message
+ * A request is recorded once its response is sent, the records are in the order of the responses. The capture
+ * stops when the log reaches its size limit.
+ */
+class TrafficCapture {
+ public:
+    static constexpr const char* CAPTURE_MAGIC = "MVSCAP01";
+
+    static TrafficCapture&
+    GetInstance() {
+        static TrafficCapture instance;
+        return instance;
+    }
+
+    Status
+    Start(const std::string& path, int64_t max_bytes);
+
+    void
+    Stop();
+
+    bool
+    Enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // call identifies the request until End(), its server context
+    void
+    Begin(const void* call, const std::string& method, const google::protobuf::Message& request);
+
+    void
+    End(const void* call);
+
+ private:
+    struct PendingRequest {
+        std::chrono::steady_clock::time_point arrival_;
+        std::string method_;
+        std::string payload_;
+    };
+
+    // the calls cancelled before their response are never ended, the pending requests are dropped beyond this
+    static constexpr size_t MAX_PENDING = 65536;
+
+    std::atomic<bool> enabled_{false};
+
+    std::mutex mutex_;
+    std::ofstream file_;
+    std::chrono::steady_clock::time_point start_;
+    int64_t max_bytes_ = 0;
+    int64_t written_bytes_ = 0;
+    std::unordered_map<const void*, PendingRequest> pending_;
+};
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
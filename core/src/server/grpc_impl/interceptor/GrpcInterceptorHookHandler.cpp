@@ -21,6 +21,11 @@ GrpcInterceptorHookHandler::OnPostRecvInitialMetaData(
     ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) {
 }
 
+void
+GrpcInterceptorHookHandler::OnPostRecvMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
+                                              ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) {
+}
+
 void
 GrpcInterceptorHookHandler::OnPreSendMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                                              ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) {
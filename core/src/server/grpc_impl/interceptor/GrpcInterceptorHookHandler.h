@@ -24,6 +24,11 @@ class GrpcInterceptorHookHandler {
     OnPostRecvInitialMetaData(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                               ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods);
 
+    // the request message is deserialized, GetRecvMessage() of the batch methods is the message of the method
+    virtual void
+    OnPostRecvMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
+                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods);
+
     virtual void
     OnPreSendMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods);
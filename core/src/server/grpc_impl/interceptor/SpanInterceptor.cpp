@@ -25,6 +25,9 @@ SpanInterceptor::Intercept(::grpc::experimental::InterceptorBatchMethods* method
     if (methods->QueryInterceptionHookPoint(::grpc::experimental::InterceptionHookPoints::POST_RECV_INITIAL_METADATA)) {
         hook_handler_->OnPostRecvInitialMetaData(info_, methods);
 
+    } else if (methods->QueryInterceptionHookPoint(::grpc::experimental::InterceptionHookPoints::POST_RECV_MESSAGE)) {
+        hook_handler_->OnPostRecvMessage(info_, methods);
+
     } else if (methods->QueryInterceptionHookPoint(::grpc::experimental::InterceptionHookPoints::PRE_SEND_MESSAGE)) {
         hook_handler_->OnPreSendMessage(info_, methods);
     }
@@ -29,6 +29,13 @@ Status
 CpuChecker::CheckCpuInstructionSet() {
     std::vector<std::string> instruction_sets;
 
+#if defined(__aarch64__)
+    bool support_neon = faiss::support_neon();
+    fiu_do_on("CpuChecker.CheckCpuInstructionSet.not_support_neon", support_neon = false);
+    if (support_neon) {
+        instruction_sets.emplace_back("neon");
+    }
+#else
     bool support_avx512 = faiss::support_avx512();
     fiu_do_on("CpuChecker.CheckCpuInstructionSet.not_support_avx512", support_avx512 = false);
     if (support_avx512) {
@@ -46,12 +53,13 @@ CpuChecker::CheckCpuInstructionSet() {
     if (support_sse4_2) {
         instruction_sets.emplace_back("sse4_2");
     }
+#endif
 
     fiu_do_on("CpuChecker.CheckCpuInstructionSet.instruction_sets_empty", instruction_sets.clear());
     if (instruction_sets.empty()) {
         std::string msg =
             "CPU instruction sets are not supported. Ensure the CPU supports at least one of the following instruction "
-            "sets: sse4_2, avx2, avx512";
+            "sets: sse4_2, avx2, avx512, neon";
         LOG_SERVER_FATAL_ << msg;
         std::cerr << msg << std::endl;
         return Status(SERVER_UNEXPECTED_ERROR, msg);
@@ -25,6 +25,9 @@ const char* NAME_ENGINE_TYPE_HNSW = "HNSW";
 const char* NAME_ENGINE_TYPE_ANNOY = "ANNOY";
 const char* NAME_ENGINE_TYPE_IVFSQ8NR = "IVFSQ8NR";
 const char* NAME_ENGINE_TYPE_HNSWSQ8NR = "HNSWSQ8NR";
+const char* NAME_ENGINE_TYPE_IVFPQFASTSCAN = "IVFPQFASTSCAN";
+const char* NAME_ENGINE_TYPE_DISKANN = "DISKANN";
+const char* NAME_ENGINE_TYPE_BINHASH = "BINHASH";
 
 const char* NAME_METRIC_TYPE_L2 = "L2";
 const char* NAME_METRIC_TYPE_IP = "IP";
@@ -46,6 +49,9 @@ const int64_t VALUE_INDEX_NLIST_DEFAULT = 16384;
 const int64_t VALUE_CONFIG_CPU_CACHE_CAPACITY_DEFAULT = 4;
 const bool VALUE_CONFIG_CACHE_INSERT_DATA_DEFAULT = false;
 
+/////////////////////////////////////////////////////
+const char* CONTENT_TYPE_OCTET_STREAM = "application/octet-stream";
+
 /////////////////////////////////////////////////////
 const std::unordered_map<engine::EngineType, std::string> IndexMap = {
     {engine::EngineType::FAISS_IDMAP, NAME_ENGINE_TYPE_FLAT},
@@ -57,7 +63,10 @@ const std::unordered_map<engine::EngineType, std::string> IndexMap = {
     {engine::EngineType::HNSW, NAME_ENGINE_TYPE_HNSW},
     {engine::EngineType::ANNOY, NAME_ENGINE_TYPE_ANNOY},
     {engine::EngineType::FAISS_IVFSQ8NR, NAME_ENGINE_TYPE_IVFSQ8NR},
-    {engine::EngineType::HNSW_SQ8NR, NAME_ENGINE_TYPE_HNSWSQ8NR}};
+    {engine::EngineType::HNSW_SQ8NR, NAME_ENGINE_TYPE_HNSWSQ8NR},
+    {engine::EngineType::FAISS_PQ_FASTSCAN, NAME_ENGINE_TYPE_IVFPQFASTSCAN},
+    {engine::EngineType::DISKANN, NAME_ENGINE_TYPE_DISKANN},
+    {engine::EngineType::FAISS_BIN_HASH, NAME_ENGINE_TYPE_BINHASH}};
 
 const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
     {NAME_ENGINE_TYPE_FLAT, engine::EngineType::FAISS_IDMAP},
@@ -69,7 +78,10 @@ const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
     {NAME_ENGINE_TYPE_HNSW, engine::EngineType::HNSW},
     {NAME_ENGINE_TYPE_ANNOY, engine::EngineType::ANNOY},
     {NAME_ENGINE_TYPE_IVFSQ8NR, engine::EngineType::FAISS_IVFSQ8NR},
-    {NAME_ENGINE_TYPE_HNSWSQ8NR, engine::EngineType::HNSW_SQ8NR}};
+    {NAME_ENGINE_TYPE_HNSWSQ8NR, engine::EngineType::HNSW_SQ8NR},
+    {NAME_ENGINE_TYPE_IVFPQFASTSCAN, engine::EngineType::FAISS_PQ_FASTSCAN},
+    {NAME_ENGINE_TYPE_DISKANN, engine::EngineType::DISKANN},
+    {NAME_ENGINE_TYPE_BINHASH, engine::EngineType::FAISS_BIN_HASH}};
 
 const std::unordered_map<engine::MetricType, std::string> MetricMap = {
     {engine::MetricType::L2, NAME_METRIC_TYPE_L2},
@@ -24,12 +24,15 @@ extern const char* NAME_ENGINE_TYPE_FLAT;
 extern const char* NAME_ENGINE_TYPE_IVFFLAT;
 extern const char* NAME_ENGINE_TYPE_IVFSQ8;
 extern const char* NAME_ENGINE_TYPE_IVFSQ8NR;
+extern const char* NAME_ENGINE_TYPE_IVFPQFASTSCAN;
 extern const char* NAME_ENGINE_TYPE_IVFSQ8H;
 extern const char* NAME_ENGINE_TYPE_RNSG;
 extern const char* NAME_ENGINE_TYPE_IVFPQ;
 extern const char* NAME_ENGINE_TYPE_HNSW;
 extern const char* NAME_ENGINE_TYPE_HNSW_SQ8NR;
 extern const char* NAME_ENGINE_TYPE_ANNOY;
+extern const char* NAME_ENGINE_TYPE_DISKANN;
+extern const char* NAME_ENGINE_TYPE_BINHASH;
 
 extern const char* NAME_METRIC_TYPE_L2;
 extern const char* NAME_METRIC_TYPE_IP;
@@ -48,6 +51,9 @@ extern const int64_t VALUE_INDEX_NLIST_DEFAULT;
 extern const int64_t VALUE_CONFIG_CPU_CACHE_CAPACITY_DEFAULT;
 extern const bool VALUE_CONFIG_CACHE_INSERT_DATA_DEFAULT;
 
+/////////////////////////////////////////////////////
+extern const char* CONTENT_TYPE_OCTET_STREAM;
+
 /////////////////////////////////////////////////////
 extern const std::unordered_map<engine::EngineType, std::string> IndexMap;
 extern const std::unordered_map<std::string, engine::EngineType> IndexNameMap;
@@ -14,7 +14,9 @@
 
 #include "config/Config.h"
 #include "server/web_impl/WebServer.h"
+#include "server/web_impl/controller/WebAsyncController.hpp"
 #include "server/web_impl/controller/WebController.hpp"
+#include "utils/Log.h"
 
 namespace milvus {
 namespace server {
@@ -26,6 +28,7 @@ WebServer::Start() {
     bool enable = true;
     config.GetNetworkConfigHTTPEnable(enable);
     if (enable && nullptr == thread_ptr_) {
+        try_stop_.store(false);
         thread_ptr_ = std::make_shared<std::thread>(&WebServer::StartService, this);
     }
 }
@@ -49,11 +52,24 @@ WebServer::StartService() {
     std::string port;
     STATUS_CHECK(config.GetNetworkConfigHTTPPort(port));
 
+    bool async_mode = false;
+    STATUS_CHECK(config.GetNetworkConfigHTTPAsync(async_mode));
+    int64_t io_threads = 0, worker_threads = 0;
+    STATUS_CHECK(config.GetNetworkConfigHTTPIOThreads(io_threads));
+    STATUS_CHECK(config.GetNetworkConfigHTTPWorkerThreads(worker_threads));
+
     {
-        AppComponent components = AppComponent(std::stoi(port));
+        AppComponent components = AppComponent(std::stoi(port), async_mode ? io_threads : 0);
 
         /* create ApiControllers and add endpoints to router */
-        auto user_controller = WebController::createShared();
+        std::shared_ptr<oatpp::web::server::api::ApiController> user_controller;
+        if (async_mode) {
+            user_controller = WebAsyncController::createShared(worker_threads);
+            LOG_SERVER_INFO_ << "HTTP server serves with " << io_threads << " io threads and " << worker_threads
+                             << " worker threads";
+        } else {
+            user_controller = WebController::createShared();
+        }
         auto router = components.http_router_.getObject();
         user_controller->addEndpointsToRouter(router);
 
@@ -79,6 +95,9 @@ WebServer::StartService() {
         // start synchronously
         server.run();
         connection_handler->stop();
+        if (components.executor_ != nullptr) {
+            components.executor_->join();
+        }
         stop_thread.join();
     }
     oatpp::base::Environment::destroy();
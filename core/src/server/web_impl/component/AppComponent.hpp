@@ -13,12 +13,14 @@
 
 #include <iostream>
 
+#include <oatpp/core/async/Executor.hpp>
 #include <oatpp/core/macro/component.hpp>
 #include <oatpp/network/client/SimpleTCPConnectionProvider.hpp>
 #include <oatpp/network/server/SimpleTCPConnectionProvider.hpp>
 #include <oatpp/parser/json/mapping/Deserializer.hpp>
 #include <oatpp/parser/json/mapping/ObjectMapper.hpp>
 #include <oatpp/parser/json/mapping/Serializer.hpp>
+#include <oatpp/web/server/AsyncHttpConnectionHandler.hpp>
 #include <oatpp/web/server/HttpConnectionHandler.hpp>
 #include <oatpp/web/server/HttpRouter.hpp>
 
@@ -30,12 +32,19 @@ class AppComponent {
 
  public:
 
-    explicit AppComponent(int port) : port_(port) {
+    // with io_threads the connections are served by coroutines on those threads, else by a thread each
+    explicit AppComponent(int port, int64_t io_threads = 0)
+        : port_(port),
+          executor_(io_threads > 0 ? std::make_shared<oatpp::async::Executor>(io_threads, 1, 1) : nullptr) {
     }
 
  private:
     const int port_;
 
+ public:
+    // stopped by the connection handler, joined by the owner
+    const std::shared_ptr<oatpp::async::Executor> executor_;
+
  public:
     OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, server_connection_provider_)
     ([this] {
@@ -58,8 +67,12 @@ class AppComponent {
         return oatpp::web::server::HttpRouter::createShared();
     }());
 
-    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::server::ConnectionHandler>, server_connection_handler_)([] {
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::server::ConnectionHandler>, server_connection_handler_)
+    ([this]() -> std::shared_ptr<oatpp::network::server::ConnectionHandler> {
         OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+        if (this->executor_ != nullptr) {
+            return oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, this->executor_);
+        }
         return oatpp::web::server::HttpConnectionHandler::createShared(router);
     }());
 
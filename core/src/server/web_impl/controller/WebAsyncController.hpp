@@ -0,0 +1,391 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include <oatpp/core/async/CoroutineWaitList.hpp>
+#include <oatpp/core/macro/codegen.hpp>
+#include <oatpp/core/macro/component.hpp>
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include "server/web_impl/controller/WebController.hpp"
+#include "utils/ThreadPool.h"
+
+// EXPR calls an endpoint of WebController, with controller, request and body in scope, on the worker pool
+#define WEB_ASYNC_WAIT()                                               \
+    std::shared_ptr<AsyncResponse> response_;                          \
+    Action WaitResponse() {                                            \
+        auto response = response_->Get();                              \
+        if (response == nullptr) {                                     \
+            return Action::createWaitListAction(response_->Waiters()); \
+        }                                                              \
+        return _return(response);                                      \
+    }
+
+#define WEB_ASYNC_CALL(NAME, EXPR)                                                  \
+    WEB_ASYNC_WAIT()                                                                \
+    Action act() override {                                                         \
+        auto controller = this->controller;                                         \
+        auto request = this->request;                                               \
+        response_ = controller->Dispatch([controller, request]() { return EXPR; }); \
+        return yieldTo(&NAME::WaitResponse);                                        \
+    }
+
+#define WEB_ASYNC_BODY_CALL(NAME, EXPR)                                                   \
+    WEB_ASYNC_WAIT()                                                                      \
+    Action act() override {                                                               \
+        return request->readBodyToStringAsync().callbackTo(&NAME::OnBody);                \
+    }                                                                                     \
+    Action OnBody(const oatpp::String& body) {                                            \
+        auto controller = this->controller;                                               \
+        auto request = this->request;                                                     \
+        response_ = controller->Dispatch([controller, request, body]() { return EXPR; }); \
+        return yieldTo(&NAME::WaitResponse);                                              \
+    }
+
+// the endpoints which don't block answer on the I/O thread
+#define WEB_ASYNC_INLINE(EXPR)                     \
+    Action act() override {                        \
+        return _return(controller->AddCors(EXPR)); \
+    }
+
+namespace milvus {
+namespace server {
+namespace web {
+
+/*
+ * The endpoints of WebController served by coroutines, for the AsyncHttpConnectionHandler. A coroutine reads the
+ * body without blocking, hands the endpoint of WebController to the worker pool, where it waits for the
+ * RequestScheduler, and resumes with its response. So an idle keep-alive connection holds no thread, and the
+ * requests in flight at most the worker threads.
+ */
+class WebAsyncController : public oatpp::web::server::api::ApiController {
+ public:
+    WebAsyncController(const std::shared_ptr<ObjectMapper>& objectMapper, int64_t worker_threads)
+        : oatpp::web::server::api::ApiController(objectMapper),
+          object_mapper_(objectMapper),
+          controller_(std::make_shared<WebController>(objectMapper)),
+          pool_(std::make_shared<ThreadPool>(worker_threads, MAX_QUEUED_REQUESTS, "web_worker")) {
+    }
+
+ public:
+    static std::shared_ptr<WebAsyncController>
+    createShared(int64_t worker_threads, OATPP_COMPONENT(std::shared_ptr<ObjectMapper>, objectMapper)) {
+        return std::make_shared<WebAsyncController>(objectMapper, worker_threads);
+    }
+
+    // the response of a worker, the coroutines waiting for it are resumed once it is set
+    class AsyncResponse : public oatpp::async::CoroutineWaitList::Listener {
+     public:
+        AsyncResponse() {
+            waiters_.setListener(this);
+        }
+
+        void
+        Set(const std::shared_ptr<OutgoingResponse>& response) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                response_ = response;
+            }
+            waiters_.notifyAll();
+        }
+
+        std::shared_ptr<OutgoingResponse>
+        Get() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return response_;
+        }
+
+        oatpp::async::CoroutineWaitList*
+        Waiters() {
+            return &waiters_;
+        }
+
+        // a coroutine starting to wait after the response is set is resumed at once
+        void
+        onNewItem(oatpp::async::CoroutineWaitList& list) override {
+            if (Get() != nullptr) {
+                list.notifyAll();
+            }
+        }
+
+     private:
+        std::mutex mutex_;
+        std::shared_ptr<OutgoingResponse> response_;
+        oatpp::async::CoroutineWaitList waiters_;
+    };
+
+    // a worker throwing answers 500, as the synchronous handler does. With the queue full the request is answered
+    // 503 at once, the I/O thread never waits for the workers
+    template <typename Call>
+    std::shared_ptr<AsyncResponse>
+    Dispatch(Call call) const {
+        auto async_response = std::make_shared<AsyncResponse>();
+        bool queued = pool_->try_enqueue([this, call, async_response]() {
+            std::shared_ptr<OutgoingResponse> response;
+            try {
+                response = call();
+            } catch (std::exception& ex) {
+                response = createResponse(Status::CODE_500, ex.what());
+            }
+            async_response->Set(AddCors(response));
+        });
+        if (!queued) {
+            async_response->Set(AddCors(createResponse(Status::CODE_503, "Too many requests in queue")));
+        }
+        return async_response;
+    }
+
+    // ADD_CORS only wraps the synchronous endpoints
+    std::shared_ptr<OutgoingResponse>
+    AddCors(const std::shared_ptr<OutgoingResponse>& response) const {
+        response->putHeaderIfNotExists("Access-Control-Allow-Origin", "*");
+        response->putHeaderIfNotExists("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
+        response->putHeaderIfNotExists("Access-Control-Allow-Headers",
+                                       "DNT, User-Agent, X-Requested-With, If-Modified-Since, Cache-Control, "
+                                       "Content-Type, Range, Authorization");
+        response->putHeaderIfNotExists("Access-Control-Max-Age", "1728000");
+        return response;
+    }
+
+    template <typename Dto>
+    typename Dto::ObjectWrapper
+    ReadDto(const oatpp::String& body) const {
+        return object_mapper_->readFromString<Dto>(body);
+    }
+
+    /**
+     *  Begin ENDPOINTs generation ('ApiController' codegen)
+     */
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+    ENDPOINT_ASYNC("GET", "/", root) {
+        ENDPOINT_ASYNC_INIT(root)
+        WEB_ASYNC_INLINE(controller->controller_->root())
+    };
+
+    ENDPOINT_ASYNC("GET", "/state", State) {
+        ENDPOINT_ASYNC_INIT(State)
+        WEB_ASYNC_CALL(State, controller->controller_->State())
+    };
+
+    ENDPOINT_ASYNC("GET", "/profile/{type}", GetProfile) {
+        ENDPOINT_ASYNC_INIT(GetProfile)
+        WEB_ASYNC_CALL(GetProfile, controller->controller_->GetProfile(request->getPathVariable("type"),
+                                                                       request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("GET", "/devices", GetDevices) {
+        ENDPOINT_ASYNC_INIT(GetDevices)
+        WEB_ASYNC_CALL(GetDevices, controller->controller_->GetDevices())
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/config/advanced", AdvancedConfigOptions) {
+        ENDPOINT_ASYNC_INIT(AdvancedConfigOptions)
+        WEB_ASYNC_INLINE(controller->controller_->AdvancedConfigOptions())
+    };
+
+    ENDPOINT_ASYNC("GET", "/config/advanced", GetAdvancedConfig) {
+        ENDPOINT_ASYNC_INIT(GetAdvancedConfig)
+        WEB_ASYNC_CALL(GetAdvancedConfig, controller->controller_->GetAdvancedConfig())
+    };
+
+    ENDPOINT_ASYNC("PUT", "/config/advanced", SetAdvancedConfig) {
+        ENDPOINT_ASYNC_INIT(SetAdvancedConfig)
+        WEB_ASYNC_BODY_CALL(SetAdvancedConfig,
+                            controller->controller_->SetAdvancedConfig(controller->ReadDto<AdvancedConfigDto>(body)))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/config/gpu_resources", GPUConfigOptions) {
+        ENDPOINT_ASYNC_INIT(GPUConfigOptions)
+        WEB_ASYNC_INLINE(controller->controller_->GPUConfigOptions())
+    };
+
+    ENDPOINT_ASYNC("GET", "/config/gpu_resources", GetGPUConfig) {
+        ENDPOINT_ASYNC_INIT(GetGPUConfig)
+        WEB_ASYNC_CALL(GetGPUConfig, controller->controller_->GetGPUConfig())
+    };
+
+    ENDPOINT_ASYNC("PUT", "/config/gpu_resources", SetGPUConfig) {
+        ENDPOINT_ASYNC_INIT(SetGPUConfig)
+        WEB_ASYNC_BODY_CALL(SetGPUConfig,
+                            controller->controller_->SetGPUConfig(controller->ReadDto<GPUConfigDto>(body)))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/collections", CollectionsOptions) {
+        ENDPOINT_ASYNC_INIT(CollectionsOptions)
+        WEB_ASYNC_INLINE(controller->controller_->CollectionsOptions())
+    };
+
+    ENDPOINT_ASYNC("POST", "/collections", CreateCollection) {
+        ENDPOINT_ASYNC_INIT(CreateCollection)
+        WEB_ASYNC_BODY_CALL(CreateCollection, controller->controller_->CreateCollection(
+                                                  controller->ReadDto<CollectionRequestDto>(body)))
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections", ShowCollections) {
+        ENDPOINT_ASYNC_INIT(ShowCollections)
+        WEB_ASYNC_CALL(ShowCollections, controller->controller_->ShowCollections(request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/collections/{collection_name}", CollectionOptions) {
+        ENDPOINT_ASYNC_INIT(CollectionOptions)
+        WEB_ASYNC_INLINE(controller->controller_->CollectionOptions())
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections/{collection_name}", GetCollection) {
+        ENDPOINT_ASYNC_INIT(GetCollection)
+        WEB_ASYNC_CALL(GetCollection, controller->controller_->GetCollection(
+                                          request->getPathVariable("collection_name"), request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("DELETE", "/collections/{collection_name}", DropCollection) {
+        ENDPOINT_ASYNC_INIT(DropCollection)
+        WEB_ASYNC_CALL(DropCollection,
+                       controller->controller_->DropCollection(request->getPathVariable("collection_name")))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/collections/{collection_name}/indexes", IndexOptions) {
+        ENDPOINT_ASYNC_INIT(IndexOptions)
+        WEB_ASYNC_INLINE(controller->controller_->IndexOptions())
+    };
+
+    ENDPOINT_ASYNC("POST", "/collections/{collection_name}/indexes", CreateIndex) {
+        ENDPOINT_ASYNC_INIT(CreateIndex)
+        WEB_ASYNC_BODY_CALL(CreateIndex,
+                            controller->controller_->CreateIndex(request->getPathVariable("collection_name"), body))
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections/{collection_name}/indexes", GetIndex) {
+        ENDPOINT_ASYNC_INIT(GetIndex)
+        WEB_ASYNC_CALL(GetIndex, controller->controller_->GetIndex(request->getPathVariable("collection_name")))
+    };
+
+    ENDPOINT_ASYNC("DELETE", "/collections/{collection_name}/indexes", DropIndex) {
+        ENDPOINT_ASYNC_INIT(DropIndex)
+        WEB_ASYNC_CALL(DropIndex, controller->controller_->DropIndex(request->getPathVariable("collection_name")))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/collections/{collection_name}/partitions", PartitionsOptions) {
+        ENDPOINT_ASYNC_INIT(PartitionsOptions)
+        WEB_ASYNC_INLINE(controller->controller_->PartitionsOptions())
+    };
+
+    ENDPOINT_ASYNC("POST", "/collections/{collection_name}/partitions", CreatePartition) {
+        ENDPOINT_ASYNC_INIT(CreatePartition)
+        WEB_ASYNC_BODY_CALL(CreatePartition,
+                            controller->controller_->CreatePartition(request->getPathVariable("collection_name"),
+                                                                     controller->ReadDto<PartitionRequestDto>(body)))
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections/{collection_name}/partitions", ShowPartitions) {
+        ENDPOINT_ASYNC_INIT(ShowPartitions)
+        WEB_ASYNC_CALL(ShowPartitions, controller->controller_->ShowPartitions(
+                                           request->getPathVariable("collection_name"), request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("DELETE", "/collections/{collection_name}/partitions", DropPartition) {
+        ENDPOINT_ASYNC_INIT(DropPartition)
+        WEB_ASYNC_BODY_CALL(DropPartition,
+                            controller->controller_->DropPartition(request->getPathVariable("collection_name"), body))
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections/{collection_name}/segments", ShowSegments) {
+        ENDPOINT_ASYNC_INIT(ShowSegments)
+        WEB_ASYNC_CALL(ShowSegments, controller->controller_->ShowSegments(request->getPathVariable("collection_name"),
+                                                                           request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections/{collection_name}/segments/{segment_name}/{info}", GetSegmentInfo) {
+        ENDPOINT_ASYNC_INIT(GetSegmentInfo)
+        WEB_ASYNC_CALL(GetSegmentInfo, controller->controller_->GetSegmentInfo(
+                                           request->getPathVariable("collection_name"),
+                                           request->getPathVariable("segment_name"), request->getPathVariable("info"),
+                                           request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/collections/{collection_name}/vectors", VectorsOptions) {
+        ENDPOINT_ASYNC_INIT(VectorsOptions)
+        WEB_ASYNC_INLINE(controller->controller_->VectorsOptions())
+    };
+
+    ENDPOINT_ASYNC("GET", "/collections/{collection_name}/vectors", GetVectors) {
+        ENDPOINT_ASYNC_INIT(GetVectors)
+        WEB_ASYNC_CALL(GetVectors, controller->controller_->GetVectors(request->getPathVariable("collection_name"),
+                                                                       request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("POST", "/collections/{collection_name}/vectors", Insert) {
+        ENDPOINT_ASYNC_INIT(Insert)
+        WEB_ASYNC_BODY_CALL(Insert,
+                            controller->controller_->Insert(request->getPathVariable("collection_name"), request, body))
+    };
+
+    ENDPOINT_ASYNC("POST", "/hybrid_collections/{collection_name}/entities", InsertEntity) {
+        ENDPOINT_ASYNC_INIT(InsertEntity)
+        WEB_ASYNC_BODY_CALL(InsertEntity,
+                            controller->controller_->InsertEntity(request->getPathVariable("collection_name"), body))
+    };
+
+    ENDPOINT_ASYNC("PUT", "/hybrid_collections/{collection_name}/entities", EntityOp) {
+        ENDPOINT_ASYNC_INIT(EntityOp)
+        WEB_ASYNC_BODY_CALL(EntityOp,
+                            controller->controller_->EntityOp(request->getPathVariable("collection_name"), body))
+    };
+
+    ENDPOINT_ASYNC("PUT", "/collections/{collection_name}/vectors", VectorsOp) {
+        ENDPOINT_ASYNC_INIT(VectorsOp)
+        WEB_ASYNC_BODY_CALL(VectorsOp, controller->controller_->VectorsOp(request->getPathVariable("collection_name"),
+                                                                          request, body))
+    };
+
+    ENDPOINT_ASYNC("OPTIONS", "/system/{info}", SystemOptions) {
+        ENDPOINT_ASYNC_INIT(SystemOptions)
+        WEB_ASYNC_INLINE(controller->controller_->SystemOptions())
+    };
+
+    ENDPOINT_ASYNC("GET", "/system/{info}", SystemInfo) {
+        ENDPOINT_ASYNC_INIT(SystemInfo)
+        WEB_ASYNC_CALL(SystemInfo, controller->controller_->SystemInfo(request->getPathVariable("info"),
+                                                                       request->getQueryParameters()))
+    };
+
+    ENDPOINT_ASYNC("PUT", "/system/{op}", SystemOp) {
+        ENDPOINT_ASYNC_INIT(SystemOp)
+        WEB_ASYNC_BODY_CALL(SystemOp, controller->controller_->SystemOp(request->getPathVariable("op"), body))
+    };
+
+    ENDPOINT_ASYNC("POST", "/hybrid_collections", CreateHybridCollection) {
+        ENDPOINT_ASYNC_INIT(CreateHybridCollection)
+        WEB_ASYNC_BODY_CALL(CreateHybridCollection, controller->controller_->CreateHybridCollection(body))
+    };
+
+/**
+ *  Finish ENDPOINTs generation ('ApiController' codegen)
+ */
+#include OATPP_CODEGEN_END(ApiController)
+
+ private:
+    // requests queued to the workers at most, beyond them a request is answered 503
+    static constexpr size_t MAX_QUEUED_REQUESTS = 10000;
+
+    std::shared_ptr<ObjectMapper> object_mapper_;
+    std::shared_ptr<WebController> controller_;
+    std::shared_ptr<ThreadPool> pool_;
+};
+
+}  // namespace web
+}  // namespace server
+}  // namespace milvus
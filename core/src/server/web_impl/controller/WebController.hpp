@@ -47,6 +47,13 @@ class WebController : public oatpp::web::server::api::ApiController {
         return std::make_shared<WebController>(objectMapper);
     }
 
+    // vectors insert and search take a binary body with this content type, see WebRequestHandler::SplitBinaryBody
+    static bool
+    IsOctetStream(const std::shared_ptr<IncomingRequest>& request) {
+        auto content_type = request->getHeader(Header::CONTENT_TYPE);
+        return content_type != nullptr && content_type->std_str().find(CONTENT_TYPE_OCTET_STREAM) == 0;
+    }
+
     /**
      *  Begin ENDPOINTs generation ('ApiController' codegen)
      */
@@ -64,8 +71,37 @@ class WebController : public oatpp::web::server::api::ApiController {
 
     ENDPOINT("GET", "/state", State) {
         TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "GET \'/state\'");
+
+        WebRequestHandler handler = WebRequestHandler();
+        OString result = "";
+        handler.GetState(result);
         tr.ElapseFromBegin("Total cost ");
-        return createDtoResponse(Status::CODE_200, StatusDto::createShared());
+        return createResponse(Status::CODE_200, result);
+    }
+
+    ADD_CORS(GetProfile)
+
+    ENDPOINT("GET", "/profile/{type}", GetProfile, PATH(String, type), QUERIES(const QueryParams&, query_params)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "GET \'/profile/" + type->std_str() + "\'");
+        tr.RecordSection("Received request.");
+
+        WebRequestHandler handler = WebRequestHandler();
+        OString result = "";
+        auto status_dto = handler.GetProfile(type, query_params, result);
+        std::shared_ptr<OutgoingResponse> response;
+        switch (status_dto->code->getValue()) {
+            case StatusCode::SUCCESS:
+                response = createResponse(Status::CODE_200, result);
+                response->putHeader(Header::CONTENT_TYPE, "application/octet-stream");
+                break;
+            default:
+                response = createDtoResponse(Status::CODE_400, status_dto);
+        }
+
+        tr.ElapseFromBegin("Done. Status: code = " + std::to_string(status_dto->code->getValue()) +
+                           ", reason = " + status_dto->message->std_str() + ". Total cost");
+
+        return response;
     }
 
     ADD_CORS(GetDevices)
@@ -596,7 +632,7 @@ class WebController : public oatpp::web::server::api::ApiController {
     ADD_CORS(Insert)
 
     ENDPOINT("POST", "/collections/{collection_name}/vectors", Insert, PATH(String, collection_name),
-             BODY_STRING(String, body)) {
+             REQUEST(std::shared_ptr<IncomingRequest>, request), BODY_STRING(String, body)) {
         TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "POST \'/collections/" + collection_name->std_str() +
                         "/vectors\'");
         tr.RecordSection("Received request.");
@@ -605,10 +641,18 @@ class WebController : public oatpp::web::server::api::ApiController {
         WebRequestHandler handler = WebRequestHandler();
 
         std::shared_ptr<OutgoingResponse> response;
-        auto status_dto = handler.Insert(collection_name, body, ids_dto);
+        bool binary = IsOctetStream(request);
+        OString ids;
+        auto status_dto = binary ? handler.InsertBinary(collection_name, body, ids)
+                                 : handler.Insert(collection_name, body, ids_dto);
         switch (status_dto->code->getValue()) {
             case StatusCode::SUCCESS:
-                response = createDtoResponse(Status::CODE_201, ids_dto);
+                if (binary) {
+                    response = createResponse(Status::CODE_201, ids);
+                    response->putHeader(Header::CONTENT_TYPE, CONTENT_TYPE_OCTET_STREAM);
+                } else {
+                    response = createDtoResponse(Status::CODE_201, ids_dto);
+                }
                 break;
             case StatusCode::COLLECTION_NOT_EXISTS:
                 response = createDtoResponse(Status::CODE_404, status_dto);
@@ -686,7 +730,7 @@ class WebController : public oatpp::web::server::api::ApiController {
     ADD_CORS(VectorsOp)
 
     ENDPOINT("PUT", "/collections/{collection_name}/vectors", VectorsOp, PATH(String, collection_name),
-             BODY_STRING(String, body)) {
+             REQUEST(std::shared_ptr<IncomingRequest>, request), BODY_STRING(String, body)) {
         TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "PUT \'/collections/" + collection_name->std_str() +
                         "/vectors\'");
         tr.RecordSection("Received request.");
@@ -695,10 +739,15 @@ class WebController : public oatpp::web::server::api::ApiController {
 
         OString result;
         std::shared_ptr<OutgoingResponse> response;
-        auto status_dto = handler.VectorsOp(collection_name, body, result);
+        bool binary = IsOctetStream(request);
+        auto status_dto = binary ? handler.VectorsOpBinary(collection_name, body, result)
+                                 : handler.VectorsOp(collection_name, body, result);
         switch (status_dto->code->getValue()) {
             case StatusCode::SUCCESS:
                 response = createResponse(Status::CODE_200, result);
+                if (binary) {
+                    response->putHeader(Header::CONTENT_TYPE, CONTENT_TYPE_OCTET_STREAM);
+                }
                 break;
             case StatusCode::COLLECTION_NOT_EXISTS:
                 response = createDtoResponse(Status::CODE_404, status_dto);
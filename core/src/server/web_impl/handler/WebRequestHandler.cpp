@@ -12,6 +12,7 @@
 #include "server/web_impl/handler/WebRequestHandler.h"
 
 #include <algorithm>
+#include <cstring>
 #include <ctime>
 #include <string>
 #include <unordered_map>
@@ -22,12 +23,14 @@
 #include "config/Config.h"
 #include "config/Utils.h"
 #include "metrics/SystemInfo.h"
+#include "server/Profiler.h"
 #include "server/delivery/request/BaseRequest.h"
 #include "server/web_impl/Constants.h"
 #include "server/web_impl/Types.h"
 #include "server/web_impl/dto/PartitionDto.hpp"
 #include "server/web_impl/utils/Util.h"
 #include "thirdparty/nlohmann/json.hpp"
+#include "utils/ContentionStats.h"
 #include "utils/StringHelpFunctions.h"
 
 namespace milvus {
@@ -132,6 +135,54 @@ WebRequestHandler::CopyRecordsFromJson(const nlohmann::json& json, engine::Vecto
     return Status::OK();
 }
 
+Status
+WebRequestHandler::CopyRecordsFromBinary(const std::string& collection_name, const char* data, size_t size,
+                                         engine::VectorsData& vectors) {
+    CollectionSchema schema;
+    auto status = request_handler_.DescribeCollection(context_ptr_, collection_name, schema);
+    if (!status.ok()) {
+        return status;
+    }
+    bool bin = false;
+    status = IsBinaryCollection(collection_name, bin);
+    if (!status.ok()) {
+        return status;
+    }
+
+    size_t row_size = bin ? schema.dimension_ / 8 : schema.dimension_ * sizeof(float);
+    if (size == 0 || row_size == 0 || size % row_size != 0) {
+        return Status(ILLEGAL_BODY, "Size of the vectors doesn't match the collection dimension");
+    }
+
+    vectors.vector_count_ = size / row_size;
+    if (bin) {
+        vectors.binary_data_.assign(data, data + size);
+    } else {
+        vectors.float_data_.resize(size / sizeof(float));
+        memcpy(vectors.float_data_.data(), data, size);
+    }
+    return Status::OK();
+}
+
+Status
+WebRequestHandler::SplitBinaryBody(const OString& body, nlohmann::json& header, const char*& data, size_t& size) {
+    if (nullptr == body.get() || static_cast<size_t>(body->getSize()) < sizeof(uint32_t)) {
+        return Status(BODY_FIELD_LOSS, "Request payload is required.");
+    }
+    auto body_data = reinterpret_cast<const char*>(body->getData());
+    size_t body_size = body->getSize();
+
+    uint32_t header_size = 0;
+    memcpy(&header_size, body_data, sizeof(uint32_t));
+    if (header_size > body_size - sizeof(uint32_t)) {
+        return Status(ILLEGAL_BODY, "Header size exceeds the payload");
+    }
+    header = nlohmann::json::parse(body_data + sizeof(uint32_t), body_data + sizeof(uint32_t) + header_size);
+    data = body_data + sizeof(uint32_t) + header_size;
+    size = body_size - sizeof(uint32_t) - header_size;
+    return Status::OK();
+}
+
 ///////////////////////// WebRequestHandler methods ///////////////////////////////////////
 Status
 WebRequestHandler::GetCollectionMetaInfo(const std::string& collection_name, nlohmann::json& json_out) {
@@ -259,7 +310,35 @@ WebRequestHandler::PreLoadCollection(const nlohmann::json& json, std::string& re
     }
 
     auto collection_name = json["collection_name"];
-    auto status = request_handler_.PreloadCollection(context_ptr_, collection_name.get<std::string>());
+
+    int64_t cache_quota = -1;
+    bool pinned = false;
+    if (json.contains("cache_quota") || json.contains("pin")) {
+        cache_quota = 0;
+        if (json.contains("cache_quota")) {
+            auto& quota_json = json["cache_quota"];
+            if (quota_json.is_number_integer()) {
+                cache_quota = quota_json.get<int64_t>();
+            } else if (quota_json.is_string()) {
+                std::string err;
+                cache_quota = parse_bytes(quota_json.get<std::string>(), err);
+                if (!err.empty()) {
+                    return Status(ILLEGAL_BODY, err);
+                }
+            } else {
+                return Status(ILLEGAL_BODY, "Field \"cache_quota\" must be an integer or a size string");
+            }
+        }
+        if (json.contains("pin")) {
+            if (!json["pin"].is_boolean()) {
+                return Status(ILLEGAL_BODY, "Field \"pin\" must be a boolean");
+            }
+            pinned = json["pin"].get<bool>();
+        }
+    }
+
+    auto status = request_handler_.PreloadCollection(context_ptr_, collection_name.get<std::string>(), cache_quota,
+                                                     pinned);
     if (status.ok()) {
         nlohmann::json result;
         AddStatusToJson(result, status.code(), status.message());
@@ -409,6 +488,47 @@ WebRequestHandler::SetConfig(const nlohmann::json& json, std::string& result_str
 
 Status
 WebRequestHandler::Search(const std::string& collection_name, const nlohmann::json& json, std::string& result_str) {
+    TopKQueryResult result;
+    auto status = SearchResult(collection_name, json, nullptr, result);
+    if (!status.ok()) {
+        return status;
+    }
+
+    nlohmann::json result_json;
+    result_json["num"] = result.row_num_;
+    if (!result.cost_.empty()) {
+        result_json["cost"] = nlohmann::json::parse(result.cost_);
+    }
+    if (result.row_num_ == 0) {
+        result_json["result"] = std::vector<int64_t>();
+        result_str = result_json.dump();
+        return Status::OK();
+    }
+
+    auto step = result.id_list_.size() / result.row_num_;
+    nlohmann::json search_result_json;
+    for (int64_t i = 0; i < result.row_num_; i++) {
+        nlohmann::json raw_result_json;
+        for (size_t j = 0; j < step; j++) {
+            nlohmann::json one_result_json;
+            one_result_json["id"] = std::to_string(result.id_list_.at(i * step + j));
+            one_result_json["distance"] = std::to_string(result.distance_list_.at(i * step + j));
+            if (!result.collection_list_.empty()) {
+                one_result_json["collection"] = result.collection_list_.at(i * step + j);
+            }
+            raw_result_json.emplace_back(one_result_json);
+        }
+        search_result_json.emplace_back(raw_result_json);
+    }
+    result_json["result"] = search_result_json;
+    result_str = result_json.dump();
+
+    return Status::OK();
+}
+
+Status
+WebRequestHandler::SearchResult(const std::string& collection_name, const nlohmann::json& json,
+                                engine::VectorsData* raw_vectors, TopKQueryResult& result) {
     if (!json.contains("topk")) {
         return Status(BODY_FIELD_LOSS, "Field \'topk\' is required");
     }
@@ -430,7 +550,6 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
         }
     }
 
-    TopKQueryResult result;
     Status status;
     if (json.contains("ids")) {
         auto vec_ids = json["ids"];
@@ -457,53 +576,30 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
             }
         }
 
-        bool bin_flag = false;
-        status = IsBinaryCollection(collection_name, bin_flag);
-        if (!status.ok()) {
-            return status;
-        }
+        engine::VectorsData vectors_data;
+        if (raw_vectors == nullptr) {
+            bool bin_flag = false;
+            status = IsBinaryCollection(collection_name, bin_flag);
+            if (!status.ok()) {
+                return status;
+            }
 
-        if (!json.contains("vectors")) {
-            return Status(BODY_FIELD_LOSS, "Field \"vectors\" is required");
-        }
+            if (!json.contains("vectors")) {
+                return Status(BODY_FIELD_LOSS, "Field \"vectors\" is required");
+            }
 
-        engine::VectorsData vectors_data;
-        status = CopyRecordsFromJson(json["vectors"], vectors_data, bin_flag);
-        if (!status.ok()) {
-            return status;
+            status = CopyRecordsFromJson(json["vectors"], vectors_data, bin_flag);
+            if (!status.ok()) {
+                return status;
+            }
+            raw_vectors = &vectors_data;
         }
 
-        status = request_handler_.Search(context_ptr_, collection_name, vectors_data, topk, json["params"],
+        status = request_handler_.Search(context_ptr_, collection_name, *raw_vectors, topk, json["params"],
                                          partition_tags, file_id_vec, result);
     }
-    if (!status.ok()) {
-        return status;
-    }
-
-    nlohmann::json result_json;
-    result_json["num"] = result.row_num_;
-    if (result.row_num_ == 0) {
-        result_json["result"] = std::vector<int64_t>();
-        result_str = result_json.dump();
-        return Status::OK();
-    }
-
-    auto step = result.id_list_.size() / result.row_num_;
-    nlohmann::json search_result_json;
-    for (int64_t i = 0; i < result.row_num_; i++) {
-        nlohmann::json raw_result_json;
-        for (size_t j = 0; j < step; j++) {
-            nlohmann::json one_result_json;
-            one_result_json["id"] = std::to_string(result.id_list_.at(i * step + j));
-            one_result_json["distance"] = std::to_string(result.distance_list_.at(i * step + j));
-            raw_result_json.emplace_back(one_result_json);
-        }
-        search_result_json.emplace_back(raw_result_json);
-    }
-    result_json["result"] = search_result_json;
-    result_str = result_json.dump();
 
-    return Status::OK();
+    return status;
 }
 
 Status
@@ -966,6 +1062,63 @@ WebRequestHandler::GetVectorsByIDs(const std::string& collection_name, const std
 }
 
 ////////////////////////////////// Router methods ////////////////////////////////////////////
+StatusDto::ObjectWrapper
+WebRequestHandler::GetState(OString& response_str) {
+    auto& stats = ContentionStats::GetInstance();
+
+    nlohmann::json locks_json = nlohmann::json::object();
+    for (auto& lock : stats.Locks()) {
+        nlohmann::json lock_json;
+        lock_json["acquisitions"] = lock.acquisitions_;
+        lock_json["contended"] = lock.contended_;
+        lock_json["wait_us"] = lock.wait_us_;
+        lock_json["hold_us"] = lock.hold_us_;
+        lock_json["max_wait_us"] = lock.max_wait_us_;
+        locks_json[lock.name_] = lock_json;
+    }
+
+    nlohmann::json queues_json = nlohmann::json::object();
+    for (auto& queue : stats.QueueDepths()) {
+        queues_json[queue.name_] = queue.depth_;
+    }
+
+    nlohmann::json result_json;
+    result_json["code"] = StatusCode::SUCCESS;
+    result_json["message"] = "Success";
+    result_json["locks"] = locks_json;
+    result_json["queues"] = queues_json;
+    response_str = result_json.dump().c_str();
+
+    RETURN_STATUS_DTO(SUCCESS, "Success");
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::GetProfile(const OString& type, const OQueryParams& query_params, OString& response_str) {
+    std::string profile;
+    Status status;
+    if (type->equals("cpu")) {
+        int64_t seconds = 30;
+        status = ParseQueryInteger(query_params, "seconds", seconds);
+        if (!status.ok()) {
+            RETURN_STATUS_DTO(status.code(), status.message().c_str());
+        }
+        if (seconds < 1 || seconds > 600) {
+            RETURN_STATUS_DTO(ILLEGAL_QUERY_PARAM, "Query param 'seconds' should be in range [1, 600]");
+        }
+        status = Profiler::GetInstance().CpuProfile(seconds, profile);
+    } else if (type->equals("heap")) {
+        status = Profiler::GetInstance().HeapProfile(profile);
+    } else {
+        RETURN_STATUS_DTO(UNKNOWN_PATH, ("Unknown path: /profile/" + type->std_str()).c_str());
+    }
+
+    if (status.ok()) {
+        response_str = OString(profile.data(), profile.size(), true);
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status);
+}
+
 StatusDto::ObjectWrapper
 WebRequestHandler::GetDevices(DevicesDto::ObjectWrapper& devices_dto) {
     auto system_info = SystemInfo::GetInstance();
@@ -1679,16 +1832,31 @@ WebRequestHandler::Insert(const OString& collection_name, const OString& body, V
         RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'vectors\' is required");
     }
     engine::VectorsData vectors;
-    CopyRecordsFromJson(body_json["vectors"], vectors, bin_flag);
+    status = CopyRecordsFromJson(body_json["vectors"], vectors, bin_flag);
     if (!status.ok()) {
         ASSIGN_RETURN_STATUS_DTO(status)
     }
 
-    // step 2: copy id array
-    if (body_json.contains("ids")) {
-        auto& ids_json = body_json["ids"];
+    // step 2: insert with the ids and partition tag of the body
+    status = InsertVectors(collection_name->std_str(), body_json, vectors);
+    if (status.ok()) {
+        ids_dto->ids = ids_dto->ids->createShared();
+        for (auto& id : vectors.id_array_) {
+            ids_dto->ids->pushBack(std::to_string(id).c_str());
+        }
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+Status
+WebRequestHandler::InsertVectors(const std::string& collection_name, const nlohmann::json& json,
+                                 engine::VectorsData& vectors) {
+    // step 1: copy id array
+    if (json.contains("ids")) {
+        auto& ids_json = json["ids"];
         if (!ids_json.is_array()) {
-            RETURN_STATUS_DTO(ILLEGAL_BODY, "Field \"ids\" must be a array");
+            return Status(ILLEGAL_BODY, "Field \"ids\" must be a array");
         }
         auto& id_array = vectors.id_array_;
         id_array.clear();
@@ -1698,24 +1866,88 @@ WebRequestHandler::Insert(const OString& collection_name, const OString& body, V
                 id_array.emplace_back(id);
             }
         } catch (std::exception& e) {
-            std::string err_msg = std::string("Cannot convert vectors id. details: ") + e.what();
-            RETURN_STATUS_DTO(SERVER_UNEXPECTED_ERROR, err_msg.c_str());
+            return Status(SERVER_UNEXPECTED_ERROR, std::string("Cannot convert vectors id. details: ") + e.what());
         }
     }
 
-    // step 3: copy partition tag
+    // step 2: copy partition tag
     std::string tag;
-    if (body_json.contains("partition_tag")) {
-        tag = body_json["partition_tag"];
+    if (json.contains("partition_tag")) {
+        tag = json["partition_tag"];
     }
 
-    // step 4: construct result
-    status = request_handler_.Insert(context_ptr_, collection_name->std_str(), vectors, tag);
-    if (status.ok()) {
-        ids_dto->ids = ids_dto->ids->createShared();
-        for (auto& id : vectors.id_array_) {
-            ids_dto->ids->pushBack(std::to_string(id).c_str());
+    // step 3: insert
+    return request_handler_.Insert(context_ptr_, collection_name, vectors, tag);
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::InsertBinary(const OString& collection_name, const OString& body, OString& response) {
+    auto status = Status::OK();
+    try {
+        nlohmann::json header;
+        const char* data = nullptr;
+        size_t size = 0;
+        status = SplitBinaryBody(body, header, data, size);
+
+        engine::VectorsData vectors;
+        if (status.ok()) {
+            status = CopyRecordsFromBinary(collection_name->std_str(), data, size, vectors);
+        }
+        if (status.ok()) {
+            status = InsertVectors(collection_name->std_str(), header, vectors);
+        }
+        if (status.ok()) {
+            response = OString(reinterpret_cast<const char*>(vectors.id_array_.data()),
+                               vectors.id_array_.size() * sizeof(int64_t), true);
+        }
+    } catch (nlohmann::detail::exception& e) {
+        std::string emsg = "json error: code=" + std::to_string(e.id) + ", reason=" + e.what();
+        RETURN_STATUS_DTO(BODY_PARSE_FAIL, emsg.c_str());
+    } catch (std::exception& e) {
+        RETURN_STATUS_DTO(SERVER_UNEXPECTED_ERROR, e.what());
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::VectorsOpBinary(const OString& collection_name, const OString& body, OString& response) {
+    auto status = Status::OK();
+    try {
+        nlohmann::json header;
+        const char* data = nullptr;
+        size_t size = 0;
+        status = SplitBinaryBody(body, header, data, size);
+        if (status.ok() && !header.contains("search")) {
+            status = Status(ILLEGAL_BODY, "Only search takes a binary body");
         }
+
+        engine::VectorsData vectors;
+        if (status.ok()) {
+            status = CopyRecordsFromBinary(collection_name->std_str(), data, size, vectors);
+        }
+        TopKQueryResult result;
+        if (status.ok()) {
+            status = SearchResult(collection_name->std_str(), header["search"], &vectors, result);
+        }
+        if (status.ok()) {
+            int64_t shape[2] = {result.row_num_, result.row_num_ > 0
+                                                     ? static_cast<int64_t>(result.id_list_.size()) / result.row_num_
+                                                     : 0};
+            std::string result_str;
+            result_str.reserve(sizeof(shape) + result.id_list_.size() * (sizeof(int64_t) + sizeof(float)));
+            result_str.append(reinterpret_cast<const char*>(shape), sizeof(shape));
+            result_str.append(reinterpret_cast<const char*>(result.id_list_.data()),
+                              result.id_list_.size() * sizeof(int64_t));
+            result_str.append(reinterpret_cast<const char*>(result.distance_list_.data()),
+                              result.distance_list_.size() * sizeof(float));
+            response = OString(result_str.data(), result_str.size(), true);
+        }
+    } catch (nlohmann::detail::exception& e) {
+        std::string emsg = "json error: code=" + std::to_string(e.id) + ", reason=" + e.what();
+        RETURN_STATUS_DTO(BODY_PARSE_FAIL, emsg.c_str());
+    } catch (std::exception& e) {
+        RETURN_STATUS_DTO(SERVER_UNEXPECTED_ERROR, e.what());
     }
 
     ASSIGN_RETURN_STATUS_DTO(status)
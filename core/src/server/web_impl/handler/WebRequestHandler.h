@@ -87,6 +87,15 @@ class WebRequestHandler {
     Status
     CopyRecordsFromJson(const nlohmann::json& json, engine::VectorsData& vectors, bool bin);
 
+    // the raw vectors of a binary body, as many as the payload holds for the collection dimension
+    Status
+    CopyRecordsFromBinary(const std::string& collection_name, const char* data, size_t size,
+                          engine::VectorsData& vectors);
+
+    // a binary body is a little-endian uint32 header size, the json header, then the raw vectors
+    Status
+    SplitBinaryBody(const OString& body, nlohmann::json& header, const char*& data, size_t& size);
+
  protected:
     Status
     GetCollectionMetaInfo(const std::string& collection_name, nlohmann::json& json_out);
@@ -126,6 +135,14 @@ class WebRequestHandler {
     Status
     Search(const std::string& collection_name, const nlohmann::json& json, std::string& result_str);
 
+    // raw_vectors, when not null, are searched instead of the field "vectors" of json
+    Status
+    SearchResult(const std::string& collection_name, const nlohmann::json& json, engine::VectorsData* raw_vectors,
+                 TopKQueryResult& result);
+
+    Status
+    InsertVectors(const std::string& collection_name, const nlohmann::json& json, engine::VectorsData& vectors);
+
     Status
     ProcessLeafQueryJson(const nlohmann::json& json, query::BooleanQueryPtr& boolean_query);
 
@@ -151,6 +168,14 @@ class WebRequestHandler {
     }
 
  public:
+    // lock contention and queue depths of ContentionStats
+    StatusDto::ObjectWrapper
+    GetState(OString& response_str);
+
+    // pprof profile of type cpu, taken for the seconds query param, or heap
+    StatusDto::ObjectWrapper
+    GetProfile(const OString& type, const OQueryParams& query_params, OString& response_str);
+
     StatusDto::ObjectWrapper
     GetDevices(DevicesDto::ObjectWrapper& devices);
 
@@ -219,6 +244,10 @@ class WebRequestHandler {
     StatusDto::ObjectWrapper
     Insert(const OString& collection_name, const OString& body, VectorIdsDto::ObjectWrapper& ids_dto);
 
+    // application/octet-stream insert, the response is the raw int64 ids
+    StatusDto::ObjectWrapper
+    InsertBinary(const OString& collection_name, const OString& body, OString& response);
+
     StatusDto::ObjectWrapper
     InsertEntity(const OString& collection_name, const OString& body, VectorIdsDto::ObjectWrapper& ids_dto);
 
@@ -231,6 +260,10 @@ class WebRequestHandler {
     StatusDto::ObjectWrapper
     VectorsOp(const OString& collection_name, const OString& payload, OString& response);
 
+    // application/octet-stream search, the response is the int64 nq and topk, the ids then the float distances
+    StatusDto::ObjectWrapper
+    VectorsOpBinary(const OString& collection_name, const OString& body, OString& response);
+
     /**
      *
      * System
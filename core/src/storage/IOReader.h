@@ -11,12 +11,32 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace storage {
 
+// expected access pattern of a mapped range, passed to the kernel as madvise
+enum class MmapAdvice {
+    NORMAL,
+    SEQUENTIAL,
+    RANDOM,
+};
+
+// read size bytes from pos of the file into ptr
+struct ReadRequest {
+    ReadRequest(void* ptr, int64_t pos, int64_t size) : ptr_(ptr), pos_(pos), size_(size) {
+    }
+    void* ptr_;
+    int64_t pos_;
+    int64_t size_;
+};
+
+using ReadRequests = std::vector<ReadRequest>;
+
 class IOReader {
  public:
     virtual bool
@@ -33,6 +53,34 @@ class IOReader {
 
     virtual void
     close() = 0;
+
+    // positional read, it is not affected by and doesn't move the position of seekg()
+    virtual void
+    pread(void* ptr, int64_t size, int64_t pos) {
+        seekg(pos);
+        read(ptr, size);
+    }
+
+    // serve several reads at once, the backend is free to reorder, merge or issue them concurrently
+    virtual void
+    preadv(const ReadRequests& requests) {
+        for (auto& request : requests) {
+            pread(request.ptr_, request.size_, request.pos_);
+        }
+    }
+
+    // hint that [pos, pos + size) of the opened file will be read soon
+    virtual void
+    readahead(int64_t pos, int64_t size) {
+    }
+
+    // map size bytes from pos of the opened file into memory without copying, the range stays valid after
+    // close() until the returned pointer is released
+    // return nullptr if the backend can't map files, the caller should read() instead
+    virtual std::shared_ptr<uint8_t[]>
+    mmap(int64_t pos, int64_t size, MmapAdvice advice) {
+        return nullptr;
+    }
 };
 
 using IOReaderPtr = std::shared_ptr<IOReader>;
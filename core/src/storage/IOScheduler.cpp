@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/IOScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace milvus {
+namespace storage {
+
+namespace {
+thread_local IOClass current_class = IOClass::FOREGROUND;
+
+constexpr double MB = 1024.0 * 1024.0;
+
+// the background rate doesn't drop below the max rate divided by this, a merge still ends
+constexpr double MIN_RATE_DIVISOR = 64.0;
+}  // namespace
+
+void
+IOScheduler::Configure(int64_t max_rate, double latency_target_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_rate_ = std::max<int64_t>(max_rate, 0);
+    latency_target_ms_ = std::max(latency_target_ms, 0.0);
+    rate_ = max_rate_;
+    tokens_ = 0;
+    last_refill_ = last_adjust_ = std::chrono::steady_clock::now();
+    read_ms_ = read_mb_ = 0;
+    enabled_ = max_rate_ > 0;
+}
+
+IOClass
+IOScheduler::CurrentClass() {
+    return current_class;
+}
+
+void
+IOScheduler::Acquire(int64_t bytes) {
+    if (!enabled_ || bytes <= 0 || current_class != IOClass::BACKGROUND) {
+        return;
+    }
+
+    double wait_seconds = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Update(std::chrono::steady_clock::now());
+        // the bytes are taken at once, a debt is waited off before the io, so the next caller waits after it
+        tokens_ -= bytes;
+        if (tokens_ < 0) {
+            wait_seconds = -tokens_ / rate_;
+        }
+    }
+    if (wait_seconds > 0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait_seconds));
+    }
+}
+
+void
+IOScheduler::RecordRead(int64_t bytes, std::chrono::steady_clock::duration elapsed) {
+    if (!enabled_ || current_class != IOClass::FOREGROUND) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    read_ms_ += std::chrono::duration<double, std::milli>(elapsed).count();
+    // a smaller read counts as one MB, its time is mostly the seek
+    read_mb_ += std::max(bytes / MB, 1.0);
+}
+
+int64_t
+IOScheduler::BackgroundRate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_ ? static_cast<int64_t>(rate_) : 0;
+}
+
+void
+IOScheduler::Update(std::chrono::steady_clock::time_point now) {
+    // a burst is at most an interval of io
+    double burst = rate_ * std::chrono::duration<double>(ADJUST_INTERVAL).count();
+    tokens_ = std::min(tokens_ + rate_ * std::chrono::duration<double>(now - last_refill_).count(), burst);
+    last_refill_ = now;
+
+    if (now - last_adjust_ < ADJUST_INTERVAL) {
+        return;
+    }
+    if (latency_target_ms_ > 0 && read_mb_ > 0 && read_ms_ / read_mb_ > latency_target_ms_) {
+        rate_ = std::max(rate_ / 2, max_rate_ / MIN_RATE_DIVISOR);
+    } else {
+        rate_ = std::min(rate_ + max_rate_ / 10.0, static_cast<double>(max_rate_));
+    }
+    read_ms_ = read_mb_ = 0;
+    last_adjust_ = now;
+}
+
+IOClassGuard::IOClassGuard(IOClass io_class) : previous_class_(current_class) {
+    current_class = io_class;
+}
+
+IOClassGuard::~IOClassGuard() {
+    current_class = previous_class_;
+}
+
+}  // namespace storage
+}  // namespace milvus
@@ -0,0 +1,104 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace milvus {
+namespace storage {
+
+enum class IOClass {
+    FOREGROUND,  // searches and the loads they wait for
+    BACKGROUND,  // merge, index build, compaction and file gc
+};
+
+/*
+ * Paces the disk io of the background class with a token bucket so that a merge or an index build doesn't saturate
+ * the disk under the searches. The foreground io is never delayed, its read latency per MB is averaged instead, and
+ * every ADJUST_INTERVAL the background rate is halved when the average exceeds the target, or raised by a tenth of
+ * the max rate otherwise, so the background takes the bandwidth the searches leave. The io class is a property of
+ * the calling thread, set by IOClassGuard.
+ */
+class IOScheduler {
+ public:
+    static constexpr std::chrono::milliseconds ADJUST_INTERVAL{100};
+    // the bytes a file system metadata update, as an unlink, is charged
+    static constexpr int64_t METADATA_IO_BYTES = 64 * 1024;
+
+    static IOScheduler&
+    GetInstance() {
+        static IOScheduler instance;
+        return instance;
+    }
+
+    // max_rate: background bytes per second when the foreground is idle, 0 for no limit
+    // latency_target_ms: foreground read time per MB above which the background backs off, 0 keeps the max rate
+    void
+    Configure(int64_t max_rate, double latency_target_ms);
+
+    static IOClass
+    CurrentClass();
+
+    // called before the io of the calling thread, waits for the tokens of a background io
+    void
+    Acquire(int64_t bytes);
+
+    // called after a foreground read
+    void
+    RecordRead(int64_t bytes, std::chrono::steady_clock::duration elapsed);
+
+    // bytes per second the background io is paced at, 0 for no limit
+    int64_t
+    BackgroundRate();
+
+ private:
+    // refills the bucket and adjusts the rate, under mutex_
+    void
+    Update(std::chrono::steady_clock::time_point now);
+
+ private:
+    std::atomic<bool> enabled_{false};
+
+    std::mutex mutex_;
+    int64_t max_rate_ = 0;
+    double latency_target_ms_ = 0;
+    double rate_ = 0;
+    double tokens_ = 0;
+    std::chrono::steady_clock::time_point last_refill_;
+    std::chrono::steady_clock::time_point last_adjust_;
+
+    // foreground reads since the last adjustment
+    double read_ms_ = 0;
+    double read_mb_ = 0;
+};
+
+// runs the io of the calling thread in an io class for its lifetime
+class IOClassGuard {
+ public:
+    explicit IOClassGuard(IOClass io_class);
+
+    IOClassGuard(const IOClassGuard&) = delete;
+
+    IOClassGuard&
+    operator=(const IOClassGuard&) = delete;
+
+    ~IOClassGuard();
+
+ private:
+    IOClass previous_class_;
+};
+
+}  // namespace storage
+}  // namespace milvus
@@ -11,19 +11,46 @@
 
 #include "storage/disk/DiskIOReader.h"
 
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "storage/IOScheduler.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
 namespace milvus {
 namespace storage {
 
+DiskIOReader::~DiskIOReader() {
+    close();
+}
+
 bool
 DiskIOReader::open(const std::string& name) {
+    close();
     name_ = name;
     fs_ = std::fstream(name_, std::ios::in | std::ios::binary);
+    if (fs_.good()) {
+        fd_ = ::open(name_.c_str(), O_RDONLY);
+    }
     return fs_.good();
 }
 
 void
 DiskIOReader::read(void* ptr, int64_t size) {
+    auto& io_scheduler = IOScheduler::GetInstance();
+    io_scheduler.Acquire(size);
+    auto start = std::chrono::steady_clock::now();
     fs_.read(reinterpret_cast<char*>(ptr), size);
+    io_scheduler.RecordRead(size, std::chrono::steady_clock::now() - start);
 }
 
 void
@@ -42,6 +69,142 @@ DiskIOReader::length() {
 void
 DiskIOReader::close() {
     fs_.close();
+    if (fd_ != -1) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void
+DiskIOReader::pread(void* ptr, int64_t size, int64_t pos) {
+    if (fd_ == -1) {
+        IOReader::pread(ptr, size, pos);
+        return;
+    }
+
+    auto& io_scheduler = IOScheduler::GetInstance();
+    io_scheduler.Acquire(size);
+    auto start = std::chrono::steady_clock::now();
+    int64_t total = size;
+
+    auto buf = static_cast<char*>(ptr);
+    while (size > 0) {
+        auto n = ::pread(fd_, buf, size, pos);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            std::string err_msg = "Failed to read " + std::to_string(size) + " bytes at " + std::to_string(pos) +
+                                  " of " + name_ + ", error: " + (n < 0 ? std::strerror(errno) : "end of file");
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        }
+        buf += n;
+        pos += n;
+        size -= n;
+    }
+    io_scheduler.RecordRead(total, std::chrono::steady_clock::now() - start);
+}
+
+void
+DiskIOReader::preadv(const ReadRequests& requests) {
+    if (fd_ == -1) {
+        IOReader::preadv(requests);
+        return;
+    }
+
+    std::vector<const ReadRequest*> sorted;
+    for (auto& request : requests) {
+        if (request.size_ > 0) {
+            sorted.push_back(&request);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const ReadRequest* a, const ReadRequest* b) { return a->pos_ < b->pos_; });
+
+    // let the kernel start the io of all ranges before waiting for the first one
+    for (auto request : sorted) {
+        readahead(request->pos_, request->size_);
+    }
+
+    // adjacent ranges are read by one system call
+    size_t i = 0;
+    while (i < sorted.size()) {
+        size_t begin = i;
+        int64_t pos = sorted[i]->pos_;
+        int64_t end = pos;
+        std::vector<struct iovec> iov;
+        while (i < sorted.size() && sorted[i]->pos_ == end && iov.size() < IOV_MAX) {
+            iov.push_back({sorted[i]->ptr_, (size_t)sorted[i]->size_});
+            end += sorted[i]->size_;
+            ++i;
+        }
+
+        auto& io_scheduler = IOScheduler::GetInstance();
+        io_scheduler.Acquire(end - pos);
+        auto start = std::chrono::steady_clock::now();
+        auto n = ::preadv(fd_, iov.data(), iov.size(), pos);
+        io_scheduler.RecordRead(std::max<int64_t>(n, 0), std::chrono::steady_clock::now() - start);
+        if (n != end - pos) {
+            // interrupted or short read, fall back to read the ranges one by one
+            for (size_t j = begin; j < i; ++j) {
+                pread(sorted[j]->ptr_, sorted[j]->size_, sorted[j]->pos_);
+            }
+        }
+    }
+}
+
+void
+DiskIOReader::readahead(int64_t pos, int64_t size) {
+    if (fd_ != -1) {
+        ::posix_fadvise(fd_, pos, size, POSIX_FADV_WILLNEED);
+    }
+}
+
+std::shared_ptr<uint8_t[]>
+DiskIOReader::mmap(int64_t pos, int64_t size, MmapAdvice advice) {
+    if (pos < 0 || size <= 0) {
+        return nullptr;
+    }
+
+    int fd = ::open(name_.c_str(), O_RDONLY);
+    if (fd == -1) {
+        LOG_ENGINE_WARNING_ << "Failed to open " << name_ << " for mmap, error: " << std::strerror(errno);
+        return nullptr;
+    }
+
+    // accessing pages beyond the end of file raises SIGBUS
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) == -1 || pos + size > file_stat.st_size) {
+        LOG_ENGINE_WARNING_ << "Invalid mmap range [" << pos << ", " << pos + size << ") of " << name_;
+        ::close(fd);
+        return nullptr;
+    }
+
+    // mmap offset must be page aligned
+    int64_t page_size = sysconf(_SC_PAGESIZE);
+    int64_t aligned_pos = pos / page_size * page_size;
+    size_t map_size = size + (pos - aligned_pos);
+
+    // private mapping, an accidental write goes to a copied page instead of the file
+    void* addr = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, aligned_pos);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        LOG_ENGINE_WARNING_ << "Failed to mmap " << name_ << ", error: " << std::strerror(errno);
+        return nullptr;
+    }
+
+    int flag = MADV_NORMAL;
+    if (advice == MmapAdvice::SEQUENTIAL) {
+        flag = MADV_SEQUENTIAL;
+    } else if (advice == MmapAdvice::RANDOM) {
+        flag = MADV_RANDOM;
+    }
+    ::madvise(addr, map_size, flag);
+
+    std::shared_ptr<uint8_t> mapping(static_cast<uint8_t*>(addr),
+                                     [map_size](uint8_t* ptr) { ::munmap(ptr, map_size); });
+    return std::shared_ptr<uint8_t[]>(mapping, mapping.get() + (pos - aligned_pos));
 }
 
 }  // namespace storage
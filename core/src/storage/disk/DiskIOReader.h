@@ -22,7 +22,7 @@ namespace storage {
 class DiskIOReader : public IOReader {
  public:
     DiskIOReader() = default;
-    ~DiskIOReader() = default;
+    ~DiskIOReader();
 
     // No copy and move
     DiskIOReader(const DiskIOReader&) = delete;
@@ -48,9 +48,23 @@ class DiskIOReader : public IOReader {
     void
     close() override;
 
+    void
+    pread(void* ptr, int64_t size, int64_t pos) override;
+
+    void
+    preadv(const ReadRequests& requests) override;
+
+    void
+    readahead(int64_t pos, int64_t size) override;
+
+    std::shared_ptr<uint8_t[]>
+    mmap(int64_t pos, int64_t size, MmapAdvice advice) override;
+
  public:
     std::string name_;
     std::fstream fs_;
+    // positional reads go through the file descriptor, bypassing the stream buffer
+    int fd_ = -1;
 };
 
 using DiskIOReaderPtr = std::shared_ptr<DiskIOReader>;
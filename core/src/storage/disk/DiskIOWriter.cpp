@@ -11,6 +11,10 @@
 
 #include "storage/disk/DiskIOWriter.h"
 
+#include <algorithm>
+
+#include "storage/IOScheduler.h"
+
 namespace milvus {
 namespace storage {
 
@@ -24,7 +28,14 @@ DiskIOWriter::open(const std::string& name) {
 
 void
 DiskIOWriter::write(void* ptr, int64_t size) {
-    fs_.write(reinterpret_cast<char*>(ptr), size);
+    // a large write is paced in chunks, not waited off at once
+    auto& io_scheduler = IOScheduler::GetInstance();
+    auto buf = reinterpret_cast<char*>(ptr);
+    for (int64_t offset = 0; offset < size; offset += WRITE_CHUNK_SIZE) {
+        int64_t chunk = std::min(WRITE_CHUNK_SIZE, size - offset);
+        io_scheduler.Acquire(chunk);
+        fs_.write(buf + offset, chunk);
+    }
     len_ += size;
 }
 
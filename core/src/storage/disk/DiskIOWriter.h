@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -21,6 +22,9 @@ namespace storage {
 
 class DiskIOWriter : public IOWriter {
  public:
+    // bytes of a write a background thread takes from the io scheduler at once
+    static constexpr int64_t WRITE_CHUNK_SIZE = 4 * 1024 * 1024;
+
     DiskIOWriter() = default;
     ~DiskIOWriter() = default;
 
@@ -9,7 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
 
 #include <aws/core/Aws.h>
@@ -18,11 +21,17 @@
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 namespace milvus {
 namespace storage {
@@ -54,20 +63,44 @@ class S3ClientMock : public Aws::S3::S3Client {
     PutObject(const Aws::S3::Model::PutObjectRequest& request) const override {
         Aws::String key = request.GetKey();
         std::shared_ptr<Aws::IOStream> body = request.GetBody();
+        std::lock_guard<std::mutex> lock(mutex_);
         aws_map_[key] = body;
 
         Aws::S3::Model::PutObjectResult result;
         return Aws::S3::Model::PutObjectOutcome(std::move(result));
     }
 
+    Aws::S3::Model::HeadObjectOutcome
+    HeadObject(const Aws::S3::Model::HeadObjectRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = aws_map_.find(request.GetKey());
+        if (iter == aws_map_.end()) {
+            return Aws::S3::Model::HeadObjectOutcome();
+        }
+
+        Aws::String body_str = ReadBody(iter->second);
+        Aws::S3::Model::HeadObjectResult result;
+        result.SetContentLength(body_str.length());
+        result.SetETag("\"" + std::to_string(std::hash<Aws::String>()(body_str)) + "\"");
+        return Aws::S3::Model::HeadObjectOutcome(std::move(result));
+    }
+
     Aws::S3::Model::GetObjectOutcome
     GetObject(const Aws::S3::Model::GetObjectRequest& request) const override {
         auto factory = request.GetResponseStreamFactory();
         Aws::Utils::Stream::ResponseStream resp_stream(factory);
 
         try {
+            std::lock_guard<std::mutex> lock(mutex_);
             std::shared_ptr<Aws::IOStream> body = aws_map_.at(request.GetKey());
-            Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+            Aws::String body_str = ReadBody(body);
+
+            // only "bytes=first-last" ranges are supported
+            if (request.RangeHasBeenSet()) {
+                int64_t first = 0, last = 0;
+                sscanf(request.GetRange().c_str(), "bytes=%ld-%ld", &first, &last);
+                body_str = body_str.substr(first, last - first + 1);
+            }
 
             resp_stream.GetUnderlyingStream().write(body_str.c_str(), body_str.length());
             resp_stream.GetUnderlyingStream().flush();
@@ -81,6 +114,69 @@ class S3ClientMock : public Aws::S3::S3Client {
         }
     }
 
+    Aws::S3::Model::CreateMultipartUploadOutcome
+    CreateMultipartUpload(const Aws::S3::Model::CreateMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Aws::String upload_id = request.GetKey() + "_" + std::to_string(++upload_seq_);
+        uploads_[upload_id].clear();
+
+        Aws::S3::Model::CreateMultipartUploadResult result;
+        result.SetUploadId(upload_id);
+        return Aws::S3::Model::CreateMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::UploadPartOutcome
+    UploadPart(const Aws::S3::Model::UploadPartRequest& request) const override {
+        Aws::String body_str = ReadBody(request.GetBody());
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = uploads_.find(request.GetUploadId());
+        if (iter == uploads_.end()) {
+            return Aws::S3::Model::UploadPartOutcome();
+        }
+        iter->second[request.GetPartNumber()] = body_str;
+
+        Aws::S3::Model::UploadPartResult result;
+        result.SetETag("\"" + std::to_string(std::hash<Aws::String>()(body_str)) + "\"");
+        return Aws::S3::Model::UploadPartOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadOutcome
+    CompleteMultipartUpload(const Aws::S3::Model::CompleteMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = uploads_.find(request.GetUploadId());
+        if (iter == uploads_.end()) {
+            return Aws::S3::Model::CompleteMultipartUploadOutcome();
+        }
+
+        // parts are concatenated in the order of the request, they must match the uploaded ones
+        Aws::String body_str;
+        for (auto& part : request.GetMultipartUpload().GetParts()) {
+            auto uploaded = iter->second.find(part.GetPartNumber());
+            if (uploaded == iter->second.end() ||
+                part.GetETag() != "\"" + std::to_string(std::hash<Aws::String>()(uploaded->second)) + "\"") {
+                return Aws::S3::Model::CompleteMultipartUploadOutcome();
+            }
+            body_str += uploaded->second;
+        }
+        uploads_.erase(iter);
+
+        auto body = Aws::MakeShared<Aws::StringStream>("");
+        body->write(body_str.data(), body_str.length());
+        aws_map_[request.GetKey()] = body;
+
+        Aws::S3::Model::CompleteMultipartUploadResult result;
+        return Aws::S3::Model::CompleteMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::AbortMultipartUploadOutcome
+    AbortMultipartUpload(const Aws::S3::Model::AbortMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uploads_.erase(request.GetUploadId());
+
+        Aws::S3::Model::AbortMultipartUploadResult result;
+        return Aws::S3::Model::AbortMultipartUploadOutcome(std::move(result));
+    }
+
     Aws::S3::Model::ListObjectsOutcome
     ListObjects(const Aws::S3::Model::ListObjectsRequest& request) const override {
         /* TODO: add object key list into ListObjectsOutcome */
@@ -92,13 +188,36 @@ class S3ClientMock : public Aws::S3::S3Client {
     Aws::S3::Model::DeleteObjectOutcome
     DeleteObject(const Aws::S3::Model::DeleteObjectRequest& request) const override {
         Aws::String key = request.GetKey();
+        std::lock_guard<std::mutex> lock(mutex_);
         aws_map_.erase(key);
         Aws::S3::Model::DeleteObjectResult result;
         Aws::S3::Model::DeleteObjectOutcome(std::move(result));
         return result;
     }
 
+    Aws::S3::Model::DeleteObjectsOutcome
+    DeleteObjects(const Aws::S3::Model::DeleteObjectsRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& object : request.GetDelete().GetObjects()) {
+            aws_map_.erase(object.GetKey());
+        }
+        Aws::S3::Model::DeleteObjectsResult result;
+        return Aws::S3::Model::DeleteObjectsOutcome(std::move(result));
+    }
+
+    // the body may be read many times
+    static Aws::String
+    ReadBody(const std::shared_ptr<Aws::IOStream>& body) {
+        body->clear();
+        body->seekg(0);
+        return Aws::String((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+    }
+
     mutable Aws::Map<Aws::String, std::shared_ptr<Aws::IOStream>> aws_map_;
+    // upload id -> (part number -> part)
+    mutable Aws::Map<Aws::String, std::map<int, Aws::String>> uploads_;
+    mutable int64_t upload_seq_ = 0;
+    mutable std::mutex mutex_;
 };
 
 }  // namespace storage
@@ -10,17 +10,29 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "config/Config.h"
 #include "storage/s3/S3ClientMock.h"
@@ -261,6 +273,285 @@ S3ClientWrapper::DeleteObject(const std::string& object_name) {
     return Status::OK();
 }
 
+Status
+S3ClientWrapper::HeadObject(const std::string& object_name, int64_t& size, std::string& etag) {
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->HeadObject(request);
+
+    fiu_do_on("S3ClientWrapper.HeadObject.outcome.fail", outcome = Aws::S3::Model::HeadObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: HeadObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    size = outcome.GetResult().GetContentLength();
+    etag = outcome.GetResult().GetETag();
+    // the ETag is returned quoted
+    etag.erase(std::remove(etag.begin(), etag.end(), '"'), etag.end());
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRange(const std::string& object_name, int64_t offset, int64_t size, char* buffer) {
+    Aws::S3::Model::GetObjectRequest request;
+    std::string range = "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + size - 1);
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithRange(range);
+
+    auto outcome = client_ptr_->GetObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectRange.outcome.fail", outcome = Aws::S3::Model::GetObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: GetObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    auto& retrieved_file = outcome.GetResultWithOwnership().GetBody();
+    retrieved_file.read(buffer, size);
+    if (retrieved_file.gcount() != size) {
+        std::string str = "Incomplete range " + range + " of object '" + object_name + "'";
+        LOG_STORAGE_ERROR_ << "ERROR: " << str;
+        return Status(SERVER_UNEXPECTED_ERROR, str);
+    }
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectParallel(const std::string& object_name, std::string& content) {
+    int64_t size = 0;
+    std::string etag;
+    auto status = HeadObject(object_name, size, etag);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // the ETag changes whenever the object is rewritten, so a cached copy is never stale
+    std::string cache_file;
+    if (!cache_path_.empty() && !etag.empty()) {
+        cache_file = CacheFilePath(object_name, etag);
+        if (ReadCacheFile(cache_file, size, content)) {
+            LOG_STORAGE_DEBUG_ << "GetObjectParallel '" << object_name << "' from local cache";
+            return Status::OK();
+        }
+    }
+
+    status = DownloadObject(object_name, size, content);
+    if (!status.ok()) {
+        return status;
+    }
+
+    if (!cache_file.empty()) {
+        WriteCacheFile(cache_file, content);
+    }
+
+    LOG_STORAGE_DEBUG_ << "GetObjectParallel '" << object_name << "' successfully!";
+    return Status::OK();
+}
+
+void
+S3ClientWrapper::SetDownloadOptions(int64_t part_size, int64_t concurrency, const std::string& cache_path) {
+    part_size_ = std::max(part_size, (int64_t)1);
+    concurrency_ = std::max(concurrency, (int64_t)1);
+    cache_path_ = cache_path;
+}
+
+Status
+S3ClientWrapper::DownloadObject(const std::string& object_name, int64_t size, std::string& content) {
+    content.resize(size);
+    if (size == 0) {
+        return Status::OK();
+    }
+
+    int64_t part_num = (size + part_size_ - 1) / part_size_;
+    int64_t thread_num = std::min(part_num, concurrency_);
+
+    std::atomic<int64_t> next_part(0);
+    std::mutex status_mutex;
+    Status status = Status::OK();
+    auto download = [&]() {
+        while (true) {
+            int64_t part = next_part++;
+            if (part >= part_num) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(status_mutex);
+                if (!status.ok()) {
+                    return;
+                }
+            }
+
+            int64_t offset = part * part_size_;
+            int64_t part_size = std::min(part_size_, size - offset);
+            auto part_status = GetObjectRange(object_name, offset, part_size, &content[offset]);
+            if (!part_status.ok()) {
+                std::lock_guard<std::mutex> lock(status_mutex);
+                status = part_status;
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int64_t i = 1; i < thread_num; ++i) {
+        threads.emplace_back(download);
+    }
+    download();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return status;
+}
+
+std::string
+S3ClientWrapper::CacheFilePath(const std::string& object_name, const std::string& etag) {
+    return cache_path_ + "/" + object_name + "." + etag;
+}
+
+bool
+S3ClientWrapper::ReadCacheFile(const std::string& file_path, int64_t size, std::string& content) {
+    boost::system::error_code err;
+    if (!boost::filesystem::exists(file_path, err) || (int64_t)boost::filesystem::file_size(file_path, err) != size) {
+        return false;
+    }
+
+    std::ifstream cache_file(file_path, std::ios::binary);
+    content.resize(size);
+    cache_file.read(&content[0], size);
+    return cache_file.gcount() == size;
+}
+
+void
+S3ClientWrapper::WriteCacheFile(const std::string& file_path, const std::string& content) {
+    boost::filesystem::path path(file_path);
+    boost::system::error_code err;
+    boost::filesystem::create_directories(path.parent_path(), err);
+
+    // copies of older versions of the object are useless from now on
+    std::string prefix = path.stem().string() + ".";
+    for (boost::filesystem::directory_iterator it(path.parent_path(), err), end; !err && it != end; ++it) {
+        auto name = it->path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) == 0 && name.find('.', prefix.size()) == std::string::npos &&
+            it->path() != path) {
+            boost::filesystem::remove(it->path(), err);
+        }
+    }
+
+    // written to a temp file first, a partial file must never be taken as a cached copy
+    std::string temp_path = file_path + ".tmp";
+    {
+        std::ofstream cache_file(temp_path, std::ios::binary | std::ios::trunc);
+        cache_file.write(content.data(), content.size());
+        if (!cache_file.good()) {
+            LOG_STORAGE_WARNING_ << "Failed to write s3 cache file " << temp_path;
+            cache_file.close();
+            boost::filesystem::remove(temp_path, err);
+            return;
+        }
+    }
+    boost::filesystem::rename(temp_path, file_path, err);
+    if (err) {
+        LOG_STORAGE_WARNING_ << "Failed to write s3 cache file " << file_path << ": " << err.message();
+    }
+}
+
+Status
+S3ClientWrapper::CreateMultipartUpload(const std::string& object_name, std::string& upload_id) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->CreateMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CreateMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CreateMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: CreateMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    upload_id = outcome.GetResult().GetUploadId();
+    LOG_STORAGE_DEBUG_ << "CreateMultipartUpload '" << object_name << "' successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::UploadPart(const std::string& object_name, const std::string& upload_id, int64_t part_number,
+                            const std::string& content, std::string& etag) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id).WithPartNumber(part_number);
+
+    const std::shared_ptr<Aws::IOStream> input_data = Aws::MakeShared<Aws::StringStream>("");
+    input_data->write(content.data(), content.length());
+    request.SetBody(input_data);
+    request.SetContentLength(content.length());
+
+    auto outcome = client_ptr_->UploadPart(request);
+
+    fiu_do_on("S3ClientWrapper.UploadPart.outcome.fail", outcome = Aws::S3::Model::UploadPartOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: UploadPart: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    etag = outcome.GetResult().GetETag();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::CompleteMultipartUpload(const std::string& object_name, const std::string& upload_id,
+                                         const std::vector<std::string>& etags) {
+    Aws::S3::Model::CompletedMultipartUpload upload;
+    for (size_t i = 0; i < etags.size(); ++i) {
+        upload.AddParts(Aws::S3::Model::CompletedPart().WithETag(etags[i]).WithPartNumber(i + 1));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id).WithMultipartUpload(upload);
+
+    auto outcome = client_ptr_->CompleteMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CompleteMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CompleteMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: CompleteMultipartUpload: " << err.GetExceptionName() << ": "
+                           << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    LOG_STORAGE_DEBUG_ << "CompleteMultipartUpload '" << object_name << "' with " << etags.size()
+                       << " parts successfully!";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::AbortMultipartUpload(const std::string& object_name, const std::string& upload_id) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+
+    auto outcome = client_ptr_->AbortMultipartUpload(request);
+
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: AbortMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    LOG_STORAGE_DEBUG_ << "AbortMultipartUpload '" << object_name << "' successfully!";
+    return Status::OK();
+}
+
+void
+S3ClientWrapper::SetUploadOptions(int64_t part_size, int64_t concurrency) {
+    upload_part_size_ = std::max(part_size, S3_UPLOAD_PART_SIZE_MIN);
+    upload_concurrency_ = std::max(concurrency, (int64_t)1);
+}
+
 Status
 S3ClientWrapper::DeleteObjects(const std::string& marker) {
     std::vector<std::string> object_list;
@@ -270,13 +561,42 @@ S3ClientWrapper::DeleteObjects(const std::string& marker) {
         return stat;
     }
 
-    for (std::string& obj_name : object_list) {
-        stat = DeleteObject(obj_name);
-        if (!stat.ok()) {
-            return stat;
+    return DeleteObjects(object_list);
+}
+
+Status
+S3ClientWrapper::DeleteObjects(const std::vector<std::string>& object_keys) {
+    for (size_t from = 0; from < object_keys.size(); from += S3_DELETE_BATCH) {
+        size_t to = std::min(object_keys.size(), from + S3_DELETE_BATCH);
+        Aws::S3::Model::Delete del;
+        for (size_t i = from; i < to; ++i) {
+            del.AddObjects(Aws::S3::Model::ObjectIdentifier().WithKey(object_keys[i].c_str()));
+        }
+        del.SetQuiet(true);
+
+        Aws::S3::Model::DeleteObjectsRequest request;
+        request.WithBucket(s3_bucket_).WithDelete(std::move(del));
+
+        auto outcome = client_ptr_->DeleteObjects(request);
+
+        fiu_do_on("S3ClientWrapper.DeleteObjects.outcome.fail", outcome = Aws::S3::Model::DeleteObjectsOutcome());
+        if (!outcome.IsSuccess()) {
+            auto err = outcome.GetError();
+            LOG_STORAGE_ERROR_ << "ERROR: DeleteObjects: " << err.GetExceptionName() << ": " << err.GetMessage();
+            return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+        }
+
+        // a quiet delete reports the failed keys only
+        auto& errors = outcome.GetResult().GetErrors();
+        if (!errors.empty()) {
+            auto& err = errors.front();
+            LOG_STORAGE_ERROR_ << "ERROR: DeleteObjects: " << errors.size() << " keys failed, " << err.GetKey()
+                               << ": " << err.GetMessage();
+            return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage().c_str());
         }
     }
 
+    LOG_STORAGE_DEBUG_ << "DeleteObjects " << object_keys.size() << " objects successfully!";
     return Status::OK();
 }
 
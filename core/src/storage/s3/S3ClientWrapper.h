@@ -22,6 +22,15 @@
 namespace milvus {
 namespace storage {
 
+constexpr int64_t S3_DOWNLOAD_PART_SIZE_DEFAULT = 8 * 1024 * 1024;
+constexpr int64_t S3_DOWNLOAD_CONCURRENCY_DEFAULT = 8;
+// s3 requires every part except the last one to be at least 5MB
+constexpr int64_t S3_UPLOAD_PART_SIZE_MIN = 5 * 1024 * 1024;
+constexpr int64_t S3_UPLOAD_PART_SIZE_DEFAULT = 8 * 1024 * 1024;
+constexpr int64_t S3_UPLOAD_CONCURRENCY_DEFAULT = 4;
+// s3 deletes at most 1000 keys a request
+constexpr size_t S3_DELETE_BATCH = 1000;
+
 class S3ClientWrapper {
  public:
     static S3ClientWrapper&
@@ -53,6 +62,63 @@ class S3ClientWrapper {
     DeleteObject(const std::string& object_key);
     Status
     DeleteObjects(const std::string& marker);
+    // S3_DELETE_BATCH keys a request
+    Status
+    DeleteObjects(const std::vector<std::string>& object_keys);
+
+    Status
+    HeadObject(const std::string& object_key, int64_t& size, std::string& etag);
+    Status
+    GetObjectRange(const std::string& object_key, int64_t offset, int64_t size, char* buffer);
+
+    // download by parallel ranged GETs, read through the local cache if it is enabled
+    Status
+    GetObjectParallel(const std::string& object_key, std::string& content);
+
+    // objects larger than part_size are downloaded by up to concurrency ranged GETs in parallel
+    // cache_path: local directory caching downloaded objects by ETag, empty to disable
+    void
+    SetDownloadOptions(int64_t part_size, int64_t concurrency, const std::string& cache_path);
+
+    Status
+    CreateMultipartUpload(const std::string& object_key, std::string& upload_id);
+    // part_number starts from 1
+    Status
+    UploadPart(const std::string& object_key, const std::string& upload_id, int64_t part_number,
+               const std::string& content, std::string& etag);
+    // etags: etag of each part, ordered by part number
+    Status
+    CompleteMultipartUpload(const std::string& object_key, const std::string& upload_id,
+                            const std::vector<std::string>& etags);
+    Status
+    AbortMultipartUpload(const std::string& object_key, const std::string& upload_id);
+
+    // S3IOWriter uploads every part_size bytes as one part, at most concurrency parts are in flight
+    void
+    SetUploadOptions(int64_t part_size, int64_t concurrency);
+
+    int64_t
+    UploadPartSize() const {
+        return upload_part_size_;
+    }
+
+    int64_t
+    UploadConcurrency() const {
+        return upload_concurrency_;
+    }
+
+ private:
+    Status
+    DownloadObject(const std::string& object_key, int64_t size, std::string& content);
+
+    std::string
+    CacheFilePath(const std::string& object_key, const std::string& etag);
+
+    bool
+    ReadCacheFile(const std::string& file_path, int64_t size, std::string& content);
+
+    void
+    WriteCacheFile(const std::string& file_path, const std::string& content);
 
  private:
     std::shared_ptr<Aws::S3::S3Client> client_ptr_;
@@ -63,6 +129,13 @@ class S3ClientWrapper {
     std::string s3_access_key_;
     std::string s3_secret_key_;
     std::string s3_bucket_;
+
+    int64_t part_size_ = S3_DOWNLOAD_PART_SIZE_DEFAULT;
+    int64_t concurrency_ = S3_DOWNLOAD_CONCURRENCY_DEFAULT;
+    std::string cache_path_;
+
+    int64_t upload_part_size_ = S3_UPLOAD_PART_SIZE_DEFAULT;
+    int64_t upload_concurrency_ = S3_UPLOAD_CONCURRENCY_DEFAULT;
 };
 
 }  // namespace storage
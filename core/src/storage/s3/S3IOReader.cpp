@@ -19,7 +19,7 @@ bool
 S3IOReader::open(const std::string& name) {
     name_ = name;
     pos_ = 0;
-    return (S3ClientWrapper::GetInstance().GetObjectStr(name_, buffer_).ok());
+    return (S3ClientWrapper::GetInstance().GetObjectParallel(name_, buffer_).ok());
 }
 
 void
@@ -11,22 +11,48 @@
 
 #include "storage/s3/S3IOWriter.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <utility>
 
 namespace milvus {
 namespace storage {
 
+S3IOWriter::~S3IOWriter() {
+    Abort();
+}
+
 bool
 S3IOWriter::open(const std::string& name) {
+    Abort();
+
+    auto& client = S3ClientWrapper::GetInstance();
     name_ = name;
     len_ = 0;
     buffer_ = "";
+    part_size_ = client.UploadPartSize();
+    concurrency_ = client.UploadConcurrency();
+    upload_id_ = "";
+    etags_.clear();
+    status_ = Status::OK();
     return true;
 }
 
 void
 S3IOWriter::write(void* ptr, int64_t size) {
-    buffer_ += std::string(reinterpret_cast<char*>(ptr), size);
+    auto data = reinterpret_cast<char*>(ptr);
     len_ += size;
+    while (size > 0) {
+        int64_t count = std::min(size, part_size_ - (int64_t)buffer_.size());
+        buffer_.append(data, count);
+        data += count;
+        size -= count;
+
+        if ((int64_t)buffer_.size() >= part_size_) {
+            UploadBuffer();
+        }
+    }
 }
 
 int64_t
@@ -36,7 +62,82 @@ S3IOWriter::length() {
 
 void
 S3IOWriter::close() {
-    S3ClientWrapper::GetInstance().PutObjectStr(name_, buffer_);
+    auto& client = S3ClientWrapper::GetInstance();
+    if (upload_id_.empty()) {
+        // never reached one part, no need to go through multipart upload
+        if (status_.ok()) {
+            status_ = client.PutObjectStr(name_, buffer_);
+        }
+        buffer_ = "";
+        return;
+    }
+
+    if (!buffer_.empty()) {
+        UploadBuffer();
+    }
+    while (!pending_parts_.empty()) {
+        WaitPart();
+    }
+
+    if (status_.ok()) {
+        std::vector<std::string> etags(etags_.begin(), etags_.end());
+        status_ = client.CompleteMultipartUpload(name_, upload_id_, etags);
+    }
+    if (!status_.ok()) {
+        LOG_STORAGE_ERROR_ << "Failed to upload '" << name_ << "': " << status_.message();
+        client.AbortMultipartUpload(name_, upload_id_);
+    }
+    upload_id_ = "";
+    etags_.clear();
+}
+
+void
+S3IOWriter::UploadBuffer() {
+    auto& client = S3ClientWrapper::GetInstance();
+    if (status_.ok() && upload_id_.empty()) {
+        status_ = client.CreateMultipartUpload(name_, upload_id_);
+    }
+    if (!status_.ok()) {
+        // the rest is dropped, close() reports the error
+        buffer_ = "";
+        return;
+    }
+
+    while ((int64_t)pending_parts_.size() >= concurrency_) {
+        WaitPart();
+    }
+
+    int64_t part_number = etags_.size() + 1;
+    etags_.emplace_back();
+    auto& etag = etags_.back();
+    auto content = std::make_shared<std::string>(std::move(buffer_));
+    buffer_ = "";
+    buffer_.reserve(part_size_);
+
+    auto upload = [&client, name = name_, upload_id = upload_id_, part_number, content, &etag]() {
+        return client.UploadPart(name, upload_id, part_number, *content, etag);
+    };
+    pending_parts_.emplace_back(std::async(std::launch::async, upload));
+}
+
+void
+S3IOWriter::WaitPart() {
+    auto status = pending_parts_.front().get();
+    pending_parts_.pop_front();
+    if (status_.ok() && !status.ok()) {
+        status_ = status;
+    }
+}
+
+void
+S3IOWriter::Abort() {
+    while (!pending_parts_.empty()) {
+        WaitPart();
+    }
+    if (!upload_id_.empty()) {
+        S3ClientWrapper::GetInstance().AbortMultipartUpload(name_, upload_id_);
+        upload_id_ = "";
+    }
 }
 
 }  // namespace storage
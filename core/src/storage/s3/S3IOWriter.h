@@ -11,17 +11,28 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
+
 #include "storage/IOWriter.h"
+#include "utils/Status.h"
 
 namespace milvus {
 namespace storage {
 
+/*
+ * Objects smaller than one part are uploaded by a single PutObject on close().
+ * Larger objects are uploaded by multipart upload while they are being written: every full part is
+ * handed to an asynchronous UploadPart, and write() blocks when the configured number of parts is in
+ * flight, so at most (concurrency + 1) parts are held in memory.
+ */
 class S3IOWriter : public IOWriter {
  public:
     S3IOWriter() = default;
-    ~S3IOWriter() = default;
+    ~S3IOWriter();
 
     // No copy and move
     S3IOWriter(const S3IOWriter&) = delete;
@@ -44,10 +55,36 @@ class S3IOWriter : public IOWriter {
     void
     close() override;
 
+    // result of the upload, valid after close()
+    const Status&
+    status() const {
+        return status_;
+    }
+
+ private:
+    void
+    UploadBuffer();
+
+    // wait for the oldest in flight part
+    void
+    WaitPart();
+
+    void
+    Abort();
+
  public:
     std::string name_;
-    int64_t len_;
+    int64_t len_ = 0;
     std::string buffer_;
+
+ private:
+    int64_t part_size_ = 0;
+    int64_t concurrency_ = 0;
+    std::string upload_id_;
+    std::deque<std::future<Status>> pending_parts_;
+    // deque, references to the etags being filled by the in flight parts stay valid while it grows
+    std::deque<std::string> etags_;
+    Status status_;
 };
 
 using S3IOWriterPtr = std::shared_ptr<S3IOWriter>;
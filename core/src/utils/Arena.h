@@ -0,0 +1,142 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace milvus {
+
+/*
+ * Bump allocator for the short lived buffers of one request. The memory is taken from blocks of BLOCK_SIZE bytes,
+ * an allocation is a pointer increment under a lock only the threads of the request share, so they don't queue on
+ * the malloc arenas of the process. Nothing is released before Reset() or the destruction of the arena, which frees
+ * all the blocks at once.
+ */
+class Arena {
+ public:
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    Arena() = default;
+
+    Arena(const Arena&) = delete;
+
+    Arena&
+    operator=(const Arena&) = delete;
+
+    void*
+    Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto begin = (reinterpret_cast<uintptr_t>(current_) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (current_ != nullptr && begin + bytes <= reinterpret_cast<uintptr_t>(end_)) {
+            current_ = reinterpret_cast<char*>(begin + bytes);
+            return reinterpret_cast<void*>(begin);
+        }
+
+        // a large allocation has a block of its own, the rest of the current block stays in use
+        size_t size = bytes + alignment;
+        bool own_block = size > BLOCK_SIZE / 4;
+        blocks_.emplace_back(new char[own_block ? size : BLOCK_SIZE]);
+        reserved_ += own_block ? size : BLOCK_SIZE;
+        char* block = blocks_.back().get();
+        begin = (reinterpret_cast<uintptr_t>(block) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (!own_block) {
+            current_ = reinterpret_cast<char*>(begin + bytes);
+            end_ = block + BLOCK_SIZE;
+        }
+        return reinterpret_cast<void*>(begin);
+    }
+
+    // the buffers allocated so far must not be used anymore
+    void
+    Reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocks_.clear();
+        current_ = end_ = nullptr;
+        reserved_ = 0;
+    }
+
+    // bytes of the blocks held
+    size_t
+    Reserved() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reserved_;
+    }
+
+ private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    size_t reserved_ = 0;
+};
+
+// allocator of the standard containers drawing from an arena, the heap without one. A container keeps its arena
+// when it is moved or swapped, deallocation is left to the arena
+template <typename T>
+class ArenaAllocator {
+ public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(Arena* arena = nullptr) noexcept : arena_(arena) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {
+    }
+
+    T*
+    allocate(size_t n) {
+        if (arena_ == nullptr) {
+            return std::allocator<T>().allocate(n);
+        }
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T* p, size_t n) {
+        if (arena_ == nullptr) {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    Arena*
+    arena() const {
+        return arena_;
+    }
+
+ private:
+    Arena* arena_;
+};
+
+template <typename T, typename U>
+bool
+operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool
+operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena() != b.arena();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace milvus
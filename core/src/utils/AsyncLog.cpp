@@ -0,0 +1,287 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/AsyncLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "utils/Log.h"
+
+namespace milvus {
+
+namespace {
+
+// the writer thread wakes up this often when no ring is filling up
+constexpr std::chrono::milliseconds WRITE_INTERVAL(10);
+
+constexpr const char* DEFAULT_LOGGER = "default";
+
+void
+WriteToEasylogging(const LogRecord& record) {
+    el::base::Writer(record.level_, record.file_, record.line_, record.func_).construct(1, DEFAULT_LOGGER)
+        << record.message_;
+}
+
+}  // namespace
+
+LogRing::LogRing(size_t capacity) {
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) {
+        size <<= 1;
+    }
+    records_.resize(size);
+    mask_ = size - 1;
+}
+
+bool
+LogRing::Push(LogRecord& record) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_) {
+        return false;
+    }
+    records_[head & mask_] = std::move(record);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool
+LogRing::Pop(LogRecord& record) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    record = std::move(records_[tail & mask_]);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool
+LogSite::Admit(int64_t lines_per_second) {
+    if (lines_per_second <= 0) {
+        return true;
+    }
+
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    auto second = second_.load(std::memory_order_relaxed);
+    if (second != now && second_.compare_exchange_strong(second, now, std::memory_order_relaxed)) {
+        lines_.store(0, std::memory_order_relaxed);
+    }
+    if (lines_.fetch_add(1, std::memory_order_relaxed) < lines_per_second) {
+        return true;
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+AsyncLog&
+AsyncLog::GetInstance() {
+    static AsyncLog instance;
+    return instance;
+}
+
+AsyncLog::~AsyncLog() {
+    Stop();
+}
+
+void
+AsyncLog::Start(size_t buffer_size, int64_t rate_limit, uint32_t levels, Sink sink) {
+    Stop();
+
+    buffer_size_ = buffer_size;
+    sink_ = sink ? std::move(sink) : WriteToEasylogging;
+    rate_limit_.store(rate_limit, std::memory_order_relaxed);
+    levels_.store(levels, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = false;
+    }
+    writer_ = std::thread(&AsyncLog::Run, this);
+    enabled_.store(true, std::memory_order_release);
+}
+
+void
+AsyncLog::Stop() {
+    if (!writer_.joinable()) {
+        return;
+    }
+
+    enabled_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_one();
+    writer_.join();
+
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.clear();
+        ++generation_;
+    }
+}
+
+std::shared_ptr<LogRing>
+AsyncLog::ThreadRing() {
+    struct ThreadRingHolder {
+        const AsyncLog* log_ = nullptr;
+        int64_t generation_ = -1;
+        std::shared_ptr<LogRing> ring_;
+
+        ~ThreadRingHolder() {
+            if (ring_ != nullptr) {
+                ring_->closed_ = true;
+            }
+        }
+    };
+    static thread_local ThreadRingHolder holder;
+
+    auto generation = generation_.load(std::memory_order_acquire);
+    if (holder.log_ != this || holder.generation_ != generation || holder.ring_ == nullptr) {
+        if (holder.ring_ != nullptr) {
+            holder.ring_->closed_ = true;
+        }
+        holder.log_ = this;
+        holder.generation_ = generation;
+        holder.ring_ = std::make_shared<LogRing>(buffer_size_);
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(holder.ring_);
+    }
+    return holder.ring_;
+}
+
+void
+AsyncLog::Write(const LogRecord& record) {
+    try {
+        sink_(record);
+    } catch (std::exception& ex) {
+        std::cerr << "Failed to write log: " << ex.what() << std::endl;
+    }
+}
+
+void
+AsyncLog::Submit(LogRecord& record) {
+    if (record.level_ == el::Level::Fatal) {
+        Flush();
+        Write(record);
+        return;
+    }
+
+    auto ring = ThreadRing();
+    if (ring->Push(record)) {
+        // wake the writer early rather than let the ring fill up before its next round
+        if (ring->Size() == ring->Capacity() / 2) {
+            wake_cv_.notify_one();
+        }
+        return;
+    }
+
+    if (IsSevere(record.level_)) {
+        Write(record);
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+AsyncLog::Flush() {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    DrainLocked();
+}
+
+void
+AsyncLog::DrainLocked() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    LogRecord record;
+    for (auto& ring : rings) {
+        while (ring->Pop(record)) {
+            Write(record);
+        }
+    }
+
+    auto dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != dropped_reported_) {
+        LogRecord report;
+        report.level_ = el::Level::Warning;
+        report.file_ = __FILE__;
+        report.line_ = __LINE__;
+        report.func_ = __func__;
+        report.message_ = "[SERVER][AsyncLog] " + std::to_string(dropped - dropped_reported_) +
+                          " log lines dropped because the log buffer of their thread was full";
+        Write(report);
+        dropped_reported_ = dropped;
+    }
+
+    // a ring closed before the drain has nothing left now
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    auto drained = [](const std::shared_ptr<LogRing>& ring) { return ring->closed_ && ring->Size() == 0; };
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(), drained), rings_.end());
+}
+
+void
+AsyncLog::Run() {
+    SetThreadName("async_log");
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait_for(lock, WRITE_INTERVAL, [this] { return stop_; });
+            if (stop_) {
+                return;
+            }
+        }
+        Flush();
+    }
+}
+
+LogLine::LogLine(el::Level level, const char* file, int64_t line, const char* func, LogSite& site) : site_(site) {
+    auto& async_log = AsyncLog::GetInstance();
+    if (!async_log.Enabled()) {
+        writer_.emplace(level, file, line, func);
+        writer_->construct(1, DEFAULT_LOGGER);
+        return;
+    }
+
+    if (!async_log.LevelEnabled(level)) {
+        return;
+    }
+    if (!AsyncLog::IsSevere(level) && !site_.Admit(async_log.RateLimit())) {
+        return;
+    }
+    record_.level_ = level;
+    record_.file_ = file;
+    record_.line_ = line;
+    record_.func_ = func;
+    stream_.emplace();
+}
+
+LogLine::~LogLine() {
+    if (!stream_) {
+        return;
+    }
+
+    record_.message_ = stream_->str();
+    auto suppressed = site_.TakeSuppressed();
+    if (suppressed > 0) {
+        record_.message_ += " (" + std::to_string(suppressed) + " similar lines suppressed)";
+    }
+    AsyncLog::GetInstance().Submit(record_);
+}
+
+}  // namespace milvus
@@ -0,0 +1,232 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "easyloggingpp/easylogging++.h"
+
+namespace milvus {
+
+struct LogRecord {
+    el::Level level_ = el::Level::Info;
+    const char* file_ = "";
+    int64_t line_ = 0;
+    const char* func_ = "";
+    std::string message_;
+};
+
+/*
+ * A bounded ring of log records written by one thread and read by the log writer thread. Push and Pop never lock,
+ * the two sides only share the head and tail counters.
+ */
+class LogRing {
+ public:
+    // capacity is rounded up to a power of two
+    explicit LogRing(size_t capacity);
+
+    // false if the ring is full, the record is left untouched then
+    bool
+    Push(LogRecord& record);
+
+    // only one thread may pop at a time
+    bool
+    Pop(LogRecord& record);
+
+    size_t
+    Capacity() const {
+        return mask_ + 1;
+    }
+
+    size_t
+    Size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    // set when the writing thread exits, the ring is released once it is drained
+    std::atomic<bool> closed_{false};
+
+ private:
+    std::vector<LogRecord> records_;
+    size_t mask_ = 0;
+
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+/*
+ * The lines logged from one place in the code, for the rate limit of that place. The limit counts the lines of each
+ * second, the lines over it are not formatted at all and their number is reported on the next line let through.
+ */
+class LogSite {
+ public:
+    bool
+    Admit(int64_t lines_per_second);
+
+    // the lines refused since the last call
+    int64_t
+    TakeSuppressed() {
+        return suppressed_.exchange(0, std::memory_order_relaxed);
+    }
+
+ private:
+    std::atomic<int64_t> second_{0};
+    std::atomic<int64_t> lines_{0};
+    std::atomic<int64_t> suppressed_{0};
+};
+
+/*
+ * Asynchronous log writing. The logging threads put their lines in a ring of their own and go on, a background thread
+ * hands them to the sink, which is easylogging++ unless another is given. When the ring of a thread is full:
+ *  - trace, debug and info lines are dropped and counted, the count is written to the log by the writer thread
+ *  - warning and error lines are written by the logging thread itself, so they are never lost
+ * A fatal line is always written by the logging thread, after the lines queued before it are written.
+ * Lines from different threads may reach the sink out of order, the lines of one thread keep their order.
+ */
+class AsyncLog {
+ public:
+    using Sink = std::function<void(const LogRecord&)>;
+
+    static AsyncLog&
+    GetInstance();
+
+    AsyncLog() = default;
+
+    ~AsyncLog();
+
+    // levels is a mask of the el::Level values to log, rate_limit of 0 means no limit per call site
+    void
+    Start(size_t buffer_size, int64_t rate_limit, uint32_t levels, Sink sink = nullptr);
+
+    // writes the queued lines and stops the writer thread, the lines are written synchronously afterwards
+    void
+    Stop();
+
+    bool
+    Enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    bool
+    LevelEnabled(el::Level level) const {
+        return (levels_.load(std::memory_order_relaxed) & static_cast<uint32_t>(level)) != 0;
+    }
+
+    int64_t
+    RateLimit() const {
+        return rate_limit_.load(std::memory_order_relaxed);
+    }
+
+    void
+    Submit(LogRecord& record);
+
+    // writes all queued lines before it returns
+    void
+    Flush();
+
+    int64_t
+    Dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    static bool
+    IsSevere(el::Level level) {
+        return level == el::Level::Warning || level == el::Level::Error || level == el::Level::Fatal;
+    }
+
+ private:
+    std::shared_ptr<LogRing>
+    ThreadRing();
+
+    void
+    Write(const LogRecord& record);
+
+    void
+    DrainLocked();
+
+    void
+    Run();
+
+ private:
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint32_t> levels_{0};
+    std::atomic<int64_t> rate_limit_{0};
+    size_t buffer_size_ = 0;
+    Sink sink_;
+
+    // a ring registered under an older generation belongs to a stopped run and is replaced
+    std::atomic<int64_t> generation_{0};
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<LogRing>> rings_;
+
+    // the rings have a single reader at a time, the writer thread or a flushing thread
+    std::mutex drain_mutex_;
+
+    std::atomic<int64_t> dropped_{0};
+    int64_t dropped_reported_ = 0;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool stop_ = false;
+    std::thread writer_;
+};
+
+/*
+ * One line of the LOG_*_ macros. Without the asynchronous mode it is an easylogging++ writer, with it the line is
+ * formatted here and submitted to AsyncLog when it ends.
+ */
+class LogLine {
+ public:
+    LogLine(el::Level level, const char* file, int64_t line, const char* func, LogSite& site);
+
+    ~LogLine();
+
+    template <typename T>
+    LogLine&
+    operator<<(const T& value) {
+        if (writer_) {
+            *writer_ << value;
+        } else if (stream_) {
+            *stream_ << value;
+        }
+        return *this;
+    }
+
+    LogLine&
+    operator<<(std::ostream& (*manip)(std::ostream&)) {
+        if (writer_) {
+            *writer_ << manip;
+        } else if (stream_) {
+            *stream_ << manip;
+        }
+        return *this;
+    }
+
+ private:
+    std::optional<el::base::Writer> writer_;
+    std::optional<std::ostringstream> stream_;
+    LogRecord record_;
+    LogSite& site_;
+};
+
+}  // namespace milvus
@@ -15,8 +15,12 @@
 #include <condition_variable>
 #include <iostream>
 #include <queue>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "utils/ContentionStats.h"
+
 namespace milvus {
 
 template <typename T>
@@ -41,6 +45,14 @@ class BlockingQueue {
         empty_.notify_all();
     }
 
+    void
+    Put(T&& task) {
+        std::unique_lock<std::mutex> lock(mtx);
+        full_.wait(lock, [this] { return (queue_.size() < capacity_); });
+        queue_.push(std::move(task));
+        empty_.notify_all();
+    }
+
     T
     Take() {
         std::unique_lock<std::mutex> lock(mtx);
@@ -84,12 +96,21 @@ class BlockingQueue {
         capacity_ = (capacity > 0 ? capacity : capacity_);
     }
 
+    // report the depth of the queue to ContentionStats
+    void
+    SetName(const std::string& name) {
+        depth_probe_.Set(name, [this] { return static_cast<int64_t>(Size()); });
+    }
+
  protected:
     mutable std::mutex mtx;
     std::condition_variable full_;
     std::condition_variable empty_;
     std::queue<T> queue_;
     size_t capacity_ = 32;
+
+ private:
+    QueueDepthProbe depth_probe_;
 };
 
 }  // namespace milvus
@@ -0,0 +1,229 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+
+// wait and hold time of the locks of one name, summed up over all the locks of the name
+struct LockStat {
+    std::atomic<int64_t> acquisitions{0};
+    std::atomic<int64_t> contended{0};  // acquisitions which had to wait
+    std::atomic<int64_t> wait_ns{0};
+    std::atomic<int64_t> hold_ns{0};
+    std::atomic<int64_t> max_wait_ns{0};
+};
+
+struct LockStatSnapshot {
+    std::string name_;
+    int64_t acquisitions_ = 0;
+    int64_t contended_ = 0;
+    int64_t wait_us_ = 0;
+    int64_t hold_us_ = 0;
+    int64_t max_wait_us_ = 0;
+};
+
+struct QueueDepthSnapshot {
+    std::string name_;
+    int64_t depth_ = 0;
+};
+
+/*
+ * Registry of the named locks and queues, read by the metrics and the web state endpoint.
+ * The lock statistics are only collected when built with MILVUS_WITH_LOCK_STATS, the queue depths always are.
+ */
+class ContentionStats {
+ public:
+    // never destroyed, the queues of static objects like the cache reclaimer are removed during the exit
+    static ContentionStats&
+    GetInstance() {
+        static auto instance = new ContentionStats();
+        return *instance;
+    }
+
+    // the statistics of name, valid for the lifetime of the process
+    LockStat*
+    Lock(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stat = locks_[name];
+        if (stat == nullptr) {
+            stat = std::make_unique<LockStat>();
+        }
+        return stat.get();
+    }
+
+    uint64_t
+    AddQueue(const std::string& name, std::function<int64_t()> depth) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto id = ++last_queue_id_;
+        queues_[id] = std::make_pair(name, std::move(depth));
+        return id;
+    }
+
+    void
+    RemoveQueue(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_.erase(id);
+    }
+
+    std::vector<LockStatSnapshot>
+    Locks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<LockStatSnapshot> snapshots;
+        for (auto& pair : locks_) {
+            LockStatSnapshot snapshot;
+            snapshot.name_ = pair.first;
+            snapshot.acquisitions_ = pair.second->acquisitions.load(std::memory_order_relaxed);
+            snapshot.contended_ = pair.second->contended.load(std::memory_order_relaxed);
+            snapshot.wait_us_ = pair.second->wait_ns.load(std::memory_order_relaxed) / 1000;
+            snapshot.hold_us_ = pair.second->hold_ns.load(std::memory_order_relaxed) / 1000;
+            snapshot.max_wait_us_ = pair.second->max_wait_ns.load(std::memory_order_relaxed) / 1000;
+            snapshots.emplace_back(std::move(snapshot));
+        }
+        return snapshots;
+    }
+
+    // the queues of the same name are summed up
+    std::vector<QueueDepthSnapshot>
+    QueueDepths() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, int64_t> depths;
+        for (auto& pair : queues_) {
+            depths[pair.second.first] += pair.second.second();
+        }
+        std::vector<QueueDepthSnapshot> snapshots;
+        for (auto& pair : depths) {
+            snapshots.push_back(QueueDepthSnapshot{pair.first, pair.second});
+        }
+        return snapshots;
+    }
+
+ private:
+    ContentionStats() = default;
+
+ private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<LockStat>> locks_;
+    uint64_t last_queue_id_ = 0;
+    std::map<uint64_t, std::pair<std::string, std::function<int64_t()>>> queues_;
+};
+
+// reports the depth of a queue under a name until reset, declare it after the members the depth reads
+class QueueDepthProbe {
+ public:
+    QueueDepthProbe() = default;
+
+    QueueDepthProbe(const QueueDepthProbe&) = delete;
+
+    QueueDepthProbe&
+    operator=(const QueueDepthProbe&) = delete;
+
+    ~QueueDepthProbe() {
+        Reset();
+    }
+
+    void
+    Set(const std::string& name, std::function<int64_t()> depth) {
+        Reset();
+        id_ = ContentionStats::GetInstance().AddQueue(name, std::move(depth));
+    }
+
+    void
+    Reset() {
+        if (id_ != 0) {
+            ContentionStats::GetInstance().RemoveQueue(id_);
+            id_ = 0;
+        }
+    }
+
+ private:
+    uint64_t id_ = 0;
+};
+
+#ifdef MILVUS_WITH_LOCK_STATS
+// a mutex recording how long its users wait for it and hold it
+class InstrumentedMutex {
+ public:
+    explicit InstrumentedMutex(const char* name) : stat_(ContentionStats::GetInstance().Lock(name)) {
+    }
+
+    InstrumentedMutex(const InstrumentedMutex&) = delete;
+
+    InstrumentedMutex&
+    operator=(const InstrumentedMutex&) = delete;
+
+    void
+    lock() {
+        if (!mutex_.try_lock()) {
+            auto start = std::chrono::steady_clock::now();
+            mutex_.lock();
+            int64_t wait =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            stat_->contended.fetch_add(1, std::memory_order_relaxed);
+            stat_->wait_ns.fetch_add(wait, std::memory_order_relaxed);
+            int64_t max_wait = stat_->max_wait_ns.load(std::memory_order_relaxed);
+            while (wait > max_wait &&
+                   !stat_->max_wait_ns.compare_exchange_weak(max_wait, wait, std::memory_order_relaxed)) {
+            }
+        }
+        Acquired();
+    }
+
+    bool
+    try_lock() {
+        if (!mutex_.try_lock()) {
+            return false;
+        }
+        Acquired();
+        return true;
+    }
+
+    void
+    unlock() {
+        int64_t hold =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - acquired_).count();
+        mutex_.unlock();
+        stat_->hold_ns.fetch_add(hold, std::memory_order_relaxed);
+    }
+
+ private:
+    void
+    Acquired() {
+        stat_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_ = std::chrono::steady_clock::now();
+    }
+
+ private:
+    std::mutex mutex_;
+    LockStat* stat_;
+    std::chrono::steady_clock::time_point acquired_;  // written and read by the holder only
+};
+#else
+// without MILVUS_WITH_LOCK_STATS the name is dropped and the lock is a plain std::mutex
+class InstrumentedMutex : public std::mutex {
+ public:
+    explicit InstrumentedMutex(const char* name) {
+    }
+};
+#endif
+
+}  // namespace milvus
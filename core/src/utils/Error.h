@@ -93,6 +93,9 @@ constexpr ErrorCode SERVER_OUT_OF_MEMORY = ToServerErrorCode(117);
 constexpr ErrorCode SERVER_INVALID_PARTITION_TAG = ToServerErrorCode(118);
 constexpr ErrorCode SERVER_INVALID_BINARY_QUERY = ToServerErrorCode(119);
 constexpr ErrorCode SERVER_INVALID_DSL_PARAMETER = ToServerErrorCode(120);
+constexpr ErrorCode SERVER_DEADLINE_EXCEEDED = ToServerErrorCode(121);
+constexpr ErrorCode SERVER_REQUEST_CANCELLED = ToServerErrorCode(122);
+constexpr ErrorCode SERVER_REQUEST_QUEUE_FULL = ToServerErrorCode(123);
 
 // db error code
 constexpr ErrorCode DB_META_TRANSACTION_FAILED = ToDbErrorCode(1);
@@ -106,6 +109,7 @@ constexpr ErrorCode DB_EMPTY_COLLECTION = ToDbErrorCode(8);
 constexpr ErrorCode DB_BLOOM_FILTER_ERROR = ToDbErrorCode(9);
 constexpr ErrorCode DB_PARTITION_NOT_FOUND = ToDbErrorCode(10);
 constexpr ErrorCode DB_OUT_OF_STORAGE = ToDbErrorCode(11);
+constexpr ErrorCode DB_INSERT_BUFFER_FULL = ToDbErrorCode(12);
 
 // knowhere error code
 constexpr ErrorCode KNOWHERE_ERROR = ToKnowhereErrorCode(1);
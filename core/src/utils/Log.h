@@ -14,6 +14,7 @@
 #include <string>
 
 #include "easyloggingpp/easylogging++.h"
+#include "utils/AsyncLog.h"
 
 namespace milvus {
 
@@ -22,25 +23,40 @@ namespace milvus {
  * and LOG_MODULE_LEVEL_ macro in other functions.
  */
 
+/*
+ * Every expansion of MILVUS_LOG owns a LogSite, the unit of the rate limit of the asynchronous mode.
+ */
+#ifdef ELPP_DISABLE_LOGS
+#define MILVUS_LOG(LEVEL, EL_LEVEL) LOG(LEVEL)
+#else
+#define MILVUS_LOG_SITE                       \
+    []() -> ::milvus::LogSite& {              \
+        static ::milvus::LogSite log_site;    \
+        return log_site;                      \
+    }()
+#define MILVUS_LOG(LEVEL, EL_LEVEL) \
+    ::milvus::LogLine(el::Level::EL_LEVEL, __FILE__, __LINE__, ELPP_FUNC, MILVUS_LOG_SITE)
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define SERVER_MODULE_NAME "SERVER"
 #define SERVER_MODULE_CLASS_FUNCTION \
     LogOut("[%s][%s::%s][%s] ", SERVER_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define SERVER_MODULE_FUNCTION LogOut("[%s][%s][%s] ", SERVER_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_SERVER_TRACE_C LOG(TRACE) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_DEBUG_C LOG(DEBUG) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_INFO_C LOG(INFO) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_WARNING_C LOG(WARNING) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_ERROR_C LOG(ERROR) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_FATAL_C LOG(FATAL) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_TRACE_C MILVUS_LOG(TRACE, Trace) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_DEBUG_C MILVUS_LOG(DEBUG, Debug) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_INFO_C MILVUS_LOG(INFO, Info) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_WARNING_C MILVUS_LOG(WARNING, Warning) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_ERROR_C MILVUS_LOG(ERROR, Error) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_FATAL_C MILVUS_LOG(FATAL, Fatal) << SERVER_MODULE_CLASS_FUNCTION
 
-#define LOG_SERVER_TRACE_ LOG(TRACE) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_DEBUG_ LOG(DEBUG) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_INFO_ LOG(INFO) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_WARNING_ LOG(WARNING) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_ERROR_ LOG(ERROR) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_FATAL_ LOG(FATAL) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_TRACE_ MILVUS_LOG(TRACE, Trace) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_DEBUG_ MILVUS_LOG(DEBUG, Debug) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_INFO_ MILVUS_LOG(INFO, Info) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_WARNING_ MILVUS_LOG(WARNING, Warning) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_ERROR_ MILVUS_LOG(ERROR, Error) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_FATAL_ MILVUS_LOG(FATAL, Fatal) << SERVER_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define ENGINE_MODULE_NAME "ENGINE"
@@ -48,19 +64,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", ENGINE_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define ENGINE_MODULE_FUNCTION LogOut("[%s][%s][%s] ", ENGINE_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_ENGINE_TRACE_C LOG(TRACE) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_DEBUG_C LOG(DEBUG) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_INFO_C LOG(INFO) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_WARNING_C LOG(WARNING) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_ERROR_C LOG(ERROR) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_FATAL_C LOG(FATAL) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_TRACE_C MILVUS_LOG(TRACE, Trace) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_DEBUG_C MILVUS_LOG(DEBUG, Debug) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_INFO_C MILVUS_LOG(INFO, Info) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_WARNING_C MILVUS_LOG(WARNING, Warning) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_ERROR_C MILVUS_LOG(ERROR, Error) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_FATAL_C MILVUS_LOG(FATAL, Fatal) << ENGINE_MODULE_CLASS_FUNCTION
 
-#define LOG_ENGINE_TRACE_ LOG(TRACE) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_DEBUG_ LOG(DEBUG) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_INFO_ LOG(INFO) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_WARNING_ LOG(WARNING) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_ERROR_ LOG(ERROR) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_FATAL_ LOG(FATAL) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_TRACE_ MILVUS_LOG(TRACE, Trace) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_DEBUG_ MILVUS_LOG(DEBUG, Debug) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_INFO_ MILVUS_LOG(INFO, Info) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_WARNING_ MILVUS_LOG(WARNING, Warning) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_ERROR_ MILVUS_LOG(ERROR, Error) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_FATAL_ MILVUS_LOG(FATAL, Fatal) << ENGINE_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WRAPPER_MODULE_NAME "WRAPPER"
@@ -68,19 +84,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", WRAPPER_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define WRAPPER_MODULE_FUNCTION LogOut("[%s][%s][%s] ", WRAPPER_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_WRAPPER_TRACE_C LOG(TRACE) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_DEBUG_C LOG(DEBUG) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_INFO_C LOG(INFO) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_WARNING_C LOG(WARNING) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_ERROR_C LOG(ERROR) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_FATAL_C LOG(FATAL) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_TRACE_C MILVUS_LOG(TRACE, Trace) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_DEBUG_C MILVUS_LOG(DEBUG, Debug) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_INFO_C MILVUS_LOG(INFO, Info) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_WARNING_C MILVUS_LOG(WARNING, Warning) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_ERROR_C MILVUS_LOG(ERROR, Error) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_FATAL_C MILVUS_LOG(FATAL, Fatal) << WRAPPER_MODULE_CLASS_FUNCTION
 
-#define LOG_WRAPPER_TRACE_ LOG(TRACE) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_DEBUG_ LOG(DEBUG) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_INFO_ LOG(INFO) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_WARNING_ LOG(WARNING) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_ERROR_ LOG(ERROR) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_FATAL_ LOG(FATAL) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_TRACE_ MILVUS_LOG(TRACE, Trace) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_DEBUG_ MILVUS_LOG(DEBUG, Debug) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_INFO_ MILVUS_LOG(INFO, Info) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_WARNING_ MILVUS_LOG(WARNING, Warning) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_ERROR_ MILVUS_LOG(ERROR, Error) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_FATAL_ MILVUS_LOG(FATAL, Fatal) << WRAPPER_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define STORAGE_MODULE_NAME "STORAGE"
@@ -88,19 +104,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", STORAGE_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define STORAGE_MODULE_FUNCTION LogOut("[%s][%s][%s] ", STORAGE_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_STORAGE_TRACE_C LOG(TRACE) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_DEBUG_C LOG(DEBUG) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_INFO_C LOG(INFO) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_WARNING_C LOG(WARNING) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_ERROR_C LOG(ERROR) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_FATAL_C LOG(FATAL) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_TRACE_C MILVUS_LOG(TRACE, Trace) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_DEBUG_C MILVUS_LOG(DEBUG, Debug) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_INFO_C MILVUS_LOG(INFO, Info) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_WARNING_C MILVUS_LOG(WARNING, Warning) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_ERROR_C MILVUS_LOG(ERROR, Error) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_FATAL_C MILVUS_LOG(FATAL, Fatal) << STORAGE_MODULE_CLASS_FUNCTION
 
-#define LOG_STORAGE_TRACE_ LOG(TRACE) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_DEBUG_ LOG(DEBUG) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_INFO_ LOG(INFO) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_WARNING_ LOG(WARNING) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_ERROR_ LOG(ERROR) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_FATAL_ LOG(FATAL) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_TRACE_ MILVUS_LOG(TRACE, Trace) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_DEBUG_ MILVUS_LOG(DEBUG, Debug) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_INFO_ MILVUS_LOG(INFO, Info) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_WARNING_ MILVUS_LOG(WARNING, Warning) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_ERROR_ MILVUS_LOG(ERROR, Error) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_FATAL_ MILVUS_LOG(FATAL, Fatal) << STORAGE_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WAL_MODULE_NAME "WAL"
@@ -108,19 +124,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", WAL_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define WAL_MODULE_FUNCTION LogOut("[%s][%s][%s] ", WAL_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_WAL_TRACE_C LOG(TRACE) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_DEBUG_C LOG(DEBUG) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_INFO_C LOG(INFO) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_WARNING_C LOG(WARNING) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_ERROR_C LOG(ERROR) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_FATAL_C LOG(FATAL) << WAL_MODULE_CLASS_FUNCTION
-
-#define LOG_WAL_TRACE_ LOG(TRACE) << WAL_MODULE_FUNCTION
-#define LOG_WAL_DEBUG_ LOG(DEBUG) << WAL_MODULE_FUNCTION
-#define LOG_WAL_INFO_ LOG(INFO) << WAL_MODULE_FUNCTION
-#define LOG_WAL_WARNING_ LOG(WARNING) << WAL_MODULE_FUNCTION
-#define LOG_WAL_ERROR_ LOG(ERROR) << WAL_MODULE_FUNCTION
-#define LOG_WAL_FATAL_ LOG(FATAL) << WAL_MODULE_FUNCTION
+#define LOG_WAL_TRACE_C MILVUS_LOG(TRACE, Trace) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_DEBUG_C MILVUS_LOG(DEBUG, Debug) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_INFO_C MILVUS_LOG(INFO, Info) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_WARNING_C MILVUS_LOG(WARNING, Warning) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_ERROR_C MILVUS_LOG(ERROR, Error) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_FATAL_C MILVUS_LOG(FATAL, Fatal) << WAL_MODULE_CLASS_FUNCTION
+
+#define LOG_WAL_TRACE_ MILVUS_LOG(TRACE, Trace) << WAL_MODULE_FUNCTION
+#define LOG_WAL_DEBUG_ MILVUS_LOG(DEBUG, Debug) << WAL_MODULE_FUNCTION
+#define LOG_WAL_INFO_ MILVUS_LOG(INFO, Info) << WAL_MODULE_FUNCTION
+#define LOG_WAL_WARNING_ MILVUS_LOG(WARNING, Warning) << WAL_MODULE_FUNCTION
+#define LOG_WAL_ERROR_ MILVUS_LOG(ERROR, Error) << WAL_MODULE_FUNCTION
+#define LOG_WAL_FATAL_ MILVUS_LOG(FATAL, Fatal) << WAL_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 std::string
@@ -0,0 +1,176 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace milvus {
+
+enum class MemorySubsystem {
+    INSERT_BUFFER = 0,
+    CPU_CACHE,
+    WAL_BUFFER,
+    SEARCH_RESULT,  // results of the searches in flight
+    INDEX_BUILD,    // raw data and new indexes of the builds in flight
+    COUNT,
+};
+
+inline const char*
+MemorySubsystemName(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::INSERT_BUFFER:
+            return "insert_buffer";
+        case MemorySubsystem::CPU_CACHE:
+            return "cpu_cache";
+        case MemorySubsystem::WAL_BUFFER:
+            return "wal_buffer";
+        case MemorySubsystem::SEARCH_RESULT:
+            return "search_result";
+        case MemorySubsystem::INDEX_BUILD:
+            return "index_build";
+        default:
+            return "unknown";
+    }
+}
+
+/*
+ * Bytes held by every subsystem, for the metrics and the memory limit.
+ * A subsystem either updates its counter as it allocates and releases (TrackedMemory),
+ * or registers a probe which is read on demand (MemoryProbe) when it already knows its usage.
+ */
+class MemoryAccounting {
+ public:
+    static MemoryAccounting&
+    GetInstance() {
+        static MemoryAccounting instance;
+        return instance;
+    }
+
+    void
+    Add(MemorySubsystem subsystem, int64_t bytes) {
+        counters_[static_cast<int>(subsystem)].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    uint64_t
+    AddProbe(MemorySubsystem subsystem, std::function<int64_t()> usage) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto id = ++last_probe_id_;
+        probes_[id] = std::make_pair(subsystem, std::move(usage));
+        return id;
+    }
+
+    void
+    RemoveProbe(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        probes_.erase(id);
+    }
+
+    int64_t
+    Usage(MemorySubsystem subsystem) const {
+        int64_t usage = counters_[static_cast<int>(subsystem)].load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& pair : probes_) {
+            if (pair.second.first == subsystem) {
+                usage += pair.second.second();
+            }
+        }
+        return usage;
+    }
+
+    int64_t
+    Total() const {
+        int64_t total = 0;
+        for (int i = 0; i < static_cast<int>(MemorySubsystem::COUNT); ++i) {
+            total += Usage(static_cast<MemorySubsystem>(i));
+        }
+        return total;
+    }
+
+ private:
+    MemoryAccounting() = default;
+
+ private:
+    std::atomic<int64_t> counters_[static_cast<int>(MemorySubsystem::COUNT)] = {};
+    mutable std::mutex mutex_;
+    uint64_t last_probe_id_ = 0;
+    std::map<uint64_t, std::pair<MemorySubsystem, std::function<int64_t()>>> probes_;
+};
+
+// bytes held by a subsystem until set again or destroyed
+class TrackedMemory {
+ public:
+    explicit TrackedMemory(MemorySubsystem subsystem) : subsystem_(subsystem) {
+    }
+
+    TrackedMemory(const TrackedMemory&) = delete;
+
+    TrackedMemory&
+    operator=(const TrackedMemory&) = delete;
+
+    ~TrackedMemory() {
+        Set(0);
+    }
+
+    void
+    Set(int64_t bytes) {
+        MemoryAccounting::GetInstance().Add(subsystem_, bytes - bytes_);
+        bytes_ = bytes;
+    }
+
+    int64_t
+    bytes() const {
+        return bytes_;
+    }
+
+ private:
+    MemorySubsystem subsystem_;
+    int64_t bytes_ = 0;
+};
+
+// reports the usage of a subsystem until reset, declare it after the members the usage reads
+class MemoryProbe {
+ public:
+    MemoryProbe() = default;
+
+    MemoryProbe(const MemoryProbe&) = delete;
+
+    MemoryProbe&
+    operator=(const MemoryProbe&) = delete;
+
+    ~MemoryProbe() {
+        Reset();
+    }
+
+    void
+    Set(MemorySubsystem subsystem, std::function<int64_t()> usage) {
+        Reset();
+        id_ = MemoryAccounting::GetInstance().AddProbe(subsystem, std::move(usage));
+    }
+
+    void
+    Reset() {
+        if (id_ != 0) {
+            MemoryAccounting::GetInstance().RemoveProbe(id_);
+            id_ = 0;
+        }
+    }
+
+ private:
+    uint64_t id_ = 0;
+};
+
+}  // namespace milvus
@@ -0,0 +1,57 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace milvus {
+
+/*
+ * Paces the bytes read or written by a background job to a number of bytes per second, shared by all its threads.
+ * A caller reserves the bytes before the io and sleeps until its share of the second comes, so a burst is spread
+ * over time rather than refused.
+ */
+class RateLimiter {
+ public:
+    // bytes_per_second of 0 means no limit
+    explicit RateLimiter(int64_t bytes_per_second) : bytes_per_second_(bytes_per_second) {
+    }
+
+    void
+    Acquire(int64_t bytes) {
+        if (bytes_per_second_ <= 0 || bytes <= 0) {
+            return;
+        }
+
+        auto cost = std::chrono::microseconds(bytes * 1000000 / bytes_per_second_);
+        std::chrono::steady_clock::time_point start;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // the budget of an idle period isn't saved up for a later burst
+            start = std::max(next_free_, std::chrono::steady_clock::now());
+            next_free_ = start + cost;
+        }
+        std::this_thread::sleep_until(start);
+    }
+
+ private:
+    int64_t bytes_per_second_;
+
+    std::mutex mutex_;
+    std::chrono::steady_clock::time_point next_free_;
+};
+
+}  // namespace milvus
@@ -0,0 +1,76 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/Log.h"
+
+namespace milvus {
+
+/*
+ * Seconds each stage of the startup took, for the metrics, which are only initialized midway through the startup.
+ * The stages run concurrently overlap, a stage recorded again replaces its former time.
+ */
+class StartupStages {
+ public:
+    static StartupStages&
+    GetInstance() {
+        static StartupStages instance;
+        return instance;
+    }
+
+    void
+    Record(const std::string& stage, double seconds) {
+        LOG_SERVER_INFO_ << "Startup stage " << stage << " took " << seconds << " seconds";
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& pair : stages_) {
+            if (pair.first == stage) {
+                pair.second = seconds;
+                return;
+            }
+        }
+        stages_.emplace_back(stage, seconds);
+    }
+
+    std::vector<std::pair<std::string, double>>
+    Stages() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stages_;
+    }
+
+ private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, double>> stages_;
+};
+
+// record the time from its construction to its destruction as a startup stage
+class StartupStageGuard {
+ public:
+    explicit StartupStageGuard(std::string stage) : stage_(std::move(stage)), start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~StartupStageGuard() {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+        StartupStages::GetInstance().Record(stage_, elapsed.count());
+    }
+
+ private:
+    std::string stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace milvus
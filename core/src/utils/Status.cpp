@@ -18,6 +18,10 @@ namespace milvus {
 constexpr int CODE_WIDTH = sizeof(StatusCode);
 
 Status::Status(StatusCode code, const std::string& msg) {
+    if (code == 0) {
+        return;
+    }
+
     // 4 bytes store code
     // 4 bytes store message length
     // the left bytes store message string
@@ -30,36 +34,21 @@ Status::Status(StatusCode code, const std::string& msg) {
     state_ = result;
 }
 
-Status::Status() : state_(nullptr) {
-}
-
-Status::~Status() {
-    delete state_;
-}
-
 Status::Status(const Status& s) : state_(nullptr) {
     CopyFrom(s);
 }
 
 Status&
 Status::operator=(const Status& s) {
-    CopyFrom(s);
-    return *this;
-}
-
-Status::Status(Status&& s) : state_(nullptr) {
-    MoveFrom(s);
-}
-
-Status&
-Status::operator=(Status&& s) {
-    MoveFrom(s);
+    if (this != &s) {
+        CopyFrom(s);
+    }
     return *this;
 }
 
 void
 Status::CopyFrom(const Status& s) {
-    delete state_;
+    delete[] state_;
     state_ = nullptr;
     if (s.state_ == nullptr) {
         return;
@@ -72,13 +61,6 @@ Status::CopyFrom(const Status& s) {
     memcpy(state_, s.state_, buff_len);
 }
 
-void
-Status::MoveFrom(Status& s) {
-    delete state_;
-    state_ = s.state_;
-    s.state_ = nullptr;
-}
-
 std::string
 Status::message() const {
     if (state_ == nullptr) {
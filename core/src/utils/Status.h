@@ -28,21 +28,36 @@ class Status;
 
 using StatusCode = ErrorCode;
 
+// An OK status holds no state, creating, moving and dropping one allocates nothing. The message of a success code
+// is not kept.
 class Status {
  public:
     Status(StatusCode code, const std::string& msg);
-    Status();
-    ~Status();
+
+    Status() noexcept = default;
+
+    ~Status() {
+        delete[] state_;
+    }
 
     Status(const Status& s);
 
     Status&
     operator=(const Status& s);
 
-    Status(Status&& s);
+    Status(Status&& s) noexcept : state_(s.state_) {
+        s.state_ = nullptr;
+    }
 
     Status&
-    operator=(Status&& s);
+    operator=(Status&& s) noexcept {
+        if (this != &s) {
+            delete[] state_;
+            state_ = s.state_;
+            s.state_ = nullptr;
+        }
+        return *this;
+    }
 
     static Status
     OK() {
@@ -69,9 +84,6 @@ class Status {
     inline void
     CopyFrom(const Status& s);
 
-    inline void
-    MoveFrom(Status& s);
-
  private:
     char* state_ = nullptr;
 };  // Status
@@ -19,22 +19,30 @@
 #include <mutex>
 #include <queue>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "utils/ContentionStats.h"
+
 #define MAX_THREADS_NUM 32
 
 namespace milvus {
 
 class ThreadPool {
  public:
-    explicit ThreadPool(size_t threads, size_t queue_size = 1000);
+    // a named pool reports the depth of its task queue to ContentionStats
+    explicit ThreadPool(size_t threads, size_t queue_size = 1000, const std::string& name = "");
 
     template <class F, class... Args>
     auto
     enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type>;
 
+    // returns false at once rather than waiting when the queue is full or the pool is stopped
+    bool
+    try_enqueue(std::function<void()> task);
+
     ~ThreadPool();
 
  private:
@@ -52,10 +60,19 @@ class ThreadPool {
     std::condition_variable condition_;
 
     bool stop;
+
+    QueueDepthProbe depth_probe_;
 };
 
 // the constructor just launches some amount of workers
-inline ThreadPool::ThreadPool(size_t threads, size_t queue_size) : max_queue_size_(queue_size), stop(false) {
+inline ThreadPool::ThreadPool(size_t threads, size_t queue_size, const std::string& name)
+    : max_queue_size_(queue_size), stop(false) {
+    if (!name.empty()) {
+        depth_probe_.Set("thread_pool." + name, [this] {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            return static_cast<int64_t>(tasks_.size());
+        });
+    }
     for (size_t i = 0; i < threads; ++i)
         workers_.emplace_back([this] {
             for (;;) {
@@ -99,6 +116,19 @@ ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<typename std::result_o
     return res;
 }
 
+inline bool
+ThreadPool::try_enqueue(std::function<void()> task) {
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (stop || tasks_.size() >= max_queue_size_) {
+            return false;
+        }
+        tasks_.emplace(std::move(task));
+    }
+    condition_.notify_all();
+    return true;
+}
+
 // the destructor joins all threads
 inline ThreadPool::~ThreadPool() {
     {
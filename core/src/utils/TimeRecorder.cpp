@@ -12,6 +12,8 @@
 #include "utils/TimeRecorder.h"
 #include "utils/Log.h"
 
+#include <algorithm>
+
 namespace milvus {
 
 TimeRecorder::TimeRecorder(const std::string& header, int64_t log_level) : header_(header), log_level_(log_level) {
@@ -96,4 +98,19 @@ TimeRecorderAuto::~TimeRecorderAuto() {
     ElapseFromBegin("totally cost");
 }
 
+TraceBuffer&
+TraceBuffer::ThreadLocal() {
+    static thread_local TraceBuffer buffer;
+    return buffer;
+}
+
+void
+TraceBuffer::Dump(std::vector<TraceRecord>& records) const {
+    uint64_t kept = std::min<uint64_t>(count_, CAPACITY);
+    records.reserve(records.size() + kept);
+    for (uint64_t i = count_ - kept; i < count_; ++i) {
+        records.push_back(records_[i % CAPACITY]);
+    }
+}
+
 }  // namespace milvus
@@ -11,8 +11,11 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "utils/Log.h"
 
 namespace milvus {
@@ -63,4 +66,87 @@ class TimeRecorderAuto : public TimeRecorder {
     ~TimeRecorderAuto() override;
 };
 
+struct TraceRecord {
+    const char* name_ = nullptr;
+    int64_t start_us_ = 0;  // steady clock
+    double span_us_ = 0.0;
+};
+
+// The latest sections timed on a thread, in a ring of fixed size, recording one allocates nothing
+class TraceBuffer {
+ public:
+    static constexpr size_t CAPACITY = 1024;
+
+    static TraceBuffer&
+    ThreadLocal();
+
+    void
+    Record(const char* name, int64_t start_us, double span_us) {
+        records_[count_ % CAPACITY] = TraceRecord{name, start_us, span_us};
+        ++count_;
+    }
+
+    // the sections recorded from the oldest one kept
+    void
+    Dump(std::vector<TraceRecord>& records) const;
+
+    uint64_t
+    Count() const {
+        return count_;
+    }
+
+ private:
+    std::array<TraceRecord, CAPACITY> records_;
+    uint64_t count_ = 0;
+};
+
+// TimeRecorder for the search path: the names are string literals and the sections go to the trace buffer of the
+// thread instead of the log. The spans are returned in microseconds, for the callers to observe in the metrics.
+class ScopedTimer {
+    using Clock = std::chrono::steady_clock;
+
+ public:
+    // name is recorded for the whole scope when it is not null
+    explicit ScopedTimer(const char* name = nullptr) : name_(name), start_(Clock::now()), last_(start_) {
+    }
+
+    ~ScopedTimer() {
+        if (name_ != nullptr) {
+            Record(name_, start_, Clock::now());
+        }
+    }
+
+    // the time since the last section, or the construction
+    double
+    RecordSection(const char* name) {
+        auto now = Clock::now();
+        double span = Record(name, last_, now);
+        last_ = now;
+        return span;
+    }
+
+    double
+    ElapseFromBegin(const char* name) {
+        return Record(name, start_, Clock::now());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer&
+    operator=(const ScopedTimer&) = delete;
+
+ private:
+    static double
+    Record(const char* name, Clock::time_point begin, Clock::time_point end) {
+        double span = std::chrono::duration<double, std::micro>(end - begin).count();
+        auto start_us = std::chrono::duration_cast<std::chrono::microseconds>(begin.time_since_epoch()).count();
+        TraceBuffer::ThreadLocal().Record(name, start_us, span);
+        return span;
+    }
+
+ private:
+    const char* name_;
+    Clock::time_point start_;
+    Clock::time_point last_;
+};
+
 }  // namespace milvus
@@ -0,0 +1,230 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <fiu-local.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "utils/ContentionStats.h"
+
+namespace milvus {
+
+/*
+ * A thread pool where every worker owns a deque of tasks for each priority. A task enqueued by a worker goes to its
+ * own deque, one enqueued by another thread goes to the workers in turn. A worker takes its own tasks from the front
+ * and, when it has none of a priority, steals from the back of the others, so the lock of a deque is only shared by
+ * its owner and an occasional thief. Enqueue never blocks, the queues are unbounded.
+ * Higher priorities run first, a task of a priority is never started while one of a higher priority is queued
+ * anywhere in the pool, save for the race of a task enqueued while the workers scan.
+ */
+class WorkStealingThreadPool {
+ public:
+    enum class Priority {
+        HIGH = 0,
+        NORMAL = 1,
+        LOW = 2,
+    };
+
+    // a named pool reports the depth of its task queues to ContentionStats
+    explicit WorkStealingThreadPool(size_t threads, const std::string& name = "");
+
+    template <class F, class... Args>
+    auto
+    enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type>;
+
+    template <class F, class... Args>
+    auto
+    enqueue_priority(Priority priority, F&& f, Args&&... args)
+        -> std::future<typename std::result_of<F(Args...)>::type>;
+
+    ~WorkStealingThreadPool();
+
+ private:
+    static constexpr size_t PRIORITY_NUM = 3;
+
+    using Task = std::function<void()>;
+
+    struct Worker {
+        std::mutex mutex_;
+        std::deque<Task> tasks_[PRIORITY_NUM];
+    };
+
+    // the pool and worker index of the calling thread, nullptr if it is not a worker
+    struct WorkerIdentity {
+        const WorkStealingThreadPool* pool_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    static WorkerIdentity&
+    CurrentWorker() {
+        static thread_local WorkerIdentity identity;
+        return identity;
+    }
+
+    void
+    Push(Priority priority, Task task);
+
+    bool
+    Take(size_t index, Task& task);
+
+    void
+    Run(size_t index);
+
+ private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_worker_{0};
+
+    // tasks queued and not taken yet, changed under the lock of the deque holding the task
+    std::atomic<int64_t> pending_{0};
+
+    // idle workers sleep here until a task is pushed or the pool stops
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+
+    QueueDepthProbe depth_probe_;
+};
+
+inline WorkStealingThreadPool::WorkStealingThreadPool(size_t threads, const std::string& name) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+    if (!name.empty()) {
+        depth_probe_.Set("thread_pool." + name, [this] { return pending_.load(); });
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] { Run(i); });
+    }
+}
+
+template <class F, class... Args>
+auto
+WorkStealingThreadPool::enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
+    return enqueue_priority(Priority::NORMAL, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args>
+auto
+WorkStealingThreadPool::enqueue_priority(Priority priority, F&& f, Args&&... args)
+    -> std::future<typename std::result_of<F(Args...)>::type> {
+    using return_type = typename std::result_of<F(Args...)>::type;
+
+    auto task = std::make_shared<std::packaged_task<return_type()> >(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    std::future<return_type> res = task->get_future();
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        fiu_do_on("WorkStealingThreadPool.enqueue.stop_is_true", stop_ = true);
+        // don't allow enqueueing after stopping the pool
+        if (stop_) {
+            throw std::runtime_error("enqueue on stopped WorkStealingThreadPool");
+        }
+    }
+
+    Push(priority, [task]() { (*task)(); });
+    return res;
+}
+
+inline void
+WorkStealingThreadPool::Push(Priority priority, Task task) {
+    auto& identity = CurrentWorker();
+    size_t index = (identity.pool_ == this) ? identity.index_ : next_worker_++ % workers_.size();
+    {
+        auto& worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        worker.tasks_[static_cast<size_t>(priority)].emplace_back(std::move(task));
+        ++pending_;
+    }
+
+    // a worker checks pending_ under the sleep lock before it waits, taking the lock here orders the two
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    sleep_cv_.notify_one();
+}
+
+inline bool
+WorkStealingThreadPool::Take(size_t index, Task& task) {
+    for (size_t priority = 0; priority < PRIORITY_NUM; ++priority) {
+        {
+            auto& own = *workers_[index];
+            std::lock_guard<std::mutex> lock(own.mutex_);
+            auto& tasks = own.tasks_[priority];
+            if (!tasks.empty()) {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                --pending_;
+                return true;
+            }
+        }
+        for (size_t i = 1; i < workers_.size(); ++i) {
+            auto& victim = *workers_[(index + i) % workers_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex_);
+            auto& tasks = victim.tasks_[priority];
+            if (!tasks.empty()) {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+                --pending_;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline void
+WorkStealingThreadPool::Run(size_t index) {
+    auto& identity = CurrentWorker();
+    identity.pool_ = this;
+    identity.index_ = index;
+
+    for (;;) {
+        Task task;
+        if (Take(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+        // the queued tasks are finished before the pool stops
+        if (stop_ && pending_.load() == 0) {
+            return;
+        }
+    }
+}
+
+// the destructor runs the queued tasks and joins all threads
+inline WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+}  // namespace milvus
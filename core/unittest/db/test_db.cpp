@@ -14,6 +14,7 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem.hpp>
+#include <fstream>
 #include <random>
 #include <thread>
 
@@ -23,7 +24,9 @@
 #include "db/DB.h"
 #include "db/DBFactory.h"
 #include "db/DBImpl.h"
+#include "db/CollectionBackup.h"
 #include "db/IDGenerator.h"
+#include "db/insert/BulkImportTask.h"
 #include "db/meta/MetaConsts.h"
 #include "db/utils.h"
 #include "utils/CommonUtil.h"
@@ -460,11 +463,34 @@ TEST_F(DBTest, PRELOAD_TEST) {
     int64_t cur_cache_usage = milvus::cache::CpuCacheMgr::GetInstance()->CacheUsage();
     ASSERT_TRUE(prev_cache_usage < cur_cache_usage);
 
+    // files which don't fit in the cache quota of the collection are skipped without being loaded
+    milvus::cache::CpuCacheMgr::GetInstance()->ClearCache();
+    milvus::cache::CpuCacheMgr::GetInstance()->SetCollectionQuota(COLLECTION_NAME, 1, false, {});
+    stat = db_->PreloadCollection(dummy_context_, COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+    milvus::cache::CacheGroupStat cache_stat;
+    ASSERT_TRUE(milvus::cache::CpuCacheMgr::GetInstance()->GetCollectionStat(COLLECTION_NAME, cache_stat));
+    ASSERT_EQ(cache_stat.usage_, 0);
+    ASSERT_EQ(cache_stat.item_count_, 0);
+    milvus::cache::CpuCacheMgr::GetInstance()->RemoveCollectionQuota(COLLECTION_NAME);
+
     FIU_ENABLE_FIU("SqliteMetaImpl.FilesToSearch.throw_exception");
     stat = db_->PreloadCollection(dummy_context_, COLLECTION_NAME);
     ASSERT_FALSE(stat.ok());
     fiu_disable("SqliteMetaImpl.FilesToSearch.throw_exception");
 
+    // the warm up loads the files not searched before in background
+    stat = db_->WarmUp({COLLECTION_NAME});
+    ASSERT_TRUE(stat.ok());
+    milvus::engine::WarmUpProgress progress;
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        stat = db_->GetWarmUpProgress(progress);
+        ASSERT_TRUE(stat.ok());
+    } while (!progress.done_);
+    ASSERT_TRUE(progress.hot_loaded_);
+    ASSERT_GT(progress.total_files_, 0);
+
     // create a partition
     stat = db_->CreatePartition(COLLECTION_NAME, "part0", "0");
     ASSERT_TRUE(stat.ok());
@@ -1222,6 +1248,132 @@ TEST_F(DBTest2, GET_VECTOR_BY_ID_TEST) {
     }
 }
 
+TEST_F(DBTest2, BULK_IMPORT_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, 0, xb);
+
+    // a numpy v1.0 file, the dict padded with spaces to a 64 bytes aligned data
+    std::string npy_path = "/tmp/milvus_test/bulk_import.npy";
+    std::string dict = "{'descr': '<f4', 'fortran_order': False, 'shape': (" + std::to_string(nb) + ", " +
+                       std::to_string(COLLECTION_DIM) + "), }";
+    dict.append((64 - (10 + dict.size() + 1) % 64) % 64, ' ');
+    dict += '\n';
+    {
+        std::ofstream out(npy_path, std::ios::binary);
+        out.write("\x93NUMPY\x01\x00", 8);
+        uint16_t dict_len = dict.size();
+        out.write(reinterpret_cast<const char*>(&dict_len), sizeof(dict_len));
+        out.write(dict.data(), dict.size());
+        out.write(reinterpret_cast<const char*>(xb.float_data_.data()), xb.float_data_.size() * sizeof(float));
+    }
+
+    milvus::engine::BulkImportTask::NpyHeader header;
+    stat = milvus::engine::BulkImportTask::ReadNpyHeader(npy_path, header);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(header.rows_, nb);
+    ASSERT_EQ(header.cols_, COLLECTION_DIM);
+    ASSERT_EQ(header.data_offset_ % 64, 0);
+
+    milvus::engine::IDNumbers ids;
+    stat = db_->BulkImport(dummy_context_, collection_info.collection_id_, "", {npy_path}, ids, false);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(ids.size(), nb);
+
+    // visible without a flush
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(collection_info.collection_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb);
+
+    std::vector<milvus::engine::VectorsData> vectors;
+    stat = db_->GetVectorsByID(collection_info, {ids[nb - 1]}, vectors);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vectors[0].float_data_.size(), COLLECTION_DIM);
+    for (int64_t i = 0; i < COLLECTION_DIM; i++) {
+        ASSERT_FLOAT_EQ(vectors[0].float_data_[i], xb.float_data_[(nb - 1) * COLLECTION_DIM + i]);
+    }
+
+    stat = db_->BulkImport(dummy_context_, collection_info.collection_id_, "", {"/tmp/milvus_test/none.npy"}, ids,
+                           false);
+    ASSERT_FALSE(stat.ok());
+    stat = db_->BulkImport(dummy_context_, collection_info.collection_id_, "not_exist_tag", {npy_path}, ids, false);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest2, EXPORT_IMPORT_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+    std::string partition_tag = "part_tag";
+    stat = db_->CreatePartition(collection_info.collection_id_, "", partition_tag);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, 0, xb);
+    stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    milvus::engine::VectorsData xb2;
+    BuildVectors(nb, 1, xb2);
+    stat = db_->InsertVectors(collection_info.collection_id_, partition_tag, xb2);
+    ASSERT_TRUE(stat.ok());
+
+    std::string backup_dir = "/tmp/milvus_test/backup";
+    stat = db_->ExportCollection(collection_info.collection_id_, backup_dir);
+    ASSERT_TRUE(stat.ok());
+
+    std::string imported = "imported_collection";
+    stat = db_->ImportCollection(imported, backup_dir);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(imported, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, 2 * nb);
+    bool has_partition = false;
+    stat = db_->HasPartition(imported, partition_tag, has_partition);
+    ASSERT_TRUE(has_partition);
+
+    milvus::engine::meta::CollectionSchema imported_info;
+    imported_info.collection_id_ = imported;
+    stat = db_->DescribeCollection(imported_info);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(imported_info.dimension_, COLLECTION_DIM);
+    std::vector<milvus::engine::VectorsData> vectors;
+    stat = db_->GetVectorsByID(imported_info, {xb2.id_array_[0]}, vectors);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vectors[0].float_data_.size(), COLLECTION_DIM);
+    for (int64_t i = 0; i < COLLECTION_DIM; i++) {
+        ASSERT_FLOAT_EQ(vectors[0].float_data_[i], xb2.float_data_[i]);
+    }
+
+    // an existing collection, a corrupted file
+    stat = db_->ImportCollection(imported, backup_dir);
+    ASSERT_FALSE(stat.ok());
+    milvus::engine::CollectionBackup::Manifest manifest;
+    stat = milvus::engine::CollectionBackup::ReadManifest(backup_dir, manifest);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(manifest.segments_.size(), 2);
+    {
+        std::fstream corrupt(backup_dir + "/" + manifest.segments_[0].entries_[0].path_,
+                             std::ios::in | std::ios::out | std::ios::binary);
+        corrupt.write("\xff\xff\xff\xff", 4);
+    }
+    stat = db_->ImportCollection("corrupted_collection", backup_dir);
+    ASSERT_FALSE(stat.ok());
+    bool has_collection = true;
+    db_->HasCollection("corrupted_collection", has_collection);
+    ASSERT_FALSE(has_collection);
+
+    stat = db_->ImportCollection("no_backup", "/tmp/milvus_test/not_exist");
+    ASSERT_FALSE(stat.ok());
+}
+
 TEST_F(DBTest2, GET_VECTOR_BY_ID_INVALID_TEST) {
     fiu_init(0);
 
@@ -1334,6 +1486,210 @@ TEST_F(DBTest2, INSERT_DUPLICATE_ID) {
     ASSERT_TRUE(stat.ok());
 }
 
+TEST_F(DBTest2, RESULT_CACHE_TEST) {
+    auto options = GetOptions();
+    options.result_cache_capacity_ = 16;
+    BuildDB(options);
+
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_schema);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t size = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(size, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush(COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 1;
+    xq.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + COLLECTION_DIM);
+
+    std::vector<std::string> tags;
+    milvus::json json_params = {{"nprobe", 10}};
+    milvus::engine::ResultIds result_ids, cached_ids;
+    milvus::engine::ResultDistances result_distances, cached_distances;
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 10, json_params, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids[0], xb.id_array_[0]);
+
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 10, json_params, xq, cached_ids, cached_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(cached_ids, result_ids);
+    ASSERT_EQ(cached_distances, result_distances);
+
+    // the flushed delete makes the cached result stale
+    stat = db_->DeleteVectors(COLLECTION_NAME, {xb.id_array_[0]});
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush(COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+
+    cached_ids.clear();
+    cached_distances.clear();
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 10, json_params, xq, cached_ids, cached_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_NE(cached_ids[0], xb.id_array_[0]);
+}
+
+TEST_F(DBTest2, SEARCH_COST_TEST) {
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_schema);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t size = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(size, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush(COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 1;
+    xq.float_data_.assign(xb.float_data_.begin(), xb.float_data_.begin() + COLLECTION_DIM);
+
+    std::vector<std::string> tags;
+    milvus::json json_params = {{"nprobe", 10}};
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 10, json_params, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+
+    auto& cost = dummy_context_->Cost();
+    int64_t searched = cost->segments_searched.load();
+    ASSERT_GT(searched, 0);
+    ASSERT_EQ(cost->cache_hits.load() + cost->cache_misses.load(), searched);
+
+    // the segments are in the cache for the second search
+    int64_t hits = cost->cache_hits.load();
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 10, json_params, xq, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(cost->segments_searched.load(), 2 * searched);
+    ASSERT_EQ(cost->cache_hits.load(), hits + searched);
+    ASSERT_EQ(cost->ToJson()["segments_searched"].get<int64_t>(), 2 * searched);
+}
+
+TEST_F(DBTest2, QUERY_COLLECTIONS_TEST) {
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_schema);
+    ASSERT_TRUE(stat.ok());
+    std::string other_name = COLLECTION_NAME + "_other";
+    collection_schema.collection_id_ = other_name;
+    stat = db_->CreateCollection(collection_schema);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t size = 100;
+    milvus::engine::VectorsData xb, xb_other;
+    BuildVectors(size, 0, xb);
+    BuildVectors(size, 1, xb_other);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->InsertVectors(other_name, "", xb_other);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // the first query is a vector of the other collection, the second one of the collection
+    int64_t nq = 2, topk = 5;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = nq;
+    xq.float_data_.assign(xb_other.float_data_.begin() + 10 * COLLECTION_DIM,
+                          xb_other.float_data_.begin() + 11 * COLLECTION_DIM);
+    xq.float_data_.insert(xq.float_data_.end(), xb.float_data_.begin() + 20 * COLLECTION_DIM,
+                          xb.float_data_.begin() + 21 * COLLECTION_DIM);
+
+    milvus::json json_params = {{"nprobe", 10}};
+    std::vector<milvus::engine::ResultIds> result_ids;
+    std::vector<milvus::engine::ResultDistances> result_distances;
+    stat = db_->QueryCollections(dummy_context_, {COLLECTION_NAME, other_name}, topk, json_params, xq, result_ids,
+                                 result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), 2);
+    ASSERT_EQ(result_ids[0].size(), nq * topk);
+    ASSERT_EQ(result_ids[1].size(), nq * topk);
+    ASSERT_EQ(result_ids[1][0], xb_other.id_array_[10]);
+    ASSERT_EQ(result_ids[0][topk], xb.id_array_[20]);
+    for (int64_t j = 0; j < nq * topk; ++j) {
+        ASSERT_LT(result_ids[0][j], (int64_t)size);
+        ASSERT_GE(result_ids[1][j], (int64_t)size);
+    }
+
+    // the collections must match in metric and dimension
+    collection_schema.collection_id_ = COLLECTION_NAME + "_wide";
+    collection_schema.dimension_ = COLLECTION_DIM * 2;
+    stat = db_->CreateCollection(collection_schema);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->QueryCollections(dummy_context_, {COLLECTION_NAME, collection_schema.collection_id_}, topk,
+                                 json_params, xq, result_ids, result_distances);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest2, PARTITION_INDEX_TEST) {
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_schema);
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t PARTITION_COUNT = 3;
+    const int64_t INSERT_BATCH = 100;
+    std::vector<milvus::engine::VectorsData> batches(PARTITION_COUNT + 1);
+    for (int64_t i = 0; i <= PARTITION_COUNT; i++) {
+        BuildVectors(INSERT_BATCH, i, batches[i]);
+    }
+    for (int64_t i = 0; i < PARTITION_COUNT; i++) {
+        std::string partition_tag = "tag_" + std::to_string(i);
+        stat = db_->CreatePartition(COLLECTION_NAME, COLLECTION_NAME + "_" + partition_tag, partition_tag);
+        ASSERT_TRUE(stat.ok());
+        stat = db_->InsertVectors(COLLECTION_NAME, partition_tag, batches[i]);
+        ASSERT_TRUE(stat.ok());
+    }
+    stat = db_->Flush(COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::json json_params = {{"nprobe", 10}};
+    auto search = [&](const std::vector<std::string>& tags, int64_t batch, milvus::engine::ResultIds& result_ids) {
+        milvus::engine::VectorsData xq;
+        xq.vector_count_ = 1;
+        xq.float_data_.assign(batches[batch].float_data_.begin(),
+                              batches[batch].float_data_.begin() + COLLECTION_DIM);
+        milvus::engine::ResultDistances result_distances;
+        result_ids.clear();
+        return db_->Query(dummy_context_, COLLECTION_NAME, tags, 1, json_params, xq, result_ids, result_distances);
+    };
+
+    // plain tags are looked up, regular expressions matched
+    milvus::engine::ResultIds result_ids;
+    stat = search({"tag_1"}, 1, result_ids);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids[0], batches[1].id_array_[0]);
+    stat = search({"tag_[02]"}, 2, result_ids);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids[0], batches[2].id_array_[0]);
+    stat = search({"tag_[02]"}, 1, result_ids);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_NE(result_ids[0], batches[1].id_array_[0]);
+    stat = search({"tag"}, 1, result_ids);
+    ASSERT_FALSE(stat.ok());
+
+    // a partition created after the index was loaded is found
+    stat = db_->CreatePartition(COLLECTION_NAME, COLLECTION_NAME + "_new", "new");
+    ASSERT_TRUE(stat.ok());
+    stat = db_->InsertVectors(COLLECTION_NAME, "new", batches[PARTITION_COUNT]);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush(COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+    stat = search({"new"}, PARTITION_COUNT, result_ids);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids[0], batches[PARTITION_COUNT].id_array_[0]);
+
+    // and a dropped one is not
+    stat = db_->DropPartitionByTag(COLLECTION_NAME, "new");
+    ASSERT_TRUE(stat.ok());
+    stat = search({"new"}, PARTITION_COUNT, result_ids);
+    ASSERT_FALSE(stat.ok());
+}
+
 /*
 TEST_F(DBTest2, SEARCH_WITH_DIFFERENT_INDEX) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
@@ -15,6 +15,7 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <random>
 #include <thread>
 
@@ -711,6 +712,33 @@ TEST_F(DeleteTest, delete_add_auto_flush) {
     ASSERT_EQ(result_distances[0], std::numeric_limits<float>::max());
 }
 
+TEST(DeleteApplyTest, find_deleted_offsets) {
+    std::vector<milvus::segment::offset_t> offsets;
+
+    // ascending uids, few ids among many uids and the other way round
+    std::vector<milvus::segment::doc_id_t> uids(10000);
+    std::iota(uids.begin(), uids.end(), 100);
+    milvus::engine::MemTable::FindDeletedOffsets(uids, {0, 100, 5000, 10099, 20000}, offsets);
+    ASSERT_EQ(offsets, std::vector<milvus::segment::offset_t>({0, 4900, 9999}));
+
+    std::vector<milvus::segment::doc_id_t> ids;
+    for (milvus::segment::doc_id_t id = -50000; id < 50000; id += 2) {
+        ids.push_back(id);
+    }
+    milvus::engine::MemTable::FindDeletedOffsets(uids, ids, offsets);
+    ASSERT_EQ(offsets.size(), 5000);
+    ASSERT_EQ(offsets.front(), 0);
+    ASSERT_EQ(offsets.back(), 9998);
+
+    // shuffled uids with a duplicate, the offsets come back ascending
+    uids = {7, 3, 9, 3, 1, 12};
+    milvus::engine::MemTable::FindDeletedOffsets(uids, {3, 9, 10, 12}, offsets);
+    ASSERT_EQ(offsets, std::vector<milvus::segment::offset_t>({1, 2, 3, 5}));
+
+    milvus::engine::MemTable::FindDeletedOffsets(uids, {}, offsets);
+    ASSERT_TRUE(offsets.empty());
+}
+
 TEST_F(CompactTest, compact_basic) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
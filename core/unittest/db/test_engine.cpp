@@ -11,11 +11,18 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <memory>
+#include <random>
 #include <vector>
 
+#include "cache/CpuCacheMgr.h"
 #include "db/engine/EngineFactory.h"
 #include "db/engine/ExecutionEngineImpl.h"
 #include "db/utils.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
+#include "knowhere/index/vector_index/IndexPreprocessed.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include <fiu-local.h>
 #include <fiu-control.h>
 
@@ -222,6 +229,153 @@ TEST_F(EngineTest, ENGINE_IMPL_TEST) {
 #endif
 }
 
+TEST_F(EngineTest, ENGINE_PREPROCESS_TEST) {
+    namespace knowhere = milvus::knowhere;
+    milvus::json conf = {{knowhere::meta::DIM, DIMENSION},
+                         {knowhere::meta::ROWS, ROW_COUNT},
+                         {knowhere::IndexParams::nlist, 10},
+                         {knowhere::IndexParams::m, 16},
+                         {knowhere::Metric::TYPE, knowhere::Metric::L2},
+                         {knowhere::IndexParams::preprocess, "PCA32"}};
+
+    // the adapters check the transforms and the params of the index behind them against their output
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(knowhere::IndexEnum::INDEX_FAISS_IVFPQ);
+    auto check_conf = conf;
+    ASSERT_TRUE(adapter->CheckTrain(check_conf, knowhere::IndexMode::MODE_CPU));
+    check_conf = conf;
+    check_conf[knowhere::IndexParams::preprocess] = "PCA48";
+    check_conf[knowhere::IndexParams::m] = 32;
+    ASSERT_FALSE(adapter->CheckTrain(check_conf, knowhere::IndexMode::MODE_CPU));
+    check_conf = conf;
+    check_conf[knowhere::IndexParams::preprocess] = "PCA128";
+    ASSERT_FALSE(adapter->CheckTrain(check_conf, knowhere::IndexMode::MODE_CPU));
+    check_conf = conf;
+    check_conf[knowhere::IndexParams::shared_quantizer] = true;
+    ASSERT_FALSE(adapter->CheckTrain(check_conf, knowhere::IndexMode::MODE_CPU));
+    check_conf = conf;
+    ASSERT_FALSE(adapter->CheckTrain(check_conf, knowhere::IndexMode::MODE_GPU));
+    adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP);
+    check_conf = conf;
+    check_conf[knowhere::Metric::TYPE] = knowhere::Metric::HAMMING;
+    ASSERT_FALSE(adapter->CheckTrain(check_conf, knowhere::IndexMode::MODE_CPU));
+
+    // the factory puts the transforms in front of the index, and back when it loads the index
+    auto& factory = knowhere::VecIndexFactory::GetInstance();
+    auto index = factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IDMAP, conf);
+    auto preprocessed = std::dynamic_pointer_cast<knowhere::PreprocessedIndex>(index);
+    ASSERT_NE(preprocessed, nullptr);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+    std::vector<float> data(ROW_COUNT * DIMENSION);
+    std::vector<int64_t> ids(ROW_COUNT);
+    for (int64_t i = 0; i < ROW_COUNT; i++) {
+        ids[i] = i;
+        for (uint16_t k = 0; k < DIMENSION; k++) {
+            data[i * DIMENSION + k] = dis(gen);
+        }
+    }
+    index->BuildAll(knowhere::GenDatasetWithIds(ROW_COUNT, DIMENSION, data.data(), ids.data()), conf);
+    ASSERT_EQ(index->Dim(), DIMENSION);
+    ASSERT_EQ(preprocessed->GetIndex()->Dim(), 32);
+    ASSERT_EQ(index->Count(), ROW_COUNT);
+
+    const int64_t nq = 10;
+    conf[knowhere::meta::TOPK] = 1;
+    auto check_self_hits = [&](const knowhere::VecIndexPtr& search_index) {
+        auto result = search_index->Query(knowhere::GenDataset(nq, DIMENSION, data.data()), conf);
+        auto res_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        for (int64_t i = 0; i < nq; i++) {
+            ASSERT_EQ(res_ids[i], i);
+        }
+        free(res_ids);
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+    };
+    check_self_hits(index);
+
+    auto binary_set = index->Serialize(conf);
+    auto loaded = factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IDMAP, binary_set);
+    ASSERT_NE(std::dynamic_pointer_cast<knowhere::PreprocessedIndex>(loaded), nullptr);
+    loaded->Load(binary_set);
+    ASSERT_EQ(loaded->Dim(), DIMENSION);
+    check_self_hits(loaded);
+
+    conf.erase(knowhere::IndexParams::preprocess);
+    index = factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IDMAP, conf);
+    ASSERT_EQ(std::dynamic_pointer_cast<knowhere::PreprocessedIndex>(index), nullptr);
+    knowhere::BinarySet empty_set;
+    index = factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IDMAP, empty_set);
+    ASSERT_EQ(std::dynamic_pointer_cast<knowhere::PreprocessedIndex>(index), nullptr);
+
+#ifndef MILVUS_GPU_VERSION
+    // the engine builds the index of the collection behind its transforms
+    milvus::json index_params = {{"nlist", 10}, {"m", 16}, {"preprocess", "OPQ16"}};
+    auto engine_ptr = CreateExecEngine(index_params);
+    auto engine_build = engine_ptr->BuildIndex("/tmp/milvus_index_6", milvus::engine::EngineType::FAISS_PQ);
+    ASSERT_NE(engine_build, nullptr);
+    ASSERT_EQ(engine_build->Count(), ROW_COUNT);
+#endif
+}
+
+TEST_F(EngineTest, ENGINE_HNSW_CHECKPOINT_TEST) {
+    fiu_init(0);
+    namespace knowhere = milvus::knowhere;
+
+    constexpr int64_t nb = 1000;
+    std::default_random_engine random(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> data(nb * DIMENSION);
+    std::vector<int64_t> ids(nb);
+    for (auto& value : data) {
+        value = distribution(random);
+    }
+    for (int64_t i = 0; i < nb; ++i) {
+        ids[i] = 100000 + i;
+    }
+
+    milvus::json index_params = {{knowhere::IndexParams::M, 16}, {knowhere::IndexParams::efConstruction, 200}};
+    auto engine_ptr = milvus::engine::EngineFactory::Build(DIMENSION, "/tmp/milvus_index_hnsw_raw",
+                                                           milvus::engine::EngineType::FAISS_IDMAP,
+                                                           milvus::engine::MetricType::L2, index_params);
+    ASSERT_TRUE(engine_ptr->AddWithIds(nb, data.data(), ids.data()).ok());
+
+    // every vector must find itself, a round adding the vectors of another one breaks that for its rows
+    auto self_hits = [&](const milvus::engine::ExecutionEnginePtr& engine) {
+        engine->Cache();
+        auto index = std::static_pointer_cast<knowhere::VecIndex>(
+            milvus::cache::CpuCacheMgr::GetInstance()->GetIndex(engine->GetLocation()));
+        milvus::json conf = {{knowhere::meta::TOPK, 1}, {knowhere::IndexParams::ef, 64}};
+        auto result = index->Query(knowhere::GenDataset(nb, DIMENSION, data.data()), conf);
+        auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        int64_t hits = 0;
+        for (int64_t i = 0; i < nb; ++i) {
+            hits += result_ids[i] == ids[i] ? 1 : 0;
+        }
+        return hits;
+    };
+
+    // built at once
+    auto single_shot = engine_ptr->BuildIndex("/tmp/milvus_index_hnsw_1", milvus::engine::EngineType::HNSW);
+    ASSERT_NE(single_shot, nullptr);
+    int64_t single_shot_hits = self_hits(single_shot);
+    ASSERT_GE(single_shot_hits, nb * 95 / 100);
+
+    // built in rounds of 100 rows, a checkpoint after each, the first build is interrupted after its first one
+    fiu_enable("ExecutionEngineImpl.BuildWithCheckpoints.small_rounds", 1, NULL, 0);
+    fiu_enable("ExecutionEngineImpl.BuildWithCheckpoints.interrupt", 1, NULL, 0);
+    ASSERT_ANY_THROW(engine_ptr->BuildIndex("/tmp/milvus_index_hnsw_2", milvus::engine::EngineType::HNSW));
+    fiu_disable("ExecutionEngineImpl.BuildWithCheckpoints.interrupt");
+    std::string checkpoint_path = engine_ptr->GetLocation() + ".build_checkpoint";
+    ASSERT_TRUE(boost::filesystem::exists(checkpoint_path));
+
+    auto resumed = engine_ptr->BuildIndex("/tmp/milvus_index_hnsw_2", milvus::engine::EngineType::HNSW);
+    fiu_disable("ExecutionEngineImpl.BuildWithCheckpoints.small_rounds");
+    ASSERT_NE(resumed, nullptr);
+    ASSERT_EQ(resumed->Count(), nb);
+    ASSERT_FALSE(boost::filesystem::exists(checkpoint_path));
+    ASSERT_GE(self_hits(resumed), single_shot_hits - nb / 100);
+}
+
 TEST_F(EngineTest, ENGINE_IMPL_NULL_INDEX_TEST) {
     uint16_t dimension = 64;
     std::string file_path = "/tmp/milvus_index_1";
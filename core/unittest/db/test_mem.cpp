@@ -9,9 +9,11 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <random>
@@ -23,6 +25,9 @@
 #include "db/Constants.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/insert/MemBufferPool.h"
+#include "db/insert/MemManagerImpl.h"
+#include "db/insert/MemSnapshot.h"
 #include "db/insert/MemTable.h"
 #include "db/insert/MemTableFile.h"
 #include "db/insert/VectorSource.h"
@@ -107,6 +112,73 @@ TEST_F(MemManagerTest, VECTOR_SOURCE_TEST) {
 
     vectors.id_array_ = source.GetVectorIds();
     ASSERT_EQ(vectors.id_array_.size(), 100);
+
+    // a source referring to the caller's buffers adds the same vectors
+    auto view_writer_ptr = std::make_shared<milvus::segment::SegmentWriter>(directory);
+    milvus::engine::VectorSource view_source(n, vectors.id_array_.data(), vectors.float_data_.data());
+    status = view_source.Add(view_writer_ptr, table_file_schema, 60, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 60);
+    status = view_source.Add(view_writer_ptr, table_file_schema, 60, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 40);
+    ASSERT_TRUE(view_source.AllAdded());
+    ASSERT_EQ(view_source.GetVectorIds(), vectors.id_array_);
+
+    milvus::segment::SegmentPtr segment_ptr;
+    view_writer_ptr->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    ASSERT_EQ(data.size(), vectors.float_data_.size() * sizeof(float));
+    ASSERT_EQ(memcmp(data.data(), vectors.float_data_.data(), data.size()), 0);
+}
+
+TEST(MemBufferPoolTest, ACQUIRE_RELEASE_TEST) {
+    auto& pool = milvus::engine::MemBufferPool::GetInstance();
+    pool.SetCapacity(0);
+    ASSERT_EQ(pool.PooledSize(), 0);
+
+    ASSERT_EQ(milvus::engine::MemBufferPool::SizeClass(1), 64 * milvus::engine::KB);
+    ASSERT_EQ(milvus::engine::MemBufferPool::SizeClass(64 * milvus::engine::KB), 64 * milvus::engine::KB);
+    ASSERT_EQ(milvus::engine::MemBufferPool::SizeClass(milvus::engine::MB + 1), 2 * milvus::engine::MB);
+
+    auto buffer = pool.Acquire(milvus::engine::MB - 10);
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(buffer.capacity(), milvus::engine::MB);
+
+    // no capacity, the buffer is freed
+    pool.Release(std::move(buffer));
+    ASSERT_EQ(pool.PooledSize(), 0);
+
+    pool.SetCapacity(2 * milvus::engine::MB);
+    buffer = pool.Acquire(milvus::engine::MB);
+    buffer.resize(100, 1);
+    auto data = buffer.data();
+    pool.Release(std::move(buffer));
+    ASSERT_EQ(pool.PooledSize(), milvus::engine::MB);
+
+    // the pooled buffer is handed out again, empty
+    auto reused = pool.Acquire(milvus::engine::MB / 2 + 1);
+    ASSERT_EQ(reused.data(), data);
+    ASSERT_TRUE(reused.empty());
+    ASSERT_EQ(pool.PooledSize(), 0);
+
+    // a buffer that isn't of a size class is not pooled
+    std::vector<uint8_t> odd(3 * milvus::engine::MB);
+    pool.Release(std::move(odd));
+    ASSERT_EQ(pool.PooledSize(), 0);
+
+    auto another = pool.Acquire(milvus::engine::MB);
+    pool.Release(std::move(reused));
+    pool.Release(std::move(another));
+    ASSERT_EQ(pool.PooledSize(), 2 * milvus::engine::MB);
+    // full
+    pool.Release(pool.Acquire(2 * milvus::engine::MB));
+    ASSERT_EQ(pool.PooledSize(), 2 * milvus::engine::MB);
+
+    pool.SetCapacity(milvus::engine::MB);
+    ASSERT_EQ(pool.PooledSize(), milvus::engine::MB);
+    pool.SetCapacity(0);
+    ASSERT_EQ(pool.PooledSize(), 0);
 }
 
 TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
@@ -173,6 +245,50 @@ TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
     }
 }
 
+TEST_F(MemManagerTest, MEM_TABLE_FILE_GET_BY_ID_TEST) {
+    auto options = GetOptions();
+
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto status = impl_->CreateCollection(collection_schema);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::MemTableFile mem_table_file(GetCollectionName(), impl_, options);
+
+    int64_t nb = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; ++i) {
+        xb.id_array_.push_back(i + 1000);
+    }
+    auto source = std::make_shared<milvus::engine::VectorSource>(xb);
+    status = mem_table_file.Add(source);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::IDNumbers ids = {1010, 7, 1099};
+    std::vector<milvus::engine::VectorsData> vectors(ids.size());
+    mem_table_file.GetVectorsByID(ids, vectors);
+    ASSERT_EQ(vectors[0].vector_count_, 1);
+    ASSERT_EQ(vectors[1].vector_count_, 0);
+    ASSERT_EQ(vectors[2].vector_count_, 1);
+    auto row = [&](int64_t i) {
+        return std::vector<float>(xb.float_data_.begin() + i * COLLECTION_DIM,
+                                  xb.float_data_.begin() + (i + 1) * COLLECTION_DIM);
+    };
+    ASSERT_EQ(vectors[0].float_data_, row(10));
+    ASSERT_EQ(vectors[2].float_data_, row(99));
+
+    // the rows after a deleted one shift, the offsets follow
+    status = mem_table_file.Delete(1005);
+    ASSERT_TRUE(status.ok());
+    ids = {1005, 1010, 1099};
+    vectors.clear();
+    vectors.resize(ids.size());
+    mem_table_file.GetVectorsByID(ids, vectors);
+    ASSERT_EQ(vectors[0].vector_count_, 0);
+    ASSERT_EQ(vectors[1].float_data_, row(10));
+    ASSERT_EQ(vectors[2].float_data_, row(99));
+}
+
 TEST_F(MemManagerTest, MEM_TABLE_TEST) {
     auto options = GetOptions();
 
@@ -244,6 +360,36 @@ TEST_F(MemManagerTest, MEM_TABLE_TEST) {
     fiu_disable("SqliteMetaImpl.UpdateCollectionFiles.throw_exception");
 }
 
+TEST_F(MemManagerTest, FLUSH_CANDIDATES_TEST) {
+    auto options = GetOptions();
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    ASSERT_TRUE(impl_->CreateCollection(collection_schema).ok());
+    std::string small_collection = GetCollectionName() + "_small";
+    collection_schema.collection_id_ = small_collection;
+    ASSERT_TRUE(impl_->CreateCollection(collection_schema).ok());
+
+    milvus::engine::MemManagerImpl mem_mgr(impl_, options);
+    milvus::engine::VectorsData large, small;
+    BuildVectors(300, large);
+    BuildVectors(100, small);
+    for (int64_t i = 0; i < 300; i++) {
+        large.id_array_.push_back(i);
+    }
+    small.id_array_.assign(large.id_array_.begin(), large.id_array_.begin() + 100);
+    auto status = mem_mgr.InsertVectors(small_collection, 100, small.id_array_.data(), COLLECTION_DIM,
+                                        small.float_data_.data(), 1);
+    ASSERT_TRUE(status.ok());
+    status = mem_mgr.InsertVectors(GetCollectionName(), 300, large.id_array_.data(), COLLECTION_DIM,
+                                   large.float_data_.data(), 2);
+    ASSERT_TRUE(status.ok());
+
+    // the largest mem table is flushed first, the next ones only if it doesn't free enough
+    ASSERT_TRUE(mem_mgr.FlushCandidates(0).empty());
+    ASSERT_EQ(mem_mgr.FlushCandidates(1), std::vector<std::string>({GetCollectionName()}));
+    ASSERT_EQ(mem_mgr.FlushCandidates(mem_mgr.GetCurrentMem()),
+              std::vector<std::string>({GetCollectionName(), small_collection}));
+}
+
 TEST_F(MemManagerTest2, SERIAL_INSERT_SEARCH_TEST) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
@@ -448,6 +594,33 @@ TEST_F(MemManagerTest2, INSERT_BINARY_TEST) {
 //    search.join();
 //}
 
+TEST_F(MemManagerTest2, PARALLEL_FLUSH_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t PARTITION_COUNT = 20;
+    const int64_t nb = 100;
+    for (int64_t i = 0; i < PARTITION_COUNT; i++) {
+        std::string partition_tag = std::to_string(i);
+        stat = db_->CreatePartition(GetCollectionName(), GetCollectionName() + "_" + partition_tag, partition_tag);
+        ASSERT_TRUE(stat.ok());
+
+        milvus::engine::VectorsData xb;
+        BuildVectors(nb, xb);
+        stat = db_->InsertVectors(GetCollectionName(), partition_tag, xb);
+        ASSERT_TRUE(stat.ok());
+    }
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(GetCollectionName(), row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb * PARTITION_COUNT);
+}
+
 TEST_F(MemManagerTest2, VECTOR_IDS_TEST) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
@@ -511,3 +684,46 @@ TEST_F(MemManagerTest2, VECTOR_IDS_TEST) {
         ASSERT_EQ(xb.id_array_[i], i + nb);
     }
 }
+
+TEST_F(MemManagerTest, MEM_SNAPSHOT_TEST) {
+    const int64_t nb = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+
+    milvus::engine::MemSnapshot snapshot;
+    milvus::engine::MemSnapshot::Part part;
+    part.collection_id_ = GetCollectionName();
+    part.dimension_ = COLLECTION_DIM;
+    part.vectors_ = xb.float_data_;
+    for (int64_t i = 0; i < nb; ++i) {
+        part.uids_.push_back(i + 1000);
+    }
+    snapshot.AddPart(std::move(part));
+    snapshot.AddPart(milvus::engine::MemSnapshot::Part());
+    ASSERT_FALSE(snapshot.Empty());
+    ASSERT_EQ(snapshot.RowCount(), nb);
+
+    const uint64_t k = 5;
+    milvus::engine::VectorsData query;
+    query.vector_count_ = 1;
+    query.float_data_.assign(xb.float_data_.begin() + 10 * COLLECTION_DIM,
+                             xb.float_data_.begin() + 11 * COLLECTION_DIM);
+
+    // the segments found the same vector, it is counted once
+    milvus::engine::ResultIds result_ids = {1010, 7, -1, -1, -1};
+    milvus::engine::ResultDistances result_distances = {0.0, 1.0, 0.0, 0.0, 0.0};
+    auto status = snapshot.Search(k, query, result_ids, result_distances);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result_ids.size(), k);
+    ASSERT_EQ(result_ids[0], 1010);
+    ASSERT_EQ(std::count(result_ids.begin(), result_ids.end(), 1010), 1);
+    ASSERT_NE(std::find(result_ids.begin(), result_ids.end(), 7), result_ids.end());
+
+    // nothing from the segments
+    result_ids.clear();
+    result_distances.clear();
+    status = snapshot.Search(k, query, result_ids, result_distances);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result_ids.size(), k);
+    ASSERT_EQ(result_ids[0], 1010);
+}
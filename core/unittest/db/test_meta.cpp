@@ -10,7 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/Constants.h"
+#include "db/ReplicaTailer.h"
 #include "db/Utils.h"
+#include "db/meta/CachedMetaImpl.h"
 #include "db/meta/MetaConsts.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/utils.h"
@@ -21,6 +23,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <boost/filesystem/operations.hpp>
+#include <thread>
 
 TEST_F(MetaTest, COLLECTION_TEST) {
     auto collection_id = "meta_test_table";
@@ -422,6 +425,41 @@ TEST_F(MetaTest, HYBRID_COLLECTION_TEST) {
     ASSERT_EQ(describe_fields.fields_schema_.size(), 2);
 }
 
+TEST_F(MetaTest, FIELDS_STATS_TEST) {
+    milvus::engine::meta::hybrid::FieldStatsSchema stats;
+    stats.collection_id_ = "meta_test_stats";
+    stats.segment_id_ = "segment_0";
+    stats.field_name_ = "field_0";
+    stats.field_type_ = (int32_t)milvus::engine::meta::hybrid::DataType::INT64;
+    stats.row_count_ = 100;
+    stats.min_value_ = "-5";
+    stats.max_value_ = "500";
+    milvus::engine::meta::hybrid::FieldsStatsSchema fields_stats = {stats};
+    stats.segment_id_ = "segment_1";
+    fields_stats.push_back(stats);
+    auto status = impl_->UpdateFieldsStats(fields_stats);
+    ASSERT_TRUE(status.ok());
+
+    // the stats of a segment are replaced as a whole
+    stats.segment_id_ = "segment_0";
+    stats.max_value_ = "600";
+    status = impl_->UpdateFieldsStats({stats});
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::hybrid::FieldsStatsSchema loaded;
+    status = impl_->GetFieldsStats({"segment_0", "segment_2"}, loaded);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(loaded.size(), 1);
+    ASSERT_EQ(loaded[0].field_name_, "field_0");
+    ASSERT_EQ(loaded[0].row_count_, 100);
+    ASSERT_EQ(loaded[0].min_value_, "-5");
+    ASSERT_EQ(loaded[0].max_value_, "600");
+
+    status = impl_->GetFieldsStats({"segment_0", "segment_1"}, loaded);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(loaded.size(), 2);
+}
+
 TEST_F(MetaTest, COLLECTION_FILE_ROW_COUNT_TEST) {
     auto collection_id = "row_count_test_table";
 
@@ -794,3 +832,269 @@ TEST_F(MetaTest, LSN_TEST) {
     status = impl_->GetGlobalLastLSN(temp_lsb);
     ASSERT_EQ(temp_lsb, lsn);
 }
+
+TEST_F(MetaTest, FLUSHED_FILES_TEST) {
+    auto collection_id = "flushed_files_test";
+    uint64_t lsn = 42949672960;
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    auto status = impl_->CreateCollection(collection);
+
+    milvus::engine::meta::SegmentSchema table_file;
+    table_file.collection_id_ = collection_id;
+    status = impl_->CreateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+
+    table_file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+    table_file.row_count_ = 100;
+    milvus::engine::meta::SegmentsSchema table_files = {table_file};
+    status = impl_->UpdateCollectionFilesAndFlushLSN(table_files, {collection_id}, lsn);
+    ASSERT_TRUE(status.ok());
+
+    uint64_t temp_lsn = 0;
+    status = impl_->GetCollectionFlushLSN(collection_id, temp_lsn);
+    ASSERT_EQ(temp_lsn, lsn);
+
+    uint64_t cnt = 0;
+    status = impl_->Count(collection_id, cnt);
+    ASSERT_EQ(cnt, 100UL);
+}
+
+TEST_F(MetaTest, CACHED_META_TEST) {
+    auto collection_id = "cached_meta_test";
+    auto cached = std::make_shared<milvus::engine::meta::CachedMetaImpl>(impl_, 60000);
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    auto status = cached->CreateCollection(collection);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentSchema table_file;
+    table_file.collection_id_ = collection_id;
+    status = cached->CreateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+    table_file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+    status = cached->UpdateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = cached->FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+    }
+
+    // a write the cache doesn't see, the cached files are returned until the ttl expires
+    auto hidden_file = table_file;
+    hidden_file.file_type_ = milvus::engine::meta::SegmentSchema::TO_DELETE;
+    status = impl_->UpdateCollectionFile(hidden_file);
+    ASSERT_TRUE(status.ok());
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = cached->FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+
+        // the holders share the cached descriptors
+        milvus::engine::meta::FilesHolder other_holder;
+        status = cached->FilesToSearch(collection_id, other_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(other_holder.HoldDescs().size(), 1UL);
+        ASSERT_EQ(other_holder.HoldDescs()[0], files_holder.HoldDescs()[0]);
+
+        other_holder.UnmarkFile(*other_holder.HoldDescs()[0]);
+        ASSERT_TRUE(other_holder.HoldDescs().empty());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+    }
+
+    // a write through the cache drops the collection at once
+    table_file.file_type_ = milvus::engine::meta::SegmentSchema::INDEX;
+    status = cached->UpdateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = cached->FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+        ASSERT_EQ(files_holder.HoldFiles()[0].file_type_, (int32_t)milvus::engine::meta::SegmentSchema::INDEX);
+    }
+
+    std::set<std::string> partitions = {collection_id};
+    status = impl_->UpdateCollectionFile(hidden_file);
+    ASSERT_TRUE(status.ok());
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = cached->FilesToSearchEx(collection_id, partitions, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+    }
+
+    // other nodes' writes are seen after the ttl
+    auto polled = std::make_shared<milvus::engine::meta::CachedMetaImpl>(impl_, 1);
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = polled->FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 0UL);
+    }
+    status = impl_->UpdateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = polled->FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+    }
+}
+
+TEST_F(MetaTest, CACHED_COUNT_TEST) {
+    auto collection_id = "cached_count_test";
+    auto cached = std::make_shared<milvus::engine::meta::CachedMetaImpl>(impl_, 60000);
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    auto status = cached->CreateCollection(collection);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentSchema table_file;
+    table_file.collection_id_ = collection_id;
+    status = cached->CreateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+    table_file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+    table_file.row_count_ = 100;
+    status = cached->UpdateCollectionFile(table_file);
+    ASSERT_TRUE(status.ok());
+
+    uint64_t count = 0;
+    status = cached->Count(collection_id, count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(count, 100UL);
+
+    // the count is summed from the cached files until a write through the cache
+    milvus::engine::meta::SegmentsSchema files = {table_file};
+    files[0].row_count_ = 60;
+    status = impl_->UpdateCollectionFilesRowCount(files);
+    ASSERT_TRUE(status.ok());
+    status = cached->Count(collection_id, count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(count, 100UL);
+
+    status = cached->UpdateCollectionFilesRowCount(files);
+    ASSERT_TRUE(status.ok());
+    status = cached->Count(collection_id, count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(count, 60UL);
+
+    status = cached->Count("not_found", count);
+    ASSERT_FALSE(status.ok());
+
+    // the partitions are cached the same way
+    std::vector<milvus::engine::meta::CollectionSchema> partitions;
+    status = cached->ShowPartitions(collection_id, partitions);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(partitions.empty());
+
+    status = impl_->CreatePartition(collection_id, "hidden_partition", "hidden", 0);
+    ASSERT_TRUE(status.ok());
+    status = cached->ShowPartitions(collection_id, partitions);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(partitions.empty());
+
+    status = cached->CreatePartition(collection_id, "cached_partition", "cached", 0);
+    ASSERT_TRUE(status.ok());
+    status = cached->ShowPartitions(collection_id, partitions);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(partitions.size(), 2UL);
+}
+
+TEST_F(MetaTest, REPLICA_TAILER_TEST) {
+    auto collection_id = "replica_tailer_test";
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    auto status = impl_->CreateCollection(collection);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentSchema raw_file;
+    raw_file.collection_id_ = collection_id;
+    status = impl_->CreateCollectionFile(raw_file);
+    ASSERT_TRUE(status.ok());
+    raw_file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+    status = impl_->UpdateCollectionFile(raw_file);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentsSchema updated;
+    status = impl_->FilesUpdatedSince(0, updated);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(updated.size(), 1UL);
+    ASSERT_EQ(updated[0].dimension_, collection.dimension_);
+
+    size_t loaded = 0;
+    auto loader = [&](const milvus::engine::meta::SegmentsSchema& files) {
+        loaded += files.size();
+        return milvus::Status::OK();
+    };
+    milvus::engine::ReplicaTailer tailer(impl_, loader);
+    ASSERT_FALSE(tailer.Ready());
+
+    // the files found by the first refresh are not loaded
+    status = tailer.Refresh();
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(tailer.Ready());
+    ASSERT_EQ(loaded, 0UL);
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = tailer.FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+    }
+
+    // an index file replaces the raw one, only the index file is loaded
+    milvus::engine::meta::SegmentSchema index_file;
+    index_file.collection_id_ = collection_id;
+    status = impl_->CreateCollectionFile(index_file);
+    ASSERT_TRUE(status.ok());
+    index_file.file_type_ = milvus::engine::meta::SegmentSchema::INDEX;
+    raw_file.file_type_ = milvus::engine::meta::SegmentSchema::TO_DELETE;
+    milvus::engine::meta::SegmentsSchema files = {index_file, raw_file};
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+
+    // the tailer keeps its files until it refreshes
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = tailer.FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+        ASSERT_EQ(files_holder.HoldFiles()[0].id_, raw_file.id_);
+    }
+
+    status = tailer.Refresh();
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(loaded, 1UL);
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = tailer.FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+        ASSERT_EQ(files_holder.HoldFiles()[0].id_, index_file.id_);
+    }
+
+    // the files refreshed again are applied once
+    status = tailer.Refresh();
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(loaded, 1UL);
+
+    fiu_enable("SqliteMetaImpl.FilesUpdatedSince.throw_exception", 1, NULL, 0);
+    status = tailer.Refresh();
+    ASSERT_FALSE(status.ok());
+    fiu_disable("SqliteMetaImpl.FilesUpdatedSince.throw_exception");
+    {
+        milvus::engine::meta::FilesHolder files_holder;
+        status = tailer.FilesToSearch(collection_id, files_holder);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(files_holder.HoldFiles().size(), 1UL);
+    }
+}
@@ -11,16 +11,52 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <set>
 #include <thread>
 #include <vector>
 
+#include "codecs/DeletedDocsFile.h"
+#include "codecs/default/BlockedIdBloomFilterFormat.h"
+#include "codecs/default/DefaultIdIndexFormat.h"
+#include "codecs/default/DefaultVectorSummaryFormat.h"
+#include "db/BuildThrottle.h"
+#include "db/FileGC.h"
 #include "db/IDGenerator.h"
+#include "db/IndexBuildTracker.h"
 #include "db/IndexFailedChecker.h"
 #include "db/Options.h"
+#include "db/PartitionKey.h"
+#include "db/RecallSampler.h"
+#include "db/SegmentAccessLog.h"
+#include "db/StorageTier.h"
 #include "db/Utils.h"
+#include "db/engine/AttrFilter.h"
 #include "db/engine/EngineFactory.h"
+#include "db/engine/HybridSearchPlan.h"
+#include "db/engine/IndexTuner.h"
+#include "db/merge/CompactionPolicy.h"
 #include "db/meta/SqliteMetaImpl.h"
+#include "faiss/BuilderSuspend.h"
+#include "faiss/utils/ConcurrentBitset.h"
+#include "knowhere/index/structured_index/StructuredIndexSort.h"
+#include "query/BinaryQuery.h"
+#include "segment/AttrZoneMap.h"
+#include "segment/BlockedBloomFilter.h"
+#include "segment/DeletedDocs.h"
+#include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
+#include "segment/RoaringBitmap.h"
+#include "segment/VectorSummary.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskOperation.h"
 #include "utils/Exception.h"
 #include "utils/Status.h"
 
@@ -143,6 +179,22 @@ TEST(DBMiscTest, UTILS_TEST) {
     status = milvus::engine::utils::DeleteSegment(options, file);
 }
 
+TEST(DBMiscTest, COLLECTION_TTL_TEST) {
+    int64_t flag = milvus::engine::meta::FLAG_MASK_HAS_USERID;
+    flag = milvus::engine::utils::SetCollectionTTL(flag, 30);
+    ASSERT_EQ(milvus::engine::utils::GetCollectionTTL(flag), 30);
+    ASSERT_NE(flag & milvus::engine::meta::FLAG_MASK_HAS_USERID, 0);
+    flag = milvus::engine::utils::SetCollectionTTL(flag, 0);
+    ASSERT_EQ(flag, milvus::engine::meta::FLAG_MASK_HAS_USERID);
+
+    // the dates expire by days, across the ends of months and years
+    auto today = milvus::engine::utils::GetDate();
+    auto month_ago = milvus::engine::utils::GetDateWithDelta(-30);
+    ASSERT_LT(month_ago, today);
+    ASSERT_EQ(milvus::engine::utils::GetDateDays(today) - milvus::engine::utils::GetDateDays(month_ago), 30);
+    ASSERT_EQ(milvus::engine::utils::GetDateDays(1210001) - milvus::engine::utils::GetDateDays(1201131), 1);
+}
+
 TEST(DBMiscTest, SAFE_ID_GENERATOR_TEST) {
     milvus::engine::SafeIDGenerator& generator = milvus::engine::SafeIDGenerator::GetInstance();
     size_t n = 1000000;
@@ -159,6 +211,54 @@ TEST(DBMiscTest, SAFE_ID_GENERATOR_TEST) {
     ASSERT_EQ(ids.size(), unique_ids.size());
 }
 
+TEST(DBMiscTest, SAFE_ID_GENERATOR_CONCURRENT_TEST) {
+    milvus::engine::SafeIDGenerator& generator = milvus::engine::SafeIDGenerator::GetInstance();
+    const size_t thread_num = 8;
+    std::vector<milvus::engine::IDNumbers> thread_ids(thread_num);
+    auto worker = [&](size_t index) {
+        auto& ids = thread_ids[index];
+        for (size_t i = 0; i < 2000; ++i) {
+            // mix requests served by the reserved tick with the ones spanning several ticks
+            size_t n = (i % 100 == 0) ? 2500 : (i % 7 + 1);
+            milvus::engine::IDRange range;
+            ASSERT_TRUE(generator.GetNextIDRange(n, range).ok());
+            ASSERT_EQ(range.count_, n);
+            if (!ids.empty()) {
+                ASSERT_GT(range.begin_, ids.back());
+            }
+            for (size_t k = 0; k < range.count_; ++k) {
+                ids.push_back(range.begin_ + k);
+            }
+            ids.push_back(generator.GetNextIDNumber());
+            ASSERT_GT(ids.back(), ids[ids.size() - 2]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::set<int64_t> unique_ids;
+    size_t total = 0;
+    for (auto& ids : thread_ids) {
+        unique_ids.insert(ids.begin(), ids.end());
+        total += ids.size();
+    }
+    ASSERT_EQ(total, unique_ids.size());
+
+    // ids handed out later are larger than the ones handed out before
+    milvus::engine::IDNumbers ids;
+    ASSERT_TRUE(generator.GetNextIDNumbers(3000, ids).ok());
+    ASSERT_EQ(ids.size(), 3000);
+    ASSERT_GT(ids.front(), *unique_ids.rbegin());
+    ASSERT_TRUE(generator.GetNextIDNumbers(0, ids).ok());
+    ASSERT_TRUE(ids.empty());
+}
+
 TEST(DBMiscTest, CHECKER_TEST) {
     {
         milvus::engine::IndexFailedChecker checker;
@@ -192,6 +292,307 @@ TEST(DBMiscTest, CHECKER_TEST) {
     }
 }
 
+TEST(DBMiscTest, INDEX_BUILD_TRACKER_TEST) {
+    auto& tracker = milvus::engine::IndexBuildTracker::GetInstance();
+    milvus::engine::meta::SegmentSchema schema;
+    schema.id_ = 900001;
+    schema.collection_id_ = "tracked";
+    schema.segment_id_ = "900001";
+    schema.row_count_ = 1000;
+    tracker.Queued(schema);
+
+    milvus::engine::IndexBuildProgress progress;
+    ASSERT_TRUE(tracker.GetBuild(schema.id_, progress));
+    ASSERT_EQ(progress.stage_, milvus::engine::IndexBuildStage::QUEUED);
+    ASSERT_EQ(progress.collection_id_, "tracked");
+    ASSERT_EQ(progress.row_count_, 1000);
+    ASSERT_EQ(progress.rows_indexed_, 0);
+
+    tracker.SetStage(schema.id_, milvus::engine::IndexBuildStage::BUILDING);
+    tracker.SetRowsIndexed(schema.id_, 1000);
+    tracker.SetBytesWritten(schema.id_, 4096);
+    ASSERT_TRUE(tracker.GetBuild(schema.id_, progress));
+    ASSERT_EQ(progress.stage_, milvus::engine::IndexBuildStage::BUILDING);
+    ASSERT_STREQ(milvus::engine::IndexBuildStageName(progress.stage_), "building");
+    ASSERT_EQ(progress.rows_indexed_, 1000);
+    ASSERT_EQ(progress.bytes_written_, 4096);
+    ASSERT_GE(progress.stage_time_, progress.queued_time_);
+
+    tracker.Finished(schema.id_);
+    ASSERT_FALSE(tracker.GetBuild(schema.id_, progress));
+
+    // updates of an unknown build are ignored
+    tracker.SetStage(schema.id_, milvus::engine::IndexBuildStage::SERIALIZING);
+    ASSERT_FALSE(tracker.GetBuild(schema.id_, progress));
+}
+
+TEST(DBMiscTest, RECALL_SAMPLER_TEST) {
+    int64_t hits = 0, expected = 0;
+    // 2 queries of top 3, the second one has only 2 exact results
+    milvus::engine::ResultIds exact_ids = {1, 2, 3, 4, 5, -1};
+    milvus::engine::ResultIds ids = {3, 1, 7, 5, 5, -1};
+    milvus::engine::RecallSampler::CountHits(ids, exact_ids, 3, hits, expected);
+    ASSERT_EQ(hits, 3);
+    ASSERT_EQ(expected, 5);
+
+    milvus::engine::RecallSampler::CountHits(exact_ids, exact_ids, 3, hits, expected);
+    ASSERT_EQ(hits, expected);
+    milvus::engine::RecallSampler::CountHits(ids, exact_ids, 0, hits, expected);
+    ASSERT_EQ(expected, 0);
+
+    milvus::engine::RecallSampler never(0.0);
+    ASSERT_FALSE(never.ShouldSample());
+    milvus::engine::RecallSampler always(1.0);
+    ASSERT_TRUE(always.ShouldSample());
+
+    // searches of raw files only are exact already, they are not sampled
+    milvus::engine::meta::SegmentSchema raw_file;
+    raw_file.id_ = 1;
+    raw_file.collection_id_ = "sampled";
+    raw_file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+    auto files_holder = std::make_shared<milvus::engine::meta::FilesHolder>();
+    files_holder->MarkFile(raw_file);
+    milvus::engine::VectorsData vectors;
+    always.Submit("sampled", files_holder, 3, vectors, ids);
+    always.Stop();
+
+    double recall = 0.0;
+    ASSERT_FALSE(always.GetRecall("sampled", "IDMAP", recall));
+}
+
+TEST(DBMiscTest, INDEX_TUNER_TEST) {
+    using milvus::engine::EngineType;
+    using milvus::engine::IndexTuner;
+
+    // nlist around 4 * sqrt(rows), m of 4 and 8 dimensions per code, no candidate of the types not tuned
+    auto candidates = IndexTuner::Candidates(EngineType::FAISS_IVFFLAT, 100000, 128);
+    ASSERT_EQ(candidates.size(), 3);
+    ASSERT_EQ(candidates[1]["nlist"].get<int64_t>(), 1024);
+    ASSERT_EQ(IndexTuner::Candidates(EngineType::FAISS_PQ, 100000, 128).size(), 6);
+    ASSERT_EQ(IndexTuner::Candidates(EngineType::HNSW, 100000, 128).size(), 3);
+    ASSERT_TRUE(IndexTuner::Candidates(EngineType::FAISS_IDMAP, 100000, 128).empty());
+    ASSERT_EQ(IndexTuner::Candidates(EngineType::FAISS_IVFFLAT, 10, 128).size(), 1);
+
+    int64_t dim = 16, nb = 4000, nq = 20;
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> dist(0.0, 1.0);
+    std::vector<float> data(nb * dim), queries(nq * dim);
+    for (auto& value : data) {
+        value = dist(e);
+    }
+    for (auto& value : queries) {
+        value = dist(e);
+    }
+
+    IndexTuner tuner(milvus::engine::MetricType::L2, dim, 10, 0.9);
+    auto status = tuner.Tune({EngineType::FAISS_IVFFLAT, EngineType::FAISS_IVFSQ8}, data, queries);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_FALSE(tuner.Points().empty());
+
+    // the front is faster as it is less accurate, every point is matched or beaten by one of it
+    auto front = tuner.ParetoFront();
+    ASSERT_FALSE(front.empty());
+    for (size_t i = 1; i < front.size(); ++i) {
+        ASSERT_GT(front[i].recall_, front[i - 1].recall_);
+        ASSERT_GE(front[i].latency_ms_, front[i - 1].latency_ms_);
+    }
+    for (auto& point : tuner.Points()) {
+        bool beaten = false;
+        for (auto& front_point : front) {
+            beaten |= front_point.recall_ >= point.recall_ && front_point.latency_ms_ <= point.latency_ms_;
+        }
+        ASSERT_TRUE(beaten);
+    }
+
+    // a full probe is exact, the fastest point reaching the target is recommended
+    IndexTuner::Point recommended;
+    ASSERT_TRUE(tuner.Recommend(recommended));
+    ASSERT_GE(recommended.recall_, 0.9);
+    for (auto& point : tuner.Points()) {
+        if (point.recall_ >= 0.9) {
+            ASSERT_LE(recommended.latency_ms_, point.latency_ms_);
+        }
+    }
+    auto report = tuner.Report();
+    ASSERT_EQ(report["sample_rows"].get<int64_t>(), nb);
+    ASSERT_EQ(report["recommended"]["index_type"].get<int32_t>(), (int32_t)recommended.engine_type_);
+
+    IndexTuner binary_tuner(milvus::engine::MetricType::HAMMING, dim, 10, 0.9);
+    ASSERT_FALSE(binary_tuner.Tune({EngineType::FAISS_IVFFLAT}, data, queries).ok());
+}
+
+TEST(DBMiscTest, BUILD_THROTTLE_TEST) {
+    // without a latency target the builds keep the configured share while searching
+    milvus::engine::BuildThrottle throttle(0.25, 0);
+    throttle.SearchBegin();
+    ASSERT_DOUBLE_EQ(faiss::BuilderSuspend::share(), 0.25);
+    throttle.SearchBegin();
+    throttle.SearchEnd(1000000);
+    ASSERT_DOUBLE_EQ(faiss::BuilderSuspend::share(), 0.25);
+    throttle.SearchEnd(1000000);
+    ASSERT_DOUBLE_EQ(faiss::BuilderSuspend::share(), 1.0);
+
+    // searches missing the target shrink the share down to the floor, never to zero
+    milvus::engine::BuildThrottle slo_throttle(0.25, 10);
+    for (int i = 0; i < 1024; ++i) {
+        slo_throttle.SearchBegin();
+        slo_throttle.SearchEnd(50000);
+    }
+    ASSERT_DOUBLE_EQ(slo_throttle.SearchingShare(), milvus::engine::BuildThrottle::MIN_BUILD_SHARE);
+    ASSERT_DOUBLE_EQ(faiss::BuilderSuspend::share(), 1.0);
+
+    // and grow it back once the target is met again
+    for (int i = 0; i < 4096; ++i) {
+        slo_throttle.SearchBegin();
+        slo_throttle.SearchEnd(1000);
+    }
+    ASSERT_DOUBLE_EQ(slo_throttle.SearchingShare(), 0.25);
+
+    // a throttled builder still progresses
+    slo_throttle.SearchBegin();
+    auto begin = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(50)) {
+        faiss::BuilderSuspend::check_wait();
+    }
+    slo_throttle.SearchEnd(1000);
+}
+
+TEST(DBMiscTest, SEGMENT_ACCESS_LOG_TEST) {
+    auto& access_log = milvus::engine::SegmentAccessLog::GetInstance();
+    access_log.Clear();
+    access_log.Touch("/tmp/a", 1);
+    access_log.Touch("/tmp/a", 1);
+    access_log.Touch("/tmp/a", 1);
+    access_log.Touch("/tmp/a", 1);
+    access_log.Touch("/tmp/b", 2);
+    access_log.Touch("/tmp/c", 3);
+    ASSERT_GT(access_log.Rank("/tmp/c"), access_log.Rank("/tmp/a"));
+    ASSERT_EQ(access_log.Rank("/tmp/d"), 0);
+
+    // the order survives a restart, the manifest only has the files cached at saving
+    std::string path = "/tmp/milvus_test_segment_access_log";
+    auto mark = [](milvus::engine::SegmentAccessLog::Entry& entry) { entry.cached_ = (entry.location_ != "/tmp/b"); };
+    ASSERT_TRUE(access_log.Save(path, mark).ok());
+    access_log.Clear();
+    ASSERT_EQ(access_log.Rank("/tmp/a"), 0);
+    ASSERT_TRUE(access_log.Load(path).ok());
+
+    auto entries = access_log.Entries();
+    ASSERT_EQ(entries.size(), 3);
+    ASSERT_EQ(entries[0].location_, "/tmp/c");
+    ASSERT_EQ(entries[2].location_, "/tmp/a");
+
+    auto manifest = access_log.Manifest();
+    ASSERT_EQ(manifest.size(), 2);
+    ASSERT_EQ(manifest[0].location_, "/tmp/a");
+    ASSERT_EQ(manifest[0].file_id_, 1);
+    ASSERT_EQ(manifest[0].hits_, 2);
+    ASSERT_EQ(manifest[1].location_, "/tmp/c");
+    boost::filesystem::remove(path);
+
+    ASSERT_TRUE(access_log.Load(path).ok());
+    ASSERT_TRUE(access_log.Entries().empty());
+}
+
+TEST(DBMiscTest, STORAGE_TIER_TEST) {
+    using Segment = milvus::engine::StorageTier::Segment;
+    auto segment = [](const std::string& dir, int64_t size, uint64_t rank, bool cold, bool pinned) {
+        Segment segment;
+        segment.dir_ = dir;
+        segment.size_ = size;
+        segment.rank_ = rank;
+        segment.cold_ = cold;
+        segment.pinned_ = pinned;
+        return segment;
+    };
+
+    // over capacity, the segments searched least lately are demoted, the pinned ones stay
+    std::vector<Segment> segments = {segment("a", 40, 3, false, false), segment("b", 40, 0, false, true),
+                                     segment("c", 40, 1, false, false), segment("d", 40, 2, false, false),
+                                     segment("e", 40, 9, true, false)};
+    std::vector<std::string> demote, promote;
+    milvus::engine::StorageTier::Plan(segments, 100, 0, demote, promote);
+    ASSERT_EQ(demote, std::vector<std::string>({"c", "d"}));
+    ASSERT_TRUE(promote.empty());
+
+    // under capacity, the cold segments searched lately are promoted while they fit
+    segments = {segment("a", 40, 3, false, false), segment("e", 40, 9, true, false), segment("f", 20, 8, true, false),
+                segment("g", 10, 1, true, false)};
+    milvus::engine::StorageTier::Plan(segments, 100, 4, demote, promote);
+    ASSERT_TRUE(demote.empty());
+    ASSERT_EQ(promote, std::vector<std::string>({"e"}));
+
+    // a demoted segment is read through the link, and moves back with the files written meanwhile
+    std::string hot_path = "/tmp/milvus_test_tier_hot";
+    std::string cold_path = "/tmp/milvus_test_tier_cold";
+    std::string segment_dir = hot_path + "/tables/c/1";
+    boost::filesystem::remove_all(hot_path);
+    boost::filesystem::remove_all(cold_path);
+    boost::filesystem::create_directories(segment_dir);
+    std::ofstream(segment_dir + "/raw") << "vectors";
+
+    milvus::engine::StorageTier tier(hot_path, cold_path);
+    ASSERT_FALSE(milvus::engine::StorageTier::IsCold(segment_dir));
+    ASSERT_TRUE(tier.Stage(segment_dir).ok());
+    ASSERT_TRUE(tier.Demote(segment_dir).ok());
+    ASSERT_TRUE(milvus::engine::StorageTier::IsCold(segment_dir));
+    ASSERT_TRUE(boost::filesystem::exists(cold_path + "/tables/c/1/raw"));
+    std::string content;
+    std::ifstream(segment_dir + "/raw") >> content;
+    ASSERT_EQ(content, "vectors");
+
+    std::ofstream(segment_dir + "/deleted_docs") << "ids";
+    ASSERT_TRUE(tier.Promote(segment_dir).ok());
+    ASSERT_FALSE(milvus::engine::StorageTier::IsCold(segment_dir));
+    ASSERT_TRUE(boost::filesystem::exists(segment_dir + "/deleted_docs"));
+    ASSERT_FALSE(boost::filesystem::exists(cold_path + "/tables/c/1"));
+
+    ASSERT_TRUE(tier.Demote(segment_dir).ok());
+    milvus::engine::StorageTier::RemoveSegment(segment_dir);
+    ASSERT_FALSE(boost::filesystem::exists(segment_dir));
+    ASSERT_FALSE(boost::filesystem::exists(cold_path + "/tables/c/1"));
+    boost::filesystem::remove_all(hot_path);
+    boost::filesystem::remove_all(cold_path);
+}
+
+TEST(DBMiscTest, FILE_GC_TEST) {
+    std::string gc_path = "/tmp/milvus_test_file_gc";
+    boost::filesystem::remove_all(gc_path);
+    boost::filesystem::create_directories(gc_path + "/segment");
+    std::vector<std::string> paths = {gc_path + "/segment"};
+    for (int64_t i = 0; i < 10; ++i) {
+        paths.push_back(gc_path + "/" + std::to_string(i));
+        std::ofstream(paths.back()) << "file";
+    }
+    paths.push_back(gc_path + "/missing");
+
+    // 20 unlinks a second, the first one right away
+    milvus::engine::FileGC gc(4, 20);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(gc.Remove(paths).ok());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_GE(elapsed.count(), (paths.size() - 1) * 50 - 10);
+    ASSERT_EQ(gc.Backlog(), 0u);
+    ASSERT_TRUE(boost::filesystem::is_empty(gc_path));
+
+    // an object store deleter gets the paths in batches of DELETE_BATCH
+    std::vector<size_t> batches;
+    std::mutex batches_mutex;
+    gc.SetDeleter([&](const std::vector<std::string>& batch) {
+        std::lock_guard<std::mutex> lock(batches_mutex);
+        batches.push_back(batch.size());
+        return milvus::Status::OK();
+    });
+    ASSERT_TRUE(gc.Remove(std::vector<std::string>(2500, "key")).ok());
+    std::sort(batches.begin(), batches.end());
+    ASSERT_EQ(batches, std::vector<size_t>({500, 1000, 1000}));
+
+    gc.SetDeleter([](const std::vector<std::string>& batch) { return milvus::Status(milvus::DB_ERROR, "failed"); });
+    ASSERT_FALSE(gc.Remove({"key"}).ok());
+    ASSERT_EQ(gc.Backlog(), 0u);
+    boost::filesystem::remove_all(gc_path);
+}
+
 TEST(DBMiscTest, IDGENERATOR_TEST) {
     milvus::engine::SimpleIDGenerator gen;
     size_t n = 1000000;
@@ -205,3 +606,713 @@ TEST(DBMiscTest, IDGENERATOR_TEST) {
 
     ASSERT_EQ(ids.size(), unique_ids.size());
 }
+
+TEST(DBMiscTest, ATTR_ZONE_MAP_TEST) {
+    using milvus::query::CompareExpr;
+    using milvus::query::CompareOperator;
+    using milvus::segment::AttrZoneMap;
+
+    // row i holds 2 * i, so block b covers [2000 * b, 2000 * b + 1998]
+    const int64_t row_count = 10000;
+    std::vector<int64_t> values(row_count);
+    for (int64_t i = 0; i < row_count; ++i) {
+        values[i] = 2 * i;
+    }
+    auto index = std::make_shared<milvus::knowhere::StructuredIndexSort<int64_t>>(row_count, values.data());
+    auto zone_map = AttrZoneMap::Build(index, milvus::engine::meta::hybrid::DataType::INT64, 1000);
+    ASSERT_NE(zone_map, nullptr);
+    ASSERT_EQ(zone_map->GetRowCount(), row_count);
+    ASSERT_EQ(zone_map->GetBlockCount(), 10);
+
+    std::vector<CompareExpr> exprs = {{CompareOperator::GTE, "2100"}, {CompareOperator::LT, "2200"}};
+    ASSERT_TRUE(zone_map->MayMatch(exprs));
+    ASSERT_FALSE(zone_map->BlockMayMatch(0, exprs));
+    ASSERT_TRUE(zone_map->BlockMayMatch(1, exprs));
+    ASSERT_FALSE(zone_map->BlockMayMatch(2, exprs));
+
+    ASSERT_FALSE(zone_map->MayMatch({{CompareOperator::GT, "19998"}}));
+    ASSERT_FALSE(zone_map->MayMatch({{CompareOperator::LT, "0"}}));
+    // 1999 falls between the bounds of block 0 and block 1
+    ASSERT_FALSE(zone_map->MayMatch({{CompareOperator::GTE, "1999"}, {CompareOperator::LTE, "1999"}}));
+    ASSERT_TRUE(zone_map->MayMatch({{CompareOperator::EQ, "19998"}}));
+    ASSERT_TRUE(zone_map->MayMatch({{CompareOperator::NE, "0"}}));
+
+    std::vector<int64_t> terms = {-5, 20000};
+    std::vector<uint8_t> field_value(terms.size() * sizeof(int64_t));
+    memcpy(field_value.data(), terms.data(), field_value.size());
+    ASSERT_FALSE(zone_map->MayMatchTerm(field_value));
+    terms[1] = 4000;
+    memcpy(field_value.data(), terms.data(), field_value.size());
+    ASSERT_TRUE(zone_map->MayMatchTerm(field_value));
+
+    std::vector<uint8_t> data;
+    zone_map->Serialize(data);
+    auto loaded = AttrZoneMap::Deserialize(data.data(), data.size());
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->GetBlockCount(), zone_map->GetBlockCount());
+    ASSERT_EQ(loaded->GetBlockRows(), 1000);
+    ASSERT_TRUE(loaded->BlockMayMatch(1, exprs));
+    ASSERT_FALSE(loaded->BlockMayMatch(2, exprs));
+
+    ASSERT_EQ(AttrZoneMap::Deserialize(data.data(), data.size() - 1), nullptr);
+}
+
+TEST(DBMiscTest, ATTR_ZONE_MAP_BOUNDS_TEST) {
+    namespace query = milvus::query;
+    using milvus::engine::meta::hybrid::DataType;
+    using milvus::segment::AttrZoneMap;
+
+    std::vector<int64_t> values = {7, -3, 9000000000000000001, 12};
+    auto index = std::make_shared<milvus::knowhere::StructuredIndexSort<int64_t>>(values.size(), values.data());
+    auto zone_map = AttrZoneMap::Build(index, DataType::INT64, 2);
+    std::string min, max;
+    ASSERT_TRUE(zone_map->GetBounds(min, max));
+    ASSERT_EQ(min, "-3");
+    ASSERT_EQ(max, "9000000000000000001");
+
+    std::vector<double> doubles = {0.1, 2.5, -1.75};
+    auto double_index = std::make_shared<milvus::knowhere::StructuredIndexSort<double>>(doubles.size(), doubles.data());
+    auto double_map = AttrZoneMap::Build(double_index, DataType::DOUBLE);
+    ASSERT_TRUE(double_map->GetBounds(min, max));
+    auto loaded = AttrZoneMap::FromBounds(DataType::DOUBLE, doubles.size(), min, max);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->GetBlockCount(), 1);
+    ASSERT_TRUE(loaded->MayMatch({{query::CompareOperator::EQ, "-1.75"}}));
+    ASSERT_FALSE(loaded->MayMatch({{query::CompareOperator::GT, "2.5"}}));
+
+    ASSERT_EQ(AttrZoneMap::FromBounds(DataType::INT32, 3, "x", "1"), nullptr);
+    ASSERT_EQ(AttrZoneMap::FromBounds(DataType::INT32, 0, "0", "1"), nullptr);
+
+    // a > 20 OR b < 0 may match, a > 20 AND b < 0 may not with a in [0, 10] and b in [5, 6]
+    milvus::segment::AttrZoneMaps zone_maps;
+    zone_maps["a"] = AttrZoneMap::FromBounds(DataType::INT32, 10, "0", "10");
+    zone_maps["b"] = AttrZoneMap::FromBounds(DataType::INT32, 10, "5", "6");
+    auto range_leaf = [](const std::string& field, query::CompareOperator op, const std::string& operand) {
+        auto general_query = std::make_shared<query::GeneralQuery>();
+        general_query->leaf = std::make_shared<query::LeafQuery>();
+        general_query->leaf->range_query = std::make_shared<query::RangeQuery>();
+        general_query->leaf->range_query->field_name = field;
+        general_query->leaf->range_query->compare_expr.push_back({op, operand});
+        return general_query;
+    };
+    auto root = std::make_shared<query::GeneralQuery>();
+    root->bin->relation = query::QueryRelation::AND;
+    root->bin->left_query = range_leaf("a", query::CompareOperator::LTE, "20");
+    root->bin->right_query = range_leaf("c", query::CompareOperator::LT, "0");
+    ASSERT_TRUE(milvus::segment::ZoneMapsMayMatch(zone_maps, root));
+    root->bin->right_query = range_leaf("b", query::CompareOperator::LT, "0");
+    ASSERT_FALSE(milvus::segment::ZoneMapsMayMatch(zone_maps, root));
+    root->bin->relation = query::QueryRelation::OR;
+    ASSERT_TRUE(milvus::segment::ZoneMapsMayMatch(zone_maps, root));
+}
+
+TEST(DBMiscTest, PARTITION_KEY_TEST) {
+    namespace query = milvus::query;
+    using milvus::engine::PartitionKey;
+    using milvus::engine::meta::hybrid::DataType;
+
+    milvus::engine::meta::hybrid::FieldsSchema fields_schema;
+    fields_schema.fields_schema_.resize(2);
+    fields_schema.fields_schema_[0].field_name_ = "age";
+    fields_schema.fields_schema_[0].field_type_ = (int32_t)DataType::INT32;
+    fields_schema.fields_schema_[1].field_name_ = "vec";
+    fields_schema.fields_schema_[1].field_type_ = (int32_t)DataType::VECTOR;
+    fields_schema.fields_schema_[1].field_params_ = R"({"metric_type": 1})";
+
+    milvus::engine::PartitionKeyPtr key;
+    ASSERT_TRUE(PartitionKey::FromFields(fields_schema, key).ok());
+    ASSERT_EQ(key, nullptr);
+
+    auto& params = fields_schema.fields_schema_[0].field_params_;
+    for (auto& invalid : {R"({"partition_key": {"type": "hash", "partitions": 0}})",
+                          R"({"partition_key": {"type": "range", "bounds": [10, 10]}})",
+                          R"({"partition_key": {"type": "list"}})"}) {
+        params = invalid;
+        ASSERT_FALSE(PartitionKey::FromFields(fields_schema, key).ok());
+    }
+    fields_schema.fields_schema_[0].field_type_ = (int32_t)DataType::FLOAT;
+    params = R"({"partition_key": {"type": "hash", "partitions": 4}})";
+    ASSERT_FALSE(PartitionKey::FromFields(fields_schema, key).ok());
+    fields_schema.fields_schema_[0].field_type_ = (int32_t)DataType::INT32;
+
+    auto term_leaf = [](const std::vector<int32_t>& values) {
+        auto general_query = std::make_shared<query::GeneralQuery>();
+        general_query->leaf = std::make_shared<query::LeafQuery>();
+        general_query->leaf->term_query = std::make_shared<query::TermQuery>();
+        general_query->leaf->term_query->field_name = "age";
+        auto& field_value = general_query->leaf->term_query->field_value;
+        field_value.resize(values.size() * sizeof(int32_t));
+        memcpy(field_value.data(), values.data(), field_value.size());
+        return general_query;
+    };
+    std::vector<int32_t> ages = {-5, 10, 99, 100, 1000};
+    std::vector<uint8_t> field_data(ages.size() * sizeof(int32_t));
+    memcpy(field_data.data(), ages.data(), field_data.size());
+
+    // range: (-inf, 10), [10, 100), [100, +inf)
+    params = R"({"partition_key": {"type": "range", "bounds": [10, 100]}})";
+    ASSERT_TRUE(PartitionKey::FromFields(fields_schema, key).ok());
+    ASSERT_NE(key, nullptr);
+    ASSERT_EQ(key->FieldName(), "age");
+    ASSERT_EQ(key->PartitionCount(), 3);
+    std::vector<int64_t> partitions;
+    key->Route(field_data, ages.size(), partitions);
+    ASSERT_EQ(partitions, std::vector<int64_t>({0, 1, 1, 2, 2}));
+
+    auto range_query = std::make_shared<query::GeneralQuery>();
+    range_query->leaf = std::make_shared<query::LeafQuery>();
+    range_query->leaf->range_query = std::make_shared<query::RangeQuery>();
+    range_query->leaf->range_query->field_name = "age";
+    range_query->leaf->range_query->compare_expr.push_back({query::CompareOperator::GTE, "100"});
+    ASSERT_FALSE(key->PartitionMayMatch(0, range_query));
+    ASSERT_FALSE(key->PartitionMayMatch(1, range_query));
+    ASSERT_TRUE(key->PartitionMayMatch(2, range_query));
+    ASSERT_TRUE(key->PartitionMayMatch(0, term_leaf({3, 200})));
+    ASSERT_FALSE(key->PartitionMayMatch(1, term_leaf({3, 200})));
+    ASSERT_TRUE(key->PartitionMayMatch(1, nullptr));
+
+    // hash: a term only matches the partitions its values hash to
+    params = R"({"partition_key": {"type": "hash", "partitions": 4}})";
+    ASSERT_TRUE(PartitionKey::FromFields(fields_schema, key).ok());
+    key->Route(field_data, ages.size(), partitions);
+    for (size_t i = 0; i < ages.size(); ++i) {
+        auto term = term_leaf({ages[i]});
+        for (int64_t partition = 0; partition < key->PartitionCount(); ++partition) {
+            ASSERT_EQ(key->PartitionMayMatch(partition, term), partition == partitions[i]);
+        }
+    }
+    ASSERT_TRUE(key->PartitionMayMatch(partitions[0], range_query));
+
+    auto root = std::make_shared<query::GeneralQuery>();
+    root->bin->relation = query::QueryRelation::OR;
+    root->bin->left_query = term_leaf({ages[0]});
+    root->bin->right_query = term_leaf({ages[4]});
+    for (int64_t partition = 0; partition < key->PartitionCount(); ++partition) {
+        bool expected = partition == partitions[0] || partition == partitions[4];
+        ASSERT_EQ(key->PartitionMayMatch(partition, root), expected);
+    }
+}
+
+TEST(DBMiscTest, COMPACTION_POLICY_TEST) {
+    using Candidate = milvus::engine::CompactionPolicy::Candidate;
+    auto make_candidate = [](const std::string& id, int64_t rows, int64_t deleted, int64_t size) {
+        Candidate candidate;
+        candidate.segment_id_ = id;
+        candidate.row_count_ = rows;
+        candidate.deleted_count_ = deleted;
+        candidate.size_ = size;
+        return candidate;
+    };
+
+    std::vector<Candidate> candidates = {
+        make_candidate("a", 60, 40, 100),   // ratio 0.4
+        make_candidate("b", 50, 50, 100),   // ratio 0.5
+        make_candidate("c", 90, 10, 100),   // ratio 0.1, below threshold
+        make_candidate("d", 100, 0, 100),   // nothing deleted
+        make_candidate("e", 0, 20, 50),     // all deleted
+    };
+    ASSERT_DOUBLE_EQ(milvus::engine::CompactionPolicy::DeletedRatio(candidates[0]), 0.4);
+
+    milvus::engine::CompactionPolicy policy;
+    auto picked = policy.Pick(candidates, 0.2, 0);
+    ASSERT_EQ(picked.size(), 3);
+    ASSERT_EQ(picked[0].segment_id_, "e");
+    ASSERT_EQ(picked[1].segment_id_, "b");
+    ASSERT_EQ(picked[2].segment_id_, "a");
+
+    // frequently searched segment goes first
+    for (int i = 0; i < 5; ++i) {
+        policy.RecordSearch("a");
+    }
+    picked = policy.Pick(candidates, 0.2, 0);
+    ASSERT_EQ(picked.size(), 3);
+    ASSERT_EQ(picked[0].segment_id_, "a");
+
+    // bytes limit
+    picked = policy.Pick(candidates, 0.2, 120);
+    ASSERT_EQ(picked.size(), 1);
+    ASSERT_EQ(picked[0].segment_id_, "a");
+
+    // the first one is picked even it exceeds the limit
+    picked = policy.Pick(candidates, 0.2, 10);
+    ASSERT_EQ(picked.size(), 1);
+}
+
+TEST(DBMiscTest, ROARING_BITMAP_TEST) {
+    milvus::segment::RoaringBitmap bitmap;
+    std::set<uint32_t> expected;
+    std::default_random_engine engine(42);
+    // a sparse chunk, a dense chunk turning into bitmap and values far away
+    std::uniform_int_distribution<uint32_t> sparse(0, 65535), dense(65536, 65536 + 9999);
+    for (int i = 0; i < 100; ++i) {
+        expected.insert(sparse(engine));
+    }
+    for (int i = 0; i < 8000; ++i) {
+        expected.insert(dense(engine));
+    }
+    expected.insert(4000000000u);
+    for (auto value : expected) {
+        bitmap.Add(value);
+        bitmap.Add(value);
+    }
+    ASSERT_EQ(bitmap.Cardinality(), expected.size());
+    for (auto value : expected) {
+        ASSERT_TRUE(bitmap.Contains(value));
+    }
+    ASSERT_FALSE(bitmap.Contains(3999999999u));
+
+    std::vector<uint32_t> visited;
+    bitmap.ForEach([&](uint32_t value) { visited.push_back(value); });
+    ASSERT_EQ(visited, std::vector<uint32_t>(expected.begin(), expected.end()));
+
+    // the values beyond the bitset are ignored
+    const size_t bits_size = 65536 + 5000;
+    std::vector<uint8_t> bits((bits_size + 7) / 8, 0);
+    bitmap.SetBits(bits.data(), bits_size);
+    for (size_t i = 0; i < bits_size; ++i) {
+        bool set = (bits[i >> 3] >> (i & 0x7)) & 0x1;
+        ASSERT_EQ(set, expected.count(i) > 0);
+    }
+
+    std::vector<uint8_t> buffer;
+    bitmap.Serialize(buffer);
+    ASSERT_EQ(buffer.size(), bitmap.SerializedSize());
+    milvus::segment::RoaringBitmap restored;
+    ASSERT_TRUE(restored.Deserialize(buffer.data(), buffer.size()));
+    ASSERT_EQ(restored.Cardinality(), bitmap.Cardinality());
+    std::vector<uint32_t> restored_values;
+    restored.ForEach([&](uint32_t value) { restored_values.push_back(value); });
+    ASSERT_EQ(restored_values, visited);
+
+    // truncated data is rejected
+    ASSERT_FALSE(restored.Deserialize(buffer.data(), buffer.size() - 1));
+
+    restored.Clear();
+    ASSERT_TRUE(restored.Empty());
+    ASSERT_FALSE(restored.Contains(4000000000u));
+}
+
+TEST(DBMiscTest, DELETED_DOCS_TEST) {
+    milvus::segment::DeletedDocs deleted_docs({5, 3, 5, 100});
+    deleted_docs.AddDeletedDoc(1);
+    deleted_docs.AddDeletedDoc(3);
+    ASSERT_EQ(deleted_docs.GetSize(), 4);
+    std::vector<milvus::segment::offset_t> expected = {1, 3, 5, 100};
+    ASSERT_EQ(deleted_docs.GetDeletedDocs(), expected);
+
+    faiss::ConcurrentBitsetPtr bitset;
+    deleted_docs.GetBitset(10, bitset);
+    ASSERT_EQ(bitset->capacity(), 10);
+    for (int64_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(bitset->test(i), i == 1 || i == 3 || i == 5);
+    }
+
+    std::string dir = "/tmp/milvus_test/deleted_docs_test";
+    boost::filesystem::create_directories(dir);
+
+    // the files written before the bitmap layout are still readable
+    std::string legacy_path = dir + "/legacy_del";
+    {
+        std::vector<milvus::segment::offset_t> offsets = {7, 2, 9};
+        size_t num_bytes = offsets.size() * sizeof(milvus::segment::offset_t);
+        std::ofstream file(legacy_path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&num_bytes), sizeof(num_bytes));
+        file.write(reinterpret_cast<const char*>(offsets.data()), num_bytes);
+    }
+    milvus::segment::RoaringBitmap bitmap;
+    milvus::codec::ReadDeletedDocsFile(legacy_path, bitmap);
+    ASSERT_EQ(bitmap.Cardinality(), 3);
+    ASSERT_TRUE(bitmap.Contains(2));
+    size_t size = 0;
+    milvus::codec::ReadDeletedDocsFileSize(legacy_path, size);
+    ASSERT_EQ(size, 3);
+
+    std::string path = dir + "/del";
+    deleted_docs.GetBitmap().ForEach([&](uint32_t offset) { bitmap.Add(offset); });
+    milvus::codec::WriteDeletedDocsFile(path, bitmap);
+    milvus::codec::ReadDeletedDocsFileSize(path, size);
+    ASSERT_EQ(size, 7);
+    milvus::segment::RoaringBitmap restored;
+    milvus::codec::ReadDeletedDocsFile(path, restored);
+    milvus::segment::DeletedDocs restored_docs(std::move(restored));
+    expected = {1, 2, 3, 5, 7, 9, 100};
+    ASSERT_EQ(restored_docs.GetDeletedDocs(), expected);
+
+    boost::filesystem::remove_all(dir);
+}
+
+TEST(DBMiscTest, BLOCKED_BLOOM_FILTER_TEST) {
+    const int64_t capacity = 100000;
+    auto blocked_filter = std::make_shared<milvus::segment::BlockedBloomFilter>(capacity, 0.01);
+    // 0.01 takes about 10 bits per key
+    ASSERT_GT(blocked_filter->NumBytes(), capacity);
+    ASSERT_LT(blocked_filter->NumBytes(), capacity * 2);
+
+    milvus::segment::IdBloomFilter id_bloom_filter(blocked_filter);
+    ASSERT_EQ(id_bloom_filter.GetBloomFilter(), nullptr);
+    for (int64_t i = 0; i < capacity; ++i) {
+        ASSERT_TRUE(id_bloom_filter.Add(i * 7).ok());
+    }
+
+    std::vector<int64_t> ids;
+    for (int64_t i = 0; i < capacity * 2; ++i) {
+        ids.push_back(i * 7 + (i < capacity ? 0 : 3));
+    }
+    std::vector<bool> may_exist;
+    id_bloom_filter.CheckMany(ids, may_exist);
+    ASSERT_EQ(may_exist.size(), ids.size());
+    int64_t false_positives = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(may_exist[i], id_bloom_filter.Check(ids[i]));
+        if (i < capacity) {
+            ASSERT_TRUE(may_exist[i]);
+        } else if (may_exist[i]) {
+            ++false_positives;
+        }
+    }
+    ASSERT_LT(false_positives, capacity * 0.02);
+
+    // removing is not supported, the id is still reported
+    ASSERT_TRUE(id_bloom_filter.Remove(7).ok());
+    ASSERT_TRUE(id_bloom_filter.Check(7));
+
+    // built by chunks in parallel, the same as added one by one
+    std::vector<int64_t> many_ids;
+    for (int64_t i = 0; i < capacity * 3; ++i) {
+        many_ids.push_back(i * 11);
+    }
+    auto many_filter = std::make_shared<milvus::segment::BlockedBloomFilter>(capacity * 3, 0.01);
+    milvus::segment::IdBloomFilter many_id_filter(many_filter);
+    ASSERT_TRUE(many_id_filter.AddMany(many_ids).ok());
+    for (auto id : many_ids) {
+        ASSERT_TRUE(many_id_filter.Check(id));
+    }
+
+    auto empty_copy = blocked_filter->EmptyCopy();
+    ASSERT_EQ(empty_copy.NumBytes(), blocked_filter->NumBytes());
+    ASSERT_FALSE(empty_copy.Check(7));
+    ASSERT_TRUE(empty_copy.Merge(*blocked_filter));
+    ASSERT_TRUE(empty_copy.Check(7));
+    ASSERT_FALSE(empty_copy.Merge(*many_filter));
+
+    std::string dir = "/tmp/milvus_test/blocked_bloom_filter_test";
+    boost::filesystem::create_directories(dir);
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+
+    milvus::codec::BlockedIdBloomFilterFormat format;
+    ASSERT_FALSE(format.exists(fs_ptr));
+    milvus::segment::IdBloomFilterPtr id_bloom_filter_ptr;
+    format.create(fs_ptr, id_bloom_filter_ptr);
+    for (int64_t i = 0; i < 1000; ++i) {
+        id_bloom_filter_ptr->Add(i);
+    }
+    format.write(fs_ptr, id_bloom_filter_ptr);
+    ASSERT_TRUE(format.exists(fs_ptr));
+
+    milvus::segment::IdBloomFilterPtr restored_ptr;
+    format.read(fs_ptr, restored_ptr);
+    ASSERT_EQ(restored_ptr->Size(), id_bloom_filter_ptr->Size());
+    for (int64_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(restored_ptr->Check(i));
+    }
+
+    std::vector<uint8_t> buffer;
+    blocked_filter->Serialize(buffer);
+    milvus::segment::BlockedBloomFilter restored_filter;
+    ASSERT_FALSE(restored_filter.Deserialize(buffer.data(), buffer.size() - 1));
+    ASSERT_TRUE(restored_filter.Deserialize(buffer.data(), buffer.size()));
+    ASSERT_TRUE(restored_filter.Check(7 * 99));
+
+    boost::filesystem::remove_all(dir);
+}
+
+TEST(DBMiscTest, ID_INDEX_TEST) {
+    std::vector<milvus::segment::doc_id_t> uids;
+    for (int64_t i = 0; i < 10000; ++i) {
+        uids.push_back(i * 3);
+    }
+    // a duplicated id maps to its first offset
+    uids.push_back(3);
+
+    auto id_index = std::make_shared<milvus::segment::IdIndex>(uids);
+    ASSERT_EQ(id_index->Count(), 10000);
+    int64_t offset;
+    for (int64_t i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(id_index->Find(i * 3, offset));
+        ASSERT_EQ(offset, i);
+        ASSERT_FALSE(id_index->Find(i * 3 + 1, offset));
+    }
+    ASSERT_FALSE(milvus::segment::IdIndex().Find(0, offset));
+
+    std::string dir = "/tmp/milvus_test/id_index_test";
+    boost::filesystem::create_directories(dir);
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+
+    milvus::codec::DefaultIdIndexFormat format;
+    milvus::segment::IdIndexPtr restored_ptr;
+    format.read(fs_ptr, restored_ptr);
+    ASSERT_EQ(restored_ptr, nullptr);
+
+    format.write(fs_ptr, id_index);
+    format.read(fs_ptr, restored_ptr);
+    ASSERT_NE(restored_ptr, nullptr);
+    ASSERT_EQ(restored_ptr->Count(), id_index->Count());
+    ASSERT_EQ(restored_ptr->Size(), id_index->Size());
+    ASSERT_TRUE(restored_ptr->Find(3, offset));
+    ASSERT_EQ(offset, 1);
+    ASSERT_FALSE(restored_ptr->Find(4, offset));
+
+    std::vector<uint8_t> buffer;
+    id_index->Serialize(buffer);
+    milvus::segment::IdIndex restored_index;
+    ASSERT_FALSE(restored_index.Deserialize(buffer.data(), buffer.size() - 1));
+    ASSERT_TRUE(restored_index.Deserialize(buffer.data(), buffer.size()));
+
+    boost::filesystem::remove_all(dir);
+}
+
+TEST(DBMiscTest, VECTOR_SUMMARY_TEST) {
+    const int64_t dim = 16;
+    const size_t count = 5000;
+    std::default_random_engine e(42);
+    std::normal_distribution<float> dist(0.0, 1.0);
+
+    // two clusters far apart
+    std::vector<float> vectors(count * dim);
+    for (size_t i = 0; i < count; ++i) {
+        for (int64_t d = 0; d < dim; ++d) {
+            vectors[i * dim + d] = dist(e) + (i % 2 == 0 ? 10.0f : -10.0f);
+        }
+    }
+
+    auto summary = std::make_shared<milvus::segment::VectorSummary>(vectors.data(), count, dim);
+    ASSERT_EQ(summary->Dimension(), dim);
+    ASSERT_GT(summary->CentroidCount(), 0);
+
+    for (size_t q = 0; q < 20; ++q) {
+        std::vector<float> query(dim);
+        for (auto& v : query) {
+            v = dist(e) * 10;
+        }
+        float min_l2 = std::numeric_limits<float>::max();
+        float max_ip = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < count; ++i) {
+            float l2 = 0, ip = 0;
+            for (int64_t d = 0; d < dim; ++d) {
+                float diff = query[d] - vectors[i * dim + d];
+                l2 += diff * diff;
+                ip += query[d] * vectors[i * dim + d];
+            }
+            min_l2 = std::min(min_l2, l2);
+            max_ip = std::max(max_ip, ip);
+        }
+        ASSERT_LE(summary->L2LowerBound(query.data()), min_l2 * 1.001f + 1e-3f);
+        ASSERT_GE(summary->IPUpperBound(query.data()), max_ip - std::abs(max_ip) * 0.001f - 1e-3f);
+    }
+
+    // a query far away from the vectors has a lower bound above zero
+    std::vector<float> far(dim, 100.0f);
+    ASSERT_GT(summary->L2LowerBound(far.data()), 0.0f);
+
+    std::string dir = "/tmp/milvus_test/vector_summary_test";
+    boost::filesystem::create_directories(dir);
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+
+    milvus::codec::DefaultVectorSummaryFormat format;
+    milvus::segment::VectorSummaryPtr restored_ptr;
+    format.read(fs_ptr, restored_ptr);
+    ASSERT_EQ(restored_ptr, nullptr);
+
+    format.write(fs_ptr, summary);
+    format.read(fs_ptr, restored_ptr);
+    ASSERT_NE(restored_ptr, nullptr);
+    ASSERT_EQ(restored_ptr->Dimension(), dim);
+    ASSERT_EQ(restored_ptr->CentroidCount(), summary->CentroidCount());
+    ASSERT_FLOAT_EQ(restored_ptr->L2LowerBound(far.data()), summary->L2LowerBound(far.data()));
+
+    std::vector<uint8_t> buffer;
+    summary->Serialize(buffer);
+    milvus::segment::VectorSummary restored_summary;
+    ASSERT_FALSE(restored_summary.Deserialize(buffer.data(), buffer.size() - 1));
+    ASSERT_TRUE(restored_summary.Deserialize(buffer.data(), buffer.size()));
+
+    boost::filesystem::remove_all(dir);
+}
+
+TEST(DBMiscTest, CONCURRENT_BITSET_TEST) {
+    // more than a word and a few bytes, the last byte partly used
+    const int64_t n = 150;
+    auto a = std::make_shared<faiss::ConcurrentBitset>(n);
+    auto b = std::make_shared<faiss::ConcurrentBitset>(n);
+    for (int64_t i = 0; i < n; ++i) {
+        if (i % 2 == 0) {
+            a->set(i);
+        }
+        if (i % 3 == 0) {
+            b->set(i);
+        }
+    }
+
+    auto and_set = (*a) & b;
+    auto or_set = (*a) | b;
+    auto andnot_set = a->andnot(b);
+    auto xor_set = std::make_shared<faiss::ConcurrentBitset>(n);
+    *xor_set |= *a;
+    *xor_set ^= *b;
+    size_t a_count = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        bool in_a = i % 2 == 0, in_b = i % 3 == 0;
+        ASSERT_EQ(and_set->test(i), in_a && in_b);
+        ASSERT_EQ(or_set->test(i), in_a || in_b);
+        ASSERT_EQ(andnot_set->test(i), in_a && !in_b);
+        ASSERT_EQ(xor_set->test(i), in_a != in_b);
+        a_count += in_a;
+    }
+    ASSERT_EQ(a->count(), a_count);
+
+    // the bits past the capacity stay clear
+    a->negate();
+    ASSERT_EQ(a->count(), n - a_count);
+    for (int64_t i = 0; i < n; ++i) {
+        ASSERT_EQ(a->test(i), i % 2 != 0);
+    }
+}
+
+TEST(DBMiscTest, HYBRID_SEARCH_PLAN_TEST) {
+    using milvus::engine::HybridStrategy;
+
+    // a selective filter is brute forced, unless the vectors can't be
+    auto plan = milvus::engine::PlanHybridSearch(100000, 50, 10, true);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::PRE_FILTER);
+    plan = milvus::engine::PlanHybridSearch(100000, 50, 10, false);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::FILTERED_ANN);
+    plan = milvus::engine::PlanHybridSearch(100000, 0, 10, true);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::PRE_FILTER);
+    plan = milvus::engine::PlanHybridSearch(1000, 8, 10, true);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::PRE_FILTER);
+
+    plan = milvus::engine::PlanHybridSearch(100000, 10000, 10, true);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::FILTERED_ANN);
+    ASSERT_EQ(plan.query_topk_, 10);
+
+    // a permissive filter asks the index for more results, never more than the rows
+    plan = milvus::engine::PlanHybridSearch(100000, 80000, 10, true);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::POST_FILTER);
+    ASSERT_GE(plan.query_topk_ * 0.8, 10);
+    plan = milvus::engine::PlanHybridSearch(100, 60, 90, false);
+    ASSERT_EQ(plan.strategy_, HybridStrategy::POST_FILTER);
+    ASSERT_EQ(plan.query_topk_, 100);
+}
+
+TEST(DBMiscTest, FUSE_RANGE_QUERIES_TEST) {
+    namespace query = milvus::query;
+    auto range_leaf = [](const std::string& field, query::CompareOperator op, const std::string& operand) {
+        auto general_query = std::make_shared<query::GeneralQuery>();
+        general_query->leaf = std::make_shared<query::LeafQuery>();
+        general_query->leaf->range_query = std::make_shared<query::RangeQuery>();
+        general_query->leaf->range_query->field_name = field;
+        general_query->leaf->range_query->compare_expr.push_back({op, operand});
+        return general_query;
+    };
+    auto join = [](query::QueryRelation relation, query::GeneralQueryPtr left, query::GeneralQueryPtr right) {
+        auto general_query = std::make_shared<query::GeneralQuery>();
+        general_query->bin->relation = relation;
+        general_query->bin->left_query = left;
+        general_query->bin->right_query = right;
+        return general_query;
+    };
+    auto vector_leaf = std::make_shared<query::GeneralQuery>();
+    vector_leaf->leaf = std::make_shared<query::LeafQuery>();
+    vector_leaf->leaf->vector_placeholder = "placeholder_1";
+
+    // a > 1 AND (b < 3 OR b > 7) AND a <= 5 AND vector
+    auto first = range_leaf("a", query::CompareOperator::GT, "1");
+    auto either = join(query::QueryRelation::OR, range_leaf("b", query::CompareOperator::LT, "3"),
+                       range_leaf("b", query::CompareOperator::GT, "7"));
+    auto root = join(query::QueryRelation::AND, first,
+                     join(query::QueryRelation::AND, either,
+                          join(query::QueryRelation::AND, range_leaf("a", query::CompareOperator::LTE, "5"),
+                               vector_leaf)));
+    query::FuseRangeQueries(root->bin);
+
+    // a > 1 AND a <= 5, the OR, the vector
+    auto fused = root->bin->left_query->leaf->range_query;
+    ASSERT_EQ(fused->field_name, "a");
+    ASSERT_EQ(fused->compare_expr.size(), 2);
+    ASSERT_EQ(fused->compare_expr[1].compare_operator, query::CompareOperator::LTE);
+    ASSERT_EQ(first->leaf->range_query->compare_expr.size(), 1);
+    auto rest = root->bin->right_query->bin;
+    ASSERT_EQ(rest->relation, query::QueryRelation::AND);
+    ASSERT_EQ(rest->left_query, either);
+    ASSERT_EQ(rest->right_query, vector_leaf);
+
+    // the ranges under an OR are left alone
+    ASSERT_EQ(either->bin->left_query->leaf->range_query->compare_expr.size(), 1);
+    ASSERT_EQ(either->bin->right_query->leaf->range_query->compare_expr.size(), 1);
+}
+
+TEST(DBMiscTest, ATTR_FILTER_TEST) {
+    namespace query = milvus::query;
+    using milvus::engine::meta::hybrid::DataType;
+
+    // a tail of rows beyond the last full word of the bitset
+    const int64_t row_count = 200;
+    std::vector<int32_t> values(row_count);
+    for (int64_t i = 0; i < row_count; ++i) {
+        values[i] = static_cast<int32_t>(i % 50) - 10;
+    }
+    std::vector<uint8_t> column(row_count * sizeof(int32_t));
+    memcpy(column.data(), values.data(), column.size());
+
+    faiss::ConcurrentBitsetPtr bitset;
+    std::vector<query::CompareExpr> exprs = {{query::CompareOperator::GTE, "0"}, {query::CompareOperator::LT, "7"}};
+    auto status = milvus::engine::FilterAttrRange(DataType::INT32, column, row_count, exprs, bitset);
+    ASSERT_TRUE(status.ok());
+    for (int64_t i = 0; i < row_count; ++i) {
+        ASSERT_EQ(bitset->test(i), values[i] >= 0 && values[i] < 7);
+    }
+    ASSERT_EQ(bitset->count(), 28);
+
+    exprs = {{query::CompareOperator::NE, "-10"}};
+    status = milvus::engine::FilterAttrRange(DataType::INT32, column, row_count, exprs, bitset);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(bitset->count(), row_count - 4);
+
+    // few terms are compared a pass each, many are probed in a hash set
+    for (int64_t term_num : {3, 40}) {
+        std::vector<int32_t> terms;
+        for (int64_t i = 0; i < term_num; ++i) {
+            terms.push_back(static_cast<int32_t>(i) - 5);
+        }
+        std::vector<uint8_t> field_value(terms.size() * sizeof(int32_t));
+        memcpy(field_value.data(), terms.data(), field_value.size());
+        status = milvus::engine::FilterAttrTerm(DataType::INT32, column, row_count, field_value, bitset);
+        ASSERT_TRUE(status.ok());
+        for (int64_t i = 0; i < row_count; ++i) {
+            ASSERT_EQ(bitset->test(i), values[i] >= -5 && values[i] < term_num - 5);
+        }
+    }
+
+    std::vector<double> doubles = {0.5, 1.5, 2.5, 3.5, 4.5};
+    std::vector<uint8_t> double_column(doubles.size() * sizeof(double));
+    memcpy(double_column.data(), doubles.data(), double_column.size());
+    exprs = {{query::CompareOperator::GT, "1.5"}, {query::CompareOperator::LTE, "3.5"}};
+    status = milvus::engine::FilterAttrRange(DataType::DOUBLE, double_column, doubles.size(), exprs, bitset);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(bitset->count(), 2);
+    ASSERT_TRUE(bitset->test(2));
+    ASSERT_TRUE(bitset->test(3));
+
+    // the column must hold every row
+    status = milvus::engine::FilterAttrRange(DataType::INT64, column, row_count, exprs, bitset);
+    ASSERT_FALSE(status.ok());
+}
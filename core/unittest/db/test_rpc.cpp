@@ -9,11 +9,23 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <faiss/impl/ScalarQuantizerOp.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/server_builder.h>
 #include <gtest/gtest.h>
 #include <opentracing/mocktracer/tracer.h>
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <random>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "config/Config.h"
 #include "server/Server.h"
@@ -29,6 +41,7 @@
 #include "scheduler/SchedInst.h"
 #include "server/DBWrapper.h"
 #include "server/grpc_impl/GrpcServer.h"
+#include "server/grpc_impl/interceptor/SpanInterceptor.h"
 #include "utils/CommonUtil.h"
 
 
@@ -65,6 +78,23 @@ SearchFunc(std::shared_ptr<milvus::server::grpc::GrpcRequestHandler> handler, ::
     handler->Search(context, request.get(), result.get());
 }
 
+// each row holds the ids sorted by id, the first kept and the next ones replaced by their distance to the
+// previous one plus 1, then the position of each hit in them, the distances stay in rank order
+std::vector<int64_t>
+DecodeDeltaIds(const ::milvus::grpc::TopKQueryResult& encoded, int64_t topk, int64_t row) {
+    const int64_t* deltas = encoded.ids().data() + 2 * topk * row;
+    const int64_t* positions = deltas + topk;
+    std::vector<int64_t> sorted(deltas, deltas + topk);
+    for (int64_t j = 1; j < topk; ++j) {
+        sorted[j] = deltas[j] == 0 || sorted[j - 1] == -1 ? -1 : sorted[j - 1] + deltas[j] - 1;
+    }
+    std::vector<int64_t> ids(topk);
+    for (int64_t j = 0; j < topk; ++j) {
+        ids[j] = sorted[positions[j]];
+    }
+    return ids;
+}
+
 class RpcHandlerTest : public testing::Test {
  protected:
     void
@@ -348,6 +378,39 @@ TEST_F(RpcHandlerTest, INSERT_TEST) {
     ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ILLEGAL_ROWRECORD);
 }
 
+TEST_F(RpcHandlerTest, PACKED_INSERT_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+    ::milvus::grpc::InsertParam request;
+    request.set_collection_name(COLLECTION_NAME);
+
+    // all the vectors in the binary data of one record
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    std::string* packed = request.add_row_record_array()->mutable_binary_data();
+    for (auto& record : record_array) {
+        packed->append(reinterpret_cast<const char*>(record.data()), record.size() * sizeof(float));
+    }
+    auto kv = request.add_extra_params();
+    kv->set_key("packed_float_rows");
+    kv->set_value(std::to_string(VECTOR_COUNT));
+
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &request, &vector_ids);
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::SUCCESS);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    // the size doesn't match the rows
+    packed->resize(packed->size() - sizeof(float));
+    handler->Insert(&context, &request, &vector_ids);
+    ASSERT_NE(vector_ids.status().error_code(), ::milvus::grpc::SUCCESS);
+
+    kv->set_value("abc");
+    handler->Insert(&context, &request, &vector_ids);
+    ASSERT_EQ(vector_ids.status().error_code(), ::milvus::grpc::ILLEGAL_ARGUMENT);
+}
+
 TEST_F(RpcHandlerTest, SEARCH_TEST) {
     ::grpc::ServerContext context;
     handler->SetContext(&context, dummy_context);
@@ -406,6 +469,50 @@ TEST_F(RpcHandlerTest, SEARCH_TEST) {
     handler->Search(&context, &request, &response);
     ASSERT_NE(response.ids_size(), 0UL);
 
+    auto encoding = request.add_extra_params();
+    encoding->set_key("result_encoding");
+    int64_t topk = response.ids_size() / response.row_num();
+
+    for (auto& value : {"fp16_distances,delta_ids", "no_distances,delta_ids"}) {
+        encoding->set_value(value);
+        ::milvus::grpc::TopKQueryResult encoded;
+        handler->Search(&context, &request, &encoded);
+        ASSERT_EQ(encoded.status().error_code(), ::milvus::grpc::SUCCESS);
+        ASSERT_EQ(encoded.row_num(), response.row_num());
+        ASSERT_EQ(encoded.ids_size(), 2 * response.ids_size());
+        for (int64_t i = 0; i < response.row_num(); ++i) {
+            std::vector<int64_t> ids(response.ids().begin() + i * topk, response.ids().begin() + (i + 1) * topk);
+            ASSERT_EQ(DecodeDeltaIds(encoded, topk, i), ids);
+
+            std::vector<int64_t> sorted = ids;
+            sorted.erase(std::remove(sorted.begin(), sorted.end(), -1), sorted.end());
+            std::sort(sorted.begin(), sorted.end());
+            ASSERT_FALSE(sorted.empty());
+            ASSERT_EQ(encoded.ids(2 * topk * i), sorted[0]);
+        }
+    }
+
+    encoding->set_value("fp16_distances,delta_ids");
+    ::milvus::grpc::TopKQueryResult encoded;
+    handler->Search(&context, &request, &encoded);
+    ASSERT_EQ(encoded.distances_size(), (response.distances_size() + 1) / 2);
+    for (int j = 0; j < response.distances_size(); ++j) {
+        uint32_t bits;
+        float packed = encoded.distances(j / 2);
+        memcpy(&bits, &packed, sizeof(bits));
+        float distance = faiss::decode_fp16(j % 2 == 0 ? bits & 0xffff : bits >> 16);
+        ASSERT_NEAR(distance, response.distances(j), std::abs(response.distances(j)) / 512 + 1e-3);
+    }
+
+    encoding->set_value("no_distances,gzip");
+    handler->Search(&context, &request, &encoded);
+    ASSERT_EQ(encoded.ids_size(), response.ids_size());
+    ASSERT_EQ(encoded.distances_size(), 0);
+
+    encoding->set_value("fp8_distances");
+    handler->Search(&context, &request, &encoded);
+    ASSERT_EQ(encoded.status().error_code(), ::milvus::grpc::ILLEGAL_ARGUMENT);
+
     // wrong file id
     ::milvus::grpc::SearchInFilesParam search_in_files_param;
     std::string* file_id = search_in_files_param.add_file_id_array();
@@ -414,6 +521,267 @@ TEST_F(RpcHandlerTest, SEARCH_TEST) {
     ASSERT_EQ(response.ids_size(), 0UL);
 }
 
+TEST_F(RpcHandlerTest, ASYNC_SEARCH_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    std::vector<std::vector<float>> record_array;
+    BuildVectors(0, VECTOR_COUNT, record_array);
+    ::milvus::grpc::InsertParam insert_param;
+    for (auto& record : record_array) {
+        CopyRowRecord(insert_param.add_row_record_array(), record);
+    }
+    insert_param.set_collection_name(COLLECTION_NAME);
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    ::milvus::grpc::Status grpc_status;
+    ::milvus::grpc::FlushParam flush_param;
+    flush_param.add_collection_name_array(COLLECTION_NAME);
+    handler->Flush(&context, &flush_param, &grpc_status);
+
+    // the plain replies of the sync handler are the reference
+    ::milvus::grpc::SearchParam request;
+    request.set_collection_name(COLLECTION_NAME);
+    request.set_topk(10);
+    milvus::grpc::KeyValuePair* kv = request.add_extra_params();
+    kv->set_key(milvus::server::grpc::EXTRA_PARAM_KEY);
+    kv->set_value("{ \"nprobe\": 32 }");
+    BuildVectors(0, 10, record_array);
+    for (auto& record : record_array) {
+        CopyRowRecord(request.add_query_record_array(), record);
+    }
+    ::milvus::grpc::TopKQueryResult response;
+    handler->Search(&context, &request, &response);
+    ASSERT_NE(response.ids_size(), 0);
+
+    ::milvus::grpc::SearchByIDParam by_id_request;
+    by_id_request.set_collection_name(COLLECTION_NAME);
+    by_id_request.set_topk(10);
+    *by_id_request.add_extra_params() = *kv;
+    for (int64_t i = 0; i < 10; ++i) {
+        by_id_request.add_id_array(vector_ids.vector_id_array(i));
+    }
+    ::milvus::grpc::TopKQueryResult by_id_response;
+    handler->SearchByID(&context, &by_id_request, &by_id_response);
+    ASSERT_NE(by_id_response.ids_size(), 0);
+
+    // the same handler serves Search and SearchByID through the callback methods
+    handler->EnableAsyncMode();
+    int port = 0;
+    ::grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", ::grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(handler.get());
+    std::vector<std::unique_ptr<::grpc::experimental::ServerInterceptorFactoryInterface>> creators;
+    creators.push_back(std::unique_ptr<::grpc::experimental::ServerInterceptorFactoryInterface>(
+        new milvus::server::grpc::SpanInterceptorFactory(handler.get())));
+    builder.experimental().SetInterceptorCreators(std::move(creators));
+    auto server = builder.BuildAndStart();
+    ASSERT_NE(server, nullptr);
+
+    auto channel = ::grpc::CreateChannel("127.0.0.1:" + std::to_string(port), ::grpc::InsecureChannelCredentials());
+    auto stub = ::milvus::grpc::MilvusService::NewStub(channel);
+
+    auto check_encoded = [](const ::milvus::grpc::TopKQueryResult& plain,
+                            const ::milvus::grpc::TopKQueryResult& encoded) {
+        ASSERT_EQ(encoded.status().error_code(), ::milvus::grpc::SUCCESS);
+        ASSERT_EQ(encoded.row_num(), plain.row_num());
+        ASSERT_EQ(encoded.ids_size(), 2 * plain.ids_size());
+        ASSERT_EQ(encoded.distances_size(), 0);
+        int64_t topk = plain.ids_size() / plain.row_num();
+        for (int64_t i = 0; i < plain.row_num(); ++i) {
+            std::vector<int64_t> ids(plain.ids().begin() + i * topk, plain.ids().begin() + (i + 1) * topk);
+            ASSERT_EQ(DecodeDeltaIds(encoded, topk, i), ids);
+        }
+    };
+
+    auto encoding = request.add_extra_params();
+    encoding->set_key("result_encoding");
+    encoding->set_value("no_distances,delta_ids");
+    *by_id_request.add_extra_params() = *encoding;
+
+    {
+        ::grpc::ClientContext client_context;
+        ::milvus::grpc::TopKQueryResult encoded;
+        ASSERT_TRUE(stub->Search(&client_context, request, &encoded).ok());
+        check_encoded(response, encoded);
+    }
+    {
+        ::grpc::ClientContext client_context;
+        ::milvus::grpc::TopKQueryResult encoded;
+        ASSERT_TRUE(stub->SearchByID(&client_context, by_id_request, &encoded).ok());
+        check_encoded(by_id_response, encoded);
+    }
+
+    // the cost asked for comes back in the trailing metadata
+    kv->set_value("{ \"nprobe\": 32, \"with_cost\": true }");
+    {
+        ::grpc::ClientContext client_context;
+        ::milvus::grpc::TopKQueryResult encoded;
+        ASSERT_TRUE(stub->Search(&client_context, request, &encoded).ok());
+        check_encoded(response, encoded);
+        ASSERT_EQ(client_context.GetServerTrailingMetadata().count("search-cost"), 1UL);
+    }
+
+    // an unknown encoding is rejected before the search is scheduled
+    encoding->set_value("fp8_distances");
+    *by_id_request.mutable_extra_params(1) = *encoding;
+    {
+        ::grpc::ClientContext client_context;
+        ::milvus::grpc::TopKQueryResult encoded;
+        ASSERT_TRUE(stub->Search(&client_context, request, &encoded).ok());
+        ASSERT_EQ(encoded.status().error_code(), ::milvus::grpc::ILLEGAL_ARGUMENT);
+    }
+    {
+        ::grpc::ClientContext client_context;
+        ::milvus::grpc::TopKQueryResult encoded;
+        ASSERT_TRUE(stub->SearchByID(&client_context, by_id_request, &encoded).ok());
+        ASSERT_EQ(encoded.status().error_code(), ::milvus::grpc::ILLEGAL_ARGUMENT);
+    }
+
+    server->Shutdown();
+}
+
+TEST_F(RpcHandlerTest, AGGREGATE_TEST) {
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->RegisterRequestHandler(milvus::server::RequestHandler());
+
+    std::string collection_name = "test_aggregate";
+    ::milvus::grpc::CollectionSchema collection_schema;
+    ::milvus::grpc::Status grpc_status;
+    collection_schema.set_collection_name(collection_name);
+    collection_schema.set_dimension(COLLECTION_DIM);
+    collection_schema.set_index_file_size(INDEX_FILE_SIZE);
+    collection_schema.set_metric_type(2);  // IP metric
+    handler->CreateCollection(&context, &collection_schema, &grpc_status);
+    ASSERT_EQ(grpc_status.error_code(), ::milvus::grpc::SUCCESS);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    ::milvus::grpc::InsertParam insert_param;
+    insert_param.set_collection_name(collection_name);
+    std::vector<float> record(COLLECTION_DIM);
+    for (int64_t i = 0; i < VECTOR_COUNT; ++i) {
+        for (auto& value : record) {
+            value = uniform(rng);
+        }
+        CopyRowRecord(insert_param.add_row_record_array(), record);
+    }
+    ::milvus::grpc::VectorIds vector_ids;
+    handler->Insert(&context, &insert_param, &vector_ids);
+    ASSERT_EQ(vector_ids.vector_id_array_size(), VECTOR_COUNT);
+
+    ::milvus::grpc::FlushParam flush_param;
+    flush_param.add_collection_name_array(collection_name);
+    handler->Flush(&context, &flush_param, &grpc_status);
+
+    // three query vectors among the inserted ones, so that their results overlap
+    const int64_t topk = 10;
+    ::milvus::grpc::SearchParam request;
+    request.set_collection_name(collection_name);
+    request.set_topk(topk);
+    for (int64_t i : {0, 1, 2}) {
+        *request.add_query_record_array() = insert_param.row_record_array(i);
+    }
+    auto kv = request.add_extra_params();
+    kv->set_key(milvus::server::grpc::EXTRA_PARAM_KEY);
+    kv->set_value("{ \"nprobe\": 32 }");
+    ::milvus::grpc::TopKQueryResult plain;
+    handler->Search(&context, &request, &plain);
+    ASSERT_EQ(plain.status().error_code(), ::milvus::grpc::SUCCESS);
+    ASSERT_EQ(plain.row_num(), 3);
+
+    // an entity scores the sum of its inner products over the queries whose top k it is in
+    std::unordered_map<int64_t, float> scores;
+    for (int i = 0; i < plain.ids_size(); ++i) {
+        if (plain.ids(i) != -1) {
+            scores[plain.ids(i)] += plain.distances(i);
+        }
+    }
+    std::vector<std::pair<float, int64_t>> ranked;
+    for (auto& pair : scores) {
+        ranked.emplace_back(pair.second, pair.first);
+    }
+    std::sort(ranked.begin(), ranked.end(), std::greater<std::pair<float, int64_t>>());
+    ranked.resize(std::min<size_t>(topk, ranked.size()));
+
+    kv->set_value("{ \"nprobe\": 32, \"aggregate\": \"max_sim\" }");
+    ::milvus::grpc::TopKQueryResult aggregated;
+    handler->Search(&context, &request, &aggregated);
+    ASSERT_EQ(aggregated.status().error_code(), ::milvus::grpc::SUCCESS);
+    ASSERT_EQ(aggregated.row_num(), 1);
+    ASSERT_EQ(aggregated.ids_size(), static_cast<int>(ranked.size()));
+    for (size_t j = 0; j < ranked.size(); ++j) {
+        ASSERT_EQ(aggregated.ids(j), ranked[j].second);
+        ASSERT_EQ(aggregated.distances(j), ranked[j].first);
+    }
+
+    // an unknown aggregation, one that isn't a string, and along with more collections
+    for (auto& value : {"{ \"nprobe\": 32, \"aggregate\": \"sum\" }", "{ \"nprobe\": 32, \"aggregate\": 1 }",
+                        "{ \"nprobe\": 32, \"aggregate\": \"max_sim\", \"collections\": [\"test_grpc\"] }"}) {
+        kv->set_value(value);
+        ::milvus::grpc::TopKQueryResult rejected;
+        handler->Search(&context, &request, &rejected);
+        ASSERT_EQ(rejected.status().error_code(), ::milvus::grpc::ILLEGAL_ARGUMENT) << value;
+    }
+
+    // the score is an inner product, the L2 collection of the fixture is rejected
+    kv->set_value("{ \"nprobe\": 32, \"aggregate\": \"max_sim\" }");
+    request.set_collection_name(COLLECTION_NAME);
+    ::milvus::grpc::TopKQueryResult rejected;
+    handler->Search(&context, &request, &rejected);
+    ASSERT_EQ(rejected.status().error_code(), ::milvus::grpc::ILLEGAL_ARGUMENT);
+}
+
+TEST_F(RpcHandlerTest, COORDINATOR_TEST) {
+    using GrpcCoordinator = milvus::server::grpc::GrpcCoordinator;
+
+    // two queries, top 3, the second shard has a single vector
+    ::milvus::grpc::TopKQueryResult shard_a, shard_b;
+    for (int64_t id : {1, 2, 3, 11, 12, 13}) {
+        shard_a.add_ids(id);
+    }
+    for (float distance : {0.1f, 0.4f, 0.5f, 0.2f, 0.3f, 0.9f}) {
+        shard_a.add_distances(distance);
+    }
+    shard_b.add_ids(100);
+    shard_b.add_distances(0.2f);
+    shard_b.add_ids(200);
+    shard_b.add_distances(0.8f);
+
+    milvus::engine::ResultIds ids;
+    milvus::engine::ResultDistances distances;
+    ASSERT_TRUE(GrpcCoordinator::MergeShardResult(shard_a, 2, 3, true, ids, distances).ok());
+    ASSERT_TRUE(GrpcCoordinator::MergeShardResult(shard_b, 2, 3, true, ids, distances).ok());
+    ASSERT_EQ(ids, milvus::engine::ResultIds({1, 100, 2, 11, 12, 200}));
+
+    // an empty shard is skipped, a shard answering another query is an error
+    ASSERT_TRUE(GrpcCoordinator::MergeShardResult(::milvus::grpc::TopKQueryResult(), 2, 3, true, ids, distances).ok());
+    ASSERT_FALSE(GrpcCoordinator::MergeShardResult(shard_b, 3, 3, true, ids, distances).ok());
+
+    // no replica of the shard answers
+    ::milvus::grpc::SearchParam request;
+    request.set_collection_name(COLLECTION_NAME);
+    request.set_topk(3);
+    ::milvus::grpc::TopKQueryResult response;
+    GrpcCoordinator coordinator({{"127.0.0.1:1", "127.0.0.1:2"}}, 10);
+    ASSERT_FALSE(coordinator.Search(nullptr, request, response).ok());
+
+    request.set_collection_name("coordinator_test_no_collection");
+    ASSERT_FALSE(coordinator.Search(nullptr, request, response).ok());
+
+    ::grpc::ServerContext context;
+    handler->SetContext(&context, dummy_context);
+    handler->EnableCoordinator(std::make_shared<GrpcCoordinator>(std::vector<std::vector<std::string>>(), 0));
+    request.set_collection_name(COLLECTION_NAME);
+    handler->Search(&context, &request, &response);
+    ASSERT_EQ(response.status().error_code(), ::milvus::grpc::SUCCESS);
+    ASSERT_EQ(response.ids_size(), 0);
+}
+
 TEST_F(RpcHandlerTest, COMBINE_SEARCH_TEST) {
     ::grpc::ServerContext context;
     handler->SetContext(&context, dummy_context);
@@ -1715,6 +2083,27 @@ TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     milvus::server::RequestScheduler::GetInstance().Stop();
 }
 
+TEST_F(RpcSchedulerTest, ASYNC_REQUEST_TEST) {
+    milvus::server::RequestScheduler::GetInstance().Start();
+
+    // the callback gets the status once the executor is done with the request
+    std::promise<milvus::Status> done;
+    milvus::server::RequestScheduler::ExecRequestAsync(
+        DummyRequest::Create(), [&done](const milvus::Status& status) { done.set_value(status); });
+    ASSERT_TRUE(done.get_future().get().ok());
+
+    // a request failing to be queued is done at once with the error
+    fiu_init(0);
+    fiu_enable("RequestScheduler.ExecuteRequest.push_queue_fail", 1, NULL, 0);
+    std::promise<milvus::Status> failed;
+    milvus::server::RequestScheduler::ExecRequestAsync(
+        DummyRequest::Create(), [&failed](const milvus::Status& status) { failed.set_value(status); });
+    fiu_disable("RequestScheduler.ExecuteRequest.push_queue_fail");
+    ASSERT_FALSE(failed.get_future().get().ok());
+
+    milvus::server::RequestScheduler::GetInstance().Stop();
+}
+
 TEST(RpcTest, RPC_SERVER_TEST) {
     using GrpcServer = milvus::server::grpc::GrpcServer;
     GrpcServer& server = GrpcServer::GetInstance();
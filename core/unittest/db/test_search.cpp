@@ -10,7 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <random>
+#include <tuple>
 #include <vector>
 
 #include "scheduler/job/SearchJob.h"
@@ -162,6 +166,230 @@ TEST(DBSearchTest, MERGE_RESULT_SET_TEST) {
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
 }
 
+void
+ReduceResultPartsTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending, bool offsets = false) {
+    ms::ResultIds ids1, ids2;
+    ms::ResultDistances dist1, dist2;
+    BuildResult(ids1, dist1, topk_1, topk, nq, ascending);
+    BuildResult(ids2, dist2, topk_2, topk, nq, ascending);
+
+    milvus::engine::VectorsData vectors;
+    auto job = std::make_shared<ms::SearchJob>(nullptr, topk, milvus::json(), vectors);
+    ms::SearchResultPart part1(&job->arena()), part2(&job->arena());
+    part1.ids_.assign(ids1.begin(), ids1.end());
+    part1.distances_.assign(dist1.begin(), dist1.end());
+    part1.k_ = topk_1;
+    part1.stride_ = topk;
+    part2.ids_.assign(ids2.begin(), ids2.end());
+    part2.distances_.assign(dist2.begin(), dist2.end());
+    part2.k_ = topk_2;
+    part2.stride_ = topk;
+    if (offsets) {
+        // the second part as the row offsets of a segment whose row i has the id ids2[i]
+        part2.ids_.clear();
+        part2.uids_ = std::make_shared<std::vector<int64_t>>(ids2.begin(), ids2.end());
+        for (size_t i = 0; i < ids2.size(); ++i) {
+            part2.offsets_.push_back(ids2[i] == -1 ? -1 : static_cast<int32_t>(i));
+        }
+    }
+    job->AddResultPart(std::move(part1), nq, topk, ascending);
+    job->AddResultPart(std::move(part2), nq, topk, ascending);
+    job->WaitResult();
+
+    CheckTopkResult(ids1, dist1, topk_1, ids2, dist2, topk_2, topk, nq, ascending, job->GetResultIds(),
+                    job->GetResultDistances());
+}
+
+TEST(DBSearchTest, REDUCE_RESULT_PARTS_TEST) {
+    size_t NQ = 100;
+    size_t TOP_K = 64;
+
+    ReduceResultPartsTest(TOP_K, 0, NQ, TOP_K, true);
+    ReduceResultPartsTest(TOP_K, 0, NQ, TOP_K, false);
+    ReduceResultPartsTest(TOP_K, TOP_K, NQ, TOP_K, true);
+    ReduceResultPartsTest(TOP_K, TOP_K, NQ, TOP_K, false);
+    ReduceResultPartsTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, true);
+    ReduceResultPartsTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
+    ReduceResultPartsTest(TOP_K, TOP_K, NQ, TOP_K, true, true);
+    ReduceResultPartsTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false, true);
+}
+
+TEST(DBSearchTest, REDUCE_RESULT_PARTS_RANDOM_TEST) {
+    // the loser tree merge of the job against the pairwise merge into the result set, on random part layouts:
+    // parts empty, shorter than topk or padded with -1 the way faiss pads them, 1 to 13 parts per job
+    std::mt19937 rng(42);
+    auto uniform = [&rng](size_t lo, size_t hi) { return std::uniform_int_distribution<size_t>(lo, hi)(rng); };
+    for (size_t round = 0; round < 300; ++round) {
+        size_t nq = uniform(1, 40);
+        size_t topk = uniform(1, 32);
+        size_t m = round < 20 ? 1 : uniform(1, 13);
+        bool ascending = round % 2 == 0;
+        float padding = ascending ? std::numeric_limits<float>::max() : -std::numeric_limits<float>::max();
+
+        milvus::engine::VectorsData vectors;
+        auto job = std::make_shared<ms::SearchJob>(nullptr, topk, milvus::json(), vectors);
+        ms::ResultIds pairwise_ids;
+        ms::ResultDistances pairwise_distances;
+        for (size_t p = 0; p < m; ++p) {
+            size_t k = uniform(0, 3) == 0 ? 0 : uniform(1, topk);
+            ms::ResultIds ids(nq * topk, -1);
+            ms::ResultDistances distances(nq * topk, padding);
+            for (size_t i = 0; i < nq; ++i) {
+                size_t valid = uniform(0, 2) == 0 ? uniform(0, k) : k;
+                std::vector<float> row(valid);
+                for (auto& distance : row) {
+                    // a few distinct values, so that the parts tie
+                    distance = static_cast<float>(uniform(0, 50)) / 4;
+                }
+                std::sort(row.begin(), row.end());
+                if (!ascending) {
+                    std::reverse(row.begin(), row.end());
+                }
+                for (size_t j = 0; j < valid; ++j) {
+                    ids[i * topk + j] = static_cast<int64_t>(p * 100000 + i * 1000 + j);
+                    distances[i * topk + j] = row[j];
+                }
+            }
+
+            ms::XSearchTask::MergeTopkToResultSet(ids, distances, k, nq, topk, ascending, pairwise_ids,
+                                                  pairwise_distances);
+            ms::SearchResultPart part(&job->arena());
+            part.ids_.assign(ids.begin(), ids.end());
+            part.distances_.assign(distances.begin(), distances.end());
+            part.k_ = k;
+            part.stride_ = topk;
+            job->AddResultPart(std::move(part), nq, topk, ascending);
+        }
+        job->WaitResult();
+
+        ASSERT_EQ(job->GetResultIds(), pairwise_ids) << "round " << round;
+        ASSERT_EQ(job->GetResultDistances(), pairwise_distances) << "round " << round;
+    }
+}
+
+TEST(DBSearchTest, REDUCE_RESULT_GROUPS_TEST) {
+    size_t NQ = 20;
+    size_t TOP_K = 8;
+
+    milvus::engine::VectorsData vectors;
+    vectors.vector_count_ = NQ;
+    auto job = std::make_shared<ms::SearchJob>(nullptr, TOP_K, milvus::json(), vectors);
+    job->SetResultGroups(3);
+    ASSERT_TRUE(job->parallel_reduce());
+
+    // two parts of the first group, one of the third, none of the second
+    ms::ResultIds ids1, ids2, ids3;
+    ms::ResultDistances dist1, dist2, dist3;
+    BuildResult(ids1, dist1, TOP_K, TOP_K, NQ, true);
+    BuildResult(ids2, dist2, TOP_K / 2, TOP_K, NQ, true);
+    BuildResult(ids3, dist3, TOP_K, TOP_K, NQ, true);
+    std::vector<std::tuple<ms::ResultIds*, ms::ResultDistances*, size_t, size_t>> parts = {
+        {&ids1, &dist1, TOP_K, 0}, {&ids2, &dist2, TOP_K / 2, 0}, {&ids3, &dist3, TOP_K, 2}};
+    for (auto& item : parts) {
+        ms::SearchResultPart part(&job->arena());
+        part.ids_.assign(std::get<0>(item)->begin(), std::get<0>(item)->end());
+        part.distances_.assign(std::get<1>(item)->begin(), std::get<1>(item)->end());
+        part.k_ = std::get<2>(item);
+        part.stride_ = TOP_K;
+        part.group_ = std::get<3>(item);
+        job->AddResultPart(std::move(part), NQ, TOP_K, true);
+    }
+    job->WaitResult();
+
+    auto& ids = job->GetResultIds();
+    auto& distances = job->GetResultDistances();
+    ASSERT_EQ(ids.size(), 3 * NQ * TOP_K);
+    ms::ResultIds group0(ids.begin(), ids.begin() + NQ * TOP_K);
+    ms::ResultDistances group0_dist(distances.begin(), distances.begin() + NQ * TOP_K);
+    CheckTopkResult(ids1, dist1, TOP_K, ids2, dist2, TOP_K / 2, TOP_K, NQ, true, group0, group0_dist);
+    for (size_t i = NQ * TOP_K; i < 2 * NQ * TOP_K; ++i) {
+        ASSERT_EQ(ids[i], -1);
+    }
+    for (size_t i = 0; i < NQ * TOP_K; ++i) {
+        ASSERT_EQ(ids[2 * NQ * TOP_K + i], ids3[i]);
+    }
+}
+
+TEST(DBSearchTest, TOPK_BOUNDS_TEST) {
+    size_t NQ = 3;
+    size_t TOP_K = 2;
+
+    milvus::engine::VectorsData vectors;
+    vectors.vector_count_ = NQ;
+    auto job = std::make_shared<ms::SearchJob>(nullptr, TOP_K, milvus::json(), vectors);
+
+    std::vector<float> bounds;
+    ASSERT_FALSE(job->GetTopkBounds(true, bounds));
+
+    // the second query has less than topk results, the file with less than topk rows is ignored
+    ms::ResultIds ids1 = {1, 2, 3, -1, 5, 6};
+    ms::ResultDistances dist1 = {0.1, 0.5, 0.2, 0.0, 0.3, 0.9};
+    job->UpdateTopkBounds(ids1, dist1, TOP_K, NQ, TOP_K, true);
+    job->UpdateTopkBounds(ids1, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, 1, NQ, TOP_K, true);
+
+    ASSERT_FALSE(job->GetTopkBounds(false, bounds));
+    ASSERT_TRUE(job->GetTopkBounds(true, bounds));
+    ASSERT_EQ(bounds.size(), NQ);
+    ASSERT_FLOAT_EQ(bounds[0], 0.5);
+    ASSERT_TRUE(std::isinf(bounds[1]));
+    ASSERT_FLOAT_EQ(bounds[2], 0.9);
+
+    // bounds only get tighter
+    ms::ResultIds ids2 = {7, 8, 9, 10, 11, 12};
+    ms::ResultDistances dist2 = {0.1, 0.7, 0.1, 0.4, 0.2, 0.6};
+    job->UpdateTopkBounds(ids2, dist2, TOP_K, NQ, TOP_K, true);
+    ASSERT_TRUE(job->GetTopkBounds(true, bounds));
+    ASSERT_FLOAT_EQ(bounds[0], 0.5);
+    ASSERT_FLOAT_EQ(bounds[1], 0.4);
+    ASSERT_FLOAT_EQ(bounds[2], 0.6);
+
+    // files disagreeing on the order disable the bounds
+    job->UpdateTopkBounds(ids2, dist2, TOP_K, NQ, TOP_K, false);
+    ASSERT_FALSE(job->GetTopkBounds(true, bounds));
+}
+
+TEST(DBSearchTest, REQUEST_PARAMS_TEST) {
+    milvus::engine::VectorsData vectors;
+    auto job = std::make_shared<ms::SearchJob>(
+        nullptr, 10, milvus::json{{"nprobe", 16}, {"segment_probe", "2"}, {"radius", 1.5}, {"refine_k", 40}}, vectors);
+    auto& params = job->request_params();
+    ASSERT_EQ(params.nprobe_, 16);
+    ASSERT_EQ(params.segment_probe_, 0);
+    ASSERT_TRUE(params.range_);
+    ASSERT_FLOAT_EQ(params.radius_, 1.5);
+    ASSERT_EQ(params.refine_k_, 40);
+    ASSERT_EQ(job->extra_params()["nprobe"].get<int64_t>(), 16);
+
+    auto plain_job = std::make_shared<ms::SearchJob>(nullptr, 10, milvus::json(), vectors);
+    ASSERT_FALSE(plain_job->request_params().range_);
+    ASSERT_EQ(plain_job->request_params().nprobe_, 0);
+    ASSERT_EQ(plain_job->request_params().refine_k_, 0);
+}
+
+TEST(DBSearchTest, SEARCH_PARAMS_TEST) {
+    milvus::engine::VectorsData vectors;
+    vectors.vector_count_ = 1;
+    auto job = std::make_shared<ms::SearchJob>(nullptr, 10, milvus::json{{"nprobe", 8}}, vectors);
+
+    // the params of a key are compiled once, the other keys get their own
+    int compiled = 0;
+    auto compile = [&](ms::SearchParams& params) {
+        ++compiled;
+        params.conf_ = job->extra_params();
+        params.valid_ = true;
+    };
+    auto params1 = job->GetSearchParams("IVF_FLAT/0/10", compile);
+    auto params2 = job->GetSearchParams("IVF_FLAT/0/10", compile);
+    ASSERT_EQ(params1, params2);
+    ASSERT_EQ(compiled, 1);
+    ASSERT_TRUE(params1->valid_);
+    ASSERT_EQ(params1->conf_["nprobe"].get<int64_t>(), 8);
+
+    auto params3 = job->GetSearchParams("IVF_FLAT/0/20", compile);
+    ASSERT_NE(params1, params3);
+    ASSERT_EQ(compiled, 2);
+}
+
 //void MergeTopkArrayTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
 //    std::vector<int64_t> ids1, ids2;
 //    std::vector<float> dist1, dist2;
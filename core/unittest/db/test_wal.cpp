@@ -15,7 +15,12 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <thread>
@@ -25,6 +30,7 @@
 #include "db/wal/WalFileHandler.h"
 #include "db/wal/WalManager.h"
 #include "db/wal/WalMetaHandler.h"
+#include "db/wal/WalReplayer.h"
 #include "utils/Error.h"
 
 namespace {
@@ -662,6 +668,248 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     }
 }
 
+TEST(WalTest, COMPRESS_BUFFER_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::wal::MXLogBuffer buffer(WAL_GTEST_PATH, 2048);
+    buffer.mxlog_buffer_size_ = 100000;
+    buffer.Reset((uint64_t)1 << 32);
+    buffer.SetCompress(true);
+
+    const uint32_t length = 100;
+    std::vector<milvus::engine::IDNumber> ids(length);
+    std::vector<float> vectors(length * 8);
+    std::vector<uint8_t> binary_vectors(length * 8);
+    std::default_random_engine e;
+    std::uniform_int_distribution<unsigned> u(0, 255);
+    for (uint32_t i = 0; i < length; ++i) {
+        ids[i] = 1000000 + i;
+    }
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        vectors[i] = (float)(i % 16) * 0.5f;
+        binary_vectors[i] = u(e);
+    }
+
+    milvus::engine::wal::MXLogRecord record[4];
+    record[0].type = milvus::engine::wal::MXLogType::InsertVector;
+    record[0].collection_id = "insert_table";
+    record[0].partition_tag = "parti1";
+    record[0].length = length;
+    record[0].ids = ids.data();
+    record[0].data_size = vectors.size() * sizeof(float);
+    record[0].data = vectors.data();
+
+    record[1].type = milvus::engine::wal::MXLogType::Delete;
+    record[1].collection_id = "insert_table";
+    record[1].length = 10;
+    record[1].ids = ids.data();
+    record[1].data_size = 0;
+    record[1].data = nullptr;
+
+    // the data doesn't shrink, the ids do
+    record[2].type = milvus::engine::wal::MXLogType::InsertBinary;
+    record[2].collection_id = "insert_table";
+    record[2].length = length;
+    record[2].ids = ids.data();
+    record[2].data_size = binary_vectors.size();
+    record[2].data = binary_vectors.data();
+
+    // nothing to compress
+    record[3].type = milvus::engine::wal::MXLogType::Flush;
+    record[3].collection_id = "insert_table";
+    record[3].length = 0;
+    record[3].ids = nullptr;
+    record[3].data_size = 0;
+    record[3].data = nullptr;
+
+    uint64_t last_lsn = buffer.GetReadLsn();
+    for (auto& rcd : record) {
+        ASSERT_EQ(buffer.Append(rcd), milvus::WAL_SUCCESS);
+        uint32_t written = (uint32_t)(rcd.lsn & LSN_OFFSET_MASK) - (uint32_t)(last_lsn & LSN_OFFSET_MASK);
+        if (rcd.length > 0) {
+            ASSERT_LT(written, buffer.RecordSize(rcd));
+        } else {
+            ASSERT_EQ(written, buffer.RecordSize(rcd));
+        }
+        last_lsn = rcd.lsn;
+    }
+
+    milvus::engine::wal::MXLogRecord read_rst;
+    for (auto& rcd : record) {
+        ASSERT_EQ(buffer.Next(last_lsn, read_rst), milvus::WAL_SUCCESS);
+        ASSERT_EQ(read_rst.type, rcd.type);
+        ASSERT_EQ(read_rst.collection_id, rcd.collection_id);
+        ASSERT_EQ(read_rst.partition_tag, rcd.partition_tag);
+        ASSERT_EQ(read_rst.length, rcd.length);
+        ASSERT_EQ(read_rst.data_size, rcd.data_size);
+        if (rcd.length > 0) {
+            ASSERT_EQ(memcmp(read_rst.ids, rcd.ids, rcd.length * sizeof(milvus::engine::IDNumber)), 0);
+        }
+        if (rcd.data_size > 0) {
+            ASSERT_EQ(memcmp(read_rst.data, rcd.data, rcd.data_size), 0);
+        }
+    }
+    ASSERT_EQ(buffer.Next(last_lsn, read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+
+    // entity, the attribute columns are encoded by their element size
+    milvus::engine::wal::MXLogRecord entity;
+    entity.type = milvus::engine::wal::MXLogType::Entity;
+    entity.collection_id = "insert_hybrid_collection";
+    entity.length = length;
+    entity.ids = ids.data();
+    entity.data_size = vectors.size() * sizeof(float);
+    entity.data = vectors.data();
+    entity.field_names = {"timestamp", "score"};
+    std::vector<int64_t> timestamps(length);
+    std::vector<float> scores(length);
+    for (uint32_t i = 0; i < length; ++i) {
+        timestamps[i] = 1590000000 + i * 3;
+        scores[i] = (float)(i % 4);
+    }
+    auto add_attr = [&](const std::string& name, const void* data, uint64_t nbytes) {
+        auto bytes = static_cast<const uint8_t*>(data);
+        entity.attr_nbytes[name] = nbytes;
+        entity.attr_data_size[name] = length * nbytes;
+        entity.attr_data[name] = std::vector<uint8_t>(bytes, bytes + length * nbytes);
+    };
+    add_attr("timestamp", timestamps.data(), sizeof(int64_t));
+    add_attr("score", scores.data(), sizeof(float));
+
+    ASSERT_EQ(buffer.AppendEntity(entity), milvus::WAL_SUCCESS);
+    ASSERT_EQ(buffer.NextEntity(entity.lsn, read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, entity.type);
+    ASSERT_EQ(read_rst.collection_id, entity.collection_id);
+    ASSERT_EQ(read_rst.length, entity.length);
+    ASSERT_EQ(memcmp(read_rst.ids, entity.ids, entity.length * sizeof(milvus::engine::IDNumber)), 0);
+    ASSERT_EQ(read_rst.data_size, entity.data_size);
+    ASSERT_EQ(memcmp(read_rst.data, entity.data, entity.data_size), 0);
+    ASSERT_EQ(read_rst.field_names, entity.field_names);
+    for (auto& name : entity.field_names) {
+        ASSERT_EQ(read_rst.attr_nbytes.at(name), entity.attr_nbytes.at(name));
+        ASSERT_EQ(read_rst.attr_data_size.at(name), entity.attr_data_size.at(name));
+        ASSERT_EQ(read_rst.attr_data.at(name), entity.attr_data.at(name));
+    }
+}
+
+TEST(WalTest, BUFFER_RESIZE_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::wal::MXLogBuffer buffer(WAL_GTEST_PATH, 2048);
+    buffer.mxlog_buffer_size_ = 8192;
+    buffer.Reset((uint64_t)1 << 32);
+
+    const uint32_t length = 100;
+    std::vector<milvus::engine::IDNumber> ids(length);
+    std::vector<float> vectors(length);
+    milvus::engine::wal::MXLogRecord record;
+    record.type = milvus::engine::wal::MXLogType::InsertVector;
+    record.collection_id = "insert_table";
+    record.length = length;
+    record.ids = ids.data();
+    record.data_size = vectors.size() * sizeof(float);
+    record.data = vectors.data();
+
+    // the reader stays behind, the files written after each change are loaded into its buffer from disk
+    int64_t next_id = 0;
+    auto append = [&](int64_t count) {
+        for (int64_t i = 0; i < count; ++i) {
+            ids[0] = next_id++;
+            ASSERT_EQ(buffer.Append(record), milvus::WAL_SUCCESS);
+        }
+    };
+    append(20);
+    buffer.SetBufferSize(32768);
+    ASSERT_EQ(buffer.GetBufferSize(), 8192);
+    append(60);
+    ASSERT_EQ(buffer.GetBufferSize(), 32768);
+    buffer.SetBufferSize(4096);
+    append(40);
+    ASSERT_EQ(buffer.GetBufferSize(), 4096);
+
+    milvus::engine::wal::MXLogRecord read_rst;
+    for (int64_t i = 0; i < next_id; ++i) {
+        ASSERT_EQ(buffer.Next(record.lsn, read_rst), milvus::WAL_SUCCESS);
+        ASSERT_EQ(read_rst.type, record.type);
+        ASSERT_EQ(read_rst.length, length);
+        ASSERT_EQ(read_rst.ids[0], i);
+    }
+    ASSERT_EQ(buffer.Next(record.lsn, read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+}
+
+TEST(WalTest, CONCURRENT_BUFFER_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::wal::MXLogBuffer buffer(WAL_GTEST_PATH, 2048);
+    // small enough to switch the wal file many times
+    buffer.mxlog_buffer_size_ = 8192;
+    buffer.Reset((uint64_t)1 << 32);
+
+    const int64_t thread_num = 4;
+    const int64_t record_num = 200;
+    const uint32_t dim = 4;
+    std::vector<std::thread> threads;
+    std::atomic<uint64_t> last_lsn(0);
+    std::atomic<int64_t> failed(0);
+    for (int64_t t = 0; t < thread_num; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int64_t i = 0; i < record_num; ++i) {
+                uint32_t length = i % 10 + 1;
+                std::vector<milvus::engine::IDNumber> ids(length, t << 32 | i);
+                std::vector<float> vectors(length * dim, (float)t);
+
+                milvus::engine::wal::MXLogRecord record;
+                record.type = milvus::engine::wal::MXLogType::InsertVector;
+                record.collection_id = "collection_" + std::to_string(t);
+                record.length = length;
+                record.ids = ids.data();
+                record.data_size = vectors.size() * sizeof(float);
+                record.data = vectors.data();
+                if (buffer.Append(record) != milvus::WAL_SUCCESS) {
+                    ++failed;
+                    continue;
+                }
+
+                uint64_t lsn = last_lsn;
+                while (lsn < record.lsn && !last_lsn.compare_exchange_weak(lsn, record.lsn)) {
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(failed, 0);
+    ASSERT_GT(buffer.mxlog_buffer_writer_.file_no, 1);
+    ASSERT_EQ(buffer.committed_lsn_, buffer.reserved_lsn_);
+
+    // every record is read back once and the records of a thread keep their order
+    std::vector<int64_t> next(thread_num, 0);
+    milvus::engine::wal::MXLogRecord read_rst;
+    uint64_t read_lsn = 0;
+    for (int64_t n = 0; n < thread_num * record_num; ++n) {
+        ASSERT_EQ(buffer.Next(last_lsn, read_rst), milvus::WAL_SUCCESS);
+        ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::InsertVector);
+        ASSERT_GT(read_rst.lsn, read_lsn);
+        read_lsn = read_rst.lsn;
+
+        int64_t t = read_rst.ids[0] >> 32;
+        ASSERT_LT(t, thread_num);
+        ASSERT_EQ(read_rst.collection_id, "collection_" + std::to_string(t));
+        ASSERT_EQ(read_rst.ids[0], t << 32 | next[t]);
+        ASSERT_EQ(read_rst.length, next[t] % 10 + 1);
+        ASSERT_EQ(read_rst.data_size, read_rst.length * dim * sizeof(float));
+        for (uint32_t i = 0; i < read_rst.length * dim; ++i) {
+            ASSERT_EQ(((const float*)read_rst.data)[i], (float)t);
+        }
+        ++next[t];
+    }
+    ASSERT_EQ(read_lsn, last_lsn);
+    ASSERT_EQ(buffer.Next(last_lsn, read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+}
+
 TEST(WalTest, MANAGER_INIT_TEST) {
     MakeEmptyTestPath();
 
@@ -742,6 +990,132 @@ TEST(WalTest, MANAGER_APPEND_FAILED) {
     ASSERT_FALSE(manager->DeleteById(schema.collection_id_, ids));
 }
 
+TEST(WalTest, MANAGER_SYNC_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::DBMetaOptions opt = {WAL_GTEST_PATH};
+    milvus::engine::meta::MetaPtr meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+
+    milvus::engine::wal::MXLogConfiguration wal_config;
+    wal_config.mxlog_path = WAL_GTEST_PATH;
+    wal_config.buffer_size = 64;
+    wal_config.recovery_error_ignore = true;
+    wal_config.sync_interval = 5;
+
+    std::string table_id = "table1";
+    std::vector<int64_t> ids(16, 0);
+    std::vector<float> data_float(16 * 64, 0);
+
+    // none: no sync thread
+    wal_config.sync_mode = milvus::engine::wal::MXLogSyncMode::NONE;
+    auto manager = std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+    ASSERT_FALSE(manager->sync_running_);
+    manager->CreateCollection(table_id);
+    ASSERT_TRUE(manager->Insert(table_id, "", ids, data_float));
+    ASSERT_EQ(manager->WaitSynced(), milvus::WAL_SUCCESS);
+    manager = nullptr;
+
+    // interval: the writer doesn't wait, the records are synced in the background
+    MakeEmptyTestPath();
+    meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+    wal_config.sync_mode = milvus::engine::wal::MXLogSyncMode::INTERVAL;
+    manager = std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+    ASSERT_TRUE(manager->sync_running_);
+    manager->CreateCollection(table_id);
+    ASSERT_TRUE(manager->Insert(table_id, "", ids, data_float));
+    ASSERT_EQ(manager->WaitSynced(), milvus::WAL_SUCCESS);
+    for (int i = 0; i < 100 && manager->synced_lsn_ < manager->last_applied_lsn_; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(manager->synced_lsn_, manager->last_applied_lsn_);
+    manager = nullptr;
+
+    // batch: every writer returns after its records are synced, concurrent writers share the syncs
+    MakeEmptyTestPath();
+    meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+    wal_config.sync_mode = milvus::engine::wal::MXLogSyncMode::BATCH;
+    manager = std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+    manager->CreateCollection(table_id);
+
+    const int64_t thread_num = 8;
+    std::mutex insert_mutex;
+    std::atomic<int64_t> success_num(0);
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < thread_num; ++i) {
+        threads.emplace_back([&]() {
+            uint64_t lsn = 0;
+            {
+                // inserts are serialized by the request scheduler
+                std::lock_guard<std::mutex> lock(insert_mutex);
+                manager->Insert(table_id, "", ids, data_float);
+                lsn = manager->last_applied_lsn_;
+            }
+            if (manager->WaitSynced() == milvus::WAL_SUCCESS && manager->synced_lsn_ >= lsn) {
+                ++success_num;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(success_num, thread_num);
+    ASSERT_EQ(manager->synced_lsn_, manager->last_applied_lsn_);
+    ASSERT_LE(manager->sync_round_, thread_num);
+}
+
+TEST(WalTest, REPLAYER_TEST) {
+    std::mutex replay_mutex;
+    std::map<std::string, std::vector<uint64_t>> replayed_lsns;
+    std::map<std::string, int64_t> replayed_ids;
+    auto replay = [&](const milvus::engine::wal::MXLogRecord& record) {
+        std::lock_guard<std::mutex> lock(replay_mutex);
+        replayed_lsns[record.collection_id].push_back(record.lsn);
+        for (uint32_t i = 0; i < record.length; ++i) {
+            replayed_ids[record.collection_id] += record.ids[i];
+        }
+        return milvus::Status::OK();
+    };
+
+    const int64_t collection_num = 8;
+    const int64_t record_num = 100;
+    for (int64_t thread_num : {1, 4}) {
+        replayed_lsns.clear();
+        replayed_ids.clear();
+
+        milvus::engine::wal::MXLogReplayer replayer(thread_num, replay);
+        uint64_t lsn = 0;
+        std::vector<milvus::engine::IDNumber> ids(16);
+        std::vector<float> data(16 * 4);
+        for (int64_t i = 0; i < record_num; ++i) {
+            milvus::engine::wal::MXLogRecord record;
+            record.lsn = ++lsn;
+            record.type = milvus::engine::wal::MXLogType::InsertVector;
+            record.collection_id = "collection_" + std::to_string(i % collection_num);
+            record.length = ids.size();
+            std::fill(ids.begin(), ids.end(), 1);
+            record.ids = ids.data();
+            record.data_size = data.size() * sizeof(float);
+            record.data = data.data();
+            replayer.Dispatch(record);
+
+            // the buffer is reused by the next record
+            std::fill(ids.begin(), ids.end(), 0);
+        }
+        replayer.Barrier();
+        ASSERT_EQ(replayer.ReplayedCount(), record_num);
+
+        ASSERT_EQ(replayed_lsns.size(), collection_num);
+        for (auto& pair : replayed_lsns) {
+            ASSERT_EQ(pair.second.size(), record_num / collection_num + (pair.first < "collection_4" ? 1 : 0));
+            ASSERT_TRUE(std::is_sorted(pair.second.begin(), pair.second.end()));
+            ASSERT_EQ(replayed_ids[pair.first], pair.second.size() * ids.size());
+        }
+    }
+}
+
 TEST(WalTest, MANAGER_RECOVERY_TEST) {
     MakeEmptyTestPath();
 
@@ -212,6 +212,8 @@ class TestClient : public oatpp::web::client::ApiClient {
 
     API_CALL("GET", "/state", getState)
 
+    API_CALL("GET", "/profile/{type}", getProfile, PATH(String, type, "type"), QUERY(String, seconds))
+
     API_CALL("GET", "/devices", getDevices)
 
     API_CALL("GET", "/config/advanced", getAdvanced)
@@ -294,6 +296,14 @@ class TestClient : public oatpp::web::client::ApiClient {
     API_CALL("PUT", "/collections/{collection_name}/vectors", vectorsOp,
              PATH(String, collection_name, "collection_name"), BODY_STRING(String, body))
 
+    API_CALL("POST", "/collections/{collection_name}/vectors", insertBinary,
+             PATH(String, collection_name, "collection_name"), HEADER(String, content_type, "Content-Type"),
+             BODY_STRING(String, body))
+
+    API_CALL("PUT", "/collections/{collection_name}/vectors", vectorsOpBinary,
+             PATH(String, collection_name, "collection_name"), HEADER(String, content_type, "Content-Type"),
+             BODY_STRING(String, body))
+
     API_CALL("GET", "/system/{msg}", cmd, PATH(String, cmd_str, "msg"), QUERY(String, action), QUERY(String, target))
 
     API_CALL("PUT", "/system/{op}", op, PATH(String, cmd_str, "op"), BODY_STRING(String, body))
@@ -516,6 +526,28 @@ TEST_F(WebControllerTest, OPTIONS) {
     ASSERT_EQ(OStatus::CODE_204.code, response->getStatusCode());
 }
 
+TEST_F(WebControllerTest, PROFILE) {
+    auto response = client_ptr->getProfile("unknown", "1", conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_400.code, response->getStatusCode());
+
+    response = client_ptr->getProfile("cpu", "0", conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_400.code, response->getStatusCode());
+
+    response = client_ptr->getProfile("cpu", "1", conncetion_ptr);
+#ifdef ENABLE_CPU_PROFILING
+    ASSERT_EQ(OStatus::CODE_200.code, response->getStatusCode());
+#else
+    ASSERT_EQ(OStatus::CODE_400.code, response->getStatusCode());
+#endif
+
+    response = client_ptr->getProfile("heap", "", conncetion_ptr);
+#ifdef ENABLE_MEM_PROFILING
+    ASSERT_EQ(OStatus::CODE_200.code, response->getStatusCode());
+#else
+    ASSERT_EQ(OStatus::CODE_400.code, response->getStatusCode());
+#endif
+}
+
 TEST_F(WebControllerTest, CREATE_COLLECTION) {
     auto collection_dto = milvus::server::web::CollectionRequestDto::createShared();
     auto response = client_ptr->createCollection(collection_dto, conncetion_ptr);
@@ -801,6 +833,57 @@ TEST_F(WebControllerTest, INSERT_BIN) {
     ASSERT_EQ(OStatus::CODE_204.code, response->getStatusCode());
 }
 
+OString
+BinaryBody(const nlohmann::json& header, const std::vector<float>& vectors) {
+    std::string header_str = header.dump();
+    uint32_t header_size = header_str.size();
+    std::string body(reinterpret_cast<const char*>(&header_size), sizeof(header_size));
+    body += header_str;
+    body.append(reinterpret_cast<const char*>(vectors.data()), vectors.size() * sizeof(float));
+    return OString(body.data(), body.size(), true);
+}
+
+TEST_F(WebControllerTest, BINARY_BODY) {
+    auto collection_name = "test_binary_body_collection_test" + OString(RandomName().c_str());
+    const int64_t dim = 64;
+    GenCollection(client_ptr, conncetion_ptr, collection_name, dim, 100, "L2");
+
+    std::vector<float> vectors(20 * dim);
+    for (size_t i = 0; i < vectors.size(); i++) {
+        vectors[i] = static_cast<float>(i % 97) / 97;
+    }
+    auto response = client_ptr->insertBinary(collection_name, "application/octet-stream",
+                                             BinaryBody(nlohmann::json::object(), vectors), conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_201.code, response->getStatusCode()) << response->readBodyToString()->std_str();
+    ASSERT_EQ(20 * sizeof(int64_t), static_cast<size_t>(response->readBodyToString()->getSize()));
+
+    // a payload which is not a whole number of vectors
+    vectors.pop_back();
+    response = client_ptr->insertBinary(collection_name, "application/octet-stream",
+                                        BinaryBody(nlohmann::json::object(), vectors), conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_400.code, response->getStatusCode());
+
+    auto status = FlushCollection(client_ptr, conncetion_ptr, collection_name);
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    nlohmann::json search_json;
+    search_json["search"]["topk"] = 3;
+    search_json["search"]["params"]["nprobe"] = 1;
+    std::vector<float> queries(vectors.begin(), vectors.begin() + 2 * dim);
+    response = client_ptr->vectorsOpBinary(collection_name, "application/octet-stream",
+                                           BinaryBody(search_json, queries), conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_200.code, response->getStatusCode()) << response->readBodyToString()->std_str();
+    auto result = response->readBodyToString();
+    ASSERT_EQ(2 * sizeof(int64_t) + 2 * 3 * (sizeof(int64_t) + sizeof(float)), static_cast<size_t>(result->getSize()));
+    int64_t shape[2];
+    memcpy(shape, result->getData(), sizeof(shape));
+    ASSERT_EQ(2, shape[0]);
+    ASSERT_EQ(3, shape[1]);
+
+    response = client_ptr->dropCollection(collection_name, conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_204.code, response->getStatusCode());
+}
+
 TEST_F(WebControllerTest, INSERT_IDS) {
     auto collection_name = "test_insert_collection_test" + OString(RandomName().c_str());
     const int64_t dim = 64;
@@ -1556,3 +1639,44 @@ TEST_F(WebControllerTest, LOAD) {
     response = client_ptr->op("task", load_json.dump().c_str(), conncetion_ptr);
     ASSERT_EQ(OStatus::CODE_400.code, response->getStatusCode());
 }
+
+TEST_F(WebControllerTest, ASYNC_SERVER) {
+    auto& config = milvus::server::Config::GetInstance();
+    auto& web_server = milvus::server::web::WebServer::GetInstance();
+    web_server.Stop();
+    config.SetNetworkConfigHTTPPort("29999");
+    ASSERT_TRUE(config.SetNetworkConfigHTTPAsync("true").ok());
+    web_server.Start();
+    sleep(3);
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, client_provider);
+    auto executor = oatpp::web::client::HttpRequestExecutor::createShared(client_provider);
+    auto client = TestClient::createShared(executor, object_mapper);
+    auto connection = client->getConnection();
+
+    auto response = client->root(connection);
+    ASSERT_EQ(OStatus::CODE_200.code, response->getStatusCode());
+    response = client->optionsVectors("collection", connection);
+    ASSERT_EQ(OStatus::CODE_204.code, response->getStatusCode());
+
+    // requests with a body and with path variables on the same keep-alive connection
+    OString collection_name = "milvus_web_test_async_" + OString(RandomName().c_str());
+    const int64_t dim = 16;
+    GenCollection(client, connection, collection_name, dim, 100, "L2");
+    nlohmann::json insert_json;
+    insert_json["vectors"] = RandomRecordsJson(dim, 20);
+    response = client->insert(collection_name, insert_json.dump().c_str(), connection);
+    ASSERT_EQ(OStatus::CODE_201.code, response->getStatusCode());
+    auto result_dto = response->readBodyToDto<milvus::server::web::VectorIdsDto>(object_mapper.get());
+    ASSERT_EQ(20, result_dto->ids->count());
+
+    response = client->dropCollection(collection_name, connection);
+    ASSERT_EQ(OStatus::CODE_204.code, response->getStatusCode());
+    response = client->dropCollection(collection_name, connection);
+    ASSERT_EQ(OStatus::CODE_404.code, response->getStatusCode());
+
+    web_server.Stop();
+    ASSERT_TRUE(config.SetNetworkConfigHTTPAsync("false").ok());
+    web_server.Start();
+    sleep(3);
+}
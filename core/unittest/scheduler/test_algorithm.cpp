@@ -184,5 +184,20 @@ TEST_F(AlgorithmTest, SHORTESTPATH_TEST) {
     std::cout << std::endl;
 }
 
+TEST_F(AlgorithmTest, ROUTE_CACHE_TEST) {
+    std::vector<std::string> route, sp;
+    res_mgr_->GetRoute(disk_.lock(), gpu_0_.lock(), route);
+    ShortestPath(disk_.lock(), gpu_0_.lock(), res_mgr_, sp);
+    ASSERT_EQ(route, sp);
+    res_mgr_->GetRoute(disk_.lock(), gpu_0_.lock(), route);
+    ASSERT_EQ(route, sp);
+
+    // a new connection drops the cached routes
+    auto direct = Connection("DIRECT", 1.0);
+    res_mgr_->Connect("disk", "gpu0", direct);
+    res_mgr_->GetRoute(disk_.lock(), gpu_0_.lock(), route);
+    ASSERT_EQ(route, std::vector<std::string>({"gpu0", "disk"}));
+}
+
 }  // namespace scheduler
 }  // namespace milvus
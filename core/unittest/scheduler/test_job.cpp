@@ -10,11 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
 
 #include "scheduler/job/Job.h"
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "server/context/ConnectionContext.h"
+#include "utils/Error.h"
 
 namespace milvus {
 namespace scheduler {
@@ -23,6 +27,14 @@ class TestJob : public Job {
     TestJob() : Job(JobType::INVALID) {}
 };
 
+class BrokenConnection : public server::ConnectionContext {
+ public:
+    bool
+    IsConnectionBroken() const override {
+        return true;
+    }
+};
+
 TEST(JobTest, TestJob) {
     engine::DBOptions options;
     auto build_index_ptr = std::make_shared<BuildIndexJob>(nullptr, options);
@@ -41,5 +53,49 @@ TEST(JobTest, TestJob) {
     search_ptr->AddIndexFile(nullptr);
 }
 
+TEST(JobTest, TestJobSchedule) {
+    engine::DBOptions options;
+    auto build_index_ptr = std::make_shared<BuildIndexJob>(nullptr, options);
+    ASSERT_EQ(build_index_ptr->priority(), JobPriority::LOW);
+    ASSERT_EQ(build_index_ptr->deadline(), JobDeadline::max());
+
+    auto delete_ptr = std::make_shared<DeleteJob>("collection_id", nullptr, 1);
+    ASSERT_EQ(delete_ptr->priority(), JobPriority::NORMAL);
+
+    // the search job takes the deadline of the request
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    auto context = std::make_shared<server::Context>("dummy_request_id");
+    context->SetDeadline(deadline);
+    engine::VectorsData vectors;
+    auto search_ptr = std::make_shared<SearchJob>(context, 1, 1, vectors);
+    ASSERT_EQ(search_ptr->priority(), JobPriority::HIGH);
+    ASSERT_EQ(search_ptr->deadline(), deadline);
+}
+
+TEST(JobTest, TestJobCancel) {
+    // the search job gives up once the client is gone, its running task sees the flag and finishes
+    auto context = std::make_shared<server::Context>("dummy_request_id");
+    server::ConnectionContextPtr connection = std::make_shared<BrokenConnection>();
+    context->SetConnectionContext(connection);
+    engine::VectorsData vectors;
+    auto search_ptr = std::make_shared<SearchJob>(context, 1, 1, vectors);
+    auto file = std::make_shared<engine::meta::SegmentSchema>();
+    file->id_ = 1;
+    ASSERT_TRUE(search_ptr->AddIndexFile(file));
+    ASSERT_FALSE(search_ptr->IsCancelled());
+
+    std::thread task([&]() {
+        while (!search_ptr->cancel_flag()->load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        search_ptr->SearchDone(file->id_);
+    });
+    search_ptr->WaitResult();
+    task.join();
+
+    ASSERT_TRUE(search_ptr->IsCancelled());
+    ASSERT_EQ(search_ptr->GetStatus().code(), SERVER_REQUEST_CANCELLED);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -10,7 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
 
+#include "scheduler/NumaTopology.h"
 #include "scheduler/ResourceMgr.h"
 #include "scheduler/resource/CpuResource.h"
 #include "scheduler/resource/DiskResource.h"
@@ -139,6 +144,37 @@ TEST_F(ResourceMgrBaseTest, GET_RESOURCE_BY_NAME) {
     ASSERT_EQ(invalid, nullptr);
 }
 
+TEST_F(ResourceMgrBaseTest, GET_SEARCH_CPU_RESOURCE) {
+    ASSERT_EQ(mgr1_->GetSearchCpuResource(0), cpu_res);
+    ASSERT_EQ(mgr1_->GetSearchCpuResource(7), cpu_res);
+    ASSERT_EQ(empty_mgr_->GetSearchCpuResource(7), nullptr);
+}
+
+TEST(NumaTopologyTest, TOPOLOGY) {
+    ASSERT_EQ(NumaTopology::ParseCpuList("0-3,8,10-11"), std::vector<int64_t>({0, 1, 2, 3, 8, 10, 11}));
+    ASSERT_TRUE(NumaTopology::ParseCpuList("").empty());
+    ASSERT_TRUE(NumaTopology::ParseCpuList("3-1").empty());
+    ASSERT_TRUE(NumaTopology::ParseCpuList("a-b").empty());
+
+    std::string root = "/tmp/milvus_test_numa";
+    boost::filesystem::create_directories(root + "/node0");
+    boost::filesystem::create_directories(root + "/node1");
+    std::ofstream(root + "/node0/cpulist") << "0-1\n";
+    std::ofstream(root + "/node1/cpulist") << "2-3\n";
+
+    NumaTopology numa(root);
+    ASSERT_EQ(numa.NodeNum(), 2);
+    ASSERT_EQ(numa.NodeOfFile(4), 0);
+    ASSERT_EQ(numa.NodeOfFile(5), 1);
+    ASSERT_FALSE(numa.BindThread(2).ok());
+
+    // no numa information, a single node
+    NumaTopology none(root + "/none");
+    ASSERT_EQ(none.NodeNum(), 1);
+    ASSERT_EQ(none.NodeOfFile(5), 0);
+    boost::filesystem::remove_all(root);
+}
+
 TEST_F(ResourceMgrBaseTest, GET_NUM_OF_RESOURCE) {
     ASSERT_EQ(empty_mgr_->GetNumOfResource(), 0);
     ASSERT_EQ(mgr1_->GetNumOfResource(), 3);
@@ -16,6 +16,7 @@
 #include "src/scheduler/SchedInst.h"
 #include "cache/DataObj.h"
 #include "cache/GpuCacheMgr.h"
+#include "scheduler/MPSCQueue.h"
 #include "scheduler/ResourceFactory.h"
 #include "scheduler/Scheduler.h"
 #include "scheduler/resource/Resource.h"
@@ -254,6 +255,37 @@ TEST_F(SchedulerTest, schedule) {
     scheduler_->Dump();
 }
 
+TEST(MPSCQueueTest, push_pop_all) {
+    MPSCQueue<int64_t> queue;
+    const int64_t producers = 4, count = 10000;
+    std::vector<std::thread> threads;
+    for (int64_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int64_t i = 0; i < count; ++i) {
+                queue.Push(p * count + i);
+            }
+        });
+    }
+
+    // the values of a producer come out in the order it pushed them
+    std::vector<int64_t> last(producers, -1);
+    std::vector<int64_t> values;
+    int64_t popped = 0;
+    while (popped < producers * count) {
+        values.clear();
+        queue.PopAll(values);
+        for (auto value : values) {
+            ASSERT_GT(value % count, last[value / count]);
+            last[value / count] = value % count;
+        }
+        popped += values.size();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(queue.Size(), 0);
+}
+
 TEST(SchedulerService, service) {
     fiu_enable("load_simple_config_mock", 1, nullptr, 0);
     StartSchedulerService();
@@ -17,6 +17,7 @@
 #include "scheduler/SchedInst.h"
 #include "scheduler/resource/CpuResource.h"
 #include "scheduler/selector/BuildIndexPass.h"
+#include "scheduler/selector/CostModel.h"
 #include "scheduler/selector/FaissFlatPass.h"
 #include "scheduler/selector/FaissIVFFlatPass.h"
 #include "scheduler/selector/FaissIVFPQPass.h"
@@ -93,5 +94,58 @@ TEST(OptimizerTest, TEST_OPTIMIZER) {
 
 #endif
 
+TEST(OptimizerTest, TEST_COST_MODEL) {
+    auto& model = CostModel::GetInstance();
+    model.Clear();
+
+    engine::VectorsData vectors;
+    vectors.vector_count_ = 10;
+    milvus::json extra_params = {{"nprobe", 16}};
+    auto job = std::make_shared<SearchJob>(nullptr, 10, extra_params, vectors);
+
+    std::vector<TaskPtr> tasks;
+    for (size_t i = 1; i <= 8; ++i) {
+        auto file = std::make_shared<SegmentSchema>();
+        file->file_type_ = SegmentSchema::INDEX;
+        file->engine_type_ = (int)engine::EngineType::FAISS_IVFFLAT;
+        file->index_params_ = "{ \"nlist\": 1024 }";
+        file->dimension_ = 128;
+        file->row_count_ = 100000 * i;
+        file->file_size_ = file->row_count_ * 128 * sizeof(float);
+        auto search_task = std::make_shared<XSearchTask>(nullptr, file, nullptr);
+        search_task->job_ = job;
+        tasks.push_back(search_task);
+    }
+
+    // 10 queries compared with 1024 centroids, then with the rows of 16 in 1024 lists
+    TaskCostFeature feature;
+    ASSERT_TRUE(CostModel::Feature(tasks[0], feature));
+    ASSERT_EQ(feature.engine_type_, (int)engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_NEAR(feature.work_, 10 * 128 * (100000 * 16.0 / 1024 + 1024) / 1e6, 1e-9);
+    ASSERT_FALSE(CostModel::Feature(std::make_shared<XBuildIndexTask>(nullptr, nullptr), feature));
+
+    // nothing observed, nothing estimated
+    double cost = 0.0;
+    ASSERT_FALSE(model.EstimateExecute("cpu", feature, cost));
+
+    // the timings follow 100us + 1000us per unit of work exactly
+    for (size_t i = 0; i + 1 < tasks.size(); ++i) {
+        ASSERT_TRUE(CostModel::Feature(tasks[i], feature));
+        model.ObserveExecute("cpu", tasks[i], 100.0 + 1000.0 * feature.work_);
+    }
+    ASSERT_TRUE(CostModel::Feature(tasks.back(), feature));
+    ASSERT_TRUE(model.EstimateExecute("cpu", feature, cost));
+    ASSERT_NEAR(cost, 100.0 + 1000.0 * feature.work_, 1e-3 * cost);
+    ASSERT_FALSE(model.EstimateExecute("gpu0", feature, cost));
+
+    // placed cost is pending until the task is executed
+    model.Place("cpu", tasks.back(), 500.0);
+    ASSERT_DOUBLE_EQ(model.Pending("cpu"), 500.0);
+    model.ObserveExecute("cpu", tasks.back(), 100.0 + 1000.0 * feature.work_);
+    ASSERT_DOUBLE_EQ(model.Pending("cpu"), 0.0);
+
+    model.Clear();
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -18,6 +18,7 @@
 
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/DBFactory.h"
+#include "scheduler/ParallelismGovernor.h"
 #include "scheduler/tasklabel/BroadcastLabel.h"
 #include "scheduler/task/BuildIndexTask.h"
 #include "scheduler/task/SearchTask.h"
@@ -189,5 +190,45 @@ TEST(TaskTest, TEST_PATH) {
     ASSERT_TRUE(empty_path.empty());
 }
 
+TEST(TaskTest, PARALLELISM_GOVERNOR) {
+    ParallelismGovernor governor(16);
+
+    // alone a task takes the budget, capped by its nq
+    ASSERT_EQ(governor.Acquire(0), 16);
+    governor.Release();
+    ASSERT_EQ(governor.Acquire(4), 4);
+    governor.Release();
+
+    // the tasks running at once share it
+    ASSERT_EQ(governor.Acquire(100), 16);
+    ASSERT_EQ(governor.Acquire(100), 8);
+    ASSERT_EQ(governor.Acquire(100), 5);
+    ASSERT_EQ(governor.ActiveTasks(), 3);
+    governor.Release();
+    governor.Release();
+    governor.Release();
+
+    governor.SetTaskMaxThreads(6);
+    ASSERT_EQ(governor.Acquire(100), 6);
+    governor.Release();
+
+    // every task gets a thread however many run
+    for (int i = 0; i < 20; ++i) {
+        governor.Acquire(100);
+    }
+    ASSERT_EQ(governor.Acquire(100), 1);
+    for (int i = 0; i < 21; ++i) {
+        governor.Release();
+    }
+    ASSERT_EQ(governor.ActiveTasks(), 0);
+
+    {
+        ParallelismGuard guard(2, governor);
+        ASSERT_EQ(guard.threads(), 2);
+        ASSERT_EQ(governor.ActiveTasks(), 1);
+    }
+    ASSERT_EQ(governor.ActiveTasks(), 0);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
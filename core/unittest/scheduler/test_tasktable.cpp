@@ -11,6 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <limits>
+#include <vector>
+
 #include "scheduler/TaskTable.h"
 #include "scheduler/task/TestTask.h"
 
@@ -234,6 +238,32 @@ TEST_F(TaskTableBaseTest, PICK_TO_LOAD_LIMIT) {
     ASSERT_EQ(indexes[2] % empty_table_.capacity(), 4);
 }
 
+TEST_F(TaskTableBaseTest, PICK_TO_LOAD_DEPTH) {
+    const size_t NUM_TASKS = 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+    }
+    empty_table_[0]->state = milvus::scheduler::TaskTableItemState::EXECUTED;
+    empty_table_[1]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADED;
+
+    // two tasks loaded ahead already, nothing more to load
+    auto indexes = empty_table_.PickToLoad(3, 2);
+    ASSERT_TRUE(indexes.empty());
+
+    // the executor takes one, the loader fills the slot
+    empty_table_[1]->state = milvus::scheduler::TaskTableItemState::EXECUTING;
+    indexes = empty_table_.PickToLoad(3, 2);
+    ASSERT_EQ(indexes.size(), 3);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+
+    // a deeper pipeline keeps loading
+    empty_table_[1]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    indexes = empty_table_.PickToLoad(1, 4);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+}
+
 TEST_F(TaskTableBaseTest, PICK_TO_LOAD_CACHE) {
     const size_t NUM_TASKS = 10;
     for (size_t i = 0; i < NUM_TASKS; ++i) {
@@ -269,6 +299,41 @@ TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE) {
     ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
 }
 
+TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE_PRIORITY) {
+    using milvus::scheduler::JobPriority;
+    auto now = std::chrono::steady_clock::now();
+    milvus::scheduler::SegmentSchemaPtr dummy = nullptr;
+    std::vector<milvus::scheduler::TaskPtr> tasks;
+    for (size_t i = 0; i < 4; ++i) {
+        tasks.emplace_back(std::make_shared<milvus::scheduler::TestTask>(
+            std::make_shared<milvus::server::Context>("dummy_request_id"), dummy, nullptr));
+    }
+    tasks[0]->SetSchedule(JobPriority::LOW, milvus::scheduler::JobDeadline::max());
+    tasks[1]->SetSchedule(JobPriority::HIGH, now + std::chrono::seconds(20));
+    tasks[2]->SetSchedule(JobPriority::NORMAL, milvus::scheduler::JobDeadline::max());
+    tasks[3]->SetSchedule(JobPriority::HIGH, now + std::chrono::seconds(10));
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        empty_table_.Put(tasks[i]);
+        empty_table_[i]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    }
+
+    // priority class first, then earliest deadline
+    auto indexes = empty_table_.PickToExecute(std::numeric_limits<uint64_t>::max());
+    ASSERT_EQ(indexes.size(), 4);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+    ASSERT_EQ(indexes[1] % empty_table_.capacity(), 1);
+    ASSERT_EQ(indexes[2] % empty_table_.capacity(), 2);
+    ASSERT_EQ(indexes[3] % empty_table_.capacity(), 0);
+
+    indexes = empty_table_.PickToExecute(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+
+    ASSERT_FALSE(tasks[1]->Expired());
+    tasks[1]->SetSchedule(JobPriority::HIGH, now - std::chrono::seconds(1));
+    ASSERT_TRUE(tasks[1]->Expired());
+}
+
 TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE_LIMIT) {
     const size_t NUM_TASKS = 10;
     for (size_t i = 0; i < NUM_TASKS; ++i) {
@@ -13,6 +13,10 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
 #include "knowhere/index/vector_index/VecIndex.h"
@@ -236,6 +240,414 @@ TEST(CacheTest, INVALID_TEST) {
     }
 }
 
+TEST(CacheTest, SHARDED_CACHE_TEST) {
+    constexpr int64_t SHARD_NUM = 8;
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 20, 1UL << 32, "[CACHE TEST]", SHARD_NUM);
+    ASSERT_EQ(cache.shard_num(), SHARD_NUM);
+
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (int64_t i = 0; i < 100; ++i) {
+                milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+                auto data_obj = std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+                std::string key = "index_" + std::to_string(t) + "_" + std::to_string(i);
+                cache.insert(key, data_obj);
+                cache.get(key);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // the capacity budget is shared by all shards
+    ASSERT_LE(cache.usage(), cache.capacity());
+    ASSERT_EQ(cache.usage(), (int64_t)cache.size() * ITEM_SIZE);
+
+    milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+    cache.insert("index_last", std::static_pointer_cast<milvus::cache::DataObj>(mock_index));
+    ASSERT_TRUE(cache.exists("index_last"));
+    cache.erase("index_last");
+    ASSERT_FALSE(cache.exists("index_last"));
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.usage(), 0);
+}
+
+TEST(CacheTest, TINY_LFU_CACHE_TEST) {
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    auto make_item = []() {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 10, 1UL << 32, "[CACHE TEST]", 1,
+                                                          milvus::cache::CachePolicyType::TINY_LFU);
+    ASSERT_EQ(cache.policy(), milvus::cache::CachePolicyType::TINY_LFU);
+
+    // working set which is searched repeatedly
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            std::string key = "hot_" + std::to_string(i);
+            if (cache.get(key) == nullptr) {
+                cache.insert(key, make_item());
+            }
+        }
+    }
+
+    // one-off scan must not flush the working set
+    for (int i = 0; i < 50; ++i) {
+        std::string key = "scan_" + std::to_string(i);
+        if (cache.get(key) == nullptr) {
+            cache.insert(key, make_item());
+        }
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(cache.exists("hot_" + std::to_string(i)));
+    }
+    ASSERT_LE(cache.usage(), cache.capacity());
+}
+
+TEST(CacheTest, PARTIAL_TINY_LFU_TEST) {
+    constexpr int MAX_SIZE = 5;
+    milvus::cache::TinyLFU<int, int> lfu(MAX_SIZE);
+
+    lfu.put(0, 2);
+    lfu.put(0, 3);
+    ASSERT_EQ(lfu.size(), 1);
+    ASSERT_EQ(lfu.get(0), 3);
+
+    for (int i = 1; i < MAX_SIZE; ++i) {
+        lfu.put(i, 0);
+    }
+    ASSERT_EQ(lfu.size(), MAX_SIZE);
+
+    // key 0 has been promoted, so it outlives the new item
+    lfu.put(99, 0);
+    ASSERT_EQ(lfu.size(), MAX_SIZE);
+    ASSERT_TRUE(lfu.exists(0));
+
+    for (int i = 0; i < 3; ++i) {
+        lfu.access(100);
+    }
+    ASSERT_EQ(lfu.frequency(100), 3);
+    ASSERT_TRUE(lfu.admit(100, lfu.frequency(101)));
+    ASSERT_FALSE(lfu.admit(101, lfu.frequency(100)));
+
+    // peek doesn't promote, the probation tail is still the first victim
+    int victim = -1;
+    lfu.visit_victims([&](const std::pair<int, int>& pair) {
+        victim = pair.first;
+        return false;
+    });
+    ASSERT_EQ(lfu.peek(victim), 0);
+    lfu.put(98, 0);
+    ASSERT_FALSE(lfu.exists(victim));
+
+    ASSERT_ANY_THROW(lfu.get(-1));
+    ASSERT_ANY_THROW(lfu.peek(-1));
+}
+
+TEST(CacheTest, SHARDED_TINY_LFU_ADMIT_TEST) {
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    constexpr int64_t SHARD_NUM = 2;
+    auto make_item = []() {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+    auto shard_of = [&](const std::string& key) { return std::hash<std::string>()(key) % SHARD_NUM; };
+    auto key_in_shard = [&](const std::string& prefix, size_t shard) {
+        for (int i = 0;; ++i) {
+            std::string key = prefix + std::to_string(i);
+            if (shard_of(key) == shard) {
+                return key;
+            }
+        }
+    };
+
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 2, 1UL << 32, "[CACHE TEST]", SHARD_NUM,
+                                                          milvus::cache::CachePolicyType::TINY_LFU);
+
+    // eviction starts from shard 0, which only holds a hot item, the cold one lives in shard 1
+    std::string hot = key_in_shard("hot_", 0);
+    std::string cold = key_in_shard("cold_", 1);
+    std::string warm = key_in_shard("warm_", 1);
+    cache.insert(hot, make_item());
+    cache.insert(cold, make_item());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NE(cache.get(hot), nullptr);
+    }
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(cache.get(warm), nullptr);
+    }
+
+    // warm is more popular than the cold item of its own shard, but inserting it would evict the hot one
+    cache.insert(warm, make_item());
+    ASSERT_FALSE(cache.exists(warm));
+    ASSERT_TRUE(cache.exists(hot));
+    ASSERT_TRUE(cache.exists(cold));
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(cache.get(warm), nullptr);
+    }
+    cache.insert(warm, make_item());
+    ASSERT_TRUE(cache.exists(warm));
+    ASSERT_FALSE(cache.exists(hot));
+    ASSERT_LE(cache.usage(), cache.capacity());
+}
+
+TEST(CacheTest, GREEDY_DUAL_CACHE_TEST) {
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    auto make_item = [](int64_t reload_cost) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        mock_index->SetReloadCost(reload_cost);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 10, 1UL << 32, "[CACHE TEST]", 1,
+                                                          milvus::cache::CachePolicyType::GREEDY_DUAL);
+    ASSERT_EQ(cache.policy(), milvus::cache::CachePolicyType::GREEDY_DUAL);
+
+    // segments fetched from slow storage are inserted first, cheap ones afterwards
+    cache.insert("slow_0", make_item(5000));
+    cache.insert("slow_1", make_item(5000));
+    for (int i = 0; i < 30; ++i) {
+        cache.insert("fast_" + std::to_string(i), make_item(10));
+    }
+
+    ASSERT_TRUE(cache.exists("slow_0"));
+    ASSERT_TRUE(cache.exists("slow_1"));
+    ASSERT_LE(cache.usage(), cache.capacity());
+}
+
+TEST(CacheTest, PARTIAL_GREEDY_DUAL_TEST) {
+    class CostItem : public milvus::cache::DataObj {
+     public:
+        CostItem(int64_t size, int64_t cost) : size_(size) {
+            SetReloadCost(cost);
+        }
+
+        int64_t
+        Size() override {
+            return size_;
+        }
+
+     private:
+        int64_t size_;
+    };
+    using CostItemPtr = std::shared_ptr<CostItem>;
+
+    constexpr int MAX_SIZE = 3;
+    milvus::cache::GreedyDual<int, CostItemPtr> gd(MAX_SIZE);
+
+    gd.put(0, std::make_shared<CostItem>(100, 10));
+    gd.put(1, std::make_shared<CostItem>(100, 1000));
+    gd.put(2, std::make_shared<CostItem>(1000, 1000));
+    ASSERT_EQ(gd.size(), MAX_SIZE);
+
+    // cheapest per byte goes first
+    int victim = -1;
+    gd.visit_victims([&](const std::pair<int, CostItemPtr>& pair) {
+        victim = pair.first;
+        return false;
+    });
+    ASSERT_EQ(victim, 0);
+
+    gd.put(3, std::make_shared<CostItem>(100, 1000));
+    ASSERT_FALSE(gd.exists(0));
+    ASSERT_GT(gd.inflation(), 0.0);
+
+    // a new item is inserted on top of the inflation, so expensive items which are never hit age out
+    for (int i = 4; i < 20; ++i) {
+        gd.put(i, std::make_shared<CostItem>(100, 1000));
+    }
+    ASSERT_FALSE(gd.exists(2));
+    ASSERT_EQ(gd.size(), MAX_SIZE);
+
+    ASSERT_ANY_THROW(gd.get(-1));
+    gd.clear();
+    ASSERT_EQ(gd.size(), 0);
+}
+
+TEST(CacheTest, COLLECTION_QUOTA_CACHE_TEST) {
+    ASSERT_EQ(milvus::cache::CpuCacheMgr::CollectionOf("/tmp/milvus/tables/coll_a/1234/5678"), "coll_a");
+    ASSERT_EQ(milvus::cache::CpuCacheMgr::CollectionOf("/tmp/milvus/tables/coll_a/1234/5678.attr"), "coll_a");
+    ASSERT_EQ(milvus::cache::CpuCacheMgr::CollectionOf("no_collection"), "");
+
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    auto make_item = []() {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+    auto location = [](const std::string& collection, int i) {
+        return "/tmp/milvus/tables/" + collection + "/" + std::to_string(i) + "/" + std::to_string(i);
+    };
+
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 10, 1UL << 32, "[CACHE TEST]", 4);
+    cache.set_group_func(&milvus::cache::CpuCacheMgr::CollectionOf);
+    cache.set_group_quota("noisy", ITEM_SIZE * 3, false);
+    cache.set_group_quota("critical", 0, true, {"critical_partition"});
+
+    for (int i = 0; i < 2; ++i) {
+        cache.insert(location("critical", i), make_item());
+        cache.insert(location("critical_partition", i), make_item());
+    }
+
+    // the noisy collection is kept inside its quota
+    for (int i = 0; i < 20; ++i) {
+        cache.insert(location("noisy", i), make_item());
+    }
+    milvus::cache::CacheGroupStat stat;
+    ASSERT_TRUE(cache.group_stat("noisy", stat));
+    ASSERT_LE(stat.usage_, ITEM_SIZE * 3);
+
+    // other collections can't push the pinned one out, its partitions are accounted to it
+    for (int i = 0; i < 20; ++i) {
+        cache.insert(location("other", i), make_item());
+    }
+    ASSERT_TRUE(cache.group_stat("critical", stat));
+    ASSERT_EQ(stat.item_count_, 4);
+    ASSERT_TRUE(stat.pinned_);
+    ASSERT_FALSE(cache.group_stat("critical_partition", stat));
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(cache.exists(location("critical", i)));
+        ASSERT_TRUE(cache.exists(location("critical_partition", i)));
+    }
+
+    ASSERT_NE(cache.get(location("critical", 0)), nullptr);
+    ASSERT_EQ(cache.get(location("critical", 99)), nullptr);
+    ASSERT_TRUE(cache.group_stat("critical", stat));
+    ASSERT_EQ(stat.hit_count_, 1);
+    ASSERT_EQ(stat.miss_count_, 1);
+
+    int64_t total_usage = 0;
+    for (auto& group : cache.group_stats()) {
+        total_usage += group.usage_;
+    }
+    ASSERT_EQ(total_usage, cache.usage());
+
+    cache.remove_group_quota("critical");
+    ASSERT_TRUE(cache.group_stat("critical", stat));
+    ASSERT_FALSE(stat.pinned_);
+
+    cache.clear();
+    for (auto& group : cache.group_stats()) {
+        ASSERT_EQ(group.usage_, 0);
+        ASSERT_EQ(group.item_count_, 0);
+    }
+}
+
+TEST(CacheTest, EVICT_GUARD_CACHE_TEST) {
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 5, 1UL << 32, "[CACHE TEST]", 1);
+    cache.set_evict_guard([](const std::string& key) { return key == "guarded"; });
+
+    milvus::knowhere::VecIndexPtr guarded = std::make_shared<MockVecIndex>(256, 1000);
+    cache.insert("guarded", std::static_pointer_cast<milvus::cache::DataObj>(guarded));
+    for (int i = 0; i < 20; ++i) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        cache.insert(std::to_string(i), std::static_pointer_cast<milvus::cache::DataObj>(mock_index));
+    }
+
+    // the least recently used item survives while the guard holds it
+    ASSERT_TRUE(cache.exists("guarded"));
+    ASSERT_LE(cache.usage(), ITEM_SIZE * 5);
+
+    cache.set_evict_guard(nullptr);
+    for (int i = 20; i < 25; ++i) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        cache.insert(std::to_string(i), std::static_pointer_cast<milvus::cache::DataObj>(mock_index));
+    }
+    ASSERT_FALSE(cache.exists("guarded"));
+}
+
+TEST(CacheTest, REPLACE_CACHE_TEST) {
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 4, 1UL << 32, "[CACHE TEST]", 4);
+    for (int i = 0; i < 3; ++i) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        cache.insert("raw_" + std::to_string(i), std::static_pointer_cast<milvus::cache::DataObj>(mock_index));
+    }
+
+    // the index takes the place of the raw vectors
+    milvus::knowhere::VecIndexPtr index = std::make_shared<MockVecIndex>(256, 2000);
+    ASSERT_TRUE(cache.replace("raw_0", "index_0", std::static_pointer_cast<milvus::cache::DataObj>(index)));
+    ASSERT_FALSE(cache.exists("raw_0"));
+    ASSERT_TRUE(cache.exists("index_0"));
+    ASSERT_EQ(cache.usage(), ITEM_SIZE * 4);
+
+    // no other item is evicted for an index which doesn't fit
+    ASSERT_FALSE(cache.replace("raw_1", "index_1", std::static_pointer_cast<milvus::cache::DataObj>(index)));
+    ASSERT_FALSE(cache.exists("raw_1"));
+    ASSERT_FALSE(cache.exists("index_1"));
+    ASSERT_TRUE(cache.exists("raw_2"));
+    ASSERT_EQ(cache.usage(), ITEM_SIZE * 3);
+}
+
+TEST(CacheTest, RECLAIM_CACHE_TEST) {
+    auto& reclaimer = milvus::cache::CacheReclaimer::GetInstance();
+    reclaimer.Start(4);
+    ASSERT_TRUE(reclaimer.Running());
+
+    constexpr int64_t ITEM_SIZE = 1000 * 256 * sizeof(float);
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 4, 1UL << 32, "[CACHE TEST]");
+    std::weak_ptr<milvus::cache::DataObj> first_item;
+    for (int i = 0; i < 20; ++i) {
+        milvus::knowhere::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000);
+        auto data_obj = std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+        if (i == 0) {
+            first_item = data_obj;
+        }
+        cache.insert("index_" + std::to_string(i), data_obj);
+    }
+    ASSERT_LE(cache.usage(), cache.capacity());
+    cache.clear();
+
+    // evicted items are released by the reclaim thread
+    reclaimer.Stop();
+    ASSERT_FALSE(reclaimer.Running());
+    ASSERT_EQ(reclaimer.PendingCount(), 0);
+    ASSERT_TRUE(first_item.expired());
+}
+
+TEST(CacheTest, RECLAIM_STOP_TEST) {
+    auto& reclaimer = milvus::cache::CacheReclaimer::GetInstance();
+    reclaimer.Start(2);
+    ASSERT_TRUE(reclaimer.Running());
+
+    // the objects reclaimed while the reclaimer stops are released by the reclaim thread or inline, none is left
+    constexpr int THREAD_COUNT = 4;
+    constexpr int OBJECT_COUNT = 1000;
+    std::vector<std::vector<std::weak_ptr<void>>> reclaimed(THREAD_COUNT);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&reclaimer, &reclaimed, t]() {
+            for (int i = 0; i < OBJECT_COUNT; ++i) {
+                auto obj = std::make_shared<std::vector<char>>(1024);
+                reclaimed[t].push_back(obj);
+                reclaimer.Reclaim(std::move(obj));
+            }
+        });
+    }
+    reclaimer.Stop();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_FALSE(reclaimer.Running());
+    ASSERT_EQ(reclaimer.PendingCount(), 0);
+    for (auto& objs : reclaimed) {
+        ASSERT_EQ(objs.size(), OBJECT_COUNT);
+        for (auto& obj : objs) {
+            ASSERT_TRUE(obj.expired());
+        }
+    }
+}
+
 TEST(CacheTest, PARTIAL_LRU_TEST) {
     constexpr int MAX_SIZE = 5;
     milvus::cache::LRU<int, int> lru(MAX_SIZE);
@@ -12,15 +12,21 @@
 #include "config/Utils.h"
 #include "db/engine/ExecutionEngine.h"
 #include "server/ValidationUtil.h"
+#include "utils/Arena.h"
+#include "utils/AsyncLog.h"
 #include "utils/BlockingQueue.h"
 #include "utils/CommonUtil.h"
+#include "utils/ContentionStats.h"
 #include "utils/Error.h"
 #include "utils/Exception.h"
+#include "utils/Log.h"
 #include "utils/LogUtil.h"
+#include "utils/MemoryAccounting.h"
 #include "utils/SignalHandler.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
 #include "utils/ThreadPool.h"
+#include "utils/WorkStealingThreadPool.h"
 
 #include <gtest/gtest.h>
 #include <sys/stat.h>
@@ -242,6 +248,118 @@ TEST(UtilTest, BLOCKINGQUEUE_TEST) {
     ASSERT_EQ(bq.Size(), 0);
 }
 
+TEST(UtilTest, CONTENTION_STATS_TEST) {
+    auto depth_of = [](const std::string& name) -> int64_t {
+        for (auto& queue : milvus::ContentionStats::GetInstance().QueueDepths()) {
+            if (queue.name_ == name) {
+                return queue.depth_;
+            }
+        }
+        return -1;
+    };
+
+    {
+        milvus::BlockingQueue<int> bq;
+        bq.SetName("util_test_queue");
+        bq.Put(1);
+        bq.Put(2);
+        ASSERT_EQ(depth_of("util_test_queue"), 2);
+        bq.Take();
+        ASSERT_EQ(depth_of("util_test_queue"), 1);
+    }
+    ASSERT_EQ(depth_of("util_test_queue"), -1);
+
+    milvus::InstrumentedMutex mutex("util_test_lock");
+    int64_t counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j) {
+                std::lock_guard<milvus::InstrumentedMutex> lock(mutex);
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(counter, 4000);
+
+#ifdef MILVUS_WITH_LOCK_STATS
+    bool found = false;
+    for (auto& lock : milvus::ContentionStats::GetInstance().Locks()) {
+        if (lock.name_ == "util_test_lock") {
+            ASSERT_EQ(lock.acquisitions_, 4000);
+            ASSERT_LE(lock.contended_, lock.acquisitions_);
+            found = true;
+        }
+    }
+    ASSERT_TRUE(found);
+#endif
+}
+
+TEST(UtilTest, MEMORY_ACCOUNTING_TEST) {
+    auto& accounting = milvus::MemoryAccounting::GetInstance();
+    int64_t search_base = accounting.Usage(milvus::MemorySubsystem::SEARCH_RESULT);
+    int64_t wal_base = accounting.Usage(milvus::MemorySubsystem::WAL_BUFFER);
+    int64_t total_base = accounting.Total();
+
+    {
+        milvus::TrackedMemory memory(milvus::MemorySubsystem::SEARCH_RESULT);
+        memory.Set(1024);
+        memory.Set(4096);
+        ASSERT_EQ(memory.bytes(), 4096);
+        ASSERT_EQ(accounting.Usage(milvus::MemorySubsystem::SEARCH_RESULT), search_base + 4096);
+
+        int64_t wal_usage = 100;
+        milvus::MemoryProbe probe;
+        probe.Set(milvus::MemorySubsystem::WAL_BUFFER, [&]() { return wal_usage; });
+        ASSERT_EQ(accounting.Usage(milvus::MemorySubsystem::WAL_BUFFER), wal_base + 100);
+        wal_usage = 200;
+        ASSERT_EQ(accounting.Usage(milvus::MemorySubsystem::WAL_BUFFER), wal_base + 200);
+        ASSERT_EQ(accounting.Total(), total_base + 4096 + 200);
+
+        probe.Reset();
+        ASSERT_EQ(accounting.Usage(milvus::MemorySubsystem::WAL_BUFFER), wal_base);
+    }
+    ASSERT_EQ(accounting.Usage(milvus::MemorySubsystem::SEARCH_RESULT), search_base);
+    ASSERT_EQ(accounting.Total(), total_base);
+    ASSERT_STREQ(milvus::MemorySubsystemName(milvus::MemorySubsystem::CPU_CACHE), "cpu_cache");
+}
+
+TEST(UtilTest, ARENA_TEST) {
+    milvus::Arena arena;
+    ASSERT_EQ(arena.Reserved(), 0);
+
+    milvus::ArenaVector<int64_t> ids{milvus::ArenaAllocator<int64_t>(&arena)};
+    ids.resize(1000, 7);
+    auto small = arena.Allocate(3, 1);
+    auto aligned = arena.Allocate(sizeof(double), alignof(double));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % alignof(double), 0);
+    ASSERT_NE(small, aligned);
+    ASSERT_EQ(arena.Reserved(), milvus::Arena::BLOCK_SIZE);
+
+    // a large buffer has a block of its own, the small ones go on in the first block
+    milvus::ArenaVector<float> distances{milvus::ArenaAllocator<float>(&arena)};
+    distances.resize(milvus::Arena::BLOCK_SIZE, 1.0f);
+    ASSERT_GT(arena.Reserved(), milvus::Arena::BLOCK_SIZE * (1 + sizeof(float)));
+    size_t reserved = arena.Reserved();
+    arena.Allocate(64);
+    ASSERT_EQ(arena.Reserved(), reserved);
+    ASSERT_EQ(ids[999], 7);
+    ASSERT_EQ(distances.back(), 1.0f);
+
+    // without an arena the heap is used
+    milvus::ArenaVector<int32_t> offsets;
+    offsets.resize(100);
+    ASSERT_EQ(arena.Reserved(), reserved);
+
+    ids.clear();
+    distances.clear();
+    arena.Reset();
+    ASSERT_EQ(arena.Reserved(), 0);
+}
+
 TEST(UtilTest, LOG_TEST) {
     fiu_init(0);
 
@@ -311,6 +429,34 @@ TEST(UtilTest, TIMERECOREDRAUTO_TEST) {
     rc.RecordSection("end");
 }
 
+TEST(UtilTest, SCOPED_TIMER_TEST) {
+    auto& buffer = milvus::TraceBuffer::ThreadLocal();
+    auto count = buffer.Count();
+    {
+        milvus::ScopedTimer rc("scope");
+        ASSERT_GE(rc.RecordSection("section"), 0.0);
+        ASSERT_GE(rc.ElapseFromBegin("begin"), 0.0);
+    }
+    ASSERT_EQ(buffer.Count(), count + 3);
+
+    std::vector<milvus::TraceRecord> records;
+    buffer.Dump(records);
+    ASSERT_GE(records.size(), 3UL);
+    ASSERT_STREQ(records[records.size() - 3].name_, "section");
+    ASSERT_STREQ(records.back().name_, "scope");
+    ASSERT_LE(records.back().start_us_, records[records.size() - 2].start_us_);
+
+    // the ring keeps the latest sections
+    milvus::ScopedTimer rc;
+    for (size_t i = 0; i < milvus::TraceBuffer::CAPACITY; ++i) {
+        rc.RecordSection("loop");
+    }
+    records.clear();
+    buffer.Dump(records);
+    ASSERT_EQ(records.size(), milvus::TraceBuffer::CAPACITY);
+    ASSERT_STREQ(records.front().name_, "loop");
+}
+
 TEST(UtilTest, STATUS_TEST) {
     auto status = milvus::Status::OK();
     std::string str = status.ToString();
@@ -320,6 +466,7 @@ TEST(UtilTest, STATUS_TEST) {
     ASSERT_EQ(status.code(), milvus::DB_SUCCESS);
     str = status.ToString();
     ASSERT_FALSE(str.empty());
+    ASSERT_EQ(status.message(), "OK");  // a success keeps no message
 
     status = milvus::Status(milvus::DB_ERROR, "mistake");
     ASSERT_EQ(status.code(), milvus::DB_ERROR);
@@ -515,6 +662,25 @@ TEST(ValidationUtilTest, VALIDATE_INDEX_PARAMS_TEST) {
                                                             (int32_t)milvus::engine::EngineType::FAISS_IVFFLAT);
     ASSERT_TRUE(status.ok());
 
+    json_params = {{"nlist", 32}, {"nbits", 4}};
+    status =
+        milvus::server::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8);
+    ASSERT_TRUE(status.ok());
+    status =
+        milvus::server::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8H);
+    ASSERT_FALSE(status.ok());
+
+    json_params = {{"nlist", 32}, {"nbits", 5}};
+    status =
+        milvus::server::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8NR);
+    ASSERT_FALSE(status.ok());
+
     json_params = {{"nlist", -1}};
     status =
         milvus::server::ValidateIndexParams(json_params,
@@ -634,6 +800,15 @@ TEST(ValidationUtilTest, VALIDATE_SEARCH_PARAMS_TEST) {
     status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
     ASSERT_FALSE(status.ok());
 
+    collection_schema.engine_type_ = (int32_t)milvus::engine::EngineType::FAISS_PQ;
+    json_params = {{"nprobe", 32}, {"lut_fp16", true}};
+    status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
+    ASSERT_TRUE(status.ok());
+
+    json_params = {{"nprobe", 32}, {"lut_fp16", 1}};
+    status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
+    ASSERT_FALSE(status.ok());
+
     collection_schema.engine_type_ = (int32_t)milvus::engine::EngineType::FAISS_BIN_IDMAP;
     json_params = {{"nprobe", 32}};
     status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
@@ -660,6 +835,24 @@ TEST(ValidationUtilTest, VALIDATE_SEARCH_PARAMS_TEST) {
     json_params = {{"ef", 100}};
     status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
     ASSERT_TRUE(status.ok());
+
+    collection_schema.engine_type_ = (int32_t)milvus::engine::EngineType::FAISS_IDMAP;
+    json_params = {{"radius", 1.5}};
+    status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
+    ASSERT_TRUE(status.ok());
+
+    json_params = {{"radius", "far"}};
+    status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
+    ASSERT_FALSE(status.ok());
+
+    collection_schema.engine_type_ = (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8;
+    json_params = {{"nprobe", 32}, {"refine_k", 100}};
+    status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
+    ASSERT_TRUE(status.ok());
+
+    json_params = {{"nprobe", 32}, {"refine_k", 5}};
+    status = milvus::server::ValidateSearchParams(json_params, collection_schema, topk);
+    ASSERT_FALSE(status.ok());
 }
 
 TEST(ValidationUtilTest, VALIDATE_VECTOR_DATA_TEST) {
@@ -703,6 +896,13 @@ TEST(ValidationUtilTest, VALIDATE_TOPK_TEST) {
     ASSERT_NE(milvus::server::ValidateSearchTopk(0).code(), milvus::SERVER_SUCCESS);
 }
 
+TEST(ValidationUtilTest, VALIDATE_SEARCH_MEMORY_TEST) {
+    // 12 bytes per result, copied 3 times
+    ASSERT_TRUE(milvus::server::ValidateSearchMemory(100, 10, 100 * 10 * 36).ok());
+    ASSERT_EQ(milvus::server::ValidateSearchMemory(101, 10, 100 * 10 * 36).code(), milvus::SERVER_OUT_OF_MEMORY);
+    ASSERT_TRUE(milvus::server::ValidateSearchMemory(100000, 2048, 0).ok());
+}
+
 TEST(ValidationUtilTest, VALIDATE_PARTITION_TAGS) {
     std::vector<std::string> partition_tags = {"abc"};
     ASSERT_EQ(milvus::server::ValidatePartitionTags(partition_tags).code(), milvus::SERVER_SUCCESS);
@@ -868,4 +1068,183 @@ TEST(UtilTest, THREADPOOL_TEST) {
     fiu_disable("ThreadPool.enqueue.stop_is_true");
 
     thread_pool_ptr.reset();
+
+    // the worker is held and the queue holds one task, try_enqueue doesn't wait for room
+    milvus::ThreadPool full_pool(1, 1);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> started;
+    ASSERT_TRUE(full_pool.try_enqueue([&started, released]() {
+        started.set_value();
+        released.wait();
+    }));
+    started.get_future().wait();
+    ASSERT_TRUE(full_pool.try_enqueue([]() {}));
+    ASSERT_FALSE(full_pool.try_enqueue([]() {}));
+    release.set_value();
+}
+
+TEST(UtilTest, WORK_STEALING_THREADPOOL_TEST) {
+    using Priority = milvus::WorkStealingThreadPool::Priority;
+    auto thread_pool_ptr = std::make_unique<milvus::WorkStealingThreadPool>(4);
+
+    // more tasks than workers, the idle workers steal from the busy ones
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.emplace_back(thread_pool_ptr->enqueue([](int i) { return i * i; }, i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(futures[i].get(), i * i);
+    }
+
+    // a task enqueued by a worker runs on the pool too
+    auto nested = thread_pool_ptr->enqueue([&]() { return thread_pool_ptr->enqueue([]() { return 7; }).get(); });
+    ASSERT_EQ(nested.get(), 7);
+
+    // the only worker is held while tasks queue up, then the high priority ones run first
+    thread_pool_ptr = std::make_unique<milvus::WorkStealingThreadPool>(1);
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+    thread_pool_ptr->enqueue([gate_future]() { gate_future.wait(); });
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto record = [&](int value) {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(value);
+    };
+    thread_pool_ptr->enqueue_priority(Priority::LOW, record, 2);
+    thread_pool_ptr->enqueue(record, 1);
+    auto last = thread_pool_ptr->enqueue_priority(Priority::HIGH, record, 0);
+    gate.set_value();
+    last.get();
+    thread_pool_ptr.reset();
+    ASSERT_EQ(order, std::vector<int>({0, 1, 2}));
+
+    thread_pool_ptr = std::make_unique<milvus::WorkStealingThreadPool>(2);
+    fiu_init(0);
+    fiu_enable("WorkStealingThreadPool.enqueue.stop_is_true", 1, NULL, 0);
+    ASSERT_ANY_THROW(thread_pool_ptr->enqueue([]() {}));
+    fiu_disable("WorkStealingThreadPool.enqueue.stop_is_true");
+    thread_pool_ptr.reset();
+}
+
+namespace milvus {
+namespace {
+
+void
+LogLines(int64_t count) {
+    for (int64_t i = 0; i < count; ++i) {
+        LOG_SERVER_INFO_ << "line " << i;
+    }
+    LOG_SERVER_DEBUG_ << "disabled level";
+}
+
+}  // namespace
+}  // namespace milvus
+
+TEST(UtilTest, ASYNC_LOG_TEST) {
+    milvus::LogRing ring(3);
+    ASSERT_EQ(ring.Capacity(), 4);
+    milvus::LogRecord record;
+    for (int64_t i = 0; i < 4; ++i) {
+        record.line_ = i;
+        ASSERT_TRUE(ring.Push(record));
+    }
+    ASSERT_FALSE(ring.Push(record));
+    for (int64_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.Pop(record));
+        ASSERT_EQ(record.line_, i);
+    }
+    ASSERT_FALSE(ring.Pop(record));
+
+    // the lines over the limit of the second are refused, two seconds at most pass by
+    milvus::LogSite site;
+    int64_t admitted = 0;
+    for (int64_t i = 0; i < 10; ++i) {
+        admitted += site.Admit(2) ? 1 : 0;
+    }
+    ASSERT_LE(admitted, 4);
+    ASSERT_EQ(site.TakeSuppressed(), 10 - admitted);
+    ASSERT_EQ(site.TakeSuppressed(), 0);
+
+    // the writer thread is held in the sink while the ring of this thread fills up
+    std::mutex records_mutex;
+    std::vector<milvus::LogRecord> records;
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+    auto main_thread = std::this_thread::get_id();
+    auto sink = [&](const milvus::LogRecord& record) {
+        if (std::this_thread::get_id() != main_thread) {
+            gate_future.wait();
+        }
+        std::lock_guard<std::mutex> lock(records_mutex);
+        records.push_back(record);
+    };
+
+    milvus::AsyncLog async_log;
+    uint32_t levels = static_cast<uint32_t>(el::Level::Info) | static_cast<uint32_t>(el::Level::Warning);
+    async_log.Start(64, 0, levels, sink);
+    ASSERT_TRUE(async_log.Enabled());
+    ASSERT_TRUE(async_log.LevelEnabled(el::Level::Info));
+    ASSERT_FALSE(async_log.LevelEnabled(el::Level::Debug));
+
+    for (int64_t i = 0; i < 200; ++i) {
+        milvus::LogRecord info;
+        info.level_ = el::Level::Info;
+        info.line_ = i;
+        async_log.Submit(info);
+    }
+    ASSERT_GE(async_log.Dropped(), 200 - 64 - 1);
+
+    // a warning isn't dropped, it is written by the logging thread
+    milvus::LogRecord warning;
+    warning.level_ = el::Level::Warning;
+    warning.message_ = "warning";
+    async_log.Submit(warning);
+    {
+        std::lock_guard<std::mutex> lock(records_mutex);
+        ASSERT_EQ(records.size(), 1);
+        ASSERT_EQ(records[0].message_, "warning");
+    }
+
+    gate.set_value();
+    async_log.Flush();
+    async_log.Stop();
+    ASSERT_FALSE(async_log.Enabled());
+
+    int64_t infos = 0;
+    int64_t last_line = -1;
+    bool dropped_reported = false;
+    for (auto& written : records) {
+        if (written.level_ == el::Level::Info) {
+            ASSERT_GT(written.line_, last_line);
+            last_line = written.line_;
+            ++infos;
+        } else if (written.message_.find("dropped") != std::string::npos) {
+            dropped_reported = true;
+        }
+    }
+    ASSERT_EQ(infos, 200 - async_log.Dropped());
+    ASSERT_TRUE(dropped_reported);
+
+    // a fatal line is written before Submit returns
+    records.clear();
+    async_log.Start(64, 0, levels, sink);
+    milvus::LogRecord fatal;
+    fatal.level_ = el::Level::Fatal;
+    async_log.Submit(fatal);
+    ASSERT_EQ(records.size(), 1);
+    async_log.Stop();
+
+    // the macros go through the asynchronous log and the rate limit of their call site
+    records.clear();
+    milvus::AsyncLog::GetInstance().Start(64, 5, levels, [&](const milvus::LogRecord& record) {
+        std::lock_guard<std::mutex> lock(records_mutex);
+        records.push_back(record);
+    });
+    milvus::LogLines(20);
+    milvus::AsyncLog::GetInstance().Stop();
+    ASSERT_GE(records.size(), 5);
+    ASSERT_LE(records.size(), 10);
+    ASSERT_NE(records[0].message_.find("line 0"), std::string::npos);
 }
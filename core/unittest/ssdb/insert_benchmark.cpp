@@ -0,0 +1,114 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "ssdb/utils.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "segment/Segment.h"
+
+namespace {
+
+constexpr int64_t COLLECTION_DIM = 128;
+constexpr int64_t ENTITY_COUNT = 10000;
+constexpr int64_t BATCH_COUNT = 5;
+
+milvus::Status
+CreateVectorCollection(std::shared_ptr<SSDBImpl> db, const std::string& collection_name) {
+    CreateCollectionContext context;
+    context.lsn = 0;
+    context.collection = std::make_shared<Collection>(collection_name);
+
+    nlohmann::json params;
+    params[milvus::knowhere::meta::DIM] = COLLECTION_DIM;
+    auto vector_field = std::make_shared<Field>("vector", 0, milvus::engine::FieldType::VECTOR, params);
+    context.fields_schema[vector_field] = {};
+
+    return db->CreateCollection(context);
+}
+
+void
+BuildVectorChunk(int64_t n, milvus::engine::DataChunkPtr& data_chunk) {
+    data_chunk = std::make_shared<milvus::engine::DataChunk>();
+    data_chunk->count_ = n;
+
+    milvus::engine::FIXED_FIELD_DATA& raw = data_chunk->fixed_fields_["vector"];
+    raw.resize(n * COLLECTION_DIM * sizeof(float));
+    auto data = reinterpret_cast<float*>(raw.data());
+    for (int64_t i = 0; i < n * COLLECTION_DIM; i++) {
+        data[i] = drand48();
+    }
+}
+
+int64_t
+ElapsedUs(std::chrono::steady_clock::time_point begin) {
+    auto span = std::chrono::steady_clock::now() - begin;
+    return std::chrono::duration_cast<std::chrono::microseconds>(span).count();
+}
+
+}  // namespace
+
+TEST_F(SSDBTest, InsertBenchmarkTest) {
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildVectorChunk(ENTITY_COUNT, data_chunk);
+    auto& uid_data = data_chunk->fixed_fields_[milvus::engine::DEFAULT_UID_NAME];
+    uid_data.resize(ENTITY_COUNT * sizeof(int64_t));
+    auto uids = reinterpret_cast<int64_t*>(uid_data.data());
+    std::iota(uids, uids + ENTITY_COUNT, 0);
+
+    // the chunk is sliced into the segment the way a mem segment takes it
+    for (int64_t slice_count : {1, 7, 64}) {
+        auto segment_begin = std::chrono::steady_clock::now();
+        milvus::engine::Segment segment;
+        segment.AddField(milvus::engine::DEFAULT_UID_NAME, milvus::engine::FieldType::UID);
+        segment.AddField("vector", milvus::engine::FieldType::VECTOR_FLOAT, COLLECTION_DIM * sizeof(float));
+        int64_t slice = ENTITY_COUNT / slice_count + 1;
+        for (int64_t from = 0; from < ENTITY_COUNT; from += slice) {
+            auto status = segment.AddChunk(data_chunk, from, std::min(from + slice, ENTITY_COUNT));
+            ASSERT_TRUE(status.ok());
+        }
+        auto segment_cost = ElapsedUs(segment_begin);
+        ASSERT_EQ(segment.GetRowCount(), ENTITY_COUNT);
+
+        std::cout << "Segment append of " << ENTITY_COUNT << " entities in " << slice_count
+                  << " slices: " << segment_cost << " us" << std::endl;
+    }
+
+    // the whole insert path, from the request chunk to the flushed segment files
+    std::string collection_name = "INSERT_BENCHMARK";
+    auto status = CreateVectorCollection(db_, collection_name);
+    ASSERT_TRUE(status.ok());
+
+    auto insert_begin = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < BATCH_COUNT; ++i) {
+        BuildVectorChunk(ENTITY_COUNT, data_chunk);
+        status = db_->InsertEntities(collection_name, "", data_chunk);
+        ASSERT_TRUE(status.ok());
+    }
+    status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+    auto insert_cost = ElapsedUs(insert_begin);
+
+    uint64_t row_count = 0;
+    status = db_->GetCollectionRowCount(collection_name, row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, ENTITY_COUNT * BATCH_COUNT);
+
+    std::cout << "Insert and flush of " << BATCH_COUNT << " x " << ENTITY_COUNT << " entities: " << insert_cost
+              << " us, " << (ENTITY_COUNT * BATCH_COUNT * 1000000.0 / std::max<int64_t>(insert_cost, 1))
+              << " entities/s" << std::endl;
+}
@@ -13,6 +13,7 @@
 #include <fiu-local.h>
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <string>
 #include <set>
 #include <algorithm>
@@ -21,6 +22,7 @@
 #include "db/SnapshotVisitor.h"
 #include "db/snapshot/IterateHandler.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "segment/Segment.h"
 
 using SegmentVisitor = milvus::engine::SegmentVisitor;
 
@@ -446,3 +448,56 @@ TEST_F(SSDBTest, MergeTest) {
     ASSERT_TRUE(status.ok());
     ASSERT_EQ(row_count, entity_count * repeat);
 }
+
+TEST_F(SSDBTest, InsertSliceTest) {
+    const int64_t entity_count = 10000;
+    const int64_t slice_count = 7;
+    milvus::engine::DataChunkPtr data_chunk;
+    BuildEntities(entity_count, 0, data_chunk);
+    auto& uid_data = data_chunk->fixed_fields_[milvus::engine::DEFAULT_UID_NAME];
+    uid_data.resize(entity_count * sizeof(int64_t));
+    auto uids = reinterpret_cast<int64_t*>(uid_data.data());
+    std::iota(uids, uids + entity_count, 0);
+
+    // the chunk is sliced into the segment the way a mem segment takes it, the rows come out in order
+    milvus::engine::Segment segment;
+    segment.AddField(milvus::engine::DEFAULT_UID_NAME, milvus::engine::FieldType::UID);
+    segment.AddField("vector", milvus::engine::FieldType::VECTOR_FLOAT, COLLECTION_DIM * sizeof(float));
+    segment.AddField("field_0", milvus::engine::FieldType::INT32);
+    segment.AddField("field_1", milvus::engine::FieldType::INT64);
+    segment.AddField("field_2", milvus::engine::FieldType::DOUBLE);
+    int64_t slice = entity_count / slice_count + 1;
+    for (int64_t from = 0; from < entity_count; from += slice) {
+        auto status = segment.AddChunk(data_chunk, from, std::min(from + slice, entity_count));
+        ASSERT_TRUE(status.ok());
+    }
+    ASSERT_EQ(segment.GetRowCount(), entity_count);
+
+    const milvus::engine::FIXED_FIELD_DATA* segment_uids = nullptr;
+    auto status = segment.GetFixedFieldData(milvus::engine::DEFAULT_UID_NAME, segment_uids);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(*segment_uids, uid_data);
+    const milvus::engine::FIXED_FIELD_DATA* segment_vectors = nullptr;
+    status = segment.GetFixedFieldData("vector", segment_vectors);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(*segment_vectors, data_chunk->fixed_fields_["vector"]);
+
+    // the whole insert path, from the request chunk to the flushed segment files
+    std::string collection_name = "INSERT_SLICE";
+    status = CreateCollection2(db_, collection_name, 0);
+    ASSERT_TRUE(status.ok());
+
+    const int64_t batch_count = 5;
+    for (int64_t i = 0; i < batch_count; ++i) {
+        BuildEntities(entity_count, i, data_chunk);
+        status = db_->InsertEntities(collection_name, "", data_chunk);
+        ASSERT_TRUE(status.ok());
+    }
+    status = db_->Flush();
+    ASSERT_TRUE(status.ok());
+
+    uint64_t row_count = 0;
+    status = db_->GetCollectionRowCount(collection_name, row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, entity_count * batch_count);
+}
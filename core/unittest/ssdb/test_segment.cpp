@@ -13,9 +13,13 @@
 #include <fiu-local.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <string>
+#include <vector>
 
 #include "ssdb/utils.h"
+#include "codecs/snapshot/SSCodec.h"
 #include "db/SnapshotVisitor.h"
 #include "db/Types.h"
 #include "db/snapshot/IterateHandler.h"
@@ -24,6 +28,9 @@
 #include "segment/SSSegmentReader.h"
 #include "segment/SSSegmentWriter.h"
 #include "segment/Types.h"
+#include "storage/disk/DiskIOReader.h"
+#include "storage/disk/DiskIOWriter.h"
+#include "storage/disk/DiskOperation.h"
 #include "utils/Json.h"
 
 using SegmentVisitor = milvus::engine::SegmentVisitor;
@@ -157,3 +164,93 @@ TEST_F(SSSegmentTest, SegmentTest) {
     status = db_->DropCollection(c1);
     ASSERT_TRUE(status.ok());
 }
+
+TEST_F(SSSegmentTest, ContainerTest) {
+    const std::string file_path = "/tmp/milvus_segment_container";
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>("/tmp");
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    auto container_format = milvus::codec::SSCodec::instance().GetSegmentContainerFormat();
+
+    milvus::codec::ContainerSections sections;
+    for (int64_t i = 0; i < 400; ++i) {
+        std::vector<uint8_t> data(i * 7);
+        for (size_t j = 0; j < data.size(); ++j) {
+            data[j] = (uint8_t)(i + j);
+        }
+        sections["section_with_a_long_name_" + std::to_string(i)] = data;
+    }
+    container_format->write(fs_ptr, file_path, sections);
+
+    // the footer of 400 sections doesn't fit into the first tail read
+    milvus::codec::ContainerIndexPtr index;
+    container_format->read_index(fs_ptr, file_path, index);
+    ASSERT_EQ(index->size(), sections.size());
+
+    std::vector<uint8_t> raw;
+    container_format->read_section(fs_ptr, file_path, index, "section_with_a_long_name_42", raw);
+    ASSERT_EQ(raw, sections["section_with_a_long_name_42"]);
+
+    std::vector<std::string> names = {"section_with_a_long_name_0", "section_with_a_long_name_399",
+                                      "section_with_a_long_name_7"};
+    milvus::codec::ContainerSections loaded;
+    container_format->read_sections(fs_ptr, file_path, index, names, loaded);
+    ASSERT_EQ(loaded.size(), names.size());
+    for (auto& name : names) {
+        ASSERT_EQ(loaded[name], sections[name]);
+    }
+    ASSERT_ANY_THROW(container_format->read_section(fs_ptr, file_path, index, "no_such_section", raw));
+
+    // flip a byte of section 42
+    auto section = index->at("section_with_a_long_name_42");
+    {
+        FILE* file = fopen(file_path.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        fseek(file, sizeof(size_t) + section.offset_, SEEK_SET);
+        uint8_t byte = ~sections["section_with_a_long_name_42"][0];
+        fwrite(&byte, 1, 1, file);
+        fclose(file);
+    }
+    ASSERT_ANY_THROW(container_format->read_section(fs_ptr, file_path, index, "section_with_a_long_name_42", raw));
+    container_format->read_section(fs_ptr, file_path, index, "section_with_a_long_name_43", raw);
+    ASSERT_EQ(raw, sections["section_with_a_long_name_43"]);
+
+    // a file which is not a container
+    milvus::codec::SSCodec::instance().GetBlockFormat()->write(fs_ptr, file_path, std::vector<uint8_t>(100, 0));
+    ASSERT_ANY_THROW(container_format->read_index(fs_ptr, file_path, index));
+    std::remove(file_path.c_str());
+}
+
+TEST_F(SSSegmentTest, CoalescedReadTest) {
+    const std::string file_path = "/tmp/milvus_segment_block";
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>("/tmp");
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    auto block_format = milvus::codec::SSCodec::instance().GetBlockFormat();
+
+    std::vector<uint8_t> block(10000);
+    for (size_t i = 0; i < block.size(); ++i) {
+        block[i] = (uint8_t)(i * 13);
+    }
+    block_format->write(fs_ptr, file_path, block);
+
+    // unsorted, overlapping, and one range cut short at the end of the block
+    milvus::codec::ReadRanges ranges = {{9000, 100}, {10, 20}, {15, 30}, {5000, 8}, {9990, 100}};
+    for (int64_t gap : {0, 100, 100000}) {
+        std::vector<std::vector<uint8_t>> data;
+        block_format->read_coalesced(fs_ptr, file_path, ranges, gap, data);
+        ASSERT_EQ(data.size(), ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            int64_t end = std::min<int64_t>(ranges[i].offset_ + ranges[i].num_bytes_, block.size());
+            std::vector<uint8_t> expected(block.begin() + ranges[i].offset_, block.begin() + end);
+            ASSERT_EQ(data[i], expected);
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> data;
+    ranges = {{10000, 10}};
+    ASSERT_ANY_THROW(block_format->read_coalesced(fs_ptr, file_path, ranges, 0, data));
+    std::remove(file_path.c_str());
+}
@@ -16,6 +16,8 @@
 #include <string>
 #include <set>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "ssdb/utils.h"
 #include "db/snapshot/HandlerFactory.h"
@@ -64,6 +66,81 @@ TEST_F(SnapshotTest, ReferenceProxyTest) {
     }
     ASSERT_EQ(proxy.ref_count(), 0);
     ASSERT_EQ(status, CALLED);
+
+    ASSERT_FALSE(proxy.TryRef());
+    ASSERT_EQ(proxy.ref_count(), 0);
+    proxy.Ref();
+    ASSERT_TRUE(proxy.TryRef());
+    ASSERT_EQ(proxy.ref_count(), 2);
+}
+
+TEST_F(SnapshotTest, EpochManagerTest) {
+    auto& manager = EpochManager::GetInstance();
+    std::atomic<bool> entered = {false};
+    std::atomic<bool> synchronized = {false};
+
+    auto reader = [&]() {
+        EpochManager::Guard guard;
+        ASSERT_TRUE(guard.Entered());
+        {
+            EpochManager::Guard inner;
+            ASSERT_TRUE(inner.Entered());
+        }
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_FALSE(synchronized);
+    };
+    std::thread t = std::thread(reader);
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    manager.Synchronize();
+    synchronized = true;
+    t.join();
+
+    // nobody is inside a guard
+    manager.Synchronize();
+}
+
+TEST_F(SnapshotTest, ConcurrentGetSnapshotTest) {
+    std::string collection_name("c1");
+    LSN_TYPE lsn = 0;
+    auto ss = CreateCollection(collection_name, ++lsn);
+    ASSERT_TRUE(ss);
+
+    std::atomic<bool> stop = {false};
+    auto reader = [&]() {
+        ID_TYPE last_id = 0;
+        while (!stop) {
+            ScopedSnapshotT a_ss;
+            auto status = Snapshots::GetInstance().GetSnapshot(a_ss, collection_name);
+            ASSERT_TRUE(status.ok());
+            ASSERT_GE(a_ss->GetID(), last_id);
+            ASSERT_TRUE(a_ss->GetCollectionCommit()->IsActive());
+            last_id = a_ss->GetID();
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back(reader);
+    }
+
+    for (auto i = 0; i < 20; ++i) {
+        PartitionContext p_ctx;
+        p_ctx.name = "p_" + std::to_string(i);
+        auto curr_ss = CreatePartition(collection_name, p_ctx, ++lsn);
+        ASSERT_TRUE(curr_ss);
+    }
+
+    stop = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    ScopedSnapshotT latest_ss;
+    ASSERT_TRUE(Snapshots::GetInstance().GetSnapshot(latest_ss, collection_name).ok());
+    ASSERT_EQ(latest_ss->NumberOfPartitions(), 21);
 }
 
 TEST_F(SnapshotTest, ScopedResourceTest) {
@@ -915,6 +992,84 @@ TEST_F(SnapshotTest, OperationTest) {
     Snapshots::GetInstance().Reset();
 }
 
+TEST_F(SnapshotTest, BatchSegmentsTest) {
+    std::string collection_name("c1");
+    LSN_TYPE lsn = 0;
+    auto ss = CreateCollection(collection_name, ++lsn);
+    ASSERT_TRUE(ss);
+    for (auto i = 0; i < 4; ++i) {
+        PartitionContext p_ctx;
+        p_ctx.name = "p_" + std::to_string(i);
+        ss = CreatePartition(collection_name, p_ctx, ++lsn);
+        ASSERT_TRUE(ss);
+    }
+
+    SegmentFileContext sf_context;
+    SFContextBuilder(sf_context, ss);
+    std::vector<ID_TYPE> partition_ids;
+    for (auto& kv : ss->GetResources<Partition>()) {
+        ASSERT_TRUE(CreateSegment(ss, kv.first, ++lsn, sf_context, 100).ok());
+        partition_ids.push_back(kv.first);
+    }
+    ASSERT_TRUE(Snapshots::GetInstance().GetSnapshot(ss, collection_name).ok());
+    ASSERT_EQ(ss->GetCollectionCommit()->GetRowCount(), 100 * partition_ids.size());
+
+    // drop the old segment of the first two partitions and add two segments to every partition
+    OperationContext context;
+    context.lsn = ++lsn;
+    auto op = std::make_shared<BatchSegmentsOperation>(context, ss);
+    std::set<ID_TYPE> stale_segment_ids;
+    for (auto& kv : ss->GetResources<Segment>()) {
+        auto partition_id = kv.second->GetPartitionId();
+        if (partition_id == partition_ids[0] || partition_id == partition_ids[1]) {
+            ASSERT_TRUE(op->CommitDropSegment(kv.first).ok());
+            stale_segment_ids.insert(kv.first);
+        }
+    }
+    ASSERT_EQ(stale_segment_ids.size(), 2);
+
+    SIZE_TYPE new_row_cnt = 0;
+    for (auto& partition_id : partition_ids) {
+        for (auto i = 0; i < 2; ++i) {
+            SegmentPtr new_seg;
+            ASSERT_TRUE(op->CommitNewSegment(partition_id, new_seg).ok());
+            auto nsf_context = sf_context;
+            nsf_context.segment_id = new_seg->GetID();
+            SegmentFilePtr seg_file;
+            ASSERT_TRUE(op->CommitNewSegmentFile(nsf_context, seg_file).ok());
+            ASSERT_EQ(seg_file->GetPartitionId(), partition_id);
+            seg_file->SetSize(200);
+            ASSERT_TRUE(op->CommitRowCount(new_seg->GetID(), 20).ok());
+            new_row_cnt += 20;
+        }
+    }
+
+    auto nsf_context = sf_context;
+    nsf_context.segment_id = *stale_segment_ids.begin();
+    SegmentFilePtr seg_file;
+    ASSERT_FALSE(op->CommitNewSegmentFile(nsf_context, seg_file).ok());
+    ASSERT_FALSE(op->CommitDropSegment(11111111).ok());
+
+    ASSERT_TRUE(op->Push().ok());
+    ScopedSnapshotT batch_ss;
+    ASSERT_TRUE(op->GetSnapshot(batch_ss).ok());
+    ASSERT_EQ(batch_ss->GetID(), ss->GetID() + 1);
+    ASSERT_EQ(batch_ss->GetCollectionCommit()->GetRowCount(), 100 * (partition_ids.size() - 2) + new_row_cnt);
+    ASSERT_EQ(batch_ss->GetResources<Segment>().size(), partition_ids.size() - 2 + 2 * partition_ids.size());
+    for (auto& stale_segment_id : stale_segment_ids) {
+        ASSERT_FALSE(batch_ss->GetSegmentCommitBySegmentId(stale_segment_id));
+    }
+    for (auto i = 0; i < partition_ids.size(); ++i) {
+        auto pc = batch_ss->GetPartitionCommitByPartitionId(partition_ids[i]);
+        ASSERT_EQ(pc->GetMappings().size(), i < 2 ? 2 : 3);
+        ASSERT_EQ(pc->GetRowCount(), i < 2 ? 40 : 140);
+    }
+
+    // a batch without any change is rejected
+    auto empty_op = std::make_shared<BatchSegmentsOperation>(context, batch_ss);
+    ASSERT_FALSE(empty_op->Push().ok());
+}
+
 TEST_F(SnapshotTest, CompoundTest1) {
     Status status;
     std::atomic<LSN_TYPE> lsn = 0;
@@ -23,6 +23,7 @@
 #include "db/meta/MetaAdapter.h"
 #include "db/snapshot/CompoundOperations.h"
 #include "db/snapshot/Context.h"
+#include "db/snapshot/EpochManager.h"
 #include "db/snapshot/EventExecutor.h"
 #include "db/snapshot/OperationExecutor.h"
 #include "db/snapshot/ReferenceProxy.h"
@@ -48,6 +49,7 @@ using AddFieldElementOperation = milvus::engine::snapshot::AddFieldElementOperat
 using DropAllIndexOperation = milvus::engine::snapshot::DropAllIndexOperation;
 using BuildOperation = milvus::engine::snapshot::BuildOperation;
 using MergeOperation = milvus::engine::snapshot::MergeOperation;
+using BatchSegmentsOperation = milvus::engine::snapshot::BatchSegmentsOperation;
 using CreateCollectionOperation = milvus::engine::snapshot::CreateCollectionOperation;
 using NewSegmentOperation = milvus::engine::snapshot::NewSegmentOperation;
 using DropPartitionOperation = milvus::engine::snapshot::DropPartitionOperation;
@@ -70,6 +72,7 @@ using FieldElementPtr = milvus::engine::snapshot::FieldElementPtr;
 using Snapshots = milvus::engine::snapshot::Snapshots;
 using ScopedSnapshotT = milvus::engine::snapshot::ScopedSnapshotT;
 using ReferenceProxy = milvus::engine::snapshot::ReferenceProxy;
+using EpochManager = milvus::engine::snapshot::EpochManager;
 using Queue = milvus::BlockingQueue<ID_TYPE>;
 using TQueue = milvus::BlockingQueue<std::tuple<ID_TYPE, ID_TYPE>>;
 using SoftDeleteCollectionOperation = milvus::engine::snapshot::SoftDeleteOperation<Collection>;
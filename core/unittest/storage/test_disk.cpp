@@ -13,7 +13,22 @@
 #include <fiu-local.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "codecs/default/DefaultAttrsFormat.h"
+#include "codecs/default/DefaultDeletedDocsFormat.h"
+#include "codecs/default/DefaultVectorsFormat.h"
+#include "codecs/default/RawDataCodec.h"
 #include "easyloggingpp/easylogging++.h"
+#include "segment/SegmentWriter.h"
+#include "storage/IOScheduler.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
 #include "storage/disk/DiskOperation.h"
@@ -64,6 +79,150 @@ TEST_F(StorageTest, DISK_RW_TEST) {
     }
 }
 
+TEST_F(StorageTest, DISK_MMAP_TEST) {
+    const std::string file_name = "/tmp/test_mmap";
+    std::vector<float> content(10000);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = i;
+    }
+    size_t len = content.size() * sizeof(float);
+
+    {
+        milvus::storage::DiskIOWriter writer;
+        ASSERT_TRUE(writer.open(file_name));
+        writer.write(&len, sizeof(len));
+        writer.write((void*)(content.data()), len);
+        writer.close();
+    }
+
+    milvus::storage::DiskIOReader reader;
+    ASSERT_TRUE(reader.open(file_name));
+    auto data = reader.mmap(sizeof(len), len, milvus::storage::MmapAdvice::SEQUENTIAL);
+    ASSERT_EQ(reader.mmap(sizeof(len), len + 1, milvus::storage::MmapAdvice::NORMAL), nullptr);
+    ASSERT_EQ(reader.mmap(-1, len, milvus::storage::MmapAdvice::NORMAL), nullptr);
+    reader.close();
+
+    // the mapping outlives the reader
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(memcmp(data.get(), content.data(), len), 0);
+}
+
+TEST_F(StorageTest, DISK_PREAD_TEST) {
+    const std::string file_name = "/tmp/test_pread";
+    std::vector<int64_t> content(10000);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = i;
+    }
+
+    {
+        milvus::storage::DiskIOWriter writer;
+        ASSERT_TRUE(writer.open(file_name));
+        writer.write((void*)(content.data()), content.size() * sizeof(int64_t));
+        writer.close();
+    }
+
+    milvus::storage::DiskIOReader reader;
+    ASSERT_TRUE(reader.open(file_name));
+
+    int64_t value = 0;
+    reader.pread(&value, sizeof(value), 42 * sizeof(int64_t));
+    ASSERT_EQ(value, 42);
+
+    // positional reads don't move the stream position
+    reader.read(&value, sizeof(value));
+    ASSERT_EQ(value, 0);
+
+    // unordered, adjacent and overlapping ranges
+    std::vector<int64_t> offsets = {9000, 5, 6, 7, 100, 6, 9999};
+    std::vector<int64_t> values(offsets.size() + 1, -1);
+    milvus::storage::ReadRequests requests;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        requests.emplace_back(&values[i], offsets[i] * sizeof(int64_t), sizeof(int64_t));
+    }
+    reader.readahead(0, 1024);
+    reader.preadv(requests);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT_EQ(values[i], offsets[i]);
+    }
+    ASSERT_EQ(values.back(), -1);
+
+    ASSERT_ANY_THROW(reader.pread(&value, sizeof(value), content.size() * sizeof(int64_t)));
+    reader.close();
+}
+
+TEST_F(StorageTest, DISK_RAW_DATA_CODEC_TEST) {
+    const std::string file_name = "/tmp/test_raw_data";
+    auto writer = std::make_shared<milvus::storage::DiskIOWriter>();
+    auto reader = std::make_shared<milvus::storage::DiskIOReader>();
+
+    auto check = [&](milvus::codec::RawDataCodecType type, const std::vector<uint8_t>& data, bool compress) {
+        ASSERT_TRUE(writer->open(file_name));
+        milvus::codec::WriteRawData(writer, type, data.data(), data.size(), compress);
+        int64_t file_size = writer->length();
+        writer->close();
+
+        ASSERT_TRUE(reader->open(file_name));
+        milvus::codec::RawDataHeader header;
+        ASSERT_EQ(milvus::codec::ReadRawDataHeader(reader, file_name, header), data.size());
+        ASSERT_EQ(header.magic_ == milvus::codec::RAW_DATA_MAGIC, (size_t)file_size < data.size() + sizeof(size_t));
+
+        std::vector<uint8_t> data_out(data.size());
+        milvus::codec::ReadRawData(reader, file_name, header, 0, data.size(), data_out.data());
+        ASSERT_TRUE(data_out == data);
+
+        // ranges within a block and across blocks
+        std::vector<std::pair<size_t, size_t>> ranges = {{0, 1}, {13, 1000}, {65530, 20}, {70000, 131072}};
+        for (auto& range : ranges) {
+            if (range.first + range.second > data.size()) {
+                continue;
+            }
+            std::vector<uint8_t> range_out(range.second);
+            milvus::codec::ReadRawData(reader, file_name, header, range.first, range.second, range_out.data());
+            ASSERT_EQ(memcmp(range_out.data(), data.data() + range.first, range.second), 0);
+        }
+        reader->close();
+    };
+
+    // float vectors in [-1, 1]: the sign/exponent plane takes a few bits per value
+    std::default_random_engine engine(42);
+    std::uniform_real_distribution<float> distribution(-1.0, 1.0);
+    std::vector<float> floats(100003);
+    for (auto& value : floats) {
+        value = distribution(engine);
+    }
+    std::vector<uint8_t> float_bytes(floats.size() * sizeof(float) + 3);
+    memcpy(float_bytes.data(), floats.data(), floats.size() * sizeof(float));
+    check(milvus::codec::RawDataCodecType::BYTE_PLANE, float_bytes, true);
+    check(milvus::codec::RawDataCodecType::BYTE_PLANE, float_bytes, false);
+
+    // random bytes don't compress, they are kept plain
+    std::vector<uint8_t> random_bytes(200000);
+    for (auto& value : random_bytes) {
+        value = engine() & 0xff;
+    }
+    check(milvus::codec::RawDataCodecType::BYTE_PLANE, random_bytes, true);
+
+    // ascending uids with gaps, and uids wrapping around the int64 range
+    std::vector<int64_t> uids(50000);
+    for (size_t i = 0; i < uids.size(); ++i) {
+        uids[i] = 1590000000000000000 + i * 3 + (i % 7 == 0 ? 1 : 0);
+    }
+    uids[100] = INT64_MAX;
+    uids[101] = INT64_MIN;
+    std::vector<uint8_t> uid_bytes(uids.size() * sizeof(int64_t));
+    memcpy(uid_bytes.data(), uids.data(), uid_bytes.size());
+    check(milvus::codec::RawDataCodecType::DELTA_INT64, uid_bytes, true);
+
+    for (auto type : {milvus::codec::RawDataCodecType::BYTE_PLANE, milvus::codec::RawDataCodecType::DELTA_INT64}) {
+        std::vector<uint8_t> encoded;
+        milvus::codec::EncodeRawDataBlock(type, uid_bytes.data(), 4096, encoded);
+        std::vector<uint8_t> decoded(4096);
+        ASSERT_TRUE(milvus::codec::DecodeRawDataBlock(type, encoded.data(), encoded.size(), decoded.data(), 4096));
+        ASSERT_EQ(memcmp(decoded.data(), uid_bytes.data(), 4096), 0);
+        ASSERT_FALSE(milvus::codec::DecodeRawDataBlock(type, encoded.data(), encoded.size() - 1, decoded.data(), 4096));
+    }
+}
+
 TEST_F(StorageTest, DISK_OPERATION_TEST) {
     auto disk_operation = milvus::storage::DiskOperation("/tmp/milvus_test/milvus_disk_operation_test");
 
@@ -81,3 +240,248 @@ TEST_F(StorageTest, DISK_OPERATION_TEST) {
         ASSERT_TRUE(disk_operation.DeleteFile(path));
     }
 }
+
+TEST_F(StorageTest, DISK_READ_ROWS_TEST) {
+    const std::string dir_path = "/tmp/test_read_rows";
+    boost::filesystem::remove_all(dir_path);
+    boost::filesystem::create_directories(dir_path);
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir_path);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+
+    const size_t rows = 10000, dim = 16;
+    std::vector<int64_t> values(rows);
+    std::vector<float> vectors(rows * dim);
+    for (size_t i = 0; i < rows; ++i) {
+        values[i] = i * 7;
+        for (size_t j = 0; j < dim; ++j) {
+            vectors[i * dim + j] = i + j / 100.0f;
+        }
+    }
+
+    // an attribute file is plain, a vector file may be encoded
+    ASSERT_TRUE(fs_ptr->writer_ptr_->open(dir_path + "/field_0.ra"));
+    size_t num_bytes = rows * sizeof(int64_t);
+    fs_ptr->writer_ptr_->write(&num_bytes, sizeof(size_t));
+    fs_ptr->writer_ptr_->write(values.data(), num_bytes);
+    fs_ptr->writer_ptr_->close();
+    ASSERT_TRUE(fs_ptr->writer_ptr_->open(dir_path + "/1.rv"));
+    milvus::codec::WriteRawData(fs_ptr->writer_ptr_, milvus::codec::RawDataCodecType::BYTE_PLANE, vectors.data(),
+                                vectors.size() * sizeof(float), true);
+    fs_ptr->writer_ptr_->close();
+
+    std::vector<int64_t> offsets = {9999, 3, 5000, 3, 0};
+    milvus::codec::DefaultAttrsFormat attrs_format;
+    std::vector<uint8_t> raw;
+    attrs_format.read_attrs(fs_ptr, "field_0", offsets, sizeof(int64_t), raw);
+    ASSERT_EQ(raw.size(), offsets.size() * sizeof(int64_t));
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT_EQ(reinterpret_cast<int64_t*>(raw.data())[i], values[offsets[i]]);
+    }
+
+    milvus::codec::DefaultVectorsFormat vectors_format;
+    size_t width = dim * sizeof(float);
+    vectors_format.read_vectors(fs_ptr, offsets, width, raw);
+    ASSERT_EQ(raw.size(), offsets.size() * width);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT_EQ(memcmp(raw.data() + i * width, vectors.data() + offsets[i] * dim, width), 0);
+    }
+
+    offsets = {rows};
+    ASSERT_ANY_THROW(attrs_format.read_attrs(fs_ptr, "field_0", offsets, sizeof(int64_t), raw));
+    ASSERT_ANY_THROW(vectors_format.read_vectors(fs_ptr, offsets, width, raw));
+    boost::filesystem::remove_all(dir_path);
+}
+
+TEST_F(StorageTest, SEGMENT_COMPACT_TEST) {
+    const std::string dir_path = "/tmp/test_segment_compact";
+    const std::string compacted_dir_path = "/tmp/test_segment_compacted";
+    boost::filesystem::remove_all(dir_path);
+    boost::filesystem::remove_all(compacted_dir_path);
+    boost::filesystem::create_directories(dir_path);
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir_path);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+
+    const size_t rows = 1000, dim = 8;
+    const size_t width = dim * sizeof(float);
+    std::vector<float> vectors(rows * dim);
+    std::vector<int64_t> uids(rows);
+    std::vector<uint8_t> values(rows * sizeof(int32_t));
+    for (size_t i = 0; i < rows; ++i) {
+        uids[i] = i + 100;
+        reinterpret_cast<int32_t*>(values.data())[i] = i * 3;
+        for (size_t j = 0; j < dim; ++j) {
+            vectors[i * dim + j] = i + j / 10.0f;
+        }
+    }
+
+    auto vectors_ptr = std::make_shared<milvus::segment::Vectors>();
+    vectors_ptr->SetName("origin");
+    vectors_ptr->AddData(reinterpret_cast<uint8_t*>(vectors.data()), vectors.size() * sizeof(float));
+    vectors_ptr->AddUids(uids);
+    milvus::codec::DefaultVectorsFormat().write(fs_ptr, vectors_ptr);
+
+    auto attrs_ptr = std::make_shared<milvus::segment::Attrs>();
+    attrs_ptr->attrs["field_0"] = std::make_shared<milvus::segment::Attr>(values, values.size(), uids, "field_0");
+    milvus::codec::DefaultAttrsFormat().write(fs_ptr, attrs_ptr);
+
+    std::vector<milvus::segment::offset_t> deleted = {0, 7, 500, 7, 999};
+    auto deleted_docs = std::make_shared<milvus::segment::DeletedDocs>(deleted);
+    milvus::codec::DefaultDeletedDocsFormat().write(fs_ptr, deleted_docs);
+
+    // chunks of a few rows, which don't divide the segment
+    milvus::segment::SegmentWriter segment_writer(compacted_dir_path);
+    auto status = segment_writer.Compact(dir_path, "compacted", width, 7 * width + 3);
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_writer.GetSegment(segment_ptr);
+    auto& compacted_uids = segment_ptr->vectors_ptr_->GetUids();
+    auto& compacted_vectors = segment_ptr->vectors_ptr_->GetData();
+    ASSERT_EQ(compacted_uids.size(), rows - 4);
+    ASSERT_EQ(compacted_vectors.size(), (rows - 4) * width);
+    auto& attr = segment_ptr->attrs_ptr_->attrs.at("field_0");
+    ASSERT_EQ(attr->GetNbytes(), (rows - 4) * sizeof(int32_t));
+
+    size_t row = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (i == 0 || i == 7 || i == 500 || i == 999) {
+            continue;
+        }
+        ASSERT_EQ(compacted_uids[row], uids[i]);
+        ASSERT_EQ(memcmp(compacted_vectors.data() + row * width, vectors.data() + i * dim, width), 0);
+        ASSERT_EQ(reinterpret_cast<const int32_t*>(attr->GetData().data())[row], i * 3);
+        ++row;
+    }
+
+    ASSERT_FALSE(segment_writer.Compact(dir_path, "compacted", 0, 1024).ok());
+    boost::filesystem::remove_all(dir_path);
+    boost::filesystem::remove_all(compacted_dir_path);
+}
+
+TEST_F(StorageTest, SEGMENT_MERGE_FILES_TEST) {
+    const std::vector<std::string> dir_paths = {"/tmp/test_segment_merge_0", "/tmp/test_segment_merge_1"};
+    const std::string merged_dir_path = "/tmp/test_segment_merged";
+    boost::filesystem::remove_all(merged_dir_path);
+
+    const size_t rows = 1000, dim = 8;
+    const size_t width = dim * sizeof(float);
+    std::vector<float> vectors(rows * dim);
+    std::vector<int64_t> uids(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        uids[i] = i + 100;
+        for (size_t j = 0; j < dim; ++j) {
+            vectors[i * dim + j] = i + j / 10.0f;
+        }
+    }
+
+    // the same rows in both segments, the first one with deleted rows
+    std::vector<milvus::storage::FSHandlerPtr> fs_ptrs;
+    for (auto& dir_path : dir_paths) {
+        boost::filesystem::remove_all(dir_path);
+        boost::filesystem::create_directories(dir_path);
+        milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+        milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+        milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(dir_path);
+        auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+        fs_ptrs.push_back(fs_ptr);
+
+        auto vectors_ptr = std::make_shared<milvus::segment::Vectors>();
+        vectors_ptr->SetName("origin");
+        vectors_ptr->AddData(reinterpret_cast<uint8_t*>(vectors.data()), vectors.size() * sizeof(float));
+        vectors_ptr->AddUids(uids);
+        milvus::codec::DefaultVectorsFormat().write(fs_ptr, vectors_ptr);
+        ASSERT_TRUE(milvus::segment::SegmentWriter::CanMergeFiles(dir_path));
+    }
+    std::vector<milvus::segment::offset_t> deleted = {0, 7, 8, 500, 999};
+    milvus::codec::DefaultDeletedDocsFormat().write(fs_ptrs[0],
+                                                    std::make_shared<milvus::segment::DeletedDocs>(deleted));
+
+    milvus::segment::SegmentWriter segment_writer(merged_dir_path);
+    for (auto& dir_path : dir_paths) {
+        auto status = segment_writer.MergeFiles(dir_path, "merged");
+        ASSERT_TRUE(status.ok()) << status.message();
+    }
+    ASSERT_EQ(segment_writer.VectorCount(), 2 * rows - deleted.size());
+    ASSERT_EQ(segment_writer.Size(), (2 * rows - deleted.size()) * (width + sizeof(int64_t)));
+    ASSERT_FALSE(segment_writer.Merge(dir_paths[0], "merged").ok());
+    auto status = segment_writer.Serialize();
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    milvus::storage::IOReaderPtr reader_ptr = std::make_shared<milvus::storage::DiskIOReader>();
+    milvus::storage::IOWriterPtr writer_ptr = std::make_shared<milvus::storage::DiskIOWriter>();
+    milvus::storage::OperationPtr operation_ptr = std::make_shared<milvus::storage::DiskOperation>(merged_dir_path);
+    auto fs_ptr = std::make_shared<milvus::storage::FSHandler>(reader_ptr, writer_ptr, operation_ptr);
+    auto merged_ptr = std::make_shared<milvus::segment::Vectors>();
+    milvus::codec::DefaultVectorsFormat().read(fs_ptr, merged_ptr);
+    auto& merged_uids = merged_ptr->GetUids();
+    auto& merged_vectors = merged_ptr->GetData();
+    ASSERT_EQ(merged_uids.size(), 2 * rows - deleted.size());
+    ASSERT_EQ(merged_vectors.size(), merged_uids.size() * width);
+
+    size_t row = 0;
+    for (size_t i = 0; i < 2 * rows; ++i) {
+        if (std::find(deleted.begin(), deleted.end(), (milvus::segment::offset_t)i) != deleted.end()) {
+            continue;
+        }
+        ASSERT_EQ(merged_uids[row], uids[i % rows]);
+        ASSERT_EQ(memcmp(merged_vectors.data() + row * width, vectors.data() + (i % rows) * dim, width), 0);
+        ++row;
+    }
+
+    // the attributes are only merged by loading the segment
+    auto attrs_ptr = std::make_shared<milvus::segment::Attrs>();
+    std::vector<uint8_t> values(rows * sizeof(int32_t));
+    attrs_ptr->attrs["field_0"] = std::make_shared<milvus::segment::Attr>(values, values.size(), uids, "field_0");
+    milvus::codec::DefaultAttrsFormat().write(fs_ptrs[1], attrs_ptr);
+    ASSERT_FALSE(milvus::segment::SegmentWriter::CanMergeFiles(dir_paths[1]));
+
+    for (auto& dir_path : dir_paths) {
+        boost::filesystem::remove_all(dir_path);
+    }
+    boost::filesystem::remove_all(merged_dir_path);
+}
+
+TEST_F(StorageTest, IO_SCHEDULER_TEST) {
+    using milvus::storage::IOClass;
+    using milvus::storage::IOClassGuard;
+    const int64_t MB = 1024 * 1024;
+
+    milvus::storage::IOScheduler scheduler;
+    scheduler.Configure(10 * MB, 5.0);
+
+    // the foreground is never paced
+    auto start = std::chrono::steady_clock::now();
+    scheduler.Acquire(100 * MB);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    {
+        IOClassGuard guard(IOClass::BACKGROUND);
+        ASSERT_EQ(milvus::storage::IOScheduler::CurrentClass(), IOClass::BACKGROUND);
+        start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < 3; ++i) {
+            scheduler.Acquire(MB);
+        }
+        ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(250));
+    }
+    ASSERT_EQ(milvus::storage::IOScheduler::CurrentClass(), IOClass::FOREGROUND);
+
+    // slow foreground reads halve the background rate, it grows back by a tenth of the max once they are fast
+    scheduler.Configure(10 * MB, 5.0);
+    scheduler.RecordRead(MB, std::chrono::milliseconds(50));
+    std::this_thread::sleep_for(std::chrono::milliseconds(110));
+    {
+        IOClassGuard guard(IOClass::BACKGROUND);
+        scheduler.Acquire(1);
+        ASSERT_EQ(scheduler.BackgroundRate(), 5 * MB);
+        std::this_thread::sleep_for(std::chrono::milliseconds(110));
+        scheduler.Acquire(1);
+        ASSERT_EQ(scheduler.BackgroundRate(), 6 * MB);
+    }
+
+    scheduler.Configure(0, 5.0);
+    ASSERT_EQ(scheduler.BackgroundRate(), 0);
+}
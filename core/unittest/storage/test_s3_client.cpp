@@ -11,6 +11,8 @@
 
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <boost/filesystem.hpp>
 #include <fstream>
 #include <memory>
 #include <fiu-local.h>
@@ -68,6 +70,40 @@ TEST_F(StorageTest, S3_CLIENT_TEST) {
         ASSERT_TRUE(content_out == content);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    /* check GetObjectParallel() with local cache */
+    {
+        const std::string cache_path = "/tmp/milvus_test/s3_cache";
+        storage_inst.SetDownloadOptions(5, 3, cache_path);
+
+        std::string content_out;
+        ASSERT_TRUE(storage_inst.GetObjectParallel(objname, content_out).ok());
+        ASSERT_TRUE(content_out == content);
+
+        int64_t size = 0;
+        std::string etag;
+        ASSERT_TRUE(storage_inst.HeadObject(objname, size, etag).ok());
+        ASSERT_EQ(size, content.length());
+        ASSERT_TRUE(boost::filesystem::exists(cache_path + "/" + objname + "." + etag));
+
+        // served from the cache file while the ETag is unchanged
+        fiu_enable("S3ClientWrapper.GetObjectRange.outcome.fail", 1, NULL, 0);
+        ASSERT_TRUE(storage_inst.GetObjectParallel(objname, content_out).ok());
+        ASSERT_TRUE(content_out == content);
+        fiu_disable("S3ClientWrapper.GetObjectRange.outcome.fail");
+
+        const std::string new_content = "0123456789";
+        ASSERT_TRUE(storage_inst.PutObjectStr(objname, new_content).ok());
+        ASSERT_TRUE(storage_inst.GetObjectParallel(objname, content_out).ok());
+        ASSERT_TRUE(content_out == new_content);
+        ASSERT_FALSE(boost::filesystem::exists(cache_path + "/" + objname + "." + etag));
+
+        storage_inst.SetDownloadOptions(milvus::storage::S3_DOWNLOAD_PART_SIZE_DEFAULT,
+                                        milvus::storage::S3_DOWNLOAD_CONCURRENCY_DEFAULT, "");
+        boost::filesystem::remove_all(cache_path);
+        ASSERT_TRUE(storage_inst.PutObjectStr(objname, content).ok());
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     ASSERT_TRUE(storage_inst.DeleteObject(filename).ok());
     ASSERT_TRUE(storage_inst.DeleteObject(objname).ok());
@@ -126,6 +162,42 @@ TEST_F(StorageTest, S3_RW_TEST) {
         reader.close();
     }
 
+    /* objects larger than one part go through multipart upload */
+    {
+        storage_inst.SetUploadOptions(milvus::storage::S3_UPLOAD_PART_SIZE_MIN, 2);
+        std::string large_content;
+        for (int64_t i = 0; i < milvus::storage::S3_UPLOAD_PART_SIZE_MIN * 3 + 100; ++i) {
+            large_content.push_back('a' + i % 26);
+        }
+
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        for (size_t pos = 0; pos < large_content.size(); pos += 1000) {
+            writer.write(&large_content[pos], std::min((size_t)1000, large_content.size() - pos));
+        }
+        ASSERT_EQ(writer.length(), large_content.size());
+        writer.close();
+        ASSERT_TRUE(writer.status().ok());
+
+        std::string content_out;
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_TRUE(content_out == large_content);
+
+        fiu_enable("S3ClientWrapper.UploadPart.outcome.fail", 1, NULL, 0);
+        writer.open(index_name);
+        writer.write(&large_content[0], large_content.size());
+        writer.close();
+        ASSERT_FALSE(writer.status().ok());
+        fiu_disable("S3ClientWrapper.UploadPart.outcome.fail");
+
+        // the failed upload left the object untouched
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_TRUE(content_out == large_content);
+
+        storage_inst.SetUploadOptions(milvus::storage::S3_UPLOAD_PART_SIZE_DEFAULT,
+                                      milvus::storage::S3_UPLOAD_CONCURRENCY_DEFAULT);
+    }
+
     storage_inst.StopService();
 }
 
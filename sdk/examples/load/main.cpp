@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <getopt.h>
+#include <libgen.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "src/LoadGenerator.h"
+
+void
+print_help(const std::string& app_name);
+
+int
+main(int argc, char* argv[]) {
+    printf("Client start...\n");
+
+    std::string app_name = basename(argv[0]);
+    static struct option long_options[] = {{"server", optional_argument, nullptr, 's'},
+                                           {"port", optional_argument, nullptr, 'p'},
+                                           {"help", no_argument, nullptr, 'h'},
+                                           {"collection_name", optional_argument, nullptr, 't'},
+                                           {"dimension", optional_argument, nullptr, 'd'},
+                                           {"rowcount", optional_argument, nullptr, 'r'},
+                                           {"index", optional_argument, nullptr, 'i'},
+                                           {"nlist", optional_argument, nullptr, 'l'},
+                                           {"rate", optional_argument, nullptr, 'R'},
+                                           {"poisson", no_argument, nullptr, 'P'},
+                                           {"duration", optional_argument, nullptr, 'D'},
+                                           {"warmup", optional_argument, nullptr, 'w'},
+                                           {"concurrency", optional_argument, nullptr, 'c'},
+                                           {"report_interval", optional_argument, nullptr, 'I'},
+                                           {"mix", optional_argument, nullptr, 'x'},
+                                           {"nq", optional_argument, nullptr, 'n'},
+                                           {"topk", optional_argument, nullptr, 'k'},
+                                           {"nprobe", optional_argument, nullptr, 'b'},
+                                           {"insert_rows", optional_argument, nullptr, 'e'},
+                                           {nullptr, 0, nullptr, 0}};
+
+    int option_index = 0;
+    std::string address = "127.0.0.1", port = "19530";
+    app_name = argv[0];
+
+    LoadParameters parameters;
+    int value;
+    while ((value = getopt_long(argc, argv, "s:p:t:d:r:i:l:R:PD:w:c:I:x:n:k:b:e:h", long_options, &option_index)) !=
+           -1) {
+        switch (value) {
+            case 's':
+                address = optarg;
+                break;
+            case 'p':
+                port = optarg;
+                break;
+            case 't':
+                parameters.collection_name_ = optarg;
+                break;
+            case 'd':
+                parameters.dimensions_ = atol(optarg);
+                break;
+            case 'r':
+                parameters.row_count_ = atol(optarg);
+                break;
+            case 'i':
+                parameters.index_type_ = atol(optarg);
+                break;
+            case 'l':
+                parameters.nlist_ = atol(optarg);
+                break;
+            case 'R':
+                parameters.rate_ = atof(optarg);
+                break;
+            case 'P':
+                parameters.poisson_ = true;
+                break;
+            case 'D':
+                parameters.duration_ = atol(optarg);
+                break;
+            case 'w':
+                parameters.warmup_ = atol(optarg);
+                break;
+            case 'c':
+                parameters.concurrency_ = atol(optarg);
+                break;
+            case 'I':
+                parameters.report_interval_ = atol(optarg);
+                break;
+            case 'x': {
+                long search = 0, insert = 0, remove = 0;
+                if (sscanf(optarg, "%ld:%ld:%ld", &search, &insert, &remove) != 3) {
+                    printf("Invalid mix: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                parameters.search_weight_ = search;
+                parameters.insert_weight_ = insert;
+                parameters.delete_weight_ = remove;
+                break;
+            }
+            case 'n':
+                parameters.nq_ = atol(optarg);
+                break;
+            case 'k':
+                parameters.topk_ = atol(optarg);
+                break;
+            case 'b':
+                parameters.nprobe_ = atol(optarg);
+                break;
+            case 'e':
+                parameters.insert_rows_ = atol(optarg);
+                break;
+            case 'h':
+            default:
+                print_help(app_name);
+                return EXIT_SUCCESS;
+        }
+    }
+
+    LoadGenerator generator(address, port);
+    generator.Run(parameters);
+
+    printf("Client exits ...\n");
+    return 0;
+}
+
+void
+print_help(const std::string& app_name) {
+    printf("\n Usage: %s [OPTIONS]\n\n", app_name.c_str());
+    printf("  Options:\n");
+    printf("   -s --server           Server address, default:127.0.0.1\n");
+    printf("   -p --port             Server port, default:19530\n");
+    printf("   -t --collection_name  Target collection name, specify this will ignore collection parameters, "
+           "default empty\n");
+    printf("   -h --help             Print help information\n");
+    printf("   -d --dimension        Dimension of the collection created, default:128\n");
+    printf("   -r --rowcount         Rows inserted into the collection created, default:100000\n");
+    printf("   -i --index            "
+           "Index type of the collection created(1=IDMAP, 2=IVFLAT, 3=IVFSQ8, 5=IVFSQ8H), default:3\n");
+    printf("   -l --nlist            Index nlist of the collection created, default:1024\n");
+    printf("   -R --rate             Operations scheduled per second, 0 for a closed loop, default:100\n");
+    printf("   -P --poisson          Schedule with exponential instead of constant intervals, default:false\n");
+    printf("   -D --duration         Seconds measured, default:60\n");
+    printf("   -w --warmup           Seconds run before measuring, default:5\n");
+    printf("   -c --concurrency      Operations in flight at most, one connection each, default:16\n");
+    printf("   -I --report_interval  Seconds between progress lines, 0 for none, default:5\n");
+    printf("   -x --mix              Weights of search:insert:delete, default:8:1:1\n");
+    printf("   -n --nq               nq of each search, default:1\n");
+    printf("   -k --topk             topk of each search, default:10\n");
+    printf("   -b --nprobe           nprobe of each search, default:16\n");
+    printf("   -e --insert_rows      Entities of each insert and each delete, default:100\n");
+    printf("\n");
+    printf("  Latencies are counted from the scheduled start of every operation, so a server which falls\n");
+    printf("  behind the rate shows in them. Inserts use ids from 2^48 up, deletes remove those only.\n");
+    printf("\n");
+}
@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "examples/load/src/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace milvus_sdk {
+
+namespace {
+constexpr int64_t SUB_BUCKET_BITS = 10;
+constexpr int64_t SUB_BUCKET_HALF_COUNT = 1 << SUB_BUCKET_BITS;  // 1024
+constexpr int64_t SUB_BUCKET_COUNT = SUB_BUCKET_HALF_COUNT * 2;   // 2048
+constexpr int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000 * 1000;  // 1 hour
+
+int
+HighestBit(int64_t value) {
+    return 63 - __builtin_clzll(static_cast<uint64_t>(value));
+}
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : counts_(BucketIndex(HIGHEST_TRACKABLE_VALUE) + 1, 0) {
+}
+
+size_t
+LatencyHistogram::BucketIndex(int64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    int64_t shift = HighestBit(value) - SUB_BUCKET_BITS;
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF_COUNT + ((value >> shift) - SUB_BUCKET_HALF_COUNT);
+}
+
+int64_t
+LatencyHistogram::HighestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<int64_t>(index);
+    }
+    int64_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF_COUNT + 1;
+    int64_t sub_bucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF_COUNT + SUB_BUCKET_HALF_COUNT;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+void
+LatencyHistogram::Record(int64_t value_us) {
+    value_us = std::min(std::max<int64_t>(value_us, 0), HIGHEST_TRACKABLE_VALUE);
+    ++counts_[BucketIndex(value_us)];
+    ++count_;
+    min_ = std::min(min_, value_us);
+    max_ = std::max(max_, value_us);
+    sum_ += value_us;
+}
+
+void
+LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+
+void
+LatencyHistogram::Reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    min_ = INT64_MAX;
+    max_ = 0;
+    sum_ = 0;
+}
+
+int64_t
+LatencyHistogram::Min() const {
+    return count_ == 0 ? 0 : min_;
+}
+
+double
+LatencyHistogram::Mean() const {
+    return count_ == 0 ? 0 : sum_ / count_;
+}
+
+int64_t
+LatencyHistogram::ValueAtPercentile(double percentile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    auto rank = std::max<int64_t>(static_cast<int64_t>(std::ceil(percentile / 100.0 * count_)), 1);
+    int64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return std::min(HighestEquivalentValue(i), max_);
+        }
+    }
+    return max_;
+}
+
+}  // namespace milvus_sdk
@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace milvus_sdk {
+
+/*
+ * A high dynamic range histogram of latencies in microseconds, in the manner of HdrHistogram.
+ * Values below 2048 have buckets of their own, above that every power of two is split into 1024
+ * buckets, so any value up to an hour is kept with 3 significant digits in fixed memory.
+ * Not thread safe, the owner serializes the calls.
+ */
+class LatencyHistogram {
+ public:
+    LatencyHistogram();
+
+    void
+    Record(int64_t value_us);
+
+    void
+    Merge(const LatencyHistogram& other);
+
+    void
+    Reset();
+
+    int64_t
+    Count() const {
+        return count_;
+    }
+
+    int64_t
+    Min() const;
+
+    int64_t
+    Max() const {
+        return max_;
+    }
+
+    double
+    Mean() const;
+
+    // the highest value equivalent to the value at the percentile, 0 <= percentile <= 100
+    int64_t
+    ValueAtPercentile(double percentile) const;
+
+ private:
+    static size_t
+    BucketIndex(int64_t value);
+
+    static int64_t
+    HighestEquivalentValue(size_t index);
+
+ private:
+    std::vector<int64_t> counts_;
+    int64_t count_ = 0;
+    int64_t min_ = INT64_MAX;
+    int64_t max_ = 0;
+    double sum_ = 0;
+};
+
+}  // namespace milvus_sdk
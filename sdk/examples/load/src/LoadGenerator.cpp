@@ -0,0 +1,498 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "examples/utils/TimeRecorder.h"
+#include "examples/utils/Utils.h"
+#include "examples/load/src/LoadGenerator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace {
+constexpr int64_t BATCH_ENTITY_COUNT = 10000;
+constexpr int64_t SEARCH_ENTITY_SETS = 1000;
+constexpr int64_t LOAD_ID_BASE = 1LL << 48;  // ids of the entities inserted by the load, above those of the rows
+
+const char* OPERATION_NAMES[] = {"search", "insert", "delete"};
+
+std::mt19937_64&
+Random() {
+    thread_local std::mt19937_64 engine(std::random_device{}());
+    return engine;
+}
+
+int64_t
+Microseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+double
+Milliseconds(int64_t us) {
+    return us / 1000.0;
+}
+
+}  // namespace
+
+LoadGenerator::LoadGenerator(const std::string& address, const std::string& port)
+    : server_ip_(address), server_port_(port) {
+}
+
+std::shared_ptr<milvus::Connection>
+LoadGenerator::Connect() {
+    milvus::ConnectParam param = {server_ip_, server_port_};
+    auto conn = milvus::Connection::Create();
+    milvus::Status stat = conn->Connect(param);
+    if (!stat.ok()) {
+        std::cout << "Connect function call status: " << stat.message() << std::endl;
+        return nullptr;
+    }
+    return conn;
+}
+
+bool
+LoadGenerator::CheckParameters(const LoadParameters& parameters) {
+    if (parameters.rate_ < 0) {
+        std::cout << "Invalid rate: " << parameters.rate_ << std::endl;
+        return false;
+    }
+
+    if (parameters.duration_ <= 0 || parameters.warmup_ < 0) {
+        std::cout << "Invalid duration: " << parameters.duration_ << ", warmup: " << parameters.warmup_ << std::endl;
+        return false;
+    }
+
+    if (parameters.concurrency_ <= 0) {
+        std::cout << "Invalid concurrency: " << parameters.concurrency_ << std::endl;
+        return false;
+    }
+
+    if (parameters.search_weight_ < 0 || parameters.insert_weight_ < 0 || parameters.delete_weight_ < 0 ||
+        parameters.search_weight_ + parameters.insert_weight_ + parameters.delete_weight_ == 0) {
+        std::cout << "Invalid operation mix" << std::endl;
+        return false;
+    }
+
+    if (parameters.row_count_ <= 0) {
+        std::cout << "Invalid row count: " << parameters.row_count_ << std::endl;
+        return false;
+    }
+
+    if (parameters.nq_ <= 0 || parameters.topk_ <= 0 || parameters.topk_ > 2048 || parameters.nprobe_ <= 0) {
+        std::cout << "Invalid search nq: " << parameters.nq_ << ", topk: " << parameters.topk_
+                  << ", nprobe: " << parameters.nprobe_ << std::endl;
+        return false;
+    }
+
+    if (parameters.insert_rows_ <= 0) {
+        std::cout << "Invalid insert rows: " << parameters.insert_rows_ << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+LoadGenerator::BuildCollection() {
+    auto conn = Connect();
+    if (conn == nullptr) {
+        return false;
+    }
+
+    parameters_.collection_name_ = milvus_sdk::Utils::GenCollectionName();
+    milvus::CollectionParam collection_param = {parameters_.collection_name_, parameters_.dimensions_, 1024,
+                                                milvus::MetricType::L2};
+    std::cout << "Create collection " << collection_param.collection_name << std::endl;
+    auto stat = conn->CreateCollection(collection_param);
+    if (!stat.ok()) {
+        std::cout << "CreateCollection function call status: " << stat.message() << std::endl;
+        milvus::Connection::Destroy(conn);
+        return false;
+    }
+
+    {
+        milvus_sdk::TimeRecorder rc("Insert " + std::to_string(parameters_.row_count_) + " entities");
+        for (int64_t from = 0; from < parameters_.row_count_; from += BATCH_ENTITY_COUNT) {
+            std::vector<milvus::Entity> entity_array;
+            std::vector<int64_t> record_ids;
+            int64_t to = std::min(from + BATCH_ENTITY_COUNT, parameters_.row_count_);
+            milvus_sdk::Utils::BuildEntities(from, to, entity_array, record_ids, parameters_.dimensions_);
+            stat = conn->Insert(parameters_.collection_name_, "", entity_array, record_ids);
+            if (!stat.ok()) {
+                std::cout << "Insert function call status: " << stat.message() << std::endl;
+            }
+        }
+        stat = conn->Flush({parameters_.collection_name_});
+    }
+
+    {
+        milvus_sdk::TimeRecorder rc("Create index " +
+                                    milvus_sdk::Utils::IndexTypeName((milvus::IndexType)parameters_.index_type_));
+        JSON json_params = {{"nlist", parameters_.nlist_}};
+        milvus::IndexParam index = {parameters_.collection_name_, (milvus::IndexType)parameters_.index_type_,
+                                    json_params.dump()};
+        stat = conn->CreateIndex(index);
+        if (!stat.ok()) {
+            std::cout << "CreateIndex function call status: " << stat.message() << std::endl;
+        }
+    }
+
+    milvus::Connection::Destroy(conn);
+    return true;
+}
+
+bool
+LoadGenerator::PrepareCollection() {
+    auto conn = Connect();
+    if (conn == nullptr) {
+        return false;
+    }
+
+    bool ok = false;
+    milvus::CollectionParam collection_param;
+    if (!conn->HasCollection(parameters_.collection_name_)) {
+        std::cout << "Collection not found: " << parameters_.collection_name_ << std::endl;
+    } else if (!conn->GetCollectionInfo(parameters_.collection_name_, collection_param).ok()) {
+        std::cout << "Failed to get collection info: " << parameters_.collection_name_ << std::endl;
+    } else {
+        milvus_sdk::TimeRecorder rc("Load collection " + parameters_.collection_name_);
+        milvus::Status stat = conn->LoadCollection(parameters_.collection_name_);
+        if (!stat.ok()) {
+            std::cout << "LoadCollection function call status: " << stat.message() << std::endl;
+        } else {
+            parameters_.dimensions_ = collection_param.dimension;
+            ok = true;
+        }
+    }
+
+    milvus::Connection::Destroy(conn);
+    return ok;
+}
+
+void
+LoadGenerator::DropCollection() {
+    auto conn = Connect();
+    if (conn == nullptr) {
+        return;
+    }
+
+    milvus::Status stat = conn->DropCollection(parameters_.collection_name_);
+    if (!stat.ok()) {
+        std::cout << "DropCollection function call status: " << stat.message() << std::endl;
+    }
+    milvus::Connection::Destroy(conn);
+}
+
+void
+LoadGenerator::BuildEntities() {
+    // generated up front, the load measures the server rather than the client building requests
+    std::uniform_real_distribution<float> u(0, 1);
+    auto random_entities = [&](int64_t count, std::vector<milvus::Entity>& entities) {
+        entities.resize(count);
+        for (auto& entity : entities) {
+            entity.float_data.resize(parameters_.dimensions_);
+            for (auto& value : entity.float_data) {
+                value = u(Random());
+            }
+        }
+    };
+
+    search_entities_.resize(SEARCH_ENTITY_SETS);
+    for (auto& entities : search_entities_) {
+        random_entities(parameters_.nq_, entities);
+    }
+    random_entities(parameters_.insert_rows_, insert_entities_);
+    next_id_ = LOAD_ID_BASE;
+}
+
+LoadGenerator::OperationType
+LoadGenerator::NextOperationType() {
+    int64_t total = parameters_.search_weight_ + parameters_.insert_weight_ + parameters_.delete_weight_;
+    int64_t pick = std::uniform_int_distribution<int64_t>(0, total - 1)(Random());
+    if (pick < parameters_.search_weight_) {
+        return SEARCH;
+    }
+    return pick < parameters_.search_weight_ + parameters_.insert_weight_ ? INSERT : DELETE;
+}
+
+void
+LoadGenerator::Schedule() {
+    std::exponential_distribution<double> exponential(parameters_.rate_);
+    auto interval = std::chrono::duration<double>(1.0 / parameters_.rate_);
+
+    // the schedule is kept even when the operations queue up, a late operation counts from its scheduled start
+    auto next = start_;
+    for (int64_t i = 0; next < end_; ++i) {
+        std::this_thread::sleep_until(next);
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            queue_.push_back(Operation{NextOperationType(), next, next >= measure_start_});
+            max_backlog_ = std::max(max_backlog_, (int64_t)queue_.size());
+        }
+        queue_cv_.notify_one();
+
+        if (parameters_.poisson_) {
+            next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(exponential(Random())));
+        } else {
+            next = start_ + std::chrono::duration_cast<Clock::duration>(interval * (i + 1));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        scheduled_all_ = true;
+    }
+    queue_cv_.notify_all();
+}
+
+void
+LoadGenerator::Work(bool closed_loop) {
+    auto conn = Connect();
+    if (conn == nullptr) {
+        return;
+    }
+
+    while (true) {
+        Operation operation;
+        if (closed_loop) {
+            auto now = Clock::now();
+            if (now >= end_) {
+                break;
+            }
+            operation = Operation{NextOperationType(), now, now >= measure_start_};
+        } else {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return scheduled_all_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                break;
+            }
+            operation = queue_.front();
+            queue_.pop_front();
+        }
+
+        auto sent = Clock::now();
+        bool skipped = false;
+        bool ok = Execute(*conn, operation.type_, skipped);
+        if (skipped) {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            ++skipped_deletes_;
+            continue;
+        }
+        Record(operation, sent, ok);
+    }
+
+    milvus::Connection::Destroy(conn);
+}
+
+bool
+LoadGenerator::Execute(milvus::Connection& conn, OperationType type, bool& skipped) {
+    milvus::Status stat;
+    switch (type) {
+        case SEARCH: {
+            JSON json_params = {{"nprobe", parameters_.nprobe_}};
+            auto& entities = search_entities_[std::uniform_int_distribution<size_t>(0, SEARCH_ENTITY_SETS - 1)(
+                Random())];
+            milvus::TopKQueryResult result;
+            stat = conn.Search(parameters_.collection_name_, {}, entities, parameters_.topk_, json_params.dump(),
+                               result);
+            break;
+        }
+        case INSERT: {
+            std::vector<int64_t> ids(parameters_.insert_rows_);
+            {
+                std::lock_guard<std::mutex> lock(ids_mutex_);
+                for (auto& id : ids) {
+                    id = next_id_++;
+                }
+            }
+            stat = conn.Insert(parameters_.collection_name_, "", insert_entities_, ids);
+            if (stat.ok()) {
+                std::lock_guard<std::mutex> lock(ids_mutex_);
+                inserted_ids_.insert(inserted_ids_.end(), ids.begin(), ids.end());
+            }
+            break;
+        }
+        case DELETE: {
+            // as many as an insert adds, equal insert and delete weights keep the collection size steady
+            std::vector<int64_t> ids;
+            {
+                std::lock_guard<std::mutex> lock(ids_mutex_);
+                auto count = std::min<size_t>(parameters_.insert_rows_, inserted_ids_.size());
+                ids.assign(inserted_ids_.end() - count, inserted_ids_.end());
+                inserted_ids_.resize(inserted_ids_.size() - count);
+            }
+            if (ids.empty()) {
+                skipped = true;
+                return true;
+            }
+            stat = conn.DeleteEntityByID(parameters_.collection_name_, ids);
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (!stat.ok()) {
+        std::cout << OPERATION_NAMES[type] << " function call status: " << stat.message() << std::endl;
+    }
+    return stat.ok();
+}
+
+void
+LoadGenerator::Record(const Operation& operation, Clock::time_point sent, bool ok) {
+    if (!operation.measured_) {
+        return;
+    }
+    auto done = Clock::now();
+    auto latency = Microseconds(done - operation.scheduled_);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto& stats = stats_[operation.type_];
+    stats.latency_.Record(latency);
+    stats.service_.Record(Microseconds(done - sent));
+    if (!ok) {
+        ++stats.errors_;
+    }
+    interval_latency_.Record(latency);
+}
+
+void
+LoadGenerator::ReportProgress() {
+    int64_t backlog = 0;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        backlog = queue_.size();
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - start_).count();
+    std::cout << std::fixed << std::setprecision(3) << "[" << elapsed << "s] " << interval_latency_.Count()
+              << " ops, latency p50 " << Milliseconds(interval_latency_.ValueAtPercentile(50)) << " ms, p99 "
+              << Milliseconds(interval_latency_.ValueAtPercentile(99)) << " ms, max "
+              << Milliseconds(interval_latency_.Max()) << " ms, backlog " << backlog << std::endl;
+    interval_latency_.Reset();
+}
+
+void
+LoadGenerator::ReportResult() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    JSON load_stats = JSON();
+    load_stats["collection_name"] = parameters_.collection_name_;
+    load_stats["dimension"] = parameters_.dimensions_;
+    load_stats["mode"] = parameters_.rate_ > 0 ? (parameters_.poisson_ ? "open_poisson" : "open") : "closed";
+    load_stats["rate"] = parameters_.rate_;
+    load_stats["duration"] = parameters_.duration_;
+    load_stats["concurrency"] = parameters_.concurrency_;
+    load_stats["nq"] = parameters_.nq_;
+    load_stats["topk"] = parameters_.topk_;
+    load_stats["nprobe"] = parameters_.nprobe_;
+    load_stats["insert_rows"] = parameters_.insert_rows_;
+    load_stats["max_backlog"] = max_backlog_;
+    load_stats["skipped_deletes"] = skipped_deletes_;
+
+    std::cout << "Latency (ms) counted from the scheduled start, service time from the send:" << std::endl;
+    std::cout << std::setw(8) << "op" << std::setw(10) << "count" << std::setw(8) << "errors" << std::setw(10)
+              << "ops/s" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::setw(12) << "svc p50" << std::setw(12)
+              << "svc p99" << std::endl;
+    for (int type = 0; type < OPERATION_TYPE_COUNT; ++type) {
+        auto& stats = stats_[type];
+        if (stats.latency_.Count() == 0) {
+            continue;
+        }
+        double throughput = (double)stats.latency_.Count() / parameters_.duration_;
+        std::cout << std::fixed << std::setprecision(3) << std::setw(8) << OPERATION_NAMES[type] << std::setw(10)
+                  << stats.latency_.Count() << std::setw(8) << stats.errors_ << std::setw(10) << std::setprecision(1)
+                  << throughput << std::setprecision(3) << std::setw(10)
+                  << Milliseconds(stats.latency_.ValueAtPercentile(50)) << std::setw(10)
+                  << Milliseconds(stats.latency_.ValueAtPercentile(90)) << std::setw(10)
+                  << Milliseconds(stats.latency_.ValueAtPercentile(99)) << std::setw(10)
+                  << Milliseconds(stats.latency_.ValueAtPercentile(99.9)) << std::setw(10)
+                  << Milliseconds(stats.latency_.Max()) << std::setw(12)
+                  << Milliseconds(stats.service_.ValueAtPercentile(50)) << std::setw(12)
+                  << Milliseconds(stats.service_.ValueAtPercentile(99)) << std::endl;
+
+        JSON op_stats;
+        op_stats["count"] = stats.latency_.Count();
+        op_stats["errors"] = stats.errors_;
+        op_stats["ops"] = throughput;
+        op_stats["latency_mean_ms"] = Milliseconds(stats.latency_.Mean());
+        op_stats["latency_p50_ms"] = Milliseconds(stats.latency_.ValueAtPercentile(50));
+        op_stats["latency_p90_ms"] = Milliseconds(stats.latency_.ValueAtPercentile(90));
+        op_stats["latency_p99_ms"] = Milliseconds(stats.latency_.ValueAtPercentile(99));
+        op_stats["latency_p999_ms"] = Milliseconds(stats.latency_.ValueAtPercentile(99.9));
+        op_stats["latency_max_ms"] = Milliseconds(stats.latency_.Max());
+        op_stats["service_p50_ms"] = Milliseconds(stats.service_.ValueAtPercentile(50));
+        op_stats["service_p99_ms"] = Milliseconds(stats.service_.ValueAtPercentile(99));
+        load_stats[OPERATION_NAMES[type]] = op_stats;
+    }
+    std::cout << load_stats.dump() << std::endl;
+}
+
+void
+LoadGenerator::Run(const LoadParameters& parameters) {
+    if (!CheckParameters(parameters)) {
+        return;
+    }
+
+    parameters_ = parameters;
+    bool created = false;
+    if (parameters_.collection_name_.empty()) {
+        if (!BuildCollection()) {
+            return;
+        }
+        created = true;
+    }
+
+    if (PrepareCollection()) {
+        BuildEntities();
+
+        bool closed_loop = parameters_.rate_ <= 0;
+        start_ = Clock::now();
+        measure_start_ = start_ + std::chrono::seconds(parameters_.warmup_);
+        end_ = measure_start_ + std::chrono::seconds(parameters_.duration_);
+
+        std::vector<std::thread> workers;
+        for (int64_t i = 0; i < parameters_.concurrency_; ++i) {
+            workers.emplace_back(&LoadGenerator::Work, this, closed_loop);
+        }
+        std::thread scheduler;
+        if (!closed_loop) {
+            scheduler = std::thread(&LoadGenerator::Schedule, this);
+        }
+
+        while (Clock::now() < end_) {
+            auto next = end_;
+            if (parameters_.report_interval_ > 0) {
+                next = std::min(next, Clock::now() + std::chrono::seconds(parameters_.report_interval_));
+            }
+            std::this_thread::sleep_until(next);
+            ReportProgress();
+        }
+
+        // the operations still queued were scheduled within the run, they are waited for and counted
+        if (scheduler.joinable()) {
+            scheduler.join();
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        ReportResult();
+    }
+
+    if (created) {
+        DropCollection();
+    }
+}
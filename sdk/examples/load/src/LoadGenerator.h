@@ -0,0 +1,153 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "include/MilvusApi.h"
+#include "examples/load/src/LatencyHistogram.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct LoadParameters {
+    // specify this will ignore dimension/row_count/index_type/nlist
+    std::string collection_name_;
+
+    // collection parameters, only works when collection_name_ is empty
+    int64_t dimensions_ = 128;
+    int64_t row_count_ = 100000;
+    int64_t index_type_ = (int64_t)milvus::IndexType::IVFSQ8;
+    int64_t nlist_ = 1024;
+
+    // load parameters
+    double rate_ = 100;            // operations issued per second, 0 runs closed loop
+    bool poisson_ = false;         // exponential instead of constant intervals between operations
+    int64_t duration_ = 60;        // seconds measured
+    int64_t warmup_ = 5;           // seconds run before measuring
+    int64_t concurrency_ = 16;     // operations in flight at most, each on a connection of its own
+    int64_t report_interval_ = 5;  // seconds between progress lines, 0 disables them
+    int64_t search_weight_ = 8;
+    int64_t insert_weight_ = 1;
+    int64_t delete_weight_ = 1;
+
+    // operation parameters
+    int64_t nq_ = 1;
+    int64_t topk_ = 10;
+    int64_t nprobe_ = 16;
+    int64_t insert_rows_ = 100;
+};
+
+/*
+ * Drives a mixed insert/search/delete workload against a running server.
+ *
+ * In open loop (rate > 0) operations are scheduled at the given rate whether or not the server keeps up, and the
+ * latency of an operation is counted from its scheduled start rather than from when a worker got to send it.
+ * A stalled server therefore shows in the latency of every operation scheduled during the stall instead of
+ * holding the load generator back, which corrects the coordinated omission of a closed loop benchmark.
+ * The service time, from send to reply, is reported next to it. In closed loop (rate = 0) every worker issues
+ * its next operation when the previous one returns, latency and service time are then the same.
+ */
+class LoadGenerator {
+ public:
+    LoadGenerator(const std::string& address, const std::string& port);
+
+    void
+    Run(const LoadParameters& parameters);
+
+ private:
+    enum OperationType { SEARCH = 0, INSERT, DELETE, OPERATION_TYPE_COUNT };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Operation {
+        OperationType type_;
+        Clock::time_point scheduled_;
+        bool measured_;  // false for the operations of the warmup
+    };
+
+    struct Stats {
+        milvus_sdk::LatencyHistogram latency_;  // from the scheduled start
+        milvus_sdk::LatencyHistogram service_;  // from the send
+        int64_t errors_ = 0;
+    };
+
+    std::shared_ptr<milvus::Connection>
+    Connect();
+
+    bool
+    CheckParameters(const LoadParameters& parameters);
+
+    bool
+    BuildCollection();
+
+    bool
+    PrepareCollection();
+
+    void
+    DropCollection();
+
+    void
+    BuildEntities();
+
+    OperationType
+    NextOperationType();
+
+    void
+    Schedule();
+
+    void
+    Work(bool closed_loop);
+
+    // false when the operation failed, skipped is set for a delete with nothing left to delete
+    bool
+    Execute(milvus::Connection& conn, OperationType type, bool& skipped);
+
+    void
+    Record(const Operation& operation, Clock::time_point sent, bool ok);
+
+    void
+    ReportProgress();
+
+    void
+    ReportResult();
+
+ private:
+    std::string server_ip_;
+    std::string server_port_;
+    LoadParameters parameters_;
+
+    std::vector<std::vector<milvus::Entity>> search_entities_;
+    std::vector<milvus::Entity> insert_entities_;
+
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<Operation> queue_;
+    bool scheduled_all_ = false;
+    int64_t max_backlog_ = 0;  // operations waiting for a worker at most
+
+    std::mutex ids_mutex_;
+    int64_t next_id_ = 0;
+    std::vector<int64_t> inserted_ids_;  // deletes remove entities inserted by the load only
+
+    std::mutex stats_mutex_;
+    Stats stats_[OPERATION_TYPE_COUNT];
+    milvus_sdk::LatencyHistogram interval_latency_;  // all operations since the last progress line
+    int64_t skipped_deletes_ = 0;
+
+    Clock::time_point start_;
+    Clock::time_point measure_start_;
+    Clock::time_point end_;
+};
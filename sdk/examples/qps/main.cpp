@@ -35,6 +35,7 @@ main(int argc, char* argv[]) {
                                            {"dimension", optional_argument, nullptr, 'd'},
                                            {"rowcount", optional_argument, nullptr, 'r'},
                                            {"concurrency", optional_argument, nullptr, 'c'},
+                                           {"channels", optional_argument, nullptr, 'C'},
                                            {"query_count", optional_argument, nullptr, 'q'},
                                            {"nq", optional_argument, nullptr, 'n'},
                                            {"topk", optional_argument, nullptr, 'k'},
@@ -48,7 +49,7 @@ main(int argc, char* argv[]) {
 
     TestParameters parameters;
     int value;
-    while ((value = getopt_long(argc, argv, "s:p:t:i:f:l:m:d:r:c:q:n:k:b:vh", long_options, &option_index)) != -1) {
+    while ((value = getopt_long(argc, argv, "s:p:t:i:f:l:m:d:r:c:C:q:n:k:b:vh", long_options, &option_index)) != -1) {
         switch (value) {
             case 's': {
                 char* address_ptr = strdup(optarg);
@@ -110,6 +111,12 @@ main(int argc, char* argv[]) {
                 free(ptr);
                 break;
             }
+            case 'C': {
+                char* ptr = strdup(optarg);
+                parameters.channel_count_ = atol(ptr);
+                free(ptr);
+                break;
+            }
             case 'q': {
                 char* ptr = strdup(optarg);
                 parameters.query_count_ = atol(ptr);
@@ -170,7 +177,8 @@ print_help(const std::string& app_name) {
            "default:1\n");
     printf("   -d --dimension        Collection dimension, default:128\n");
     printf("   -r --rowcount         Collection total row count(unit:million), default:1\n");
-    printf("   -c --concurrency      Max client connections, default:20\n");
+    printf("   -c --concurrency      Max searches in flight, default:20\n");
+    printf("   -C --channels         Connections the searches are spread over, default:4\n");
     printf("   -q --query_count      Query total count, default:1000\n");
     printf("   -n --nq               nq of each query, default:1\n");
     printf("   -k --topk             topk of each query, default:10\n");
@@ -11,7 +11,6 @@
 
 #include "examples/utils/TimeRecorder.h"
 #include "examples/utils/Utils.h"
-#include "examples/utils/ThreadPool.h"
 #include "examples/qps/src/ClientTest.h"
 
 #include <iostream>
@@ -69,6 +68,7 @@ std::shared_ptr<milvus::Connection>
 ClientTest::Connect() {
     std::shared_ptr<milvus::Connection> conn;
     milvus::ConnectParam param = {server_ip_, server_port_};
+    param.channel_count = parameters_.channel_count_;
     conn = milvus::Connection::Create();
     milvus::Status stat = conn->Connect(param);
     if (!stat.ok()) {
@@ -99,6 +99,11 @@ ClientTest::CheckParameters(const TestParameters& parameters) {
         return false;
     }
 
+    if (parameters.channel_count_ <= 0) {
+        std::cout << "Invalid channel count: " << parameters.channel_count_ << std::endl;
+        return false;
+    }
+
     if (parameters.query_count_ <= 0) {
         std::cout << "Invalid query count: " << parameters.query_count_ << std::endl;
         return false;
@@ -301,34 +306,44 @@ ClientTest::Search() {
     std::vector<EntityList> search_entities;
     BuildSearchEntities(search_entities);
 
-    std::list<std::future<milvus::TopKQueryResult>> query_thread_results;
-    milvus_sdk::ThreadPool query_thread_pool(parameters_.concurrency_, parameters_.concurrency_ * 2);
+    std::shared_ptr<milvus::Connection> conn = Connect();
+    ConnectionWrapper wrapper(conn);
+    std::vector<milvus::TopKQueryResult> query_results(parameters_.query_count_);
 
     auto start = std::chrono::system_clock::now();
     {
         std::string title = "Searching " + parameters_.collection_name_;
         milvus_sdk::TimeRecorder rc(title);
 
-        // multi-threads query
-        for (int32_t i = 0; i < parameters_.query_count_; i++) {
-            query_thread_results.push_back(query_thread_pool.enqueue(&ClientTest::SearchWorker,
-                                                                     this,
-                                                                     search_entities[i]));
+        // one connection keeps up to concurrency searches in flight over its channels
+        JSON json_params = {{"nprobe", parameters_.nprobe_}};
+        std::vector<std::string> partition_tags;
+        std::list<std::future<milvus::Status>> in_flight;
+        auto wait_oldest = [&]() {
+            milvus::Status stat = in_flight.front().get();
+            in_flight.pop_front();
+            if (!stat.ok()) {
+                std::cout << "Search function call status: " << stat.message() << std::endl;
+            }
+        };
+        for (int64_t i = 0; i < parameters_.query_count_; i++) {
+            if ((int64_t)in_flight.size() >= parameters_.concurrency_) {
+                wait_oldest();
+            }
+            in_flight.push_back(conn->SearchAsync(parameters_.collection_name_, partition_tags, search_entities[i],
+                                                  parameters_.topk_, json_params.dump(), query_results[i]));
         }
 
         // wait all query return
-        for (auto& iter : query_thread_results) {
-            iter.wait();
+        while (!in_flight.empty()) {
+            wait_oldest();
         }
     }
 
     // print result
-    int64_t index = 0;
-    for (auto& iter : query_thread_results) {
-        milvus::TopKQueryResult result = iter.get();
-        CheckSearchResult(index, result);
-        PrintSearchResult(index, result);
-        index++;
+    for (int64_t index = 0; index < parameters_.query_count_; index++) {
+        CheckSearchResult(index, query_results[index]);
+        PrintSearchResult(index, query_results[index]);
     }
 
     // calculate qps
@@ -350,6 +365,7 @@ ClientTest::Search() {
     search_stats["dimension"] = parameters_.dimensions_;
     search_stats["row_count"] = parameters_.row_count_;
     search_stats["concurrency"] = parameters_.concurrency_;
+    search_stats["channels"] = parameters_.channel_count_;
     search_stats["query_count"] = parameters_.query_count_;
     search_stats["nq"] = parameters_.nq_;
     search_stats["topk"] = parameters_.topk_;
@@ -359,40 +375,6 @@ ClientTest::Search() {
     std::cout << search_stats.dump() << std::endl;
 }
 
-milvus::TopKQueryResult
-ClientTest::SearchWorker(EntityList& entities) {
-    milvus::TopKQueryResult res;
-
-    std::shared_ptr<milvus::Connection> conn;
-    milvus::ConnectParam param = {server_ip_, server_port_};
-    conn = milvus::Connection::Create();
-    milvus::Status stat = conn->Connect(param);
-    if (!stat.ok()) {
-        milvus::Connection::Destroy(conn);
-        std::string msg = "Connect function call status: " + stat.message();
-        std::cout << msg << std::endl;
-        return res;
-    }
-
-    JSON json_params = {{"nprobe", parameters_.nprobe_}};
-    std::vector<std::string> partition_tags;
-    stat = conn->Search(parameters_.collection_name_,
-                        partition_tags,
-                        entities,
-                        parameters_.topk_,
-                        json_params.dump(),
-                        res);
-    if (!stat.ok()) {
-        milvus::Connection::Destroy(conn);
-        std::string msg = "Search function call status: " + stat.message();
-        std::cout << msg << std::endl;
-        return res;
-    }
-
-    milvus::Connection::Destroy(conn);
-    return res;
-}
-
 void
 ClientTest::PrintSearchResult(int64_t batch_num, const milvus::TopKQueryResult& result) {
     if (!parameters_.print_result_) {
@@ -32,7 +32,8 @@ struct TestParameters {
     int64_t row_count_ = 1; // 1 million
 
     // query parameters
-    int64_t concurrency_ = 20; // 20 connections
+    int64_t concurrency_ = 20; // 20 searches in flight
+    int64_t channel_count_ = 4; // 4 HTTP/2 connections
     int64_t query_count_ = 1000;
     int64_t nq_ = 1;
     int64_t topk_ = 10;
@@ -80,9 +81,6 @@ class ClientTest {
     void
     Search();
 
-    milvus::TopKQueryResult
-    SearchWorker(EntityList& entities);
-
     void
     PrintSearchResult(int64_t batch_num, const milvus::TopKQueryResult& result);
 
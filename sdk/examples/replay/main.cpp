@@ -0,0 +1,111 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <getopt.h>
+#include <libgen.h>
+#include <cstring>
+#include <string>
+
+#include "src/ReplayClient.h"
+
+void
+print_help(const std::string& app_name);
+
+int
+main(int argc, char* argv[]) {
+    printf("Client start...\n");
+
+    std::string app_name = basename(argv[0]);
+    static struct option long_options[] = {{"server", optional_argument, nullptr, 's'},
+                                           {"port", optional_argument, nullptr, 'p'},
+                                           {"help", no_argument, nullptr, 'h'},
+                                           {"file", required_argument, nullptr, 'f'},
+                                           {"speed", optional_argument, nullptr, 'x'},
+                                           {"concurrency", optional_argument, nullptr, 'c'},
+                                           {"method", optional_argument, nullptr, 'm'},
+                                           {nullptr, 0, nullptr, 0}};
+
+    int option_index = 0;
+    std::string address = "127.0.0.1", port = "19530";
+    app_name = argv[0];
+
+    ReplayParameters parameters;
+    int value;
+    while ((value = getopt_long(argc, argv, "s:p:f:x:c:m:h", long_options, &option_index)) != -1) {
+        switch (value) {
+            case 's': {
+                char* address_ptr = strdup(optarg);
+                address = address_ptr;
+                free(address_ptr);
+                break;
+            }
+            case 'p': {
+                char* port_ptr = strdup(optarg);
+                port = port_ptr;
+                free(port_ptr);
+                break;
+            }
+            case 'f': {
+                char* ptr = strdup(optarg);
+                parameters.capture_file_ = ptr;
+                free(ptr);
+                break;
+            }
+            case 'x': {
+                char* ptr = strdup(optarg);
+                parameters.speed_ = atof(ptr);
+                free(ptr);
+                break;
+            }
+            case 'c': {
+                char* ptr = strdup(optarg);
+                parameters.concurrency_ = atol(ptr);
+                free(ptr);
+                break;
+            }
+            case 'm': {
+                char* ptr = strdup(optarg);
+                parameters.method_filter_ = ptr;
+                free(ptr);
+                break;
+            }
+            case 'h':
+            default:
+                print_help(app_name);
+                return EXIT_SUCCESS;
+        }
+    }
+
+    if (parameters.capture_file_.empty()) {
+        print_help(app_name);
+        return EXIT_FAILURE;
+    }
+
+    ReplayClient client(address, port);
+    bool ok = client.Replay(parameters);
+
+    printf("Client exits ...\n");
+    return ok ? 0 : EXIT_FAILURE;
+}
+
+void
+print_help(const std::string& app_name) {
+    printf("\n Usage: %s [OPTIONS]\n\n", app_name.c_str());
+    printf("  Options:\n");
+    printf("   -s --server           Server address, default:127.0.0.1\n");
+    printf("   -p --port             Server port, default:19530\n");
+    printf("   -f --file             Capture file written by a server with network.grpc.capture_path set\n");
+    printf("   -x --speed            Replay speed relative to the capture, 0 sends as fast as possible, default:1\n");
+    printf("   -c --concurrency      Max requests in flight, default:16\n");
+    printf("   -m --method           Replay only the methods containing this, e.g. Search, default empty\n");
+    printf("   -h --help             Print help information\n");
+    printf("\n");
+}
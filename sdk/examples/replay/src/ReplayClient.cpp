@@ -0,0 +1,200 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "examples/replay/src/ReplayClient.h"
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "examples/utils/ThreadPool.h"
+
+namespace {
+
+// the magic of the capture log, see TrafficCapture of the server
+constexpr const char* CAPTURE_MAGIC = "MVSCAP01";
+
+// tasks queued to the pool at most, the dispatch waits beyond
+constexpr size_t MAX_QUEUED_REQUESTS = 10000;
+
+template <typename T>
+bool
+ReadValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+uint64_t
+Percentile(std::vector<uint64_t>& values, double percentile) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t idx = std::min(values.size() - 1, static_cast<size_t>(percentile * values.size()));
+    std::nth_element(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
+
+double
+Delta(uint64_t replayed, uint64_t captured) {
+    return captured > 0 ? 100.0 * (static_cast<double>(replayed) - captured) / captured : 0.0;
+}
+
+}  // namespace
+
+ReplayClient::ReplayClient(const std::string& address, const std::string& port) {
+    channel_ = ::grpc::CreateChannel(address + ":" + port, ::grpc::InsecureChannelCredentials());
+    stub_ = std::make_unique<::grpc::GenericStub>(channel_);
+}
+
+bool
+ReplayClient::LoadCapture(const std::string& path, std::vector<CapturedRequest>& requests) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Cannot open capture file " << path << std::endl;
+        return false;
+    }
+
+    char magic[8];
+    if (!file.read(magic, sizeof(magic)) || memcmp(magic, CAPTURE_MAGIC, sizeof(magic)) != 0) {
+        std::cout << path << " is not a capture file" << std::endl;
+        return false;
+    }
+
+    // a record cut by a server stopped while capturing ends the log
+    requests.clear();
+    while (true) {
+        CapturedRequest request;
+        uint16_t method_length = 0;
+        uint32_t payload_length = 0;
+        if (!ReadValue(file, request.arrival_us_) || !ReadValue(file, request.latency_us_) ||
+            !ReadValue(file, method_length)) {
+            break;
+        }
+        request.method_.resize(method_length);
+        if (!file.read(&request.method_[0], method_length) || !ReadValue(file, payload_length)) {
+            break;
+        }
+        request.payload_.resize(payload_length);
+        if (payload_length > 0 && !file.read(&request.payload_[0], payload_length)) {
+            break;
+        }
+        requests.emplace_back(std::move(request));
+    }
+
+    // recorded in the order of the responses
+    std::stable_sort(requests.begin(), requests.end(), [](const CapturedRequest& a, const CapturedRequest& b) {
+        return a.arrival_us_ < b.arrival_us_;
+    });
+    return true;
+}
+
+bool
+ReplayClient::Replay(const ReplayParameters& parameters) {
+    std::vector<CapturedRequest> requests;
+    if (!LoadCapture(parameters.capture_file_, requests)) {
+        return false;
+    }
+    if (!parameters.method_filter_.empty()) {
+        auto removed = std::remove_if(requests.begin(), requests.end(), [&](const CapturedRequest& request) {
+            return request.method_.find(parameters.method_filter_) == std::string::npos;
+        });
+        requests.erase(removed, requests.end());
+    }
+    if (requests.empty()) {
+        std::cout << "No request to replay" << std::endl;
+        return true;
+    }
+    std::cout << "Replay " << requests.size() << " requests at speed " << parameters.speed_ << std::endl;
+
+    stats_.clear();
+    std::vector<uint64_t> lags_us;
+    lags_us.reserve(requests.size());
+    auto start = std::chrono::steady_clock::now();
+    uint64_t first_arrival = requests.front().arrival_us_;
+    {
+        milvus_sdk::ThreadPool pool(std::max<int64_t>(parameters.concurrency_, 1), MAX_QUEUED_REQUESTS);
+        for (auto& request : requests) {
+            if (parameters.speed_ > 0) {
+                auto offset = std::chrono::microseconds(
+                    static_cast<int64_t>((request.arrival_us_ - first_arrival) / parameters.speed_));
+                std::this_thread::sleep_until(start + offset);
+                // the pool falls behind the captured pace when all its threads are busy
+                auto lag = std::chrono::steady_clock::now() - (start + offset);
+                lags_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(lag).count());
+            }
+            pool.enqueue(&ReplayClient::Send, this, std::cref(request));
+        }
+    }
+    auto total = std::chrono::steady_clock::now() - start;
+
+    Report(std::chrono::duration_cast<std::chrono::microseconds>(total).count(), lags_us);
+    return true;
+}
+
+void
+ReplayClient::Send(const CapturedRequest& request) {
+    ::grpc::Slice slice(request.payload_);
+    ::grpc::ByteBuffer request_buffer(&slice, 1);
+    ::grpc::ByteBuffer response_buffer;
+    ::grpc::ClientContext context;
+    ::grpc::CompletionQueue cq;
+    ::grpc::Status status;
+
+    auto begin = std::chrono::steady_clock::now();
+    auto call = stub_->PrepareUnaryCall(&context, request.method_, request_buffer, &cq);
+    call->StartCall();
+    call->Finish(&response_buffer, &status, reinterpret_cast<void*>(1));
+    void* tag = nullptr;
+    bool ok = false;
+    cq.Next(&tag, &ok);
+    auto latency = std::chrono::steady_clock::now() - begin;
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto& stats = stats_[request.method_];
+    stats.captured_us_.push_back(request.latency_us_);
+    stats.replayed_us_.push_back(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    if (!ok || !status.ok()) {
+        stats.errors_++;
+    }
+}
+
+void
+ReplayClient::Report(uint64_t total_us, const std::vector<uint64_t>& lags_us) {
+    std::cout << "Replay done in " << total_us / 1000 << " ms" << std::endl;
+    std::vector<uint64_t> lags = lags_us;
+    if (!lags.empty()) {
+        std::cout << "Dispatch lag behind the captured pace: p50 " << Percentile(lags, 0.5) / 1000.0 << " ms, p99 "
+                  << Percentile(lags, 0.99) / 1000.0 << " ms" << std::endl;
+    }
+
+    // the captured latency is taken in the server, the replayed one in the client and includes the network
+    std::cout << "method, count, errors, captured p50/p99 ms, replayed p50/p99 ms, delta p50/p99 %" << std::endl;
+    for (auto& pair : stats_) {
+        auto& stats = pair.second;
+        uint64_t captured_p50 = Percentile(stats.captured_us_, 0.5);
+        uint64_t captured_p99 = Percentile(stats.captured_us_, 0.99);
+        uint64_t replayed_p50 = Percentile(stats.replayed_us_, 0.5);
+        uint64_t replayed_p99 = Percentile(stats.replayed_us_, 0.99);
+        std::cout << pair.first << ", " << stats.replayed_us_.size() << ", " << stats.errors_ << ", "
+                  << captured_p50 / 1000.0 << "/" << captured_p99 / 1000.0 << ", " << replayed_p50 / 1000.0 << "/"
+                  << replayed_p99 / 1000.0 << ", " << Delta(replayed_p50, captured_p50) << "/"
+                  << Delta(replayed_p99, captured_p99) << std::endl;
+    }
+}
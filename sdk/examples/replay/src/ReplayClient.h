@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <grpcpp/channel.h>
+#include <grpcpp/generic/generic_stub.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ReplayParameters {
+    std::string capture_file_;
+    double speed_ = 1.0;         // 2 replays twice as fast as captured, 0 sends the requests as fast as possible
+    int64_t concurrency_ = 16;   // max requests in flight
+    std::string method_filter_;  // only the methods containing it, as "Search"
+};
+
+// a request of the capture log written by the server with network.grpc.capture_path set
+struct CapturedRequest {
+    uint64_t arrival_us_ = 0;
+    uint64_t latency_us_ = 0;
+    std::string method_;
+    std::string payload_;
+};
+
+/*
+ * Replays the requests captured by a server against another one at their captured pace, scaled by the speed, and
+ * reports the latency of each method against the captured one. The requests are sent as they were captured, by
+ * their full method name, so any method of the service replays.
+ */
+class ReplayClient {
+ public:
+    ReplayClient(const std::string& address, const std::string& port);
+
+    // false if the capture can't be read
+    bool
+    Replay(const ReplayParameters& parameters);
+
+    static bool
+    LoadCapture(const std::string& path, std::vector<CapturedRequest>& requests);
+
+ private:
+    struct MethodStats {
+        std::vector<uint64_t> captured_us_;
+        std::vector<uint64_t> replayed_us_;
+        int64_t errors_ = 0;
+    };
+
+    void
+    Send(const CapturedRequest& request);
+
+    void
+    Report(uint64_t total_us, const std::vector<uint64_t>& lags_us);
+
+ private:
+    std::shared_ptr<::grpc::Channel> channel_;
+    std::unique_ptr<::grpc::GenericStub> stub_;
+
+    std::mutex stats_mutex_;
+    std::map<std::string, MethodStats> stats_;
+};
@@ -119,6 +119,12 @@ Utils::IndexTypeName(const milvus::IndexType& index_type) {
             return "ANNOY";
         case milvus::IndexType::IVFSQ8NR:
             return "IVFSQ8NR";
+        case milvus::IndexType::IVFPQ_FASTSCAN:
+            return "IVFPQ_FASTSCAN";
+        case milvus::IndexType::DISKANN:
+            return "DISKANN";
+        case milvus::IndexType::BIN_HASH:
+            return "BIN_HASH";
         default:
             return "Unknown index type";
     }
@@ -11,6 +11,7 @@
 
 #include "grpc/ClientProxy.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,6 +23,9 @@
 namespace milvus {
 
 static const char* EXTRA_PARAM_KEY = "params";
+static const char* PACKED_FLOAT_ROWS_KEY = "packed_float_rows";
+static const char* RESULT_ENCODING_KEY = "result_encoding";
+static const char* CHANNEL_INDEX_ARG = "milvus.sdk.channel_index";
 
 bool
 UriCheck(const std::string& uri) {
@@ -32,12 +36,18 @@ UriCheck(const std::string& uri) {
 template <typename T>
 void
 ConstructSearchParam(const std::string& collection_name, const std::vector<std::string>& partition_tag_array,
-                     int64_t topk, const std::string& extra_params, T& search_param) {
+                     int64_t topk, const std::string& extra_params, const std::string& result_encoding,
+                     T& search_param) {
     search_param.set_collection_name(collection_name);
     search_param.set_topk(topk);
     milvus::grpc::KeyValuePair* kv = search_param.add_extra_params();
     kv->set_key(EXTRA_PARAM_KEY);
     kv->set_value(extra_params);
+    if (!result_encoding.empty()) {
+        kv = search_param.add_extra_params();
+        kv->set_key(RESULT_ENCODING_KEY);
+        kv->set_value(result_encoding);
+    }
 
     for (auto& tag : partition_tag_array) {
         search_param.add_partition_tag_array(tag);
@@ -57,17 +67,103 @@ CopyRowRecord(::milvus::grpc::RowRecord* target, const Entity& src) {
     }
 }
 
+// float vectors of one dimension go back to back in the binary data of a single record, the server parses one bytes
+// field instead of a message per vector
+template <typename T>
+void
+CopyRowRecords(const std::vector<Entity>& entity_array, int64_t begin, int64_t end,
+               google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecord>* records, T& param) {
+    size_t dim = begin < end ? entity_array[begin].float_data.size() : 0;
+    bool packable = dim > 0;
+    for (int64_t i = begin; packable && i < end; ++i) {
+        packable = entity_array[i].float_data.size() == dim && entity_array[i].binary_data.empty();
+    }
+    if (!packable) {
+        for (int64_t i = begin; i < end; ++i) {
+            CopyRowRecord(records->Add(), entity_array[i]);
+        }
+        return;
+    }
+
+    std::string* packed = records->Add()->mutable_binary_data();
+    packed->resize((end - begin) * dim * sizeof(float));
+    for (int64_t i = begin; i < end; ++i) {
+        memcpy(&(*packed)[(i - begin) * dim * sizeof(float)], entity_array[i].float_data.data(), dim * sizeof(float));
+    }
+    milvus::grpc::KeyValuePair* kv = param.add_extra_params();
+    kv->set_key(PACKED_FLOAT_ROWS_KEY);
+    kv->set_value(std::to_string(end - begin));
+}
+
+float
+DecodeFp16(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        // subnormal, normalized in the wider exponent
+        exponent = 113;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    } else {
+        bits = sign;
+    }
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// undoes the result encoding asked by ClientProxy::Connect(), see EncodeResults() of the server
 void
-ConstructTopkResult(const ::milvus::grpc::TopKQueryResult& grpc_result, TopKQueryResult& topk_query_result) {
+ConstructTopkResult(const ::milvus::grpc::TopKQueryResult& grpc_result, DistanceEncoding distance_encoding,
+                    bool delta_ids, TopKQueryResult& topk_query_result) {
     topk_query_result.reserve(grpc_result.row_num());
     int64_t nq = grpc_result.row_num();
-    int64_t topk = grpc_result.ids().size() / nq;
+    // with delta ids a row holds the sorted ids, then the position of each hit in them
+    int64_t topk = grpc_result.ids().size() / nq / (delta_ids ? 2 : 1);
+    int64_t count = nq * topk;
+    // a server not knowing the encoding replies plain distances
+    bool fp16 = distance_encoding == DistanceEncoding::FP16 && grpc_result.distances_size() == (count + 1) / 2;
+    bool with_distances = fp16 || grpc_result.distances_size() == count;
     for (int64_t i = 0; i < nq; i++) {
         milvus::QueryResult one_result;
         one_result.ids.resize(topk);
-        one_result.distances.resize(topk);
-        memcpy(one_result.ids.data(), grpc_result.ids().data() + topk * i, topk * sizeof(int64_t));
-        memcpy(one_result.distances.data(), grpc_result.distances().data() + topk * i, topk * sizeof(float));
+        if (delta_ids) {
+            const int64_t* deltas = grpc_result.ids().data() + 2 * topk * i;
+            const int64_t* positions = deltas + topk;
+            // the padding goes last, a row without hits begins with it
+            std::vector<int64_t> sorted(deltas, deltas + topk);
+            for (int64_t j = 1; j < topk; j++) {
+                sorted[j] = deltas[j] == 0 || sorted[j - 1] == -1 ? -1 : sorted[j - 1] + deltas[j] - 1;
+            }
+            for (int64_t j = 0; j < topk; j++) {
+                one_result.ids[j] = sorted[positions[j]];
+            }
+        } else {
+            memcpy(one_result.ids.data(), grpc_result.ids().data() + topk * i, topk * sizeof(int64_t));
+        }
+
+        if (fp16) {
+            one_result.distances.resize(topk);
+            for (int64_t j = 0; j < topk; j++) {
+                int64_t idx = topk * i + j;
+                uint32_t bits;
+                float packed = grpc_result.distances(idx / 2);
+                memcpy(&bits, &packed, sizeof(bits));
+                one_result.distances[j] = DecodeFp16(idx % 2 == 0 ? bits & 0xffff : bits >> 16);
+            }
+        } else if (with_distances) {
+            one_result.distances.resize(topk);
+            memcpy(one_result.distances.data(), grpc_result.distances().data() + topk * i, topk * sizeof(float));
+        }
 
         int valid_size = one_result.ids.size();
         while (valid_size > 0 && one_result.ids[valid_size - 1] == -1) {
@@ -75,7 +171,9 @@ ConstructTopkResult(const ::milvus::grpc::TopKQueryResult& grpc_result, TopKQuer
         }
         if (valid_size != topk) {
             one_result.ids.resize(valid_size);
-            one_result.distances.resize(valid_size);
+            if (with_distances) {
+                one_result.distances.resize(valid_size);
+            }
         }
 
         topk_query_result.emplace_back(one_result);
@@ -135,23 +233,62 @@ ConstructTopkHybridResult(const ::milvus::grpc::HQueryResult& result, TopKHybrid
     }
 }
 
+ClientProxy::~ClientProxy() {
+    StopInsertBatching();
+}
+
 Status
 ClientProxy::Connect(const ConnectParam& param) {
     std::string uri = param.ip_address + ":" + param.port;
 
-    ::grpc::ChannelArguments args;
-    args.SetMaxSendMessageSize(-1);
-    args.SetMaxReceiveMessageSize(-1);
-    channel_ = ::grpc::CreateCustomChannel(uri, ::grpc::InsecureChannelCredentials(), args);
-    if (channel_ != nullptr) {
-        connected_ = true;
-        client_ptr_ = std::make_shared<GrpcClient>(channel_);
-        return Status::OK();
+    StopInsertBatching();
+    channels_.clear();
+    clients_.clear();
+    int64_t channel_count = std::max<int64_t>(param.channel_count, 1);
+    for (int64_t i = 0; i < channel_count; ++i) {
+        ::grpc::ChannelArguments args;
+        args.SetMaxSendMessageSize(-1);
+        args.SetMaxReceiveMessageSize(-1);
+        // channels with equal arguments would share one connection
+        args.SetInt(CHANNEL_INDEX_ARG, static_cast<int>(i));
+        auto channel = ::grpc::CreateCustomChannel(uri, ::grpc::InsecureChannelCredentials(), args);
+        if (channel == nullptr) {
+            channels_.clear();
+            clients_.clear();
+            connected_ = false;
+            return Status(StatusCode::NotConnected, "Connect failed!");
+        }
+        channels_.push_back(channel);
+        clients_.push_back(std::make_shared<GrpcClient>(channel));
+    }
+    connected_ = true;
+
+    result_distances_ = param.result_distances;
+    result_delta_ids_ = param.result_delta_ids;
+    std::vector<std::string> encodings;
+    if (param.result_distances == DistanceEncoding::FP16) {
+        encodings.emplace_back("fp16_distances");
+    } else if (param.result_distances == DistanceEncoding::NONE) {
+        encodings.emplace_back("no_distances");
+    }
+    if (param.result_delta_ids) {
+        encodings.emplace_back("delta_ids");
+    }
+    if (param.result_compression) {
+        encodings.emplace_back("gzip");
+    }
+    result_encoding_.clear();
+    for (auto& encoding : encodings) {
+        result_encoding_ += (result_encoding_.empty() ? "" : ",") + encoding;
     }
 
-    std::string reason = "Connect failed!";
-    connected_ = false;
-    return Status(StatusCode::NotConnected, reason);
+    insert_batch_rows_ = param.insert_batch_rows;
+    insert_batch_delay_ = std::chrono::milliseconds(std::max<int64_t>(param.insert_batch_delay_ms, 0));
+    if (insert_batch_rows_ > 0) {
+        batch_stop_ = false;
+        batch_thread_ = std::thread(&ClientProxy::InsertBatchLoop, this);
+    }
+    return Status::OK();
 }
 
 Status
@@ -172,7 +309,7 @@ Status
 ClientProxy::Connected() const {
     try {
         std::string info;
-        return client_ptr_->Cmd("", info);
+        return Client()->Cmd("", info);
     } catch (std::exception& ex) {
         return Status(StatusCode::NotConnected, "Connection lost: " + std::string(ex.what()));
     }
@@ -181,9 +318,14 @@ ClientProxy::Connected() const {
 Status
 ClientProxy::Disconnect() {
     try {
-        Status status = client_ptr_->Disconnect();
+        // the merged inserts still waiting are sent before the stubs are gone
+        StopInsertBatching();
+        Status status = Status::OK();
+        for (auto& client : clients_) {
+            status = client->Disconnect();
+        }
         connected_ = false;
-        channel_.reset();
+        channels_.clear();
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to disconnect: " + std::string(ex.what()));
@@ -200,7 +342,7 @@ ClientProxy::ServerVersion() const {
     Status status = Status::OK();
     try {
         std::string version;
-        Status status = client_ptr_->Cmd("version", version);
+        Status status = Client()->Cmd("version", version);
         return version;
     } catch (std::exception& ex) {
         return "";
@@ -209,13 +351,13 @@ ClientProxy::ServerVersion() const {
 
 std::string
 ClientProxy::ServerStatus() const {
-    if (channel_ == nullptr) {
+    if (channels_.empty()) {
         return "not connected to server";
     }
 
     try {
         std::string dummy;
-        Status status = client_ptr_->Cmd("", dummy);
+        Status status = Client()->Cmd("", dummy);
         return "server alive";
     } catch (std::exception& ex) {
         return "connection lost";
@@ -225,7 +367,7 @@ ClientProxy::ServerStatus() const {
 Status
 ClientProxy::GetConfig(const std::string& node_name, std::string& value) const {
     try {
-        return client_ptr_->Cmd("get_config " + node_name, value);
+        return Client()->Cmd("get_config " + node_name, value);
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to get config: " + node_name);
     }
@@ -235,7 +377,7 @@ Status
 ClientProxy::SetConfig(const std::string& node_name, const std::string& value) const {
     try {
         std::string dummy;
-        return client_ptr_->Cmd("set_config " + node_name + " " + value, dummy);
+        return Client()->Cmd("set_config " + node_name + " " + value, dummy);
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to set config: " + node_name);
     }
@@ -250,7 +392,7 @@ ClientProxy::CreateCollection(const CollectionParam& param) {
         schema.set_index_file_size(param.index_file_size);
         schema.set_metric_type(static_cast<int32_t>(param.metric_type));
 
-        return client_ptr_->CreateCollection(schema);
+        return Client()->CreateCollection(schema);
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to create collection: " + std::string(ex.what()));
     }
@@ -262,7 +404,7 @@ ClientProxy::HasCollection(const std::string& collection_name) {
         Status status = Status::OK();
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
-        return client_ptr_->HasCollection(grpc_collection_name, status);
+        return Client()->HasCollection(grpc_collection_name, status);
     } catch (std::exception& ex) {
         return false;
     }
@@ -273,7 +415,7 @@ ClientProxy::DropCollection(const std::string& collection_name) {
     try {
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
-        return client_ptr_->DropCollection(grpc_collection_name);
+        return Client()->DropCollection(grpc_collection_name);
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to drop collection: " + std::string(ex.what()));
     }
@@ -288,7 +430,7 @@ ClientProxy::CreateIndex(const IndexParam& index_param) {
         milvus::grpc::KeyValuePair* kv = grpc_index_param.add_extra_params();
         kv->set_key(EXTRA_PARAM_KEY);
         kv->set_value(index_param.extra_params);
-        return client_ptr_->CreateIndex(grpc_index_param);
+        return Client()->CreateIndex(grpc_index_param);
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to build index: " + std::string(ex.what()));
     }
@@ -303,10 +445,7 @@ ClientProxy::Insert(const std::string& collection_name, const std::string& parti
         insert_param.set_collection_name(collection_name);
         insert_param.set_partition_tag(partition_tag);
 
-        for (auto& entity : entity_array) {
-            ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
-            CopyRowRecord(grpc_record, entity);
-        }
+        CopyRowRecords(entity_array, 0, entity_array.size(), insert_param.mutable_row_record_array(), insert_param);
 
         // Single thread
         ::milvus::grpc::VectorIds vector_ids;
@@ -315,9 +454,9 @@ ClientProxy::Insert(const std::string& collection_name, const std::string& parti
             auto row_ids = insert_param.mutable_row_id_array();
             row_ids->Resize(static_cast<int>(id_array.size()), -1);
             memcpy(row_ids->mutable_data(), id_array.data(), id_array.size() * sizeof(int64_t));
-            status = client_ptr_->Insert(insert_param, vector_ids);
+            status = Client()->Insert(insert_param, vector_ids);
         } else {
-            status = client_ptr_->Insert(insert_param, vector_ids);
+            status = Client()->Insert(insert_param, vector_ids);
             /* return Milvus generated ids back to user */
             id_array.insert(id_array.end(), vector_ids.vector_id_array().begin(), vector_ids.vector_id_array().end());
         }
@@ -328,6 +467,58 @@ ClientProxy::Insert(const std::string& collection_name, const std::string& parti
     return status;
 }
 
+Status
+ClientProxy::BulkInsert(const std::string& collection_name, const std::string& partition_tag,
+                        const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array, int64_t chunk_size,
+                        int64_t max_in_flight) {
+    if (chunk_size <= 0 || max_in_flight <= 0) {
+        return Status(StatusCode::InvalidAgument, "Chunk size and max in flight must be positive");
+    }
+    bool user_ids = !id_array.empty();
+    if (user_ids && id_array.size() != entity_array.size()) {
+        return Status(StatusCode::InvalidAgument, "Size of id array doesn't match size of entity array");
+    }
+
+    try {
+        int64_t total = entity_array.size();
+        if (!user_ids) {
+            id_array.resize(total, -1);
+        }
+        int64_t offset = 0;
+        auto next_chunk = [&](::milvus::grpc::InsertParam& insert_param) {
+            if (offset >= total) {
+                return false;
+            }
+            int64_t end = std::min(offset + chunk_size, total);
+            insert_param.set_collection_name(collection_name);
+            insert_param.set_partition_tag(partition_tag);
+            CopyRowRecords(entity_array, offset, end, insert_param.mutable_row_record_array(), insert_param);
+            if (user_ids) {
+                auto row_ids = insert_param.mutable_row_id_array();
+                row_ids->Resize(static_cast<int>(end - offset), -1);
+                memcpy(row_ids->mutable_data(), id_array.data() + offset, (end - offset) * sizeof(int64_t));
+            }
+            offset = end;
+            return true;
+        };
+        auto chunk_done = [&](int64_t chunk, const ::milvus::grpc::VectorIds& vector_ids) {
+            /* return Milvus generated ids back to user */
+            if (!user_ids) {
+                std::copy(vector_ids.vector_id_array().begin(), vector_ids.vector_id_array().end(),
+                          id_array.begin() + chunk * chunk_size);
+            }
+        };
+
+        Status status = Client()->BulkInsert(next_chunk, chunk_done, max_in_flight);
+        if (!status.ok() && !user_ids) {
+            id_array.clear();
+        }
+        return status;
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "Failed to add entities: " + std::string(ex.what()));
+    }
+}
+
 Status
 ClientProxy::GetEntityByID(const std::string& collection_name, const std::vector<int64_t>& id_array,
                            std::vector<Entity>& entities_data) {
@@ -341,7 +532,7 @@ ClientProxy::GetEntityByID(const std::string& collection_name, const std::vector
         }
 
         ::milvus::grpc::VectorsData grpc_data;
-        Status status = client_ptr_->GetEntityByID(vectors_identity, grpc_data);
+        Status status = Client()->GetEntityByID(vectors_identity, grpc_data);
         if (!status.ok()) {
             return status;
         }
@@ -380,7 +571,7 @@ ClientProxy::ListIDInSegment(const std::string& collection_name, const std::stri
         param.set_segment_name(segment_name);
 
         ::milvus::grpc::VectorIds vector_ids;
-        Status status = client_ptr_->ListIDInSegment(param, vector_ids);
+        Status status = Client()->ListIDInSegment(param, vector_ids);
         if (!status.ok()) {
             return status;
         }
@@ -400,22 +591,20 @@ ClientProxy::Search(const std::string& collection_name, const std::vector<std::s
     try {
         // step 1: convert vectors data
         ::milvus::grpc::SearchParam search_param;
-        ConstructSearchParam(collection_name, partition_tag_array, topk, extra_params, search_param);
+        ConstructSearchParam(collection_name, partition_tag_array, topk, extra_params, result_encoding_,
+                             search_param);
 
-        for (auto& entity : entity_array) {
-            ::milvus::grpc::RowRecord* row_record = search_param.add_query_record_array();
-            CopyRowRecord(row_record, entity);
-        }
+        CopyRowRecords(entity_array, 0, entity_array.size(), search_param.mutable_query_record_array(), search_param);
 
         // step 2: search vectors
         ::milvus::grpc::TopKQueryResult grpc_result;
-        Status status = client_ptr_->Search(search_param, grpc_result);
+        Status status = Client()->Search(search_param, grpc_result);
         if (grpc_result.row_num() == 0) {
             return status;
         }
 
         // step 3: convert result array
-        ConstructTopkResult(grpc_result, topk_query_result);
+        ConstructTopkResult(grpc_result, result_distances_, result_delta_ids_, topk_query_result);
 
         return status;
     } catch (std::exception& ex) {
@@ -423,12 +612,222 @@ ClientProxy::Search(const std::string& collection_name, const std::vector<std::s
     }
 }
 
+Status
+ClientProxy::SearchChunked(const std::string& collection_name, const std::vector<std::string>& partition_tag_array,
+                           const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                           int64_t chunk_nq, const QueryChunkCallback& on_chunk, int64_t max_in_flight) {
+    if (chunk_nq <= 0 || max_in_flight <= 0) {
+        return Status(StatusCode::InvalidAgument, "Chunk nq and max in flight must be positive");
+    }
+
+    try {
+        int64_t total = entity_array.size();
+        int64_t offset = 0;
+        auto next_chunk = [&](::milvus::grpc::SearchParam& search_param) {
+            if (offset >= total) {
+                return false;
+            }
+            int64_t end = std::min(offset + chunk_nq, total);
+            ConstructSearchParam(collection_name, partition_tag_array, topk, extra_params, result_encoding_,
+                             search_param);
+            CopyRowRecords(entity_array, offset, end, search_param.mutable_query_record_array(), search_param);
+            offset = end;
+            return true;
+        };
+        auto chunk_done = [&](int64_t chunk, const ::milvus::grpc::TopKQueryResult& grpc_result) {
+            TopKQueryResult chunk_result;
+            if (grpc_result.row_num() > 0) {
+                ConstructTopkResult(grpc_result, result_distances_, result_delta_ids_, chunk_result);
+            }
+            on_chunk(chunk * chunk_nq, chunk_result);
+        };
+
+        return Client()->SearchChunked(next_chunk, chunk_done, max_in_flight);
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "Failed to search entities: " + std::string(ex.what()));
+    }
+}
+
+std::future<Status>
+ClientProxy::InsertAsync(const std::string& collection_name, const std::string& partition_tag,
+                         const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) {
+    auto pending = std::make_shared<PendingInsert>();
+    auto future = pending->promise.get_future();
+    bool user_ids = !id_array.empty();
+    if (user_ids && id_array.size() != entity_array.size()) {
+        pending->promise.set_value(
+            Status(StatusCode::InvalidAgument, "Size of id array doesn't match size of entity array"));
+        return future;
+    }
+    pending->id_array = &id_array;
+    pending->rows = entity_array.size();
+
+    int64_t rows = pending->rows;
+    if (insert_batch_rows_ > 0 && rows > 0 && rows < insert_batch_rows_) {
+        pending->entity_array = entity_array;
+        InsertBatch full_batch;
+        {
+            std::lock_guard<std::mutex> lock(batch_mutex_);
+            std::string key = collection_name + '\0' + partition_tag + '\0' + (user_ids ? '1' : '0');
+            auto& batch = insert_batches_[key];
+            if (batch.inserts.empty()) {
+                batch.collection_name = collection_name;
+                batch.partition_tag = partition_tag;
+                batch.user_ids = user_ids;
+                batch.deadline = std::chrono::steady_clock::now() + insert_batch_delay_;
+            }
+            batch.inserts.push_back(pending);
+            batch.rows += rows;
+            if (batch.rows < insert_batch_rows_) {
+                batch_cv_.notify_one();
+                return future;
+            }
+            full_batch = std::move(batch);
+            insert_batches_.erase(key);
+        }
+        SendInsertBatch(full_batch);
+        return future;
+    }
+
+    InsertBatch batch;
+    batch.collection_name = collection_name;
+    batch.partition_tag = partition_tag;
+    batch.user_ids = user_ids;
+    batch.rows = rows;
+    batch.inserts.push_back(pending);
+    SendInsertBatch(batch, &entity_array);
+    return future;
+}
+
+void
+ClientProxy::SendInsertBatch(InsertBatch& batch, const std::vector<Entity>* entity_array) {
+    auto inserts = std::make_shared<std::vector<PendingInsertPtr>>(std::move(batch.inserts));
+    try {
+        ::milvus::grpc::InsertParam insert_param;
+        insert_param.set_collection_name(batch.collection_name);
+        insert_param.set_partition_tag(batch.partition_tag);
+
+        // a merged insert sends the entities of its parts one after the other
+        std::vector<Entity> merged;
+        if (entity_array == nullptr) {
+            merged.reserve(batch.rows);
+            for (auto& insert : *inserts) {
+                merged.insert(merged.end(), insert->entity_array.begin(), insert->entity_array.end());
+            }
+            entity_array = &merged;
+        }
+        CopyRowRecords(*entity_array, 0, entity_array->size(), insert_param.mutable_row_record_array(), insert_param);
+        if (batch.user_ids) {
+            auto row_ids = insert_param.mutable_row_id_array();
+            for (auto& insert : *inserts) {
+                for (auto id : *insert->id_array) {
+                    row_ids->Add(id);
+                }
+            }
+        }
+
+        bool user_ids = batch.user_ids;
+        Client()->InsertAsync(insert_param, [inserts, user_ids](const Status& status,
+                                                                 const ::milvus::grpc::VectorIds& vector_ids) {
+            // the ids come back in the order of the entities, each part takes as many as it sent
+            int64_t offset = 0;
+            for (auto& insert : *inserts) {
+                if (status.ok() && !user_ids && offset + insert->rows <= vector_ids.vector_id_array_size()) {
+                    auto begin = vector_ids.vector_id_array().begin() + offset;
+                    insert->id_array->insert(insert->id_array->end(), begin, begin + insert->rows);
+                }
+                offset += insert->rows;
+                insert->promise.set_value(status);
+            }
+        });
+    } catch (std::exception& ex) {
+        for (auto& insert : *inserts) {
+            insert->promise.set_value(
+                Status(StatusCode::UnknownError, "Failed to add entities: " + std::string(ex.what())));
+        }
+    }
+}
+
+void
+ClientProxy::InsertBatchLoop() {
+    std::unique_lock<std::mutex> lock(batch_mutex_);
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        auto next_deadline = now + std::chrono::hours(1);
+        std::vector<InsertBatch> due;
+        for (auto iter = insert_batches_.begin(); iter != insert_batches_.end();) {
+            if (batch_stop_ || iter->second.deadline <= now) {
+                due.emplace_back(std::move(iter->second));
+                iter = insert_batches_.erase(iter);
+            } else {
+                next_deadline = std::min(next_deadline, iter->second.deadline);
+                ++iter;
+            }
+        }
+
+        if (!due.empty()) {
+            lock.unlock();
+            for (auto& batch : due) {
+                SendInsertBatch(batch);
+            }
+            lock.lock();
+            continue;
+        }
+        if (batch_stop_) {
+            break;
+        }
+        batch_cv_.wait_until(lock, next_deadline);
+    }
+}
+
+void
+ClientProxy::StopInsertBatching() {
+    if (!batch_thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex_);
+        batch_stop_ = true;
+    }
+    batch_cv_.notify_one();
+    batch_thread_.join();
+}
+
+std::future<Status>
+ClientProxy::SearchAsync(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                         const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                         TopKQueryResult& topk_query_result) {
+    auto promise = std::make_shared<std::promise<Status>>();
+    auto future = promise->get_future();
+    try {
+        ::milvus::grpc::SearchParam search_param;
+        ConstructSearchParam(collection_name, partition_tag_array, topk, extra_params, result_encoding_,
+                             search_param);
+        CopyRowRecords(entity_array, 0, entity_array.size(), search_param.mutable_query_record_array(), search_param);
+
+        auto result = &topk_query_result;
+        auto distances = result_distances_;
+        bool delta_ids = result_delta_ids_;
+        auto done = [promise, result, distances, delta_ids](const Status& status,
+                                                            const ::milvus::grpc::TopKQueryResult& grpc_result) {
+            if (status.ok() && grpc_result.row_num() > 0) {
+                ConstructTopkResult(grpc_result, distances, delta_ids, *result);
+            }
+            promise->set_value(status);
+        };
+        Client()->SearchAsync(search_param, done);
+    } catch (std::exception& ex) {
+        promise->set_value(Status(StatusCode::UnknownError, "Failed to search entities: " + std::string(ex.what())));
+    }
+    return future;
+}
+
 Status
 ClientProxy::GetCollectionInfo(const std::string& collection_name, CollectionParam& collection_param) {
     try {
         ::milvus::grpc::CollectionSchema grpc_schema;
 
-        Status status = client_ptr_->GetCollectionInfo(collection_name, grpc_schema);
+        Status status = Client()->GetCollectionInfo(collection_name, grpc_schema);
 
         collection_param.collection_name = grpc_schema.collection_name();
         collection_param.dimension = grpc_schema.dimension();
@@ -447,7 +846,7 @@ ClientProxy::CountEntities(const std::string& collection_name, int64_t& row_coun
         Status status;
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
-        row_count = client_ptr_->CountEntities(grpc_collection_name, status);
+        row_count = Client()->CountEntities(grpc_collection_name, status);
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to count collection: " + std::string(ex.what()));
@@ -459,7 +858,7 @@ ClientProxy::ListCollections(std::vector<std::string>& collection_array) {
     try {
         Status status;
         milvus::grpc::CollectionNameList collection_name_list;
-        status = client_ptr_->ListCollections(collection_name_list);
+        status = Client()->ListCollections(collection_name_list);
 
         collection_array.resize(collection_name_list.collection_names_size());
         for (uint64_t i = 0; i < collection_name_list.collection_names_size(); ++i) {
@@ -478,7 +877,7 @@ ClientProxy::GetCollectionStats(const std::string& collection_name, std::string&
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
         milvus::grpc::CollectionInfo grpc_collection_stats;
-        status = client_ptr_->GetCollectionStats(grpc_collection_name, grpc_collection_stats);
+        status = Client()->GetCollectionStats(grpc_collection_name, grpc_collection_stats);
 
         collection_stats = grpc_collection_stats.json_info();
 
@@ -497,7 +896,7 @@ ClientProxy::DeleteEntityByID(const std::string& collection_name, const std::vec
             delete_by_id_param.add_id_array(id);
         }
 
-        return client_ptr_->DeleteEntityByID(delete_by_id_param);
+        return Client()->DeleteEntityByID(delete_by_id_param);
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to delete entity id: " + std::string(ex.what()));
     }
@@ -508,7 +907,7 @@ ClientProxy::LoadCollection(const std::string& collection_name) const {
     try {
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
-        Status status = client_ptr_->LoadCollection(grpc_collection_name);
+        Status status = Client()->LoadCollection(grpc_collection_name);
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to preload collection: " + std::string(ex.what()));
@@ -522,7 +921,7 @@ ClientProxy::GetIndexInfo(const std::string& collection_name, IndexParam& index_
         grpc_collection_name.set_collection_name(collection_name);
 
         ::milvus::grpc::IndexParam grpc_index_param;
-        Status status = client_ptr_->GetIndexInfo(grpc_collection_name, grpc_index_param);
+        Status status = Client()->GetIndexInfo(grpc_collection_name, grpc_index_param);
         index_param.index_type = static_cast<IndexType>(grpc_index_param.index_type());
 
         for (int i = 0; i < grpc_index_param.extra_params_size(); i++) {
@@ -543,7 +942,7 @@ ClientProxy::DropIndex(const std::string& collection_name) const {
     try {
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
-        Status status = client_ptr_->DropIndex(grpc_collection_name);
+        Status status = Client()->DropIndex(grpc_collection_name);
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to drop index: " + std::string(ex.what()));
@@ -556,7 +955,7 @@ ClientProxy::CreatePartition(const PartitionParam& partition_param) {
         ::milvus::grpc::PartitionParam grpc_partition_param;
         grpc_partition_param.set_collection_name(partition_param.collection_name);
         grpc_partition_param.set_tag(partition_param.partition_tag);
-        Status status = client_ptr_->CreatePartition(grpc_partition_param);
+        Status status = Client()->CreatePartition(grpc_partition_param);
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to create partition: " + std::string(ex.what()));
@@ -570,7 +969,7 @@ ClientProxy::HasPartition(const std::string& collection_name, const std::string&
         ::milvus::grpc::PartitionParam grpc_partition_param;
         grpc_partition_param.set_collection_name(collection_name);
         grpc_partition_param.set_tag(partition_tag);
-        return client_ptr_->HasPartition(grpc_partition_param, status);
+        return Client()->HasPartition(grpc_partition_param, status);
     } catch (std::exception& ex) {
         return false;
     }
@@ -582,7 +981,7 @@ ClientProxy::ListPartitions(const std::string& collection_name, PartitionTagList
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
         ::milvus::grpc::PartitionList grpc_partition_list;
-        Status status = client_ptr_->ListPartitions(grpc_collection_name, grpc_partition_list);
+        Status status = Client()->ListPartitions(grpc_collection_name, grpc_partition_list);
         partition_tag_array.resize(grpc_partition_list.partition_tag_array_size());
         for (uint64_t i = 0; i < grpc_partition_list.partition_tag_array_size(); ++i) {
             partition_tag_array[i] = grpc_partition_list.partition_tag_array(i);
@@ -599,7 +998,7 @@ ClientProxy::DropPartition(const PartitionParam& partition_param) {
         ::milvus::grpc::PartitionParam grpc_partition_param;
         grpc_partition_param.set_collection_name(partition_param.collection_name);
         grpc_partition_param.set_tag(partition_param.partition_tag);
-        Status status = client_ptr_->DropPartition(grpc_partition_param);
+        Status status = Client()->DropPartition(grpc_partition_param);
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to drop partition: " + std::string(ex.what()));
@@ -610,10 +1009,10 @@ Status
 ClientProxy::Flush(const std::vector<std::string>& collection_name_array) {
     try {
         if (collection_name_array.empty()) {
-            return client_ptr_->Flush("");
+            return Client()->Flush("");
         } else {
             for (auto& collection_name : collection_name_array) {
-                client_ptr_->Flush(collection_name);
+                Client()->Flush(collection_name);
             }
         }
         return Status::OK();
@@ -627,7 +1026,7 @@ ClientProxy::Compact(const std::string& collection_name) {
     try {
         ::milvus::grpc::CollectionName grpc_collection_name;
         grpc_collection_name.set_collection_name(collection_name);
-        Status status = client_ptr_->Compact(grpc_collection_name);
+        Status status = Client()->Compact(grpc_collection_name);
         return status;
     } catch (std::exception& ex) {
         return Status(StatusCode::UnknownError, "Failed to compact collection: " + std::string(ex.what()));
@@ -658,7 +1057,7 @@ ClientProxy::CreateHybridCollection(const HMapping& mapping) {
             kv_pair->set_key("params");
             kv_pair->set_value(field->extram_params);
         }
-        return client_ptr_->CreateHybridCollection(grpc_mapping);
+        return Client()->CreateHybridCollection(grpc_mapping);
     } catch (std::exception& exception) {
         return Status(StatusCode::UnknownError, "Failed to create collection: " + std::string(exception.what()));
     }
@@ -711,9 +1110,9 @@ ClientProxy::InsertEntity(const std::string& collection_name, const std::string&
             auto row_ids = grpc_param.mutable_entity_id_array();
             row_ids->Resize(static_cast<int>(id_array.size()), -1);
             memcpy(row_ids->mutable_data(), id_array.data(), id_array.size() * sizeof(int64_t));
-            status = client_ptr_->InsertEntities(grpc_param, entity_ids);
+            status = Client()->InsertEntities(grpc_param, entity_ids);
         } else {
-            status = client_ptr_->InsertEntities(grpc_param, entity_ids);
+            status = Client()->InsertEntities(grpc_param, entity_ids);
             id_array.insert(id_array.end(), entity_ids.entity_id_array().begin(), entity_ids.entity_id_array().end());
         }
     } catch (std::exception& exception) {
@@ -804,7 +1203,7 @@ ClientProxy::HybridSearchPB(const std::string& collection_name, const std::vecto
 
         // step 2: search vectors
         ::milvus::grpc::HQueryResult result;
-        Status status = client_ptr_->HybridSearchPB(search_param, result);
+        Status status = Client()->HybridSearchPB(search_param, result);
 
         // step 3: convert result array
         ConstructTopkHybridResult(result, topk_query_result);
@@ -834,7 +1233,7 @@ ClientProxy::HybridSearch(const std::string& collection_name, const std::vector<
         }
 
         ::milvus::grpc::HQueryResult result;
-        Status status = client_ptr_->HybridSearch(search_param, result);
+        Status status = Client()->HybridSearch(search_param, result);
         ConstructTopkHybridResult(result, topk_query_result);
         return status;
     } catch (std::exception& ex) {
@@ -853,7 +1252,7 @@ ClientProxy::GetHEntityByID(const std::string& collection_name, const std::vecto
         }
 
         ::milvus::grpc::HEntity grpc_entity;
-        Status status = client_ptr_->GetHEntityByID(vectors_identity, grpc_entity);
+        Status status = Client()->GetHEntityByID(vectors_identity, grpc_entity);
         if (!status.ok()) {
             return status;
         }
@@ -918,7 +1317,7 @@ ClientProxy::CreateHybridIndex(const milvus::HIndexParam& index_param) {
         }
 
         grpc::Status grpc_status;
-        auto status = client_ptr_->CreateHybridIndex(grpc_param, grpc_status);
+        auto status = Client()->CreateHybridIndex(grpc_param, grpc_status);
 
         return status;
     } catch (std::exception& ex) {
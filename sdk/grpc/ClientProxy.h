@@ -14,14 +14,23 @@
 #include "GrpcClient.h"
 #include "MilvusApi.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace milvus {
 
 class ClientProxy : public Connection {
  public:
+    ~ClientProxy();
+
     // Implementations of the Connection interface
     Status
     Connect(const ConnectParam& connect_param) override;
@@ -66,6 +75,11 @@ class ClientProxy : public Connection {
     Insert(const std::string& collection_name, const std::string& partition_tag,
            const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) override;
 
+    Status
+    BulkInsert(const std::string& collection_name, const std::string& partition_tag,
+               const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array, int64_t chunk_size,
+               int64_t max_in_flight) override;
+
     Status
     GetEntityByID(const std::string& collection_name, const std::vector<int64_t>& id_array,
                   std::vector<Entity>& entities_data) override;
@@ -79,6 +93,20 @@ class ClientProxy : public Connection {
            const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
            TopKQueryResult& topk_query_result) override;
 
+    Status
+    SearchChunked(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                  const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                  int64_t chunk_nq, const QueryChunkCallback& on_chunk, int64_t max_in_flight) override;
+
+    std::future<Status>
+    InsertAsync(const std::string& collection_name, const std::string& partition_tag,
+                const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) override;
+
+    std::future<Status>
+    SearchAsync(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                TopKQueryResult& topk_query_result) override;
+
     Status
     GetCollectionInfo(const std::string& collection_name, CollectionParam& collection_param) override;
 
@@ -148,9 +176,58 @@ class ClientProxy : public Connection {
     CreateHybridIndex(const HIndexParam& index_param) override;
 
  private:
-    std::shared_ptr<::grpc::Channel> channel_;
-    std::shared_ptr<GrpcClient> client_ptr_;
+    // an insert waiting for its reply, entity_array keeps the entities of a merged one until it is sent
+    struct PendingInsert {
+        int64_t rows = 0;
+        std::vector<Entity> entity_array;
+        std::vector<int64_t>* id_array = nullptr;
+        std::promise<Status> promise;
+    };
+    using PendingInsertPtr = std::shared_ptr<PendingInsert>;
+
+    struct InsertBatch {
+        std::string collection_name;
+        std::string partition_tag;
+        bool user_ids = false;
+        int64_t rows = 0;
+        std::chrono::steady_clock::time_point deadline;
+        std::vector<PendingInsertPtr> inserts;
+    };
+
+    // the clients take the calls in turn
+    std::shared_ptr<GrpcClient>
+    Client() const {
+        return clients_[next_client_++ % clients_.size()];
+    }
+
+    // sends the entities of the batch, or entity_array for a batch of one insert, as one request
+    void
+    SendInsertBatch(InsertBatch& batch, const std::vector<Entity>* entity_array = nullptr);
+
+    void
+    InsertBatchLoop();
+
+    void
+    StopInsertBatching();
+
+ private:
+    std::vector<std::shared_ptr<::grpc::Channel>> channels_;
+    std::vector<std::shared_ptr<GrpcClient>> clients_;
+    mutable std::atomic<uint64_t> next_client_{0};
     bool connected_ = false;
+
+    // the result options of the connect param, and the extra param asking the server for them
+    DistanceEncoding result_distances_ = DistanceEncoding::FLOAT;
+    bool result_delta_ids_ = false;
+    std::string result_encoding_;
+
+    int64_t insert_batch_rows_ = 0;
+    std::chrono::milliseconds insert_batch_delay_{2};
+    std::mutex batch_mutex_;
+    std::condition_variable batch_cv_;
+    std::map<std::string, InsertBatch> insert_batches_;
+    bool batch_stop_ = false;
+    std::thread batch_thread_;
 };
 
 }  // namespace milvus
@@ -17,6 +17,8 @@
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include <grpcpp/completion_queue.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -33,7 +35,13 @@ GrpcClient::GrpcClient(std::shared_ptr<::grpc::Channel>& channel)
     : stub_(::milvus::grpc::MilvusService::NewStub(channel)) {
 }
 
-GrpcClient::~GrpcClient() = default;
+GrpcClient::~GrpcClient() {
+    // the calls still in flight complete before the queue is drained
+    async_cq_.Shutdown();
+    if (async_thread_.joinable()) {
+        async_thread_.join();
+    }
+}
 
 Status
 GrpcClient::CreateCollection(const ::milvus::grpc::CollectionSchema& collection_schema) {
@@ -124,6 +132,153 @@ GrpcClient::Insert(const ::milvus::grpc::InsertParam& insert_param, ::milvus::gr
     return Status::OK();
 }
 
+namespace {
+
+milvus::Status
+ReplyStatus(const char* rpc_name, bool ok, const ::grpc::Status& grpc_status, const milvus::grpc::Status& status) {
+    if (!ok || !grpc_status.ok()) {
+        std::cerr << rpc_name << " rpc failed!" << std::endl;
+        return milvus::Status(milvus::StatusCode::RPCFailed, grpc_status.error_message());
+    }
+    if (status.error_code() != milvus::grpc::SUCCESS) {
+        std::cerr << status.reason() << std::endl;
+        return milvus::Status(milvus::StatusCode::ServerFailed, status.reason());
+    }
+    return milvus::Status::OK();
+}
+
+template <typename Reply>
+struct PipelinedCall {
+    int64_t chunk = 0;
+    ClientContext context;
+    Reply reply;
+    ::grpc::Status grpc_status;
+    std::unique_ptr<::grpc::ClientAsyncResponseReader<Reply>> reader;
+};
+
+// keeps up to max_in_flight unary calls outstanding: start_call issues the call of the next chunk on the queue and
+// returns false at the end, chunk_done gets the replies in completion order; stops issuing on the first error and
+// drains the calls still in flight
+template <typename Request, typename Reply>
+milvus::Status
+PipelineCalls(const char* rpc_name, const std::function<bool(Request&)>& next_chunk,
+              const std::function<std::unique_ptr<::grpc::ClientAsyncResponseReader<Reply>>(
+                  ClientContext*, const Request&, ::grpc::CompletionQueue*)>& start_call,
+              const std::function<void(int64_t, const Reply&)>& chunk_done, int64_t max_in_flight) {
+    ::grpc::CompletionQueue cq;
+    milvus::Status status = milvus::Status::OK();
+    int64_t chunk = 0, in_flight = 0;
+    bool more = true;
+    while (true) {
+        while (more && status.ok() && in_flight < max_in_flight) {
+            Request request;
+            more = next_chunk(request);
+            if (!more) {
+                break;
+            }
+            auto call = new PipelinedCall<Reply>;
+            call->chunk = chunk++;
+            call->reader = start_call(&call->context, request, &cq);
+            call->reader->Finish(&call->reply, &call->grpc_status, call);
+            ++in_flight;
+        }
+        if (in_flight == 0) {
+            break;
+        }
+
+        void* tag = nullptr;
+        bool ok = false;
+        if (!cq.Next(&tag, &ok)) {
+            break;
+        }
+        std::unique_ptr<PipelinedCall<Reply>> call(static_cast<PipelinedCall<Reply>*>(tag));
+        --in_flight;
+        if (!status.ok()) {
+            continue;
+        }
+        status = ReplyStatus(rpc_name, ok, call->grpc_status, call->reply.status());
+        if (status.ok()) {
+            chunk_done(call->chunk, call->reply);
+        }
+    }
+    cq.Shutdown();
+    void* tag = nullptr;
+    bool ok = false;
+    while (cq.Next(&tag, &ok)) {
+    }
+
+    return status;
+}
+
+struct AsyncCallBase {
+    virtual ~AsyncCallBase() = default;
+
+    virtual void
+    Complete(bool ok) = 0;
+};
+
+template <typename Reply>
+struct AsyncCall : public AsyncCallBase {
+    const char* rpc_name = "";
+    ClientContext context;
+    Reply reply;
+    ::grpc::Status grpc_status;
+    std::unique_ptr<::grpc::ClientAsyncResponseReader<Reply>> reader;
+    std::function<void(const milvus::Status&, const Reply&)> done;
+
+    void
+    Complete(bool ok) override {
+        done(ReplyStatus(rpc_name, ok, grpc_status, reply.status()), reply);
+    }
+};
+
+}  // namespace
+
+void
+GrpcClient::InsertAsync(const ::milvus::grpc::InsertParam& insert_param, const InsertDone& done) {
+    std::call_once(async_once_, [this] { async_thread_ = std::thread(&GrpcClient::AsyncLoop, this); });
+
+    auto call = new AsyncCall<::milvus::grpc::VectorIds>;
+    call->rpc_name = "InsertAsync";
+    call->done = done;
+    call->reader = stub_->AsyncInsert(&call->context, insert_param, &async_cq_);
+    call->reader->Finish(&call->reply, &call->grpc_status, static_cast<AsyncCallBase*>(call));
+}
+
+void
+GrpcClient::SearchAsync(const ::milvus::grpc::SearchParam& search_param, const SearchDone& done) {
+    std::call_once(async_once_, [this] { async_thread_ = std::thread(&GrpcClient::AsyncLoop, this); });
+
+    auto call = new AsyncCall<::milvus::grpc::TopKQueryResult>;
+    call->rpc_name = "SearchAsync";
+    call->done = done;
+    call->reader = stub_->AsyncSearch(&call->context, search_param, &async_cq_);
+    call->reader->Finish(&call->reply, &call->grpc_status, static_cast<AsyncCallBase*>(call));
+}
+
+void
+GrpcClient::AsyncLoop() {
+    void* tag = nullptr;
+    bool ok = false;
+    while (async_cq_.Next(&tag, &ok)) {
+        std::unique_ptr<AsyncCallBase> call(static_cast<AsyncCallBase*>(tag));
+        call->Complete(ok);
+    }
+}
+
+Status
+GrpcClient::BulkInsert(const std::function<bool(::milvus::grpc::InsertParam&)>& next_chunk,
+                       const std::function<void(int64_t, const ::milvus::grpc::VectorIds&)>& chunk_done,
+                       int64_t max_in_flight) {
+    // the server holds inserts while its insert buffer is full, so the window is the backpressure
+    return PipelineCalls<::milvus::grpc::InsertParam, ::milvus::grpc::VectorIds>(
+        "BulkInsert", next_chunk,
+        [this](ClientContext* context, const ::milvus::grpc::InsertParam& request, ::grpc::CompletionQueue* cq) {
+            return stub_->AsyncInsert(context, request, cq);
+        },
+        chunk_done, max_in_flight);
+}
+
 Status
 GrpcClient::GetEntityByID(const grpc::VectorsIdentity& vectors_identity, ::milvus::grpc::VectorsData& vectors_data) {
     ClientContext context;
@@ -178,6 +333,18 @@ GrpcClient::Search(const ::milvus::grpc::SearchParam& search_param,
     return Status::OK();
 }
 
+Status
+GrpcClient::SearchChunked(const std::function<bool(::milvus::grpc::SearchParam&)>& next_chunk,
+                          const std::function<void(int64_t, const ::milvus::grpc::TopKQueryResult&)>& chunk_done,
+                          int64_t max_in_flight) {
+    return PipelineCalls<::milvus::grpc::SearchParam, ::milvus::grpc::TopKQueryResult>(
+        "SearchChunked", next_chunk,
+        [this](ClientContext* context, const ::milvus::grpc::SearchParam& request, ::grpc::CompletionQueue* cq) {
+            return stub_->AsyncSearch(context, request, cq);
+        },
+        chunk_done, max_in_flight);
+}
+
 Status
 GrpcClient::GetCollectionInfo(const std::string& collection_name, ::milvus::grpc::CollectionSchema& grpc_schema) {
     ClientContext context;
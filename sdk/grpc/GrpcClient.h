@@ -16,8 +16,10 @@
 //#include "grpc/gen-status/status.grpc.pb.h"
 
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
 #include <thread>
@@ -25,6 +27,7 @@
 #include <grpc/grpc.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
@@ -50,6 +53,22 @@ class GrpcClient {
     Status
     Insert(const grpc::InsertParam& insert_param, grpc::VectorIds& vector_ids);
 
+    // keeps up to max_in_flight inserts outstanding: next_chunk fills the next request and returns false at the end,
+    // chunk_done gets the ids of each chunk in completion order; stops sending on the first error
+    Status
+    BulkInsert(const std::function<bool(grpc::InsertParam&)>& next_chunk,
+               const std::function<void(int64_t, const grpc::VectorIds&)>& chunk_done, int64_t max_in_flight);
+
+    using InsertDone = std::function<void(const Status&, const grpc::VectorIds&)>;
+    using SearchDone = std::function<void(const Status&, const grpc::TopKQueryResult&)>;
+
+    // issues the call and returns at once, done gets the status and reply on the completion thread of the client
+    void
+    InsertAsync(const grpc::InsertParam& insert_param, const InsertDone& done);
+
+    void
+    SearchAsync(const grpc::SearchParam& search_param, const SearchDone& done);
+
     Status
     GetEntityByID(const grpc::VectorsIdentity& vectors_identity, ::milvus::grpc::VectorsData& vectors_data);
 
@@ -59,6 +78,12 @@ class GrpcClient {
     Status
     Search(const grpc::SearchParam& search_param, ::milvus::grpc::TopKQueryResult& topk_query_result);
 
+    // searches the query chunks next_chunk fills with up to max_in_flight searches outstanding, chunk_done gets the
+    // result of each chunk in completion order; stops sending on the first error
+    Status
+    SearchChunked(const std::function<bool(grpc::SearchParam&)>& next_chunk,
+                  const std::function<void(int64_t, const grpc::TopKQueryResult&)>& chunk_done, int64_t max_in_flight);
+
     Status
     GetCollectionInfo(const std::string& collection_name, grpc::CollectionSchema& grpc_schema);
 
@@ -126,8 +151,17 @@ class GrpcClient {
     Status
     CreateHybridIndex(milvus::grpc::HIndexParam& index_param, milvus::grpc::Status& status);
 
+ private:
+    void
+    AsyncLoop();
+
  private:
     std::unique_ptr<grpc::MilvusService::Stub> stub_;
+
+    // completion queue of the async calls, drained by a thread started with the first one
+    ::grpc::CompletionQueue async_cq_;
+    std::once_flag async_once_;
+    std::thread async_thread_;
 };
 
 }  // namespace milvus
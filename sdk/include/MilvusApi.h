@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -41,6 +43,9 @@ enum class IndexType {
     ANNOY = 12,
     IVFSQ8NR = 13,
     HNSW_SQ8NR = 14,
+    IVFPQ_FASTSCAN = 15,
+    DISKANN = 16,
+    BIN_HASH = 17,
 };
 
 enum class MetricType {
@@ -53,12 +58,30 @@ enum class MetricType {
     SUPERSTRUCTURE = 7,  // Superstructure Distance
 };
 
+/**
+ * @brief Distances of the search replies
+ */
+enum class DistanceEncoding {
+    FLOAT = 0,  // 4 bytes each
+    FP16 = 1,   // 2 bytes each, about 3 significant digits, beyond 65504 infinite
+    NONE = 2,   // left out, the distances of the results are empty
+};
+
 /**
  * @brief Connect API parameter
+ *
+ * The result options shrink the replies of large batch searches, they need a server knowing them.
  */
 struct ConnectParam {
-    std::string ip_address;  ///< Server IP address
-    std::string port;        ///< Server PORT
+    std::string ip_address;             ///< Server IP address
+    std::string port;                   ///< Server PORT
+    int64_t channel_count = 1;          ///< Number of HTTP/2 connections the calls are spread over
+    int64_t insert_batch_rows = 0;      ///< InsertAsync merges small inserts up to this many rows, 0 disables it
+    int64_t insert_batch_delay_ms = 2;  ///< Longest time an insert waits for others to merge with, unit: ms
+
+    DistanceEncoding result_distances = DistanceEncoding::FLOAT;  ///< Distances of the search replies
+    bool result_delta_ids = false;                                ///< Reply ids delta encoded, hits keep their order
+    bool result_compression = false;                              ///< Search replies gzip compressed
 };
 
 /**
@@ -79,6 +102,8 @@ struct QueryResult {
     std::vector<float> distances;  ///< Query distances result
 };
 using TopKQueryResult = std::vector<QueryResult>;  ///< Topk query result
+using QueryChunkCallback =
+    std::function<void(int64_t first_query, TopKQueryResult& chunk_result)>;  ///< Result of a chunk of queries
 
 /**
  * @brief Attribute record
@@ -351,6 +376,30 @@ class Connection {
     Insert(const std::string& collection_name, const std::string& partition_tag,
            const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) = 0;
 
+    /**
+     * @brief Insert a large entity array to collection
+     *
+     * This method is used to insert a large vector array in chunks, keeping several chunks in flight.
+     * The server holds the inserts while its insert buffer is full, which throttles the client.
+     * A failed chunk stops the insert, the chunks sent before it may be inserted.
+     *
+     * @param collection_name, target collection's name.
+     * @param partition_tag, target partition's tag, keep empty if no partition specified.
+     * @param entity_array, entity array is inserted, each entity represent a vector.
+     * @param id_array,
+     *  specify id for each entity,
+     *  if this array is empty, milvus will generate unique id for each entity,
+     *  and return all ids by this parameter.
+     * @param chunk_size, number of entities sent by one insert request.
+     * @param max_in_flight, number of insert requests waiting for a reply at most.
+     *
+     * @return Indicate if entity array are inserted successfully
+     */
+    virtual Status
+    BulkInsert(const std::string& collection_name, const std::string& partition_tag,
+               const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array, int64_t chunk_size = 10000,
+               int64_t max_in_flight = 4) = 0;
+
     /**
      * @brief Get entity data by id
      *
@@ -397,10 +446,18 @@ class Connection {
      *       For different index type, parameter list is different accordingly
      *       FLAT/IVFLAT/SQ8/IVFPQ:  {nprobe: 32}
      *           ///< nprobe range:[1,999999]
+     *       SQ8/IVFPQ may add {refine_k: 200} to re-score refine_k candidates with the raw vectors on the server
+     *           ///< refine_k range:[topk, 16384]
      *       NSG:  {search_length:100}
      *           ///< search_length range:[10, 300]
      *       HNSW  {ef: 64}
      *           ///< ef range:[topk, 4096]
+     *       Any index type may add {radius: 2.5} to search by range: only the entities whose distance is below the
+     *       radius (or whose inner product is above it) are returned, at most topk of them per query. The rows of
+     *       the result are as long as the longest one, the shorter ones are padded with id -1.
+     *       An IP collection may add {aggregate: "max_sim"} to search the query vectors as one multi-vector query:
+     *       an entity scores the sum of its inner products with the query vectors whose top k it is in, and a
+     *       single row of the topk best entities is returned.
      * @param topk_query_result, result array.
      *
      * @return Indicate if query is successful.
@@ -410,6 +467,73 @@ class Connection {
            const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
            TopKQueryResult& topk_query_result) = 0;
 
+    /**
+     * @brief Search entities in a collection by chunks of queries
+     *
+     * This method is used to query a large entity array in chunks of chunk_nq vectors, keeping several chunks in
+     * flight. The result of a chunk is handed to on_chunk as soon as it arrives, so the first results come before
+     * the last queries are searched and neither side holds the whole result.
+     *
+     * @param collection_name, target collection's name.
+     * @param partition_tag_array, target partitions, keep empty if no partition specified.
+     * @param query_entity_array, vectors to be queried.
+     * @param topk, how many similarity entities will be returned.
+     * @param extra_params, extra search parameters as for Search, except {aggregate: "max_sim"} which needs all the
+     *  query vectors in one search.
+     * @param chunk_nq, number of query vectors searched by one request.
+     * @param on_chunk, called on the calling thread with the index of the first query of a chunk and the chunk
+     *  result, chunks may complete out of order.
+     * @param max_in_flight, number of search requests waiting for a reply at most.
+     *
+     * @return Indicate if query is successful, the chunks handed to on_chunk before a failure are valid.
+     */
+    virtual Status
+    SearchChunked(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                  const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                  int64_t chunk_nq, const QueryChunkCallback& on_chunk, int64_t max_in_flight = 2) = 0;
+
+    /**
+     * @brief Insert entity to collection without waiting for the reply
+     *
+     * This method is used to keep many inserts in flight from one thread. The request is built before the method
+     * returns, so entity_array may be released at once, but id_array must stay alive until the future is ready.
+     * When insert_batch_rows of the connect parameters is set, inserts into the same collection and partition
+     * issued within insert_batch_delay_ms are merged into one request, each one getting its own ids back.
+     *
+     * @param collection_name, target collection's name.
+     * @param partition_tag, target partition's tag, keep empty if no partition specified.
+     * @param entity_array, entity array is inserted, each entity represent a vector.
+     * @param id_array,
+     *  specify id for each entity,
+     *  if this array is empty, milvus will generate unique id for each entity,
+     *  and return all ids by this parameter.
+     *
+     * @return Future of the status of the insert, a merged insert fails for all its parts.
+     */
+    virtual std::future<Status>
+    InsertAsync(const std::string& collection_name, const std::string& partition_tag,
+                const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) = 0;
+
+    /**
+     * @brief Search entities in a collection without waiting for the reply
+     *
+     * This method is used to keep many searches in flight from one thread. The request is built before the method
+     * returns, topk_query_result must stay alive until the future is ready.
+     *
+     * @param collection_name, target collection's name.
+     * @param partition_tag_array, target partitions, keep empty if no partition specified.
+     * @param query_entity_array, vectors to be queried.
+     * @param topk, how many similarity entities will be returned.
+     * @param extra_params, extra search parameters as for Search.
+     * @param topk_query_result, result array.
+     *
+     * @return Future of the status of the search.
+     */
+    virtual std::future<Status>
+    SearchAsync(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                TopKQueryResult& topk_query_result) = 0;
+
     /**
      * @brief Get collection information
      *
@@ -102,6 +102,14 @@ ConnectionImpl::Insert(const std::string& collection_name, const std::string& pa
     return client_proxy_->Insert(collection_name, partition_tag, entity_array, id_array);
 }
 
+Status
+ConnectionImpl::BulkInsert(const std::string& collection_name, const std::string& partition_tag,
+                           const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array, int64_t chunk_size,
+                           int64_t max_in_flight) {
+    return client_proxy_->BulkInsert(collection_name, partition_tag, entity_array, id_array, chunk_size,
+                                     max_in_flight);
+}
+
 Status
 ConnectionImpl::GetEntityByID(const std::string& collection_name, const std::vector<int64_t>& id_array,
                               std::vector<Entity>& entities_data) {
@@ -122,6 +130,28 @@ ConnectionImpl::Search(const std::string& collection_name, const PartitionTagLis
                                  topk_query_result);
 }
 
+Status
+ConnectionImpl::SearchChunked(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                              const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                              int64_t chunk_nq, const QueryChunkCallback& on_chunk, int64_t max_in_flight) {
+    return client_proxy_->SearchChunked(collection_name, partition_tag_array, entity_array, topk, extra_params,
+                                        chunk_nq, on_chunk, max_in_flight);
+}
+
+std::future<Status>
+ConnectionImpl::InsertAsync(const std::string& collection_name, const std::string& partition_tag,
+                            const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) {
+    return client_proxy_->InsertAsync(collection_name, partition_tag, entity_array, id_array);
+}
+
+std::future<Status>
+ConnectionImpl::SearchAsync(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                            const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                            TopKQueryResult& topk_query_result) {
+    return client_proxy_->SearchAsync(collection_name, partition_tag_array, entity_array, topk, extra_params,
+                                      topk_query_result);
+}
+
 Status
 ConnectionImpl::GetCollectionInfo(const std::string& collection_name, CollectionParam& collection_schema) {
     return client_proxy_->GetCollectionInfo(collection_name, collection_schema);
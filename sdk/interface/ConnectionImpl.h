@@ -68,6 +68,11 @@ class ConnectionImpl : public Connection {
     Insert(const std::string& collection_name, const std::string& partition_tag,
            const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) override;
 
+    Status
+    BulkInsert(const std::string& collection_name, const std::string& partition_tag,
+               const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array, int64_t chunk_size,
+               int64_t max_in_flight) override;
+
     Status
     GetEntityByID(const std::string& collection_name, const std::vector<int64_t>& id_array,
                   std::vector<Entity>& entities_data) override;
@@ -81,6 +86,20 @@ class ConnectionImpl : public Connection {
            const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
            TopKQueryResult& topk_query_result) override;
 
+    Status
+    SearchChunked(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                  const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                  int64_t chunk_nq, const QueryChunkCallback& on_chunk, int64_t max_in_flight) override;
+
+    std::future<Status>
+    InsertAsync(const std::string& collection_name, const std::string& partition_tag,
+                const std::vector<Entity>& entity_array, std::vector<int64_t>& id_array) override;
+
+    std::future<Status>
+    SearchAsync(const std::string& collection_name, const PartitionTagList& partition_tag_array,
+                const std::vector<Entity>& entity_array, int64_t topk, const std::string& extra_params,
+                TopKQueryResult& topk_query_result) override;
+
     Status
     GetCollectionInfo(const std::string& collection_name, CollectionParam& collection_param) override;
 